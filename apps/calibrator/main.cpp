@@ -48,6 +48,7 @@ namespace {
     float theta = 0.f;
 
     bool takeScreenshot = false;
+    bool writeTrace = false;
     bool captureBackbuffer = false;
     bool renderGrid = false;
     bool renderBox = true;
@@ -458,6 +459,10 @@ void postSyncPreDraw() {
         Engine::instance().takeScreenshot();
         takeScreenshot = false;
     }
+    if (writeTrace) {
+        Engine::instance().writeTrace();
+        writeTrace = false;
+    }
 }
 
 void draw(const RenderData& data) {
@@ -626,6 +631,7 @@ void postDraw() {
 std::vector<std::byte> encode() {
     std::vector<std::byte> data;
     serializeObject(data, takeScreenshot);
+    serializeObject(data, writeTrace);
     serializeObject(data, captureBackbuffer);
     serializeObject(data, renderGrid);
     serializeObject(data, renderBox);
@@ -641,6 +647,7 @@ std::vector<std::byte> encode() {
 void decode(const std::vector<std::byte>& data) {
     unsigned pos = 0;
     deserializeObject(data, pos, takeScreenshot);
+    deserializeObject(data, pos, writeTrace);
     deserializeObject(data, pos, captureBackbuffer);
     deserializeObject(data, pos, renderGrid);
     deserializeObject(data, pos, renderBox);
@@ -692,6 +699,10 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
         takeScreenshot = true;
     }
 
+    if (key == Key::T && action == Action::Press) {
+        writeTrace = true;
+    }
+
     if (key == Key::B && action == Action::Press) {
         captureBackbuffer = !captureBackbuffer;
     }
@@ -724,7 +735,7 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
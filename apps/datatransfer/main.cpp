@@ -427,7 +427,7 @@ void drop(const std::vector<std::string_view>& path) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
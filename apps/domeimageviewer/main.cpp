@@ -7,37 +7,31 @@
  ****************************************************************************************/
 
 #include <sgct/sgct.h>
+#include <sgct/mediadistributor.h>
 #include <sgct/opengl.h>
 #include "dome.h"
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-#include <fstream>
 
 namespace {
-    std::unique_ptr<std::thread> loadThread;
-    std::mutex imageMutex;
-    GLFWwindow* hiddenWindow;
-    GLFWwindow* sharedWindow;
-    std::vector<std::unique_ptr<sgct::Image>> transImages;
-
     bool stats = false;
     int32_t texIndex = -1;
     int32_t incrIndex = 1;
+    // The number of images that are ready on all nodes, only used on the master
     int32_t numSyncedTex = 0;
 
-    int32_t lastPackage = -1;
-    bool transfer = false;
-    bool serverUploadDone = false;
-    int32_t serverUploadCount(0);
-    bool clientsUploadDone = false;
-    std::vector<std::string> imagePaths;
-    std::vector<GLuint> texIds;
+    // Images that are larger than the maximum texture size are split into tiles, which
+    // are stored in the layers of an array texture
+    struct Texture {
+        GLuint id = 0;
+        sgct::ivec2 tiles = sgct::ivec2{ 1, 1 };
+        sgct::vec2 tileScale = sgct::vec2{ 1.f, 1.f };
+    };
+    std::vector<Texture> textures;
     double sendTimer = 0.0;
 
-    bool isRunning = true;
-
     std::unique_ptr<Dome> dome;
     GLint matrixLoc = -1;
+    GLint tilesLoc = -1;
+    GLint tileScaleLoc = -1;
 
     double currentTime(0.0);
 
@@ -59,169 +53,136 @@ namespace {
     constexpr std::string_view fragmentShader = R"(
   #version 330 core
 
-  uniform sampler2D tex;
+  uniform sampler2DArray tex;
+  uniform ivec2 tiles;
+  uniform vec2 tileScale;
 
   in vec2 uv;
   out vec4 color;
 
-  void main() { color = texture(tex, uv); }
+  void main() {
+    vec2 pos = uv * tileScale;
+    ivec2 tile = clamp(ivec2(pos), ivec2(0), tiles - 1);
+    color = texture(tex, vec3(pos - vec2(tile), tile.y * tiles.x + tile.x));
+  }
 )";
 } // namespace
 
 using namespace sgct;
 
-void readImage(unsigned char* data, int len) {
-    std::unique_lock lk(imageMutex);
-
-    std::unique_ptr<Image> img = std::make_unique<Image>();
-    try {
-        img->load(data, len);
-        transImages.push_back(std::move(img));
-    }
-    catch (const std::runtime_error& e) {
-        Log::Error(e.what());
-    }
-}
-
-void startDataTransfer() {
-    int id = lastPackage;
-    id++;
-
-    // make sure to keep within bounds
-    if (static_cast<int>(imagePaths.size()) <= id) {
-        return;
+Texture uploadTexture(const Image& image) {
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+    // create texture
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tex);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    const size_t bpc = image.bytesPerChannel();
+
+    GLenum internalformat;
+    GLenum type;
+    switch (image.channels()) {
+        case 1:
+            internalformat = (bpc == 1 ? GL_R8 : GL_R16);
+            type = GL_RED;
+            break;
+        case 2:
+            internalformat = (bpc == 1 ? GL_RG8 : GL_RG16);
+            type = GL_RG;
+            break;
+        case 3:
+        default:
+            internalformat = (bpc == 1 ? GL_RGB8 : GL_RGB16);
+            type = GL_BGR;
+            break;
+        case 4:
+            internalformat = (bpc == 1 ? GL_RGBA8 : GL_RGBA16);
+            type = GL_BGRA;
+            break;
     }
-    sendTimer = time();
 
-    const int imageCounter = static_cast<int32_t>(imagePaths.size());
-    lastPackage = imageCounter - 1;
-
-    for (int i = id; i < imageCounter; i++) {
-        // load from file
-        const std::string& p = imagePaths[static_cast<size_t>(i)];
-
-        std::ifstream file(p.c_str(), std::ios::binary);
-        file.seekg(0, std::ios::end);
-        std::streamsize size = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        std::vector<char> buffer(size);
-        if (file.read(buffer.data(), size)) {
-            const int s = static_cast<int>(buffer.size());
-            NetworkManager::instance().transferData(buffer.data(), s, i);
-            readImage(reinterpret_cast<unsigned char*>(buffer.data()), s);
+    GLenum format = (bpc == 1 ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT);
+
+    const GLsizei width = image.size().x;
+    const GLsizei height = image.size().y;
+    const unsigned char* data = image.data();
+
+    // The tiles are as small as possible so that little memory is wasted on the
+    // padding of the last row and column of tiles
+    Texture t;
+    t.id = tex;
+    t.tiles = ivec2{
+        (width + maxSize - 1) / maxSize,
+        (height + maxSize - 1) / maxSize
+    };
+    const ivec2 tileSize = ivec2{
+        (width + t.tiles.x - 1) / t.tiles.x,
+        (height + t.tiles.y - 1) / t.tiles.y
+    };
+    t.tileScale = vec2{
+        static_cast<float>(width) / static_cast<float>(tileSize.x),
+        static_cast<float>(height) / static_cast<float>(tileSize.y)
+    };
+    glTexStorage3D(
+        GL_TEXTURE_2D_ARRAY,
+        1,
+        internalformat,
+        tileSize.x,
+        tileSize.y,
+        t.tiles.x * t.tiles.y
+    );
+
+    // The tiles are uploaded directly out of the image without copying them first
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for (int y = 0; y < t.tiles.y; y++) {
+        for (int x = 0; x < t.tiles.x; x++) {
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, x * tileSize.x);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, y * tileSize.y);
+            glTexSubImage3D(
+                GL_TEXTURE_2D_ARRAY,
+                0,
+                0,
+                0,
+                y * t.tiles.x + x,
+                std::min(tileSize.x, width - x * tileSize.x),
+                std::min(tileSize.y, height - y * tileSize.y),
+                1,
+                type,
+                format,
+                data
+            );
         }
     }
-}
-
-void uploadTexture() {
-    std::unique_lock lk(imageMutex);
-
-    if (transImages.empty()) {
-        return;
-    }
-    glfwMakeContextCurrent(hiddenWindow);
-
-    for (size_t i = 0; i < transImages.size(); i++) {
-        if (!transImages[i]) {
-            // if invalid load
-            texIds.push_back(0);
-            continue;
-        }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
 
-        // create texture
-        GLuint tex;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        const size_t bpc = transImages[i]->bytesPerChannel();
-
-        GLenum internalformat;
-        GLenum type;
-        switch (transImages[i]->channels()) {
-            case 1:
-                internalformat = (bpc == 1 ? GL_R8 : GL_R16);
-                type = GL_RED;
-                break;
-            case 2:
-                internalformat = (bpc == 1 ? GL_RG8 : GL_RG16);
-                type = GL_RG;
-                break;
-            case 3:
-            default:
-                internalformat = (bpc == 1 ? GL_RGB8 : GL_RGB16);
-                type = GL_BGR;
-                break;
-            case 4:
-                internalformat = (bpc == 1 ? GL_RGBA8 : GL_RGBA16);
-                type = GL_BGRA;
-                break;
-        }
-
-        GLenum format = (bpc == 1 ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT);
-
-        const GLsizei width = transImages[i]->size().x;
-        const GLsizei height = transImages[i]->size().y;
-        unsigned char* data = transImages[i]->data();
-        glTexStorage2D(GL_TEXTURE_2D, 1, internalformat, width, height);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, type, format, data);
+    // Disable mipmaps
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
 
-        // Disable mipmaps
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // unbind
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
-        // unbind
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        Log::Info(std::format(
-            "Texture id %d loaded ({}x{}x{})",
-            tex, transImages[i]->size().x, transImages[i]->size().y,
-            transImages[i]->channels()
-        ));
-
-        texIds.push_back(tex);
-        transImages[i] = nullptr;
-    }
-
-    transImages.clear();
-    glFinish();
-
-    glfwMakeContextCurrent(nullptr);
-}
-
-void threadWorker() {
-    while (isRunning) {
-        const bool trans = transfer;
-        const bool serverDone = serverUploadDone;
-        const bool clientDone = clientsUploadDone;
-        // runs only on master
-        if (trans && !serverDone && !clientDone) {
-            startDataTransfer();
-            transfer = false;
-
-            // load textures on master
-            uploadTexture();
-            serverUploadDone = true;
-
-            if (ClusterManager::instance().numberOfNodes() == 1) {
-                clientsUploadDone = true;
-            }
-        }
+    Log::Info(std::format(
+        "Texture id {} loaded ({}x{}x{}) in {}x{} tiles",
+        tex, image.size().x, image.size().y, image.channels(), t.tiles.x, t.tiles.y
+    ));
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    return t;
 }
 
-
 void draw(const RenderData& data) {
-    if (texIndex == -1) {
+    if (texIndex < 0 || texIndex >= static_cast<int>(textures.size())) {
         return;
     }
 
@@ -232,17 +193,15 @@ void draw(const RenderData& data) {
 
     glActiveTexture(GL_TEXTURE0);
 
-    if ((static_cast<int>(texIds.size()) > (texIndex + 1)) &&
-        data.frustumMode == FrustumMode::StereoRight)
-    {
-        glBindTexture(GL_TEXTURE_2D, texIds[texIndex + 1]);
-    }
-    else {
-        glBindTexture(GL_TEXTURE_2D, texIds[texIndex]);
-    }
+    const bool useNext = static_cast<int>(textures.size()) > (texIndex + 1) &&
+        data.frustumMode == FrustumMode::StereoRight;
+    const Texture& t = textures[useNext ? texIndex + 1 : texIndex];
+    glBindTexture(GL_TEXTURE_2D_ARRAY, t.id);
 
     ShaderManager::instance().shaderProgram("xform").bind();
     glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, mvp.values.data());
+    glUniform2i(tilesLoc, t.tiles.x, t.tiles.y);
+    glUniform2f(tileScaleLoc, t.tileScale.x, t.tileScale.y);
     dome->draw();
     ShaderManager::instance().shaderProgram("xform").unbind();
 
@@ -254,40 +213,44 @@ void preSync() {
     if (Engine::instance().isMaster()) {
         currentTime = time();
 
-        // if texture is uploaded then iterate the index
-        if (serverUploadDone && clientsUploadDone) {
-            numSyncedTex = static_cast<int32_t>(texIds.size());
-
-            // only iterate up to the first new image, even if multiple images was added
-            texIndex = numSyncedTex - serverUploadCount;
+        // The images that became ready in this frame are ready on all nodes, so the
+        // clients show the first new one in the same frame as the master
+        const int32_t nReady = Engine::instance().mediaDistributor().nReady();
+        if (nReady > numSyncedTex) {
+            texIndex = numSyncedTex;
+            numSyncedTex = nReady;
 
-            serverUploadDone = false;
-            clientsUploadDone = false;
+            Log::Info(std::format(
+                "Time to distribute and decode images on cluster: {} ms",
+                (time() - sendTimer) * 1000.0
+            ));
         }
     }
 }
 
 void postSyncPreDraw() {
     Engine::instance().setStatsGraphVisibility(stats);
-}
 
-void initOGL(GLFWwindow* win) {
-    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-
-    sharedWindow = win;
-    hiddenWindow = glfwCreateWindow(1, 1, "Thread Window", nullptr, sharedWindow);
-
-    if (!hiddenWindow) {
-        Log::Info("Failed to create loader context");
-    }
-
-    // restore to normal
-    glfwMakeContextCurrent(sharedWindow);
-
-    if (Engine::instance().isMaster()) {
-        loadThread = std::make_unique<std::thread>(threadWorker);
+    // The images are uploaded in order as soon as they are decoded on this node, so all
+    // images that are ready on all nodes have been uploaded before they are drawn
+    MediaDistributor& distributor = Engine::instance().mediaDistributor();
+    while (true) {
+        const int id = static_cast<int>(textures.size());
+        const MediaDistributor::Status status = distributor.status(id);
+        if (status == MediaDistributor::Status::Decoded) {
+            textures.push_back(uploadTexture(*distributor.image(id)));
+            distributor.release(id);
+        }
+        else if (status == MediaDistributor::Status::Failed) {
+            textures.push_back(Texture());
+        }
+        else {
+            break;
+        }
     }
+}
 
+void initOGL(GLFWwindow*) {
     dome = std::make_unique<Dome>(7.4f, 180.f, 256, 128);
 
     // Set up backface culling
@@ -299,6 +262,8 @@ void initOGL(GLFWwindow* win) {
     const ShaderProgram& prog = ShaderManager::instance().shaderProgram("xform");
     prog.bind();
     matrixLoc = glGetUniformLocation(prog.id(), "mvp");
+    tilesLoc = glGetUniformLocation(prog.id(), "tiles");
+    tileScaleLoc = glGetUniformLocation(prog.id(), "tileScale");
     glUniform1i(glGetUniformLocation(prog.id(), "tex"), 0);
     prog.unbind();
 }
@@ -323,18 +288,13 @@ void decode(const std::vector<std::byte>& data) {
 void cleanup() {
     dome = nullptr;
 
-    for (size_t i = 0; i < texIds.size(); i++) {
-        GLuint tex = texIds[i];
-        if (tex) {
-            glDeleteTextures(1, &tex);
-            texIds[i] = 0;
+    for (Texture& t : textures) {
+        if (t.id) {
+            glDeleteTextures(1, &t.id);
+            t.id = 0;
         }
     }
-    texIds.clear();
-
-    if (hiddenWindow) {
-        glfwDestroyWindow(hiddenWindow);
-    }
+    textures.clear();
 }
 
 void keyboard(Key key, Modifier, Action action, int, Window*) {
@@ -374,47 +334,6 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
     }
 }
 
-void dataTransferDecoder(void* receivedData, int receivedLength, int packageId,
-                         int clientIndex)
-{
-    Log::Info(std::format(
-        "Decoding {} bytes in transfer id: {} on node {}",
-        receivedLength, packageId, clientIndex
-    ));
-
-    lastPackage = packageId;
-
-    // read the image on slave
-    readImage(reinterpret_cast<unsigned char*>(receivedData), receivedLength);
-    uploadTexture();
-}
-
-void dataTransferStatus(bool connected, int clientIndex) {
-    Log::Info(std::format(
-        "Transfer node {} is {}", clientIndex, connected ? "connected" : "disconnected"
-    ));
-}
-
-void dataTransferAcknowledge(int packageId, int clientIndex) {
-    Log::Info(std::format(
-        "Transfer id: {} is completed on node {}", packageId, clientIndex
-    ));
-
-    if (packageId == lastPackage) {
-        static int counter = 0;
-        counter++;
-        if (counter == (ClusterManager::instance().numberOfNodes() - 1)) {
-            clientsUploadDone = true;
-            counter = 0;
-
-            Log::Info(std::format(
-                "Time to distribute and upload textures on cluster: {} ms",
-                (time() - sendTimer) * 1000.0
-            ));
-        }
-    }
-}
-
 void drop(const std::vector<std::string_view>& paths) {
     if (Engine::instance().isMaster()) {
         std::vector<std::string> pathStrings;
@@ -436,25 +355,15 @@ void drop(const std::vector<std::string_view>& paths) {
         // sort in alphabetical order
         std::sort(pathStrings.begin(), pathStrings.end());
 
-        serverUploadCount = 0;
+        sendTimer = time();
 
         // iterate all drop paths
-        for (size_t i = 0; i < pathStrings.size(); i++) {
-            std::string tmpStr = pathStrings[i];
-
-            const size_t foundJpg = tmpStr.find(".jpg");
-            const size_t foundJpeg = tmpStr.find(".jpeg");
-            if (foundJpg != std::string::npos || foundJpeg != std::string::npos) {
-                imagePaths.push_back(pathStrings[i]);
-                transfer = true; // tell transfer thread to start processing data
-                serverUploadCount++;
-            }
-
-            const size_t foundPng = tmpStr.find(".png");
-            if (foundPng != std::string::npos) {
-                imagePaths.push_back(pathStrings[i]);
-                transfer = true; // tell transfer thread to start processing data
-                serverUploadCount++;
+        for (const std::string& path : pathStrings) {
+            const bool isJpg = path.find(".jpg") != std::string::npos ||
+                path.find(".jpeg") != std::string::npos;
+            const bool isPng = path.find(".png") != std::string::npos;
+            if (isJpg || isPng) {
+                Engine::instance().mediaDistributor().distribute(path);
             }
         }
     }
@@ -463,7 +372,7 @@ void drop(const std::vector<std::string_view>& paths) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
@@ -478,9 +387,6 @@ int main(int argc, char** argv) {
     callbacks.cleanup = cleanup;
     callbacks.keyboard = keyboard;
     callbacks.drop = drop;
-    callbacks.dataTransferDecode = dataTransferDecoder;
-    callbacks.dataTransferStatus = dataTransferStatus;
-    callbacks.dataTransferAcknowledge = dataTransferAcknowledge;
 
     try {
         Engine::create(cluster, callbacks, config);
@@ -492,14 +398,6 @@ int main(int argc, char** argv) {
     }
 
     Engine::instance().exec();
-
-    isRunning = false;
-
-    if (loadThread) {
-        loadThread->join();
-        loadThread = nullptr;
-    }
-
     Engine::destroy();
     exit(EXIT_SUCCESS);
 }
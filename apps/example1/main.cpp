@@ -130,7 +130,7 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
@@ -6,49 +6,49 @@
  * For conditions of distribution and use, see copyright notice in LICENSE.md            *
  ****************************************************************************************/
 
-#include "capture.h"
-
 #include <sgct/sgct.h>
-#include <sgct/utils/dome.h>
-#include <sgct/utils/plane.h>
-#include <GLFW/glfw3.h>
-#include <glm/gtc/matrix_inverse.hpp>
+#include <sgct/opengl.h>
+#include <sgct/videodecoder.h>
+#include "dome.h"
+#include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <stdlib.h>
-#include <stdio.h>
 
 namespace {
-    Capture capture;
-
-    std::unique_ptr<sgct::utils::Plane> plane;
-    std::unique_ptr<sgct::utils::Dome> dome;
+    // The video and the node that decodes it. If no host is given, all nodes decode it
+    std::string video;
+    std::string videoHost;
+    sgct::VideoDecoder::Options videoOptions;
+    std::unique_ptr<sgct::VideoDecoder> decoder;
+    // Whether all nodes decode the same file and show its frames in sync
+    bool isSynchronized = false;
+
+    // The time that the nodes have to decode the first frames ahead before the video
+    // starts
+    constexpr double StartDelay = 0.5;
+
+    std::unique_ptr<Dome> dome;
+    GLuint planeVao = 0;
+    GLuint planeVbo = 0;
 
     GLint matrixLoc = -1;
     GLint scaleUvLoc = -1;
-    GLint offsetUVLoc = -1;
-    GLuint texId = 0;
+    GLint offsetUvLoc = -1;
+    GLint flipLoc = -1;
 
-    std::thread* workerThread;
-    GLFWwindow* hiddenWindow;
     bool flipFrame = false;
-    bool fulldomeMode = false;
     float planeAzimuth = 0.f;
     float planeElevation = 33.f;
     float planeRoll = 0.f;
 
     // variables to share across cluster
-    double currTime = 0.0;
     bool info = false;
     bool stats = false;
     bool takeScreenshot = false;
-
-    // variables to share between threads
-    bool workerRunning = true;
-    bool renderDome = fulldomeMode;
-    double captureRate = 0.0;
+    bool renderDome = false;
     int32_t domeCut = 2;
-
+    // The presentation time at which a synchronized video starts
+    double videoStart = -1.0;
 
     constexpr std::string_view VertexShader = R"(
   #version 330 core
@@ -58,11 +58,9 @@ namespace {
   layout(location = 2) in vec3 vertPositions;
 
   uniform mat4 mvp;
-
   out vec2 uv;
 
   void main() {
-    // Output position of the vertex, in clip space : MVP * position
     gl_Position =  mvp * vec4(vertPositions, 1.0);
     uv = texCoords;
   })";
@@ -73,193 +71,92 @@ namespace {
   uniform sampler2D tex;
   uniform vec2 scaleUV;
   uniform vec2 offsetUV;
+  uniform bool flip;
 
   in vec2 uv;
   out vec4 color;
 
-  void main() { color = texture(tex, (uv.st * scaleUV) + offsetUV); }
+  void main() {
+    vec2 st = flip ? vec2(uv.s, 1.0 - uv.t) : uv;
+    color = texture(tex, st * scaleUV + offsetUV);
+  }
 )";
 } // namespace
 
 using namespace sgct;
 
-void captureLoop() {
-    glfwMakeContextCurrent(hiddenWindow);
-
-    GLuint pbo;
-    glGenBuffers(1, &pbo);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
-    const int dataSize = capture.width() * capture.height() * 3;
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, dataSize, 0, GL_DYNAMIC_DRAW);
-
-    while (workerRunning) {
-        capture.poll();
-    }
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-    glDeleteBuffers(1, &pbo);
-
-    glfwMakeContextCurrent(nullptr); // detach context
-}
-
-void calculateStats() {
-    double timeStamp = Engine::getTime();
-    static double previousTimeStamp = timeStamp;
-    static double numberOfSamples = 0.0;
-    static double duration = 0.0;
-
-    timeStamp = Engine::getTime();
-    duration += timeStamp - previousTimeStamp;
-    previousTimeStamp = timeStamp;
-    numberOfSamples++;
-
-    if (duration >= 1.0) {
-        captureRate = numberOfSamples / duration;
-        duration = 0.0;
-        numberOfSamples = 0.0;
-    }
-}
-
-void allocateTexture() {
-    const int w = capture.width();
-    const int h = capture.height();
-
-    if (w * h <= 0) {
-        sgct::Log::Error("Invalid texture size (%dx%d)", w, h);
-        return;
-    }
-
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB8, w, h);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-}
-
-void uploadData(const uint8_t** data, int w, int h) {
-    // At least two textures and GLSync objects should be used to control that the
-    // uploaded texture is the same for all viewports to prevent any tearing and maintain
-    // frame sync
-
-    if (texId == 0) {
+void draw(const RenderData& data) {
+    if (!decoder || decoder->texture() == 0) {
         return;
     }
 
-    unsigned char* gpuMemory = reinterpret_cast<unsigned char*>(
-        glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)
-        );
-    if (gpuMemory) {
-        int dataOffset = 0;
-        const int stride = w * 3;
-
-        if (flipFrame) {
-            for (int row = 0; row < h; row++) {
-                std::memcpy(gpuMemory + dataOffset, data[0] + row * stride, stride);
-                dataOffset += stride;
-            }
-        }
-        else {
-            for (int row = h - 1; row > -1; row--) {
-                std::memcpy(gpuMemory + dataOffset, data[0] + row * stride, stride);
-                dataOffset += stride;
-            }
-        }
-
-        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texId);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_BGR, GL_UNSIGNED_BYTE, 0);
-    }
-
-    calculateStats();
-}
-
-void draw(const RenderData& data) {
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
-    glm::mat4 MVP = data.modelViewProjectionMatrix;
+    const glm::mat4 mvp = glm::make_mat4(data.modelViewProjectionMatrix.values.data());
+    const glm::vec2 texSize = glm::vec2(decoder->size().x, decoder->size().y);
 
     ShaderManager::instance().shaderProgram("xform").bind();
+    glUniform1i(flipLoc, flipFrame ? 1 : 0);
 
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texId);
+    glBindTexture(GL_TEXTURE_2D, decoder->texture());
 
-    glm::vec2 texSize = glm::vec2(
-        static_cast<float>(capture.width()),
-        static_cast<float>(capture.height())
-    );
-
-    if (fulldomeMode) {
-        // TextureCut 2 equals showing only the middle square of a capturing a input
+    if (renderDome) {
+        // The second cut only shows the square in the middle of the video
         if (domeCut == 2) {
             glUniform2f(scaleUvLoc, texSize.y / texSize.x, 1.f);
-            glUniform2f(offsetUVLoc, ((texSize.x - texSize.y)*0.5f) / texSize.x, 0.f);
+            glUniform2f(offsetUvLoc, ((texSize.x - texSize.y) * 0.5f) / texSize.x, 0.f);
         }
         else {
             glUniform2f(scaleUvLoc, 1.f, 1.f);
-            glUniform2f(offsetUVLoc, 0.f, 0.f);
+            glUniform2f(offsetUvLoc, 0.f, 0.f);
         }
 
-        glCullFace(GL_FRONT); //camera on the inside of the dome
-
-        glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, glm::value_ptr(MVP));
+        // camera on the inside of the dome
+        glFrontFace(GL_CW);
+        glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, glm::value_ptr(mvp));
         dome->draw();
     }
     else {
-        // plane mode
         glUniform2f(scaleUvLoc, 1.f, 1.f);
-        glUniform2f(offsetUVLoc, 0.f, 0.f);
-
-        glCullFace(GL_BACK);
+        glUniform2f(offsetUvLoc, 0.f, 0.f);
 
-        //transform and draw plane
-        glm::mat4 planeTransform = glm::mat4(1.f);
-        // azimuth
-        planeTransform = glm::rotate(
-            planeTransform,
+        glm::mat4 plane = glm::rotate(
+            glm::mat4(1.f),
             glm::radians(planeAzimuth),
             glm::vec3(0.f, -1.f, 0.f)
         );
-        // elevation
-        planeTransform = glm::rotate(
-            planeTransform,
+        plane = glm::rotate(
+            plane,
             glm::radians(planeElevation),
             glm::vec3(1.f, 0.f, 0.f)
         );
-        // roll
-        planeTransform = glm::rotate(
-            planeTransform,
-            glm::radians(planeRoll),
-            glm::vec3(0.f, 0.f, 1.f)
-        );
-        // distance
-        planeTransform = glm::translate(planeTransform, glm::vec3(0.f, 0.f, -5.f));
-
-        planeTransform = MVP * planeTransform;
-        glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, glm::value_ptr(planeTransform));
-        plane->draw();
+        plane = glm::rotate(plane, glm::radians(planeRoll), glm::vec3(0.f, 0.f, 1.f));
+        plane = glm::translate(plane, glm::vec3(0.f, 0.f, -5.f));
+        // The plane is 8 units wide and has the aspect ratio of the video
+        plane = glm::scale(plane, glm::vec3(8.f, 8.f * texSize.y / texSize.x, 1.f));
+
+        const glm::mat4 planeMvp = mvp * plane;
+        glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, glm::value_ptr(planeMvp));
+        glBindVertexArray(planeVao);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glBindVertexArray(0);
     }
 
     ShaderManager::instance().shaderProgram("xform").unbind();
 
+    glFrontFace(GL_CCW);
     glDisable(GL_CULL_FACE);
     glDisable(GL_DEPTH_TEST);
 }
 
 void draw2D(const RenderData& data) {
-    if (info) {
-        unsigned int size = static_cast<unsigned int>(9.f * data.window.scale().x);
+#ifdef SGCT_HAS_TEXT
+    if (info && decoder) {
+        const unsigned int size = static_cast<unsigned int>(9.f * data.window.scale().x);
         text::Font* font = text::FontManager::instance().font("SGCTFont", size);
-        float padding = 10.f;
+        const float padding = 10.f;
 
         text::print(
             data.window,
@@ -268,20 +165,15 @@ void draw2D(const RenderData& data) {
             text::Alignment::TopLeft,
             padding,
             static_cast<float>(data.window.framebufferResolution().y - size) - padding,
-            glm::vec4(1.f),
-            "Format: %s\nResolution: %d x %d\nRate: %.2lf Hz",
-            capture.format().c_str(),
-            capture.width(),
-            capture.height(),
-            captureRate
+            vec4{ 1.f, 1.f, 1.f, 1.f },
+            std::format(
+                "Resolution: {} x {}\nDecoder: {}",
+                decoder->size().x, decoder->size().y,
+                decoder->hardwareDevice().empty() ? "CPU" : decoder->hardwareDevice()
+            )
         );
     }
-}
-
-void preSync() {
-    if (Engine::instance().isMaster()) {
-        currTime = Engine::getTime();
-    }
+#endif // SGCT_HAS_TEXT
 }
 
 void postSyncPreDraw() {
@@ -292,196 +184,230 @@ void postSyncPreDraw() {
         takeScreenshot = false;
     }
 
-    fulldomeMode = renderDome; // set the flag frame synchronized for all viewports
+    if (decoder && isSynchronized) {
+        if (videoStart >= 0.0) {
+            decoder->update(Engine::instance().presentationTime() - videoStart);
+        }
+    }
+    else if (decoder) {
+        decoder->update();
+    }
 }
 
-void myInitOGLFun(GLFWwindow* win) {
-    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-
-    hiddenWindow = glfwCreateWindow(1, 1, "Thread Window", nullptr, win);
-    if (!hiddenWindow) {
-        sgct::Log::Info("Failed to create loader context");
+void preSync() {
+    if (Engine::instance().isMaster() && isSynchronized && videoStart < 0.0) {
+        videoStart = Engine::instance().presentationTime() + StartDelay;
     }
+}
 
-    // restore to normal
-    glfwMakeContextCurrent(win);
-
-    capture.initialize();
-
-    allocateTexture();
-
-    // start capture thread
-    const sgct::Node& thisNode = sgct::ClusterManager::instance().thisNode();
-    if (thisNode.address() == capture.videoHost()) {
-        workerThread = new std::thread(captureLoop);
+void initOGL(GLFWwindow*) {
+    const Node& thisNode = ClusterManager::instance().thisNode();
+    if (!video.empty() && (videoHost.empty() || thisNode.address() == videoHost)) {
+        try {
+            decoder = std::make_unique<VideoDecoder>(video, videoOptions);
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
     }
 
-    capture.setVideoDecoderCallback(uploadData);
-
-    // create plane
-    float planeWidth = 8.f;
-    float planeHeight =
-        planeWidth *
-        (static_cast<float>(capture.height()) / static_cast<float>(capture.width()));
-    plane = std::make_unique<utils::Plane>(planeWidth, planeHeight);
+    // A unit plane in the xy-plane with the same vertex layout as the dome
+    struct Vertex {
+        float s, t;
+        float nx, ny, nz;
+        float x, y, z;
+    };
+    constexpr std::array<Vertex, 4> Vertices = {
+        Vertex{ 0.f, 0.f, 0.f, 0.f, 1.f, -0.5f, -0.5f, 0.f },
+        Vertex{ 1.f, 0.f, 0.f, 0.f, 1.f, 0.5f, -0.5f, 0.f },
+        Vertex{ 0.f, 1.f, 0.f, 0.f, 1.f, -0.5f, 0.5f, 0.f },
+        Vertex{ 1.f, 1.f, 0.f, 0.f, 1.f, 0.5f, 0.5f, 0.f }
+    };
+    glGenVertexArrays(1, &planeVao);
+    glBindVertexArray(planeVao);
+    glGenBuffers(1, &planeVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, planeVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertices), Vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<void*>(offsetof(Vertex, nx))
+    );
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(
+        2,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<void*>(offsetof(Vertex, x))
+    );
+    glBindVertexArray(0);
 
-    // create dome
-    dome = std::make_unique<utils::Dome>(7.4f, 180.f, 256, 128);
+    dome = std::make_unique<Dome>(7.4f, 180.f, 256, 128);
 
-    // Set up backface culling
     glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
 
-    ShaderManager::instance().addShaderProgram("xform", vertexShader, fragmentShader);
+    ShaderManager::instance().addShaderProgram("xform", VertexShader, FragmentShader);
     const ShaderProgram& prog = ShaderManager::instance().shaderProgram("xform");
     prog.bind();
-
     matrixLoc = glGetUniformLocation(prog.id(), "mvp");
     scaleUvLoc = glGetUniformLocation(prog.id(), "scaleUV");
-    offsetUVLoc = glGetUniformLocation(prog.id(), "offsetUV");
+    offsetUvLoc = glGetUniformLocation(prog.id(), "offsetUV");
+    flipLoc = glGetUniformLocation(prog.id(), "flip");
     glUniform1i(glGetUniformLocation(prog.id(), "tex"), 0);
-
     prog.unbind();
 }
 
 std::vector<std::byte> encode() {
     std::vector<std::byte> data;
-    serializeObject(data, currTime);
     serializeObject(data, info);
     serializeObject(data, stats);
     serializeObject(data, takeScreenshot);
     serializeObject(data, renderDome);
     serializeObject(data, domeCut);
+    serializeObject(data, videoStart);
     return data;
 }
 
 void decode(const std::vector<std::byte>& data) {
     unsigned int pos = 0;
-    deserializeObject(data, pos, currTime);
     deserializeObject(data, pos, info);
     deserializeObject(data, pos, stats);
     deserializeObject(data, pos, takeScreenshot);
     deserializeObject(data, pos, renderDome);
     deserializeObject(data, pos, domeCut);
+    deserializeObject(data, pos, videoStart);
 }
 
-void cleanUp() {
-    plane = nullptr;
+void cleanup() {
+    decoder = nullptr;
     dome = nullptr;
-
-    glDeleteTextures(1, &texId);
-    texId = 0;
+    glDeleteBuffers(1, &planeVbo);
+    glDeleteVertexArrays(1, &planeVao);
 }
 
-void keyCallback(Key key, Modifier, Action action, int) {
-    if (Engine::instance().isMaster() && (action == Action::Press)) {
-        switch (key) {
-            //dome mode
-            case Key::D:
-                renderDome = true;
-                break;
-            case Key::S:
-                stats = !stats;
-                break;
-            case Key::I:
-                info = !info;
-                break;
-            case Key::Key1:
-                domeCut = 1;
-                break;
-            case Key::Key2:
-                domeCut = 2;
-                break;
-
-            // plane mode
-            case Key::P:
-                renderDome = false;
-                break;
-            case Key::PrintScreen:
-            case Key::F10:
-                takeScreenshot = true;
-                break;
-        }
+void keyboard(Key key, Modifier, Action action, int, Window*) {
+    if (!Engine::instance().isMaster() || action != Action::Press) {
+        return;
+    }
+    switch (key) {
+        case Key::Esc:
+            Engine::instance().terminate();
+            break;
+        case Key::D:
+            renderDome = true;
+            break;
+        case Key::P:
+            renderDome = false;
+            break;
+        case Key::S:
+            stats = !stats;
+            break;
+        case Key::I:
+            info = !info;
+            break;
+        case Key::Key1:
+            domeCut = 1;
+            break;
+        case Key::Key2:
+            domeCut = 2;
+            break;
+        case Key::PrintScreen:
+        case Key::F10:
+            takeScreenshot = true;
+            break;
+        default:
+            break;
     }
 }
 
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
-
-    Engine::Callbacks callbacks;
-    callbacks.initOpenGL = myInitOGLFun;
-    callbacks.draw = draw;
-    callbacks.draw2D = draw2D;
-    callbacks.preSync = preSync;
-    callbacks.postSyncPreDraw = postSyncPreDraw;
-    callbacks.cleanUp = cleanUp;
-    callbacks.keyboard = keyCallback;
-    callbacks.encode = encode;
-    callbacks.decode = decode;
+    config::Cluster cluster = loadCluster(config);
+    if (!cluster.success) {
+        return -1;
+    }
 
-    // arguments:
-    // -host <host which should capture>
-    // -video <device name>
-    // -option <key> <val>
-    // -flip
-    // -plane <azimuth> <elevation> <roll>
-    //
-    // to obtain video device names in windows use:
-    // ffmpeg -list_devices true -f dshow -i dummy
-    // for mac:
-    // ffmpeg -f avfoundation -list_devices true -i ""
-    //
-    // to obtain device properties in windows use:
-    // ffmpeg -f dshow -list_options true -i video=<device name>
-    //
-    // For options look at: http://ffmpeg.org/ffmpeg-devices.html
-
-    int i = 0;
-    while (i < argc) {
-        std::string_view a = std::string_view(argv[i]);
-        if (a == "-host" && argc > (i + 1)) {
-            capture.setVideoHost(std::string(argv[i + 1]));
+    for (int i = 0; i < argc; i++) {
+        std::string_view argument = argv[i];
+
+        if (argument == "-video" && argc > i + 1) {
+            // Capture devices are opened with the input format of the platform
+            video = argv[i + 1];
+#ifdef WIN32
+            videoOptions.format = "dshow";
+            video = "video=" + video;
+#elif defined __APPLE__
+            videoOptions.format = "avfoundation";
+#else // ^^^^ __APPLE__ // !WIN32 && !__APPLE__ vvvv
+            videoOptions.format = "video4linux2";
+#endif // WIN32
+        }
+        if (argument == "-file" && argc > i + 1) {
+            video = argv[i + 1];
+            isSynchronized = true;
         }
-        else if (a == "-video" && argc > (i + 1)) {
-            capture.setVideoDevice(std::string(argv[i + 1]));
+        if (argument == "-host" && argc > i + 1) {
+            videoHost = argv[i + 1];
         }
-        else if (a == "-option" && argc > (i + 2)) {
-            capture.addOption(
-                std::pair(std::string(argv[i + 1]), std::string(argv[i + 2])));
+        if (argument == "-option" && argc > i + 2) {
+            videoOptions.parameters.emplace_back(argv[i + 1], argv[i + 2]);
         }
-        else if (a == "-flip") {
+        if (argument == "-loop") {
+            videoOptions.loop = true;
+        }
+        if (argument == "-software") {
+            videoOptions.allowHardware = false;
+        }
+        if (argument == "-flip") {
             flipFrame = true;
         }
-        else if (a == "-plane" && argc > (i + 3)) {
-            planeAzimuth = static_cast<float>(atof(argv[i + 1]));
-            planeElevation = static_cast<float>(atof(argv[i + 2]));
-            planeRoll = static_cast<float>(atof(argv[i + 3]));
+        if (argument == "-plane" && argc > i + 3) {
+            planeAzimuth = std::stof(argv[i + 1]);
+            planeElevation = std::stof(argv[i + 2]);
+            planeRoll = std::stof(argv[i + 3]);
         }
-
-        i++;
+    }
+    if (video.empty()) {
+        Log::Error("No video specified, use -video <device> or -file <path>");
+        return EXIT_FAILURE;
+    }
+    // A file that is decoded on all nodes is shown at the same presentation time on all
+    // of them, which requires the frames to be decoded ahead
+    isSynchronized = isSynchronized && videoHost.empty();
+    if (isSynchronized) {
+        videoOptions.decodeAhead = 4;
     }
 
+    Engine::Callbacks callbacks;
+    callbacks.initOpenGL = initOGL;
+    callbacks.preSync = preSync;
+    callbacks.encode = encode;
+    callbacks.decode = decode;
+    callbacks.postSyncPreDraw = postSyncPreDraw;
+    callbacks.draw = draw;
+    callbacks.draw2D = draw2D;
+    callbacks.cleanup = cleanup;
+    callbacks.keyboard = keyboard;
+
     try {
         Engine::create(cluster, callbacks, config);
     }
-    catch (const std::runtime_error & e) {
-        Log::Error("%s", e.what());
+    catch (const std::runtime_error& e) {
+        Log::Error(e.what());
         Engine::destroy();
         return EXIT_FAILURE;
     }
 
-    // Main loop
-    Engine::instance().render();
-
-    // kill worker thread
-    workerRunning = false;
-    if (workerThread) {
-        workerThread->join();
-        delete workerThread;
-    }
-
-    // Exit program
+    Engine::instance().exec();
+    Engine::destroy();
     exit(EXIT_SUCCESS);
 }
@@ -893,7 +893,7 @@ void dropCallback(int count, const char** paths) {
 int main(int argc, char* argv[]) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
 
     // arguments:
     //   -host <host which should capture>
@@ -8,63 +8,65 @@
 
 #include <sgct/sgct.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
 namespace {
-    const char* joyStick1Name = nullptr;
+    // The number of button presses of the first joystick since the start
+    int nPresses = 0;
 } // namespace
 
 using namespace sgct;
 
-void draw2D(const RenderData& data) {
-#ifdef SGCT_HAS_TEXT
-    if (joyStick1Name) {
-        int numberOfAxes = 0;
-        const float* pos = glfwGetJoystickAxes(
-            static_cast<int>(Joystick::Joystick1),
-            &numberOfAxes
-        );
-        std::string joystickInfoStr = "Axes: ";
-
-        for (int i = 0; i < numberOfAxes; i++) {
-            joystickInfoStr += std::to_string(pos[i]) + ' ';
+void preSync() {
+    // The events are sampled on a background thread, so none are lost between frames
+    for (const joystick::Event& e : joystick::events()) {
+        const bool isButton = e.type == joystick::Event::Type::Button;
+        if (e.joystick == Joystick::Joystick1 && isButton && e.value == 1.f) {
+            nPresses++;
         }
+    }
+}
 
-        int numberOfButtons = 0;
-        const unsigned char* buttons = glfwGetJoystickButtons(
-            static_cast<int>(Joystick::Joystick1),
-            &numberOfButtons
-        );
+void draw2D(const RenderData& data) {
+#ifdef SGCT_HAS_TEXT
+    // The axes are interpolated at the time at which the frame is drawn
+    const joystick::State state = joystick::state(Joystick::Joystick1, time());
+    if (!state.isPresent) {
+        return;
+    }
 
-        joystickInfoStr += "\nButtons: ";
-        for (int i = 0; i < numberOfButtons; i++) {
-            joystickInfoStr += std::to_string(buttons[i]) + ' ';
-        }
+    std::string joystickInfoStr = "Axes: ";
+    for (float axis : state.axes) {
+        joystickInfoStr += std::to_string(axis) + ' ';
+    }
 
-        text::print(
-            data.window,
-            data.viewport,
-            *text::FontManager::instance().font("SGCTFont", 12),
-            text::Alignment::TopLeft,
-            18,
-            32,
-            vec4{ 1.f, 0.5f, 0.f, 1.f },
-            joystickInfoStr
-        );
+    joystickInfoStr += "\nButtons: ";
+    for (bool button : state.buttons) {
+        joystickInfoStr += button ? "1 " : "0 ";
     }
+    joystickInfoStr += std::format("\nPresses: {}", nPresses);
+
+    text::print(
+        data.window,
+        data.viewport,
+        *text::FontManager::instance().font("SGCTFont", 12),
+        text::Alignment::TopLeft,
+        18,
+        32,
+        vec4{ 1.f, 0.5f, 0.f, 1.f },
+        joystickInfoStr
+    );
 #endif // SGCT_HAS_TEXT
 }
 
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
 
     Engine::Callbacks callbacks;
+    callbacks.preSync = preSync;
     callbacks.draw2D = draw2D;
 
     try {
@@ -76,20 +78,7 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
-    joyStick1Name = glfwGetJoystickName(static_cast<int>(Joystick::Joystick1));
-    if (joyStick1Name) {
-        Log::Info(std::format("Joystick 1 '{}' is present", joyStick1Name));
-
-        int numberOfAxes = 0;
-        glfwGetJoystickAxes(static_cast<int>(Joystick::Joystick1), &numberOfAxes);
-
-        int numberOfButtons = 0;
-        glfwGetJoystickButtons(static_cast<int>(Joystick::Joystick1), &numberOfButtons);
-
-        Log::Info(std::format(
-            "Number of axes {}\nNumber of buttons {}", numberOfAxes, numberOfButtons
-        ));
-    }
+    joystick::startSampling();
 
     Engine::instance().exec();
     Engine::destroy();
@@ -9,27 +9,87 @@
 #include <sgct/sgct.h>
 #include <sgct/opengl.h>
 
+#include <sgct/gputimer.h>
 #include <sgct/trackingmanager.h>
 #include <sgct/user.h>
+#include <sgct/projection/cylindrical.h>
+#include <sgct/projection/fisheye.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+
+/**
+ * Draws the heightmapped terrain as a reference workload for comparing the hardware of
+ * the nodes. By default, the terrain is a grid of patches that are drawn with a single
+ * instanced draw call and subdivided by the tessellation shaders depending on their
+ * angular size, which works for all projections as it does not depend on the projection
+ * matrix. The tessellation evaluation shader also warps the terrain directly into a
+ * fisheye if the fisheye projection uses `directrendering`. With `-grid`, or if the
+ * OpenGL version does not support tessellation, the terrain is a fixed grid that is
+ * drawn as triangle strips with a single draw call by using primitive restart.
+ *
+ * With `-timing <frames>`, the animation uses a fixed time step, the GPU time of the
+ * draw callback is measured in every window for the number of frames after a warm-up,
+ * and the application terminates after logging the results. Running it with the
+ * planar.json, fisheye.json, and cylindrical.json configurations gives the draw cost of
+ * each type of projection. The number of draw calls per frame shows how often the
+ * non-linear projections call the draw callback for their cube map faces.
+ */
 
 namespace {
     constexpr int GridSize = 256;
 
+    // The terrain is divided into PatchCount x PatchCount patches that are tessellated up
+    // to MaxTessellationLevel subdivisions along each edge
+    constexpr int PatchCount = 32;
+    constexpr float MaxTessellationLevel = 64.f;
+
+    // The number of frames that are rendered before the measurements start
+    constexpr unsigned int WarmupFrames = 100;
+
     // shader data
+    sgct::ShaderProgram program;
     GLint currTimeLoc = -1;
     GLint mvpLoc = -1;
     GLint mvLoc = -1;
     GLint mvLightLoc = -1;
     GLint nmLoc = -1;
+    GLint tessScaleLoc = -1;
+    GLint isFisheyeLoc = -1;
+    GLint fisheyeHalfFovLoc = -1;
+    GLint fisheyeScaleLoc = -1;
+    GLint fisheyeOffsetLoc = -1;
+    GLint fisheyeClipLoc = -1;
 
     unsigned int heightTextureId = 0;
     unsigned int normalTextureId = 0;
 
     GLuint vertexArray = 0;
     GLuint vertexPositionBuffer = 0;
+    GLuint indexBuffer = 0;
+    GLsizei nIndices = 0;
+
+    bool useTessellation = true;
+
+    // The tessellation level of an edge is its angular size in radians times this factor
+    float tessellationScale = 256.f;
+
+    // If this has a value, the draw calls are timed for this number of frames
+    std::optional<unsigned int> timingFrames;
+
+    struct WindowTiming {
+        sgct::GpuTimer timer = sgct::GpuTimer(1);
+        unsigned int frame = std::numeric_limits<unsigned int>::max();
+        int nDraws = 0;
+        int nDrawsPerFrame = 0;
+        std::vector<double> times;
+    };
+    std::map<const sgct::Window*, WindowTiming> timings;
 
     bool mPause = false;
 
@@ -46,7 +106,7 @@ namespace {
     };
     using Geometry = std::vector<Vertex>;
 
-    constexpr std::string_view VertexShader = R"(
+    constexpr std::string_view GridVertexShader = R"(
   #version 330 core
 
   layout(location = 0) in vec3 vertPositions;
@@ -80,6 +140,124 @@ namespace {
     gl_Position =  mvp * transformedVertex;
   })";
 
+    constexpr std::string_view PatchVertexShader = R"(
+  #version 410 core
+
+  out vec2 vsUv;
+
+  uniform int patchCount;
+
+  void main() {
+    // Each instance is one patch, whose corners are in the order that the tessellation
+    // evaluation shader interpolates them in
+    ivec2 patchIndex = ivec2(gl_InstanceID % patchCount, gl_InstanceID / patchCount);
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vsUv = (vec2(patchIndex) + corner) / float(patchCount);
+  })";
+
+    constexpr std::string_view TessellationControlShader = R"(
+  #version 410 core
+
+  layout(vertices = 4) out;
+
+  in vec2 vsUv[];
+  out vec2 tcsUv[];
+
+  uniform sampler2D hTex;
+  uniform float currTime;
+  uniform mat4 mv;
+  uniform float tessScale;
+  uniform float maxTessLevel;
+
+  vec3 viewPosition(vec2 uv) {
+    float vScale = 0.2 + 0.10 * sin(currTime);
+    float hVal = textureLod(hTex, uv, 0.0).r;
+    return vec3(mv * vec4(uv.x - 0.5, hVal * vScale, uv.y - 0.5, 1.0));
+  }
+
+  // The angular size of the edge is independent of the projection, so the level is the
+  // same for the planar, the cube map, and the direct fisheye rendering
+  float edgeLevel(vec3 a, vec3 b) {
+    float angle = distance(a, b) / max(length(0.5 * (a + b)), 1e-4);
+    return clamp(angle * tessScale, 1.0, maxTessLevel);
+  }
+
+  void main() {
+    tcsUv[gl_InvocationID] = vsUv[gl_InvocationID];
+
+    if (gl_InvocationID == 0) {
+      vec3 p0 = viewPosition(vsUv[0]);
+      vec3 p1 = viewPosition(vsUv[1]);
+      vec3 p2 = viewPosition(vsUv[2]);
+      vec3 p3 = viewPosition(vsUv[3]);
+
+      // The edges u = 0, v = 0, u = 1, and v = 1 of the quad domain
+      gl_TessLevelOuter[0] = edgeLevel(p0, p2);
+      gl_TessLevelOuter[1] = edgeLevel(p0, p1);
+      gl_TessLevelOuter[2] = edgeLevel(p1, p3);
+      gl_TessLevelOuter[3] = edgeLevel(p2, p3);
+      gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+      gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+    }
+  })";
+
+    constexpr std::string_view TessellationEvaluationShader = R"(
+  #version 410 core
+
+  layout(quads, fractional_odd_spacing, cw) in;
+
+  in vec2 tcsUv[];
+
+  out vec2 uv;
+  out float vScale; // Height scaling
+  out vec3 lightDir;
+  out vec3 v;
+
+  uniform sampler2D hTex;
+  uniform float currTime;
+  uniform mat4 mvp;
+  uniform mat4 mv;
+  uniform mat4 mvLight;
+  uniform vec4 lightPos;
+
+  uniform bool isFisheye;
+  uniform float fisheyeHalfFov;
+  uniform vec2 fisheyeScale;
+  uniform vec2 fisheyeOffset;
+  uniform vec2 fisheyeClip;
+
+  void main() {
+    uv = mix(
+      mix(tcsUv[0], tcsUv[1], gl_TessCoord.x),
+      mix(tcsUv[2], tcsUv[3], gl_TessCoord.x),
+      gl_TessCoord.y
+    );
+
+    vScale = 0.2 + 0.10 * sin(currTime);
+    float hVal = textureLod(hTex, uv, 0.0).r;
+    vec4 transformedVertex = vec4(uv.x - 0.5, hVal * vScale, uv.y - 0.5, 1.0);
+
+    v = vec3(mv * transformedVertex);
+    vec3 l = vec3(mvLight * lightPos);
+    lightDir = normalize(l - v);
+
+    if (isFisheye) {
+      // The fisheye looks along the negative z-axis of the view space
+      vec3 dir = normalize(v);
+      float theta = acos(clamp(-dir.z, -1.0, 1.0));
+      vec2 radial = length(dir.xy) > 0.0 ? normalize(dir.xy) : vec2(0.0);
+      vec2 ndc = theta / fisheyeHalfFov * radial * fisheyeScale + fisheyeOffset;
+      float depth =
+        2.0 * (length(v) - fisheyeClip.x) / (fisheyeClip.y - fisheyeClip.x) - 1.0;
+      gl_Position = vec4(ndc, depth, 1.0);
+      gl_ClipDistance[0] = fisheyeHalfFov - theta;
+    }
+    else {
+      gl_Position = mvp * transformedVertex;
+      gl_ClipDistance[0] = 1.0;
+    }
+  })";
+
     constexpr std::string_view FragmentShader = R"(
   #version 330 core
 
@@ -192,7 +370,76 @@ Geometry generateTerrainGrid(float width, float depth, int wRes, int dRes) {
     return res;
 }
 
+/**
+ * \return The names of the projections of the viewports of the \p window
+ */
+std::string projectionNames(const Window& window) {
+    std::vector<std::string_view> names;
+    for (const std::unique_ptr<Viewport>& vp : window.viewports()) {
+        const NonLinearProjection* p = vp->nonLinearProjection();
+        std::string_view name = "non-linear";
+        if (!p) {
+            name = "planar";
+        }
+        else if (dynamic_cast<const FisheyeProjection*>(p)) {
+            name = "fisheye";
+        }
+        else if (dynamic_cast<const CylindricalProjection*>(p)) {
+            name = "cylindrical";
+        }
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+    }
+
+    std::string res;
+    for (std::string_view name : names) {
+        res += res.empty() ? std::string(name) : std::format("+{}", name);
+    }
+    return res;
+}
+
+void logTimings() {
+    for (auto& [window, timing] : timings) {
+        std::vector<double>& times = timing.times;
+        if (times.empty()) {
+            continue;
+        }
+        std::sort(times.begin(), times.end());
+        const double mean =
+            std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        const double median = times[times.size() / 2];
+        const double p95 = times[std::min(times.size() * 95 / 100, times.size() - 1)];
+        Log::Info(std::format(
+            "Window {} ({}): {} draw calls per frame, GPU draw time over {} frames: "
+            "mean {:.3f} ms, median {:.3f} ms, 95th percentile {:.3f} ms, max {:.3f} ms",
+            window->id(), projectionNames(*window), timing.nDrawsPerFrame, times.size(),
+            mean * 1000.0, median * 1000.0, p95 * 1000.0, times.back() * 1000.0
+        ));
+    }
+}
+
 void draw(const RenderData& data) {
+    WindowTiming* timing = nullptr;
+    if (timingFrames) {
+        timing = &timings[&data.window];
+        const unsigned int frame = Engine::instance().currentFrameNumber();
+        if (timing->frame != frame) {
+            // The timer returns the results of the frame that was drawn its latency ago
+            timing->timer.beginFrame();
+            const bool isMeasured = frame >= WarmupFrames + GpuTimer::Latency &&
+                timing->times.size() < *timingFrames;
+            if (isMeasured) {
+                timing->times.push_back(timing->timer.time(0));
+            }
+            timing->frame = frame;
+            timing->nDrawsPerFrame = timing->nDraws;
+            timing->nDraws = 0;
+        }
+        timing->nDraws++;
+        timing->timer.begin(0);
+    }
+
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
@@ -214,8 +461,7 @@ void draw(const RenderData& data) {
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, normalTextureId);
 
-    const ShaderProgram& prog = ShaderManager::instance().shaderProgram("xform");
-    prog.bind();
+    program.bind();
 
     const glm::mat4 mvp =
         glm::make_mat4(data.modelViewProjectionMatrix.values.data()) * scene;
@@ -233,19 +479,45 @@ void draw(const RenderData& data) {
 
     glBindVertexArray(vertexArray);
 
-    // Draw the triangles
-    for (unsigned int i = 0; i < GridSize; i++) {
-        glDrawArrays(GL_TRIANGLE_STRIP, i * GridSize * 2, GridSize * 2);
+    if (useTessellation) {
+        glUniform1f(tessScaleLoc, tessellationScale);
+        glUniform1i(isFisheyeLoc, data.fisheye.has_value());
+        if (data.fisheye) {
+            glUniform1f(fisheyeHalfFovLoc, data.fisheye->halfFov);
+            glUniform2f(fisheyeScaleLoc, data.fisheye->scale.x, data.fisheye->scale.y);
+            glUniform2f(fisheyeOffsetLoc, data.fisheye->offset.x, data.fisheye->offset.y);
+            glUniform2f(fisheyeClipLoc, data.fisheye->nearClip, data.fisheye->farClip);
+            glEnable(GL_CLIP_DISTANCE0);
+        }
+
+        glPatchParameteri(GL_PATCH_VERTICES, 4);
+        glDrawArraysInstanced(GL_PATCHES, 0, 4, PatchCount * PatchCount);
+
+        glDisable(GL_CLIP_DISTANCE0);
+    }
+    else {
+        // All rows of the grid are drawn with one call as strips that are separated by
+        // the restart index
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(std::numeric_limits<GLuint>::max());
+        glDrawElements(GL_TRIANGLE_STRIP, nIndices, GL_UNSIGNED_INT, nullptr);
+        glDisable(GL_PRIMITIVE_RESTART);
     }
 
     glBindVertexArray(0);
 
-    prog.unbind();
+    program.unbind();
+
+    if (timing) {
+        timing->timer.end(0);
+    }
 }
 
 void preSync() {
     if (Engine::instance().isMaster() && !mPause) {
-        currentTime += Engine::instance().statistics().avgDt();
+        // The timed frames have to show the same scene on every run
+        const double dt = Engine::instance().statistics().avgDt();
+        currentTime += timingFrames ? 1.0 / 60.0 : dt;
     }
 }
 
@@ -261,24 +533,68 @@ void postSyncPreDraw() {
     }
 }
 
+void postDraw() {
+    if (!timingFrames) {
+        return;
+    }
+
+    // The frames are locked across the cluster, so all nodes finish in the same frame
+    const unsigned int frame = Engine::instance().currentFrameNumber();
+    if (frame == WarmupFrames + GpuTimer::Latency + *timingFrames) {
+        logTimings();
+        if (Engine::instance().isMaster()) {
+            Engine::instance().terminate();
+        }
+    }
+}
+
 void initOGL(GLFWwindow*) {
     stereoMode = Engine::instance().windows()[0]->stereoMode();
 
     heightTextureId = TextureManager::instance().loadTexture("heightmap.png", true, 0);
     normalTextureId = TextureManager::instance().loadTexture("normalmap.png", true, 0);
 
+    GLint major = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    if (useTessellation && major < 4) {
+        Log::Warning("Tessellation requires OpenGL 4.0, drawing the fixed grid instead");
+        useTessellation = false;
+    }
+
     // setup shader
-    ShaderManager::instance().addShaderProgram("xform", VertexShader, FragmentShader);
-    const ShaderProgram& prog = ShaderManager::instance().shaderProgram("xform");
-
-    prog.bind();
-    currTimeLoc = glGetUniformLocation(prog.id(), "currTime");
-    mvpLoc = glGetUniformLocation(prog.id(), "mvp");
-    mvLoc = glGetUniformLocation(prog.id(), "mv");
-    mvLightLoc = glGetUniformLocation(prog.id(), "mvLight");
-    nmLoc = glGetUniformLocation(prog.id(), "normalMatrix");
-    glUniform1i(glGetUniformLocation(prog.id(), "hTex"), 0);
-    glUniform1i(glGetUniformLocation(prog.id(), "nTex"), 1);
+    program = ShaderProgram("xform");
+    if (useTessellation) {
+        program.addVertexShader(PatchVertexShader);
+        program.addTessellationShaders(
+            TessellationControlShader,
+            TessellationEvaluationShader
+        );
+    }
+    else {
+        program.addVertexShader(GridVertexShader);
+    }
+    program.addFragmentShader(FragmentShader);
+    program.createAndLinkProgram();
+
+    program.bind();
+    currTimeLoc = glGetUniformLocation(program.id(), "currTime");
+    mvpLoc = glGetUniformLocation(program.id(), "mvp");
+    mvLoc = glGetUniformLocation(program.id(), "mv");
+    mvLightLoc = glGetUniformLocation(program.id(), "mvLight");
+    nmLoc = glGetUniformLocation(program.id(), "normalMatrix");
+    tessScaleLoc = glGetUniformLocation(program.id(), "tessScale");
+    isFisheyeLoc = glGetUniformLocation(program.id(), "isFisheye");
+    fisheyeHalfFovLoc = glGetUniformLocation(program.id(), "fisheyeHalfFov");
+    fisheyeScaleLoc = glGetUniformLocation(program.id(), "fisheyeScale");
+    fisheyeOffsetLoc = glGetUniformLocation(program.id(), "fisheyeOffset");
+    fisheyeClipLoc = glGetUniformLocation(program.id(), "fisheyeClip");
+    glUniform1i(glGetUniformLocation(program.id(), "hTex"), 0);
+    glUniform1i(glGetUniformLocation(program.id(), "nTex"), 1);
+    glUniform1i(glGetUniformLocation(program.id(), "patchCount"), PatchCount);
+    glUniform1f(
+        glGetUniformLocation(program.id(), "maxTessLevel"),
+        MaxTessellationLevel
+    );
 
     // light data
     const glm::vec4 position(-2.f, 5.f, 5.f, 1.f);
@@ -287,24 +603,31 @@ void initOGL(GLFWwindow*) {
     const glm::vec4 specular(1.f, 1.f, 1.f, 1.f);
 
     glUniform4fv(
-        glGetUniformLocation(prog.id(), "lightPos"), 1, glm::value_ptr(position)
+        glGetUniformLocation(program.id(), "lightPos"), 1, glm::value_ptr(position)
     );
     glUniform4fv(
-        glGetUniformLocation(prog.id(), "lightAmbient"), 1, glm::value_ptr(ambient)
+        glGetUniformLocation(program.id(), "lightAmbient"), 1, glm::value_ptr(ambient)
     );
     glUniform4fv(
-        glGetUniformLocation(prog.id(), "lightDiffuse"), 1, glm::value_ptr(diffuse)
+        glGetUniformLocation(program.id(), "lightDiffuse"), 1, glm::value_ptr(diffuse)
     );
     glUniform4fv(
-        glGetUniformLocation(prog.id(), "lightSpecular"), 1, glm::value_ptr(specular)
+        glGetUniformLocation(program.id(), "lightSpecular"), 1, glm::value_ptr(specular)
     );
-    prog.unbind();
-
-    Geometry geometry = generateTerrainGrid(1.f, 1.f, GridSize, GridSize);
+    program.unbind();
 
     glGenVertexArrays(1, &vertexArray);
     glBindVertexArray(vertexArray);
 
+    if (useTessellation) {
+        // The patches are generated from the instance and vertex ids, so the vertex
+        // array has no attributes
+        glBindVertexArray(0);
+        return;
+    }
+
+    Geometry geometry = generateTerrainGrid(1.f, 1.f, GridSize, GridSize);
+
     glGenBuffers(1, &vertexPositionBuffer);
     glBindBuffer(GL_ARRAY_BUFFER, vertexPositionBuffer);
     glBufferData(
@@ -325,6 +648,25 @@ void initOGL(GLFWwindow*) {
         reinterpret_cast<void*>(3 * sizeof(float))
     );
 
+    std::vector<GLuint> indices;
+    indices.reserve(GridSize * (GridSize * 2 + 1));
+    for (GLuint row = 0; row < GridSize; row++) {
+        for (GLuint i = 0; i < GridSize * 2; i++) {
+            indices.push_back(row * GridSize * 2 + i);
+        }
+        indices.push_back(std::numeric_limits<GLuint>::max());
+    }
+    nIndices = static_cast<GLsizei>(indices.size());
+
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(
+        GL_ELEMENT_ARRAY_BUFFER,
+        sizeof(GLuint) * indices.size(),
+        indices.data(),
+        GL_STATIC_DRAW
+    );
+
     glBindVertexArray(0);
 }
 
@@ -390,6 +732,15 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
 }
 
 void cleanup() {
+    for (auto& [window, timing] : timings) {
+        // The queries belong to the context of the window that they were used in
+        const_cast<Window*>(window)->makeOpenGLContextCurrent();
+        timing.timer.destroy();
+    }
+    Engine::instance().windows()[0]->makeOpenGLContextCurrent();
+
+    program.deleteProgram();
+    glDeleteBuffers(1, &indexBuffer);
     glDeleteBuffers(1, &vertexPositionBuffer);
     glDeleteVertexArrays(1, &vertexArray);
 }
@@ -397,11 +748,28 @@ void cleanup() {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
 
+    for (int i = 0; i < argc; i++) {
+        std::string_view argument = argv[i];
+
+        if (argument == "-grid") {
+            useTessellation = false;
+            Log::Info("Drawing the terrain as a fixed grid");
+        }
+        if (argument == "-tessscale" && argc > i + 1) {
+            tessellationScale = std::stof(argv[i + 1]);
+            Log::Info(std::format("Setting tessellation scale to {}", tessellationScale));
+        }
+        if (argument == "-timing" && argc > i + 1) {
+            timingFrames = static_cast<unsigned int>(std::stoi(argv[i + 1]));
+            Log::Info(std::format("Timing the draw calls for {} frames", *timingFrames));
+        }
+    }
+
     Engine::Callbacks callbacks;
     callbacks.initOpenGL = initOGL;
     callbacks.preSync = preSync;
@@ -409,6 +777,7 @@ int main(int argc, char** argv) {
     callbacks.decode = decode;
     callbacks.postSyncPreDraw = postSyncPreDraw;
     callbacks.draw = draw;
+    callbacks.postDraw = postDraw;
     callbacks.cleanup = cleanup;
     callbacks.keyboard = keyboard;
 
@@ -0,0 +1,69 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+// Turns the binary logs that the nodes write when the `binarylog` setting is set into
+// text. The events of all files that are passed are merged in the order of their time on
+// the master's clock, so that the events of the whole cluster can be read together:
+//   logdecoder binarylog-node0.sgctlog binarylog-node1.sgctlog > cluster.log
+
+#include <sgct/binarylog.h>
+#include <sgct/correction/mappedfile.h>
+#include <sgct/format.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: logdecoder <file> [<file> ...]\n");
+        return EXIT_FAILURE;
+    }
+
+    // The time of each line on the master's clock and the line itself
+    std::vector<std::pair<double, std::string>> lines;
+    for (int i = 1; i < argc; i++) {
+        std::unique_ptr<sgct::correction::MappedFile> file =
+            sgct::correction::MappedFile::map(argv[i]);
+        if (!file) {
+            std::fprintf(stderr, "Failed to open '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+
+        try {
+            // The time that starts each line is followed by the name of the file, so
+            // that the events of the nodes can be told apart
+            const std::string name = std::filesystem::path(argv[i]).stem().string();
+            for (std::string& line : sgct::BinaryLog::decode(file->data())) {
+                const size_t end = line.find(' ');
+                line.insert(end, std::format(" [{}]", name));
+                const double t = std::stod(line.substr(0, end));
+                lines.emplace_back(t, std::move(line));
+            }
+        }
+        catch (const std::runtime_error& e) {
+            std::fprintf(stderr, "Failed to decode '%s': %s\n", argv[i], e.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::stable_sort(
+        lines.begin(),
+        lines.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }
+    );
+    for (const std::pair<double, std::string>& line : lines) {
+        std::printf("%s\n", line.second.c_str());
+    }
+    return EXIT_SUCCESS;
+}
@@ -25,6 +25,8 @@ namespace {
     int mvpMatrixLoc = -1;
     int worldMatrixTransposeLoc = -1;
     int normalMatrixLoc = -1;
+    int radialDepthLoc = -1;
+    int clipPlanesLoc = -1;
 
     unsigned int textureId = 0;
 
@@ -42,6 +44,7 @@ namespace {
   out vec2 uv;
   out vec3 n;
   out vec4 p;
+  out vec3 viewPos;
 
   void main() {
     mat3 worldRotationInverse = mat3(worldMatrixTranspose);
@@ -50,25 +53,34 @@ namespace {
     uv = texCoords;
     n  = normalize(worldRotationInverse * normalMatrix * normals);
     p  = gl_Position;
+    viewPos = (transpose(worldMatrixTranspose) * vec4(vertPositions, 1.0)).xyz;
   })";
 
-    constexpr std::string_view FragmentShader = R"(
+    constexpr std::string_view FragmentShaderHeader = R"(
   #version 330 core
+)";
 
+    // The radial depth function of SGCT is inserted between the header and the body
+    constexpr std::string_view FragmentShaderBody = R"(
   in vec2 uv;
   in vec3 n;
   in vec4 p;
+  in vec3 viewPos;
 
   layout(location = 0) out vec4 diffuse;
   layout(location = 1) out vec3 normal;
   layout(location = 2) out vec3 position;
 
   uniform sampler2D tDiffuse;
+  uniform bool radialDepth;
+  uniform vec2 clipPlanes;
 
   void main() {
     diffuse = texture(tDiffuse, uv);
     normal = n;
     position = p.xyz;
+    gl_FragDepth = radialDepth ?
+      sgctRadialDepth(viewPos, clipPlanes.x, clipPlanes.y) : gl_FragCoord.z;
   }
 )";
 } // namespace
@@ -108,6 +120,11 @@ void draw(const RenderData& data) {
     glUniformMatrix4fv(worldMatrixTransposeLoc, 1, GL_TRUE, glm::value_ptr(mv));
     glUniformMatrix3fv(normalMatrixLoc, 1, GL_FALSE, glm::value_ptr(normalMatrix));
     glUniform1i(textureLoc, 0);
+    // The cube faces of a fisheye store the distance from the center in their depth
+    glUniform1i(radialDepthLoc, data.radialDepth.has_value() ? 1 : 0);
+    if (data.radialDepth) {
+        glUniform2f(clipPlanesLoc, data.radialDepth->nearClip, data.radialDepth->farClip);
+    }
 
     box->draw();
 
@@ -131,13 +148,17 @@ void postSyncPreDraw() {
 }
 
 void initOGL(GLFWwindow*) {
-    ShaderManager::instance().addShaderProgram("MRT", VertexShader, FragmentShader);
+    const std::string fragmentShader = std::string(FragmentShaderHeader) +
+        std::string(RenderData::RadialDepth::Function) + std::string(FragmentShaderBody);
+    ShaderManager::instance().addShaderProgram("MRT", VertexShader, fragmentShader);
     const ShaderProgram& prg = ShaderManager::instance().shaderProgram("MRT");
     prg.bind();
     textureLoc = glGetUniformLocation(prg.id(), "tDiffuse");
     worldMatrixTransposeLoc = glGetUniformLocation(prg.id(), "worldMatrixTranspose");
     mvpMatrixLoc = glGetUniformLocation(prg.id(), "mvpMatrix");
     normalMatrixLoc = glGetUniformLocation(prg.id(), "normalMatrix");
+    radialDepthLoc = glGetUniformLocation(prg.id(), "radialDepth");
+    clipPlanesLoc = glGetUniformLocation(prg.id(), "clipPlanes");
 
     prg.bind();
     textureId = TextureManager::instance().loadTexture("box.png", true, 8.f);
@@ -179,17 +200,19 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
 
     if (cluster.settings) {
+        cluster.settings->useDepthTexture = true;
         cluster.settings->useNormalTexture = true;
         cluster.settings->usePositionTexture = true;
     }
     else {
         config::Settings settings;
+        settings.useDepthTexture = true;
         settings.useNormalTexture = true;
         settings.usePositionTexture = true;
         cluster.settings = settings;
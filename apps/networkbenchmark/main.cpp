@@ -0,0 +1,420 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+// Measures the cost of synchronizing the shared data and of transferring data between
+// the master and the clients. The master synchronizes payloads of increasing sizes for a
+// number of frames each and afterwards sends blocks of data of increasing sizes through
+// the data transfer connections. The transport is selected by the network settings of
+// the cluster configuration, so that each option can be measured by running the
+// benchmark with a different configuration. The master writes the percentiles of all
+// measurements into a JSON file and terminates the cluster when it is done.
+//
+// Locally, every node is started in its own process:
+//   networkbenchmark -c two_nodes.json --local 0
+//   networkbenchmark -c two_nodes.json --local 1 --client
+
+#include <sgct/sgct.h>
+#include <sgct/opengl.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace {
+    // The sizes of the payloads in bytes that are synchronized, in this order
+    std::vector<int> payloadSizes = { 0, 1024, 16384, 262144, 1048576, 4194304 };
+
+    // The sizes of the blocks in bytes that are sent through the data transfer
+    std::vector<int> transferSizes = { 65536, 1048576, 16777216 };
+
+    // The number of frames that are measured for each payload size, after the warm-up
+    // frames in which the connections adapt to the new size
+    int nFrames = 500;
+    constexpr int WarmupFrames = 50;
+
+    // The number of blocks that are sent for each transfer size
+    int nTransfers = 10;
+
+    // If this is true, the payloads consist of a repeated pattern instead of random bytes
+    // so that the compression of the network settings can be measured
+    bool isCompressible = false;
+
+    std::filesystem::path outputPath = "networkbenchmark.json";
+
+    struct ReportedSettings {
+        bool compression = false;
+        bool deltaSync = false;
+        bool sharedMemory = false;
+        bool pipelinedSync = false;
+        bool eventDriven = false;
+        bool parallelSend = false;
+        std::string multicastAddress;
+    } transport;
+
+    // Shared between the master and the clients
+    std::vector<std::byte> payload;
+    uint32_t frameNumber = 0;
+
+    // The state of the master
+    enum class Phase { Sync, Transfer, Done };
+    Phase phase = Phase::Sync;
+    size_t sizeIndex = 0;
+    int frameInSize = 0;
+    double postDrawTime = 0.0;
+
+    struct SyncSamples {
+        int size = 0;
+        // The time the master spent sending the payload to the slowest client
+        std::vector<double> sendTimes;
+        // The time between sending the frame's data and receiving the acknowledgement
+        // of the slowest client, which includes the network latency in both directions
+        std::vector<double> roundTrips;
+        // The time the master waited for the clients after it had drawn its own frame
+        std::vector<double> waitTimes;
+        std::vector<double> frameTimes;
+    };
+    std::vector<SyncSamples> syncResults;
+
+    struct TransferSamples {
+        int size = 0;
+        // The time between starting to send a block and the acknowledgement of the last
+        // client
+        std::vector<double> roundTrips;
+    };
+    std::vector<TransferSamples> transferResults;
+
+    std::vector<std::byte> transferBlock;
+    int transferInSize = 0;
+    std::atomic_int nAcknowledged = 0;
+    std::atomic_bool isTransferInFlight = false;
+    double transferStartTime = 0.0;
+    int nClients = 0;
+
+    // Fills the payload with bytes that only depend on the frame number, so that every
+    // frame sends new data that cannot be reused by delta synchronization
+    void fillPayload(std::vector<std::byte>& buffer, size_t size, uint32_t seed) {
+        buffer.resize(size);
+        if (isCompressible) {
+            for (size_t i = 0; i < size; i++) {
+                buffer[i] = static_cast<std::byte>((i / 64 + seed) & 0xFF);
+            }
+            return;
+        }
+
+        // xorshift32, which cannot start from 0
+        uint32_t state = seed * 2654435761u + 1;
+        for (size_t i = 0; i < size; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            buffer[i] = static_cast<std::byte>(state & 0xFF);
+        }
+    }
+
+    std::vector<int> parseSizes(std::string_view list) {
+        std::vector<int> res;
+        while (!list.empty()) {
+            const size_t comma = list.find(',');
+            const std::string_view item = list.substr(0, comma);
+            int value = 0;
+            std::from_chars(item.data(), item.data() + item.size(), value);
+            res.push_back(value);
+            list = comma == std::string_view::npos ? "" : list.substr(comma + 1);
+        }
+        return res;
+    }
+
+    // Uses the nearest rank, so that every reported value has actually been measured
+    double percentile(const std::vector<double>& sorted, double p) {
+        const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    std::string summarize(std::vector<double> values, double scale) {
+        if (values.empty()) {
+            return "null";
+        }
+
+        std::sort(values.begin(), values.end());
+        const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+        return std::format(
+            R"({{ "mean": {}, "min": {}, "p50": {}, "p90": {}, "p95": {}, "p99": {}, )"
+            R"("max": {} }})",
+            sum / values.size() * scale, values.front() * scale,
+            percentile(values, 0.5) * scale, percentile(values, 0.9) * scale,
+            percentile(values, 0.95) * scale, percentile(values, 0.99) * scale,
+            values.back() * scale
+        );
+    }
+
+    void writeResults() {
+        std::string sync;
+        for (const SyncSamples& s : syncResults) {
+            sync += std::format(
+                "{}    {{\n"
+                "      \"bytes\": {},\n"
+                "      \"sendMs\": {},\n"
+                "      \"roundTripMs\": {},\n"
+                "      \"waitMs\": {},\n"
+                "      \"frameMs\": {}\n"
+                "    }}",
+                sync.empty() ? "" : ",\n", s.size, summarize(s.sendTimes, 1000.0),
+                summarize(s.roundTrips, 1000.0), summarize(s.waitTimes, 1000.0),
+                summarize(s.frameTimes, 1000.0)
+            );
+        }
+
+        std::string transfer;
+        for (const TransferSamples& t : transferResults) {
+            // The throughput of each block to each of the clients in megabytes per second
+            std::vector<double> throughputs;
+            for (double roundTrip : t.roundTrips) {
+                throughputs.push_back(t.size / roundTrip / 1e6);
+            }
+            transfer += std::format(
+                "{}    {{\n"
+                "      \"bytes\": {},\n"
+                "      \"roundTripMs\": {},\n"
+                "      \"megabytesPerSecond\": {}\n"
+                "    }}",
+                transfer.empty() ? "" : ",\n", t.size, summarize(t.roundTrips, 1000.0),
+                summarize(std::move(throughputs), 1.0)
+            );
+        }
+
+        std::ofstream file = std::ofstream(outputPath);
+        file << std::format(
+            "{{\n"
+            "  \"clients\": {},\n"
+            "  \"frames\": {},\n"
+            "  \"compressiblePayload\": {},\n"
+            "  \"transport\": {{\n"
+            "    \"compression\": {},\n"
+            "    \"deltaSync\": {},\n"
+            "    \"sharedMemory\": {},\n"
+            "    \"pipelinedSync\": {},\n"
+            "    \"eventDriven\": {},\n"
+            "    \"parallelSend\": {},\n"
+            "    \"multicastAddress\": \"{}\"\n"
+            "  }},\n"
+            "  \"sync\": [\n{}\n  ],\n"
+            "  \"transfer\": [\n{}\n  ]\n"
+            "}}\n",
+            nClients, nFrames, isCompressible, transport.compression, transport.deltaSync,
+            transport.sharedMemory, transport.pipelinedSync, transport.eventDriven,
+            transport.parallelSend, transport.multicastAddress, sync, transfer
+        );
+        if (file.good()) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            //        formatting std::filesystem::path
+            sgct::Log::Info(std::format(
+                "Network benchmark results written to '{}'", outputPath.string()
+            ));
+        }
+        else {
+            sgct::Log::Error(std::format(
+                "Could not write network benchmark results to '{}'", outputPath.string()
+            ));
+        }
+    }
+} // namespace
+
+using namespace sgct;
+
+void startTransfer() {
+    const TransferSamples& current = transferResults.back();
+    fillPayload(transferBlock, current.size, static_cast<uint32_t>(transferInSize));
+
+    nAcknowledged = 0;
+    isTransferInFlight = true;
+    transferStartTime = time();
+    NetworkManager::instance().transferData(
+        transferBlock.data(),
+        current.size,
+        transferInSize
+    );
+}
+
+void preSync() {
+    if (!Engine::instance().isMaster()) {
+        return;
+    }
+
+    frameNumber++;
+    if (phase == Phase::Sync) {
+        if (postDrawTime > 0.0 && frameInSize > WarmupFrames) {
+            syncResults.back().waitTimes.push_back(time() - postDrawTime);
+        }
+
+        if (frameInSize == WarmupFrames + nFrames) {
+            sizeIndex++;
+            frameInSize = 0;
+        }
+        if (sizeIndex == payloadSizes.size()) {
+            payload.clear();
+            sizeIndex = 0;
+            const bool hasTransfers = nClients > 0 && !transferSizes.empty();
+            phase = hasTransfers ? Phase::Transfer : Phase::Done;
+            if (hasTransfers) {
+                transferResults.push_back({ .size = transferSizes[0] });
+                startTransfer();
+            }
+        }
+        else {
+            if (frameInSize == 0) {
+                Log::Info(std::format("Synchronizing {} bytes", payloadSizes[sizeIndex]));
+                syncResults.push_back({ .size = payloadSizes[sizeIndex] });
+            }
+            fillPayload(payload, payloadSizes[sizeIndex], frameNumber);
+            frameInSize++;
+        }
+    }
+    else if (phase == Phase::Transfer && !isTransferInFlight) {
+        transferInSize++;
+        if (transferInSize == nTransfers) {
+            sizeIndex++;
+            transferInSize = 0;
+            if (sizeIndex == transferSizes.size()) {
+                phase = Phase::Done;
+            }
+            else {
+                transferResults.push_back({ .size = transferSizes[sizeIndex] });
+            }
+        }
+        if (phase != Phase::Done) {
+            startTransfer();
+        }
+    }
+
+    if (phase == Phase::Done) {
+        writeResults();
+        Engine::instance().terminate();
+    }
+}
+
+void postDraw() {
+    if (!Engine::instance().isMaster() || phase != Phase::Sync) {
+        return;
+    }
+
+    postDrawTime = time();
+    if (frameInSize <= WarmupFrames || syncResults.empty()) {
+        return;
+    }
+
+    const Engine::Statistics& stats = Engine::instance().statistics();
+    SyncSamples& samples = syncResults.back();
+    if (stats.sendTimeMax.size() > 0) {
+        samples.sendTimes.push_back(stats.sendTimeMax.newest());
+    }
+    if (stats.loopTimeMax.size() > 0) {
+        samples.roundTrips.push_back(stats.loopTimeMax.newest());
+    }
+    samples.frameTimes.push_back(stats.dt());
+}
+
+std::vector<std::byte> encode() {
+    std::vector<std::byte> data;
+    serializeObject(data, frameNumber);
+    serializeObject(data, payload);
+    return data;
+}
+
+void decode(const std::vector<std::byte>& data) {
+    unsigned int pos = 0;
+    deserializeObject(data, pos, frameNumber);
+    deserializeObject(data, pos, payload);
+}
+
+void dataTransferDecoder(void*, int, int, int) {
+    // The data is acknowledged once this function returns, so nothing has to be done
+}
+
+void dataTransferAcknowledge(int packageId, int) {
+    if (packageId != transferInSize || !isTransferInFlight) {
+        return;
+    }
+
+    if (++nAcknowledged == nClients) {
+        transferResults.back().roundTrips.push_back(time() - transferStartTime);
+        isTransferInFlight = false;
+    }
+}
+
+void keyboard(Key key, Modifier, Action action, int, Window*) {
+    if (key == Key::Esc && action == Action::Press) {
+        Engine::instance().terminate();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> arg(argv + 1, argv + argc);
+    Configuration config = parseArguments(arg);
+    config::Cluster cluster = loadCluster(config);
+    if (!cluster.success) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < arg.size(); i++) {
+        const bool hasValue = i + 1 < arg.size();
+        if (arg[i] == "--sizes" && hasValue) {
+            payloadSizes = parseSizes(arg[++i]);
+        }
+        else if (arg[i] == "--transfer-sizes" && hasValue) {
+            transferSizes = parseSizes(arg[++i]);
+        }
+        else if (arg[i] == "--frames" && hasValue) {
+            nFrames = std::max(std::stoi(arg[++i]), 1);
+        }
+        else if (arg[i] == "--transfers" && hasValue) {
+            nTransfers = std::max(std::stoi(arg[++i]), 1);
+        }
+        else if (arg[i] == "--compressible") {
+            isCompressible = true;
+        }
+        else if (arg[i] == "--output" && hasValue) {
+            outputPath = arg[++i];
+        }
+    }
+
+    if (cluster.settings && cluster.settings->network) {
+        const config::Settings::Network& n = *cluster.settings->network;
+        transport.compression = n.compression.value_or(false);
+        transport.deltaSync = n.deltaSync.value_or(false);
+        transport.sharedMemory = n.sharedMemory.value_or(false);
+        transport.pipelinedSync = n.pipelinedSync.value_or(false);
+        transport.eventDriven = n.eventDriven.value_or(false);
+        transport.parallelSend = n.parallelSend.value_or(false);
+        transport.multicastAddress = n.multicastAddress.value_or("");
+    }
+    nClients = static_cast<int>(cluster.nodes.size()) - 1;
+
+    Engine::Callbacks callbacks;
+    callbacks.preSync = preSync;
+    callbacks.encode = encode;
+    callbacks.decode = decode;
+    callbacks.postDraw = postDraw;
+    callbacks.keyboard = keyboard;
+    callbacks.dataTransferDecode = dataTransferDecoder;
+    callbacks.dataTransferAcknowledge = dataTransferAcknowledge;
+
+    try {
+        Engine::create(cluster, callbacks, config);
+    }
+    catch (const std::runtime_error& e) {
+        Log::Error(e.what());
+        Engine::destroy();
+        return EXIT_FAILURE;
+    }
+
+    Engine::instance().exec();
+    Engine::destroy();
+    exit(EXIT_SUCCESS);
+}
@@ -203,9 +203,9 @@ Box::~Box() {
     glDeleteBuffers(1, &_vbo);
 }
 
-void Box::draw() const {
+void Box::draw(int nInstances) const {
     glBindVertexArray(_vao);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, nInstances);
     glBindVertexArray(0);
 }
 
@@ -26,7 +26,10 @@ public:
      */
     ~Box();
 
-     void draw() const;
+    /**
+     * Draws the box \p nInstances times with a single draw call.
+     */
+    void draw(int nInstances = 1) const;
 
 private:
     unsigned int _vao = 0;
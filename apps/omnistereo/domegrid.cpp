@@ -81,17 +81,18 @@ DomeGrid::~DomeGrid() {
     glDeleteBuffers(1, &_vbo);
 }
 
-void DomeGrid::draw() const {
+void DomeGrid::draw(int nInstances) const {
     glBindVertexArray(_vao);
 
     for (int r = 0; r < _rings; r++) {
-        glDrawArrays(GL_LINE_LOOP, r * _resolution, _resolution);
+        glDrawArraysInstanced(GL_LINE_LOOP, r * _resolution, _resolution, nInstances);
     }
     for (int s = 0; s < _segments; s++) {
-        glDrawArrays(
+        glDrawArraysInstanced(
             GL_LINE_STRIP,
             _rings * _resolution + s * ((_resolution / 4) + 1),
-            (_resolution / 4) + 1
+            (_resolution / 4) + 1,
+            nInstances
         );
     }
 
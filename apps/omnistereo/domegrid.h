@@ -24,7 +24,10 @@ public:
      */
     ~DomeGrid();
 
-    void draw() const;
+    /**
+     * Draws the grid \p nInstances times with a single draw call per line.
+     */
+    void draw(int nInstances = 1) const;
 
 private:
     const int _resolution;
@@ -17,7 +17,6 @@
 
 namespace {
     constexpr float Diameter = 14.8f;
-    constexpr float Tilt = glm::radians(30.f);
 
     std::unique_ptr<Box> box;
     std::unique_ptr<DomeGrid> grid;
@@ -30,19 +29,13 @@ namespace {
     double currentTime = 0.0;
     bool takeScreenshot = true;
 
-    struct OmniData {
-        std::map<sgct::FrustumMode, glm::mat4> viewProjectionMatrix;
-        bool enabled = false;
-    };
-    std::vector<std::vector<OmniData>> omniProjections;
-    bool omniInited = false;
-
-    // Parameters to control omni rendering
-    bool maskOutSimilarities = false;
-    int tileSize = 2;
+    // The shaders that draw one instance per omni stereo tile
+    GLint omniMatrixLoc = -1;
+    GLint omniGridMatrixLoc = -1;
 
     std::string turnMapSrc;
     std::string sepMapSrc;
+    std::optional<int> tileSize;
 
     constexpr std::string_view BaseVertexShader = R"(
   #version 330 core
@@ -91,262 +84,60 @@ namespace {
   void main() { color = vec4(1.0, 0.5, 0.0, 1.0); }
 )";
 
-   unsigned char getSampleAt(const sgct::Image& img, int x, int y) {
-       const int width = img.size().x;
-       const size_t idx = (y * width + x) * img.channels() * img.bytesPerChannel();
-       return img.data()[idx];
-   }
-
-   float getInterpolatedSampleAt(const sgct::Image& img, float x, float y) {
-       int px = static_cast<int>(x); //floor x
-       int py = static_cast<int>(y); //floor y
-
-       // Calculate the weights for each pixel
-       float fx = x - static_cast<float>(px);
-       float fy = y - static_cast<float>(py);
+   // Every instance is drawn into the omni stereo tile with the index of the instance
+   static_assert(sgct::RenderData::OmniStereo::MaxTiles == 192);
+   constexpr std::string_view OmniTile = R"(
+  struct Tile {
+    mat4 viewProjection;
+    vec4 rect;
+  };
+  layout(std140) uniform OmniStereoTiles {
+    Tile tiles[192];
+  };
+
+  vec4 tilePosition(vec4 p) {
+    Tile tile = tiles[gl_InstanceID];
+    vec4 clip = tile.viewProjection * p;
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    gl_ClipDistance[2] = clip.w + clip.y;
+    gl_ClipDistance[3] = clip.w - clip.y;
+    return vec4(clip.xy * tile.rect.zw + tile.rect.xy * clip.w, clip.zw);
+  }
+)";
 
-       //if no need for interpolation
-       if (fx == 0.f && fy == 0.f) {
-           return static_cast<float>(getSampleAt(img, px, py));
-       }
+   constexpr std::string_view OmniVertexShader = R"(
+  layout(location = 0) in vec2 texCoords;
+  layout(location = 1) in vec3 normals;
+  layout(location = 2) in vec3 vertPositions;
 
-       float fx1 = 1.0f - fx;
-       float fy1 = 1.0f - fy;
+  uniform mat4 model;
+  out vec2 uv;
 
-       float w0 = fx1 * fy1;
-       float w1 = fx * fy1;
-       float w2 = fx1 * fy;
-       float w3 = fx * fy;
+  void main() {
+    gl_Position = tilePosition(model * vec4(vertPositions, 1.0));
+    uv = texCoords;
+  })";
 
-       float p0 = static_cast<float>(getSampleAt(img, px, py));
-       float p1 = static_cast<float>(getSampleAt(img, px, py + 1));
-       float p2 = static_cast<float>(getSampleAt(img, px + 1, py));
-       float p3 = static_cast<float>(getSampleAt(img, px + 1, py + 1));
+   constexpr std::string_view OmniGridVertexShader = R"(
+  layout(location = 0) in vec3 vertPositions;
 
-       return p0 * w0 + p1 * w1 + p2 * w2 + p3 * w3;
-   }
+  uniform mat4 model;
 
+  void main() {
+    gl_Position = tilePosition(model * vec4(vertPositions, 1.0));
+  })";
 
 } // namespace
 
 using namespace sgct;
 
-void renderGrid(glm::mat4 transform) {
-    glUniformMatrix4fv(gridMatrixLoc, 1, GL_FALSE, glm::value_ptr(transform));
-    grid->draw();
+void renderGrid(glm::mat4 transform, GLint location, int nInstances = 1) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(transform));
+    grid->draw(nInstances);
 }
 
-void initOmniStereo(bool mask) {
-    double t0 = time();
-
-    if (Engine::instance().windows().size() < 2) {
-        Log::Error("Failed to allocate omni stereo in secondary window");
-        return;
-    }
-
-    Image turnMap;
-    turnMap.load(turnMapSrc);
-
-    Image sepMap;
-    sepMap.load(sepMapSrc);
-
-    Window& win = *Engine::instance().windows()[1];
-    const ivec2 res = ivec2{
-        win.framebufferResolution().x / tileSize,
-        win.framebufferResolution().y / tileSize
-    };
-
-    Log::Info(std::format(
-        "Allocating: {} MB data", (sizeof(OmniData) * res.x * res.y) / (1024 * 1024)
-    ));
-    omniProjections.resize(res.x);
-    for (int i = 0; i < res.x; i++) {
-        omniProjections[i].resize(res.y);
-    }
-
-    int VPCounter = 0;
-
-    for (int eye = 0; eye <= 2; eye++) {
-        float eyeSep = Engine::instance().defaultUser().eyeSeparation();
-
-        FrustumMode fm;
-        glm::vec3 eyePos;
-        switch (eye) {
-            case 0:
-            default:
-                fm = FrustumMode::Mono;
-                eyePos = glm::vec3{ 0.f, 0.f, 0.f };
-                break;
-            case 1:
-                fm = FrustumMode::StereoLeft;
-                eyePos = glm::vec3{ -eyeSep / 2.f, 0.f, 0.f };
-                break;
-            case 2:
-                fm = FrustumMode::StereoRight;
-                eyePos = glm::vec3{ eyeSep / 2.f, 0.f, 0.f };
-                break;
-        }
-
-        for (int y = 0; y < res.y; y++) {
-            for (int x = 0; x < res.x; x++) {
-                // scale to [-1, 1)
-                // Center of each pixel
-                const float xResf = static_cast<float>(res.x);
-                const float yResf = static_cast<float>(res.y);
-                const float s = ((static_cast<float>(x) + 0.5f) / xResf - 0.5f) * 2.f;
-                const float t = ((static_cast<float>(y) + 0.5f) / yResf - 0.5f) * 2.f;
-                const float r2 = s * s + t * t;
-
-                constexpr float fovInDegrees = 180.f;
-                constexpr float halfFov = glm::radians(fovInDegrees / 2.f);
-
-                const float phi = sqrt(r2) * halfFov;
-                const float theta = atan2(s, -t);
-
-                const glm::vec3 normalPosition = {
-                    sin(phi) * sin(theta),
-                    -sin(phi) * cos(theta),
-                    cos(phi)
-                };
-
-                float tmpY = normalPosition.y * cos(Tilt) - normalPosition.z * sin(Tilt);
-                float eyeRot = atan2(normalPosition.x, -tmpY);
-
-                // get corresponding map positions
-                bool omniNeeded = true;
-                if (turnMap.channels() > 0) {
-                    const glm::vec2 turnMapPos = {
-                        (x / xResf) * static_cast<float>(turnMap.size().x - 1),
-                        (y / yResf) * static_cast<float>(turnMap.size().y - 1)
-                    };
-
-                    // inverse gamma
-                    const float headTurnMultiplier = pow(
-                        getInterpolatedSampleAt(
-                            turnMap,
-                            turnMapPos.x,
-                            turnMapPos.y
-                        ) / 255.f,
-                        2.2f
-                    );
-
-                    if (headTurnMultiplier == 0.f) {
-                        omniNeeded = false;
-                    }
-
-                    eyeRot *= headTurnMultiplier;
-                }
-
-                glm::vec3 newEyePos;
-                if (sepMap.channels() > 0) {
-                    const glm::vec2 sepMapPos = {
-                        (x / xResf) * static_cast<float>(sepMap.size().x - 1),
-                        (y / yResf) * static_cast<float>(sepMap.size().y - 1)
-                    };
-
-                    // inverse gamma 2.2
-                    const float separationMultiplier = pow(
-                        getInterpolatedSampleAt(
-                            sepMap,
-                            sepMapPos.x,
-                            sepMapPos.y
-                        ) / 255.f,
-                        2.2f
-                    );
-
-                    if (separationMultiplier == 0.f) {
-                        omniNeeded = false;
-                    }
-
-                    // get values at positions
-                    newEyePos = eyePos * separationMultiplier;
-                }
-                else {
-                    newEyePos = eyePos;
-                }
-
-                // IF VALID
-                if (r2 <= 1.1f && (omniNeeded || !mask)) {
-                    auto convertCoords = [&](glm::vec2 tc) {
-                        //scale to [-1, 1)
-                        const float ss = ((x + tc.x) / xResf - 0.5f) * 2.f;
-                        const float tt = ((y + tc.y) / yResf - 0.5f) * 2.f;
-
-                        const float rr2 = ss * ss + tt * tt;
-                        // zenith - elevation (0 degrees in zenith, 90 degrees at the rim)
-                        const float phi2 = sqrt(rr2) * halfFov;
-                        // azimuth (0 degrees at back of dome and 180 degrees at front)
-                        const float theta2 = atan2(ss, tt);
-
-                        constexpr float radius = Diameter / 2.f;
-                        glm::vec3 p = {
-                            radius * sin(phi2) * sin(theta2),
-                            radius * -sin(phi2) * cos(theta2),
-                            radius * cos(phi2)
-                        };
-
-                        const glm::mat4 rotMat = glm::rotate(
-                            glm::mat4(1.f),
-                            glm::radians(-90.f),
-                            glm::vec3(1.f, 0.f, 0.f)
-                        );
-                        glm::vec3 convPos = glm::mat3(rotMat) * p;
-                        return vec3{ convPos.x, convPos.y, convPos.z };
-                    };
-
-
-                    ProjectionPlane projPlane;
-
-                    projPlane.setCoordinates(
-                        convertCoords(glm::vec2(0.f, 0.f)),
-                        convertCoords(glm::vec2(0.f, 1.f)),
-                        convertCoords(glm::vec2(1.f, 1.f))
-                    );
-
-                    const glm::mat4 rotEyeMat = glm::rotate(
-                        glm::mat4(1.f),
-                        eyeRot,
-                        glm::vec3(0.f, -1.f, 0.f)
-                    );
-                    const glm::vec3 rotatedEyePos = glm::mat3(rotEyeMat) * newEyePos;
-
-                    // tilt
-                    const glm::mat4 tiltEyeMat = glm::rotate(
-                        glm::mat4(1.f),
-                        Tilt,
-                        glm::vec3(1.f, 0.f, 0.f)
-                    );
-
-                    const glm::vec3 tiltedEyePos = glm::mat3(tiltEyeMat) * rotatedEyePos;
-
-                    // calc projection
-                    Projection proj;
-                    proj.calculateProjection(
-                        vec3{ tiltedEyePos.x, tiltedEyePos.y, tiltedEyePos.z },
-                        projPlane,
-                        Engine::instance().nearClipPlane(),
-                        Engine::instance().farClipPlane()
-                    );
-
-                    omniProjections[x][y].enabled = true;
-                    omniProjections[x][y].viewProjectionMatrix[fm] = glm::make_mat4(
-                        proj.viewProjectionMatrix().values.data()
-                    );
-                    VPCounter++;
-                }
-            }
-        }
-    }
-
-    int percentage = (100 * VPCounter) / (res.x * res.y * 3);
-    Log::Info(std::format(
-        "Time to init viewports: {} s\n{} %% will be rendered",
-        time() - t0, percentage
-    ));
-    omniInited = true;
-}
-
-void renderBoxes(glm::mat4 transform) {
+void renderBoxes(glm::mat4 transform, GLint location, int nInstances = 1) {
     // create scene transform
     const glm::mat4 levels[3] = {
         glm::translate(glm::mat4(1.f), glm::vec3(0.f, -0.5f, -3.f)),
@@ -364,60 +155,35 @@ void renderBoxes(glm::mat4 transform) {
             );
 
             boxTrans = transform * rot * levels[l];
-            glUniformMatrix4fv(matrixLoc, 1, GL_FALSE, glm::value_ptr(boxTrans));
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(boxTrans));
 
-            box->draw();
+            box->draw(nInstances);
         }
     }
 }
 
 void drawOmniStereo(const RenderData& renderData) {
-    if (!omniInited) {
-        return;
-    }
-
-    double t0 = time();
+    // The library calls this once per batch of tiles, each of which is one instance
+    const int nTiles = renderData.omniStereo->nTiles;
 
-    Window& win = *Engine::instance().windows()[1];
-    ivec2 res = ivec2{
-        win.framebufferResolution().x / tileSize,
-        win.framebufferResolution().y / tileSize
-    };
-
-    ShaderManager::instance().shaderProgram("xform").bind();
+    ShaderManager::instance().shaderProgram("xformOmni").bind();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textureId);
-
-    FrustumMode fm = renderData.frustumMode;
-    for (int x = 0; x < res.x; x++) {
-        for (int y = 0; y < res.y; y++) {
-            if (omniProjections[x][y].enabled) {
-                glViewport(x * tileSize, y * tileSize, tileSize, tileSize);
-                const glm::mat4 vp = omniProjections[x][y].viewProjectionMatrix[fm];
-                renderBoxes(vp * glm::make_mat4(renderData.modelMatrix.values.data()));
-            }
-        }
-    }
-
-    ShaderManager::instance().shaderProgram("grid").bind();
-    for (int x = 0; x < res.x; x++) {
-        for (int y = 0; y < res.y; y++) {
-            if (omniProjections[x][y].enabled) {
-                glViewport(x * tileSize, y * tileSize, tileSize, tileSize);
-                const glm::mat4 vp = omniProjections[x][y].viewProjectionMatrix[fm];
-                renderGrid(vp);
-            }
-        }
-    }
-
-    Log::Info(std::format("Time to draw frame: {}s", time() - t0));
+    renderBoxes(
+        glm::make_mat4(renderData.modelMatrix.values.data()),
+        omniMatrixLoc,
+        nTiles
+    );
+
+    ShaderManager::instance().shaderProgram("gridOmni").bind();
+    renderGrid(glm::mat4(1.f), omniGridMatrixLoc, nTiles);
 }
 
 void draw(const RenderData& data) {
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
-    if (data.window.id() == 1) {
+    if (data.omniStereo) {
         drawOmniStereo(data);
     }
     else {
@@ -425,13 +191,13 @@ void draw(const RenderData& data) {
             glm::make_mat4(data.viewMatrix.values.data());
 
         ShaderManager::instance().shaderProgram("grid").bind();
-        renderGrid(vp);
+        renderGrid(vp, gridMatrixLoc);
 
         ShaderManager::instance().shaderProgram("xform").bind();
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, textureId);
-        renderBoxes(vp * glm::make_mat4(data.modelMatrix.values.data()));
+        renderBoxes(vp * glm::make_mat4(data.modelMatrix.values.data()), matrixLoc);
     }
 
     glDisable(GL_CULL_FACE);
@@ -481,7 +247,32 @@ void initOGL(GLFWwindow*) {
     glUniform1i(textureLoc, 0);
     xformProg.unbind();
 
-    initOmniStereo(maskOutSimilarities);
+    auto addOmniProgram = [&sm](const std::string& name, std::string_view vertexShader,
+                                std::string_view fragmentShader) -> const ShaderProgram&
+    {
+        const std::string vert = std::format(
+            "#version 330 core\n{}{}", OmniTile, vertexShader
+        );
+        sm.addShaderProgram(name, vert, fragmentShader);
+        const ShaderProgram& prog = sm.shaderProgram(name);
+        glUniformBlockBinding(
+            prog.id(),
+            glGetUniformBlockIndex(prog.id(), "OmniStereoTiles"),
+            RenderData::OmniStereo::UniformBinding
+        );
+        return prog;
+    };
+
+    const ShaderProgram& omniProg =
+        addOmniProgram("xformOmni", OmniVertexShader, BaseFragmentShader);
+    omniProg.bind();
+    omniMatrixLoc = glGetUniformLocation(omniProg.id(), "model");
+    glUniform1i(glGetUniformLocation(omniProg.id(), "tex"), 0);
+    omniProg.unbind();
+
+    const ShaderProgram& omniGridProg =
+        addOmniProgram("gridOmni", OmniGridVertexShader, GridFragmentShader);
+    omniGridMatrixLoc = glGetUniformLocation(omniGridProg.id(), "model");
 }
 
 std::vector<std::byte> encode() {
@@ -511,7 +302,7 @@ void keyboard(Key key, Modifier, Action action, int, Window*) {
 int main(int argc, char** argv) {
     std::vector<std::string> arg(argv + 1, argv + argc);
     Configuration config = parseArguments(arg);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
@@ -548,6 +339,31 @@ int main(int argc, char** argv) {
             sepMapSrc = argv[i + 1];
             Log::Info(std::format("Setting separation map path to '{}'", sepMapSrc));
         }
+        if (argument == "-tilesize" && argc > i + 1) {
+            tileSize = std::stoi(argv[i + 1]);
+            Log::Info(std::format("Setting omni stereo tile size to {}", *tileSize));
+        }
+    }
+
+    // The command line arguments override the omni stereo settings of the configuration
+    for (config::Node& node : cluster.nodes) {
+        for (config::Window& window : node.windows) {
+            for (config::Viewport& viewport : window.viewports) {
+                auto* p = std::get_if<config::FisheyeProjection>(&viewport.projection);
+                if (!p || !p->omniStereo) {
+                    continue;
+                }
+                if (!turnMapSrc.empty()) {
+                    p->omniStereo->turnMap = std::filesystem::absolute(turnMapSrc);
+                }
+                if (!sepMapSrc.empty()) {
+                    p->omniStereo->separationMap = std::filesystem::absolute(sepMapSrc);
+                }
+                if (tileSize) {
+                    p->omniStereo->tileSize = *tileSize;
+                }
+            }
+        }
     }
 
     Engine::Callbacks callbacks;
@@ -11,8 +11,11 @@
 #include <sgct/projection/fisheye.h>
 #include <sgct/projection/nonlinearprojection.h>
 #include <sgct/user.h>
-#include <cstring>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <format>
+#include <thread>
 
 namespace {
     enum class Rotation { Deg0 = 0, Deg90, Deg180, Deg270 };
@@ -36,6 +39,21 @@ namespace {
     int iterator;
     bool sequence = false;
 
+    // In the batch mode, the windows are hidden and the frames of the sequence are
+    // stitched as fast as they can be decoded and encoded, after which the application
+    // terminates
+    bool batch = false;
+
+    // The faces of the next frame of the sequence are decoded by the job system and
+    // uploaded while the current frame is rendered and saved by the capture threads
+    struct {
+        std::array<sgct::TextureManager::AsyncTexture, 8> textures;
+        bool isLoading = false;
+        bool isLastFrame = false;
+        int nStitched = 0;
+        double startTime = 0.0;
+    } nextFrame;
+
     int counter = 0;
     int startFrame = 0;
     struct {
@@ -154,127 +172,101 @@ void draw(const RenderData&) {
     }
 }
 
-void preSync() {
-    if (sequence && iterator <= stopIndex) {
-        for (size_t i = 0; i < numberOfTextures; i++) {
-            char tmpStr[256];
-
-            if (numberOfDigits == 0) {
-#if (_MSC_VER >= 1400)
-                sprintf_s(tmpStr, 256, "%s.png", texturePaths[i].c_str());
-#else
-                sprintf(tmpStr, "%s.png", texturePaths[i].c_str());
-#endif
-            }
-            else {
-                char digitStr[16];
-                char zeros[16];
-                zeros[0] = '\0';
-
-#if (_MSC_VER >= 1400)
-                sprintf_s(digitStr, 16, "%d", iterator);
-#else
-                sprintf(digitStr, "%d", iterator);
-#endif
-
-
-                size_t currentSize = strlen(digitStr);
+std::string texturePath(size_t index, int frame) {
+    if (numberOfDigits == 0) {
+        return std::format("{}.png", texturePaths[index]);
+    }
+    return std::format("{}{:0{}}.png", texturePaths[index], frame, numberOfDigits);
+}
 
-                for (size_t j = 0; j < (numberOfDigits - currentSize); j++) {
-                    zeros[j] = '0';
-                    zeros[j + 1] = '\0';
-                }
+void loadNextFrame() {
+    for (size_t i = 0; i < numberOfTextures; i++) {
+        nextFrame.textures[i] = TextureManager::instance().loadTextureAsync(
+            texturePath(i, iterator),
+            true,
+            1.f,
+            1
+        );
+    }
+    nextFrame.isLoading = true;
+    nextFrame.isLastFrame = iterator == stopIndex;
+    iterator++;
+}
 
-#if (_MSC_VER >= 1400)
-                sprintf_s(
-                    tmpStr,
-                    256,
-                    "%s%s%d.png",
-                    texturePaths[i].c_str(),
-                    zeros,
-                    iterator
-                );
-#else
-                sprintf(tmpStr, "%s%s%d.png", texturePaths[i].c_str(), zeros, iterator);
-#endif
-            }
+void preSync() {
+    counter = 0;
+}
 
-            // load the texture
-            std::string str(tmpStr);
-            textureIndices[i] = TextureManager::instance().loadTexture(
-                str,
-                true,
-                1
-            );
+void postSyncPreDraw() {
+    // The current frame is shown until all faces of the next one have been uploaded
+    using Status = TextureManager::AsyncTexture::Status;
+    const bool isReady = std::all_of(
+        nextFrame.textures.begin(),
+        nextFrame.textures.begin() + numberOfTextures,
+        [](const TextureManager::AsyncTexture& t) {
+            return t.status() == Status::Ready || t.status() == Status::Failed;
         }
-
-        takeScreenshot = true;
-        iterator++;
-    }
-    else if (sequence && iterator <= stopIndex && numberOfDigits == 0) {
+    );
+    if (nextFrame.isLoading && isReady) {
         for (size_t i = 0; i < numberOfTextures; i++) {
-            textureIndices[i] = TextureManager::instance().loadTexture(
-                texturePaths[i],
-                true,
-                1
-            );
+            if (textureIndices[i] != 0) {
+                TextureManager::instance().removeTexture(textureIndices[i]);
+            }
+            textureIndices[i] = nextFrame.textures[i].id();
+            if (textureIndices[i] == 0) {
+                Log::Warning(std::format(
+                    "Failed to load '{}'", texturePath(i, iterator - 1)
+                ));
+            }
+            nextFrame.textures[i] = TextureManager::AsyncTexture();
         }
-
+        nextFrame.isLoading = false;
+        nextFrame.nStitched++;
         takeScreenshot = true;
-        iterator++;
-    }
 
-    counter = 0;
-}
+        if (!nextFrame.isLastFrame) {
+            loadNextFrame();
+        }
+    }
+    else if (batch && nextFrame.isLoading) {
+        // Nothing would be saved, so there is no point in rendering as fast as possible
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 
-void postSyncPreDraw() {
     if (takeScreenshot) {
         Engine::instance().takeScreenshot();
         takeScreenshot = false;
     }
 }
 
-void preWinInit() {
-    Engine::instance().defaultUser().setEyeSeparation(settings.eyeSeparation);
-    for (const std::unique_ptr<Window>& win : Engine::instance().windows()) {
-        Engine::instance().setScreenShotNumber(startFrame);
-        win->setAlpha(settings.alpha);
-
-        for (const std::unique_ptr<Viewport>& vp : win->viewports()) {
-            if (!vp->hasSubViewports()) {
-                continue;
-            }
-            vp->nonLinearProjection()->setClearColor(vec4{ 0.f, 0.f, 0.f, 1.f });
-            vp->nonLinearProjection()->setCubemapResolution(settings.cubemapRes);
-            vp->nonLinearProjection()->setInterpolationMode(
-                settings.cubic ?
-                NonLinearProjection::InterpolationMode::Cubic :
-                NonLinearProjection::InterpolationMode::Linear
-            );
-
-            FisheyeProjection* p = dynamic_cast<FisheyeProjection*>(
-                vp->nonLinearProjection()
-            );
-            if (p) {
-                p->setDomeDiameter(settings.domeDiameter);
-            }
-        }
-
-        win->setNumberOfAASamples(settings.numberOfMSAASamples);
-        win->setFramebufferResolution(ivec2{ settings.resolution, settings.resolution });
-        win->setUseFXAA(settings.fxaa);
-        win->setStereoMode(
-            settings.stereo ? Window::StereoMode::Dummy : Window::StereoMode::NoStereo
-        );
+void postDraw() {
+    if (batch && sequence && !nextFrame.isLoading && nextFrame.isLastFrame) {
+        const double duration = time() - nextFrame.startTime;
+        Log::Info(std::format(
+            "Stitched {} frames in {:.2f} s ({:.1f} frames per second)",
+            nextFrame.nStitched, duration, nextFrame.nStitched / duration
+        ));
+        Engine::instance().terminate();
     }
 }
 
 void initOGL(GLFWwindow*) {
+    Engine::instance().setScreenshotNumber(startFrame);
+
     // load all textures
-    if (!sequence) {
+    if (sequence) {
+        // A frame is only saved once its faces are complete, so there is no reason to
+        // spread their uploads across multiple frames
+        if (batch) {
+            TextureManager::instance().setUploadBudget(1000.0);
+        }
+        nextFrame.startTime = time();
+        loadNextFrame();
+    }
+    else {
         for (size_t i = 0; i < numberOfTextures; i++) {
             textureIndices[i] = TextureManager::instance().loadTexture(
-                texturePaths[i],
+                texturePath(i, 0),
                 true,
                 8.f
             );
@@ -384,7 +376,7 @@ void initOGL(GLFWwindow*) {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
-    ShaderManager::instance().addShaderProgram("simple", vertexShader, fragmentShader);
+    ShaderManager::instance().addShaderProgram("simple", VertexShader, FragmentShader);
 }
 
 std::vector<std::byte> encode() {
@@ -393,11 +385,12 @@ std::vector<std::byte> encode() {
     return data;
 }
 
-void decode(const std::vector<std::byte>& data, unsigned int pos) {
+void decode(const std::vector<std::byte>& data) {
+    unsigned int pos = 0;
     deserializeObject(data, pos, takeScreenshot);
 }
 
-void keyboard(Key key, Modifier, Action action, int) {
+void keyboard(Key key, Modifier, Action action, int, Window*) {
     if (Engine::instance().isMaster() && action == Action::Press) {
         switch (key) {
             case Key::Esc:
@@ -439,11 +432,13 @@ Sides getSideIndex(size_t index) {
 int main(int argc, char** argv) {
     std::vector<std::string> arguments(argv + 1, argv + argc);
     Configuration config = parseArguments(arguments);
-    config::Cluster cluster = loadCluster(config.configFilename);
+    config::Cluster cluster = loadCluster(config);
     if (!cluster.success) {
         return -1;
     }
 
+    config::Capture capture = cluster.capture.value_or(config::Capture());
+
     // parse arguments
     for (int i = 0; i < argc; i++) {
         std::string_view arg = argv[i];
@@ -568,46 +563,107 @@ int main(int argc, char** argv) {
         }
         else if (arg == "-format" && argc > (i + 1)) {
             std::string_view arg2 = argv[i + 1];
-            Settings::CaptureFormat f = [](std::string_view format) {
+            config::Capture::Format f = [](std::string_view format) {
                 if (format == "png" || format == "PNG") {
-                    return Settings::CaptureFormat::PNG;
+                    return config::Capture::Format::Png;
                 }
-                else if (format == "tga" || format == "TGA") {
-                    return Settings::CaptureFormat::TGA;
+                else if (format == "raw" || format == "RAW") {
+                    return config::Capture::Format::Raw;
                 }
-                else if (format == "jpg" || format == "JPG") {
-                    return Settings::CaptureFormat::JPG;
+                else if (format == "video" || format == "VIDEO") {
+                    return config::Capture::Format::Video;
+                }
+                else if (format == "exr" || format == "EXR") {
+                    return config::Capture::Format::Exr;
                 }
                 else {
                     Log::Info("Unknown capturing format. Using PNG");
-                    return Settings::CaptureFormat::PNG;
+                    return config::Capture::Format::Png;
                 }
             } (arg2);
-            Settings::instance().setCaptureFormat(f);
+            capture.format = f;
             Log::Info(std::format("Format set to {}", argv[i + 1]));
         }
         else if (arg == "-path" && argc > (i + 1)) {
-            Settings::instance().setCapturePath(argv[i + 1]);
+            capture.path = std::filesystem::absolute(argv[i + 1]);
             Log::Info(std::format("Left path set to {}", argv[i + 1]));
         }
         else if (arg == "-leftPath" || arg == "-rightPath") {
             Log::Warning("-leftPath and -rightPath are no longer supported; use -path");
         }
+        else if (arg == "-batch") {
+            batch = true;
+            Log::Info("Stitching the sequence in batch mode");
+        }
+    }
+
+    config::Settings::Display display =
+        cluster.settings.value_or(config::Settings()).display.value_or(
+            config::Settings::Display()
+        );
+    if (batch) {
+        // The frame rate is only limited by decoding the faces and saving the frames
+        display.swapInterval = 0;
+
+        // Every frame of the sequence has to be saved, even if the capture threads fall
+        // behind for a moment
+        capture.dropWhenFull = false;
+    }
+    if (!cluster.settings) {
+        cluster.settings = config::Settings();
+    }
+    cluster.settings->display = display;
+    cluster.capture = capture;
+
+    if (cluster.users.empty()) {
+        cluster.users.emplace_back();
+    }
+    for (config::User& user : cluster.users) {
+        user.eyeSeparation = settings.eyeSeparation;
+    }
+
+    for (config::Node& node : cluster.nodes) {
+        for (config::Window& window : node.windows) {
+            window.alpha = settings.alpha;
+            window.msaa = static_cast<uint8_t>(settings.numberOfMSAASamples);
+            window.useFxaa = settings.fxaa;
+            window.resolution = ivec2{ settings.resolution, settings.resolution };
+            window.stereo = settings.stereo ?
+                config::Window::StereoMode::Dummy :
+                config::Window::StereoMode::NoStereo;
+            if (batch) {
+                // A hidden window is still a complete offscreen render target
+                window.isHidden = true;
+                window.alwaysRender = true;
+            }
+
+            for (config::Viewport& vp : window.viewports) {
+                auto* p = std::get_if<config::FisheyeProjection>(&vp.projection);
+                if (!p) {
+                    continue;
+                }
+                p->quality = settings.cubemapRes;
+                p->interpolation = settings.cubic ?
+                    config::FisheyeProjection::Interpolation::Cubic :
+                    config::FisheyeProjection::Interpolation::Linear;
+                p->diameter = settings.domeDiameter;
+                p->background = vec4{ 0.f, 0.f, 0.f, 1.f };
+            }
+        }
     }
 
     Engine::Callbacks callbacks;
-    callbacks.preWindow = preWinInit;
     callbacks.initOpenGL = initOGL;
     callbacks.preSync = preSync;
     callbacks.encode = encode;
     callbacks.decode = decode;
     callbacks.postSyncPreDraw = postSyncPreDraw;
     callbacks.draw = draw;
+    callbacks.postDraw = postDraw;
     callbacks.keyboard = keyboard;
 
     try {
         Engine::create(cluster, callbacks, config);
-        Engine::instance().setClearColor(vec4{ 0.f, 0.f, 0.f, 1.f });
     }
     catch (const std::runtime_error& e) {
         Log::Error(e.what());
@@ -615,7 +671,7 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
-    Engine::instance().render();
+    Engine::instance().exec();
     Engine::destroy();
     exit(EXIT_SUCCESS);
 }
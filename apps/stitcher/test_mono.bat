@@ -1 +1 @@
-stitcher.exe -config fisheye.xml -tex Left_L.png -tex Right_L.png -tex Top_L.png -tex Bottom_L.png -start 0 -seq 0 0 0 -rot 0 0 0 90
\ No newline at end of file
+stitcher.exe -config fisheye.json -tex Left_L.png -tex Right_L.png -tex Top_L.png -tex Bottom_L.png -start 0 -seq 0 0 0 -rot 0 0 0 90
\ No newline at end of file
@@ -1 +1 @@
-stitcher.exe -config fisheye_stereo.xml -tex Left_L.png -tex Right_L.png -tex Top_L.png -tex Bottom_L.png -tex Left_R.png -tex Right_R.png -tex Top_R.png -tex Bottom_R.png -start 0 -seq 0 0 0 -rot 0 0 0 90
\ No newline at end of file
+stitcher.exe -config fisheye.json -stereo 1 -tex Left_L.png -tex Right_L.png -tex Top_L.png -tex Bottom_L.png -tex Left_R.png -tex Right_R.png -tex Top_R.png -tex Bottom_R.png -start 0 -seq 0 0 0 -rot 0 0 0 90
\ No newline at end of file
@@ -0,0 +1,625 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/baseviewport.h>
+#include <sgct/clustermanager.h>
+#include <sgct/config.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/math.h>
+#include <sgct/offscreenbuffer.h>
+#include <sgct/screencapture.h>
+#include <sgct/window.h>
+#include <sgct/correction/buffer.h>
+#include <sgct/correction/domeprojection.h>
+#include <sgct/correction/meshcache.h>
+#include <sgct/correction/obj.h>
+#include <sgct/correction/paulbourke.h>
+#include <sgct/correction/pfm.h>
+#include <sgct/correction/scalable.h>
+#include <sgct/correction/sciss.h>
+#include <sgct/correction/simcad.h>
+#include <sgct/correction/simplify.h>
+#include <sgct/correction/skyskan.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <numbers>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The benchmark runs the same loaders as the CorrectionMesh, but without a window or an
+// OpenGL context, so the upload of the meshes is not part of the measurements. Each
+// loader reads a synthetic mesh of `--size` x `--size` vertices from a file that is
+// written into the temporary directory first. The results can be written to a file with
+// `--output` and compared against such a file with `--baseline`, in which case the
+// program fails if the throughput of any step dropped, or its peak memory grew, by more
+// than the `--threshold`
+
+namespace {
+    std::atomic<size_t> currentBytes = 0;
+    std::atomic<size_t> peakBytes = 0;
+} // namespace
+
+#ifndef SGCT_OVERRIDE_NEW_AND_DELETE
+// Every allocation is preceded by its size so that the deallocation can subtract it from
+// the currently allocated memory. The default versions of all other forms of new and
+// delete, except for the aligned ones, are implemented in terms of these two
+void* operator new(size_t count) {
+    constexpr size_t Header = alignof(std::max_align_t);
+    void* ptr = std::malloc(count + Header);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(ptr) = count;
+
+    const size_t current = currentBytes.fetch_add(count) + count;
+    size_t peak = peakBytes.load();
+    while (current > peak && !peakBytes.compare_exchange_weak(peak, current)) {}
+    return static_cast<std::byte*>(ptr) + Header;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    constexpr size_t Header = alignof(std::max_align_t);
+    std::byte* block = static_cast<std::byte*>(ptr) - Header;
+    currentBytes -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+#endif // SGCT_OVERRIDE_NEW_AND_DELETE
+
+namespace {
+    using namespace sgct;
+    using namespace sgct::correction;
+
+    struct Measurement {
+        double seconds = std::numeric_limits<double>::max();
+        size_t peakBytes = 0;
+    };
+
+    struct Format {
+        std::string_view name;
+        std::string_view extension;
+        std::function<void(const std::filesystem::path&, int)> write;
+        std::function<Buffer(const std::filesystem::path&, BaseViewport&)> load;
+    };
+
+    // The resolution of the projector for which the Scalable mesh was created
+    constexpr ivec2 NativeResolution = ivec2{ 1920, 1200 };
+
+    // Returns the corrected position of the vertex at the normalized texture coordinate
+    // (u, v), which is a mild barrel distortion as it is typical for curved screens
+    vec2 warp(float u, float v) {
+        const float dx = u - 0.5f;
+        const float dy = v - 0.5f;
+        const float r2 = dx * dx + dy * dy;
+        return vec2{ 0.5f + dx * (1.f - 0.1f * r2), 0.5f + dy * (1.f - 0.1f * r2) };
+    }
+
+    float coordinate(int i, int n) {
+        return static_cast<float>(i) / static_cast<float>(n - 1);
+    }
+
+    std::ofstream openFile(const std::filesystem::path& path, bool binary) {
+        std::ofstream file = std::ofstream(
+            path,
+            binary ? std::ofstream::binary : std::ofstream::out
+        );
+        if (!file.good()) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            // formatting std::filesystem::path
+            throw std::runtime_error(std::format("Failed to write '{}'", path.string()));
+        }
+        return file;
+    }
+
+    template <typename T>
+    void writeBinary(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Calls the function with the four vertex indices of every cell of the grid in
+    // counterclockwise order, starting in the lower left corner
+    void forEachCell(int n, const std::function<void(int, int, int, int)>& fn) {
+        for (int r = 0; r < n - 1; r++) {
+            for (int c = 0; c < n - 1; c++) {
+                fn(r * n + c, r * n + c + 1, (r + 1) * n + c + 1, (r + 1) * n + c);
+            }
+        }
+    }
+
+    void writeOBJ(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const vec2 p = warp(coordinate(c, n), coordinate(r, n));
+                file << std::format("v {} {} 0\n", 2.f * p.x - 1.f, 2.f * p.y - 1.f);
+            }
+        }
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                file << std::format("vt {} {}\n", coordinate(c, n), coordinate(r, n));
+            }
+        }
+        forEachCell(n, [&file](int i0, int i1, int i2, int i3) {
+            // OBJ files are using 1-based indices
+            file << std::format("f {} {} {}\n", i0 + 1, i1 + 1, i2 + 1);
+            file << std::format("f {} {} {}\n", i0 + 1, i2 + 1, i3 + 1);
+        });
+    }
+
+    void writePFM(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, true);
+        // Side-by-side stereo image with one warp per eye
+        file << std::format("PF\n{} {}\n-1.0\n", 2 * n, n);
+        for (int r = 0; r < n; r++) {
+            for (int e = 0; e < 2; e++) {
+                for (int c = 0; c < n; c++) {
+                    const vec2 p = warp(coordinate(c, n), 1.f - coordinate(r, n));
+                    writeBinary(file, p.x);
+                    writeBinary(file, p.y);
+                    writeBinary(file, 0.f);
+                }
+            }
+        }
+    }
+
+    void writeSCISS(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, true);
+        file.write("SGC", 3);
+        writeBinary(file, uint8_t(1));
+        // Planar mapping
+        writeBinary(file, 0u);
+        // Rotation quaternion, position, and the field of view up, down, left, right
+        constexpr std::array<float, 11> ViewData = {
+            0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 20.f, 20.f, 20.f, 20.f
+        };
+        writeBinary(file, ViewData);
+        writeBinary(file, std::array<unsigned int, 2>{
+            static_cast<unsigned int>(n), static_cast<unsigned int>(n)
+        });
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                const float v = coordinate(r, n);
+                const vec2 p = warp(u, v);
+                const std::array<float, 6> vertex = { p.x, 1.f - p.y, 0.f, u, v, 0.f };
+                writeBinary(file, vertex);
+            }
+        }
+
+        // Triangle strip that turns around at the end of each row
+        std::vector<unsigned int> indices;
+        for (int r = 0; r < n - 1; r++) {
+            for (int c = 0; c < n; c++) {
+                const int col = (r % 2 == 0) ? c : n - 1 - c;
+                indices.push_back(static_cast<unsigned int>(r * n + col));
+                indices.push_back(static_cast<unsigned int>((r + 1) * n + col));
+            }
+        }
+        writeBinary(file, static_cast<unsigned int>(indices.size()));
+        file.write(
+            reinterpret_cast<const char*>(indices.data()),
+            indices.size() * sizeof(unsigned int)
+        );
+    }
+
+    void writeScalable(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        const int nFaces = 2 * (n - 1) * (n - 1);
+        file << "OPENMESH Version 1.1\n";
+        file << std::format("VERTICES {}\nFACES {}\n", n * n, nFaces);
+        file << "MAPPING NORMALIZED\nSAMPLING LINEAR\nPROJECTION PERSPECTIVE\n";
+        file << "PERSPECTIVE_LEFT -40\nPERSPECTIVE_RIGHT 40\n";
+        file << "PERSPECTIVE_TOP 25\nPERSPECTIVE_BOTTOM -25\n";
+        file << std::format(
+            "NATIVEXRES {}\nNATIVEYRES {}\n", NativeResolution.x, NativeResolution.y
+        );
+        file << "SUBVERSION 5\n";
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                const float v = coordinate(r, n);
+                const vec2 p = warp(u, v);
+                file << std::format(
+                    "{} {} 255 {} {}\n",
+                    p.x * NativeResolution.x, p.y * NativeResolution.y, u, v
+                );
+            }
+        }
+        forEachCell(n, [&file](int i0, int i1, int i2, int i3) {
+            file << std::format("[ {} {} {} ]\n", i0, i1, i2);
+            file << std::format("[ {} {} {} ]\n", i0, i2, i3);
+        });
+    }
+
+    void writeSimCAD(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+        file << "<GeometryFile>\n<GeometryDefinition>\n";
+
+        // The parameters are the offsets of the corrected from the regular grid
+        file << "<X-FlatParameters range=\"1.0\">";
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                file << std::format("{} ", warp(u, 1.f - coordinate(r, n)).x - u);
+            }
+            file << '\n';
+        }
+        file << "</X-FlatParameters>\n";
+
+        file << "<Y-FlatParameters range=\"1.0\">";
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float v = 1.f - coordinate(r, n);
+                file << std::format("{} ", v - warp(coordinate(c, n), v).y);
+            }
+            file << '\n';
+        }
+        file << "</Y-FlatParameters>\n";
+
+        file << "</GeometryDefinition>\n</GeometryFile>\n";
+    }
+
+    void writeSkySkan(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        file << "Dome Azimuth=0\nDome Elevation=20\n";
+        file << "Horizontal FOV=80\nVertical FOV=50\n";
+        file << std::format("{} {}\n", n, n);
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                const float v = coordinate(r, n);
+                const vec2 p = warp(u, v);
+                file << std::format("{} {} {} {}\n", p.x, 1.f - p.y, u, 1.f - v);
+            }
+        }
+    }
+
+    void writeDomeProjection(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                const float v = coordinate(r, n);
+                const vec2 p = warp(u, v);
+                file << std::format("{};{};{};{};{};{}\n", p.x, 1.f - p.y, u, v, c, r);
+            }
+        }
+    }
+
+    void writePaulBourke(const std::filesystem::path& path, int n) {
+        std::ofstream file = openFile(path, false);
+        // Polar mapping type, followed by the dimensions of the grid
+        file << std::format("2\n{} {}\n", n, n);
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const float u = coordinate(c, n);
+                const float v = coordinate(r, n);
+                const vec2 p = warp(u, v);
+                // The intensity falls off towards the border like with a real mirror
+                const float intensity = std::cos(
+                    std::numbers::pi_v<float> * 0.4f * (2.f * u - 1.f)
+                );
+                file << std::format(
+                    "{} {} {} {} {}\n",
+                    2.f * p.x - 1.f, 2.f * p.y - 1.f, u, v, intensity
+                );
+            }
+        }
+    }
+
+    std::vector<Format> formats() {
+        using Path = std::filesystem::path;
+        return {
+            {
+                "OBJ", ".obj", writeOBJ,
+                [](const Path& path, BaseViewport&) { return generateOBJMesh(path); }
+            },
+            {
+                "PFM", ".pfm", writePFM,
+                [](const Path& path, BaseViewport& vp) {
+                    return generatePerEyeMeshFromPFMImage(path, vp.position(), vp.size());
+                }
+            },
+            {
+                "SCISS", ".sgc", writeSCISS,
+                [](const Path& path, BaseViewport& vp) {
+                    return generateScissMesh(path, vp);
+                }
+            },
+            {
+                "Scalable", ".ol", writeScalable,
+                [](const Path& path, BaseViewport& vp) {
+                    return generateScalableMesh(path, vp);
+                }
+            },
+            {
+                "SimCAD", ".simcad", writeSimCAD,
+                [](const Path& path, BaseViewport& vp) {
+                    return generateSimCADMesh(path, vp.position(), vp.size());
+                }
+            },
+            {
+                "SkySkan", ".skyskan", writeSkySkan,
+                [](const Path& path, BaseViewport& vp) {
+                    return generateSkySkanMesh(path, vp);
+                }
+            },
+            {
+                "DomeProjection", ".csv", writeDomeProjection,
+                [](const Path& path, BaseViewport& vp) {
+                    return generateDomeProjectionMesh(path, vp.position(), vp.size());
+                }
+            },
+            {
+                "PaulBourke", ".data", writePaulBourke,
+                [](const Path& path, BaseViewport& vp) {
+                    const ivec2 res = vp.window().framebufferResolution();
+                    const float aspectRatio =
+                        static_cast<float>(res.x) / static_cast<float>(res.y);
+                    return generatePaulBourkeMesh(
+                        path,
+                        vp.position(),
+                        vp.size(),
+                        aspectRatio
+                    );
+                }
+            }
+        };
+    }
+
+    // Runs the function the requested number of times and keeps the fastest duration, as
+    // that is the one that is least disturbed by the rest of the system
+    Measurement measure(int iterations, const std::function<void()>& fn) {
+        Measurement m;
+        for (int i = 0; i < iterations; i++) {
+            const size_t base = currentBytes.load();
+            peakBytes = base;
+            const auto begin = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double> duration = end - begin;
+            m.seconds = std::min(m.seconds, duration.count());
+            m.peakBytes = std::max(m.peakBytes, peakBytes.load() - base);
+        }
+        return m;
+    }
+
+    nlohmann::json toJson(const Measurement& m, size_t nVertices) {
+        return {
+            { "seconds", m.seconds },
+            { "verticespersecond", static_cast<double>(nVertices) / m.seconds },
+            { "peakbytes", m.peakBytes }
+        };
+    }
+
+    nlohmann::json runBenchmarks(int size, int iterations, BaseViewport& viewport) {
+        const std::filesystem::path folder =
+            std::filesystem::temp_directory_path() / "sgct-benchmark";
+        std::filesystem::create_directories(folder);
+
+        nlohmann::json results;
+        for (const Format& format : formats()) {
+            const std::filesystem::path path =
+                folder / std::format("mesh{}", format.extension);
+            format.write(path, size);
+
+            Buffer buffer;
+            const Measurement load = measure(iterations, [&]() {
+                buffer = format.load(path, viewport);
+            });
+            const size_t nVertices = buffer.vertices.size();
+            if (nVertices == 0) {
+                throw std::runtime_error(std::format("{} mesh was empty", format.name));
+            }
+
+            const ivec2 res = viewport.window().framebufferResolution();
+            const Measurement simplify = measure(iterations, [&]() {
+                [[maybe_unused]] Buffer b = simplifyMesh(buffer, 0.5f, res);
+            });
+
+            // The cache file is what the CorrectionMesh reads instead of the file when
+            // the same mesh was loaded before
+            const uint64_t key = meshCacheKey(path, {});
+            writeMeshCache(path, key, buffer);
+            const Measurement cache = measure(iterations, [&]() {
+                std::unique_ptr<CachedMesh> cached = readMeshCache(path, key);
+                if (!cached) {
+                    throw std::runtime_error(
+                        std::format("Failed to read {} mesh cache", format.name)
+                    );
+                }
+            });
+            std::filesystem::remove(meshCachePath(path));
+            std::filesystem::remove(path);
+
+            std::cout << std::format(
+                "{:<16}{:>10}{:>14.1f}{:>14.1f}{:>14.1f}{:>12.1f}\n",
+                format.name, nVertices,
+                nVertices / load.seconds / 1e6, nVertices / simplify.seconds / 1e6,
+                nVertices / cache.seconds / 1e6, load.peakBytes / (1024.0 * 1024.0)
+            );
+
+            results[std::string(format.name)] = {
+                { "vertices", nVertices },
+                { "load", toJson(load, nVertices) },
+                { "simplify", toJson(simplify, nVertices) },
+                { "cache", toJson(cache, nVertices) }
+            };
+        }
+        return { { "size", size }, { "formats", results } };
+    }
+
+    // Returns the number of steps that are slower, or use more memory, than in the
+    // baseline by more than the threshold
+    int compare(const nlohmann::json& baseline, const nlohmann::json& current,
+                double threshold)
+    {
+        if (baseline.at("size") != current.at("size")) {
+            throw std::runtime_error(std::format(
+                "Baseline was measured with size {}, but the current size is {}",
+                baseline.at("size").get<int>(), current.at("size").get<int>()
+            ));
+        }
+
+        int nRegressions = 0;
+        for (const auto& [name, formatBaseline] : baseline.at("formats").items()) {
+            if (!current.at("formats").contains(name)) {
+                std::cout << std::format("{}: Missing in current results\n", name);
+                nRegressions++;
+                continue;
+            }
+            const nlohmann::json& format = current.at("formats").at(name);
+            for (const char* step : { "load", "simplify", "cache" }) {
+                const nlohmann::json& base = formatBaseline.at(step);
+                const nlohmann::json& cur = format.at(step);
+
+                const double ratio = cur.at("verticespersecond").get<double>() /
+                                     base.at("verticespersecond").get<double>();
+                if (ratio < 1.0 - threshold) {
+                    std::cout << std::format(
+                        "{} {}: Throughput dropped to {:.1f}% of the baseline\n",
+                        name, step, 100.0 * ratio
+                    );
+                    nRegressions++;
+                }
+
+                const size_t basePeak = base.at("peakbytes").get<size_t>();
+                const size_t curPeak = cur.at("peakbytes").get<size_t>();
+                if (curPeak > basePeak * (1.0 + threshold)) {
+                    std::cout << std::format(
+                        "{} {}: Peak memory grew from {} to {} bytes\n",
+                        name, step, basePeak, curPeak
+                    );
+                    nRegressions++;
+                }
+            }
+        }
+        return nRegressions;
+    }
+
+    void printUsage() {
+        std::cout << "Usage: SGCTBenchmark [--size <vertices per side>] "
+            "[--iterations <count>] [--output <file>] [--baseline <file>] "
+            "[--threshold <fraction>]\n";
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    int size = 512;
+    int iterations = 3;
+    std::filesystem::path output;
+    std::filesystem::path baseline;
+    double threshold = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        const std::string_view value = argv[++i];
+
+        if (arg == "--size") {
+            size = std::atoi(std::string(value).c_str());
+        }
+        else if (arg == "--iterations") {
+            iterations = std::atoi(std::string(value).c_str());
+        }
+        else if (arg == "--output") {
+            output = value;
+        }
+        else if (arg == "--baseline") {
+            baseline = value;
+        }
+        else if (arg == "--threshold") {
+            threshold = std::atof(std::string(value).c_str());
+        }
+        else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (size < 2 || iterations < 1 || threshold <= 0.0) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    // The loaders report every file they read
+    Log::instance().setNotifyLevel(Log::Level::Warning);
+
+    try {
+        // Some of the loaders change the default user and the view plane of the viewport
+        config::Cluster cluster;
+        cluster.users.emplace_back();
+        ClusterManager::create(cluster, 0);
+
+        config::Window windowConfig;
+        windowConfig.size = ivec2{ 1920, 1080 };
+        const Window window = Window(windowConfig);
+        BaseViewport viewport = BaseViewport(window);
+
+        std::cout << std::format(
+            "{:<16}{:>10}{:>14}{:>14}{:>14}{:>12}\n",
+            "Format", "Vertices", "Load [MV/s]", "Simplify", "Cache", "Peak [MiB]"
+        );
+        const nlohmann::json results = runBenchmarks(size, iterations, viewport);
+        ClusterManager::destroy();
+
+        if (!output.empty()) {
+            std::ofstream file = openFile(output, false);
+            file << results.dump(2) << '\n';
+        }
+
+        if (!baseline.empty()) {
+            std::ifstream file = std::ifstream(baseline);
+            if (!file.good()) {
+                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+                // formatting std::filesystem::path
+                throw std::runtime_error(
+                    std::format("Failed to open baseline '{}'", baseline.string())
+                );
+            }
+            const nlohmann::json base = nlohmann::json::parse(file);
+            const int nRegressions = compare(base, results, threshold);
+            if (nRegressions > 0) {
+                std::cout << std::format("{} regressions found\n", nRegressions);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sgct/bytestream.h>
+#include <sgct/format.h>
+#include <sgct/shareddata.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The benchmarks measure the functions that every frame passes the shared data through,
+// for payloads from a few values up to the size of large scene states. The name of each
+// benchmark contains the number of bytes of its payload, so that the throughput is that
+// number divided by the reported mean time. Each benchmark is preceded by a check that
+// the data survives the round trip, so the program also fails if the serialization
+// breaks
+
+namespace {
+    using namespace sgct;
+
+    constexpr std::array<size_t, 4> PayloadSizes = { 64, 4096, 65536, 1048576 };
+
+    // A typical value of the shared data of an application
+    struct Pose {
+        float position[3];
+        float orientation[4];
+        double time;
+    };
+
+    Pose pose(size_t i) {
+        const float f = static_cast<float>(i);
+        return { { f, f + 1.f, f + 2.f }, { 0.f, 0.f, 0.f, 1.f }, 0.01 * f };
+    }
+
+    std::vector<std::byte> payload(size_t size) {
+        std::vector<std::byte> res(size);
+        for (size_t i = 0; i < size; i++) {
+            res[i] = static_cast<std::byte>(i * 31);
+        }
+        return res;
+    }
+
+    std::string name(std::string_view function, size_t size) {
+        return std::format("{} ({} bytes)", function, size);
+    }
+} // namespace
+
+TEST_CASE("Benchmark: SharedData/POD", "[benchmark]") {
+    for (size_t size : PayloadSizes) {
+        const size_t n = std::max<size_t>(size / sizeof(Pose), 1);
+        std::vector<std::byte> buffer;
+        buffer.reserve(n * sizeof(Pose));
+        for (size_t i = 0; i < n; i++) {
+            serializeObject(buffer, pose(i));
+        }
+
+        unsigned int pos = 0;
+        Pose back = {};
+        for (size_t i = 0; i < n; i++) {
+            deserializeObject(buffer, pos, back);
+        }
+        REQUIRE(std::memcmp(&back, &buffer[buffer.size() - sizeof(Pose)], sizeof(Pose))
+            == 0);
+
+        BENCHMARK(name("serializeObject", buffer.size())) {
+            buffer.clear();
+            for (size_t i = 0; i < n; i++) {
+                serializeObject(buffer, pose(i));
+            }
+            return buffer.size();
+        };
+        BENCHMARK(name("deserializeObject", buffer.size())) {
+            unsigned int p = 0;
+            Pose value = {};
+            for (size_t i = 0; i < n; i++) {
+                deserializeObject(buffer, p, value);
+            }
+            return value.time;
+        };
+    }
+}
+
+TEST_CASE("Benchmark: SharedData/Vector", "[benchmark]") {
+    for (size_t size : PayloadSizes) {
+        std::vector<float> values(size / sizeof(float));
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<float>(i);
+        }
+        std::vector<std::byte> buffer;
+        serializeObject(buffer, values);
+
+        unsigned int pos = 0;
+        std::vector<float> back;
+        deserializeObject(buffer, pos, back);
+        REQUIRE(back == values);
+
+        BENCHMARK(name("serializeObject", buffer.size())) {
+            buffer.clear();
+            serializeObject(buffer, values);
+            return buffer.size();
+        };
+        BENCHMARK(name("deserializeObject", buffer.size())) {
+            unsigned int p = 0;
+            deserializeObject(buffer, p, back);
+            return back.size();
+        };
+    }
+}
+
+TEST_CASE("Benchmark: SharedData/String", "[benchmark]") {
+    for (size_t size : PayloadSizes) {
+        std::string value(size, ' ');
+        for (size_t i = 0; i < size; i++) {
+            value[i] = static_cast<char>('a' + i % 26);
+        }
+        std::vector<std::byte> buffer;
+        serializeObject(buffer, value);
+
+        unsigned int pos = 0;
+        std::string back;
+        deserializeObject(buffer, pos, back);
+        REQUIRE(back == value);
+
+        BENCHMARK(name("serializeObject", buffer.size())) {
+            buffer.clear();
+            serializeObject(buffer, value);
+            return buffer.size();
+        };
+        BENCHMARK(name("deserializeObject", buffer.size())) {
+            unsigned int p = 0;
+            deserializeObject(buffer, p, back);
+            return back.size();
+        };
+    }
+}
+
+TEST_CASE("Benchmark: SharedData/WString", "[benchmark]") {
+    for (size_t size : PayloadSizes) {
+        std::wstring value(size / sizeof(wchar_t), L' ');
+        for (size_t i = 0; i < value.size(); i++) {
+            value[i] = static_cast<wchar_t>(L'a' + i % 26);
+        }
+        std::vector<std::byte> buffer;
+        serializeObject(buffer, value);
+
+        unsigned int pos = 0;
+        std::wstring back;
+        deserializeObject(buffer, pos, back);
+        REQUIRE(back == value);
+
+        BENCHMARK(name("serializeObject", buffer.size())) {
+            buffer.clear();
+            serializeObject(buffer, value);
+            return buffer.size();
+        };
+        BENCHMARK(name("deserializeObject", buffer.size())) {
+            unsigned int p = 0;
+            deserializeObject(buffer, p, back);
+            return back.size();
+        };
+    }
+}
+
+TEST_CASE("Benchmark: SharedData/Encode Decode", "[benchmark]") {
+    // The master encodes the data into its data block and the clients receive that same
+    // block, which is decoded once the frame's data has arrived
+    SharedData& sd = SharedData::instance();
+    for (size_t size : PayloadSizes) {
+        const std::vector<std::byte> data = payload(size);
+        std::vector<std::byte> decoded;
+        sd.setEncodeWriterFunction(nullptr);
+        sd.setDecodeReaderFunction(nullptr);
+        sd.setEncodeFunction([&data]() { return data; });
+        sd.setDecodeFunction([&decoded](const std::vector<std::byte>& block) {
+            decoded = block;
+        });
+
+        sd.encode();
+        sd.decode(reinterpret_cast<const char*>(sd.dataBlock()), sd.dataSize());
+        sd.applyReceivedData();
+        REQUIRE(decoded == data);
+
+        BENCHMARK(name("encode", size)) {
+            sd.encode();
+            return sd.dataSize();
+        };
+        BENCHMARK(name("decode", size)) {
+            sd.decode(reinterpret_cast<const char*>(sd.dataBlock()), sd.dataSize());
+            sd.applyReceivedData();
+            return decoded.size();
+        };
+
+        // The writer functions avoid the copies of the returned and received buffers
+        sd.setEncodeFunction(nullptr);
+        sd.setDecodeFunction(nullptr);
+        sd.setEncodeWriterFunction([&data](ByteWriter& writer) {
+            writer.write(data);
+        });
+        sd.setDecodeReaderFunction([&decoded](ByteReader& reader) {
+            reader.read(decoded);
+        });
+
+        decoded.clear();
+        sd.encode();
+        sd.decode(reinterpret_cast<const char*>(sd.dataBlock()), sd.dataSize());
+        sd.applyReceivedData();
+        REQUIRE(decoded == data);
+
+        BENCHMARK(name("encode with writer", size)) {
+            sd.encode();
+            return sd.dataSize();
+        };
+        BENCHMARK(name("decode with reader", size)) {
+            sd.decode(reinterpret_cast<const char*>(sd.dataBlock()), sd.dataSize());
+            sd.applyReceivedData();
+            return decoded.size();
+        };
+    }
+    SharedData::destroy();
+}
@@ -0,0 +1,131 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__ANTIALIASING__H__
+#define __SGCT__ANTIALIASING__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <sgct/rendertargetpool.h>
+#include <sgct/shaderprogram.h>
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Smooths the edges in the color texture of a window after it has been rendered, either
+ * through subpixel morphological anti-aliasing (SMAA), through temporal anti-aliasing
+ * (TAA), or both. SMAA detects the edges in the luma of the image, estimates the shape
+ * of the silhouette along each edge, and blends the pixels across the edge by the area
+ * that the silhouette covers, which keeps the text and lines sharp that FXAA blurs. TAA
+ * offsets the projection of every frame by a different subpixel jitter and blends each
+ * frame with the history of the previous ones at the position that the pixel had in the
+ * previous frame, which it finds through the depth buffer and the view-projection
+ * matrices of the viewports. Both run once per eye on the final image, so unlike MSAA
+ * their cost does not grow with the number of cube faces of a non-linear projection.
+ *
+ * All functions have to be called with the shared OpenGL context current.
+ */
+class SGCT_EXPORT AntiAliasing {
+public:
+    /// The area of a viewport in the color texture that is reprojected on its own
+    struct Region {
+        /// The area in pixels (x, y, width, height)
+        ivec4 rect = ivec4(0, 0, 0, 0);
+        /// The view-projection matrix of this frame without the jitter, including the
+        /// scene transform. Not set for viewports with a non-linear projection, which
+        /// blend the history at the same pixel
+        std::optional<mat4> viewProjection;
+    };
+
+    AntiAliasing(bool useSmaa, bool useTaa);
+    ~AntiAliasing();
+
+    /**
+     * Creates the textures for a color texture of the \p size with the \p internalFormat,
+     * which is allocated with the \p format and the \p type. The history of the previous
+     * frames is discarded.
+     */
+    void resize(ivec2 size, unsigned int internalFormat, unsigned int format,
+        unsigned int type);
+
+    /**
+     * Applies the anti-aliasing to the \p color texture of the \p eye, which uses the
+     * \p depth texture or 0 if there is none. The framebuffer bindings, the viewport,
+     * and the scissor test are changed by this function.
+     *
+     * \param regions The viewports of the color texture, which are only used by TAA
+     */
+    void apply(unsigned int color, unsigned int depth, int eye,
+        std::span<const Region> regions);
+
+    bool useSmaa() const;
+    bool useTaa() const;
+
+    /**
+     * \return The subpixel jitter of the \p frame in pixels, which is in [-0.5, 0.5] and
+     *         repeats every 8 frames
+     */
+    static vec2 jitter(unsigned int frame);
+
+private:
+    AntiAliasing(const AntiAliasing&) = delete;
+    AntiAliasing(AntiAliasing&&) = delete;
+    AntiAliasing& operator=(const AntiAliasing&) = delete;
+    AntiAliasing& operator=(AntiAliasing&&) = delete;
+
+    struct History {
+        unsigned int texture = 0;
+        bool isValid = false;
+        // The view-projection matrices of the regions in the previous frame
+        std::vector<Region> regions;
+    };
+
+    void copy(unsigned int color);
+    void applySmaa(unsigned int color);
+    void applyTaa(unsigned int color, unsigned int depth, History& history,
+        std::span<const Region> regions);
+    // Draws the bound shader into the target, which is cleared first if clear is true
+    void draw(unsigned int target, bool clear);
+
+    const bool _useSmaa;
+    const bool _useTaa;
+
+    unsigned int _fbo = 0;
+    unsigned int _vao = 0;
+    ivec2 _size = ivec2(0, 0);
+    unsigned int _internalFormat = 0;
+    unsigned int _format = 0;
+    unsigned int _type = 0;
+
+    // A copy of the color texture, as the passes cannot read the texture they write
+    RenderTargetPool::Target _source;
+    RenderTargetPool::Target _edges;
+    RenderTargetPool::Target _weights;
+
+    ShaderProgram _edgeShader;
+    ShaderProgram _weightsShader;
+    ShaderProgram _blendShader;
+    ShaderProgram _resolveShader;
+    int _hasDepthLoc = -1;
+    int _reprojectionLoc = -1;
+    int _viewportLoc = -1;
+    int _feedbackLoc = -1;
+
+    // One history per eye
+    std::array<History, 2> _histories;
+    MemoryAccount _historyMemory = MemoryAccount(MemoryTracker::Category::Framebuffers);
+};
+
+} // namespace sgct
+
+#endif // __SGCT__ANTIALIASING__H__
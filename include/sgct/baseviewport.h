@@ -31,8 +31,16 @@ public:
 
     void setupViewport(FrustumMode frustum) const;
 
+    /**
+     * \return The area of the framebuffer in pixels (x, y, width, height) into which the
+     *         \p frustum of this viewport is rendered, which is half of the viewport in
+     *         the side-by-side and top-bottom stereo modes
+     */
+    ivec4 pixelCoordinates(FrustumMode frustum) const;
+
     const Projection& projection(FrustumMode frustumMode) const;
     ProjectionPlane& projectionPlane();
+    const ProjectionPlane& projectionPlane() const;
 
     virtual void calculateFrustum(FrustumMode mode, float nearClip, float farClip);
 
@@ -0,0 +1,120 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__BENCHMARK__H__
+#define __SGCT__BENCHMARK__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/shaderprogram.h>
+#include <filesystem>
+#include <vector>
+
+namespace sgct {
+
+struct RenderData;
+
+/**
+ * Renders a fixed synthetic scene instead of the content of the application, so that
+ * the overhead of SGCT can be measured on its own with the configured windows and
+ * projections. The scene is a grid of rotating cubes that is viewed along a camera path,
+ * both of which only depend on the cluster frame number, so all nodes render the same
+ * frames in every run. After a number of warm-up frames, the times of each frame are
+ * recorded and their percentiles are written into a JSON file.
+ */
+class SGCT_EXPORT Benchmark {
+public:
+    /// The number of frames in the beginning that are rendered but not measured
+    static constexpr int WarmupFrames = 100;
+
+    /// The times in seconds that are recorded for each frame
+    struct Frame {
+        /// The time between the start of this frame and of the previous one
+        double frameTime = 0.0;
+
+        /// The CPU time of rendering all windows
+        double drawTime = 0.0;
+
+        /// The GPU time of rendering all windows, which is a few frames old
+        double gpuDrawTime = 0.0;
+
+        /// The time spent in both frame lock stages
+        double syncTime = 0.0;
+
+        /// The GPU time of compositing the framebuffers onto all windows
+        double compositeTime = 0.0;
+    };
+
+    /**
+     * Creates the scene for measuring \p nFrames frames, whose results are written into
+     * the \p output file. The \p cameraPath is a text file with one keyframe of the
+     * camera per line as `frame x y z yaw pitch roll`, with the position in meters and
+     * the angles in degrees, between which the camera is interpolated linearly. Lines
+     * that are empty or start with `#` are ignored. If the path is empty, the camera
+     * circles around the center of the scene once during the benchmark.
+     *
+     * \pre The OpenGL context has to be current
+     * \throw Error If the camera path cannot be read
+     */
+    Benchmark(int nFrames, std::filesystem::path output,
+        const std::filesystem::path& cameraPath);
+    ~Benchmark();
+
+    /**
+     * Renders the scene with the matrices of the \p data. This is used in place of the
+     * draw callback of the application.
+     */
+    void draw(const RenderData& data) const;
+
+    /**
+     * Records the times of the \p frame, unless it is one of the warm-up frames.
+     *
+     * \return `true` once all frames have been measured
+     */
+    bool addFrame(const Frame& frame);
+
+    /**
+     * Writes the percentiles of the recorded times and a description of the workload
+     * and of this node with the \p nodeId into the output file.
+     *
+     * \return The path of the file, which is empty if it could not be written
+     */
+    std::filesystem::path writeResults(int nodeId) const;
+
+private:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark(Benchmark&&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+    Benchmark& operator=(Benchmark&&) = delete;
+
+    // The transformation from the scene into the coordinates of the camera
+    mat4 cameraTransform(unsigned int frame) const;
+
+    struct Keyframe {
+        double frame = 0.0;
+        vec3 position;
+        // Yaw, pitch, and roll in degrees
+        vec3 orientation;
+    };
+    std::vector<Keyframe> _cameraPath;
+
+    const int _nFrames;
+    const std::filesystem::path _output;
+    int _nWarmupFrames = 0;
+    std::vector<Frame> _frames;
+
+    unsigned int _vao = 0;
+    ShaderProgram _program;
+    // Renders into several layers in one pass for the single pass stereo and the layered
+    // cube maps
+    ShaderProgram _layeredProgram;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__BENCHMARK__H__
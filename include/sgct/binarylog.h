@@ -0,0 +1,151 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__BINARYLOG__H__
+#define __SGCT__BINARYLOG__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * A log for events that happen too often to be formatted as text, such as the network
+ * and frame events, and that is cheap enough to be left enabled permanently. Instead of
+ * the formatted message, each event only stores the id of its format string and the raw
+ * values of up to #MaxArguments arithmetic arguments in a fixed-size record. The format
+ * strings, which use the syntax of `std::format`, are stored once in a table at the
+ * beginning of the file. The records are written into a ring of #Capacity records in a
+ * memory-mapped file, so only the most recent events are kept, and the file is complete
+ * even if the application crashes. The file is turned into text with #decode, which is
+ * what the `logdecoder` application does.
+ *
+ * The events are written with the #BinaryLogN macro, which only costs a single check if
+ * the log is not enabled.
+ */
+class SGCT_EXPORT BinaryLog {
+public:
+    /// The maximum number of arguments of an event
+    static constexpr int MaxArguments = 4;
+
+    /// The number of records that are kept in the ring
+    static constexpr uint64_t Capacity = 65536;
+
+    /// The number of bytes that are reserved for the format strings in the file
+    static constexpr size_t FormatTableSize = 64 * 1024;
+
+    /// One argument of an event with its type, which decides how it is formatted
+    struct Argument {
+        enum class Type : uint8_t { Signed, Unsigned, Floating };
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        Argument(T value) {
+            if constexpr (std::is_floating_point_v<T>) {
+                type = Type::Floating;
+                bits = std::bit_cast<uint64_t>(static_cast<double>(value));
+            }
+            else if constexpr (std::is_signed_v<T>) {
+                type = Type::Signed;
+                bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+            }
+            else {
+                type = Type::Unsigned;
+                bits = static_cast<uint64_t>(value);
+            }
+        }
+
+        Type type;
+        uint64_t bits;
+    };
+
+    /**
+     * Creates the log file `binarylog-node<id>.sgctlog` for the \p nodeId in the
+     * \p folder, which is created if it does not exist, and starts recording into it. An
+     * existing file is replaced. If the file cannot be created, an error is logged and
+     * nothing is recorded.
+     */
+    static void enable(const std::filesystem::path& folder, int nodeId);
+
+    /**
+     * Stops recording and unmaps the log file.
+     *
+     * \pre No other thread is writing an event
+     */
+    static void disable();
+
+    /**
+     * \return `true` if the events are being recorded
+     */
+    static bool isEnabled();
+
+    /**
+     * Sets the \p offset in seconds that is added to the local time to get the time of
+     * the master node, which the decoder applies to all times in the file.
+     */
+    static void setClockOffset(double offset);
+
+    /**
+     * Adds the \p format to the table of format strings in the file. The \p format has
+     * to stay valid until the application ends, which string literals do.
+     *
+     * \return The id of the format, which is 0 if the table is full
+     */
+    static uint32_t registerFormat(const char* format);
+
+    /**
+     * Writes an event with the \p format that was returned by #registerFormat and the
+     * \p arguments into the next record of the ring. This is thread-safe and does not
+     * take a lock.
+     *
+     * \pre The log has to be enabled
+     */
+    template <typename... Args>
+    static void write(uint32_t format, Args... arguments) {
+        static_assert(sizeof...(Args) <= MaxArguments, "Too many arguments");
+        const std::array<Argument, sizeof...(Args)> args = { Argument(arguments)... };
+        writeRecord(format, args);
+    }
+
+    /**
+     * Turns the content of a log file into one line of text per record that is still
+     * kept, starting with the oldest one. Each line starts with the time of the event on
+     * the master's clock.
+     *
+     * \throw std::runtime_error If the \p data is not a binary log file
+     */
+    static std::vector<std::string> decode(std::span<const std::byte> data);
+
+private:
+    static void writeRecord(uint32_t format, std::span<const Argument> arguments);
+};
+
+} // namespace sgct
+
+/**
+ * Writes an event with the \p format, which has to be a string literal, and up to
+ * BinaryLog::MaxArguments arithmetic arguments into the binary log if it is enabled.
+ */
+#define BinaryLogN(format, ...)                                                          \
+    do {                                                                                 \
+        if (sgct::BinaryLog::isEnabled()) [[unlikely]] {                                 \
+            static const uint32_t sgctBinaryLogFormat =                                  \
+                sgct::BinaryLog::registerFormat(format);                                 \
+            sgct::BinaryLog::write(sgctBinaryLogFormat __VA_OPT__(,) __VA_ARGS__);       \
+        }                                                                                \
+    } while (false)
+
+#endif // __SGCT__BINARYLOG__H__
@@ -0,0 +1,103 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__BUFFERPOLICY__H__
+#define __SGCT__BUFFERPOLICY__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/config.h>
+#include <cstddef>
+
+namespace sgct {
+
+/**
+ * Provides the memory of the large buffers that are touched every frame, such as the
+ * receive buffers of the network connections and the pixels of the captured frames.
+ * Buffers of at least #MinimumSize bytes are mapped directly from the operating system
+ * instead of the heap, so that they can be backed by huge pages, which reduces the TLB
+ * misses of streaming through them, and placed on a NUMA node, for example the one that
+ * the network card or the GPU is attached to. Smaller buffers are allocated on the heap.
+ *
+ * On Linux, the huge pages are transparent huge pages, which requires the
+ * `/sys/kernel/mm/transparent_hugepage/enabled` setting to be `madvise` or `always`. On
+ * Windows, large pages require the "Lock pages in memory" privilege and fall back to
+ * regular pages without it. macOS ignores both hints.
+ */
+class SGCT_EXPORT BufferPolicy {
+public:
+    enum class Subsystem { Network, SharedData, Capture, Ndi };
+
+    /// The size of the buffers from which on they are mapped from the operating system
+    static constexpr size_t MinimumSize = 256 * 1024;
+
+    /// The size of a huge page, and the granularity of the buffers using huge pages
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * Sets the placement of the buffers of each subsystem that are allocated afterwards.
+     * Without a configuration, all subsystems use huge pages and no NUMA node.
+     */
+    static void configure(const config::Settings::Buffers& buffers);
+
+    /**
+     * Allocates a buffer of \p bytes for the \p subsystem.
+     *
+     * \throw std::bad_alloc If the memory cannot be allocated
+     */
+    static void* allocate(Subsystem subsystem, size_t bytes);
+
+    /**
+     * Frees the \p data that was returned by #allocate with the same number of \p bytes.
+     */
+    static void deallocate(void* data, size_t bytes);
+
+    /**
+     * Applies the hints of the \p subsystem to an existing buffer that was not allocated
+     * by #allocate, for buffers whose type cannot be changed. Only the huge pages that
+     * lie entirely within the buffer are affected, and the pages that were already
+     * touched are migrated to the NUMA node.
+     */
+    static void advise(Subsystem subsystem, void* data, size_t bytes);
+};
+
+/**
+ * An allocator for standard containers that allocates their memory through the
+ * BufferPolicy for the subsystem \p S.
+ */
+template <typename T, BufferPolicy::Subsystem S>
+class BufferAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = BufferAllocator<U, S>;
+    };
+
+    BufferAllocator() noexcept = default;
+
+    template <typename U>
+    BufferAllocator(const BufferAllocator<U, S>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(BufferPolicy::allocate(S, n * sizeof(T)));
+    }
+
+    void deallocate(T* data, size_t n) noexcept {
+        BufferPolicy::deallocate(data, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const BufferAllocator<U, S>&) const noexcept {
+        return true;
+    }
+};
+
+} // namespace sgct
+
+#endif // __SGCT__BUFFERPOLICY__H__
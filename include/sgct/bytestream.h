@@ -0,0 +1,320 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__BYTESTREAM__H__
+#define __SGCT__BYTESTREAM__H__
+
+#include <sgct/sgctexports.h>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Lists the members of an aggregate that the ByteWriter serializes and the ByteReader
+ * deserializes, in the order in which they are listed. The members are written one
+ * after another, so the padding between them is not sent. Each member can be of any type
+ * that the ByteWriter supports, including arrays of and other types with a member list.
+ * The macro has to be placed inside the definition of the type:
+ *
+ * \code{.cpp}
+ * struct State {
+ *     vec3 position;
+ *     sgct::Quantized<0.f, 1.f> opacity;
+ *     std::string name;
+ *
+ *     SGCT_SERIALIZE_MEMBERS(position, opacity, name)
+ * };
+ * \endcode
+ */
+#define SGCT_SERIALIZE_MEMBERS(...)                                                      \
+    template <typename Fn>                                                               \
+    void sgctVisitMembers(Fn&& fn) {                                                     \
+        fn(__VA_ARGS__);                                                                 \
+    }                                                                                    \
+    template <typename Fn>                                                               \
+    void sgctVisitMembers(Fn&& fn) const {                                               \
+        fn(__VA_ARGS__);                                                                 \
+    }
+
+namespace sgct {
+
+/**
+ * A floating point value in the range [\p Min, \p Max] that is serialized as an integer
+ * of type \p Storage instead of as a `float`, trading precision for size. With the
+ * default `uint16_t`, the value is sent with a resolution of (Max - Min) / 65535. Values
+ * outside the range are clamped when they are serialized.
+ */
+template <float Min, float Max, std::unsigned_integral Storage = uint16_t>
+struct Quantized {
+    static_assert(Min < Max, "The range must not be empty");
+
+    using StorageType = Storage;
+
+    Quantized& operator=(float v) {
+        value = v;
+        return *this;
+    }
+
+    operator float() const {
+        return value;
+    }
+
+    Storage quantized() const {
+        constexpr double Steps = std::numeric_limits<Storage>::max();
+        const double t = (static_cast<double>(value) - Min) / (Max - Min);
+        // Written this way round so that a NaN ends up at the lower end of the range
+        const double clamped = t > 0.0 ? std::min(t, 1.0) : 0.0;
+        return static_cast<Storage>(std::llround(clamped * Steps));
+    }
+
+    void setQuantized(Storage q) {
+        constexpr double Steps = std::numeric_limits<Storage>::max();
+        value = static_cast<float>(Min + (Max - Min) * (q / Steps));
+    }
+
+    float value = Min;
+};
+
+namespace detail {
+    template <typename T>
+    constexpr bool IsQuantized = false;
+
+    template <float Min, float Max, typename Storage>
+    constexpr bool IsQuantized<Quantized<Min, Max, Storage>> = true;
+
+    template <typename T>
+    concept HasMemberList = requires(T& value) {
+        value.sgctVisitMembers([](auto&...) {});
+    };
+
+    // Types that are serialized as their in-memory representation
+    template <typename T>
+    concept IsPlain =
+        std::is_trivially_copyable_v<T> && !IsQuantized<T> && !HasMemberList<T>;
+} // namespace detail
+
+/**
+ * Reads values from a block of serialized data without copying the block. Every read is
+ * bounds checked and throws an Error if the block is too short. The values have to be
+ * stored in the format that is written by the ByteWriter and the serializeObject
+ * functions, that is plain-old data types in their in-memory representation, and
+ * strings and arrays as their number of elements as a `uint32_t` followed by the
+ * elements.
+ */
+class SGCT_EXPORT ByteReader {
+public:
+    explicit ByteReader(std::span<const std::byte> data);
+
+    template <typename T>
+    T read() {
+        T value;
+        read(value);
+        return value;
+    }
+
+    template <typename T>
+    void read(T& value) {
+        if constexpr (detail::IsQuantized<T>) {
+            value.setQuantized(read<typename T::StorageType>());
+        }
+        else if constexpr (detail::HasMemberList<T>) {
+            value.sgctVisitMembers([this](auto&... members) { (read(members), ...); });
+        }
+        else {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "Type has to be a plain-old data type or list its members"
+            );
+
+            require(sizeof(T));
+            std::memcpy(&value, _data.data() + _pos, sizeof(T));
+            _pos += sizeof(T);
+        }
+    }
+
+    /**
+     * Reads an array into the \p value. The memory that is already allocated by the
+     * \p value is reused if it is large enough.
+     */
+    template <typename T>
+    void read(std::vector<T>& value) {
+        const uint32_t size = read<uint32_t>();
+        if constexpr (detail::IsPlain<T>) {
+            require(size * sizeof(T));
+            value.resize(size);
+            if (size > 0) {
+                std::memcpy(value.data(), _data.data() + _pos, size * sizeof(T));
+            }
+            _pos += size * sizeof(T);
+        }
+        else {
+            // Every element occupies at least one byte, which rejects a corrupted size
+            // before the vector is resized
+            require(size);
+            value.resize(size);
+            for (T& v : value) {
+                read(v);
+            }
+        }
+    }
+
+    void read(std::string& value);
+    void read(std::wstring& value);
+
+    /**
+     * Reads an array without copying it. The returned view points into the data of this
+     * reader and is only valid as long as that data is. The elements must be correctly
+     * aligned in memory, which the writer can ensure by calling ByteWriter::align before
+     * writing the array and the reader by calling #align before reading it.
+     *
+     * \throw Error If the array is not suitably aligned for the type \p T
+     */
+    template <typename T>
+    std::span<const T> readArray() {
+        static_assert(
+            detail::IsPlain<T>,
+            "Type has to be a plain-old data type"
+        );
+
+        const uint32_t size = read<uint32_t>();
+        require(size * sizeof(T));
+        const std::byte* begin = _data.data() + _pos;
+        requireAlignment(begin, alignof(T));
+        _pos += size * sizeof(T);
+        return std::span<const T>(reinterpret_cast<const T*>(begin), size);
+    }
+
+    /**
+     * Reads a string without copying it. The returned view points into the data of this
+     * reader and is only valid as long as that data is.
+     */
+    std::string_view readStringView();
+
+    /**
+     * Reads \p size raw bytes without copying them. The returned view points into the
+     * data of this reader and is only valid as long as that data is.
+     */
+    std::span<const std::byte> readBytes(size_t size);
+
+    /**
+     * Skips the padding that the ByteWriter::align function with the same
+     * \p alignment has inserted.
+     */
+    void align(size_t alignment);
+
+    size_t position() const;
+    size_t remaining() const;
+
+private:
+    void require(size_t size) const;
+    void requireAlignment(const std::byte* ptr, size_t alignment) const;
+
+    std::span<const std::byte> _data;
+    size_t _pos = 0;
+};
+
+/**
+ * Appends serialized values to a buffer in the format that is read by the ByteReader and
+ * the deserializeObject functions. The writer only appends to the buffer, so the memory
+ * that the buffer has allocated previously is reused.
+ */
+class SGCT_EXPORT ByteWriter {
+public:
+    explicit ByteWriter(std::vector<std::byte>& buffer);
+
+    /**
+     * Reserves space for an additional \p size bytes in the buffer so that the following
+     * writes do not have to grow the buffer.
+     */
+    void reserve(size_t size);
+
+    template <typename T>
+    void write(const T& value) {
+        if constexpr (detail::IsQuantized<T>) {
+            write(value.quantized());
+        }
+        else if constexpr (detail::HasMemberList<T>) {
+            value.sgctVisitMembers(
+                [this](const auto&... members) { (write(members), ...); }
+            );
+        }
+        else {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "Type has to be a plain-old data type or list its members"
+            );
+
+            append(&value, sizeof(T));
+        }
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& value) {
+        if constexpr (detail::IsPlain<T>) {
+            writeArray(std::span<const T>(value));
+        }
+        else {
+            write(static_cast<uint32_t>(value.size()));
+            for (const T& v : value) {
+                write(v);
+            }
+        }
+    }
+
+    void write(std::string_view value);
+    void write(const std::string& value);
+    void write(const char* value);
+    void write(const std::wstring& value);
+
+    template <typename T>
+    void writeArray(std::span<const T> value) {
+        static_assert(
+            detail::IsPlain<T>,
+            "Type has to be a plain-old data type"
+        );
+
+        write(static_cast<uint32_t>(value.size()));
+        append(value.data(), value.size_bytes());
+    }
+
+    /**
+     * Writes the raw bytes of the \p value without their size, which can be read back
+     * with ByteReader::readBytes.
+     */
+    void writeBytes(std::span<const std::byte> value);
+
+    /**
+     * Pads the data with zeros until the number of bytes written by this writer is a
+     * multiple of the \p alignment, which lets a ByteReader return views into arrays.
+     */
+    void align(size_t alignment);
+
+    /**
+     * \return The number of bytes written by this writer
+     */
+    size_t size() const;
+
+private:
+    void append(const void* data, size_t size);
+
+    std::vector<std::byte>& _buffer;
+    const size_t _begin;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__BYTESTREAM__H__
@@ -12,6 +12,10 @@
 #include <sgct/sgctexports.h>
 #include <sgct/definitions.h>
 #include <sgct/math.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 #include <utility>
 
 namespace sgct {
@@ -44,6 +48,125 @@ struct SGCT_EXPORT RenderData {
     mat4 modelViewProjectionMatrix;
 
     ivec2 bufferSize;
+
+    struct EyeMatrices {
+        mat4 viewMatrix;
+        mat4 projectionMatrix;
+        mat4 modelViewProjectionMatrix;
+    };
+
+    /// Only set if both eyes are rendered in a single pass into the two layers of a
+    /// texture array. The matrices above then belong to the left eye in layer 0 and
+    /// these to the right eye in layer 1
+    std::optional<EyeMatrices> rightEye;
+
+    struct CubeFaces {
+        std::array<mat4, 6> viewMatrices;
+        std::array<mat4, 6> projectionMatrices;
+        std::array<mat4, 6> modelViewProjectionMatrices;
+
+        /// Bit `i` is set if the face `i` is used by the projection. The faces are in the
+        /// order of the cube map layers, that is +X, -X, +Y, -Y, +Z, -Z
+        uint8_t faceMask = 0;
+    };
+
+    /// Only set if all faces of a cube map are rendered in a single pass into the layers
+    /// of the cube map. The shaders have to write the index of the face to both
+    /// `gl_Layer` and `gl_ViewportIndex`. The matrices above belong to the first face
+    /// that is used
+    std::optional<CubeFaces> cubeFaces;
+
+    struct Fisheye {
+        /// Half of the field of view of the fisheye in radians
+        float halfFov = 0.f;
+
+        /// Map the position on the unit disk of the fisheye to normalized device
+        /// coordinates and contain the aspect ratio and the crop factors
+        vec2 scale = vec2{ 1.f, 1.f };
+        vec2 offset = vec2{ 0.f, 0.f };
+
+        float nearClip = 0.f;
+        float farClip = 0.f;
+    };
+
+    /// Only set if a fisheye projection is rendered directly instead of through a cube
+    /// map, in which case the vertex or tessellation shaders have to warp the geometry
+    /// into the fisheye. The fisheye looks along the negative z-axis of the view matrix
+    /// and the projection matrix is the identity. A position `p` in view space is drawn
+    /// at `ndc.xy = acos(-normalize(p).z) / halfFov * normalize(p.xy) * scale + offset`
+    /// and `ndc.z = 2 * (length(p) - nearClip) / (farClip - nearClip) - 1`. Geometry
+    /// beyond `halfFov` falls outside of the fisheye disk and should be clipped, and
+    /// long edges have to be tessellated as they are curved in the fisheye
+    std::optional<Fisheye> fisheye;
+
+    struct OmniStereo {
+        /// The uniform buffer binding point to which the tiles of the batch are bound
+        static constexpr unsigned int UniformBinding = 0;
+
+        /// The length of the tile array in the uniform block and thereby the largest
+        /// number of tiles in a batch
+        static constexpr int MaxTiles = 192;
+
+        /// The number of tiles in this batch, which is the number of instances that each
+        /// part of the scene has to be drawn with
+        int nTiles = 0;
+    };
+
+    /// Only set if a fisheye projection is rendered as omni-directional stereo, in which
+    /// case the draw function is called once for every batch of tiles. Each tile has its
+    /// own view projection matrix and has to be drawn as one instance. The tiles are
+    /// bound to #OmniStereo::UniformBinding as the uniform block
+    /// `layout(std140) uniform OmniStereoTiles { Tile tiles[192]; }` of the
+    /// `struct Tile { mat4 viewProjection; vec4 rect; }`. A vertex shader computes
+    /// `vec4 p = tiles[gl_InstanceID].viewProjection * model * position`, writes
+    /// `p.w + p.x`, `p.w - p.x`, `p.w + p.y`, and `p.w - p.y` into the enabled
+    /// `gl_ClipDistance[0]` to `gl_ClipDistance[3]`, and outputs
+    /// `gl_Position = vec4(p.xy * rect.zw + rect.xy * p.w, p.zw)`, which moves the tile
+    /// from the entire viewport to its rectangle with the center `rect.xy` and the half
+    /// size `rect.zw`. The view and projection matrices above are the identity
+    std::optional<OmniStereo> omniStereo;
+
+    struct RadialDepth {
+        /// The GLSL source of the function `float sgctRadialDepth(vec3 viewPosition,
+        /// float nearClip, float farClip)`, which can be added to a fragment shader after
+        /// its version directive
+        static constexpr std::string_view Function = R"(
+  float sgctRadialDepth(vec3 viewPosition, float nearClip, float farClip) {
+    float a = farClip / (farClip - nearClip);
+    float b = farClip * nearClip / (nearClip - farClip);
+    return a + b / length(viewPosition);
+  }
+)";
+
+        float nearClip = 0.f;
+        float farClip = 0.f;
+    };
+
+    /// Only set if a cube face of a non-linear projection is rendered whose depth is
+    /// transformed into the depth of the projection, which depends on the distance from
+    /// the center of the cube instead of the distance from the plane of the face. The
+    /// fragment shaders then write the depth of the position `p` in view space as
+    /// `gl_FragDepth = sgctRadialDepth(p, nearClip, farClip)` using #Function, which
+    /// encodes the distance like a perspective projection encodes the distance from its
+    /// plane. Fragment shaders that do not write it leave the planar depth of the face
+    std::optional<RadialDepth> radialDepth;
+
+    struct EyePair {
+        /// `true` for the call of the left eye, which comes first, and `false` for the
+        /// call of the right eye that directly follows it for the same cube face
+        bool isFirst = true;
+
+        /// The distance between the two eyes, by which the frustum of the left eye has
+        /// to be widened sideways to also contain everything that the right eye sees
+        float eyeSeparation = 0.f;
+    };
+
+    /// Only set if the cube faces of a stereoscopic non-linear projection are rendered
+    /// with the eyes interleaved, in which case the draw function is called for the
+    /// right eye of a face directly after the left eye of the same face. The application
+    /// can then cull the scene once in the first call against the frustum of the left
+    /// eye widened by the eye separation and reuse the result in the second call
+    std::optional<EyePair> eyePair;
 };
 
 } // namespace sgct
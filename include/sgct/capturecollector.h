@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CAPTURECOLLECTOR__H__
+#define __SGCT__CAPTURECOLLECTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Collects the screenshots of all nodes on the master node. The clients save their
+ * screenshots into their own capture path as usual, which acts as a staging area, and
+ * a sender thread streams the saved files one at a time to the master through the data
+ * transfer connection as chunked transfers. Once a file has been received completely,
+ * it is removed from the client. The master writes the received chunks directly into
+ * the file `<capture path>/node<id>/<file name>`, so that at most one file per client is
+ * held in memory on either side.
+ */
+class SGCT_EXPORT CaptureCollector {
+public:
+    /**
+     * The package id of the chunked data transfers that contain the screenshots. These
+     * transfers are not passed to the data transfer callbacks of the application.
+     */
+    static constexpr int PackageId = std::numeric_limits<int>::min();
+
+    struct Statistics {
+        /// The number of screenshots that are waiting to be sent to the master
+        uint64_t nPending = 0;
+
+        /// The number of screenshots that were sent to the master
+        uint64_t nSent = 0;
+
+        /// The number of bytes that were sent to the master
+        uint64_t bytesSent = 0;
+
+        /// The time in seconds that was spent sending screenshots
+        double sendTime = 0.0;
+
+        /// The number of screenshots that were received from the clients
+        uint64_t nReceived = 0;
+
+        /// The number of bytes that were received from the clients
+        uint64_t bytesReceived = 0;
+    };
+
+    CaptureCollector() = default;
+
+    /**
+     * Waits until the queued screenshots have been sent to the master or the network is
+     * shut down. Screenshots that could not be sent remain in the capture path.
+     */
+    ~CaptureCollector();
+
+    /**
+     * Queues the screenshot that was saved into the file at the \p path to be sent to the
+     * master. This function can be called from multiple threads at the same time.
+     */
+    void send(std::filesystem::path path);
+
+    /**
+     * Handles one chunk of a screenshot that is received by the master. The parameters
+     * are the same as for the data transfer chunk callback.
+     */
+    void receive(const void* data, int length, uint64_t offset, uint64_t total,
+        int clientIndex);
+
+    /**
+     * \return The number of screenshots and bytes that were sent and received so far
+     */
+    Statistics statistics() const;
+
+private:
+    CaptureCollector(const CaptureCollector&) = delete;
+    CaptureCollector(CaptureCollector&&) = delete;
+    CaptureCollector& operator=(const CaptureCollector&) = delete;
+    CaptureCollector& operator=(CaptureCollector&&) = delete;
+
+    /// The state of a file that is being received from one of the clients
+    struct Incoming {
+        // The node id and file name that precede the content of the file
+        std::string header;
+        std::filesystem::path path;
+        std::ofstream file;
+        uint64_t received = 0;
+    };
+
+    void work();
+    bool sendFile(const std::filesystem::path& path);
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::filesystem::path> _queue;
+    bool _isRunning = true;
+    std::thread _sender;
+    // Only used by the sender thread, so that the files are not read into a new buffer
+    // every time
+    std::vector<char> _buffer;
+
+    std::mutex _incomingMutex;
+    std::map<int, Incoming> _incoming;
+
+    std::atomic_uint64_t _nSent = 0;
+    std::atomic_uint64_t _bytesSent = 0;
+    std::atomic<double> _sendTime = 0.0;
+    std::atomic_uint64_t _nReceived = 0;
+    std::atomic_uint64_t _bytesReceived = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__CAPTURECOLLECTOR__H__
@@ -29,6 +29,19 @@ class User;
  */
 class SGCT_EXPORT ClusterManager {
 public:
+    /// The options of the sockets of the sync or of the data transfer connections
+    struct SocketProfile {
+        /// The sizes of the socket buffers in bytes, or 0 to use the system's default
+        int sendBufferSize = 0;
+        int receiveBufferSize = 0;
+        /// The DSCP value with which the packets are marked, or -1 if they are not
+        int dscp = -1;
+        /// The local address of the interface to bind to, or empty for any interface
+        std::string interfaceAddress;
+        /// Whether the send buffer is sized from the round trip time and the bandwidth
+        bool autoTuneBuffers = false;
+    };
+
     static ClusterManager& instance();
     static void create(const config::Cluster& cluster, int clusterID);
     static void destroy();
@@ -113,6 +126,149 @@ public:
      */
     bool firmFrameLockSyncStatus() const;
 
+    /**
+     * \return `true` if the master only sends the changes in the shared data to clients
+     */
+    bool useDeltaSync() const;
+
+    /**
+     * \return The maximum number of frames between two full shared data blocks if delta
+     *         sync is enabled
+     */
+    int deltaSyncKeyframeInterval() const;
+
+    /**
+     * \return `true` if messages sent to other nodes should be compressed
+     */
+    bool useCompression() const;
+
+    /**
+     * \return The minimum size in bytes of a message before it is compressed
+     */
+    int compressionThreshold() const;
+
+    /**
+     * \return The zlib compression level between 1 and 9 used for compressed messages
+     */
+    int compressionLevel() const;
+
+    /**
+     * \return The multicast group address to which the shared data is broadcast, or an
+     *         empty string if the shared data is sent over the TCP sync connections
+     */
+    const std::string& multicastAddress() const;
+
+    /**
+     * \return The UDP port to which the shared data is broadcast
+     */
+    int multicastPort() const;
+
+    /**
+     * \return `true` if the shared data is sent to all clients concurrently
+     */
+    bool useParallelSend() const;
+
+    /**
+     * \return `true` if incoming messages are handled by a shared event loop instead of
+     *         a separate thread for each connection
+     */
+    bool useEventDrivenNetwork() const;
+
+    /**
+     * \return `true` if the master only waits for the clients' acknowledgement of the
+     *         previous frame rather than the current one
+     */
+    bool usePipelinedSync() const;
+
+    /**
+     * \return The size in bytes of the chunks of a chunked data transfer
+     */
+    int transferChunkSize() const;
+
+    /**
+     * \return The bandwidth limit of chunked data transfers in kilobytes per second, or
+     *         0 if the bandwidth is not limited
+     */
+    int transferRateLimit() const;
+
+    /**
+     * \return The number of data transfer packages that can be unacknowledged on a
+     *         connection at the same time, or 0 if the number is not limited
+     */
+    int transferWindow() const;
+
+    /**
+     * \return The time in seconds after which the master stops waiting for nodes that
+     *         are not critical, or 0 if the master always waits for all nodes
+     */
+    double syncDeadline() const;
+
+    /**
+     * \return `true` if the shared data is passed to clients on the same computer
+     *         through shared memory instead of the network
+     */
+    bool useSharedMemory() const;
+
+    /**
+     * \return The size in bytes of the memory region used by
+     *         NetworkManager::transferRdmaData, or 0 if it is disabled
+     */
+    int rdmaBufferSize() const;
+
+    /**
+     * \return `true` if the clients send their log messages to the master node
+     */
+    bool forwardLog() const;
+
+    /**
+     * \return The TCP port on which the performance metrics of this node are served, or
+     *         0 if they are not served
+     */
+    int metricsPort() const;
+
+    /**
+     * \return The TCP port on which the master receives external control messages, or 0
+     *         if no control connections are accepted
+     */
+    int controlPort() const;
+
+    /**
+     * \return The UDP port on which the master receives external control messages, or 0
+     *         if no control datagrams are received
+     */
+    int controlUdpPort() const;
+
+    /**
+     * \return The options of the sockets of the connections that synchronize the frames
+     */
+    const SocketProfile& syncSocketProfile() const;
+
+    /**
+     * \return The options of the sockets of the data transfer connections
+     */
+    const SocketProfile& transferSocketProfile() const;
+
+    /**
+     * \return `true` if the clients forward the data transfers of the master to other
+     *         clients along a chain or a tree instead of the master sending to every
+     *         client itself
+     */
+    bool relaysTransfers() const;
+
+    /**
+     * \return The index of the node that sends the data transfers of the master to the
+     *         node with the \p nodeIndex if the transfers are relayed, which is either
+     *         the #masterNodeIndex or another client, or -1 for the master and for nodes
+     *         without a data transfer port
+     */
+    int transferParent(int nodeIndex) const;
+
+    /**
+     * \return The index of the node whose address is the master address, or 0 if no
+     *         node has that address
+     */
+    int masterNodeIndex() const;
+
     /**
      * Set if software sync between nodes should be ignored.
      */
@@ -137,7 +293,33 @@ private:
     const int _thisNodeId;
     bool _firmFrameLockSync;
     bool _ignoreSync = false;
+    bool _useDeltaSync = false;
+    int _deltaSyncKeyframeInterval = 60;
+    bool _useCompression = false;
+    int _compressionThreshold = 1024;
+    int _compressionLevel = 1;
+    std::string _multicastAddress;
+    int _multicastPort = 20500;
+    bool _useParallelSend = false;
+    bool _useEventDrivenNetwork = false;
+    bool _usePipelinedSync = false;
+    int _transferChunkSize = 1024 * 1024;
+    int _transferRateLimit = 0;
+    int _transferWindow = 0;
+    double _syncDeadline = 0.0;
+    bool _useSharedMemory = true;
+    int _rdmaBufferSize = 0;
+    bool _forwardLog = false;
+    int _metricsPort = 0;
+    int _controlPort = 0;
+    int _controlUdpPort = 0;
+    SocketProfile _syncSocketProfile;
+    SocketProfile _transferSocketProfile;
     std::string _masterAddress;
+    int _masterNodeIndex = 0;
+    // The parent of each node in the relay topology, or empty if the data transfers are
+    // not relayed
+    std::vector<int> _transferParents;
 
     std::vector<std::unique_ptr<Node>> _nodes;
     std::vector<std::unique_ptr<User>> _users;
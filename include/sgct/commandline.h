@@ -22,6 +22,7 @@ struct SGCT_EXPORT Configuration {
     std::optional<std::string> configFilename;
     std::optional<bool> isServer;
     std::optional<Log::Level> logLevel;
+    std::optional<bool> asyncLog;
     std::optional<bool> showHelpText;
     std::optional<int> nodeId;
     std::optional<bool> firmSync;
@@ -32,9 +33,20 @@ struct SGCT_EXPORT Configuration {
     std::optional<bool> addNodeNameInScreenshot;
     std::optional<bool> omitWindowNameInScreenshot;
     std::optional<bool> useOpenGLDebugContext;
+    std::optional<bool> headless;
+
+    std::optional<int> benchmarkFrames;
+    std::optional<std::filesystem::path> benchmarkPath;
+    std::optional<std::filesystem::path> benchmarkCameraPath;
 
     std::optional<bool> printWaitMessage;
     std::optional<float> waitTimeout;
+
+    /// The port on which the master serves its configuration to the clients
+    std::optional<int> configServePort;
+    /// The address and port of the master from which the configuration is requested
+    std::optional<std::string> configServerAddress;
+    std::optional<int> configServerPort;
 };
 
 /**
@@ -0,0 +1,86 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__COMPRESSEDIMAGE__H__
+#define __SGCT__COMPRESSEDIMAGE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace sgct {
+
+namespace correction { class MappedFile; }
+
+/**
+ * An image in a KTX2 or DDS file whose pixels are stored in one of the BCn or ASTC
+ * formats, which the GPU decompresses while sampling the texture. The file is mapped into
+ * memory and the compressed blocks of the mipmap levels that are stored in it are
+ * uploaded as they are. As the blocks cannot be flipped, the rows of the image have to
+ * be stored from the bottom to the top, which is how SGCT expects all textures, for
+ * example by creating KTX2 files with `toktx --lower_left_maps_to_s0t0`.
+ */
+class SGCT_EXPORT CompressedImage {
+public:
+    /// One mipmap level of the image, with the largest level coming first
+    struct Level {
+        ivec2 size;
+        std::span<const std::byte> data;
+    };
+
+    /**
+     * \return `true` if the file at the \p path starts with the signature of a KTX2 or
+     *         DDS file
+     */
+    static bool isCompressedImage(const std::filesystem::path& path);
+
+    /**
+     * Maps the KTX2 or DDS file at the \p path and locates its mipmap levels.
+     *
+     * \throw Error If the file cannot be read or is malformed, if it uses
+     *        supercompression, or if its pixels are not stored in a supported format
+     */
+    explicit CompressedImage(const std::filesystem::path& path);
+    ~CompressedImage();
+
+    /**
+     * \return The OpenGL internal format of the compressed blocks
+     */
+    unsigned int internalFormat() const;
+
+    /**
+     * \return The size of the largest mipmap level in pixels
+     */
+    ivec2 size() const;
+
+    /**
+     * \return The mipmap levels that are stored in the file
+     */
+    const std::vector<Level>& levels() const;
+
+private:
+    CompressedImage(const CompressedImage&) = delete;
+    CompressedImage(CompressedImage&&) = delete;
+    CompressedImage& operator=(const CompressedImage&) = delete;
+    CompressedImage& operator=(CompressedImage&&) = delete;
+
+    void parseKtx2();
+    void parseDds();
+
+    std::unique_ptr<correction::MappedFile> _file;
+    unsigned int _internalFormat = 0;
+    std::vector<Level> _levels;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__COMPRESSEDIMAGE__H__
@@ -11,8 +11,10 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -40,6 +42,10 @@ SGCT_EXPORT void validateUser(const User& user);
 
 
 struct SGCT_EXPORT Capture {
+    enum class Format { Png, Raw, Video, Exr };
+    enum class Codec { H264, HEVC };
+    enum class CompressionStrategy { Default, Filtered, HuffmanOnly, Rle };
+
     struct ScreenShotRange {
         int first = -1; // inclusive
         int last = -1;  // exclusive
@@ -49,6 +55,18 @@ struct SGCT_EXPORT Capture {
 
     std::optional<std::filesystem::path> path;
     std::optional<ScreenShotRange> range;
+    std::optional<int> queueDepth;
+    std::optional<bool> dropWhenFull;
+    std::optional<Format> format;
+    std::optional<int> compressionLevel;
+    std::optional<CompressionStrategy> compressionStrategy;
+    std::optional<bool> parallelEncoding;
+    std::optional<Codec> codec;
+    std::optional<int> bitrate; // kbit/s
+    std::optional<int> frameRate;
+    std::optional<bool> eightBit;
+    std::optional<float> scale;
+    std::optional<bool> collect;
 
     auto operator<=>(const Capture&) const noexcept = default;
 };
@@ -72,16 +90,171 @@ struct SGCT_EXPORT Settings {
 
     struct Display {
         std::optional<int8_t> swapInterval;
+        std::optional<bool> adaptiveSync;
         std::optional<int> refreshRate;
+        std::optional<float> framePacingMargin;
+        std::optional<bool> lateLatching;
+        std::optional<float> targetFrameRate;
+        std::optional<float> minResolutionScale;
+        std::optional<float> maxResolutionScale;
+        std::optional<int> maxFramesInFlight;
+        std::optional<float> resizeDelay;
+        std::optional<bool> headless;
 
         auto operator<=>(const Display&) const noexcept = default;
     };
 
+    struct Network {
+        enum class TransferTopology { Star, Chain, Tree };
+
+        /// The options of the sockets of one type of connection
+        struct SocketProfile {
+            std::optional<int> sendBufferSize;
+            std::optional<int> receiveBufferSize;
+            /// The Differentiated Services Code Point in the range [0, 63]
+            std::optional<int> dscp;
+            /// The local address of the network interface that the sockets are bound to
+            std::optional<std::string> interfaceAddress;
+            /// Sizes the send buffer from the measured round trip time and bandwidth
+            std::optional<bool> autoTuneBuffers;
+
+            auto operator<=>(const SocketProfile&) const noexcept = default;
+        };
+
+        std::optional<bool> deltaSync;
+        std::optional<int> deltaSyncKeyframeInterval;
+        std::optional<bool> compression;
+        std::optional<int> compressionThreshold;
+        std::optional<int> compressionLevel;
+        std::optional<std::string> multicastAddress;
+        std::optional<uint16_t> multicastPort;
+        std::optional<bool> parallelSend;
+        std::optional<bool> eventDriven;
+        std::optional<bool> busyWait;
+        std::optional<bool> pipelinedSync;
+        std::optional<int> transferChunkSize;
+        std::optional<int> transferRateLimit;
+        std::optional<int> transferWindow;
+        std::optional<float> syncDeadline;
+        std::optional<bool> sharedMemory;
+        std::optional<int> rdmaBufferSize;
+        std::optional<bool> forwardLog;
+        std::optional<uint16_t> metricsPort;
+        std::optional<uint16_t> controlPort;
+        std::optional<uint16_t> controlUdpPort;
+        std::optional<TransferTopology> transferTopology;
+        std::optional<SocketProfile> syncSocket;
+        std::optional<SocketProfile> transferSocket;
+
+        auto operator<=>(const Network&) const noexcept = default;
+    };
+
+    /// The fixed-timestep simulation that all nodes run in lockstep
+    struct Lockstep {
+        /// The duration of one simulation step in seconds
+        std::optional<float> timestep;
+        /// The largest number of simulation steps in one frame
+        std::optional<int> maxSteps;
+        /// The number of steps after which the nodes compare their simulation state
+        std::optional<int> hashInterval;
+        /// The seed of the random numbers, which the master chooses if it is not set
+        std::optional<uint64_t> seed;
+
+        auto operator<=>(const Lockstep&) const noexcept = default;
+    };
+
+    /// Writes a report when a frame takes much longer than the frames before it
+    struct HitchDetector {
+        /// The multiple of the median frame time above which a frame is a hitch
+        std::optional<float> threshold;
+        /// The time in seconds after a report during which no other report is written
+        std::optional<float> cooldown;
+        /// The folder into which the reports are written
+        std::optional<std::filesystem::path> path;
+
+        auto operator<=>(const HitchDetector&) const noexcept = default;
+    };
+
+    /// The name, priority, and processor cores of one class of threads
+    struct Thread {
+        enum class Priority { Idle, Low, Normal, High, Realtime };
+
+        /// The prefix of the names of the threads, which are clipped to 15 characters
+        std::optional<std::string> name;
+        std::optional<Priority> priority;
+        /// The indices of the processor cores that the threads are allowed to run on
+        std::optional<std::vector<int>> affinity;
+
+        auto operator<=>(const Thread&) const noexcept = default;
+    };
+
+    /// The settings of the threads that SGCT creates, grouped by their purpose
+    struct Threads {
+        /// The main thread and the threads that render the windows
+        std::optional<Thread> render;
+        /// The threads that send and receive the data of the network connections
+        std::optional<Thread> network;
+        /// The threads that sample the trackers and joysticks
+        std::optional<Thread> tracking;
+        /// The threads that encode the screenshots and captured frames
+        std::optional<Thread> capture;
+        /// The thread that writes the asynchronous log messages
+        std::optional<Thread> logging;
+
+        auto operator<=>(const Threads&) const noexcept = default;
+    };
+
+    /// The placement of the large buffers of one subsystem in memory
+    struct Buffer {
+        /// Whether the buffers are backed by huge pages
+        std::optional<bool> hugePages;
+        /// The NUMA node that the memory of the buffers is preferably taken from
+        std::optional<int> numaNode;
+
+        auto operator<=>(const Buffer&) const noexcept = default;
+    };
+
+    /// The placement of the large buffers that are touched every frame
+    struct Buffers {
+        /// The receive and decompression buffers of the network connections
+        std::optional<Buffer> network;
+        /// The blocks that are encoded and decoded by the shared data
+        std::optional<Buffer> sharedData;
+        /// The pixels of the screenshots and captured frames
+        std::optional<Buffer> capture;
+        /// The frames that are sent through NDI
+        std::optional<Buffer> ndi;
+
+        auto operator<=>(const Buffers&) const noexcept = default;
+    };
+
     std::optional<bool> useDepthTexture;
     std::optional<bool> useNormalTexture;
     std::optional<bool> usePositionTexture;
+    std::optional<bool> useWindowThreads;
+    std::optional<bool> usePresentThread;
+    std::optional<bool> useLayeredCubeMaps;
+    std::optional<int> cubeMapRefreshInterval;
+    std::optional<bool> shareCubeMaps;
+    std::optional<bool> interleaveCubeMapEyes;
+    std::optional<bool> useCorrectionMeshCache;
+    std::optional<bool> loadCorrectionMeshesAsync;
+    std::optional<bool> watchCorrectionMeshes;
+    std::optional<bool> watchConfig;
+    std::optional<bool> syncInput;
+    std::optional<std::filesystem::path> shaderCachePath;
+    std::optional<int> statisticsHistoryLength;
+    std::optional<std::filesystem::path> tracePath;
+    std::optional<std::filesystem::path> binaryLogPath;
+    std::optional<std::filesystem::path> syncRecordPath;
+    std::optional<std::filesystem::path> syncReplayPath;
     std::optional<BufferFloatPrecision> bufferFloatPrecision;
     std::optional<Display> display;
+    std::optional<Network> network;
+    std::optional<Lockstep> lockstep;
+    std::optional<HitchDetector> hitchDetector;
+    std::optional<Threads> threads;
+    std::optional<Buffers> buffers;
 
     auto operator<=>(const Settings&) const noexcept = default;
 };
@@ -109,6 +282,26 @@ struct SGCT_EXPORT Tracker {
 
             auto operator<=>(const Axis&) const noexcept = default;
         };
+        struct Filter {
+            enum class Type { OneEuro, Kalman };
+
+            Type type = Type::OneEuro;
+            std::optional<double> minCutoff;
+            std::optional<double> beta;
+            std::optional<double> derivativeCutoff;
+            std::optional<double> processNoise;
+            std::optional<double> measurementNoise;
+
+            auto operator<=>(const Filter&) const noexcept = default;
+        };
+        struct Prediction {
+            enum class Model { Velocity, Acceleration };
+
+            std::optional<Model> model;
+            double latency = 0.0;
+
+            auto operator<=>(const Prediction&) const noexcept = default;
+        };
 
         std::string name;
         std::vector<Sensor> sensors;
@@ -116,6 +309,8 @@ struct SGCT_EXPORT Tracker {
         std::vector<Axis> axes;
         std::optional<vec3> offset;
         std::optional<mat4> transformation;
+        std::optional<Filter> filter;
+        std::optional<Prediction> prediction;
 
         auto operator<=>(const Device&) const noexcept = default;
     };
@@ -153,6 +348,10 @@ struct SGCT_EXPORT CubemapProjection {
     struct Spout {
         bool enabled = true;
         std::optional<std::string> name;
+        /// If this is true, the content is written directly into the texture that Spout
+        /// shares through the WGL_NV_DX_interop extension instead of being sent with a
+        /// copy by the Spout library
+        std::optional<bool> sharedTexture;
 
         auto operator<=>(const Spout&) const noexcept = default;
     };
@@ -165,10 +364,26 @@ struct SGCT_EXPORT CubemapProjection {
         auto operator<=>(const NDI&) const noexcept = default;
     };
 
+    /// The number of frames between two frames in which a face is sent through Spout
+    /// and NDI, which is every frame for the faces without a value
+    struct OutputIntervals {
+        std::optional<int> right;
+        std::optional<int> zLeft;
+        std::optional<int> bottom;
+        std::optional<int> top;
+        std::optional<int> left;
+        std::optional<int> zRight;
+
+        auto operator<=>(const OutputIntervals&) const noexcept = default;
+    };
+
     std::optional<int> quality;
     std::optional<Spout> spout;
     std::optional<NDI> ndi;
     std::optional<Channels> channels;
+    std::optional<OutputIntervals> outputIntervals;
+    /// If this is true, the faces that are not sent in a frame are not rendered either
+    std::optional<bool> skipUnsentFaces;
     std::optional<vec3> orientation;
 
     auto operator<=>(const CubemapProjection&) const noexcept = default;
@@ -179,9 +394,14 @@ SGCT_EXPORT void validateProjection(const CubemapProjection& proj);
 
 struct SGCT_EXPORT CylindricalProjection {
     std::optional<int> quality;
+    /// If this is true, the cube map resolution follows the size of the viewport and the
+    /// quality is only the upper limit of the resolution
+    std::optional<bool> automaticQuality;
     std::optional<float> rotation;
     std::optional<float> heightOffset;
     std::optional<float> radius;
+    std::optional<bool> adaptiveResolution;
+    std::optional<bool> lookupTexture;
 
     auto operator<=>(const CylindricalProjection&) const noexcept = default;
 };
@@ -191,6 +411,10 @@ SGCT_EXPORT void validateProjection(const CylindricalProjection& proj);
 
 struct SGCT_EXPORT EquirectangularProjection {
     std::optional<int> quality;
+    /// If this is true, the cube map resolution follows the size of the viewport and the
+    /// quality is only the upper limit of the resolution
+    std::optional<bool> automaticQuality;
+    std::optional<bool> lookupTexture;
 
     auto operator<=>(const EquirectangularProjection&) const noexcept = default;
 };
@@ -210,6 +434,30 @@ struct SGCT_EXPORT FisheyeProjection {
 
         auto operator<=>(const Crop&) const noexcept = default;
     };
+    struct OmniStereo {
+        // The size of the square tiles in pixels that are rendered with their own eye
+        std::optional<int> tileSize;
+        // Grayscale images that scale the rotation of the eyes and their separation
+        std::optional<std::filesystem::path> turnMap;
+        std::optional<std::filesystem::path> separationMap;
+
+        auto operator<=>(const OmniStereo&) const noexcept = default;
+    };
+    // Splits the rendering of the cube faces between the output node, which shows the
+    // projection, and helper nodes, which render some of the faces and send them to it
+    struct Distribution {
+        enum class Face { Right, Left, Bottom, Top, Front, Back };
+        struct Helper {
+            uint8_t node = 0;
+            std::vector<Face> faces;
+
+            auto operator<=>(const Helper&) const noexcept = default;
+        };
+        uint8_t output = 0;
+        std::vector<Helper> helpers;
+
+        auto operator<=>(const Distribution&) const noexcept = default;
+    };
     std::optional<float> fov;
     std::optional<int> quality;
     std::optional<Interpolation> interpolation;
@@ -219,6 +467,10 @@ struct SGCT_EXPORT FisheyeProjection {
     std::optional<bool> keepAspectRatio;
     std::optional<vec3> offset;
     std::optional<vec4> background;
+    std::optional<bool> adaptiveResolution;
+    std::optional<bool> directRendering;
+    std::optional<OmniStereo> omniStereo;
+    std::optional<Distribution> distribution;
 
     auto operator<=>(const FisheyeProjection&) const noexcept = default;
 };
@@ -269,6 +521,7 @@ struct SGCT_EXPORT SphericalMirrorProjection {
     std::optional<int> quality;
     std::optional<float> tilt;
     std::optional<vec4> background;
+    std::optional<bool> adaptiveResolution;
     Mesh mesh;
 
     auto operator<=>(const SphericalMirrorProjection&) const noexcept = default;
@@ -278,6 +531,9 @@ SGCT_EXPORT void validateProjection(const SphericalMirrorProjection& proj);
 
 
 struct SGCT_EXPORT TextureMappedProjection : PlanarProjection {
+    std::optional<bool> baked;
+
+    auto operator<=>(const TextureMappedProjection&) const noexcept = default;
 };
 SGCT_EXPORT void validateProjection(const TextureMappedProjection& proj);
 
@@ -299,9 +555,16 @@ struct SGCT_EXPORT Viewport {
     std::optional<std::filesystem::path> blendMaskTexture;
     std::optional<std::filesystem::path> blackLevelMaskTexture;
     std::optional<std::filesystem::path> correctionMeshTexture;
+    std::optional<float> correctionMeshTolerance;
+    std::optional<bool> correctionMeshWarpMap;
+    std::optional<bool> correctionMeshProcedural;
+    std::optional<bool> correctionMeshEditable;
     std::optional<bool> isTracked;
     std::optional<Eye> eye;
     std::optional<std::string> user;
+    /// The users that take turns viewing the viewport, one in each frame. If this list is
+    /// not empty, `user` must not be set
+    std::vector<std::string> users;
 
 
     auto operator<=>(const Viewport&) const noexcept = default;
@@ -313,6 +576,7 @@ SGCT_EXPORT void validateViewport(const Viewport& viewport);
 struct SGCT_EXPORT Window {
     enum class ColorBitDepth {
         Depth8,
+        Depth10,
         Depth16,
         Depth16Float,
         Depth32Float,
@@ -342,6 +606,10 @@ struct SGCT_EXPORT Window {
     struct Spout {
         bool enabled = true;
         std::optional<std::string> name;
+        /// If this is true, the content is written directly into the texture that Spout
+        /// shares through the WGL_NV_DX_interop extension instead of being sent with a
+        /// copy by the Spout library
+        std::optional<bool> sharedTexture;
 
         auto operator<=>(const Spout&) const noexcept = default;
     };
@@ -354,6 +622,43 @@ struct SGCT_EXPORT Window {
         auto operator<=>(const NDI&) const noexcept = default;
     };
 
+    /// Shares the final image of the window with other processes on the same computer
+    /// without copying it, as a dmabuf on Linux and a shared DirectX texture on Windows
+    struct FrameExport {
+        bool enabled = true;
+        /// The name under which the frames are exported, which defaults to the name of
+        /// the window, or its id if it has no name
+        std::optional<std::string> name;
+
+        auto operator<=>(const FrameExport&) const noexcept = default;
+    };
+
+    /// Streams the final image of the window as a video with little latency to a
+    /// receiver on the network, for example to monitor the outputs of a dome remotely
+    struct Stream {
+        /// The address of the receiver, for example `srt://host:port` or
+        /// `udp://host:port`, whose protocol has to be supported by FFmpeg
+        std::string url;
+        std::optional<Capture::Codec> codec;
+        std::optional<int> bitrate; // kbit/s
+        std::optional<int> frameRate;
+        /// The factor by which the image is scaled down before it is encoded
+        std::optional<float> scale;
+
+        auto operator<=>(const Stream&) const noexcept = default;
+    };
+
+    /// Composites the images that several nodes render into their window with the same
+    /// id by their depth, so that each node only has to render a part of the data
+    struct Compositing {
+        /// The nodes that render a part of the data, in the order of their partitions
+        std::vector<uint8_t> nodes;
+        /// The node that shows the composited image, which has to be one of the #nodes
+        uint8_t output = 0;
+
+        auto operator<=>(const Compositing&) const noexcept = default;
+    };
+
     struct Scalable {
         std::filesystem::path mesh;
         std::optional<int> orthographicQuality;
@@ -370,6 +675,13 @@ struct SGCT_EXPORT Window {
     std::optional<std::string> name;
     std::vector<std::string> tags;
     std::optional<ColorBitDepth> bufferBitDepth;
+    /// The bit depths of the cube maps of non-linear projections, of the texture that
+    /// FXAA reads from, and of the screenshots. Each of them defaults to the
+    /// #bufferBitDepth of the final frame, from which they are converted when they are
+    /// sampled, blitted, or downloaded
+    std::optional<ColorBitDepth> cubemapBitDepth;
+    std::optional<ColorBitDepth> intermediateBitDepth;
+    std::optional<ColorBitDepth> captureBitDepth;
     std::optional<bool> isFullScreen;
     std::optional<bool> shouldAutoiconify;
     std::optional<bool> hideMouseCursor;
@@ -380,18 +692,37 @@ struct SGCT_EXPORT Window {
     std::optional<bool> alpha;
     std::optional<uint8_t> msaa;
     std::optional<bool> useFxaa;
+    /// Subpixel morphological anti-aliasing, which cannot be combined with FXAA
+    std::optional<bool> useSmaa;
+    /// Temporal anti-aliasing, which cannot be combined with FXAA
+    std::optional<bool> useTaa;
+    std::optional<int8_t> swapInterval;
+    std::optional<bool> adaptiveSync;
     std::optional<bool> isDecorated;
     std::optional<bool> isResizable;
     std::optional<bool> draw2D;
+    /// The highest rate in Hz at which the 2D overlays are rendered into a cached layer,
+    /// which is blended over every frame. A value of 0 only renders them again when the
+    /// application invalidates them
+    std::optional<float> draw2DRate;
+    /// The window only renders its viewports in every n-th frame and displays the
+    /// previously rendered frame again in between
+    std::optional<int> renderEvery;
     std::optional<bool> draw3D;
     std::optional<bool> noError;
     std::optional<int8_t> blitWindowId;
     std::optional<bool> mirrorX;
     std::optional<bool> mirrorY;
     std::optional<uint8_t> monitor;
+    /// The GPU that renders the window, which places it on a display of that GPU
+    std::optional<uint8_t> gpu;
+    std::optional<Compositing> compositing;
     std::optional<StereoMode> stereo;
+    std::optional<bool> singlePassStereo;
     std::optional<Spout> spout;
     std::optional<NDI> ndi;
+    std::optional<FrameExport> frameExport;
+    std::optional<Stream> stream;
     std::optional<Scalable> scalable;
 
     auto operator<=>(const Window&) const noexcept = default;
@@ -405,6 +736,8 @@ struct SGCT_EXPORT Node {
     uint16_t port = 0;
     std::optional<uint16_t> dataTransferPort;
     std::optional<bool> swapLock;
+    std::optional<bool> isCritical;
+    std::optional<int> pollInterval;
     std::vector<Window> windows;
 
     auto operator<=>(const Node&) const noexcept = default;
@@ -467,7 +800,9 @@ namespace sgct {
 
 /**
  * Reads a JSON configuration file from the provided \p filename. If the loading fails an
- * exception is raised, otherwise a valid #Cluster object is returned.
+ * exception is raised, otherwise a valid #Cluster object is returned. Files with the
+ * `.cbor` extension are read as the binary configuration that is created by
+ * #serializeBinaryConfig.
  */
 SGCT_EXPORT [[nodiscard]] config::Cluster readConfig(
     const std::filesystem::path& filename);
@@ -479,6 +814,14 @@ SGCT_EXPORT [[nodiscard]] config::Cluster readConfig(
  */
 SGCT_EXPORT [[nodiscard]] config::Cluster readJsonConfig(std::string_view configuration);
 
+/**
+ * Reads the binary configuration that was created by #serializeBinaryConfig from the
+ * provided \p configuration. If the loading fails an exception is raised, otherwise a
+ * valid #Cluster object is returned.
+ */
+SGCT_EXPORT [[nodiscard]] config::Cluster readBinaryConfig(
+    std::span<const uint8_t> configuration);
+
 SGCT_EXPORT [[nodiscard]] config::Cluster defaultCluster();
 
 /**
@@ -489,11 +832,24 @@ SGCT_EXPORT [[nodiscard]] config::Cluster defaultCluster();
 SGCT_EXPORT [[nodiscard]] std::string serializeConfig(const config::Cluster& cluster,
     std::optional<config::GeneratorVersion> genVersion = std::nullopt);
 
+/**
+ * Serialize the provided \p cluster into the CBOR encoding of its JSON representation,
+ * which is smaller and faster to parse than the JSON string. Parsing it later with
+ * #readBinaryConfig or from a `.cbor` file with #readConfig results in the same
+ * \p cluster again. Unlike the JSON string, the binary configuration is not meant to be
+ * edited or validated against the schema, so it should be created from a configuration
+ * that has already been validated.
+ */
+SGCT_EXPORT [[nodiscard]] std::vector<uint8_t> serializeBinaryConfig(
+    const config::Cluster& cluster,
+    std::optional<config::GeneratorVersion> genVersion = std::nullopt);
+
 /**
  * Validate the provided JSON-based string representation of a configuration against the
  * schema file located at the provided \p schema file. If the JSON is valid according to
  * the schema, the function returns the empty string. Otherwise it contains an error
- * message that describes which parts of the JSON are ill-formed.
+ * message that describes which parts of the JSON are ill-formed. The validator that is
+ * compiled from the schema is kept for later calls until the \p schema file changes.
  */
 SGCT_EXPORT [[nodiscard]] std::string validateConfigAgainstSchema(
     std::string_view configuration, const std::filesystem::path& schema);
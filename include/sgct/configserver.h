@@ -0,0 +1,77 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CONFIGSERVER__H__
+#define __SGCT__CONFIGSERVER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/config.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Sends the cluster configuration of the master to the clients that request it with
+ * #fetchConfig, so that the configuration file only has to exist on the master. The
+ * configuration is sent in its binary format, compressed and with a checksum. The clients
+ * need the configuration to find their node and the address of the master in the first
+ * place, so it cannot be sent over the sync connections, and a background thread answers
+ * the requests on a separate port instead for as long as the Engine exists.
+ */
+class SGCT_EXPORT ConfigServer {
+public:
+    /**
+     * Starts serving the \p cluster on the TCP \p port. If the port cannot be opened, an
+     * error is logged and no configuration is served.
+     */
+    ConfigServer(const config::Cluster& cluster, int port);
+    ~ConfigServer();
+
+    /**
+     * Replaces the configuration that is sent to the clients that connect from now on,
+     * which is used when the configuration file is reloaded while the cluster is running.
+     */
+    void setCluster(const config::Cluster& cluster);
+
+private:
+    ConfigServer(const ConfigServer&) = delete;
+    ConfigServer(ConfigServer&&) = delete;
+    ConfigServer& operator=(const ConfigServer&) = delete;
+    ConfigServer& operator=(ConfigServer&&) = delete;
+
+    void work();
+
+    // The header and the compressed configuration that is sent to every client
+    std::vector<char> _message;
+    std::mutex _mutex;
+
+    SGCT_SOCKET _socket;
+    std::atomic_bool _isRunning = false;
+    std::thread _thread;
+};
+
+/**
+ * Requests the cluster configuration from the ConfigServer of the master at the
+ * \p address and \p port. As the master might not be running yet, the connection is
+ * retried until \p timeout seconds have passed.
+ *
+ * \return The cluster configuration that is served by the master
+ * \throw Error If the master cannot be reached or the received configuration is damaged
+ */
+SGCT_EXPORT config::Cluster fetchConfig(const std::string& address, int port,
+    double timeout);
+
+} // namespace sgct
+
+#endif // __SGCT__CONFIGSERVER__H__
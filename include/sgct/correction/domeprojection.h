@@ -12,10 +12,13 @@
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
 #include <sgct/correction/buffer.h>
+#include <sgct/correction/warpgrid.h>
 #include <filesystem>
 
 namespace sgct::correction {
 
+SGCT_EXPORT WarpGrid readDomeProjectionGrid(const std::filesystem::path& path);
+
 SGCT_EXPORT Buffer generateDomeProjectionMesh(const std::filesystem::path& path,
     const vec2& pos, const vec2& size);
 
@@ -0,0 +1,62 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_MAPPEDFILE__H__
+#define __SGCT__CORRECTION_MAPPEDFILE__H__
+
+#include <sgct/sgctexports.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace sgct::correction {
+
+/**
+ * A file that is mapped into memory for reading. The content stays mapped as long as
+ * this object exists.
+ */
+class SGCT_EXPORT MappedFile {
+public:
+    /**
+     * Maps the whole file at the \p path into memory.
+     *
+     * \return The mapped file, or `nullptr` if it cannot be opened or mapped
+     */
+    static std::unique_ptr<MappedFile> map(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    /**
+     * \return The content of the mapped file
+     */
+    std::span<const std::byte> data() const;
+
+    /**
+     * \return The content of the mapped file interpreted as text, which is not
+     *         null-terminated
+     */
+    std::string_view text() const;
+
+private:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* _memory = nullptr;
+    size_t _size = 0;
+#ifdef WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif // WIN32
+};
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_MAPPEDFILE__H__
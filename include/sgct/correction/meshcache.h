@@ -0,0 +1,109 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_MESHCACHE__H__
+#define __SGCT__CORRECTION_MESHCACHE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/correction/buffer.h>
+#include <sgct/correction/mappedfile.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace sgct::correction {
+
+/**
+ * A correction mesh that is read from a memory-mapped cache file. The vertices and
+ * indices point into the mapped file, which stays mapped as long as this object exists.
+ */
+struct SGCT_EXPORT CachedMesh {
+    std::unique_ptr<MappedFile> file;
+    std::span<const Buffer::Vertex> vertices;
+    std::span<const unsigned int> indices;
+    unsigned int geometryType = 0;
+};
+
+/**
+ * A warp map that is read from a memory-mapped cache file. For every pixel, the texture
+ * coordinates hold two 32-bit floats and the colors hold four 16-bit floats, starting
+ * with the bottom row. Both point into the mapped file, which stays mapped as long as
+ * this object exists.
+ */
+struct SGCT_EXPORT CachedWarpMap {
+    std::unique_ptr<MappedFile> file;
+    std::span<const float> texCoords;
+    std::span<const uint16_t> colors;
+};
+
+/**
+ * \return The path of the cache file for the mesh at the \p path, which lies next to it
+ */
+SGCT_EXPORT std::filesystem::path meshCachePath(const std::filesystem::path& path);
+
+/**
+ * Computes the key that identifies the mesh that is generated from the file at the
+ * \p path with the \p parameters, which are the values other than the file that the
+ * loader of the format uses. The key is a hash of the content of the file, the
+ * \p parameters, and the version of the cache format.
+ */
+SGCT_EXPORT uint64_t meshCacheKey(const std::filesystem::path& path,
+    std::span<const float> parameters);
+
+/**
+ * Combines the \p keys of several meshes into the key of the mesh that is merged from
+ * them in this order.
+ */
+SGCT_EXPORT uint64_t combineMeshCacheKeys(std::span<const uint64_t> keys);
+
+/**
+ * Maps the cache file of the mesh at the \p path into memory.
+ *
+ * \return The cached mesh, or `nullptr` if there is no cache file or if it was written
+ *         for a different \p key
+ */
+SGCT_EXPORT std::unique_ptr<CachedMesh> readMeshCache(const std::filesystem::path& path,
+    uint64_t key);
+
+/**
+ * Writes the \p buffer into the cache file of the mesh at the \p path, for the \p key.
+ * A cache file that cannot be written is only reported as a warning, as the mesh is
+ * then loaded from its source file again.
+ */
+SGCT_EXPORT void writeMeshCache(const std::filesystem::path& path, uint64_t key,
+    const Buffer& buffer);
+
+/**
+ * \return The path of the cache file for the warp map that is baked from the mesh at the
+ *         \p path, which lies next to it
+ */
+SGCT_EXPORT std::filesystem::path warpMapCachePath(const std::filesystem::path& path);
+
+/**
+ * Maps the cache file of the warp map of the mesh at the \p path into memory.
+ *
+ * \return The cached warp map, or `nullptr` if there is no cache file or if it was
+ *         written for a different \p key or \p size
+ */
+SGCT_EXPORT std::unique_ptr<CachedWarpMap> readWarpMapCache(
+    const std::filesystem::path& path, uint64_t key, ivec2 size);
+
+/**
+ * Writes the \p texCoords and \p colors of the warp map with the \p size that was baked
+ * from the mesh at the \p path into its cache file, for the \p key. The layout of the
+ * values is the one of the CachedWarpMap. A cache file that cannot be written is only
+ * reported as a warning, as the warp map is then baked again.
+ */
+SGCT_EXPORT void writeWarpMapCache(const std::filesystem::path& path, uint64_t key,
+    ivec2 size, std::span<const float> texCoords, std::span<const uint16_t> colors);
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_MESHCACHE__H__
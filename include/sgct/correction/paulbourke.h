@@ -12,10 +12,13 @@
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
 #include <sgct/correction/buffer.h>
+#include <sgct/correction/warpgrid.h>
 #include <filesystem>
 
 namespace sgct::correction {
 
+SGCT_EXPORT WarpGrid readPaulBourkeGrid(const std::filesystem::path& path);
+
 SGCT_EXPORT Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos,
     const vec2& size, float aspectRatio);
 
@@ -0,0 +1,50 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_SIMPLIFY__H__
+#define __SGCT__CORRECTION_SIMPLIFY__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/correction/buffer.h>
+#include <span>
+
+namespace sgct::correction {
+
+/**
+ * Reorders the triangles of a mesh so that their vertices are reused from the
+ * post-transform vertex cache of the GPU as often as possible and stores the vertices in
+ * the order in which the reordered triangles use them.
+ *
+ * \param vertices The vertices of the mesh
+ * \param indices The indices of the mesh, which have to describe a list of triangles
+ * \return The reordered mesh, which consists of the same triangles
+ */
+SGCT_EXPORT Buffer optimizeVertexOrder(std::span<const Buffer::Vertex> vertices,
+    std::span<const unsigned int> indices);
+
+/**
+ * Creates a simplified version of the mesh in the \p buffer by collapsing the edges in
+ * its interior for as long as the texture coordinates that are interpolated at each
+ * removed vertex deviate by at most \p tolerance pixels from that vertex's texture
+ * coordinates and its color by at most 1/255. The vertices on the border of the mesh
+ * are never removed. The triangles of the result are ordered so that their vertices are
+ * reused from the post-transform vertex cache of the GPU as often as possible.
+ *
+ * \param buffer The mesh that is simplified, which can consist of triangles or of a
+ *        triangle strip
+ * \param tolerance The largest allowed deviation in pixels
+ * \param resolution The size of the texture in pixels that is sampled by the mesh, which
+ *        converts the texture coordinates into pixels
+ * \return The simplified mesh, which always consists of triangles
+ */
+SGCT_EXPORT Buffer simplifyMesh(const Buffer& buffer, float tolerance, ivec2 resolution);
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_SIMPLIFY__H__
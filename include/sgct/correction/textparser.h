@@ -0,0 +1,67 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_TEXTPARSER__H__
+#define __SGCT__CORRECTION_TEXTPARSER__H__
+
+#include <sgct/sgctexports.h>
+#include <string_view>
+
+namespace sgct::correction {
+
+/**
+ * Splits a text into its lines without copying it. The line breaks, including a carriage
+ * return in front of them, are not part of the lines.
+ */
+class SGCT_EXPORT LineReader {
+public:
+    explicit LineReader(std::string_view text);
+
+    /**
+     * Reads the next line of the text into the \p line. The \p line points into the text
+     * that was passed to the constructor.
+     *
+     * \return `false` if there are no more lines in the text
+     */
+    bool next(std::string_view& line);
+
+private:
+    std::string_view _text;
+};
+
+/**
+ * Removes the next token from the beginning of the \p text and returns it. The tokens
+ * are separated by any number of the \p delimiters, which are removed in front of the
+ * token. If the \p text only consists of delimiters, an empty token is returned.
+ */
+SGCT_EXPORT std::string_view nextToken(std::string_view& text,
+    std::string_view delimiters = " \t");
+
+/**
+ * Converts the number at the beginning of the \p text into a `float`. Like `std::stof`,
+ * leading whitespace is skipped and the characters after the number are ignored, but the
+ * \p text is not copied into a temporary string.
+ *
+ * \throw std::invalid_argument If the \p text does not start with a number
+ * \throw std::out_of_range If the number cannot be represented as a `float`
+ */
+SGCT_EXPORT float toFloat(std::string_view text);
+
+/**
+ * Converts the number at the beginning of the \p text into an `int`. Like `std::stoi`,
+ * leading whitespace is skipped and the characters after the number are ignored, but the
+ * \p text is not copied into a temporary string.
+ *
+ * \throw std::invalid_argument If the \p text does not start with a number
+ * \throw std::out_of_range If the number cannot be represented as an `int`
+ */
+SGCT_EXPORT int toInt(std::string_view text);
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_TEXTPARSER__H__
@@ -0,0 +1,66 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_WARPGRID__H__
+#define __SGCT__CORRECTION_WARPGRID__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/correction/buffer.h>
+#include <vector>
+
+namespace sgct::correction {
+
+/**
+ * The control points of a correction mesh as they are stored in the mesh file. Each
+ * control point becomes one vertex of the mesh, which is computed by #evaluateWarpGrid
+ * for the viewport that shows the mesh. The triangles of the mesh do not depend on the
+ * viewport, so the vertices can be computed again without changing the indices.
+ */
+struct SGCT_EXPORT WarpGrid {
+    enum class Model {
+        /// The positions are in [-aspect, aspect] x [-1, 1] and the texture coordinates
+        /// in [0, 1] x [0, 1], as used by the Paul Bourke format
+        PaulBourke = 0,
+        /// The positions and texture coordinates are in [0, 1] x [0, 1] with the origin
+        /// in the upper left corner, as used by the Domeprojection format
+        DomeProjection = 1
+    };
+
+    struct Point {
+        float x = 0.f;
+        float y = 0.f;
+        float s = 0.f;
+        float t = 0.f;
+        float intensity = 1.f;
+    };
+
+    Model model = Model::PaulBourke;
+    std::vector<Point> points;
+    /// The list of triangles of the mesh
+    std::vector<unsigned int> indices;
+};
+
+/**
+ * Computes the vertex of the mesh that the control \p point of a grid with the \p model
+ * becomes in the viewport with the \p pos and \p size. The \p aspectRatio of the window
+ * is only used by the Paul Bourke model.
+ */
+SGCT_EXPORT Buffer::Vertex evaluateWarpGrid(WarpGrid::Model model,
+    const WarpGrid::Point& point, const vec2& pos, const vec2& size, float aspectRatio);
+
+/**
+ * Generates the mesh of the \p grid for the viewport with the \p pos and \p size by
+ * evaluating all of its control points.
+ */
+SGCT_EXPORT Buffer generateWarpGridMesh(const WarpGrid& grid, const vec2& pos,
+    const vec2& size, float aspectRatio);
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_WARPGRID__H__
@@ -10,24 +10,59 @@
 #define __SGCT__CORRECTION_MESH__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <sgct/shaderprogram.h>
+#include <sgct/correction/buffer.h>
+#include <sgct/correction/warpgrid.h>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace sgct {
 
 class BaseViewport;
 
-namespace correction { struct Buffer; }
-
 /**
  * Helper class for reading and rendering a correction mesh. A correction mesh is used for
  * warping and edge-blending.
  */
 class SGCT_EXPORT CorrectionMesh {
 public:
+    CorrectionMesh();
+    ~CorrectionMesh();
+
+    /**
+     * \return `true` if the mesh file at the \p path is in a format that #prepareMesh
+     *         parses, which are the formats whose parsers do not change the viewport
+     */
+    static bool isPreparable(const std::filesystem::path& path);
+
+    /**
+     * Parses the mesh file without creating any OpenGL objects, so that this function
+     * can be called on a worker thread. The following call to #loadMesh with the same
+     * \p path then only creates the geometry from the parsed data. The formats whose
+     * parsers change the viewport or its user are left to #loadMesh, so that they are
+     * still applied in the order of the viewports. If the correction mesh cache is
+     * enabled in the Engine settings, a valid cache file is mapped instead of parsing the
+     * mesh file, which otherwise is written after the parsing.
+     *
+     * \param path The path to the mesh data
+     * \param parent The viewport that the mesh belongs to
+     * \param textureRenderMode The same value that is passed to #loadMesh
+     *
+     * \throw std::runtime_error if mesh was not loaded successfully
+     */
+    void prepareMesh(const std::filesystem::path& path, const BaseViewport& parent,
+        bool textureRenderMode = false);
+
     /**
-     * This function finds a suitable parser for warping meshes and loads them.
+     * This function finds a suitable parser for warping meshes and loads them. It can be
+     * called again to replace a mesh that has been loaded before.
      *
      * \param path The path to the mesh data
      * \param parent The pointer to parent viewport
@@ -39,6 +74,124 @@ public:
     void loadMesh(const std::filesystem::path& path, BaseViewport& parent,
         bool needsMaskGeometry = false, bool textureRenderMode = false);
 
+    /**
+     * \return `true` if the mesh file at the \p path is in a format that #loadMergedMesh
+     *         can merge, which are the formats whose parsers do not change the viewport
+     */
+    static bool isMergeable(const std::filesystem::path& path);
+
+    /**
+     * Loads the warp meshes at the \p paths into a single warp mesh, so that
+     * #renderWarpMesh draws all of them with one draw call. The mesh at each index of the
+     * \p paths is loaded for the viewport at the same index of the \p parents and is a
+     * segment of the merged mesh. The shaders find the segment of a vertex from its
+     * texture coordinates, whose `t` is moved by twice the index of the segment, for
+     * example to select the texture that the segment samples. If the correction mesh
+     * cache is enabled in the Engine settings, the merged mesh is cached next to the
+     * first mesh file. The merged mesh has no mask geometry and cannot be applied
+     * through a warp map.
+     *
+     * \throw std::runtime_error if one of the meshes was not loaded successfully
+     */
+    void loadMergedMesh(std::span<const std::filesystem::path> paths,
+        std::span<const BaseViewport* const> parents);
+
+    /**
+     * Sets the largest deviation in pixels of the framebuffer that the simplification of
+     * the warp mesh is allowed to introduce. Without a tolerance, the meshes are used as
+     * they are stored in the files. This has to be called before #prepareMesh and
+     * #loadMesh to have an effect.
+     *
+     * \param tolerance The largest allowed deviation in pixels, which must be positive
+     */
+    void setSimplificationTolerance(float tolerance);
+
+    /**
+     * Enables applying the warp mesh through a warp map, which stores the texture
+     * coordinates and colors of the warp mesh for every pixel of the viewport. This has
+     * to be called before #loadMesh to have an effect.
+     */
+    void setUseWarpMap(bool useWarpMap);
+
+    /**
+     * Enables computing the vertices of the meshes in the Paul Bourke and Domeprojection
+     * formats from their control points on the GPU, so that only the control points are
+     * uploaded. Changes to the control points or to the viewport are then applied by
+     * #setProceduralMeshPoints and #updateProceduralMesh without generating the mesh
+     * again. This has to be called before #loadMesh to have an effect.
+     */
+    void setUseProceduralMesh(bool useProceduralMesh);
+
+    /**
+     * \return `true` if the vertices of the warp mesh are computed on the GPU from the
+     *         control points that are returned by #proceduralMeshPoints
+     */
+    bool hasProceduralMesh() const;
+
+    /**
+     * \return The control points of the procedural warp mesh, which are empty if the
+     *         warp mesh is not procedural
+     */
+    std::span<const correction::WarpGrid::Point> proceduralMeshPoints() const;
+
+    /**
+     * Replaces the control points of the procedural warp mesh and computes its vertices
+     * again for the \p parent. As the triangles of the mesh do not change, the number of
+     * control points has to stay the same. This function must only be called if
+     * #hasProceduralMesh is `true` and with the context of the parent's window current.
+     *
+     * \param points The new control points in the coordinates of the mesh file
+     * \param parent The viewport that the mesh belongs to
+     * \throw std::runtime_error If the number of \p points differs from the number of
+     *        control points of the mesh
+     */
+    void setProceduralMeshPoints(std::span<const correction::WarpGrid::Point> points,
+        const BaseViewport& parent);
+
+    /**
+     * Computes the vertices of the procedural warp mesh again if the position or size of
+     * the \p parent or the aspect ratio of its window have changed since they were last
+     * computed. Does nothing if the warp mesh is not procedural.
+     */
+    void updateProceduralMesh(const BaseViewport& parent);
+
+    /**
+     * Enables replacing vertices of the warp mesh while the application is running, for
+     * example while calibrating the projectors. The vertices are then uploaded in the
+     * layout of correction::Buffer into a buffer that is updated in place, a copy of
+     * them is kept, and the mesh is not shared with other viewports. Procedural meshes
+     * are not editable. This has to be called before #loadMesh to have an effect.
+     */
+    void setUseEditableMesh(bool useEditableMesh);
+
+    /**
+     * \return `true` if the vertices of the warp mesh can be replaced through
+     *         #setWarpMeshVertices
+     */
+    bool hasEditableMesh() const;
+
+    /**
+     * \return The vertices of the editable warp mesh, which are empty if the warp mesh is
+     *         not editable
+     */
+    std::span<const correction::Buffer::Vertex> warpMeshVertices() const;
+
+    /**
+     * Replaces the vertices of the editable warp mesh, starting at the vertex with the
+     * index \p first. Only the replaced range of the vertex buffer is written, and the
+     * blending is changed through the colors of the vertices. The texture bounds and
+     * resolution of the mesh are computed again, and the warp map is baked again the
+     * next time it is bound. This function must only be called with an OpenGL context
+     * current that shares its objects with the parent's window.
+     *
+     * \param first The index of the first vertex that is replaced
+     * \param vertices The new vertices in the coordinates of the framebuffer
+     * \throw std::runtime_error If the warp mesh is not editable or if the range of the
+     *        \p vertices extends past the end of the mesh
+     */
+    void setWarpMeshVertices(size_t first,
+        std::span<const correction::Buffer::Vertex> vertices);
+
     /**
      * Render the final mesh where for mapping the frame buffer to the screen.
      */
@@ -54,27 +207,162 @@ public:
      */
     void renderMaskMesh() const;
 
+    /**
+     * Binds the texture coordinates of the warp map to texture unit 1 and its colors to
+     * texture unit 2. The warp map covers the viewport with the \p position and \p size
+     * in the current OpenGL viewport. If the warp map does not exist yet or that size
+     * has changed, the warp mesh is rendered into it first, which also changes the bound
+     * shader program. If the correction mesh cache is enabled, the warp map is read from
+     * its cache file instead, or the rendered warp map is written to it. This function
+     * must only be called if #hasWarpMap is `true`.
+     */
+    void bindWarpMap(const vec2& position, const vec2& size) const;
+
+    /**
+     * \return `true` if the warp mesh is applied by sampling the warp map that is
+     *         bound by #bindWarpMap in a single pass over the quad mesh, instead of by
+     *         rendering the warp mesh
+     */
+    bool hasWarpMap() const;
+
+    /**
+     * \return A number that changes whenever the vertices of the warp mesh are replaced
+     *         or computed again, which is used to find out when the information that is
+     *         derived from the warp mesh is outdated
+     */
+    uint64_t revision() const;
+
+    /**
+     * \return The smallest and the largest texture coordinates of the warp mesh, or
+     *         `std::nullopt` if no warp mesh has been loaded or if it is procedural
+     */
+    std::optional<std::pair<vec2, vec2>> warpTextureBounds() const;
+
+    /**
+     * \return The resolution that a texture sampled by the warp mesh needs so that its
+     *         texels are no larger than the pixels of the window where the mesh magnifies
+     *         the texture the most, or `std::nullopt` if no warp mesh has been loaded
+     *         or if it is procedural
+     */
+    std::optional<float> warpTextureResolution() const;
+
+    /**
+     * \return The smallest and the largest texture coordinates of the \p segment of a
+     *         warp mesh that was loaded by #loadMergedMesh, without the offset of the
+     *         segment, or `std::nullopt` if the mesh has no such segment
+     */
+    std::optional<std::pair<vec2, vec2>> warpTextureBounds(int segment) const;
+
+    /**
+     * \return The resolution that the texture sampled by the \p segment of a warp mesh
+     *         that was loaded by #loadMergedMesh needs, as for #warpTextureResolution, or
+     *         `std::nullopt` if the mesh has no such segment
+     */
+    std::optional<float> warpTextureResolution(int segment) const;
+
 private:
+    // The vertex and index buffers of a geometry. The windows share their OpenGL
+    // objects, so the buffers can be used by the correction meshes of all windows
+    struct GeometryBuffers;
+
+    // A parsed mesh file and the buffers that were created from it, which is shared by
+    // all correction meshes that load the same file for the same viewport
+    struct SharedMesh;
+
     struct CorrectionMeshGeometry {
-        CorrectionMeshGeometry(const correction::Buffer& buffer);
-        CorrectionMeshGeometry(CorrectionMeshGeometry&&) noexcept;
+        explicit CorrectionMeshGeometry(
+            std::shared_ptr<const GeometryBuffers> geometryBuffers);
+        CorrectionMeshGeometry(const correction::Buffer& buffer, ivec2 resolution);
+        CorrectionMeshGeometry(CorrectionMeshGeometry&& rhs) noexcept;
         ~CorrectionMeshGeometry();
 
-        CorrectionMeshGeometry& operator=(CorrectionMeshGeometry&&) noexcept = default;
+        CorrectionMeshGeometry& operator=(CorrectionMeshGeometry&& rhs) noexcept;
 
         void render() const;
 
+        // Vertex array objects are not shared between contexts, so every correction
+        // mesh has its own for the buffers
         unsigned int vao = 0;
-        unsigned int vbo = 0;
-        unsigned int ibo = 0;
-        unsigned int nVertices = 0;
-        unsigned int nIndices = 0;
-        unsigned int type = 0x0005; // = GL_TRIANGLE_STRIP;
+        std::shared_ptr<const GeometryBuffers> buffers;
     };
 
+    /**
+     * Returns the parsed mesh that is shared by all correction meshes which load the
+     * file at the \p path, as long as it has not been modified, for a viewport with the
+     * same position and size in a framebuffer with the same resolution. The mesh is
+     * parsed by the first caller, while the others wait for it. This function can be
+     * called from any thread.
+     */
+    static std::shared_ptr<SharedMesh> sharedMesh(const std::filesystem::path& path,
+        const BaseViewport& parent, bool textureRenderMode,
+        std::optional<float> tolerance);
+
     std::optional<CorrectionMeshGeometry> _quadGeometry;
     std::optional<CorrectionMeshGeometry> _warpGeometry;
     std::optional<CorrectionMeshGeometry> _maskGeometry;
+    std::optional<std::pair<vec2, vec2>> _warpTextureBounds;
+    std::optional<float> _warpTextureResolution;
+
+    // The texture bounds and resolutions of the segments of a merged warp mesh
+    struct Segment {
+        std::optional<std::pair<vec2, vec2>> textureBounds;
+        std::optional<float> textureResolution;
+    };
+    std::vector<Segment> _warpSegments;
+
+    // Uploads the control points of the mesh file and creates the geometry that the
+    // vertices are computed into
+    std::unique_ptr<GeometryBuffers> loadProceduralMesh(const std::filesystem::path& path,
+        const BaseViewport& parent);
+
+    // Computes the vertices of the procedural mesh into the vertex buffer object \p vbo
+    void evaluateProceduralMesh(const BaseViewport& parent, unsigned int vbo);
+
+    // The mesh that was parsed by prepareMesh and has not been loaded yet
+    std::shared_ptr<SharedMesh> _preparedMesh;
+
+    std::optional<float> _simplificationTolerance;
+    bool _useWarpMap = false;
+    bool _useProceduralMesh = false;
+    bool _useEditableMesh = false;
+    uint64_t _revision = 0;
+
+    struct {
+        ShaderProgram bakeShader;
+        unsigned int fbo = 0;
+        mutable unsigned int texCoords = 0;
+        mutable unsigned int colors = 0;
+        mutable ivec2 size = ivec2(0, 0);
+        mutable MemoryAccount memory =
+            MemoryAccount(MemoryTracker::Category::CorrectionMeshes);
+
+        // The mesh file that the baked warp map is cached next to and the key of the
+        // mesh it is baked from, or an empty path if the warp map is not cached
+        std::filesystem::path cachePath;
+        uint64_t cacheKey = 0;
+    } _warpMap;
+
+    struct {
+        ShaderProgram program;
+        unsigned int pointBuffer = 0;
+        MemoryAccount memory = MemoryAccount(MemoryTracker::Category::CorrectionMeshes);
+        correction::WarpGrid::Model model = correction::WarpGrid::Model::PaulBourke;
+        std::vector<correction::WarpGrid::Point> points;
+
+        // The values that the vertices were last computed for
+        vec2 position = vec2{ 0.f, 0.f };
+        vec2 size = vec2{ 0.f, 0.f };
+        float aspectRatio = 0.f;
+    } _procedural;
+
+    // The copy of the editable warp mesh, from which its texture bounds and resolution
+    // are computed again after its vertices have been replaced
+    struct {
+        std::vector<correction::Buffer::Vertex> vertices;
+        std::vector<unsigned int> indices;
+        unsigned int geometryType = 0;
+        ivec2 resolution = ivec2(0, 0);
+    } _editable;
 };
 
 } // namespace sgct
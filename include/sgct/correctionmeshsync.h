@@ -0,0 +1,71 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTIONMESHSYNC__H__
+#define __SGCT__CORRECTIONMESHSYNC__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/shareddata.h>
+#include <sgct/correction/buffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Sends the replaced vertices of the editable correction meshes from the master to all
+ * nodes of the cluster, so that a warp or blend that is calibrated on the master is
+ * shown on every projector without writing the mesh files and restarting. Each patch
+ * addresses the viewport of one window of one node and is sent with the shared data of
+ * the next frame. All nodes, including the master, apply the patches that address them
+ * after the frame has been synchronized and before it is rendered, so the new vertices
+ * are shown in the same frame everywhere.
+ */
+class SGCT_EXPORT CorrectionMeshSync final : public SharedObjectBase {
+public:
+    /// The range of vertices of the correction mesh of one viewport that is replaced
+    struct Patch {
+        /// The index of the node in the cluster
+        int node = 0;
+        /// The id of the window on that node
+        int window = 0;
+        /// The index of the viewport in the window
+        int viewport = 0;
+        /// The index of the first vertex that is replaced
+        uint32_t first = 0;
+        std::vector<correction::Buffer::Vertex> vertices;
+    };
+
+    explicit CorrectionMeshSync(uint32_t id);
+
+    /**
+     * Adds a patch that is sent to the clients with the data of the next frame. This is
+     * only called on the master.
+     */
+    void addPatch(Patch patch);
+
+    /**
+     * Replaces the vertices of the viewports of this node that are addressed by the
+     * patches that have been added or received since the last call. This is called on
+     * all nodes once per frame after the shared data of the frame has been synchronized
+     * and with an OpenGL context current that shares its objects with the windows.
+     */
+    void apply();
+
+private:
+    void serialize(ByteWriter& writer) const override;
+    void deserialize(ByteReader& reader) override;
+
+    // The patches that have not been applied yet. On the master, these are also the ones
+    // that are sent with the next frame
+    std::vector<Patch> _patches;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__CORRECTIONMESHSYNC__H__
@@ -0,0 +1,91 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CUBEFACEDISTRIBUTOR__H__
+#define __SGCT__CUBEFACEDISTRIBUTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/definitions.h>
+#include <sgct/math.h>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Transports the cube faces that helper nodes render for the non-linear projection of an
+ * output node. A helper sends the color of every face it has rendered as a data transfer
+ * to the master, which keeps the faces that are meant for itself and forwards the other
+ * ones to their output node. The output node waits for the faces of the frame that it
+ * renders before it resamples its cube map, so that all faces show the same frame even
+ * though they are rendered on different nodes.
+ *
+ * Each node can only show or help with one projection with distributed faces, so the
+ * faces are identified by their index and the frustum mode they are rendered for.
+ */
+class SGCT_EXPORT CubeFaceDistributor {
+public:
+    /**
+     * The package id of the data transfers that contain the cube faces. These transfers
+     * are not passed to the data transfer callbacks of the application.
+     */
+    static constexpr int PackageId = std::numeric_limits<int>::min() + 2;
+
+    /// The pixels of a part of a cube face, with 4 bytes per pixel in rows from the bottom
+    struct Face {
+        unsigned int frame = 0;
+        /// The part of the face (x, y, width, height) in pixels
+        ivec4 rect = ivec4(0, 0, 0, 0);
+        std::vector<std::byte> pixels;
+    };
+
+    /**
+     * Sends the \p face with the index \p index, which was rendered for the \p mode, to
+     * the \p outputNode. This function is called on the render thread of a helper node.
+     */
+    void send(int outputNode, int index, FrustumMode mode, const Face& face) const;
+
+    /**
+     * Handles a data transfer with a cube face. The master forwards the faces that are
+     * meant for other nodes. This function is called internally by SGCT and shouldn't be
+     * used by the user.
+     */
+    void receive(const void* data, int length);
+
+    /**
+     * Waits until the face with the \p index for the \p mode has been received for the
+     * \p frame and moves it into \p face, whose previous pixel buffer is reused for the
+     * next face that is received.
+     *
+     * \return `false` if the face has not arrived in time, in which case \p face is not
+     *         changed
+     */
+    bool take(int index, FrustumMode mode, unsigned int frame, Face& face);
+
+private:
+    // The most recent face that has been received for each index and frustum mode
+    struct Slot {
+        Face face;
+        bool isValid = false;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::array<Slot, 18> _slots;
+    bool _hasWarned = false;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__CUBEFACEDISTRIBUTOR__H__
@@ -14,22 +14,44 @@
 #include <sgct/callbackdata.h>
 #include <sgct/config.h>
 #include <sgct/definitions.h>
+#include <sgct/externalcontrol.h>
 #include <sgct/joystick.h>
 #include <sgct/keys.h>
 #include <sgct/modifiers.h>
 #include <sgct/mouse.h>
+#include <sgct/network.h>
+#include <sgct/statisticshistory.h>
 #include <sgct/window.h>
+#include <sgct/correction/buffer.h>
 #include <array>
+#include <deque>
 #include <filesystem>
 #include <functional>
 #include <optional>
+#include <span>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace sgct {
 
+class Benchmark;
+class CaptureCollector;
+class ConfigServer;
+class CorrectionMeshSync;
+class CubeFaceDistributor;
 struct Configuration;
+class HitchDetector;
+class InputSync;
+class JobSystem;
+class SortLastCompositor;
+class MediaDistributor;
+class MetricsExporter;
 class Node;
+template <typename T> class SharedObject;
 class StatisticsRenderer;
+class SyncRecorder;
+class SyncReplay;
 
 /**
  * Loads the cluster information from the provided \p path. The \p path is a configuration
@@ -48,6 +70,20 @@ class StatisticsRenderer;
 SGCT_EXPORT config::Cluster loadCluster(
     std::optional<std::filesystem::path> path = std::nullopt);
 
+/**
+ * Loads the cluster information that is selected by the commandline \p config. If a
+ * config server is set, the configuration is requested from the master, which has to be
+ * started with a port on which it serves its configuration. Otherwise the configuration
+ * file is loaded as in #loadCluster(std::optional<std::filesystem::path>).
+ *
+ * \param config The commandline options that were parsed with #parseArguments
+ * \return The loaded Cluster object
+ *
+ * \exception std::runtime_error This exception is thrown whenever an unrecoverable error
+ *            occurs while trying to load or receive the configuration
+ */
+SGCT_EXPORT config::Cluster loadCluster(const Configuration& config);
+
 /**
  * Returns the number of seconds since the program start. The resultion of this counter is
  * usually the best available counter from the operating system.
@@ -57,6 +93,21 @@ SGCT_EXPORT config::Cluster loadCluster(
 SGCT_EXPORT double time();
 
 
+/**
+ * One fixed step of the lockstep simulation, which is passed to Callbacks::simulate.
+ */
+struct SGCT_EXPORT SimulationStep {
+    /// The number of the step, which starts at 0 and is the same on all nodes
+    uint64_t step = 0;
+
+    /// The duration of the step in seconds
+    double timestep = 0.0;
+
+    /// The seed for the random numbers of this step, which is derived from the seed of
+    /// the cluster and the number of the step
+    uint64_t seed = 0;
+};
+
 /**
  * The Engine class is the central part of SGCT and handles most of the callbacks,
  * rendering, network handling, input devices, etc.
@@ -66,30 +117,119 @@ public:
     using DrawFunction = void (*)(const RenderData&);
 
     /**
-     * Structure with all statistics gathered about different frametimes. The newest value
-     * is always at the front of the different arrays, the remaining values being sorted
-     * by the frame in which they occured. These values are only collected while the
+     * Structure with all statistics gathered about different frametimes. The histories
+     * keep the values of the most recent frames, which can be copied from other threads
+     * while the frames are rendered. These values are only collected while the
      * statistics are being shown.
      */
     struct SGCT_EXPORT Statistics {
-        /// For how many frames are the history values collected before the oldest values
-        /// are replaced
-        static constexpr int HistoryLength = 128;
+        explicit Statistics(int historyLength = StatisticsHistory::DefaultLength);
+
+        /**
+         * Changes the number of frames for which the history values are collected
+         * before the oldest values are replaced, and removes all collected values
+         */
+        void setHistoryLength(int historyLength);
 
         /// The times that contain the entire time spending processing the frames
-        std::array<double, HistoryLength> frametimes = {};
+        StatisticsHistory frametimes;
 
         /// The amount of time spend rendering the 2D and 3D components of the frame
-        std::array<double, HistoryLength> drawTimes = {};
+        StatisticsHistory drawTimes;
 
         /// The amount of time spend synchronizing the state between master and clients
-        std::array<double, HistoryLength> syncTimes = {};
+        StatisticsHistory syncTimes;
 
         /// The lowest time recorded for network communication between master and clients
-        std::array<double, HistoryLength> loopTimeMin = {};
+        StatisticsHistory loopTimeMin;
 
         /// The highest time recorded for network communication between master and clients
-        std::array<double, HistoryLength> loopTimeMax = {};
+        StatisticsHistory loopTimeMax;
+
+        /// The lowest time the master spent sending the shared data to a single client
+        StatisticsHistory sendTimeMin;
+
+        /// The highest time the master spent sending the shared data to a single client
+        StatisticsHistory sendTimeMax;
+
+        /// The CPU time of the pre-sync callback
+        StatisticsHistory preSyncTimes;
+
+        /// The CPU time of the encode callbacks, which are only called on the master
+        StatisticsHistory encodeTimes;
+
+        /// The CPU time of the decode callbacks, which are only called on the clients
+        StatisticsHistory decodeTimes;
+
+        /// The CPU time of the post-sync-pre-draw callback
+        StatisticsHistory postSyncPreDrawTimes;
+
+        /// The CPU time of all calls of the draw callback in a frame. Together with the
+        /// other callback times, this separates the time spent in the application from
+        /// the time spent in SGCT
+        StatisticsHistory drawCallbackTimes;
+
+        /// The CPU time of all calls of the draw 2D callback in a frame
+        StatisticsHistory draw2DTimes;
+
+        /// The CPU time of the post-draw callback
+        StatisticsHistory postDrawTimes;
+
+        /// The time the master spent sending the shared data of the last frame to each of
+        /// the clients, in the order of the sync connections
+        std::vector<double> sendTimes;
+
+        /// The GPU times of the stages of rendering each of the windows of this node, in
+        /// the order of the windows. Like the #drawTimes, they are a few frames old
+        std::vector<Window::GpuTimes> windowTimes;
+
+        /// The CPU times of the draw callback for each viewport of the windows of this
+        /// node in the last frame, in the order of the windows and their viewports
+        std::vector<std::vector<double>> viewportDrawTimes;
+
+        /// The estimated offset in seconds of the clock of each connected node relative
+        /// to this node's clock, in the order of the sync connections
+        std::vector<double> clockOffsets;
+
+        /// The estimated one-way network latency in seconds to each connected node, in
+        /// the order of the sync connections
+        std::vector<double> latencies;
+
+        /// The jitter in seconds of the clock measurements to each connected node, in the
+        /// order of the sync connections
+        std::vector<double> jitters;
+
+        /// The number of frames in which the master continued without each of the nodes
+        /// because they missed the sync deadline, in the order of the sync connections
+        std::vector<uint64_t> skippedFrames;
+
+        /// The statistics that each of the clients sent with its acknowledgement of the
+        /// current frame, in the order of the sync connections. The entry of a client is
+        /// empty if it is not connected or does not send statistics, which clients only
+        /// do while their own statistics are being shown or their swap barrier is active
+        std::vector<std::optional<Network::NodeStatistics>> nodes;
+
+        /// The frame counter of the Nvidia swap group after the previous buffer swap,
+        /// which is 0 if the swap barrier is not active
+        uint32_t swapGroupFrame = 0;
+
+        /// The number of buffer swaps that this node missed since the swap barrier was
+        /// enabled, which are the vertical retraces by which the frame counter of the
+        /// swap group advanced beyond the swap interval between two buffer swaps
+        uint64_t missedSwaps = 0;
+
+        /// The number of times that the master reset the frame counters of the swap
+        /// group because the counter of a client diverged from its own
+        uint64_t swapGroupResyncs = 0;
+
+        /// The number of previous frames that the GPU was still working on when the CPU
+        /// started drawing the current frame, which is how far the CPU work overlaps the
+        /// GPU work. This is only measured if Settings::maxFramesInFlight is set
+        int framesInFlight = 0;
+
+        /// The time in seconds that the CPU waited for the GPU to finish the previous
+        /// frames before drawing the current one because of Settings::maxFramesInFlight
+        double gpuWaitTime = 0.0;
 
         /**
          * \return The frame time (delta time) in seconds
@@ -118,8 +258,16 @@ public:
         /// constructor and the #initialize function
         bool createDebugContext = false;
 
-        /// Sets the swap interval to be used by the application
-        ///   -1 = adaptive sync(Nvidia)
+        /// If this is true, the windows are never shown or presented and are only used
+        /// as the render targets of their framebuffer textures. The frames do not wait
+        /// for the vertical sync, and, if GLFW supports it, the OpenGL contexts are
+        /// created through EGL without a window system
+        bool headless = false;
+
+        /// Sets the swap interval to be used by the application. Unless a window sets its
+        /// own interval, only the last window of a node waits for the vertical sync
+        ///   -n = adaptive sync, which waits for every n-th vertical sync unless the
+        ///        frame is late, in which case it is swapped immediately and tears
         ///    0 = vertical sync off
         ///    1 = wait for vertical sync
         ///    2..inf = wait for every n-th vertical sync
@@ -134,14 +282,179 @@ public:
         /// masks and warping
         bool captureBackBuffer = false;
 
+        /// If these are true, the windows also render their depth, normals, and
+        /// positions into textures. With stereo, the textures hold the right eye, as
+        /// they are shared by both eyes
         bool useDepthTexture = false;
         bool useNormalTexture = false;
         bool usePositionTexture = false;
 
+        /// If this is true, every window except the first one is composited and swapped
+        /// on its own thread with its own OpenGL context
+        bool useWindowThreads = false;
+
+        /// If this is true, the buffers of the windows are swapped on a thread of its
+        /// own, so that the main thread starts with the next frame instead of waiting
+        /// for the vertical retrace or the swap barrier. At most one frame is pending,
+        /// as the next frame is only composited into the windows once the buffers of
+        /// the previous one have been swapped
+        bool usePresentThread = false;
+
+        /// If this is true, the non-linear projections that support it render all faces
+        /// of their cube map with a single call of the draw callback
+        bool useLayeredCubeMaps = false;
+
+        /// The number of frames over which the non-linear projections spread the
+        /// rendering of their cube faces. Each face is rendered in one of these frames
+        /// and is reused in the others unless its view has changed. A value of 1 renders
+        /// all faces in every frame
+        int cubeMapRefreshInterval = 1;
+
+        /// If this is true, a non-linear projection samples the cube map of another
+        /// projection on the same node instead of rendering its own, if that one has
+        /// rendered an identical cube map in the same frame
+        bool shareCubeMaps = false;
+
+        /// If this is true, the stereoscopic fisheye, cylindrical, and equirectangular
+        /// projections render each cube face for the left and the right eye directly
+        /// after each other instead of rendering all faces of one eye before the other.
+        /// This needs a second set of cube maps for the right eye, but lets the
+        /// application reuse the culling of a face for the second eye through
+        /// RenderData::eyePair
+        bool interleaveCubeMapEyes = false;
+
+        /// If this is true, the correction meshes whose formats support it are stored in
+        /// a binary cache file next to the mesh file, which is mapped into memory instead
+        /// of parsing the mesh file again as long as neither has changed
+        bool useCorrectionMeshCache = false;
+
+        /// If this is true, the Engine does not wait for the correction meshes that are
+        /// parsed in the background before it starts rendering. The viewports are shown
+        /// without warping until their mesh is ready
+        bool loadCorrectionMeshesAsync = false;
+
+        /// If this is true, the correction mesh files are checked for changes once per
+        /// second and loaded again if they have been modified
+        bool watchCorrectionMeshes = false;
+
+        /// If this is true, the master checks the configuration file for changes once
+        /// per second and all nodes apply the changed settings that are safe to change
+        /// at runtime in the same frame
+        bool watchConfig = false;
+
+        /// If this is true, the keyboard, mouse, and joystick input of the master is
+        /// sent to the clients, which call their input callbacks with it as well
+        bool syncInput = false;
+
+        /// If this has a value, all nodes run the lockstep simulation of
+        /// Callbacks::simulate with steps of this many seconds, of which the master
+        /// decides how many are run in each frame. The input is synchronized as well
+        std::optional<double> lockstepTimestep;
+
+        /// The largest number of lockstep simulation steps in one frame
+        int lockstepMaxSteps = 4;
+
+        /// The number of lockstep simulation steps after which the clients send the hash
+        /// of their simulation state to the master for comparison, or 0 to not compare
+        int lockstepHashInterval = 0;
+
+        /// The seed of the random numbers of the lockstep simulation. If this does not
+        /// have a value, the master chooses a random seed
+        std::optional<uint64_t> lockstepSeed;
+
+        /// If this is not empty, the linked shader programs are stored in this folder
+        /// and loaded from it instead of compiling them again, as long as the sources,
+        /// the driver, and the GPU are the same
+        std::filesystem::path shaderCachePath;
+
+        /// The number of frames for which the statistics keep their history values
+        int statisticsHistoryLength = StatisticsHistory::DefaultLength;
+
+        /// If this is not empty, the Tracer records the stages of the frames, and the
+        /// trace files are written into this folder
+        std::filesystem::path tracePath;
+
+        /// If this is not empty, the network and frame events are recorded into a binary
+        /// log file in this folder
+        std::filesystem::path binaryLogPath;
+
+        /// If this is not empty, the master records the shared data of every frame into
+        /// this file, which can be played back through the #syncReplayPath
+        std::filesystem::path syncRecordPath;
+
+        /// If this is not empty, the master sends the frames of this recording of the
+        /// shared data instead of encoding it and terminates after the last frame
+        std::filesystem::path syncReplayPath;
+
+        /// If this has a value, a frame that takes longer than this multiple of the
+        /// median of the recent frames is a hitch, for which a report and a trace are
+        /// written into the #hitchPath
+        std::optional<double> hitchThreshold;
+
+        /// The time in seconds after a hitch report during which no further reports are
+        /// written
+        double hitchCooldown = 10.0;
+
+        /// The folder into which the hitch reports are written
+        std::filesystem::path hitchPath = "hitches";
+
+        /// If this has a value, the master delays the start of each frame so that the
+        /// frame is expected to finish this many seconds before the next buffer swap
+        std::optional<double> framePacingMargin;
+
+        /// If this is true, the head tracking data and the OpenVR poses are sampled right
+        /// before the frame is rendered instead of at the beginning of the frame
+        bool lateLatching = false;
+
+        /// If this has a value, the CPU waits before drawing a frame until the GPU has
+        /// finished all but this many of the previous frames. A value of 1 gives the
+        /// lowest latency, while larger values let the CPU work on the next frames while
+        /// the GPU is still busy. Without a value, the driver decides how far ahead the
+        /// CPU can get
+        std::optional<int> maxFramesInFlight;
+
+        /// If this has a value, the framebuffer textures of a window that is resized are
+        /// only recreated once its size has not changed for this many seconds, and the
+        /// previous frame is stretched to the window until then
+        std::optional<double> resizeDelay;
+
+        /// If this has a value, the framebuffer resolution of all windows is scaled so
+        /// that drawing a frame on the master takes this many seconds of GPU time
+        std::optional<double> dynamicResolutionBudget;
+
+        /// The smallest factor by which the dynamic resolution scales the framebuffers
+        float minResolutionScale = 0.5f;
+
+        /// The largest factor by which the dynamic resolution scales the framebuffers
+        float maxResolutionScale = 1.f;
+
         /// The number of seconds that SGCT will wait for the master or clients to connect
         /// before aborting
         float syncTimeout = 60.f;
 
+        /// If this is true, the frame lock stages spin on the network state while waiting
+        /// for the sync signal instead of sleeping on a condition variable. This lowers
+        /// the wake-up jitter at the cost of keeping one CPU core busy
+        bool busyWaitSync = false;
+
+        struct BenchmarkSettings {
+            /// The number of frames that are measured after the warm-up frames
+            int nFrames = 0;
+
+            /// The file into which the results are written. If this is empty, they are
+            /// written into `benchmark-node<id>.json` in the working directory
+            std::filesystem::path output;
+
+            /// The file with the keyframes of the camera. If this is empty, the camera
+            /// circles around the scene
+            std::filesystem::path cameraPath;
+        };
+
+        /// If this has a value, the Engine renders the synthetic scene of the Benchmark
+        /// instead of calling the draw callbacks, and terminates once all frames have
+        /// been measured
+        std::optional<BenchmarkSettings> benchmark;
+
         struct SS{
             /// The location where the screenshots are being saved
             std::filesystem::path capturePath;
@@ -149,6 +462,50 @@ public:
             // The number of capture threads
             int nCaptureThreads = std::max(std::thread::hardware_concurrency() / 2, 1u);
 
+            /// The number of screenshots per window that can wait to be saved by the
+            /// capture threads. If this has no value, it is the number of capture threads
+            std::optional<int> queueDepth;
+
+            /// If this is true, screenshots are skipped while the queue is full instead
+            /// of waiting for a capture thread to save one of the queued screenshots
+            bool dropWhenFull = false;
+
+            /// The format in which the screenshots are saved
+            config::Capture::Format format = config::Capture::Format::Png;
+
+            /// The zlib compression level of the screenshots between 0, which stores the
+            /// pixels uncompressed, and 9. The value -1 selects the zlib default level
+            int compressionLevel = -1;
+
+            /// The zlib compression strategy of the screenshots
+            config::Capture::CompressionStrategy compressionStrategy =
+                config::Capture::CompressionStrategy::Default;
+
+            /// If this is true, bands of rows of each screenshot are compressed
+            /// concurrently by the job system instead of only by one capture thread
+            bool parallelEncoding = true;
+
+            /// The codec of the video files if the format is Video
+            config::Capture::Codec codec = config::Capture::Codec::H264;
+
+            /// The target bitrate of the video files in kilobits per second
+            int bitrate = 20000;
+
+            /// The number of frames per second that is stored in the video files
+            int frameRate = 60;
+
+            /// If this is true, screenshots of windows with more than 8 bits per color
+            /// channel are converted to 8 bits on the GPU before they are downloaded
+            bool eightBit = false;
+
+            /// The factor by which screenshots are scaled down on the GPU before they are
+            /// downloaded. 1 keeps the resolution of the window
+            float scale = 1.f;
+
+            /// If this is true, the clients send their screenshots to the master through
+            /// the data transfer connection instead of keeping them
+            bool collect = false;
+
             /// If set to true, the node name is added to screenshots
             bool addNodeName = false;
 
@@ -186,11 +543,30 @@ public:
         /// This function is called before the synchronization stage.
         void (*preSync)() = nullptr;
 
+        /// This function is called on the master before the PreSync callback with the
+        /// messages that the external control ports have received since the previous
+        /// frame, of which only the newest one is kept for each address.
+        void (*externalControl)(std::span<const ExternalControl::Message>) = nullptr;
+
         /// This function is called once per frame after sync but before draw stage.
         void (*postSyncPreDraw)() = nullptr;
 
+        /// If the lockstep simulation is enabled, this function is called on all nodes
+        /// before the PostSyncPreDraw callback once for each simulation step that the
+        /// master has decided on for this frame. The input callbacks with the input of
+        /// the master have been called before.
+        void (*simulate)(const SimulationStep&) = nullptr;
+
+        /// If the lockstep simulation compares the simulation state of the nodes, this
+        /// function is called after every Settings::lockstepHashInterval steps and has to
+        /// return a hash of the entire simulation state.
+        uint64_t (*simulationHash)() = nullptr;
+
         /// This function draws the scene and could be called several times per frame
         /// as it's called once per viewport and once per eye if stereoscopy is used.
+        /// In viewports with a correction mesh or a blend mask, the depth buffer holds
+        /// the near plane where the pixels can not be seen, so depth tested fragments
+        /// are not shaded there unless the depth buffer is cleared again.
         void (*draw)(const RenderData&) = nullptr;
 
         /// This function is be called after overlays and post effects has been drawn and
@@ -210,7 +586,8 @@ public:
         std::vector<std::byte> (*encode)() = nullptr;
 
         /// This function is called by decode all shared data sent to us from the master
-        /// The parameter is the block of data that contains the data to be decoded.
+        /// The parameter is the block of data that contains the data to be decoded. It
+        /// is called on the render thread before the PostSyncPreDraw function.
         void (*decode)(const std::vector<std::byte>&) = nullptr;
 
         /// This function is called when a TCP message is received.
@@ -228,6 +605,16 @@ public:
         /// This function is called when data is successfully sent.
         void (*dataTransferAcknowledge)(int, int) = nullptr;
 
+        /// This function is called for every chunk of a chunked data transfer that is
+        /// received. The parameters are the chunk data, its length, its byte offset in
+        /// the package, the total package size, the package id, and the client index.
+        void (*dataTransferChunk)(void*, int, uint64_t, uint64_t, int, int) = nullptr;
+
+        /// This function is called when a chunk of a chunked data transfer has been
+        /// acknowledged. The parameters are the package id, the client index, the number
+        /// of bytes received so far, and the total package size.
+        void (*dataTransferProgress)(int, int, uint64_t, uint64_t) = nullptr;
+
         /// This function sets the keyboard callback (GLFW wrapper) for all windows.
         void (*keyboard)(Key, Modifier, Action, int, Window*) = nullptr;
 
@@ -337,6 +724,84 @@ public:
      */
     void updateFrustums() const;
 
+    /**
+     * Marks the following frames as unchanged, for example while a static image is
+     * shown. For the unchanged frames, all nodes skip rendering the scene and instead
+     * display the content of the previous frame again, which includes the warping and
+     * blending, and the encode function is not called, so that only a heartbeat is sent
+     * to the clients. The draw callbacks are not called for unchanged frames. The state
+     * is decided by the master and sent to the clients with the next frame, so this
+     * function only has an effect on the master and should be called before or in the
+     * pre-sync callback.
+     */
+    void setFrameUnchanged(bool state);
+
+    /**
+     * \return `true` if the frames are currently marked as unchanged
+     */
+    bool isFrameUnchanged() const;
+
+    /**
+     * Replaces vertices of the editable correction mesh of a viewport on any node of the
+     * cluster, starting at the vertex with the index \p first, for example while the
+     * projectors are calibrated. The vertices are sent with the next frame and replaced
+     * on all nodes before that frame is rendered, so that the master can edit the warp
+     * and blend of every projector. The correction mesh has to be made editable in the
+     * configuration of the viewport. This function only has an effect on the master.
+     *
+     * \param node The index of the node in the cluster
+     * \param window The id of the window on that node
+     * \param viewport The index of the viewport in the window
+     * \param first The index of the first vertex that is replaced
+     * \param vertices The new vertices in the coordinates of the framebuffer
+     */
+    void setCorrectionMeshVertices(int node, int window, int viewport, size_t first,
+        std::vector<correction::Buffer::Vertex> vertices);
+
+    /**
+     * Returns the job system that runs tasks on the worker threads of the Engine. The
+     * number of workers is based on the number of hardware threads minus the threads
+     * that are used for screen captures. A job can be bound to a stage of the frame,
+     * in which case the Engine waits for it before it enters that stage.
+     *
+     * \return The job system of the Engine
+     */
+    JobSystem& jobSystem();
+
+    /**
+     * Returns the collector that sends the screenshots of the clients to the master if
+     * the screenshots are collected, or `nullptr` otherwise.
+     *
+     * \return The capture collector of the Engine
+     */
+    CaptureCollector* captureCollector();
+
+    /**
+     * Returns the distributor that sends media files from the master to all nodes and
+     * announces when they have been decoded everywhere, so that the nodes can switch to
+     * them in the same frame.
+     *
+     * \return The media distributor of the Engine
+     */
+    MediaDistributor& mediaDistributor();
+
+    /**
+     * Returns the distributor that transports the cube faces that helper nodes render for
+     * a projection of another node, which is used by the projections with distributed
+     * cube faces.
+     *
+     * \return The cube face distributor of the Engine
+     */
+    CubeFaceDistributor& cubeFaceDistributor();
+
+    /**
+     * Returns the compositor that exchanges the images of the windows whose images are
+     * composited across nodes by their depth.
+     *
+     * \return The sort-last compositor of the Engine
+     */
+    SortLastCompositor& sortLastCompositor();
+
     /**
      * Return the Window that currently has the focus. If no SGCT window has focus, a
      * `nullptr` is returned.
@@ -406,6 +871,30 @@ public:
      */
     void takeScreenshot(std::vector<int> windowIds = std::vector<int>());
 
+    /**
+     * Takes a screenshot with \p tiles times the framebuffer resolution of each window,
+     * for which the scene is rendered once per tile in the next frame. The tiles of each
+     * row are written into the PNG file before the next row is rendered, so neither the
+     * GPU nor the memory has to hold the whole image, which makes resolutions possible
+     * that are larger than the largest texture of the GPU. The screenshot uses the same
+     * counter as #takeScreenshot. Windows with non-linear projections are skipped.
+     *
+     * \param tiles The number of tiles in x and y, each of which is at least 1
+     * \param windowIds If the vector is empty, screenshots of all windows will be taken,
+     *        otherwise only of the windows whose ids appear in the vector
+     */
+    void takeTiledScreenshot(ivec2 tiles,
+        std::vector<int> windowIds = std::vector<int>());
+
+    /**
+     * Writes the most recent scopes that the Tracer recorded on this node into a new
+     * Chrome trace file in the Settings::tracePath. Like #takeScreenshot, this only
+     * affects the node on which it is called, so an application that dumps the trace of
+     * all nodes on a key press has to share that request with the clients. Nothing is
+     * written if no trace path was provided in the configuration.
+     */
+    void writeTrace() const;
+
     /**
      * Resets the screenshot number to 0.
      */
@@ -438,6 +927,12 @@ public:
 
     Engine::DrawFunction draw2DFunction() const;
 
+    /**
+     * \return The CPU time in seconds that the calls of the draw function took in the
+     *         current frame so far
+     */
+    double drawCallbackTime() const;
+
 
     /**
      * Returns a reference to the node that represents this computer.
@@ -479,6 +974,29 @@ public:
      */
     unsigned int currentFrameNumber() const;
 
+    /**
+     * Returns the frame number of the master, which is the same on all nodes and can be
+     * used to spread work over several frames in the same way on all nodes. It is only
+     * sent to the clients if the cube map refresh interval is larger than 1, or if a
+     * window uses temporal anti-aliasing, otherwise this is the same as the
+     * currentFrameNumber.
+     *
+     * \return The frame number of the master
+     */
+    unsigned int clusterFrameNumber() const;
+
+    /**
+     * Returns the time in seconds on the master's clock at which the master started the
+     * current frame. The clients receive it with the shared data of the frame, so from
+     * the post sync pre draw callback on it is the same on all nodes, which makes it the
+     * clock with which all nodes select the same frame of a video, for example through
+     * VideoDecoder::update. On the master, it is already valid in the pre sync callback.
+     * Unlike sgct::time, it only changes once per frame.
+     *
+     * \return The time of the current frame on the master's clock
+     */
+    double presentationTime() const;
+
     /**
      * Set capture/screenshot path used by SGCT.
      *
@@ -550,6 +1068,62 @@ private:
      */
     void frameLockPostStage();
 
+    /**
+     * Waits until the time at which the next frame has to start so that it is finished
+     * Settings::framePacingMargin seconds before the next buffer swap. The buffer swap
+     * is predicted to happen one V-Sync interval, the shortest recent frame time, after
+     * the previous one and the frame is predicted to take as long as the longest of the
+     * recent frames.
+     */
+    void waitForFrameStart() const;
+
+    /**
+     * Adjusts the resolution scale that is sent to all nodes so that the GPU time of
+     * drawing a frame, \p drawTime, moves towards Settings::dynamicResolutionBudget.
+     * This function is only called on the master.
+     */
+    void updateResolutionScale(double drawTime);
+
+    /**
+     * Reads the configuration file again if it has been modified since it was checked
+     * last, and sends it to the clients and to the ConfigServer. The file is checked at
+     * most once per second. This function is only called on the master.
+     */
+    void checkConfigFile();
+
+    /**
+     * Applies the settings of the \p cluster that can be changed without recreating the
+     * windows, which are the swap interval, the cube map refresh interval, the length of
+     * the statistics history, and whether the windows of this node use FXAA. All nodes
+     * call this in the same frame.
+     */
+    void applyConfig(const config::Cluster& cluster);
+
+    /**
+     * Reads the frame counter of the swap group after the buffer swap and counts the
+     * swaps that were missed since the previous frame.
+     */
+    void updateSwapGroupFrame();
+
+    /**
+     * Compares the frame counters of the swap group that the clients sent with their
+     * acknowledgements against the master's own. If the difference to a client changed
+     * since the counters were reset, the master chooses a frame in the near future in
+     * which all nodes reset their counters. This function is only called on the master.
+     */
+    void checkSwapGroups();
+
+    /// Runs the lockstep simulation steps of the current frame
+    void simulate();
+
+    /// Compares the hashes of the clients' simulation states with the master's
+    void checkSimulationHashes();
+
+    /**
+     * \return `true` if a screenshot should be taken of the \p window in this frame
+     */
+    bool shouldTakeScreenshot(const Window& window) const;
+
     /**
      * This function waits for all windows to be created on the whole cluster in order to
      * set the barrier (hardware swap-lock). Under some Nvidia drivers the stability is
@@ -558,6 +1132,14 @@ private:
      */
     void waitForAllWindowsInSwapGroupToOpen();
 
+    /**
+     * Waits on the master until all clients have finished their initialization, so that
+     * the first frame is not held up by a client that is still loading its correction
+     * meshes, and reports the startup \p times of all nodes. A client instead signals to
+     * the master that it is ready.
+     */
+    void waitForAllNodesToBeReady(const Network::StartupTimes& times);
+
     /// The function pointer that is called before any windows are created
     void (*_preWindowFn)() = nullptr;
 
@@ -567,9 +1149,18 @@ private:
     /// Function pointer that is called before the synchronization step of the frame
     void (*_preSyncFn)() = nullptr;
 
+    /// Function pointer that is called with the messages of the external control
+    void (*_externalControlFn)(std::span<const ExternalControl::Message>) = nullptr;
+
     /// Function pointer that is called after the synchronization but before rendering
     void (*_postSyncPreDrawFn)() = nullptr;
 
+    /// Function pointer that is called for each step of the lockstep simulation
+    void (*_simulateFn)(const SimulationStep&) = nullptr;
+
+    /// Function pointer that returns the hash of the lockstep simulation state
+    uint64_t (*_simulationHashFn)() = nullptr;
+
     /// Function pointer that is called for the 3D portion of the rendering
     void (*_drawFn)(const RenderData&) = nullptr;
 
@@ -579,6 +1170,14 @@ private:
     /// Function pointer that is called after all rendering has finished
     void (*_postDrawFn)() = nullptr;
 
+    /// The draw functions of the application, which the #_drawFn and #_draw2DFn call
+    /// while measuring their CPU time in the #_drawCallbackTime and #_draw2DCallbackTime
+    /// of the current frame
+    void (*_userDrawFn)(const RenderData&) = nullptr;
+    void (*_userDraw2DFn)(const RenderData&) = nullptr;
+    double _drawCallbackTime = 0.0;
+    double _draw2DCallbackTime = 0.0;
+
     /// Function pointer that is called when the Engine is being destroyed
     void (*_cleanupFn)() = nullptr;
 
@@ -596,6 +1195,141 @@ private:
     /// Stores the previous frametime so that a delta frametime can be calculated
     double _statsPrevTimestamp = 0.0;
 
+    /// The number of previous frames that are used to predict the duration of a frame
+    static constexpr int FramePacingHistory = 16;
+
+    /// The time that the previous frames took from their start until their buffer swap,
+    /// which is the duration that the frame pacing has to leave before the next swap
+    std::array<double, FramePacingHistory> _frameWorkTimes = {};
+
+    /// The time at which the buffers were swapped at the end of the previous frame
+    double _previousSwapTime = 0.0;
+
+    /// The resolution scale of the windows that the master decides on and sends to the
+    /// clients. This is `nullptr` if the dynamic resolution is disabled
+    std::unique_ptr<SharedObject<float>> _resolutionScale;
+
+    /// Whether the master has marked the frames as unchanged, which is sent to the
+    /// clients with the frame's data
+    std::unique_ptr<SharedObject<bool>> _isFrameUnchanged;
+
+    /// The time on the master's clock at which the master started the frame
+    std::unique_ptr<SharedObject<double>> _presentationTime;
+
+    /// The frame number of the master, so that the cube faces that are rendered in each
+    /// frame and the benchmark scene are the same on all nodes. This is `nullptr` if the
+    /// cube faces are rendered every frame and no benchmark is running
+    std::unique_ptr<SharedObject<uint32_t>> _clusterFrameNumber;
+
+    /// The frame of the master in which all nodes reset the frame counters of their swap
+    /// group, and the frame of the last reset that has been applied. This is `nullptr`
+    /// if no node uses swap groups
+    std::unique_ptr<SharedObject<uint32_t>> _swapGroupReset;
+    uint32_t _appliedSwapGroupReset = 0;
+
+    /// Whether Statistics::swapGroupFrame has been read since the last reset
+    bool _hasSwapGroupFrame = false;
+
+    /// The steps of the lockstep simulation that all nodes run in a frame
+    struct LockstepFrame {
+        uint64_t firstStep = 0;
+        uint64_t nSteps = 0;
+        uint64_t seed = 0;
+    };
+
+    /// The simulation steps that the master decided on for the current frame, which is
+    /// `nullptr` if the lockstep simulation is disabled
+    std::unique_ptr<SharedObject<LockstepFrame>> _lockstepFrame;
+
+    /// The simulation time of the master that has not been simulated yet
+    double _lockstepAccumulator = 0.0;
+
+    /// The time at which the master started the previous frame
+    double _lockstepTime = -1.0;
+
+    /// The first simulation step that this node has not run yet
+    uint64_t _nextSimulationStep = 0;
+
+    /// The most recent hashes of the simulation state with the number of steps after
+    /// which they were computed. A client only keeps the latest hash, which it sends to
+    /// the master
+    std::deque<std::pair<uint64_t, uint64_t>> _simulationHashes;
+
+    /// The number of steps of the last hash of every client that has been compared, and
+    /// whether the client's simulation differed from the master's then
+    struct SimulationCheck {
+        uint64_t step = 0;
+        bool hasDiverged = false;
+    };
+    std::vector<SimulationCheck> _simulationChecks;
+
+    /// The difference between the swap group frame counter of each client and that of
+    /// the master after the last reset, in the order of the sync connections
+    std::vector<std::optional<int64_t>> _swapGroupOffsets;
+
+    /// The serialized configuration that the master sends to the clients whenever its
+    /// file has changed. This is `nullptr` if the configuration file is not watched
+    std::unique_ptr<SharedObject<std::string>> _config;
+
+    /// The input of the master that is sent to the clients. This is `nullptr` if the
+    /// input is not synchronized or if there is only a single node
+    std::unique_ptr<InputSync> _inputSync;
+
+    /// The replaced vertices of the editable correction meshes that the master sends to
+    /// the clients
+    std::unique_ptr<CorrectionMeshSync> _correctionMeshSync;
+
+    /// The serialized configuration whose settings have been applied last
+    std::string _appliedConfig;
+
+    /// The configuration file that is watched by the master and the time at which it
+    /// was last checked and modified
+    std::filesystem::path _configPath;
+    double _lastConfigCheck = 0.0;
+    std::optional<std::filesystem::file_time_type> _configWriteTime;
+
+    /// Serves the configuration to the clients that request it at startup. This is
+    /// `nullptr` on the clients and if no port is set on the commandline
+    std::unique_ptr<ConfigServer> _configServer;
+
+    /// The worker threads that run the jobs that are submitted by the user and by SGCT
+    std::unique_ptr<JobSystem> _jobSystem;
+
+    /// Sends the screenshots of the clients to the master, or receives them on the
+    /// master. This is `nullptr` if the screenshots are not collected
+    std::unique_ptr<CaptureCollector> _captureCollector;
+
+    /// Distributes media files from the master to all nodes
+    std::unique_ptr<MediaDistributor> _mediaDistributor;
+
+    /// Sends the cube faces of the helper nodes to the nodes that show them
+    std::unique_ptr<CubeFaceDistributor> _cubeFaceDistributor;
+
+    /// Exchanges the images of the windows that are composited across nodes
+    std::unique_ptr<SortLastCompositor> _sortLastCompositor;
+
+    /// Serves the performance metrics of this node to a monitoring system. This is
+    /// `nullptr` if no metrics port is set in the configuration
+    std::unique_ptr<MetricsExporter> _metricsExporter;
+
+    /// Writes a report of the frames that take much longer than the recent ones. This is
+    /// `nullptr` if no hitch detector is set in the configuration
+    std::unique_ptr<HitchDetector> _hitchDetector;
+
+    /// Records or replays the shared data on the master. These are `nullptr` on the
+    /// clients and if no recording is set in the configuration
+    std::unique_ptr<SyncRecorder> _syncRecorder;
+    std::unique_ptr<SyncReplay> _syncReplay;
+    std::unique_ptr<ExternalControl> _externalControl;
+
+    /// Renders the synthetic scene and records the frame times if the benchmark mode is
+    /// enabled, and is `nullptr` otherwise
+    std::unique_ptr<Benchmark> _benchmark;
+
+    /// The frame in which the resolution scale was changed last. The GPU times of the
+    /// frames before have been measured with the previous scale
+    unsigned int _resolutionScaleFrame = 0;
+
     /// The class that renders the on-screen representation of the Statistics data. If
     /// this pointer is `nullptr` then no rendering is performed
     std::unique_ptr<StatisticsRenderer> _statisticsRenderer;
@@ -610,6 +1344,9 @@ private:
     /// vector is empty, all windows will have a screenshot
     std::vector<int> _shouldTakeScreenshotIds;
 
+    /// The number of tiles if the screenshot of the next frame is a tiled screenshot
+    std::optional<ivec2> _screenshotTiles;
+
     Settings _settings;
 
     std::unique_ptr<std::thread> _thread;
@@ -0,0 +1,77 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__EXRWRITER__H__
+#define __SGCT__EXRWRITER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sgct {
+
+class JobSystem;
+
+/**
+ * Writes OpenEXR files with scanline images, for example the HDR colors of a frame
+ * together with its depth, normals, and positions. Every image is stored in its own part
+ * of a multi-part file, so that compositing applications show them as separate layers,
+ * and a file with a single image is written as a regular single-part file. The images
+ * are compressed with the ZIP method of the format in blocks of 16 scanlines, which are
+ * compressed concurrently if a job system is provided.
+ */
+class SGCT_EXPORT ExrWriter {
+public:
+    /// The types of the channels, which are stored in the file as they are in memory
+    enum class PixelType { Half, Float };
+
+    struct Channel {
+        /// The name of the channel in the file, for example `R` or `Z`
+        std::string name;
+        PixelType type = PixelType::Half;
+        /// The offset of the channel in bytes from the start of a pixel in memory
+        size_t offset = 0;
+    };
+
+    struct Part {
+        /// The name of the part in a multi-part file, for example `rgba` or `depth`
+        std::string name;
+        std::vector<Channel> channels;
+        /// The pixels of the image, whose rows are stored from the bottom like the rows
+        /// of an Image
+        const std::byte* data = nullptr;
+        /// The distance in bytes between two pixels in the data
+        size_t pixelSize = 0;
+    };
+
+    struct Settings {
+        /// The zlib compression level between 0, which stores the pixels uncompressed,
+        /// and 9 for the best compression. The value -1 selects the zlib default level
+        int compressionLevel = -1;
+
+        /// If this is set, the blocks of scanlines are compressed concurrently by the
+        /// jobs of this job system. Otherwise, they are compressed on the calling thread
+        JobSystem* jobSystem = nullptr;
+    };
+
+    /**
+     * Writes the \p parts, which all have the same \p size, into the file \p filename.
+     *
+     * \throw Error If the file cannot be written or the pixels cannot be compressed
+     */
+    static void write(const std::filesystem::path& filename, ivec2 size,
+        std::span<const Part> parts, const Settings& settings);
+};
+
+} // namespace sgct
+
+#endif // __SGCT__EXRWRITER__H__
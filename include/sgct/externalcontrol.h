@@ -0,0 +1,103 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__EXTERNALCONTROL__H__
+#define __SGCT__EXTERNALCONTROL__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Receives Open Sound Control (OSC) packets from control surfaces and other external
+ * applications on the master. The packets arrive on a TCP port, on which every packet is
+ * preceded by its size as a 32-bit big-endian integer as in OSC 1.0 streams, or as UDP
+ * datagrams with one packet each. A background thread parses the messages and bundles
+ * of the packets and keeps only the newest message for each address, so that the render
+ * thread receives at most one update per address and frame no matter how many updates
+ * the control surface sends.
+ */
+class SGCT_EXPORT ExternalControl {
+public:
+    /// The value of an argument of the OSC types `i`, `h`, `f`, `d`, `T` or `F`, and `s`
+    using Argument = std::variant<int32_t, int64_t, float, double, bool, std::string>;
+
+    struct Message {
+        /// The address pattern of the message, for example `/mixer/fader/1`
+        std::string address;
+        std::vector<Argument> arguments;
+    };
+
+    /**
+     * Starts receiving control packets on the TCP \p tcpPort and the UDP \p udpPort. A
+     * port of 0 is not opened. If a port cannot be opened, an error is logged and no
+     * packets are received on it.
+     */
+    ExternalControl(int tcpPort, int udpPort);
+    ~ExternalControl();
+
+    /**
+     * Calls the \p callback with the messages that have been received since the previous
+     * call, of which only the newest one is kept for each address. The messages are in
+     * the order in which their addresses were first received. The \p callback is not
+     * called if no messages have been received. This function is called on the render
+     * thread once per frame.
+     */
+    void update(void (*callback)(std::span<const Message>));
+
+private:
+    ExternalControl(const ExternalControl&) = delete;
+    ExternalControl(ExternalControl&&) = delete;
+    ExternalControl& operator=(const ExternalControl&) = delete;
+    ExternalControl& operator=(ExternalControl&&) = delete;
+
+    // A TCP connection with the bytes that have been received of its next packet
+    struct Client {
+        SGCT_SOCKET socket;
+        std::vector<std::byte> buffer;
+    };
+
+    void work();
+    // Returns `false` if the client has disconnected or sent an invalid packet size
+    bool receive(Client& client);
+    void handlePacket(std::span<const std::byte> packet);
+
+    SGCT_SOCKET _tcpSocket;
+    SGCT_SOCKET _udpSocket;
+    std::vector<Client> _clients;
+    std::vector<std::byte> _datagram;
+    // The messages of the packet that is parsed, reused for every packet
+    std::vector<Message> _parsed;
+    bool _hasWarned = false;
+
+    std::mutex _mutex;
+    // The newest message for each address that has been received since the last update
+    // and the index of each address in it
+    std::vector<Message> _pending;
+    std::unordered_map<std::string, size_t> _pendingIndices;
+    // The messages passed to the callback, whose memory is reused for the next frame
+    std::vector<Message> _messages;
+
+    std::atomic_bool _isRunning = false;
+    std::thread _thread;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__EXTERNALCONTROL__H__
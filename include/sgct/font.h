@@ -13,8 +13,12 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -35,15 +39,25 @@ namespace sgct::text {
 /**
  * Will handle font textures and rendering. Implementation is based on
  * <a href="http://nehe.gamedev.net/tutorial/freetype_fonts_in_opengl/24001/">Nehe's font
- * tutorial for freetype</a>.
+ * tutorial for freetype</a>. All glyphs of the font are packed into a single atlas
+ * texture, so that a text can be rendered with one draw call. The glyphs are created
+ * when a code point is used for the first time. The atlas is limited in size, and when
+ * it is full, the row of glyphs that was used the longest time ago is replaced.
+ *
+ * A distance field font stores the distance of each texel to the outline of the glyph
+ * instead of its coverage. Such a font is created once per face and can be rendered
+ * crisply at any size, and its stroke is drawn by the shader instead of being stored.
  */
 class SGCT_EXPORT Font {
 public:
     struct FontFaceData {
+        /// The atlas texture, which is the same for all glyphs of the font
         unsigned int texId = 0;
         float distToNextChar = 0.f;
         vec2 pos = vec2{ 0.f, 0.f };
         vec2 size = vec2{ 0.f, 0.f };
+        /// The top left corner of the glyph in the atlas, in texels
+        ivec2 atlasPos = ivec2{ 0, 0 };
         FT_Glyph glyph = nullptr;
     };
 
@@ -53,8 +67,9 @@ public:
      *
      * \param face The truetype face pointer
      * \param height Font height in pixels
+     * \param isDistanceField Whether the glyphs are stored as signed distance fields
      */
-    Font(FT_Library lib, FT_Face face, unsigned int h);
+    Font(FT_Library lib, FT_Face face, unsigned int h, bool isDistanceField = false);
 
     /**
      * Cleans up memory used by the Font and destroys the OpenGL objects.
@@ -62,20 +77,51 @@ public:
     ~Font();
 
     /**
-     * Get the font face data.
+     * Get the font face data of the Unicode code point \p c, which is created if it has
+     * not been used before or has been removed from the atlas since. The returned
+     * reference is valid until the next call of this function.
      */
-    const Font::FontFaceData& fontFaceData(char c);
+    const Font::FontFaceData& fontFaceData(char32_t c);
 
     /**
-     * Get the vertex array id.
+     * Get the vertex array id. The vertex array reads the vertex buffer with two floats
+     * for the position followed by two floats for the texel in the atlas.
      */
     unsigned int vao() const;
 
+    /**
+     * Get the vertex buffer id, into which the vertices of a text are uploaded.
+     */
+    unsigned int vbo() const;
+
+    /**
+     * Get the atlas texture that contains all glyphs that have been created so far.
+     */
+    unsigned int atlasTexture() const;
+
     /**
      * Get height of the font.
      */
     float height() const;
 
+    /**
+     * \return `true` if the atlas of this font contains signed distance fields
+     */
+    bool isDistanceField() const;
+
+    /**
+     * \return A number that changes whenever glyphs are removed from the atlas, after
+     *         which the atlas positions of glyphs that were looked up before can be
+     *         outdated
+     */
+    uint64_t atlasRevision() const;
+
+    /**
+     * \return The width of the stroke in the values of the distance field, which are 0.5
+     *         on the outline of a glyph
+     */
+    float distanceFieldStroke() const;
+
     /**
      * Set the stroke (border) size.
      *
@@ -84,15 +130,61 @@ public:
     void setStrokeSize(int size);
 
 private:
-    void createCharacter(char c);
+    /// A row of glyphs in the atlas, which is the unit in which glyphs are replaced
+    struct Row {
+        int y = 0;
+        int height = 0;
+        /// The end of the last glyph in the row
+        int x = 0;
+        /// The value of _useCounter when a glyph of the row was last used
+        uint64_t lastUse = 0;
+        std::vector<char32_t> glyphs;
+    };
+
+    void createCharacter(char32_t c);
+
+    /**
+     * Finds space for the glyph \p c with the size \p width x \p height in the atlas,
+     * which grows or has a row replaced if the glyph does not fit anymore, and copies
+     * the \p pixels into it.
+     *
+     * \return The top left corner of the glyph in the atlas, or no value if the glyph is
+     *         larger than the atlas
+     */
+    std::optional<ivec2> addToAtlas(char32_t c, int width, int height,
+        const std::vector<unsigned char>& pixels);
+
+    /**
+     * Removes all glyphs from the row with the index \p row and clears its texels.
+     */
+    void clearRow(size_t row);
+
+    void uploadAtlas();
 
     const FT_Library _library;
     const FT_Face _face;
     FT_Fixed _strokeSize = 1;
     const float _height;
-    std::unordered_map<char, FontFaceData> _fontFaceData;
+    const bool _isDistanceField;
+    // The number of bytes of each texel in the atlas
+    const int _channels;
+    std::unordered_map<char32_t, FontFaceData> _fontFaceData;
     unsigned int _vao = 0;
     unsigned int _vbo = 0;
+
+    unsigned int _atlas = 0;
+    ivec2 _atlasSize = ivec2{ 0, 0 };
+    // A copy of the atlas, from which the texture is recreated when it grows
+    std::vector<unsigned char> _atlasPixels;
+    // The height up to which the atlas grows before rows are replaced
+    int _maxAtlasHeight = 0;
+    // The rows of glyphs from the top of the atlas, which are at least as high as a line
+    std::vector<Row> _rows;
+    uint64_t _useCounter = 0;
+    uint64_t _atlasRevision = 0;
+
+    // The estimated video memory of the atlas texture
+    MemoryAccount _textureMemory = MemoryAccount(MemoryTracker::Category::Fonts);
 };
 
 } // namespace sgct
@@ -79,14 +79,15 @@ class Font;
  * );
  * ```
  *
- * Non ASCII characters are supported as well:
+ * Non ASCII characters are supported as well if the text is encoded in UTF-8. Their
+ * glyphs are created when they are printed for the first time:
  * ```cpp
  * sgct::text::print(
  *     sgct::text::FontManager::instance().getDefaultFont(14),
  *     sgct::text::TopLeft,
  *     50,
  *     50,
- *     L"Hallå Världen"
+ *     "Hallå Världen"
  * );
  * ```
  */
@@ -117,6 +118,15 @@ public:
      */
     Font* font(const std::string& name, unsigned int height = 10);
 
+    /**
+     * Get the distance field version of a font face, which is loaded into memory once
+     * and can be printed at any height.
+     *
+     * \param name Name of the font
+     * \return Pointer to the font face, `nullptr` if not found
+     */
+    Font* distanceFieldFont(const std::string& name);
+
     /**
      * Binds the font shader and also sets the four uniform values for the
      * modelviewprojectionmatrix, the inner color of the text, the stroke color, and the
@@ -124,9 +134,19 @@ public:
      */
     void bindShader(const mat4& mvp, const vec4& color, int texture) const;
 
+    /**
+     * Binds the shader for distance field fonts and sets its uniform values, which are
+     * the same as for #bindShader plus the width of the \p stroke in distance field
+     * values.
+     */
+    void bindDistanceFieldShader(const mat4& mvp, const vec4& color, int texture,
+        float stroke) const;
+
 private:
     /**
-     * Constructor initiates the freetype library.
+     * Constructor sets up the system font path. The freetype library is only initiated
+     * when the first font is created, so that nodes that never render text do not pay
+     * for it.
      */
     FontManager();
 
@@ -135,13 +155,16 @@ private:
      *
      * \param name Name of the font
      * \param height Height of the font in pixels
+     * \param isDistanceField Whether the glyphs are rendered as distance fields
      * \return Pointer to the newly created font, nullptr if something went wrong
      */
-    std::unique_ptr<Font> createFont(const std::string& name, int height);
+    std::unique_ptr<Font> createFont(const std::string& name, int height,
+        bool isDistanceField = false);
 
     static FontManager* _instance;
 
-    FT_Library _library;
+    FT_Library _library = nullptr;
+    bool _isLibraryInitialized = false;
 
     /// Holds all predefined font paths for generating font glyphs
     std::map<std::string, std::string> _fontPaths;
@@ -149,10 +172,21 @@ private:
     /// All generated fonts
     std::map<std::pair<std::string, unsigned int>, std::unique_ptr<Font>> _fontMap;
 
+    /// All generated distance field fonts, of which there is only one per face
+    std::map<std::string, std::unique_ptr<Font>> _distanceFieldFonts;
+
     ShaderProgram _shader;
     int _mvpLocation = -1;
     int _colorLocation = -1;
     int _textureLocation = -1;
+
+    ShaderProgram _distanceFieldShader;
+    struct {
+        int mvp = -1;
+        int color = -1;
+        int texture = -1;
+        int stroke = -1;
+    } _distanceFieldLocations;
 };
 
 } // namespace sgct::text
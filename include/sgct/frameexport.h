@@ -0,0 +1,135 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__FRAMEEXPORT__H__
+#define __SGCT__FRAMEEXPORT__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Shares the final frames of a window with other processes without copying them through
+ * the CPU. The frames are blitted into images whose memory is exported by the driver and
+ * which the other processes import into their own graphics API. The rows of the images
+ * are stored from the top, as Vulkan and DirectX expect them.
+ *
+ * On Linux, the images are exported as dmabufs through the EGL_MESA_image_dma_buf_export
+ * extension, which requires the OpenGL context to be created through EGL, and can be
+ * imported with EGL_EXT_image_dma_buf_import or VK_EXT_external_memory_dma_buf. The
+ * consumers connect to the Unix domain socket with the name `sgct-frameexport-<name>` in
+ * the abstract namespace. After connecting, they receive a Description together with the
+ * file descriptors of the planes of all images, and then a FrameMessage for every frame,
+ * together with the file descriptor of a sync file that is signaled once the frame has
+ * been written, if EGL_ANDROID_native_fence_sync is available. The images are written in
+ * turns, so a consumer has to finish reading an image before the number of images minus
+ * one frames have been written after it.
+ *
+ * On Windows, the image is a DirectX 11 texture whose shared NT handle has the name
+ * `SGCT_FrameExport_<name>` and that is written through the WGL_NV_DX_interop extension.
+ * Consumers open it with `ID3D11Device1::OpenSharedResourceByName` and synchronize with
+ * its keyed mutex: a new frame is released with the key 1, which the consumers acquire to
+ * read it and release with the key 0. A frame is skipped while a consumer holds the
+ * mutex.
+ */
+class SGCT_EXPORT FrameExport {
+public:
+    static constexpr uint32_t Magic = 0x46584753; // "SGXF"
+    static constexpr uint32_t Version = 1;
+    static constexpr int MaxPlanes = 4;
+
+    /// The message that a consumer receives after connecting, followed by
+    /// `nImages * nPlanes` file descriptors, the planes of each image after each other
+    struct Description {
+        uint32_t magic = Magic;
+        uint32_t version = Version;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        /// The DRM fourcc code and the format modifier of the images
+        uint32_t fourcc = 0;
+        uint32_t nImages = 0;
+        uint64_t modifier = 0;
+        uint32_t nPlanes = 0;
+        uint32_t strides[MaxPlanes] = {};
+        uint32_t offsets[MaxPlanes] = {};
+    };
+
+    /// The message that a consumer receives for every frame, followed by the file
+    /// descriptor of the sync file if #hasFence is 1
+    struct FrameMessage {
+        uint64_t frameNumber = 0;
+        uint32_t image = 0;
+        uint32_t hasFence = 0;
+    };
+
+    /**
+     * Creates the images with the \p size of the frames that are exported under the
+     * \p name. Has to be called with the OpenGL context current that renders the frames.
+     *
+     * \return The export, or `nullptr` if the required extensions are not available or
+     *         the images could not be exported, in which case a warning is logged
+     */
+    static std::unique_ptr<FrameExport> create(const std::string& name, ivec2 size);
+
+    ~FrameExport();
+
+    /**
+     * Blits the content of the read framebuffer into the next image and passes it to the
+     * consumers, unless there are none. This also accepts the consumers that have
+     * connected since the last frame.
+     *
+     * \param frameNumber The number of the frame that is sent with it
+     */
+    void exportFrame(uint64_t frameNumber);
+
+    /**
+     * \return The size of the exported images in pixels
+     */
+    ivec2 size() const;
+
+private:
+    FrameExport() = default;
+    FrameExport(const FrameExport&) = delete;
+    FrameExport& operator=(const FrameExport&) = delete;
+
+    std::string _name;
+    ivec2 _size = ivec2(0, 0);
+    unsigned int _fbo = 0;
+    std::vector<unsigned int> _textures;
+    size_t _nextImage = 0;
+    MemoryAccount _memory = MemoryAccount(MemoryTracker::Category::Framebuffers);
+#ifdef WIN32
+    void* _dxDevice = nullptr;
+    void* _dxTexture = nullptr;
+    void* _keyedMutex = nullptr;
+    void* _sharedHandle = nullptr;
+    void* _interopDevice = nullptr;
+    void* _interopObject = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    void acceptConsumers();
+
+    void* _display = nullptr;
+    std::vector<void*> _images;
+    Description _description;
+    // The file descriptors of the planes of all images, which are kept open to be passed
+    // to the consumers that connect later
+    std::vector<int> _planes;
+    int _socket = -1;
+    std::vector<int> _consumers;
+#endif // WIN32
+};
+
+} // namespace sgct
+
+#endif // __SGCT__FRAMEEXPORT__H__
@@ -11,6 +11,8 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <cstdint>
+#include <string>
 
 namespace sgct {
     class BaseViewport;
@@ -23,9 +25,78 @@ class Font;
 
 enum class Alignment { TopLeft, TopCenter, TopRight};
 
+/**
+ * Prints the \p text, which is encoded in UTF-8, at the position \p x, \p y in the
+ * \p viewport. Each line that is separated by `\n` is printed below the previous one.
+ */
 SGCT_EXPORT void print(const Window& window, const BaseViewport& viewport, Font& font,
     Alignment mode, float x, float y, const vec4& color, std::string text);
 
+/**
+ * Prints the \p text with the glyphs of the \p font scaled to the \p height in pixels.
+ * This is meant for the fonts from FontManager::distanceFieldFont, which stay sharp at
+ * any height, while the bitmaps of other fonts become blurry or blocky when scaled.
+ */
+SGCT_EXPORT void print(const Window& window, const BaseViewport& viewport, Font& font,
+    float height, Alignment mode, float x, float y, const vec4& color, std::string text);
+
+/**
+ * A text whose glyphs are laid out once and kept in a vertex buffer, so that printing it
+ * again only needs a single draw call. This is meant for labels that only change
+ * occasionally, as #print lays out the glyphs of the text on every call. The glyphs are
+ * laid out again when the text changes or when glyphs were removed from the atlas of the
+ * font to make room for other ones. The font has to outlive the layout, whose OpenGL
+ * objects are created in the context in which it is rendered for the first time.
+ */
+class SGCT_EXPORT TextLayout {
+public:
+    /**
+     * Creates a layout of the \p text, which is encoded in UTF-8, with the glyphs of the
+     * \p font scaled to the \p height in pixels.
+     */
+    TextLayout(Font& font, float height, Alignment mode, std::string text = "");
+
+    /**
+     * Creates a layout of the \p text with the glyphs of the \p font at its own height.
+     */
+    TextLayout(Font& font, Alignment mode, std::string text = "");
+
+    ~TextLayout();
+
+    /**
+     * Replaces the text of this layout, whose glyphs are only laid out again if the
+     * \p text is different from the previous one.
+     */
+    void setText(std::string text);
+
+    /**
+     * \return The text of this layout, encoded in UTF-8
+     */
+    const std::string& text() const;
+
+    /**
+     * Prints the text at the position \p x, \p y in the \p viewport in the same way as
+     * #print does.
+     */
+    void render(const Window& window, const BaseViewport& viewport, float x, float y,
+        const vec4& color);
+
+private:
+    TextLayout(const TextLayout&) = delete;
+    TextLayout& operator=(const TextLayout&) = delete;
+
+    Font& _font;
+    const float _height;
+    const Alignment _mode;
+    std::string _text;
+    bool _isDirty = true;
+    // The revision of the atlas of the font when the glyphs were laid out
+    uint64_t _atlasRevision = 0;
+    unsigned int _vao = 0;
+    unsigned int _vbo = 0;
+    int _nVertices = 0;
+};
+
 } // namespace sgct::text
 
 #endif // __SGCT__FREETYPE__H__
@@ -0,0 +1,110 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__FRUSTUMCULLER__H__
+#define __SGCT__FRUSTUMCULLER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace sgct {
+
+struct RenderData;
+
+/**
+ * Tests bounding volumes against several view frusta at once, so that a draw callback
+ * that renders the same objects into both eyes or into all faces of a cube map only
+ * walks the objects once. The planes of the frusta are stored as separate arrays of
+ * their components, and four objects are tested against each plane at a time with the
+ * same 4-wide vector instructions as the matrix products. The result of each object is
+ * a mask in which bit `i` is set if the object is at least partially inside of the
+ * frustum `i`. The tests are conservative, so an object close to an edge of a frustum
+ * can be reported as visible even though it is not.
+ */
+class SGCT_EXPORT FrustumCuller {
+public:
+    /// The number of frusta that fit into the visibility masks
+    static constexpr int MaxFrusta = 32;
+
+    struct Sphere {
+        vec3 center;
+        float radius = 0.f;
+    };
+
+    struct Box {
+        vec3 min;
+        vec3 max;
+    };
+
+    /**
+     * Removes all frusta, which is done when the matrices change, usually once a frame.
+     */
+    void clear();
+
+    /**
+     * Adds the frustum of the \p modelViewProjection matrix, which makes the objects
+     * tested in the space in which the matrix expects its input.
+     *
+     * \return The index of the frustum, which is its bit in the visibility masks, or -1
+     *         if #MaxFrusta frusta have been added already
+     */
+    int addFrustum(const mat4& modelViewProjection);
+
+    /**
+     * Adds all frusta that the draw call of the \p data renders into. These are the six
+     * faces of RenderData::cubeFaces in the order of the cube map faces if it is set, and
+     * otherwise the frustum of RenderData::modelViewProjectionMatrix followed by the one
+     * of RenderData::rightEye if it is set. The fisheye and omni-stereo draw calls have
+     * no frustum that is bounded by planes and add a frustum that contains everything.
+     *
+     * \return The index of the first frustum that was added, or -1 if not all of them
+     *         fit
+     */
+    int addFrusta(const RenderData& data);
+
+    /**
+     * \return The number of frusta that have been added since the last #clear
+     */
+    int numberOfFrusta() const;
+
+    /**
+     * Writes the visibility mask of each of the \p spheres into the element of the
+     * \p masks with the same index. The \p masks need at least as many elements as there
+     * are \p spheres.
+     */
+    void cull(std::span<const Sphere> spheres, std::span<uint32_t> masks) const;
+
+    /**
+     * Writes the visibility mask of each of the axis-aligned \p boxes into the element of
+     * the \p masks with the same index. The \p masks need at least as many elements as
+     * there are \p boxes.
+     */
+    void cull(std::span<const Box> boxes, std::span<uint32_t> masks) const;
+
+private:
+    static constexpr int PlanesPerFrustum = 6;
+
+    // The components of the normalized planes, with the plane `p` of the frustum `f` at
+    // `f * PlanesPerFrustum + p`. A point is inside of a frustum if `a*x + b*y + c*z + d`
+    // is positive for all of its planes
+    struct Planes {
+        std::array<float, MaxFrusta * PlanesPerFrustum> a = {};
+        std::array<float, MaxFrusta * PlanesPerFrustum> b = {};
+        std::array<float, MaxFrusta * PlanesPerFrustum> c = {};
+        std::array<float, MaxFrusta * PlanesPerFrustum> d = {};
+    };
+    Planes _planes;
+    int _nFrusta = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__FRUSTUMCULLER__H__
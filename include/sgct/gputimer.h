@@ -0,0 +1,70 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__GPUTIMER__H__
+#define __SGCT__GPUTIMER__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Measures the GPU time of a number of stages of a frame using timestamp queries. The
+ * queries of each frame are only read back #Latency frames later, by which time the GPU
+ * has usually finished them, so that the measurement never waits for the GPU. A result
+ * that is not available by then is dropped. Each stage can be measured multiple times in
+ * a frame, in which case the durations are summed up. The queries belong to the OpenGL
+ * context that is current when they are first used, so a timer must only be used with a
+ * single context.
+ */
+class SGCT_EXPORT GpuTimer {
+public:
+    /// The number of frames after which the results of a frame are read back
+    static constexpr int Latency = 3;
+
+    explicit GpuTimer(int nStages);
+
+    /**
+     * Deletes the queries. The context in which the queries were used has to be current.
+     */
+    void destroy();
+
+    /**
+     * Starts a new frame, which collects the results of the frame that was started
+     * #Latency frames earlier.
+     */
+    void beginFrame();
+
+    void begin(int stage);
+    void end(int stage);
+
+    /**
+     * \return The GPU time in seconds that the \p stage took in the most recent frame
+     *         whose results have been collected
+     */
+    double time(int stage) const;
+
+private:
+    struct Stage {
+        // Pairs of queries for the begin and end timestamps, one for each measurement
+        std::vector<std::array<unsigned int, 2>> queries;
+        int nUsed = 0;
+    };
+
+    void collect(std::vector<Stage>& frame);
+
+    std::array<std::vector<Stage>, Latency> _frames;
+    int _current = 0;
+    std::vector<double> _times;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__GPUTIMER__H__
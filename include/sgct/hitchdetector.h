@@ -0,0 +1,82 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__HITCHDETECTOR__H__
+#define __SGCT__HITCHDETECTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Detects frames that take much longer than the frames before them and writes a report
+ * for each of them, so that intermittent stalls can be diagnosed after the fact. A frame
+ * is a hitch if it takes longer than a multiple of the median of the recent frames. The
+ * report is a JSON file that contains the recent frame times, the timings and traffic of
+ * the network connections, and the memory counters of this node, and the Tracer writes
+ * the scopes that it has recorded next to it.
+ */
+class SGCT_EXPORT HitchDetector {
+public:
+    /// The number of recent frames whose median is compared with each frame
+    static constexpr size_t HistoryLength = 240;
+
+    /**
+     * \param folder The folder into which the reports are written, which is created when
+     *        the first report is written
+     * \param threshold The multiple of the median frame time above which a frame is a
+     *        hitch
+     * \param cooldown The time in seconds after a report during which no further reports
+     *        are written
+     * \param nodeId The id of this node, which is part of the names of the reports
+     */
+    HitchDetector(std::filesystem::path folder, double threshold, double cooldown,
+        int nodeId);
+
+    /**
+     * Adds the time of the \p frame and writes a report if it is a hitch. This function
+     * is called on the render thread once per frame.
+     *
+     * \param frame The number of the frame
+     * \param frameTime The time in seconds between the beginning of the previous frame
+     *        and the beginning of this one
+     */
+    void addFrame(unsigned int frame, double frameTime);
+
+    /**
+     * \return The number of hitches that have been detected, including those for which
+     *         no report was written because of the cooldown
+     */
+    int nHitches() const;
+
+private:
+    void writeReport(unsigned int frame, double frameTime, double median) const;
+
+    const std::filesystem::path _folder;
+    const double _threshold;
+    const double _cooldown;
+    const int _nodeId;
+
+    // The times of the recent frames as a ring buffer and the number of frames so far
+    std::array<double, HistoryLength> _frameTimes = {};
+    size_t _nFrames = 0;
+    // Reused for finding the median
+    std::vector<double> _sorted;
+
+    double _lastReportTime = 0.0;
+    bool _hasReported = false;
+    int _nHitches = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__HITCHDETECTOR__H__
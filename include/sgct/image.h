@@ -11,16 +11,81 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <cstddef>
+#include <cstdio>
 #include <filesystem>
+#include <functional>
+
+struct png_struct_def;
+struct png_info_def;
 
 namespace sgct {
 
+class JobSystem;
+
 class SGCT_EXPORT Image {
 public:
+    /**
+     * The zlib strategies that can be used to compress a PNG file.
+     */
+    enum class CompressionStrategy { Default, Filtered, HuffmanOnly, Rle };
+
+    /**
+     * The settings that control how a PNG file is compressed when it is saved.
+     */
+    struct PngSettings {
+        /// The zlib compression level between 0, which stores the pixels uncompressed,
+        /// and 9 for the best compression. The value -1 selects the zlib default level
+        int compressionLevel = -1;
+
+        /// The zlib compression strategy
+        CompressionStrategy strategy = CompressionStrategy::Default;
+
+        /// If this is set, the image is split into bands of rows that are compressed
+        /// concurrently by the jobs of this job system and joined into one stream.
+        /// Otherwise, the image is compressed by libPNG on the calling thread
+        JobSystem* jobSystem = nullptr;
+    };
+
+    /**
+     * Provides the memory for the pixels of images that allocate their own buffer, for
+     * example from a pool of buffers that are reused for images of the same size. If the
+     * \p allocate function returns `nullptr`, the allocation fails with an exception.
+     * The \p deallocate function receives the pointer and the size that were returned
+     * by and passed to the \p allocate function.
+     */
+    struct Allocator {
+        std::function<unsigned char*(size_t size)> allocate;
+        std::function<void(unsigned char* data, size_t size)> deallocate;
+    };
+
     Image() = default;
+    Image(Image&& rhs) noexcept;
+    Image& operator=(Image&& rhs) noexcept;
     ~Image();
 
+    /**
+     * Sets the \p allocator that is used by allocateOrResizeData. Buffers that were
+     * allocated before are still freed in the way in which they were allocated.
+     */
+    void setAllocator(Allocator allocator);
+
+    /**
+     * Allocates a buffer that matches the size, number of channels, and bytes per
+     * channel of this image. An existing buffer is reused if it has the correct size.
+     */
     void allocateOrResizeData();
+
+    /**
+     * Uses the \p data as the buffer of this image without copying it, for example the
+     * memory of a mapped pixel buffer object. The \p data has to match the size, number
+     * of channels, and bytes per channel of this image. If \p release is set, it is
+     * called with the \p data once the image no longer uses it. Otherwise, the memory
+     * stays owned by the caller and has to remain valid as long as the image uses it.
+     */
+    void setData(unsigned char* data, std::function<void(unsigned char*)> release = {});
+
     void load(const std::filesystem::path& filename);
     void load(unsigned char* data, int length);
 
@@ -29,6 +94,15 @@ public:
      */
     void save(const std::filesystem::path& filename);
 
+    /**
+     * Saves the \p data to file as if it was the buffer of this image, which is used
+     * when the pixels are stored in memory that is not owned by the image. The \p data
+     * has to have the size, number of channels, and bytes per channel of this image.
+     * The PNG file is compressed according to the \p settings.
+     */
+    void save(const std::filesystem::path& filename, const unsigned char* data,
+        const PngSettings& settings) const;
+
     unsigned char* data();
     const unsigned char* data() const;
     int channels() const;
@@ -40,11 +114,64 @@ public:
     void setBytesPerChannel(int bpc);
 
 private:
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    /// Frees the buffer through the function that belongs to its origin
+    void releaseData();
+
     int _nChannels = 0;
     ivec2 _size = ivec2{ 0, 0 };
     unsigned int _dataSize = 0;
     int _bytesPerChannel = 1;
     unsigned char* _data = nullptr;
+    // Frees the _data in the same way in which it was allocated. This is empty if the
+    // image does not own its buffer
+    std::function<void(unsigned char*)> _release;
+    Allocator _allocator;
+    // The size of the _data if the image owns it
+    MemoryAccount _memory = MemoryAccount(MemoryTracker::Category::Images);
+};
+
+/**
+ * Writes a PNG file in stripes of rows, so that an image that is too large to be held in
+ * memory as a whole can be saved while it is being created. The stripes are written from
+ * the top of the image, while the rows within each stripe are stored from the bottom
+ * like the rows of an Image. The file is complete once all rows have been written.
+ */
+class SGCT_EXPORT PngStripeWriter {
+public:
+    /**
+     * Creates the PNG file \p filename for an image of the \p size with the number of
+     * \p channels, which are stored in the order BGR(A) with \p bytesPerChannel bytes.
+     */
+    PngStripeWriter(const std::filesystem::path& filename, ivec2 size, int channels,
+        int bytesPerChannel, int compressionLevel = -1);
+
+    /**
+     * Closes the file, which is incomplete if not all rows have been written.
+     */
+    ~PngStripeWriter();
+
+    /**
+     * Writes the stripe of \p nRows rows in the \p data below the previous stripe.
+     */
+    void write(const unsigned char* data, int nRows);
+
+    /**
+     * \return The number of rows that have not been written yet
+     */
+    int remainingRows() const;
+
+private:
+    PngStripeWriter(const PngStripeWriter&) = delete;
+    PngStripeWriter& operator=(const PngStripeWriter&) = delete;
+
+    std::FILE* _file = nullptr;
+    png_struct_def* _png = nullptr;
+    png_info_def* _info = nullptr;
+    const size_t _rowSize;
+    int _remainingRows = 0;
 };
 
 } // namespace sgct
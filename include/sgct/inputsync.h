@@ -0,0 +1,123 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__INPUTSYNC__H__
+#define __SGCT__INPUTSYNC__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/actions.h>
+#include <sgct/joystick.h>
+#include <sgct/keys.h>
+#include <sgct/modifiers.h>
+#include <sgct/mouse.h>
+#include <sgct/shareddata.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace sgct {
+
+class Window;
+
+/**
+ * Sends the keyboard, mouse, and joystick input of the master to the clients, which
+ * call their input callbacks with it in the same order as the master did, so that the
+ * application does not have to share its input itself. The input is sent in a compact
+ * form with the data of the frame in which it happened:
+ *   - Keys as their code, their scancode, and one byte for the action and modifiers
+ *   - Characters and mouse buttons with their modifiers packed into 4 and 2 bytes
+ *   - Mouse positions as the difference to the previous position in quarter pixels,
+ *     which takes two bytes for small movements
+ *   - Scroll offsets in 1/256 steps as two 16 bit integers
+ *   - The states of the joysticks that have changed, with their axes quantized to 16 bit
+ *     and their buttons packed into bits, if they are sampled with joystick
+ * The clients pass the window with the same index as the master's window to the
+ * callbacks, or their first window if they do not have such a window. Their own input
+ * still calls the callbacks as well.
+ */
+class SGCT_EXPORT InputSync final : public SharedObjectBase {
+public:
+    /// The functions that are called on the clients with the input of the master
+    struct Callbacks {
+        std::function<void(Key, Modifier, Action, int, Window*)> keyboard;
+        std::function<void(unsigned int, int, Window*)> character;
+        std::function<void(MouseButton, Modifier, Action, Window*)> mouseButton;
+        std::function<void(double, double, Window*)> mousePos;
+        std::function<void(double, double, Window*)> mouseScroll;
+        std::function<void(std::vector<std::string_view>)> drop;
+    };
+
+    InputSync(uint32_t id, Callbacks callbacks);
+
+    /// Adds an event of the master, which is sent with the data of the next frame
+    void addKey(Key key, Modifier modifiers, Action action, int scancode,
+        const Window* window);
+    void addCharacter(unsigned int codepoint, int modifiers, const Window* window);
+    void addMouseButton(MouseButton button, Modifier modifiers, Action action,
+        const Window* window);
+    void addMousePosition(double x, double y, const Window* window);
+    void addMouseScroll(double x, double y, const Window* window);
+    void addDrop(const std::vector<std::string_view>& paths);
+
+    /**
+     * Adds the states of the joysticks that have changed since the last frame, if they
+     * are sampled. This is called on the master once per frame before the shared data
+     * is encoded.
+     */
+    void update();
+
+    /**
+     * Calls the callbacks with the input that has been received since the last call.
+     * This is called on the clients once per frame after the shared data of the frame
+     * has been received.
+     */
+    void replay();
+
+private:
+    enum class Type : uint8_t;
+
+    // The joysticks whose states are compared with the ones that were sent last
+    static constexpr int MaxJoysticks = 16;
+
+    struct SentJoystick {
+        bool isPresent = false;
+        std::vector<uint16_t> axes;
+        std::vector<bool> buttons;
+
+        bool operator==(const SentJoystick&) const = default;
+    };
+
+    void serialize(ByteWriter& writer) const override;
+    void deserialize(ByteReader& reader) override;
+
+    void writeHeader(Type type, const Window* window);
+    void decodeEvents(ByteReader& reader);
+
+    const Callbacks _callbacks;
+
+    // The events since the last frame that was sent, in their compact form
+    mutable std::vector<std::byte> _events;
+    // The joysticks whose states have changed since the last frame that was sent
+    mutable uint16_t _joystickMask = 0;
+    std::array<SentJoystick, MaxJoysticks> _joysticks;
+
+    // The last position of the mouse in each window as the clients decode it, so that
+    // the differences do not accumulate rounding errors
+    std::array<std::optional<std::array<double, 2>>, 32> _mousePositions;
+
+    // The blocks that the clients have received since the input was last replayed
+    std::vector<std::vector<std::byte>> _received;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__INPUTSYNC__H__
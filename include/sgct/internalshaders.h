@@ -27,6 +27,7 @@ constexpr std::string_view BaseVert = R"(
   }
 )";
 
+// Requires one of the implementations of sampleFrame, FrameSampleFun or FXAASampleFun
 constexpr std::string_view BaseFrag = R"(
   #version 330 core
 
@@ -34,7 +35,7 @@ constexpr std::string_view BaseFrag = R"(
   in vec4 tr_color;
   out vec4 out_color;
 
-  uniform sampler2D tex;
+  vec4 sampleFrame(vec2 uv);
 
   uniform int flipX = 0;
   uniform int flipY = 0;
@@ -48,7 +49,64 @@ constexpr std::string_view BaseFrag = R"(
       uv.y = 1.0 - uv.y;
     }
 
-    out_color = tr_color * texture(tex, uv);
+    out_color = tr_color * sampleFrame(uv);
+  }
+)";
+
+constexpr std::string_view FrameSampleFun = R"(
+  #version 330 core
+
+  uniform sampler2D tex;
+
+  vec4 sampleFrame(vec2 uv) {
+    return texture(tex, uv);
+  }
+)";
+
+// Applies a warp map together with the blend mask and black level mask of a viewport.
+// The warp map stores the texture coordinates and the color of the warp mesh at each
+// pixel, and the masks are multiplied as they are when they are blended onto the image.
+// Requires one of the implementations of sampleFrame, FrameSampleFun or FXAASampleFun
+constexpr std::string_view WarpMapFrag = R"(
+  #version 330 core
+
+  in vec2 tr_uv;
+  in vec4 tr_color;
+  out vec4 out_color;
+
+  vec4 sampleFrame(vec2 uv);
+
+  uniform sampler2D warpTexCoords;
+  uniform sampler2D warpColors;
+  uniform sampler2D blendMask;
+  uniform sampler2D blackLevelMask;
+
+  uniform int hasBlendMask = 0;
+  uniform int hasBlackLevelMask = 0;
+  uniform int flipX = 0;
+  uniform int flipY = 0;
+
+  vec2 flip(vec2 uv) {
+    if (flipX != 0) {
+      uv.x = 1.0 - uv.x;
+    }
+    if (flipY != 0) {
+      uv.y = 1.0 - uv.y;
+    }
+    return uv;
+  }
+
+  void main() {
+    vec2 uv = flip(texture(warpTexCoords, tr_uv).xy);
+    out_color = tr_color * texture(warpColors, tr_uv) * sampleFrame(uv);
+
+    vec2 maskUv = flip(tr_uv);
+    if (hasBlendMask != 0) {
+      out_color *= texture(blendMask, maskUv);
+    }
+    if (hasBlackLevelMask != 0) {
+      out_color *= texture(blackLevelMask, maskUv);
+    }
   }
 )";
 
@@ -281,6 +339,95 @@ constexpr std::string_view DummyStereoFrag = R"(
   }
 )";
 
+// Renders a warp mesh where it samples the framebuffer instead of where it ends up in the
+// window, which marks the pixels that are visible unless the mesh's color or the blend
+// mask of the viewport makes them black
+constexpr std::string_view PreMaskCoverageVert = R"(
+  #version 330 core
+
+  layout (location = 0) in vec2 in_position;
+  layout (location = 1) in vec2 in_texCoords;
+  layout (location = 2) in vec4 in_color;
+  out vec2 tr_maskUv;
+  out vec4 tr_color;
+
+  uniform vec2 viewportPosition;
+  uniform vec2 viewportSize;
+  uniform int flipX = 0;
+  uniform int flipY = 0;
+
+  vec2 flip(vec2 uv) {
+    return vec2(flipX != 0 ? 1.0 - uv.x : uv.x, flipY != 0 ? 1.0 - uv.y : uv.y);
+  }
+
+  void main() {
+    gl_Position = vec4(flip(in_texCoords) * 2.0 - 1.0, 0.0, 1.0);
+    // The blend mask covers the viewport in the window and is mirrored like the frame
+    tr_maskUv = flip(((in_position + 1.0) * 0.5 - viewportPosition) / viewportSize);
+    tr_color = in_color;
+  }
+)";
+
+constexpr std::string_view PreMaskCoverageFrag = R"(
+  #version 330 core
+
+  in vec2 tr_maskUv;
+  in vec4 tr_color;
+  out vec4 out_color;
+
+  uniform sampler2D blendMask;
+  uniform int hasBlendMask = 0;
+
+  void main() {
+    vec3 color = tr_color.rgb;
+    bool isInMask = all(greaterThanEqual(tr_maskUv, vec2(0.0))) &&
+      all(lessThanEqual(tr_maskUv, vec2(1.0)));
+    if (hasBlendMask != 0 && isInMask) {
+      color *= textureLod(blendMask, tr_maskUv, 0.0).rgb;
+    }
+    if (max(color.r, max(color.g, color.b)) <= 0.0) {
+      discard;
+    }
+    out_color = vec4(1.0);
+  }
+)";
+
+// Writes the near plane into the depth of the pixels that are not marked as visible in
+// the coverage texture, with the screen quad at the near plane
+constexpr std::string_view PreMaskVert = R"(
+  #version 330 core
+
+  layout (location = 0) in vec3 in_position;
+
+  void main() {
+    gl_Position = vec4(in_position, 1.0);
+  }
+)";
+
+constexpr std::string_view PreMaskFrag = R"(
+  #version 330 core
+
+  out vec4 out_color;
+
+  uniform sampler2D coverage;
+
+  void main() {
+    // The neighbors are included as the linear filtering of the framebuffer reaches one
+    // pixel beyond the pixels that are covered by the warp meshes
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 last = textureSize(coverage, 0) - 1;
+    for (int y = -1; y <= 1; y++) {
+      for (int x = -1; x <= 1; x++) {
+        ivec2 p = clamp(pixel + ivec2(x, y), ivec2(0), last);
+        if (texelFetch(coverage, p, 0).r > 0.0) {
+          discard;
+        }
+      }
+    }
+    out_color = vec4(0.0);
+  }
+)";
+
 constexpr std::string_view FXAAVert = R"(
   #version 330 core
 
@@ -397,520 +544,531 @@ constexpr std::string_view FXAAFrag = R"(
   }
 )";
 
-} // namespace sgct::shaders
-
-namespace sgct::shaders_fisheye {
-
-constexpr std::string_view RotationFourFaceCubeFun = R"(
-  #version 330 core
-
-  vec3 rotate(vec3 dir) {
-    const float Angle = 0.7071067812;
-    float x = Angle*dir.x + Angle*dir.z;
-    float y = dir.y;
-    float z = -Angle*dir.x + Angle*dir.z;
-
-    return vec3(x, y, z);
-  }
-)";
-
-constexpr std::string_view RotationFiveSixFaceCubeFun = R"(
+// The same antialiasing as FXAAFrag, but evaluated at an arbitrary position of the
+// framebuffer, so that it can be applied while the framebuffer is warped
+constexpr std::string_view FXAASampleFun = R"(
   #version 330 core
 
-  vec3 rotate(vec3 dir) {
-    const float Angle = 0.7071067812;
-    float x = Angle*dir.x - Angle*dir.y;
-    float y = Angle*dir.x + Angle*dir.y;
-    float z = dir.z;
-    return vec3(x, y, z);
-  }
-)";
-
-constexpr std::string_view RotationFun = R"(
-  #version 330 core
-
-  uniform mat4 rotMatrix;
-
-  vec3 rotate(vec3 dir) {
-    return (rotMatrix * vec4(dir, 0.0)).xyz;
-  }
-)";
+  const float FXAA_EDGE_THRESHOLD_MIN = 1.0 / 16.0;
+  const float FXAA_EDGE_THRESHOLD = 1.0 / 8.0;
+  const float FXAA_SPAN_MAX = 8.0;
+  const float FXAA_REDUCE_MIN = 1.0 / 128.0;
 
-constexpr std::string_view SampleFun = R"(
-  #version 330 core
+  uniform float FXAA_SUBPIX_TRIM;
+  uniform float FXAA_SUBPIX_OFFSET;
+  uniform float rt_w;
+  uniform float rt_h;
+  uniform sampler2D tex;
 
-  uniform float halfFov;
+  vec4 sampleFrame(vec2 uv) {
+    vec2 texel = vec2(1.0 / rt_w, 1.0 / rt_h);
+    vec2 offset = FXAA_SUBPIX_OFFSET * texel;
+    vec3 rgbNW = textureLod(tex, uv + vec2(-offset.x, -offset.y), 0.0).xyz;
+    vec3 rgbNE = textureLod(tex, uv + vec2( offset.x, -offset.y), 0.0).xyz;
+    vec3 rgbSW = textureLod(tex, uv + vec2(-offset.x,  offset.y), 0.0).xyz;
+    vec3 rgbSE = textureLod(tex, uv + vec2( offset.x,  offset.y), 0.0).xyz;
+    vec3 rgbM  = textureLod(tex, uv, 0.0).xyz;
 
-  vec3 rotate(vec3 dir);
+    const vec3 luma = vec3(0.299, 0.587, 0.114);
+    float lumaNW = dot(rgbNW, luma);
+    float lumaNE = dot(rgbNE, luma);
+    float lumaSW = dot(rgbSW, luma);
+    float lumaSE = dot(rgbSE, luma);
+    float lumaM  = dot( rgbM, luma);
 
-  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg) {
-    float s = 2.0 * (texel.s - 0.5);
-    float t = 2.0 * (texel.t - 0.5);
-    float r2 = s*s + t*t;
-    if (r2 <= 1.0) {
-      float phi = sqrt(r2) * halfFov;
-      float theta = atan(s, t);
-      vec3 dir = vec3(sin(phi) * sin(theta), -sin(phi) * cos(theta), cos(phi));
-      return texture(map, rotate(dir));
-    }
-    else {
-      return bg;
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+    float range = lumaMax - lumaMin;
+    // local contrast check, for not processing homogeneous areas
+    if (range < max(FXAA_EDGE_THRESHOLD_MIN, lumaMax * FXAA_EDGE_THRESHOLD)) {
+      return vec4(rgbM, 1.0);
     }
-  }
-)";
 
-constexpr std::string_view SampleLatlonFun = R"(
-  #version 330 core
-
-  vec3 rotate(vec3 dir);
+    vec2 dir = vec2(
+      -((lumaNW + lumaNE) - (lumaSW + lumaSE)),
+      ((lumaNW + lumaSW) - (lumaNE + lumaSE))
+    );
 
-  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg) {
-    float phi = 3.14159265359 * (1.0 - texel.t);
-    float theta = 6.28318530718 * (texel.s - 0.5);
-    vec3 dir = vec3(sin(phi) * sin(theta), sin(phi) * cos(theta), cos(phi));
-    return texture(map, rotate(dir));
-  }
-)";
+    float dirReduce = max(
+      (lumaNW + lumaNE + lumaSW + lumaSE) * (0.25 * FXAA_SUBPIX_TRIM),
+      FXAA_REDUCE_MIN
+    );
 
-constexpr std::string_view SampleOffsetFun = R"(
-  #version 330 core
+    float rcpDirMin = 1.0 / (min(abs(dir.x), abs(dir.y)) + dirReduce);
 
-  uniform float halfFov;
-  uniform vec3 offset;
+    dir = min(
+      vec2(FXAA_SPAN_MAX,  FXAA_SPAN_MAX),
+      max(vec2(-FXAA_SPAN_MAX, -FXAA_SPAN_MAX), dir * rcpDirMin)
+    ) * texel;
 
-  vec3 rotate(vec3 dir);
+    vec3 rgbA = 0.5 * (
+      textureLod(tex, uv + dir * (1.0 / 3.0 - 0.5), 0.0).xyz +
+      textureLod(tex, uv + dir * (2.0 / 3.0 - 0.5), 0.0).xyz
+    );
+    vec3 rgbB = rgbA * 0.5 + (1.0/4.0) * (
+      textureLod(tex, uv + dir * (0.0 / 3.0 - 0.5), 0.0).xyz +
+      textureLod(tex, uv + dir * (3.0 / 3.0 - 0.5), 0.0).xyz
+    );
+    float lumaB = dot(rgbB, luma);
 
-  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg) {
-    float s = 2.0 * (texel.s - 0.5);
-    float t = 2.0 * (texel.t - 0.5);
-    float r2 = s*s + t*t;
-    if (r2 <= 1.0) {
-      float phi = sqrt(r2) * halfFov;
-      float theta = atan(s, t);
-      float x = sin(phi) * sin(theta) - offset.x;
-      float y = -sin(phi) * cos(theta) - offset.y;
-      float z = cos(phi) - offset.z;
-      vec3 dir = vec3(x, y, z);
-      return texture(map, rotate(dir));
+    if ((lumaB < lumaMin) || (lumaB > lumaMax))  {
+      return vec4(rgbA, 1.0);
     }
     else {
-      return bg;
+      return vec4(rgbB, 1.0);
     }
   }
 )";
 
-constexpr std::string_view InterpolateLinearFun = R"(
+constexpr std::string_view FullscreenTriangleVert = R"(
   #version 330 core
 
-  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg);
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg) {
-    return getCubeSample(tc, map, bg);
+  void main() {
+    vec2 p = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);
+    gl_Position = vec4(p, 0.0, 1.0);
   }
 )";
 
-constexpr std::string_view InterpolateCubicFun = R"(
+// The red channel marks an edge between a pixel and its left neighbor, the green channel
+// an edge between a pixel and the neighbor below it
+constexpr std::string_view SMAAEdgeFrag = R"(
   #version 330 core
 
-  uniform float size;
-
-  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg);
-
-  vec4 cubic(float x) {
-    float x2 = x * x;
-    float x3 = x2 * x;
-    vec4 w = vec4(-x + 2*x2 - x3, 2 - 5*x2 + 3*x3, x + 4*x2 - 3*x3, -x2 + x3);
-    return w / 2.0;
-  }
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg) {
-    vec2 transTex = tc * vec2(size, size);
-    vec2 frac = fract(transTex);
-    transTex -= frac;
-
-    vec4 xcubic = cubic(frac.x);
-    vec4 ycubic = cubic(frac.y);
-
-    const float h = 1.0;
-    vec4 c = transTex.xxyy + vec4(-h, +h, -h, +h);
-    vec4 s = vec4(
-      xcubic.x + xcubic.y,
-      xcubic.z + xcubic.w,
-      ycubic.x + ycubic.y,
-      ycubic.z + ycubic.w
-    );
-    vec4 offset = c + vec4(xcubic.y, xcubic.w, ycubic.y, ycubic.w) / s;
+  uniform sampler2D tex;
 
-    vec4 sample0 = getCubeSample(vec2(offset.x, offset.z) / size, map, bg);
-    vec4 sample1 = getCubeSample(vec2(offset.y, offset.z) / size, map, bg);
-    vec4 sample2 = getCubeSample(vec2(offset.x, offset.w) / size, map, bg);
-    vec4 sample3 = getCubeSample(vec2(offset.y, offset.w) / size, map, bg);
+  out vec4 out_edges;
 
-    float sx = s.x / (s.x + s.y);
-    float sy = s.z / (s.z + s.w);
+  const float Threshold = 0.1;
+  // Edges that are much weaker than the strongest edge around the pixel are dropped
+  const float ContrastAdaptation = 2.0;
 
-    return mix(mix(sample3, sample2, sx), mix(sample1, sample0, sx), sy);
+  float luma(ivec2 p) {
+    ivec2 maxP = textureSize(tex, 0) - 1;
+    vec3 color = texelFetch(tex, clamp(p, ivec2(0), maxP), 0).rgb;
+    return dot(color, vec3(0.2126, 0.7152, 0.0722));
   }
-)";
-
-constexpr std::string_view BaseVert = R"(
-  #version 330 core
-
-  layout (location = 0) in vec3 in_position;
-  layout (location = 1) in vec2 in_texCoords;
-  out vec2 tr_uv;
 
   void main() {
-    gl_Position = vec4(in_position, 1.0);
-    tr_uv = in_texCoords;
-  }
-)";
-
-constexpr std::string_view FisheyeFrag = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  out vec4 out_diffuse;
-
-  uniform samplerCube cubemap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 texel, samplerCube map, vec4 bg);
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    float l = luma(p);
+    vec2 neighbors = vec2(luma(p + ivec2(-1, 0)), luma(p + ivec2(0, -1)));
+    vec2 delta = abs(l - neighbors);
+    vec2 edges = step(Threshold, delta);
+    if (edges.x + edges.y == 0.0) {
+      discard;
+    }
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
+    vec2 next = vec2(luma(p + ivec2(1, 0)), luma(p + ivec2(0, 1)));
+    vec2 beyond = vec2(luma(p + ivec2(-2, 0)), luma(p + ivec2(0, -2)));
+    vec2 maxDelta = max(max(delta, abs(l - next)), abs(neighbors - beyond));
+    float strongest = max(maxDelta.x, maxDelta.y);
+    edges *= step(strongest, ContrastAdaptation * delta);
+    out_edges = vec4(edges, 0.0, 1.0);
   }
 )";
 
-constexpr std::string_view FisheyeFragNormal = R"(
+// Instead of the precomputed area texture of SMAA, the area that the revectorized
+// silhouette covers in a pixel is integrated analytically. The silhouette runs from the
+// middle of the crossing edge at each end of an edge, which is half a pixel above or
+// below it, to the center of the edge. The red and green channels hold the weights for
+// the pixels above and below an edge at the bottom of the pixel, the blue and alpha
+// channels the weights for the pixels to the right and left of an edge at the left of the
+// pixel
+constexpr std::string_view SMAAWeightsFrag = R"(
   #version 330 core
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
+  uniform sampler2D edges;
 
-  uniform samplerCube cubemap;
-  uniform samplerCube normalmap;
-  uniform vec4 bgColor;
+  out vec4 out_weights;
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  const int MaxSearchSteps = 16;
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
+  float edge(ivec2 p, int channel) {
+    ivec2 maxP = textureSize(edges, 0) - 1;
+    if (any(lessThan(p, ivec2(0))) || any(greaterThan(p, maxP))) {
+      return 0.0;
+    }
+    return texelFetch(edges, p, 0)[channel];
   }
-)";
 
-constexpr std::string_view FisheyeFragPosition = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_position;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
-
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
+  // The number of pixels that continue the edge from p in the direction
+  int search(ivec2 p, ivec2 direction, int channel) {
+    int steps = 0;
+    for (int i = 1; i <= MaxSearchSteps; i++) {
+      if (edge(p + i * direction, channel) == 0.0) {
+        break;
+      }
+      steps = i;
+    }
+    return steps;
   }
-)";
-
-constexpr std::string_view FisheyeFragNormalPosition = R"(
-  #version 330 core
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
-  layout(location = 2) out vec3 out_position;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube normalmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
-
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
+  // The height of the silhouette at an end of the edge, which is positive if the
+  // crossing edge lies on the side of the pixel
+  float endHeight(ivec2 p, ivec2 across, int channel) {
+    return 0.5 * (edge(p, channel) - edge(p + across, channel));
   }
-)";
 
-constexpr std::string_view FisheyeFragDepth = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  out vec4 out_diffuse;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
-
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+  // The signed area below the line from (x0, h0) to (x1, h1) between a and b
+  float lineArea(float a, float b, float x0, float h0, float x1, float h1) {
+    if (b <= a) {
+      return 0.0;
+    }
+    float ha = mix(h0, h1, (a - x0) / (x1 - x0));
+    float hb = mix(h0, h1, (b - x0) / (x1 - x0));
+    return 0.5 * (b - a) * (ha + hb);
   }
-)";
-
-constexpr std::string_view FisheyeFragDepthNormal = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
 
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform samplerCube normalmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
-
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+  vec2 weights(ivec2 p, ivec2 direction, ivec2 across, int channel, int crossing) {
+    int before = search(p, -direction, channel);
+    int after = search(p, direction, channel);
+    float hBefore = endHeight(p - before * direction, across, crossing);
+    float hAfter = endHeight(p + (after + 1) * direction, across, crossing);
+
+    float len = float(before + after + 1);
+    float center = 0.5 * len;
+    float a = float(before);
+    float b = a + 1.0;
+    float area = lineArea(a, min(b, center), 0.0, hBefore, center, 0.0) +
+      lineArea(max(a, center), b, center, 0.0, len, hAfter);
+    return vec2(max(area, 0.0), max(-area, 0.0));
   }
-)";
-
-constexpr std::string_view FisheyeFragDepthPosition = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_position;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
 
   void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    vec2 e = texelFetch(edges, p, 0).rg;
+    if (e.r + e.g == 0.0) {
+      discard;
+    }
+
+    vec4 w = vec4(0.0);
+    if (e.g > 0.0) {
+      w.rg = weights(p, ivec2(1, 0), ivec2(0, -1), 1, 0);
+    }
+    if (e.r > 0.0) {
+      w.ba = weights(p, ivec2(0, 1), ivec2(-1, 0), 0, 1);
+    }
+    out_weights = w;
   }
 )";
 
-constexpr std::string_view FisheyeFragDepthNormalPosition = R"(
+// Blends each pixel with the neighbors across the edges around it in the direction in
+// which the weights are largest
+constexpr std::string_view SMAABlendFrag = R"(
   #version 330 core
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
-  layout(location = 2) out vec3 out_position;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform samplerCube normalmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
+  uniform sampler2D tex;
+  uniform sampler2D weights;
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  out vec4 out_color;
 
   void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 maxP = textureSize(tex, 0) - 1;
+    vec4 w = texelFetch(weights, p, 0);
+    float below = p.y > 0 ? w.r : 0.0;
+    float above = p.y < maxP.y ? texelFetch(weights, p + ivec2(0, 1), 0).g : 0.0;
+    float left = p.x > 0 ? w.b : 0.0;
+    float right = p.x < maxP.x ? texelFetch(weights, p + ivec2(1, 0), 0).a : 0.0;
+    if (below + above + left + right == 0.0) {
+      discard;
+    }
+
+    vec4 color = texelFetch(tex, p, 0);
+    vec2 amount;
+    ivec2 offset;
+    if (max(below, above) >= max(left, right)) {
+      amount = vec2(below, above);
+      offset = ivec2(0, 1);
+    }
+    else {
+      amount = vec2(left, right);
+      offset = ivec2(1, 0);
+    }
+    vec4 first = texelFetch(tex, clamp(p - offset, ivec2(0), maxP), 0);
+    vec4 second = texelFetch(tex, clamp(p + offset, ivec2(0), maxP), 0);
+    out_color = color * (1.0 - amount.x - amount.y) + first * amount.x +
+      second * amount.y;
   }
 )";
 
-constexpr std::string_view FisheyeFragOffAxis = R"(
+// Blends the current frame with the history of the previous frames at the position that
+// the pixel had in the previous frame. The history is clamped to the colors around the
+// pixel so that surfaces that have been uncovered or that moved do not leave a trail
+constexpr std::string_view TAAResolveFrag = R"(
   #version 330 core
 
-  in vec2 tr_uv;
-  out vec4 out_diffuse;
-
-  uniform samplerCube cubemap;
-  uniform vec4 bgColor;
+  uniform sampler2D tex;
+  uniform sampler2D history;
+  uniform sampler2D depth;
+  uniform bool hasDepth;
+  // Transforms normalized device coordinates of this frame into those of the previous
+  uniform mat4 reprojection;
+  // The area of the viewport in pixels (x, y, width, height)
+  uniform vec4 viewport;
+  uniform float feedback;
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  out vec4 out_color;
 
   void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-  }
-)";
-
-constexpr std::string_view FisheyeFragOffAxisNormal = R"(
-  #version 330 core
-
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube normalmap;
-  uniform vec4 bgColor;
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 minP = ivec2(viewport.xy);
+    ivec2 maxP = minP + ivec2(viewport.zw) - 1;
+    vec4 current = texelFetch(tex, p, 0);
+    vec4 lo = current;
+    vec4 hi = current;
+    for (int y = -1; y <= 1; y++) {
+      for (int x = -1; x <= 1; x++) {
+        vec4 c = texelFetch(tex, clamp(p + ivec2(x, y), minP, maxP), 0);
+        lo = min(lo, c);
+        hi = max(hi, c);
+      }
+    }
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+    // Without a depth buffer the pixels are reprojected as if they were infinitely far
+    // away, which is exact for rotations of the camera
+    vec2 uv = (gl_FragCoord.xy - viewport.xy) / viewport.zw;
+    float z = hasDepth ? texelFetch(depth, p, 0).r : 1.0;
+    vec4 previous = reprojection * vec4(vec3(uv, z) * 2.0 - 1.0, 1.0);
+    vec2 previousUv = previous.xy / previous.w * 0.5 + 0.5;
+    if (previous.w <= 0.0 || any(lessThan(previousUv, vec2(0.0))) ||
+        any(greaterThan(previousUv, vec2(1.0))))
+    {
+      out_color = current;
+      return;
+    }
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
+    vec2 position = viewport.xy + previousUv * viewport.zw;
+    vec4 h = texture(history, position / vec2(textureSize(history, 0)));
+    out_color = mix(current, clamp(h, lo, hi), feedback);
   }
 )";
 
-constexpr std::string_view FisheyeFragOffAxisPosition = R"(
-  #version 330 core
+} // namespace sgct::shaders
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_position;
+namespace sgct::shaders_fisheye {
 
-  uniform samplerCube cubemap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
+constexpr std::string_view RotationFun = R"(
+  #version 330 core
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  uniform mat4 rotMatrix;
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
+  vec3 rotate(vec3 dir) {
+    return (rotMatrix * vec4(dir, 0.0)).xyz;
   }
 )";
 
-constexpr std::string_view FisheyeFragOffAxisNormalPosition = R"(
+constexpr std::string_view SampleLatlonFun = R"(
   #version 330 core
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
-  layout(location = 2) out vec3 out_position;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube normalmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  vec3 rotate(vec3 dir);
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
+  vec4 getCubeSample(vec2 texel, samplerCube map, vec4 bg) {
+    float phi = 3.14159265359 * (1.0 - texel.t);
+    float theta = 6.28318530718 * (texel.s - 0.5);
+    vec3 dir = vec3(sin(phi) * sin(theta), sin(phi) * cos(theta), cos(phi));
+    return texture(map, rotate(dir));
   }
 )";
 
-constexpr std::string_view FisheyeFragOffAxisDepth = R"(
+constexpr std::string_view BaseVert = R"(
   #version 330 core
 
-  in vec2 tr_uv;
-  out vec4 out_diffuse;
-
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform vec4 bgColor;
-
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  layout (location = 0) in vec3 in_position;
+  layout (location = 1) in vec2 in_texCoords;
+  out vec2 tr_uv;
 
   void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+    gl_Position = vec4(in_position, 1.0);
+    tr_uv = in_texCoords;
   }
 )";
 
-constexpr std::string_view FisheyeFragOffAxisDepthNormal = R"(
+// The permutations are selected with the macros USE_DEPTH, USE_NORMALS, USE_POSITIONS,
+// OFF_AXIS, CUBIC, and FOUR_FACE_CUBE, and the constants BG_COLOR and CUBEMAP_SIZE are
+// baked into each of them. The fisheye direction is only computed once per pixel, and
+// all attachments are sampled in the same directions
+constexpr std::string_view FisheyeFrag = R"(
   #version 330 core
 
   in vec2 tr_uv;
   layout(location = 0) out vec4 out_diffuse;
+#ifdef USE_NORMALS
   layout(location = 1) out vec3 out_normal;
+  #define POSITION_LOCATION 2
+#else
+  #define POSITION_LOCATION 1
+#endif
+#ifdef USE_POSITIONS
+  layout(location = POSITION_LOCATION) out vec3 out_position;
+#endif
 
   uniform samplerCube cubemap;
+#ifdef USE_DEPTH
   uniform samplerCube depthmap;
+#endif
+#ifdef USE_NORMALS
   uniform samplerCube normalmap;
-  uniform vec4 bgColor;
+#endif
+#ifdef USE_POSITIONS
+  uniform samplerCube positionmap;
+#endif
+  uniform float halfFov;
+#ifdef OFF_AXIS
+  uniform vec3 offset;
+#endif
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+  struct Sample {
+    vec4 color;
+    float depth;
+    vec3 normal;
+    vec3 position;
+  };
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+  vec3 rotate(vec3 dir) {
+    const float Angle = 0.7071067812;
+#ifdef FOUR_FACE_CUBE
+    return vec3(Angle*dir.x + Angle*dir.z, dir.y, -Angle*dir.x + Angle*dir.z);
+#else
+    return vec3(Angle*dir.x - Angle*dir.y, Angle*dir.x + Angle*dir.y, dir.z);
+#endif
   }
-)";
 
-constexpr std::string_view FisheyeFragOffAxisDepthPosition = R"(
-  #version 330 core
+  // Returns false for texels outside of the fisheye circle
+  bool fisheyeDirection(vec2 texel, out vec3 dir) {
+    float s = 2.0 * (texel.s - 0.5);
+    float t = 2.0 * (texel.t - 0.5);
+    float r2 = s*s + t*t;
+    if (r2 > 1.0) {
+      return false;
+    }
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_position;
+    float phi = sqrt(r2) * halfFov;
+    float theta = atan(s, t);
+    dir = vec3(sin(phi) * sin(theta), -sin(phi) * cos(theta), cos(phi));
+#ifdef OFF_AXIS
+    dir -= offset;
+#endif
+    dir = rotate(dir);
+    return true;
+  }
 
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
+  Sample cubeSample(vec3 dir) {
+    Sample res = Sample(BG_COLOR, 1.0, vec3(0.0), vec3(0.0));
+    res.color = texture(cubemap, dir);
+#ifdef USE_DEPTH
+    res.depth = texture(depthmap, dir).x;
+#endif
+#ifdef USE_NORMALS
+    res.normal = texture(normalmap, dir).xyz;
+#endif
+#ifdef USE_POSITIONS
+    res.position = texture(positionmap, dir).xyz;
+#endif
+    return res;
+  }
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+#ifdef CUBIC
+  vec4 cubic(float x) {
+    float x2 = x * x;
+    float x3 = x2 * x;
+    vec4 w = vec4(-x + 2*x2 - x3, 2 - 5*x2 + 3*x3, x + 4*x2 - 3*x3, -x2 + x3);
+    return w / 2.0;
+  }
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
+  Sample mixSamples(Sample a, Sample b, float t) {
+    return Sample(
+      mix(a.color, b.color, t),
+      mix(a.depth, b.depth, t),
+      mix(a.normal, b.normal, t),
+      mix(a.position, b.position, t)
+    );
   }
-)";
 
-constexpr std::string_view FisheyeFragOffAxisDepthNormalPosition = R"(
-  #version 330 core
+  // The cubic filter is evaluated on the texel grid of the cube face that the direction
+  // points at with 4 bilinear samples, each of which weighs 2x2 texels. The samples are
+  // placed in the plane of the face and turned back into directions, so the samples
+  // beyond the edge of the face continue onto the neighboring face, whose seam is
+  // filtered by the seamless cube map sampling
+  Sample interpolatedSample(vec2 tc) {
+    vec3 dir;
+    if (!fisheyeDirection(tc, dir)) {
+      return Sample(BG_COLOR, 1.0, vec3(0.0), vec3(0.0));
+    }
 
-  in vec2 tr_uv;
-  layout(location = 0) out vec4 out_diffuse;
-  layout(location = 1) out vec3 out_normal;
-  layout(location = 2) out vec3 out_position;
+    // The texel grid is symmetric, so the orientation of the axes of the face does not
+    // matter as long as they are the two axes that are not the major axis
+    vec3 a = abs(dir);
+    mat3 face;
+    vec2 uv;
+    if (a.x >= a.y && a.x >= a.z) {
+      face = mat3(vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(sign(dir.x), 0.0, 0.0));
+      uv = dir.yz / a.x;
+    }
+    else if (a.y >= a.z) {
+      face = mat3(vec3(1.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, sign(dir.y), 0.0));
+      uv = dir.xz / a.y;
+    }
+    else {
+      face = mat3(vec3(1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, sign(dir.z)));
+      uv = dir.xy / a.z;
+    }
 
-  uniform samplerCube cubemap;
-  uniform samplerCube depthmap;
-  uniform samplerCube normalmap;
-  uniform samplerCube positionmap;
-  uniform vec4 bgColor;
+    const float Size = CUBEMAP_SIZE;
+    vec2 texel = (uv * 0.5 + 0.5) * Size - 0.5;
+    vec2 frac = fract(texel);
+    texel -= frac;
 
-  vec4 sample(vec2 tc, samplerCube map, vec4 bg);
+    vec4 xcubic = cubic(frac.x);
+    vec4 ycubic = cubic(frac.y);
 
-  void main() {
-    out_diffuse = sample(tr_uv, cubemap, bgColor);
-    out_normal = sample(tr_uv, normalmap, vec4(0.0)).xyz;
-    out_position = sample(tr_uv, positionmap, vec4(0.0)).xyz;
-    gl_FragDepth = sample(tr_uv, depthmap, vec4(1.0)).x;
-  }
-)";
+    vec4 c = texel.xxyy + vec4(-0.5, 1.5, -0.5, 1.5);
+    vec4 s = vec4(
+      xcubic.x + xcubic.y,
+      xcubic.z + xcubic.w,
+      ycubic.x + ycubic.y,
+      ycubic.z + ycubic.w
+    );
+    // The positions of the bilinear samples in the plane of the face in [-1, 1]
+    vec4 coords = (c + vec4(xcubic.y, xcubic.w, ycubic.y, ycubic.w) / s) / Size;
+    coords = coords * 2.0 - 1.0;
 
-constexpr std::string_view FisheyeDepthCorrectionFrag = R"(
-  #version 330 core
+    Sample sample0 = cubeSample(face * vec3(coords.x, coords.z, 1.0));
+    Sample sample1 = cubeSample(face * vec3(coords.y, coords.z, 1.0));
+    Sample sample2 = cubeSample(face * vec3(coords.x, coords.w, 1.0));
+    Sample sample3 = cubeSample(face * vec3(coords.y, coords.w, 1.0));
 
-  in vec2 tr_uv;
-  out vec4 Color;
+    float sx = s.x / (s.x + s.y);
+    float sy = s.z / (s.z + s.w);
 
-  uniform sampler2D cTex;
-  uniform sampler2D dTex;
-  uniform float near;
-  uniform float far;
+    return mixSamples(
+      mixSamples(sample3, sample2, sx),
+      mixSamples(sample1, sample0, sx),
+      sy
+    );
+  }
+#else
+  Sample interpolatedSample(vec2 tc) {
+    vec3 dir;
+    if (!fisheyeDirection(tc, dir)) {
+      return Sample(BG_COLOR, 1.0, vec3(0.0), vec3(0.0));
+    }
+    return cubeSample(dir);
+  }
+#endif
 
   void main() {
-    float a = far / (far - near);
-    float b = far * near / (near - far);
-    float z = b / (texture(dTex, tr_uv).x - a);
-
-    // get angle from -45 to 45 degrees (-pi/4 to +pi/4)
-    vec2 angle = 1.57079632679 * tr_uv - 0.5;
-
-    float xNorm = tan(angle.x);
-    float yNorm = tan(angle.y);
-    float r = z * sqrt(xNorm * xNorm + yNorm * yNorm + 1.0);
-
-    Color = texture(cTex, tr_uv);
-    gl_FragDepth = a + b / r;
+    Sample res = interpolatedSample(tr_uv);
+    out_diffuse = res.color;
+#ifdef USE_NORMALS
+    out_normal = res.normal;
+#endif
+#ifdef USE_POSITIONS
+    out_position = res.position;
+#endif
+#ifdef USE_DEPTH
+    gl_FragDepth = res.depth;
+#endif
   }
 )";
 
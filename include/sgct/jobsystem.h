@@ -0,0 +1,156 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__JOBSYSTEM__H__
+#define __SGCT__JOBSYSTEM__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * A pool of worker threads that runs jobs which can depend on other jobs. Every worker
+ * has its own queue, to which the jobs that are submitted from that worker are added
+ * and from which the worker takes the most recently added job. A worker whose queue is
+ * empty steals the oldest job from the queue of another worker. A thread that waits for
+ * a job runs other jobs in the meantime, so jobs can wait for other jobs, too. The jobs
+ * must not use OpenGL as the workers do not have a context.
+ */
+class SGCT_EXPORT JobSystem {
+    struct State;
+
+public:
+    /**
+     * The stages of a frame that a job can be required to be finished before. The Engine
+     * waits for all jobs that are bound to a stage before it calls the stage's callback.
+     */
+    enum class FrameStage {
+        /// Before the pre sync callback of the next frame
+        PreSync = 0,
+        /// Before the post sync pre draw callback
+        PostSyncPreDraw,
+        /// Before the windows are rendered
+        Draw,
+        /// Before the post draw callback
+        PostDraw
+    };
+
+    /**
+     * Refers to a job that has been submitted, which can be used to wait for the job or
+     * as a dependency of other jobs. A default-constructed Job refers to no job and
+     * counts as finished.
+     */
+    class SGCT_EXPORT Job {
+    public:
+        Job() = default;
+
+        /**
+         * \return `true` if the job has finished running, whether or not it threw an
+         *         exception
+         */
+        bool isFinished() const;
+
+    private:
+        friend class JobSystem;
+
+        std::shared_ptr<State> _state;
+    };
+
+    /**
+     * \param nThreads The number of worker threads, which is at least 1
+     */
+    explicit JobSystem(int nThreads);
+
+    /**
+     * Finishes all jobs that have been submitted and stops the worker threads.
+     */
+    ~JobSystem();
+
+    /**
+     * Submits the \p function to be run on a worker thread once all \p dependencies have
+     * finished.
+     *
+     * \param function The function that is run by the job
+     * \param dependencies The jobs that have to finish before this job can start
+     * \param finishBefore If provided, the Engine waits for this job before it enters
+     *        the stage of the frame, which is the next occurrence of that stage after
+     *        this function was called
+     * \return The job that refers to the submitted \p function
+     */
+    Job submit(std::function<void()> function, const std::vector<Job>& dependencies = {},
+        std::optional<FrameStage> finishBefore = std::nullopt);
+
+    /**
+     * Waits until the \p job has finished and runs other jobs on the calling thread in
+     * the meantime.
+     *
+     * \throw The exception that was thrown by the \p job, if any
+     */
+    void wait(const Job& job);
+
+    /**
+     * Waits for all jobs that have to be finished before the \p stage. This function is
+     * called internally by SGCT and shouldn't be used by the user.
+     *
+     * \throw The first exception that was thrown by any of these jobs
+     */
+    void finishStage(FrameStage stage);
+
+    /**
+     * \return The number of worker threads
+     */
+    int nThreads() const;
+
+private:
+    JobSystem(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<State>> queue;
+    };
+
+    void loop(int index);
+
+    // Takes a job from the queue of the worker with the \p index, or any other queue if
+    // that one is empty, and runs it. The index is -1 for threads that are not workers
+    bool runOne(int index);
+    void schedule(std::shared_ptr<State> state);
+    void finish(State& state);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::atomic_int _nextWorker = 0;
+
+    // The number of jobs that are in a queue, which is only increased while holding the
+    // _sleepMutex so that no worker misses the wake-up
+    std::atomic_int _nQueued = 0;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCond;
+    bool _shouldTerminate = false;
+
+    std::mutex _stageMutex;
+    std::array<std::vector<Job>, 4> _stageJobs;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__JOBSYSTEM__H__
@@ -9,6 +9,10 @@
 #ifndef __SGCT__JOYSTICK__H__
 #define __SGCT__JOYSTICK__H__
 
+#include <sgct/sgctexports.h>
+#include <cstdint>
+#include <vector>
+
 // abock(2019-10-02);  The values here are hardcoded as I don't want to pull in the
 // entirety of GLFW in this header just for the definitions.  And they most likely will
 // not change anytime soon anyway (famous last words)
@@ -34,4 +38,84 @@ enum class Joystick {
 };
 } // namespace sgct
 
+/**
+ * Samples the joysticks on a background thread instead of polling them with GLFW in the
+ * frame loop, so that neither the resolution of the input nor the time it takes to read
+ * it depend on the rendering. GLFW only allows joysticks to be read from the main
+ * thread, so the sampling thread uses the joystick devices `/dev/input/js0` to
+ * `/dev/input/js15` on Linux, which deliver their samples the moment they arrive, and
+ * the XInput controllers 1 to 4 on Windows, which are polled at the frequency of the
+ * sampling. The numbers of the joysticks usually match the ones of GLFW for the first
+ * joysticks, but this is not guaranteed. Joysticks cannot be sampled on other platforms.
+ */
+namespace sgct::joystick {
+    /// The change of an axis or a button of a joystick
+    struct Event {
+        enum class Type : uint8_t { Axis, Button };
+
+        Joystick joystick = Joystick::Joystick1;
+        Type type = Type::Axis;
+        /// The index of the axis or the button
+        int index = 0;
+        /// The position of an axis in [-1, 1], or 1 for a button that was pressed and 0
+        /// for one that was released
+        float value = 0.f;
+        /// The time at which the change was sampled, as returned by sgct::time
+        double time = 0.0;
+    };
+
+    /// The positions of the axes and the buttons of a joystick at a point in time
+    struct State {
+        bool isPresent = false;
+        std::vector<float> axes;
+        std::vector<bool> buttons;
+    };
+
+    /**
+     * Starts sampling the joysticks on a background thread. The joysticks that are
+     * polled are sampled \p frequency times per second, and joysticks that are
+     * connected later are found within a second. Nothing happens if the joysticks are
+     * already being sampled.
+     */
+    SGCT_EXPORT void startSampling(double frequency = 1000.0);
+
+    /**
+     * Stops sampling the joysticks and waits for the background thread to end. This is
+     * called by the Engine when it is destroyed.
+     */
+    SGCT_EXPORT void stopSampling();
+
+    /**
+     * \return `true` if the joysticks are being sampled
+     */
+    SGCT_EXPORT bool isSampling();
+
+    /**
+     * Removes the events that have been sampled since the last call from the queue and
+     * returns them in the order in which they were sampled. If the queue is not emptied,
+     * only the latest 4096 events are kept.
+     */
+    SGCT_EXPORT std::vector<Event> events();
+
+    /**
+     * \return The latest state of the \p joystick
+     */
+    SGCT_EXPORT State state(Joystick joystick);
+
+    /**
+     * \return The state of the \p joystick at the \p time, as returned by sgct::time,
+     *         which can lie up to a second in the past. The axes are interpolated
+     *         between the samples that surround the time, so that a frame can read the
+     *         joystick at the time that it shows
+     */
+    SGCT_EXPORT State state(Joystick joystick, double time);
+
+    /**
+     * Replaces the state of the \p joystick with the \p state that the master has
+     * sampled, whose changes are queued as events. This function is called internally by
+     * SGCT on the clients if the input is synchronized and shouldn't be used by the user.
+     */
+    SGCT_EXPORT void setReceivedState(Joystick joystick, const State& state);
+} // namespace sgct::joystick
+
 #endif // __SGCT__JOYSTICK__H__
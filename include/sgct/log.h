@@ -10,10 +10,13 @@
 #define __SGCT__LOGGER__H__
 
 #include <sgct/sgctexports.h>
+#include <atomic>
+#include <ctime>
 #include <functional>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace sgct {
@@ -59,14 +62,53 @@ public:
      */
     void setLogCallback(std::function<void(Level, std::string_view)> fn);
 
+    /**
+     * Sets a second callback that gets invoked for each log in addition to the log
+     * callback. This is used by SGCT itself to forward the log messages of a client to
+     * the master node. Unlike the log callback, this callback receives the message
+     * without the time and log level.
+     */
+    void setForwardCallback(std::function<void(Level, std::string_view)> fn);
+
+    /**
+     * Sets whether the messages are written on a background thread. In that case, the
+     * thread that logs a message only adds it to a lock-free queue, and the background
+     * thread adds the time and log level, writes the message to the console, and calls
+     * the callbacks, so a burst of messages does not delay the rendering. The callbacks
+     * are then called on the background thread. Disabling it writes the messages that
+     * are still queued before this function returns.
+     */
+    void setAsynchronous(bool state);
+
 private:
+    struct Record {
+        Record* next = nullptr;
+        Level level = Level::Info;
+        time_t time = 0;
+        std::string message;
+        /// Set on the record that stops the background thread
+        bool isStop = false;
+    };
+
     Log();
+    ~Log();
     Log(const Log&) = delete;
     Log(Log&&) = delete;
     Log& operator=(const Log&) = delete;
     Log& operator=(Log&&) = delete;
 
     void printv(Level level, std::string message);
+    void write(Level level, time_t time, std::string message);
+
+    void push(Record* record);
+    void work();
+
+    /**
+     * Writes the \p records, which are in the reverse order in which they were pushed.
+     *
+     * \return `false` if one of them was the record that stops the background thread
+     */
+    bool writeRecords(Record* records);
 
     static Log* _instance;
 
@@ -79,7 +121,13 @@ private:
 
     std::mutex _mutex;
 
+    /// The most recently pushed record of the messages that have not been written yet
+    std::atomic<Record*> _pending = nullptr;
+    std::atomic_bool _isAsynchronous = false;
+    std::thread _thread;
+
     std::function<void(Level, std::string_view)> _messageCallback;
+    std::function<void(Level, std::string_view)> _forwardCallback;
 };
 
 } // namespace sgct
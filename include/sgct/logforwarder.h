@@ -0,0 +1,71 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__LOGFORWARDER__H__
+#define __SGCT__LOGFORWARDER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/log.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace sgct {
+
+class Network;
+
+/**
+ * Forwards the log messages of a client to the master, where they are printed in the
+ * master's log with the id of the client, their original log level, and the time on the
+ * master's clock at which they were logged. The messages are queued on the sync
+ * connection, which sends all messages of a frame together with the acknowledgement of
+ * that frame. To protect the master's log from a client that floods its own, only
+ * #MaxMessagesPerSecond messages of each level are forwarded per second, and the number
+ * of the messages that were dropped is forwarded once the limit is lifted again.
+ */
+class SGCT_EXPORT LogForwarder {
+public:
+    /// The number of messages per second that are forwarded, indexed by the log level
+    static constexpr std::array<int, 4> MaxMessagesPerSecond = { 20, 50, 100, 100 };
+
+    explicit LogForwarder(Network& connection);
+
+    /**
+     * Queues the \p message with the \p level on the connection, unless the limit of its
+     * level has been reached. This function can be called from any thread.
+     */
+    void forward(Log::Level level, std::string_view message);
+
+    /**
+     * \return The line in which a \p message with the \p level that was logged at the
+     *         master's \p time is sent to the master
+     */
+    static std::string encode(Log::Level level, double time, std::string_view message);
+
+    /**
+     * Prints the \p messages, which the client with the \p clientId has sent with the
+     * acknowledgement of a frame, in the log of the master.
+     */
+    static void print(int clientId, std::string_view messages);
+
+private:
+    struct Limit {
+        double windowStart = 0.0;
+        int nMessages = 0;
+        int nDropped = 0;
+    };
+
+    Network& _connection;
+    std::mutex _mutex;
+    std::array<Limit, 4> _limits;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__LOGFORWARDER__H__
@@ -12,6 +12,20 @@
 #include <sgct/sgctexports.h>
 #include <array>
 #include <compare>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+// The matrix products use 4-wide vector instructions where they are available, which all
+// 64-bit x86 and ARM processors support. They fall back to the scalar implementation for
+// constant evaluation and on all other processors
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SGCT_MATH_USE_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SGCT_MATH_USE_NEON
+#endif
 
 namespace sgct {
 
@@ -112,9 +126,171 @@ struct SGCT_EXPORT mat4 {
     std::array<float, 16> values;
 };
 
-SGCT_EXPORT mat4 operator*(const mat4& m1, const mat4& m2);
-SGCT_EXPORT vec4 operator*(const mat4& m, const vec4& v);
-SGCT_EXPORT vec3 operator*(const quat& q, const vec3& v);
+constexpr mat4 operator*(const mat4& m1, const mat4& m2) {
+    mat4 res;
+    if (!std::is_constant_evaluated()) {
+#if defined(SGCT_MATH_USE_SSE)
+        const __m128 c0 = _mm_loadu_ps(&m1.values[0]);
+        const __m128 c1 = _mm_loadu_ps(&m1.values[4]);
+        const __m128 c2 = _mm_loadu_ps(&m1.values[8]);
+        const __m128 c3 = _mm_loadu_ps(&m1.values[12]);
+        for (int c = 0; c < 4; c++) {
+            const float* col = &m2.values[c * 4];
+            __m128 r = _mm_mul_ps(c0, _mm_set1_ps(col[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(col[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(col[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(col[3])));
+            _mm_storeu_ps(&res.values[c * 4], r);
+        }
+        return res;
+#elif defined(SGCT_MATH_USE_NEON)
+        const float32x4_t c0 = vld1q_f32(&m1.values[0]);
+        const float32x4_t c1 = vld1q_f32(&m1.values[4]);
+        const float32x4_t c2 = vld1q_f32(&m1.values[8]);
+        const float32x4_t c3 = vld1q_f32(&m1.values[12]);
+        for (int c = 0; c < 4; c++) {
+            const float* col = &m2.values[c * 4];
+            float32x4_t r = vmulq_n_f32(c0, col[0]);
+            r = vmlaq_n_f32(r, c1, col[1]);
+            r = vmlaq_n_f32(r, c2, col[2]);
+            r = vmlaq_n_f32(r, c3, col[3]);
+            vst1q_f32(&res.values[c * 4], r);
+        }
+        return res;
+#endif
+    }
+
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float v = 0.f;
+            for (int k = 0; k < 4; k++) {
+                v += m1.values[k * 4 + r] * m2.values[c * 4 + k];
+            }
+            res.values[c * 4 + r] = v;
+        }
+    }
+    return res;
+}
+
+constexpr vec4 operator*(const mat4& m, const vec4& v) {
+    if (!std::is_constant_evaluated()) {
+#if defined(SGCT_MATH_USE_SSE)
+        __m128 r = _mm_mul_ps(_mm_loadu_ps(&m.values[0]), _mm_set1_ps(v.x));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m.values[4]), _mm_set1_ps(v.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m.values[8]), _mm_set1_ps(v.z)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m.values[12]), _mm_set1_ps(v.w)));
+        vec4 res;
+        _mm_storeu_ps(&res.x, r);
+        return res;
+#elif defined(SGCT_MATH_USE_NEON)
+        float32x4_t r = vmulq_n_f32(vld1q_f32(&m.values[0]), v.x);
+        r = vmlaq_n_f32(r, vld1q_f32(&m.values[4]), v.y);
+        r = vmlaq_n_f32(r, vld1q_f32(&m.values[8]), v.z);
+        r = vmlaq_n_f32(r, vld1q_f32(&m.values[12]), v.w);
+        vec4 res;
+        vst1q_f32(&res.x, r);
+        return res;
+#endif
+    }
+
+    const std::array<float, 16>& a = m.values;
+    return vec4(
+        a[0] * v.x + a[4] * v.y + a[8] * v.z + a[12] * v.w,
+        a[1] * v.x + a[5] * v.y + a[9] * v.z + a[13] * v.w,
+        a[2] * v.x + a[6] * v.y + a[10] * v.z + a[14] * v.w,
+        a[3] * v.x + a[7] * v.y + a[11] * v.z + a[15] * v.w
+    );
+}
+
+constexpr vec3 operator*(const quat& q, const vec3& v) {
+    // v + 2 * (w * (q x v) + q x (q x v)) with the vector part q of the quaternion
+    const vec3 uv = vec3(
+        q.y * v.z - q.z * v.y,
+        q.z * v.x - q.x * v.z,
+        q.x * v.y - q.y * v.x
+    );
+    const vec3 uuv = vec3(
+        q.y * uv.z - q.z * uv.y,
+        q.z * uv.x - q.x * uv.z,
+        q.x * uv.y - q.y * uv.x
+    );
+    return vec3(
+        v.x + 2.f * (uv.x * q.w + uuv.x),
+        v.y + 2.f * (uv.y * q.w + uuv.y),
+        v.z + 2.f * (uv.z * q.w + uuv.z)
+    );
+}
+
+/**
+ * Computes the inverse of the matrix \p m through its cofactors. The result is not
+ * defined if the matrix is singular.
+ */
+constexpr mat4 inverse(const mat4& m) {
+    const std::array<float, 16>& a = m.values;
+    mat4 res;
+    std::array<float, 16>& inv = res.values;
+
+    inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] +
+             a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] -
+             a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] +
+             a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] -
+              a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] -
+             a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] +
+             a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] -
+             a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] +
+              a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] +
+             a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] -
+             a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] +
+              a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] -
+              a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] -
+             a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] +
+             a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] -
+              a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] +
+              a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    const float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+    const float invDet = 1.f / det;
+    for (float& v : inv) {
+        v *= invDet;
+    }
+    return res;
+}
+
+/**
+ * Multiplies the matrix \p m with each of the matrices in \p in and stores the products
+ * in \p out, which has to be at least as large as \p in. This is used to apply the same
+ * transformation to the matrices of many viewports or tracked devices at once.
+ */
+constexpr void transform(const mat4& m, std::span<const mat4> in, std::span<mat4> out) {
+    for (size_t i = 0; i < in.size(); i++) {
+        out[i] = m * in[i];
+    }
+}
+
+/**
+ * Multiplies the matrix \p m with each of the vectors in \p in and stores the results
+ * in \p out, which has to be at least as large as \p in.
+ */
+constexpr void transform(const mat4& m, std::span<const vec4> in, std::span<vec4> out) {
+    for (size_t i = 0; i < in.size(); i++) {
+        out[i] = m * in[i];
+    }
+}
 
 } // namespace sgct
 
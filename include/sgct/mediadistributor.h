@@ -0,0 +1,180 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__MEDIADISTRIBUTOR__H__
+#define __SGCT__MEDIADISTRIBUTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/image.h>
+#include <sgct/jobsystem.h>
+#include <sgct/shareddata.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Distributes image files from the master to all nodes of the cluster so that every
+ * node shows them in the same frame. The master reads a file in chunks on a sender
+ * thread and sends every chunk to all data transfer connections as soon as it has been
+ * read, so reading the file and sending it overlap. Every node decodes the file on the
+ * job system once it has been received completely and reports the result to the master.
+ * When all nodes have decoded a medium, the master marks it as ready through a shared
+ * object, which reaches all nodes with the same frame, so that a medium is ready on all
+ * nodes at once. The media are identified by consecutive ids and become ready in the
+ * order in which they were distributed.
+ *
+ * The decoded images are kept until they are released, so the application uploads them
+ * on the render thread whenever #status reports them as decoded, and switches to them
+ * once #isReady returns `true`, which happens in the same frame on all nodes.
+ */
+class SGCT_EXPORT MediaDistributor {
+public:
+    /**
+     * The package id of the chunked data transfers that contain the media and of the
+     * reports of the clients. These transfers are not passed to the data transfer
+     * callbacks of the application.
+     */
+    static constexpr int PackageId = std::numeric_limits<int>::min() + 1;
+
+    enum class Status {
+        /// The file is still being read or transferred to this node
+        Transferring,
+        /// The file has been received and is being decoded on this node
+        Decoding,
+        /// The image has been decoded on this node and can be retrieved with #image
+        Decoded,
+        /// The file could not be read, transferred, or decoded on this node
+        Failed
+    };
+
+    /**
+     * \param sharedObjectId The id of the shared object through which the master
+     *        announces the media that are ready on all nodes
+     * \param jobSystem The job system on which the media are decoded, which has to
+     *        outlive this distributor
+     */
+    MediaDistributor(uint32_t sharedObjectId, JobSystem& jobSystem);
+
+    /**
+     * Stops sending the remaining media and waits for the decoding jobs to finish.
+     */
+    ~MediaDistributor();
+
+    /**
+     * Queues the file at the \p path to be sent to all nodes. This function may only be
+     * called on the master.
+     *
+     * \return The id of the medium, which is one larger than that of the previous one
+     */
+    int distribute(std::filesystem::path path);
+
+    /**
+     * \return `true` if the medium with the \p id has been decoded, or has failed to be
+     *         decoded, on all nodes. This changes in the same frame on all nodes
+     */
+    bool isReady(int id) const;
+
+    /**
+     * \return The number of media that are ready on all nodes, which are the media with
+     *         the ids below this number
+     */
+    int nReady() const;
+
+    /**
+     * \return The status of the medium with the \p id on this node
+     */
+    Status status(int id) const;
+
+    /**
+     * \return The decoded image of the medium with the \p id if its status is
+     *         Status::Decoded, or `nullptr` otherwise. The image stays valid until the
+     *         medium is released
+     */
+    const Image* image(int id) const;
+
+    /**
+     * Releases the decoded image of the medium with the \p id, for example after it has
+     * been uploaded into a texture. The status of the medium does not change.
+     */
+    void release(int id);
+
+    /**
+     * Handles one chunk of a medium that is received by a client. The parameters are the
+     * same as for the data transfer chunk callback. This function is called internally
+     * by SGCT and shouldn't be used by the user.
+     */
+    void receive(const void* data, int length, uint64_t offset, uint64_t total);
+
+    /**
+     * Handles the report of the client with the \p clientIndex that it has decoded a
+     * medium, which is received by the master. This function is called internally by
+     * SGCT and shouldn't be used by the user.
+     */
+    void receiveReport(const void* data, int length, int clientIndex);
+
+    /**
+     * Marks the media that have been decoded on all nodes as ready. This function is
+     * called internally by SGCT on the master before the pre sync callback and shouldn't
+     * be used by the user.
+     */
+    void update();
+
+private:
+    MediaDistributor(const MediaDistributor&) = delete;
+    MediaDistributor(MediaDistributor&&) = delete;
+    MediaDistributor& operator=(const MediaDistributor&) = delete;
+    MediaDistributor& operator=(MediaDistributor&&) = delete;
+
+    struct Medium {
+        Status status = Status::Transferring;
+        std::unique_ptr<Image> image;
+        // The number of nodes, including the master, that have not reported the result
+        // of decoding this medium yet. Only used on the master
+        int nPending = 0;
+    };
+
+    /// The state of the medium that is being received by a client
+    struct Incoming {
+        std::vector<unsigned char> buffer;
+        uint64_t received = 0;
+    };
+
+    void work();
+    void sendFile(int id, const std::filesystem::path& path);
+    void decode(int id, std::vector<unsigned char> buffer, size_t offset);
+    // Returns the medium with the id and creates it if it does not exist yet. The
+    // _mutex has to be locked
+    Medium& medium(int id);
+    void finish(int id, bool success, int clientIndex);
+
+    JobSystem& _jobSystem;
+    SharedObject<int32_t> _ready;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<Medium> _media;
+    std::deque<std::pair<int, std::filesystem::path>> _queue;
+    std::vector<JobSystem::Job> _jobs;
+    bool _isRunning = true;
+    std::thread _sender;
+
+    // Only used by the network thread of the connection to the master
+    Incoming _incoming;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__MEDIADISTRIBUTOR__H__
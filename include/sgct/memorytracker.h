@@ -0,0 +1,132 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__MEMORYTRACKER__H__
+#define __SGCT__MEMORYTRACKER__H__
+
+#include <sgct/sgctexports.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sgct {
+
+/**
+ * Keeps track of the memory that the subsystems of SGCT occupy, independent of the
+ * `SGCT_MEMORY_PROFILING` option, which is only available with Tracy. Instead of every
+ * single allocation, the subsystems report the size of the buffers that they keep, which
+ * only changes rarely, through a MemoryAccount. The video memory of the textures and
+ * buffers is estimated from their size and format, as OpenGL does not report it.
+ */
+class SGCT_EXPORT MemoryTracker {
+public:
+    enum class Category {
+        /// The buffers of the network connections
+        NetworkBuffers = 0,
+        /// The blocks that are encoded and decoded by SharedData
+        SharedData,
+        /// The pixels of Image%s that own their buffer
+        Images,
+        /// The vertex and index buffers and warp maps of the correction meshes
+        CorrectionMeshes,
+        /// The glyph textures of the fonts
+        Fonts,
+        /// The textures and render buffers that the windows are rendered into
+        Framebuffers,
+        /// The cube maps and textures of the non-linear projections
+        CubeMaps
+    };
+    static constexpr int NumberOfCategories = 7;
+
+    struct Usage {
+        /// The number of bytes that are currently in use
+        uint64_t bytes = 0;
+        /// The largest number of bytes that have been in use at the same time
+        uint64_t peakBytes = 0;
+        /// How often the memory of this category has grown or shrunk
+        uint64_t nAllocations = 0;
+        uint64_t nDeallocations = 0;
+    };
+
+    /**
+     * Adds \p bytes to the memory that is in use by the \p category. This function can
+     * be called from any thread and does not allocate any memory.
+     */
+    static void allocate(Category category, size_t bytes);
+
+    /**
+     * Removes \p bytes from the memory that is in use by the \p category. This function
+     * can be called from any thread and does not allocate any memory.
+     */
+    static void deallocate(Category category, size_t bytes);
+
+    static Usage usage(Category category);
+
+    /**
+     * \return A short name of the \p category that can be used as an identifier
+     */
+    static std::string_view name(Category category);
+
+    /**
+     * \return `true` if the memory of the \p category is an estimate of video memory
+     */
+    static bool isVideoMemory(Category category);
+
+    /**
+     * \return The estimated size of a texel with the \p internalFormat in bytes, which
+     *         is 4 for the formats that are not explicitly known
+     */
+    static size_t bytesPerTexel(unsigned int internalFormat);
+
+    /**
+     * \return A table of the memory that is in use by all categories, which is meant to
+     *         be logged
+     */
+    static std::string report();
+};
+
+/**
+ * The memory that a single object reports for one MemoryTracker::Category. The object
+ * sets the size of its buffers whenever they change, and the size is removed from the
+ * category when the account is destroyed, so that owners do not have to undo the
+ * accounting in all of the ways in which they can release their buffers.
+ */
+class SGCT_EXPORT MemoryAccount {
+public:
+    explicit MemoryAccount(MemoryTracker::Category category);
+    MemoryAccount(MemoryAccount&& rhs) noexcept;
+    MemoryAccount& operator=(MemoryAccount&& rhs) noexcept;
+    ~MemoryAccount();
+
+    /**
+     * Sets the number of \p bytes that the owner of this account currently occupies.
+     * This function can be called from any thread.
+     */
+    void set(size_t bytes);
+
+    /**
+     * Adds \p bytes to the memory that the owner of this account currently occupies.
+     * This function can be called from any thread.
+     */
+    void add(size_t bytes);
+
+    size_t bytes() const;
+
+private:
+    MemoryAccount(const MemoryAccount&) = delete;
+    MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+    MemoryTracker::Category _category;
+    std::atomic<size_t> _bytes = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__MEMORYTRACKER__H__
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__METRICSEXPORTER__H__
+#define __SGCT__METRICSEXPORTER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/engine.h>
+#include <sgct/network.h>
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Serves the performance metrics of this node in the Prometheus text format over HTTP,
+ * so that a monitoring system can collect them while the application is running. A
+ * background thread answers the requests and regularly moves the values that have been
+ * added to the Engine::Statistics since its last visit into cumulative histograms, so
+ * the rendering threads only add their values to the statistics as they always do. The
+ * only exception is the available video memory, which has to be queried on a thread
+ * with an OpenGL context in #updateGpuMemory.
+ */
+class SGCT_EXPORT MetricsExporter {
+public:
+    /**
+     * Starts serving the metrics of the \p statistics and of the network connections,
+     * windows, and screenshot collection of this node on the TCP \p port. If the port
+     * cannot be opened, an error is logged and no metrics are served.
+     *
+     * \pre The OpenGL context has to be current, as this checks how the available video
+     *      memory can be queried
+     */
+    MetricsExporter(const Engine::Statistics& statistics, int port);
+    ~MetricsExporter();
+
+    /**
+     * Queries the video memory that is available, if the driver supports this, at most
+     * once per second. This must be called on a thread with a current OpenGL context and
+     * does not allocate any memory.
+     */
+    void updateGpuMemory();
+
+private:
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter(MetricsExporter&&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(MetricsExporter&&) = delete;
+
+    void work();
+    void collect();
+    void answer(SGCT_SOCKET client) const;
+    std::string metrics() const;
+
+    // The upper bounds of the histogram buckets in seconds, without the infinite one
+    static constexpr std::array<double, 11> Buckets = {
+        0.001, 0.002, 0.004, 0.008, 1.0 / 90.0, 1.0 / 60.0, 1.0 / 30.0, 0.05, 0.1, 0.25,
+        1.0
+    };
+
+    // A cumulative histogram of all values that were added to one statistic
+    struct Histogram {
+        const StatisticsHistory* history = nullptr;
+        std::string name;
+        std::string help;
+        // The number of values of the history that have been counted so far
+        uint64_t count = 0;
+        std::array<uint64_t, Buckets.size() + 1> buckets = {};
+        uint64_t total = 0;
+        double sum = 0.0;
+    };
+    std::vector<Histogram> _histograms;
+    // Reused for copying the values of the histories
+    std::vector<double> _values;
+
+    const int _nodeId;
+    SGCT_SOCKET _socket;
+    std::atomic_bool _isRunning = false;
+    std::thread _thread;
+
+    enum class GpuMemorySource { None, Nvidia, Amd };
+    GpuMemorySource _gpuMemorySource = GpuMemorySource::None;
+    double _lastGpuMemoryQuery = 0.0;
+    // In kilobytes, as reported by the driver
+    std::atomic_int _gpuMemoryTotal = 0;
+    std::atomic_int _gpuMemoryAvailable = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__METRICSEXPORTER__H__
@@ -0,0 +1,120 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__MULTICAST__H__
+#define __SGCT__MULTICAST__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Broadcasts the shared data block from the master to all clients using UDP multicast so
+ * that the block only has to be sent once per frame, regardless of the number of nodes.
+ * Each block is split into datagrams that are tagged with a sequence number. The master
+ * keeps the most recent blocks around so that fragments that a client reports as missing
+ * through a NACK on its TCP sync connection can be sent again.
+ */
+class SGCT_EXPORT Multicast {
+public:
+    /// The number of blocks that the master keeps around for retransmissions
+    static constexpr int HistoryLength = 8;
+
+    /**
+     * \param group The IPv4 multicast group address that is used for the broadcast
+     * \param port The UDP port to which the datagrams are sent
+     * \param isServer Whether this is the sending side of the broadcast
+     */
+    Multicast(const std::string& group, int port, bool isServer);
+    ~Multicast();
+
+    /**
+     * Sends the \p data block to all clients that have joined the multicast group.
+     *
+     * \param data The data that should be broadcast
+     * \param length The number of bytes in \p data
+     * \return The sequence number under which the block was sent
+     */
+    uint32_t send(const char* data, uint32_t length);
+
+    /**
+     * Sends the requested fragments of the block with the provided \p sequence number
+     * again. If \p fragments is empty, all fragments of the block are sent. Requests for
+     * blocks that are no longer part of the history are ignored.
+     */
+    void retransmit(uint32_t sequence, const std::vector<uint16_t>& fragments);
+
+    /**
+     * Waits a short time for the block with the provided \p sequence number to be
+     * received completely. If the block is complete, it is moved into \p data and all
+     * older blocks are discarded. Otherwise \p missing contains the fragments that have
+     * not been received yet, which is empty if nothing of the block has arrived.
+     *
+     * \return `true` if the block was received completely, `false` otherwise
+     */
+    bool waitForBlock(uint32_t sequence, std::vector<char>& data,
+        std::vector<uint16_t>& missing);
+
+    /**
+     * Discards any block with a \p sequence number that is not newer than the provided
+     * one, for example after a block has been given up on.
+     */
+    void discard(uint32_t sequence);
+
+    /**
+     * Stops receiving datagrams and wakes up anyone waiting for a block.
+     */
+    void close();
+
+private:
+    Multicast(const Multicast&) = delete;
+    Multicast(Multicast&&) = delete;
+    Multicast& operator=(const Multicast&) = delete;
+    Multicast& operator=(Multicast&&) = delete;
+
+    struct Block {
+        std::vector<char> data;
+        std::vector<bool> received;
+        uint16_t nMissing = 0;
+    };
+
+    void sendFragment(uint32_t sequence, const std::vector<char>& block, uint16_t index);
+    void receiveHandler();
+
+    SGCT_SOCKET _socket;
+    const bool _isServer;
+    std::atomic_bool _shouldTerminate = false;
+    uint32_t _group = 0; // in network byte order
+    uint16_t _port = 0;
+
+    // Sending side: the most recently sent blocks by their sequence number
+    std::mutex _historyMutex;
+    uint32_t _nextSequence = 0;
+    std::map<uint32_t, std::vector<char>> _history;
+
+    // Receiving side: the blocks that are currently being reassembled
+    std::mutex _blockMutex;
+    std::condition_variable _blockCond;
+    std::map<uint32_t, Block> _blocks;
+    uint32_t _firstAccepted = 0; // datagrams of older blocks are ignored
+    std::unique_ptr<std::thread> _receiveThread;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__MULTICAST__H__
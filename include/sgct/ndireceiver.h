@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__NDIRECEIVER__H__
+#define __SGCT__NDIRECEIVER__H__
+
+#ifdef SGCT_HAS_NDI
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Processing.NDI.Lib.h>
+
+struct __GLsync;
+
+namespace sgct {
+
+/**
+ * Receives the video of an NDI source as an OpenGL texture. The frames are captured on a
+ * background thread, which copies them straight into pixel buffers that are mapped
+ * persistently, so the rendering thread only starts the upload of the latest frame from
+ * the buffer into the texture. Frames that arrive faster than they are rendered are
+ * dropped. The source does not have to exist when the receiver is created.
+ *
+ * The first row of the texture is the top of the image and the texture coordinates have
+ * to be flipped vertically when it is sampled.
+ */
+class SGCT_EXPORT NdiReceiver {
+public:
+    /**
+     * Creates the receiver for the source with the \p sourceName, which has the form
+     * `MACHINE (Source)`. Has to be called with the OpenGL context current that uses the
+     * texture.
+     */
+    explicit NdiReceiver(std::string sourceName);
+    ~NdiReceiver();
+
+    /**
+     * Starts the upload of the latest frame that has been received into the #texture.
+     * This has to be called once per frame with the OpenGL context current before the
+     * #texture is used. The upload goes into the texture that was not used in the
+     * previous frame, so it does not have to wait for the draw calls that still sample
+     * it.
+     *
+     * \return `true` if the #texture can be used until the next call
+     */
+    bool update();
+
+    /**
+     * \return The texture with the latest frame or 0 if no frame has been received yet
+     */
+    unsigned int texture() const;
+
+    /**
+     * \return The size of the latest frame in pixels
+     */
+    ivec2 size() const;
+
+private:
+    // The pixel buffers that the frames are received into
+    struct Slot {
+        enum class State {
+            /// Can be written by the receiving thread
+            Free,
+            /// Is being written by the receiving thread
+            Writing,
+            /// Holds a frame that has not been uploaded yet
+            Filled,
+            /// Is being read by the GPU until the fence is signaled
+            Uploading
+        };
+        State state = State::Free;
+        unsigned int pbo = 0;
+        // Only set if the buffer is mapped persistently, otherwise the frame is copied
+        // into the data and uploaded from there
+        std::byte* mapping = nullptr;
+        std::vector<std::byte> data;
+        size_t capacity = 0;
+
+        ivec2 size = ivec2(0, 0);
+        int stride = 0;
+        uint64_t frame = 0;
+        __GLsync* fence = nullptr;
+    };
+
+    NdiReceiver(const NdiReceiver&) = delete;
+    NdiReceiver& operator=(const NdiReceiver&) = delete;
+
+    void receive();
+    void allocate(Slot& slot, size_t capacity);
+
+    const std::string _sourceName;
+    NDIlib_recv_instance_t _receiver = nullptr;
+    // Whether the frames are written into persistently mapped pixel buffers, which
+    // requires OpenGL 4.4
+    bool _isPersistent = false;
+
+    std::atomic_bool _isRunning = false;
+    std::thread _thread;
+
+    // Protects the states of the slots and the required capacity
+    std::mutex _mutex;
+    std::array<Slot, 3> _slots;
+    // Set by the receiving thread if a frame did not fit into the pixel buffers
+    size_t _requiredCapacity = 0;
+    uint64_t _frameCounter = 0;
+
+    std::array<unsigned int, 2> _textures = { 0, 0 };
+    std::array<ivec2, 2> _textureSizes = { ivec2(0, 0), ivec2(0, 0) };
+    // The texture that holds the latest frame or -1 if no frame has been uploaded yet
+    int _current = -1;
+};
+
+} // namespace sgct
+
+#endif // SGCT_HAS_NDI
+#endif // __SGCT__NDIRECEIVER__H__
@@ -10,12 +10,21 @@
 #define __SGCT__NETWORK__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/bufferpolicy.h>
+#include <sgct/memorytracker.h>
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <initializer_list>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -27,22 +36,102 @@ using SGCT_SOCKET = int;
 
 namespace sgct {
 
+class Multicast;
+class SharedMemory;
+
 /**
  * Network manages peer-to-peer tcp connections.
  */
 class SGCT_EXPORT Network {
 public:
-    // ASCII device control chars = 17, 18, 19 & 20
+    // ASCII device control chars = 17, 18, 19 & 20, negative acknowledge = 21,
+    // synchronous idle = 22, end of transmission block = 23, cancel = 24, end of
+    // medium = 25, substitute = 26, escape = 27, file separator = 28, and group
+    // separator = 29
     static constexpr char DefaultId = 0;
     static constexpr char Ack = 6;
     static constexpr char DataId = 17;
     static constexpr char ConnectedId = 18;
     static constexpr char DisconnectId = 19;
+    static constexpr char DeltaDataId = 20;
+    static constexpr char NackId = 21;
+    static constexpr char MulticastDataId = 22;
+    static constexpr char ChunkId = 23;
+    static constexpr char ChunkAckId = 24;
+    static constexpr char TimeRequestId = 25;
+    static constexpr char TimeResponseId = 26;
+    static constexpr char SharedMemoryDataId = 27;
+    static constexpr char StatisticsId = 28;
+    static constexpr char ReadyId = 29;
 
     enum class ConnectionType { SyncConnection, DataTransfer };
 
     static constexpr size_t HeaderSize = 13;
 
+    /**
+     * The compact statistics of one frame of a client, which are sent to the master
+     * together with the acknowledgement of a frame so that the master can show the
+     * statistics of the entire cluster. All times are in seconds.
+     */
+    struct NodeStatistics {
+        /// The time between the beginning of the previous and the current frame
+        float frameTime = 0.f;
+
+        /// The time the CPU spent drawing and compositing the windows
+        float drawTime = 0.f;
+
+        /// The time the client spent waiting for the shared data of the master
+        float syncWait = 0.f;
+
+        /// The time the GPU spent drawing and compositing the windows
+        float gpuTime = 0.f;
+
+        /// The total number of frames that the client skipped because the master did
+        /// not wait for it at the sync deadline
+        uint32_t droppedFrames = 0;
+
+        /// The frame counter of the client's swap group after its previous buffer swap,
+        /// which is 0 if the client does not use a swap barrier
+        uint32_t swapGroupFrame = 0;
+
+        /// The total number of buffer swaps that the client missed in its swap group
+        uint32_t missedSwaps = 0;
+
+        /// The number of lockstep simulation steps after which the client computed
+        /// #simulationHash, or 0 if it has not computed a hash yet
+        uint64_t simulationStep = 0;
+
+        /// The hash of the client's simulation state after #simulationStep steps
+        uint64_t simulationHash = 0;
+    };
+
+    /**
+     * The durations of the phases of the startup of a node, which a client sends to the
+     * master once it is ready to render its first frame, so that the master can wait for
+     * the entire cluster and report where the startup time is spent. All times are in
+     * seconds.
+     */
+    struct StartupTimes {
+        /// The time from the start of the node until it was ready to render
+        float total = 0.f;
+
+        /// The time spent creating the windows
+        float windows = 0.f;
+
+        /// The time spent in the OpenGL initialization callback of the application
+        float application = 0.f;
+
+        /// The time spent creating the buffers and compiling the shaders of the windows
+        float shaders = 0.f;
+
+        /// The time spent waiting for all nodes of the cluster to connect
+        float connection = 0.f;
+
+        /// The time spent waiting for the correction meshes and images of the viewports
+        /// to be loaded and uploading them
+        float viewportData = 0.f;
+    };
+
     /**
      * \return The last error code
      */
@@ -58,6 +147,13 @@ public:
     ~Network();
 
     void initialize();
+
+    /**
+     * Prepares this connection to be driven by a NetworkReactor instead of its own
+     * threads. This function is used instead of #initialize.
+     */
+    void initializeEventDriven();
+
     void closeNetwork(bool forced);
     void initShutdown();
 
@@ -66,6 +162,41 @@ public:
     void setUpdateFunction(std::function<void(Network&)> fn);
     void setConnectedFunction(std::function<void (void)> fn);
     void setAcknowledgeFunction(std::function<void(int, int)> fn);
+    void setNackFunction(std::function<void(uint32_t, std::vector<uint16_t>)> fn);
+
+    /**
+     * Sets the function that is called for every chunk of a chunked data transfer that
+     * is received. The parameters are the chunk data, the length of the chunk, the byte
+     * offset of the chunk in the package, the total size of the package, the package id,
+     * and the id of this connection.
+     */
+    void setChunkDecodeFunction(
+        std::function<void(void*, int, uint64_t, uint64_t, int, int)> fn);
+
+    /**
+     * Sets the function that is called when the remote side has acknowledged a chunk of
+     * a chunked data transfer. The parameters are the package id, the id of this
+     * connection, the number of bytes that have been received so far, and the total
+     * size of the package.
+     */
+    void setChunkAcknowledgeFunction(
+        std::function<void(int, int, uint64_t, uint64_t)> fn);
+
+    /**
+     * Sets the multicast receiver from which a client retrieves the shared data blocks
+     * that are announced by #MulticastDataId messages on this connection. The
+     * \p multicast object has to outlive this connection.
+     */
+    void setMulticast(Multicast* multicast);
+
+    /**
+     * Passes the shared data blocks of this sync connection through the shared memory
+     * segment with the provided \p name instead of the socket if both sides of the
+     * connection run on the same computer. The server creates the segment immediately,
+     * whereas the client opens it once the first block has been announced by a
+     * #SharedMemoryDataId message.
+     */
+    void useSharedMemory(std::string name);
 
     void setConnectedStatus(bool state);
     void closeSocket(SGCT_SOCKET lSocket);
@@ -84,27 +215,260 @@ public:
      */
     double loopTime() const;
 
+    /**
+     * Get the time in seconds it took to send the last sync data to this connection.
+     */
+    double sendTime() const;
+    void setSendTime(double time);
+
+    /// The amount of data that was transferred on a connection since it was created
+    struct Traffic {
+        uint64_t bytesSent = 0;
+        uint64_t messagesSent = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t messagesReceived = 0;
+    };
+
+    /**
+     * \return The number of bytes and messages that were sent and received on this
+     *         connection. A single write that contains multiple messages, such as the
+     *         acknowledgement of a client, counts as one message. This can be called
+     *         from any thread
+     */
+    Traffic traffic() const;
+
+    /// The data transfer packages that were sent on a connection and their
+    /// acknowledgements
+    struct TransferStatistics {
+        /// The packages that have been sent but not acknowledged yet
+        uint32_t packagesInFlight = 0;
+        /// The bytes of the packages that have not been acknowledged yet
+        uint64_t bytesInFlight = 0;
+        /// The packages that the remote side has acknowledged since the connection was
+        /// established
+        uint64_t packagesAcknowledged = 0;
+        /// The smoothed rate in bytes per second at which packages are acknowledged
+        double throughput = 0.0;
+        /// The smoothed time in seconds between sending a package and receiving its
+        /// acknowledgement
+        double latency = 0.0;
+    };
+
+    /**
+     * \return The statistics of the packages that were sent with #sendPackage on this
+     *         data transfer connection. This can be called from any thread
+     */
+    TransferStatistics transferStatistics() const;
+
+    /**
+     * Sends a clock synchronization request to the remote side if the last one was sent
+     * long enough ago. The remote side replies with the times at which it received the
+     * request and sent the reply, which is used to estimate the offset between the two
+     * clocks and the network latency in the same way as NTP does. On a client sync
+     * connection, the request is not sent immediately but together with the next
+     * acknowledgement in #pushClientMessage.
+     */
+    void updateClock();
+
+    /**
+     * \return The estimated offset in seconds that has to be added to the local time to
+     *         get the time of the remote side of this connection
+     */
+    double clockOffset() const;
+
+    /**
+     * \return The estimated one-way network latency to the remote side in seconds
+     */
+    double latency() const;
+
+    /**
+     * \return The jitter of the clock offset measurements in seconds
+     */
+    double jitter() const;
+
+    /**
+     * Sets whether the master always waits for the client of this connection, even after
+     * the sync deadline has passed. Connections are critical by default.
+     */
+    void setCritical(bool isCritical);
+    bool isCritical() const;
+
     /**
      * This function compares the received frame number with the sent frame number. The
      * server starts by sending a frame sync number to the client. The client receives the
      * sync frame number and sends it back after drawing when ready for buffer swap. When
      * the server gets a frame sync number equal to the sent number it swaps buffers.
      *
+     * A client that reconnects to the server counts as updated until it has acknowledged
+     * its first frame, so that the other nodes do not have to wait while it restarts. It
+     * joins the frame lock with the frame that it acknowledges first.
+     *
      * \return `true` if updates has been received
      */
     bool isUpdated() const;
+
+    /**
+     * \return `true` if the client of this connection has reconnected to the server and
+     *         has not acknowledged a frame yet
+     */
+    bool isJoining() const;
     void sendData(const void* data, int length) const;
 
+    /**
+     * Sends the \p header of #HeaderSize bytes followed by the \p data as one message
+     * using a scatter-gather send, so that the two do not have to be copied into a
+     * contiguous buffer first.
+     *
+     * \param header The #HeaderSize bytes of the message header
+     * \param data The payload that follows the header
+     * \param length The length of the \p data in bytes, excluding the header
+     */
+    void sendData(const void* header, const void* data, int length) const;
+
+    /**
+     * Sends a data transfer package as a #DataId message with the \p header followed by
+     * the \p data in the same way as #sendData. If the transfer window of the cluster
+     * already holds as many unacknowledged packages as allowed, this function waits
+     * until the remote side has acknowledged the oldest one. The remote side acknowledges
+     * all packages that have arrived up to that point at once, and the acknowledge
+     * function is called for each of the packages in the order in which they were sent.
+     *
+     * \param header The #HeaderSize bytes of the message header with the package id
+     * \param data The payload that follows the header
+     * \param length The length of the \p data in bytes, excluding the header
+     */
+    void sendPackage(const void* header, const void* data, int length) const;
+
+    /**
+     * Sends a block of shared data as a #DeltaDataId message. Instead of the full block,
+     * only the difference to the block that was previously sent on this connection is
+     * transmitted, XOR-coded and run-length encoded. A full keyframe is sent instead if
+     * no previous block of the same size exists, if \p keyframeInterval frames have
+     * passed since the last keyframe, or if the encoded difference would not be smaller
+     * than the block itself.
+     *
+     * \param header The #HeaderSize bytes of the header with the frame number
+     * \param data The shared data block, excluding the header
+     * \param length The length of the \p data block, excluding the header
+     * \param keyframeInterval The maximum number of frames between two keyframes
+     */
+    void sendDeltaData(const unsigned char* header, const unsigned char* data, int length,
+        int keyframeInterval);
+
+    /**
+     * Announces the shared data block that has been broadcast using multicast with the
+     * provided \p sequence number as the current frame to the client.
+     */
+    void sendMulticastHeader(int frame, uint32_t sequence) const;
+
+    /**
+     * Writes the shared data block of the provided \p frame into the shared memory
+     * segment of this connection and announces it to the client with a
+     * #SharedMemoryDataId message.
+     *
+     * \return `false` if this connection does not use shared memory or the block does
+     *         not fit into the segment, in which case it has to be sent on the socket
+     */
+    bool sendSharedMemoryData(int frame, const void* data, uint32_t length);
+
+    /**
+     * Sends one chunk of a chunked data transfer as a #ChunkId message. The remote side
+     * acknowledges every chunk with a #ChunkAckId message, which updates the value
+     * returned by #acknowledgedChunkBytes.
+     *
+     * \param packageId The id of the package to which the chunk belongs
+     * \param offset The byte offset of the chunk in the package
+     * \param totalSize The total size of the package in bytes
+     * \param data The chunk data
+     * \param length The length of the chunk in bytes
+     */
+    void sendChunk(int packageId, uint64_t offset, uint64_t totalSize, const void* data,
+        int length) const;
+
+    /**
+     * \return The number of bytes of the package with the id \p packageId that the
+     *         remote side has acknowledged without gaps, or 0 if the last acknowledged
+     *         chunk belonged to a different package
+     */
+    uint64_t acknowledgedChunkBytes(int packageId) const;
+
+    /**
+     * Sizes the send buffer of the socket so that it holds about as much data as the
+     * connection delivers in a round trip. A larger buffer would not make the transfers
+     * faster but queue them up in front of the other traffic on the same interface. The
+     * buffer is only resized if the size changes noticeably.
+     *
+     * \param bytesPerSecond The bandwidth of the data transfers on this connection
+     * \param roundTripTime The round trip time to the remote side in seconds
+     */
+    void tuneSendBuffer(double bytesPerSecond, double roundTripTime) const;
+
+    /**
+     * Runs the \p job on the sender thread of this connection, which is started the first
+     * time this function is called. Jobs are run in the order in which they are added.
+     * Exceptions thrown by the \p job are logged and not propagated to the caller.
+     */
+    void sendAsync(std::function<void()> job);
+
     /**
      * Iterates the send frame number and returns the new frame number.
      */
     int iterateFrameCounter();
 
     /**
-     * The client sends ack message to server + console messages.
+     * The client sends the acknowledgement of the current frame to the server, together
+     * with all messages that have been queued for this frame, as a single write so that
+     * the messages of one frame end up in as few packets as possible. The write consists
+     * of the following messages, each of which has the regular #HeaderSize header:
+     *   1. A #DataId message with the frame number, whose payload is the text of all
+     *      messages added with #queueMessage since the previous frame, separated by
+     *      newlines. Without queued messages, the payload is empty
+     *   2. A #TimeRequestId message if #updateClock has requested a new measurement
+     *   3. A #StatisticsId message with the NodeStatistics that were provided with
+     *      #queueStatistics since the previous frame
      */
     void pushClientMessage();
 
+    /**
+     * Adds the text \p message to the payload of the next acknowledgement that is sent
+     * by #pushClientMessage. The server passes the payload to its decode function.
+     */
+    void queueMessage(std::string_view message);
+
+    /**
+     * Sends the \p statistics of this client together with the next acknowledgement
+     * that is sent by #pushClientMessage, replacing statistics that have been queued
+     * before. The NodeStatistics::droppedFrames are filled in by this connection.
+     */
+    void queueStatistics(const NodeStatistics& statistics);
+
+    /**
+     * \return The statistics that the client of this server connection sent with its
+     *         most recent acknowledgement, or nothing if it has not sent any
+     */
+    std::optional<NodeStatistics> nodeStatistics() const;
+
+    /**
+     * Sends the startup \p times of this client to the server, which signals that the
+     * client has finished its initialization and is ready to render its first frame.
+     */
+    void sendReady(const StartupTimes& times);
+
+    /**
+     * \return The startup times that the client of this server connection sent once it
+     *         was ready, or nothing if it is not ready yet. A client that reconnects is
+     *         not ready until it sends its startup times again
+     */
+    std::optional<StartupTimes> startupTimes() const;
+
+    /**
+     * With pipelined sync, a client does not read the next sync message from the master
+     * until the data of the previous message has been used for rendering, which is
+     * signalled by calling this function at the beginning of each frame. Without
+     * pipelined sync, this function does nothing.
+     */
+    void releaseSyncData();
+
     /**
      * \return The port of this connection
      */
@@ -112,6 +476,21 @@ public:
 
     std::condition_variable& startConnectionConditionVar();
 
+    /**
+     * \return The socket on which a NetworkReactor has to wait for incoming data for this
+     *         connection. While a server is waiting for a client to connect, this is the
+     *         listening socket
+     */
+    SGCT_SOCKET pollSocket() const;
+
+    /**
+     * Called by a NetworkReactor when the #pollSocket has incoming data. This either
+     * accepts a waiting client or receives and handles the next message.
+     *
+     * \return `false` if the connection is finished and no longer has to be polled
+     */
+    bool handleReadable();
+
 private:
     Network(const Network&) = delete;
     Network(Network&&) = delete;
@@ -119,17 +498,49 @@ private:
     Network& operator=(Network&&) = delete;
 
     void setRecvFrame(int i);
-    void updateBuffer(std::vector<char>& buffer, uint32_t reqSize, uint32_t& currSize);
+    // The buffers that every received message is written into, which grow to the size
+    // of the largest message
+    using ReceiveBuffer =
+        std::vector<char, BufferAllocator<char, BufferPolicy::Subsystem::Network>>;
+
+    void updateBuffer(ReceiveBuffer& buffer, uint32_t reqSize, uint32_t& currSize);
+    // Reports the capacity of the buffers that are used by the receiving thread
+    void updateReceiveMemory();
+
+    // Sends all `buffers` in order as one message using a scatter-gather send
+    void sendBuffers(std::initializer_list<std::pair<const char*, long>> buffers) const;
+    void handleChunk(int32_t packageId, uint32_t dataSize);
+    void handleChunkAck(int32_t packageId, uint32_t dataSize);
+    // Acknowledges the packages that have been received so far, unless more of them are
+    // waiting on the socket and the acknowledgement can cover them as well
+    void acknowledgePackage(int32_t packageId);
+    void handleAck(const char* header);
+    void handleTimeRequest(uint32_t dataSize);
+    void handleTimeResponse(uint32_t dataSize);
+    void holdSyncData();
     int readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSize,
         uint32_t& uncompressedDataSize);
     int readDataTransferMessage(char* header, int32_t& packageId, uint32_t& dataSize,
         uint32_t& uncompressedDataSize);
     int readExternalMessage();
+    void decompressMessage(uint32_t dataSize, uint32_t uncompressedDataSize);
+    void decodeDeltaMessage(uint32_t dataSize, uint32_t uncompressedDataSize);
+    void receiveMulticastBlock(uint32_t sequence);
+    void receiveSharedMemoryBlock(int32_t frame, uint32_t size);
+    void sendHandler();
 
     /// function to decode messages
     void communicationHandler();
     void connectionHandler();
 
+    // Connects a client to its server, retrying until the server accepts the connection
+    // or the connection is closed, in which case `false` is returned
+    bool connectToServer();
+    bool acceptConnection();
+    void beginConnection();
+    bool receiveMessage();
+    void endConnection();
+
     SGCT_SOCKET _socket;
     SGCT_SOCKET _listenSocket;
 
@@ -137,35 +548,141 @@ private:
     std::atomic_bool _isServer;
     std::atomic_bool _isConnected = false;
     std::atomic_bool _isUpdated = false;
+    // Set while a reconnected client has not acknowledged a frame yet
+    std::atomic_bool _isJoining = false;
+    bool _hasConnected = false;
     std::atomic<int32_t> _currentSendFrame = 0;
     std::atomic<int32_t> _previousSendFrame = 0;
     std::atomic<int32_t> _currentRecvFrame = 0;
     std::atomic<int32_t> _previousRecvFrame = -1;
     std::atomic_bool _shouldTerminate = false; // set to true upon exit
+    bool _isReceiving = false; // a connection has been accepted in event-driven mode
 
     mutable std::mutex _connectionMutex;
+    mutable std::mutex _sendMutex;
+
+    // Counted by the threads that send and receive, read by the metrics exporter
+    mutable std::atomic_uint64_t _bytesSent = 0;
+    // The size of the send buffer last set by tuneSendBuffer
+    mutable std::atomic_int _tunedSendBufferSize = 0;
+    mutable std::atomic_uint64_t _messagesSent = 0;
+    std::atomic_uint64_t _bytesReceived = 0;
+    std::atomic_uint64_t _messagesReceived = 0;
     std::unique_ptr<std::thread> _commThread;
     std::unique_ptr<std::thread> _mainThread;
 
     double _timeStampSend = 0.0;
     std::atomic<double> _timeStampTotal = 0.0;
+    std::atomic<double> _sendTime = 0.0;
+
+    // The most recent clock measurements, of which the one with the lowest round-trip
+    // delay is used as it is the least affected by queueing in the network
+    struct ClockSample {
+        double offset = 0.0;
+        double delay = std::numeric_limits<double>::max();
+    };
+    std::array<ClockSample, 8> _clockSamples;
+    size_t _nextClockSample = 0;
+    double _lastClockRequest = -std::numeric_limits<double>::max();
+    std::atomic<double> _clockOffset = 0.0;
+    std::atomic<double> _latency = 0.0;
+    std::atomic<double> _jitter = 0.0;
+
+    // The text messages, the clock request, and the statistics that are sent with the
+    // next acknowledgement
+    std::mutex _pendingMutex;
+    std::string _pendingMessages;
+    bool _isClockRequestPending = false;
+    std::optional<NodeStatistics> _pendingStatistics;
+    // The number of frames that this client skipped to catch up with the master
+    uint32_t _droppedFrames = 0;
+
+    // The statistics that were last received from the client and its startup times
+    mutable std::mutex _statisticsMutex;
+    std::optional<NodeStatistics> _nodeStatistics;
+    std::optional<StartupTimes> _startupTimes;
+
+    bool _isCritical = true;
     int _id;
     uint32_t _bufferSize = 1024;
     uint32_t _uncompressedBufferSize = _bufferSize;
     std::atomic<uint32_t> _requestedSize = _bufferSize;
     const int _port = -1;
+    // The address of the server that a client connects to
+    const std::string _address;
 
-    std::vector<char> _recvBuffer;
-    std::vector<char> _uncompressBuffer;
+    ReceiveBuffer _recvBuffer;
+    ReceiveBuffer _uncompressBuffer;
+    std::array<char, HeaderSize> _recvHeader = {};
     char _headerId = 0;
 
+    // The last block sent as a delta reference and the buffer for the encoded difference
+    std::vector<char> _deltaReference;
+    std::vector<char> _deltaBuffer;
+    int _framesSinceKeyframe = 0;
+    std::atomic_bool _needsKeyframe = true;
+    uint32_t _deltaReferenceSize = 0;
+
+    Multicast* _multicast = nullptr;
+    std::vector<char> _multicastBuffer;
+
+    std::string _sharedMemoryName;
+    std::unique_ptr<SharedMemory> _sharedMemory;
+    std::vector<char> _sharedMemoryBuffer;
+
+    // The buffers that are used for receiving and for sending, respectively
+    MemoryAccount _receiveMemory = MemoryAccount(MemoryTracker::Category::NetworkBuffers);
+    MemoryAccount _sendMemory = MemoryAccount(MemoryTracker::Category::NetworkBuffers);
+
+    std::unique_ptr<std::thread> _sendThread;
+    std::mutex _sendQueueMutex;
+    std::condition_variable _sendQueueCond;
+    std::deque<std::function<void()>> _sendQueue;
+
     std::condition_variable _startConnectionCond;
 
+    // Set on a client with pipelined sync after a frame's data has been decoded and
+    // until the main thread is ready for the next frame's data
+    bool _isHoldingSyncData = false;
+    std::mutex _releaseMutex;
+    std::condition_variable _releaseCond;
+
     std::function<void(const char*, int)> decoderCallback;
     std::function<void(void*, int, int, int)> _packageDecoderCallback;
     std::function<void(Network&)> _updateCallback;
     std::function<void(void)> _connectedCallback;
     std::function<void(int, int)> _acknowledgeCallback;
+    std::function<void(void*, int, uint64_t, uint64_t, int, int)> _chunkDecoderCallback;
+    std::function<void(int, int, uint64_t, uint64_t)> _chunkAcknowledgeCallback;
+
+    // The package and end offset of the last chunk that the remote side acknowledged
+    std::atomic<int32_t> _chunkAckPackageId = -1;
+    std::atomic<uint64_t> _chunkAckBytes = 0;
+
+    // A data transfer package that has been sent but not acknowledged yet
+    struct PackageInFlight {
+        // The number of packages sent on this connection up to and including this one
+        uint32_t sequence = 0;
+        int32_t packageId = -1;
+        uint32_t size = 0;
+        double sendTime = 0.0;
+    };
+    // Held while a package is sent so that the packages are sent in the order in which
+    // they are added to the window
+    mutable std::mutex _packageMutex;
+    mutable std::mutex _windowMutex;
+    mutable std::condition_variable _windowCond;
+    mutable std::deque<PackageInFlight> _packagesInFlight;
+    mutable uint32_t _nSentPackages = 0;
+    mutable TransferStatistics _transferStatistics;
+    double _lastAckTime = 0.0;
+    // The package ids of an acknowledgement, reused by the receiving thread
+    std::vector<int32_t> _acknowledgedPackages;
+    // The packages received since the connection was established and the number of
+    // them that has not been acknowledged yet
+    uint32_t _nReceivedPackages = 0;
+    uint32_t _nUnacknowledgedPackages = 0;
+    std::function<void(uint32_t, std::vector<uint16_t>)> _nackCallback;
 };
 
 } // namespace sgct
@@ -14,6 +14,9 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -21,7 +24,11 @@
 
 namespace sgct {
 
+class LogForwarder;
+class Multicast;
 class Network;
+class NetworkReactor;
+class RdmaConnection;
 
 /**
  * The network manager manages all network connections for SGCT.
@@ -35,7 +42,9 @@ public:
     static void create(NetworkMode nm,
         std::function<void(void*, int, int, int)> dataTransferDecode,
         std::function<void(bool, int)> dataTransferStatus,
-        std::function<void(int, int)> dataTransferAcknowledge);
+        std::function<void(int, int)> dataTransferAcknowledge,
+        std::function<void(void*, int, uint64_t, uint64_t, int, int)> dataTransferChunk,
+        std::function<void(int, int, uint64_t, uint64_t)> dataTransferProgress);
     static void destroy();
 
     static std::condition_variable cond;
@@ -59,6 +68,52 @@ public:
      */
     bool isSyncComplete() const;
 
+    /**
+     * \return `true` if all connected critical nodes are in sync, regardless of whether
+     *         the remaining nodes are
+     */
+    bool isCriticalSyncComplete() const;
+
+    /**
+     * Signals all sync connections that the previously received shared data has been
+     * used, allowing them to decode the next frame's data if pipelined sync is enabled.
+     */
+    void releaseSyncData() const;
+
+    /**
+     * \return The current time of the master node in seconds. On the master, this is
+     *         the same as sgct::time, on the clients the estimated clock offset to the
+     *         master is applied
+     */
+    double masterTime() const;
+
+    /**
+     * Sends the text \p message from a client to the master node, where it is printed
+     * in the log. The message is not sent immediately, but together with the
+     * acknowledgement of the current frame. On the master, this function does nothing.
+     */
+    void queueMessageToMaster(std::string_view message) const;
+
+    /**
+     * Sends the \p statistics of the current frame of a client to the master, together
+     * with the acknowledgement of the next frame. On the master, this function does
+     * nothing.
+     */
+    void queueStatisticsToMaster(const Network::NodeStatistics& statistics) const;
+
+    /**
+     * Signals the master that this client is ready to render its first frame and sends
+     * it the startup \p times of this client. On the master, this function does nothing.
+     */
+    void sendReadyToMaster(const Network::StartupTimes& times) const;
+
+    /**
+     * \return `true` if all clients are connected and have signalled with
+     *         #sendReadyToMaster that they are ready to render their first frame. On a
+     *         client, this is always `true`
+     */
+    bool areAllNodesReady() const;
+
     bool matchesAddress(std::string_view address) const;
 
     /**
@@ -67,10 +122,73 @@ public:
     bool isComputerServer() const;
     bool isRunning() const;
     bool areAllNodesConnected() const;
+
+    /**
+     * Sends \p length bytes of \p data to all data transfer connections, or to only the
+     * provided \p connection. Unless the data is compressed, it is sent straight from
+     * the provided memory without being copied into an intermediate buffer first. A
+     * client only sends to the data transfer connection towards the master, also if it
+     * relays the transfers of the master to other clients. If a connection already has
+     * as many unacknowledged packages as the transfer window allows, this function waits
+     * until the oldest one has been acknowledged, except when it is called from a data
+     * transfer callback.
+     */
     void transferData(const void* data, int length, int packageId) const;
     void transferData(const void* data, int length, int packageId,
         const Network& connection) const;
 
+    /**
+     * Sends \p length bytes of \p data to all connected data transfer connections, or
+     * to only the provided \p connection, as a sequence of chunks. The receiving side
+     * gets each chunk through the chunk callback and acknowledges it, which is reported
+     * through the progress callback. The chunk size and an optional bandwidth limit are
+     * set in the cluster configuration. If a connection is lost during the transfer,
+     * this function waits for it to be reestablished and continues after the last
+     * acknowledged chunk. This function blocks until the transfer is finished or the
+     * network is shut down.
+     */
+    void transferChunkedData(const void* data, uint64_t length, int packageId) const;
+    void transferChunkedData(const void* data, uint64_t length, int packageId,
+        const Network& connection) const;
+
+    /**
+     * \return The number of nodes that receive the data transfers that the master sends
+     *         through the \p connection, which is larger than 1 if the transfers are
+     *         relayed by the node at the other end to further clients
+     */
+    int transferNodesCount(const Network& connection) const;
+
+    /**
+     * \return The data transfer connection of the master to the node with the
+     *         \p nodeIndex, or `nullptr` if there is none, which is always the case on
+     *         the clients and for nodes whose transfers are relayed by another client
+     */
+    const Network* transferConnection(int nodeIndex) const;
+
+    /**
+     * \return The memory region into which the data for #transferRdmaData has to be
+     *         written, or `nullptr` if no RDMA buffer size is set in the cluster
+     *         configuration. If SGCT is built with RDMA support, the region is
+     *         registered with the network adapter so that it is sent without a copy
+     */
+    void* rdmaTransferBuffer();
+    size_t rdmaTransferBufferSize() const;
+
+    /**
+     * Sends the first \p length bytes of the #rdmaTransferBuffer to all connected data
+     * transfer connections. Where an RDMA connection to the remote node is established,
+     * the data is written directly into the remote node's memory, otherwise it is sent
+     * in the same way as #transferData. On the receiving side, the data is passed to the
+     * data transfer decode callback, and the acknowledgement to the acknowledge callback
+     * on the sending side. This function returns once the region can be written to again.
+     */
+    void transferRdmaData(int length, int packageId) const;
+
+    /**
+     * The functions that count and access the connections do not take a lock, so that
+     * they can be called in the loops that wait for the frame lock without contending
+     * with the threads of the connections. They can be called from any thread.
+     */
     unsigned int activeConnectionsCount() const;
     int connectionsCount() const;
     int syncConnectionsCount() const;
@@ -83,37 +201,110 @@ private:
     NetworkManager(NetworkMode nm,
         std::function<void(void*, int, int, int)> dataTransferDecode,
         std::function<void(bool, int)> dataTransferStatus,
-        std::function<void(int, int)> dataTransferAcknowledge);
+        std::function<void(int, int)> dataTransferAcknowledge,
+        std::function<void(void*, int, uint64_t, uint64_t, int, int)> dataTransferChunk,
+        std::function<void(int, int, uint64_t, uint64_t)> dataTransferProgress);
     NetworkManager(const NetworkManager&) = delete;
     NetworkManager(NetworkManager&&) = delete;
     NetworkManager& operator=(const NetworkManager&) = delete;
     NetworkManager& operator=(NetworkManager&&) = delete;
 
 
+    // The connection listens for the remote node if \p isServer is `true`, which is the
+    // case for all connections of the master and the data transfer connections through
+    // which a client relays the transfers to other clients
     void addConnection(int port, std::string address,
-        Network::ConnectionType connectionType = Network::ConnectionType::SyncConnection);
+        Network::ConnectionType connectionType = Network::ConnectionType::SyncConnection,
+        std::optional<bool> isServer = std::nullopt);
+    // Connects the client connections that were added while the event-driven network is
+    // used in parallel and adds them to their reactor afterwards
+    void connectPendingConnections();
     void updateConnectionStatus(Network& connection);
     void setAllNodesConnected();
+    void setDataTransferCallbacks(Network& connection) const;
+    void setRelayCallbacks(Network& connection) const;
+    // The number of nodes in the relay tree below and including the node
+    int nRelayedNodes(int nodeIndex) const;
+    bool isTransferTarget(const Network& connection) const;
+    void sendChunks(const Network& connection, const void* data, uint64_t length,
+        int packageId) const;
+    // The round trip time to the node of the data transfer \p connection in seconds, or
+    // 0 if it has not been measured
+    double roundTripTime(const Network& connection) const;
 
     std::function<void(void*, int, int, int)> _dataTransferDecodeFn;
     std::function<void(bool, int)> _dataTransferStatusFn;
     std::function<void(int, int)> _dataTransferAcknowledgeFn;
+    std::function<void(void*, int, uint64_t, uint64_t, int, int)> _dataTransferChunkFn;
+    std::function<void(int, int, uint64_t, uint64_t)> _dataTransferProgressFn;
+
+    // The connections by their type. A list is never changed once it is published, but
+    // replaced by a new one when a connection is added, so that the frame lock and the
+    // threads of the connections read the connections without taking a lock
+    struct Connections {
+        std::vector<Network*> all;
+        std::vector<Network*> sync;
+        std::vector<Network*> dataTransfer;
+    };
+    const Connections& connections() const;
+    // Publishes a new list of the current _networkConnections
+    void publishConnections();
 
     // This could be a std::vector<Network>, but Network is not move-constructible
-    // because of the std::condition_variable in it
+    // because of the std::condition_variable in it. It is only changed on the thread
+    // that initializes and closes the network
     std::vector<std::unique_ptr<Network>> _networkConnections;
-    std::vector<Network*> _syncConnections;
-    std::vector<Network*> _dataTransferConnections;
+    std::atomic<const Connections*> _connections = nullptr;
+    // All lists that have been published, as the other threads could still be reading
+    // a previous one until the network is closed
+    std::vector<std::unique_ptr<const Connections>> _connectionLists;
+
+    // The number of nodes that are reached through each of the master's data transfer
+    // connections if the transfers are relayed
+    std::map<const Network*, int> _relayedNodes;
+
+    // The data transfer connections of the master by the index of their node
+    std::map<int, const Network*> _nodeTransferConnections;
+
+    // The sync connection to the same node as each of the master's data transfer
+    // connections, whose clock measurements provide the round trip time
+    std::map<const Network*, const Network*> _transferSyncConnections;
+
+    // Broadcasts the shared data to all clients at once if a multicast group is set
+    std::unique_ptr<Multicast> _multicast;
+
+    /// Sends the log messages of this client to the master if the log is forwarded
+    std::unique_ptr<LogForwarder> _logForwarder;
+
+    // Handle the incoming messages of all sync and data transfer connections on one
+    // thread each if the event-driven network is enabled
+    std::unique_ptr<NetworkReactor> _syncReactor;
+    std::unique_ptr<NetworkReactor> _dataTransferReactor;
+    // The client connections that still have to connect before they are polled
+    std::vector<std::pair<Network*, NetworkReactor*>> _pendingConnections;
+
+    // Reused between calls to #transferData so that compressing large transfers does
+    // not allocate a new buffer every time
+    mutable std::mutex _transferMutex;
+    mutable std::vector<char> _transferBuffer;
+
+    // The region from which the RDMA transfers are sent. With RDMA support, every remote
+    // data transfer connection has an RDMA connection alongside it
+    std::vector<char> _rdmaBuffer;
+#ifdef SGCT_HAS_RDMA
+    std::map<const Network*, std::unique_ptr<RdmaConnection>> _rdmaConnections;
+#endif // SGCT_HAS_RDMA
 
     std::vector<std::string> _localAddresses;
 
     bool _isServer = true;
-    bool _isRunning = true;
-    bool _allNodesConnected = false;
+    std::atomic_bool _isRunning = true;
+    std::atomic_bool _allNodesConnected = false;
+    bool _useSharedMemory = false;
     const NetworkMode _mode;
-    unsigned int _nActiveConnections = 0;
-    unsigned int _nActiveSyncConnections = 0;
-    unsigned int _nActiveDataTransferConnections = 0;
+    std::atomic<unsigned int> _nActiveConnections = 0;
+    std::atomic<unsigned int> _nActiveSyncConnections = 0;
+    std::atomic<unsigned int> _nActiveDataTransferConnections = 0;
 };
 
 } // namespace sgct
@@ -0,0 +1,70 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__NETWORKREACTOR__H__
+#define __SGCT__NETWORKREACTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Waits for incoming data on the sockets of any number of connections on a single thread
+ * and lets each connection handle its data once it is available. This replaces the
+ * threads that each Network would otherwise run for itself. On Linux, the sockets are
+ * watched using epoll, on other platforms using poll.
+ */
+class SGCT_EXPORT NetworkReactor {
+public:
+    NetworkReactor();
+    ~NetworkReactor();
+
+    /**
+     * Adds the \p connection to the list of connections that are handled by this reactor.
+     * The \p connection has to be initialized with Network::initializeEventDriven first
+     * and it has to outlive this reactor or be finished.
+     */
+    void add(Network& connection);
+
+    /**
+     * Stops the reactor thread and waits for it to finish.
+     */
+    void stop();
+
+private:
+    NetworkReactor(const NetworkReactor&) = delete;
+    NetworkReactor(NetworkReactor&&) = delete;
+    NetworkReactor& operator=(const NetworkReactor&) = delete;
+    NetworkReactor& operator=(NetworkReactor&&) = delete;
+
+    void run();
+    void dispatch(Network* connection);
+    void updateRegistration(Network* connection);
+
+    std::mutex _mutex;
+    std::vector<Network*> _connections;
+    std::atomic_bool _shouldTerminate = false;
+    std::unique_ptr<std::thread> _thread;
+
+#ifdef __linux__
+    int _epoll = -1;
+    // The socket under which each connection is currently registered with epoll
+    std::map<Network*, SGCT_SOCKET> _registered;
+#endif // __linux__
+};
+
+} // namespace sgct
+
+#endif // __SGCT__NETWORKREACTOR__H__
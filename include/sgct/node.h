@@ -57,11 +57,25 @@ public:
      */
     int dataTransferPort() const;
 
+    /**
+     * \return `true` if the master always waits for this node, even after the sync
+     *         deadline has passed
+     */
+    bool isCritical() const;
+
+    /**
+     * \return The number of frames after which this node polls the events of its
+     *         windows if it is a client
+     */
+    int pollInterval() const;
+
 private:
     const std::string _address;
     const uint16_t _syncPort;
     const uint16_t _dataTransferPort;
     const bool _useSwapGroups;
+    const bool _isCritical;
+    const int _pollInterval;
 
     std::vector<std::unique_ptr<Window>> _windows;
 };
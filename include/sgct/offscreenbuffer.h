@@ -11,6 +11,10 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace sgct {
 
@@ -19,15 +23,69 @@ namespace sgct {
  */
 class SGCT_EXPORT OffScreenBuffer {
 public:
+    /**
+     * The buffers that are rendered into in addition to the color buffer.
+     */
+    struct Attachments {
+        bool depth = false;
+        bool normals = false;
+        bool positions = false;
+
+        auto operator<=>(const Attachments&) const noexcept = default;
+    };
+
+    /**
+     * A texture, or a part of a texture, that is attached to a framebuffer.
+     */
+    struct Target {
+        enum class Type {
+            /// A 2D texture
+            Texture,
+            /// The face #index of a cube map texture
+            CubeMapFace,
+            /// All layers of a texture array, of which the shaders select the layer
+            Layered,
+            /// The layer #index of a texture array
+            Layer
+        };
+
+        Type type = Type::Texture;
+        unsigned int texture = 0;
+        int index = 0;
+
+        auto operator<=>(const Target&) const noexcept = default;
+    };
+
+    /**
+     * The textures that are attached to a framebuffer at the same time. Without a depth
+     * texture, the depth render buffer of this buffer is used if it is not multisampled.
+     */
+    struct Configuration {
+        Target color;
+        std::optional<Target> depth = std::nullopt;
+        std::optional<Target> normals = std::nullopt;
+        std::optional<Target> positions = std::nullopt;
+
+        auto operator<=>(const Configuration&) const noexcept = default;
+    };
+
     static void unbind();
 
+    /**
+     * Creates a buffer with the depth, normal, and position attachments that are enabled
+     * in the settings of the Engine.
+     */
     explicit OffScreenBuffer(unsigned int internalFormat);
+    OffScreenBuffer(unsigned int internalFormat, Attachments attachments);
     ~OffScreenBuffer();
 
     void createFBO(int width, int height, int samples = 1);
     void resizeFBO(int width, int height, int samples = 1);
 
     /**
+     * Attaches the texture to the framebuffer that is bound, which must not be the
+     * framebuffer of a Configuration, as that would change the configuration.
+     *
      * \param texId GL id of the texture to attach
      * \param attachment The gl attachment enum in the form of `GL_COLOR_ATTACHMENT`i
      */
@@ -43,6 +101,22 @@ public:
         unsigned int attachment) const;
     void attachCubeMapDepthTexture(unsigned int texId, unsigned int face) const;
 
+    /**
+     * Attaches all layers of a texture array, so that the layer that is rendered to is
+     * selected by the shaders.
+     *
+     * \param texId GL id of the texture array to attach
+     * \param attachment The gl attachment enum, for example `GL_DEPTH_ATTACHMENT`
+     */
+    void attachLayeredTexture(unsigned int texId, unsigned int attachment) const;
+
+    /**
+     * \param texId GL id of the texture array to attach
+     * \param layer The layer of the texture array that is attached
+     * \param attachment The gl attachment enum, for example `GL_DEPTH_ATTACHMENT`
+     */
+    void attachTextureLayer(unsigned int texId, int layer, unsigned int attachment) const;
+
     /**
      * Bind framebuffer, auto-set multisampling and draw buffers.
      */
@@ -57,10 +131,44 @@ public:
      */
     void bind(bool isMultisampled, int n, const unsigned int* bufs) const;
     void bindBlit() const;
+
+    /**
+     * Binds a framebuffer that has the textures of the \p configuration attached and
+     * sets the draw buffers of its attachments. The framebuffer is created the first time
+     * that the configuration is bound and kept until the buffer is resized, so that
+     * switching between the configurations, for example between the eyes or the faces
+     * of a cube map, only binds a framebuffer instead of changing its attachments, each
+     * of which makes the driver validate the framebuffer again. The framebuffers of the
+     * configurations are never multisampled, and the textures must not be recreated
+     * without resizing this buffer.
+     */
+    void bind(const Configuration& configuration) const;
+
+    /**
+     * Binds the multisampled framebuffer for reading and the framebuffer of the
+     * \p configuration for drawing, to resolve into its textures with #blit.
+     */
+    void bindBlit(const Configuration& configuration) const;
+
+    /**
+     * Resolves the multisampled color buffer and all attachments into the textures that
+     * are attached to the framebuffer that was bound with #bindBlit.
+     */
     void blit() const;
+
+    /**
+     * Resolves the multisampled color buffer and only those of the \p attachments that
+     * this buffer has. Resolving an attachment whose content is not read afterwards only
+     * costs bandwidth, which grows with the number of samples.
+     */
+    void blit(Attachments attachments) const;
     bool isMultiSampled() const;
 
 private:
+    /// Returns the framebuffer of the \p configuration, which is created if needed
+    unsigned int configurationFrameBuffer(const Configuration& configuration) const;
+    void deleteConfigurations() const;
+
     unsigned int _frameBuffer = 0;
     unsigned int _multiSampledFrameBuffer = 0;
     unsigned int _colorBuffer = 0;
@@ -68,9 +176,16 @@ private:
     unsigned int _positionBuffer = 0;
     unsigned int _depthBuffer = 0;
     const unsigned int _internalColorFormat = 0x8058; // GL_RGBA8;
+    const Attachments _attachments;
 
     ivec2 _size = ivec2{ -1, -1 };
     bool _isMultiSampled = false;
+
+    // The framebuffers of the configurations that have been bound since the last resize
+    mutable std::vector<std::pair<Configuration, unsigned int>> _configurations;
+
+    // The estimated video memory of the render buffers
+    MemoryAccount _memory = MemoryAccount(MemoryTracker::Category::Framebuffers);
 };
 
 } // namespace sgct
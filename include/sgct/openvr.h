@@ -17,7 +17,7 @@
 #include <openvr.h>
 #include <string>
 
-class Window;
+namespace sgct { class Window; }
 
 namespace sgct::openvr {
     /// Init OpenVR
@@ -32,7 +32,13 @@ namespace sgct::openvr {
 
     SGCT_EXPORT glm::mat4 currentViewProjectionMatrix(sgct::Frustum::Mode nEye);
 
-    // Updates pose matrices for all tracked OpenVR devices
+    /// Blocks until the compositor is ready for the next frame. This is only the pacing
+    /// point of the frame loop and does not change the poses
+    SGCT_EXPORT void waitForPoses();
+
+    /// Updates pose matrices for all tracked OpenVR devices with the poses that are
+    /// predicted for the time at which the current frame is shown. This does not block,
+    /// so it should be called as late as possible before the frame is drawn
     SGCT_EXPORT void updatePoses();
 
     /// Updates matrices for both eyes of tracked HMD.
@@ -0,0 +1,94 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__POSEFILTER__H__
+#define __SGCT__POSEFILTER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/config.h>
+#include <sgct/math.h>
+#include <optional>
+#include <utility>
+
+namespace sgct {
+
+/**
+ * Smooths the samples of a tracked sensor and estimates its linear and angular velocity
+ * and acceleration, which are used to extrapolate the pose to the time at which a frame
+ * is shown. Without a filter, the samples are used as they are and the velocities are
+ * the differences between consecutive samples. The filter is only used by the thread
+ * that receives the samples.
+ */
+class SGCT_EXPORT PoseFilter {
+public:
+    /// The filtered pose of the sensor and its motion, all in the coordinates of the
+    /// tracker
+    struct State {
+        vec3 position = vec3{ 0.f, 0.f, 0.f };
+        quat rotation = quat{ 0.f, 0.f, 0.f, 1.f };
+        /// In meters per second
+        vec3 velocity = vec3{ 0.f, 0.f, 0.f };
+        /// In meters per second squared
+        vec3 acceleration = vec3{ 0.f, 0.f, 0.f };
+        /// The rotation axis scaled by the speed in radians per second
+        vec3 angularVelocity = vec3{ 0.f, 0.f, 0.f };
+        /// In radians per second squared
+        vec3 angularAcceleration = vec3{ 0.f, 0.f, 0.f };
+    };
+
+    explicit PoseFilter(std::optional<config::Tracker::Device::Filter> filter = {});
+
+    /**
+     * Adds the sample with the \p position and \p rotation that was received at
+     * \p time, in seconds.
+     *
+     * \return The filtered pose and motion of the sensor after this sample
+     */
+    State update(double time, vec3 position, quat rotation);
+
+    /**
+     * Moves the pose of the \p state forward by \p dt seconds with its velocities and,
+     * if \p useAcceleration is `true`, also with its accelerations.
+     */
+    static State extrapolate(const State& state, double dt, bool useAcceleration);
+
+private:
+    struct Covariance {
+        double position = 0.0;
+        double positionVelocity = 0.0;
+        double velocity = 0.0;
+    };
+
+    void reset(double time, vec3 position, quat rotation);
+    void updateOneEuro(double dt, vec3 position, quat rotation);
+    void updateKalman(double dt, vec3 position, quat rotation);
+
+    // Applies the constant velocity model to the covariance and returns the gains for
+    // the value and its velocity
+    std::pair<double, double> kalmanGain(Covariance& covariance, double dt) const;
+
+    std::optional<config::Tracker::Device::Filter::Type> _type;
+    double _minCutoff = 1.0;
+    double _beta = 10.0;
+    double _derivativeCutoff = 1.0;
+    double _processNoise = 50.0;
+    double _measurementNoise = 1e-6;
+
+    bool _hasSample = false;
+    double _time = 0.0;
+    State _state;
+    // The previous sample, from which the one euro filter estimates the speed
+    vec3 _samplePosition = vec3{ 0.f, 0.f, 0.f };
+    quat _sampleRotation = quat{ 0.f, 0.f, 0.f, 1.f };
+    Covariance _positionCovariance;
+    Covariance _rotationCovariance;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__POSEFILTER__H__
@@ -42,6 +42,7 @@ void operator delete(void* ptr) noexcept;
 #define TracyLockable(type, var) type var
 #define TracyAlloc(ptr, bytes)
 #define TracyAllocN(ptr, bytes, name)
+#define TracyFreeN(ptr, name)
 
 #endif // TRACY_ENABLE
 
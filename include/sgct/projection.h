@@ -11,6 +11,7 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <optional>
 
 namespace sgct {
 
@@ -21,10 +22,24 @@ class ProjectionPlane;
  */
 class SGCT_EXPORT Projection {
 public:
+    /**
+     * Calculates the matrices for the eye at \p base + \p offset looking through the
+     * projection plane \p proj. If all parameters are the same as in the previous call,
+     * the previous matrices are kept, so this function can be called every frame for
+     * every viewport and eye without repeating the calculation.
+     */
     void calculateProjection(vec3 base, const ProjectionPlane& proj, float nearClip,
         float farClip, vec3 offset = vec3{ 0.f, 0.f, 0.f });
 
     const mat4& viewProjectionMatrix() const;
+
+    /**
+     * \return The view projection matrix multiplied with the \p sceneTransform. The
+     *         product is cached until either the projection or the \p sceneTransform
+     *         changes
+     */
+    const mat4& viewProjectionMatrix(const mat4& sceneTransform) const;
+
     const mat4& viewMatrix() const;
     const mat4& projectionMatrix() const;
 
@@ -43,6 +58,24 @@ private:
     mat4 _projectionMatrix = mat4(1.f);
 
     Frustum _frustum;
+
+    // The parameters of the last calculation, which are compared against to skip
+    // recalculating the matrices if nothing has changed
+    struct Parameters {
+        vec3 base;
+        vec3 offset;
+        vec3 lowerLeft;
+        vec3 upperLeft;
+        vec3 upperRight;
+        float nearClip;
+        float farClip;
+
+        bool operator==(const Parameters&) const noexcept = default;
+    };
+    std::optional<Parameters> _parameters;
+
+    mutable std::optional<mat4> _sceneTransform;
+    mutable mat4 _sceneViewProjectionMatrix = mat4(1.f);
 };
 
 } // namespace sgct
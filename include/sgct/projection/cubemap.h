@@ -23,11 +23,14 @@ typedef SPOUTLIBRARY* SPOUTHANDLE;
 
 #ifdef SGCT_HAS_NDI
 #include <Processing.NDI.Lib.h>
+
+struct __GLsync;
 #endif // SGCT_HAS_NDI
 
 namespace sgct {
 
 class OffScreenBuffer;
+class SpoutSharedTexture;
 
 /**
  * This class manages and renders non-linear fisheye projections.
@@ -41,7 +44,7 @@ public:
     /**
      * Update projection when aspect ratio changes for the viewport.
      */
-    void update(const vec2& size) const override;
+    void update(const vec2& size) override;
 
     /**
      * Render the non linear projection to currently bounded FBO.
@@ -55,6 +58,7 @@ public:
     void setSpoutRigOrientation(vec3 orientation);
 
 private:
+    bool supportsLayeredRendering() const override;
     void initTextures(unsigned int internalFormat, unsigned int format,
         unsigned int type) override;
     void initVBO() override;
@@ -64,26 +68,57 @@ private:
 
     void renderCubemap(FrustumMode frustumMode) const override;
 
+    /**
+     * Decides which faces are sent through Spout and NDI in the current frame from their
+     * output intervals and, for NDI, whether a receiver is connected to them.
+     */
+    void updateSentFaces() const;
+
     std::unique_ptr<OffScreenBuffer> _spoutFBO;
 
     struct Cubeface {
         bool enabled = true;
+        // The number of frames between two frames in which the face is sent
+        int outputInterval = 1;
         unsigned int texture = 0;
+        // Whether the face is sent in this frame, which is updated at its beginning
+        mutable bool isSent = true;
 
 #ifdef SGCT_HAS_SPOUT
         struct {
             SPOUTHANDLE handle = nullptr;
+            // If this is set, the face is blitted into the texture of the sender
+            // instead of being sent through Spout
+            std::unique_ptr<SpoutSharedTexture> sharedTexture;
         } spout;
 #endif // SGCT_HAS_SPOUT
 
 #ifdef SGCT_HAS_NDI
         mutable struct {
             NDIlib_send_instance_t handle = nullptr;
+            // Faces without a connected receiver are neither downloaded nor sent
+            bool isConnected = false;
             NDIlib_video_frame_v2_t videoFrame;
             std::string name;
             std::vector<std::byte> videoBufferPing;
             std::vector<std::byte> videoBufferPong;
             std::vector<std::byte>* currentVideoBuffer = nullptr;
+
+            // Receives the UYVY encoded face as an RGBA texture of half the width, so
+            // that each texel holds the U, Y0, V, and Y1 bytes of two pixels
+            unsigned int uyvyTexture = 0;
+
+            // The pixel buffers into which the face is downloaded asynchronously. A
+            // download is sent to NDI two frames after it was started
+            struct Readback {
+                unsigned int pbo = 0;
+                // Only set if the buffer is mapped persistently, in which case NDI reads
+                // directly from it instead of from the ping-pong buffers
+                std::byte* mapping = nullptr;
+                __GLsync* fence = nullptr;
+            };
+            std::array<Readback, 3> readbacks;
+            size_t nextReadback = 0;
         } ndi;
 #endif // SGCT_HAS_NDI
     };
@@ -92,14 +127,23 @@ private:
 #ifdef SGCT_HAS_SPOUT
     const bool _spoutEnabled;
     const std::string _spoutName;
+    const bool _spoutUseSharedTexture;
 #endif // SGCT_HAS_SPOUT
 
 #ifdef SGCT_HAS_NDI
     const bool _ndiEnabled;
     const std::string _ndiName;
     const std::string _ndiGroups;
+
+    // Whether the faces are converted to UYVY on the GPU before they are downloaded,
+    // which requires an even width. Otherwise they are sent as RGBX
+    bool _ndiUseUyvy = false;
+    ShaderProgram _ndiShader;
+    unsigned int _ndiFbo = 0;
 #endif // SGCT_HAS_NDI
 
+    const bool _skipUnsentFaces;
+
     vec3 _rigOrientation = vec3{ 0.f, 0.f, 0.f };
 
     unsigned int _vao = 0;
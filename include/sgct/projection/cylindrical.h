@@ -14,6 +14,7 @@
 
 #include <sgct/callbackdata.h>
 #include <sgct/definitions.h>
+#include <vector>
 
 namespace sgct {
 
@@ -23,24 +24,41 @@ public:
         const Window& parent, User& user);
     ~CylindricalProjection() final;
 
+    void initialize(unsigned int internalFormat, unsigned int format, unsigned int type,
+        int nSamples) override;
+
     void render(const BaseViewport& viewport, FrustumMode mode) const override;
 
     void renderCubemap(FrustumMode frustumMode) const override;
 
-    void update(const vec2& size) const override;
+    void update(const vec2& size) override;
 
     void setRotation(float rotation);
     void setHeightOffset(float heightOffset);
     void setRadius(float radius);
 
 private:
+    bool supportsLayeredRendering() const override;
+    bool supportsSharedCubeMap() const override;
     void initVBO() override;
     void initViewports() override;
     void initShaders() override;
 
+    /**
+     * \return The cube map directions of the cylindrical image as the fragment shader
+     *         computes them, sampled on a regular grid of DirectionSamples squared
+     *         samples in rows
+     */
+    std::vector<vec3> sampledDirections() const;
+
     float _rotation;
     float _heightOffset;
     float _radius;
+    bool _useAdaptiveResolution;
+    bool _useAutomaticQuality;
+    // The highest cube map resolution that is chosen automatically
+    int _maxQuality;
+    bool _useLookupTexture;
 
     struct {
         ShaderProgram program;
@@ -15,6 +15,7 @@
 #include <sgct/callbackdata.h>
 #include <sgct/definitions.h>
 #include <sgct/math.h>
+#include <vector>
 
 namespace sgct {
 
@@ -24,17 +25,34 @@ public:
         const Window& parent, User& user);
     ~EquirectangularProjection() final;
 
+    void initialize(unsigned int internalFormat, unsigned int format, unsigned int type,
+        int nSamples) override;
+
     void render(const BaseViewport& viewport, FrustumMode mode) const override;
 
     void renderCubemap(FrustumMode frustumMode) const override;
 
-    void update(const vec2& size) const override;
+    void update(const vec2& size) override;
 
 private:
+    bool supportsLayeredRendering() const override;
+    bool supportsSharedCubeMap() const override;
     void initVBO() override;
     void initViewports() override;
     void initShaders() override;
 
+    /**
+     * \return The cube map directions of the equirectangular image as the fragment shader
+     *         computes them, sampled on a regular grid of DirectionSamples squared
+     *         samples in rows
+     */
+    std::vector<vec3> sampledDirections() const;
+
+    bool _useAutomaticQuality;
+    // The highest cube map resolution that is chosen automatically
+    int _maxQuality;
+    bool _useLookupTexture;
+
     unsigned int _vao = 0;
     unsigned int _vbo = 0;
     ShaderProgram _shader;
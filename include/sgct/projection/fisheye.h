@@ -13,6 +13,7 @@
 #include <sgct/projection/nonlinearprojection.h>
 
 #include <sgct/callbackdata.h>
+#include <vector>
 
 namespace sgct {
 
@@ -30,7 +31,7 @@ public:
     /**
      * Update projection when aspect ratio changes for the viewport.
      */
-    void update(const vec2& size) const override;
+    void update(const vec2& size) override;
 
     /**
      * Render the non-linear projection to currently bounded FBO.
@@ -95,10 +96,51 @@ public:
     void setKeepAspectRatio(bool state);
 
 private:
+    bool supportsLayeredRendering() const override;
+    bool readsAttachmentCubeMaps() const override;
+    bool supportsSharedCubeMap() const override;
+    void initTextures(unsigned int internalFormat, unsigned int format,
+        unsigned int type) override;
+    void initFBO(unsigned int internalFormat, int nSamples) override;
     void initVBO() override;
     void initViewports() override;
     void initShaders() override;
 
+    /**
+     * Calls the draw function once to render the fisheye directly into the
+     * \p viewport, without the cube map. The application warps its geometry with the
+     * parameters in RenderData::fisheye.
+     */
+    void renderDirect(const BaseViewport& viewport, FrustumMode frustumMode) const;
+
+    /**
+     * Calls the draw function once for every batch of the omni-directional stereo tiles
+     * of the \p frustumMode, whose matrices are bound as a uniform block.
+     */
+    void renderOmniStereo(const BaseViewport& viewport, FrustumMode frustumMode) const;
+
+    /**
+     * Computes the view projection matrices of the tiles that cover the fisheye in the
+     * \p viewport for the \p frustumMode and uploads them into the uniform buffer of
+     * the mode in batches of RenderData::OmniStereo::MaxTiles tiles. Nothing is done if
+     * none of the parameters that the tiles depend on has changed since the last call.
+     */
+    void updateOmniStereoTiles(const BaseViewport& viewport,
+        FrustumMode frustumMode) const;
+
+    /**
+     * Rotates the \p dir of the fisheye into the cube map in the same way as the
+     * rotate functions of the fisheye shaders.
+     */
+    vec3 cubeMapDirection(float x, float y, float z) const;
+
+    /**
+     * \return The directions in which the fisheye samples the cube map, on a regular
+     *         grid over the cropped part of the fisheye image, in the same way as the
+     *         sampling shader
+     */
+    std::vector<vec3> sampledDirections() const;
+
     float _fov;
     float _tilt;
     float _diameter;
@@ -109,6 +151,13 @@ private:
 
     bool _ignoreAspectRatio = false;
     bool _keepAspectRatio;
+    bool _useAdaptiveResolution;
+    bool _isDirect;
+
+    // The rotation from the user's coordinate system into the one of the fisheye when it
+    // is rendered directly, as well as the half size of the fisheye quad
+    mat4 _directRotation = mat4(1.f);
+    mutable vec2 _quadSize = vec2{ 1.f, 1.f };
 
     mutable bool _isOffAxis = false;
     mutable vec3 _offset = vec3{ 0.f, 0.f, 0.f };
@@ -117,6 +166,43 @@ private:
 
     FisheyeMethod _method = FisheyeMethod::FourFaceCube;
 
+    // A grayscale image of the omni-directional stereo with the inverse gamma applied
+    struct OmniStereoMap {
+        ivec2 size = ivec2{ 0, 0 };
+        std::vector<float> values;
+    };
+
+    // The parameters that the omni-directional stereo tiles of a frustum mode depend on
+    struct OmniStereoKey {
+        ivec2 size;
+        vec2 quadSize;
+        vec3 eye;
+        float eyeSeparation;
+        float nearClip;
+        float farClip;
+
+        bool operator==(const OmniStereoKey&) const noexcept = default;
+    };
+
+    struct OmniStereoTiles {
+        unsigned int buffer = 0;
+        int nTiles = 0;
+        std::optional<OmniStereoKey> key;
+    };
+
+    struct {
+        bool isEnabled = false;
+        int tileSize = 8;
+        OmniStereoMap turnMap;
+        OmniStereoMap separationMap;
+
+        // The distance in bytes between the batches in the uniform buffers
+        int batchStride = 0;
+
+        // The tiles of each frustum mode, indexed by the mode
+        mutable std::array<OmniStereoTiles, 3> tiles;
+    } _omniStereo;
+
     // shader locations
     struct {
         int cubemap = -1;
@@ -125,15 +211,10 @@ private:
         int positionCubemap = -1;
         int halfFov = -1;
         int offset = -1;
-        int swapColor = -1;
-        int swapDepth = -1;
-        int swapNear = -1;
-        int swapFar = -1;
     } _shaderLoc;
     unsigned int _vao = 0;
     unsigned int _vbo = 0;
     ShaderProgram _shader;
-    ShaderProgram _depthCorrectionShader;
 };
 
 } // namespace sgct
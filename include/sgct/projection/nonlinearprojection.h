@@ -11,13 +11,24 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/baseviewport.h>
+#include <sgct/callbackdata.h>
+#include <sgct/cubefacedistributor.h>
+#include <sgct/memorytracker.h>
+#include <sgct/offscreenbuffer.h>
+#include <sgct/rendertargetpool.h>
 #include <sgct/shaderprogram.h>
+#include <array>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace sgct {
 
-class OffScreenBuffer;
 class Window;
 
 /**
@@ -27,6 +38,15 @@ class SGCT_EXPORT NonLinearProjection {
 public:
     enum class InterpolationMode : uint8_t { Linear, Cubic };
 
+    /// The nodes that render the cube faces if their rendering is distributed
+    struct Distribution {
+        /// The node that shows the projection
+        int outputNode = 0;
+        /// The index of each helper node and the mask of the faces that it renders, in
+        /// the order of the cube map faces
+        std::vector<std::pair<int, uint8_t>> helpers;
+    };
+
     NonLinearProjection(const Window& parent);
 
     virtual ~NonLinearProjection();
@@ -40,7 +60,20 @@ public:
 
     virtual void render(const BaseViewport& viewport, FrustumMode frustumMode) const = 0;
     virtual void renderCubemap(FrustumMode frustumMode) const = 0;
-    virtual void update(const vec2& size) const = 0;
+
+    /**
+     * Renders the cube map for the \p frustumMode. If cube maps are shared in the
+     * settings and another projection on this node has rendered an identical cube map
+     * in this frame, the render function samples that cube map instead of rendering it
+     * again.
+     */
+    void prepareCubemap(FrustumMode frustumMode) const;
+    /**
+     * Updates the projection for the \p size of its viewport in pixels, which is called
+     * whenever the framebuffer of the window is resized, including when its resolution
+     * is scaled.
+     */
+    virtual void update(const vec2& size) = 0;
 
     virtual void updateFrustums(FrustumMode mode, float nearClip, float farClip);
 
@@ -59,7 +92,10 @@ public:
     void setInterpolationMode(InterpolationMode im);
 
     /**
-     * Set if depth should be re-calculated to match the non-linear projection.
+     * Set if the depth of the cube faces should match the non-linear projection, which
+     * measures the distance from the center of the cube rather than from the plane of a
+     * face. The faces are then rendered with RenderData::radialDepth, whose fragment
+     * shaders write the radial depth themselves, so no extra pass is needed.
      */
     void setUseDepthTransformation(bool state);
 
@@ -70,11 +106,26 @@ public:
 
     virtual void setUser(User& user);
 
+    /**
+     * Distributes the rendering of the cube faces across nodes. The output node renders
+     * the faces that no helper renders and receives the other ones from the helpers,
+     * which render only their own faces and send them to the output node instead of
+     * drawing the projection. This has to be called before the projection is
+     * initialized.
+     */
+    void setDistribution(Distribution distribution);
+
     /**
      * \return the resolution of the cubemap
      */
     ivec2 cubemapResolution() const;
 
+    /**
+     * \return `true` if all cube faces are rendered with a single call of the draw
+     *         callback, in which case the RenderData contains the matrices of all faces
+     */
+    bool isLayered() const;
+
 protected:
     virtual void initTextures(unsigned int internalFormat, unsigned int format,
         unsigned int type);
@@ -83,31 +134,277 @@ protected:
     virtual void initViewports() = 0;
     virtual void initShaders() = 0;
 
-    void setupViewport(const BaseViewport& vp) const;
+    /**
+     * Allocates the scaled color texture if any of the cube faces is scaled, or resets
+     * the scales of the faces if they cannot be scaled with the current settings.
+     */
+    void initScaledFaces();
+
+    /**
+     * Allocates the cube maps of the right eye for the interleaved rendering of the eyes.
+     */
+    void initRightEyeTextures();
+
+    /**
+     * Recreates the cube maps and the framebuffer with the current cube map resolution.
+     * The viewports are initialized again, as the scales of the faces depend on the
+     * resolution.
+     */
+    void recreateCubeMaps();
+
+    /**
+     * Sets the viewport and scissor rectangle to the part of a cube face that the
+     * \p vp covers, with the face shrunk by the \p scale.
+     */
+    void setupViewport(const BaseViewport& vp, float scale = 1.f) const;
+    ivec4 viewportCoordinates(const BaseViewport& vp, float scale) const;
     void generateMap(unsigned int& texture, unsigned int internalFormat,
         unsigned int format, unsigned int type);
     void generateCubeMap(unsigned int& texture, unsigned int internalFormat,
         unsigned int format, unsigned int type);
 
-    void attachTextures(int face) const;
-    void blitCubeFace(int face) const;
-    void renderCubeFace(const BaseViewport& vp, int idx, FrustumMode mode) const;
+    /**
+     * Returns the attachments of the face \p face of the cube maps that are rendered for
+     * the \p mode.
+     */
+    OffScreenBuffer::Configuration faceConfiguration(int face, FrustumMode mode) const;
+    void blitCubeFace(int face, FrustumMode mode) const;
+
+    /**
+     * Renders the cube face \p vp with the index \p idx, unless it is disabled or its
+     * previous content is reused in this frame. If the eyes are interleaved, the face is
+     * rendered for both eyes when the left eye is rendered and is skipped for the right
+     * eye.
+     *
+     * \return `true` if the face was rendered
+     */
+    bool renderCubeFace(const BaseViewport& vp, int idx, FrustumMode mode) const;
+
+    /**
+     * Calls the draw function for the cube face \p vp with the index \p idx.
+     */
+    void drawCubeFace(const BaseViewport& vp, int idx, FrustumMode mode,
+        std::optional<RenderData::EyePair> eyePair) const;
+
+    /**
+     * \return The clipping planes of the radial depth that the cube faces are rendered
+     *         with, or `std::nullopt` if the depth is not transformed
+     */
+    std::optional<RenderData::RadialDepth> radialDepth() const;
+
+    /**
+     * \return `true` if the cube face \p idx has to be rendered in this frame with the
+     *         \p modelViewProjection matrix. If the cube map refresh interval is larger
+     *         than 1, the enabled faces take turns so that each of them is rendered once
+     *         during the interval, and a face is also rendered whenever its matrix has
+     *         changed since it was last rendered
+     */
+    bool isCubeFaceDue(int idx, const mat4& modelViewProjection) const;
+
+    /**
+     * Magnifies the part of the scaled color texture that the face \p idx was rendered
+     * into onto the part of the \p texture that the face \p vp covers. The \p target is
+     * the texture target of the face in the \p texture.
+     */
+    void magnifyScaledFace(const BaseViewport& vp, int idx, unsigned int target,
+        unsigned int texture) const;
+
+    /**
+     * \return `true` if the projection renders the cube faces only into the cube maps,
+     *         which is required for rendering them in a single pass
+     */
+    virtual bool supportsLayeredRendering() const;
+
+    /**
+     * \return `true` if the projection only reads the color, depth, normal, and position
+     *         cube maps when it renders, so that it can read the ones of another
+     *         projection through #sampledTextures instead
+     */
+    virtual bool supportsSharedCubeMap() const;
+
+    /**
+     * \return `true` if the cube map that the \p other projection renders is the same as
+     *         the one that this projection renders for the \p mode
+     */
+    bool hasSameCubeMap(const NonLinearProjection& other, FrustumMode mode) const;
+
+    /**
+     * \return `true` if the projection reads the depth, normal, and position cube maps.
+     *         Only then are the ones that are enabled in the settings allocated and
+     *         rendered into
+     */
+    virtual bool readsAttachmentCubeMaps() const;
+
+    /**
+     * Renders the faces in the \p faceMask with a single call of the draw callback into
+     * the layers of the cube maps.
+     */
+    void renderCubeFacesLayered(FrustumMode mode, uint8_t faceMask) const;
+
+    /**
+     * Calls the draw function for the faces in the \p faceMask of the layered cube maps.
+     */
+    void drawCubeFacesLayered(FrustumMode mode, uint8_t faceMask,
+        std::optional<RenderData::EyePair> eyePair) const;
+
+    /**
+     * \return `true` if the cube faces of the right eye have already been rendered
+     *         together with the ones of the left eye in this frame
+     */
+    bool isRightEyeInterleaved() const;
+
+    /**
+     * \return The mask of the faces whose sub viewports are enabled
+     */
+    uint8_t enabledFaces() const;
+
+    /**
+     * \return The mask of the enabled faces that this node renders itself, which are all
+     *         of them unless the rendering of the faces is distributed
+     */
+    uint8_t renderedFaces() const;
+
+    /**
+     * \return `true` if this node renders cube faces for the projection of another node,
+     *         in which case the projection is not drawn
+     */
+    bool isHelper() const;
+
+    /**
+     * Sends the faces that this helper node has rendered for the \p mode to the output
+     * node or, on the output node, waits for the faces of the helpers and copies them
+     * into the cube map. This has to be called after the faces have been rendered.
+     */
+    void exchangeDistributedFaces(FrustumMode mode) const;
+
+    /**
+     * Restricts the rendering of the cube face \p vp to the rectangle between \p min and
+     * \p max, given in normalized coordinates of the face, or disables the face if the
+     * rectangle is empty. The rectangle is grown by the texels that the interpolation
+     * reads and is never grown beyond the part of the face that is already rendered. The
+     * projection plane of the face is shrunk accordingly, so that the remaining part of
+     * the face shows the same image as before.
+     */
+    void cropCubeFace(BaseViewport& vp, vec2 min, vec2 max);
+
+    /**
+     * Restricts the rendering of all cube faces to the parts that are sampled by the
+     * \p directions, which are given in the coordinate system of the cube map. The
+     * faces in which none of the directions lie are disabled. The directions have to be
+     * sampled densely enough that neighboring directions are less than 1/32 of a face
+     * apart.
+     */
+    void cropCubeFaces(std::span<const vec3> directions);
+
+    /**
+     * Lowers the resolutions at which the cube faces are rendered so that their texels
+     * are no denser than needed for the \p directions, for projections that sample the
+     * cube map with the same angular density in every direction. The configured cube
+     * map resolution is the density at the center of a face, and the texels get denser
+     * towards the edges. So a face that is only sampled away from its center is rendered
+     * at a lower resolution and magnified into the cube map. This has to be called
+     * before the projection is initialized.
+     */
+    void scaleCubeFacesToDensity(std::span<const vec3> directions);
+
+    /**
+     * Lowers the resolutions at which the cube faces are rendered to what the final image
+     * needs, for projections whose density varies across the image. The \p directions
+     * are sampled on a regular grid of \p gridSize samples, in rows, over the image of
+     * \p imageSize pixels and are zero where the image does not sample the cube map. The
+     * distances between neighboring directions on a face give the number of face texels
+     * per pixel of the image, and a face is rendered with no more texels than is needed
+     * for one texel per pixel where the image is the most magnified. This has to be
+     * called before the projection is initialized.
+     */
+    void scaleCubeFacesToImage(std::span<const vec3> directions, ivec2 gridSize,
+        vec2 imageSize);
+
+    /**
+     * Lowers the resolution at which the face \p idx is rendered to \p resolution texels
+     * along each side of the face, if that saves enough to be worth the blur of
+     * magnifying the face into the cube map.
+     */
+    void scaleCubeFace(int idx, float resolution);
+
+    /**
+     * Sets the cube map resolution to the lowest one at which the texels of the faces
+     * are no larger than the pixels of the image where the image is the most magnified,
+     * for the \p directions sampled as for #scaleCubeFacesToImage. The resolution is
+     * rounded up to a multiple of 64 and is at most \p maxResolution. If the projection
+     * has already been initialized and the resolution changes, its cube maps are
+     * recreated.
+     */
+    void fitCubemapResolution(std::span<const vec3> directions, ivec2 gridSize,
+        vec2 imageSize, int maxResolution);
+
+    /**
+     * \return The normalized direction, relative to the user, that is rendered into the
+     *         cube map at the \p cubeMapDirection, as given by the projection planes of
+     *         the faces. The face that the direction points to has to be set up
+     */
+    vec3 renderedDirection(const vec3& cubeMapDirection) const;
+
+    /**
+     * Creates the shaders that sample the cube map through a lookup texture instead of
+     * computing the direction of every pixel in every frame. The \p directionFunction is
+     * a GLSL shader that defines `vec3 direction(vec2 uv)`, which returns the direction
+     * in the cube map that the pixel at the texture coordinates `uv` of the viewport
+     * shows. The direction function is only evaluated when the lookup texture is baked.
+     */
+    void initDirectionLookup(std::string_view directionFunction);
+
+    /**
+     * Binds the shader that samples the cube map through the lookup texture and binds
+     * the lookup texture to the texture unit 1. The lookup texture is baked for the
+     * current OpenGL viewport first if its size has changed or if it has been marked as
+     * dirty, in which case \p setUniforms is called with the bound program of the
+     * direction function to set the uniforms that the function uses.
+     */
+    void bindDirectionLookup(
+        const std::function<void(const ShaderProgram&)>& setUniforms) const;
 
     struct {
+        ShaderProgram bakeShader;
+        ShaderProgram shader;
+        unsigned int fbo = 0;
+        unsigned int vao = 0;
+        mutable unsigned int texture = 0;
+        mutable ivec2 size = ivec2(0, 0);
+        // Set when a parameter of the direction function changes
+        mutable bool isDirty = true;
+    } _directionLookup;
+
+    struct Textures {
         unsigned int cubeMapColor = 0;
         unsigned int cubeMapDepth = 0;
         unsigned int cubeMapNormals = 0;
         unsigned int cubeMapPositions = 0;
-        unsigned int colorSwap = 0;
-        unsigned int depthSwap = 0;
         unsigned int cubeFaceRight = 0;
         unsigned int cubeFaceLeft = 0;
         unsigned int cubeFaceBottom = 0;
         unsigned int cubeFaceTop = 0;
         unsigned int cubeFaceFront = 0;
         unsigned int cubeFaceBack = 0;
+        unsigned int scaledColor = 0;
     } _textures;
 
+    // The cube maps of the right eye, which are only allocated if the eyes are
+    // interleaved, as both eyes are otherwise rendered into _textures one after another
+    Textures _rightEyeTextures;
+
+    /**
+     * \return The textures whose cube maps are rendered by this projection for the
+     *         \p mode
+     */
+    const Textures& renderedTextures(FrustumMode mode) const;
+
+    /**
+     * \return The textures whose cube maps are read when rendering this frame, which are
+     *         the ones of another projection if its cube map is shared
+     */
+    const Textures& sampledTextures() const;
+
     struct {
         BaseViewport right;
         BaseViewport left;
@@ -120,8 +417,71 @@ protected:
     InterpolationMode _interpolationMode = InterpolationMode::Linear;
     FrustumMode _preferedMonoFrustumMode = FrustumMode::Mono;
 
+    // The depth, normal, and position cube maps that are rendered for this projection
+    OffScreenBuffer::Attachments _attachments;
+
+    // The memory that the textures of this projection occupy, in bytes, except for the
+    // ones that are shared through the RenderTargetPool
+    MemoryAccount _textureMemory = MemoryAccount(MemoryTracker::Category::CubeMaps);
+
+    // The scaled texture only holds a single face until it has been copied into the
+    // cube map, so it is shared with the other projections of the same size
+    struct {
+        RenderTargetPool::Target scaledColor;
+    } _transientTargets;
+
+    /**
+     * Returns the pooled texture with the size of a cube face.
+     */
+    RenderTargetPool::Target acquireTransientTarget(unsigned int internalFormat,
+        unsigned int format, unsigned int type) const;
+
+    unsigned int _internalFormat = 0;
+    unsigned int _format = 0;
+    unsigned int _type = 0;
+    int _nSamples = 1;
+
+    // The frame and frustum mode that the cube map was last rendered for by this
+    // projection itself
+    struct RenderedCubeMap {
+        unsigned int frame;
+        FrustumMode mode;
+    };
+    mutable std::optional<RenderedCubeMap> _renderedCubeMap;
+
+    // The projection whose cube maps are read in this frame, or `nullptr` if this
+    // projection has rendered its own
+    mutable const NonLinearProjection* _cubeMapSource = nullptr;
+    bool _isSharingCubeMap = false;
+
     bool _useDepthTransformation = false;
     bool _isStereo = false;
+    bool _isLayered = false;
+    // Whether each cube face is rendered for both eyes directly after each other
+    bool _isInterleaved = false;
+    // The frame in which the left eye was rendered together with the right eye
+    mutable std::optional<unsigned int> _interleavedFrame;
+    // The frustum mode for which the cube maps were last prepared
+    mutable FrustumMode _sampledMode = FrustumMode::Mono;
+
+    std::optional<Distribution> _distribution;
+    // The faces that this node renders itself, which excludes the faces of the helper
+    // nodes on the output node and the faces of the other nodes on a helper node
+    uint8_t _localFaces = 0b111111;
+    bool _isHelper = false;
+    // The framebuffer from which a helper reads its faces back
+    unsigned int _distributedFbo = 0;
+    // Reused for the pixels of the faces that are sent or received
+    mutable CubeFaceDistributor::Face _distributedFace;
+
+    // The factors by which the resolution of each cube face is lowered when it is
+    // rendered, in the order of the cube map faces
+    std::array<float, 6> _faceScales = { 1.f, 1.f, 1.f, 1.f, 1.f, 1.f };
+    unsigned int _scaledFbo = 0;
+
+    // The model view projection matrix with which each face was last rendered, in the
+    // order of the cube map faces, or no value if the face has not been rendered yet
+    mutable std::array<std::optional<mat4>, 6> _faceMatrices;
 
     ivec2 _cubemapResolution = ivec2(512, 512);
     vec4 _clearColor = vec4(0.3f, 0.3f, 0.3f, 1.f);
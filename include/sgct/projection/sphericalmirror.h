@@ -13,6 +13,7 @@
 #include <sgct/projection/nonlinearprojection.h>
 
 #include <sgct/correctionmesh.h>
+#include <array>
 
 namespace sgct {
 
@@ -25,7 +26,7 @@ public:
         const Window& parent, User& user);
     virtual ~SphericalMirrorProjection() final;
 
-    void update(const vec2& size) const override;
+    void update(const vec2& size) override;
 
     /**
      * Render the non linear projection to currently bounded FBO.
@@ -54,22 +55,20 @@ private:
 
     float _tilt;
     float _diameter = 2.4f;
+    bool _useAdaptiveResolution;
 
-    // mesh data
-    CorrectionMesh _meshBottom;
-    CorrectionMesh _meshLeft;
-    CorrectionMesh _meshRight;
-    CorrectionMesh _meshTop;
+    // The meshes of the bottom, left, right, and top segments. If all of them can be
+    // merged, the first mesh contains all segments and the others are empty
+    std::array<CorrectionMesh, 4> _meshes;
+    bool _isMerged = false;
     std::string _meshPathBottom;
     std::string _meshPathLeft;
     std::string _meshPathRight;
     std::string _meshPathTop;
 
     // shader locations
-    int _texLoc = -1;
     int _matrixLoc = -1;
     ShaderProgram _shader;
-    ShaderProgram _depthCorrectionShader;
 };
 
 } // namespace sgct
@@ -0,0 +1,125 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__RAWCAPTUREFILE__H__
+#define __SGCT__RAWCAPTUREFILE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace sgct {
+
+/**
+ * A container file into which the screenshots of one window are written back-to-back as
+ * raw pixels instead of encoding each of them into its own image file. The file starts
+ * with a header of #HeaderSize bytes, which is followed by one slot of slotSize() bytes
+ * per frame. Each slot starts with the screenshot number as a 64 bit integer, and the
+ * pixels start #SlotHeaderSize bytes into the slot. The pixels are stored in BGR or BGRA
+ * order with the rows from the bottom to the top, as they are downloaded from OpenGL.
+ *
+ * The file is preallocated and grows in large steps, and the slots are written without
+ * going through the file system cache where the operating system supports it. Multiple
+ * threads can write frames at the same time.
+ */
+class SGCT_EXPORT RawCaptureFile {
+public:
+    /// The alignment of the file offsets and buffers that are written to the file
+    static constexpr size_t Alignment = 4096;
+
+    /// The size of the header at the beginning of the file
+    static constexpr size_t HeaderSize = Alignment;
+
+    /// The offset of the pixels from the beginning of each slot
+    static constexpr size_t SlotHeaderSize = 64;
+
+    struct AlignedDelete {
+        void operator()(std::byte* buffer) const;
+    };
+
+    /// A buffer that fulfills the alignment requirements for writing to the file
+    using Buffer = std::unique_ptr<std::byte[], AlignedDelete>;
+
+    /**
+     * Creates the file at the \p path, replacing an existing file, and preallocates
+     * space for the first frames.
+     *
+     * \param path The path of the container file
+     * \param size The size of each frame in pixels
+     * \param nChannels The number of color channels of each pixel, which is 3 or 4
+     * \param bytesPerChannel The number of bytes per color channel
+     * \throw Error If the file cannot be created
+     */
+    RawCaptureFile(std::filesystem::path path, ivec2 size, int nChannels,
+        int bytesPerChannel);
+
+    /**
+     * Writes the number of frames into the header and releases the space that was
+     * preallocated but not used.
+     */
+    ~RawCaptureFile();
+
+    /**
+     * \return A buffer of slotSize() bytes that can be passed to write()
+     */
+    Buffer createBuffer() const;
+
+    /**
+     * Writes the screenshot with the \p number to the next free slot of the file. This
+     * function can be called from multiple threads at the same time.
+     *
+     * \param number The number of the screenshot that is stored in the slot
+     * \param data The pixels of the frame
+     * \param buffer The buffer that was created by createBuffer(), into which the slot is
+     *        assembled before it is written
+     * \throw Error If the frame cannot be written
+     */
+    void write(uint64_t number, const unsigned char* data, std::byte* buffer);
+
+    /**
+     * \return The size of a slot of the file in bytes
+     */
+    size_t slotSize() const;
+
+private:
+    RawCaptureFile(const RawCaptureFile&) = delete;
+    RawCaptureFile(RawCaptureFile&&) = delete;
+    RawCaptureFile& operator=(const RawCaptureFile&) = delete;
+    RawCaptureFile& operator=(RawCaptureFile&&) = delete;
+
+    void writeAt(uint64_t offset, const std::byte* data, size_t size);
+    void reserve(uint64_t size);
+
+    const std::filesystem::path _path;
+    const std::string _filename;
+    const ivec2 _size;
+    const int _nChannels;
+    const int _bytesPerChannel;
+    const size_t _frameSize;
+    const size_t _slotSize;
+
+    std::atomic_uint64_t _nFrames = 0;
+    std::mutex _reserveMutex;
+    std::atomic_uint64_t _reservedSize = 0;
+
+#ifdef WIN32
+    void* _handle = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    int _fd = -1;
+#endif // WIN32
+};
+
+} // namespace sgct
+
+#endif // __SGCT__RAWCAPTUREFILE__H__
@@ -0,0 +1,123 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__RDMACONNECTION__H__
+#define __SGCT__RDMACONNECTION__H__
+
+#include <sgct/sgctexports.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ibv_mr;
+struct rdma_cm_id;
+
+namespace sgct {
+
+/**
+ * A reliable RDMA connection between two nodes that transfers data by writing it from a
+ * registered memory region on the sending side directly into a registered memory region
+ * on the receiving side, bypassing the TCP stack on both ends. The connection is
+ * established using the RDMA connection manager on its own thread, which afterwards
+ * handles the incoming data. The receiving side provides #NumberOfSlots regions so that
+ * the sender can write the next block while the previous one is still being decoded.
+ */
+class SGCT_EXPORT RdmaConnection {
+public:
+    /// The number of blocks that can be in flight at the same time
+    static constexpr int NumberOfSlots = 2;
+
+    /**
+     * \param port The port in the RDMA connection manager's TCP port space
+     * \param address The address of the server, which is ignored if \p isServer is true
+     * \param isServer If `true`, this connection waits for the other side to connect
+     * \param sendBuffer The memory from which the data is sent. It is registered with
+     *        the network adapter and has to outlive this connection
+     * \param bufferSize The size of the \p sendBuffer and of each of the receive slots
+     * \param decode Called on the connection's thread with the data, the length, and
+     *        the package id of every block that is received
+     * \param acknowledge Called on the connection's thread with the package id of every
+     *        block that the other side has finished decoding
+     */
+    RdmaConnection(int port, std::string address, bool isServer, char* sendBuffer,
+        size_t bufferSize, std::function<void(char*, int, int)> decode,
+        std::function<void(int)> acknowledge);
+    ~RdmaConnection();
+
+    bool isConnected() const;
+
+    /**
+     * Writes the first \p length bytes of the send buffer into the next free receive
+     * slot of the other side. This function waits until a slot is available and returns
+     * once the send buffer can be written to again.
+     *
+     * \return `false` if the connection is not established, in which case nothing was
+     *         sent
+     */
+    bool send(int length, int packageId);
+
+private:
+    RdmaConnection(const RdmaConnection&) = delete;
+    RdmaConnection(RdmaConnection&&) = delete;
+    RdmaConnection& operator=(const RdmaConnection&) = delete;
+    RdmaConnection& operator=(RdmaConnection&&) = delete;
+
+    void run();
+    bool accept();
+    bool connect();
+    void registerRegions();
+    void receive();
+    void postReceive();
+    void sendCredit(int packageId);
+    void cleanup();
+
+    const int _port;
+    const std::string _address;
+    const bool _isServer;
+    char* _sendBuffer;
+    const size_t _bufferSize;
+    std::vector<char> _receiveBuffer;
+
+    std::function<void(char*, int, int)> _decode;
+    std::function<void(int)> _acknowledge;
+
+    rdma_cm_id* _listenId = nullptr;
+    rdma_cm_id* _id = nullptr;
+    ibv_mr* _sendRegion = nullptr;
+    ibv_mr* _receiveRegion = nullptr;
+
+    // The receive region of the other side, exchanged when connecting
+    uint64_t _remoteAddress = 0;
+    uint32_t _remoteKey = 0;
+    uint32_t _remoteSize = 0;
+
+    std::atomic_bool _isConnected = false;
+    std::atomic_bool _shouldTerminate = false;
+
+    // Guards the connection against being torn down while data is sent on it
+    mutable std::mutex _sendMutex;
+    int _nextSendSlot = 0;
+    int _nextReceiveSlot = 0;
+
+    // The number of receive slots on the other side that are free to be written to
+    std::mutex _creditMutex;
+    std::condition_variable _creditCond;
+    int _credits = NumberOfSlots;
+
+    std::unique_ptr<std::thread> _thread;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__RDMACONNECTION__H__
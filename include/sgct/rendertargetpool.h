@@ -0,0 +1,90 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__RENDERTARGETPOOL__H__
+#define __SGCT__RENDERTARGETPOOL__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/memorytracker.h>
+#include <optional>
+#include <string>
+
+namespace sgct {
+
+/**
+ * Shares the textures that are only used as transient render targets. A transient target
+ * is written and read within a single pass, such as the texture that a window renders
+ * into before it is smoothed by FXAA or the copy of its image that SMAA and TAA read
+ * while they write the image. As all windows are
+ * drawn one after the other in the shared context, the content of such a target is never
+ * needed by more than one pass at a time, so all users that request a target with the
+ * same format and size get the same texture.
+ *
+ * The pool can only be used on the thread with the shared OpenGL context.
+ */
+class SGCT_EXPORT RenderTargetPool {
+public:
+    struct Description {
+        unsigned int internalFormat = 0;
+        /// The format and type with which the texture is allocated
+        unsigned int format = 0;
+        unsigned int type = 0;
+        ivec2 size = ivec2(0, 0);
+
+        auto operator<=>(const Description&) const noexcept = default;
+    };
+
+    /**
+     * The use of a pooled texture, which is released when this object is destroyed. The
+     * texture is deleted when its last user is released.
+     */
+    class SGCT_EXPORT Target {
+    public:
+        Target() = default;
+        Target(Target&& rhs) noexcept;
+        Target& operator=(Target&& rhs) noexcept;
+        ~Target();
+
+        /**
+         * \return The OpenGL texture of this target or 0 if it is empty
+         */
+        unsigned int texture() const;
+
+    private:
+        friend class RenderTargetPool;
+
+        Target(const Target&) = delete;
+        Target& operator=(const Target&) = delete;
+
+        void release();
+
+        std::optional<Description> _description;
+        unsigned int _texture = 0;
+    };
+
+    /**
+     * Returns a transient 2D texture with the \p description, which is shared with all
+     * other users of a texture with the same description. The texture uses linear
+     * filtering, clamps to its edges, and has no mipmaps. Its memory is counted as part
+     * of the \p category of the first user.
+     */
+    static Target acquire(const Description& description,
+        MemoryTracker::Category category);
+
+    /**
+     * \return A table of the textures in the pool with their number of users and the
+     *         estimated video memory that they occupy or save, which is meant to be
+     *         logged
+     */
+    static std::string report();
+};
+
+} // namespace sgct
+
+#endif // __SGCT__RENDERTARGETPOOL__H__
@@ -10,19 +10,64 @@
 #define __SGCT__SCREENCAPTURE__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/config.h>
+#include <sgct/exrwriter.h>
+#include <sgct/image.h>
 #include <sgct/math.h>
+#include <sgct/rawcapturefile.h>
+#include <sgct/videoencoder.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
 #include <functional>
-#include <mutex>
+#include <memory>
+#include <semaphore>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+struct __GLsync;
+
 namespace sgct {
 
-class Image;
+class CaptureCollector;
+class Window;
 
 /**
- * This class is used internally by SGCT and is called when taking screenshots.
+ * This class is used internally by SGCT and is called when taking screenshots. The
+ * captured images are saved by a pool of capture threads that is started with the first
+ * screenshot. The images are recycled, so there is at most a fixed number of
+ * screenshots waiting to be saved.
+ *
+ * Every frame is downloaded asynchronously into its own pixel buffer and is only handed
+ * to the capture threads once the download has finished, which is at the latest two
+ * frames after the screenshot was taken. If the OpenGL version supports it, the pixel
+ * buffers are mapped persistently and the images are saved directly from them.
+ *
+ * Instead of one PNG file per screenshot, the screenshots can also be written as raw
+ * pixels into one RawCaptureFile per window and eye, or be encoded into one video file
+ * per window and eye by a VideoEncoder. Both files are replaced by a new file whenever
+ * the resolution changes. The frames of a video are encoded by a single capture thread,
+ * as they have to be passed to the encoder in order.
+ *
+ * EXR screenshots store the colors as half floats, independent of the 8 bit setting.
+ * If the depth, normals, or positions of the frame are passed along with its colors and
+ * the screenshots are not scaled down, they are stored as further parts of the same file.
+ *
+ * A ScreenCapture can also stream every frame of a window to a receiver on the network
+ * instead of saving screenshots. Its frames are limited to the frame rate of the stream,
+ * are always converted to 8 bits, and are skipped instead of waiting while the encoder
+ * is busy, so the stream never stalls the render thread. The capture thread connects to
+ * the receiver and connects again if the connection breaks.
+ *
+ * If the screenshots are collected, the clients hand every saved PNG file to the
+ * CaptureCollector, which sends it to the master.
+ *
+ * If the screenshots are converted to 8 bits per channel or scaled down, the conversion
+ * happens on the GPU by blitting the frame into a renderbuffer of the target format and
+ * size, which is then downloaded instead of the frame itself.
  */
 class SGCT_EXPORT ScreenCapture {
 public:
@@ -32,20 +77,31 @@ public:
     enum class CaptureSource { Texture, BackBuffer, LeftBackBuffer, RightBackBuffer };
     enum class EyeIndex { Mono, StereoLeft, StereoRight };
 
-    struct ScreenCaptureThreadInfo {
-        std::string filename;
-        std::unique_ptr<Image> frameBufferImage;
-        std::unique_ptr<std::thread> captureThread;
-        std::mutex* mutex = nullptr;
-        bool isRunning = false; // needed for test if running without join
+    /// The textures of the geometry buffer that are saved with the colors into EXR
+    /// files. A texture is skipped if its id is 0
+    struct GeometryTextures {
+        unsigned int depth;
+        unsigned int normals;
+        unsigned int positions;
     };
 
-    ScreenCapture(const Window& window, ScreenCapture::EyeIndex ei, int bytesPerColor,
-        unsigned int colorDataType, bool addAlpha);
+    /**
+     * Creates the capture of one eye of the \p window, which saves screenshots with the
+     * capture settings of the Engine. If a \p stream is passed, all frames are streamed
+     * with its settings instead, and the \p stream has to outlive this object.
+     */
+    ScreenCapture(const Window& window, ScreenCapture::EyeIndex ei,
+        unsigned int internalFormat, int bytesPerColor, unsigned int colorDataType,
+        bool addAlpha, const config::Window::Stream* stream = nullptr);
+
+    /**
+     * Waits until all queued screenshots have been saved and stops the capture threads.
+     */
     ~ScreenCapture();
 
     /**
-     * Initializes the PBO or re-sizes it if the frame buffer size have changed.
+     * Initializes the PBOs or re-sizes them if the frame buffer size have changed. This
+     * waits until the screenshots that were taken with the previous size are saved.
      *
      * \param resolution The pixel resolution of the frame buffer
      */
@@ -57,28 +113,157 @@ public:
      * \param textureId The texture that will be streamed from the GPU if frame buffer
      *        objects are used in the rendering
      * \param capSrc The object that should be captured
+     * \param geometry The textures of the geometry buffer, which are only downloaded
+     *        if the screenshots are saved as EXR files and \p capSrc is the texture
      */
     void saveScreenCapture(unsigned int textureId,
-        CaptureSource capSrc = CaptureSource::Texture);
+        CaptureSource capSrc = CaptureSource::Texture, GeometryTextures geometry = {});
+
+    /**
+     * Saves a PNG file with \p tiles times the framebuffer resolution of the window. The
+     * \p renderTile function is called for the index of every tile, starting with the
+     * top left one, and has to render the tile into the texture \p textureId, which
+     * is downloaded afterwards. The rows of tiles are written into the file one after
+     * the other, so that the image never has to be held in memory as a whole. As the
+     * screenshot needs all tiles at once, it is saved on the render thread.
+     */
+    void saveTiledScreenCapture(unsigned int textureId, ivec2 tiles,
+        const std::function<void(ivec2)>& renderTile);
+
+    /**
+     * Hands the screenshots whose download has finished to the capture threads. This has
+     * to be called once per frame, whether a screenshot was taken or not, so that the
+     * last screenshots are saved even if no further screenshots are taken.
+     */
+    void update();
+
+    /**
+     * Waits until all screenshots that have been taken are saved.
+     */
+    void flush();
+
+    /**
+     * \return The number of screenshots that have been captured but not yet saved
+     */
+    int queueDepth() const;
+
+    /**
+     * \return The number of screenshots that were skipped because the queue was full
+     */
+    uint64_t nDroppedFrames() const;
 
 private:
-    std::string createFilename(uint64_t frameNumber);
-    int availableCaptureThread();
-    Image* prepareImage(int index, std::string file);
+    /**
+     * A bounded queue of frame indices that can be used by any number of threads
+     * without locking. Every slot has a sequence number that tells whether it is ready
+     * to be written to or read from for the current position of the queue.
+     */
+    class FrameQueue {
+    public:
+        explicit FrameQueue(size_t capacity);
 
-    std::mutex _mutex;
-    std::vector<ScreenCaptureThreadInfo> _captureInfos;
+        bool push(size_t frame);
+        bool pop(size_t& frame);
+
+    private:
+        struct Slot {
+            std::atomic_size_t sequence = 0;
+            size_t frame = 0;
+        };
+
+        std::unique_ptr<Slot[]> _slots;
+        const size_t _mask;
+        std::atomic_size_t _head = 0;
+        std::atomic_size_t _tail = 0;
+    };
+
+    struct Frame {
+        uint64_t number = 0;
+        std::string filename;
+        // Only holds pixel data if the PBO is not mapped persistently, otherwise it only
+        // describes the layout of the mapped memory
+        std::unique_ptr<Image> image;
+        unsigned int pbo = 0;
+        // Only set if the buffer is mapped persistently, in which case the image is saved
+        // directly from it instead of from the image's own data
+        unsigned char* mapping = nullptr;
+        __GLsync* fence = nullptr;
+        // The buffer in which the slot of a raw capture file is assembled
+        RawCaptureFile::Buffer staging;
+        // The textures of the geometry buffer that were downloaded with the colors into
+        // their own PBO, one after the other, and are copied into the geometry data
+        GeometryTextures geometryTextures = {};
+        unsigned int geometryPbo = 0;
+        size_t geometrySize = 0;
+        std::vector<std::byte> geometry;
+    };
+
+    std::filesystem::path filePrefix() const;
+    std::string createFilename(uint64_t frameNumber, std::string_view extension);
+    std::string createContainerFilename(std::string_view extension);
+    bool openContainerFile();
+    Frame* prepareFrame(size_t index, uint64_t number, std::string file);
+    void packFrame(unsigned int textureId, CaptureSource capSrc);
+    void downloadGeometry(Frame& frame, GeometryTextures geometry);
+    void finishDownload();
+    void startWorkers();
+    void work();
+    void saveExr(const Frame& frame, const unsigned char* data) const;
+    void stream(const unsigned char* data);
 
     const unsigned int _nThreads;
-    unsigned int _pbo = 0;
     const unsigned int _downloadType;
     int _dataSize = 0;
+    // The resolution of the window and the resolution of the screenshots, which only
+    // differ if the screenshots are scaled down
+    ivec2 _sourceResolution = ivec2{ 0, 0 };
     ivec2 _resolution = ivec2{ 0, 0 };
     const int _bytesPerColor;
+    const float _scale;
+    // The framebuffers and renderbuffer of the pass that converts and scales the frame
+    // before it is downloaded, which are only created if the pass is needed
+    const unsigned int _packFormat;
+    unsigned int _sourceFbo = 0;
+    unsigned int _packFbo = 0;
+    unsigned int _packBuffer = 0;
     const bool _addAlpha;
+    const bool _dropWhenFull;
+    Image::PngSettings _pngSettings;
+    ExrWriter::Settings _exrSettings;
+    config::Capture::Format _format;
+    const config::Capture::Codec _codec;
+    const int _bitrate;
+    const int _frameRate;
+    // Only set if the frames are streamed instead of being saved as screenshots
+    const std::string _streamUrl;
+    // The time at which the next frame is streamed, which is used by the render thread,
+    // and the time at which the capture thread connects to the receiver again
+    double _nextStreamFrame = 0.0;
+    double _nextStreamConnection = 0.0;
+    uint64_t _nStreamFrames = 0;
+    std::unique_ptr<RawCaptureFile> _rawFile;
+    std::unique_ptr<VideoEncoder> _videoFile;
+    int _nContainerFiles = 0;
+    // Only set on the clients if the screenshots are collected on the master
+    CaptureCollector* _collector = nullptr;
 
     const EyeIndex _eyeIndex;
     const Window& _window;
+
+    // Every frame is either in the free or in the queued list, or is being used by the
+    // render thread or a capture thread. The semaphores count the frames in the lists so
+    // that the threads can wait for them
+    std::vector<Frame> _frames;
+    // The frames whose download has been started, which is only used by the render
+    // thread. They are queued for the capture threads in the order they were taken
+    std::deque<size_t> _downloads;
+    FrameQueue _freeFrames;
+    FrameQueue _queuedFrames;
+    std::counting_semaphore<> _nFreeFrames = std::counting_semaphore<>(0);
+    std::counting_semaphore<> _nQueuedFrames = std::counting_semaphore<>(0);
+    std::atomic_int _queueDepth = 0;
+    std::atomic_uint64_t _nDroppedFrames = 0;
+    std::vector<std::thread> _workers;
 };
 
 } // namespace sgct
@@ -0,0 +1,97 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SEQLOCK__H__
+#define __SGCT__SEQLOCK__H__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace sgct {
+
+/**
+ * Stores a value that one thread writes and any number of threads read without taking a
+ * lock. Readers copy the value and try again if it was changed while they copied it, so
+ * a reader never blocks the writer and always gets a value that was written as a whole.
+ * The value is kept in atomic words, so that the concurrent copies are well-defined.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "Type has to be trivially copyable");
+
+public:
+    SeqLock() : SeqLock(T()) {}
+
+    explicit SeqLock(const T& value) {
+        store(value);
+    }
+
+    /**
+     * Replaces the value with \p value. Only one thread can call this function at a time.
+     */
+    void store(const T& value) {
+        std::array<uint64_t, NumberOfWords> words = {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < NumberOfWords; i++) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * \return A copy of the value that was stored last, which can be called from any
+     *         thread
+     */
+    T load() const {
+        std::array<uint64_t, NumberOfWords> words;
+        while (true) {
+            const uint64_t sequence = _sequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 1) {
+                // The writer only copies a few words, so it is done almost immediately
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < NumberOfWords; i++) {
+                words[i] = _words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                break;
+            }
+        }
+
+        T res;
+        std::memcpy(&res, words.data(), sizeof(T));
+        return res;
+    }
+
+private:
+    SeqLock(const SeqLock&) = delete;
+    SeqLock(SeqLock&&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+    SeqLock& operator=(SeqLock&&) = delete;
+
+    static constexpr size_t NumberOfWords = (sizeof(T) + 7) / 8;
+    std::array<std::atomic_uint64_t, NumberOfWords> _words = {};
+    // Odd while a value is being written, so that readers know to try again
+    std::atomic_uint64_t _sequence = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SEQLOCK__H__
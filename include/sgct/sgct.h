@@ -10,6 +10,7 @@
 #define __SGCT__SGCT__H__
 
 #include <sgct/actions.h>
+#include <sgct/binarylog.h>
 #include <sgct/clustermanager.h>
 #include <sgct/commandline.h>
 #include <sgct/engine.h>
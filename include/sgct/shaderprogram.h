@@ -10,7 +10,9 @@
 #define __SGCT__SHADERPROGRAM__H__
 
 #include <sgct/sgctexports.h>
+#include <filesystem>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace sgct {
@@ -49,25 +51,71 @@ public:
     void deleteProgram();
 
     /**
-     * Will create and add a vertex shader to the program.
+     * Will add a vertex shader to the program, which is compiled when the program is
+     * linked.
      *
      * \param src The shader source string
-     * \throw std::runtime_error If the adding of the shaders failed
      */
     void addVertexShader(std::string_view src);
 
     /**
-     * Will create and add a fragment shader to the program.
+     * Will add a fragment shader to the program, which is compiled when the program is
+     * linked.
      *
      * \param src The shader source string
-     * \throw std::runtime_error If the adding of the shaders failed
      */
     void addFragmentShader(std::string_view src);
 
+    /**
+     * Will add a geometry shader to the program, which is compiled when the program is
+     * linked.
+     *
+     * \param src The shader source string
+     */
+    void addGeometryShader(std::string_view src);
+
+    /**
+     * Will add a tessellation control shader and a tessellation evaluation shader to the
+     * program, which are compiled when the program is linked. The program has to be
+     * drawn with `GL_PATCHES`, which requires OpenGL 4.0.
+     *
+     * \param controlSrc The tessellation control shader source string
+     * \param evaluationSrc The tessellation evaluation shader source string
+     */
+    void addTessellationShaders(std::string_view controlSrc,
+        std::string_view evaluationSrc);
+
+    /**
+     * Sets the outputs of the vertex shader that are written into the buffer that is
+     * bound to GL_TRANSFORM_FEEDBACK_BUFFER while transform feedback is active. The
+     * outputs are interleaved in the order of the \p varyings. This function has to be
+     * called before #createAndLinkProgram.
+     *
+     * \param varyings The names of the outputs of the vertex shader
+     */
+    void setTransformFeedbackVaryings(std::vector<std::string> varyings);
+
+    /**
+     * Adds a preprocessor macro to all shaders of the program, which is defined right
+     * after their `#version` directive. This selects the permutation of shaders that are
+     * specialized with `#ifdef` and bakes constant values into them, and each
+     * permutation is cached separately if the shader cache is enabled. This function has
+     * to be called before #createAndLinkProgram.
+     *
+     * \param name The name of the macro
+     * \param value The value of the macro, which is empty for macros that only select a
+     *        permutation
+     */
+    void addDefine(std::string_view name, std::string_view value = "");
+
     /**
      * Will create the program and link the shaders. The shader sources must have been set
      * before the program can be linked. After the program is created and linked no
-     * modification to the shader sources can be made.
+     * modification to the shader sources can be made. If the shader cache is enabled in
+     * the settings of the Engine, the program is loaded from its cached binary instead,
+     * if one exists, and otherwise the binary of the linked program is stored in it.
+     *
+     * \throw std::runtime_error If the program could not be linked
      */
     void createAndLinkProgram();
 
@@ -91,18 +139,49 @@ public:
      */
     unsigned int id() const;
 
+    /**
+     * Returns the location of the uniform with the \p name in the linked program. The
+     * location is only queried from OpenGL the first time and is cached afterwards, so
+     * this function can be used for uniforms that are set in every frame.
+     *
+     * \param name The name of the uniform
+     * \return The location of the uniform or -1 if the program has no active uniform
+     *         with the \p name
+     */
+    int uniformLocation(std::string_view name) const;
+
 private:
     /**
      * Will create and the program and return whether it was properly created or not.
      */
     void createProgram();
 
+    /**
+     * Loads the program from the binary in the cache file at the \p path and returns
+     * whether it was successful. A binary that the driver rejects is ignored.
+     */
+    bool loadBinary(const std::filesystem::path& path);
+
+    /**
+     * Stores the binary of the linked program in the cache file at the \p path.
+     */
+    void storeBinary(const std::filesystem::path& path) const;
+
     /// Name of the program, has to be unique
     std::string _name;
     /// Unique program id
     unsigned int _programId = 0;
 
+    /// The types and sources of the shaders that are compiled when the program is linked
+    std::vector<std::pair<unsigned int, std::string>> _sources;
     std::vector<unsigned int> _shaders;
+    std::vector<std::string> _feedbackVaryings;
+    /// The `#define` lines that are inserted into all shaders when they are linked
+    std::string _defines;
+
+    /// The locations that have been looked up by uniformLocation. Programs only have a
+    /// few uniforms, so they are searched linearly
+    mutable std::vector<std::pair<std::string, int>> _uniformLocations;
 };
 
 } // namespace sgct
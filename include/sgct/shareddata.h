@@ -10,51 +10,294 @@
 #define __SGCT__SHAREDDATA__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/bufferpolicy.h>
+#include <sgct/bytestream.h>
+#include <sgct/jobsystem.h>
+#include <sgct/memorytracker.h>
 #include <sgct/mutexes.h>
 #include <sgct/network.h>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace sgct {
 
+class SharedObjectBase;
+
 /**
  * This class shares application data between nodes in a cluster where the master encodes
  * and transmits the data and the clients receives and decode the data.
  */
 class SGCT_EXPORT SharedData {
 public:
+    /// Information about the sizes of the blocks of shared data this node has sent or
+    /// received, which shows whether the buffers had to grow while running
+    struct Statistics {
+        /// The size of the largest block in bytes
+        size_t peakSize = 0;
+        /// The average size of all blocks in bytes
+        double averageSize = 0.0;
+        /// The number of blocks that were sent or received
+        uint64_t nBlocks = 0;
+        /// The number of times a buffer had to grow to fit a block of shared data
+        int nResizes = 0;
+    };
+
     static SharedData& instance();
     static void destroy();
 
     void setEncodeFunction(std::function<std::vector<std::byte>()> function);
     void setDecodeFunction(std::function<void(const std::vector<std::byte>&)> function);
 
+    /**
+     * Sets an encode function that writes the shared data directly into the buffer that
+     * is sent to the clients instead of returning a new buffer in every frame. If this
+     * function is set, the function set with #setEncodeFunction is not used.
+     */
+    void setEncodeWriterFunction(std::function<void(ByteWriter&)> function);
+
+    /**
+     * Sets a decode function that reads the shared data directly from the buffer into
+     * which it was received instead of a copy of it. This function is called before the
+     * function set with #setDecodeFunction, if both are set.
+     */
+    void setDecodeReaderFunction(std::function<void(ByteReader&)> function);
+
+    /**
+     * Registers the functions of a segment of the shared data, which is encoded on the
+     * master and decoded on the clients by a job of the Engine's job system. All
+     * segments are encoded concurrently with each other and with the encode functions
+     * above, so independent parts of an application, for example a simulation and its
+     * user interface, can be shared as separate segments whose encode times do not add
+     * up. Likewise, the clients decode the segments concurrently with each other and with
+     * the decode functions above. The functions of a segment therefore must not access
+     * the data of the other segments or of the other functions without synchronizing.
+     * The segments are skipped together with the encode functions, and a client skips
+     * the segments whose id it has not registered. This function must not be called
+     * while the shared data is encoded or decoded.
+     *
+     * \param id The id that identifies the segment on all nodes
+     * \param encode The function that writes the segment on the master
+     * \param decode The function that reads the segment on the clients
+     */
+    void setSegmentFunctions(uint32_t id, std::function<void(ByteWriter&)> encode,
+        std::function<void(ByteReader&)> decode);
+
+    /**
+     * Removes the functions of the segment with the \p id, which is no longer sent.
+     */
+    void removeSegmentFunctions(uint32_t id);
+
+    /**
+     * If \p state is `true`, the encode functions are not called and only the modified
+     * SharedObject%s are sent to the clients. The clients do not call their decode
+     * functions for data that does not contain any data from the encode functions. SGCT
+     * skips the encode functions while the frames are marked as unchanged through
+     * Engine::setFrameUnchanged.
+     */
+    void setEncodeSkipped(bool state);
+
     /**
      * This fuction is called internally by SGCT and shouldn't be used by the user.
      */
     void encode();
 
     /**
-     * This function is called internally by SGCT and shouldn't be used by the user.
+     * This function is called internally by SGCT and shouldn't be used by the user. It
+     * is called on the master instead of #encode while a recording of the shared data is
+     * replayed and sends the recorded \p data of a frame to the clients. The data is also
+     * passed to the decode functions and the SharedObject%s of the master, so that all
+     * nodes show the recorded state.
+     */
+    void replay(std::span<const std::byte> data);
+
+    /**
+     * This function is called internally by SGCT and shouldn't be used by the user. It
+     * is called on the network thread and only stores a copy of the received data, which
+     * is decoded by the next call to #applyReceivedData.
      */
     void decode(const char* receivedData, int receivedLength);
 
+    /**
+     * This function is called internally by SGCT and shouldn't be used by the user. It is
+     * called on the render thread once the data for the next frame has been received and
+     * passes all data that was received since the last call to the decode functions and
+     * the SharedObject%s, in the order in which it was received.
+     */
+    void applyReceivedData();
+
+    /**
+     * \return The #Network::HeaderSize bytes of the header that precede the shared data
+     *         when it is sent to the clients
+     */
+    unsigned char* header();
+
+    /**
+     * \return The shared data that was encoded last, excluding the header
+     */
     unsigned char* dataBlock();
+
+    /**
+     * \return The size of the shared data in bytes, excluding the header
+     */
     int dataSize();
     int bufferSize();
 
+    /**
+     * Allocates the buffers for blocks of shared data of up to \p size bytes, so that
+     * they do not have to grow while the application is running. This function has to be
+     * called on all nodes before the Engine is created for the network buffers to be
+     * sized accordingly, too.
+     */
+    void reserve(size_t size);
+
+    Statistics statistics() const;
+
+    /**
+     * \return The CPU time in seconds that the encode functions and the segments took in
+     *         the last frame, which is 0 on the clients and while the encode functions
+     *         are skipped
+     */
+    double encodeTime() const;
+
+    /**
+     * \return The CPU time in seconds that the decode functions took for the data that
+     *         #applyReceivedData passed to them last, which is 0 on the master unless
+     *         a recording is replayed
+     */
+    double decodeTime() const;
+
+    /**
+     * This function is called internally by SGCT and shouldn't be used by the user. It
+     * counts a buffer that had to grow to receive the shared data.
+     */
+    void addBufferResize();
+
+    /**
+     * Marks all registered SharedObject%s as modified so that all of them are sent with
+     * the next frame. This function is called by #requestFullState whenever a client
+     * connects, and only has to be called by the user if the clients have to receive
+     * the complete state for another reason.
+     */
+    void markObjectsDirty();
+
+    /**
+     * Requests that the next frame carries the full state of the application, which is
+     * used when a client has restarted and reconnects. All registered SharedObject%s are
+     * marked as modified and the encode functions are called even if they are skipped
+     * through #setEncodeSkipped. This function is called internally by SGCT whenever a
+     * client connects.
+     */
+    void requestFullState();
+
+    /**
+     * \return `true` while the encode functions are called for a frame that has to carry
+     *         the full state of the application, which an encode function that only
+     *         writes the changes since the previous frame has to write completely. Large
+     *         assets should instead be sent to the client through the data transfer once
+     *         its connection is reported by the data transfer status callback
+     */
+    bool isFullState() const;
+
 private:
+    friend class SharedObjectBase;
+
     SharedData();
 
+    void registerObject(SharedObjectBase* object);
+    static void unregisterObject(SharedObjectBase* object);
+
+    // The modified objects are appended to the data block after the user's data as a
+    // sequence of (id, size, value) entries, followed by the size of that section
+    void encodeObjects(std::vector<std::byte>& buffer);
+    void decodeObjects(std::span<const std::byte> data);
+
+    // The segments follow the user's data, followed by a table of their ids and sizes
+    // and the number of segments. The jobs that encode the segments run while the
+    // user's encode functions are called, and their results are appended afterwards
+    std::vector<JobSystem::Job> startSegmentEncoding();
+    void appendSegments(const std::vector<JobSystem::Job>& jobs,
+        std::vector<std::byte>& buffer);
+    std::vector<JobSystem::Job> startSegmentDecoding(std::span<const std::byte> data,
+        std::span<const std::byte> table);
+
+    void decodeBlock(std::span<const std::byte> data);
+    void decodeUserData(std::span<const std::byte> data);
+    void addBlock(size_t size, bool isResized);
+    // Reports the capacity of the _dataBlock and the _decodeBuffer and applies the
+    // BufferPolicy to them once they have grown or moved
+    void updateBlockMemory();
+
     std::function<std::vector<std::byte>()> _encodeFn;
     std::function<void(const std::vector<std::byte>&)> _decodeFn;
+    std::function<void(ByteWriter&)> _encodeWriterFn;
+    std::function<void(ByteReader&)> _decodeReaderFn;
+
+    struct Segment {
+        std::function<void(ByteWriter&)> encode;
+        std::function<void(ByteReader&)> decode;
+        // The buffer into which the segment is encoded, which keeps its capacity between
+        // the frames
+        std::vector<std::byte> buffer;
+    };
+    std::map<uint32_t, Segment> _segments;
+
+    bool _isEncodeSkipped = false;
+    std::atomic_bool _isFullStateRequested = false;
+    bool _isFullState = false;
+
+    // Both are measured on the render thread around the calls of the user's functions
+    double _encodeTime = 0.0;
+    double _decodeTime = 0.0;
 
     static SharedData* _instance;
+
+    // The header and the data are kept separate so that the buffer returned by the
+    // encode function can be sent without copying it behind the header first
     std::vector<std::byte> _dataBlock;
     std::array<std::byte, Network::HeaderSize> _headerSpace;
+
+    // The copy of the received data that is passed to the decode function
+    std::vector<std::byte> _decodeBuffer;
+
+    // The types of the _dataBlock and the _decodeBuffer are part of the interface of
+    // the encode and decode functions, so the memory of the blocks is not provided by
+    // the BufferPolicy but only advised, whenever they are reallocated
+    const std::byte* _advisedDataBlock = nullptr;
+    const std::byte* _advisedDecodeBuffer = nullptr;
+
+    // The network thread appends the received data to _pendingData while the render
+    // thread decodes the previously received data in _decodingData, so that the two
+    // threads only hold the lock for swapping the buffers. The buffers that have been
+    // decoded are kept in _freeBuffers to be reused for receiving
+    using ReceiveBuffer = std::vector<
+        std::byte, BufferAllocator<std::byte, BufferPolicy::Subsystem::SharedData>
+    >;
+    std::mutex _receiveMutex;
+    std::vector<ReceiveBuffer> _pendingData;
+    std::vector<ReceiveBuffer> _decodingData;
+    std::vector<ReceiveBuffer> _freeBuffers;
+
+    size_t _expectedSize = 0;
+
+    // The memory of the _dataBlock and the _decodeBuffer, and of the buffers that
+    // receive the data, respectively
+    MemoryAccount _blockMemory = MemoryAccount(MemoryTracker::Category::SharedData);
+    MemoryAccount _receiveMemory = MemoryAccount(MemoryTracker::Category::SharedData);
+
+    mutable std::mutex _statisticsMutex;
+    Statistics _statistics;
+
+    std::mutex _objectsMutex;
+    std::map<uint32_t, SharedObjectBase*> _objects;
 };
 
 template <typename T>
@@ -138,6 +381,101 @@ template <>
 SGCT_EXPORT void deserializeObject(const std::vector<std::byte>& buffer, unsigned int& pos,
     std::wstring& value);
 
+/**
+ * The base class of all SharedObject%s, which registers itself with SharedData under
+ * its id when it is created and unregisters itself again when it is destroyed.
+ */
+class SGCT_EXPORT SharedObjectBase {
+public:
+    /// The ids from this one upwards are used by the shared objects of SGCT itself
+    static constexpr uint32_t FirstReservedId = 0xFFFF0000;
+
+    /**
+     * \param id The id that identifies this object on all nodes. It has to be the same
+     *        on the master and on the clients and unique among all shared objects.
+     *        It has to be smaller than #FirstReservedId
+     * \throw Error If another shared object with the same \p id already exists
+     */
+    explicit SharedObjectBase(uint32_t id);
+    virtual ~SharedObjectBase();
+
+    uint32_t id() const;
+
+    /**
+     * \return `true` if this object has been modified since it was sent last
+     */
+    bool isDirty() const;
+
+protected:
+    void setDirty();
+
+private:
+    friend class SharedData;
+
+    SharedObjectBase(const SharedObjectBase&) = delete;
+    SharedObjectBase(SharedObjectBase&&) = delete;
+    SharedObjectBase& operator=(const SharedObjectBase&) = delete;
+    SharedObjectBase& operator=(SharedObjectBase&&) = delete;
+
+    virtual void serialize(ByteWriter& writer) const = 0;
+    virtual void deserialize(ByteReader& reader) = 0;
+
+    const uint32_t _id;
+    std::atomic_bool _isDirty = true;
+};
+
+/**
+ * A value that is shared between all nodes in the cluster. On the master, the value is
+ * only serialized and sent to the clients in frames in which it has been modified
+ * through #setValue, the assignment operator, or #modify. On the clients, the value is
+ * updated with the received data before the frame is rendered. The type \p T has to be
+ * supported by ByteWriter::write and ByteReader::read. The shared objects are sent in
+ * addition to the data of the encode function that is set on SharedData.
+ */
+template <typename T>
+class SharedObject : public SharedObjectBase {
+public:
+    explicit SharedObject(uint32_t id, T value = T())
+        : SharedObjectBase(id)
+        , _value(std::move(value))
+    {}
+
+    const T& value() const {
+        return _value;
+    }
+
+    void setValue(T value) {
+        _value = std::move(value);
+        setDirty();
+    }
+
+    SharedObject& operator=(T value) {
+        setValue(std::move(value));
+        return *this;
+    }
+
+    /**
+     * Calls \p fn with a reference to the value, which allows modifying it in-place, and
+     * marks the value as modified.
+     */
+    template <typename Fn>
+    void modify(Fn&& fn) {
+        fn(_value);
+        setDirty();
+    }
+
+private:
+    void serialize(ByteWriter& writer) const override {
+        writer.write(_value);
+    }
+
+    void deserialize(ByteReader& reader) override {
+        reader.read(_value);
+    }
+
+    T _value;
+};
+
 } // namespace sgct
 
 #endif // __SGCT__SHAREDDATA__H__
@@ -0,0 +1,78 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SHAREDMEMORY__H__
+#define __SGCT__SHAREDMEMORY__H__
+
+#include <sgct/sgctexports.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * A named shared memory segment through which the master passes the shared data blocks
+ * to a client running on the same computer, so that the blocks do not have to be copied
+ * through the loopback network interface. The segment contains a small ring of slots
+ * that are indexed by the frame number. Each slot is protected by a sequence lock, which
+ * lets the client detect if the master has overwritten a slot while it was being read.
+ */
+class SGCT_EXPORT SharedMemory {
+public:
+    /// The number of frames that are kept in the segment at the same time
+    static constexpr int NumberOfSlots = 4;
+
+    /// The maximum size of a single data block in bytes
+    static constexpr uint32_t SlotCapacity = 4 * 1024 * 1024;
+
+    /**
+     * \param name The name of the segment, which has to be the same on both sides
+     * \param isServer If `true`, the segment is created and removed again when this
+     *        object is destroyed. Otherwise, an existing segment is opened
+     */
+    SharedMemory(std::string name, bool isServer);
+    ~SharedMemory();
+
+    /**
+     * Stores the \p data block for the provided \p frame in the segment.
+     *
+     * \return `false` if the block is larger than the #SlotCapacity
+     */
+    bool write(int32_t frame, const char* data, uint32_t length);
+
+    /**
+     * Copies the block of the provided \p frame from the segment into \p data.
+     *
+     * \return `false` if the slot no longer contains the block of this \p frame
+     */
+    bool read(int32_t frame, std::vector<char>& data) const;
+
+private:
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory(SharedMemory&&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+    SharedMemory& operator=(SharedMemory&&) = delete;
+
+    struct Slot;
+    Slot& slot(int32_t frame) const;
+
+    const std::string _name;
+    const bool _isServer;
+    size_t _size = 0;
+    char* _memory = nullptr;
+#ifdef WIN32
+    void* _handle = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    int _fd = -1;
+#endif // WIN32
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SHAREDMEMORY__H__
@@ -0,0 +1,118 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SORTLASTCOMPOSITOR__H__
+#define __SGCT__SORTLASTCOMPOSITOR__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Composites the images that several nodes render into windows with the same id into one
+ * image by comparing their depth, so that each node only has to hold a part of the data
+ * of the scene. The nodes exchange their images with the binary swap algorithm: in each
+ * round, every node sends one half of the rows that it is responsible for to a partner
+ * and composites the other half with the rows that it receives from the partner, which
+ * halves the rows in every round. If the number of nodes is not a power of two, the
+ * remaining nodes first send their whole image to one of the other nodes. Finally, all
+ * nodes send their composited rows to the output node, which shows the composited image.
+ *
+ * The images are sent as data transfers, which the master relays to the nodes that they
+ * are meant for, so the compositing requires the star transfer topology.
+ */
+class SGCT_EXPORT SortLastCompositor {
+public:
+    /**
+     * The package id of the data transfers that contain the parts of the images. These
+     * transfers are not passed to the data transfer callbacks of the application.
+     */
+    static constexpr int PackageId = std::numeric_limits<int>::min() + 3;
+
+    /// The nodes that composite the images of one window
+    struct Group {
+        /// The nodes that render a part of the data, in the order of their partitions
+        std::vector<int> nodes;
+        /// The node that shows the composited image
+        int output = 0;
+    };
+
+    /// The part of the data that this node renders into a window that is composited
+    struct Partition {
+        /// The zero-based index of the part of the data that this node renders
+        int index = 0;
+        /// The number of parts into which the data is split
+        int count = 1;
+    };
+
+    /// The image of a window, with the rows starting at the bottom
+    struct Image {
+        ivec2 size = ivec2(0, 0);
+        /// The number of bytes of the color of each pixel
+        int bytesPerPixel = 4;
+        std::vector<std::byte> color;
+        /// The depth of each pixel in the range [0, 1], where smaller values are closer
+        std::vector<float> depth;
+    };
+
+    /**
+     * Composites the \p image of the window with the \p window id for the \p eye with the
+     * images of the other nodes of the \p group, which have to call this function in the
+     * same frame. This function is called on the render thread and blocks until the parts
+     * of the images of the other nodes have arrived or have timed out.
+     *
+     * \return `true` if this node is the output node, in which case the \p image contains
+     *         the composited image afterwards
+     */
+    bool composite(const Group& group, int window, int eye, Image& image);
+
+    /**
+     * Handles a data transfer with a part of an image. The master forwards the parts that
+     * are meant for other nodes. This function is called internally by SGCT and shouldn't
+     * be used by the user.
+     */
+    void receive(const void* data, int length);
+
+private:
+    // A part of an image with the rows [firstRow, firstRow + nRows)
+    struct Part {
+        unsigned int frame = 0;
+        int firstRow = 0;
+        int nRows = 0;
+        std::vector<std::byte> color;
+        std::vector<float> depth;
+    };
+
+    // The most recent part that has been received for each window, eye, and stage
+    struct Slot {
+        Part part;
+        bool isValid = false;
+    };
+
+    void send(int node, uint32_t key, int firstRow, int nRows, const Image& image) const;
+    bool take(uint32_t key, unsigned int frame, Part& part);
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::map<uint32_t, Slot> _slots;
+    // Reused for the parts that are received on the render thread
+    Part _part;
+    bool _hasWarned = false;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SORTLASTCOMPOSITOR__H__
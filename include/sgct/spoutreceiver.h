@@ -0,0 +1,83 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SPOUTRECEIVER__H__
+#define __SGCT__SPOUTRECEIVER__H__
+
+#ifdef SGCT_HAS_SPOUT
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <memory>
+#include <string>
+
+struct SPOUTLIBRARY;
+typedef SPOUTLIBRARY* SPOUTHANDLE;
+
+namespace sgct {
+
+class SpoutSharedTexture;
+
+/**
+ * Receives the content of a Spout sender as an OpenGL texture. The texture is the one
+ * that the sender writes into, which is linked to OpenGL through the WGL_NV_DX_interop
+ * extension, so the content is neither copied on the GPU nor downloaded to the CPU. The
+ * sender does not have to exist when the receiver is created and can be closed and
+ * reopened at any time.
+ *
+ * As the texture is shared with DirectX, its first row is the top of the image and the
+ * texture coordinates have to be flipped vertically when it is sampled.
+ */
+class SGCT_EXPORT SpoutReceiver {
+public:
+    /**
+     * Creates the receiver for the sender with the \p senderName.
+     */
+    explicit SpoutReceiver(std::string senderName);
+    ~SpoutReceiver();
+
+    /**
+     * Locks the texture of the sender for this frame. This has to be called once per
+     * frame with the OpenGL context current before the #texture is used and releases the
+     * texture of the previous frame. If the sender has been resized or restarted, its new
+     * texture is opened.
+     *
+     * \return `true` if the #texture can be used until the next call
+     */
+    bool update();
+
+    /**
+     * \return The texture with the content of the sender or 0 if the last call to #update
+     *         did not succeed
+     */
+    unsigned int texture() const;
+
+    /**
+     * \return The size of the content of the sender in pixels
+     */
+    ivec2 size() const;
+
+private:
+    SpoutReceiver(const SpoutReceiver&) = delete;
+    SpoutReceiver& operator=(const SpoutReceiver&) = delete;
+
+    const std::string _senderName;
+    SPOUTHANDLE _handle = nullptr;
+
+    // The DirectX handle of the texture that is open, which changes if the sender is
+    // resized or restarted
+    void* _shareHandle = nullptr;
+    std::unique_ptr<SpoutSharedTexture> _texture;
+    ivec2 _size = ivec2(0, 0);
+    bool _isLocked = false;
+};
+
+} // namespace sgct
+
+#endif // SGCT_HAS_SPOUT
+#endif // __SGCT__SPOUTRECEIVER__H__
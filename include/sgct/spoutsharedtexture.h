@@ -0,0 +1,86 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SPOUTSHAREDTEXTURE__H__
+#define __SGCT__SPOUTSHAREDTEXTURE__H__
+
+#ifdef SGCT_HAS_SPOUT
+
+#include <sgct/sgctexports.h>
+#include <memory>
+#include <string>
+
+struct SPOUTLIBRARY;
+typedef SPOUTLIBRARY* SPOUTHANDLE;
+
+namespace sgct {
+
+/**
+ * The DirectX texture that Spout shares for a sender, linked to an OpenGL texture through
+ * the WGL_NV_DX_interop extension. Content that is drawn or blitted into the OpenGL
+ * texture while it is locked is immediately visible to the receivers of the sender, so
+ * the sender does not have to send a copy of it every frame. The rows of the texture are
+ * stored from the top, as DirectX expects them, so content has to be written upside
+ * down compared to an OpenGL texture.
+ */
+class SGCT_EXPORT SpoutSharedTexture {
+public:
+    enum class Access {
+        /// The texture is only sampled, as by a receiver
+        Read,
+        /// The texture is only written and its previous content is discarded
+        Write
+    };
+
+    /**
+     * Opens the shared texture of the sender with the \p senderName through the
+     * \p handle, which is either the handle that created the sender or one of a
+     * receiver. Has to be called with the OpenGL context current that uses the texture.
+     *
+     * \return The shared texture, or `nullptr` if the interop extension is not available
+     *         or the texture could not be opened
+     */
+    static std::unique_ptr<SpoutSharedTexture> open(SPOUTHANDLE handle,
+        const std::string& senderName, Access access = Access::Write);
+
+    ~SpoutSharedTexture();
+
+    /**
+     * \return The OpenGL texture that is linked to the shared texture, which can only be
+     *         used while it is locked
+     */
+    unsigned int texture() const;
+
+    /**
+     * Gives OpenGL access to the texture until #unlock is called. A locked texture can't
+     * be read by the receivers.
+     *
+     * \return `true` if the texture can be used
+     */
+    bool lock();
+
+    void unlock();
+
+private:
+    struct Interop;
+
+    SpoutSharedTexture() = default;
+    SpoutSharedTexture(const SpoutSharedTexture&) = delete;
+    SpoutSharedTexture& operator=(const SpoutSharedTexture&) = delete;
+
+    std::shared_ptr<Interop> _interop;
+    void* _dxTexture = nullptr;
+    void* _object = nullptr;
+    unsigned int _texture = 0;
+    bool _isLocked = false;
+};
+
+} // namespace sgct
+
+#endif // SGCT_HAS_SPOUT
+#endif // __SGCT__SPOUTSHAREDTEXTURE__H__
@@ -0,0 +1,101 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__STATISTICSHISTORY__H__
+#define __SGCT__STATISTICSHISTORY__H__
+
+#include <sgct/sgctexports.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace sgct {
+
+/**
+ * The most recent values of one statistic, which are stored in a ring buffer so that
+ * adding a value only overwrites the oldest one. Values are added by a single thread,
+ * while any number of other threads can copy a consistent snapshot of them at the same
+ * time without taking a lock. A reader that overlaps with a new value being added
+ * retries its copy instead of mixing old and new values.
+ */
+class SGCT_EXPORT StatisticsHistory {
+public:
+    /// The number of values that are kept unless another length is requested
+    static constexpr int DefaultLength = 128;
+
+    explicit StatisticsHistory(int length = DefaultLength);
+
+    /**
+     * Changes the number of values that are kept and removes all values. This function
+     * must not be called while other threads access the history.
+     */
+    void setLength(int length);
+
+    /**
+     * Adds the \p value as the newest value, replacing the oldest value if the history
+     * is full. Only one thread may add values.
+     */
+    void add(double value);
+
+    /**
+     * \return The number of values that can be kept
+     */
+    int length() const;
+
+    /**
+     * \return The number of values that are currently kept, which is smaller than the
+     *         length until enough values have been added
+     */
+    int size() const;
+
+    /**
+     * \return The total number of values that were added so far, which lets a reader
+     *         find out how many values were added since its last copy
+     */
+    uint64_t count() const;
+
+    /**
+     * Returns the value that was added \p age values before the newest one, or 0 if
+     * fewer values are kept. Reading values one at a time is only consistent on the
+     * thread that adds them, other threads should use #copy instead.
+     *
+     * \param age The age of the value, where 0 is the newest value
+     */
+    double operator[](int age) const;
+
+    /**
+     * \return The newest value, or 0 if no value has been added yet
+     */
+    double newest() const;
+
+    /**
+     * Copies the newest values into \p values, starting with the newest one. This can be
+     * called from any thread while values are being added.
+     *
+     * \return The number of values that were copied, which is the smaller of the size
+     *         of \p values and the number of values that are kept
+     */
+    int copy(std::span<double> values) const;
+
+private:
+    StatisticsHistory(const StatisticsHistory&) = delete;
+    StatisticsHistory(StatisticsHistory&&) = delete;
+    StatisticsHistory& operator=(const StatisticsHistory&) = delete;
+    StatisticsHistory& operator=(StatisticsHistory&&) = delete;
+
+    std::unique_ptr<std::atomic<double>[]> _values;
+    int _length = 0;
+    std::atomic_uint64_t _count = 0;
+    // Odd while a value is being written, so that readers know to try again
+    std::atomic_uint64_t _sequence = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__STATISTICSHISTORY__H__
@@ -12,7 +12,11 @@
 #include <sgct/sgctexports.h>
 #include <sgct/engine.h>
 #include <sgct/shaderprogram.h>
+#include <array>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace sgct { class Window; }
 
@@ -39,78 +43,84 @@ private:
     int _mvpLoc = -1;
     int _colorLoc = -1;
 
-    struct Vertex {
-        float x = 0.f;
-        float y = 0.f;
-    };
+    // Generates the vertices of the lines from the values in the buffer texture
+    ShaderProgram _lineShader;
+    struct {
+        int mvp = -1;
+        int color = -1;
+        int offset = -1;
+        int newest = -1;
+        int size = -1;
+    } _lineLocs;
+
+    // Generates the vertices of the histogram bins from the counts in the buffer texture
+    ShaderProgram _histogramShader;
+    struct {
+        int mvp = -1;
+        int color = -1;
+        int offset = -1;
+        int maxBin = -1;
+    } _histogramLocs;
+
     struct Lines {
         struct {
             unsigned int vao = 0;
             unsigned int vbo = 0;
             int nLines = 0;
         } staticDraw;
-
-        struct {
-            unsigned int vao = 0;
-            unsigned int vbo = 0;
-        } dynamicDraw;
-
-
-        struct Vertices {
-            // The implementation requires frametimes to be the first element so beware
-            std::array<Vertex, Engine::Statistics::HistoryLength> frametimes;
-            std::array<Vertex, Engine::Statistics::HistoryLength> drawTimes;
-            std::array<Vertex, Engine::Statistics::HistoryLength> syncTimes;
-            std::array<Vertex, Engine::Statistics::HistoryLength> loopTimeMin;
-            std::array<Vertex, Engine::Statistics::HistoryLength> loopTimeMax;
-        };
-        Vertices buffer;
     };
     Lines _lines;
 
+    // The axes of the histograms followed by a unit quad for the bars of the nodes
     struct Histogram {
         // Each bin covers 1ms
         static constexpr int Bins = 128;
 
-        struct Values {
-            std::array<int, Bins> frametimes = {};
-            std::array<int, Bins> drawTimes = {};
-            std::array<int, Bins> syncTimes = {};
-            std::array<int, Bins> loopTimeMin = {};
-            std::array<int, Bins> loopTimeMax = {};
-        };
-        Values values;
-
-        struct Vertices {
-            // The implementation requires frametimes to be the first element so beware
-            std::array<Vertex, 6 * Bins> frametimes = {};
-            std::array<Vertex, 6 * Bins> drawTimes = {};
-            std::array<Vertex, 6 * Bins> syncTimes = {};
-            std::array<Vertex, 6 * Bins> loopTimeMin = {};
-            std::array<Vertex, 6 * Bins> loopTimeMax = {};
-        };
-        Vertices buffer;
-
-        struct {
-            int frametimes = 0;
-            int drawTimes = 0;
-            int syncTimes = 0;
-            int loopTimeMin = 0;
-            int loopTimeMax = 0;
-        } maxBinValue;
-
         struct {
             unsigned int vao = 0;
             unsigned int vbo = 0;
         } staticDraw;
-
-        struct {
-            unsigned int vao = 0;
-            unsigned int vbo = 0;
-        } dynamicDraw;
     };
     Histogram _histogram;
 
+    // The frame, draw, sync, minimum loop, and maximum loop times that are shown
+    static constexpr int NStatistics = 5;
+
+    // The part of a statistic that has already been transferred into the buffer texture
+    struct Statistic {
+        const StatisticsHistory* history = nullptr;
+        double histogramScale = 0.0;
+        // The number of values of the history that have been transferred so far
+        uint64_t count = 0;
+        std::array<int, Histogram::Bins> bins = {};
+        int maxBin = 1;
+    };
+    std::array<Statistic, NStatistics> _statisticsState;
+
+    // The buffer texture first contains the values of each statistic at the same place
+    // in which they are stored in the ring buffer of its history, followed by the bins
+    // of all histograms. Only values that were added since the last update are uploaded
+    unsigned int _valueBuffer = 0;
+    unsigned int _valueTexture = 0;
+    // A copy of the values in the buffer texture, so that the bins of the values that are
+    // replaced can be decremented
+    std::vector<float> _values;
+    std::array<float, NStatistics * Histogram::Bins> _binValues = {};
+
+    // The statistics that the clients sent to the master, together with whether they
+    // stand out from the statistics of the other clients
+    struct Node {
+        std::optional<Network::NodeStatistics> statistics;
+        bool isSlow = false;
+        // The number of updates since the client last dropped a frame
+        uint64_t updatesSinceDrop = std::numeric_limits<uint64_t>::max();
+    };
+    std::vector<Node> _nodes;
+
+    // The vertices of the lines and histograms are generated in the shaders, but a vertex
+    // array still has to be bound to draw them
+    unsigned int _emptyVao = 0;
+
     float _scale = 0.5f;
     vec2 _offset;
 };
@@ -0,0 +1,124 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SYNCRECORDING__H__
+#define __SGCT__SYNCRECORDING__H__
+
+#include <sgct/sgctexports.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace sgct {
+
+namespace correction { class MappedFile; }
+
+/**
+ * Records the shared data that the master sends to the clients in every frame into a
+ * memory-mapped file, together with the number and the time of the frame. The file
+ * grows as frames are added and is complete up to the last added frame even if the
+ * application crashes. Once the recorder is destroyed, the file is truncated to the
+ * recorded frames. A recording is played back by a SyncReplay, which makes the
+ * performance of a live show reproducible.
+ */
+class SGCT_EXPORT SyncRecorder {
+public:
+    /**
+     * Creates the recording at the \p path, replacing an existing file.
+     *
+     * \return The recorder, or `nullptr` if the file cannot be created, in which case an
+     *         error is logged
+     */
+    static std::unique_ptr<SyncRecorder> create(const std::filesystem::path& path);
+
+    ~SyncRecorder();
+
+    /**
+     * Appends the shared \p data of the frame with the \p frameNumber that was sent at
+     * the \p time in seconds. If the file cannot grow, an error is logged and this and
+     * all following frames are dropped.
+     */
+    void addFrame(uint64_t frameNumber, double time, std::span<const std::byte> data);
+
+    /**
+     * \return The number of frames that have been recorded
+     */
+    uint64_t nFrames() const;
+
+private:
+    SyncRecorder() = default;
+    SyncRecorder(const SyncRecorder&) = delete;
+    SyncRecorder& operator=(const SyncRecorder&) = delete;
+
+    bool map(size_t capacity);
+    void unmap();
+
+    std::filesystem::path _path;
+    std::byte* _memory = nullptr;
+    // The size of the file and of its mapping, of which the first _size bytes are used
+    size_t _capacity = 0;
+    size_t _size = 0;
+    uint64_t _nFrames = 0;
+    bool _isFailed = false;
+#ifdef WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    int _file = -1;
+#endif // WIN32
+};
+
+/**
+ * Plays back a recording of a SyncRecorder, whose frames the master sends to the clients
+ * instead of the data of its encode functions.
+ */
+class SGCT_EXPORT SyncReplay {
+public:
+    struct Frame {
+        /// The number of the frame in the recorded session
+        uint64_t frameNumber = 0;
+        /// The time in seconds at which the frame was sent in the recorded session
+        double time = 0.0;
+        /// The shared data of the frame, which stays valid as long as the replay exists
+        std::span<const std::byte> data;
+    };
+
+    /**
+     * Opens the recording at the \p path.
+     *
+     * \throw Error If the file cannot be opened or is not a recording
+     */
+    explicit SyncReplay(const std::filesystem::path& path);
+
+    ~SyncReplay();
+
+    /**
+     * \return The next frame of the recording, or `std::nullopt` once all frames have
+     *         been returned
+     * \throw Error If the frame is malformed
+     */
+    std::optional<Frame> nextFrame();
+
+    /**
+     * \return The number of frames in the recording
+     */
+    uint64_t nFrames() const;
+
+private:
+    std::unique_ptr<correction::MappedFile> _file;
+    uint64_t _nFrames = 0;
+    uint64_t _nextFrame = 0;
+    size_t _offset = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SYNCRECORDING__H__
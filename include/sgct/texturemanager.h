@@ -10,26 +10,87 @@
 #define __SGCT__TEXTUREMANAGER__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <array>
+#include <deque>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace sgct {
 
+class CompressedImage;
 class Image;
 
 /**
  * The TextureManager loads and handles textures. It is a singleton and can be accessed
- * anywhere using its static instance. Currently only PNG textures are supported.
+ * anywhere using its static instance. Currently only PNG textures are supported, in
+ * addition to KTX2 and DDS files that contain GPU-compressed textures.
  */
 class SGCT_EXPORT TextureManager {
+    struct AsyncState;
+
 public:
+    /**
+     * Refers to a texture that is loaded by loadTextureAsync. The texture can be used
+     * once it is ready, which happens during one of the following frames. A
+     * default-constructed AsyncTexture refers to no texture and has failed.
+     */
+    class SGCT_EXPORT AsyncTexture {
+    public:
+        enum class Status {
+            /// The image file is being decoded on a worker thread
+            Decoding,
+            /// The image is streamed into the texture, or its mipmaps are generated
+            Uploading,
+            /// The texture has been uploaded completely and can be used
+            Ready,
+            /// The image file could not be loaded, so no texture was created
+            Failed
+        };
+
+        AsyncTexture() = default;
+
+        Status status() const;
+
+        /**
+         * \return The OpenGL name of the texture once it is ready, or 0 otherwise
+         */
+        unsigned int id() const;
+
+    private:
+        friend class TextureManager;
+
+        std::shared_ptr<AsyncState> _state;
+    };
+
+    /**
+     * The place of an image that was loaded into a layer of an array texture by
+     * loadTextureArray.
+     */
+    struct ArrayLayer {
+        /// The OpenGL name of the `GL_TEXTURE_2D_ARRAY` that contains the image, or 0 if
+        /// the image could not be loaded
+        unsigned int texture = 0;
+
+        /// The layer of the array texture that contains the image
+        int layer = 0;
+
+        /// The image covers the part of its layer from the origin to this point. It is
+        /// smaller than 1 if other images in the array texture are larger, so the texture
+        /// coordinates of the image have to be multiplied with this value
+        vec2 uvScale = vec2(1.f, 1.f);
+    };
+
     static TextureManager& instance();
     static void destroy();
 
     /**
      * Loads a texture to the TextureManager.
      *
-     * \param filename The path to the texture
+     * \param filename The path to the texture. KTX2 and DDS files are loaded as
+     *        compressed textures with the mipmap levels that are stored in the file
      * \param interpolate Set to true for using interpolation (bi-linear filtering)
      * \param anisotropicFilterSize The filter size that is used for the anisotropic
      *        filtering. If this value is 1.f, only bilinear filtering is used
@@ -54,6 +115,70 @@ public:
     unsigned int loadTexture(const Image& img, bool interpolate = true,
         float anisotropicFilterSize = 1.f, int mipmapLevels = 8);
 
+    /**
+     * Loads a GPU-compressed texture to the TextureManager. The compressed mipmap levels
+     * of the image are uploaded as they are, as mipmaps cannot be generated for
+     * compressed textures.
+     *
+     * \param img The image with the compressed texture data
+     * \param interpolate Set to true for using interpolation (bi-linear filtering)
+     * \param anisotropicFilterSize The filter size that is used for the anisotropic
+     *        filtering. If this value is 1.f, only bilinear filtering is used
+     * \param mipmapLevels The maximum number of mipmap levels that are uploaded from
+     *        the image, setting this value to 1 or less disables mipmaps
+     * \return The OpenGL name for the texture that was loaded
+     */
+    unsigned int loadTexture(const CompressedImage& img, bool interpolate = true,
+        float anisotropicFilterSize = 1.f, int mipmapLevels = 8);
+
+    /**
+     * Loads many textures into as few array textures as possible, so that they can be
+     * drawn without binding a different texture for each of them. All images with the
+     * same number of channels are placed into the layers of the same array texture,
+     * whose size is that of the largest of these images. A shader samples an image with
+     * the layer and scaled texture coordinates of its ArrayLayer. Array textures are
+     * removed with removeTexture once none of their layers is needed anymore.
+     *
+     * \param filenames The paths to the textures
+     * \param interpolate Set to true for using interpolation (bi-linear filtering)
+     * \param anisotropicFilterSize The filter size that is used for the anisotropic
+     *        filtering. If this value is 1.f, only bilinear filtering is used
+     * \param mipmapLevels The number of mipmap levels that will be generated, setting
+     *        this value to 1 or less disables mipmaps
+     * \return The place of each texture, in the same order as the \p filenames
+     */
+    std::vector<ArrayLayer> loadTextureArray(
+        std::span<const std::filesystem::path> filenames, bool interpolate = true,
+        float anisotropicFilterSize = 1.f, int mipmapLevels = 8);
+
+    /**
+     * Loads a texture without blocking the calling thread. The image file is decoded by
+     * the job system of the Engine. The pixels are then streamed into the texture
+     * through pixel buffer objects, and the mipmaps are generated, in steps which are
+     * limited by the upload budget of each frame. The parameters are the same as for
+     * the synchronous loadTexture.
+     *
+     * \return The handle through which the status and name of the texture are queried
+     */
+    AsyncTexture loadTextureAsync(std::filesystem::path filename, bool interpolate = true,
+        float anisotropicFilterSize = 1.f, int mipmapLevels = 8);
+
+    /**
+     * Sets the time that is spent at most on uploading textures that are loaded
+     * asynchronously in each frame. At least one step is made in every frame, so a
+     * texture is always uploaded eventually. The default budget is 2 ms.
+     *
+     * \param milliseconds The upload budget of each frame in milliseconds
+     */
+    void setUploadBudget(double milliseconds);
+
+    /**
+     * Continues the uploads of the textures that are loaded asynchronously. This
+     * function is called internally by SGCT once per frame and shouldn't be used by the
+     * user.
+     */
+    void update();
+
     /**
      * Removes a previously generated OpenGL texture.
      *
@@ -64,8 +189,20 @@ public:
 
 private:
     ~TextureManager();
+
+    // Makes the next step for the \p state, which uploads one band of rows or generates
+    // the mipmaps
+    void uploadStep(AsyncState& state);
+
     static TextureManager* _instance;
     std::vector<unsigned int> _textures;
+
+    std::deque<std::shared_ptr<AsyncState>> _pending;
+    // The pixel buffer objects through which the rows are uploaded are used in turn, so
+    // that the driver can copy from one while the next one is filled
+    std::array<unsigned int, 3> _pbos = {};
+    size_t _nextPbo = 0;
+    double _uploadBudget = 0.002;
 };
 
 } // namespace sgct
@@ -0,0 +1,49 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__THREADPOLICY__H__
+#define __SGCT__THREADPOLICY__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/config.h>
+#include <string_view>
+
+namespace sgct {
+
+/**
+ * Applies the names, priorities, and processor cores that are configured for the classes
+ * of threads that SGCT creates. Each thread calls #apply with its class when it starts,
+ * so that for example the network threads can be kept apart from the capture threads,
+ * which would otherwise preempt them and delay the synchronization of the nodes. If no
+ * priority is configured, the render and network threads run with a high priority and
+ * all other threads with the normal priority.
+ */
+class SGCT_EXPORT ThreadPolicy {
+public:
+    enum class Class { Render, Network, Tracking, Capture, Logging };
+
+    /**
+     * Sets the settings of the thread classes that are applied by the threads that start
+     * afterwards. The threads that are already running keep their settings.
+     */
+    static void configure(const config::Settings::Threads& threads);
+
+    /**
+     * Applies the settings of the \p threadClass to the calling thread. The thread is
+     * named by the name of its class followed by the \p name, which distinguishes the
+     * threads of the same class. If the \p name is empty, the thread keeps its name,
+     * which is used for the main thread whose name is the name of the process. Settings
+     * that cannot be applied, for example because the process lacks the permission to
+     * raise the priority, are logged once per class and otherwise ignored.
+     */
+    static void apply(Class threadClass, std::string_view name);
+};
+
+} // namespace sgct
+
+#endif // __SGCT__THREADPOLICY__H__
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__TRACER__H__
+#define __SGCT__TRACER__H__
+
+#include <sgct/sgctexports.h>
+#include <filesystem>
+#include <string>
+
+namespace sgct {
+
+/**
+ * A lightweight tracer that, unlike the Tracy instrumentation, is part of every build and
+ * only records anything once it has been enabled. Each thread records the begin and end
+ * times of the scopes that are marked with #TraceScopedN into a ring buffer of its own,
+ * without taking a lock, so that only the most recent #EventsPerThread scopes of each
+ * thread are kept. The recorded scopes are written as a Chrome trace file, which can be
+ * opened in Perfetto or in `chrome://tracing`, either on request or when the application
+ * crashes. All times are converted to the clock of the master node, so that the trace
+ * files of all nodes line up when they are viewed together.
+ */
+class SGCT_EXPORT Tracer {
+public:
+    /// The number of scopes that are kept for each thread
+    static constexpr int EventsPerThread = 16384;
+
+    /**
+     * Starts recording the scopes of all threads. The trace files are written into the
+     * \p folder, which is created if it does not exist, and the scopes of this node are
+     * grouped as a process with the \p nodeId. This also installs signal handlers that
+     * write the trace when the application crashes.
+     */
+    static void enable(std::filesystem::path folder, int nodeId);
+
+    /**
+     * \return `true` if the scopes are being recorded
+     */
+    static bool isEnabled();
+
+    /**
+     * Sets the \p name under which the scopes of the calling thread are shown.
+     */
+    static void setThreadName(std::string name);
+
+    /**
+     * Sets the \p offset in seconds that is added to the local time to get the time of
+     * the master node. This is applied to all recorded times when they are written.
+     */
+    static void setClockOffset(double offset);
+
+    /**
+     * Adds a scope with the \p name that lasted from \p begin to \p end, both of which
+     * are local times as returned by sgct::time, to the ring buffer of the calling
+     * thread. The \p name has to stay valid until the application ends, which string
+     * literals do.
+     */
+    static void record(const char* name, double begin, double end);
+
+    /**
+     * Writes the scopes that are currently kept for all threads into a new trace file.
+     * Scopes that are recorded by other threads while the file is written are either
+     * included completely or left out.
+     *
+     * \return The path of the trace file, which is empty if the tracer is not enabled or
+     *         the file could not be written
+     */
+    static std::filesystem::path write();
+};
+
+/**
+ * Records the time from its creation until its destruction as a scope of the Tracer,
+ * if the tracer is enabled. If it is not, this only costs a single check.
+ */
+class SGCT_EXPORT TraceScope {
+public:
+    explicit TraceScope(const char* name);
+    ~TraceScope();
+
+private:
+    TraceScope(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+    const char* _name = nullptr;
+    double _begin = 0.0;
+};
+
+} // namespace sgct
+
+#define TraceScopedN(name) const sgct::TraceScope sgctTraceScope(name)
+
+#endif // __SGCT__TRACER__H__
@@ -10,14 +10,23 @@
 #define __SGCT__TRACKINGDEVICE__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/config.h>
 #include <sgct/math.h>
+#include <sgct/posefilter.h>
+#include <sgct/seqlock.h>
+#include <atomic>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace sgct {
 
 /**
- * Helper class that holds tracking device/sensor data.
+ * Helper class that holds tracking device/sensor data. The pose of the sensor is written
+ * by the sampling thread and can be read by any thread without a lock, and the current
+ * and previous poses and their time stamps are always read together. The samples can be
+ * smoothed by a filter, and the pose can be predicted for the time at which the current
+ * frame will be shown.
  */
 class SGCT_EXPORT TrackingDevice {
 public:
@@ -69,6 +78,26 @@ public:
      */
     void setTransform(mat4 mat);
 
+    /**
+     * Set the filter that smooths the samples of the sensor. This has to be called
+     * before the sampling starts.
+     */
+    void setFilter(std::optional<config::Tracker::Device::Filter> filter);
+
+    /**
+     * Set how far ahead and with which model the pose is predicted by
+     * #predictedWorldTransform. This has to be called before the sampling starts.
+     */
+    void setPrediction(std::optional<config::Tracker::Device::Prediction> prediction);
+
+    /**
+     * Sets the pose that a client received from the master, which has already been
+     * filtered and predicted there, in world coordinates. Nothing changes if the pose is
+     * the same as the current one.
+     */
+    void setReceivedPose(vec3 position, quat rotation, vec3 predictedPosition,
+        quat predictedRotation);
+
     const std::string& name() const;
     int numberOfButtons() const;
     int numberOfAxes() const;
@@ -95,6 +124,7 @@ public:
 
     bool isEnabled() const;
     bool hasSensor() const;
+    bool hasPrediction() const;
     bool hasButtons() const;
     bool hasAnalogs() const;
 
@@ -143,6 +173,13 @@ public:
      */
     mat4 worldTransformPrevious() const;
 
+    /**
+     * \return The sensor's transform matrix in world coordinates, extrapolated from the
+     *         last sample to the current time plus the latency of the prediction. If no
+     *         prediction is set, this is the same as #worldTransform
+     */
+    mat4 predictedWorldTransform() const;
+
     /**
      * \return The raw sensor rotation quaternion
      */
@@ -177,11 +214,10 @@ public:
 
 private:
     void calculateTransform();
-    void setTrackerTimeStamp();
     void setAnalogTimeStamp();
     void setButtonTimeStamp(int index);
 
-    bool _isEnabled = true;
+    std::atomic_bool _isEnabled = true;
     const std::string _name;
 #ifdef SGCT_HAS_VRPN
     const int _parentIndex; // the index of parent Tracker
@@ -190,22 +226,37 @@ private:
     int _nAxes = 0;
     int _sensorId = -1;
 
-    mat4 _deviceTransform = mat4(1.f);
+    // Read by the sampling thread for every sample, while the setters that change it
+    // are serialized by the tracking mutex
+    SeqLock<mat4> _deviceTransform = SeqLock<mat4>(mat4(1.f));
+
+    struct Pose {
+        mat4 worldTransform = mat4(1.f);
+        quat sensorRotation = quat{ 0.f, 0.f, 0.f, 0.f };
+        vec3 sensorPosition = vec3{ 0.f, 0.f, 0.f };
+        // The time at which the sample was received
+        double timeStamp = 0.0;
+    };
+    struct Poses {
+        Pose current;
+        Pose previous;
+
+        // The filtered pose of the current sample and its motion in the coordinates of
+        // the tracker, together with the transforms that are applied around it
+        PoseFilter::State state;
+        mat4 parentTransform = mat4(1.f);
+        mat4 deviceTransform = mat4(1.f);
+    };
+    SeqLock<Poses> _poses;
+
+    // Only used by the sampling thread
+    PoseFilter _filter;
+    // Only set while the configuration is applied, before the sampling starts
+    std::optional<config::Tracker::Device::Prediction> _prediction;
 
-    mat4 _worldTransform = mat4(1.f);
-    mat4 _worldTransformPrevious = mat4(1.f);
-
-    quat _sensorRotation = quat{ 0.f, 0.f, 0.f, 0.f };
-    quat _sensorRotationPrevious = quat{ 0.f, 0.f, 0.f, 0.f };
-
-    vec3 _sensorPos = vec3{ 0.f, 0.f, 0.f };
-    vec3 _sensorPosPrevious = vec3{ 0.f, 0.f, 0.f };
     quat _orientation = quat{ 0.f, 0.f, 0.f, 0.f };
     vec3 _offset = vec3{ 0.f, 0.f, 0.f };
 
-    double _trackerTime = 0.0;
-    double _trackerTimePrevious = 0.0;
-
     double _analogTime = 0.0;
     double _analogTimePrevious = 0.0;
 
@@ -10,7 +10,10 @@
 #define __SGCT__TRACKINGMANAGER__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/config.h>
 #include <sgct/tracker.h>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <set>
 #include <string_view>
@@ -19,29 +22,33 @@
 
 namespace sgct {
 
-namespace config {
-    struct Device;
-    struct Tracker;
-} // namespace config
-
 class TrackingDevice;
 class User;
 
 /**
- * Class that manages tracking systems.
+ * Class that manages tracking systems. The devices are only sampled on the master, which
+ * sends their poses, buttons, and axes to the clients with the shared data of every frame
+ * in which they have changed, so that all nodes use the same tracking state.
  */
 class SGCT_EXPORT TrackingManager {
 public:
     static TrackingManager& instance();
     static void destroy();
 
-    void applyDevice(const config::Device& device);
+    void applyDevice(const config::Tracker::Device& device);
     void applyTracker(const config::Tracker& tracker);
 
     void startSampling();
 
     /**
-     * Update the user position if headtracking is used. The engine calls this function.
+     * Links the head of the tracked user on a client, whose devices are not sampled but
+     * updated with the state that is received from the master.
+     */
+    void startReceiving();
+
+    /**
+     * Update the user position if headtracking is used and pass the state of all devices
+     * to the clients. The engine calls this function on the master.
      */
     void updateTrackingDevices();
     void addTracker(std::string name);
@@ -64,6 +71,9 @@ private:
 
     Tracker* tracker(std::string_view name) const;
 
+    // Finds the device that tracks the head of the user
+    bool linkHeadDevice();
+
     void addDeviceToCurrentTracker(std::string name);
     void addSensorToCurrentDevice(std::string address, int id);
     void addButtonsToCurrentDevice(std::string address, int nButtons);
@@ -72,11 +82,17 @@ private:
     std::unique_ptr<std::thread> _samplingThread;
     std::vector<std::unique_ptr<Tracker>> _trackers;
     std::set<std::string> _addresses;
-    double _samplingTime = 0.0;
-    bool _isRunning = true;
+    // The time the sampling thread spent handling the devices, without waiting for samples
+    std::atomic<double> _samplingTime = 0.0;
+    std::atomic_bool _isRunning = true;
 
     User* _headUser = nullptr;
     TrackingDevice* _head = nullptr;
+
+    // The state of all devices that the master sends to the clients
+    class SharedState;
+    std::unique_ptr<SharedState> _sharedState;
+    std::vector<std::byte> _encodeBuffer;
 };
 
 } // namespace sgct
@@ -0,0 +1,244 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__VIDEODECODER__H__
+#define __SGCT__VIDEODECODER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/shaderprogram.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct AVBufferRef;
+struct AVCodec;
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct SwsContext;
+struct __GLsync;
+
+namespace sgct {
+
+/**
+ * Decodes a video file, stream, or capture device into an OpenGL texture. The decoder
+ * prefers the hardware decoders of the GPU vendors and the operating system and only
+ * decodes on the CPU if none of them is available. The frames are decoded on a
+ * background thread, which copies their luma and chroma planes straight into pixel
+ * buffers that are mapped persistently. The rendering thread uploads the planes of the
+ * latest frame into textures and converts them from YUV into RGB in a shader, so the CPU
+ * neither converts nor rescales any pixels. Frames that are decoded faster than they are
+ * rendered are dropped. This class is only available if SGCT was compiled with
+ * `SGCT_VIDEO_CAPTURE_SUPPORT`.
+ *
+ * Files are decoded at the speed at which they are played, while streams and capture
+ * devices are decoded as fast as they deliver their frames. Unlike the frames of the
+ * video, the #texture is oriented as OpenGL expects it, so its first row is the bottom
+ * of the image.
+ *
+ * To show the same frame of a file on all nodes of a cluster, the decoder is created
+ * with Options::decodeAhead and the frame is selected by passing the time of the video
+ * to #update, which is derived from Engine::presentationTime. The frames are then
+ * decoded ahead of the time at which they are shown instead of being paced by the clock
+ * of this node, so no frame is decoded between selecting a frame and drawing it.
+ */
+class SGCT_EXPORT VideoDecoder {
+public:
+    struct Options {
+        /// The name of the input format, for example `dshow`, `avfoundation`, or
+        /// `video4linux2` for a capture device. If it is empty, the format is detected
+        std::string format;
+        /// The options that are passed to the input format, such as `framerate`
+        std::vector<std::pair<std::string, std::string>> parameters;
+        /// Whether a file starts again from the beginning once its end is reached
+        bool loop = false;
+        /// Whether the hardware decoders are tried before the software decoder
+        bool allowHardware = true;
+        /// The number of frames that are decoded ahead of the one that is shown. If it
+        /// is 0, the latest frame is shown as soon as it has been decoded and frames are
+        /// dropped. Otherwise no frame is dropped by the decoder, which waits until one
+        /// of the frames ahead has been shown, and the frames are shown at the time
+        /// that is passed to #update
+        int decodeAhead = 0;
+    };
+
+    /**
+     * Opens the video at the \p url, which is a path, a URL, or the name of a capture
+     * device. Has to be called with the OpenGL context current that uses the texture.
+     *
+     * \throw Error If the video cannot be opened or no decoder is available for it
+     */
+    explicit VideoDecoder(std::string url);
+
+    /**
+     * Opens the video at the \p url with the \p options. Has to be called with the
+     * OpenGL context current that uses the texture.
+     *
+     * \throw Error If the video cannot be opened or no decoder is available for it
+     */
+    VideoDecoder(std::string url, Options options);
+
+    ~VideoDecoder();
+
+    /**
+     * Uploads the latest frame that has been decoded and converts it into the #texture.
+     * This has to be called once per frame with the OpenGL context current before the
+     * #texture is used. The conversion goes into the texture that was not used in the
+     * previous frame, so it does not have to wait for the draw calls that still sample
+     * it.
+     *
+     * \return `true` if the #texture can be used until the next call
+     */
+    bool update();
+
+    /**
+     * Uploads the latest frame that has been decoded and that is due at the \p time and
+     * converts it into the #texture. The frames that are older than it are dropped. Like
+     * #update, this has to be called once per frame with the OpenGL context current.
+     *
+     * \param time The time in seconds since the start of the video. If the video is
+     *        looped, the time continues to grow with every repetition
+     * \return `true` if the #texture can be used until the next call
+     */
+    bool update(double time);
+
+    /**
+     * \return The texture with the latest frame or 0 if no frame has been decoded yet
+     */
+    unsigned int texture() const;
+
+    /**
+     * \return The size of the latest frame in pixels
+     */
+    ivec2 size() const;
+
+    /**
+     * \return The name of the hardware device that decodes the video, such as `cuda`,
+     *         `d3d11va`, or `vaapi`, or an empty string if it is decoded on the CPU
+     */
+    const std::string& hardwareDevice() const;
+
+    /**
+     * \return `true` if the end of the video has been reached and all of its frames
+     *         have been decoded. This never happens if the video is looped
+     */
+    bool hasEnded() const;
+
+private:
+    // The pixel buffers that the planes of the frames are decoded into
+    struct Slot {
+        enum class State {
+            /// Can be written by the decoding thread
+            Free,
+            /// Is being written by the decoding thread
+            Writing,
+            /// Holds a frame that has not been uploaded yet
+            Filled,
+            /// Is being read by the GPU until the fence is signaled
+            Uploading
+        };
+        State state = State::Free;
+        unsigned int pbo = 0;
+        // Only set if the buffer is mapped persistently, otherwise the frame is copied
+        // into the data and uploaded from there
+        std::byte* mapping = nullptr;
+        std::vector<std::byte> data;
+        size_t capacity = 0;
+
+        ivec2 size = ivec2(0, 0);
+        // The chroma is either stored interleaved in one plane (NV12) or in two planes
+        // (I420)
+        int nPlanes = 0;
+        std::array<size_t, 3> offsets = { 0, 0, 0 };
+        std::array<int, 3> strides = { 0, 0, 0 };
+        // The luma coefficients of red and blue of the color space of the frame
+        float kr = 0.f;
+        float kb = 0.f;
+        bool isFullRange = false;
+        // The time in seconds since the start of the video at which the frame is shown
+        double time = 0.0;
+        uint64_t frame = 0;
+        __GLsync* fence = nullptr;
+    };
+
+    VideoDecoder(const VideoDecoder&) = delete;
+    VideoDecoder(VideoDecoder&&) = delete;
+    VideoDecoder& operator=(const VideoDecoder&) = delete;
+    VideoDecoder& operator=(VideoDecoder&&) = delete;
+
+    void open(const Options& options);
+    void openHardwareDevice(const AVCodec& decoder);
+    void release();
+    void decode();
+    void store(const AVFrame& frame, double time);
+    void allocate(Slot& slot, size_t capacity);
+    void convert(const Slot& slot, int target);
+
+    const std::string _url;
+    const bool _loop;
+    const int _decodeAhead;
+    // Whether the frames are written into persistently mapped pixel buffers, which
+    // requires OpenGL 4.4
+    const bool _isPersistent;
+
+    AVFormatContext* _format = nullptr;
+    AVCodecContext* _codec = nullptr;
+    AVBufferRef* _hwDevice = nullptr;
+    // The AVPixelFormat of the frames that are decoded by the hardware device
+    int _hwFormat = -1;
+    std::string _hardwareDevice;
+    int _streamIndex = -1;
+    // Whether the frames are decoded at the speed at which they are played, which is
+    // only the case for files
+    bool _isPaced = false;
+    // Only created for frames whose planes cannot be uploaded directly
+    SwsContext* _conversion = nullptr;
+    AVFrame* _converted = nullptr;
+
+    std::atomic_bool _isRunning = false;
+    std::atomic_bool _hasEnded = false;
+    std::thread _thread;
+
+    // Protects the states of the slots and the required capacity
+    std::mutex _mutex;
+    // Notifies the decoding thread when a slot becomes free while it decodes ahead
+    std::condition_variable _slotFreed;
+    std::vector<Slot> _slots;
+    // Set by the decoding thread if a frame did not fit into the pixel buffers
+    size_t _requiredCapacity = 0;
+    uint64_t _frameCounter = 0;
+
+    // The textures of the luma and chroma planes of the latest frame
+    std::array<unsigned int, 3> _planes = { 0, 0, 0 };
+    ivec2 _planeSize = ivec2(0, 0);
+    int _nPlanes = 0;
+    ShaderProgram _shader;
+    unsigned int _fbo = 0;
+    unsigned int _vao = 0;
+    int _sizeLoc = -1;
+    int _isPlanarLoc = -1;
+    int _conversionLoc = -1;
+    int _offsetLoc = -1;
+
+    std::array<unsigned int, 2> _textures = { 0, 0 };
+    std::array<ivec2, 2> _textureSizes = { ivec2(0, 0), ivec2(0, 0) };
+    // The texture that holds the latest frame or -1 if no frame has been converted yet
+    int _current = -1;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__VIDEODECODER__H__
@@ -0,0 +1,98 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__VIDEOENCODER__H__
+#define __SGCT__VIDEOENCODER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <cstdint>
+#include <filesystem>
+
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+struct AVStream;
+struct SwsContext;
+
+namespace sgct {
+
+/**
+ * Encodes the screenshots of one window into a video file or streams the frames of a
+ * window to a receiver on the network. The encoder prefers the
+ * hardware encoders of the GPU vendors and the operating system and only uses a software
+ * encoder if none of them is available. The hardware encoders that accept BGR(A) pixels
+ * convert them into the color format of the video on the GPU, all other encoders are fed
+ * with frames that are converted by FFmpeg. Streams are encoded without B-frames and
+ * with a rate control buffer of a single frame, so that every frame is sent as soon as
+ * it is encoded. This class is only available if SGCT was compiled with
+ * `SGCT_VIDEO_CAPTURE_SUPPORT`.
+ */
+class SGCT_EXPORT VideoEncoder {
+public:
+    enum class Codec { H264, HEVC };
+    enum class Mode { File, Stream };
+
+    /**
+     * Creates the video file at the \p path, whose container format is determined by
+     * the extension of the \p path, or connects to the receiver of a stream. Streams are
+     * sent as an MPEG transport stream, which is wrapped into RTP for `rtp` URLs.
+     *
+     * \param path The path of the video file, which is replaced if it already exists, or
+     *        the URL of the receiver if the \p mode is Mode::Stream
+     * \param size The size of each frame in pixels
+     * \param nChannels The number of color channels of each pixel, which is 3 or 4
+     * \param codec The codec with which the video is compressed
+     * \param bitrate The target bitrate of the video in kilobits per second
+     * \param frameRate The number of frames per second of the video
+     * \param mode Whether the video is written into a file or sent to a receiver
+     * \throw Error If no encoder is available or the file cannot be created
+     */
+    VideoEncoder(const std::filesystem::path& path, ivec2 size, int nChannels,
+        Codec codec, int bitrate, int frameRate, Mode mode = Mode::File);
+
+    /**
+     * Encodes the frames that are still buffered by the encoder and finishes the file.
+     */
+    ~VideoEncoder();
+
+    /**
+     * Encodes the next frame of the video. The frames have to be passed in the order in
+     * which they are shown, so this function must not be called concurrently.
+     *
+     * \param data The pixels of the frame in BGR(A) order from the bottom row to the top
+     *        row, as they are downloaded from OpenGL
+     * \throw Error If the frame cannot be encoded
+     */
+    void encode(const unsigned char* data);
+
+private:
+    VideoEncoder(const VideoEncoder&) = delete;
+    VideoEncoder(VideoEncoder&&) = delete;
+    VideoEncoder& operator=(const VideoEncoder&) = delete;
+    VideoEncoder& operator=(VideoEncoder&&) = delete;
+
+    void writePackets();
+
+    const ivec2 _size;
+    const int _nChannels;
+    int64_t _nFrames = 0;
+
+    AVFormatContext* _format = nullptr;
+    AVCodecContext* _codec = nullptr;
+    AVStream* _stream = nullptr;
+    AVFrame* _frame = nullptr;
+    AVPacket* _packet = nullptr;
+    // Only set if the encoder does not accept the pixels directly
+    SwsContext* _conversion = nullptr;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__VIDEOENCODER__H__
@@ -12,13 +12,18 @@
 #include <sgct/sgctexports.h>
 #include <sgct/baseviewport.h>
 #include <sgct/correctionmesh.h>
+#include <sgct/jobsystem.h>
+#include <chrono>
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace sgct {
 
+class Image;
 class NonLinearProjection;
 
 /**
@@ -32,36 +37,132 @@ public:
     void initialize(vec2 size, bool hasStereo, unsigned int internalFormat,
         unsigned int format, unsigned int type, uint8_t samples);
 
+    /**
+     * Decodes the overlay and mask images without using OpenGL, so that the viewports can
+     * be prepared on worker threads while the windows are created. This function is
+     * optional and has to be called before #loadData, which creates the textures from
+     * the decoded images.
+     */
+    void prepareData();
+
+    /**
+     * Submits a job to the Engine's job system that parses the correction mesh without
+     * using OpenGL. No job is submitted for the formats that #loadData has to parse as
+     * they also change the viewport. If the mesh is still being parsed when #loadData is
+     * called, the viewport is rendered without warping until #updateMesh finds the job
+     * finished.
+     *
+     * \return The job that parses the correction mesh
+     */
+    JobSystem::Job prepareMesh();
+
     void loadData();
 
+    /**
+     * Loads the correction mesh once the job submitted by #prepareMesh has finished and,
+     * if the Engine settings ask for it, reloads the mesh after its file has changed. The
+     * vertices of a mesh that are computed on the GPU follow the changes of the viewport.
+     * This function has to be called every frame while the window's context is current.
+     *
+     * \throw std::runtime_error If the correction mesh could not be loaded for the first
+     *        time. Errors while reloading it are only logged
+     */
+    void updateMesh();
+
+    /**
+     * Replaces the control points of a correction mesh whose vertices are computed on
+     * the GPU, which has to be enabled in the configuration of the viewport. This has to
+     * be called with the context of the viewport's window current.
+     *
+     * \param points The new control points, which have to be as many as the mesh has
+     * \throw std::runtime_error If the number of \p points is wrong
+     */
+    void setCorrectionMeshPoints(std::span<const correction::WarpGrid::Point> points);
+
+    /**
+     * \return The control points of the correction mesh if its vertices are computed on
+     *         the GPU, or an empty list otherwise
+     */
+    std::span<const correction::WarpGrid::Point> correctionMeshPoints() const;
+
+    /**
+     * Replaces the vertices of an editable correction mesh, which has to be enabled in
+     * the configuration of the viewport, starting at the vertex with the index \p first.
+     * To replace the vertices on all nodes of the cluster, use
+     * Engine::setCorrectionMeshVertices instead. This has to be called with the context
+     * of the viewport's window current.
+     *
+     * \param first The index of the first vertex that is replaced
+     * \param vertices The new vertices, which have to be within the mesh
+     * \throw std::runtime_error If the \p vertices extend past the end of the mesh
+     */
+    void setCorrectionMeshVertices(size_t first,
+        std::span<const correction::Buffer::Vertex> vertices);
+
+    /**
+     * \return The vertices of the correction mesh if it is editable, or an empty list
+     *         otherwise
+     */
+    std::span<const correction::Buffer::Vertex> correctionMeshVertices() const;
+
     void calculateFrustum(FrustumMode mode, float nearClip, float farClip) override;
 
     void renderQuadMesh() const;
     void renderWarpMesh() const;
     void renderMaskMesh() const;
+    void bindWarpMap() const;
 
     bool hasOverlayTexture() const;
     bool hasBlendMaskTexture() const;
     bool hasBlackLevelMaskTexture() const;
+    bool hasWarpMap() const;
+    bool hasCorrectionMesh() const;
     bool hasSubViewports() const;
     bool isTracked() const;
+
+    /**
+     * \return The users that take turns viewing this viewport, one in each frame, or an
+     *         empty list if the viewport is only viewed by its #user. The user of the
+     *         frame that is being rendered is returned by #user, which applications can
+     *         use to share their culling between the viewports of the same user
+     */
+    const std::vector<User*>& users() const;
     unsigned int overlayTextureIndex() const;
     unsigned int blendMaskTextureIndex() const;
     unsigned int blackLevelMaskTextureIndex() const;
     NonLinearProjection* nonLinearProjection() const;
 
+    /**
+     * \return A number that changes whenever the vertices of the warp mesh change
+     */
+    uint64_t meshRevision() const;
+
 private:
+    void loadMesh();
+
     CorrectionMesh _mesh;
     std::filesystem::path _overlayFilename;
     std::filesystem::path _blendMaskFilename;
     std::filesystem::path _blackLevelMaskFilename;
     std::filesystem::path _meshFilename;
     bool _isTracked;
+    std::vector<User*> _users;
     bool _useTextureMappedProjection = false;
     unsigned int _overlayTextureIndex = 0;
     unsigned int _blendMaskTextureIndex = 0;
     unsigned int _blackLevelMaskTextureIndex = 0;
 
+    // The images decoded by prepareData that have not been uploaded yet
+    std::unique_ptr<Image> _overlayImage;
+    std::unique_ptr<Image> _blendMaskImage;
+    std::unique_ptr<Image> _blackLevelMaskImage;
+
+    // The job that parses the correction mesh, which is set until its result is loaded
+    std::optional<JobSystem::Job> _meshPreparation;
+    bool _isMeshLoaded = false;
+    std::optional<std::filesystem::file_time_type> _meshWriteTime;
+    std::chrono::steady_clock::time_point _lastMeshCheck;
+
     std::unique_ptr<NonLinearProjection> _nonLinearProjection;
 };
 
@@ -0,0 +1,145 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__VULKANIMAGE__H__
+#define __SGCT__VULKANIMAGE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <cstdint>
+#include <memory>
+
+namespace sgct {
+
+/**
+ * An image of a Vulkan renderer whose memory is imported into an OpenGL texture through
+ * the GL_EXT_memory_object and GL_EXT_semaphore extensions, so that the content that
+ * Vulkan renders into the image can be used by SGCT without copying it. The access to
+ * the image is synchronized by two semaphores that are exported by the Vulkan renderer.
+ * The renderer signals the ready semaphore when it has finished rendering into the
+ * image, and SGCT signals the released semaphore when it has finished using the image,
+ * after which the renderer can render the next frame into it.
+ *
+ * An image that is set on a Window with Window::setVulkanImages replaces the
+ * framebuffer texture of an eye of that window, so that the warping, blending, and
+ * post-processing of the window are applied to it directly.
+ */
+class SGCT_EXPORT VulkanImage {
+public:
+#ifdef WIN32
+    /// The `HANDLE` of a memory object or a semaphore. The handles remain owned by the
+    /// caller, which has to close them once the image was imported
+    using Handle = void*;
+    static constexpr Handle NoHandle = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    /// The file descriptor of a memory object or a semaphore. The ownership of the file
+    /// descriptors is passed to OpenGL if the image was imported successfully
+    using Handle = int;
+    static constexpr Handle NoHandle = -1;
+#endif // WIN32
+
+    /// The layouts that Vulkan and OpenGL transition the image to and from
+    enum class Layout {
+        General,
+        ColorAttachment,
+        DepthStencilAttachment,
+        ShaderReadOnly
+    };
+
+    struct Info {
+        /// The exported handle of the `VkDeviceMemory` that is bound to the image
+        Handle memory = NoHandle;
+        /// The size in bytes of the whole allocation of the memory
+        uint64_t memorySize = 0;
+        /// The offset in bytes of the image in the memory
+        uint64_t memoryOffset = 0;
+        /// `true` if the memory was allocated as a dedicated allocation of the image
+        bool isDedicated = false;
+
+        /// The size of the image in pixels
+        ivec2 size = ivec2(0, 0);
+        /// The OpenGL internal format that matches the `VkFormat` of the image, for
+        /// example `GL_RGBA8` for `VK_FORMAT_R8G8B8A8_UNORM` or `GL_DEPTH_COMPONENT32F`
+        /// for `VK_FORMAT_D32_SFLOAT`
+        unsigned int internalFormat = 0;
+
+        /// The semaphore that Vulkan signals when the image is ready to be used. If this
+        /// is NoHandle, the application has to synchronize the access itself, which is
+        /// also the case if the depth and the color are signaled by the same semaphore
+        /// and it was only imported with one of them
+        Handle readySemaphore = NoHandle;
+        /// The layout in which Vulkan leaves the image when it signals the ready
+        /// semaphore
+        Layout readyLayout = Layout::ColorAttachment;
+
+        /// The semaphore that OpenGL signals when SGCT has finished using the image
+        Handle releasedSemaphore = NoHandle;
+        /// The layout in which the image is left for Vulkan when the released semaphore
+        /// is signaled
+        Layout releasedLayout = Layout::ColorAttachment;
+    };
+
+    /**
+     * Imports the memory and the semaphores of the image that is described by the
+     * \p info into the current OpenGL context, which has to share its objects with the
+     * contexts of the windows that use the image.
+     *
+     * \return The imported image, or `nullptr` if the interop extensions are not
+     *         available or the image could not be imported
+     */
+    static std::unique_ptr<VulkanImage> import(const Info& info);
+
+    ~VulkanImage();
+
+    /**
+     * \return The OpenGL texture whose storage is the memory of the Vulkan image
+     */
+    unsigned int texture() const;
+
+    /**
+     * \return The size of the image in pixels
+     */
+    ivec2 size() const;
+
+    /**
+     * Makes the OpenGL commands that are issued after this call wait until Vulkan has
+     * signaled the ready semaphore. This has no effect if the image has already been
+     * acquired and not released since. The Vulkan submission that signals the semaphore
+     * has to be submitted before this function is called.
+     */
+    void acquire();
+
+    /**
+     * Signals the released semaphore once the OpenGL commands that have been issued
+     * before this call have finished. This has no effect if the image is not acquired.
+     */
+    void release();
+
+    /**
+     * \return `true` if the image has been acquired and not released since
+     */
+    bool isAcquired() const;
+
+private:
+    VulkanImage() = default;
+    VulkanImage(const VulkanImage&) = delete;
+    VulkanImage& operator=(const VulkanImage&) = delete;
+
+    unsigned int _memory = 0;
+    unsigned int _texture = 0;
+    unsigned int _readySemaphore = 0;
+    unsigned int _releasedSemaphore = 0;
+    unsigned int _readyLayout = 0;
+    unsigned int _releasedLayout = 0;
+    ivec2 _size = ivec2(0, 0);
+    bool _isAcquired = false;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__VULKANIMAGE__H__
@@ -10,10 +10,17 @@
 #define __SGCT__WINDOW__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/antialiasing.h>
+#include <sgct/gputimer.h>
+#include <sgct/memorytracker.h>
+#include <sgct/rendertargetpool.h>
 #include <sgct/shaderprogram.h>
+#include <sgct/sortlastcompositor.h>
 #include <sgct/viewport.h>
+#include <array>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -26,6 +33,7 @@ typedef SPOUTLIBRARY* SPOUTHANDLE;
 #endif // SGCT_HAS_SPOUT
 
 #ifdef SGCT_HAS_NDI
+#include <sgct/bufferpolicy.h>
 #include <Processing.NDI.Lib.h>
 #endif // SGCT_HAS_NDI
 
@@ -34,7 +42,10 @@ namespace sgct {
 namespace config { struct Window; }
 
 class OffScreenBuffer;
+class FrameExport;
 class ScreenCapture;
+class SpoutSharedTexture;
+class VulkanImage;
 
 class SGCT_EXPORT Window {
 public:
@@ -56,8 +67,37 @@ public:
         TopBottomInverted
     };
 
+    /**
+     * The GPU times in seconds of the stages of rendering this window. They are only
+     * measured while the statistics are shown and are read back a few frames later so
+     * that measuring them does not stall the GPU.
+     */
+    struct GpuTimes {
+        /// Rendering the viewports into the framebuffer, which includes all of the
+        /// following stages except the composition
+        double draw = 0.0;
+
+        /// Resolving the non-linear projections into the framebuffer
+        double nonLinearProjection = 0.0;
+
+        /// Copying the contents of another window and resolving the multisampling
+        double blit = 0.0;
+
+        /// Applying the fast approximate anti-aliasing
+        double fxaa = 0.0;
+
+        /// Compositing the framebuffer onto the window, including warping and blending
+        double composite = 0.0;
+    };
+
     static void makeSharedContextCurrent();
 
+    /**
+     * Releases the OpenGL context that is current on the calling thread so that it can be
+     * made current on a different thread.
+     */
+    static void releaseContext();
+
     /**
      * Init Nvidia swap groups if supported by hardware. Supported hardware is NVidia
      * Quadro graphics card + sync card or AMD/ATI FireGL graphics card + sync card.
@@ -100,21 +140,64 @@ public:
 
     void draw();
 
+    /**
+     * Renders the scene of this window in \p tiles that are each the size of the
+     * framebuffer and saves them together as one screenshot, whose resolution can exceed
+     * the largest texture that the GPU supports. The projections of the viewports are
+     * cropped to the tile that is rendered and the 2D overlays are left out. Viewports
+     * with non-linear projections cannot be split into tiles, so windows that contain
+     * them do not take a tiled screenshot.
+     *
+     * \pre The shared OpenGL context has to be current
+     */
+    void renderTiledScreenshot(ivec2 tiles);
+
     void renderFBOTexture();
 
     /**
      * Swap previous data and current data. This is done at the end of the render loop.
+     * If \p shouldPresent is `false`, everything except the swap itself is done and the
+     * commands of the frame are flushed, so that #present can be called on another
+     * thread.
      */
-    void swapBuffers(bool takeScreenshot);
+    void swapBuffers(bool takeScreenshot, bool shouldPresent = true);
+
+    /**
+     * Swaps the front and back buffers of this window, which can be called from any
+     * thread without the OpenGL context of the window being current. This must only be
+     * called for windows that are visible or rendered while hidden.
+     */
+    void present();
 
     void makeOpenGLContextCurrent();
 
+    GpuTimes gpuTimes() const;
+
+    /**
+     * \return The CPU time in seconds that the draw callback took for each of the
+     *         viewports of this window in the last frame, summed over both eyes and the
+     *         faces of the cube maps of the non-linear projections
+     */
+    const std::vector<double>& viewportDrawTimes() const;
+
     // Returns true if this window has any settings that require a fallback on an OpenGL
     // compatibility profile
     bool needsCompatibilityProfile() const;
 
     bool shouldTakeScreenshot() const;
 
+    /**
+     * \return The number of screenshots of this window that have been captured but are
+     *         still waiting to be saved by the capture threads
+     */
+    int nQueuedScreenshots() const;
+
+    /**
+     * Waits until all screenshots that have been taken of this window are saved. The
+     * OpenGL context of the window has to be current when calling this function.
+     */
+    void flushScreenshots();
+
     /**
      * \return Get the scale value (relation between pixel and point size). Normally this
      *         value is 1.f but 2.f on some retina computers.
@@ -157,11 +240,33 @@ public:
      */
     ivec2 framebufferResolution() const;
 
+    /**
+     * Sets the factor by which the framebuffer resolution of this window is scaled, which
+     * reduces the number of pixels that are rendered if it is smaller than 1. The
+     * framebuffer is stretched to the size of the window when it is displayed. The new
+     * scale is applied when the window is updated at the beginning of the next frame.
+     * Windows that send their framebuffer through Spout or NDI ignore the scale.
+     */
+    void setResolutionScale(float scale);
+
+    /**
+     * \return The factor by which the framebuffer resolution is currently scaled
+     */
+    float resolutionScale() const;
+
     /**
      * \return `true` if this window is resized
      */
     bool isWindowResized() const;
 
+    /**
+     * Determines whether this window renders its viewports in the \p frame. A window that
+     * only renders in every n-th frame displays the last frame that it rendered in the
+     * frames in between, and renders the first frame after a change once it is its turn.
+     * If the frame is \p isUnchanged, the window only renders changes that it skipped.
+     */
+    bool shouldRender(unsigned int frame, bool isUnchanged);
+
     /**
      * \return `this` window's focused flag
      */
@@ -192,6 +297,11 @@ public:
      */
     bool hasTag(std::string_view tag) const;
 
+    /**
+     * \return `true` if the final frames of this window are exported to other processes
+     */
+    bool hasFrameExport() const;
+
     /**
      * Set the visibility state of this window. If a window is hidden the rendering for
      * that window will be paused unless it's forced to render while hidden by using
@@ -267,6 +377,14 @@ public:
      */
     void setCallDraw2DFunction(bool state);
 
+    /**
+     * Marks the 2D overlays of this window as changed, so that they are rendered again
+     * in the next frame. This only has an effect if the window was configured with a
+     * `draw2dRate`, in which case the overlays are otherwise only rendered at that rate
+     * and the previous result is shown in between.
+     */
+    void invalidateOverlay();
+
     /**
      * Set if the specified Draw3D function pointer should be called for this window.
      */
@@ -278,6 +396,63 @@ public:
      */
     void setStereoMode(StereoMode sm);
 
+    /**
+     * Enables or disables the FXAA pass of this window without recreating the window.
+     * FXAA cannot be enabled on a window that renders both eyes in a single pass, as its
+     * framebuffer textures are layered, in which case a warning is logged instead.
+     *
+     * \pre The shared OpenGL context has to be current
+     */
+    void setUseFXAA(bool state);
+
+    /**
+     * Renders the \p eye of this window from the images of a Vulkan renderer, which
+     * replace the framebuffer textures of that eye, so that the warping, blending, and
+     * post-processing of the window are applied to the Vulkan rendering without copying
+     * it. The draw callback is still called for every viewport of the eye, but SGCT does
+     * not clear the images for it, and the application records and submits the Vulkan
+     * rendering of the viewport with the RenderData instead of drawing with OpenGL. The
+     * submission of the last viewport has to signal the ready semaphores of the images.
+     * The viewports with non-linear projections are rendered into the color image by
+     * SGCT after the images have been acquired, and their cube faces are rendered by the
+     * draw callback with OpenGL as in other windows. The images are released after the
+     * window has been swapped. The images are only used while their size is that of the
+     * framebuffer of the window.
+     *
+     * \param eye The eye whose framebuffer textures are replaced. In the side-by-side
+     *        and top-bottom stereo modes, both eyes are rendered into the images of the
+     *        MonoOrLeft eye
+     * \param color The image that replaces the color texture, or `nullptr` to render
+     *        the eye into the framebuffer textures of the window again
+     * \param depth The image that replaces the depth texture, if any
+     * \pre The images must outlive this window or be unset before they are destroyed
+     */
+    void setVulkanImages(Eye eye, VulkanImage* color, VulkanImage* depth = nullptr);
+
+    /**
+     * Offsets the \p matrix, which is a projection or model-view-projection matrix, by
+     * the subpixel jitter of the temporal anti-aliasing in the current frame. The jitter
+     * is measured in the pixels of a render target of the \p size. If the temporal
+     * anti-aliasing is disabled for this window, the \p matrix is returned unchanged.
+     * While a tiled screenshot is rendered, the \p matrix is also cropped to the tile.
+     */
+    mat4 jitteredMatrix(const mat4& matrix, ivec2 size) const;
+
+    /**
+     * Sets how this window waits for the vertical sync. The \p swapInterval and
+     * \p adaptiveSync override Engine::Settings::swapInterval for this window. If the
+     * window does not have its own \p swapInterval, only the \p isLastWindow of the
+     * node uses the global interval and all other windows do not wait at all, as the
+     * windows would otherwise wait for one vertical retrace each. With adaptive sync, a
+     * frame that missed the vertical retrace is swapped immediately and tears instead of
+     * waiting for the next one. If the driver does not support this, the window uses the
+     * regular vertical sync instead.
+     *
+     * \pre The OpenGL context of this window has to be current
+     */
+    void setSwapInterval(std::optional<int8_t> swapInterval,
+        std::optional<bool> adaptiveSync, bool isLastWindow);
+
     /**
      * \return The stereo mode
      */
@@ -288,12 +463,30 @@ public:
      */
     bool isStereo() const;
 
+    /**
+     * \return `true` if both eyes are rendered in a single pass of the draw callback, in
+     *         which case the RenderData contains the matrices of the right eye, too
+     */
+    bool isSinglePassStereo() const;
+
+    /**
+     * \return The part of the data that this node renders into the window if the images
+     *         of several nodes are composited into this window, or `std::nullopt`
+     *         otherwise
+     */
+    std::optional<SortLastCompositor::Partition> compositingPartition() const;
 
     // @TODO: Remove this
     unsigned int frameBufferTextureEye(Eye eye) const;
+    unsigned int frameBufferDepthTexture(Eye eye) const;
 
 private:
-    enum class TextureType { Color, Depth, Normal, Position };
+    enum class TextureType { Color, Depth, Normal, Position, Overlay };
+
+    struct VulkanImages {
+        VulkanImage* color = nullptr;
+        VulkanImage* depth = nullptr;
+    };
 
     Window(const Window&) = delete;
     Window& operator=(const Window&) = delete;
@@ -304,6 +497,17 @@ private:
     void createTextures();
     void generateTexture(unsigned int& id, TextureType type);
 
+    /**
+     * Acquires the pooled texture into which the window is rendered before FXAA.
+     */
+    void acquireIntermediateTarget();
+
+    /**
+     * Creates the texture arrays for the single pass stereo and the eye textures as
+     * views of their layers.
+     */
+    void generateStereoTextures();
+
     /**
      * This function resizes the FBOs when the window is resized to achive 1:1 mapping.
      */
@@ -311,13 +515,79 @@ private:
 
     void destroyFBOs();
 
+    /**
+     * Sets the framebuffer resolution to the unscaled resolution multiplied by the
+     * current resolution scale.
+     */
+    void applyResolutionScale();
+
     /**
      * Create vertex buffer objects used to render framebuffer quad.
      */
     void createVBOs();
     void loadShaders();
+    void loadFxaaShaders();
+
+    /**
+     * \return The shader that draws a texture onto a quad, which is only compiled when
+     *         the first overlay, overlay layer, or blitted window is drawn
+     */
+    const ShaderProgram& overlayShader() const;
+
+    /**
+     * Moves the window onto a display of the \p gpu, which makes the driver render it on
+     * that GPU. Fullscreen windows use a monitor of the GPU instead.
+     */
+    void placeOnGpu(int gpu);
+
+    /**
+     * \return The timer for the stages of rendering in the shared context, or `nullptr`
+     *         if the GPU times are not measured in this frame
+     */
+    GpuTimer* sharedGpuTimer() const;
     bool useRightEyeTexture() const;
 
+    /**
+     * \return `true` if FXAA is applied while the framebuffer is warped onto the window
+     *         instead of in a separate pass. This is only possible if nothing else
+     *         renders into or reads from the framebuffer texture after the FXAA pass
+     */
+    bool isFxaaFused() const;
+
+    /**
+     * Applies SMAA and TAA to the framebuffer texture of the \p eye, which has been
+     * rendered with the \p frustum, after the multisampled framebuffer was resolved.
+     */
+    void applyAntiAliasing(FrustumMode frustum, Eye eye) const;
+
+    /**
+     * Composites the framebuffer texture of the \p eye with the images that the other
+     * nodes of the compositing group have rendered into their window with the same id,
+     * which replaces the color and depth textures of this window on the output node.
+     */
+    void composite(Eye eye) const;
+
+    /**
+     * \return `true` if the final composite of this window samples the framebuffer
+     *         texture of the window that it blits instead of rendering anything itself.
+     *         This is only possible if the window would show nothing but the blitted
+     *         window, so it has to be mono without FXAA, draw callbacks, or overlays and
+     *         have a single viewport that covers the whole window
+     */
+    bool isSamplingBlitWindow() const;
+
+    /**
+     * \return The texture of the \p eye that is warped onto the window in the final
+     *         composite, which belongs to the blitted window if #isSamplingBlitWindow
+     */
+    unsigned int compositeTexture(Eye eye) const;
+
+    /**
+     * \return The Vulkan images that the \p eye is rendered into, or `nullptr` if it is
+     *         rendered into the framebuffer textures of this window
+     */
+    const VulkanImages* vulkanImages(Eye eye) const;
+
     /**
      * Causes all of the viewports of the provided \p window be rendered with the
      * \p frustum into the texture behind the provided \p ti texture index.
@@ -325,8 +595,39 @@ private:
      * \param window The window whose viewports should be rendered
      * \param frustum The frustum that should be used to render the viewports
      * \param eye The eye that should be rendered
+     * \param isSceneRendered If `true`, the regular viewports have already been
+     *        rendered by #renderSinglePassStereo and only the non-linear projections,
+     *        the post-processing, and the 2D elements are rendered
+     */
+    void renderViewports(FrustumMode frustum, Eye eye,
+        bool isSceneRendered = false) const;
+
+    /**
+     * Renders the regular viewports for both eyes at once into the layers of the stereo
+     * texture arrays.
+     */
+    void renderSinglePassStereo() const;
+
+    /**
+     * Adds the time that the draw callback took since Engine::drawCallbackTime returned
+     * \p callbackTime to the draw time of the \p viewport.
+     */
+    void addViewportDrawTime(const Viewport& viewport, double callbackTime) const;
+
+    /**
+     * Renders the warp meshes of all viewports into the coverage texture of the pre-mask
+     * if they or the blend masks have changed since they were last rendered. This has to
+     * be called with the context of this window current and the pre-mask is only used
+     * if the window is mono or uses active stereo and has no warp maps.
+     */
+    void updatePreMask();
+
+    /**
+     * Sets the depth of the pixels of the current viewport that cannot be seen after the
+     * warping and blending to the near plane, so that the fragments of the scene that
+     * are depth tested are rejected there before they are shaded.
      */
-    void renderViewports(FrustumMode frustum, Eye eye) const;
+    void applyPreMask() const;
 
     /**
      * Draw viewport overlays if there are any. This function renders stats, OSD and
@@ -337,6 +638,18 @@ private:
      */
     void render2D(FrustumMode frustum) const;
 
+    /**
+     * Renders the 2D overlays for the \p frustum into the overlay layer of the \p eye if
+     * they have been invalidated or if the interval of the `draw2dRate` has passed, and
+     * blends the layer over the currently bound framebuffer.
+     *
+     * \param frustum The frustum for which the overlays are drawn
+     * \param eye The eye whose overlay layer is used
+     * \param isSplitScreen Whether the overlays of the left eye are drawn as well as
+     *        both eyes are rendered into the same texture
+     */
+    void renderOverlayLayer(FrustumMode frustum, Eye eye, bool isSplitScreen) const;
+
     /**
      * This function copies/render the result from the previous window same viewport (if
      * it exists) into this window.
@@ -368,19 +681,39 @@ private:
     bool _shouldRenderWhileHidden;
     uint8_t _nAASamples;
     bool _useFXAA;
+    bool _useSmaa;
+    bool _useTaa;
+    std::optional<int8_t> _swapInterval;
+    std::optional<bool> _adaptiveSync;
     bool _isDecorated;
     bool _isResizable;
     bool _isMirrored;
     int8_t _blitWindowId;
+    // The window with the _blitWindowId, which is looked up when this window is
+    // initialized
+    const Window* _blitWindow = nullptr;
     uint8_t _monitorIndex;
+    std::optional<uint8_t> _gpu;
+    // The nodes whose images are composited into this window by their depth
+    std::optional<SortLastCompositor::Group> _compositing;
+    // Reused for the image that is read back and composited in every frame
+    mutable SortLastCompositor::Image _compositingImage;
     bool _mirrorX;
     bool _mirrorY;
     bool _noError;
     bool _isVisible;
     StereoMode _stereoMode;
+    bool _useSinglePassStereo;
+    // Whether the single pass stereo was requested and is supported by this window
+    bool _isSinglePassStereoSupported = false;
     std::optional<ivec2> _windowPos;
     std::optional<ivec2> _windowRes;
     ivec2 _framebufferRes;
+    // The framebuffer resolution before the resolution scale is applied
+    ivec2 _unscaledFramebufferRes;
+    float _resolutionScale = 1.f;
+    std::optional<float> _pendingResolutionScale;
+    bool _isResolutionScaleChanged = false;
 
     std::optional<ivec2> _pendingWindowRes;
     bool _windowResChanged = false;
@@ -388,6 +721,10 @@ private:
     bool _useFixResolution = false;
     bool _hasAnyMasks = false;
     std::optional<ivec2> _pendingFramebufferRes;
+    // The time at which the _pendingFramebufferRes was last changed
+    double _framebufferResTime = 0.0;
+    // The resolution with which the framebuffer textures were created
+    ivec2 _textureResolution = ivec2(0, 0);
     GLFWwindow* _windowHandle = nullptr;
     float _aspectRatio = 1.f;
     vec2 _scale = vec2{ 0.f, 0.f };
@@ -396,6 +733,10 @@ private:
     bool _spoutEnabled;
     std::string _spoutName;
     SPOUTHANDLE _spoutHandle = nullptr;
+    const bool _useSpoutSharedTexture;
+    // Only set if the window is blitted directly into the texture that Spout shares
+    std::unique_ptr<SpoutSharedTexture> _spoutTexture;
+    unsigned int _spoutFbo = 0;
 #endif // SGCT_HAS_SPOUT
 
 #ifdef SGCT_HAS_NDI
@@ -403,14 +744,28 @@ private:
     NDIlib_video_frame_v2_t _videoFrame;
     std::string _ndiName;
     std::string _ndiGroups;
-    std::vector<std::byte> _videoBufferPing;
-    std::vector<std::byte> _videoBufferPong;
-    std::vector<std::byte>* _currentVideoBuffer = &_videoBufferPing;
+    using VideoBuffer =
+        std::vector<std::byte, BufferAllocator<std::byte, BufferPolicy::Subsystem::Ndi>>;
+    VideoBuffer _videoBufferPing;
+    VideoBuffer _videoBufferPong;
+    VideoBuffer* _currentVideoBuffer = &_videoBufferPing;
 #endif // SGCT_HAS_NDI
 
+    // The format of the frame buffer textures that hold the final frame
     const unsigned int _internalColorFormat;
     const unsigned int _colorDataType;
     const int _bytesPerColor = 4;
+    // The formats of the cube maps of the non-linear projections, of the intermediate
+    // texture that FXAA reads from, and of the screenshots, which are converted when
+    // they are sampled, blitted, or downloaded
+    const unsigned int _cubemapColorFormat;
+    const unsigned int _cubemapDataType;
+    const unsigned int _intermediateColorFormat;
+    const unsigned int _intermediateDataType;
+    const unsigned int _captureColorFormat;
+    const unsigned int _captureDataType;
+    const int _captureBytesPerColor = 4;
+    const std::optional<config::Window::Stream> _stream;
 
     struct {
         unsigned int leftEye = 0;
@@ -419,29 +774,102 @@ private:
         unsigned int intermediate = 0;
         unsigned int normals = 0;
         unsigned int positions = 0;
+        // The texture arrays with one layer per eye for the single pass stereo, of which
+        // the eye textures are views
+        unsigned int stereoColor = 0;
+        unsigned int stereoDepth = 0;
     } _frameBufferTextures;
+    // The images of a Vulkan renderer that replace the color and depth textures of each
+    // eye, which are only used while their size matches the _framebufferRes
+    std::array<VulkanImages, 2> _vulkanImages;
+    // The estimated video memory of the _frameBufferTextures, except for the
+    // intermediate texture that is shared through the RenderTargetPool
+    MemoryAccount _textureMemory = MemoryAccount(MemoryTracker::Category::Framebuffers);
+    // Only used between the rendering of the scene and the FXAA pass of one eye
+    RenderTargetPool::Target _intermediateTarget;
+
+    // The highest rate in Hz at which the 2D overlays are rendered into the overlay
+    // layers, or 0 if they are only rendered when they have been invalidated. If this
+    // value is not set, the overlays are rendered directly into every frame
+    std::optional<float> _draw2DRate;
+    // The window only renders in every n-th frame, and is outdated if it skipped a frame
+    // that has changed since it last rendered
+    const unsigned int _renderEvery = 1;
+    bool _isOutdated = true;
+    // The 2D overlays of each eye with premultiplied alpha, which are blended over the
+    // frame in every frame, but are only rendered again when they have changed
+    struct {
+        unsigned int fbo = 0;
+        std::array<unsigned int, 2> textures = { 0, 0 };
+        mutable std::array<bool, 2> isDirty = { true, true };
+        mutable std::array<double, 2> renderTime = { 0.0, 0.0 };
+    } _overlayLayer;
+
+    // The tile of the tiled screenshot that is currently rendered
+    struct ScreenshotTile {
+        ivec2 index = ivec2(0, 0);
+        ivec2 count = ivec2(1, 1);
+    };
+    std::optional<ScreenshotTile> _screenshotTile;
+
+    // The pixels of the framebuffer that are sampled by a warp mesh and that are not
+    // black in the blend mask of its viewport. The framebuffer object belongs to the
+    // context of this window, in which the warp meshes have to be rendered. The shaders
+    // are only compiled once a window needs a pre-mask
+    struct {
+        ShaderProgram coverageShader;
+        ShaderProgram shader;
+        unsigned int fbo = 0;
+        unsigned int texture = 0;
+        ivec2 size = ivec2(0, 0);
+        // The revisions of the viewports' meshes when the coverage was rendered
+        std::vector<uint64_t> meshRevisions;
+        bool isValid = false;
+        MemoryAccount memory = MemoryAccount(MemoryTracker::Category::Framebuffers);
+    } _preMask;
 
     std::unique_ptr<ScreenCapture> _screenCaptureLeftOrMono;
     std::unique_ptr<ScreenCapture> _screenCaptureRight;
+    // Sends the final frame of the left eye to the receiver of the #_stream
+    std::unique_ptr<ScreenCapture> _streamCapture;
+    // The name under which the final frames are exported, if they are
+    std::optional<std::string> _frameExportName;
+    std::unique_ptr<FrameExport> _frameExport;
 
 
     unsigned int _vao = 0;
     unsigned int _vbo = 0;
 
     ShaderProgram _fboQuad;
-    ShaderProgram _overlay;
+    ShaderProgram _warpMapQuad;
+    // Created by the first call to overlayShader, which happens in the const draw calls
+    mutable ShaderProgram _overlay;
     ShaderProgram _stereo;
 
     struct FXAAShader {
         ShaderProgram shader;
         int sizeX = -1;
         int sizeY = -1;
+        // The variants of _fboQuad and _warpMapQuad that apply FXAA while warping
+        ShaderProgram fusedQuad;
+        ShaderProgram fusedWarpMapQuad;
     };
     std::optional<FXAAShader> _fxaa;
+    // Only created if SMAA or TAA is enabled for this window
+    std::unique_ptr<AntiAliasing> _antiAliasing;
 
     std::vector<std::unique_ptr<Viewport>> _viewports;
     std::unique_ptr<OffScreenBuffer> _finalFBO;
 
+    // The queries of the two timers belong to the shared context and to the context of
+    // this window, respectively. The rendering functions are const, so the first one has
+    // to be mutable
+    mutable GpuTimer _sharedGpuTimer = GpuTimer(4);
+    GpuTimer _windowGpuTimer = GpuTimer(1);
+    bool _isMeasuringGpuTimes = false;
+    // The rendering functions are const, so the times have to be mutable, too
+    mutable std::vector<double> _viewportDrawTimes;
+
     static GLFWwindow* _sharedHandle;
     static bool _useSwapGroups;
     static bool _isBarrierActive;
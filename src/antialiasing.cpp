@@ -0,0 +1,343 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/antialiasing.h>
+
+#include <sgct/internalshaders.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <cassert>
+
+namespace {
+    // The number of frames after which the jitter repeats
+    constexpr unsigned int JitterPeriod = 8;
+
+    // The weight of the history in the blend with the current frame
+    constexpr float Feedback = 0.9f;
+
+    float halton(unsigned int index, unsigned int base) {
+        float f = 1.f;
+        float res = 0.f;
+        while (index > 0) {
+            f /= static_cast<float>(base);
+            res += f * static_cast<float>(index % base);
+            index /= base;
+        }
+        return res;
+    }
+} // namespace
+
+namespace sgct {
+
+AntiAliasing::AntiAliasing(bool useSmaa, bool useTaa)
+    : _useSmaa(useSmaa)
+    , _useTaa(useTaa)
+{
+    if (_useSmaa) {
+        _edgeShader = ShaderProgram("SMAAEdgeShader");
+        _edgeShader.addVertexShader(shaders::FullscreenTriangleVert);
+        _edgeShader.addFragmentShader(shaders::SMAAEdgeFrag);
+        _edgeShader.createAndLinkProgram();
+        _edgeShader.bind();
+        glUniform1i(glGetUniformLocation(_edgeShader.id(), "tex"), 0);
+
+        _weightsShader = ShaderProgram("SMAAWeightsShader");
+        _weightsShader.addVertexShader(shaders::FullscreenTriangleVert);
+        _weightsShader.addFragmentShader(shaders::SMAAWeightsFrag);
+        _weightsShader.createAndLinkProgram();
+        _weightsShader.bind();
+        glUniform1i(glGetUniformLocation(_weightsShader.id(), "edges"), 0);
+
+        _blendShader = ShaderProgram("SMAABlendShader");
+        _blendShader.addVertexShader(shaders::FullscreenTriangleVert);
+        _blendShader.addFragmentShader(shaders::SMAABlendFrag);
+        _blendShader.createAndLinkProgram();
+        _blendShader.bind();
+        glUniform1i(glGetUniformLocation(_blendShader.id(), "tex"), 0);
+        glUniform1i(glGetUniformLocation(_blendShader.id(), "weights"), 1);
+    }
+
+    if (_useTaa) {
+        _resolveShader = ShaderProgram("TAAResolveShader");
+        _resolveShader.addVertexShader(shaders::FullscreenTriangleVert);
+        _resolveShader.addFragmentShader(shaders::TAAResolveFrag);
+        _resolveShader.createAndLinkProgram();
+        _resolveShader.bind();
+        const int id = _resolveShader.id();
+        glUniform1i(glGetUniformLocation(id, "tex"), 0);
+        glUniform1i(glGetUniformLocation(id, "history"), 1);
+        glUniform1i(glGetUniformLocation(id, "depth"), 2);
+        _hasDepthLoc = glGetUniformLocation(id, "hasDepth");
+        _reprojectionLoc = glGetUniformLocation(id, "reprojection");
+        _viewportLoc = glGetUniformLocation(id, "viewport");
+        _feedbackLoc = glGetUniformLocation(id, "feedback");
+    }
+    ShaderProgram::unbind();
+
+    glGenFramebuffers(1, &_fbo);
+    // The vertices are generated in the vertex shader, but a vertex array still has to
+    // be bound to draw them
+    glGenVertexArrays(1, &_vao);
+}
+
+AntiAliasing::~AntiAliasing() {
+    for (History& history : _histories) {
+        glDeleteTextures(1, &history.texture);
+    }
+    glDeleteFramebuffers(1, &_fbo);
+    glDeleteVertexArrays(1, &_vao);
+    _edgeShader.deleteProgram();
+    _weightsShader.deleteProgram();
+    _blendShader.deleteProgram();
+    _resolveShader.deleteProgram();
+}
+
+void AntiAliasing::resize(ivec2 size, unsigned int internalFormat, unsigned int format,
+                          unsigned int type)
+{
+    _size = size;
+    _internalFormat = internalFormat;
+    _format = format;
+    _type = type;
+
+    _source = RenderTargetPool::acquire(
+        {
+            .internalFormat = internalFormat,
+            .format = format,
+            .type = type,
+            .size = size
+        },
+        MemoryTracker::Category::Framebuffers
+    );
+    if (_useSmaa) {
+        _edges = RenderTargetPool::acquire(
+            {
+                .internalFormat = GL_RG8,
+                .format = GL_RG,
+                .type = GL_UNSIGNED_BYTE,
+                .size = size
+            },
+            MemoryTracker::Category::Framebuffers
+        );
+        _weights = RenderTargetPool::acquire(
+            {
+                .internalFormat = GL_RGBA8,
+                .format = GL_RGBA,
+                .type = GL_UNSIGNED_BYTE,
+                .size = size
+            },
+            MemoryTracker::Category::Framebuffers
+        );
+    }
+
+    // The history textures are only created once they are used, so that a window
+    // without stereo does not allocate one for the right eye
+    for (History& history : _histories) {
+        glDeleteTextures(1, &history.texture);
+        history = History();
+    }
+    _historyMemory.set(0);
+}
+
+void AntiAliasing::apply(unsigned int color, unsigned int depth, int eye,
+                         std::span<const Region> regions)
+{
+    ZoneScoped;
+
+    assert(eye >= 0 && eye < static_cast<int>(_histories.size()));
+    glBindFramebuffer(GL_FRAMEBUFFER, _fbo);
+    glViewport(0, 0, _size.x, _size.y);
+    glDisable(GL_SCISSOR_TEST);
+    glBindVertexArray(_vao);
+
+    if (_useSmaa) {
+        applySmaa(color);
+    }
+    if (_useTaa) {
+        applyTaa(color, depth, _histories[eye], regions);
+    }
+
+    glBindVertexArray(0);
+    ShaderProgram::unbind();
+    for (int i = 2; i >= 0; i--) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+}
+
+bool AntiAliasing::useSmaa() const {
+    return _useSmaa;
+}
+
+bool AntiAliasing::useTaa() const {
+    return _useTaa;
+}
+
+vec2 AntiAliasing::jitter(unsigned int frame) {
+    // The Halton sequence covers the pixel evenly with few samples. It starts at 1 as
+    // the first element of the sequence is 0 in both bases
+    const unsigned int index = frame % JitterPeriod + 1;
+    return vec2(halton(index, 2) - 0.5f, halton(index, 3) - 0.5f);
+}
+
+void AntiAliasing::copy(unsigned int color) {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT1,
+        GL_TEXTURE_2D,
+        _source.texture(),
+        0
+    );
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT1);
+    glBlitFramebuffer(
+        0, 0, _size.x, _size.y,
+        0, 0, _size.x, _size.y,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+}
+
+void AntiAliasing::applySmaa(unsigned int color) {
+    ZoneScoped;
+
+    copy(color);
+
+    // The edges and weights are only written for the pixels on an edge, so the rest of
+    // these textures has to be cleared
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _source.texture());
+    _edgeShader.bind();
+    draw(_edges.texture(), true);
+
+    glBindTexture(GL_TEXTURE_2D, _edges.texture());
+    _weightsShader.bind();
+    draw(_weights.texture(), true);
+
+    // The pixels that are not blended keep their color
+    glBindTexture(GL_TEXTURE_2D, _source.texture());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, _weights.texture());
+    _blendShader.bind();
+    draw(color, false);
+}
+
+void AntiAliasing::applyTaa(unsigned int color, unsigned int depth, History& history,
+                            std::span<const Region> regions)
+{
+    ZoneScoped;
+
+    if (history.texture == 0) {
+        glGenTextures(1, &history.texture);
+        glBindTexture(GL_TEXTURE_2D, history.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            _internalFormat,
+            _size.x,
+            _size.y,
+            0,
+            _format,
+            _type,
+            nullptr
+        );
+        _historyMemory.add(
+            static_cast<size_t>(_size.x) * _size.y *
+            MemoryTracker::bytesPerTexel(_internalFormat)
+        );
+    }
+
+    copy(color);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _source.texture());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, history.texture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, depth);
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    _resolveShader.bind();
+    glUniform1i(_hasDepthLoc, depth != 0 ? 1 : 0);
+    glUniform1f(_feedbackLoc, history.isValid ? Feedback : 0.f);
+
+    glEnable(GL_SCISSOR_TEST);
+    for (size_t i = 0; i < regions.size(); i++) {
+        const Region& region = regions[i];
+
+        // The regions are compared by their index, so the history of a viewport that has
+        // been moved or resized is only clamped, but not reprojected
+        mat4 reprojection = mat4(1.f);
+        if (i < history.regions.size() && history.regions[i].rect == region.rect &&
+            region.viewProjection && history.regions[i].viewProjection)
+        {
+            reprojection =
+                *history.regions[i].viewProjection * inverse(*region.viewProjection);
+        }
+
+        const ivec4& r = region.rect;
+        glScissor(r.x, r.y, r.z, r.w);
+        glUniformMatrix4fv(_reprojectionLoc, 1, GL_FALSE, reprojection.values.data());
+        glUniform4f(
+            _viewportLoc,
+            static_cast<float>(r.x),
+            static_cast<float>(r.y),
+            static_cast<float>(r.z),
+            static_cast<float>(r.w)
+        );
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    glDisable(GL_SCISSOR_TEST);
+
+    // The history cannot be written while it is read, so the result is copied into it
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT1,
+        GL_TEXTURE_2D,
+        history.texture,
+        0
+    );
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT1);
+    glBlitFramebuffer(
+        0, 0, _size.x, _size.y,
+        0, 0, _size.x, _size.y,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+
+    history.regions.assign(regions.begin(), regions.end());
+    history.isValid = true;
+}
+
+void AntiAliasing::draw(unsigned int target, bool clear) {
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        target,
+        0
+    );
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    if (clear) {
+        glClearColor(0.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+} // namespace sgct
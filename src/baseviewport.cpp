@@ -34,6 +34,12 @@ BaseViewport::~BaseViewport() = default;
 void BaseViewport::setupViewport(FrustumMode frustum) const {
     ZoneScoped;
 
+    const ivec4 vpCoordinates = pixelCoordinates(frustum);
+    glViewport(vpCoordinates.x, vpCoordinates.y, vpCoordinates.z, vpCoordinates.w);
+    glScissor(vpCoordinates.x, vpCoordinates.y, vpCoordinates.z, vpCoordinates.w);
+}
+
+ivec4 BaseViewport::pixelCoordinates(FrustumMode frustum) const {
     const ivec2 res = _parent.framebufferResolution();
     ivec4 vpCoordinates = ivec4 {
         static_cast<int>(_position.x * res.x),
@@ -87,8 +93,7 @@ void BaseViewport::setupViewport(FrustumMode frustum) const {
         }
     }
 
-    glViewport(vpCoordinates.x, vpCoordinates.y, vpCoordinates.z, vpCoordinates.w);
-    glScissor(vpCoordinates.x, vpCoordinates.y, vpCoordinates.z, vpCoordinates.w);
+    return vpCoordinates;
 }
 
 const Projection& BaseViewport::projection(FrustumMode frustumMode) const {
@@ -104,6 +109,10 @@ ProjectionPlane& BaseViewport::projectionPlane() {
     return _projPlane;
 }
 
+const ProjectionPlane& BaseViewport::projectionPlane() const {
+    return _projPlane;
+}
+
 void BaseViewport::calculateFrustum(FrustumMode mode, float nearClip, float farClip) {
     ZoneScoped;
 
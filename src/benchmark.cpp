@@ -0,0 +1,538 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/benchmark.h>
+
+#include <sgct/callbackdata.h>
+#include <sgct/engine.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <sgct/version.h>
+#include <sgct/window.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+#include <sstream>
+
+#define Err(code, msg) Error(Error::Component::Engine, code, msg)
+
+namespace {
+    // The cubes are placed on a regular grid with this many cubes along each axis
+    constexpr int GridSize = 16;
+    constexpr int NumberOfCubes = GridSize * GridSize * GridSize;
+
+    // The default camera circles around the grid at this distance and height in meters
+    constexpr float OrbitRadius = 30.f;
+    constexpr float OrbitHeight = 6.f;
+
+    // Generates the vertices of the cubes from the vertex and instance id, so that no
+    // vertex buffers are needed
+    constexpr std::string_view CubeVertex = R"(
+  uniform float phase;
+
+  const int GridSize = 16;
+  const float Spacing = 1.5;
+  const float CubeSize = 0.4;
+
+  // The corners of the six faces in cyclic order, where the bits of each index are the
+  // x, y, and z coordinates of the corner
+  const int Faces[24] = int[24](
+    0, 4, 6, 2,   1, 3, 7, 5,   0, 1, 5, 4,   2, 6, 7, 3,   0, 2, 3, 1,   4, 5, 7, 6
+  );
+  const int Triangles[6] = int[6](0, 1, 2, 0, 2, 3);
+  const vec3 Normals[6] = vec3[6](
+    vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0), vec3(0.0, -1.0, 0.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0)
+  );
+  const vec3 Light = vec3(0.27, 0.89, 0.36);
+
+  vec3 cubeVertex(out vec3 color) {
+    int face = gl_VertexID / 6;
+    int corner = Faces[face * 4 + Triangles[gl_VertexID % 6]];
+    vec3 p = vec3(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1) * 2.0 - 1.0;
+
+    ivec3 cell = ivec3(
+      gl_InstanceID % GridSize,
+      (gl_InstanceID / GridSize) % GridSize,
+      gl_InstanceID / (GridSize * GridSize)
+    );
+    vec3 center = (vec3(cell) - 0.5 * float(GridSize - 1)) * Spacing;
+
+    float a = phase + 0.37 * float(gl_InstanceID);
+    float c = cos(a);
+    float s = sin(a);
+    mat3 rotation = mat3(1.0, 0.0, 0.0, 0.0, c, s, 0.0, -s, c) *
+                    mat3(c, 0.0, -s, 0.0, 1.0, 0.0, s, 0.0, c);
+
+    float diffuse = max(dot(rotation * Normals[face], Light), 0.0);
+    color = (0.25 + 0.75 * vec3(cell) / float(GridSize - 1)) * (0.3 + 0.7 * diffuse);
+    return center + rotation * (p * CubeSize);
+  }
+)";
+
+    constexpr std::string_view VertexShader = R"(
+  out vec3 color;
+
+  uniform mat4 mvp;
+  uniform bool isFisheye;
+  uniform float halfFov;
+  uniform vec2 fisheyeScale;
+  uniform vec2 fisheyeOffset;
+  uniform float nearClip;
+  uniform float farClip;
+
+  void main() {
+    vec3 position = cubeVertex(color);
+    if (isFisheye) {
+      // The projection matrix is the identity, so this is the position in view space
+      vec3 p = (mvp * vec4(position, 1.0)).xyz;
+      float r = length(p);
+      vec3 d = p / r;
+      float theta = acos(clamp(-d.z, -1.0, 1.0));
+      vec2 dir = length(d.xy) > 0.0 ? normalize(d.xy) : vec2(0.0);
+      vec2 ndc = theta / halfFov * dir * fisheyeScale + fisheyeOffset;
+      // Vertices outside of the fisheye disk are moved behind the far plane. The cubes
+      // are small enough that their edges do not have to be tessellated
+      float z = theta > halfFov ? 2.0 : 2.0 * (r - nearClip) / (farClip - nearClip) - 1.0;
+      gl_Position = vec4(ndc, z, 1.0);
+    }
+    else {
+      gl_Position = mvp * vec4(position, 1.0);
+    }
+  }
+)";
+
+    constexpr std::string_view LayeredVertexShader = R"(
+  out vec3 vPosition;
+  out vec3 vColor;
+
+  void main() {
+    vPosition = cubeVertex(vColor);
+  }
+)";
+
+    constexpr std::string_view LayeredGeometryShader = R"(
+  #version 410 core
+
+  layout(triangles) in;
+  layout(triangle_strip, max_vertices = 18) out;
+
+  in vec3 vPosition[];
+  in vec3 vColor[];
+  out vec3 color;
+
+  uniform mat4 layerMvp[6];
+  uniform int layerMask;
+  uniform bool setViewportIndex;
+
+  void main() {
+    for (int layer = 0; layer < 6; layer++) {
+      if ((layerMask & (1 << layer)) == 0) {
+        continue;
+      }
+
+      for (int i = 0; i < 3; i++) {
+        gl_Position = layerMvp[layer] * vec4(vPosition[i], 1.0);
+        color = vColor[i];
+        gl_Layer = layer;
+        if (setViewportIndex) {
+          gl_ViewportIndex = layer;
+        }
+        EmitVertex();
+      }
+      EndPrimitive();
+    }
+  }
+)";
+
+    constexpr std::string_view FragmentShader = R"(
+  #version 330 core
+
+  in vec3 color;
+  out vec4 out_color;
+
+  void main() {
+    out_color = vec4(color, 1.0);
+  }
+)";
+
+    struct Summary {
+        double mean = 0.0;
+        double min = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    // Uses the nearest rank of the percentiles, so that every reported value has been
+    // measured in one of the frames
+    Summary summarize(std::vector<double> values) {
+        if (values.empty()) {
+            return Summary();
+        }
+
+        std::sort(values.begin(), values.end());
+        auto percentile = [&values](double p) {
+            const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+            return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+        };
+        double sum = 0.0;
+        for (double v : values) {
+            sum += v;
+        }
+
+        return Summary {
+            .mean = sum / values.size(),
+            .min = values.front(),
+            .p50 = percentile(0.5),
+            .p90 = percentile(0.9),
+            .p95 = percentile(0.95),
+            .p99 = percentile(0.99),
+            .max = values.back()
+        };
+    }
+
+    nlohmann::json toJsonInMilliseconds(const Summary& s) {
+        return {
+            { "mean", s.mean * 1000.0 },
+            { "min", s.min * 1000.0 },
+            { "p50", s.p50 * 1000.0 },
+            { "p90", s.p90 * 1000.0 },
+            { "p95", s.p95 * 1000.0 },
+            { "p99", s.p99 * 1000.0 },
+            { "max", s.max * 1000.0 }
+        };
+    }
+
+    std::string glString(GLenum name) {
+        const GLubyte* str = glGetString(name);
+        return str ? reinterpret_cast<const char*>(str) : "";
+    }
+} // namespace
+
+namespace sgct {
+
+Benchmark::Benchmark(int nFrames, std::filesystem::path output,
+                     const std::filesystem::path& cameraPath)
+    : _nFrames(nFrames)
+    , _output(std::move(output))
+{
+    ZoneScoped;
+
+    if (!cameraPath.empty()) {
+        std::ifstream file = std::ifstream(cameraPath);
+        if (!file.good()) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            //        formatting std::filesystem::path
+            throw Err(
+                3014,
+                std::format("Could not open camera path '{}'", cameraPath.string())
+            );
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            if (line.empty() || line.starts_with('#')) {
+                continue;
+            }
+
+            Keyframe kf;
+            std::istringstream stream = std::istringstream(line);
+            stream >> kf.frame >> kf.position.x >> kf.position.y >> kf.position.z >>
+                kf.orientation.x >> kf.orientation.y >> kf.orientation.z;
+            if (stream.fail()) {
+                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+                //        formatting std::filesystem::path
+                throw Err(
+                    3015,
+                    std::format(
+                        "Malformed keyframe in line {} of camera path '{}'",
+                        lineNumber, cameraPath.string()
+                    )
+                );
+            }
+            _cameraPath.push_back(kf);
+        }
+
+        std::stable_sort(
+            _cameraPath.begin(),
+            _cameraPath.end(),
+            [](const Keyframe& lhs, const Keyframe& rhs) { return lhs.frame < rhs.frame; }
+        );
+    }
+
+    _frames.reserve(_nFrames);
+
+    // All vertices are generated in the shaders, but a vertex array has to be bound
+    glGenVertexArrays(1, &_vao);
+
+    _program = ShaderProgram("BenchmarkShader");
+    _program.addVertexShader(
+        std::format("#version 330 core\n{}{}", CubeVertex, VertexShader)
+    );
+    _program.addFragmentShader(FragmentShader);
+    _program.createAndLinkProgram();
+
+    // Writing the viewport index in the geometry shader requires OpenGL 4.1
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 1)) {
+        _layeredProgram = ShaderProgram("BenchmarkLayeredShader");
+        _layeredProgram.addVertexShader(
+            std::format("#version 410 core\n{}{}", CubeVertex, LayeredVertexShader)
+        );
+        _layeredProgram.addGeometryShader(LayeredGeometryShader);
+        _layeredProgram.addFragmentShader(FragmentShader);
+        _layeredProgram.createAndLinkProgram();
+    }
+
+    Log::Info(std::format(
+        "Benchmarking {} frames after {} warm-up frames with {} cubes", _nFrames,
+        WarmupFrames, NumberOfCubes
+    ));
+}
+
+Benchmark::~Benchmark() {
+    glDeleteVertexArrays(1, &_vao);
+}
+
+void Benchmark::draw(const RenderData& data) const {
+    ZoneScoped;
+
+    const unsigned int frame = Engine::instance().clusterFrameNumber();
+    const mat4 camera = cameraTransform(frame);
+    // The phase is wrapped around a multiple of 2 pi, so that it keeps its precision
+    const float phase = static_cast<float>(frame % 62832) * 0.01f;
+
+    glEnable(GL_DEPTH_TEST);
+    glBindVertexArray(_vao);
+
+    // Without the layered program, only the first layer is rendered
+    if ((data.rightEye || data.cubeFaces) && _layeredProgram.id() != 0) {
+        std::array<mat4, 6> mvps;
+        int layerMask = 0;
+        if (data.cubeFaces) {
+            for (int i = 0; i < 6; i++) {
+                mvps[i] = data.cubeFaces->modelViewProjectionMatrices[i] * camera;
+            }
+            layerMask = data.cubeFaces->faceMask;
+        }
+        else {
+            mvps[0] = data.modelViewProjectionMatrix * camera;
+            mvps[1] = data.rightEye->modelViewProjectionMatrix * camera;
+            layerMask = 0b11;
+        }
+
+        _layeredProgram.bind();
+        glUniformMatrix4fv(
+            _layeredProgram.uniformLocation("layerMvp"),
+            static_cast<GLsizei>(mvps.size()),
+            GL_FALSE,
+            mvps[0].values.data()
+        );
+        glUniform1i(_layeredProgram.uniformLocation("layerMask"), layerMask);
+        glUniform1i(
+            _layeredProgram.uniformLocation("setViewportIndex"),
+            data.cubeFaces.has_value() ? 1 : 0
+        );
+        glUniform1f(_layeredProgram.uniformLocation("phase"), phase);
+    }
+    else {
+        const mat4 mvp = data.modelViewProjectionMatrix * camera;
+
+        _program.bind();
+        glUniformMatrix4fv(
+            _program.uniformLocation("mvp"),
+            1,
+            GL_FALSE,
+            mvp.values.data()
+        );
+        glUniform1f(_program.uniformLocation("phase"), phase);
+        glUniform1i(_program.uniformLocation("isFisheye"), data.fisheye ? 1 : 0);
+        if (data.fisheye) {
+            const RenderData::Fisheye& f = *data.fisheye;
+            glUniform1f(_program.uniformLocation("halfFov"), f.halfFov);
+            glUniform2f(_program.uniformLocation("fisheyeScale"), f.scale.x, f.scale.y);
+            glUniform2f(
+                _program.uniformLocation("fisheyeOffset"),
+                f.offset.x,
+                f.offset.y
+            );
+            glUniform1f(_program.uniformLocation("nearClip"), f.nearClip);
+            glUniform1f(_program.uniformLocation("farClip"), f.farClip);
+        }
+    }
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, NumberOfCubes);
+
+    ShaderProgram::unbind();
+    glBindVertexArray(0);
+    glDisable(GL_DEPTH_TEST);
+}
+
+bool Benchmark::addFrame(const Frame& frame) {
+    if (_nWarmupFrames < WarmupFrames) {
+        _nWarmupFrames++;
+        return false;
+    }
+
+    _frames.push_back(frame);
+    return static_cast<int>(_frames.size()) >= _nFrames;
+}
+
+std::filesystem::path Benchmark::writeResults(int nodeId) const {
+    ZoneScoped;
+
+    auto summarizeMember = [this](double Frame::* member) {
+        std::vector<double> values;
+        values.reserve(_frames.size());
+        for (const Frame& f : _frames) {
+            values.push_back(f.*member);
+        }
+        return toJsonInMilliseconds(summarize(std::move(values)));
+    };
+
+    nlohmann::json windows = nlohmann::json::array();
+    for (const std::unique_ptr<Window>& window : Engine::instance().windows()) {
+        const ivec2 res = window->framebufferResolution();
+        windows.push_back({
+            { "id", window->id() },
+            { "name", window->name() },
+            { "resolution", { res.x, res.y } },
+            { "stereo", window->isStereo() }
+        });
+    }
+
+    nlohmann::json j = {
+        { "node", nodeId },
+        { "version", std::string(Version) },
+        {
+            "gpu",
+            {
+                { "vendor", glString(GL_VENDOR) },
+                { "renderer", glString(GL_RENDERER) },
+                { "version", glString(GL_VERSION) }
+            }
+        },
+        {
+            "workload",
+            {
+                { "frames", _frames.size() },
+                { "warmupFrames", WarmupFrames },
+                { "cubes", NumberOfCubes },
+                { "cameraKeyframes", _cameraPath.size() }
+            }
+        },
+        { "windows", std::move(windows) },
+        {
+            "milliseconds",
+            {
+                { "frame", summarizeMember(&Frame::frameTime) },
+                { "draw", summarizeMember(&Frame::drawTime) },
+                { "gpuDraw", summarizeMember(&Frame::gpuDrawTime) },
+                { "sync", summarizeMember(&Frame::syncTime) },
+                { "composite", summarizeMember(&Frame::compositeTime) }
+            }
+        }
+    };
+
+    std::ofstream file = std::ofstream(_output);
+    if (!file.good()) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        //        formatting std::filesystem::path
+        Log::Error(std::format(
+            "Could not write benchmark results to '{}'", _output.string()
+        ));
+        return std::filesystem::path();
+    }
+    file << j.dump(2) << '\n';
+    return _output;
+}
+
+mat4 Benchmark::cameraTransform(unsigned int frame) const {
+    vec3 position;
+    vec3 orientation;
+    if (_cameraPath.empty()) {
+        // Circle around the grid once while the frames are measured
+        const double t = static_cast<double>(frame) / (WarmupFrames + _nFrames);
+        const float angle = static_cast<float>(2.0 * std::numbers::pi * t);
+        position = vec3(
+            OrbitRadius * std::sin(angle),
+            OrbitHeight,
+            OrbitRadius * std::cos(angle)
+        );
+        orientation = vec3(
+            glm::degrees(angle),
+            -glm::degrees(std::atan2(OrbitHeight, OrbitRadius)),
+            0.f
+        );
+    }
+    else {
+        const double f = static_cast<double>(frame);
+        auto it = std::upper_bound(
+            _cameraPath.begin(),
+            _cameraPath.end(),
+            f,
+            [](double lhs, const Keyframe& rhs) { return lhs < rhs.frame; }
+        );
+        if (it == _cameraPath.begin()) {
+            position = it->position;
+            orientation = it->orientation;
+        }
+        else if (it == _cameraPath.end()) {
+            position = _cameraPath.back().position;
+            orientation = _cameraPath.back().orientation;
+        }
+        else {
+            const Keyframe& a = *(it - 1);
+            const Keyframe& b = *it;
+            const float t = static_cast<float>((f - a.frame) / (b.frame - a.frame));
+            auto mix = [t](const vec3& x, const vec3& y) {
+                return vec3(
+                    x.x + (y.x - x.x) * t,
+                    x.y + (y.y - x.y) * t,
+                    x.z + (y.z - x.z) * t
+                );
+            };
+            position = mix(a.position, b.position);
+            orientation = mix(a.orientation, b.orientation);
+        }
+    }
+
+    // The camera looks along the negative z-axis before it is rotated by the yaw around
+    // the y-axis, the pitch around the x-axis, and the roll around the z-axis
+    glm::mat4 pose = glm::translate(
+        glm::mat4(1.f),
+        glm::vec3(position.x, position.y, position.z)
+    );
+    pose = glm::rotate(pose, glm::radians(orientation.x), glm::vec3(0.f, 1.f, 0.f));
+    pose = glm::rotate(pose, glm::radians(orientation.y), glm::vec3(1.f, 0.f, 0.f));
+    pose = glm::rotate(pose, glm::radians(orientation.z), glm::vec3(0.f, 0.f, 1.f));
+    const glm::mat4 transform = glm::inverse(pose);
+
+    mat4 res;
+    std::memcpy(&res, glm::value_ptr(transform), sizeof(mat4));
+    return res;
+}
+
+} // namespace sgct
@@ -0,0 +1,399 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/binarylog.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // WIN32
+
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+    constexpr uint32_t Magic = 0x4C424753; // "SGBL"
+    constexpr uint32_t Version = 1;
+
+    // The header is followed by the format table and the ring of records
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        uint64_t formatTableSize;
+        int32_t nodeId;
+        uint32_t maxArguments;
+        double clockOffset;
+        // The total number of records that were written, of which the last `capacity`
+        // are kept
+        uint64_t count;
+        // The number of bytes of the format table that contain format strings
+        uint64_t formatTableUsed;
+    };
+    constexpr size_t HeaderSize = 4096;
+    static_assert(sizeof(FileHeader) <= HeaderSize);
+
+    struct Record {
+        // 0 while the record is being written, otherwise the number of the record plus 1
+        uint64_t sequence;
+        double time;
+        uint32_t format;
+        uint8_t nArguments;
+        std::array<uint8_t, sgct::BinaryLog::MaxArguments> types;
+        std::array<uint64_t, sgct::BinaryLog::MaxArguments> arguments;
+    };
+    static_assert(sizeof(Record) == 64);
+
+    constexpr size_t FileSize = HeaderSize + sgct::BinaryLog::FormatTableSize +
+        sgct::BinaryLog::Capacity * sizeof(Record);
+
+    // The format with the id 0, which is used for the events whose format did not fit
+    // into the table anymore
+    constexpr std::string_view UnknownFormat = "<format table full>";
+
+    std::atomic_bool isLogging = false;
+    std::byte* memory = nullptr;
+#ifdef WIN32
+    HANDLE file = nullptr;
+    HANDLE mapping = nullptr;
+#endif // WIN32
+
+    // All registered formats in the order of their ids, starting with 1, so that they
+    // can be written into the table again if the log is enabled with a new file
+    std::mutex formatsMutex;
+    std::vector<std::string_view> formats;
+    size_t formatTableUsed = UnknownFormat.size() + 1;
+
+    FileHeader& header() {
+        return *reinterpret_cast<FileHeader*>(memory);
+    }
+
+    char* formatTable() {
+        return reinterpret_cast<char*>(memory + HeaderSize);
+    }
+
+    Record* records() {
+        return reinterpret_cast<Record*>(
+            memory + HeaderSize + sgct::BinaryLog::FormatTableSize
+        );
+    }
+
+    bool mapFile(const std::filesystem::path& path) {
+#ifdef WIN32
+        file = CreateFileW(
+            path.c_str(),
+            GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ,
+            nullptr,
+            CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            file = nullptr;
+            return false;
+        }
+        mapping = CreateFileMappingW(
+            file,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(FileSize) >> 32),
+            static_cast<DWORD>(FileSize & 0xFFFFFFFF),
+            nullptr
+        );
+        if (!mapping) {
+            CloseHandle(file);
+            file = nullptr;
+            return false;
+        }
+        memory = reinterpret_cast<std::byte*>(
+            MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, FileSize)
+        );
+        if (!memory) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            mapping = nullptr;
+            file = nullptr;
+            return false;
+        }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(FileSize)) == -1) {
+            close(fd);
+            return false;
+        }
+        void* m = mmap(nullptr, FileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        // The mapping keeps the file alive on its own
+        close(fd);
+        if (m == MAP_FAILED) {
+            return false;
+        }
+        memory = reinterpret_cast<std::byte*>(m);
+#endif // WIN32
+        return true;
+    }
+
+    void unmapFile() {
+#ifdef WIN32
+        if (memory) {
+            UnmapViewOfFile(memory);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file) {
+            CloseHandle(file);
+        }
+        mapping = nullptr;
+        file = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        if (memory) {
+            munmap(memory, FileSize);
+        }
+#endif // WIN32
+        memory = nullptr;
+    }
+
+    // Formats the argument with the format \p spec, which is the replacement field
+    // without its argument id, such as `{}` or `{:.3f}`
+    std::string formatArgument(const std::string& spec, uint8_t type, uint64_t bits) {
+        using Type = sgct::BinaryLog::Argument::Type;
+
+        try {
+            switch (static_cast<Type>(type)) {
+                case Type::Signed:
+                {
+                    const int64_t value = static_cast<int64_t>(bits);
+                    return std::vformat(spec, std::make_format_args(value));
+                }
+                case Type::Unsigned:
+                    return std::vformat(spec, std::make_format_args(bits));
+                case Type::Floating:
+                {
+                    const double value = std::bit_cast<double>(bits);
+                    return std::vformat(spec, std::make_format_args(value));
+                }
+                default:
+                    return "<invalid argument>";
+            }
+        }
+        catch (const std::format_error&) {
+            // The format does not fit the type of the argument
+            return std::format("<invalid format '{}'>", spec);
+        }
+    }
+
+    std::string formatRecord(std::string_view format, const Record& record) {
+        std::string res;
+        int argument = 0;
+        for (size_t i = 0; i < format.size(); i++) {
+            const char c = format[i];
+            const bool isDoubled = i + 1 < format.size() && format[i + 1] == c;
+            if ((c == '{' || c == '}') && isDoubled) {
+                res += c;
+                i++;
+                continue;
+            }
+            if (c != '{') {
+                res += c;
+                continue;
+            }
+
+            const size_t end = format.find('}', i);
+            if (end == std::string_view::npos) {
+                res += format.substr(i);
+                break;
+            }
+            const std::string_view field = format.substr(i + 1, end - i - 1);
+            const size_t colon = field.find(':');
+            const std::string spec = colon == std::string_view::npos ?
+                "{}" :
+                std::format("{{{}}}", field.substr(colon));
+            if (argument < record.nArguments) {
+                res += formatArgument(
+                    spec,
+                    record.types[argument],
+                    record.arguments[argument]
+                );
+            }
+            else {
+                res += "<missing argument>";
+            }
+            argument++;
+            i = end;
+        }
+        return res;
+    }
+} // namespace
+
+namespace sgct {
+
+void BinaryLog::enable(const std::filesystem::path& folder, int nodeId) {
+    disable();
+
+    std::error_code ec;
+    std::filesystem::create_directories(folder, ec);
+    const std::filesystem::path path =
+        folder / std::format("binarylog-node{}.sgctlog", nodeId);
+    if (!mapFile(path)) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Error(std::format("Failed to create binary log '{}'", path.string()));
+        return;
+    }
+
+    FileHeader& h = header();
+    h.magic = Magic;
+    h.version = Version;
+    h.capacity = Capacity;
+    h.formatTableSize = FormatTableSize;
+    h.nodeId = nodeId;
+    h.maxArguments = MaxArguments;
+    h.clockOffset = 0.0;
+    h.count = 0;
+
+    // The formats that were registered for a previous file keep their ids
+    const std::lock_guard lock(formatsMutex);
+    char* table = formatTable();
+    std::memcpy(table, UnknownFormat.data(), UnknownFormat.size());
+    table += UnknownFormat.size() + 1;
+    for (std::string_view format : formats) {
+        std::memcpy(table, format.data(), format.size());
+        table += format.size() + 1;
+    }
+    h.formatTableUsed = formatTableUsed;
+
+    isLogging = true;
+}
+
+void BinaryLog::disable() {
+    isLogging = false;
+    unmapFile();
+}
+
+bool BinaryLog::isEnabled() {
+    return isLogging.load(std::memory_order_relaxed);
+}
+
+void BinaryLog::setClockOffset(double offset) {
+    if (isEnabled()) {
+        std::atomic_ref(header().clockOffset).store(offset, std::memory_order_relaxed);
+    }
+}
+
+uint32_t BinaryLog::registerFormat(const char* format) {
+    const std::string_view f = format;
+
+    const std::lock_guard lock(formatsMutex);
+    if (formatTableUsed + f.size() + 1 > FormatTableSize) {
+        Log::Warning(std::format("Binary log format table is full, dropping '{}'", f));
+        return 0;
+    }
+
+    if (memory) {
+        std::memcpy(formatTable() + formatTableUsed, f.data(), f.size());
+        std::atomic_ref(header().formatTableUsed).store(
+            formatTableUsed + f.size() + 1,
+            std::memory_order_release
+        );
+    }
+    formatTableUsed += f.size() + 1;
+    formats.push_back(f);
+    return static_cast<uint32_t>(formats.size());
+}
+
+void BinaryLog::writeRecord(uint32_t format, std::span<const Argument> arguments) {
+    const uint64_t index =
+        std::atomic_ref(header().count).fetch_add(1, std::memory_order_relaxed);
+    // Another thread would only write into the same record if it wrote a whole ring of
+    // records while this one is being written, which the decoder cannot tell apart
+    Record& record = records()[index % Capacity];
+
+    std::atomic_ref(record.sequence).store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.time = time();
+    record.format = format;
+    record.nArguments = static_cast<uint8_t>(arguments.size());
+    for (size_t i = 0; i < arguments.size(); i++) {
+        record.types[i] = static_cast<uint8_t>(arguments[i].type);
+        record.arguments[i] = arguments[i].bits;
+    }
+    std::atomic_ref(record.sequence).store(index + 1, std::memory_order_release);
+}
+
+std::vector<std::string> BinaryLog::decode(std::span<const std::byte> data) {
+    if (data.size() < HeaderSize) {
+        throw std::runtime_error("File is too small to be a binary log");
+    }
+    FileHeader h;
+    std::memcpy(&h, data.data(), sizeof(FileHeader));
+    if (h.magic != Magic) {
+        throw std::runtime_error("File is not a binary log");
+    }
+    if (h.version != Version) {
+        throw std::runtime_error(std::format("Unsupported version {}", h.version));
+    }
+    if (h.maxArguments != MaxArguments || h.capacity == 0 ||
+        h.formatTableUsed > h.formatTableSize ||
+        data.size() != HeaderSize + h.formatTableSize + h.capacity * sizeof(Record))
+    {
+        throw std::runtime_error("Binary log is damaged");
+    }
+
+    std::vector<std::string_view> table;
+    std::string_view t = std::string_view(
+        reinterpret_cast<const char*>(data.data() + HeaderSize),
+        h.formatTableUsed
+    );
+    while (!t.empty()) {
+        const size_t end = t.find('\0');
+        table.push_back(t.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        t.remove_prefix(end + 1);
+    }
+
+    const std::byte* recordData = data.data() + HeaderSize + h.formatTableSize;
+    const uint64_t first = h.count - std::min(h.count, h.capacity);
+    std::vector<std::string> res;
+    res.reserve(h.count - first);
+    for (uint64_t i = first; i < h.count; i++) {
+        Record record;
+        const size_t offset = (i % h.capacity) * sizeof(Record);
+        std::memcpy(&record, recordData + offset, sizeof(Record));
+        if (record.sequence != i + 1) {
+            // The record was being written when the application ended
+            continue;
+        }
+
+        const std::string message = record.format < table.size() ?
+            formatRecord(table[record.format], record) :
+            std::format("<unknown format {}>", record.format);
+        res.push_back(std::format("{:.6f} {}", record.time + h.clockOffset, message));
+    }
+    return res;
+}
+
+} // namespace sgct
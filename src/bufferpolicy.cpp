@@ -0,0 +1,257 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/bufferpolicy.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+#endif // WIN32
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace {
+    using Subsystem = sgct::BufferPolicy::Subsystem;
+
+    constexpr int NumberOfSubsystems = 4;
+
+    constexpr std::array<std::string_view, NumberOfSubsystems> SubsystemNames = {
+        "network", "shared data", "capture", "NDI"
+    };
+
+    struct Policy {
+        bool hugePages = true;
+        int numaNode = -1;
+    };
+
+    std::mutex policiesMutex;
+    std::array<Policy, NumberOfSubsystems> policies;
+
+    // Every buffer of a subsystem would fail the same way, so each one only logs once
+    std::array<std::atomic_flag, NumberOfSubsystems> hasReported;
+
+    Policy policy(Subsystem subsystem) {
+        const std::lock_guard lock(policiesMutex);
+        return policies[static_cast<int>(subsystem)];
+    }
+
+    void report(Subsystem subsystem, std::string_view message) {
+        const int s = static_cast<int>(subsystem);
+        if (!hasReported[s].test_and_set()) {
+            sgct::Log::Warning(std::format(
+                "Could not {} for the {} buffers", message, SubsystemNames[s]
+            ));
+        }
+    }
+
+    size_t roundUp(size_t bytes, size_t granularity) {
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    // The size of the mapping that is created for a buffer of the requested size. Buffers
+    // that can hold a huge page are rounded to full huge pages, so that the end of the
+    // buffer does not fall back to regular pages
+    size_t mappingSize(size_t bytes) {
+        if (bytes >= sgct::BufferPolicy::HugePageSize) {
+            return roundUp(bytes, sgct::BufferPolicy::HugePageSize);
+        }
+        return bytes;
+    }
+
+#ifdef __linux__
+    // Prefers the NUMA node for the pages of the range, and moves the pages of the range
+    // that are already in memory if \p move is set
+    bool bindToNode(void* data, size_t bytes, int node, bool move) {
+        constexpr size_t BitsPerMask = sizeof(unsigned long) * 8;
+        std::array<unsigned long, 16> mask = {};
+        if (static_cast<size_t>(node) >= mask.size() * BitsPerMask) {
+            return false;
+        }
+        mask[node / BitsPerMask] = 1ul << (node % BitsPerMask);
+        const long res = syscall(
+            SYS_mbind,
+            data,
+            bytes,
+            MPOL_PREFERRED,
+            mask.data(),
+            mask.size() * BitsPerMask,
+            move ? MPOL_MF_MOVE : 0
+        );
+        return res == 0;
+    }
+#endif // __linux__
+} // namespace
+
+namespace sgct {
+
+void BufferPolicy::configure(const config::Settings::Buffers& buffers) {
+    auto toPolicy = [](const std::optional<config::Settings::Buffer>& buffer) {
+        Policy res;
+        if (buffer) {
+            res.hugePages = buffer->hugePages.value_or(res.hugePages);
+            res.numaNode = buffer->numaNode.value_or(res.numaNode);
+        }
+        return res;
+    };
+
+    const std::lock_guard lock(policiesMutex);
+    policies = {
+        toPolicy(buffers.network),
+        toPolicy(buffers.sharedData),
+        toPolicy(buffers.capture),
+        toPolicy(buffers.ndi)
+    };
+    for (std::atomic_flag& flag : hasReported) {
+        flag.clear();
+    }
+}
+
+void* BufferPolicy::allocate(Subsystem subsystem, size_t bytes) {
+    if (bytes < MinimumSize) {
+        return ::operator new(bytes);
+    }
+
+    const Policy p = policy(subsystem);
+    const size_t size = mappingSize(bytes);
+#ifdef WIN32
+    DWORD type = MEM_RESERVE | MEM_COMMIT;
+    const size_t largePage = GetLargePageMinimum();
+    if (p.hugePages && largePage > 0 && size % largePage == 0) {
+        type |= MEM_LARGE_PAGES;
+    }
+    const DWORD node =
+        p.numaNode >= 0 ? static_cast<DWORD>(p.numaNode) : NUMA_NO_PREFERRED_NODE;
+    void* data = VirtualAllocExNuma(
+        GetCurrentProcess(),
+        nullptr,
+        size,
+        type,
+        PAGE_READWRITE,
+        node
+    );
+    if (!data && (type & MEM_LARGE_PAGES)) {
+        // Large pages need the privilege to lock the memory, which is rarely granted
+        report(subsystem, "allocate large pages");
+        data = VirtualAllocExNuma(
+            GetCurrentProcess(),
+            nullptr,
+            size,
+            MEM_RESERVE | MEM_COMMIT,
+            PAGE_READWRITE,
+            node
+        );
+    }
+    if (!data) {
+        throw std::bad_alloc();
+    }
+    return data;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const bool isHuge = p.hugePages && size % HugePageSize == 0;
+    // The transparent huge pages are only used for the parts of a mapping that are
+    // aligned to the huge page size, so the mapping is over-allocated and trimmed
+    const size_t reserve = isHuge ? size + HugePageSize : size;
+    void* mapping = mmap(
+        nullptr,
+        reserve,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    char* data = static_cast<char*>(mapping);
+    if (isHuge) {
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(mapping);
+        const uintptr_t aligned = roundUp(begin, HugePageSize);
+        data = reinterpret_cast<char*>(aligned);
+        const size_t head = aligned - begin;
+        if (head > 0) {
+            munmap(mapping, head);
+        }
+        const size_t tail = reserve - head - size;
+        if (tail > 0) {
+            munmap(data + size, tail);
+        }
+    }
+
+    // The hints have to be given before the pages are touched for the first time
+    advise(subsystem, data, size);
+    return data;
+#endif // WIN32
+}
+
+void BufferPolicy::deallocate(void* data, size_t bytes) {
+    if (!data) {
+        return;
+    }
+    if (bytes < MinimumSize) {
+        ::operator delete(data);
+        return;
+    }
+
+#ifdef WIN32
+    VirtualFree(data, 0, MEM_RELEASE);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    munmap(data, mappingSize(bytes));
+#endif // WIN32
+}
+
+void BufferPolicy::advise(Subsystem subsystem, void* data, size_t bytes) {
+#ifdef __linux__
+    const Policy p = policy(subsystem);
+
+    // Both hints only apply to whole pages, which for the huge pages means that only
+    // the huge pages that lie entirely within the buffer are affected
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t end = begin + bytes;
+    const uintptr_t hugeBegin = roundUp(begin, HugePageSize);
+    const uintptr_t hugeEnd = end / HugePageSize * HugePageSize;
+    if (p.hugePages && hugeEnd > hugeBegin) {
+        void* d = reinterpret_cast<void*>(hugeBegin);
+        if (madvise(d, hugeEnd - hugeBegin, MADV_HUGEPAGE) != 0) {
+            report(subsystem, "use transparent huge pages");
+        }
+    }
+
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t pageBegin = roundUp(begin, pageSize);
+    const uintptr_t pageEnd = end / pageSize * pageSize;
+    if (p.numaNode >= 0 && pageEnd > pageBegin) {
+        void* d = reinterpret_cast<void*>(pageBegin);
+        if (!bindToNode(d, pageEnd - pageBegin, p.numaNode, true)) {
+            report(subsystem, std::format("use NUMA node {}", p.numaNode));
+        }
+    }
+#else // ^^^^ __linux__ // !__linux__ vvvv
+    // Windows places the memory when it is allocated, which is not possible for buffers
+    // that already exist, and macOS does not support either hint
+    (void)subsystem;
+    (void)data;
+    (void)bytes;
+#endif // __linux__
+}
+
+} // namespace sgct
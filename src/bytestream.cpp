@@ -0,0 +1,135 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/bytestream.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Engine, code, msg)
+
+namespace sgct {
+
+ByteReader::ByteReader(std::span<const std::byte> data)
+    : _data(data)
+{}
+
+void ByteReader::read(std::string& value) {
+    const std::string_view view = readStringView();
+    value.assign(view.data(), view.size());
+}
+
+void ByteReader::read(std::wstring& value) {
+    const uint32_t size = read<uint32_t>();
+    require(size * sizeof(wchar_t));
+    value.resize(size);
+    if (size > 0) {
+        std::memcpy(value.data(), _data.data() + _pos, size * sizeof(wchar_t));
+    }
+    _pos += size * sizeof(wchar_t);
+}
+
+std::string_view ByteReader::readStringView() {
+    const uint32_t size = read<uint32_t>();
+    require(size);
+    const std::string_view value =
+        std::string_view(reinterpret_cast<const char*>(_data.data() + _pos), size);
+    _pos += size;
+    return value;
+}
+
+std::span<const std::byte> ByteReader::readBytes(size_t size) {
+    require(size);
+    const std::span<const std::byte> value = _data.subspan(_pos, size);
+    _pos += size;
+    return value;
+}
+
+void ByteReader::align(size_t alignment) {
+    const size_t padding = (alignment - _pos % alignment) % alignment;
+    require(padding);
+    _pos += padding;
+}
+
+size_t ByteReader::position() const {
+    return _pos;
+}
+
+size_t ByteReader::remaining() const {
+    return _data.size() - _pos;
+}
+
+void ByteReader::require(size_t size) const {
+    if (size > _data.size() - _pos) {
+        throw Err(
+            3012,
+            std::format(
+                "Reading {} bytes at position {} exceeds the data of {} bytes",
+                size, _pos, _data.size()
+            )
+        );
+    }
+}
+
+void ByteReader::requireAlignment(const std::byte* ptr, size_t alignment) const {
+    if (reinterpret_cast<uintptr_t>(ptr) % alignment != 0) {
+        throw Err(
+            3013,
+            std::format(
+                "Array at position {} is not aligned to {} bytes", _pos, alignment
+            )
+        );
+    }
+}
+
+ByteWriter::ByteWriter(std::vector<std::byte>& buffer)
+    : _buffer(buffer)
+    , _begin(buffer.size())
+{}
+
+void ByteWriter::reserve(size_t size) {
+    _buffer.reserve(_buffer.size() + size);
+}
+
+void ByteWriter::write(std::string_view value) {
+    write(static_cast<uint32_t>(value.size()));
+    append(value.data(), value.size());
+}
+
+void ByteWriter::write(const std::string& value) {
+    write(std::string_view(value));
+}
+
+void ByteWriter::write(const char* value) {
+    write(std::string_view(value));
+}
+
+void ByteWriter::write(const std::wstring& value) {
+    write(static_cast<uint32_t>(value.size()));
+    append(value.data(), value.size() * sizeof(wchar_t));
+}
+
+void ByteWriter::writeBytes(std::span<const std::byte> value) {
+    append(value.data(), value.size());
+}
+
+void ByteWriter::align(size_t alignment) {
+    const size_t padding = (alignment - size() % alignment) % alignment;
+    _buffer.resize(_buffer.size() + padding, std::byte(0));
+}
+
+size_t ByteWriter::size() const {
+    return _buffer.size() - _begin;
+}
+
+void ByteWriter::append(const void* data, size_t size) {
+    const std::byte* begin = reinterpret_cast<const std::byte*>(data);
+    _buffer.insert(_buffer.end(), begin, begin + size);
+}
+
+} // namespace sgct
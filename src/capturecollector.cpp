@@ -0,0 +1,291 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/capturecollector.h>
+
+#include <sgct/clustermanager.h>
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/network.h>
+#include <sgct/networkmanager.h>
+#include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+
+namespace {
+    // Every transfer starts with the node id and the length of the file name, followed
+    // by the file name and the content of the file
+    constexpr size_t FixedHeaderSize = sizeof(int32_t) + sizeof(uint32_t);
+
+    constexpr double BytesPerMegabyte = 1024.0 * 1024.0;
+
+    const sgct::Network* dataTransferConnection() {
+        const sgct::NetworkManager& nm = sgct::NetworkManager::instance();
+        for (int i = 0; i < nm.connectionsCount(); i++) {
+            const sgct::Network& connection = nm.connection(i);
+            if (connection.type() == sgct::Network::ConnectionType::DataTransfer &&
+                connection.isConnected())
+            {
+                return &connection;
+            }
+        }
+        return nullptr;
+    }
+} // namespace
+
+namespace sgct {
+
+CaptureCollector::~CaptureCollector() {
+    {
+        const std::lock_guard lock(_mutex);
+        _isRunning = false;
+    }
+    _cv.notify_one();
+    if (_sender.joinable()) {
+        _sender.join();
+    }
+
+    const Statistics stats = statistics();
+    if (stats.nSent > 0) {
+        const double megabytes = stats.bytesSent / BytesPerMegabyte;
+        Log::Info(std::format(
+            "Sent {} screenshots ({:.1f} MB) to the master at {:.1f} MB/s",
+            stats.nSent, megabytes,
+            stats.sendTime > 0.0 ? megabytes / stats.sendTime : 0.0
+        ));
+    }
+    if (stats.nPending > 0) {
+        Log::Warning(std::format(
+            "{} screenshots could not be sent to the master and remain in the capture "
+            "path", stats.nPending
+        ));
+    }
+    if (stats.nReceived > 0) {
+        Log::Info(std::format(
+            "Received {} screenshots ({:.1f} MB) from the clients",
+            stats.nReceived, stats.bytesReceived / BytesPerMegabyte
+        ));
+    }
+
+    // Files whose transfer was interrupted are incomplete, so they are removed
+    const std::lock_guard lock(_incomingMutex);
+    for (auto& [client, incoming] : _incoming) {
+        if (incoming.file.is_open()) {
+            incoming.file.close();
+            std::error_code ec;
+            std::filesystem::remove(incoming.path, ec);
+        }
+    }
+}
+
+void CaptureCollector::send(std::filesystem::path path) {
+    {
+        const std::lock_guard lock(_mutex);
+        if (!_sender.joinable()) {
+            _sender = std::thread(&CaptureCollector::work, this);
+        }
+        _queue.push_back(std::move(path));
+    }
+    _cv.notify_one();
+}
+
+void CaptureCollector::receive(const void* data, int length, uint64_t offset,
+                               uint64_t total, int clientIndex)
+{
+    ZoneScoped;
+
+    const std::lock_guard lock(_incomingMutex);
+    Incoming& incoming = _incoming[clientIndex];
+    if (offset == 0 && incoming.received > 0) {
+        // The client started over, so the previous file is abandoned
+        if (incoming.file.is_open()) {
+            incoming.file.close();
+            std::error_code ec;
+            std::filesystem::remove(incoming.path, ec);
+        }
+        incoming = Incoming();
+    }
+
+    // After a reconnection, the chunk that was not acknowledged is sent again
+    const char* bytes = reinterpret_cast<const char*>(data);
+    const char* end = bytes + length;
+    if (offset + length <= incoming.received) {
+        return;
+    }
+    if (offset > incoming.received) {
+        Log::Error(std::format(
+            "Missing {} bytes of a screenshot from client {}",
+            offset - incoming.received, clientIndex
+        ));
+        incoming = Incoming();
+        return;
+    }
+    bytes += incoming.received - offset;
+
+    while (bytes < end && !incoming.file.is_open()) {
+        incoming.header.push_back(*bytes);
+        bytes++;
+        incoming.received++;
+        if (incoming.header.size() < FixedHeaderSize) {
+            continue;
+        }
+
+        int32_t nodeId = 0;
+        uint32_t nameLength = 0;
+        std::memcpy(&nodeId, incoming.header.data(), sizeof(int32_t));
+        std::memcpy(
+            &nameLength,
+            incoming.header.data() + sizeof(int32_t),
+            sizeof(uint32_t)
+        );
+        if (incoming.header.size() < FixedHeaderSize + nameLength) {
+            continue;
+        }
+
+        // Only the file name is used so that a client cannot write outside of the
+        // capture path
+        const std::filesystem::path name = std::filesystem::path(
+            incoming.header.substr(FixedHeaderSize)
+        ).filename();
+        const std::filesystem::path folder =
+            Engine::instance().settings().capture.capturePath /
+            std::format("node{}", nodeId);
+        std::error_code ec;
+        std::filesystem::create_directories(folder, ec);
+        incoming.path = folder / name;
+        incoming.file.open(incoming.path, std::ios::binary | std::ios::trunc);
+        if (!incoming.file.is_open()) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            // formatting std::filesystem::path
+            Log::Error(std::format(
+                "Failed to create collected screenshot '{}'", incoming.path.string()
+            ));
+            incoming = Incoming();
+            return;
+        }
+    }
+
+    if (bytes < end) {
+        incoming.file.write(bytes, end - bytes);
+        incoming.received += static_cast<uint64_t>(end - bytes);
+    }
+
+    if (incoming.received == total) {
+        incoming.file.close();
+        _nReceived++;
+        _bytesReceived += total;
+        _incoming.erase(clientIndex);
+    }
+}
+
+CaptureCollector::Statistics CaptureCollector::statistics() const {
+    Statistics stats;
+    {
+        const std::lock_guard lock(_mutex);
+        stats.nPending = _queue.size();
+    }
+    stats.nSent = _nSent;
+    stats.bytesSent = _bytesSent;
+    stats.sendTime = _sendTime;
+    stats.nReceived = _nReceived;
+    stats.bytesReceived = _bytesReceived;
+    return stats;
+}
+
+void CaptureCollector::work() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Capture, "Collect");
+
+    while (true) {
+        std::filesystem::path path;
+        {
+            std::unique_lock lock(_mutex);
+            // The remaining files are still sent after the collector has been stopped
+            _cv.wait(lock, [this]() { return !_queue.empty() || !_isRunning; });
+            if (_queue.empty()) {
+                return;
+            }
+            path = _queue.front();
+        }
+
+        const bool success = sendFile(path);
+        if (!success && !NetworkManager::instance().isRunning()) {
+            // Nothing can be sent anymore, so the files are left in the staging area
+            return;
+        }
+
+        const std::lock_guard lock(_mutex);
+        _queue.pop_front();
+    }
+}
+
+bool CaptureCollector::sendFile(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    const std::string filename = path.string();
+
+    const Network* connection = dataTransferConnection();
+    if (!connection) {
+        Log::Warning(std::format(
+            "No data transfer connection to the master, keeping '{}'", filename
+        ));
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        Log::Error(std::format("Failed to open screenshot '{}'", filename));
+        return false;
+    }
+    const size_t size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    const std::string name = path.filename().string();
+    const int32_t nodeId = ClusterManager::instance().thisNodeId();
+    const uint32_t nameLength = static_cast<uint32_t>(name.size());
+    const size_t headerSize = FixedHeaderSize + name.size();
+    _buffer.resize(headerSize + size);
+    std::memcpy(_buffer.data(), &nodeId, sizeof(int32_t));
+    std::memcpy(_buffer.data() + sizeof(int32_t), &nameLength, sizeof(uint32_t));
+    std::memcpy(_buffer.data() + FixedHeaderSize, name.data(), name.size());
+    file.read(_buffer.data() + headerSize, static_cast<std::streamsize>(size));
+    if (!file.good()) {
+        Log::Error(std::format("Failed to read screenshot '{}'", filename));
+        return false;
+    }
+    file.close();
+
+    // This blocks until the master has acknowledged all chunks, and continues after a
+    // lost connection has been reestablished
+    const auto start = std::chrono::steady_clock::now();
+    NetworkManager::instance().transferChunkedData(
+        _buffer.data(),
+        _buffer.size(),
+        PackageId,
+        *connection
+    );
+    if (!NetworkManager::instance().isRunning()) {
+        return false;
+    }
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+
+    _nSent++;
+    _bytesSent += _buffer.size();
+    _sendTime += duration.count();
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return true;
+}
+
+} // namespace sgct
@@ -18,6 +18,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <iterator>
 
 namespace sgct {
 
@@ -67,6 +68,85 @@ ClusterManager::ClusterManager(const config::Cluster& cluster, int clusterID)
         Log::instance().setNotifyLevel(Log::Level::Debug);
     }
 
+    if (cluster.settings && cluster.settings->network) {
+        const config::Settings::Network& network = *cluster.settings->network;
+        _useDeltaSync = network.deltaSync.value_or(_useDeltaSync);
+        _deltaSyncKeyframeInterval =
+            network.deltaSyncKeyframeInterval.value_or(_deltaSyncKeyframeInterval);
+        _useCompression = network.compression.value_or(_useCompression);
+        _compressionThreshold =
+            network.compressionThreshold.value_or(_compressionThreshold);
+        _compressionLevel = network.compressionLevel.value_or(_compressionLevel);
+        _multicastAddress = network.multicastAddress.value_or(_multicastAddress);
+        _multicastPort = network.multicastPort.value_or(_multicastPort);
+        _useParallelSend = network.parallelSend.value_or(_useParallelSend);
+        _useEventDrivenNetwork = network.eventDriven.value_or(_useEventDrivenNetwork);
+        _usePipelinedSync = network.pipelinedSync.value_or(_usePipelinedSync);
+        _transferChunkSize = network.transferChunkSize.value_or(_transferChunkSize);
+        _transferRateLimit = network.transferRateLimit.value_or(_transferRateLimit);
+        _transferWindow = network.transferWindow.value_or(_transferWindow);
+        _useSharedMemory = network.sharedMemory.value_or(_useSharedMemory);
+        _rdmaBufferSize = network.rdmaBufferSize.value_or(_rdmaBufferSize);
+        _forwardLog = network.forwardLog.value_or(_forwardLog);
+        _metricsPort = network.metricsPort.value_or(_metricsPort);
+        _controlPort = network.controlPort.value_or(_controlPort);
+        _controlUdpPort = network.controlUdpPort.value_or(_controlUdpPort);
+        if (network.syncDeadline) {
+            _syncDeadline = *network.syncDeadline / 1000.0;
+        }
+
+        auto convert = [](const config::Settings::Network::SocketProfile& p) {
+            SocketProfile profile;
+            profile.sendBufferSize = p.sendBufferSize.value_or(profile.sendBufferSize);
+            profile.receiveBufferSize =
+                p.receiveBufferSize.value_or(profile.receiveBufferSize);
+            profile.dscp = p.dscp.value_or(profile.dscp);
+            profile.interfaceAddress =
+                p.interfaceAddress.value_or(profile.interfaceAddress);
+            profile.autoTuneBuffers = p.autoTuneBuffers.value_or(profile.autoTuneBuffers);
+            return profile;
+        };
+        if (network.syncSocket) {
+            _syncSocketProfile = convert(*network.syncSocket);
+        }
+        if (network.transferSocket) {
+            _transferSocketProfile = convert(*network.transferSocket);
+        }
+    }
+
+    const auto master = std::find_if(
+        cluster.nodes.cbegin(),
+        cluster.nodes.cend(),
+        [&](const config::Node& n) { return n.address == _masterAddress; }
+    );
+    if (master != cluster.nodes.cend()) {
+        _masterNodeIndex =
+            static_cast<int>(std::distance(cluster.nodes.cbegin(), master));
+    }
+
+    using Topology = config::Settings::Network::TransferTopology;
+    const Topology topology =
+        cluster.settings && cluster.settings->network ?
+        cluster.settings->network->transferTopology.value_or(Topology::Star) :
+        Topology::Star;
+    if (topology != Topology::Star) {
+        // The master is at the root, followed by the clients that receive data transfers
+        // in the order of the nodes. In a chain, every node sends to the next one, in a
+        // binary tree to the two nodes at twice its position
+        std::vector<int> order = { _masterNodeIndex };
+        for (int i = 0; i < static_cast<int>(cluster.nodes.size()); i++) {
+            if (i != _masterNodeIndex && cluster.nodes[i].dataTransferPort.value_or(0)) {
+                order.push_back(i);
+            }
+        }
+
+        _transferParents.resize(cluster.nodes.size(), -1);
+        for (size_t p = 1; p < order.size(); p++) {
+            const size_t parent = topology == Topology::Chain ? p - 1 : (p - 1) / 2;
+            _transferParents[order[p]] = order[parent];
+        }
+    }
+
     if (cluster.scene) {
         const glm::mat4 translate = cluster.scene->offset ?
             glm::translate(
@@ -125,6 +205,109 @@ bool ClusterManager::ignoreSync() const {
     return _ignoreSync;
 }
 
+bool ClusterManager::useDeltaSync() const {
+    return _useDeltaSync;
+}
+
+int ClusterManager::deltaSyncKeyframeInterval() const {
+    return _deltaSyncKeyframeInterval;
+}
+
+bool ClusterManager::useCompression() const {
+    return _useCompression;
+}
+
+int ClusterManager::compressionThreshold() const {
+    return _compressionThreshold;
+}
+
+int ClusterManager::compressionLevel() const {
+    return _compressionLevel;
+}
+
+const std::string& ClusterManager::multicastAddress() const {
+    return _multicastAddress;
+}
+
+int ClusterManager::multicastPort() const {
+    return _multicastPort;
+}
+
+bool ClusterManager::useParallelSend() const {
+    return _useParallelSend;
+}
+
+bool ClusterManager::useEventDrivenNetwork() const {
+    return _useEventDrivenNetwork;
+}
+
+bool ClusterManager::usePipelinedSync() const {
+    return _usePipelinedSync;
+}
+
+int ClusterManager::transferChunkSize() const {
+    return _transferChunkSize;
+}
+
+int ClusterManager::transferRateLimit() const {
+    return _transferRateLimit;
+}
+
+int ClusterManager::transferWindow() const {
+    return _transferWindow;
+}
+
+double ClusterManager::syncDeadline() const {
+    return _syncDeadline;
+}
+
+bool ClusterManager::useSharedMemory() const {
+    return _useSharedMemory;
+}
+
+int ClusterManager::rdmaBufferSize() const {
+    return _rdmaBufferSize;
+}
+
+bool ClusterManager::forwardLog() const {
+    return _forwardLog;
+}
+
+int ClusterManager::metricsPort() const {
+    return _metricsPort;
+}
+
+int ClusterManager::controlPort() const {
+    return _controlPort;
+}
+
+int ClusterManager::controlUdpPort() const {
+    return _controlUdpPort;
+}
+
+const ClusterManager::SocketProfile& ClusterManager::syncSocketProfile() const {
+    return _syncSocketProfile;
+}
+
+const ClusterManager::SocketProfile& ClusterManager::transferSocketProfile() const {
+    return _transferSocketProfile;
+}
+
+bool ClusterManager::relaysTransfers() const {
+    return !_transferParents.empty();
+}
+
+int ClusterManager::transferParent(int nodeIndex) const {
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(_transferParents.size())) {
+        return -1;
+    }
+    return _transferParents[nodeIndex];
+}
+
+int ClusterManager::masterNodeIndex() const {
+    return _masterNodeIndex;
+}
+
 void ClusterManager::setUseIgnoreSync(bool state) {
     _ignoreSync = state;
 }
@@ -29,6 +29,10 @@ Configuration parseArguments(std::vector<std::string>& arg) {
             config.logLevel = Log::Level::Debug;
             arg.erase(arg.begin() + i);
         }
+        else if (arg[i] == "--async-log") {
+            config.asyncLog = true;
+            arg.erase(arg.begin() + i);
+        }
         else if (arg[i] == "--help" || arg[i] == "-h") {
             config.showHelpText = true;
             arg.erase(arg.begin() + i);
@@ -93,6 +97,38 @@ Configuration parseArguments(std::vector<std::string>& arg) {
             config.waitTimeout = std::stof(arg[i + 1]);
             arg.erase(arg.begin() + 1, arg.begin() + i + 2);
         }
+        else if (arg[i] == "--headless") {
+            config.headless = true;
+            arg.erase(arg.begin() + i);
+        }
+        else if (arg[i] == "--benchmark" && arg.size() > (i + 1)) {
+            config.benchmarkFrames = std::stoi(arg[i + 1]);
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
+        else if (arg[i] == "--benchmark-output" && arg.size() > (i + 1)) {
+            config.benchmarkPath = arg[i + 1];
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
+        else if (arg[i] == "--benchmark-camera" && arg.size() > (i + 1)) {
+            config.benchmarkCameraPath = arg[i + 1];
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
+        else if (arg[i] == "--serve-config" && arg.size() > (i + 1)) {
+            config.configServePort = std::stoi(arg[i + 1]);
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
+        else if (arg[i] == "--config-server" && arg.size() > (i + 1)) {
+            const std::string& server = arg[i + 1];
+            const size_t colon = server.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "Config server has to be given as <address>:<port>\n";
+            }
+            else {
+                config.configServerAddress = server.substr(0, colon);
+                config.configServerPort = std::stoi(server.substr(colon + 1));
+            }
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
         else {
             // Ignore unknown commands
             i++;
@@ -123,6 +159,9 @@ Parameters:
     Disable frame sync
 --notify <"error", "warning", "info", or "debug">
     Set the notify level used in the Log
+--async-log
+    Writes the log messages on a background thread, so that logging does not delay the
+    rendering
 --capture-jpg
     Use jpg images for screen capture
 --capture-tga
@@ -139,6 +178,25 @@ Parameters:
     If set, screenshots will not contain the name of the window if multiple windows exist
 --number-capture-threads <integer>
     Set the maximum amount of thread that should be used during framecapture
+--headless
+    Renders into windows that are never shown or presented, without waiting for the
+    vertical sync, and without a window system if GLFW supports it
+--benchmark <integer>
+    Renders a synthetic scene instead of the application for the number of frames after
+    a warm-up and writes the percentiles of the frame times to a file. All nodes of the
+    cluster have to be started with this option
+--benchmark-output <filename.json>
+    Sets the file into which the benchmark results are written, which defaults to
+    benchmark-node<id>.json
+--benchmark-camera <filename>
+    Moves the camera of the benchmark along the keyframes in the file, which contains one
+    'frame x y z yaw pitch roll' per line
+--serve-config <integer>
+    Serves the configuration of the master on this port, so that the clients can request
+    it with --config-server instead of loading their own copy of the file
+--config-server <address>:<port>
+    Requests the configuration from the master that was started with --serve-config
+    instead of loading it from a file
 )";
 }
 
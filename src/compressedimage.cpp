@@ -0,0 +1,352 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/compressedimage.h>
+
+#include <sgct/correction/mappedfile.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+namespace {
+    // The S3TC and ASTC formats are not part of the core profile, so they are not
+    // declared by the OpenGL loader
+    constexpr GLenum CompressedRgbS3tcDxt1 = 0x83F0;
+    constexpr GLenum CompressedRgbaS3tcDxt1 = 0x83F1;
+    constexpr GLenum CompressedRgbaS3tcDxt3 = 0x83F2;
+    constexpr GLenum CompressedRgbaS3tcDxt5 = 0x83F3;
+    constexpr GLenum CompressedSrgbS3tcDxt1 = 0x8C4C;
+    constexpr GLenum CompressedSrgbAlphaS3tcDxt1 = 0x8C4D;
+    constexpr GLenum CompressedSrgbAlphaS3tcDxt3 = 0x8C4E;
+    constexpr GLenum CompressedSrgbAlphaS3tcDxt5 = 0x8C4F;
+    constexpr GLenum CompressedRgbaAstc4x4 = 0x93B0;
+    constexpr GLenum CompressedSrgb8Alpha8Astc4x4 = 0x93D0;
+
+    constexpr std::array<unsigned char, 12> Ktx2Identifier = {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+    constexpr std::array<unsigned char, 4> DdsIdentifier = { 'D', 'D', 'S', ' ' };
+
+    // The sizes of the KTX2 header up to the level index and of one level index entry
+    constexpr size_t Ktx2HeaderSize = 80;
+    constexpr size_t Ktx2LevelSize = 3 * sizeof(uint64_t);
+
+    // The sizes of the DDS header and of its extension for DXGI formats
+    constexpr size_t DdsHeaderSize = 4 + 124;
+    constexpr size_t DdsDx10HeaderSize = 20;
+
+    // A 32 bit size cannot be halved more often than this
+    constexpr uint32_t MaxLevels = 32;
+
+    struct BlockFormat {
+        GLenum internalFormat = 0;
+        int blockWidth = 4;
+        int blockHeight = 4;
+        int blockBytes = 16;
+    };
+
+    // The ASTC block sizes in the order in which they appear both in the Vulkan formats
+    // that KTX2 uses and in the OpenGL internal formats
+    constexpr std::array<std::pair<int, int>, 14> AstcBlocks = {
+        std::pair(4, 4), std::pair(5, 4), std::pair(5, 5), std::pair(6, 5),
+        std::pair(6, 6), std::pair(8, 5), std::pair(8, 6), std::pair(8, 8),
+        std::pair(10, 5), std::pair(10, 6), std::pair(10, 8), std::pair(10, 10),
+        std::pair(12, 10), std::pair(12, 12)
+    };
+
+    template <typename T>
+    T read(std::span<const std::byte> data, size_t offset) {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::optional<BlockFormat> fromVkFormat(uint32_t vkFormat) {
+        switch (vkFormat) {
+            case 131: return BlockFormat{ CompressedRgbS3tcDxt1, 4, 4, 8 };
+            case 132: return BlockFormat{ CompressedSrgbS3tcDxt1, 4, 4, 8 };
+            case 133: return BlockFormat{ CompressedRgbaS3tcDxt1, 4, 4, 8 };
+            case 134: return BlockFormat{ CompressedSrgbAlphaS3tcDxt1, 4, 4, 8 };
+            case 135: return BlockFormat{ CompressedRgbaS3tcDxt3 };
+            case 136: return BlockFormat{ CompressedSrgbAlphaS3tcDxt3 };
+            case 137: return BlockFormat{ CompressedRgbaS3tcDxt5 };
+            case 138: return BlockFormat{ CompressedSrgbAlphaS3tcDxt5 };
+            case 139: return BlockFormat{ GL_COMPRESSED_RED_RGTC1, 4, 4, 8 };
+            case 140: return BlockFormat{ GL_COMPRESSED_SIGNED_RED_RGTC1, 4, 4, 8 };
+            case 141: return BlockFormat{ GL_COMPRESSED_RG_RGTC2 };
+            case 142: return BlockFormat{ GL_COMPRESSED_SIGNED_RG_RGTC2 };
+            case 143: return BlockFormat{ GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT };
+            case 144: return BlockFormat{ GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT };
+            case 145: return BlockFormat{ GL_COMPRESSED_RGBA_BPTC_UNORM };
+            case 146: return BlockFormat{ GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM };
+        }
+
+        // The unorm and sRGB variants of each ASTC block size alternate, starting with
+        // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+        constexpr uint32_t FirstAstc = 157;
+        if (vkFormat >= FirstAstc && vkFormat < FirstAstc + 2 * AstcBlocks.size()) {
+            const uint32_t index = (vkFormat - FirstAstc) / 2;
+            const bool isSrgb = (vkFormat - FirstAstc) % 2 == 1;
+            return BlockFormat{
+                (isSrgb ? CompressedSrgb8Alpha8Astc4x4 : CompressedRgbaAstc4x4) + index,
+                AstcBlocks[index].first,
+                AstcBlocks[index].second,
+                16
+            };
+        }
+        return std::nullopt;
+    }
+
+    std::optional<BlockFormat> fromDxgiFormat(uint32_t dxgiFormat) {
+        switch (dxgiFormat) {
+            case 71: return BlockFormat{ CompressedRgbaS3tcDxt1, 4, 4, 8 };
+            case 72: return BlockFormat{ CompressedSrgbAlphaS3tcDxt1, 4, 4, 8 };
+            case 74: return BlockFormat{ CompressedRgbaS3tcDxt3 };
+            case 75: return BlockFormat{ CompressedSrgbAlphaS3tcDxt3 };
+            case 77: return BlockFormat{ CompressedRgbaS3tcDxt5 };
+            case 78: return BlockFormat{ CompressedSrgbAlphaS3tcDxt5 };
+            case 80: return BlockFormat{ GL_COMPRESSED_RED_RGTC1, 4, 4, 8 };
+            case 81: return BlockFormat{ GL_COMPRESSED_SIGNED_RED_RGTC1, 4, 4, 8 };
+            case 83: return BlockFormat{ GL_COMPRESSED_RG_RGTC2 };
+            case 84: return BlockFormat{ GL_COMPRESSED_SIGNED_RG_RGTC2 };
+            case 95: return BlockFormat{ GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT };
+            case 96: return BlockFormat{ GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT };
+            case 98: return BlockFormat{ GL_COMPRESSED_RGBA_BPTC_UNORM };
+            case 99: return BlockFormat{ GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM };
+            default: return std::nullopt;
+        }
+    }
+
+    std::optional<BlockFormat> fromFourCC(std::string_view fourCC) {
+        if (fourCC == "DXT1") {
+            return BlockFormat{ CompressedRgbaS3tcDxt1, 4, 4, 8 };
+        }
+        if (fourCC == "DXT3") {
+            return BlockFormat{ CompressedRgbaS3tcDxt3 };
+        }
+        if (fourCC == "DXT5") {
+            return BlockFormat{ CompressedRgbaS3tcDxt5 };
+        }
+        if (fourCC == "ATI1" || fourCC == "BC4U") {
+            return BlockFormat{ GL_COMPRESSED_RED_RGTC1, 4, 4, 8 };
+        }
+        if (fourCC == "BC4S") {
+            return BlockFormat{ GL_COMPRESSED_SIGNED_RED_RGTC1, 4, 4, 8 };
+        }
+        if (fourCC == "ATI2" || fourCC == "BC5U") {
+            return BlockFormat{ GL_COMPRESSED_RG_RGTC2 };
+        }
+        if (fourCC == "BC5S") {
+            return BlockFormat{ GL_COMPRESSED_SIGNED_RG_RGTC2 };
+        }
+        return std::nullopt;
+    }
+
+    bool isKtx2(std::span<const std::byte> data) {
+        return data.size() >= Ktx2Identifier.size() &&
+            std::memcmp(data.data(), Ktx2Identifier.data(), Ktx2Identifier.size()) == 0;
+    }
+
+    bool isDds(std::span<const std::byte> data) {
+        return data.size() >= DdsIdentifier.size() &&
+            std::memcmp(data.data(), DdsIdentifier.data(), DdsIdentifier.size()) == 0;
+    }
+
+    size_t levelByteSize(const BlockFormat& format, sgct::ivec2 size) {
+        const size_t nBlocksX = (size.x + format.blockWidth - 1) / format.blockWidth;
+        const size_t nBlocksY = (size.y + format.blockHeight - 1) / format.blockHeight;
+        return nBlocksX * nBlocksY * format.blockBytes;
+    }
+
+    sgct::ivec2 levelSize(sgct::ivec2 size, int level) {
+        return sgct::ivec2{ std::max(size.x >> level, 1), std::max(size.y >> level, 1) };
+    }
+} // namespace
+
+namespace sgct {
+
+bool CompressedImage::isCompressedImage(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::array<std::byte, Ktx2Identifier.size()> signature = {};
+    file.read(reinterpret_cast<char*>(signature.data()), signature.size());
+    const std::span<const std::byte> data = std::span(signature).first(file.gcount());
+    return isKtx2(data) || isDds(data);
+}
+
+CompressedImage::CompressedImage(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    _file = correction::MappedFile::map(path);
+    if (!_file) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        throw Err(9023, std::format("Could not open file '{}'", path.string()));
+    }
+
+    const std::span<const std::byte> data = _file->data();
+    try {
+        if (isKtx2(data)) {
+            parseKtx2();
+        }
+        else if (isDds(data)) {
+            parseDds();
+        }
+        else {
+            throw Err(9024, "Not a KTX2 or DDS file");
+        }
+    }
+    catch (const Error& e) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        throw Err(e.code, std::format("{} in '{}'", e.message, path.string()));
+    }
+}
+
+CompressedImage::~CompressedImage() = default;
+
+unsigned int CompressedImage::internalFormat() const {
+    return _internalFormat;
+}
+
+ivec2 CompressedImage::size() const {
+    return _levels.front().size;
+}
+
+const std::vector<CompressedImage::Level>& CompressedImage::levels() const {
+    return _levels;
+}
+
+void CompressedImage::parseKtx2() {
+    const std::span<const std::byte> data = _file->data();
+    if (data.size() < Ktx2HeaderSize) {
+        throw Err(9024, "Truncated KTX2 header");
+    }
+
+    const uint32_t vkFormat = read<uint32_t>(data, 12);
+    const ivec2 size = ivec2{
+        static_cast<int>(read<uint32_t>(data, 20)),
+        static_cast<int>(read<uint32_t>(data, 24))
+    };
+    const uint32_t depth = read<uint32_t>(data, 28);
+    const uint32_t nLayers = read<uint32_t>(data, 32);
+    const uint32_t nFaces = read<uint32_t>(data, 36);
+    // A level count of 0 asks the loader to generate the mipmaps, which is not possible
+    // for compressed formats, so only the stored level is used
+    const uint32_t nLevels = std::max(read<uint32_t>(data, 40), 1u);
+    const uint32_t supercompression = read<uint32_t>(data, 44);
+
+    if (supercompression != 0) {
+        throw Err(
+            9026,
+            std::format(
+                "Supercompression scheme {} is not supported, the file has to be stored "
+                "without supercompression", supercompression
+            )
+        );
+    }
+    const std::optional<BlockFormat> format = fromVkFormat(vkFormat);
+    if (!format.has_value()) {
+        throw Err(9025, std::format("Unsupported texture format {}", vkFormat));
+    }
+    if (size.x <= 0 || size.y <= 0 || depth > 1 || nLayers > 1 || nFaces != 1) {
+        throw Err(9025, "Only two-dimensional textures are supported");
+    }
+    if (nLevels > MaxLevels || data.size() < Ktx2HeaderSize + nLevels * Ktx2LevelSize) {
+        throw Err(9024, "Truncated KTX2 level index");
+    }
+
+    _internalFormat = format->internalFormat;
+    _levels.reserve(nLevels);
+    for (uint32_t i = 0; i < nLevels; i++) {
+        const size_t entry = Ktx2HeaderSize + i * Ktx2LevelSize;
+        const uint64_t offset = read<uint64_t>(data, entry);
+        const uint64_t length = read<uint64_t>(data, entry + sizeof(uint64_t));
+
+        const ivec2 s = levelSize(size, static_cast<int>(i));
+        if (length < levelByteSize(*format, s) || offset > data.size() ||
+            length > data.size() - offset)
+        {
+            throw Err(9024, std::format("Truncated mipmap level {}", i));
+        }
+        _levels.push_back(Level{ s, data.subspan(offset, levelByteSize(*format, s)) });
+    }
+}
+
+void CompressedImage::parseDds() {
+    const std::span<const std::byte> data = _file->data();
+    if (data.size() < DdsHeaderSize) {
+        throw Err(9024, "Truncated DDS header");
+    }
+
+    // The offsets are those of the DDS_HEADER structure plus the identifier
+    const ivec2 size = ivec2{
+        static_cast<int>(read<uint32_t>(data, 16)),
+        static_cast<int>(read<uint32_t>(data, 12))
+    };
+    const uint32_t nLevels = std::max(read<uint32_t>(data, 28), 1u);
+    if (nLevels > MaxLevels) {
+        throw Err(9024, std::format("Invalid number of mipmap levels {}", nLevels));
+    }
+    const std::string_view fourCC = std::string_view(
+        reinterpret_cast<const char*>(data.data()) + 84,
+        4
+    );
+
+    std::optional<BlockFormat> format;
+    size_t offset = DdsHeaderSize;
+    if (fourCC == "DX10") {
+        if (data.size() < DdsHeaderSize + DdsDx10HeaderSize) {
+            throw Err(9024, "Truncated DDS header");
+        }
+        const uint32_t dxgiFormat = read<uint32_t>(data, DdsHeaderSize);
+        const uint32_t dimension = read<uint32_t>(data, DdsHeaderSize + 4);
+        const uint32_t arraySize = read<uint32_t>(data, DdsHeaderSize + 12);
+        // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+        if (dimension != 3 || arraySize > 1) {
+            throw Err(9025, "Only two-dimensional textures are supported");
+        }
+        format = fromDxgiFormat(dxgiFormat);
+        if (!format.has_value()) {
+            throw Err(9025, std::format("Unsupported DXGI format {}", dxgiFormat));
+        }
+        offset += DdsDx10HeaderSize;
+    }
+    else {
+        format = fromFourCC(fourCC);
+        if (!format.has_value()) {
+            throw Err(9025, std::format("Unsupported pixel format '{}'", fourCC));
+        }
+    }
+    if (size.x <= 0 || size.y <= 0) {
+        throw Err(9024, "Invalid image size");
+    }
+
+    // The mipmap levels follow each other directly after the header
+    _internalFormat = format->internalFormat;
+    _levels.reserve(nLevels);
+    for (uint32_t i = 0; i < nLevels; i++) {
+        const ivec2 s = levelSize(size, static_cast<int>(i));
+        const size_t length = levelByteSize(*format, s);
+        if (length > data.size() - offset) {
+            throw Err(9024, std::format("Truncated mipmap level {}", i));
+        }
+        _levels.push_back(Level{ s, data.subspan(offset, length) });
+        offset += length;
+    }
+}
+
+} // namespace sgct
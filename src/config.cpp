@@ -28,6 +28,9 @@
 #include <fstream>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 
 #define Error(code, msg) sgct::Error(sgct::Error::Component::Config, code, msg)
@@ -55,6 +58,12 @@ namespace {
             return res;
         }
     }
+
+    bool isIntegerBitDepth(sgct::config::Window::ColorBitDepth depth) {
+        using CBD = sgct::config::Window::ColorBitDepth;
+        return depth == CBD::Depth16Int || depth == CBD::Depth32Int ||
+               depth == CBD::Depth16UInt || depth == CBD::Depth32UInt;
+    }
 } // namespace
 
 namespace sgct::config {
@@ -122,6 +131,26 @@ void validateCapture(const Capture& c) {
             throw Error(1011, "Screenshot ranges beginning has to be before the end");
         }
     }
+
+    if (c.queueDepth && *c.queueDepth < 1) {
+        throw Error(1012, "Capture queue depth must be positive");
+    }
+
+    if (c.compressionLevel && (*c.compressionLevel < 0 || *c.compressionLevel > 9)) {
+        throw Error(1013, "Capture compression level must be between 0 and 9");
+    }
+
+    if (c.bitrate && *c.bitrate < 1) {
+        throw Error(1014, "Capture bitrate must be positive");
+    }
+
+    if (c.frameRate && *c.frameRate < 1) {
+        throw Error(1015, "Capture frame rate must be positive");
+    }
+
+    if (c.scale && (*c.scale <= 0.f || *c.scale > 1.f)) {
+        throw Error(1016, "Capture scale must be bigger than 0 and at most 1");
+    }
 }
 
 void validateScene(const Scene&) {}
@@ -133,6 +162,135 @@ void validateSettings(const Settings& s) {
     if (s.display && s.display->refreshRate && *s.display->refreshRate < 0) {
         throw Error(1021, "Refresh rate must not be negative");
     }
+    if (s.display && s.display->maxFramesInFlight && *s.display->maxFramesInFlight < 1) {
+        throw Error(1041, "Maximum number of frames in flight must be positive");
+    }
+    if (s.lockstep && s.lockstep->timestep && *s.lockstep->timestep <= 0.f) {
+        throw Error(1116, "Lockstep timestep must be positive");
+    }
+    if (s.lockstep && s.lockstep->maxSteps && *s.lockstep->maxSteps < 1) {
+        throw Error(1117, "Maximum number of lockstep steps must be positive");
+    }
+    if (s.lockstep && s.lockstep->hashInterval && *s.lockstep->hashInterval < 0) {
+        throw Error(1118, "Lockstep hash interval must not be negative");
+    }
+    if (s.hitchDetector && s.hitchDetector->threshold &&
+        *s.hitchDetector->threshold <= 1.f)
+    {
+        throw Error(1119, "Hitch threshold must be bigger than 1");
+    }
+    if (s.hitchDetector && s.hitchDetector->cooldown && *s.hitchDetector->cooldown < 0.f)
+    {
+        throw Error(1132, "Hitch cooldown must not be negative");
+    }
+    if (s.syncRecordPath && s.syncReplayPath) {
+        throw Error(1138, "The shared data cannot be recorded while it is replayed");
+    }
+    if (s.threads) {
+        const Settings::Threads& ts = *s.threads;
+        for (const std::optional<Settings::Thread>& t :
+             { ts.render, ts.network, ts.tracking, ts.capture, ts.logging })
+        {
+            if (t && t->name && t->name->empty()) {
+                throw Error(1048, "Thread name must not be empty");
+            }
+            if (t && t->affinity &&
+                std::any_of(
+                    t->affinity->begin(), t->affinity->end(),
+                    [](int core) { return core < 0; }
+                ))
+            {
+                throw Error(1049, "Thread affinity must not contain negative cores");
+            }
+        }
+    }
+    if (s.buffers) {
+        const Settings::Buffers& bs = *s.buffers;
+        for (const std::optional<Settings::Buffer>& b :
+             { bs.network, bs.sharedData, bs.capture, bs.ndi })
+        {
+            if (b && b->numaNode && *b->numaNode < 0) {
+                throw Error(1099, "Buffer NUMA node must not be negative");
+            }
+        }
+    }
+    if (s.network && s.network->deltaSyncKeyframeInterval &&
+        *s.network->deltaSyncKeyframeInterval < 1)
+    {
+        throw Error(1022, "Delta sync keyframe interval must be positive");
+    }
+    if (s.network && s.network->compressionThreshold &&
+        *s.network->compressionThreshold < 0)
+    {
+        throw Error(1023, "Compression threshold must not be negative");
+    }
+    if (s.network && s.network->compressionLevel &&
+        (*s.network->compressionLevel < 1 || *s.network->compressionLevel > 9))
+    {
+        throw Error(1024, "Compression level must be between 1 and 9");
+    }
+    if (s.network && s.network->multicastAddress &&
+        s.network->multicastAddress->empty())
+    {
+        throw Error(1025, "Multicast address must not be empty");
+    }
+    if (s.network && s.network->multicastPort && *s.network->multicastPort == 0) {
+        throw Error(1026, "Multicast port must not be 0");
+    }
+    if (s.network && s.network->transferChunkSize && *s.network->transferChunkSize < 1)
+    {
+        throw Error(1027, "Transfer chunk size must be positive");
+    }
+    if (s.network && s.network->transferRateLimit && *s.network->transferRateLimit < 0)
+    {
+        throw Error(1028, "Transfer rate limit must not be negative");
+    }
+    if (s.network && s.network->transferWindow && *s.network->transferWindow < 0) {
+        throw Error(1047, "Transfer window must not be negative");
+    }
+    if (s.network && s.network->syncDeadline && *s.network->syncDeadline < 0.f) {
+        throw Error(1029, "Sync deadline must not be negative");
+    }
+    if (s.network && s.network->syncDeadline && *s.network->syncDeadline > 0.f &&
+        s.network->pipelinedSync.value_or(false))
+    {
+        throw Error(1034, "Pipelined sync cannot be combined with a sync deadline");
+    }
+    if (s.cubeMapRefreshInterval && *s.cubeMapRefreshInterval < 1) {
+        throw Error(1035, "Cube map refresh interval must be positive");
+    }
+    if (s.statisticsHistoryLength && *s.statisticsHistoryLength < 1) {
+        throw Error(1036, "Statistics history length must be positive");
+    }
+    if (s.network && s.network->metricsPort && *s.network->metricsPort == 0) {
+        throw Error(1037, "Metrics port must not be 0");
+    }
+    if (s.network && s.network->controlPort && *s.network->controlPort == 0) {
+        throw Error(1045, "Control port must not be 0");
+    }
+    if (s.network && s.network->controlUdpPort && *s.network->controlUdpPort == 0) {
+        throw Error(1046, "Control UDP port must not be 0");
+    }
+
+    auto validateSocketProfile = [](const Settings::Network::SocketProfile& p) {
+        if ((p.sendBufferSize && *p.sendBufferSize < 1) ||
+            (p.receiveBufferSize && *p.receiveBufferSize < 1))
+        {
+            throw Error(1042, "Socket buffer sizes must be positive");
+        }
+        if (p.dscp && (*p.dscp < 0 || *p.dscp > 63)) {
+            throw Error(1043, "Socket DSCP value must be between 0 and 63");
+        }
+        if (p.interfaceAddress && p.interfaceAddress->empty()) {
+            throw Error(1044, "Socket interface address must not be empty");
+        }
+    };
+    if (s.network && s.network->syncSocket) {
+        validateSocketProfile(*s.network->syncSocket);
+    }
+    if (s.network && s.network->transferSocket) {
+        validateSocketProfile(*s.network->transferSocket);
+    }
 }
 
 void validateTracker(const Tracker& t) {
@@ -157,6 +315,19 @@ void validateTracker(const Tracker& t) {
         if (!std::all_of(d.axes.begin(), d.axes.end(), validateAddress)) {
             throw Error(1033, "VRPN address for axes must not be empty");
         }
+        if (d.filter) {
+            auto isPositive = [](std::optional<double> v) { return !v || *v > 0.0; };
+            const Tracker::Device::Filter& f = *d.filter;
+            if (!isPositive(f.minCutoff) || !isPositive(f.derivativeCutoff) ||
+                !isPositive(f.processNoise) || !isPositive(f.measurementNoise) ||
+                (f.beta && *f.beta < 0.0))
+            {
+                throw Error(1038, "Tracking filter parameters must be positive");
+            }
+        }
+        if (d.prediction && d.prediction->latency < 0.0) {
+            throw Error(1039, "Tracking prediction latency must not be negative");
+        }
     };
     std::for_each(t.devices.begin(), t.devices.end(), validateDevice);
 }
@@ -199,6 +370,26 @@ void validateProjection(const FisheyeProjection& p) {
             throw Error(1066, "All background color components have to be positive");
         }
     }
+    if (p.omniStereo && p.omniStereo->tileSize && *p.omniStereo->tileSize <= 0) {
+        throw Error(1067, "Omni stereo tile size must be positive");
+    }
+    if (p.distribution) {
+        if (p.directRendering.value_or(false) || p.omniStereo) {
+            throw Error(
+                1068,
+                "Distributed cube faces cannot be used with direct or omni stereo "
+                "rendering"
+            );
+        }
+        std::vector<FisheyeProjection::Distribution::Face> faces;
+        for (const FisheyeProjection::Distribution::Helper& h : p.distribution->helpers) {
+            faces.insert(faces.end(), h.faces.begin(), h.faces.end());
+        }
+        std::sort(faces.begin(), faces.end());
+        if (std::adjacent_find(faces.begin(), faces.end()) != faces.end()) {
+            throw Error(1069, "Each cube face can only be rendered by one helper node");
+        }
+    }
 }
 
 void validateProjection(const SphericalMirrorProjection& p) {
@@ -220,6 +411,16 @@ void validateProjection(const CubemapProjection& p) {
     if (p.quality && *p.quality <= 0) {
         throw Error(1080, "Quality value must be positive");
     }
+    if (p.outputIntervals) {
+        const CubemapProjection::OutputIntervals& i = *p.outputIntervals;
+        for (const std::optional<int>& v :
+             { i.right, i.zLeft, i.bottom, i.top, i.left, i.zRight })
+        {
+            if (v && *v < 1) {
+                throw Error(1139, "Cubemap output intervals must be positive");
+            }
+        }
+    }
 }
 
 void validateProjection(const CylindricalProjection&) {}
@@ -234,6 +435,20 @@ void validateViewport(const Viewport& v) {
     if (v.user && v.user->empty()) {
         throw Error(1090, "User must not be empty");
     }
+    if (std::any_of(v.users.begin(), v.users.end(), std::mem_fn(&std::string::empty))) {
+        throw Error(1096, "Users must not be empty");
+    }
+    if (v.user && !v.users.empty()) {
+        throw Error(1097, "A viewport cannot have both a user and a list of users");
+    }
+    // The non-linear projections are created for a single user
+    const bool isPlanar = std::holds_alternative<NoProjection>(v.projection) ||
+        std::holds_alternative<PlanarProjection>(v.projection) ||
+        std::holds_alternative<ProjectionPlane>(v.projection) ||
+        std::holds_alternative<TextureMappedProjection>(v.projection);
+    if (!v.users.empty() && !isPlanar) {
+        throw Error(1098, "A list of users is only supported for planar projections");
+    }
     if (v.overlayTexture && v.overlayTexture->empty()) {
         throw Error(1091, "Overlay texture path must not be empty");
     }
@@ -246,6 +461,9 @@ void validateViewport(const Viewport& v) {
     if (v.correctionMeshTexture && v.correctionMeshTexture->empty()) {
         throw Error(1094, "Correction mesh texture path must not be empty");
     }
+    if (v.correctionMeshTolerance && *v.correctionMeshTolerance <= 0.f) {
+        throw Error(1095, "Correction mesh tolerance must be positive");
+    }
 
     std::visit([](const auto& p) { validateProjection(p); }, v.projection);
 }
@@ -257,6 +475,77 @@ void validateWindow(const Window& w) {
     if (std::any_of(w.tags.begin(), w.tags.end(), std::mem_fn(&std::string::empty))) {
         throw Error(1101, "Empty tags are not allowed for windows");
     }
+    if (w.swapInterval && *w.swapInterval < 0) {
+        throw Error(1102, "Window swap interval must not be negative");
+    }
+    // The stages are blitted into each other, which is not possible between integer and
+    // normalized or floating point formats
+    const Window::ColorBitDepth final =
+        w.bufferBitDepth.value_or(Window::ColorBitDepth::Depth8);
+    const auto isCompatible = [final](std::optional<Window::ColorBitDepth> depth) {
+        return !depth || isIntegerBitDepth(*depth) == isIntegerBitDepth(final);
+    };
+    if (!isCompatible(w.cubemapBitDepth) || !isCompatible(w.intermediateBitDepth) ||
+        !isCompatible(w.captureBitDepth))
+    {
+        throw Error(
+            1103,
+            "Window bit depths must either all be integer formats or none of them"
+        );
+    }
+    if (w.captureBitDepth == Window::ColorBitDepth::Depth10) {
+        throw Error(1104, "Window capture bit depth must not be 10 bit");
+    }
+    const bool useSmaaOrTaa = w.useSmaa.value_or(false) || w.useTaa.value_or(false);
+    if (w.useFxaa.value_or(false) && useSmaaOrTaa) {
+        throw Error(1105, "Window FXAA cannot be combined with SMAA or TAA");
+    }
+    if (w.draw2DRate && *w.draw2DRate < 0.f) {
+        throw Error(1115, "Window draw 2D rate must not be negative");
+    }
+    if (w.renderEvery && *w.renderEvery < 1) {
+        throw Error(1133, "Window frame-rate divisor must be a positive number");
+    }
+    if (w.frameExport && w.frameExport->name && w.frameExport->name->empty()) {
+        throw Error(1140, "Window frame export name must not be empty");
+    }
+    if (w.stream) {
+        if (w.stream->url.empty()) {
+            throw Error(1134, "Window stream URL must not be empty");
+        }
+        if (w.stream->bitrate && *w.stream->bitrate < 1) {
+            throw Error(1135, "Window stream bitrate must be positive");
+        }
+        if (w.stream->frameRate && *w.stream->frameRate < 1) {
+            throw Error(1136, "Window stream frame rate must be positive");
+        }
+        if (w.stream->scale && (*w.stream->scale <= 0.f || *w.stream->scale > 1.f)) {
+            throw Error(1137, "Window stream scale must be bigger than 0 and at most 1");
+        }
+    }
+    if (w.compositing) {
+        std::vector<uint8_t> nodes = w.compositing->nodes;
+        std::sort(nodes.begin(), nodes.end());
+        if (std::find(nodes.begin(), nodes.end(), w.compositing->output) == nodes.end() ||
+            std::adjacent_find(nodes.begin(), nodes.end()) != nodes.end())
+        {
+            throw Error(
+                1106,
+                "Window compositing nodes must be unique and contain the output node"
+            );
+        }
+        // The images are read back as normalized or floating point colors, and their
+        // depth is read from the depth texture of a single layer
+        if (isIntegerBitDepth(w.bufferBitDepth.value_or(Window::ColorBitDepth::Depth8)) ||
+            w.singlePassStereo.value_or(false))
+        {
+            throw Error(
+                1114,
+                "Window compositing cannot be used with an integer buffer bit depth or "
+                "single pass stereo"
+            );
+        }
+    }
 
 #ifndef SGCT_HAS_SCALABLE
     if (w.scalable.has_value()) {
@@ -279,6 +568,9 @@ void validateNode(const Node& n) {
     if (n.dataTransferPort && *n.dataTransferPort <= 0) {
         throw Error(1112, "Node data transfer port must be a positive number");
     }
+    if (n.pollInterval && *n.pollInterval < 1) {
+        throw Error(1121, "Node poll interval must be a positive number");
+    }
     if (n.windows.empty()) {
         throw Error(1113, "Every node must contain at least one window");
     }
@@ -436,6 +728,84 @@ void validateCluster(const Cluster& c) {
         throw Error(1127, "Configuration must contain at least one node");
     }
     std::for_each(c.nodes.cbegin(), c.nodes.cend(), validateNode);
+
+    // The chunks of the collected screenshots of different clients would be interleaved
+    // on the connections of the clients that relay them
+    using Topology = Settings::Network::TransferTopology;
+    const bool isRelayed = c.settings && c.settings->network &&
+        c.settings->network->transferTopology.value_or(Topology::Star) != Topology::Star;
+    if (isRelayed && c.capture && c.capture->collect.value_or(false)) {
+        throw Error(
+            1128,
+            "Collecting screenshots requires the 'star' transfer topology"
+        );
+    }
+
+    // The faces are sent to one specific node, which only the master can route to
+    std::vector<size_t> distributingNodes;
+    for (size_t i = 0; i < c.nodes.size(); i++) {
+        for (const Window& w : c.nodes[i].windows) {
+            for (const Viewport& vp : w.viewports) {
+                const FisheyeProjection* p =
+                    std::get_if<FisheyeProjection>(&vp.projection);
+                if (!p || !p->distribution) {
+                    continue;
+                }
+                const FisheyeProjection::Distribution& d = *p->distribution;
+                const bool isValidNode = d.output < c.nodes.size() &&
+                    std::all_of(
+                        d.helpers.begin(),
+                        d.helpers.end(),
+                        [&](const FisheyeProjection::Distribution::Helper& h) {
+                            return h.node < c.nodes.size() && h.node != d.output;
+                        }
+                    );
+                if (!isValidNode || isRelayed) {
+                    throw Error(
+                        1129,
+                        "Distributed cube faces require the 'star' transfer topology "
+                        "and helper nodes that are other nodes of the cluster"
+                    );
+                }
+                distributingNodes.push_back(i);
+            }
+        }
+    }
+    std::sort(distributingNodes.begin(), distributingNodes.end());
+    if (std::adjacent_find(distributingNodes.begin(), distributingNodes.end()) !=
+        distributingNodes.end())
+    {
+        throw Error(1130, "A node can only have one projection with distributed faces");
+    }
+
+    // The images are sent between arbitrary nodes and their depth has to be a texture
+    for (const Node& node : c.nodes) {
+        for (const Window& w : node.windows) {
+            if (!w.compositing) {
+                continue;
+            }
+            const bool hasWindows = std::all_of(
+                w.compositing->nodes.begin(),
+                w.compositing->nodes.end(),
+                [&](uint8_t n) {
+                    return n < c.nodes.size() && std::any_of(
+                        c.nodes[n].windows.begin(),
+                        c.nodes[n].windows.end(),
+                        [&w](const Window& other) { return other.id == w.id; }
+                    );
+                }
+            );
+            const bool hasDepthTexture =
+                c.settings && c.settings->useDepthTexture.value_or(false);
+            if (!hasWindows || isRelayed || !hasDepthTexture) {
+                throw Error(
+                    1131,
+                    "Window compositing requires the 'star' transfer topology, the depth "
+                    "buffer texture, and a window with the same id on each of the nodes"
+                );
+            }
+        }
+    }
 }
 
 void validateGeneratorVersion(const GeneratorVersion&) {}
@@ -519,6 +889,7 @@ namespace {
 
     sgct::config::Window::ColorBitDepth parseBufferColorBitDepth(std::string_view type) {
         if (type == "8") { return sgct::config::Window::ColorBitDepth::Depth8; }
+        if (type == "10") { return sgct::config::Window::ColorBitDepth::Depth10; }
         if (type == "16") { return sgct::config::Window::ColorBitDepth::Depth16; }
         if (type == "16f") { return sgct::config::Window::ColorBitDepth::Depth16Float; }
         if (type == "32f") { return sgct::config::Window::ColorBitDepth::Depth32Float; }
@@ -530,6 +901,21 @@ namespace {
         throw Err(6086, std::format("Unknown color bit depth {}", type));
     }
 
+    std::string_view toString(sgct::config::Window::ColorBitDepth depth) {
+        switch (depth) {
+            case sgct::config::Window::ColorBitDepth::Depth8:       return "8";
+            case sgct::config::Window::ColorBitDepth::Depth10:      return "10";
+            case sgct::config::Window::ColorBitDepth::Depth16:      return "16";
+            case sgct::config::Window::ColorBitDepth::Depth16Float: return "16f";
+            case sgct::config::Window::ColorBitDepth::Depth32Float: return "32f";
+            case sgct::config::Window::ColorBitDepth::Depth16Int:   return "16i";
+            case sgct::config::Window::ColorBitDepth::Depth32Int:   return "32i";
+            case sgct::config::Window::ColorBitDepth::Depth16UInt:  return "16ui";
+            case sgct::config::Window::ColorBitDepth::Depth32UInt:  return "32ui";
+            default: throw std::logic_error("Missing case exception");
+        }
+    }
+
     int cubeMapResolutionForQuality(std::string_view quality) {
         if (quality == "low" || quality == "256") { return 256; }
         if (quality == "medium" || quality == "512") { return 512; }
@@ -562,6 +948,98 @@ namespace {
         throw Err(6023, "Unregnozed interpolation");
     }
 
+    sgct::config::Capture::Format parseCaptureFormat(std::string_view format) {
+        if (format == "png") { return sgct::config::Capture::Format::Png; }
+        if (format == "raw") { return sgct::config::Capture::Format::Raw; }
+        if (format == "video") { return sgct::config::Capture::Format::Video; }
+        if (format == "exr") { return sgct::config::Capture::Format::Exr; }
+
+        throw Err(6091, std::format("Unknown capture format '{}'", format));
+    }
+
+    sgct::config::Capture::Codec parseCodec(std::string_view codec) {
+        if (codec == "h264") { return sgct::config::Capture::Codec::H264; }
+        if (codec == "hevc") { return sgct::config::Capture::Codec::HEVC; }
+
+        throw Err(6092, std::format("Unknown video codec '{}'", codec));
+    }
+
+    sgct::config::Settings::Thread::Priority parsePriority(std::string_view priority) {
+        using Priority = sgct::config::Settings::Thread::Priority;
+        if (priority == "idle") { return Priority::Idle; }
+        if (priority == "low") { return Priority::Low; }
+        if (priority == "normal") { return Priority::Normal; }
+        if (priority == "high") { return Priority::High; }
+        if (priority == "realtime") { return Priority::Realtime; }
+
+        throw Err(6097, std::format("Unknown thread priority '{}'", priority));
+    }
+
+    sgct::config::Capture::CompressionStrategy parseStrategy(std::string_view s) {
+        using CompressionStrategy = sgct::config::Capture::CompressionStrategy;
+        if (s == "default") { return CompressionStrategy::Default; }
+        if (s == "filtered") { return CompressionStrategy::Filtered; }
+        if (s == "huffmanonly") { return CompressionStrategy::HuffmanOnly; }
+        if (s == "rle") { return CompressionStrategy::Rle; }
+
+        throw Err(6090, std::format("Unknown compression strategy '{}'", s));
+    }
+
+    sgct::config::Tracker::Device::Filter::Type parseFilterType(std::string_view type) {
+        using Type = sgct::config::Tracker::Device::Filter::Type;
+        if (type == "oneeuro") { return Type::OneEuro; }
+        if (type == "kalman") { return Type::Kalman; }
+
+        throw Err(6093, std::format("Unknown tracking filter '{}'", type));
+    }
+
+    sgct::config::Tracker::Device::Prediction::Model
+    parsePredictionModel(std::string_view m)
+    {
+        using Model = sgct::config::Tracker::Device::Prediction::Model;
+        if (m == "velocity") { return Model::Velocity; }
+        if (m == "acceleration") { return Model::Acceleration; }
+
+        throw Err(6094, std::format("Unknown tracking prediction model '{}'", m));
+    }
+
+    sgct::config::Settings::Network::TransferTopology
+    parseTransferTopology(std::string_view t)
+    {
+        using Topology = sgct::config::Settings::Network::TransferTopology;
+        if (t == "star") { return Topology::Star; }
+        if (t == "chain") { return Topology::Chain; }
+        if (t == "tree") { return Topology::Tree; }
+
+        throw Err(6095, std::format("Unknown transfer topology '{}'", t));
+    }
+
+    sgct::config::FisheyeProjection::Distribution::Face parseCubeFace(std::string_view f)
+    {
+        using Face = sgct::config::FisheyeProjection::Distribution::Face;
+        if (f == "right") { return Face::Right; }
+        if (f == "left") { return Face::Left; }
+        if (f == "bottom") { return Face::Bottom; }
+        if (f == "top") { return Face::Top; }
+        if (f == "front") { return Face::Front; }
+        if (f == "back") { return Face::Back; }
+
+        throw Err(6096, std::format("Unknown cube face '{}'", f));
+    }
+
+    std::string_view toString(sgct::config::FisheyeProjection::Distribution::Face face) {
+        using Face = sgct::config::FisheyeProjection::Distribution::Face;
+        switch (face) {
+            case Face::Right: return "right";
+            case Face::Left: return "left";
+            case Face::Bottom: return "bottom";
+            case Face::Top: return "top";
+            case Face::Front: return "front";
+            case Face::Back: return "back";
+            default: throw std::logic_error("Unhandled case label");
+        }
+    }
+
     std::string stringifyJsonFile(const std::filesystem::path& filename) {
         std::ifstream myfile = std::ifstream(filename);
         if (myfile.fail()) {
@@ -574,6 +1052,73 @@ namespace {
         return buffer.str();
     }
 
+    std::unique_ptr<nlohmann::json_schema::json_validator> createValidator(
+                                                      const std::filesystem::path& schema)
+    {
+        using nlohmann::json;
+        using nlohmann::json_uri;
+
+        const std::string schemaStr = stringifyJsonFile(schema);
+        const json schemaInput = json::parse(schemaStr);
+        const std::filesystem::path schemaDir = schema.parent_path();
+        return std::make_unique<nlohmann::json_schema::json_validator>(
+            schemaInput,
+            [schemaDir](const json_uri& id, json& value) {
+                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+                // formatting std::filesystem::path
+                std::string loadPath = std::format(
+                    "{}/{}", schemaDir.string(), id.to_string()
+                );
+                const size_t lbIndex = loadPath.find('#');
+                if (lbIndex != std::string::npos) {
+                    loadPath = loadPath.substr(0, lbIndex);
+                }
+                // Remove trailing spaces
+                if (!loadPath.empty()) {
+                    const size_t strEnd = loadPath.find_last_not_of(" #\t\r\n\0");
+                    loadPath = loadPath.substr(0, strEnd + 1);
+                }
+                if (std::filesystem::exists(loadPath)) {
+                    sgct::Log::Debug(std::format("Loading schema file '{}'", loadPath));
+                    const std::string newSchema = stringifyJsonFile(loadPath);
+                    value = json::parse(newSchema);
+                }
+                else {
+                    throw Err(
+                        6081,
+                        std::format("Could not find schema file to load: {}", loadPath)
+                    );
+                }
+            }
+        );
+    }
+
+    // Compiling a validator from the schema files takes much longer than validating a
+    // configuration with it, so the validators are kept until their main schema file
+    // changes. The mutex has to be held while a validator is used
+    struct CachedValidator {
+        std::filesystem::file_time_type writeTime;
+        std::unique_ptr<nlohmann::json_schema::json_validator> validator;
+    };
+    std::mutex ValidatorMutex;
+
+    const nlohmann::json_schema::json_validator& cachedValidator(
+                                                      const std::filesystem::path& schema)
+    {
+        static std::map<std::filesystem::path, CachedValidator> Validators;
+
+        const std::filesystem::path path = std::filesystem::absolute(schema);
+        std::error_code ec;
+        const std::filesystem::file_time_type time =
+            std::filesystem::last_write_time(path, ec);
+        CachedValidator& cached = Validators[path];
+        if (!cached.validator || ec || cached.writeTime != time) {
+            cached.validator = createValidator(path);
+            cached.writeTime = time;
+        }
+        return *cached.validator;
+    }
+
     constexpr int8_t InvalidWindowIndex = std::numeric_limits<int8_t>::min();
 
     template <typename T> struct is_optional : std::false_type {};
@@ -821,10 +1366,82 @@ static void to_json(nlohmann::json& j, const User& u) {
     }
 }
 
+static void from_json(const nlohmann::json& j, Settings::Thread& t) {
+    parseValue(j, "name", t.name);
+    if (auto it = j.find("priority");  it != j.end()) {
+        const std::string priority = it->get<std::string>();
+        t.priority = parsePriority(priority);
+    }
+    parseValue(j, "affinity", t.affinity);
+}
+
+static void to_json(nlohmann::json& j, const Settings::Thread& t) {
+    j = nlohmann::json::object();
+
+    if (t.name.has_value()) {
+        j["name"] = *t.name;
+    }
+    if (t.priority.has_value()) {
+        switch (*t.priority) {
+            case Settings::Thread::Priority::Idle:
+                j["priority"] = "idle";
+                break;
+            case Settings::Thread::Priority::Low:
+                j["priority"] = "low";
+                break;
+            case Settings::Thread::Priority::Normal:
+                j["priority"] = "normal";
+                break;
+            case Settings::Thread::Priority::High:
+                j["priority"] = "high";
+                break;
+            case Settings::Thread::Priority::Realtime:
+                j["priority"] = "realtime";
+                break;
+        }
+    }
+    if (t.affinity.has_value()) {
+        j["affinity"] = *t.affinity;
+    }
+}
+
+static void from_json(const nlohmann::json& j, Settings::Buffer& b) {
+    parseValue(j, "hugepages", b.hugePages);
+    parseValue(j, "numanode", b.numaNode);
+}
+
+static void to_json(nlohmann::json& j, const Settings::Buffer& b) {
+    j = nlohmann::json::object();
+
+    if (b.hugePages.has_value()) {
+        j["hugepages"] = *b.hugePages;
+    }
+    if (b.numaNode.has_value()) {
+        j["numanode"] = *b.numaNode;
+    }
+}
+
 static void from_json(const nlohmann::json& j, Settings& s) {
     parseValue(j, "depthbuffertexture", s.useDepthTexture);
     parseValue(j, "normaltexture", s.useNormalTexture);
     parseValue(j, "positiontexture", s.usePositionTexture);
+    parseValue(j, "windowthreads", s.useWindowThreads);
+    parseValue(j, "presentthread", s.usePresentThread);
+    parseValue(j, "layeredcubemaps", s.useLayeredCubeMaps);
+    parseValue(j, "cubemaprefreshinterval", s.cubeMapRefreshInterval);
+    parseValue(j, "sharecubemaps", s.shareCubeMaps);
+    parseValue(j, "interleavecubemapeyes", s.interleaveCubeMapEyes);
+    parseValue(j, "correctionmeshcache", s.useCorrectionMeshCache);
+    parseValue(j, "asynccorrectionmeshes", s.loadCorrectionMeshesAsync);
+    parseValue(j, "watchcorrectionmeshes", s.watchCorrectionMeshes);
+    parseValue(j, "watchconfig", s.watchConfig);
+    parseValue(j, "syncinput", s.syncInput);
+    parseValue(j, "shadercache", s.shaderCachePath);
+    parseValue(j, "statisticshistory", s.statisticsHistoryLength);
+    parseValue(j, "trace", s.tracePath);
+    parseValue(j, "binarylog", s.binaryLogPath);
+    parseValue(j, "syncrecord", s.syncRecordPath);
+    parseValue(j, "syncreplay", s.syncReplayPath);
 
     if (auto it = j.find("precision");  it != j.end()) {
         float precision = it->get<float>();
@@ -842,9 +1459,99 @@ static void from_json(const nlohmann::json& j, Settings& s) {
     if (auto it = j.find("display");  it != j.end()) {
         Settings::Display display;
         parseValue(*it, "swapinterval", display.swapInterval);
+        parseValue(*it, "adaptivesync", display.adaptiveSync);
         parseValue(*it, "refreshrate", display.refreshRate);
+        parseValue(*it, "framepacingmargin", display.framePacingMargin);
+        parseValue(*it, "latelatching", display.lateLatching);
+        parseValue(*it, "targetframerate", display.targetFrameRate);
+        parseValue(*it, "minresolutionscale", display.minResolutionScale);
+        parseValue(*it, "maxresolutionscale", display.maxResolutionScale);
+        parseValue(*it, "maxframesinflight", display.maxFramesInFlight);
+        parseValue(*it, "resizedelay", display.resizeDelay);
+        parseValue(*it, "headless", display.headless);
         s.display = display;
     }
+
+    if (auto it = j.find("lockstep");  it != j.end()) {
+        Settings::Lockstep lockstep;
+        parseValue(*it, "timestep", lockstep.timestep);
+        parseValue(*it, "maxsteps", lockstep.maxSteps);
+        parseValue(*it, "hashinterval", lockstep.hashInterval);
+        parseValue(*it, "seed", lockstep.seed);
+        s.lockstep = lockstep;
+    }
+
+    if (auto it = j.find("hitchdetector");  it != j.end()) {
+        Settings::HitchDetector hitchDetector;
+        parseValue(*it, "threshold", hitchDetector.threshold);
+        parseValue(*it, "cooldown", hitchDetector.cooldown);
+        parseValue(*it, "path", hitchDetector.path);
+        s.hitchDetector = hitchDetector;
+    }
+
+    if (auto it = j.find("threads");  it != j.end()) {
+        Settings::Threads threads;
+        parseValue(*it, "render", threads.render);
+        parseValue(*it, "network", threads.network);
+        parseValue(*it, "tracking", threads.tracking);
+        parseValue(*it, "capture", threads.capture);
+        parseValue(*it, "logging", threads.logging);
+        s.threads = threads;
+    }
+
+    if (auto it = j.find("buffers");  it != j.end()) {
+        Settings::Buffers buffers;
+        parseValue(*it, "network", buffers.network);
+        parseValue(*it, "shareddata", buffers.sharedData);
+        parseValue(*it, "capture", buffers.capture);
+        parseValue(*it, "ndi", buffers.ndi);
+        s.buffers = buffers;
+    }
+
+    if (auto it = j.find("network");  it != j.end()) {
+        Settings::Network network;
+        parseValue(*it, "deltasync", network.deltaSync);
+        parseValue(*it, "deltasynckeyframeinterval", network.deltaSyncKeyframeInterval);
+        parseValue(*it, "compression", network.compression);
+        parseValue(*it, "compressionthreshold", network.compressionThreshold);
+        parseValue(*it, "compressionlevel", network.compressionLevel);
+        parseValue(*it, "multicastaddress", network.multicastAddress);
+        parseValue(*it, "multicastport", network.multicastPort);
+        parseValue(*it, "parallelsend", network.parallelSend);
+        parseValue(*it, "eventdriven", network.eventDriven);
+        parseValue(*it, "busywait", network.busyWait);
+        parseValue(*it, "pipelinedsync", network.pipelinedSync);
+        parseValue(*it, "transferchunksize", network.transferChunkSize);
+        parseValue(*it, "transferratelimit", network.transferRateLimit);
+        parseValue(*it, "transferwindow", network.transferWindow);
+        parseValue(*it, "syncdeadline", network.syncDeadline);
+        parseValue(*it, "sharedmemory", network.sharedMemory);
+        parseValue(*it, "rdmabuffersize", network.rdmaBufferSize);
+        parseValue(*it, "forwardlog", network.forwardLog);
+        parseValue(*it, "metricsport", network.metricsPort);
+        parseValue(*it, "controlport", network.controlPort);
+        parseValue(*it, "controludpport", network.controlUdpPort);
+        if (auto jt = it->find("transfertopology");  jt != it->end()) {
+            const std::string topology = jt->get<std::string>();
+            network.transferTopology = parseTransferTopology(topology);
+        }
+        auto parseSocketProfile = [](const nlohmann::json& p) {
+            Settings::Network::SocketProfile profile;
+            parseValue(p, "sendbuffer", profile.sendBufferSize);
+            parseValue(p, "receivebuffer", profile.receiveBufferSize);
+            parseValue(p, "dscp", profile.dscp);
+            parseValue(p, "interface", profile.interfaceAddress);
+            parseValue(p, "autotune", profile.autoTuneBuffers);
+            return profile;
+        };
+        if (auto jt = it->find("syncsocket");  jt != it->end()) {
+            network.syncSocket = parseSocketProfile(*jt);
+        }
+        if (auto jt = it->find("transfersocket");  jt != it->end()) {
+            network.transferSocket = parseSocketProfile(*jt);
+        }
+        s.network = network;
+    }
 }
 
 static void to_json(nlohmann::json& j, const Settings& s) {
@@ -862,6 +1569,70 @@ static void to_json(nlohmann::json& j, const Settings& s) {
         j["positiontexture"] = *s.usePositionTexture;
     }
 
+    if (s.useWindowThreads.has_value()) {
+        j["windowthreads"] = *s.useWindowThreads;
+    }
+
+    if (s.usePresentThread.has_value()) {
+        j["presentthread"] = *s.usePresentThread;
+    }
+
+    if (s.useLayeredCubeMaps.has_value()) {
+        j["layeredcubemaps"] = *s.useLayeredCubeMaps;
+    }
+
+    if (s.cubeMapRefreshInterval.has_value()) {
+        j["cubemaprefreshinterval"] = *s.cubeMapRefreshInterval;
+    }
+
+    if (s.shareCubeMaps.has_value()) {
+        j["sharecubemaps"] = *s.shareCubeMaps;
+    }
+
+    if (s.interleaveCubeMapEyes.has_value()) {
+        j["interleavecubemapeyes"] = *s.interleaveCubeMapEyes;
+    }
+
+    if (s.useCorrectionMeshCache.has_value()) {
+        j["correctionmeshcache"] = *s.useCorrectionMeshCache;
+    }
+
+    if (s.loadCorrectionMeshesAsync.has_value()) {
+        j["asynccorrectionmeshes"] = *s.loadCorrectionMeshesAsync;
+    }
+
+    if (s.watchCorrectionMeshes.has_value()) {
+        j["watchcorrectionmeshes"] = *s.watchCorrectionMeshes;
+    }
+    if (s.watchConfig.has_value()) {
+        j["watchconfig"] = *s.watchConfig;
+    }
+
+    if (s.syncInput.has_value()) {
+        j["syncinput"] = *s.syncInput;
+    }
+
+    if (s.shaderCachePath.has_value()) {
+        j["shadercache"] = *s.shaderCachePath;
+    }
+
+    if (s.statisticsHistoryLength.has_value()) {
+        j["statisticshistory"] = *s.statisticsHistoryLength;
+    }
+
+    if (s.tracePath.has_value()) {
+        j["trace"] = *s.tracePath;
+    }
+    if (s.binaryLogPath.has_value()) {
+        j["binarylog"] = *s.binaryLogPath;
+    }
+    if (s.syncRecordPath.has_value()) {
+        j["syncrecord"] = *s.syncRecordPath;
+    }
+    if (s.syncReplayPath.has_value()) {
+        j["syncreplay"] = *s.syncReplayPath;
+    }
+
     if (s.bufferFloatPrecision.has_value()) {
         switch (*s.bufferFloatPrecision) {
             case Settings::BufferFloatPrecision::Float16Bit:
@@ -871,17 +1642,220 @@ static void to_json(nlohmann::json& j, const Settings& s) {
                 j["precision"] = 32.0;
                 break;
         }
-    }
-
-    if (s.display.has_value()) {
-        nlohmann::json display = nlohmann::json::object();
-        if (s.display->swapInterval.has_value()) {
-            display["swapinterval"] = *s.display->swapInterval;
+    }
+
+    if (s.display.has_value()) {
+        nlohmann::json display = nlohmann::json::object();
+        if (s.display->swapInterval.has_value()) {
+            display["swapinterval"] = *s.display->swapInterval;
+        }
+        if (s.display->adaptiveSync.has_value()) {
+            display["adaptivesync"] = *s.display->adaptiveSync;
+        }
+        if (s.display->refreshRate.has_value()) {
+            display["refreshrate"] = *s.display->refreshRate;
+        }
+        if (s.display->framePacingMargin.has_value()) {
+            display["framepacingmargin"] = *s.display->framePacingMargin;
+        }
+        if (s.display->lateLatching.has_value()) {
+            display["latelatching"] = *s.display->lateLatching;
+        }
+        if (s.display->targetFrameRate.has_value()) {
+            display["targetframerate"] = *s.display->targetFrameRate;
+        }
+        if (s.display->minResolutionScale.has_value()) {
+            display["minresolutionscale"] = *s.display->minResolutionScale;
+        }
+        if (s.display->maxResolutionScale.has_value()) {
+            display["maxresolutionscale"] = *s.display->maxResolutionScale;
+        }
+        if (s.display->maxFramesInFlight.has_value()) {
+            display["maxframesinflight"] = *s.display->maxFramesInFlight;
+        }
+        if (s.display->resizeDelay.has_value()) {
+            display["resizedelay"] = *s.display->resizeDelay;
+        }
+        if (s.display->headless.has_value()) {
+            display["headless"] = *s.display->headless;
+        }
+        j["display"] = display;
+    }
+
+    if (s.lockstep.has_value()) {
+        nlohmann::json lockstep = nlohmann::json::object();
+        if (s.lockstep->timestep.has_value()) {
+            lockstep["timestep"] = *s.lockstep->timestep;
+        }
+        if (s.lockstep->maxSteps.has_value()) {
+            lockstep["maxsteps"] = *s.lockstep->maxSteps;
+        }
+        if (s.lockstep->hashInterval.has_value()) {
+            lockstep["hashinterval"] = *s.lockstep->hashInterval;
+        }
+        if (s.lockstep->seed.has_value()) {
+            lockstep["seed"] = *s.lockstep->seed;
+        }
+        j["lockstep"] = lockstep;
+    }
+
+    if (s.hitchDetector.has_value()) {
+        nlohmann::json hitchDetector = nlohmann::json::object();
+        if (s.hitchDetector->threshold.has_value()) {
+            hitchDetector["threshold"] = *s.hitchDetector->threshold;
+        }
+        if (s.hitchDetector->cooldown.has_value()) {
+            hitchDetector["cooldown"] = *s.hitchDetector->cooldown;
+        }
+        if (s.hitchDetector->path.has_value()) {
+            hitchDetector["path"] = *s.hitchDetector->path;
+        }
+        j["hitchdetector"] = hitchDetector;
+    }
+
+    if (s.threads.has_value()) {
+        nlohmann::json threads = nlohmann::json::object();
+        if (s.threads->render.has_value()) {
+            threads["render"] = *s.threads->render;
+        }
+        if (s.threads->network.has_value()) {
+            threads["network"] = *s.threads->network;
+        }
+        if (s.threads->tracking.has_value()) {
+            threads["tracking"] = *s.threads->tracking;
+        }
+        if (s.threads->capture.has_value()) {
+            threads["capture"] = *s.threads->capture;
+        }
+        if (s.threads->logging.has_value()) {
+            threads["logging"] = *s.threads->logging;
+        }
+        j["threads"] = threads;
+    }
+
+    if (s.buffers.has_value()) {
+        nlohmann::json buffers = nlohmann::json::object();
+        if (s.buffers->network.has_value()) {
+            buffers["network"] = *s.buffers->network;
+        }
+        if (s.buffers->sharedData.has_value()) {
+            buffers["shareddata"] = *s.buffers->sharedData;
+        }
+        if (s.buffers->capture.has_value()) {
+            buffers["capture"] = *s.buffers->capture;
+        }
+        if (s.buffers->ndi.has_value()) {
+            buffers["ndi"] = *s.buffers->ndi;
+        }
+        j["buffers"] = buffers;
+    }
+
+    if (s.network.has_value()) {
+        nlohmann::json network = nlohmann::json::object();
+        if (s.network->deltaSync.has_value()) {
+            network["deltasync"] = *s.network->deltaSync;
+        }
+        if (s.network->deltaSyncKeyframeInterval.has_value()) {
+            network["deltasynckeyframeinterval"] = *s.network->deltaSyncKeyframeInterval;
+        }
+        if (s.network->compression.has_value()) {
+            network["compression"] = *s.network->compression;
+        }
+        if (s.network->compressionThreshold.has_value()) {
+            network["compressionthreshold"] = *s.network->compressionThreshold;
+        }
+        if (s.network->compressionLevel.has_value()) {
+            network["compressionlevel"] = *s.network->compressionLevel;
+        }
+        if (s.network->multicastAddress.has_value()) {
+            network["multicastaddress"] = *s.network->multicastAddress;
+        }
+        if (s.network->multicastPort.has_value()) {
+            network["multicastport"] = *s.network->multicastPort;
+        }
+        if (s.network->parallelSend.has_value()) {
+            network["parallelsend"] = *s.network->parallelSend;
+        }
+        if (s.network->eventDriven.has_value()) {
+            network["eventdriven"] = *s.network->eventDriven;
+        }
+        if (s.network->busyWait.has_value()) {
+            network["busywait"] = *s.network->busyWait;
+        }
+        if (s.network->pipelinedSync.has_value()) {
+            network["pipelinedsync"] = *s.network->pipelinedSync;
+        }
+        if (s.network->transferChunkSize.has_value()) {
+            network["transferchunksize"] = *s.network->transferChunkSize;
+        }
+        if (s.network->transferRateLimit.has_value()) {
+            network["transferratelimit"] = *s.network->transferRateLimit;
+        }
+        if (s.network->transferWindow.has_value()) {
+            network["transferwindow"] = *s.network->transferWindow;
+        }
+        if (s.network->syncDeadline.has_value()) {
+            network["syncdeadline"] = *s.network->syncDeadline;
         }
-        if (s.display->refreshRate.has_value()) {
-            display["refreshrate"] = *s.display->refreshRate;
+        if (s.network->sharedMemory.has_value()) {
+            network["sharedmemory"] = *s.network->sharedMemory;
         }
-        j["display"] = display;
+        if (s.network->rdmaBufferSize.has_value()) {
+            network["rdmabuffersize"] = *s.network->rdmaBufferSize;
+        }
+        if (s.network->forwardLog.has_value()) {
+            network["forwardlog"] = *s.network->forwardLog;
+        }
+        if (s.network->metricsPort.has_value()) {
+            network["metricsport"] = *s.network->metricsPort;
+        }
+        if (s.network->controlPort.has_value()) {
+            network["controlport"] = *s.network->controlPort;
+        }
+        if (s.network->controlUdpPort.has_value()) {
+            network["controludpport"] = *s.network->controlUdpPort;
+        }
+        if (s.network->transferTopology.has_value()) {
+            using Topology = Settings::Network::TransferTopology;
+            switch (*s.network->transferTopology) {
+                case Topology::Star:
+                    network["transfertopology"] = "star";
+                    break;
+                case Topology::Chain:
+                    network["transfertopology"] = "chain";
+                    break;
+                case Topology::Tree:
+                    network["transfertopology"] = "tree";
+                    break;
+            }
+        }
+        auto serializeSocketProfile = [](const Settings::Network::SocketProfile& p) {
+            nlohmann::json profile = nlohmann::json::object();
+            if (p.sendBufferSize.has_value()) {
+                profile["sendbuffer"] = *p.sendBufferSize;
+            }
+            if (p.receiveBufferSize.has_value()) {
+                profile["receivebuffer"] = *p.receiveBufferSize;
+            }
+            if (p.dscp.has_value()) {
+                profile["dscp"] = *p.dscp;
+            }
+            if (p.interfaceAddress.has_value()) {
+                profile["interface"] = *p.interfaceAddress;
+            }
+            if (p.autoTuneBuffers.has_value()) {
+                profile["autotune"] = *p.autoTuneBuffers;
+            }
+            return profile;
+        };
+        if (s.network->syncSocket.has_value()) {
+            network["syncsocket"] = serializeSocketProfile(*s.network->syncSocket);
+        }
+        if (s.network->transferSocket.has_value()) {
+            network["transfersocket"] =
+                serializeSocketProfile(*s.network->transferSocket);
+        }
+        j["network"] = network;
     }
 }
 
@@ -907,6 +1881,34 @@ static void from_json(const nlohmann::json& j, Capture& c) {
     if (rangeBeg && rangeEnd && *rangeBeg > *rangeEnd) {
         throw Err(6051, "End of range must be greater than beginning of range");
     }
+
+    parseValue(j, "queuedepth", c.queueDepth);
+    parseValue(j, "dropwhenfull", c.dropWhenFull);
+
+    if (auto it = j.find("format");  it != j.end()) {
+        const std::string format = it->get<std::string>();
+        c.format = parseCaptureFormat(format);
+    }
+
+    parseValue(j, "compressionlevel", c.compressionLevel);
+
+    if (auto it = j.find("compressionstrategy");  it != j.end()) {
+        const std::string strategy = it->get<std::string>();
+        c.compressionStrategy = parseStrategy(strategy);
+    }
+
+    parseValue(j, "parallelencoding", c.parallelEncoding);
+
+    if (auto it = j.find("codec");  it != j.end()) {
+        const std::string codec = it->get<std::string>();
+        c.codec = parseCodec(codec);
+    }
+
+    parseValue(j, "bitrate", c.bitrate);
+    parseValue(j, "framerate", c.frameRate);
+    parseValue(j, "eightbit", c.eightBit);
+    parseValue(j, "scale", c.scale);
+    parseValue(j, "collect", c.collect);
 }
 
 static void to_json(nlohmann::json& j, const Capture& c) {
@@ -920,6 +1922,87 @@ static void to_json(nlohmann::json& j, const Capture& c) {
         j["rangebegin"] = c.range->first;
         j["rangeend"] = c.range->last;
     }
+
+    if (c.queueDepth.has_value()) {
+        j["queuedepth"] = *c.queueDepth;
+    }
+
+    if (c.dropWhenFull.has_value()) {
+        j["dropwhenfull"] = *c.dropWhenFull;
+    }
+
+    if (c.format.has_value()) {
+        switch (*c.format) {
+            case Capture::Format::Png:
+                j["format"] = "png";
+                break;
+            case Capture::Format::Raw:
+                j["format"] = "raw";
+                break;
+            case Capture::Format::Video:
+                j["format"] = "video";
+                break;
+            case Capture::Format::Exr:
+                j["format"] = "exr";
+                break;
+        }
+    }
+
+    if (c.compressionLevel.has_value()) {
+        j["compressionlevel"] = *c.compressionLevel;
+    }
+
+    if (c.compressionStrategy.has_value()) {
+        switch (*c.compressionStrategy) {
+            case Capture::CompressionStrategy::Default:
+                j["compressionstrategy"] = "default";
+                break;
+            case Capture::CompressionStrategy::Filtered:
+                j["compressionstrategy"] = "filtered";
+                break;
+            case Capture::CompressionStrategy::HuffmanOnly:
+                j["compressionstrategy"] = "huffmanonly";
+                break;
+            case Capture::CompressionStrategy::Rle:
+                j["compressionstrategy"] = "rle";
+                break;
+        }
+    }
+
+    if (c.parallelEncoding.has_value()) {
+        j["parallelencoding"] = *c.parallelEncoding;
+    }
+
+    if (c.codec.has_value()) {
+        switch (*c.codec) {
+            case Capture::Codec::H264:
+                j["codec"] = "h264";
+                break;
+            case Capture::Codec::HEVC:
+                j["codec"] = "hevc";
+                break;
+        }
+    }
+
+    if (c.bitrate.has_value()) {
+        j["bitrate"] = *c.bitrate;
+    }
+
+    if (c.frameRate.has_value()) {
+        j["framerate"] = *c.frameRate;
+    }
+
+    if (c.eightBit.has_value()) {
+        j["eightbit"] = *c.eightBit;
+    }
+
+    if (c.scale.has_value()) {
+        j["scale"] = *c.scale;
+    }
+
+    if (c.collect.has_value()) {
+        j["collect"] = *c.collect;
+    }
 }
 
 static void from_json(const nlohmann::json& j, Tracker::Device::Sensor& s) {
@@ -958,6 +2041,74 @@ static void to_json(nlohmann::json& j, const Tracker::Device::Axis& a) {
     j["count"] = a.count;
 }
 
+static void from_json(const nlohmann::json& j, Tracker::Device::Filter& f) {
+    if (auto it = j.find("type");  it != j.end()) {
+        f.type = parseFilterType(it->get<std::string>());
+    }
+    parseValue(j, "mincutoff", f.minCutoff);
+    parseValue(j, "beta", f.beta);
+    parseValue(j, "derivativecutoff", f.derivativeCutoff);
+    parseValue(j, "processnoise", f.processNoise);
+    parseValue(j, "measurementnoise", f.measurementNoise);
+}
+
+static void to_json(nlohmann::json& j, const Tracker::Device::Filter& f) {
+    j = nlohmann::json::object();
+
+    switch (f.type) {
+        case Tracker::Device::Filter::Type::OneEuro:
+            j["type"] = "oneeuro";
+            break;
+        case Tracker::Device::Filter::Type::Kalman:
+            j["type"] = "kalman";
+            break;
+    }
+
+    if (f.minCutoff.has_value()) {
+        j["mincutoff"] = *f.minCutoff;
+    }
+
+    if (f.beta.has_value()) {
+        j["beta"] = *f.beta;
+    }
+
+    if (f.derivativeCutoff.has_value()) {
+        j["derivativecutoff"] = *f.derivativeCutoff;
+    }
+
+    if (f.processNoise.has_value()) {
+        j["processnoise"] = *f.processNoise;
+    }
+
+    if (f.measurementNoise.has_value()) {
+        j["measurementnoise"] = *f.measurementNoise;
+    }
+}
+
+static void from_json(const nlohmann::json& j, Tracker::Device::Prediction& p) {
+    if (auto it = j.find("model");  it != j.end()) {
+        p.model = parsePredictionModel(it->get<std::string>());
+    }
+    j.at("latency").get_to(p.latency);
+}
+
+static void to_json(nlohmann::json& j, const Tracker::Device::Prediction& p) {
+    j = nlohmann::json::object();
+
+    if (p.model.has_value()) {
+        switch (*p.model) {
+            case Tracker::Device::Prediction::Model::Velocity:
+                j["model"] = "velocity";
+                break;
+            case Tracker::Device::Prediction::Model::Acceleration:
+                j["model"] = "acceleration";
+                break;
+        }
+    }
+
+    j["latency"] = p.latency;
+}
+
 static void from_json(const nlohmann::json& j, Tracker::Device& d) {
     parseValue(j, "name", d.name);
     parseValue(j, "sensors", d.sensors);
@@ -965,6 +2116,8 @@ static void from_json(const nlohmann::json& j, Tracker::Device& d) {
     parseValue(j, "axes", d.axes);
     parseValue(j, "offset", d.offset);
     parseValue(j, "matrix", d.transformation);
+    parseValue(j, "filter", d.filter);
+    parseValue(j, "prediction", d.prediction);
 }
 
 static void to_json(nlohmann::json& j, const Tracker::Device& d) {
@@ -982,6 +2135,14 @@ static void to_json(nlohmann::json& j, const Tracker::Device& d) {
     if (d.transformation.has_value()) {
         j["matrix"] = *d.transformation;
     }
+
+    if (d.filter.has_value()) {
+        j["filter"] = *d.filter;
+    }
+
+    if (d.prediction.has_value()) {
+        j["prediction"] = *d.prediction;
+    }
 }
 
 static void from_json(const nlohmann::json& j, Tracker& t) {
@@ -1133,10 +2294,15 @@ static void to_json(nlohmann::json& j, const PlanarProjection& p) {
 
 static void from_json(const nlohmann::json& j, TextureMappedProjection& p) {
     from_json(j, static_cast<PlanarProjection&>(p));
+    parseValue(j, "baked", p.baked);
 }
 
 static void to_json(nlohmann::json& j, const TextureMappedProjection& p) {
     to_json(j, static_cast<const PlanarProjection&>(p));
+
+    if (p.baked.has_value()) {
+        j["baked"] = *p.baked;
+    }
 }
 
 static void from_json(const nlohmann::json& j, FisheyeProjection& p) {
@@ -1181,6 +2347,38 @@ static void from_json(const nlohmann::json& j, FisheyeProjection& p) {
     parseValue(j, "keepaspectratio", p.keepAspectRatio);
     parseValue(j, "offset", p.offset);
     parseValue(j, "background", p.background);
+    parseValue(j, "adaptiveresolution", p.adaptiveResolution);
+    parseValue(j, "directrendering", p.directRendering);
+
+    if (auto it = j.find("omnistereo");  it != j.end()) {
+        FisheyeProjection::OmniStereo omniStereo;
+        parseValue(*it, "tilesize", omniStereo.tileSize);
+        if (auto jt = it->find("turnmap");  jt != it->end()) {
+            omniStereo.turnMap = std::filesystem::absolute(jt->get<std::string>());
+        }
+        if (auto jt = it->find("separationmap");  jt != it->end()) {
+            omniStereo.separationMap = std::filesystem::absolute(jt->get<std::string>());
+        }
+        p.omniStereo = omniStereo;
+    }
+
+    if (auto it = j.find("distribution");  it != j.end()) {
+        FisheyeProjection::Distribution distribution;
+        distribution.output = it->value("output", distribution.output);
+        if (auto jt = it->find("helpers");  jt != it->end()) {
+            for (const nlohmann::json& h : *jt) {
+                FisheyeProjection::Distribution::Helper helper;
+                helper.node = h.value("node", helper.node);
+                if (auto kt = h.find("faces");  kt != h.end()) {
+                    for (const nlohmann::json& face : *kt) {
+                        helper.faces.push_back(parseCubeFace(face.get<std::string>()));
+                    }
+                }
+                distribution.helpers.push_back(std::move(helper));
+            }
+        }
+        p.distribution = std::move(distribution);
+    }
 }
 
 static void to_json(nlohmann::json& j, const FisheyeProjection& p) {
@@ -1233,6 +2431,46 @@ static void to_json(nlohmann::json& j, const FisheyeProjection& p) {
     if (p.background.has_value()) {
         j["background"] = *p.background;
     }
+
+    if (p.adaptiveResolution.has_value()) {
+        j["adaptiveresolution"] = *p.adaptiveResolution;
+    }
+
+    if (p.directRendering.has_value()) {
+        j["directrendering"] = *p.directRendering;
+    }
+
+    if (p.omniStereo.has_value()) {
+        nlohmann::json omniStereo = nlohmann::json::object();
+        if (p.omniStereo->tileSize.has_value()) {
+            omniStereo["tilesize"] = *p.omniStereo->tileSize;
+        }
+        if (p.omniStereo->turnMap.has_value()) {
+            omniStereo["turnmap"] = *p.omniStereo->turnMap;
+        }
+        if (p.omniStereo->separationMap.has_value()) {
+            omniStereo["separationmap"] = *p.omniStereo->separationMap;
+        }
+        j["omnistereo"] = omniStereo;
+    }
+
+    if (p.distribution.has_value()) {
+        nlohmann::json distribution = nlohmann::json::object();
+        distribution["output"] = p.distribution->output;
+        nlohmann::json helpers = nlohmann::json::array();
+        for (const FisheyeProjection::Distribution::Helper& h : p.distribution->helpers) {
+            nlohmann::json helper = nlohmann::json::object();
+            helper["node"] = h.node;
+            nlohmann::json faces = nlohmann::json::array();
+            for (FisheyeProjection::Distribution::Face face : h.faces) {
+                faces.push_back(toString(face));
+            }
+            helper["faces"] = faces;
+            helpers.push_back(helper);
+        }
+        distribution["helpers"] = helpers;
+        j["distribution"] = distribution;
+    }
 }
 
 static void from_json(const nlohmann::json& j, SphericalMirrorProjection& p) {
@@ -1243,6 +2481,7 @@ static void from_json(const nlohmann::json& j, SphericalMirrorProjection& p) {
 
     parseValue(j, "tilt", p.tilt);
     parseValue(j, "background", p.background);
+    parseValue(j, "adaptiveresolution", p.adaptiveResolution);
 
     if (auto it = j.find("geometry");  it != j.end()) {
         SphericalMirrorProjection::Mesh mesh;
@@ -1272,6 +2511,10 @@ static void to_json(nlohmann::json& j, const SphericalMirrorProjection& p) {
         j["background"] = *p.background;
     }
 
+    if (p.adaptiveResolution.has_value()) {
+        j["adaptiveresolution"] = *p.adaptiveResolution;
+    }
+
     nlohmann::json mesh = nlohmann::json::object();
     mesh["bottom"] = p.mesh.bottom;
     mesh["left"] = p.mesh.left;
@@ -1290,9 +2533,19 @@ static void from_json(const nlohmann::json& j, CubemapProjection::Channels& c) {
     parseValue(j, "zright", c.zRight);
 }
 
+static void from_json(const nlohmann::json& j, CubemapProjection::OutputIntervals& i) {
+    parseValue(j, "right", i.right);
+    parseValue(j, "zleft", i.zLeft);
+    parseValue(j, "bottom", i.bottom);
+    parseValue(j, "top", i.top);
+    parseValue(j, "left", i.left);
+    parseValue(j, "zright", i.zRight);
+}
+
 static void from_json(const nlohmann::json& j, CubemapProjection::Spout& s) {
     parseValue(j, "enabled", s.enabled);
     parseValue(j, "name", s.name);
+    parseValue(j, "sharedtexture", s.sharedTexture);
 }
 
 static void from_json(const nlohmann::json& j, CubemapProjection::NDI& n) {
@@ -1310,6 +2563,8 @@ static void from_json(const nlohmann::json& j, CubemapProjection& p) {
     parseValue(j, "spout", p.spout);
     parseValue(j, "ndi", p.ndi);
     parseValue(j, "channels", p.channels);
+    parseValue(j, "outputintervals", p.outputIntervals);
+    parseValue(j, "skipunsentfaces", p.skipUnsentFaces);
 
     if (auto it = j.find("orientation");  it != j.end()) {
         sgct::vec3 orientation;
@@ -1329,11 +2584,36 @@ static void to_json(nlohmann::json& j, const CubemapProjection::Channels& c) {
     j["zright"] = c.zRight;
 }
 
+static void to_json(nlohmann::json& j, const CubemapProjection::OutputIntervals& i) {
+    j = nlohmann::json::object();
+    if (i.right) {
+        j["right"] = *i.right;
+    }
+    if (i.zLeft) {
+        j["zleft"] = *i.zLeft;
+    }
+    if (i.bottom) {
+        j["bottom"] = *i.bottom;
+    }
+    if (i.top) {
+        j["top"] = *i.top;
+    }
+    if (i.left) {
+        j["left"] = *i.left;
+    }
+    if (i.zRight) {
+        j["zright"] = *i.zRight;
+    }
+}
+
 static void to_json(nlohmann::json& j, const CubemapProjection::Spout& s) {
     j["enabled"] = s.enabled;
     if (s.name) {
         j["name"] = *s.name;
     }
+    if (s.sharedTexture) {
+        j["sharedtexture"] = *s.sharedTexture;
+    }
 }
 
 static void to_json(nlohmann::json& j, const CubemapProjection::NDI& n) {
@@ -1365,6 +2645,14 @@ static void to_json(nlohmann::json& j, const CubemapProjection& p) {
         j["channels"] = *p.channels;
     }
 
+    if (p.outputIntervals.has_value()) {
+        j["outputintervals"] = *p.outputIntervals;
+    }
+
+    if (p.skipUnsentFaces.has_value()) {
+        j["skipunsentfaces"] = *p.skipUnsentFaces;
+    }
+
     if (p.orientation.has_value()) {
         nlohmann::json orientation = nlohmann::json::object();
         orientation["pitch"] = p.orientation->x;
@@ -1379,10 +2667,13 @@ static void from_json(const nlohmann::json& j, CylindricalProjection& p) {
         const std::string quality = it->get<std::string>();
         p.quality = cubeMapResolutionForQuality(quality);
     }
+    parseValue(j, "automaticquality", p.automaticQuality);
 
     parseValue(j, "rotation", p.rotation);
     parseValue(j, "heightoffset", p.heightOffset);
     parseValue(j, "radius", p.radius);
+    parseValue(j, "adaptiveresolution", p.adaptiveResolution);
+    parseValue(j, "lookuptexture", p.lookupTexture);
 }
 
 static void to_json(nlohmann::json& j, const CylindricalProjection& p) {
@@ -1392,6 +2683,10 @@ static void to_json(nlohmann::json& j, const CylindricalProjection& p) {
         j["quality"] = std::to_string(*p.quality);
     }
 
+    if (p.automaticQuality.has_value()) {
+        j["automaticquality"] = *p.automaticQuality;
+    }
+
     if (p.rotation.has_value()) {
         j["rotation"] = *p.rotation;
     }
@@ -1403,6 +2698,13 @@ static void to_json(nlohmann::json& j, const CylindricalProjection& p) {
     if (p.radius.has_value()) {
         j["radius"] = *p.radius;
     }
+
+    if (p.adaptiveResolution.has_value()) {
+        j["adaptiveresolution"] = *p.adaptiveResolution;
+    }
+    if (p.lookupTexture.has_value()) {
+        j["lookuptexture"] = *p.lookupTexture;
+    }
 }
 
 static void from_json(const nlohmann::json& j, EquirectangularProjection& p) {
@@ -1410,12 +2712,23 @@ static void from_json(const nlohmann::json& j, EquirectangularProjection& p) {
         const std::string quality = it->get<std::string>();
         p.quality = cubeMapResolutionForQuality(quality);
     }
+    parseValue(j, "automaticquality", p.automaticQuality);
+
+    parseValue(j, "lookuptexture", p.lookupTexture);
 }
 
 static void to_json(nlohmann::json& j, const EquirectangularProjection& p) {
     if (p.quality.has_value()) {
         j["quality"] = std::to_string(*p.quality);
     }
+
+    if (p.automaticQuality.has_value()) {
+        j["automaticquality"] = *p.automaticQuality;
+    }
+
+    if (p.lookupTexture.has_value()) {
+        j["lookuptexture"] = *p.lookupTexture;
+    }
 }
 
 static void from_json(const nlohmann::json& j, ProjectionPlane& p) {
@@ -1440,6 +2753,7 @@ static void to_json(nlohmann::json& j, const ProjectionPlane& p) {
 
 static void from_json(const nlohmann::json& j, Viewport& v) {
     parseValue(j, "user", v.user);
+    parseValue(j, "users", v.users);
     if (auto it = j.find("overlay");  it != j.end()) {
         v.overlayTexture = std::filesystem::absolute(it->get<std::string>());
     }
@@ -1454,6 +2768,10 @@ static void from_json(const nlohmann::json& j, Viewport& v) {
         v.correctionMeshTexture =
             std::filesystem::absolute(it->get<std::string>());
     }
+    parseValue(j, "meshtolerance", v.correctionMeshTolerance);
+    parseValue(j, "meshwarpmap", v.correctionMeshWarpMap);
+    parseValue(j, "meshprocedural", v.correctionMeshProcedural);
+    parseValue(j, "mesheditable", v.correctionMeshEditable);
 
     parseValue(j, "tracked", v.isTracked);
 
@@ -1514,6 +2832,10 @@ static void to_json(nlohmann::json& j, const Viewport& v) {
         j["user"] = *v.user;
     }
 
+    if (!v.users.empty()) {
+        j["users"] = v.users;
+    }
+
     if (v.overlayTexture.has_value()) {
         j["overlay"] = *v.overlayTexture;
     }
@@ -1530,6 +2852,22 @@ static void to_json(nlohmann::json& j, const Viewport& v) {
         j["mesh"] = *v.correctionMeshTexture;
     }
 
+    if (v.correctionMeshTolerance.has_value()) {
+        j["meshtolerance"] = *v.correctionMeshTolerance;
+    }
+
+    if (v.correctionMeshWarpMap.has_value()) {
+        j["meshwarpmap"] = *v.correctionMeshWarpMap;
+    }
+
+    if (v.correctionMeshProcedural.has_value()) {
+        j["meshprocedural"] = *v.correctionMeshProcedural;
+    }
+
+    if (v.correctionMeshEditable.has_value()) {
+        j["mesheditable"] = *v.correctionMeshEditable;
+    }
+
     if (v.isTracked.has_value()) {
         j["tracked"] = *v.isTracked;
     }
@@ -1606,6 +2944,7 @@ static void to_json(nlohmann::json& j, const Viewport& v) {
 static void from_json(const nlohmann::json& j, Window::Spout& n) {
     parseValue(j, "enabled", n.enabled);
     parseValue(j, "name", n.name);
+    parseValue(j, "sharedtexture", n.sharedTexture);
 }
 
 static void from_json(const nlohmann::json& j, Window::NDI& n) {
@@ -1614,6 +2953,26 @@ static void from_json(const nlohmann::json& j, Window::NDI& n) {
     parseValue(j, "groups", n.groups);
 }
 
+static void from_json(const nlohmann::json& j, Window::FrameExport& f) {
+    parseValue(j, "enabled", f.enabled);
+    parseValue(j, "name", f.name);
+}
+
+static void from_json(const nlohmann::json& j, Window::Stream& s) {
+    parseValue(j, "url", s.url);
+    if (auto it = j.find("codec");  it != j.end()) {
+        s.codec = parseCodec(it->get<std::string>());
+    }
+    parseValue(j, "bitrate", s.bitrate);
+    parseValue(j, "framerate", s.frameRate);
+    parseValue(j, "scale", s.scale);
+}
+
+static void from_json(const nlohmann::json& j, Window::Compositing& c) {
+    parseValue(j, "nodes", c.nodes);
+    parseValue(j, "output", c.output);
+}
+
 static void from_json(const nlohmann::json& j, Window& w) {
     std::optional<int8_t> id;
     parseValue(j, "id", id);
@@ -1625,6 +2984,8 @@ static void from_json(const nlohmann::json& j, Window& w) {
     parseValue(j, "takescreenshot", w.takeScreenshot);
     parseValue(j, "alpha", w.alpha);
     parseValue(j, "draw2d", w.draw2D);
+    parseValue(j, "draw2drate", w.draw2DRate);
+    parseValue(j, "renderevery", w.renderEvery);
     parseValue(j, "draw3d", w.draw3D);
 
     std::optional<std::filesystem::path> mesh;
@@ -1644,6 +3005,15 @@ static void from_json(const nlohmann::json& j, Window& w) {
         const std::string bbd = it->get<std::string>();
         w.bufferBitDepth = parseBufferColorBitDepth(bbd);
     }
+    if (auto it = j.find("cubemapbitdepth");  it != j.end()) {
+        w.cubemapBitDepth = parseBufferColorBitDepth(it->get<std::string>());
+    }
+    if (auto it = j.find("intermediatebitdepth");  it != j.end()) {
+        w.intermediateBitDepth = parseBufferColorBitDepth(it->get<std::string>());
+    }
+    if (auto it = j.find("capturebitdepth");  it != j.end()) {
+        w.captureBitDepth = parseBufferColorBitDepth(it->get<std::string>());
+    }
 
     parseValue(j, "fullscreen", w.isFullScreen);
     parseValue(j, "autoiconify", w.shouldAutoiconify);
@@ -1653,6 +3023,10 @@ static void from_json(const nlohmann::json& j, Window& w) {
 
     parseValue(j, "msaa", w.msaa);
     parseValue(j, "fxaa", w.useFxaa);
+    parseValue(j, "smaa", w.useSmaa);
+    parseValue(j, "taa", w.useTaa);
+    parseValue(j, "swapinterval", w.swapInterval);
+    parseValue(j, "adaptivesync", w.adaptiveSync);
 
     parseValue(j, "border", w.isDecorated);
     parseValue(j, "resizable", w.isResizable);
@@ -1661,13 +3035,18 @@ static void from_json(const nlohmann::json& j, Window& w) {
     parseValue(j, "mirrorx", w.mirrorX);
     parseValue(j, "mirrory", w.mirrorY);
     parseValue(j, "monitor", w.monitor);
+    parseValue(j, "gpu", w.gpu);
+    parseValue(j, "compositing", w.compositing);
 
     if (auto it = j.find("stereo");  it != j.end()) {
         w.stereo = parseStereoType(it->get<std::string>());
     }
+    parseValue(j, "singlepassstereo", w.singlePassStereo);
 
     parseValue(j, "spout", w.spout);
     parseValue(j, "ndi", w.ndi);
+    parseValue(j, "frameexport", w.frameExport);
+    parseValue(j, "stream", w.stream);
 
     parseValue(j, "pos", w.pos);
     parseValue(j, "size", w.size);
@@ -1681,6 +3060,14 @@ static void to_json(nlohmann::json& j, const Window::Spout& n) {
     if (n.name) {
         j["name"] = *n.name;
     }
+    if (n.sharedTexture) {
+        j["sharedtexture"] = *n.sharedTexture;
+    }
+}
+
+static void to_json(nlohmann::json& j, const Window::Compositing& c) {
+    j["nodes"] = c.nodes;
+    j["output"] = c.output;
 }
 
 static void to_json(nlohmann::json& j, const Window::NDI& n) {
@@ -1693,6 +3080,29 @@ static void to_json(nlohmann::json& j, const Window::NDI& n) {
     }
 }
 
+static void to_json(nlohmann::json& j, const Window::FrameExport& f) {
+    j["enabled"] = f.enabled;
+    if (f.name) {
+        j["name"] = *f.name;
+    }
+}
+
+static void to_json(nlohmann::json& j, const Window::Stream& s) {
+    j["url"] = s.url;
+    if (s.codec) {
+        j["codec"] = *s.codec == Capture::Codec::H264 ? "h264" : "hevc";
+    }
+    if (s.bitrate) {
+        j["bitrate"] = *s.bitrate;
+    }
+    if (s.frameRate) {
+        j["framerate"] = *s.frameRate;
+    }
+    if (s.scale) {
+        j["scale"] = *s.scale;
+    }
+}
+
 static void to_json(nlohmann::json& j, const Window& w) {
     j["id"] = w.id;
 
@@ -1716,37 +3126,32 @@ static void to_json(nlohmann::json& j, const Window& w) {
         j["draw2d"] = *w.draw2D;
     }
 
+    if (w.draw2DRate.has_value()) {
+        j["draw2drate"] = *w.draw2DRate;
+    }
+
+    if (w.renderEvery.has_value()) {
+        j["renderevery"] = *w.renderEvery;
+    }
+
     if (w.draw3D.has_value()) {
         j["draw3d"] = *w.draw3D;
     }
 
     if (w.bufferBitDepth.has_value()) {
-        switch (*w.bufferBitDepth) {
-            case Window::ColorBitDepth::Depth8:
-                j["bufferbitdepth"] = "8";
-                break;
-            case Window::ColorBitDepth::Depth16:
-                j["bufferbitdepth"] = "16";
-                break;
-            case Window::ColorBitDepth::Depth16Float:
-                j["bufferbitdepth"] = "16f";
-                break;
-            case Window::ColorBitDepth::Depth32Float:
-                j["bufferbitdepth"] = "32f";
-                break;
-            case Window::ColorBitDepth::Depth16Int:
-                j["bufferbitdepth"] = "16i";
-                break;
-            case Window::ColorBitDepth::Depth32Int:
-                j["bufferbitdepth"] = "32i";
-                break;
-            case Window::ColorBitDepth::Depth16UInt:
-                j["bufferbitdepth"] = "16ui";
-                break;
-            case Window::ColorBitDepth::Depth32UInt:
-                j["bufferbitdepth"] = "32ui";
-                break;
-        }
+        j["bufferbitdepth"] = toString(*w.bufferBitDepth);
+    }
+
+    if (w.cubemapBitDepth.has_value()) {
+        j["cubemapbitdepth"] = toString(*w.cubemapBitDepth);
+    }
+
+    if (w.intermediateBitDepth.has_value()) {
+        j["intermediatebitdepth"] = toString(*w.intermediateBitDepth);
+    }
+
+    if (w.captureBitDepth.has_value()) {
+        j["capturebitdepth"] = toString(*w.captureBitDepth);
     }
 
     if (w.isFullScreen.has_value()) {
@@ -1777,6 +3182,22 @@ static void to_json(nlohmann::json& j, const Window& w) {
         j["fxaa"] = *w.useFxaa;
     }
 
+    if (w.useSmaa.has_value()) {
+        j["smaa"] = *w.useSmaa;
+    }
+
+    if (w.useTaa.has_value()) {
+        j["taa"] = *w.useTaa;
+    }
+
+    if (w.swapInterval.has_value()) {
+        j["swapinterval"] = *w.swapInterval;
+    }
+
+    if (w.adaptiveSync.has_value()) {
+        j["adaptivesync"] = *w.adaptiveSync;
+    }
+
     if (w.isDecorated.has_value()) {
         j["border"] = *w.isDecorated;
     }
@@ -1797,6 +3218,14 @@ static void to_json(nlohmann::json& j, const Window& w) {
         j["monitor"] = *w.monitor;
     }
 
+    if (w.gpu.has_value()) {
+        j["gpu"] = *w.gpu;
+    }
+
+    if (w.compositing.has_value()) {
+        j["compositing"] = *w.compositing;
+    }
+
     if (w.mirrorX.has_value()) {
         j["mirrorx"] = *w.mirrorX;
     }
@@ -1809,6 +3238,10 @@ static void to_json(nlohmann::json& j, const Window& w) {
         j["stereo"] = toString(*w.stereo);
     }
 
+    if (w.singlePassStereo.has_value()) {
+        j["singlepassstereo"] = *w.singlePassStereo;
+    }
+
     if (w.spout.has_value()) {
         j["spout"] = *w.spout;
     }
@@ -1817,6 +3250,14 @@ static void to_json(nlohmann::json& j, const Window& w) {
         j["ndi"] = *w.ndi;
     }
 
+    if (w.frameExport.has_value()) {
+        j["frameexport"] = *w.frameExport;
+    }
+
+    if (w.stream.has_value()) {
+        j["stream"] = *w.stream;
+    }
+
     if (w.pos.has_value()) {
         j["pos"] = *w.pos;
     }
@@ -1864,6 +3305,8 @@ static void from_json(const nlohmann::json& j, Node& n) {
 
     parseValue(j, "datatransferport", n.dataTransferPort);
     parseValue(j, "swaplock", n.swapLock);
+    parseValue(j, "critical", n.isCritical);
+    parseValue(j, "pollinterval", n.pollInterval);
 
     parseValue(j, "windows", n.windows);
     if (n.windows.size() > std::numeric_limits<int8_t>::max()) {
@@ -1888,6 +3331,14 @@ static void to_json(nlohmann::json& j, const Node& n) {
         j["swaplock"] = *n.swapLock;
     }
 
+    if (n.isCritical.has_value()) {
+        j["critical"] = *n.isCritical;
+    }
+
+    if (n.pollInterval.has_value()) {
+        j["pollinterval"] = *n.pollInterval;
+    }
+
     if (!n.windows.empty()) {
         j["windows"] = n.windows;
     }
@@ -2012,6 +3463,32 @@ static void to_json(nlohmann::json& j, const Cluster& c) {
 
 namespace sgct {
 
+namespace {
+    config::Cluster readCluster(const nlohmann::json& j) {
+        auto it = j.find("version");
+        if (it == j.end()) {
+            throw std::runtime_error("Missing 'version' information");
+        }
+
+        config::Cluster cluster;
+        from_json(j, cluster);
+        cluster.success = true;
+        return cluster;
+    }
+
+    nlohmann::json clusterToJson(const config::Cluster& cluster,
+                                 std::optional<config::GeneratorVersion> genVersion)
+    {
+        nlohmann::json res;
+        res["version"] = 1;
+        if (genVersion) {
+            res["generator"] = genVersion.value();
+        }
+        to_json(res, cluster);
+        return res;
+    }
+} // namespace
+
 config::Cluster readConfig(const std::filesystem::path& filename) {
     if (filename.empty()) {
         throw Err(6080, "No configuration file provided");
@@ -2036,12 +3513,19 @@ config::Cluster readConfig(const std::filesystem::path& filename) {
 
     // Then load the cluster
     try {
-        std::ifstream f = std::ifstream(name);
+        const bool isBinary = name.extension() == ".cbor";
+        std::ifstream f = std::ifstream(name, isBinary ? std::ios::binary : std::ios::in);
         const std::string contents = std::string(
             std::istreambuf_iterator<char>(f),
             std::istreambuf_iterator<char>()
         );
-        const config::Cluster cluster = readJsonConfig(contents);
+        const config::Cluster cluster =
+            isBinary ?
+            readBinaryConfig(std::span(
+                reinterpret_cast<const uint8_t*>(contents.data()),
+                contents.size()
+            )) :
+            readJsonConfig(contents);
         // and reset the current working directory to the old value
         std::filesystem::current_path(oldPwd);
         return cluster;
@@ -2054,17 +3538,11 @@ config::Cluster readConfig(const std::filesystem::path& filename) {
 }
 
 config::Cluster readJsonConfig(std::string_view configuration) {
-    nlohmann::json j = nlohmann::json::parse(configuration);
-
-    auto it = j.find("version");
-    if (it == j.end()) {
-        throw std::runtime_error("Missing 'version' information");
-    }
+    return readCluster(nlohmann::json::parse(configuration));
+}
 
-    config::Cluster cluster;
-    from_json(j, cluster);
-    cluster.success = true;
-    return cluster;
+config::Cluster readBinaryConfig(std::span<const uint8_t> configuration) {
+    return readCluster(nlohmann::json::from_cbor(configuration));
 }
 
 config::Cluster defaultCluster() {
@@ -2106,58 +3584,23 @@ config::Cluster defaultCluster() {
 std::string serializeConfig(const config::Cluster& cluster,
                             std::optional<config::GeneratorVersion> genVersion)
 {
-    nlohmann::json res;
-    res["version"] = 1;
-    if (genVersion) {
-        res["generator"] = genVersion.value();
-    }
-    to_json(res, cluster);
-    return res.dump(2);
+    return clusterToJson(cluster, std::move(genVersion)).dump(2);
+}
+
+std::vector<uint8_t> serializeBinaryConfig(
+                                                           const config::Cluster& cluster,
+                                       std::optional<config::GeneratorVersion> genVersion)
+{
+    return nlohmann::json::to_cbor(clusterToJson(cluster, std::move(genVersion)));
 }
 
 std::string validateConfigAgainstSchema(std::string_view configuration,
                                         const std::filesystem::path& schema)
 {
-    using nlohmann::json;
-    using nlohmann::json_uri;
-    using nlohmann::json_schema::basic_error_handler;
-    using nlohmann::json_schema::json_validator;
-
-    const std::string schemaStr = stringifyJsonFile(schema);
-    const json schemaInput = json::parse(schemaStr);
-    const std::filesystem::path schemaDir = std::filesystem::path(schema).parent_path();
-    const json_validator validator = json_validator(
-        schemaInput,
-        [&schemaDir](const json_uri& id, json& value) {
-            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-            // formatting std::filesystem::path
-            std::string loadPath = std::format(
-                "{}/{}", schemaDir.string(), id.to_string()
-            );
-            const size_t lbIndex = loadPath.find('#');
-            if (lbIndex != std::string::npos) {
-                loadPath = loadPath.substr(0, lbIndex);
-            }
-            // Remove trailing spaces
-            if (!loadPath.empty()) {
-                const size_t strEnd = loadPath.find_last_not_of(" #\t\r\n\0");
-                loadPath = loadPath.substr(0, strEnd + 1);
-            }
-            if (std::filesystem::exists(loadPath)) {
-                Log::Debug(std::format("Loading schema file '{}'", loadPath));
-                const std::string newSchema = stringifyJsonFile(loadPath);
-                value = json::parse(newSchema);
-            }
-            else {
-                throw Err(
-                    6081,
-                    std::format("Could not find schema file to load: {}", loadPath)
-                );
-            }
-        }
-    );
+    const nlohmann::json config = nlohmann::json::parse(configuration);
 
-    json config = json::parse(configuration);
+    std::lock_guard lock(ValidatorMutex);
+    const nlohmann::json_schema::json_validator& validator = cachedValidator(schema);
     try {
         validator.validate(config);
         return "";
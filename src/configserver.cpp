@@ -0,0 +1,340 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/configserver.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/types.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <unistd.h>
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <zlib.h>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    // The magic number, the uncompressed size, the compressed size, and the CRC-32 of the
+    // uncompressed configuration
+    constexpr uint32_t Magic = 0x46434753; // "SGCF"
+    constexpr size_t HeaderSize = 4 * sizeof(uint32_t);
+
+    // Protects the clients against allocating huge buffers for a damaged header
+    constexpr uint32_t MaxConfigSize = 256 * 1024 * 1024;
+
+    // The time a client gets to receive the configuration, and the time after which the
+    // server gives up sending it
+    constexpr int TransferTimeout = 10; // seconds
+
+    // The interval in which the server checks whether it should stop
+    constexpr long AcceptInterval = 100 * 1000; // microseconds
+
+    void closeSocket(SGCT_SOCKET socket) {
+#ifdef WIN32
+        closesocket(socket);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        close(socket);
+#endif // WIN32
+    }
+
+    void setTimeout(SGCT_SOCKET socket, int option) {
+#ifdef WIN32
+        const DWORD timeout = TransferTimeout * 1000;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        const timeval timeout = { TransferTimeout, 0 };
+#endif // WIN32
+        setsockopt(
+            socket,
+            SOL_SOCKET,
+            option,
+            reinterpret_cast<const char*>(&timeout),
+            sizeof(timeout)
+        );
+    }
+
+    bool sendAll(SGCT_SOCKET socket, const char* data, size_t size) {
+        while (size > 0) {
+            const long sent = send(socket, data, static_cast<int>(size), 0);
+            if (sent == SOCKET_ERROR || sent == 0) {
+                return false;
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool receiveAll(SGCT_SOCKET socket, char* data, size_t size) {
+        while (size > 0) {
+            const long received = recv(socket, data, static_cast<int>(size), 0);
+            if (received <= 0) {
+                return false;
+            }
+            data += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    std::vector<char> createMessage(const sgct::config::Cluster& cluster) {
+        ZoneScoped;
+
+        const std::vector<uint8_t> data = sgct::serializeBinaryConfig(cluster);
+        uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+        std::vector<char> res(HeaderSize + compressedSize);
+        const int r = compress2(
+            reinterpret_cast<Bytef*>(res.data() + HeaderSize),
+            &compressedSize,
+            data.data(),
+            static_cast<uLong>(data.size()),
+            Z_BEST_COMPRESSION
+        );
+        if (r != Z_OK) {
+            throw Err(5041, "Failed to compress the configuration");
+        }
+        res.resize(HeaderSize + compressedSize);
+
+        const std::array<uint32_t, 4> header = {
+            Magic,
+            static_cast<uint32_t>(data.size()),
+            static_cast<uint32_t>(compressedSize),
+            static_cast<uint32_t>(
+                crc32(0, data.data(), static_cast<uInt>(data.size()))
+            )
+        };
+        std::memcpy(res.data(), header.data(), HeaderSize);
+        return res;
+    }
+
+    SGCT_SOCKET connectToServer(const std::string& address, int port, double timeout) {
+        ZoneScoped;
+
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        addrinfo* res = nullptr;
+        const std::string portStr = std::to_string(port);
+        if (getaddrinfo(address.c_str(), portStr.c_str(), &hints, &res) != 0) {
+            throw Err(5042, std::format("Failed to resolve config server '{}'", address));
+        }
+
+        // The master might not have opened its port yet
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + std::chrono::duration<double>(timeout);
+        while (true) {
+            SGCT_SOCKET s = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+            if (s == INVALID_SOCKET) {
+                freeaddrinfo(res);
+                throw Err(5042, "Failed to create the socket for the config server");
+            }
+            const int r = connect(s, res->ai_addr, static_cast<int>(res->ai_addrlen));
+            if (r != SOCKET_ERROR) {
+                freeaddrinfo(res);
+                return s;
+            }
+            closeSocket(s);
+
+            if (std::chrono::steady_clock::now() > end) {
+                freeaddrinfo(res);
+                throw Err(
+                    5042,
+                    std::format("Failed to connect to config server {}:{}", address, port)
+                );
+            }
+            sgct::Log::Debug("Waiting for config server...");
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+    }
+
+    std::vector<uint8_t> receiveConfig(const std::string& address, int port,
+                                       double timeout)
+    {
+        ZoneScoped;
+
+        const SGCT_SOCKET s = connectToServer(address, port, timeout);
+        setTimeout(s, SO_RCVTIMEO);
+
+        std::array<uint32_t, 4> header;
+        if (!receiveAll(s, reinterpret_cast<char*>(header.data()), HeaderSize)) {
+            closeSocket(s);
+            throw Err(5043, "Failed to receive the configuration from the config server");
+        }
+        const auto [magic, size, compressedSize, crc] = header;
+        if (magic != Magic || size > MaxConfigSize || compressedSize > MaxConfigSize) {
+            closeSocket(s);
+            throw Err(5043, "Received an invalid configuration from the config server");
+        }
+
+        std::vector<char> compressed(compressedSize);
+        const bool success = receiveAll(s, compressed.data(), compressed.size());
+        closeSocket(s);
+        if (!success) {
+            throw Err(5043, "Failed to receive the configuration from the config server");
+        }
+
+        std::vector<uint8_t> res(size);
+        uLongf resSize = size;
+        const int r = uncompress(
+            res.data(),
+            &resSize,
+            reinterpret_cast<const Bytef*>(compressed.data()),
+            static_cast<uLong>(compressed.size())
+        );
+        if (r != Z_OK || resSize != size ||
+            crc32(0, res.data(), static_cast<uInt>(res.size())) != crc)
+        {
+            throw Err(5043, "The configuration from the config server is damaged");
+        }
+        return res;
+    }
+} // namespace
+
+namespace sgct {
+
+ConfigServer::ConfigServer(const config::Cluster& cluster, int port)
+    : _message(createMessage(cluster))
+    , _socket(static_cast<SGCT_SOCKET>(INVALID_SOCKET))
+{
+    ZoneScoped;
+
+    _socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (_socket == INVALID_SOCKET) {
+        Log::Error(std::format(
+            "Failed to create the config server socket: {}", SGCT_ERRNO
+        ));
+        return;
+    }
+
+    const int reuse = 1;
+    setsockopt(
+        _socket,
+        SOL_SOCKET,
+        SO_REUSEADDR,
+        reinterpret_cast<const char*>(&reuse),
+        sizeof(reuse)
+    );
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    const int bindResult =
+        bind(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    if (bindResult == SOCKET_ERROR || listen(_socket, SOMAXCONN) == SOCKET_ERROR) {
+        Log::Error(std::format(
+            "Failed to serve the configuration on port {}: {}", port, SGCT_ERRNO
+        ));
+        closeSocket(_socket);
+        _socket = static_cast<SGCT_SOCKET>(INVALID_SOCKET);
+        return;
+    }
+
+    Log::Info(std::format(
+        "Serving the configuration ({} bytes) on port {}", _message.size(), port
+    ));
+    _isRunning = true;
+    _thread = std::thread(&ConfigServer::work, this);
+}
+
+ConfigServer::~ConfigServer() {
+    _isRunning = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_socket != INVALID_SOCKET) {
+        closeSocket(_socket);
+    }
+}
+
+void ConfigServer::setCluster(const config::Cluster& cluster) {
+    std::vector<char> message = createMessage(cluster);
+    std::lock_guard lock(_mutex);
+    _message = std::move(message);
+}
+
+void ConfigServer::work() {
+    std::vector<char> message;
+    while (_isRunning) {
+        fd_set sockets;
+        FD_ZERO(&sockets);
+        FD_SET(_socket, &sockets);
+        timeval timeout = { 0, AcceptInterval };
+        const int nfds = static_cast<int>(_socket + 1);
+        const int res = select(nfds, &sockets, nullptr, nullptr, &timeout);
+        if (res <= 0 || !FD_ISSET(_socket, &sockets)) {
+            continue;
+        }
+
+        const SGCT_SOCKET client = accept(_socket, nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            continue;
+        }
+        {
+            std::lock_guard lock(_mutex);
+            message = _message;
+        }
+        setTimeout(client, SO_SNDTIMEO);
+        if (!sendAll(client, message.data(), message.size())) {
+            Log::Warning(std::format(
+                "Failed to send the configuration to a client: {}", SGCT_ERRNO
+            ));
+        }
+        closeSocket(client);
+    }
+}
+
+config::Cluster fetchConfig(const std::string& address, int port, double timeout) {
+    ZoneScoped;
+
+    Log::Info(std::format("Requesting the configuration from {}:{}", address, port));
+#ifdef WIN32
+    // The network API is only initialized by the NetworkManager once the Engine exists
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        throw Err(5042, "Winsock 2.2 startup failed");
+    }
+    std::vector<uint8_t> data;
+    try {
+        data = receiveConfig(address, port, timeout);
+    }
+    catch (...) {
+        WSACleanup();
+        throw;
+    }
+    WSACleanup();
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const std::vector<uint8_t> data = receiveConfig(address, port, timeout);
+#endif // WIN32
+    Log::Debug(std::format("Received the configuration ({} bytes)", data.size()));
+    return readBinaryConfig(data);
+}
+
+} // namespace sgct
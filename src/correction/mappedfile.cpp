@@ -0,0 +1,125 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/mappedfile.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+#include <sgct/profiling.h>
+
+namespace sgct::correction {
+
+std::unique_ptr<MappedFile> MappedFile::map(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    std::unique_ptr<MappedFile> file = std::unique_ptr<MappedFile>(new MappedFile);
+#ifdef WIN32
+    file->_file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file->_file == INVALID_HANDLE_VALUE) {
+        file->_file = nullptr;
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->_file, &size)) {
+        return nullptr;
+    }
+    if (size.QuadPart == 0) {
+        // An empty file cannot be mapped, but it is still a valid file
+        return file;
+    }
+    file->_size = static_cast<size_t>(size.QuadPart);
+    file->_mapping = CreateFileMappingW(
+        file->_file,
+        nullptr,
+        PAGE_READONLY,
+        0,
+        0,
+        nullptr
+    );
+    if (!file->_mapping) {
+        return nullptr;
+    }
+    file->_memory = reinterpret_cast<const std::byte*>(
+        MapViewOfFile(file->_mapping, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (!file->_memory) {
+        return nullptr;
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        return nullptr;
+    }
+    if (info.st_size == 0) {
+        // An empty file cannot be mapped, but it is still a valid file
+        close(fd);
+        return file;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive on its own
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    file->_memory = reinterpret_cast<const std::byte*>(memory);
+    file->_size = size;
+#endif // WIN32
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#ifdef WIN32
+    if (_memory) {
+        UnmapViewOfFile(_memory);
+    }
+    if (_mapping) {
+        CloseHandle(_mapping);
+    }
+    if (_file) {
+        CloseHandle(_file);
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (_memory) {
+        munmap(const_cast<std::byte*>(_memory), _size);
+    }
+#endif // WIN32
+}
+
+std::span<const std::byte> MappedFile::data() const {
+    return std::span<const std::byte>(_memory, _size);
+}
+
+std::string_view MappedFile::text() const {
+    return std::string_view(reinterpret_cast<const char*>(_memory), _size);
+}
+
+} // namespace sgct::correction
@@ -0,0 +1,315 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/meshcache.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <string_view>
+#include <system_error>
+
+namespace {
+    // Increased whenever the layout of the cache file or of the Buffer::Vertex changes,
+    // or when the stored meshes are processed differently before they are written
+    constexpr uint32_t Version = 2;
+    constexpr std::array<char, 4> Magic = { 'S', 'G', 'M', 'C' };
+
+    struct Header {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t geometryType;
+        uint32_t nVertices;
+        uint32_t nIndices;
+        uint32_t padding;
+    };
+    static_assert(sizeof(Header) == 32, "The header must not contain any padding");
+
+    // Increased whenever the layout of the warp map cache file changes
+    constexpr uint32_t WarpMapVersion = 1;
+    constexpr std::array<char, 4> WarpMapMagic = { 'S', 'G', 'W', 'M' };
+
+    struct WarpMapHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t width;
+        uint32_t height;
+    };
+    static_assert(
+        sizeof(WarpMapHeader) == 24,
+        "The header must not contain any padding"
+    );
+
+    // The 64-bit FNV-1a hash
+    constexpr uint64_t FnvOffset = 14695981039346656037ull;
+    constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    void hash(uint64_t& h, const void* data, size_t size) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            h = (h ^ bytes[i]) * FnvPrime;
+        }
+    }
+
+    // Maps the cache file at the \p cachePath, or returns `nullptr` if it does not exist
+    // or cannot be mapped
+    std::unique_ptr<sgct::correction::MappedFile> mapCacheFile(
+                                                  const std::filesystem::path& cachePath,
+                                                                  std::string_view kind)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(cachePath, ec)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<sgct::correction::MappedFile> file =
+            sgct::correction::MappedFile::map(cachePath);
+        if (!file) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            // formatting std::filesystem::path
+            sgct::Log::Warning(
+                std::format("Failed to map {} '{}'", kind, cachePath.string())
+            );
+        }
+        return file;
+    }
+
+    // Writes the \p parts after each other into the cache file at the \p cachePath. They
+    // are written to a temporary file first, so that other nodes that share the
+    // directory never map a partially written cache
+    void writeCacheFile(const std::filesystem::path& cachePath, std::string_view kind,
+                        std::initializer_list<std::span<const std::byte>> parts)
+    {
+        std::filesystem::path tmpPath = cachePath;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file = std::ofstream(tmpPath, std::ofstream::binary);
+            for (std::span<const std::byte> part : parts) {
+                file.write(reinterpret_cast<const char*>(part.data()), part.size());
+            }
+            if (!file.good()) {
+                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+                // formatting std::filesystem::path
+                sgct::Log::Warning(
+                    std::format("Failed to write {} '{}'", kind, cachePath.string())
+                );
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(tmpPath, ec);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, cachePath, ec);
+        if (ec) {
+            // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+            // formatting std::filesystem::path
+            sgct::Log::Warning(std::format(
+                "Failed to write {} '{}': {}", kind, cachePath.string(), ec.message()
+            ));
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+} // namespace
+
+namespace sgct::correction {
+
+std::filesystem::path meshCachePath(const std::filesystem::path& path) {
+    std::filesystem::path res = path;
+    res += ".sgctcache";
+    return res;
+}
+
+uint64_t meshCacheKey(const std::filesystem::path& path,
+                      std::span<const float> parameters)
+{
+    ZoneScoped;
+
+    uint64_t h = FnvOffset;
+    hash(h, &Version, sizeof(Version));
+    hash(h, parameters.data(), parameters.size_bytes());
+
+    if (std::unique_ptr<MappedFile> file = MappedFile::map(path);  file) {
+        hash(h, file->data().data(), file->data().size());
+    }
+    return h;
+}
+
+uint64_t combineMeshCacheKeys(std::span<const uint64_t> keys) {
+    uint64_t h = FnvOffset;
+    hash(h, keys.data(), keys.size_bytes());
+    return h;
+}
+
+std::unique_ptr<CachedMesh> readMeshCache(const std::filesystem::path& path,
+                                          uint64_t key)
+{
+    ZoneScoped;
+
+    const std::filesystem::path cachePath = meshCachePath(path);
+    std::unique_ptr<MappedFile> file = mapCacheFile(cachePath, "mesh cache");
+    if (!file) {
+        return nullptr;
+    }
+
+    const std::span<const std::byte> data = file->data();
+    Header header;
+    if (data.size() < sizeof(Header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, data.data(), sizeof(Header));
+    const size_t verticesSize = header.nVertices * sizeof(Buffer::Vertex);
+    const size_t indicesSize = header.nIndices * sizeof(unsigned int);
+    if (header.magic != Magic || header.version != Version || header.key != key ||
+        data.size() != sizeof(Header) + verticesSize + indicesSize)
+    {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Debug(std::format("Mesh cache '{}' is out of date", cachePath.string()));
+        return nullptr;
+    }
+
+    // The mapping is page-aligned and the header keeps the arrays aligned after it
+    const std::byte* vertices = data.data() + sizeof(Header);
+    std::unique_ptr<CachedMesh> mesh = std::make_unique<CachedMesh>();
+    mesh->vertices = std::span<const Buffer::Vertex>(
+        reinterpret_cast<const Buffer::Vertex*>(vertices),
+        header.nVertices
+    );
+    mesh->indices = std::span<const unsigned int>(
+        reinterpret_cast<const unsigned int*>(vertices + verticesSize),
+        header.nIndices
+    );
+    mesh->geometryType = header.geometryType;
+    mesh->file = std::move(file);
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    Log::Info(std::format("Reading cached mesh data from '{}'", cachePath.string()));
+    return mesh;
+}
+
+void writeMeshCache(const std::filesystem::path& path, uint64_t key,
+                    const Buffer& buffer)
+{
+    ZoneScoped;
+
+    const Header header = {
+        .magic = Magic,
+        .version = Version,
+        .key = key,
+        .geometryType = buffer.geometryType,
+        .nVertices = static_cast<uint32_t>(buffer.vertices.size()),
+        .nIndices = static_cast<uint32_t>(buffer.indices.size()),
+        .padding = 0
+    };
+
+    writeCacheFile(
+        meshCachePath(path),
+        "mesh cache",
+        {
+            std::as_bytes(std::span(&header, 1)),
+            std::as_bytes(std::span(buffer.vertices)),
+            std::as_bytes(std::span(buffer.indices))
+        }
+    );
+}
+
+std::filesystem::path warpMapCachePath(const std::filesystem::path& path) {
+    std::filesystem::path res = path;
+    res += ".sgctwarpmap";
+    return res;
+}
+
+std::unique_ptr<CachedWarpMap> readWarpMapCache(const std::filesystem::path& path,
+                                                uint64_t key, ivec2 size)
+{
+    ZoneScoped;
+
+    const std::filesystem::path cachePath = warpMapCachePath(path);
+    std::unique_ptr<MappedFile> file = mapCacheFile(cachePath, "warp map cache");
+    if (!file) {
+        return nullptr;
+    }
+
+    const std::span<const std::byte> data = file->data();
+    WarpMapHeader header;
+    if (data.size() < sizeof(WarpMapHeader)) {
+        return nullptr;
+    }
+    std::memcpy(&header, data.data(), sizeof(WarpMapHeader));
+    const size_t nPixels = static_cast<size_t>(header.width) * header.height;
+    const size_t texCoordsSize = nPixels * 2 * sizeof(float);
+    const size_t colorsSize = nPixels * 4 * sizeof(uint16_t);
+    if (header.magic != WarpMapMagic || header.version != WarpMapVersion ||
+        header.key != key || header.width != static_cast<uint32_t>(size.x) ||
+        header.height != static_cast<uint32_t>(size.y) ||
+        data.size() != sizeof(WarpMapHeader) + texCoordsSize + colorsSize)
+    {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Debug(
+            std::format("Warp map cache '{}' is out of date", cachePath.string())
+        );
+        return nullptr;
+    }
+
+    // The mapping is page-aligned and the header keeps the arrays aligned after it
+    const std::byte* texCoords = data.data() + sizeof(WarpMapHeader);
+    std::unique_ptr<CachedWarpMap> map = std::make_unique<CachedWarpMap>();
+    map->texCoords = std::span<const float>(
+        reinterpret_cast<const float*>(texCoords),
+        nPixels * 2
+    );
+    map->colors = std::span<const uint16_t>(
+        reinterpret_cast<const uint16_t*>(texCoords + texCoordsSize),
+        nPixels * 4
+    );
+    map->file = std::move(file);
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    Log::Info(std::format("Reading cached warp map from '{}'", cachePath.string()));
+    return map;
+}
+
+void writeWarpMapCache(const std::filesystem::path& path, uint64_t key, ivec2 size,
+                       std::span<const float> texCoords, std::span<const uint16_t> colors)
+{
+    ZoneScoped;
+
+    const size_t nPixels = static_cast<size_t>(size.x) * size.y;
+    assert(texCoords.size() == nPixels * 2 && colors.size() == nPixels * 4);
+
+    const WarpMapHeader header = {
+        .magic = WarpMapMagic,
+        .version = WarpMapVersion,
+        .key = key,
+        .width = static_cast<uint32_t>(size.x),
+        .height = static_cast<uint32_t>(size.y)
+    };
+    writeCacheFile(
+        warpMapCachePath(path),
+        "warp map cache",
+        {
+            std::as_bytes(std::span(&header, 1)),
+            std::as_bytes(texCoords),
+            std::as_bytes(colors)
+        }
+    );
+}
+
+} // namespace sgct::correction
@@ -6,15 +6,20 @@
  * For conditions of distribution and use, see copyright notice in LICENSE.md            *
  ****************************************************************************************/
 
-#include <sgct/correction/skyskan.h>
+#include <sgct/correction/obj.h>
 
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/correction/mappedfile.h>
+#include <sgct/correction/textparser.h>
+#include <algorithm>
 #include <cassert>
-#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace {
     struct Position {
@@ -41,8 +46,8 @@ Buffer generateOBJMesh(const std::filesystem::path& path) {
     // formatting std::filesystem::path
     Log::Info(std::format("Reading Wavefront OBJ mesh data from '{}'", path.string()));
 
-    std::ifstream file = std::ifstream(path);
-    if (!file.good()) {
+    std::unique_ptr<MappedFile> file = MappedFile::map(path);
+    if (!file) {
         // @TODO: Remove `.string()` as soon as Clang on MacOS supports
         // formatting std::filesystem::path
         throw Error(
@@ -56,40 +61,21 @@ Buffer generateOBJMesh(const std::filesystem::path& path) {
 
     std::vector<std::string> reported;
 
-    std::string line;
-    while (std::getline(file, line)) {
+    LineReader lines = LineReader(file->text());
+    std::string_view line;
+    while (lines.next(line)) {
         if (line.empty()) {
             continue;
         }
-        else if (line.back() == '\r') {
-            line.pop_back();
-        }
 
-        const std::string_view v = line;
-        const size_t separator = v.find(' ');
-        std::string_view first = v.substr(0, separator);
-        std::string_view rest = v.substr(separator + 1);
+        std::string_view rest = line;
+        const std::string_view first = nextToken(rest);
 
         if (first == "v") {
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::OBJ, 2034,
-                    std::format(
-                        "Illegal vertex format in OBJ file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view v1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
+            const std::string_view v1 = nextToken(rest);
+            const std::string_view v2 = nextToken(rest);
+            const std::string_view v3 = nextToken(rest);
+            if (v2.empty() || v3.empty()) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
                 throw Error(
@@ -100,11 +86,8 @@ Buffer generateOBJMesh(const std::filesystem::path& path) {
                     )
                 );
             }
-            const std::string_view v2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
 
-            const std::string_view v3 = rest;
-            const float z = std::stof(std::string(v3));
+            const float z = toFloat(v3);
             if (z != 0.f) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -115,26 +98,24 @@ Buffer generateOBJMesh(const std::filesystem::path& path) {
             }
 
             Position p;
-            p.x = std::stof(std::string(v1));
-            p.y = std::stof(std::string(v2));
+            p.x = toFloat(v1);
+            p.y = toFloat(v2);
             positions.push_back(p);
         }
         else if (first == "vt") {
-            size_t sep = rest.find(' ');
-            const std::string_view v1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            const std::string_view v2 = rest.substr(0, sep);
+            const std::string_view v1 = nextToken(rest);
+            const std::string_view v2 = nextToken(rest);
 
             Texture t;
-            t.s = std::stof(std::string(v1));
-            t.t = std::stof(std::string(v2));
+            t.s = toFloat(v1);
+            t.t = toFloat(v2);
             texCoords.push_back(t);
         }
         else if (first == "f") {
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
+            const std::string_view f1 = nextToken(rest);
+            const std::string_view f2 = nextToken(rest);
+            const std::string_view f3 = nextToken(rest);
+            if (f2.empty() || f3.empty()) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
                 throw Error(
@@ -145,37 +126,14 @@ Buffer generateOBJMesh(const std::filesystem::path& path) {
                     )
                 );
             }
-            const std::string_view f1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::OBJ, 2035,
-                    std::format(
-                        "Illegal face format in OBJ file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view f2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            const std::string_view f3 =
-                sep == std::string_view::npos ?
-                rest :
-                rest.substr(0, sep);
 
-            // The face description might just consist of a single value, in which case
-            // the f.find method will return npos, which tells substr to "extract" the
-            // entire string -> et voila; it still works
+            // The face description might consist of the position index followed by the
+            // texture and normal indices, separated by slashes. The conversion stops at
+            // the first slash, so only the position index is read
             Face f;
-            f.f1 = std::stoi(std::string(f1.substr(0, f1.find('/'))));
-            f.f2 = std::stoi(std::string(f2.substr(0, f2.find('/'))));
-            f.f3 = std::stoi(std::string(f3.substr(0, f3.find('/'))));
+            f.f1 = toInt(f1);
+            f.f2 = toInt(f2);
+            f.f3 = toInt(f3);
             faces.emplace_back(f);
         }
         else if (first == "vn") {
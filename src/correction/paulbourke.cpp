@@ -15,18 +15,19 @@
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
 #include <sgct/window.h>
+#include <sgct/correction/mappedfile.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
 #include <scn/scan.h>
-#include <fstream>
+#include <memory>
 
 namespace sgct::correction {
 
-Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos,
-                              const vec2& size, float aspectRatio)
-{
+WarpGrid readPaulBourkeGrid(const std::filesystem::path& path) {
     ZoneScoped;
 
-    Buffer buf;
+    WarpGrid grid;
+    grid.model = WarpGrid::Model::PaulBourke;
 
     // @TODO: Remove `.string()` as soon as Clang on MacOS supports
     // formatting std::filesystem::path
@@ -34,8 +35,8 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
         "Reading Paul Bourke spherical mirror mesh from '{}'", path.string()
     ));
 
-    std::ifstream meshFile = std::ifstream(path);
-    if (!meshFile.good()) {
+    std::unique_ptr<MappedFile> meshFile = MappedFile::map(path);
+    if (!meshFile) {
         // @TODO: Remove `.string()` as soon as Clang on MacOS supports
         // formatting std::filesystem::path
         throw Error(
@@ -44,10 +45,11 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
         );
     }
 
-    std::string line;
+    LineReader lines = LineReader(meshFile->text());
+    std::string_view line;
 
     // get the first line containing the mapping type _id
-    if (std::getline(meshFile, line)) {
+    if (lines.next(line)) {
         auto r = scn::scan_value<int>(line);
         if (!r) {
             // @TODO: Remove `.string()` as soon as Clang on MacOS supports
@@ -61,7 +63,7 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
 
     // get the mesh dimensions
     std::optional<glm::ivec2> meshSize;
-    if (std::getline(meshFile, line)) {
+    if (lines.next(line)) {
         auto r = scn::scan<int, int>(line, "{} {}");
         if (!r) {
             // @TODO: Remove `.string()` as soon as Clang on MacOS supports
@@ -72,28 +74,16 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
             );
         }
         const auto& [valX, valY] = r->values();
-        buf.vertices.reserve(static_cast<size_t>(valX) * static_cast<size_t>(valY));
+        grid.points.reserve(static_cast<size_t>(valX) * static_cast<size_t>(valY));
         meshSize = glm::ivec2(valX, valY);
     }
 
     // get all data
-    while (std::getline(meshFile, line)) {
+    while (lines.next(line)) {
         auto r = scn::scan<float, float, float, float, float>(line, "{} {} {} {} {}");
         if (r) {
             const auto& [x, y, s, t, intensity] = r->values();
-
-            Buffer::Vertex vertex;
-            vertex.x = x;
-            vertex.y = y;
-            vertex.s = s;
-            vertex.t = t;
-
-            vertex.r = intensity;
-            vertex.g = intensity;
-            vertex.b = intensity;
-            vertex.a = 1.f;
-
-            buf.vertices.push_back(vertex);
+            grid.points.push_back({ x, y, s, t, intensity });
         }
     }
 
@@ -106,35 +96,24 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
             const int i3 = (r + 1) * meshSize->x + c;
 
             // triangle 1
-            buf.indices.push_back(i0);
-            buf.indices.push_back(i1);
-            buf.indices.push_back(i2);
+            grid.indices.push_back(i0);
+            grid.indices.push_back(i1);
+            grid.indices.push_back(i2);
 
             // triangle 2
-            buf.indices.push_back(i0);
-            buf.indices.push_back(i2);
-            buf.indices.push_back(i3);
+            grid.indices.push_back(i0);
+            grid.indices.push_back(i2);
+            grid.indices.push_back(i3);
         }
     }
 
-    const float aspect = aspectRatio * (size.x / size.y);
-    for (Buffer::Vertex& vertex : buf.vertices) {
-        // convert to [0, 1] (normalize)
-        vertex.x /= aspect;
-        vertex.x = (vertex.x + 1.f) / 2.f;
-        vertex.y = (vertex.y + 1.f) / 2.f;
-
-        // scale, re-position and convert to [-1, 1]
-        vertex.x = (vertex.x * size.x + pos.x) * 2.f - 1.f;
-        vertex.y = (vertex.y * size.y + pos.y) * 2.f - 1.f;
-
-        // convert to viewport coordinates
-        vertex.s = vertex.s * size.x + pos.x;
-        vertex.t = vertex.t * size.y + pos.y;
-    }
+    return grid;
+}
 
-    buf.geometryType = GL_TRIANGLES;
-    return buf;
+Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos,
+                              const vec2& size, float aspectRatio)
+{
+    return generateWarpGridMesh(readPaulBourkeGrid(path), pos, size, aspectRatio);
 }
 
 } // namespace sgct::correction
@@ -9,17 +9,19 @@
 #include <sgct/correction/scalable.h>
 
 #include <sgct/baseviewport.h>
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
 #include <sgct/user.h>
+#include <sgct/correction/mappedfile.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <fstream>
+#include <memory>
+#include <stdexcept>
 
 namespace {
     struct Data {
@@ -103,8 +105,8 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
     // formatting std::filesystem::path
     Log::Info(std::format("Reading scalable mesh data from '{}'", path.string()));
 
-    std::ifstream file = std::ifstream(path);
-    if (!file.good()) {
+    std::unique_ptr<MappedFile> file = MappedFile::map(path);
+    if (!file) {
         // @TODO: Remove `.string()` as soon as Clang on MacOS supports
         // formatting std::filesystem::path
         throw Error(
@@ -115,19 +117,19 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
     }
 
     Data data;
-    std::string line;
-    while (std::getline(file, line)) {
+    LineReader lines = LineReader(file->text());
+    std::string_view line;
+    while (lines.next(line)) {
         if (line.empty()) {
             continue;
         }
-        else if (line.back() == '\r') {
-            line.pop_back();
-        }
 
-        const std::string_view v = line;
-        const size_t separator = v.find(' ');
-        std::string_view first = v.substr(0, separator);
-        std::string_view rest = v.substr(separator + 1);
+        const size_t separator = line.find(' ');
+        const std::string_view first = line.substr(0, separator);
+        std::string_view rest =
+            separator == std::string_view::npos ?
+            std::string_view() :
+            line.substr(separator + 1);
 
         if (first == "OPENMESH") {
             if (rest != "Version 1.1") {
@@ -140,11 +142,11 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "VERTICES") {
-            data.nVertices = std::stoi(std::string(rest));
+            data.nVertices = toInt(rest);
             data.vertices.reserve(data.nVertices);
         }
         else if (first == "FACES") {
-            data.nFaces = std::stoi(std::string(rest));
+            data.nFaces = toInt(rest);
             data.faces.reserve(data.nFaces);
         }
         else if (first == "MAPPING") {
@@ -178,62 +180,62 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "ORTHO_LEFT") {
-            data.ortho.left = std::stof(std::string(rest));
+            data.ortho.left = toFloat(rest);
         }
         else if (first == "ORTHO_RIGHT") {
-            data.ortho.right = std::stof(std::string(rest));
+            data.ortho.right = toFloat(rest);
         }
         else if (first == "ORTHO_TOP") {
-            data.ortho.top = std::stof(std::string(rest));
+            data.ortho.top = toFloat(rest);
         }
         else if (first == "ORTHO_BOTTOM") {
-            data.ortho.bottom = std::stof(std::string(rest));
+            data.ortho.bottom = toFloat(rest);
         }
         else if (first == "PERSPECTIVE_XOFFSET") {
-            data.perspective.offset.x = std::stof(std::string(rest));
+            data.perspective.offset.x = toFloat(rest);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_YOFFSET") {
-            data.perspective.offset.y = std::stof(std::string(rest));
+            data.perspective.offset.y = toFloat(rest);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_ZOFFSET") {
-            data.perspective.offset.z = std::stof(std::string(rest));
+            data.perspective.offset.z = toFloat(rest);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_ROLL") {
-            data.perspective.direction.roll = std::stof(std::string(rest));
+            data.perspective.direction.roll = toFloat(rest);
         }
         else if (first == "PERSPECTIVE_PITCH") {
-            data.perspective.direction.pitch = std::stof(std::string(rest));
+            data.perspective.direction.pitch = toFloat(rest);
         }
         else if (first == "PERSPECTIVE_YAW") {
-            data.perspective.direction.yaw = std::stof(std::string(rest));
+            data.perspective.direction.yaw = toFloat(rest);
         }
         else if (first == "PERSPECTIVE_LEFT") {
-            data.perspective.fov.left = std::stof(std::string(rest));
+            data.perspective.fov.left = toFloat(rest);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_RIGHT") {
-            data.perspective.fov.right = std::stof(std::string(rest));
+            data.perspective.fov.right = toFloat(rest);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_TOP") {
-            data.perspective.fov.top = std::stof(std::string(rest));
+            data.perspective.fov.top = toFloat(rest);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_BOTTOM") {
-            data.perspective.fov.bottom = std::stof(std::string(rest));
+            data.perspective.fov.bottom = toFloat(rest);
             data.perspective.hasFov = true;
         }
         else if (first == "NATIVEXRES") {
-            data.resolution.x = std::stoi(std::string(rest));
+            data.resolution.x = toInt(rest);
         }
         else if (first == "NATIVEYRES") {
-            data.resolution.y = std::stoi(std::string(rest));
+            data.resolution.y = toInt(rest);
         }
         else if (first == "SUBVERSION") {
-            const int version = std::stoi(std::string(rest));
+            const int version = toInt(rest);
             if (version != 5) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -244,7 +246,7 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "GAMMA") {
-            const float gamma = std::stof(std::string(rest));
+            const float gamma = toFloat(rest);
             if (gamma != data.gamma) {
                 data.gamma = gamma;
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
@@ -256,10 +258,10 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "DO_NO_WARP") {
-            data.doNotWarp = std::stoi(std::string(rest)) != 0;
+            data.doNotWarp = toInt(rest) != 0;
         }
         else if (first == "USE_SPHERE_SAMPLE_COORDINATE_SYSTEM") {
-            const bool useSphereSampling = std::stoi(std::string(rest)) != 0;
+            const bool useSphereSampling = toInt(rest) != 0;
             if (useSphereSampling) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -270,7 +272,7 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "FRUSTUM_EULER_ANGLES") {
-            data.frustumEulerAngles.useAngles = std::stoi(std::string(rest)) != 0;
+            data.frustumEulerAngles.useAngles = toInt(rest) != 0;
             if (data.frustumEulerAngles.useAngles) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -281,19 +283,19 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "FRUSTUM_EULER_YAW") {
-            data.frustumEulerAngles.yaw = std::stof(std::string(rest));
+            data.frustumEulerAngles.yaw = toFloat(rest);
         }
         else if (first == "FRUSTUM_EULER_PITCH") {
-            data.frustumEulerAngles.pitch = std::stof(std::string(rest));
+            data.frustumEulerAngles.pitch = toFloat(rest);
         }
         else if (first == "FRUSTUM_EULER_ROLL") {
-            data.frustumEulerAngles.roll = std::stof(std::string(rest));
+            data.frustumEulerAngles.roll = toFloat(rest);
         }
         else if (first == "LABEL") {
             data.label = std::string(rest);
         }
         else if (first == "APPLY_MASK") {
-            data.applyMask = std::stoi(std::string(rest)) != 0;
+            data.applyMask = toInt(rest) != 0;
             if (data.applyMask) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -305,7 +307,7 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "APPLY_BLACK_LEVEL") {
-            data.applyBlackLevel = std::stoi(std::string(rest)) != 0;
+            data.applyBlackLevel = toInt(rest) != 0;
             if (data.applyBlackLevel) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -317,7 +319,7 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             }
         }
         else if (first == "APPLY_COLOR") {
-            data.applyColor = std::stoi(std::string(rest)) != 0;
+            data.applyColor = toInt(rest) != 0;
             if (data.applyBlackLevel) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
@@ -330,38 +332,10 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
         }
         else if (first == "[") {
             // Face
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::Scalable, 2035,
-                    std::format(
-                        "Illegal formatting of face in file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view f1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::Scalable, 2035,
-                    std::format(
-                        "Illegal formatting of face in file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view f2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
+            const std::string_view f1 = nextToken(rest);
+            const std::string_view f2 = nextToken(rest);
+            const std::string_view f3 = nextToken(rest);
+            if (f3.empty() || rest.empty()) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
                 throw Error(
@@ -372,12 +346,11 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
                     )
                 );
             }
-            const std::string_view f3 = rest.substr(0, sep);
 
             Data::Face f;
-            f.f1 = static_cast<unsigned int>(std::stoi(std::string(f1)));
-            f.f2 = static_cast<unsigned int>(std::stoi(std::string(f2)));
-            f.f3 = static_cast<unsigned int>(std::stoi(std::string(f3)));
+            f.f1 = static_cast<unsigned int>(toInt(f1));
+            f.f2 = static_cast<unsigned int>(toInt(f2));
+            f.f3 = static_cast<unsigned int>(toInt(f3));
             data.faces.push_back(f);
         }
         else {
@@ -385,7 +358,7 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             try {
                 // We try to convert the first value into a float.  If it succeeds, we
                 // have reached the vertices.  Otherwise we have found an unknown key
-                [[maybe_unused]] const float dummy = std::stof(std::string(first));
+                [[maybe_unused]] const float dummy = toFloat(first);
             }
             catch (const std::invalid_argument&) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
@@ -400,53 +373,11 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
 
 
             const std::string_view x = first;
-
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view y = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view intensity = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                // @TODO: Remove `.string()` as soon as Clang on MacOS supports
-                // formatting std::filesystem::path
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path.string(), line
-                    )
-                );
-            }
-            const std::string_view s = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
+            const std::string_view y = nextToken(rest);
+            const std::string_view intensity = nextToken(rest);
+            const std::string_view s = nextToken(rest);
+            const std::string_view t = nextToken(rest);
+            if (t.empty()) {
                 // @TODO: Remove `.string()` as soon as Clang on MacOS supports
                 // formatting std::filesystem::path
                 throw Error(
@@ -457,14 +388,13 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
                     )
                 );
             }
-            const std::string_view t = rest.substr(0, sep);
 
             Data::Vertex vertex;
-            vertex.x = std::stof(std::string(x));
-            vertex.y = std::stof(std::string(y));
-            vertex.intensity = std::stoi(std::string(intensity));
-            vertex.s = std::stof(std::string(s));
-            vertex.t = std::stof(std::string(t));
+            vertex.x = toFloat(x);
+            vertex.y = toFloat(y);
+            vertex.intensity = toInt(intensity);
+            vertex.s = toFloat(s);
+            vertex.t = toFloat(t);
             data.vertices.push_back(vertex);
         }
     }
@@ -486,7 +416,6 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             data.perspective.fov.right,
             quat(q.x, q.y, q.z, q.w)
         );
-        Engine::instance().updateFrustums();
     }
     if (data.perspective.hasOffset) {
         parent.projectionPlane().offset(
@@ -8,7 +8,6 @@
 
 #include <sgct/correction/sciss.h>
 
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
@@ -183,7 +182,6 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
         quat{ viewData.qx, viewData.qy, viewData.qz, viewData.qw }
     );
 
-    Engine::instance().updateFrustums();
 
     buf.vertices.resize(nVertices);
     for (unsigned int i = 0; i < nVertices; i++) {
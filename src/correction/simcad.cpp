@@ -15,21 +15,15 @@
 #include <sgct/profiling.h>
 #include <sgct/tinyxml.h>
 #include <sgct/viewport.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
-#include <sstream>
+#include <string_view>
 
 #define Error(code, msg) Error(Error::Component::SimCAD, code, msg)
 
 namespace {
-    std::vector<std::string> split(std::string str, char delimiter) {
-        std::vector<std::string> res;
-        std::stringstream ss(std::move(str));
-        std::string part;
-        while (std::getline(ss, part, delimiter)) {
-            res.push_back(part);
-        }
-        return res;
-    }
+    // The values in the parameter lists can be separated by spaces and line breaks
+    constexpr std::string_view Whitespace = " \t\r\n";
 } // namespace
 
 namespace sgct::correction {
@@ -94,20 +88,22 @@ Buffer generateSimCADMesh(const std::filesystem::path& path, const vec2& pos,
         if (childVal == "X-FlatParameters") {
             float xrange = 1.f;
             if (child->QueryFloatAttribute("range", &xrange) == XML_SUCCESS) {
-                const std::string xcoordstr(child->GetText());
-                const std::vector<std::string> xcoords = split(xcoordstr, ' ');
-                for (const std::string& x : xcoords) {
-                    xcorrections.push_back(std::stof(x) / xrange);
+                std::string_view xcoords = child->GetText();
+                std::string_view x = nextToken(xcoords, Whitespace);
+                while (!x.empty()) {
+                    xcorrections.push_back(toFloat(x) / xrange);
+                    x = nextToken(xcoords, Whitespace);
                 }
             }
         }
         else if (childVal == "Y-FlatParameters") {
             float yrange = 1.f;
             if (child->QueryFloatAttribute("range", &yrange) == XML_SUCCESS) {
-                const std::string ycoordstr(child->GetText());
-                const std::vector<std::string> ycoords = split(ycoordstr, ' ');
-                for (const std::string& y : ycoords) {
-                    ycorrections.push_back(std::stof(y) / yrange);
+                std::string_view ycoords = child->GetText();
+                std::string_view y = nextToken(ycoords, Whitespace);
+                while (!y.empty()) {
+                    ycorrections.push_back(toFloat(y) / yrange);
+                    y = nextToken(ycoords, Whitespace);
                 }
             }
         }
@@ -0,0 +1,476 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/simplify.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sgct::correction {
+
+namespace {
+    // The largest deviation of the interpolated colors, which is below the precision of
+    // an 8-bit framebuffer and keeps the blending of the mesh unchanged
+    constexpr float ColorTolerance = 1.f / 255.f;
+
+    // How far outside of a triangle a point can lie in barycentric coordinates to still
+    // count as inside, which accepts the points on the edges between the triangles
+    constexpr float Epsilon = 1e-5f;
+
+    // The number of vertices that the post-transform cache is assumed to hold
+    constexpr int CacheSize = 16;
+
+    constexpr float Invalid = std::numeric_limits<float>::infinity();
+
+    using Triangle = std::array<unsigned int, 3>;
+
+    std::vector<Triangle> triangles(const Buffer& buffer) {
+        const std::vector<unsigned int>& indices = buffer.indices;
+
+        std::vector<Triangle> res;
+        if (buffer.geometryType == GL_TRIANGLE_STRIP) {
+            res.reserve(indices.size());
+            for (size_t i = 0; i + 2 < indices.size(); i++) {
+                Triangle t = { indices[i], indices[i + 1], indices[i + 2] };
+                // Every other triangle of a strip has the opposite winding order
+                if (i % 2 == 1) {
+                    std::swap(t[0], t[1]);
+                }
+                // Strips use degenerate triangles to jump between rows
+                if (t[0] != t[1] && t[1] != t[2] && t[0] != t[2]) {
+                    res.push_back(t);
+                }
+            }
+        }
+        else {
+            res.reserve(indices.size() / 3);
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                res.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+            }
+        }
+        return res;
+    }
+
+    float signedArea(const Buffer::Vertex& a, const Buffer::Vertex& b,
+                     const Buffer::Vertex& c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    }
+
+    class Simplifier {
+    public:
+        Simplifier(const Buffer& buffer, float tolerance, ivec2 resolution);
+
+        // Collapses edges until none of the remaining collapses is within the tolerance
+        void run();
+
+        std::vector<unsigned int> indices() const;
+
+    private:
+        struct Face {
+            Triangle vertices;
+            // The orientation of the original triangle, which a collapse must not flip
+            bool isCounterClockwise = false;
+            bool isAlive = true;
+            // The removed vertices that lie inside this triangle
+            std::vector<unsigned int> removed;
+        };
+
+        struct Candidate {
+            unsigned int face;
+            Triangle vertices;
+        };
+
+        // Returns the largest deviation that is caused by moving vertex u onto its
+        // neighbor v, or Invalid if the collapse is not allowed or the deviation exceeds
+        // the bound. Also fills _candidates with the resulting triangles and _points with
+        // the affected removed vertices
+        float collapseError(unsigned int u, unsigned int v, float bound);
+
+        // Applies the collapse that was evaluated by the last call to collapseError
+        void collapse(unsigned int u, unsigned int v);
+
+        // Returns the deviation of the interpolated values at the vertex p, or
+        // std::nullopt if p does not lie inside of the triangle t
+        std::optional<float> deviation(unsigned int p, const Triangle& t) const;
+
+        const std::vector<Buffer::Vertex>& _vertices;
+        const float _tolerance;
+        const vec2 _resolution;
+
+        std::vector<Face> _faces;
+        std::vector<std::vector<unsigned int>> _vertexFaces;
+        std::vector<bool> _isLocked;
+
+        std::vector<Candidate> _candidates;
+        std::vector<unsigned int> _points;
+    };
+
+    Simplifier::Simplifier(const Buffer& buffer, float tolerance, ivec2 resolution)
+        : _vertices(buffer.vertices)
+        , _tolerance(tolerance)
+        , _resolution(static_cast<float>(resolution.x), static_cast<float>(resolution.y))
+        , _vertexFaces(buffer.vertices.size())
+        , _isLocked(buffer.vertices.size(), false)
+    {
+        ZoneScoped;
+
+        const std::vector<Triangle> tris = triangles(buffer);
+        _faces.reserve(tris.size());
+        std::vector<uint64_t> edges;
+        edges.reserve(tris.size() * 3);
+        for (const Triangle& t : tris) {
+            Face face;
+            face.vertices = t;
+            const Buffer::Vertex& a = _vertices[t[0]];
+            const Buffer::Vertex& b = _vertices[t[1]];
+            const Buffer::Vertex& c = _vertices[t[2]];
+            face.isCounterClockwise = signedArea(a, b, c) > 0.f;
+            for (int i = 0; i < 3; i++) {
+                _vertexFaces[t[i]].push_back(static_cast<unsigned int>(_faces.size()));
+
+                const uint64_t v0 = std::min(t[i], t[(i + 1) % 3]);
+                const uint64_t v1 = std::max(t[i], t[(i + 1) % 3]);
+                edges.push_back((v0 << 32) | v1);
+            }
+            _faces.push_back(std::move(face));
+        }
+
+        // Edges that are not shared by exactly two triangles are on the border of the
+        // mesh, whose vertices are kept so that the outline of the mesh is unchanged
+        std::sort(edges.begin(), edges.end());
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j] == edges[i]) {
+                j++;
+            }
+            if (j - i != 2) {
+                _isLocked[edges[i] >> 32] = true;
+                _isLocked[edges[i] & 0xFFFFFFFF] = true;
+            }
+            i = j;
+        }
+    }
+
+    void Simplifier::run() {
+        ZoneScoped;
+
+        std::vector<unsigned int> neighbors;
+        bool hasChanged = true;
+        while (hasChanged) {
+            hasChanged = false;
+            for (unsigned int u = 0; u < _vertices.size(); u++) {
+                if (_isLocked[u] || _vertexFaces[u].empty()) {
+                    continue;
+                }
+
+                neighbors.clear();
+                for (unsigned int f : _vertexFaces[u]) {
+                    if (!_faces[f].isAlive) {
+                        continue;
+                    }
+                    for (unsigned int w : _faces[f].vertices) {
+                        if (w != u &&
+                            std::find(neighbors.begin(), neighbors.end(), w) ==
+                            neighbors.end())
+                        {
+                            neighbors.push_back(w);
+                        }
+                    }
+                }
+
+                float bestError = Invalid;
+                unsigned int best = 0;
+                for (unsigned int w : neighbors) {
+                    const float error =
+                        collapseError(u, w, std::min(bestError, _tolerance));
+                    if (error < bestError) {
+                        bestError = error;
+                        best = w;
+                    }
+                }
+
+                if (bestError <= _tolerance) {
+                    collapseError(u, best, _tolerance);
+                    collapse(u, best);
+                    hasChanged = true;
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> Simplifier::indices() const {
+        std::vector<unsigned int> res;
+        for (const Face& face : _faces) {
+            if (face.isAlive) {
+                res.insert(res.end(), face.vertices.begin(), face.vertices.end());
+            }
+        }
+        return res;
+    }
+
+    float Simplifier::collapseError(unsigned int u, unsigned int v, float bound) {
+        _candidates.clear();
+        _points.clear();
+        _points.push_back(u);
+        for (unsigned int f : _vertexFaces[u]) {
+            const Face& face = _faces[f];
+            if (!face.isAlive) {
+                continue;
+            }
+            _points.insert(_points.end(), face.removed.begin(), face.removed.end());
+
+            // The triangles that contain both vertices disappear with the collapse
+            const Triangle& t = face.vertices;
+            if (t[0] == v || t[1] == v || t[2] == v) {
+                continue;
+            }
+
+            Triangle n = t;
+            std::replace(n.begin(), n.end(), u, v);
+            const float area = signedArea(_vertices[n[0]], _vertices[n[1]], _vertices[n[2]]);
+            if (area == 0.f || (area > 0.f) != face.isCounterClockwise) {
+                return Invalid;
+            }
+            _candidates.push_back({ f, n });
+        }
+
+        // The removed vertices have to be reproduced by the remaining triangles, which
+        // bounds the error of the simplified mesh compared to the original one
+        float error = 0.f;
+        for (unsigned int p : _points) {
+            std::optional<float> d;
+            for (const Candidate& c : _candidates) {
+                d = deviation(p, c.vertices);
+                if (d.has_value()) {
+                    break;
+                }
+            }
+            if (!d.has_value()) {
+                return Invalid;
+            }
+            error = std::max(error, *d);
+            if (error > bound) {
+                return Invalid;
+            }
+        }
+        return error;
+    }
+
+    void Simplifier::collapse(unsigned int u, unsigned int v) {
+        for (unsigned int f : _vertexFaces[u]) {
+            Face& face = _faces[f];
+            face.removed.clear();
+            const Triangle& t = face.vertices;
+            if (t[0] == v || t[1] == v || t[2] == v) {
+                face.isAlive = false;
+            }
+        }
+
+        for (const Candidate& c : _candidates) {
+            _faces[c.face].vertices = c.vertices;
+            _vertexFaces[v].push_back(c.face);
+        }
+        std::erase_if(
+            _vertexFaces[v],
+            [this](unsigned int f) { return !_faces[f].isAlive; }
+        );
+
+        for (unsigned int p : _points) {
+            for (const Candidate& c : _candidates) {
+                if (deviation(p, c.vertices).has_value()) {
+                    _faces[c.face].removed.push_back(p);
+                    break;
+                }
+            }
+        }
+
+        _vertexFaces[u].clear();
+    }
+
+    std::optional<float> Simplifier::deviation(unsigned int p, const Triangle& t) const {
+        const Buffer::Vertex& a = _vertices[t[0]];
+        const Buffer::Vertex& b = _vertices[t[1]];
+        const Buffer::Vertex& c = _vertices[t[2]];
+        const Buffer::Vertex& q = _vertices[p];
+
+        const float area = signedArea(a, b, c);
+        const float wa = signedArea(q, b, c) / area;
+        const float wb = signedArea(a, q, c) / area;
+        const float wc = 1.f - wa - wb;
+        if (wa < -Epsilon || wb < -Epsilon || wc < -Epsilon) {
+            return std::nullopt;
+        }
+
+        auto error = [&](float Buffer::Vertex::* m) {
+            return wa * a.*m + wb * b.*m + wc * c.*m - q.*m;
+        };
+        if (std::abs(error(&Buffer::Vertex::r)) > ColorTolerance ||
+            std::abs(error(&Buffer::Vertex::g)) > ColorTolerance ||
+            std::abs(error(&Buffer::Vertex::b)) > ColorTolerance ||
+            std::abs(error(&Buffer::Vertex::a)) > ColorTolerance)
+        {
+            return Invalid;
+        }
+        return std::hypot(
+            error(&Buffer::Vertex::s) * _resolution.x,
+            error(&Buffer::Vertex::t) * _resolution.y
+        );
+    }
+
+    // Reorders the triangles with the Tipsify algorithm (Sander et al., "Fast
+    // Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007), which fans
+    // around vertices that are still in the cache and have few triangles left
+    std::vector<unsigned int> optimizeVertexCache(std::span<const unsigned int> indices,
+                                                  size_t nVertices)
+    {
+        ZoneScoped;
+
+        if (indices.empty()) {
+            return std::vector<unsigned int>();
+        }
+
+        // The triangles that use each vertex, stored consecutively per vertex
+        const size_t nTriangles = indices.size() / 3;
+        std::vector<unsigned int> offsets(nVertices + 1, 0);
+        for (unsigned int i : indices) {
+            offsets[i + 1]++;
+        }
+        for (size_t i = 0; i < nVertices; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<unsigned int> adjacency(indices.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < nTriangles; t++) {
+            for (size_t k = 0; k < 3; k++) {
+                adjacency[fill[indices[3 * t + k]]++] = static_cast<unsigned int>(t);
+            }
+        }
+
+        std::vector<int> nLive(nVertices);
+        for (size_t i = 0; i < nVertices; i++) {
+            nLive[i] = static_cast<int>(offsets[i + 1] - offsets[i]);
+        }
+        std::vector<int> cacheTime(nVertices, 0);
+        std::vector<bool> isEmitted(nTriangles, false);
+        std::vector<unsigned int> deadEnd;
+        std::vector<unsigned int> candidates;
+
+        std::vector<unsigned int> res;
+        res.reserve(indices.size());
+        int time = CacheSize + 1;
+        size_t cursor = 0;
+        std::optional<unsigned int> fanning = indices[0];
+        while (fanning.has_value()) {
+            candidates.clear();
+            for (unsigned int i = offsets[*fanning]; i < offsets[*fanning + 1]; i++) {
+                const unsigned int t = adjacency[i];
+                if (isEmitted[t]) {
+                    continue;
+                }
+                for (size_t k = 0; k < 3; k++) {
+                    const unsigned int v = indices[3 * t + k];
+                    res.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    nLive[v]--;
+                    if (time - cacheTime[v] > CacheSize) {
+                        cacheTime[v] = time;
+                        time++;
+                    }
+                }
+                isEmitted[t] = true;
+            }
+
+            // Prefer the vertex that has been in the cache for the longest time and that
+            // will still be in the cache after its remaining triangles have been emitted
+            fanning = std::nullopt;
+            int bestPriority = -1;
+            for (unsigned int v : candidates) {
+                if (nLive[v] <= 0) {
+                    continue;
+                }
+                int priority = 0;
+                if (time - cacheTime[v] + 2 * nLive[v] <= CacheSize) {
+                    priority = time - cacheTime[v];
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    fanning = v;
+                }
+            }
+
+            while (!fanning.has_value() && !deadEnd.empty()) {
+                const unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (nLive[v] > 0) {
+                    fanning = v;
+                }
+            }
+            while (!fanning.has_value() && cursor < nVertices) {
+                if (nLive[cursor] > 0) {
+                    fanning = static_cast<unsigned int>(cursor);
+                }
+                cursor++;
+            }
+        }
+        return res;
+    }
+} // namespace
+
+Buffer optimizeVertexOrder(std::span<const Buffer::Vertex> vertices,
+                           std::span<const unsigned int> indices)
+{
+    ZoneScoped;
+
+    const std::vector<unsigned int> order = optimizeVertexCache(indices, vertices.size());
+
+    // Stores the vertices in the order in which they are first used, which makes the
+    // vertex fetches of the GPU as sequential as the indices allow. Vertices that are not
+    // used by any triangle are dropped
+    constexpr unsigned int Unused = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> remap(vertices.size(), Unused);
+    Buffer res;
+    res.geometryType = GL_TRIANGLES;
+    res.indices.reserve(order.size());
+    for (unsigned int i : order) {
+        if (remap[i] == Unused) {
+            remap[i] = static_cast<unsigned int>(res.vertices.size());
+            res.vertices.push_back(vertices[i]);
+        }
+        res.indices.push_back(remap[i]);
+    }
+    return res;
+}
+
+Buffer simplifyMesh(const Buffer& buffer, float tolerance, ivec2 resolution) {
+    ZoneScoped;
+
+    Simplifier simplifier = Simplifier(buffer, tolerance, resolution);
+    simplifier.run();
+    const Buffer res = optimizeVertexOrder(buffer.vertices, simplifier.indices());
+
+    Log::Debug(std::format(
+        "Simplified correction mesh from {} to {} vertices and from {} to {} indices",
+        buffer.vertices.size(), res.vertices.size(),
+        buffer.indices.size(), res.indices.size()
+    ));
+    return res;
+}
+
+} // namespace sgct::correction
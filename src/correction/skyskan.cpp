@@ -8,7 +8,6 @@
 
 #include <sgct/correction/skyskan.h>
 
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
@@ -16,11 +15,13 @@
 #include <sgct/profiling.h>
 #include <sgct/viewport.h>
 #include <sgct/user.h>
+#include <sgct/correction/mappedfile.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <scn/scan.h>
-#include <fstream>
+#include <memory>
 #include <optional>
 
 #define Error(code, msg) sgct::Error(sgct::Error::Component::SkySkan, code, msg)
@@ -36,8 +37,8 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
     // formatting std::filesystem::path
     Log::Info(std::format("Reading SkySkan mesh data from '{}'", path.string()));
 
-    std::ifstream meshFile = std::ifstream(path);
-    if (!meshFile.good()) {
+    std::unique_ptr<MappedFile> meshFile = MappedFile::map(path);
+    if (!meshFile) {
         // @TODO: Remove `.string()` as soon as Clang on MacOS supports
         // formatting std::filesystem::path
         throw Error(2090, std::format("Failed to open file '{}'", path.string()));
@@ -55,39 +56,40 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
     unsigned int sizeY = 0;
     unsigned int counter = 0;
 
-    std::string line;
-    while (std::getline(meshFile, line)) {
+    LineReader lines = LineReader(meshFile->text());
+    std::string_view line;
+    while (lines.next(line)) {
         if (auto r = scn::scan<float>(line, "Dome Azimuth={}");  r) {
             azimuth = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "Dome Elevation={}");  r) {
             elevation = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "Horizontal FOV={}");  r) {
             hFov = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "Vertical FOV={}");  r) {
             vFov = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "Horizontal Tweak={}");  r) {
             fovTweaks.x = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "Vertical Tweak={}");  r) {
             fovTweaks.y = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "U Tweak={}");  r) {
             uvTweaks.x = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<float>(line, "V Tweak={}");  r) {
             uvTweaks.y = r->value();
-            break;
+            continue;
         }
         if (auto r = scn::scan<unsigned int, unsigned int>(line, "{} {}");
             r && !areDimsSet)
@@ -95,10 +97,10 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
             areDimsSet = true;
             std::tie(sizeX, sizeY) = r->values();
             buf.vertices.resize(static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY));
-            break;
+            continue;
         }
         if (auto r = scn::scan<float, float, float, float>(line, "{} {} {} {}");
-            r && areDimsSet)
+            r && areDimsSet && counter < buf.vertices.size())
         {
             auto& [x, y, u, v] = r->values();
             if (uvTweaks.x > -1.f) {
@@ -119,7 +121,6 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
             buf.vertices[counter].b = 1.f;
             buf.vertices[counter].a = 1.f;
             counter++;
-            break;
         }
     }
 
@@ -163,7 +164,6 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
         hHalf,
         quat(rotQuat.x, rotQuat.y, rotQuat.z, rotQuat.w)
     );
-    Engine::instance().updateFrustums();
 
     for (unsigned int c = 0; c < (sizeX - 1); c++) {
         for (unsigned int r = 0; r < (sizeY - 1); r++) {
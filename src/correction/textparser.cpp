@@ -0,0 +1,97 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/textparser.h>
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+    std::string_view trimNumber(std::string_view text) {
+        const size_t begin = text.find_first_not_of(" \t\n\v\f\r");
+        if (begin == std::string_view::npos) {
+            return std::string_view();
+        }
+        text.remove_prefix(begin);
+        // std::from_chars does not accept the leading plus sign that std::stof does
+        if (text.size() > 1 && text[0] == '+' && text[1] != '-') {
+            text.remove_prefix(1);
+        }
+        return text;
+    }
+
+    template <typename T>
+    T toNumber(std::string_view text, const char* function) {
+        const std::string_view number = trimNumber(text);
+        T value = T();
+        const std::from_chars_result res =
+            std::from_chars(number.data(), number.data() + number.size(), value);
+        if (res.ec == std::errc::invalid_argument) {
+            throw std::invalid_argument(std::string(function) + ": no conversion");
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range(std::string(function) + ": out of range");
+        }
+        return value;
+    }
+} // namespace
+
+namespace sgct::correction {
+
+LineReader::LineReader(std::string_view text)
+    : _text(text)
+{}
+
+bool LineReader::next(std::string_view& line) {
+    if (_text.empty()) {
+        return false;
+    }
+
+    // Searching for a single character is vectorized by the standard library, which makes
+    // this considerably faster than reading the lines with std::getline
+    const size_t end = _text.find('\n');
+    if (end == std::string_view::npos) {
+        line = _text;
+        _text = std::string_view();
+    }
+    else {
+        line = _text.substr(0, end);
+        _text.remove_prefix(end + 1);
+    }
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+std::string_view nextToken(std::string_view& text, std::string_view delimiters) {
+    const size_t begin = text.find_first_not_of(delimiters);
+    if (begin == std::string_view::npos) {
+        text = std::string_view();
+        return std::string_view();
+    }
+
+    text.remove_prefix(begin);
+    const size_t end = text.find_first_of(delimiters);
+    const std::string_view token = text.substr(0, end);
+    text.remove_prefix(token.size());
+    return token;
+}
+
+float toFloat(std::string_view text) {
+    return toNumber<float>(text, "toFloat");
+}
+
+int toInt(std::string_view text) {
+    return toNumber<int>(text, "toInt");
+}
+
+} // namespace sgct::correction
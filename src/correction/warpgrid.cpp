@@ -0,0 +1,86 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/warpgrid.h>
+
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+
+namespace sgct::correction {
+
+Buffer::Vertex evaluateWarpGrid(WarpGrid::Model model, const WarpGrid::Point& point,
+                                const vec2& pos, const vec2& size, float aspectRatio)
+{
+    Buffer::Vertex vertex;
+    vertex.a = 1.f;
+
+    switch (model) {
+        case WarpGrid::Model::PaulBourke:
+        {
+            // convert to [0, 1] (normalize)
+            const float aspect = aspectRatio * (size.x / size.y);
+            const float x = (point.x / aspect + 1.f) / 2.f;
+            const float y = (point.y + 1.f) / 2.f;
+
+            // scale, re-position and convert to [-1, 1]
+            vertex.x = (x * size.x + pos.x) * 2.f - 1.f;
+            vertex.y = (y * size.y + pos.y) * 2.f - 1.f;
+
+            // convert to viewport coordinates
+            vertex.s = point.s * size.x + pos.x;
+            vertex.t = point.t * size.y + pos.y;
+
+            vertex.r = point.intensity;
+            vertex.g = point.intensity;
+            vertex.b = point.intensity;
+            break;
+        }
+        case WarpGrid::Model::DomeProjection:
+        {
+            const float x = std::clamp(point.x, 0.f, 1.f);
+            const float y = std::clamp(point.y, 0.f, 1.f);
+
+            // convert to [-1, 1]
+            vertex.x = 2.f * (pos.x + x * size.x) - 1.f;
+
+            // (abock, 2019-08-30); I'm not sure why the y inversion happens
+            // here. It seems like a mistake, but who knows
+            vertex.y = 2.f * (pos.y + (1.f - y) * size.y) - 1.f;
+
+            // scale to viewport coordinates
+            vertex.s = pos.x + point.s * size.x;
+            vertex.t = pos.y + (1.f - point.t) * size.y;
+
+            // init to max intensity (opaque white)
+            vertex.r = 1.f;
+            vertex.g = 1.f;
+            vertex.b = 1.f;
+            break;
+        }
+    }
+    return vertex;
+}
+
+Buffer generateWarpGridMesh(const WarpGrid& grid, const vec2& pos, const vec2& size,
+                            float aspectRatio)
+{
+    ZoneScoped;
+
+    Buffer buf;
+    buf.vertices.reserve(grid.points.size());
+    for (const WarpGrid::Point& point : grid.points) {
+        const Buffer::Vertex v = evaluateWarpGrid(grid.model, point, pos, size, aspectRatio);
+        buf.vertices.push_back(v);
+    }
+    buf.indices = grid.indices;
+    buf.geometryType = GL_TRIANGLES;
+    return buf;
+}
+
+} // namespace sgct::correction
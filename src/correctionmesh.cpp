@@ -8,8 +8,10 @@
 
 #include <sgct/correctionmesh.h>
 
+#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
+#include <sgct/internalshaders.h>
 #include <sgct/log.h>
 #include <sgct/math.h>
 #include <sgct/opengl.h>
@@ -17,17 +19,30 @@
 #include <sgct/viewport.h>
 #include <sgct/window.h>
 #include <sgct/correction/domeprojection.h>
+#include <sgct/correction/meshcache.h>
 #include <sgct/correction/obj.h>
 #include <sgct/correction/paulbourke.h>
 #include <sgct/correction/pfm.h>
 #include <sgct/correction/scalable.h>
 #include <sgct/correction/sciss.h>
 #include <sgct/correction/simcad.h>
+#include <sgct/correction/simplify.h>
 #include <sgct/correction/skyskan.h>
 #include <sgct/projection/fisheye.h>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <utility>
 
 #define Error(c, msg) sgct::Error(sgct::Error::Component::CorrectionMesh, c, msg)
 
@@ -93,82 +108,651 @@ correction::Buffer setupSimpleMesh(const vec2& pos, const vec2& size) {
     return buff;
 }
 
+// The formats whose parsers only depend on the file and the parameters that are stored
+// in the key of the cache, but not on the state of the viewport or its user
+bool isCacheable(const std::filesystem::path& path) {
+    const std::filesystem::path ext = path.extension();
+    return ext == ".csv" || ext == ".obj" || ext == ".pfm" || ext == ".simcad" ||
+        ext == ".data";
+}
+
+correction::Buffer generateCacheableMesh(const std::filesystem::path& path,
+                                         const BaseViewport& parent,
+                                         bool textureRenderMode)
+{
+    using namespace correction;
+    const vec2& parentPos = parent.position();
+    const vec2& parentSize = parent.size();
+
+    if (path.extension() == ".csv") {
+        return generateDomeProjectionMesh(path, parentPos, parentSize);
+    }
+    else if (path.extension() == ".data") {
+        const float aspectRatio = parent.window().aspectRatio();
+        return generatePaulBourkeMesh(path, parentPos, parentSize, aspectRatio);
+    }
+    else if (path.extension() == ".obj") {
+        return generateOBJMesh(path);
+    }
+    else if (path.extension() == ".pfm") {
+        return generatePerEyeMeshFromPFMImage(
+            path,
+            parentPos,
+            parentSize,
+            textureRenderMode
+        );
+    }
+    else {
+        assert(path.extension() == ".simcad");
+        return generateSimCADMesh(path, parentPos, parentSize);
+    }
+}
+
+// Simplifies the mesh if a \p tolerance is set and reorders its triangles for the vertex
+// cache. Triangle strips without a tolerance are kept as they are, as their indices are
+// already in an order that reuses the previous vertices
+void optimize(correction::Buffer& buffer, const BaseViewport& parent,
+              std::optional<float> tolerance)
+{
+    if (buffer.vertices.empty()) {
+        return;
+    }
+
+    if (tolerance) {
+        const ivec2 res = parent.window().framebufferResolution();
+        buffer = correction::simplifyMesh(buffer, *tolerance, res);
+    }
+    else if (buffer.geometryType == GL_TRIANGLES) {
+        buffer = correction::optimizeVertexOrder(buffer.vertices, buffer.indices);
+    }
+}
+
+// The values other than the file that the meshes of the cacheable formats depend on
+std::vector<float> meshParameters(const std::filesystem::path& path,
+                                  const BaseViewport& parent, bool textureRenderMode,
+                                  std::optional<float> tolerance)
+{
+    std::vector<float> parameters = {
+        parent.position().x,
+        parent.position().y,
+        parent.size().x,
+        parent.size().y,
+        textureRenderMode ? 1.f : 0.f
+    };
+    if (path.extension() == ".data") {
+        parameters.push_back(parent.window().aspectRatio());
+    }
+    if (tolerance) {
+        // The tolerance is measured in pixels of the framebuffer
+        const ivec2 res = parent.window().framebufferResolution();
+        parameters.push_back(*tolerance);
+        parameters.push_back(static_cast<float>(res.x));
+        parameters.push_back(static_cast<float>(res.y));
+    }
+    return parameters;
+}
+
+// Identifies the meshes that are shared between the viewports. The resolution is part of
+// the key as the vertices are packed for the framebuffer that they are rendered into
+struct SharedMeshKey {
+    std::filesystem::path path;
+    std::filesystem::file_time_type writeTime;
+    std::vector<float> parameters;
+    ivec2 resolution;
+
+    auto operator<=>(const SharedMeshKey&) const = default;
+};
+
+// Maps the cache file of the mesh if it is enabled and valid. Otherwise the mesh is
+// parsed and optimized into the \p buffer and, if enabled, written to the cache file
+std::unique_ptr<correction::CachedMesh> readOrGenerateMesh(
+                                                        const std::filesystem::path& path,
+                                                               const BaseViewport& parent,
+                                                                   bool textureRenderMode,
+                                                           std::optional<float> tolerance,
+                                                               correction::Buffer& buffer)
+{
+    ZoneScoped;
+
+    if (!Engine::instance().settings().useCorrectionMeshCache) {
+        buffer = generateCacheableMesh(path, parent, textureRenderMode);
+        optimize(buffer, parent, tolerance);
+        return nullptr;
+    }
+
+    const std::vector<float> parameters =
+        meshParameters(path, parent, textureRenderMode, tolerance);
+    const uint64_t key = correction::meshCacheKey(path, parameters);
+
+    std::unique_ptr<correction::CachedMesh> mesh = correction::readMeshCache(path, key);
+    if (!mesh) {
+        buffer = generateCacheableMesh(path, parent, textureRenderMode);
+        optimize(buffer, parent, tolerance);
+        correction::writeMeshCache(path, key, buffer);
+    }
+    return mesh;
+}
+
+std::pair<vec2, vec2> textureBounds(
+                                     std::span<const correction::Buffer::Vertex> vertices)
+{
+    vec2 min = vec2{ vertices[0].s, vertices[0].t };
+    vec2 max = min;
+    for (const correction::Buffer::Vertex& v : vertices) {
+        min = vec2{ std::min(min.x, v.s), std::min(min.y, v.t) };
+        max = vec2{ std::max(max.x, v.s), std::max(max.y, v.t) };
+    }
+    return std::pair(min, max);
+}
+
+// The positions are in normalized device coordinates of the window, so the ratio of the
+// pixels and the texture coordinates that an edge of the mesh spans is the resolution
+// that the texture needs along that edge
+float textureResolution(std::span<const correction::Buffer::Vertex> vertices,
+                        std::span<const unsigned int> indices, unsigned int geometryType,
+                        ivec2 res)
+{
+    float resolution = 0.f;
+    auto edge = [&](unsigned int i, unsigned int j) {
+        const correction::Buffer::Vertex& a = vertices[i];
+        const correction::Buffer::Vertex& b = vertices[j];
+        const float texture = std::hypot(a.s - b.s, a.t - b.t);
+        const float pixels = std::hypot(
+            (a.x - b.x) * static_cast<float>(res.x) / 2.f,
+            (a.y - b.y) * static_cast<float>(res.y) / 2.f
+        );
+        if (texture > 0.f) {
+            resolution = std::max(resolution, pixels / texture);
+        }
+    };
+    const size_t step = geometryType == GL_TRIANGLE_STRIP ? 1 : 3;
+    for (size_t i = 0; i + 2 < indices.size(); i += step) {
+        edge(indices[i], indices[i + 1]);
+        edge(indices[i + 1], indices[i + 2]);
+        edge(indices[i + 2], indices[i]);
+    }
+    return resolution;
+}
+
+// Appends the triangles of the \p mesh to the \p merged mesh, with the texture coordinate
+// t of its vertices moved by twice the \p segment
+void appendSegment(correction::Buffer& merged, const correction::Buffer& mesh,
+                   int segment)
+{
+    const unsigned int offset = static_cast<unsigned int>(merged.vertices.size());
+    for (correction::Buffer::Vertex v : mesh.vertices) {
+        v.t += 2.f * static_cast<float>(segment);
+        merged.vertices.push_back(v);
+    }
+
+    const std::vector<unsigned int>& indices = mesh.indices;
+    if (mesh.geometryType == GL_TRIANGLE_STRIP) {
+        for (size_t i = 0; i + 2 < indices.size(); i++) {
+            std::array<unsigned int, 3> t = {
+                indices[i], indices[i + 1], indices[i + 2]
+            };
+            // Every other triangle of a strip has the opposite winding order
+            if (i % 2 == 1) {
+                std::swap(t[0], t[1]);
+            }
+            // Strips use degenerate triangles to jump between rows
+            if (t[0] != t[1] && t[1] != t[2] && t[0] != t[2]) {
+                merged.indices.insert(
+                    merged.indices.end(),
+                    { t[0] + offset, t[1] + offset, t[2] + offset }
+                );
+            }
+        }
+    }
+    else {
+        for (unsigned int i : indices) {
+            merged.indices.push_back(i + offset);
+        }
+    }
+    merged.geometryType = GL_TRIANGLES;
+}
+
+int segmentOf(const correction::Buffer::Vertex& vertex) {
+    return static_cast<int>(std::floor(vertex.t / 2.f));
+}
+
+constexpr std::string_view WarpMapBakeFrag = R"(
+  #version 330 core
+
+  in vec2 tr_uv;
+  in vec4 tr_color;
+  layout (location = 0) out vec2 out_uv;
+  layout (location = 1) out vec4 out_color;
+
+  void main() {
+    out_uv = tr_uv;
+    out_color = tr_color;
+  }
+)";
+
+void createWarpMapTexture(unsigned int& texture, GLenum internalFormat, GLenum format,
+                          ivec2 size)
+{
+    glDeleteTextures(1, &texture);
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        internalFormat,
+        size.x,
+        size.y,
+        0,
+        format,
+        GL_FLOAT,
+        nullptr
+    );
+    // Every pixel of the viewport reads exactly the texel that was rendered for it, which
+    // gives the same result as rasterizing the mesh
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+// The largest error in pixels that the compact vertex formats are allowed to introduce
+// into the positions and the texture coordinates of the mesh
+constexpr float MaxQuantizationError = 1.f / 16.f;
+
+struct PackedVertices {
+    struct Attribute {
+        GLenum type = GL_FLOAT;
+        GLint size = 0;
+        GLuint offset = 0;
+    };
+
+    std::vector<std::byte> data;
+    GLsizei stride = 0;
+    Attribute position;
+    Attribute texCoords;
+    // Empty if all vertices have the same constantColor
+    std::optional<Attribute> color;
+    vec4 constantColor = vec4{ 1.f, 1.f, 1.f, 1.f };
+};
+
+// Converts the vertices into the most compact layout that represents them within the
+// MaxQuantizationError when the positions cover the window's framebuffer of the size
+// \p resolution and the texture coordinates sample a texture of the same size. Before
+// OpenGL 4.2, signed normalized integers were converted with (2c + 1) / (2^b - 1), which
+// cannot represent 0 exactly, so the positions are only packed if \p hasExactSnorm
+PackedVertices packVertices(std::span<const correction::Buffer::Vertex> vertices,
+                            ivec2 resolution, bool hasExactSnorm)
+{
+    ZoneScoped;
+
+    using Vertex = correction::Buffer::Vertex;
+
+    const float maxRes = static_cast<float>(std::max(resolution.x, resolution.y));
+    // Rounding to SNORM16 moves the positions by up to half of 1/32767 of the [-1, 1]
+    // range that spans the window, and UNORM16 does the same with 1/65535 of [0, 1]
+    const bool isPositionPrecise = maxRes / (4.f * 32767.f) <= MaxQuantizationError;
+    const bool isTexCoordPrecise = maxRes / (2.f * 65535.f) <= MaxQuantizationError;
+
+    auto inRange = [](float v, float min, float max) { return v >= min && v <= max; };
+    bool isPositionShort = hasExactSnorm && isPositionPrecise;
+    bool isTexCoordShort = isTexCoordPrecise;
+    bool isColorShort = true;
+    bool isColorConstant = true;
+    for (const Vertex& v : vertices) {
+        isPositionShort &= inRange(v.x, -1.f, 1.f) && inRange(v.y, -1.f, 1.f);
+        isTexCoordShort &= inRange(v.s, 0.f, 1.f) && inRange(v.t, 0.f, 1.f);
+        isColorShort &= inRange(v.r, 0.f, 1.f) && inRange(v.g, 0.f, 1.f) &&
+            inRange(v.b, 0.f, 1.f) && inRange(v.a, 0.f, 1.f);
+        const Vertex& f = vertices.front();
+        isColorConstant &= v.r == f.r && v.g == f.g && v.b == f.b && v.a == f.a;
+    }
+
+    PackedVertices res;
+    auto addAttribute = [&res](GLint size, bool isShort, GLenum shortType) {
+        PackedVertices::Attribute a = {
+            .type = isShort ? shortType : GL_FLOAT,
+            .size = size,
+            .offset = static_cast<GLuint>(res.stride)
+        };
+        const size_t bytes = isShort ? sizeof(uint16_t) : sizeof(float);
+        res.stride += static_cast<GLsizei>(size * bytes);
+        return a;
+    };
+    res.position = addAttribute(2, isPositionShort, GL_SHORT);
+    res.texCoords = addAttribute(2, isTexCoordShort, GL_UNSIGNED_SHORT);
+    if (isColorConstant && !vertices.empty()) {
+        const Vertex& f = vertices.front();
+        res.constantColor = vec4{ f.r, f.g, f.b, f.a };
+    }
+    else {
+        res.color = addAttribute(4, isColorShort, GL_UNSIGNED_SHORT);
+    }
+
+    res.data.resize(vertices.size() * static_cast<size_t>(res.stride));
+    auto write = [](std::byte* dst, const PackedVertices::Attribute& a,
+                    std::initializer_list<float> values)
+    {
+        dst += a.offset;
+        for (float v : values) {
+            if (a.type == GL_FLOAT) {
+                std::memcpy(dst, &v, sizeof(float));
+                dst += sizeof(float);
+            }
+            else if (a.type == GL_SHORT) {
+                const int16_t c = static_cast<int16_t>(std::lround(v * 32767.f));
+                std::memcpy(dst, &c, sizeof(int16_t));
+                dst += sizeof(int16_t);
+            }
+            else {
+                const uint16_t c = static_cast<uint16_t>(std::lround(v * 65535.f));
+                std::memcpy(dst, &c, sizeof(uint16_t));
+                dst += sizeof(uint16_t);
+            }
+        }
+    };
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Vertex& v = vertices[i];
+        std::byte* dst = res.data.data() + i * static_cast<size_t>(res.stride);
+        write(dst, res.position, { v.x, v.y });
+        write(dst, res.texCoords, { v.s, v.t });
+        if (res.color) {
+            write(dst, *res.color, { v.r, v.g, v.b, v.a });
+        }
+    }
+    return res;
+}
+
+// The procedural meshes are written by the GPU in the layout of correction::Buffer
+PackedVertices vertexLayout() {
+    using Vertex = correction::Buffer::Vertex;
+    PackedVertices res;
+    res.stride = sizeof(Vertex);
+    res.position = { GL_FLOAT, 2, static_cast<GLuint>(offsetof(Vertex, x)) };
+    res.texCoords = { GL_FLOAT, 2, static_cast<GLuint>(offsetof(Vertex, s)) };
+    res.color = PackedVertices::Attribute{
+        GL_FLOAT, 4, static_cast<GLuint>(offsetof(Vertex, r))
+    };
+    return res;
+}
+
+bool hasExactSnorm() {
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    return major > 4 || (major == 4 && minor >= 2);
+}
+
+bool isProcedural(const std::filesystem::path& path) {
+    return path.extension() == ".data" || path.extension() == ".csv";
+}
+
+// Computes the vertices of a correction::WarpGrid in the same way as
+// correction::evaluateWarpGrid and writes them through transform feedback
+constexpr std::string_view ProceduralMeshVert = R"(
+  #version 330 core
+
+  layout (location = 0) in vec4 in_point;
+  layout (location = 1) in float in_intensity;
+  out vec2 out_position;
+  out vec2 out_texCoords;
+  out vec4 out_color;
+
+  uniform int model;
+  uniform vec2 pos;
+  uniform vec2 size;
+  uniform float aspectRatio;
+
+  const int PaulBourke = 0;
+
+  void main() {
+    if (model == PaulBourke) {
+      float aspect = aspectRatio * (size.x / size.y);
+      vec2 p = (vec2(in_point.x / aspect, in_point.y) + 1.0) / 2.0;
+      out_position = (p * size + pos) * 2.0 - 1.0;
+      out_texCoords = in_point.zw * size + pos;
+      out_color = vec4(vec3(in_intensity), 1.0);
+    }
+    else {
+      vec2 p = clamp(in_point.xy, 0.0, 1.0);
+      out_position = 2.0 * (pos + vec2(p.x, 1.0 - p.y) * size) - 1.0;
+      out_texCoords = pos + vec2(in_point.z, 1.0 - in_point.w) * size;
+      out_color = vec4(1.0);
+    }
+  }
+)";
+
 } // namespace
 
-CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
-                                                         const correction::Buffer& buffer)
+struct CorrectionMesh::GeometryBuffers {
+    // The vertices are uploaded in the most compact format that is precise enough for a
+    // window's framebuffer of the size of the resolution
+    GeometryBuffers(std::span<const correction::Buffer::Vertex> vertices,
+        std::span<const unsigned int> indices, unsigned int geometryType,
+        ivec2 resolution);
+    // The packed vertices are uploaded as they are with the \p usage. If they have no
+    // data, the vertex buffer object is only allocated for n vertices, which are then
+    // written on the GPU
+    GeometryBuffers(PackedVertices packed, size_t n,
+        std::span<const unsigned int> indices, unsigned int geometryType,
+        unsigned int usage = GL_STATIC_DRAW);
+    GeometryBuffers(const GeometryBuffers&) = delete;
+    GeometryBuffers& operator=(const GeometryBuffers&) = delete;
+    ~GeometryBuffers();
+
+    unsigned int vbo = 0;
+    unsigned int ibo = 0;
+    // The layout of the vertices in the vbo, whose data has been uploaded already
+    PackedVertices layout;
+    unsigned int nVertices = 0;
+    unsigned int nIndices = 0;
+    unsigned int type = GL_TRIANGLE_STRIP;
+    unsigned int indexType = GL_UNSIGNED_INT;
+    MemoryAccount memory = MemoryAccount(MemoryTracker::Category::CorrectionMeshes);
+};
+
+struct CorrectionMesh::SharedMesh {
+    std::once_flag isParsed;
+    correction::Buffer buffer;
+    std::unique_ptr<correction::CachedMesh> cachedMesh;
+
+    // These are only used on the main thread. The parsed mesh is released once the
+    // buffers have been created from it
+    std::unique_ptr<GeometryBuffers> geometry;
+    std::optional<std::pair<vec2, vec2>> textureBounds;
+    std::optional<float> textureResolution;
+};
+
+CorrectionMesh::GeometryBuffers::GeometryBuffers(
+                                     std::span<const correction::Buffer::Vertex> vertices,
+                                                    std::span<const unsigned int> indices,
+                                                                unsigned int geometryType,
+                                                                        ivec2 resolution)
+    : GeometryBuffers(
+        packVertices(vertices, resolution, hasExactSnorm()),
+        vertices.size(),
+        indices,
+        geometryType
+    )
+{}
+
+CorrectionMesh::GeometryBuffers::GeometryBuffers(PackedVertices packed, size_t n,
+                                                    std::span<const unsigned int> indices,
+                                                                unsigned int geometryType,
+                                                                       unsigned int usage)
+    : layout(std::move(packed))
 {
     ZoneScoped;
     TracyGpuZone("createMesh");
 
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
-
+    // The element array binding is part of the vertex array object, so both buffers are
+    // uploaded through the array buffer binding and attached to each vertex array object
+    // by CorrectionMeshGeometry
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    constexpr int s = sizeof(correction::Buffer::Vertex);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        buffer.vertices.size() * s,
-        buffer.vertices.data(),
-        GL_STATIC_DRAW
-    );
+    size_t bytes = 0;
+    if (layout.data.empty()) {
+        bytes = n * static_cast<size_t>(layout.stride);
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_DYNAMIC_COPY);
+    }
+    else {
+        bytes = layout.data.size();
+        glBufferData(GL_ARRAY_BUFFER, bytes, layout.data.data(), usage);
+        layout.data = std::vector<std::byte>();
+    }
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, s, nullptr);
+    glGenBuffers(1, &ibo);
+    glBindBuffer(GL_ARRAY_BUFFER, ibo);
+    if (n <= std::numeric_limits<uint16_t>::max() + size_t(1)) {
+        // Halves the size of the index buffer for all but the largest meshes
+        std::vector<uint16_t> shortIndices = std::vector<uint16_t>(
+            indices.begin(),
+            indices.end()
+        );
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            shortIndices.size() * sizeof(uint16_t),
+            shortIndices.data(),
+            GL_STATIC_DRAW
+        );
+        indexType = GL_UNSIGNED_SHORT;
+        bytes += shortIndices.size() * sizeof(uint16_t);
+    }
+    else {
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            indices.size_bytes(),
+            indices.data(),
+            GL_STATIC_DRAW
+        );
+        indexType = GL_UNSIGNED_INT;
+        bytes += indices.size_bytes();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    memory.set(bytes);
 
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(8));
+    nVertices = static_cast<unsigned int>(n);
+    nIndices = static_cast<unsigned int>(indices.size());
+    type = geometryType;
+}
+
+CorrectionMesh::GeometryBuffers::~GeometryBuffers() {
+    // Yes, glDeleteBuffers works when passing 0, but this check is a standin for whether
+    // they were created in the first place. This would only fail if there is no OpenGL
+    // context, which would cause these functions to fail, too.
+    if (vbo) {
+        glDeleteBuffers(1, &vbo);
+    }
+    if (ibo) {
+        glDeleteBuffers(1, &ibo);
+    }
+}
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(16));
+CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
+                                   std::shared_ptr<const GeometryBuffers> geometryBuffers)
+    : buffers(std::move(geometryBuffers))
+{
+    ZoneScoped;
 
-    glGenBuffers(1, &ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER,
-        buffer.indices.size() * sizeof(unsigned int),
-        buffer.indices.data(),
-        GL_STATIC_DRAW
-    );
-    glBindVertexArray(0);
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers->vbo);
+
+    const PackedVertices& packed = buffers->layout;
+    auto setAttribute = [&packed](GLuint location, const PackedVertices::Attribute& a) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(
+            location,
+            a.size,
+            a.type,
+            a.type == GL_FLOAT ? GL_FALSE : GL_TRUE,
+            packed.stride,
+            reinterpret_cast<void*>(static_cast<uintptr_t>(a.offset))
+        );
+    };
+    setAttribute(0, packed.position);
+    setAttribute(1, packed.texCoords);
+    if (packed.color) {
+        setAttribute(2, *packed.color);
+    }
 
-    nVertices = static_cast<int>(buffer.vertices.size());
-    nIndices = static_cast<int>(buffer.indices.size());
-    type = buffer.geometryType;
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->ibo);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
+                                                         const correction::Buffer& buffer,
+                                                                        ivec2 resolution)
+    : CorrectionMeshGeometry(std::make_shared<const GeometryBuffers>(
+        buffer.vertices,
+        buffer.indices,
+        buffer.geometryType,
+        resolution
+    ))
+{}
+
 CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
                                                     CorrectionMeshGeometry&& rhs) noexcept
     : vao(rhs.vao)
-    , vbo(rhs.vbo)
-    , ibo(rhs.ibo)
-    , nVertices(rhs.nVertices)
-    , nIndices(rhs.nIndices)
-    , type(rhs.type)
+    , buffers(std::move(rhs.buffers))
 {
     // We need to prevent a double-free of the OpenGL resource in the destructor
     rhs.vao = 0;
-    rhs.vbo = 0;
-    rhs.ibo = 0;
+}
+
+CorrectionMesh::CorrectionMeshGeometry&
+CorrectionMesh::CorrectionMeshGeometry::operator=(CorrectionMeshGeometry&& rhs) noexcept
+{
+    // The previous OpenGL objects are handed to rhs, which deletes them when a reloaded
+    // mesh replaces this one
+    std::swap(vao, rhs.vao);
+    std::swap(buffers, rhs.buffers);
+    return *this;
 }
 
 CorrectionMesh::CorrectionMeshGeometry::~CorrectionMeshGeometry() {
-    // Yes, glDeleteVertexArrays and glDeleteBuffers work when passing 0, but this check
-    // is a standin for whether they were created in the first place. This would only fail
-    // if there is no OpenGL context, which would cause these functions to fail, too.
     if (vao) {
         glDeleteVertexArrays(1, &vao);
         vao = 0;
     }
-    if (vbo) {
-        glDeleteBuffers(1, &vbo);
-        vbo = 0;
+}
+
+CorrectionMesh::CorrectionMesh() = default;
+
+CorrectionMesh::~CorrectionMesh() {
+    if (_warpMap.fbo) {
+        glDeleteFramebuffers(1, &_warpMap.fbo);
+        glDeleteTextures(1, &_warpMap.texCoords);
+        glDeleteTextures(1, &_warpMap.colors);
     }
-    if (ibo) {
-        glDeleteBuffers(1, &ibo);
-        ibo = 0;
+    if (_procedural.pointBuffer) {
+        glDeleteBuffers(1, &_procedural.pointBuffer);
+    }
+}
+
+bool CorrectionMesh::isPreparable(const std::filesystem::path& path) {
+    // These parsers only read the file, while the other formats also set up the viewport
+    // and the Paul Bourke format depends on the window's aspect ratio, which might still
+    // change while the windows are created
+    const std::filesystem::path ext = path.extension();
+    return ext == ".csv" || ext == ".obj" || ext == ".pfm" || ext == ".simcad";
+}
+
+void CorrectionMesh::prepareMesh(const std::filesystem::path& path,
+                                 const BaseViewport& parent, bool textureRenderMode)
+{
+    ZoneScoped;
+
+    if (!isPreparable(path) || (_useProceduralMesh && isProcedural(path)) ||
+        _useEditableMesh)
+    {
+        return;
     }
+
+    _preparedMesh = sharedMesh(path, parent, textureRenderMode, _simplificationTolerance);
 }
 
 void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& parent,
@@ -179,12 +763,17 @@ void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& p
     using namespace correction;
     const vec2& parentPos = parent.position();
     const vec2& parentSize = parent.size();
+    const ivec2 windowRes = parent.window().framebufferResolution();
+    _revision++;
+    _warpSegments.clear();
+    _editable.vertices.clear();
+    _editable.indices.clear();
 
     // generate unwarped mask
     {
         ZoneScopedN("Create simple mask");
         const Buffer buf = setupSimpleMesh(parentPos, parentSize);
-        _quadGeometry = CorrectionMeshGeometry(buf);
+        _quadGeometry = CorrectionMeshGeometry(buf, windowRes);
     }
 
     // generate unwarped mesh for mask
@@ -193,38 +782,65 @@ void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& p
         Log::Debug("CorrectionMesh: Creating mask mesh");
 
         const Buffer buf = setupMaskMesh(parentPos, parentSize);
-        _maskGeometry = CorrectionMeshGeometry(buf);
+        _maskGeometry = CorrectionMeshGeometry(buf, windowRes);
     }
 
     // fallback if no mesh is provided
     if (path.empty()) {
         const Buffer buf = setupSimpleMesh(parentPos, parentSize);
-        _warpGeometry = CorrectionMeshGeometry(buf);
+        _warpGeometry = CorrectionMeshGeometry(buf, windowRes);
         return;
     }
 
-    Buffer buf;
-
-    // find a suitable format
-    if (path.extension() == ".sgc") {
-        buf = generateScissMesh(path, parent);
+    // find a suitable format. The parsers of the formats that are not cacheable change
+    // the view plane of the viewport, so their meshes are not shared with other viewports
+    // and the frustums have to be recalculated afterwards
+    std::shared_ptr<SharedMesh> mesh;
+    if (_useProceduralMesh && isProcedural(path)) {
+        // Only the control points are kept, which are not shared either
+        mesh = std::make_shared<SharedMesh>();
+        mesh->geometry = loadProceduralMesh(path, parent);
+    }
+    else if (_preparedMesh) {
+        mesh = std::move(_preparedMesh);
+    }
+    else if (path.extension() == ".sgc") {
+        mesh = std::make_shared<SharedMesh>();
+        mesh->buffer = generateScissMesh(path, parent);
+        Engine::instance().updateFrustums();
+        optimize(mesh->buffer, parent, _simplificationTolerance);
     }
     else if (path.extension() == ".ol") {
-        buf = generateScalableMesh(path, parent);
+        mesh = std::make_shared<SharedMesh>();
+        mesh->buffer = generateScalableMesh(path, parent);
+        Engine::instance().updateFrustums();
+        optimize(mesh->buffer, parent, _simplificationTolerance);
     }
-    else if (path.extension() == ".skyskan") {
-        buf = generateSkySkanMesh(path, parent);
+    else if (path.extension() == ".skyskan" || path.extension() == ".txt") {
+        mesh = std::make_shared<SharedMesh>();
+        mesh->buffer = generateSkySkanMesh(path, parent);
+        Engine::instance().updateFrustums();
+        optimize(mesh->buffer, parent, _simplificationTolerance);
     }
-    else if (path.extension() == ".txt") {
-        buf = generateSkySkanMesh(path, parent);
+    else if (isCacheable(path) && _useEditableMesh) {
+        // The vertices of an editable mesh are replaced for this viewport alone
+        mesh = std::make_shared<SharedMesh>();
+        mesh->cachedMesh = readOrGenerateMesh(
+            path,
+            parent,
+            textureRenderMode,
+            _simplificationTolerance,
+            mesh->buffer
+        );
     }
-    else if (path.extension() == ".csv") {
-        buf = generateDomeProjectionMesh(path, parentPos, parentSize);
+    else if (isCacheable(path)) {
+        mesh = sharedMesh(path, parent, textureRenderMode, _simplificationTolerance);
+    }
+    else {
+        throw Error(2002, "Could not determine format for warping mesh");
     }
-    else if (path.extension() == ".data") {
-        const float aspectRatio = parent.window().aspectRatio();
-        buf = generatePaulBourkeMesh(path, parentPos, parentSize, aspectRatio);
 
+    if (path.extension() == ".data") {
         // force regeneration of dome render quad
         if (Viewport* vp = dynamic_cast<Viewport*>(&parent); vp) {
             auto fishPrj = dynamic_cast<FisheyeProjection*>(vp->nonLinearProjection());
@@ -234,35 +850,523 @@ void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& p
             }
         }
     }
-    else if (path.extension() == ".obj") {
-        buf = generateOBJMesh(path);
+
+    if (!mesh->geometry) {
+        ZoneScopedN("Create shared mesh");
+
+        // The cached mesh is passed to OpenGL straight from the mapped file
+        const std::unique_ptr<CachedMesh>& cached = mesh->cachedMesh;
+        const Buffer& buf = mesh->buffer;
+        const std::span<const Buffer::Vertex> vertices =
+            cached ? cached->vertices : std::span<const Buffer::Vertex>(buf.vertices);
+        const std::span<const unsigned int> indices =
+            cached ? cached->indices : std::span<const unsigned int>(buf.indices);
+        const unsigned int geometryType =
+            cached ? cached->geometryType : buf.geometryType;
+
+        if (_useEditableMesh) {
+            // The vertices are not packed, so that any vertex can be replaced without
+            // changing the layout of the whole buffer
+            PackedVertices layout = vertexLayout();
+            layout.data.resize(vertices.size_bytes());
+            std::memcpy(layout.data.data(), vertices.data(), vertices.size_bytes());
+            mesh->geometry = std::make_unique<GeometryBuffers>(
+                std::move(layout),
+                vertices.size(),
+                indices,
+                geometryType,
+                GL_DYNAMIC_DRAW
+            );
+            _editable.vertices.assign(vertices.begin(), vertices.end());
+            _editable.indices.assign(indices.begin(), indices.end());
+            _editable.geometryType = geometryType;
+            _editable.resolution = windowRes;
+        }
+        else {
+            mesh->geometry = std::make_unique<GeometryBuffers>(
+                vertices,
+                indices,
+                geometryType,
+                windowRes
+            );
+        }
+
+        if (!vertices.empty()) {
+            mesh->textureBounds = textureBounds(vertices);
+
+            const float resolution = textureResolution(
+                vertices,
+                indices,
+                geometryType,
+                windowRes
+            );
+            if (resolution > 0.f) {
+                mesh->textureResolution = resolution;
+            }
+        }
+
+        // Every other viewport that uses this mesh only needs the buffers
+        mesh->buffer = Buffer();
+        mesh->cachedMesh = nullptr;
     }
-    else if (path.extension() == ".pfm") {
-        buf = generatePerEyeMeshFromPFMImage(
+
+    // The buffers keep the whole mesh alive so that it is found by the other viewports
+    const GeometryBuffers* geometry = mesh->geometry.get();
+    _warpGeometry = CorrectionMeshGeometry(
+        std::shared_ptr<const GeometryBuffers>(mesh, geometry)
+    );
+    _warpTextureBounds = mesh->textureBounds;
+    _warpTextureResolution = mesh->textureResolution;
+
+    if (_useWarpMap && _warpMap.fbo == 0) {
+        _warpMap.bakeShader = ShaderProgram("WarpMapBakeShader");
+        _warpMap.bakeShader.addVertexShader(shaders::BaseVert);
+        _warpMap.bakeShader.addFragmentShader(WarpMapBakeFrag);
+        _warpMap.bakeShader.createAndLinkProgram();
+        ShaderProgram::unbind();
+
+        glGenFramebuffers(1, &_warpMap.fbo);
+    }
+    // A reloaded mesh is baked into the warp map again the next time it is bound
+    _warpMap.size = ivec2(0, 0);
+    _warpMap.cachePath.clear();
+    const bool isCachedWarpMap = _useWarpMap &&
+        Engine::instance().settings().useCorrectionMeshCache &&
+        !(_useProceduralMesh && isProcedural(path)) && !_useEditableMesh;
+    if (isCachedWarpMap) {
+        const std::vector<float> parameters = meshParameters(
             path,
-            parentPos,
-            parentSize,
-            textureRenderMode
+            parent,
+            textureRenderMode,
+            _simplificationTolerance
         );
+        _warpMap.cachePath = path;
+        _warpMap.cacheKey = meshCacheKey(path, parameters);
     }
-    else if (path.extension() == ".simcad") {
-        buf = generateSimCADMesh(path, parentPos, parentSize);
+
+    Log::Debug(std::format(
+        "CorrectionMesh read successfully. Vertices={}, Indices={}",
+        geometry->nVertices, geometry->nIndices
+    ));
+}
+
+std::shared_ptr<CorrectionMesh::SharedMesh> CorrectionMesh::sharedMesh(
+                                                        const std::filesystem::path& path,
+                                                               const BaseViewport& parent,
+                                                                   bool textureRenderMode,
+                                                           std::optional<float> tolerance)
+{
+    ZoneScoped;
+
+    static std::mutex Mutex;
+    static std::map<SharedMeshKey, std::weak_ptr<SharedMesh>> Meshes;
+
+    // A file that cannot be found gets a key that is not used by any other file, which
+    // then fails to be parsed
+    std::error_code ec;
+    const SharedMeshKey key = {
+        .path = std::filesystem::weakly_canonical(path, ec),
+        .writeTime = std::filesystem::last_write_time(path, ec),
+        .parameters = meshParameters(path, parent, textureRenderMode, tolerance),
+        .resolution = parent.window().framebufferResolution()
+    };
+
+    std::shared_ptr<SharedMesh> mesh;
+    {
+        const std::lock_guard lock(Mutex);
+        std::erase_if(Meshes, [](const auto& p) { return p.second.expired(); });
+        std::weak_ptr<SharedMesh>& entry = Meshes[key];
+        mesh = entry.lock();
+        if (!mesh) {
+            mesh = std::make_shared<SharedMesh>();
+            entry = mesh;
+        }
+    }
+
+    // The viewports that share the mesh wait until the first one has parsed it. If the
+    // parsing fails, the next viewport tries again and reports the same error
+    std::call_once(mesh->isParsed, [&]() {
+        mesh->cachedMesh = readOrGenerateMesh(
+            path,
+            parent,
+            textureRenderMode,
+            tolerance,
+            mesh->buffer
+        );
+    });
+    return mesh;
+}
+
+bool CorrectionMesh::isMergeable(const std::filesystem::path& path) {
+    return isCacheable(path);
+}
+
+void CorrectionMesh::loadMergedMesh(std::span<const std::filesystem::path> paths,
+                                    std::span<const BaseViewport* const> parents)
+{
+    ZoneScoped;
+
+    using namespace correction;
+    assert(!paths.empty() && paths.size() == parents.size());
+    const BaseViewport& parent = *parents.front();
+    const ivec2 windowRes = parent.window().framebufferResolution();
+    _revision++;
+    _editable.vertices.clear();
+    _editable.indices.clear();
+
+    const Buffer quad = setupSimpleMesh(parent.position(), parent.size());
+    _quadGeometry = CorrectionMeshGeometry(quad, windowRes);
+    _maskGeometry = std::nullopt;
+
+    // The segments are optimized each on their own, as the simplification would
+    // otherwise collapse the edges between them
+    auto generateMergedMesh = [&]() {
+        Buffer merged;
+        for (size_t i = 0; i < paths.size(); i++) {
+            if (!isMergeable(paths[i])) {
+                throw Error(
+                    2004,
+                    "Could not determine format for merged warping mesh"
+                );
+            }
+            Buffer mesh = generateCacheableMesh(paths[i], *parents[i], false);
+            optimize(mesh, *parents[i], _simplificationTolerance);
+            appendSegment(merged, mesh, static_cast<int>(i));
+        }
+        return merged;
+    };
+
+    Buffer buffer;
+    std::unique_ptr<CachedMesh> cached;
+    if (Engine::instance().settings().useCorrectionMeshCache) {
+        std::vector<uint64_t> keys;
+        for (size_t i = 0; i < paths.size(); i++) {
+            const std::vector<float> parameters =
+                meshParameters(paths[i], *parents[i], false, _simplificationTolerance);
+            keys.push_back(meshCacheKey(paths[i], parameters));
+        }
+        const uint64_t key = combineMeshCacheKeys(keys);
+
+        std::filesystem::path cachePath = paths.front();
+        cachePath += ".merged";
+        cached = readMeshCache(cachePath, key);
+        if (!cached) {
+            buffer = generateMergedMesh();
+            writeMeshCache(cachePath, key, buffer);
+        }
     }
     else {
-        throw Error(2002, "Could not determine format for warping mesh");
+        buffer = generateMergedMesh();
     }
 
-    _warpGeometry = CorrectionMeshGeometry(buf);
+    const std::span<const Buffer::Vertex> vertices =
+        cached ? cached->vertices : std::span<const Buffer::Vertex>(buffer.vertices);
+    const std::span<const unsigned int> indices =
+        cached ? cached->indices : std::span<const unsigned int>(buffer.indices);
+    _warpGeometry = CorrectionMeshGeometry(std::make_shared<const GeometryBuffers>(
+        vertices,
+        indices,
+        GL_TRIANGLES,
+        windowRes
+    ));
+    _warpTextureBounds = std::nullopt;
+    _warpTextureResolution = std::nullopt;
+
+    // The vertices and the triangles of each segment follow those of the previous one
+    _warpSegments = std::vector<Segment>(paths.size());
+    size_t begin = 0;
+    while (begin < indices.size()) {
+        const int segment = segmentOf(vertices[indices[begin]]);
+        size_t end = begin;
+        while (end < indices.size() && segmentOf(vertices[indices[end]]) == segment) {
+            end += 3;
+        }
+        end = std::min(end, indices.size());
+        if (segment < 0 || segment >= static_cast<int>(_warpSegments.size())) {
+            begin = end;
+            continue;
+        }
+
+        std::vector<Buffer::Vertex> local;
+        local.reserve(end - begin);
+        for (size_t i = begin; i < end; i++) {
+            Buffer::Vertex v = vertices[indices[i]];
+            v.t -= 2.f * static_cast<float>(segment);
+            local.push_back(v);
+        }
+        Segment& s = _warpSegments[segment];
+        s.textureBounds = textureBounds(local);
+        const float resolution = textureResolution(
+            vertices,
+            indices.subspan(begin, end - begin),
+            GL_TRIANGLES,
+            windowRes
+        );
+        if (resolution > 0.f) {
+            s.textureResolution = resolution;
+        }
+        begin = end;
+    }
 
     Log::Debug(std::format(
-        "CorrectionMesh read successfully. Vertices={}, Indices={}",
-        buf.vertices.size(), buf.indices.size()
+        "Merged {} correction meshes. Vertices={}, Indices={}",
+        paths.size(), vertices.size(), indices.size()
     ));
 }
 
+void CorrectionMesh::setSimplificationTolerance(float tolerance) {
+    _simplificationTolerance = tolerance;
+}
+
+void CorrectionMesh::setUseWarpMap(bool useWarpMap) {
+    _useWarpMap = useWarpMap;
+}
+
+void CorrectionMesh::setUseProceduralMesh(bool useProceduralMesh) {
+    _useProceduralMesh = useProceduralMesh;
+}
+
+bool CorrectionMesh::hasProceduralMesh() const {
+    return _procedural.pointBuffer != 0;
+}
+
+std::span<const correction::WarpGrid::Point>
+CorrectionMesh::proceduralMeshPoints() const
+{
+    return _procedural.points;
+}
+
+void CorrectionMesh::setProceduralMeshPoints(
+                                     std::span<const correction::WarpGrid::Point> points,
+                                                               const BaseViewport& parent)
+{
+    ZoneScoped;
+
+    assert(hasProceduralMesh());
+    if (points.size() != _procedural.points.size()) {
+        throw Error(
+            2003,
+            std::format(
+                "Expected {} control points for the procedural mesh but got {}",
+                _procedural.points.size(), points.size()
+            )
+        );
+    }
+
+    _procedural.points.assign(points.begin(), points.end());
+    glBindBuffer(GL_ARRAY_BUFFER, _procedural.pointBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, points.size_bytes(), points.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    evaluateProceduralMesh(parent, _warpGeometry->buffers->vbo);
+}
+
+void CorrectionMesh::updateProceduralMesh(const BaseViewport& parent) {
+    if (!hasProceduralMesh()) {
+        return;
+    }
+
+    const bool hasChanged = parent.position() != _procedural.position ||
+        parent.size() != _procedural.size ||
+        parent.window().aspectRatio() != _procedural.aspectRatio;
+    if (hasChanged) {
+        evaluateProceduralMesh(parent, _warpGeometry->buffers->vbo);
+    }
+}
+
+void CorrectionMesh::setUseEditableMesh(bool useEditableMesh) {
+    _useEditableMesh = useEditableMesh;
+}
+
+bool CorrectionMesh::hasEditableMesh() const {
+    return !_editable.vertices.empty();
+}
+
+std::span<const correction::Buffer::Vertex> CorrectionMesh::warpMeshVertices() const {
+    return _editable.vertices;
+}
+
+void CorrectionMesh::setWarpMeshVertices(size_t first,
+                                 std::span<const correction::Buffer::Vertex> vertices)
+{
+    ZoneScoped;
+
+    using Vertex = correction::Buffer::Vertex;
+    if (!hasEditableMesh()) {
+        throw Error(2005, "The correction mesh is not editable");
+    }
+    const size_t n = _editable.vertices.size();
+    if (first > n || vertices.size() > n - first) {
+        throw Error(
+            2006,
+            std::format(
+                "Vertices {} to {} are outside of the {} vertices of the correction mesh",
+                first, first + vertices.size(), n
+            )
+        );
+    }
+    if (vertices.empty()) {
+        return;
+    }
+
+    std::copy(vertices.begin(), vertices.end(), _editable.vertices.begin() + first);
+
+    // Only the replaced range is mapped, and its previous content is discarded, so that
+    // the driver does not have to wait for the frames that still render the old mesh
+    const GLintptr offset = static_cast<GLintptr>(first * sizeof(Vertex));
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(vertices.size_bytes());
+    glBindBuffer(GL_ARRAY_BUFFER, _warpGeometry->buffers->vbo);
+    void* data = glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        offset,
+        bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+    );
+    bool isWritten = false;
+    if (data) {
+        std::memcpy(data, vertices.data(), vertices.size_bytes());
+        // The content of the mapping is undefined if it was lost while it was mapped
+        isWritten = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+    }
+    if (!isWritten) {
+        glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, vertices.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _revision++;
+    _warpTextureBounds = textureBounds(_editable.vertices);
+    const float resolution = textureResolution(
+        _editable.vertices,
+        _editable.indices,
+        _editable.geometryType,
+        _editable.resolution
+    );
+    _warpTextureResolution =
+        resolution > 0.f ? std::optional<float>(resolution) : std::nullopt;
+    _warpMap.size = ivec2(0, 0);
+}
+
+std::unique_ptr<CorrectionMesh::GeometryBuffers> CorrectionMesh::loadProceduralMesh(
+                                                        const std::filesystem::path& path,
+                                                               const BaseViewport& parent)
+{
+    ZoneScoped;
+
+    correction::WarpGrid grid =
+        path.extension() == ".data" ?
+        correction::readPaulBourkeGrid(path) :
+        correction::readDomeProjectionGrid(path);
+
+    if (_procedural.program.id() == 0) {
+        _procedural.program = ShaderProgram("ProceduralMeshShader");
+        _procedural.program.addVertexShader(ProceduralMeshVert);
+        _procedural.program.setTransformFeedbackVaryings(
+            { "out_position", "out_texCoords", "out_color" }
+        );
+        _procedural.program.createAndLinkProgram();
+        glGenBuffers(1, &_procedural.pointBuffer);
+    }
+
+    using Point = correction::WarpGrid::Point;
+    glBindBuffer(GL_ARRAY_BUFFER, _procedural.pointBuffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        grid.points.size() * sizeof(Point),
+        grid.points.data(),
+        GL_DYNAMIC_DRAW
+    );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    _procedural.memory.set(grid.points.size() * sizeof(Point));
+
+    std::unique_ptr<GeometryBuffers> geometry = std::make_unique<GeometryBuffers>(
+        vertexLayout(),
+        grid.points.size(),
+        grid.indices,
+        GL_TRIANGLES
+    );
+    _procedural.model = grid.model;
+    _procedural.points = std::move(grid.points);
+    evaluateProceduralMesh(parent, geometry->vbo);
+    return geometry;
+}
+
+void CorrectionMesh::evaluateProceduralMesh(const BaseViewport& parent,
+                                            unsigned int vbo)
+{
+    ZoneScoped;
+    TracyGpuZone("Evaluate procedural mesh");
+
+    _procedural.position = parent.position();
+    _procedural.size = parent.size();
+    _procedural.aspectRatio = parent.window().aspectRatio();
+    _revision++;
+
+    _procedural.program.bind();
+    const unsigned int id = _procedural.program.id();
+    glUniform1i(glGetUniformLocation(id, "model"), static_cast<int>(_procedural.model));
+    glUniform2f(
+        glGetUniformLocation(id, "pos"),
+        _procedural.position.x,
+        _procedural.position.y
+    );
+    glUniform2f(glGetUniformLocation(id, "size"), _procedural.size.x, _procedural.size.y);
+    glUniform1f(glGetUniformLocation(id, "aspectRatio"), _procedural.aspectRatio);
+
+    // Vertex array objects are not shared between the contexts of the windows, so a new
+    // one is created for every evaluation, which is rare
+    using Point = correction::WarpGrid::Point;
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _procedural.pointBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Point),
+        reinterpret_cast<void*>(offsetof(Point, x))
+    );
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        1,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Point),
+        reinterpret_cast<void*>(offsetof(Point, intensity))
+    );
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, vbo);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_procedural.points.size()));
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ShaderProgram::unbind();
+
+    // The warp map is baked again from the new vertices the next time it is bound
+    _warpMap.size = ivec2(0, 0);
+}
+
 void CorrectionMesh::CorrectionMeshGeometry::render() const {
+    const GeometryBuffers& b = *buffers;
     glBindVertexArray(vao);
-    glDrawElements(type, nIndices, GL_UNSIGNED_INT, nullptr);
+    if (!b.layout.color) {
+        // The current value of an attribute is not part of the vertex array object
+        const vec4& c = b.layout.constantColor;
+        glVertexAttrib4f(2, c.x, c.y, c.z, c.w);
+        glDrawElements(b.type, b.nIndices, b.indexType, nullptr);
+        glVertexAttrib4f(2, 0.f, 0.f, 0.f, 1.f);
+    }
+    else {
+        glDrawElements(b.type, b.nIndices, b.indexType, nullptr);
+    }
     glBindVertexArray(0);
 }
 
@@ -286,4 +1390,182 @@ void CorrectionMesh::renderMaskMesh() const {
     }
 }
 
+void CorrectionMesh::bindWarpMap(const vec2& position, const vec2& size) const {
+    ZoneScoped;
+
+    assert(hasWarpMap());
+
+    using namespace correction;
+    std::array<GLint, 4> viewport;
+    glGetIntegerv(GL_VIEWPORT, viewport.data());
+    const vec2 windowSize = vec2(
+        static_cast<float>(viewport[2]),
+        static_cast<float>(viewport[3])
+    );
+    const ivec2 mapSize = ivec2(
+        std::max(static_cast<int>(std::round(size.x * windowSize.x)), 1),
+        std::max(static_cast<int>(std::round(size.y * windowSize.y)), 1)
+    );
+
+    if (mapSize != _warpMap.size) {
+        ZoneScopedN("Bake warp map");
+        TracyGpuZone("Bake warp map");
+
+        createWarpMapTexture(_warpMap.texCoords, GL_RG32F, GL_RG, mapSize);
+        createWarpMapTexture(_warpMap.colors, GL_RGBA16F, GL_RGBA, mapSize);
+        _warpMap.size = mapSize;
+        _warpMap.memory.set(
+            static_cast<size_t>(mapSize.x) * mapSize.y *
+            (MemoryTracker::bytesPerTexel(GL_RG32F) +
+             MemoryTracker::bytesPerTexel(GL_RGBA16F))
+        );
+
+        const ivec2 offset = ivec2(
+            static_cast<int>(std::round(position.x * windowSize.x)),
+            static_cast<int>(std::round(position.y * windowSize.y))
+        );
+
+        // The baked values also depend on where the viewport lies in the window
+        uint64_t key = 0;
+        std::unique_ptr<CachedWarpMap> cached;
+        if (!_warpMap.cachePath.empty()) {
+            const std::array<uint64_t, 7> keys = {
+                _warpMap.cacheKey,
+                static_cast<uint64_t>(mapSize.x),
+                static_cast<uint64_t>(mapSize.y),
+                static_cast<uint64_t>(offset.x),
+                static_cast<uint64_t>(offset.y),
+                static_cast<uint64_t>(viewport[2]),
+                static_cast<uint64_t>(viewport[3])
+            };
+            key = combineMeshCacheKeys(keys);
+            cached = readWarpMapCache(_warpMap.cachePath, key, mapSize);
+        }
+        if (cached) {
+            // The rows of both textures are a multiple of 8 bytes, so they are always
+            // aligned
+            glBindTexture(GL_TEXTURE_2D, _warpMap.texCoords);
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                0,
+                mapSize.x,
+                mapSize.y,
+                GL_RG,
+                GL_FLOAT,
+                cached->texCoords.data()
+            );
+            glBindTexture(GL_TEXTURE_2D, _warpMap.colors);
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                0,
+                mapSize.x,
+                mapSize.y,
+                GL_RGBA,
+                GL_HALF_FLOAT,
+                cached->colors.data()
+            );
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        else {
+            Log::Debug(std::format(
+                "Baking warp map texture of {}x{} pixels", mapSize.x, mapSize.y
+            ));
+
+            GLint prevFbo = 0;
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFbo);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _warpMap.fbo);
+            glFramebufferTexture2D(
+                GL_DRAW_FRAMEBUFFER,
+                GL_COLOR_ATTACHMENT0,
+                GL_TEXTURE_2D,
+                _warpMap.texCoords,
+                0
+            );
+            glFramebufferTexture2D(
+                GL_DRAW_FRAMEBUFFER,
+                GL_COLOR_ATTACHMENT1,
+                GL_TEXTURE_2D,
+                _warpMap.colors,
+                0
+            );
+            constexpr std::array<GLenum, 2> Buffers = {
+                GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1
+            };
+            glDrawBuffers(static_cast<GLsizei>(Buffers.size()), Buffers.data());
+
+            // The pixels that are not covered by the mesh stay black, as they do when the
+            // warp mesh itself is rendered
+            constexpr std::array<GLfloat, 4> Zero = { 0.f, 0.f, 0.f, 0.f };
+            glClearBufferfv(GL_COLOR, 0, Zero.data());
+            glClearBufferfv(GL_COLOR, 1, Zero.data());
+
+            // Offsets the viewport's part of the window to the origin of the warp map, so
+            // that each texel stores the values of the mesh at the center of its pixel
+            glViewport(-offset.x, -offset.y, viewport[2], viewport[3]);
+            glDisable(GL_SCISSOR_TEST);
+            glDisable(GL_DEPTH_TEST);
+            glDisable(GL_BLEND);
+
+            _warpMap.bakeShader.bind();
+            _warpGeometry->render();
+
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFbo);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+            if (!_warpMap.cachePath.empty()) {
+                // Read back once, so that the next start does not have to bake it again
+                const size_t nPixels = static_cast<size_t>(mapSize.x) * mapSize.y;
+                std::vector<float> texCoords = std::vector<float>(nPixels * 2);
+                std::vector<uint16_t> colors = std::vector<uint16_t>(nPixels * 4);
+                glBindTexture(GL_TEXTURE_2D, _warpMap.texCoords);
+                glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_FLOAT, texCoords.data());
+                glBindTexture(GL_TEXTURE_2D, _warpMap.colors);
+                glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_HALF_FLOAT, colors.data());
+                glBindTexture(GL_TEXTURE_2D, 0);
+                writeWarpMapCache(_warpMap.cachePath, key, mapSize, texCoords, colors);
+            }
+        }
+    }
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, _warpMap.texCoords);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, _warpMap.colors);
+}
+
+bool CorrectionMesh::hasWarpMap() const {
+    return _warpMap.fbo != 0;
+}
+
+uint64_t CorrectionMesh::revision() const {
+    return _revision;
+}
+
+std::optional<std::pair<vec2, vec2>> CorrectionMesh::warpTextureBounds() const {
+    return _warpTextureBounds;
+}
+
+std::optional<float> CorrectionMesh::warpTextureResolution() const {
+    return _warpTextureResolution;
+}
+
+std::optional<std::pair<vec2, vec2>> CorrectionMesh::warpTextureBounds(int segment) const
+{
+    if (segment < 0 || segment >= static_cast<int>(_warpSegments.size())) {
+        return std::nullopt;
+    }
+    return _warpSegments[segment].textureBounds;
+}
+
+std::optional<float> CorrectionMesh::warpTextureResolution(int segment) const {
+    if (segment < 0 || segment >= static_cast<int>(_warpSegments.size())) {
+        return std::nullopt;
+    }
+    return _warpSegments[segment].textureResolution;
+}
+
 } // namespace sgct
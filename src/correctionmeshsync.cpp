@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correctionmeshsync.h>
+
+#include <sgct/bytestream.h>
+#include <sgct/clustermanager.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/node.h>
+#include <sgct/profiling.h>
+#include <sgct/viewport.h>
+#include <sgct/window.h>
+#include <algorithm>
+#include <memory>
+
+namespace sgct {
+
+CorrectionMeshSync::CorrectionMeshSync(uint32_t id)
+    : SharedObjectBase(id)
+{}
+
+void CorrectionMeshSync::addPatch(Patch patch) {
+    _patches.push_back(std::move(patch));
+    setDirty();
+}
+
+void CorrectionMeshSync::apply() {
+    ZoneScoped;
+
+    const ClusterManager& cm = ClusterManager::instance();
+    const std::vector<std::unique_ptr<Window>>& windows = cm.thisNode().windows();
+    for (const Patch& patch : _patches) {
+        if (patch.node != cm.thisNodeId()) {
+            continue;
+        }
+
+        const auto it = std::find_if(
+            windows.cbegin(),
+            windows.cend(),
+            [&patch](const std::unique_ptr<Window>& w) { return w->id() == patch.window; }
+        );
+        if (it == windows.cend()) {
+            Log::Warning(std::format(
+                "Could not find window {} for the correction mesh patch", patch.window
+            ));
+            continue;
+        }
+        const std::vector<std::unique_ptr<Viewport>>& vps = (*it)->viewports();
+        if (patch.viewport < 0 || patch.viewport >= static_cast<int>(vps.size())) {
+            Log::Warning(std::format(
+                "Could not find viewport {} of window {} for the correction mesh patch",
+                patch.viewport, patch.window
+            ));
+            continue;
+        }
+
+        // A patch that does not fit the mesh of this node is dropped, so that a tool
+        // that is out of date with the mesh files does not stop the rendering
+        try {
+            vps[patch.viewport]->setCorrectionMeshVertices(patch.first, patch.vertices);
+        }
+        catch (const Error& e) {
+            Log::Warning(std::format(
+                "Could not patch the correction mesh: {}", e.message
+            ));
+        }
+    }
+    _patches.clear();
+}
+
+void CorrectionMeshSync::serialize(ByteWriter& writer) const {
+    writer.write(static_cast<uint32_t>(_patches.size()));
+    for (const Patch& patch : _patches) {
+        writer.write(static_cast<int32_t>(patch.node));
+        writer.write(static_cast<int32_t>(patch.window));
+        writer.write(static_cast<int32_t>(patch.viewport));
+        writer.write(patch.first);
+        writer.write(patch.vertices);
+    }
+}
+
+void CorrectionMeshSync::deserialize(ByteReader& reader) {
+    // The vertices are only replaced in #apply, as the shared objects are locked here and
+    // no OpenGL context might be current
+    const uint32_t nPatches = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < nPatches; i++) {
+        Patch patch;
+        patch.node = reader.read<int32_t>();
+        patch.window = reader.read<int32_t>();
+        patch.viewport = reader.read<int32_t>();
+        patch.first = reader.read<uint32_t>();
+        reader.read(patch.vertices);
+        _patches.push_back(std::move(patch));
+    }
+}
+
+} // namespace sgct
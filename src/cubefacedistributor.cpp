@@ -0,0 +1,145 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/cubefacedistributor.h>
+
+#include <sgct/clustermanager.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/networkmanager.h>
+#include <sgct/profiling.h>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    // Every transfer starts with this header, followed by the pixels of the face
+    struct Header {
+        int32_t outputNode = 0;
+        uint32_t frame = 0;
+        uint8_t index = 0;
+        uint8_t mode = 0;
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+    };
+
+    // The longest time that the output node waits for a face before it reuses the
+    // previous content of the face. A helper that is this late has most likely lost its
+    // connection, so waiting longer would only stall the whole cluster
+    constexpr std::chrono::milliseconds Timeout = std::chrono::milliseconds(250);
+
+    size_t slotIndex(int index, sgct::FrustumMode mode) {
+        return static_cast<size_t>(index) * 3 + static_cast<size_t>(mode);
+    }
+} // namespace
+
+namespace sgct {
+
+void CubeFaceDistributor::send(int outputNode, int index, FrustumMode mode,
+                               const Face& face) const
+{
+    ZoneScoped;
+
+    const Header header = {
+        .outputNode = outputNode,
+        .frame = face.frame,
+        .index = static_cast<uint8_t>(index),
+        .mode = static_cast<uint8_t>(mode),
+        .x = face.rect.x,
+        .y = face.rect.y,
+        .width = face.rect.z,
+        .height = face.rect.w
+    };
+    std::vector<std::byte> buffer(sizeof(Header) + face.pixels.size());
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+    std::memcpy(buffer.data() + sizeof(Header), face.pixels.data(), face.pixels.size());
+
+    NetworkManager& nm = NetworkManager::instance();
+    const int size = static_cast<int>(buffer.size());
+    if (!nm.isComputerServer()) {
+        // A client only has the data transfer connection to the master
+        nm.transferData(buffer.data(), size, PackageId);
+    }
+    else if (const Network* connection = nm.transferConnection(outputNode)) {
+        nm.transferData(buffer.data(), size, PackageId, *connection);
+    }
+}
+
+void CubeFaceDistributor::receive(const void* data, int length) {
+    ZoneScoped;
+
+    if (length < static_cast<int>(sizeof(Header))) {
+        Log::Warning("Received a cube face without a header");
+        return;
+    }
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    const size_t size = static_cast<size_t>(length) - sizeof(Header);
+    const size_t expected = static_cast<size_t>(header.width) * header.height * 4;
+    if (header.index >= 6 || header.mode > 2 || size != expected) {
+        Log::Warning(std::format("Received an invalid cube face {}", header.index));
+        return;
+    }
+
+    NetworkManager& nm = NetworkManager::instance();
+    if (header.outputNode != ClusterManager::instance().thisNodeId()) {
+        // Only the master receives the faces of other nodes, which it relays to them
+        if (const Network* connection = nm.transferConnection(header.outputNode)) {
+            nm.transferData(data, length, PackageId, *connection);
+        }
+        return;
+    }
+
+    {
+        const std::lock_guard lock(_mutex);
+        Slot& slot = _slots[slotIndex(header.index, FrustumMode(header.mode))];
+        slot.face.frame = header.frame;
+        slot.face.rect = ivec4(header.x, header.y, header.width, header.height);
+        slot.face.pixels.resize(size);
+        std::memcpy(
+            slot.face.pixels.data(),
+            reinterpret_cast<const std::byte*>(data) + sizeof(Header),
+            size
+        );
+        slot.isValid = true;
+    }
+    _cv.notify_all();
+}
+
+bool CubeFaceDistributor::take(int index, FrustumMode mode, unsigned int frame,
+                               Face& face)
+{
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    Slot& slot = _slots[slotIndex(index, mode)];
+    // A face of a later frame can arrive before the output node has started rendering
+    // if the cluster runs without frame lock, which is used as well
+    const bool hasArrived = _cv.wait_for(
+        lock,
+        Timeout,
+        [&]() { return slot.isValid && slot.face.frame >= frame; }
+    );
+    if (!hasArrived) {
+        if (!_hasWarned) {
+            Log::Warning(std::format(
+                "Cube face {} of frame {} did not arrive in time, its previous content "
+                "is reused", index, frame
+            ));
+            _hasWarned = true;
+        }
+        return false;
+    }
+
+    std::swap(face, slot.face);
+    slot.isValid = false;
+    return true;
+}
+
+} // namespace sgct
@@ -7,28 +7,65 @@
  ****************************************************************************************/
 
 #include <sgct/engine.h>
+#include <sgct/benchmark.h>
+#include <sgct/binarylog.h>
+#include <sgct/bufferpolicy.h>
+#include <sgct/capturecollector.h>
 #include <sgct/clustermanager.h>
 #include <sgct/commandline.h>
+#include <sgct/configserver.h>
+#include <sgct/correctionmeshsync.h>
+#include <sgct/cubefacedistributor.h>
 #include <sgct/error.h>
 #include <sgct/fontmanager.h>
+#include <sgct/hitchdetector.h>
+#include <sgct/inputsync.h>
 #include <sgct/internalshaders.h>
+#include <sgct/jobsystem.h>
 #include <sgct/log.h>
+#include <sgct/mediadistributor.h>
+#include <sgct/memorytracker.h>
+#include <sgct/metricsexporter.h>
 #include <sgct/networkmanager.h>
 #include <sgct/node.h>
 #include <sgct/offscreenbuffer.h>
+#ifdef SGCT_HAS_OPENVR
+#include <sgct/openvr.h>
+#endif // SGCT_HAS_OPENVR
 #include <sgct/profiling.h>
+#include <sgct/rendertargetpool.h>
 #include <sgct/shadermanager.h>
 #include <sgct/shareddata.h>
+#include <sgct/sortlastcompositor.h>
 #include <sgct/statisticsrenderer.h>
+#include <sgct/syncrecording.h>
 #include <sgct/texturemanager.h>
+#include <sgct/threadpolicy.h>
+#include <sgct/tracer.h>
 #ifdef SGCT_HAS_VRPN
 #include <sgct/trackingmanager.h>
 #endif // SGCT_HAS_VRPN
 #include <sgct/version.h>
+#include <sgct/viewport.h>
 #include <sgct/projection/nonlinearprojection.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <iostream>
-#include <numeric>
 #include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define SGCT_CPU_RELAX() _mm_pause()
+#else // ^^^^ x64 // !x64 vvvv
+#define SGCT_CPU_RELAX() std::this_thread::yield()
+#endif // x64
 
 #ifdef WIN32
 #include <glad/glad_wgl.h>
@@ -63,9 +100,13 @@ namespace {
     std::function<void(double, double, Window*)> gMouseScrollCallback = nullptr;
     std::function<void(std::vector<std::string_view>)> gDropCallback = nullptr;
 
+    // Only set on the master if its input is sent to the clients
+    sgct::InputSync* gInputSync = nullptr;
+
     // For feedback: breaks a frame lock wait condition every time interval
     // (FrameLockTimeout) in order to print waiting message.
     void updateFrameLockLoop(void*) {
+        sgct::ThreadPolicy::apply(sgct::ThreadPolicy::Class::Render, "Lock");
         bool run = true;
 
         while (run) {
@@ -77,9 +118,290 @@ namespace {
         }
     }
 
-    void addValue(std::array<double, Engine::Statistics::HistoryLength>& a, double v) {
-        std::rotate(std::rbegin(a), std::rbegin(a) + 1, std::rend(a));
-        a[0] = v;
+    // The time after which a busy wait for the sync signal returns to the caller so that
+    // it can print waiting messages and check for timeouts
+    constexpr std::chrono::milliseconds SpinWaitDuration(1);
+
+    // The number of times that the busy wait doubles the number of pause instructions
+    // between checks before it starts yielding the rest of its time slice instead
+    constexpr int SpinBackoffSteps = 8;
+
+    // Spins until `isDone` returns true or until SpinWaitDuration has passed. The wait
+    // between two checks starts with a single pause instruction and gets longer with
+    // every unsuccessful check, which avoids the wake-up latency of the condition
+    // variable at the cost of keeping one core busy
+    template <typename Pred>
+    void spinWait(Pred isDone) {
+        ZoneScoped;
+
+        const auto end = std::chrono::steady_clock::now() + SpinWaitDuration;
+        int step = 0;
+        while (!isDone() && std::chrono::steady_clock::now() < end) {
+            if (step < SpinBackoffSteps) {
+                for (int i = 0; i < (1 << step); i++) {
+                    SGCT_CPU_RELAX();
+                }
+                step++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Runs a task for each window with the window's OpenGL context current. The first
+    // window, whose context is the shared context, is handled by the calling thread and
+    // all other windows by a thread of their own. The worker threads release their
+    // context after each task so that the windows can still be used from the main thread
+    // between the tasks
+    class WindowThreads {
+    public:
+        explicit WindowThreads(const std::vector<std::unique_ptr<Window>>& windows) {
+            for (size_t i = 1; i < windows.size(); i++) {
+                _threads.emplace_back(&WindowThreads::loop, this, windows[i].get());
+            }
+            _mainWindow = windows.front().get();
+        }
+
+        ~WindowThreads() {
+            {
+                const std::unique_lock lock(_mutex);
+                _shouldTerminate = true;
+            }
+            _startCond.notify_all();
+            for (std::thread& thread : _threads) {
+                thread.join();
+            }
+        }
+
+        // Returns once the task has finished for all windows and rethrows the first
+        // exception that was thrown by the task
+        void run(const std::function<void(Window&)>& task) {
+            ZoneScoped;
+
+            {
+                const std::unique_lock lock(_mutex);
+                _task = &task;
+                _nFinished = 0;
+                _generation++;
+            }
+            _startCond.notify_all();
+
+            std::exception_ptr error;
+            try {
+                _mainWindow->makeOpenGLContextCurrent();
+                task(*_mainWindow);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            std::unique_lock lock(_mutex);
+            _doneCond.wait(lock, [this]() { return _nFinished == _threads.size(); });
+            _task = nullptr;
+            if (!error) {
+                error = _error;
+            }
+            _error = nullptr;
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        void loop(Window* window) {
+            ThreadPolicy::apply(
+                ThreadPolicy::Class::Render,
+                std::format("Window {}", window->id())
+            );
+
+            uint64_t generation = 0;
+            while (true) {
+                const std::function<void(Window&)>* task = nullptr;
+                {
+                    std::unique_lock lock(_mutex);
+                    _startCond.wait(
+                        lock,
+                        [&]() { return _shouldTerminate || _generation != generation; }
+                    );
+                    if (_shouldTerminate) {
+                        return;
+                    }
+                    generation = _generation;
+                    task = _task;
+                }
+
+                try {
+                    window->makeOpenGLContextCurrent();
+                    (*task)(*window);
+                    Window::releaseContext();
+                }
+                catch (...) {
+                    Window::releaseContext();
+                    const std::unique_lock lock(_mutex);
+                    if (!_error) {
+                        _error = std::current_exception();
+                    }
+                }
+
+                {
+                    const std::unique_lock lock(_mutex);
+                    _nFinished++;
+                }
+                _doneCond.notify_one();
+            }
+        }
+
+        Window* _mainWindow = nullptr;
+        std::vector<std::thread> _threads;
+
+        std::mutex _mutex;
+        std::condition_variable _startCond;
+        std::condition_variable _doneCond;
+        const std::function<void(Window&)>* _task = nullptr;
+        uint64_t _generation = 0;
+        size_t _nFinished = 0;
+        bool _shouldTerminate = false;
+        std::exception_ptr _error;
+    };
+
+    // Swaps the buffers of the windows of a frame on a thread of its own, so that the
+    // main thread does not wait for the vertical retrace or the swap barrier. Only one
+    // frame can be pending, as the back buffers of the next frame can only be written
+    // once the previous frame has been swapped. No OpenGL context is current on the
+    // thread, as the contexts of the windows are used by the main thread in between
+    class PresentThread {
+    public:
+        PresentThread() {
+            _thread = std::thread(&PresentThread::loop, this);
+        }
+
+        ~PresentThread() {
+            {
+                const std::unique_lock lock(_mutex);
+                _shouldTerminate = true;
+            }
+            _cond.notify_all();
+            _thread.join();
+        }
+
+        // Waits until the previous frame has been swapped and then swaps the buffers of
+        // the windows of this frame in their order
+        void present(std::vector<Window*> windows) {
+            ZoneScoped;
+
+            wait();
+            {
+                const std::unique_lock lock(_mutex);
+                _windows = std::move(windows);
+                _isPending = true;
+            }
+            _cond.notify_all();
+        }
+
+        // Returns once the buffers of the pending frame have been swapped and rethrows
+        // the exception that the swap has thrown
+        void wait() {
+            ZoneScoped;
+
+            std::unique_lock lock(_mutex);
+            _cond.wait(lock, [this]() { return !_isPending; });
+            if (_error) {
+                std::exception_ptr error = std::exchange(_error, nullptr);
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        void loop() {
+            ThreadPolicy::apply(ThreadPolicy::Class::Render, "Present");
+
+            while (true) {
+                std::vector<Window*> windows;
+                {
+                    std::unique_lock lock(_mutex);
+                    _cond.wait(lock, [this]() { return _shouldTerminate || _isPending; });
+                    if (_shouldTerminate) {
+                        return;
+                    }
+                    windows = std::move(_windows);
+                }
+
+                std::exception_ptr error;
+                try {
+                    for (Window* window : windows) {
+                        window->present();
+                    }
+                }
+                catch (...) {
+                    error = std::current_exception();
+                }
+
+                {
+                    const std::unique_lock lock(_mutex);
+                    _error = error;
+                    _isPending = false;
+                }
+                _cond.notify_all();
+            }
+        }
+
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _cond;
+        std::vector<Window*> _windows;
+        bool _isPending = false;
+        bool _shouldTerminate = false;
+        std::exception_ptr _error;
+    };
+
+    // The ids of the shared objects that the Engine uses to synchronize its own state
+    constexpr uint32_t ResolutionScaleId = sgct::SharedObjectBase::FirstReservedId;
+    constexpr uint32_t FrameUnchangedId = sgct::SharedObjectBase::FirstReservedId + 1;
+    constexpr uint32_t ClusterFrameNumberId = sgct::SharedObjectBase::FirstReservedId + 2;
+    // FirstReservedId + 3 is used for the state of the trackers by the TrackingManager
+    constexpr uint32_t ConfigId = sgct::SharedObjectBase::FirstReservedId + 4;
+    constexpr uint32_t SwapGroupResetId = sgct::SharedObjectBase::FirstReservedId + 5;
+    constexpr uint32_t MediaReadyId = sgct::SharedObjectBase::FirstReservedId + 6;
+    constexpr uint32_t PresentationTimeId = sgct::SharedObjectBase::FirstReservedId + 7;
+    constexpr uint32_t InputSyncId = sgct::SharedObjectBase::FirstReservedId + 8;
+    constexpr uint32_t LockstepId = sgct::SharedObjectBase::FirstReservedId + 9;
+    constexpr uint32_t CorrectionMeshId = sgct::SharedObjectBase::FirstReservedId + 10;
+
+    // The time in nanoseconds after which the CPU stops waiting for a frame to finish on
+    // the GPU, so that a lost fence does not stop the rendering
+    constexpr uint64_t FrameFenceTimeout = 1'000'000'000;
+
+    // The number of frames between the master's decision to reset the frame counters of
+    // the swap group and the reset, so that all clients have received the frame first
+    constexpr uint32_t SwapGroupResetDelay = 2;
+
+    // The time that a client waits for the master to serve the configuration
+    constexpr double ConfigServerTimeout = 60.0; // seconds
+
+    // The number of simulation hashes that the master keeps for the comparison with the
+    // hashes of the clients, which arrive a few frames later
+    constexpr size_t MaxSimulationHashes = 16;
+
+    // Derives the seed of a simulation step with the SplitMix64 generator, so that the
+    // seeds of consecutive steps are unrelated
+    uint64_t simulationSeed(uint64_t seed, uint64_t step) {
+        uint64_t z = seed + (step + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    void logNodes(const sgct::config::Cluster& cluster) {
+        using namespace sgct;
+
+        Log::Info(std::format("Number of nodes: {}", cluster.nodes.size()));
+        for (size_t i = 0; i < cluster.nodes.size(); i++) {
+            const config::Node& node = cluster.nodes[i];
+            Log::Info(std::format(
+                "\tNode ({}) address: {} [{}]", i, node.address, node.port
+            ));
+        }
     }
 
     Engine::Settings createSettings(config::Cluster cluster, const Configuration& config)
@@ -90,6 +412,10 @@ namespace {
             config.nCaptureThreads.value_or(res.capture.nCaptureThreads);
         res.createDebugContext =
             config.useOpenGLDebugContext.value_or(res.createDebugContext);
+        if (cluster.settings && cluster.settings->display) {
+            res.headless = cluster.settings->display->headless.value_or(res.headless);
+        }
+        res.headless = config.headless.value_or(res.headless);
         res.capture.capturePath = config.screenshotPath.value_or(res.capture.capturePath);
         res.capture.prefix = config.screenshotPrefix.value_or(res.capture.prefix);
         res.capture.addNodeName =
@@ -97,11 +423,35 @@ namespace {
         if (config.omitWindowNameInScreenshot) {
             res.capture.addWindowName = !(*config.omitWindowNameInScreenshot);
         }
+        if (config.benchmarkFrames) {
+            res.benchmark = Engine::Settings::BenchmarkSettings {
+                .nFrames = *config.benchmarkFrames,
+                .output = config.benchmarkPath.value_or(std::filesystem::path()),
+                .cameraPath = config.benchmarkCameraPath.value_or(std::filesystem::path())
+            };
+        }
         if (cluster.settings) {
             if (cluster.settings->display) {
-                res.swapInterval = cluster.settings->display->swapInterval.value_or(
-                    res.swapInterval
-                );
+                const config::Settings::Display& display = *cluster.settings->display;
+                res.swapInterval = display.swapInterval.value_or(res.swapInterval);
+                if (display.adaptiveSync.value_or(false)) {
+                    res.swapInterval = -res.swapInterval;
+                }
+                if (display.framePacingMargin) {
+                    res.framePacingMargin = *display.framePacingMargin / 1000.0;
+                }
+                res.lateLatching = display.lateLatching.value_or(res.lateLatching);
+                res.maxFramesInFlight = display.maxFramesInFlight;
+                if (display.resizeDelay) {
+                    res.resizeDelay = *display.resizeDelay / 1000.0;
+                }
+                if (display.targetFrameRate) {
+                    res.dynamicResolutionBudget = 1.0 / *display.targetFrameRate;
+                }
+                res.minResolutionScale =
+                    display.minResolutionScale.value_or(res.minResolutionScale);
+                res.maxResolutionScale =
+                    display.maxResolutionScale.value_or(res.maxResolutionScale);
             }
             res.useDepthTexture =
                 cluster.settings->useDepthTexture.value_or(res.useDepthTexture);
@@ -109,6 +459,70 @@ namespace {
                 cluster.settings->useNormalTexture.value_or(res.useNormalTexture);
             res.usePositionTexture =
                 cluster.settings->usePositionTexture.value_or(res.usePositionTexture);
+            res.useWindowThreads =
+                cluster.settings->useWindowThreads.value_or(res.useWindowThreads);
+            res.usePresentThread =
+                cluster.settings->usePresentThread.value_or(res.usePresentThread);
+            res.useLayeredCubeMaps =
+                cluster.settings->useLayeredCubeMaps.value_or(res.useLayeredCubeMaps);
+            res.cubeMapRefreshInterval =
+                cluster.settings->cubeMapRefreshInterval.value_or(
+                    res.cubeMapRefreshInterval
+                );
+            res.shareCubeMaps =
+                cluster.settings->shareCubeMaps.value_or(res.shareCubeMaps);
+            res.interleaveCubeMapEyes =
+                cluster.settings->interleaveCubeMapEyes.value_or(
+                    res.interleaveCubeMapEyes
+                );
+            res.useCorrectionMeshCache =
+                cluster.settings->useCorrectionMeshCache.value_or(
+                    res.useCorrectionMeshCache
+                );
+            res.loadCorrectionMeshesAsync =
+                cluster.settings->loadCorrectionMeshesAsync.value_or(
+                    res.loadCorrectionMeshesAsync
+                );
+            res.watchCorrectionMeshes =
+                cluster.settings->watchCorrectionMeshes.value_or(
+                    res.watchCorrectionMeshes
+                );
+            res.watchConfig =
+                cluster.settings->watchConfig.value_or(res.watchConfig);
+            res.syncInput = cluster.settings->syncInput.value_or(res.syncInput);
+            if (cluster.settings->lockstep) {
+                const config::Settings::Lockstep& lockstep = *cluster.settings->lockstep;
+                res.lockstepTimestep = lockstep.timestep.value_or(0.01f);
+                res.lockstepMaxSteps = lockstep.maxSteps.value_or(res.lockstepMaxSteps);
+                res.lockstepHashInterval =
+                    lockstep.hashInterval.value_or(res.lockstepHashInterval);
+                res.lockstepSeed = lockstep.seed;
+            }
+            res.shaderCachePath =
+                cluster.settings->shaderCachePath.value_or(res.shaderCachePath);
+            res.statisticsHistoryLength =
+                cluster.settings->statisticsHistoryLength.value_or(
+                    res.statisticsHistoryLength
+                );
+            res.tracePath = cluster.settings->tracePath.value_or(res.tracePath);
+            res.binaryLogPath =
+                cluster.settings->binaryLogPath.value_or(res.binaryLogPath);
+            res.syncRecordPath =
+                cluster.settings->syncRecordPath.value_or(res.syncRecordPath);
+            res.syncReplayPath =
+                cluster.settings->syncReplayPath.value_or(res.syncReplayPath);
+            if (cluster.settings->hitchDetector) {
+                const config::Settings::HitchDetector& hitch =
+                    *cluster.settings->hitchDetector;
+                res.hitchThreshold = hitch.threshold.value_or(3.f);
+                res.hitchCooldown = hitch.cooldown.value_or(res.hitchCooldown);
+                res.hitchPath = hitch.path.value_or(res.hitchPath);
+            }
+            if (cluster.settings->network) {
+                res.busyWaitSync = cluster.settings->network->busyWait.value_or(
+                    res.busyWaitSync
+                );
+            }
         }
         if (cluster.capture) {
             res.capture.capturePath =
@@ -120,6 +534,26 @@ namespace {
                     static_cast<uint64_t>(cluster.capture->range->last)
                 };
             }
+            res.capture.queueDepth = cluster.capture->queueDepth;
+            res.capture.dropWhenFull =
+                cluster.capture->dropWhenFull.value_or(res.capture.dropWhenFull);
+            res.capture.format = cluster.capture->format.value_or(res.capture.format);
+            res.capture.compressionLevel =
+                cluster.capture->compressionLevel.value_or(res.capture.compressionLevel);
+            res.capture.compressionStrategy =
+                cluster.capture->compressionStrategy.value_or(
+                    res.capture.compressionStrategy
+                );
+            res.capture.parallelEncoding =
+                cluster.capture->parallelEncoding.value_or(res.capture.parallelEncoding);
+            res.capture.codec = cluster.capture->codec.value_or(res.capture.codec);
+            res.capture.bitrate = cluster.capture->bitrate.value_or(res.capture.bitrate);
+            res.capture.frameRate =
+                cluster.capture->frameRate.value_or(res.capture.frameRate);
+            res.capture.eightBit =
+                cluster.capture->eightBit.value_or(res.capture.eightBit);
+            res.capture.scale = cluster.capture->scale.value_or(res.capture.scale);
+            res.capture.collect = cluster.capture->collect.value_or(res.capture.collect);
         }
 
         return res;
@@ -127,29 +561,70 @@ namespace {
 
 } // namespace
 
+Engine::Statistics::Statistics(int historyLength)
+    : frametimes(historyLength)
+    , drawTimes(historyLength)
+    , syncTimes(historyLength)
+    , loopTimeMin(historyLength)
+    , loopTimeMax(historyLength)
+    , sendTimeMin(historyLength)
+    , sendTimeMax(historyLength)
+    , preSyncTimes(historyLength)
+    , encodeTimes(historyLength)
+    , decodeTimes(historyLength)
+    , postSyncPreDrawTimes(historyLength)
+    , drawCallbackTimes(historyLength)
+    , draw2DTimes(historyLength)
+    , postDrawTimes(historyLength)
+{}
+
+void Engine::Statistics::setHistoryLength(int historyLength) {
+    frametimes.setLength(historyLength);
+    drawTimes.setLength(historyLength);
+    syncTimes.setLength(historyLength);
+    loopTimeMin.setLength(historyLength);
+    loopTimeMax.setLength(historyLength);
+    sendTimeMin.setLength(historyLength);
+    sendTimeMax.setLength(historyLength);
+    preSyncTimes.setLength(historyLength);
+    encodeTimes.setLength(historyLength);
+    decodeTimes.setLength(historyLength);
+    postSyncPreDrawTimes.setLength(historyLength);
+    drawCallbackTimes.setLength(historyLength);
+    draw2DTimes.setLength(historyLength);
+    postDrawTimes.setLength(historyLength);
+}
+
 double Engine::Statistics::dt() const {
-    return frametimes.front();
+    return frametimes.newest();
 }
 
 double Engine::Statistics::avgDt() const {
-    const double accFT = std::accumulate(frametimes.begin(), frametimes.end(), 0.0);
-    const int nValues = static_cast<int>(std::count_if(
-        frametimes.cbegin(),
-        frametimes.cend(),
-        [](double d) { return d != 0.0; }
-    ));
-    // We must take the frame counter into account as the history might not be filled yet
-    const unsigned int frameCounter = Engine::instance().currentFrameNumber();
-    const unsigned f = std::clamp<unsigned int>(frameCounter, 1, nValues);
-    return accFT / f;
+    // The history might not be filled yet, so only the values that exist are averaged
+    const int n = frametimes.size();
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) {
+        sum += frametimes[i];
+    }
+    return n > 0 ? sum / n : 0.0;
 }
 
 double Engine::Statistics::minDt() const {
-    return *std::min_element(frametimes.begin(), frametimes.end());
+    const int n = frametimes.size();
+    double res = frametimes.newest();
+    for (int i = 1; i < n; i++) {
+        res = std::min(res, frametimes[i]);
+    }
+    return res;
 }
 
 double Engine::Statistics::maxDt() const {
-    return *std::max_element(frametimes.begin(), frametimes.end());
+    const int n = frametimes.size();
+    double res = frametimes.newest();
+    for (int i = 1; i < n; i++) {
+        res = std::max(res, frametimes[i]);
+    }
+    return res;
 }
 
 Engine* Engine::_instance = nullptr;
@@ -187,6 +662,25 @@ void Engine::destroy() {
     _instance = nullptr;
 }
 
+config::Cluster loadCluster(const Configuration& config) {
+    ZoneScoped;
+
+    if (config.configServerAddress && config.configServerPort) {
+        config::Cluster cluster = fetchConfig(
+            *config.configServerAddress,
+            *config.configServerPort,
+            ConfigServerTimeout
+        );
+        logNodes(cluster);
+        return cluster;
+    }
+    return loadCluster(
+        config.configFilename ?
+            std::optional<std::filesystem::path>(*config.configFilename) :
+            std::nullopt
+    );
+}
+
 config::Cluster loadCluster(std::optional<std::filesystem::path> path) {
     ZoneScoped;
 
@@ -197,14 +691,7 @@ config::Cluster loadCluster(std::optional<std::filesystem::path> path) {
             config::Cluster cluster = readConfig(*path);
 
             Log::Debug("Config file read successfully");
-            Log::Info(std::format("Number of nodes: {}", cluster.nodes.size()));
-
-            for (size_t i = 0; i < cluster.nodes.size(); i++) {
-                const config::Node& node = cluster.nodes[i];
-                Log::Info(std::format(
-                    "\tNode ({}) address: {} [{}]", i, node.address, node.port
-                ));
-            }
+            logNodes(cluster);
             return cluster;
         }
         catch (const std::runtime_error& e) {
@@ -230,7 +717,10 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     : _preWindowFn(std::move(callbacks.preWindow))
     , _initOpenGLFn(std::move(callbacks.initOpenGL))
     , _preSyncFn(std::move(callbacks.preSync))
+    , _externalControlFn(std::move(callbacks.externalControl))
     , _postSyncPreDrawFn(std::move(callbacks.postSyncPreDraw))
+    , _simulateFn(std::move(callbacks.simulate))
+    , _simulationHashFn(std::move(callbacks.simulationHash))
     , _drawFn(std::move(callbacks.draw))
     , _draw2DFn(std::move(callbacks.draw2D))
     , _postDrawFn(std::move(callbacks.postDraw))
@@ -239,15 +729,117 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
 {
     ZoneScoped;
 
+    _statistics.setHistoryLength(_settings.statisticsHistoryLength);
+
     SharedData::instance().setEncodeFunction(std::move(callbacks.encode));
     SharedData::instance().setDecodeFunction(std::move(callbacks.decode));
 
+    // The capture threads run alongside the jobs, so they share the hardware threads
+    const int nHardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    _jobSystem = std::make_unique<JobSystem>(
+        std::max(nHardwareThreads - _settings.capture.nCaptureThreads, 1)
+    );
+
+    if (_settings.benchmark) {
+        // The benchmark scene replaces the content of the application
+        _drawFn = [](const RenderData& data) {
+            Engine::instance()._benchmark->draw(data);
+        };
+        _draw2DFn = nullptr;
+    }
+    // The renderers only receive the wrappers, which measure the time of each call
+    if (_drawFn) {
+        _userDrawFn = _drawFn;
+        _drawFn = [](const RenderData& data) {
+            Engine& engine = Engine::instance();
+            const double t0 = glfwGetTime();
+            engine._userDrawFn(data);
+            engine._drawCallbackTime += glfwGetTime() - t0;
+        };
+    }
+    if (_draw2DFn) {
+        _userDraw2DFn = _draw2DFn;
+        _draw2DFn = [](const RenderData& data) {
+            Engine& engine = Engine::instance();
+            const double t0 = glfwGetTime();
+            engine._userDraw2DFn(data);
+            engine._draw2DCallbackTime += glfwGetTime() - t0;
+        };
+    }
+
+    _isFrameUnchanged = std::make_unique<SharedObject<bool>>(FrameUnchangedId, false);
+    _presentationTime = std::make_unique<SharedObject<double>>(PresentationTimeId, 0.0);
+    _correctionMeshSync = std::make_unique<CorrectionMeshSync>(CorrectionMeshId);
+    const bool useSwapGroups = std::any_of(
+        cluster.nodes.cbegin(),
+        cluster.nodes.cend(),
+        [](const config::Node& node) { return node.swapLock.value_or(false); }
+    );
+    if (useSwapGroups) {
+        // The reset frame is compared with the master's frame number
+        _swapGroupReset = std::make_unique<SharedObject<uint32_t>>(SwapGroupResetId, 0);
+    }
+    // The jitter of the temporal anti-aliasing has to be the same on all nodes
+    const bool useTaa = std::any_of(
+        cluster.nodes.cbegin(),
+        cluster.nodes.cend(),
+        [](const config::Node& node) {
+            return std::any_of(
+                node.windows.cbegin(),
+                node.windows.cend(),
+                [](const config::Window& w) { return w.useTaa.value_or(false); }
+            );
+        }
+    );
+    if (_settings.cubeMapRefreshInterval > 1 || _settings.benchmark || useSwapGroups ||
+        useTaa)
+    {
+        _clusterFrameNumber = std::make_unique<SharedObject<uint32_t>>(
+            ClusterFrameNumberId,
+            0
+        );
+    }
+    if (_settings.lockstepTimestep) {
+        // The seed of the clients is replaced by the master's with the first frame
+        const uint64_t seed = _settings.lockstepSeed.value_or(
+            (static_cast<uint64_t>(std::random_device()()) << 32) |
+            std::random_device()()
+        );
+        _lockstepFrame = std::make_unique<SharedObject<LockstepFrame>>(
+            LockstepId,
+            LockstepFrame{ .seed = seed }
+        );
+    }
+    if (_settings.dynamicResolutionBudget) {
+        // Created on all nodes, so that the clients receive the master's scale
+        _resolutionScale = std::make_unique<SharedObject<float>>(
+            ResolutionScaleId,
+            std::clamp(1.f, _settings.minResolutionScale, _settings.maxResolutionScale)
+        );
+    }
+
     gKeyboardCallback = std::move(callbacks.keyboard);
     gCharCallback = std::move(callbacks.character);
     gMouseButtonCallback = std::move(callbacks.mouseButton);
     gMousePosCallback = std::move(callbacks.mousePos);
     gMouseScrollCallback = std::move(callbacks.mouseScroll);
     gDropCallback = std::move(callbacks.drop);
+    // The lockstep simulation relies on all nodes receiving the same input
+    const bool syncInput = _settings.syncInput || _settings.lockstepTimestep.has_value();
+    if (syncInput && cluster.nodes.size() > 1) {
+        // Created on all nodes, so that the clients receive the input of the master
+        _inputSync = std::make_unique<InputSync>(
+            InputSyncId,
+            InputSync::Callbacks{
+                .keyboard = gKeyboardCallback,
+                .character = gCharCallback,
+                .mouseButton = gMouseButtonCallback,
+                .mousePos = gMousePosCallback,
+                .mouseScroll = gMouseScrollCallback,
+                .drop = gDropCallback
+            }
+        );
+    }
 
     NetworkManager::NetworkMode netMode = NetworkManager::NetworkMode::Remote;
     if (config.isServer) {
@@ -258,6 +850,18 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     if (config.logLevel) {
         Log::instance().setNotifyLevel(*config.logLevel);
     }
+    // Configured before any of the threads is started, as each thread applies the
+    // settings of its class only when it starts
+    if (cluster.settings && cluster.settings->threads) {
+        ThreadPolicy::configure(*cluster.settings->threads);
+    }
+    if (cluster.settings && cluster.settings->buffers) {
+        BufferPolicy::configure(*cluster.settings->buffers);
+    }
+    ThreadPolicy::apply(ThreadPolicy::Class::Render, "");
+    if (config.asyncLog) {
+        Log::instance().setAsynchronous(*config.asyncLog);
+    }
     if (config.showHelpText) {
         std::cout << helpMessage() << '\n';
         std::exit(0);
@@ -281,10 +885,28 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
                 throw Err(3010, std::format("GLFW error ({}): {}", error, desc));
             }
         );
+        if (_settings.headless) {
+#ifdef GLFW_PLATFORM_NULL
+            // The null platform does not need a display server, and its windows only
+            // exist as the surfaces of their EGL contexts
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else // ^^^^ GLFW_PLATFORM_NULL // !GLFW_PLATFORM_NULL vvvv
+            Log::Warning(
+                "This version of GLFW has no null platform, so the headless mode uses "
+                "hidden windows of the window system"
+            );
+#endif // GLFW_PLATFORM_NULL
+        }
         const int res = glfwInit();
         if (res == GLFW_FALSE) {
             throw Err(3000, "Failed to initialize GLFW");
         }
+#ifdef GLFW_PLATFORM_NULL
+        if (_settings.headless) {
+            // The hint applies to the contexts of all windows that are created later
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        }
+#endif // GLFW_PLATFORM_NULL
     }
 
     Log::Info(std::format("SGCT version: {}", Version));
@@ -292,11 +914,80 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     Log::Debug("Validating cluster configuration");
     config::validateCluster(cluster);
 
+    // The collected screenshots and the distributed media are sent as data transfers,
+    // which are handled by the collector and the distributor instead of the application
+    if (_settings.capture.collect) {
+        _captureCollector = std::make_unique<CaptureCollector>();
+    }
+    _mediaDistributor = std::make_unique<MediaDistributor>(MediaReadyId, *_jobSystem);
+    _cubeFaceDistributor = std::make_unique<CubeFaceDistributor>();
+    _sortLastCompositor = std::make_unique<SortLastCompositor>();
+    auto decode = callbacks.dataTransferDecode;
+    auto decodeFn = [this, decode](void* data, int length, int packageId, int client) {
+        if (packageId == MediaDistributor::PackageId) {
+            if (_mediaDistributor) {
+                _mediaDistributor->receiveReport(data, length, client);
+            }
+        }
+        else if (packageId == CubeFaceDistributor::PackageId) {
+            if (_cubeFaceDistributor) {
+                _cubeFaceDistributor->receive(data, length);
+            }
+        }
+        else if (packageId == SortLastCompositor::PackageId) {
+            if (_sortLastCompositor) {
+                _sortLastCompositor->receive(data, length);
+            }
+        }
+        else if (decode) {
+            decode(data, length, packageId, client);
+        }
+    };
+    auto acknowledge = callbacks.dataTransferAcknowledge;
+    auto acknowledgeFn = [acknowledge](int packageId, int client) {
+        if (packageId != MediaDistributor::PackageId &&
+            packageId != CubeFaceDistributor::PackageId &&
+            packageId != SortLastCompositor::PackageId && acknowledge)
+        {
+            acknowledge(packageId, client);
+        }
+    };
+    auto chunk = callbacks.dataTransferChunk;
+    auto chunkFn = [this, chunk](void* data, int length, uint64_t offset, uint64_t total,
+                                 int packageId, int client)
+    {
+        if (packageId == CaptureCollector::PackageId) {
+            if (_captureCollector) {
+                _captureCollector->receive(data, length, offset, total, client);
+            }
+        }
+        else if (packageId == MediaDistributor::PackageId) {
+            if (_mediaDistributor) {
+                _mediaDistributor->receive(data, length, offset, total);
+            }
+        }
+        else if (chunk) {
+            chunk(data, length, offset, total, packageId, client);
+        }
+    };
+    auto progress = callbacks.dataTransferProgress;
+    auto progressFn = [progress](int packageId, int client, uint64_t received,
+                                 uint64_t total)
+    {
+        if (packageId != CaptureCollector::PackageId &&
+            packageId != MediaDistributor::PackageId && progress)
+        {
+            progress(packageId, client, received, total);
+        }
+    };
+
     NetworkManager::create(
         netMode,
-        std::move(callbacks.dataTransferDecode),
+        std::move(decodeFn),
         std::move(callbacks.dataTransferStatus),
-        std::move(callbacks.dataTransferAcknowledge)
+        std::move(acknowledgeFn),
+        std::move(chunkFn),
+        std::move(progressFn)
     );
 #ifdef SGCT_HAS_VRPN
     for (const config::Tracker& tracker : cluster.trackers) {
@@ -343,11 +1034,88 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     }
 
     NetworkManager::instance().initialize();
+
+    const bool isServer = NetworkManager::instance().isComputerServer();
+    if (isServer && config.configServePort) {
+        _configServer = std::make_unique<ConfigServer>(cluster, *config.configServePort);
+    }
+    if (_settings.watchConfig) {
+        _config = std::make_unique<SharedObject<std::string>>(ConfigId);
+        _appliedConfig = serializeConfig(cluster);
+        if (isServer && config.configFilename) {
+            _configPath = *config.configFilename;
+            std::error_code ec;
+            const std::filesystem::file_time_type time =
+                std::filesystem::last_write_time(_configPath, ec);
+            _configWriteTime = ec ? std::nullopt : std::optional(time);
+        }
+    }
+
+    if (!_settings.tracePath.empty()) {
+        Tracer::enable(_settings.tracePath, clusterId);
+        Tracer::setThreadName("Main");
+    }
+    if (_settings.hitchThreshold) {
+        // The reports refer to the trace of the frames before the hitch, so the tracer
+        // records into the folder of the reports unless it already records elsewhere
+        if (!Tracer::isEnabled()) {
+            Tracer::enable(_settings.hitchPath, clusterId);
+            Tracer::setThreadName("Main");
+        }
+        _hitchDetector = std::make_unique<HitchDetector>(
+            _settings.hitchPath,
+            *_settings.hitchThreshold,
+            _settings.hitchCooldown,
+            clusterId
+        );
+    }
+    if (!_settings.binaryLogPath.empty()) {
+        BinaryLog::enable(_settings.binaryLogPath, clusterId);
+    }
+    // Only the master sends the shared data, so the clients ignore the recordings
+    if (isServer && !_settings.syncReplayPath.empty()) {
+        _syncReplay = std::make_unique<SyncReplay>(_settings.syncReplayPath);
+    }
+    else if (isServer && !_settings.syncRecordPath.empty()) {
+        _syncRecorder = SyncRecorder::create(_settings.syncRecordPath);
+    }
 }
 
 void Engine::initialize() {
     ZoneScoped;
 
+    const double startTime = glfwGetTime();
+
+    // The images and correction meshes of the viewports are read from disk while the
+    // windows are created, which only uses the main thread and the GPU. If the meshes are
+    // loaded asynchronously, the viewports are rendered without them until they are ready
+    const Node& node = ClusterManager::instance().thisNode();
+    std::vector<JobSystem::Job> preparation;
+    for (const std::unique_ptr<Window>& window : node.windows()) {
+        for (const std::unique_ptr<Viewport>& vp : window->viewports()) {
+            preparation.push_back(
+                _jobSystem->submit([vp = vp.get()]() { vp->prepareData(); })
+            );
+            JobSystem::Job mesh = vp->prepareMesh();
+            if (!_settings.loadCorrectionMeshesAsync) {
+                preparation.push_back(std::move(mesh));
+            }
+        }
+    }
+
+#ifdef __linux__
+    // The frames can only be exported as dmabufs from EGL contexts, and all windows have
+    // to use the same API to share their contexts
+    const bool hasFrameExport = std::any_of(
+        node.windows().begin(),
+        node.windows().end(),
+        [](const std::unique_ptr<Window>& w) { return w->hasFrameExport(); }
+    );
+    if (hasFrameExport) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    }
+#endif // __linux__
+
     int major = 0;
     int minor = 0;
     {
@@ -376,6 +1144,7 @@ void Engine::initialize() {
     Log::Info(std::format("Detected OpenGL version: {}.{}", major, minor));
 
     initWindows(major, minor);
+    const double windowsTime = glfwGetTime();
 
     // Window resolution may have been set by the config. However, it only sets a pending
     // resolution, so it needs to apply it using the same routine as in the end of a frame
@@ -388,69 +1157,104 @@ void Engine::initialize() {
         ClusterManager::instance().setUseIgnoreSync(true);
     }
 
+    if (_inputSync && NetworkManager::instance().isComputerServer()) {
+        gInputSync = _inputSync.get();
+    }
+
+    // When the input is synchronized, the clients replay the input of the master instead
+    // of taking their own, so their windows do not report any input
+    const bool hasInput = !_inputSync || NetworkManager::instance().isComputerServer();
+
     for (const std::unique_ptr<Window>& window : wins) {
         GLFWwindow* win = window->windowHandle();
-        if (gKeyboardCallback) {
+        if (hasInput && gKeyboardCallback) {
             glfwSetKeyCallback(
                 win,
                 [](GLFWwindow* w, int key, int scancode, int a, int m) {
-                    void* sgctWindow = glfwGetWindowUserPointer(w);
+                    Window* sgctWindow =
+                        reinterpret_cast<Window*>(glfwGetWindowUserPointer(w));
+                    if (gInputSync) {
+                        gInputSync->addKey(
+                            Key(key),
+                            Modifier(m),
+                            Action(a),
+                            scancode,
+                            sgctWindow
+                        );
+                    }
                     gKeyboardCallback(
                         Key(key),
                         Modifier(m),
                         Action(a),
                         scancode,
-                        reinterpret_cast<Window*>(sgctWindow)
+                        sgctWindow
                     );
                 }
             );
         }
-        if (gMouseButtonCallback) {
+        if (hasInput && gMouseButtonCallback) {
             glfwSetMouseButtonCallback(
                 win,
                 [](GLFWwindow* w, int b, int a, int m) {
-                    void* sgctWindow = glfwGetWindowUserPointer(w);
+                    Window* sgctWindow =
+                        reinterpret_cast<Window*>(glfwGetWindowUserPointer(w));
+                    if (gInputSync) {
+                        gInputSync->addMouseButton(
+                            MouseButton(b),
+                            Modifier(m),
+                            Action(a),
+                            sgctWindow
+                        );
+                    }
                     gMouseButtonCallback(
                         MouseButton(b),
                         Modifier(m),
                         Action(a),
-                        reinterpret_cast<Window*>(sgctWindow)
+                        sgctWindow
                     );
                 }
             );
         }
-        if (gMousePosCallback) {
+        if (hasInput && gMousePosCallback) {
             glfwSetCursorPosCallback(
                 win,
                 [](GLFWwindow* w, double xPos, double yPos) {
-                    void* sgctWindow = glfwGetWindowUserPointer(w);
-                    gMousePosCallback(xPos, yPos, reinterpret_cast<Window*>(sgctWindow));
+                    Window* sgctWindow =
+                        reinterpret_cast<Window*>(glfwGetWindowUserPointer(w));
+                    if (gInputSync) {
+                        gInputSync->addMousePosition(xPos, yPos, sgctWindow);
+                    }
+                    gMousePosCallback(xPos, yPos, sgctWindow);
                 }
             );
         }
-        if (gCharCallback) {
+        if (hasInput && gCharCallback) {
             glfwSetCharModsCallback(
                 win,
                 [](GLFWwindow* w, unsigned int ch, int mod) {
-                    void* sgctWindow = glfwGetWindowUserPointer(w);
-                    gCharCallback(ch, mod, reinterpret_cast<Window*>(sgctWindow));
+                    Window* sgctWindow =
+                        reinterpret_cast<Window*>(glfwGetWindowUserPointer(w));
+                    if (gInputSync) {
+                        gInputSync->addCharacter(ch, mod, sgctWindow);
+                    }
+                    gCharCallback(ch, mod, sgctWindow);
                 }
             );
         }
-        if (gMouseScrollCallback) {
+        if (hasInput && gMouseScrollCallback) {
             glfwSetScrollCallback(
                 win,
                 [](GLFWwindow* w, double xOffset, double yOffset) {
-                    void* sgctWindow = glfwGetWindowUserPointer(w);
-                    gMouseScrollCallback(
-                        xOffset,
-                        yOffset,
-                        reinterpret_cast<Window*>(sgctWindow)
-                    );
+                    Window* sgctWindow =
+                        reinterpret_cast<Window*>(glfwGetWindowUserPointer(w));
+                    if (gInputSync) {
+                        gInputSync->addMouseScroll(xOffset, yOffset, sgctWindow);
+                    }
+                    gMouseScrollCallback(xOffset, yOffset, sgctWindow);
                 }
             );
         }
-        if (gDropCallback) {
+        if (hasInput && gDropCallback) {
             glfwSetDropCallback(
                 win,
                 [](GLFWwindow*, int count, const char** paths) {
@@ -459,6 +1263,9 @@ void Engine::initialize() {
                     for (int i = 0; i < count; i++) {
                         p.emplace_back(paths[i]);
                     }
+                    if (gInputSync) {
+                        gInputSync->addDrop(p);
+                    }
                     gDropCallback(std::move(p));
                 }
             );
@@ -488,6 +1295,7 @@ void Engine::initialize() {
     }
 #endif // SGCT_HAS_NDI
 
+    const double applicationTime = glfwGetTime();
     if (_initOpenGLFn) {
         Log::Info("Calling initialization callback");
         ZoneScopedN("[SGCT] OpenGL Initialization");
@@ -495,7 +1303,10 @@ void Engine::initialize() {
         _initOpenGLFn(share);
     }
 
+    const double initializeTime = glfwGetTime();
     std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::initialize));
+    const double buffersTime = glfwGetTime();
+    Log::Info(RenderTargetPool::report());
 
     updateFrustums();
 
@@ -507,11 +1318,14 @@ void Engine::initialize() {
 #else // !WIN32 && !__APPLE__
     constexpr std::string_view FontName = "FreeSansBold.ttf";
 #endif // WIN32
+    // This only registers the file, which is loaded when the font is first used
     text::FontManager::instance().addFont("SGCTFont", std::string(FontName));
 #endif // SGCT_HAS_TEXT
 
     // init draw buffer resolution
+    const double connectionTime = glfwGetTime();
     waitForAllWindowsInSwapGroupToOpen();
+    const double connectedTime = glfwGetTime();
     // init swap group if enabled
     if (thisNode.isUsingSwapGroups()) {
         Window::initNvidiaSwapGroups();
@@ -521,13 +1335,72 @@ void Engine::initialize() {
     Window::setBarrier(true);
     Window::resetSwapGroupFrameNumber();
 
+    const double preparationTime = glfwGetTime();
+    for (const JobSystem::Job& job : preparation) {
+        _jobSystem->wait(job);
+    }
+    const double dataTime = glfwGetTime();
     std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::initializeContextSpecific));
+    const double endTime = glfwGetTime();
+
+    Log::Info(std::format(
+        "Startup took {:.3f} s: Creating windows {:.3f} s, initializing buffers and "
+        "shaders {:.3f} s, waiting for viewport data {:.3f} s, uploading viewport data "
+        "{:.3f} s",
+        endTime - startTime, windowsTime - startTime, buffersTime - initializeTime,
+        dataTime - preparationTime, endTime - dataTime
+    ));
+
+    // The time of GLFW starts when it is initialized at the creation of the engine
+    waitForAllNodesToBeReady(Network::StartupTimes{
+        .total = static_cast<float>(endTime),
+        .windows = static_cast<float>(windowsTime - startTime),
+        .application = static_cast<float>(initializeTime - applicationTime),
+        .shaders = static_cast<float>(buffersTime - initializeTime),
+        .connection = static_cast<float>(connectedTime - connectionTime),
+        .viewportData = static_cast<float>(endTime - preparationTime)
+    });
+
+    if (ClusterManager::instance().metricsPort() > 0) {
+        _metricsExporter = std::make_unique<MetricsExporter>(
+            _statistics,
+            ClusterManager::instance().metricsPort()
+        );
+    }
+
+    // Only the master is controlled, which passes the changes on in its shared data
+    const int controlPort = ClusterManager::instance().controlPort();
+    const int controlUdpPort = ClusterManager::instance().controlUdpPort();
+    if (NetworkManager::instance().isComputerServer() &&
+        (controlPort > 0 || controlUdpPort > 0))
+    {
+        _externalControl = std::make_unique<ExternalControl>(controlPort, controlUdpPort);
+    }
+
+    if (_settings.benchmark) {
+        const Settings::BenchmarkSettings& benchmark = *_settings.benchmark;
+        std::filesystem::path output = benchmark.output;
+        if (output.empty()) {
+            output = std::format(
+                "benchmark-node{}.json",
+                ClusterManager::instance().thisNodeId()
+            );
+        }
+        _benchmark = std::make_unique<Benchmark>(
+            benchmark.nFrames,
+            std::move(output),
+            benchmark.cameraPath
+        );
+    }
 
 #ifdef SGCT_HAS_VRPN
     // start sampling tracking data
     if (isMaster()) {
         TrackingManager::instance().startSampling();
     }
+    else {
+        TrackingManager::instance().startReceiving();
+    }
 #endif // SGCT_HAS_VRPN
 }
 
@@ -538,6 +1411,36 @@ Engine::~Engine() {
     // if the configuration was illformed
     const ClusterManager& cm = ClusterManager::instance();
     const bool hasNode = cm.thisNodeId() > -1 && cm.thisNodeId() < cm.numberOfNodes();
+
+    // The screenshots are compressed by the job system, so the ones that are still
+    // waiting to be saved have to be finished before it is stopped
+    if (hasNode) {
+        Window::makeSharedContextCurrent();
+        for (const std::unique_ptr<Window>& win : cm.thisNode().windows()) {
+            win->flushScreenshots();
+        }
+    }
+
+    // The exporter reads from the capture collector and the network connections
+    _metricsExporter = nullptr;
+    _hitchDetector = nullptr;
+    _syncRecorder = nullptr;
+    _syncReplay = nullptr;
+    _configServer = nullptr;
+    _externalControl = nullptr;
+
+    // The collected screenshots are sent while the network connections still exist
+    _captureCollector = nullptr;
+
+    // The distributor waits for its decoding jobs, so it is destroyed before the workers
+    _mediaDistributor = nullptr;
+    _cubeFaceDistributor = nullptr;
+    _sortLastCompositor = nullptr;
+
+    // The remaining jobs are finished first as they might use resources that are
+    // released by the cleanup callback
+    _jobSystem = nullptr;
+
     if (hasNode) {
         Window::makeSharedContextCurrent();
         if (_cleanupFn) {
@@ -578,6 +1481,11 @@ Engine::~Engine() {
     Log::Debug("Destroying network manager");
     NetworkManager::destroy();
 
+    joystick::stopSampling();
+
+    // All threads that write events have ended with the network connections
+    BinaryLog::disable();
+
     // Shared contex
     if (hasNode && !cm.thisNode().windows().empty()) {
         Window::makeSharedContextCurrent();
@@ -587,6 +1495,7 @@ Engine::~Engine() {
     ShaderManager::destroy();
 
     _statisticsRenderer = nullptr;
+    _benchmark = nullptr;
 
     Log::Debug("Destroying texture manager");
     TextureManager::destroy();
@@ -601,12 +1510,39 @@ Engine::~Engine() {
         cm.thisNode().windows().front()->makeOpenGLContextCurrent();
     }
 
+    const SharedData::Statistics stats = SharedData::instance().statistics();
+    if (stats.nBlocks > 0) {
+        Log::Debug(std::format(
+            "Shared data: {} blocks, peak size {} bytes, average size {:.1f} bytes, "
+            "{} buffer resizes",
+            stats.nBlocks, stats.peakSize, stats.averageSize, stats.nResizes
+        ));
+    }
+
+#ifdef SGCT_HAS_VRPN
+    // The tracking state is shared, so it has to be removed before the shared data
+    Log::Debug("Destroying tracking manager");
+    TrackingManager::destroy();
+#endif // SGCT_HAS_VRPN
+
+    _resolutionScale = nullptr;
+    _isFrameUnchanged = nullptr;
+    _presentationTime = nullptr;
+    _clusterFrameNumber = nullptr;
+    _lockstepFrame = nullptr;
+    _config = nullptr;
+    gInputSync = nullptr;
+    _inputSync = nullptr;
+    _correctionMeshSync = nullptr;
     Log::Debug("Destroying shared data");
     SharedData::destroy();
 
     Log::Debug("Destroying cluster manager");
     ClusterManager::destroy();
 
+    // Anything that is still in use at this point belongs to the application or leaked
+    Log::Debug(MemoryTracker::report());
+
     Log::Debug("Destroying message handler");
     Log::destroy();
 
@@ -684,6 +1620,7 @@ void Engine::terminate() {
 
 void Engine::frameLockPreStage() {
     ZoneScoped;
+    TraceScopedN("Frame lock pre stage");
 
     NetworkManager& nm = NetworkManager::instance();
 
@@ -692,11 +1629,46 @@ void Engine::frameLockPreStage() {
     using P = std::pair<double, double>;
     std::optional<P> minMax = nm.sync(NetworkManager::SyncMode::SendDataToClients);
     if (minMax) {
-        addValue(_statistics.loopTimeMin, minMax->first);
-        addValue(_statistics.loopTimeMax, minMax->second);
+        _statistics.loopTimeMin.add(minMax->first);
+        _statistics.loopTimeMax.add(minMax->second);
+
+        _statistics.sendTimes.clear();
+        for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+            const Network& connection = nm.syncConnection(i);
+            if (connection.isConnected()) {
+                _statistics.sendTimes.push_back(connection.sendTime());
+            }
+        }
+        if (!_statistics.sendTimes.empty()) {
+            const auto [min, max] = std::minmax_element(
+                _statistics.sendTimes.cbegin(),
+                _statistics.sendTimes.cend()
+            );
+            _statistics.sendTimeMin.add(*min);
+            _statistics.sendTimeMax.add(*max);
+        }
     }
     if (nm.isComputerServer()) {
-        addValue(_statistics.syncTimes, static_cast<float>(glfwGetTime() - ts));
+        _statistics.syncTimes.add(static_cast<float>(glfwGetTime() - ts));
+    }
+
+    _statistics.clockOffsets.clear();
+    _statistics.latencies.clear();
+    _statistics.jitters.clear();
+    for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+        const Network& connection = nm.syncConnection(i);
+        if (connection.isConnected()) {
+            _statistics.clockOffsets.push_back(connection.clockOffset());
+            _statistics.latencies.push_back(connection.latency());
+            _statistics.jitters.push_back(connection.jitter());
+        }
+    }
+    if (Tracer::isEnabled()) {
+        // The clock offset changes slowly, so it is enough to update it once per frame
+        Tracer::setClockOffset(nm.masterTime() - time());
+    }
+    if (BinaryLog::isEnabled()) {
+        BinaryLog::setClockOffset(nm.masterTime() - time());
     }
 
     // run only on clients
@@ -705,10 +1677,16 @@ void Engine::frameLockPreStage() {
     }
 
     // not server
+    nm.releaseSyncData();
     const double t0 = glfwGetTime();
     while (nm.isRunning() && !nm.isSyncComplete()) {
-        std::unique_lock lk(FrameSync);
-        NetworkManager::cond.wait(lk);
+        if (_settings.busyWaitSync) {
+            spinWait([&nm]() { return !nm.isRunning() || nm.isSyncComplete(); });
+        }
+        else {
+            std::unique_lock lk(FrameSync);
+            NetworkManager::cond.wait(lk);
+        }
 
         if (glfwGetTime() - t0 <= 1.0) {
             continue;
@@ -738,13 +1716,22 @@ void Engine::frameLockPreStage() {
     // A this point all data needed for rendering a frame is received.
     // Let's signal that back to the master/server.
     nm.sync(NetworkManager::SyncMode::Acknowledge);
+
+    // The received data is decoded after the acknowledgement so that the master can
+    // continue while the data is applied
+    SharedData::instance().applyReceivedData();
     if (!nm.isComputerServer()) {
-        addValue(_statistics.syncTimes, glfwGetTime() - t0);
+        _statistics.syncTimes.add(glfwGetTime() - t0);
     }
+    BinaryLogN(
+        "Frame {}: waited {:.3f} ms for the master",
+        _frameCounter, (glfwGetTime() - t0) * 1000.0
+    );
 }
 
 void Engine::frameLockPostStage() {
     ZoneScoped;
+    TraceScopedN("Frame lock post stage");
 
     const NetworkManager& nm = NetworkManager::instance();
     // post stage
@@ -752,10 +1739,40 @@ void Engine::frameLockPostStage() {
         return;
     }
 
+    const double deadline = ClusterManager::instance().syncDeadline();
     const double t0 = glfwGetTime();
     while (nm.isRunning() && nm.activeConnectionsCount() > 0 && !nm.isSyncComplete()) {
-        std::unique_lock lk(FrameSync);
-        NetworkManager::cond.wait(lk);
+        const double elapsed = glfwGetTime() - t0;
+        if (deadline > 0.0 && elapsed > deadline && nm.isCriticalSyncComplete()) {
+            // Continue without the nodes that missed the deadline, they will catch up by
+            // skipping to the newest frame
+            _statistics.skippedFrames.resize(nm.syncConnectionsCount(), 0);
+            for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+                const Network& connection = nm.syncConnection(i);
+                if (connection.isConnected() && !connection.isUpdated()) {
+                    _statistics.skippedFrames[i]++;
+                }
+            }
+            break;
+        }
+
+        if (_settings.busyWaitSync) {
+            spinWait([&nm]() {
+                return !nm.isRunning() || nm.activeConnectionsCount() == 0 ||
+                       nm.isSyncComplete();
+            });
+        }
+        else if (deadline > 0.0 && elapsed < deadline) {
+            std::unique_lock lk(FrameSync);
+            NetworkManager::cond.wait_for(
+                lk,
+                std::chrono::duration<double>(deadline - elapsed)
+            );
+        }
+        else {
+            std::unique_lock lk(FrameSync);
+            NetworkManager::cond.wait(lk);
+        }
 
         if (glfwGetTime() - t0 <= 1.0) {
             continue;
@@ -783,42 +1800,167 @@ void Engine::frameLockPostStage() {
         }
     }
 
-    addValue(_statistics.syncTimes, glfwGetTime() - t0);
-}
+    _statistics.syncTimes.add(glfwGetTime() - t0);
+    BinaryLogN(
+        "Frame {}: waited {:.3f} ms for the clients",
+        _frameCounter, (glfwGetTime() - t0) * 1000.0
+    );
 
-void Engine::exec() {
-    Window::makeSharedContextCurrent();
+    // The clients' statistics arrived together with their acknowledgements
+    _statistics.nodes.resize(nm.syncConnectionsCount());
+    for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+        const Network& connection = nm.syncConnection(i);
+        _statistics.nodes[i] =
+            connection.isConnected() ? connection.nodeStatistics() : std::nullopt;
+    }
+
+    if (_swapGroupReset && Window::isBarrierActive()) {
+        checkSwapGroups();
+    }
+    if (_lockstepFrame && _settings.lockstepHashInterval > 0) {
+        checkSimulationHashes();
+    }
+}
+
+void Engine::exec() {
+    Window::makeSharedContextCurrent();
+
+    // Measures the time from the beginning of the first window's rendering until the
+    // end of the last window's composition
+    GpuTimer drawTimer = GpuTimer(1);
 
-    unsigned int timeQueryBegin = 0;
-    glGenQueries(1, &timeQueryBegin);
-    unsigned int timeQueryEnd = 0;
-    glGenQueries(1, &timeQueryEnd);
+    // The fences after the buffer swaps of the frames that might still be in flight,
+    // oldest first. These are only used if the frames in flight are limited
+    std::deque<GLsync> frameFences;
 
     Node& thisNode = ClusterManager::instance().thisNode();
     const std::vector<std::unique_ptr<Window>>& wins = thisNode.windows();
+
+    // Only the master takes the input for the whole cluster, so render-only clients can
+    // process the events of their windows less often
+    const unsigned int pollInterval = NetworkManager::instance().isComputerServer() ?
+        1 : static_cast<unsigned int>(thisNode.pollInterval());
+
+    std::unique_ptr<WindowThreads> windowThreads;
+    if (_settings.useWindowThreads && wins.size() > 1) {
+        Log::Info(std::format("Compositing {} windows on separate threads", wins.size()));
+        windowThreads = std::make_unique<WindowThreads>(wins);
+    }
+    std::unique_ptr<PresentThread> presentThread;
+    if (_settings.usePresentThread && !_settings.headless) {
+        Log::Info("Swapping the windows on a separate thread");
+        presentThread = std::make_unique<PresentThread>();
+    }
+
     while (!_shouldTerminate && !thisNode.closeAllWindows() &&
            NetworkManager::instance().isRunning()) [[unlikely]]
     {
+        waitForFrameStart();
+#ifdef SGCT_HAS_OPENVR
+        // The compositor paces the frames of the HMD, but the poses are predicted later
+        if (openvr::isHMDActive()) {
+            openvr::waitForPoses();
+            if (!_settings.lateLatching) {
+                openvr::updatePoses();
+            }
+        }
+#endif // SGCT_HAS_OPENVR
+        const double frameStartTime = glfwGetTime();
+
 #ifdef SGCT_HAS_VRPN
-        if (isMaster()) {
+        if (isMaster() && !_settings.lateLatching) {
             TrackingManager::instance().updateTrackingDevices();
         }
 #endif // SGCT_HAS_VRPN
 
-        {
+        if (_frameCounter % pollInterval == 0) {
             ZoneScopedN("GLFW Poll Events");
+            TraceScopedN("GLFW Poll Events");
             glfwPollEvents();
         }
 
         Window::makeSharedContextCurrent();
 
+        _jobSystem->finishStage(JobSystem::FrameStage::PreSync);
+        TextureManager::instance().update();
+        if (NetworkManager::instance().isComputerServer()) {
+            // Taken once per frame, so that it is the same in all callbacks of the frame
+            _presentationTime->setValue(time());
+            _mediaDistributor->update();
+            if (_externalControl) {
+                _externalControl->update(_externalControlFn);
+            }
+        }
+        double preSyncCallbackTime = 0.0;
         if (_preSyncFn) [[likely]] {
             ZoneScopedN("[SGCT] PreSync");
+            TraceScopedN("[SGCT] PreSync");
+            const double t0 = glfwGetTime();
             _preSyncFn();
+            preSyncCallbackTime = glfwGetTime() - t0;
         }
 
         if (NetworkManager::instance().isComputerServer()) {
-            SharedData::instance().encode();
+            if (!_configPath.empty()) [[unlikely]] {
+                checkConfigFile();
+            }
+            if (_clusterFrameNumber) {
+                _clusterFrameNumber->setValue(_frameCounter);
+            }
+            if (_inputSync) {
+                _inputSync->update();
+            }
+            if (_lockstepFrame) {
+                // Only the master measures the time, so all nodes run the same steps
+                const double timestep = *_settings.lockstepTimestep;
+                if (_lockstepTime >= 0.0) {
+                    _lockstepAccumulator += frameStartTime - _lockstepTime;
+                }
+                _lockstepTime = frameStartTime;
+                const uint64_t maxSteps =
+                    static_cast<uint64_t>(_settings.lockstepMaxSteps);
+                const uint64_t nSteps = std::min(
+                    static_cast<uint64_t>(_lockstepAccumulator / timestep),
+                    maxSteps
+                );
+                _lockstepAccumulator -= nSteps * timestep;
+                if (nSteps == maxSteps) {
+                    // The simulation falls behind instead of catching up in ever longer
+                    // frames when the frames take longer than the maximum steps
+                    _lockstepAccumulator = std::min(_lockstepAccumulator, timestep);
+                }
+                _lockstepFrame->modify([nSteps](LockstepFrame& frame) {
+                    frame.firstStep += frame.nSteps;
+                    frame.nSteps = nSteps;
+                });
+            }
+            std::optional<SyncReplay::Frame> replayed;
+            if (_syncReplay) [[unlikely]] {
+                replayed = _syncReplay->nextFrame();
+                if (!replayed) {
+                    Log::Info("The replay of the shared data has finished");
+                    terminate();
+                }
+            }
+            if (replayed) [[unlikely]] {
+                SharedData::instance().replay(replayed->data);
+            }
+            else {
+                SharedData::instance().setEncodeSkipped(_isFrameUnchanged->value());
+                SharedData::instance().encode();
+            }
+            if (_syncRecorder) [[unlikely]] {
+                _syncRecorder->addFrame(
+                    _frameCounter,
+                    time(),
+                    std::span(
+                        reinterpret_cast<const std::byte*>(
+                            SharedData::instance().dataBlock()
+                        ),
+                        SharedData::instance().dataSize()
+                    )
+                );
+            }
         }
         else if (!NetworkManager::instance().isRunning()) {
             // exit if not running
@@ -826,87 +1968,305 @@ void Engine::exec() {
             break;
         }
 
+        const double preSyncStartTime = glfwGetTime();
         frameLockPreStage();
+        const double preSyncTime = glfwGetTime() - preSyncStartTime;
+        // Taken right after the sync, as that is the state that the clients received
+        const bool isFrameUnchanged = _isFrameUnchanged->value();
+        if (_inputSync && !NetworkManager::instance().isComputerServer()) {
+            _inputSync->replay();
+        }
+        _correctionMeshSync->apply();
+        if (_lockstepFrame) {
+            simulate();
+        }
+        if (_swapGroupReset && _swapGroupReset->value() != _appliedSwapGroupReset &&
+            clusterFrameNumber() >= _swapGroupReset->value()) [[unlikely]]
+        {
+            _appliedSwapGroupReset = _swapGroupReset->value();
+            Window::resetSwapGroupFrameNumber();
+            _hasSwapGroupFrame = false;
+            _swapGroupOffsets.clear();
+        }
+        if (_config && !_config->value().empty() && _config->value() != _appliedConfig)
+            [[unlikely]]
+        {
+            // All nodes receive the changed configuration in the same frame
+            try {
+                applyConfig(readJsonConfig(_config->value()));
+            }
+            catch (const std::runtime_error& e) {
+                Log::Error(std::format("Failed to apply configuration: {}", e.what()));
+            }
+            _appliedConfig = _config->value();
+        }
+        if (_resolutionScale) {
+            // All nodes apply the scale that was sent with this frame's data
+            for (const std::unique_ptr<Window>& window : wins) {
+                window->setResolutionScale(_resolutionScale->value());
+            }
+        }
         std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::update));
         Window::makeSharedContextCurrent();
 
+        _jobSystem->finishStage(JobSystem::FrameStage::PostSyncPreDraw);
+        double postSyncPreDrawCallbackTime = 0.0;
         if (_postSyncPreDrawFn) [[likely]] {
             ZoneScopedN("[SGCT] PostSyncPreDraw");
+            TraceScopedN("[SGCT] PostSyncPreDraw");
+            const double t0 = glfwGetTime();
             _postSyncPreDrawFn();
+            postSyncPreDrawCallbackTime = glfwGetTime() - t0;
         }
 
+        if (_settings.maxFramesInFlight) [[unlikely]] {
+            // Everything up to here overlapped with the GPU still finishing the previous
+            // frames, and only the oldest ones have to be finished before drawing
+            ZoneScopedN("Wait for frames in flight");
+            const double waitStartTime = glfwGetTime();
+            const size_t maxFrames = static_cast<size_t>(*_settings.maxFramesInFlight);
+            while (frameFences.size() >= maxFrames) {
+                glClientWaitSync(
+                    frameFences.front(),
+                    GL_SYNC_FLUSH_COMMANDS_BIT,
+                    FrameFenceTimeout
+                );
+                glDeleteSync(frameFences.front());
+                frameFences.pop_front();
+            }
+            _statistics.gpuWaitTime = glfwGetTime() - waitStartTime;
+            _statistics.framesInFlight = static_cast<int>(std::count_if(
+                frameFences.cbegin(),
+                frameFences.cend(),
+                [](GLsync fence) {
+                    return glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED;
+                }
+            ));
+        }
+
+#ifdef SGCT_HAS_VRPN
+        if (isMaster() && _settings.lateLatching) {
+            // The tracked viewports calculate their frusta while rendering, so this is
+            // the latest point at which all viewports still see the same head position
+            TrackingManager::instance().updateTrackingDevices();
+        }
+#endif // SGCT_HAS_VRPN
+#ifdef SGCT_HAS_OPENVR
+        if (_settings.lateLatching && openvr::isHMDActive()) {
+            // Each node predicts the pose of its own HMD, as it is not synchronized
+            openvr::updatePoses();
+        }
+#endif // SGCT_HAS_OPENVR
+
+        // The dynamic resolution is decided on by the master alone
+        const bool isMeasuringDraw = _statisticsRenderer || _metricsExporter ||
+            _benchmark || (_resolutionScale && isMaster());
         {
             ZoneScopedN("Statistics update");
             const double startFrameTime = glfwGetTime();
             const double ft = static_cast<float>(startFrameTime - _statsPrevTimestamp);
-            addValue(_statistics.frametimes, ft);
+            _statistics.frametimes.add(ft);
             _statsPrevTimestamp = startFrameTime;
+            if (_hitchDetector) [[unlikely]] {
+                _hitchDetector->addFrame(_frameCounter, ft);
+            }
 
-            if (_statisticsRenderer) [[unlikely]] {
-                glQueryCounter(timeQueryBegin, GL_TIMESTAMP);
+            if (isMeasuringDraw) [[unlikely]] {
+                drawTimer.beginFrame();
+                drawTimer.begin(0);
             }
         }
 
+        _jobSystem->finishStage(JobSystem::FrameStage::Draw);
+        const double drawStartTime = glfwGetTime();
+        _drawCallbackTime = 0.0;
+        _draw2DCallbackTime = 0.0;
+
         // Render Viewports / Draw
-        std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::draw));
-        std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::renderFBOTexture));
+        for (const std::unique_ptr<Window>& window : wins) {
+            // The previous frame's textures can only be displayed again if they exist
+            // and have not been recreated in this frame
+            // The tiles of a tiled screenshot are rendered into the same textures, so the
+            // frame itself is rendered again afterwards
+            const bool isTiled = _screenshotTiles && shouldTakeScreenshot(*window);
+            if (isTiled) [[unlikely]] {
+                window->renderTiledScreenshot(*_screenshotTiles);
+            }
+            if (window->shouldRender(_frameCounter, isFrameUnchanged) ||
+                _frameCounter == 0 || window->isWindowResized() || isTiled)
+            {
+                window->draw();
+            }
+        }
+        if (presentThread) {
+            // The back buffers still belong to the previous frame until it is swapped
+            presentThread->wait();
+            if (Window::isBarrierActive()) [[unlikely]] {
+                updateSwapGroupFrame();
+            }
+        }
+        if (windowThreads) {
+            // The windows' contexts have to wait until the scene that they composite has
+            // been rendered into the textures of the shared context
+            GLsync rendered = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            windowThreads->run([rendered](Window& window) {
+                glWaitSync(rendered, 0, GL_TIMEOUT_IGNORED);
+                window.renderFBOTexture();
+            });
+            glDeleteSync(rendered);
+        }
+        else {
+            std::for_each(
+                wins.cbegin(),
+                wins.cend(),
+                std::mem_fn(&Window::renderFBOTexture)
+            );
+        }
 
         Window::makeSharedContextCurrent();
+        const double cpuDrawTime = glfwGetTime() - drawStartTime;
 
-        if (_statisticsRenderer) [[unlikely]] {
-            ZoneScopedN("glQueryCounter");
-            glQueryCounter(timeQueryEnd, GL_TIMESTAMP);
+        if (isMeasuringDraw) [[unlikely]] {
+            drawTimer.end(0);
+        }
+        if (_resolutionScale && isMaster()) {
+            updateResolutionScale(drawTimer.time(0));
         }
 
+        _jobSystem->finishStage(JobSystem::FrameStage::PostDraw);
+        double postDrawCallbackTime = 0.0;
         if (_postDrawFn) [[likely]] {
             ZoneScopedN("[SGCT] PostDraw");
+            TraceScopedN("[SGCT] PostDraw");
+            const double t0 = glfwGetTime();
             _postDrawFn();
+            postDrawCallbackTime = glfwGetTime() - t0;
         }
 
-        if (_statisticsRenderer) [[unlikely]] {
-            ZoneScopedN("Statistics Update");
-            // wait until the query results are available
-            GLint done = GL_FALSE;
-            while (!done) {
-                glGetQueryObjectiv(timeQueryEnd, GL_QUERY_RESULT_AVAILABLE, &done);
+        _statistics.preSyncTimes.add(preSyncCallbackTime);
+        _statistics.encodeTimes.add(SharedData::instance().encodeTime());
+        _statistics.decodeTimes.add(SharedData::instance().decodeTime());
+        _statistics.postSyncPreDrawTimes.add(postSyncPreDrawCallbackTime);
+        _statistics.drawCallbackTimes.add(_drawCallbackTime);
+        _statistics.draw2DTimes.add(_draw2DCallbackTime);
+        _statistics.postDrawTimes.add(postDrawCallbackTime);
+
+        if (_metricsExporter) [[unlikely]] {
+            _metricsExporter->updateGpuMemory();
+            if (!_statisticsRenderer) {
+                _statistics.drawTimes.add(drawTimer.time(0));
             }
+        }
 
-            // get the query results
-            GLuint64 timerStart = 0;
-            glGetQueryObjectui64v(timeQueryBegin, GL_QUERY_RESULT, &timerStart);
-            GLuint64 timerEnd = 0;
-            glGetQueryObjectui64v(timeQueryEnd, GL_QUERY_RESULT, &timerEnd);
+        if (_statisticsRenderer) [[unlikely]] {
+            ZoneScopedN("Statistics Update");
+            // The GPU times are those of a frame a few frames ago, whose queries have
+            // finished by now, so that the statistics do not stall the GPU
+            _statistics.drawTimes.add(drawTimer.time(0));
 
-            const double t = static_cast<double>(timerEnd - timerStart) / 1000000000.0;
-            addValue(_statistics.drawTimes, t);
+            _statistics.windowTimes.clear();
+            for (const std::unique_ptr<Window>& window : wins) {
+                _statistics.windowTimes.push_back(window->gpuTimes());
+            }
+            _statistics.viewportDrawTimes.resize(wins.size());
+            for (size_t i = 0; i < wins.size(); i++) {
+                _statistics.viewportDrawTimes[i] = wins[i]->viewportDrawTimes();
+            }
 
             _statisticsRenderer->update();
         }
 
+        // The master monitors the swap groups and the lockstep simulation with the frame
+        // counters and the simulation hashes of the clients
+        const bool sendsHash = _lockstepFrame && _settings.lockstepHashInterval > 0;
+        const bool sendsStatistics =
+            _statisticsRenderer || Window::isBarrierActive() || sendsHash;
+        if (!isMaster() && sendsStatistics) {
+            // The dropped frames are counted by the connection to the master
+            Network::NodeStatistics node;
+            node.frameTime = static_cast<float>(_statistics.frametimes.newest());
+            node.drawTime = static_cast<float>(cpuDrawTime);
+            node.syncWait = static_cast<float>(_statistics.syncTimes.newest());
+            node.gpuTime = static_cast<float>(_statistics.drawTimes.newest());
+            node.swapGroupFrame = _statistics.swapGroupFrame;
+            node.missedSwaps = static_cast<uint32_t>(_statistics.missedSwaps);
+            if (!_simulationHashes.empty()) {
+                node.simulationStep = _simulationHashes.back().first;
+                node.simulationHash = _simulationHashes.back().second;
+            }
+            NetworkManager::instance().queueStatisticsToMaster(node);
+        }
+
         // master will wait for nodes render before swapping
+        const double postSyncStartTime = glfwGetTime();
         frameLockPostStage();
+        const double postSyncTime = glfwGetTime() - postSyncStartTime;
+        _frameWorkTimes[_frameCounter % FramePacingHistory] =
+            glfwGetTime() - frameStartTime;
+
+        if (_benchmark) [[unlikely]] {
+            // Like the draw time, the composition times are those of a few frames ago
+            double compositeTime = 0.0;
+            for (const std::unique_ptr<Window>& window : wins) {
+                compositeTime += window->gpuTimes().composite;
+            }
+            const bool isFinished = _benchmark->addFrame(Benchmark::Frame {
+                .frameTime = _statistics.frametimes.newest(),
+                .drawTime = cpuDrawTime,
+                .gpuDrawTime = drawTimer.time(0),
+                .syncTime = preSyncTime + postSyncTime,
+                .compositeTime = compositeTime
+            });
+            if (isFinished) {
+                const std::filesystem::path path =
+                    _benchmark->writeResults(ClusterManager::instance().thisNodeId());
+                if (!path.empty()) {
+                    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+                    //        formatting std::filesystem::path
+                    Log::Info(std::format(
+                        "Benchmark finished, results written to '{}'", path.string()
+                    ));
+                }
+                terminate();
+            }
+        }
+
         // Swap front and back rendering buffers
-        for (const std::unique_ptr<Window>& window : wins) {
-            bool shouldTakeScreenshot = _shouldTakeScreenshot;
-
-            // The window might want to opt out of taking screenshots
-            shouldTakeScreenshot &= window->shouldTakeScreenshot();
-
-            // If we don't want to take any screenshots anyway, there is no need for any
-            // extra work. Same thing if we want to take a screenshot of all windows,
-            // meaning that the _takeScreenshotIds list is empty
-            if (shouldTakeScreenshot && !_shouldTakeScreenshotIds.empty()) {
-                auto it = std::find(
-                    _shouldTakeScreenshotIds.cbegin(),
-                    _shouldTakeScreenshotIds.cend(),
-                    window->id()
+        const bool shouldPresent = !presentThread;
+        if (windowThreads) {
+            windowThreads->run([this, shouldPresent](Window& window) {
+                window.swapBuffers(
+                    shouldTakeScreenshot(window) && !_screenshotTiles,
+                    shouldPresent
+                );
+            });
+        }
+        else {
+            for (const std::unique_ptr<Window>& window : wins) {
+                window->swapBuffers(
+                    shouldTakeScreenshot(*window) && !_screenshotTiles,
+                    shouldPresent
                 );
-                // If the window id is in the list of ids, then we want to take a
-                // screenshot. We already checked that `shouldTakeScreenshot` is true in
-                // the if statement above
-                shouldTakeScreenshot = (it != _shouldTakeScreenshotIds.cend());
             }
-            window->swapBuffers(shouldTakeScreenshot);
+        }
+        if (presentThread) {
+            std::vector<Window*> presented;
+            for (const std::unique_ptr<Window>& window : wins) {
+                if (window->isVisible() || window->isRenderingWhileHidden()) {
+                    presented.push_back(window.get());
+                }
+            }
+            presentThread->present(std::move(presented));
+        }
+
+        _previousSwapTime = glfwGetTime();
+        if (_settings.maxFramesInFlight) [[unlikely]] {
+            frameFences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            glFlush();
+        }
+        if (Window::isBarrierActive() && !presentThread) [[unlikely]] {
+            updateSwapGroupFrame();
         }
 
         TracyGpuCollect;
@@ -919,16 +2279,332 @@ void Engine::exec() {
         );
 
         // for all windows
+        BinaryLogN("Frame {} finished", _frameCounter);
         _frameCounter++;
         if (_shouldTakeScreenshot) {
             _shotCounter++;
         }
         _shouldTakeScreenshot = false;
+        _screenshotTiles = std::nullopt;
     }
 
     Window::makeSharedContextCurrent();
-    glDeleteQueries(1, &timeQueryBegin);
-    glDeleteQueries(1, &timeQueryEnd);
+    for (GLsync fence : frameFences) {
+        glDeleteSync(fence);
+    }
+    drawTimer.destroy();
+}
+
+void Engine::waitForFrameStart() const {
+    ZoneScoped;
+
+    // Without V-Sync, the waiting would only make the frame time longer. The frame time
+    // history has to be filled for the shortest frame time to be meaningful
+    if (!_settings.framePacingMargin || _settings.swapInterval == 0 || !isMaster() ||
+        _statistics.frametimes.size() < _statistics.frametimes.length())
+    {
+        return;
+    }
+
+    // The shortest frame time is the swap interval, as a frame that missed a swap makes
+    // the average longer, which would cause the next frame to start too late, too
+    const double frameTime = _statistics.minDt();
+    const double workTime =
+        *std::max_element(_frameWorkTimes.cbegin(), _frameWorkTimes.cend());
+    const double start =
+        _previousSwapTime + frameTime - workTime - *_settings.framePacingMargin;
+
+    // Never wait longer than a frame in case the prediction is off
+    const double wait = std::min(start - glfwGetTime(), frameTime);
+    if (wait > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+}
+
+void Engine::checkConfigFile() {
+    ZoneScoped;
+
+    const double now = glfwGetTime();
+    if (now - _lastConfigCheck < 1.0) {
+        return;
+    }
+    _lastConfigCheck = now;
+
+    // The file might briefly be missing while it is replaced by a newer version
+    std::error_code ec;
+    const std::filesystem::file_time_type time =
+        std::filesystem::last_write_time(_configPath, ec);
+    if (ec || time == _configWriteTime) {
+        return;
+    }
+    _configWriteTime = time;
+
+    try {
+        const config::Cluster cluster = readConfig(_configPath);
+        config::validateCluster(cluster);
+        std::string serialized = serializeConfig(cluster);
+        if (serialized == _appliedConfig) {
+            return;
+        }
+
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Info(std::format("Reloading configuration '{}'", _configPath.string()));
+        if (_configServer) {
+            _configServer->setCluster(cluster);
+        }
+        _config->setValue(std::move(serialized));
+    }
+    catch (const std::runtime_error& e) {
+        // The previous configuration is kept until the file has been fixed
+        Log::Error(std::format("Failed to reload configuration: {}", e.what()));
+    }
+}
+
+void Engine::applyConfig(const config::Cluster& cluster) {
+    ZoneScoped;
+
+    // Only the settings that come from the configuration are taken, the commandline
+    // options stay as they were
+    const Settings settings = createSettings(cluster, Configuration());
+    Node& thisNode = ClusterManager::instance().thisNode();
+    const std::vector<std::unique_ptr<Window>>& wins = thisNode.windows();
+
+    if (settings.swapInterval != _settings.swapInterval) {
+        Log::Info(std::format("Setting swap interval to {}", settings.swapInterval));
+        _settings.swapInterval = settings.swapInterval;
+    }
+
+    if (settings.cubeMapRefreshInterval != _settings.cubeMapRefreshInterval) {
+        Log::Info(std::format(
+            "Setting cube map refresh interval to {}", settings.cubeMapRefreshInterval
+        ));
+        _settings.cubeMapRefreshInterval = settings.cubeMapRefreshInterval;
+        if (_settings.cubeMapRefreshInterval > 1 && !_clusterFrameNumber) {
+            // Created in the same frame on all nodes, so the clients have it before the
+            // master sends it for the first time
+            _clusterFrameNumber = std::make_unique<SharedObject<uint32_t>>(
+                ClusterFrameNumberId,
+                _frameCounter
+            );
+        }
+    }
+
+    if (settings.statisticsHistoryLength != _settings.statisticsHistoryLength) {
+        _settings.statisticsHistoryLength = settings.statisticsHistoryLength;
+        _statistics.setHistoryLength(_settings.statisticsHistoryLength);
+    }
+
+    const int nodeId = ClusterManager::instance().thisNodeId();
+    if (nodeId >= static_cast<int>(cluster.nodes.size())) {
+        return;
+    }
+    const std::vector<config::Window>& windows = cluster.nodes[nodeId].windows;
+    if (windows.size() != wins.size()) {
+        Log::Warning("The number of windows has changed, which requires a restart");
+        return;
+    }
+    for (size_t i = 0; i < wins.size(); i++) {
+        wins[i]->setUseFXAA(windows[i].useFxaa.value_or(false));
+    }
+
+    // The windows without their own interval use the global one
+    for (size_t i = 0; i < wins.size(); i++) {
+        wins[i]->makeOpenGLContextCurrent();
+        wins[i]->setSwapInterval(
+            windows[i].swapInterval,
+            windows[i].adaptiveSync,
+            i == wins.size() - 1
+        );
+    }
+    Window::makeSharedContextCurrent();
+}
+
+void Engine::updateSwapGroupFrame() {
+    const uint32_t frame = Window::swapGroupFrameNumber();
+    const uint32_t interval =
+        static_cast<uint32_t>(std::max(std::abs(_settings.swapInterval), 1));
+    if (_hasSwapGroupFrame && frame > _statistics.swapGroupFrame + interval) {
+        // The swap group went through the retraces in between without this node
+        const uint32_t nMissed = frame - _statistics.swapGroupFrame - interval;
+        _statistics.missedSwaps += nMissed;
+        BinaryLogN("Frame {}: missed {} swaps", _frameCounter, nMissed);
+    }
+    _statistics.swapGroupFrame = frame;
+    _hasSwapGroupFrame = true;
+}
+
+void Engine::simulate() {
+    ZoneScoped;
+
+    if (!_simulateFn) {
+        return;
+    }
+
+    const LockstepFrame& frame = _lockstepFrame->value();
+    const uint64_t interval = static_cast<uint64_t>(_settings.lockstepHashInterval);
+    const uint64_t end = frame.firstStep + frame.nSteps;
+    // The steps of a frame whose data is received again are not run twice, and a client
+    // that joins later starts with the steps of its first frame
+    for (uint64_t s = std::max(frame.firstStep, _nextSimulationStep); s < end; s++) {
+        _simulateFn(SimulationStep{
+            .step = s,
+            .timestep = *_settings.lockstepTimestep,
+            .seed = simulationSeed(frame.seed, s)
+        });
+
+        if (_simulationHashFn && interval > 0 && (s + 1) % interval == 0) {
+            _simulationHashes.emplace_back(s + 1, _simulationHashFn());
+            const size_t nHashes = isMaster() ? MaxSimulationHashes : 1;
+            while (_simulationHashes.size() > nHashes) {
+                _simulationHashes.pop_front();
+            }
+        }
+    }
+    _nextSimulationStep = std::max(_nextSimulationStep, end);
+}
+
+void Engine::checkSimulationHashes() {
+    _simulationChecks.resize(_statistics.nodes.size());
+    for (size_t i = 0; i < _statistics.nodes.size(); i++) {
+        const std::optional<Network::NodeStatistics>& node = _statistics.nodes[i];
+        SimulationCheck& check = _simulationChecks[i];
+        if (!node || node->simulationStep == 0 || node->simulationStep == check.step) {
+            continue;
+        }
+        check.step = node->simulationStep;
+
+        const auto it = std::find_if(
+            _simulationHashes.cbegin(),
+            _simulationHashes.cend(),
+            [&](const std::pair<uint64_t, uint64_t>& hash) {
+                return hash.first == node->simulationStep;
+            }
+        );
+        if (it == _simulationHashes.cend()) {
+            // The master no longer has the hash of a client that lags this far behind
+            continue;
+        }
+
+        const bool hasDiverged = it->second != node->simulationHash;
+        if (hasDiverged && !check.hasDiverged) {
+            Log::Error(std::format(
+                "The simulation of node {} diverged from the master's after {} steps",
+                i, node->simulationStep
+            ));
+        }
+        else if (!hasDiverged && check.hasDiverged) {
+            Log::Info(std::format(
+                "The simulation of node {} matches the master's again after {} steps",
+                i, node->simulationStep
+            ));
+        }
+        check.hasDiverged = hasDiverged;
+    }
+}
+
+void Engine::checkSwapGroups() {
+    if (_swapGroupReset->value() != _appliedSwapGroupReset) {
+        // The counters are compared again once they have been reset
+        return;
+    }
+
+    _swapGroupOffsets.resize(_statistics.nodes.size());
+    bool hasDiverged = false;
+    for (size_t i = 0; i < _statistics.nodes.size(); i++) {
+        const std::optional<Network::NodeStatistics>& node = _statistics.nodes[i];
+        if (!node || node->swapGroupFrame == 0) {
+            continue;
+        }
+
+        const int64_t offset = static_cast<int64_t>(node->swapGroupFrame) -
+            static_cast<int64_t>(_statistics.swapGroupFrame);
+        if (!_swapGroupOffsets[i]) {
+            _swapGroupOffsets[i] = offset;
+            continue;
+        }
+        // The nodes read their counters at slightly different times, so the counters
+        // can be one retrace apart while the nodes are still swapping together
+        const int64_t drift = offset - *_swapGroupOffsets[i];
+        if (drift < -1 || drift > 1) {
+            Log::Warning(std::format(
+                "Swap group frame counter of node {} drifted by {} frames from the "
+                "master's ({} vs {}). Missed swaps: {}",
+                i, drift, node->swapGroupFrame, _statistics.swapGroupFrame,
+                node->missedSwaps
+            ));
+            hasDiverged = true;
+        }
+    }
+
+    if (hasDiverged) {
+        const uint32_t frame = _frameCounter + SwapGroupResetDelay;
+        Log::Info(std::format(
+            "Resetting the swap group frame counters in frame {}", frame
+        ));
+        _swapGroupReset->setValue(frame);
+        _statistics.swapGroupResyncs++;
+    }
+}
+
+void Engine::updateResolutionScale(double drawTime) {
+    ZoneScoped;
+
+    // The draw time has to be measured with the current scale, which is only the case
+    // once the queries of the frames rendered before the last change have been collected
+    if (drawTime <= 0.0 || _frameCounter - _resolutionScaleFrame <= GpuTimer::Latency) {
+        return;
+    }
+
+    // The scale is only changed once the draw time leaves the band around the target so
+    // that small variations between frames do not cause the resolution to oscillate
+    constexpr double LowerLoad = 0.75;
+    constexpr double TargetLoad = 0.85;
+    constexpr double UpperLoad = 0.95;
+    const double load = drawTime / *_settings.dynamicResolutionBudget;
+    if (load > LowerLoad && load < UpperLoad) {
+        return;
+    }
+
+    // The draw time is roughly proportional to the number of pixels, that is the square
+    // of the scale. The resolution drops quickly if the frame is over budget but only
+    // rises slowly as every change reallocates the framebuffers
+    const float current = _resolutionScale->value();
+    const double factor = std::clamp(std::sqrt(TargetLoad / load), 0.8, 1.05);
+
+    // Rounding to a fixed step limits the number of different framebuffer sizes
+    constexpr float Step = 1.f / 64.f;
+    const float scale = std::clamp(
+        std::round(static_cast<float>(current * factor) / Step) * Step,
+        _settings.minResolutionScale,
+        std::max(_settings.minResolutionScale, _settings.maxResolutionScale)
+    );
+    if (scale == current) {
+        return;
+    }
+
+    Log::Debug(std::format(
+        "Resolution scale changed from {} to {} at {:.2f} ms GPU draw time",
+        current, scale, drawTime * 1000.0
+    ));
+    _resolutionScale->setValue(scale);
+    _resolutionScaleFrame = _frameCounter;
+}
+
+bool Engine::shouldTakeScreenshot(const Window& window) const {
+    // The window might want to opt out of taking screenshots
+    if (!_shouldTakeScreenshot || !window.shouldTakeScreenshot()) {
+        return false;
+    }
+
+    // If we want to take a screenshot of all windows, the _takeScreenshotIds list is
+    // empty. Otherwise only the windows whose ids are in the list take a screenshot
+    return _shouldTakeScreenshotIds.empty() ||
+        std::find(
+            _shouldTakeScreenshotIds.cbegin(),
+            _shouldTakeScreenshotIds.cend(),
+            window.id()
+        ) != _shouldTakeScreenshotIds.cend();
 }
 
 bool Engine::isMaster() const {
@@ -939,6 +2615,14 @@ unsigned int Engine::currentFrameNumber() const {
     return _frameCounter;
 }
 
+unsigned int Engine::clusterFrameNumber() const {
+    return _clusterFrameNumber ? _clusterFrameNumber->value() : _frameCounter;
+}
+
+double Engine::presentationTime() const {
+    return _presentationTime->value();
+}
+
 void Engine::waitForAllWindowsInSwapGroupToOpen() {
     ZoneScoped;
 
@@ -953,7 +2637,8 @@ void Engine::waitForAllWindowsInSwapGroupToOpen() {
         glClearColor(0.f, 0.f, 0.f, 0.f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        {
+        // The surface of a headless window might not have buffers that can be swapped
+        if (!_settings.headless) {
             ZoneScopedN("glfwSwapBuffers");
             glfwSwapBuffers(window->windowHandle());
         }
@@ -987,7 +2672,9 @@ void Engine::waitForAllWindowsInSwapGroupToOpen() {
         // Swap front and back rendering buffers
         for (const std::unique_ptr<Window>& window : thisNode.windows()) {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            glfwSwapBuffers(window->windowHandle());
+            if (!_settings.headless) {
+                glfwSwapBuffers(window->windowHandle());
+            }
         }
         {
             ZoneScopedN("GLFW Poll Events");
@@ -1009,6 +2696,88 @@ void Engine::waitForAllWindowsInSwapGroupToOpen() {
     }
 }
 
+void Engine::waitForAllNodesToBeReady(const Network::StartupTimes& times) {
+    ZoneScoped;
+
+    NetworkManager& nm = NetworkManager::instance();
+    if (_shouldTerminate || ClusterManager::instance().numberOfNodes() == 1) {
+        return;
+    }
+    if (!nm.isComputerServer()) {
+        nm.sendReadyToMaster(times);
+        return;
+    }
+
+    Log::Info("Waiting for all nodes to be ready");
+    const double startTime = glfwGetTime();
+    Node& thisNode = ClusterManager::instance().thisNode();
+    while (!nm.areAllNodesReady()) {
+        for (const std::unique_ptr<Window>& window : thisNode.windows()) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (!_settings.headless) {
+                glfwSwapBuffers(window->windowHandle());
+            }
+        }
+        {
+            ZoneScopedN("GLFW Poll Events");
+            glfwPollEvents();
+        }
+
+        if (_shouldTerminate || !nm.isRunning() || thisNode.closeAllWindows()) {
+            terminate();
+            return;
+        }
+
+        std::unique_lock lock(FrameSync);
+        NetworkManager::cond.wait_for(lock, std::chrono::milliseconds(100));
+    }
+
+    // Every phase is reported with the node that spent the longest time in it, which
+    // usually is the node that the whole cluster waited for
+    using Phase = float Network::StartupTimes::*;
+    auto report = [&nm, &times](std::string_view phase, Phase t) {
+        float slowest = times.*t;
+        int node = -1;
+        for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+            const std::optional<Network::StartupTimes> s =
+                nm.syncConnection(i).startupTimes();
+            if (s && (*s).*t > slowest) {
+                slowest = (*s).*t;
+                node = i;
+            }
+        }
+        return node < 0 ?
+            std::format("{} {:.3f} s (master)", phase, slowest) :
+            std::format("{} {:.3f} s (node {})", phase, slowest, node);
+    };
+
+    for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+        const std::optional<Network::StartupTimes> s =
+            nm.syncConnection(i).startupTimes();
+        if (!s) {
+            continue;
+        }
+        Log::Debug(std::format(
+            "Node {} was ready after {:.3f} s: Creating windows {:.3f} s, application "
+            "initialization {:.3f} s, initializing buffers and shaders {:.3f} s, waiting "
+            "for the cluster to connect {:.3f} s, viewport data {:.3f} s",
+            i, s->total, s->windows, s->application, s->shaders, s->connection,
+            s->viewportData
+        ));
+    }
+    Log::Info(std::format(
+        "Cluster was ready after {:.3f} s, waited {:.3f} s for the clients. Slowest "
+        "nodes: {}, {}, {}, {}, {}, {}",
+        glfwGetTime(), glfwGetTime() - startTime,
+        report("total", &Network::StartupTimes::total),
+        report("creating windows", &Network::StartupTimes::windows),
+        report("application initialization", &Network::StartupTimes::application),
+        report("buffers and shaders", &Network::StartupTimes::shaders),
+        report("connecting", &Network::StartupTimes::connection),
+        report("viewport data", &Network::StartupTimes::viewportData)
+    ));
+}
+
 void Engine::updateFrustums() const {
     ZoneScoped;
 
@@ -1017,6 +2786,51 @@ void Engine::updateFrustums() const {
     }
 }
 
+void Engine::setFrameUnchanged(bool state) {
+    if (state != _isFrameUnchanged->value()) {
+        _isFrameUnchanged->setValue(state);
+    }
+}
+
+bool Engine::isFrameUnchanged() const {
+    return _isFrameUnchanged->value();
+}
+
+void Engine::setCorrectionMeshVertices(int node, int window, int viewport, size_t first,
+                                       std::vector<correction::Buffer::Vertex> vertices)
+{
+    if (!NetworkManager::instance().isComputerServer()) {
+        return;
+    }
+    _correctionMeshSync->addPatch({
+        .node = node,
+        .window = window,
+        .viewport = viewport,
+        .first = static_cast<uint32_t>(first),
+        .vertices = std::move(vertices)
+    });
+}
+
+JobSystem& Engine::jobSystem() {
+    return *_jobSystem;
+}
+
+CaptureCollector* Engine::captureCollector() {
+    return _captureCollector.get();
+}
+
+MediaDistributor& Engine::mediaDistributor() {
+    return *_mediaDistributor;
+}
+
+CubeFaceDistributor& Engine::cubeFaceDistributor() {
+    return *_cubeFaceDistributor;
+}
+
+SortLastCompositor& Engine::sortLastCompositor() {
+    return *_sortLastCompositor;
+}
+
 const Engine::Statistics& Engine::statistics() const {
     return _statistics;
 }
@@ -1047,7 +2861,13 @@ const Window* Engine::focusedWindow() const {
 
 void Engine::setStatsGraphVisibility(bool value) {
     if (value && _statisticsRenderer == nullptr) {
+        // The renderer and its shaders and fonts are only created when the graph is
+        // shown for the first time
+        const double t0 = time();
         _statisticsRenderer = std::make_unique<StatisticsRenderer>(_statistics);
+        Log::Debug(std::format(
+            "Created the statistics renderer ({:.2f} ms)", (time() - t0) * 1000.0
+        ));
     }
     if (!value && _statisticsRenderer) {
         _statisticsRenderer = nullptr;
@@ -1077,6 +2897,22 @@ void Engine::setStatsGraphOffset(vec2 offset) {
 void Engine::takeScreenshot(std::vector<int> windowIds) {
     _shouldTakeScreenshot = true;
     _shouldTakeScreenshotIds = std::move(windowIds);
+    _screenshotTiles = std::nullopt;
+}
+
+void Engine::takeTiledScreenshot(ivec2 tiles, std::vector<int> windowIds) {
+    _shouldTakeScreenshot = true;
+    _shouldTakeScreenshotIds = std::move(windowIds);
+    _screenshotTiles = ivec2{ std::max(tiles.x, 1), std::max(tiles.y, 1) };
+}
+
+void Engine::writeTrace() const {
+    const std::filesystem::path path = Tracer::write();
+    if (!path.empty()) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Info(std::format("Wrote trace file '{}'", path.string()));
+    }
 }
 
 void Engine::resetScreenshotNumber() {
@@ -1091,6 +2927,10 @@ Engine::DrawFunction Engine::draw2DFunction() const {
     return _draw2DFn;
 }
 
+double Engine::drawCallbackTime() const {
+    return _drawCallbackTime;
+}
+
 const Node& Engine::thisNode() const {
     return ClusterManager::instance().thisNode();
 }
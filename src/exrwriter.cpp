@@ -0,0 +1,342 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/exrwriter.h>
+
+#include <sgct/engine.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/jobsystem.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string_view>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+namespace {
+    using Channel = sgct::ExrWriter::Channel;
+    using Part = sgct::ExrWriter::Part;
+    using PixelType = sgct::ExrWriter::PixelType;
+
+    // The number that identifies the format and the version 2 of the file layout
+    constexpr uint32_t Magic = 20000630;
+    constexpr uint32_t Version = 2;
+    constexpr uint32_t MultiPartFlag = 0x1000;
+
+    // The compression methods and the number of scanlines that are stored in each chunk
+    constexpr uint8_t NoCompression = 0;
+    constexpr uint8_t ZipCompression = 3;
+    constexpr int ZipLines = 16;
+
+    size_t channelSize(PixelType type) {
+        return type == PixelType::Half ? 2 : 4;
+    }
+
+    void appendBytes(std::vector<unsigned char>& buffer, const void* data, size_t size) {
+        const unsigned char* d = static_cast<const unsigned char*>(data);
+        buffer.insert(buffer.end(), d, d + size);
+    }
+
+    // All values in the file are little-endian
+    void appendInt(std::vector<unsigned char>& buffer, uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    void appendFloat(std::vector<unsigned char>& buffer, float value) {
+        uint32_t v = 0;
+        std::memcpy(&v, &value, sizeof(float));
+        appendInt(buffer, v, sizeof(uint32_t));
+    }
+
+    void appendString(std::vector<unsigned char>& buffer, std::string_view value) {
+        appendBytes(buffer, value.data(), value.size());
+        buffer.push_back(0);
+    }
+
+    void appendAttribute(std::vector<unsigned char>& header, std::string_view name,
+                         std::string_view type, const std::vector<unsigned char>& value)
+    {
+        appendString(header, name);
+        appendString(header, type);
+        appendInt(header, value.size(), sizeof(int32_t));
+        appendBytes(header, value.data(), value.size());
+    }
+
+    // The channels of a part, which are stored in the file in alphabetical order
+    std::vector<Channel> sortedChannels(const Part& part) {
+        std::vector<Channel> res = part.channels;
+        std::sort(
+            res.begin(),
+            res.end(),
+            [](const Channel& a, const Channel& b) { return a.name < b.name; }
+        );
+        return res;
+    }
+
+    std::vector<unsigned char> createHeader(const Part& part, sgct::ivec2 size,
+                                            uint8_t compression, int nChunks,
+                                            bool isMultiPart)
+    {
+        std::vector<unsigned char> header;
+        std::vector<unsigned char> v;
+
+        for (const Channel& c : sortedChannels(part)) {
+            appendString(v, c.name);
+            appendInt(v, c.type == PixelType::Half ? 1 : 2, sizeof(int32_t));
+            // The channel is not perceptually linear, followed by three reserved bytes
+            appendInt(v, 0, 4);
+            // The channel is not subsampled horizontally or vertically
+            appendInt(v, 1, sizeof(int32_t));
+            appendInt(v, 1, sizeof(int32_t));
+        }
+        v.push_back(0);
+        appendAttribute(header, "channels", "chlist", v);
+
+        if (isMultiPart) {
+            v.clear();
+            appendInt(v, static_cast<uint64_t>(nChunks), sizeof(int32_t));
+            appendAttribute(header, "chunkCount", "int", v);
+        }
+
+        v = { compression };
+        appendAttribute(header, "compression", "compression", v);
+
+        v.clear();
+        appendInt(v, 0, sizeof(int32_t));
+        appendInt(v, 0, sizeof(int32_t));
+        appendInt(v, static_cast<uint64_t>(size.x - 1), sizeof(int32_t));
+        appendInt(v, static_cast<uint64_t>(size.y - 1), sizeof(int32_t));
+        appendAttribute(header, "dataWindow", "box2i", v);
+        appendAttribute(header, "displayWindow", "box2i", v);
+
+        // The scanlines are stored from the top of the image
+        v = { 0 };
+        appendAttribute(header, "lineOrder", "lineOrder", v);
+
+        if (isMultiPart) {
+            v.clear();
+            appendBytes(v, part.name.data(), part.name.size());
+            appendAttribute(header, "name", "string", v);
+        }
+
+        v.clear();
+        appendFloat(v, 1.f);
+        appendAttribute(header, "pixelAspectRatio", "float", v);
+
+        v.clear();
+        appendFloat(v, 0.f);
+        appendFloat(v, 0.f);
+        appendAttribute(header, "screenWindowCenter", "v2f", v);
+
+        v.clear();
+        appendFloat(v, 1.f);
+        appendAttribute(header, "screenWindowWidth", "float", v);
+
+        if (isMultiPart) {
+            v.clear();
+            constexpr std::string_view Type = "scanlineimage";
+            appendBytes(v, Type.data(), Type.size());
+            appendAttribute(header, "type", "string", v);
+        }
+
+        header.push_back(0);
+        return header;
+    }
+
+    // Converts the scanlines [begin, end), which are counted from the top of the image,
+    // into the layout of the file, in which every scanline holds all values of the first
+    // channel followed by all values of the next channel, and compresses them
+    std::vector<unsigned char> compressBlock(const Part& part,
+                                             const std::vector<Channel>& channels,
+                                             sgct::ivec2 size, int begin, int end,
+                                             int compressionLevel)
+    {
+        ZoneScoped;
+
+        std::vector<unsigned char> raw;
+        for (int y = begin; y < end; y++) {
+            const size_t row = static_cast<size_t>(size.y - 1 - y);
+            const std::byte* in = part.data + row * size.x * part.pixelSize;
+            for (const Channel& c : channels) {
+                const size_t s = channelSize(c.type);
+                for (int x = 0; x < size.x; x++) {
+                    appendBytes(raw, in + x * part.pixelSize + c.offset, s);
+                }
+            }
+        }
+        if (compressionLevel == 0) {
+            return raw;
+        }
+
+        // The bytes are split into the ones at even and the ones at odd positions, which
+        // separates the high and low bytes of the values, and are then replaced by their
+        // differences, as the ZIP method of the format expects
+        std::vector<unsigned char> reordered = std::vector<unsigned char>(raw.size());
+        const size_t half = (raw.size() + 1) / 2;
+        for (size_t i = 0; i < raw.size(); i++) {
+            reordered[i % 2 == 0 ? i / 2 : half + i / 2] = raw[i];
+        }
+        for (size_t i = reordered.size(); i > 1; i--) {
+            const int d = int(reordered[i - 1]) - int(reordered[i - 2]) + 128 + 256;
+            reordered[i - 1] = static_cast<unsigned char>(d);
+        }
+
+        uLongf compressedSize = compressBound(static_cast<uLong>(reordered.size()));
+        std::vector<unsigned char> compressed =
+            std::vector<unsigned char>(compressedSize);
+        const int res = compress2(
+            compressed.data(),
+            &compressedSize,
+            reordered.data(),
+            static_cast<uLong>(reordered.size()),
+            compressionLevel
+        );
+        if (res != Z_OK) {
+            throw Err(9036, "Failed to compress EXR data");
+        }
+
+        // A chunk that would grow is stored uncompressed, which the readers recognize by
+        // its size
+        if (compressedSize >= raw.size()) {
+            return raw;
+        }
+        compressed.resize(compressedSize);
+        return compressed;
+    }
+} // namespace
+
+namespace sgct {
+
+void ExrWriter::write(const std::filesystem::path& filename, ivec2 size,
+                      std::span<const Part> parts, const Settings& settings)
+{
+    ZoneScoped;
+
+    if (parts.empty() || size.x <= 0 || size.y <= 0) {
+        throw Err(9035, std::format("No image to save as '{}'", filename.string()));
+    }
+
+    const double t0 = time();
+
+    const bool isMultiPart = parts.size() > 1;
+    const uint8_t compression =
+        settings.compressionLevel == 0 ? NoCompression : ZipCompression;
+    const int linesPerChunk = compression == NoCompression ? 1 : ZipLines;
+    const int nChunks = (size.y + linesPerChunk - 1) / linesPerChunk;
+
+    // The chunks are compressed before the file is created so that it is not left open
+    // if the compression fails
+    std::vector<std::vector<Channel>> channels;
+    for (const Part& part : parts) {
+        channels.push_back(sortedChannels(part));
+    }
+    std::vector<std::vector<unsigned char>> chunks =
+        std::vector<std::vector<unsigned char>>(parts.size() * nChunks);
+    auto compressChunk = [&](size_t i) {
+        const size_t p = i / nChunks;
+        const int begin = static_cast<int>(i % nChunks) * linesPerChunk;
+        const int end = std::min(begin + linesPerChunk, size.y);
+        chunks[i] = compressBlock(
+            parts[p],
+            channels[p],
+            size,
+            begin,
+            end,
+            settings.compressionLevel
+        );
+    };
+    if (settings.jobSystem) {
+        std::vector<JobSystem::Job> jobs;
+        jobs.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); i++) {
+            jobs.push_back(settings.jobSystem->submit([&compressChunk, i]() {
+                compressChunk(i);
+            }));
+        }
+        // The jobs have to finish before the chunks go out of scope, even if one of them
+        // failed, so the first exception is only rethrown afterwards
+        std::exception_ptr error;
+        for (const JobSystem::Job& job : jobs) {
+            try {
+                settings.jobSystem->wait(job);
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    else {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            compressChunk(i);
+        }
+    }
+
+    std::vector<unsigned char> head;
+    appendInt(head, Magic, sizeof(uint32_t));
+    appendInt(head, Version | (isMultiPart ? MultiPartFlag : 0), sizeof(uint32_t));
+    for (const Part& part : parts) {
+        const std::vector<unsigned char> header =
+            createHeader(part, size, compression, nChunks, isMultiPart);
+        appendBytes(head, header.data(), header.size());
+    }
+    if (isMultiPart) {
+        // The list of headers ends with an empty header
+        head.push_back(0);
+    }
+
+    // The offset tables of all parts follow the headers and point at the chunks, each of
+    // which starts with its part in multi-part files, its first scanline, and its size
+    const size_t chunkHeaderSize = (isMultiPart ? 3 : 2) * sizeof(int32_t);
+    uint64_t offset = head.size() + chunks.size() * sizeof(uint64_t);
+    for (const std::vector<unsigned char>& chunk : chunks) {
+        appendInt(head, offset, sizeof(uint64_t));
+        offset += chunkHeaderSize + chunk.size();
+    }
+
+    const std::string f = filename.string();
+    FILE* fp = fopen(f.c_str(), "wb");
+    if (fp == nullptr) {
+        throw Err(9037, std::format("Cannot create EXR file '{}'", f));
+    }
+
+    bool success = fwrite(head.data(), 1, head.size(), fp) == head.size();
+    std::vector<unsigned char> chunkHeader;
+    for (size_t i = 0; i < chunks.size() && success; i++) {
+        chunkHeader.clear();
+        if (isMultiPart) {
+            appendInt(chunkHeader, i / nChunks, sizeof(int32_t));
+        }
+        appendInt(chunkHeader, (i % nChunks) * linesPerChunk, sizeof(int32_t));
+        appendInt(chunkHeader, chunks[i].size(), sizeof(int32_t));
+        success &= fwrite(chunkHeader.data(), 1, chunkHeader.size(), fp) ==
+            chunkHeader.size();
+        success &= fwrite(chunks[i].data(), 1, chunks[i].size(), fp) == chunks[i].size();
+    }
+    success &= fclose(fp) == 0;
+    if (!success) {
+        throw Err(9038, std::format("Failed to write EXR file '{}'", f));
+    }
+
+    const double t = (time() - t0) * 1000.0;
+    Log::Debug(std::format("'{}' was saved successfully ({:.2f} ms)", f, t));
+}
+
+} // namespace sgct
@@ -0,0 +1,452 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/externalcontrol.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/types.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <unistd.h>
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <string_view>
+
+namespace {
+    using Message = sgct::ExternalControl::Message;
+
+    // The largest packet that is accepted on the TCP port, which is also the size of the
+    // largest UDP datagram
+    constexpr uint32_t MaxPacketSize = 65536;
+
+    // Bundles can contain other bundles, which are only followed up to this depth
+    constexpr int MaxBundleDepth = 8;
+
+    // The time after which the thread checks whether it should stop
+    constexpr long PollInterval = 100 * 1000; // microseconds
+
+    void closeSocket(SGCT_SOCKET socket) {
+#ifdef WIN32
+        closesocket(socket);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        close(socket);
+#endif // WIN32
+    }
+
+    SGCT_SOCKET openSocket(int type, int protocol, int port) {
+        SGCT_SOCKET s = socket(AF_INET, type, protocol);
+        if (s == INVALID_SOCKET) {
+            return s;
+        }
+
+        const int reuse = 1;
+        setsockopt(
+            s,
+            SOL_SOCKET,
+            SO_REUSEADDR,
+            reinterpret_cast<const char*>(&reuse),
+            sizeof(reuse)
+        );
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        bool isOpen = bind(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) !=
+            SOCKET_ERROR;
+        if (isOpen && type == SOCK_STREAM) {
+            isOpen = listen(s, SOMAXCONN) != SOCKET_ERROR;
+        }
+        if (!isOpen) {
+            closeSocket(s);
+            return static_cast<SGCT_SOCKET>(INVALID_SOCKET);
+        }
+        return s;
+    }
+
+    // Reads the big-endian values and the 4-byte aligned strings of an OSC packet
+    class PacketReader {
+    public:
+        explicit PacketReader(std::span<const std::byte> data) : _data(data) {}
+
+        size_t remaining() const {
+            return _data.size() - _pos;
+        }
+
+        bool read(size_t nBytes, uint64_t& value) {
+            if (remaining() < nBytes) {
+                return false;
+            }
+            value = 0;
+            for (size_t i = 0; i < nBytes; i++) {
+                value = (value << 8) | std::to_integer<uint64_t>(_data[_pos + i]);
+            }
+            _pos += nBytes;
+            return true;
+        }
+
+        bool read(std::string& value) {
+            const std::span<const std::byte> rest = _data.subspan(_pos);
+            const auto end = std::find(rest.begin(), rest.end(), std::byte(0));
+            if (end == rest.end()) {
+                return false;
+            }
+            const size_t length = static_cast<size_t>(std::distance(rest.begin(), end));
+            value.assign(reinterpret_cast<const char*>(rest.data()), length);
+            // The terminating zero is followed by up to three more to fill 4 bytes
+            return skip((length + 4) & ~size_t(3));
+        }
+
+        bool skip(size_t nBytes) {
+            if (remaining() < nBytes) {
+                return false;
+            }
+            _pos += nBytes;
+            return true;
+        }
+
+        std::span<const std::byte> readBytes(size_t nBytes) {
+            const std::span<const std::byte> res = _data.subspan(_pos, nBytes);
+            _pos += nBytes;
+            return res;
+        }
+
+    private:
+        std::span<const std::byte> _data;
+        size_t _pos = 0;
+    };
+
+    bool parseMessage(std::span<const std::byte> data, Message& message) {
+        PacketReader reader = PacketReader(data);
+        if (!reader.read(message.address) || !message.address.starts_with('/')) {
+            return false;
+        }
+        message.arguments.clear();
+        // Old implementations send messages without the type tags and arguments
+        std::string tags;
+        if (reader.remaining() == 0) {
+            return true;
+        }
+        if (!reader.read(tags) || !tags.starts_with(',')) {
+            return false;
+        }
+
+        for (const char tag : std::string_view(tags).substr(1)) {
+            uint64_t value = 0;
+            switch (tag) {
+                case 'i':
+                    if (!reader.read(4, value)) {
+                        return false;
+                    }
+                    message.arguments.emplace_back(
+                        std::bit_cast<int32_t>(static_cast<uint32_t>(value))
+                    );
+                    break;
+                case 'h':
+                    if (!reader.read(8, value)) {
+                        return false;
+                    }
+                    message.arguments.emplace_back(std::bit_cast<int64_t>(value));
+                    break;
+                case 'f':
+                    if (!reader.read(4, value)) {
+                        return false;
+                    }
+                    message.arguments.emplace_back(
+                        std::bit_cast<float>(static_cast<uint32_t>(value))
+                    );
+                    break;
+                case 'd':
+                    if (!reader.read(8, value)) {
+                        return false;
+                    }
+                    message.arguments.emplace_back(std::bit_cast<double>(value));
+                    break;
+                case 's':
+                case 'S':
+                {
+                    std::string str;
+                    if (!reader.read(str)) {
+                        return false;
+                    }
+                    message.arguments.emplace_back(std::move(str));
+                    break;
+                }
+                case 'T':
+                    message.arguments.emplace_back(true);
+                    break;
+                case 'F':
+                    message.arguments.emplace_back(false);
+                    break;
+                case 'N':
+                case 'I':
+                    // Nil and impulse do not have a value
+                    break;
+                default:
+                    // The size of the other types' values is not known, so the rest of
+                    // the message cannot be read
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool parsePacket(std::span<const std::byte> data, int depth,
+                     std::vector<Message>& messages)
+    {
+        constexpr std::string_view BundleTag = std::string_view("#bundle\0", 8);
+        const bool isBundle = data.size() >= BundleTag.size() &&
+            std::equal(
+                BundleTag.begin(), BundleTag.end(),
+                reinterpret_cast<const char*>(data.data())
+            );
+        if (!isBundle) {
+            Message message;
+            if (!parseMessage(data, message)) {
+                return false;
+            }
+            messages.push_back(std::move(message));
+            return true;
+        }
+
+        if (depth >= MaxBundleDepth) {
+            return false;
+        }
+        // The time tag is ignored as the messages are applied with the next frame anyway
+        PacketReader reader = PacketReader(data);
+        if (!reader.skip(BundleTag.size() + sizeof(uint64_t))) {
+            return false;
+        }
+        while (reader.remaining() > 0) {
+            uint64_t size = 0;
+            if (!reader.read(4, size) || size > reader.remaining()) {
+                return false;
+            }
+            if (!parsePacket(reader.readBytes(size), depth + 1, messages)) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+namespace sgct {
+
+ExternalControl::ExternalControl(int tcpPort, int udpPort)
+    : _tcpSocket(static_cast<SGCT_SOCKET>(INVALID_SOCKET))
+    , _udpSocket(static_cast<SGCT_SOCKET>(INVALID_SOCKET))
+{
+    ZoneScoped;
+
+    if (tcpPort > 0) {
+        _tcpSocket = openSocket(SOCK_STREAM, IPPROTO_TCP, tcpPort);
+        if (_tcpSocket == INVALID_SOCKET) {
+            Log::Error(std::format(
+                "Failed to receive external control on TCP port {}: {}",
+                tcpPort, SGCT_ERRNO
+            ));
+        }
+        else {
+            Log::Info(std::format("Receiving external control on TCP port {}", tcpPort));
+        }
+    }
+    if (udpPort > 0) {
+        _udpSocket = openSocket(SOCK_DGRAM, IPPROTO_UDP, udpPort);
+        if (_udpSocket == INVALID_SOCKET) {
+            Log::Error(std::format(
+                "Failed to receive external control on UDP port {}: {}",
+                udpPort, SGCT_ERRNO
+            ));
+        }
+        else {
+            Log::Info(std::format("Receiving external control on UDP port {}", udpPort));
+            _datagram.resize(MaxPacketSize);
+        }
+    }
+
+    if (_tcpSocket != INVALID_SOCKET || _udpSocket != INVALID_SOCKET) {
+        _isRunning = true;
+        _thread = std::thread(&ExternalControl::work, this);
+    }
+}
+
+ExternalControl::~ExternalControl() {
+    _isRunning = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    for (const Client& client : _clients) {
+        closeSocket(client.socket);
+    }
+    if (_tcpSocket != INVALID_SOCKET) {
+        closeSocket(_tcpSocket);
+    }
+    if (_udpSocket != INVALID_SOCKET) {
+        closeSocket(_udpSocket);
+    }
+}
+
+void ExternalControl::update(void (*callback)(std::span<const Message>)) {
+    ZoneScoped;
+
+    _messages.clear();
+    {
+        const std::unique_lock lock(_mutex);
+        std::swap(_pending, _messages);
+        _pendingIndices.clear();
+    }
+
+    if (callback && !_messages.empty()) {
+        callback(_messages);
+    }
+}
+
+void ExternalControl::work() {
+    while (_isRunning) {
+        fd_set sockets;
+        FD_ZERO(&sockets);
+        SGCT_SOCKET maxSocket = 0;
+        auto add = [&sockets, &maxSocket](SGCT_SOCKET s) {
+            FD_SET(s, &sockets);
+            maxSocket = std::max(maxSocket, s);
+        };
+        if (_tcpSocket != INVALID_SOCKET) {
+            add(_tcpSocket);
+        }
+        if (_udpSocket != INVALID_SOCKET) {
+            add(_udpSocket);
+        }
+        for (const Client& client : _clients) {
+            add(client.socket);
+        }
+
+        timeval timeout = { 0, PollInterval };
+        const int nfds = static_cast<int>(maxSocket + 1);
+        const int res = select(nfds, &sockets, nullptr, nullptr, &timeout);
+        if (res <= 0) {
+            continue;
+        }
+
+        if (_udpSocket != INVALID_SOCKET && FD_ISSET(_udpSocket, &sockets)) {
+            const long size = recv(
+                _udpSocket,
+                reinterpret_cast<char*>(_datagram.data()),
+                static_cast<int>(_datagram.size()),
+                0
+            );
+            if (size > 0) {
+                handlePacket(std::span(_datagram).first(static_cast<size_t>(size)));
+            }
+        }
+
+        for (auto it = _clients.begin(); it != _clients.end();) {
+            if (FD_ISSET(it->socket, &sockets) && !receive(*it)) {
+                closeSocket(it->socket);
+                it = _clients.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+
+        if (_tcpSocket != INVALID_SOCKET && FD_ISSET(_tcpSocket, &sockets)) {
+            const SGCT_SOCKET client = accept(_tcpSocket, nullptr, nullptr);
+            if (client != INVALID_SOCKET) {
+                Log::Info("External control connection established");
+                _clients.push_back({ .socket = client, .buffer = {} });
+            }
+        }
+    }
+}
+
+bool ExternalControl::receive(Client& client) {
+    ZoneScoped;
+
+    std::array<std::byte, 4096> buffer;
+    const long size = recv(
+        client.socket,
+        reinterpret_cast<char*>(buffer.data()),
+        static_cast<int>(buffer.size()),
+        0
+    );
+    if (size <= 0) {
+        Log::Info("External control connection closed");
+        return false;
+    }
+    client.buffer.insert(client.buffer.end(), buffer.begin(), buffer.begin() + size);
+
+    // A single receive can contain several packets or only a part of one
+    size_t pos = 0;
+    while (client.buffer.size() - pos >= sizeof(uint32_t)) {
+        uint64_t packetSize = 0;
+        PacketReader reader = PacketReader(std::span(client.buffer).subspan(pos));
+        reader.read(sizeof(uint32_t), packetSize);
+        if (packetSize > MaxPacketSize) {
+            Log::Warning(std::format(
+                "Closing external control connection after a packet of {} bytes",
+                packetSize
+            ));
+            return false;
+        }
+        if (reader.remaining() < packetSize) {
+            break;
+        }
+        handlePacket(reader.readBytes(packetSize));
+        pos += sizeof(uint32_t) + packetSize;
+    }
+    client.buffer.erase(client.buffer.begin(), client.buffer.begin() + pos);
+    return true;
+}
+
+void ExternalControl::handlePacket(std::span<const std::byte> packet) {
+    ZoneScoped;
+
+    _parsed.clear();
+    if (!parsePacket(packet, 0, _parsed)) {
+        if (!_hasWarned) {
+            Log::Warning(std::format(
+                "Ignoring invalid external control packet of {} bytes", packet.size()
+            ));
+            _hasWarned = true;
+        }
+        return;
+    }
+
+    const std::unique_lock lock(_mutex);
+    for (Message& message : _parsed) {
+        const auto it = _pendingIndices.find(message.address);
+        if (it != _pendingIndices.end()) {
+            _pending[it->second] = std::move(message);
+        }
+        else {
+            _pendingIndices.emplace(message.address, _pending.size());
+            _pending.push_back(std::move(message));
+        }
+    }
+}
+
+} // namespace sgct
@@ -20,12 +20,13 @@
 #pragma clang diagnostic ignored "-Wold-style-cast"
 
 #include <freetype/ftglyph.h>
+#include <freetype/ftmodapi.h>
 #include <freetype/ftstroke.h>
 
 #pragma GCC diagnostic pop
 #pragma clang diagnostic pop
 
-#include <array>
+#include <algorithm>
 #include <optional>
 
 namespace {
@@ -136,39 +137,26 @@ namespace {
         return res;
     }
 
-    unsigned int generateTexture(int w, int h, const std::vector<unsigned char>& buffer) {
-        unsigned int tex = 0;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
+    // The glyphs are separated by empty texels, so that no texel of a neighbor is sampled
+    constexpr int GlyphPadding = 1;
 
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_COMPRESSED_RG,
-            w,
-            h,
-            0,
-            GL_RG,
-            GL_UNSIGNED_BYTE,
-            buffer.data()
-        );
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    // The distance in pixels from the outline at which the distance field saturates,
+    // which limits the width of the stroke. FreeType pads each glyph by this distance
+    constexpr int DistanceFieldSpread = 8;
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    // The number of texels up to which the atlas of a font grows. Beyond that, the
+    // glyphs that were not used for the longest time are replaced
+    constexpr int MaxAtlasTexels = 2048 * 2048;
 
-        return tex;
-    }
+    struct Glyph {
+        sgct::text::Font::FontFaceData ffd;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;
+    };
 
-    std::optional<sgct::text::Font::FontFaceData>
-    createGlyph(FT_Library library, FT_Face face, FT_Fixed strokeSize, char c)
+    std::optional<Glyph>
+    createGlyph(FT_Library library, FT_Face face, FT_Fixed strokeSize, char32_t c)
     {
         // Load the Glyph for our character.
         // Hints:
@@ -185,19 +173,12 @@ namespace {
         }
 
         // load pixel data
-        const PixelDataResult res = getPixelData(library, face, strokeSize);
+        PixelDataResult res = getPixelData(library, face, strokeSize);
         if (!res.success) {
             return std::nullopt;
         }
 
         sgct::text::Font::FontFaceData ffd;
-        // create texture
-        if (charIndex > 0) {
-            ffd.texId = generateTexture(res.width, res.height, res.pixels);
-        }
-        else {
-            ffd.texId = 0;
-        }
 
         // setup geometry data
         ffd.pos.x = static_cast<float>(res.gd.bitmapGlyph->left);
@@ -217,32 +198,87 @@ namespace {
         ffd.glyph = res.gd.glyph;
         ffd.distToNextChar = static_cast<float>(face->glyph->advance.x / 64);
 
-        return ffd;
+        return Glyph{
+            .ffd = ffd,
+            .width = res.width,
+            .height = res.height,
+            .pixels = std::move(res.pixels)
+        };
+    }
+
+    std::optional<Glyph> createDistanceFieldGlyph(FT_Face face, char32_t c) {
+        const FT_UInt charIndex = FT_Get_Char_Index(face, static_cast<FT_ULong>(c));
+        if (charIndex == 0) {
+            return std::nullopt;
+        }
+
+        // The glyph is scaled when it is rendered, so it is not hinted to the pixel grid
+        // of its original size
+        const FT_Error loadError = FT_Load_Glyph(face, charIndex, FT_LOAD_NO_HINTING);
+        if (loadError) {
+            return std::nullopt;
+        }
+
+        Glyph res;
+        FT_GlyphSlot slot = face->glyph;
+        res.ffd.distToNextChar = static_cast<float>(slot->advance.x / 64);
+        if (slot->outline.n_points == 0) {
+            // Nothing to render for white space
+            return res;
+        }
+
+        const FT_Error renderError = FT_Render_Glyph(slot, FT_RENDER_MODE_SDF);
+        if (renderError) {
+            return std::nullopt;
+        }
+
+        const FT_Bitmap& bitmap = slot->bitmap;
+        res.width = static_cast<int>(bitmap.width);
+        res.height = static_cast<int>(bitmap.rows);
+        res.pixels.resize(
+            static_cast<size_t>(res.width) * static_cast<size_t>(res.height)
+        );
+        for (int j = 0; j < res.height; j++) {
+            std::copy_n(
+                bitmap.buffer + static_cast<ptrdiff_t>(j) * bitmap.pitch,
+                res.width,
+                res.pixels.begin() + static_cast<size_t>(j) * res.width
+            );
+        }
+
+        // The bitmap is larger than the glyph by the spread on all sides, which the
+        // position of the bitmap already includes
+        const int y = slot->bitmap_top - res.height;
+        res.ffd.pos.x = static_cast<float>(slot->bitmap_left);
+        res.ffd.pos.y = static_cast<float>(y);
+        res.ffd.size.x = static_cast<float>(res.width);
+        res.ffd.size.y = static_cast<float>(res.height);
+        return res;
     }
 } // namespace
 
 namespace sgct::text {
 
-Font::Font(FT_Library lib, FT_Face face, unsigned int height)
+Font::Font(FT_Library lib, FT_Face face, unsigned int height, bool isDistanceField)
     : _library(lib)
     , _face(face)
     , _height(static_cast<float>(height))
+    , _isDistanceField(isDistanceField)
+    , _channels(isDistanceField ? 1 : 2)
 {
+    if (_isDistanceField) {
+        // The spread is a property of the renderer, which is shared by all faces
+        const FT_Int spread = DistanceFieldSpread;
+        FT_Property_Set(_library, "sdf", "spread", &spread);
+    }
+
     glGenVertexArrays(1, &_vao);
     glGenBuffers(1, &_vbo);
 
-    constexpr std::array<float, 16> c = std::array<float, 16> {
-        // x y s t
-        0.f, 1.f, 0.f, 0.f,
-        1.f, 1.f, 1.f, 0.f,
-        0.f, 0.f, 0.f, 1.f,
-        1.f, 0.f, 1.f, 1.f
-    };
-
     glBindVertexArray(_vao);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, c.size() * sizeof(float), c.data(), GL_STATIC_DRAW);
 
+    // x y s t
     constexpr int s = 4 * sizeof(float);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, s, nullptr);
@@ -250,13 +286,39 @@ Font::Font(FT_Library lib, FT_Face face, unsigned int height)
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(8));
 
     glBindVertexArray(0);
+
+    // The face is rendered at 96 dpi, so a glyph is about 4/3 of the height wide. There
+    // are about 16 glyphs in each row of the atlas, which only grows in height
+    int width = 256;
+    while (width < 32 * static_cast<int>(height)) {
+        width *= 2;
+    }
+    _atlasSize = ivec2{ width, width / 4 };
+    _maxAtlasHeight = std::max(MaxAtlasTexels / width, _atlasSize.y);
+    _atlasPixels.resize(
+        static_cast<size_t>(_channels) * static_cast<size_t>(width) *
+        static_cast<size_t>(width / 4)
+    );
+
+    // The distances are interpolated between the texels, which is what makes the edge
+    // of a scaled glyph sharp
+    const GLint filter = _isDistanceField ? GL_LINEAR : GL_NEAREST;
+    glGenTextures(1, &_atlas);
+    glBindTexture(GL_TEXTURE_2D, _atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    uploadAtlas();
 }
 
 Font::~Font() {
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
-    for (const std::pair<const char, FontFaceData>& n : _fontFaceData) {
-        glDeleteTextures(1, &(n.second.texId));
+    glDeleteTextures(1, &_atlas);
+    for (const std::pair<const char32_t, FontFaceData>& n : _fontFaceData) {
         FT_Done_Glyph(n.second.glyph);
     }
 
@@ -269,30 +331,234 @@ void Font::setStrokeSize(int size) {
     _strokeSize = size;
 }
 
-const Font::FontFaceData& Font::fontFaceData(char c) {
-    if (!_fontFaceData.contains(c)) {
+const Font::FontFaceData& Font::fontFaceData(char32_t c) {
+    auto it = _fontFaceData.find(c);
+    if (it == _fontFaceData.end()) {
         // check if c does not exist in map
         createCharacter(c);
+        it = _fontFaceData.try_emplace(c).first;
     }
-    return _fontFaceData[c];
+
+    const FontFaceData& ffd = it->second;
+    if (ffd.size.x > 0.f && ffd.size.y > 0.f) {
+        // The rows are ordered by their position in the atlas
+        const auto row = std::upper_bound(
+            _rows.begin(),
+            _rows.end(),
+            ffd.atlasPos.y,
+            [](int y, const Row& r) { return y < r.y; }
+        );
+        std::prev(row)->lastUse = ++_useCounter;
+    }
+    return ffd;
 }
 
 unsigned int Font::vao() const {
     return _vao;
 }
 
+unsigned int Font::vbo() const {
+    return _vbo;
+}
+
+unsigned int Font::atlasTexture() const {
+    return _atlas;
+}
+
 float Font::height() const {
     return _height;
 }
 
-void Font::createCharacter(char c) {
-    std::optional<FontFaceData> ffd = createGlyph(_library, _face, _strokeSize, c);
-    if (ffd) {
-        _fontFaceData[c] = std::move(*ffd);
+bool Font::isDistanceField() const {
+    return _isDistanceField;
+}
+
+uint64_t Font::atlasRevision() const {
+    return _atlasRevision;
+}
+
+float Font::distanceFieldStroke() const {
+    // The distance field covers the spread on both sides of the outline
+    return static_cast<float>(_strokeSize) / (2.f * DistanceFieldSpread);
+}
+
+void Font::createCharacter(char32_t c) {
+    std::optional<Glyph> glyph =
+        _isDistanceField ?
+        createDistanceFieldGlyph(_face, c) :
+        createGlyph(_library, _face, _strokeSize, c);
+    if (!glyph) {
+        Log::Error(std::format(
+            "Error creating character U+{:04X}", static_cast<uint32_t>(c)
+        ));
+        return;
+    }
+
+    glyph->ffd.texId = _atlas;
+    if (glyph->width > 0 && glyph->height > 0) {
+        std::optional<ivec2> pos =
+            addToAtlas(c, glyph->width, glyph->height, glyph->pixels);
+        if (!pos) {
+            Log::Error(std::format(
+                "Character U+{:04X} is too large for the font atlas",
+                static_cast<uint32_t>(c)
+            ));
+            FT_Done_Glyph(glyph->ffd.glyph);
+            return;
+        }
+        glyph->ffd.atlasPos = *pos;
+    }
+    _fontFaceData[c] = std::move(glyph->ffd);
+}
+
+std::optional<ivec2> Font::addToAtlas(char32_t c, int width, int height,
+                                      const std::vector<unsigned char>& pixels)
+{
+    const int w = width + GlyphPadding;
+    const int h = height + GlyphPadding;
+    if (w + GlyphPadding > _atlasSize.x || h + GlyphPadding > _maxAtlasHeight) {
+        return std::nullopt;
+    }
+
+    auto row = std::find_if(
+        _rows.begin(),
+        _rows.end(),
+        [&](const Row& r) { return r.height >= h && r.x + w <= _atlasSize.x; }
+    );
+
+    bool grows = false;
+    if (row == _rows.end()) {
+        // The rows are as high as a line, including the stroke or the spread of the
+        // distance field, so that most glyphs fit into any row
+        const int border =
+            _isDistanceField ? DistanceFieldSpread : static_cast<int>(_strokeSize);
+        const int lineHeight = static_cast<int>(_face->size->metrics.height >> 6);
+        const int rowHeight = std::max(h, lineHeight + 2 * border + GlyphPadding);
+
+        const int y = _rows.empty() ? 0 : _rows.back().y + _rows.back().height;
+        const int neededHeight = y + rowHeight + GlyphPadding;
+        int atlasHeight = _atlasSize.y;
+        while (atlasHeight < neededHeight && atlasHeight < _maxAtlasHeight) {
+            atlasHeight = std::min(2 * atlasHeight, _maxAtlasHeight);
+        }
+
+        if (neededHeight <= atlasHeight) {
+            _rows.push_back(Row{ .y = y, .height = rowHeight });
+            row = std::prev(_rows.end());
+            grows = atlasHeight > _atlasSize.y;
+            if (grows) {
+                // The rows are stored one after the other, so growing the atlas in
+                // height keeps the position of all glyphs that were already placed
+                _atlasSize.y = atlasHeight;
+                _atlasPixels.resize(
+                    static_cast<size_t>(_channels) * static_cast<size_t>(_atlasSize.x) *
+                    static_cast<size_t>(_atlasSize.y)
+                );
+            }
+        }
+        else {
+            // The atlas is full, so the glyphs in the row that was not used for the
+            // longest time make room for this one
+            row = _rows.end();
+            for (auto it = _rows.begin(); it != _rows.end(); it++) {
+                if (it->height >= h && (row == _rows.end() || it->lastUse < row->lastUse))
+                {
+                    row = it;
+                }
+            }
+            if (row == _rows.end()) {
+                return std::nullopt;
+            }
+            clearRow(static_cast<size_t>(std::distance(_rows.begin(), row)));
+        }
+    }
+
+    const ivec2 pos = ivec2{ row->x + GlyphPadding, row->y + GlyphPadding };
+    row->x += w;
+    row->lastUse = ++_useCounter;
+    row->glyphs.push_back(c);
+
+    const size_t stride = static_cast<size_t>(_channels) * _atlasSize.x;
+    const size_t rowSize = static_cast<size_t>(_channels) * width;
+    const size_t column = static_cast<size_t>(_channels) * pos.x;
+    for (int j = 0; j < height; j++) {
+        std::copy_n(
+            pixels.begin() + static_cast<size_t>(j) * rowSize,
+            rowSize,
+            _atlasPixels.begin() + static_cast<size_t>(pos.y + j) * stride + column
+        );
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _atlas);
+    if (grows) {
+        uploadAtlas();
     }
     else {
-        Log::Error(std::format("Error creating character {}", c));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            pos.x,
+            pos.y,
+            width,
+            height,
+            _isDistanceField ? GL_RED : GL_RG,
+            GL_UNSIGNED_BYTE,
+            pixels.data()
+        );
     }
+    return pos;
+}
+
+void Font::clearRow(size_t row) {
+    Row& r = _rows[row];
+    for (const char32_t glyph : r.glyphs) {
+        const auto it = _fontFaceData.find(glyph);
+        FT_Done_Glyph(it->second.glyph);
+        _fontFaceData.erase(it);
+    }
+    r.glyphs.clear();
+    r.x = 0;
+    _atlasRevision++;
+
+    // The padding between the glyphs has to stay empty, so the whole row is cleared
+    const size_t stride = static_cast<size_t>(_channels) * _atlasSize.x;
+    const auto begin = _atlasPixels.begin() + static_cast<size_t>(r.y) * stride;
+    std::fill(begin, begin + static_cast<size_t>(r.height) * stride, 0);
+
+    glBindTexture(GL_TEXTURE_2D, _atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        r.y,
+        _atlasSize.x,
+        r.height,
+        _isDistanceField ? GL_RED : GL_RG,
+        GL_UNSIGNED_BYTE,
+        _atlasPixels.data() + static_cast<size_t>(r.y) * stride
+    );
+}
+
+void Font::uploadAtlas() {
+    const GLint internalFormat = _isDistanceField ? GL_R8 : GL_RG8;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        internalFormat,
+        _atlasSize.x,
+        _atlasSize.y,
+        0,
+        _isDistanceField ? GL_RED : GL_RG,
+        GL_UNSIGNED_BYTE,
+        _atlasPixels.data()
+    );
+
+    const size_t texels =
+        static_cast<size_t>(_atlasSize.x) * static_cast<size_t>(_atlasSize.y);
+    _textureMemory.set(texels * MemoryTracker::bytesPerTexel(internalFormat));
 }
 
 } // namespace sgct::text
@@ -10,6 +10,7 @@
 
 #include <sgct/fontmanager.h>
 
+#include <sgct/engine.h>
 #include <sgct/font.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
@@ -46,15 +47,17 @@ namespace {
 
     constexpr std::string_view FontVertShader = R"(
 #version 330 core
-layout (location = 0) in vec2 in_texCoord;
-layout (location = 1) in vec2 in_position;
+layout (location = 0) in vec2 in_position;
+layout (location = 1) in vec2 in_texel;
 out vec2 tr_uv;
 
 uniform mat4 mvp;
+uniform sampler2D tex;
 
 void main() {
     gl_Position = mvp * vec4(in_position, 0.0, 1.0);
-    tr_uv = in_texCoord;
+    // The atlas grows while glyphs are added, so the texels are only normalized here
+    tr_uv = in_texel / vec2(textureSize(tex, 0));
 })";
 
     constexpr std::string_view FontFragShader = R"(
@@ -72,6 +75,31 @@ void main() {
     vec4 blend = mix(StrokeCol, col, luminanceAlpha.r);
     out_color = blend * vec4(1.0, 1.0, 1.0, luminanceAlpha.g);
 })";
+
+    constexpr std::string_view DistanceFieldFragShader = R"(
+#version 330 core
+in vec2 tr_uv;
+out vec4 out_color;
+
+uniform vec4 col;
+uniform sampler2D tex;
+uniform float stroke;
+
+const vec4 StrokeCol = vec4(0.0, 0.0, 0.0, 0.9);
+
+void main() {
+    // The distance is 0.5 on the outline. The edges are antialiased over one pixel on
+    // the screen, independent of how much the glyph is scaled
+    float dist = texture(tex, tr_uv).r;
+    float w = fwidth(dist);
+    float fill = smoothstep(0.5 - w, 0.5 + w, dist);
+    float outline = smoothstep(0.5 - stroke - w, 0.5 - stroke + w, dist);
+    vec4 blend = mix(StrokeCol, col, fill);
+    out_color = blend * vec4(1.0, 1.0, 1.0, outline);
+})";
+
+    // The size at which the glyphs of distance field fonts are rendered into the atlas
+    constexpr unsigned int DistanceFieldHeight = 32;
 } // namespace
 
 namespace sgct::text {
@@ -91,13 +119,6 @@ void FontManager::destroy() {
 }
 
 FontManager::FontManager() {
-    const FT_Error error = FT_Init_FreeType(&_library);
-
-    if (error != 0) {
-        Log::Error("Could not initiate Freetype library");
-        return;
-    }
-
     // Set default font path
 #ifdef WIN32
     constexpr int BufferSize = 256;
@@ -119,12 +140,14 @@ FontManager::~FontManager() {
     // We need to delete all of the fonts before destroying the FreeType library or the
     // destructor of the Font classes will access the library after it has been destroyed
     _fontMap.clear();
+    _distanceFieldFonts.clear();
 
     if (_library) {
         FT_Done_FreeType(_library);
     }
 
     _shader.deleteProgram();
+    _distanceFieldShader.deleteProgram();
 }
 
 void FontManager::bindShader(const mat4& mvp, const vec4& color, int texture) const {
@@ -135,6 +158,17 @@ void FontManager::bindShader(const mat4& mvp, const vec4& color, int texture) co
     glUniformMatrix4fv(_mvpLocation, 1, GL_FALSE, mvp.values.data());
 }
 
+void FontManager::bindDistanceFieldShader(const mat4& mvp, const vec4& color, int texture,
+                                          float stroke) const
+{
+    _distanceFieldShader.bind();
+
+    glUniform4fv(_distanceFieldLocations.color, 1, &color.x);
+    glUniform1i(_distanceFieldLocations.texture, texture);
+    glUniform1f(_distanceFieldLocations.stroke, stroke);
+    glUniformMatrix4fv(_distanceFieldLocations.mvp, 1, GL_FALSE, mvp.values.data());
+}
+
 bool FontManager::addFont(std::string name, std::string file) {
     // Perform file exists check
     file = SystemFontPath + file;
@@ -158,7 +192,21 @@ Font* FontManager::font(const std::string& name, unsigned int height) {
     return _fontMap[{ name, height }].get();
 }
 
-std::unique_ptr<Font> FontManager::createFont(const std::string& name, int height) {
+Font* FontManager::distanceFieldFont(const std::string& name) {
+    if (!_distanceFieldFonts.contains(name)) {
+        std::unique_ptr<Font> f = createFont(name, DistanceFieldHeight, true);
+        if (!f) {
+            return nullptr;
+        }
+        _distanceFieldFonts[name] = std::move(f);
+    }
+
+    return _distanceFieldFonts[name].get();
+}
+
+std::unique_ptr<Font> FontManager::createFont(const std::string& name, int height,
+                                              bool isDistanceField)
+{
     const auto it = _fontPaths.find(name);
 
     if (it == _fontPaths.end()) {
@@ -166,6 +214,21 @@ std::unique_ptr<Font> FontManager::createFont(const std::string& name, int heigh
         return nullptr;
     }
 
+    const double t0 = time();
+    if (!_isLibraryInitialized) {
+        _isLibraryInitialized = true;
+        const FT_Error error = FT_Init_FreeType(&_library);
+        if (error != 0) {
+            Log::Error("Could not initiate Freetype library");
+            _library = nullptr;
+        }
+        else {
+            Log::Debug(std::format(
+                "Initialized the Freetype library ({:.2f} ms)", (time() - t0) * 1000.0
+            ));
+        }
+    }
+
     if (_library == nullptr) {
         Log::Error(std::format(
             "Freetype library is not initialized, cannot create font '{}'", name
@@ -194,10 +257,9 @@ std::unique_ptr<Font> FontManager::createFont(const std::string& name, int heigh
     }
 
     // Create the font when all error tests are done
-    auto font = std::make_unique<Font>(_library, face, height);
+    auto font = std::make_unique<Font>(_library, face, height, isDistanceField);
 
-    static bool isShaderCreated = false;
-    if (!isShaderCreated) {
+    if (_shader.id() == 0) {
         _shader = ShaderProgram("FontShader");
         _shader.addVertexShader(FontVertShader);
         _shader.addFragmentShader(FontFragShader);
@@ -208,10 +270,27 @@ std::unique_ptr<Font> FontManager::createFont(const std::string& name, int heigh
         _colorLocation = glGetUniformLocation(_shader.id(), "col");
         _textureLocation = glGetUniformLocation(_shader.id(), "tex");
         ShaderProgram::unbind();
+    }
 
-        isShaderCreated = true;
+    if (isDistanceField && _distanceFieldShader.id() == 0) {
+        _distanceFieldShader = ShaderProgram("FontDistanceFieldShader");
+        _distanceFieldShader.addVertexShader(FontVertShader);
+        _distanceFieldShader.addFragmentShader(DistanceFieldFragShader);
+        _distanceFieldShader.createAndLinkProgram();
+        _distanceFieldShader.bind();
+
+        const unsigned int id = _distanceFieldShader.id();
+        _distanceFieldLocations.mvp = glGetUniformLocation(id, "mvp");
+        _distanceFieldLocations.color = glGetUniformLocation(id, "col");
+        _distanceFieldLocations.texture = glGetUniformLocation(id, "tex");
+        _distanceFieldLocations.stroke = glGetUniformLocation(id, "stroke");
+        ShaderProgram::unbind();
     }
 
+    Log::Debug(std::format(
+        "Created font '{}' with a height of {} pixels ({:.2f} ms)",
+        name, height, (time() - t0) * 1000.0
+    ));
     return font;
 }
 
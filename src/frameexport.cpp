@@ -0,0 +1,723 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/frameexport.h>
+
+#ifdef WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+#include <d3d11.h>
+#include <dxgi1_2.h>
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#endif // WIN32
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace {
+#ifdef WIN32
+    // The functions of the WGL_NV_DX_interop extension, which is not part of the loader
+    using DXOpenDevice = HANDLE(WINAPI*)(void* dxDevice);
+    using DXCloseDevice = BOOL(WINAPI*)(HANDLE device);
+    using DXRegisterObject =
+        HANDLE(WINAPI*)(HANDLE device, void* dxObject, GLuint name, GLenum type,
+            GLenum access);
+    using DXUnregisterObject = BOOL(WINAPI*)(HANDLE device, HANDLE object);
+    using DXLockObjects = BOOL(WINAPI*)(HANDLE device, GLint count, HANDLE* objects);
+
+    constexpr GLenum AccessWriteDiscard = 0x0002;
+
+    // The keys of the keyed mutex with which the texture is passed to the consumers and
+    // back
+    constexpr UINT64 WriteKey = 0;
+    constexpr UINT64 ReadKey = 1;
+
+    struct Functions {
+        DXOpenDevice openDevice = nullptr;
+        DXCloseDevice closeDevice = nullptr;
+        DXRegisterObject registerObject = nullptr;
+        DXUnregisterObject unregisterObject = nullptr;
+        DXLockObjects lockObjects = nullptr;
+        DXLockObjects unlockObjects = nullptr;
+    };
+
+    const Functions* functions() {
+        static const Functions Fns = {
+            .openDevice = reinterpret_cast<DXOpenDevice>(
+                wglGetProcAddress("wglDXOpenDeviceNV")
+            ),
+            .closeDevice = reinterpret_cast<DXCloseDevice>(
+                wglGetProcAddress("wglDXCloseDeviceNV")
+            ),
+            .registerObject = reinterpret_cast<DXRegisterObject>(
+                wglGetProcAddress("wglDXRegisterObjectNV")
+            ),
+            .unregisterObject = reinterpret_cast<DXUnregisterObject>(
+                wglGetProcAddress("wglDXUnregisterObjectNV")
+            ),
+            .lockObjects = reinterpret_cast<DXLockObjects>(
+                wglGetProcAddress("wglDXLockObjectsNV")
+            ),
+            .unlockObjects = reinterpret_cast<DXLockObjects>(
+                wglGetProcAddress("wglDXUnlockObjectsNV")
+            )
+        };
+
+        const bool isComplete = Fns.openDevice && Fns.closeDevice && Fns.registerObject &&
+            Fns.unregisterObject && Fns.lockObjects && Fns.unlockObjects;
+        return isComplete ? &Fns : nullptr;
+    }
+
+    std::wstring toWideString(const std::string& str) {
+        const int size = MultiByteToWideChar(
+            CP_UTF8,
+            0,
+            str.data(),
+            static_cast<int>(str.size()),
+            nullptr,
+            0
+        );
+        std::wstring res = std::wstring(size, L'\0');
+        MultiByteToWideChar(
+            CP_UTF8,
+            0,
+            str.data(),
+            static_cast<int>(str.size()),
+            res.data(),
+            size
+        );
+        return res;
+    }
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+    // The types, constants, and functions of EGL and of its EGL_KHR_image_base,
+    // EGL_KHR_gl_texture_2D_image, EGL_MESA_image_dma_buf_export, and
+    // EGL_ANDROID_native_fence_sync extensions, whose headers are not required
+    using EGLDisplay = void*;
+    using EGLContext = void*;
+    using EGLImage = void*;
+    using EGLSync = void*;
+    using EGLint = int32_t;
+    using EGLenum = unsigned int;
+    using EGLBoolean = unsigned int;
+
+    constexpr EGLint EglNone = 0x3038;
+    constexpr EGLint EglExtensions = 0x3055;
+    constexpr EGLenum EglGLTexture2D = 0x30B1;
+    constexpr EGLint EglGLTextureLevel = 0x30BC;
+    constexpr EGLenum EglSyncNativeFence = 0x3144;
+    constexpr EGLint EglNoNativeFenceFd = -1;
+
+    using GetCurrentDisplay = EGLDisplay(*)();
+    using GetCurrentContext = EGLContext(*)();
+    using QueryString = const char*(*)(EGLDisplay display, EGLint name);
+    using CreateImage =
+        EGLImage(*)(EGLDisplay display, EGLContext context, EGLenum target,
+            void* buffer, const EGLint* attributes);
+    using DestroyImage = EGLBoolean(*)(EGLDisplay display, EGLImage image);
+    using ExportQuery =
+        EGLBoolean(*)(EGLDisplay display, EGLImage image, int* fourcc, int* nPlanes,
+            uint64_t* modifiers);
+    using ExportImage =
+        EGLBoolean(*)(EGLDisplay display, EGLImage image, int* fds, EGLint* strides,
+            EGLint* offsets);
+    using CreateSync =
+        EGLSync(*)(EGLDisplay display, EGLenum type, const EGLint* attributes);
+    using DestroySync = EGLBoolean(*)(EGLDisplay display, EGLSync sync);
+    using DupNativeFenceFd = EGLint(*)(EGLDisplay display, EGLSync sync);
+
+    struct Functions {
+        GetCurrentDisplay getCurrentDisplay = nullptr;
+        GetCurrentContext getCurrentContext = nullptr;
+        CreateImage createImage = nullptr;
+        DestroyImage destroyImage = nullptr;
+        ExportQuery exportQuery = nullptr;
+        ExportImage exportImage = nullptr;
+        // The fences are optional, without them the frames are finished before they are
+        // passed to the consumers
+        CreateSync createSync = nullptr;
+        DestroySync destroySync = nullptr;
+        DupNativeFenceFd dupNativeFenceFd = nullptr;
+    };
+
+    // The functions are only returned by GLFW while an EGL context is current, and are
+    // loaded by the first export, as all contexts of the windows have the same API
+    const Functions* functions() {
+        static const Functions Fns = []() {
+            // Other context APIs would return functions for any name
+            Functions fns;
+            GLFWwindow* window = glfwGetCurrentContext();
+            const bool isEgl = window &&
+                glfwGetWindowAttrib(window, GLFW_CONTEXT_CREATION_API) ==
+                GLFW_EGL_CONTEXT_API;
+            if (!isEgl) {
+                return fns;
+            }
+
+            fns.getCurrentDisplay = reinterpret_cast<GetCurrentDisplay>(
+                glfwGetProcAddress("eglGetCurrentDisplay")
+            );
+            fns.getCurrentContext = reinterpret_cast<GetCurrentContext>(
+                glfwGetProcAddress("eglGetCurrentContext")
+            );
+            auto queryString =
+                reinterpret_cast<QueryString>(glfwGetProcAddress("eglQueryString"));
+            if (!fns.getCurrentDisplay || !fns.getCurrentContext || !queryString) {
+                return fns;
+            }
+
+            const char* ext = queryString(fns.getCurrentDisplay(), EglExtensions);
+            auto hasExtension = [ext](std::string_view name) {
+                // The names are separated by spaces, and some are prefixes of others
+                std::string_view extensions = ext ? ext : "";
+                size_t pos = extensions.find(name);
+                while (pos != std::string_view::npos) {
+                    const size_t end = pos + name.size();
+                    if (end == extensions.size() || extensions[end] == ' ') {
+                        return true;
+                    }
+                    pos = extensions.find(name, end);
+                }
+                return false;
+            };
+
+            if (hasExtension("EGL_KHR_gl_texture_2D_image") &&
+                hasExtension("EGL_MESA_image_dma_buf_export"))
+            {
+                fns.createImage = reinterpret_cast<CreateImage>(
+                    glfwGetProcAddress("eglCreateImageKHR")
+                );
+                fns.destroyImage = reinterpret_cast<DestroyImage>(
+                    glfwGetProcAddress("eglDestroyImageKHR")
+                );
+                fns.exportQuery = reinterpret_cast<ExportQuery>(
+                    glfwGetProcAddress("eglExportDMABUFImageQueryMESA")
+                );
+                fns.exportImage = reinterpret_cast<ExportImage>(
+                    glfwGetProcAddress("eglExportDMABUFImageMESA")
+                );
+            }
+            if (hasExtension("EGL_ANDROID_native_fence_sync")) {
+                fns.createSync = reinterpret_cast<CreateSync>(
+                    glfwGetProcAddress("eglCreateSyncKHR")
+                );
+                fns.destroySync = reinterpret_cast<DestroySync>(
+                    glfwGetProcAddress("eglDestroySyncKHR")
+                );
+                fns.dupNativeFenceFd = reinterpret_cast<DupNativeFenceFd>(
+                    glfwGetProcAddress("eglDupNativeFenceFDANDROID")
+                );
+                if (!fns.createSync || !fns.destroySync || !fns.dupNativeFenceFd) {
+                    fns.createSync = nullptr;
+                }
+            }
+            return fns;
+        }();
+
+        const bool isComplete = Fns.createImage && Fns.destroyImage &&
+            Fns.exportQuery && Fns.exportImage;
+        return isComplete ? &Fns : nullptr;
+    }
+
+    // The number of images that are written in turns
+    constexpr size_t NImages = 3;
+
+    enum class SendResult {
+        Sent,
+        // The consumer has not read the previous messages yet
+        Busy,
+        Failed
+    };
+
+    SendResult sendMessage(int socket, const void* data, size_t size,
+                           std::span<const int> fds)
+    {
+        iovec iov = {
+            .iov_base = const_cast<void*>(data),
+            .iov_len = size
+        };
+        msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        std::vector<std::byte> control;
+        if (!fds.empty()) {
+            control.resize(CMSG_SPACE(fds.size_bytes()));
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(fds.size_bytes());
+            std::memcpy(CMSG_DATA(cmsg), fds.data(), fds.size_bytes());
+        }
+
+        const ssize_t res = sendmsg(socket, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (res == static_cast<ssize_t>(size)) {
+            return SendResult::Sent;
+        }
+        // A partially sent message breaks the stream, so only a message that was not sent
+        // at all can be skipped
+        const bool isBusy = res == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        return isBusy ? SendResult::Busy : SendResult::Failed;
+    }
+#endif // WIN32
+
+    // Blits the read framebuffer into the \p texture, flipped so that the rows are stored
+    // from the top
+    void blit(GLuint fbo, GLuint texture, sgct::ivec2 size) {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(
+            GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            texture,
+            0
+        );
+        glBlitFramebuffer(
+            0,
+            0,
+            size.x,
+            size.y,
+            0,
+            size.y,
+            size.x,
+            0,
+            GL_COLOR_BUFFER_BIT,
+            GL_NEAREST
+        );
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    }
+
+    GLuint createTexture(sgct::ivec2 size) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RGBA8,
+            size.x,
+            size.y,
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return texture;
+    }
+} // namespace
+
+namespace sgct {
+
+std::unique_ptr<FrameExport> FrameExport::create(const std::string& name,
+                                                 [[maybe_unused]] ivec2 size)
+{
+    ZoneScoped;
+
+#ifdef WIN32
+    const Functions* fns = functions();
+    if (!fns) {
+        Log::Warning(std::format(
+            "WGL_NV_DX_interop is not available for exporting the frames of '{}'", name
+        ));
+        return nullptr;
+    }
+
+    std::unique_ptr<FrameExport> res = std::unique_ptr<FrameExport>(new FrameExport);
+    res->_name = name;
+    res->_size = size;
+
+    ID3D11Device* device = nullptr;
+    const HRESULT createRes = D3D11CreateDevice(
+        nullptr,
+        D3D_DRIVER_TYPE_HARDWARE,
+        nullptr,
+        0,
+        nullptr,
+        0,
+        D3D11_SDK_VERSION,
+        &device,
+        nullptr,
+        nullptr
+    );
+    if (FAILED(createRes)) {
+        Log::Warning(std::format(
+            "Could not create the DirectX device for exporting the frames of '{}'", name
+        ));
+        return nullptr;
+    }
+    res->_dxDevice = device;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = static_cast<UINT>(size.x);
+    desc.Height = static_cast<UINT>(size.y);
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    desc.MiscFlags =
+        D3D11_RESOURCE_MISC_SHARED_NTHANDLE | D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX;
+    ID3D11Texture2D* texture = nullptr;
+    if (FAILED(device->CreateTexture2D(&desc, nullptr, &texture))) {
+        Log::Warning(std::format(
+            "Could not create the shared texture for exporting the frames of '{}'", name
+        ));
+        return nullptr;
+    }
+    res->_dxTexture = texture;
+
+    IDXGIResource1* resource = nullptr;
+    HANDLE sharedHandle = nullptr;
+    const std::wstring handleName = toWideString("SGCT_FrameExport_" + name);
+    HRESULT shareRes = texture->QueryInterface(
+        __uuidof(IDXGIResource1),
+        reinterpret_cast<void**>(&resource)
+    );
+    if (SUCCEEDED(shareRes)) {
+        shareRes = resource->CreateSharedHandle(
+            nullptr,
+            DXGI_SHARED_RESOURCE_READ | DXGI_SHARED_RESOURCE_WRITE,
+            handleName.c_str(),
+            &sharedHandle
+        );
+        resource->Release();
+    }
+    IDXGIKeyedMutex* keyedMutex = nullptr;
+    if (SUCCEEDED(shareRes)) {
+        shareRes = texture->QueryInterface(
+            __uuidof(IDXGIKeyedMutex),
+            reinterpret_cast<void**>(&keyedMutex)
+        );
+    }
+    res->_sharedHandle = sharedHandle;
+    res->_keyedMutex = keyedMutex;
+    if (FAILED(shareRes)) {
+        Log::Warning(std::format(
+            "Could not share the texture for exporting the frames of '{}'", name
+        ));
+        return nullptr;
+    }
+
+    res->_interopDevice = fns->openDevice(device);
+    if (!res->_interopDevice) {
+        Log::Warning("Could not open the DirectX device for OpenGL interop");
+        return nullptr;
+    }
+    res->_textures.push_back(0);
+    glGenTextures(1, res->_textures.data());
+    res->_interopObject = fns->registerObject(
+        res->_interopDevice,
+        texture,
+        res->_textures.front(),
+        GL_TEXTURE_2D,
+        AccessWriteDiscard
+    );
+    if (!res->_interopObject) {
+        Log::Warning(std::format(
+            "Could not register the shared texture for exporting the frames of '{}'",
+            name
+        ));
+        return nullptr;
+    }
+    glGenFramebuffers(1, &res->_fbo);
+    res->_memory.set(
+        static_cast<size_t>(size.x) * size.y * MemoryTracker::bytesPerTexel(GL_RGBA8)
+    );
+
+    Log::Info(std::format(
+        "Exporting the frames of '{}' as the shared texture '{}' of {}x{} pixels",
+        name, "SGCT_FrameExport_" + name, size.x, size.y
+    ));
+    return res;
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+    const Functions* fns = functions();
+    if (!fns) {
+        Log::Warning(std::format(
+            "EGL_MESA_image_dma_buf_export is not available for exporting the frames of "
+            "'{}', which requires the OpenGL context to be created through EGL", name
+        ));
+        return nullptr;
+    }
+
+    std::unique_ptr<FrameExport> res = std::unique_ptr<FrameExport>(new FrameExport);
+    res->_name = name;
+    res->_size = size;
+    res->_display = fns->getCurrentDisplay();
+    const EGLContext context = fns->getCurrentContext();
+
+    for (size_t i = 0; i < NImages; i++) {
+        const GLuint texture = createTexture(size);
+        res->_textures.push_back(texture);
+
+        constexpr std::array<EGLint, 3> Attributes = { EglGLTextureLevel, 0, EglNone };
+        EGLImage image = fns->createImage(
+            res->_display,
+            context,
+            EglGLTexture2D,
+            reinterpret_cast<void*>(static_cast<uintptr_t>(texture)),
+            Attributes.data()
+        );
+        if (!image) {
+            Log::Warning(std::format(
+                "Could not create the EGL image for exporting the frames of '{}'", name
+            ));
+            return nullptr;
+        }
+        res->_images.push_back(image);
+
+        int fourcc = 0;
+        int nPlanes = 0;
+        uint64_t modifier = 0;
+        const bool hasQuery =
+            fns->exportQuery(res->_display, image, &fourcc, &nPlanes, &modifier);
+        std::array<int, MaxPlanes> fds;
+        fds.fill(-1);
+        std::array<EGLint, MaxPlanes> strides = {};
+        std::array<EGLint, MaxPlanes> offsets = {};
+        const bool isExported = hasQuery && nPlanes > 0 && nPlanes <= MaxPlanes &&
+            fns->exportImage(
+                res->_display,
+                image,
+                fds.data(),
+                strides.data(),
+                offsets.data()
+            );
+        if (!isExported || fds[0] == -1) {
+            for (int fd : fds) {
+                if (fd != -1) {
+                    close(fd);
+                }
+            }
+            Log::Warning(std::format(
+                "Could not export the EGL image of the frames of '{}' as a dmabuf", name
+            ));
+            return nullptr;
+        }
+
+        // Planes that lie in the buffer of a previous plane have no file descriptor of
+        // their own, but every plane is passed with one
+        for (int p = 0; p < nPlanes; p++) {
+            res->_planes.push_back(fds[p] != -1 ? fds[p] : dup(res->_planes.back()));
+        }
+
+        // All images are created in the same way, so they have the same layout
+        Description& d = res->_description;
+        d.width = static_cast<uint32_t>(size.x);
+        d.height = static_cast<uint32_t>(size.y);
+        d.fourcc = static_cast<uint32_t>(fourcc);
+        d.nImages = static_cast<uint32_t>(NImages);
+        d.modifier = modifier;
+        d.nPlanes = static_cast<uint32_t>(nPlanes);
+        for (int p = 0; p < nPlanes; p++) {
+            d.strides[p] = static_cast<uint32_t>(strides[p]);
+            d.offsets[p] = static_cast<uint32_t>(offsets[p]);
+        }
+    }
+    glGenFramebuffers(1, &res->_fbo);
+    res->_memory.set(
+        NImages * size.x * size.y * MemoryTracker::bytesPerTexel(GL_RGBA8)
+    );
+
+    // The socket lies in the abstract namespace, so that no file has to be removed
+    const std::string socketName = "sgct-frameexport-" + name;
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    const size_t nameSize = std::min(socketName.size(), sizeof(addr.sun_path) - 1);
+    std::memcpy(addr.sun_path + 1, socketName.data(), nameSize);
+    const socklen_t addrSize =
+        static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + nameSize);
+
+    res->_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    const bool isListening = res->_socket != -1 &&
+        bind(res->_socket, reinterpret_cast<const sockaddr*>(&addr), addrSize) == 0 &&
+        listen(res->_socket, 8) == 0;
+    if (!isListening) {
+        Log::Warning(std::format(
+            "Could not create the socket '{}' for exporting the frames of '{}': {}",
+            socketName, name, std::strerror(errno)
+        ));
+        return nullptr;
+    }
+
+    Log::Info(std::format(
+        "Exporting the frames of '{}' as {} dmabufs of {}x{} pixels through '{}'{}",
+        name, NImages, size.x, size.y, socketName,
+        fns->createSync ? "" : " without fences"
+    ));
+    return res;
+#else // ^^^^ __linux__ // !WIN32 && !__linux__ vvvv
+    Log::Warning(std::format(
+        "Exporting the frames of '{}' is not supported on this platform", name
+    ));
+    return nullptr;
+#endif // WIN32
+}
+
+FrameExport::~FrameExport() {
+#ifdef WIN32
+    const Functions* fns = functions();
+    if (_interopObject) {
+        fns->unregisterObject(_interopDevice, _interopObject);
+    }
+    if (_interopDevice) {
+        fns->closeDevice(_interopDevice);
+    }
+    if (_sharedHandle) {
+        CloseHandle(_sharedHandle);
+    }
+    if (_keyedMutex) {
+        static_cast<IDXGIKeyedMutex*>(_keyedMutex)->Release();
+    }
+    if (_dxTexture) {
+        static_cast<ID3D11Texture2D*>(_dxTexture)->Release();
+    }
+    if (_dxDevice) {
+        static_cast<ID3D11Device*>(_dxDevice)->Release();
+    }
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+    for (int consumer : _consumers) {
+        close(consumer);
+    }
+    if (_socket != -1) {
+        close(_socket);
+    }
+    for (int plane : _planes) {
+        close(plane);
+    }
+    for (void* image : _images) {
+        functions()->destroyImage(_display, image);
+    }
+#endif // WIN32
+    glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+    glDeleteFramebuffers(1, &_fbo);
+}
+
+void FrameExport::exportFrame([[maybe_unused]] uint64_t frameNumber) {
+    ZoneScoped;
+
+#ifdef WIN32
+    // The previous frame is replaced if no consumer has read it yet, and the frame is
+    // skipped while a consumer is reading
+    IDXGIKeyedMutex* mutex = static_cast<IDXGIKeyedMutex*>(_keyedMutex);
+    if (mutex->AcquireSync(WriteKey, 0) != S_OK && mutex->AcquireSync(ReadKey, 0) != S_OK)
+    {
+        return;
+    }
+
+    const Functions* fns = functions();
+    HANDLE object = _interopObject;
+    if (fns->lockObjects(_interopDevice, 1, &object)) {
+        blit(_fbo, _textures.front(), _size);
+        fns->unlockObjects(_interopDevice, 1, &object);
+    }
+    mutex->ReleaseSync(ReadKey);
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+    acceptConsumers();
+    if (_consumers.empty()) {
+        return;
+    }
+
+    const size_t image = _nextImage;
+    _nextImage = (_nextImage + 1) % _textures.size();
+    blit(_fbo, _textures[image], _size);
+
+    const Functions* fns = functions();
+    int fence = EglNoNativeFenceFd;
+    if (fns->createSync) {
+        constexpr std::array<EGLint, 1> Attributes = { EglNone };
+        EGLSync sync =
+            fns->createSync(_display, EglSyncNativeFence, Attributes.data());
+        // The file descriptor of the fence only exists once the commands are flushed
+        glFlush();
+        if (sync) {
+            fence = fns->dupNativeFenceFd(_display, sync);
+            fns->destroySync(_display, sync);
+        }
+    }
+    if (fence == EglNoNativeFenceFd) {
+        // Without a fence, the consumers can only use the image once it is written
+        glFinish();
+    }
+
+    const FrameMessage msg = {
+        .frameNumber = frameNumber,
+        .image = static_cast<uint32_t>(image),
+        .hasFence = fence != EglNoNativeFenceFd ? 1u : 0u
+    };
+    const std::span<const int> fds =
+        msg.hasFence ? std::span<const int>(&fence, 1) : std::span<const int>();
+    for (auto it = _consumers.begin(); it != _consumers.end();) {
+        const SendResult r = sendMessage(*it, &msg, sizeof(FrameMessage), fds);
+        if (r == SendResult::Failed) {
+            Log::Info(
+                std::format("A consumer of the frames of '{}' disconnected", _name)
+            );
+            close(*it);
+            it = _consumers.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+    if (fence != EglNoNativeFenceFd) {
+        close(fence);
+    }
+#endif // WIN32
+}
+
+ivec2 FrameExport::size() const {
+    return _size;
+}
+
+#if !defined(WIN32) && defined(__linux__)
+void FrameExport::acceptConsumers() {
+    while (true) {
+        const int consumer =
+            accept4(_socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (consumer == -1) {
+            return;
+        }
+
+        const SendResult r =
+            sendMessage(consumer, &_description, sizeof(Description), _planes);
+        if (r != SendResult::Sent) {
+            close(consumer);
+            continue;
+        }
+        _consumers.push_back(consumer);
+        Log::Info(std::format("A consumer of the frames of '{}' connected", _name));
+    }
+}
+#endif // !WIN32 && __linux__
+
+} // namespace sgct
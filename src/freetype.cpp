@@ -18,10 +18,20 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <array>
 #include <cstdarg>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace {
+    struct Vertex {
+        float x = 0.f;
+        float y = 0.f;
+        float s = 0.f;
+        float t = 0.f;
+    };
+
     glm::mat4 setupOrthoMat(const sgct::Window& win, const sgct::BaseViewport& vp) {
         const sgct::vec2 res = sgct::vec2{
             static_cast<float>(win.windowResolution().x),
@@ -44,79 +54,269 @@ namespace {
         return tmpVec;
     }
 
-    float getLineWidth(sgct::text::Font& font, const std::string& line) {
+    // Invalid sequences are replaced by U+FFFD, the replacement character
+    std::u32string decodeUtf8(std::string_view str) {
+        constexpr char32_t Replacement = 0xFFFD;
+
+        std::u32string res;
+        res.reserve(str.size());
+        size_t i = 0;
+        while (i < str.size()) {
+            const unsigned char lead = static_cast<unsigned char>(str[i]);
+            int length = 0;
+            char32_t c = 0;
+            if (lead < 0x80) {
+                length = 1;
+                c = lead;
+            }
+            else if ((lead & 0xE0) == 0xC0) {
+                length = 2;
+                c = lead & 0x1F;
+            }
+            else if ((lead & 0xF0) == 0xE0) {
+                length = 3;
+                c = lead & 0x0F;
+            }
+            else if ((lead & 0xF8) == 0xF0) {
+                length = 4;
+                c = lead & 0x07;
+            }
+            else {
+                res.push_back(Replacement);
+                i++;
+                continue;
+            }
+
+            int n = 1;
+            while (n < length && i + n < str.size() &&
+                   (static_cast<unsigned char>(str[i + n]) & 0xC0) == 0x80)
+            {
+                c = (c << 6) | (static_cast<unsigned char>(str[i + n]) & 0x3F);
+                n++;
+            }
+
+            // Overlong encodings and surrogates are not valid code points in UTF-8
+            constexpr std::array<char32_t, 5> MinValue = { 0, 0, 0x80, 0x800, 0x10000 };
+            const bool isValid = n == length && c >= MinValue[length] && c <= 0x10FFFF &&
+                                 (c < 0xD800 || c > 0xDFFF);
+            res.push_back(isValid ? c : Replacement);
+            i += n;
+        }
+        return res;
+    }
+
+    float getLineWidth(sgct::text::Font& font, const std::u32string& line) {
+        if (line.empty()) {
+            return 0.f;
+        }
+
         // figure out width
         float lineWidth = 0.f;
         for (size_t j = 0; j < line.length() - 1; j++) {
-            const char c = line.c_str()[j];
-            const sgct::text::Font::FontFaceData& ffd = font.fontFaceData(c);
+            const sgct::text::Font::FontFaceData& ffd = font.fontFaceData(line[j]);
             lineWidth += ffd.distToNextChar;
         }
         // add last char width
-        const char c = line.c_str()[line.length() - 1];
-        const sgct::text::Font::FontFaceData& ffd = font.fontFaceData(c);
+        const sgct::text::Font::FontFaceData& ffd = font.fontFaceData(line.back());
         lineWidth += ffd.size.x;
 
         return lineWidth;
     }
+
+    // x y s t
+    void setupVertexAttributes() {
+        constexpr int s = sizeof(Vertex);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, s, nullptr);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(8));
+    }
+
+    // The vertices of the glyphs of the text, which are relative to the position at
+    // which the text is printed
+    std::vector<Vertex> layout(sgct::text::Font& font, float height,
+                               sgct::text::Alignment mode, std::string text)
+    {
+        using namespace sgct::text;
+
+        // The line breaks can't be part of a multi-byte sequence, so the lines are split
+        // before they are decoded
+        std::vector<std::u32string> lines;
+        for (const std::string& line : split(std::move(text), '\n')) {
+            lines.push_back(decodeUtf8(line));
+        }
+
+        // The glyphs are stored at the height of the font
+        const float scale = height / font.height();
+        const float h = height * 1.59f;
+
+        // All glyphs are in the atlas of the font, so the whole text is drawn at once
+        std::vector<Vertex> vertices;
+        for (size_t i = 0; i < lines.size(); i++) {
+            glm::vec3 offset(0.f, -h * i, 0.f);
+
+            if (mode == Alignment::TopCenter) {
+                offset.x -= scale * getLineWidth(font, lines[i]) / 2.f;
+            }
+            else if (mode == Alignment::TopRight) {
+                offset.x -= scale * getLineWidth(font, lines[i]);
+            }
+
+            for (const char32_t c : lines[i]) {
+                const Font::FontFaceData& ffd = font.fontFaceData(c);
+
+                const float x0 = offset.x + scale * ffd.pos.x;
+                const float y0 = offset.y + scale * ffd.pos.y;
+                const float x1 = x0 + scale * ffd.size.x;
+                const float y1 = y0 + scale * ffd.size.y;
+
+                // The rows of the glyph are stored from the top, so the top of the glyph
+                // has the smaller t coordinate
+                const float s0 = static_cast<float>(ffd.atlasPos.x);
+                const float t0 = static_cast<float>(ffd.atlasPos.y);
+                const float s1 = s0 + ffd.size.x;
+                const float t1 = t0 + ffd.size.y;
+
+                vertices.push_back({ x0, y0, s0, t1 });
+                vertices.push_back({ x1, y0, s1, t1 });
+                vertices.push_back({ x0, y1, s0, t0 });
+                vertices.push_back({ x0, y1, s0, t0 });
+                vertices.push_back({ x1, y0, s1, t1 });
+                vertices.push_back({ x1, y1, s1, t0 });
+
+                offset += glm::vec3(scale * ffd.distToNextChar, 0.f, 0.f);
+            }
+        }
+        return vertices;
+    }
+
+    // Draws the first vertices of the bound vertex array as a text at the position x, y
+    void draw(const sgct::Window& window, const sgct::BaseViewport& viewport,
+              sgct::text::Font& font, float x, float y, const sgct::vec4& color,
+              int nVertices)
+    {
+        using namespace sgct;
+
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, font.atlasTexture());
+
+        const glm::mat4 orthoMatrix =
+            glm::translate(setupOrthoMat(window, viewport), glm::vec3(x, y, 0.f));
+        mat4 s;
+        std::memcpy(&s, glm::value_ptr(orthoMatrix), sizeof(mat4));
+        if (font.isDistanceField()) {
+            text::FontManager::instance().bindDistanceFieldShader(
+                s,
+                color,
+                0,
+                font.distanceFieldStroke()
+            );
+        }
+        else {
+            text::FontManager::instance().bindShader(s, color, 0);
+        }
+
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(nVertices));
+
+        glBindVertexArray(0);
+        ShaderProgram::unbind();
+    }
 } // namespace
 
 namespace sgct::text {
 
 void print(const Window& window, const BaseViewport& viewport, Font& font, Alignment mode,
            float x, float y, const vec4& color, std::string text)
+{
+    print(window, viewport, font, font.height(), mode, x, y, color, std::move(text));
+}
+
+void print(const Window& window, const BaseViewport& viewport, Font& font, float height,
+           Alignment mode, float x, float y, const vec4& color, std::string text)
 {
     if (text.empty()) {
         return;
     }
 
-    std::vector<std::string> lines = split(std::move(text), '\n');
-    const glm::mat4 orthoMatrix = setupOrthoMat(window, viewport);
-
-    const float h = font.height() * 1.59f;
-
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    const std::vector<Vertex> vertices = layout(font, height, mode, std::move(text));
 
     glBindVertexArray(font.vao());
-    glActiveTexture(GL_TEXTURE0);
+    glBindBuffer(GL_ARRAY_BUFFER, font.vbo());
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertices.size() * sizeof(Vertex),
+        vertices.data(),
+        GL_STREAM_DRAW
+    );
+    draw(window, viewport, font, x, y, color, static_cast<int>(vertices.size()));
+}
 
-    for (size_t i = 0; i < lines.size(); i++) {
-        glm::vec3 offset(x, y - h * i, 0.f);
+TextLayout::TextLayout(Font& font, float height, Alignment mode, std::string text)
+    : _font(font)
+    , _height(height)
+    , _mode(mode)
+    , _text(std::move(text))
+{}
 
-        if (mode == Alignment::TopCenter) {
-            offset.x -= getLineWidth(font, lines[i]) / 2.f;
-        }
-        else if (mode == Alignment::TopRight) {
-            offset.x -= getLineWidth(font, lines[i]);
-        }
+TextLayout::TextLayout(Font& font, Alignment mode, std::string text)
+    : TextLayout(font, font.height(), mode, std::move(text))
+{}
 
-        for (const char c : lines[i]) {
-            const sgct::text::Font::FontFaceData& ffd = font.fontFaceData(c);
+TextLayout::~TextLayout() {
+    glDeleteVertexArrays(1, &_vao);
+    glDeleteBuffers(1, &_vbo);
+}
 
-            glBindTexture(GL_TEXTURE_2D, ffd.texId);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+void TextLayout::setText(std::string text) {
+    if (text != _text) {
+        _text = std::move(text);
+        _isDirty = true;
+    }
+}
 
-            const glm::mat4 trans = glm::translate(
-                orthoMatrix,
-                glm::vec3(offset.x + ffd.pos.x, offset.y + ffd.pos.y, offset.z)
-            );
-            glm::mat4 scale = glm::scale(trans, glm::vec3(ffd.size.x, ffd.size.y, 1.f));
-            sgct::mat4 s;
-            std::memcpy(&s, glm::value_ptr(scale), sizeof(sgct::mat4));
+const std::string& TextLayout::text() const {
+    return _text;
+}
 
-            FontManager::instance().bindShader(s, color, 0);
+void TextLayout::render(const Window& window, const BaseViewport& viewport, float x,
+                        float y, const vec4& color)
+{
+    if (_text.empty()) {
+        return;
+    }
 
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        setupVertexAttributes();
+    }
+    glBindVertexArray(_vao);
 
-            offset += glm::vec3(ffd.distToNextChar, 0.f, 0.f);
-        }
+    if (_isDirty || _atlasRevision != _font.atlasRevision()) {
+        const uint64_t revision = _font.atlasRevision();
+        const std::vector<Vertex> vertices = layout(_font, _height, _mode, _text);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            vertices.size() * sizeof(Vertex),
+            vertices.data(),
+            GL_STATIC_DRAW
+        );
+        _nVertices = static_cast<int>(vertices.size());
+        _atlasRevision = _font.atlasRevision();
+        // If the glyphs of this text did not all fit into the atlas at the same time,
+        // the ones that were laid out first might have been replaced already, in which
+        // case the layout is repeated in the next frame
+        _isDirty = revision != _atlasRevision;
     }
 
-    glBindVertexArray(0);
-    sgct::ShaderProgram::unbind();
+    draw(window, viewport, _font, x, y, color, _nVertices);
 }
 
 } // namespace sgct::text
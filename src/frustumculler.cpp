@@ -0,0 +1,259 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/frustumculler.h>
+
+#include <sgct/callbackdata.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+    constexpr int Width = 4;
+
+    // The four objects that are tested at the same time, with one object in each lane
+#if defined(SGCT_MATH_USE_SSE)
+    using Lanes = __m128;
+
+    Lanes load(const float* v) { return _mm_loadu_ps(v); }
+    Lanes splat(float v) { return _mm_set1_ps(v); }
+    Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+
+    // Returns the bits of the lanes in which `a` is smaller than `b`
+    unsigned int lessThan(Lanes a, Lanes b) {
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(a, b)));
+    }
+#elif defined(SGCT_MATH_USE_NEON)
+    using Lanes = float32x4_t;
+
+    Lanes load(const float* v) { return vld1q_f32(v); }
+    Lanes splat(float v) { return vdupq_n_f32(v); }
+    Lanes add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+    Lanes mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+
+    unsigned int lessThan(Lanes a, Lanes b) {
+        const uint32x4_t r = vcltq_f32(a, b);
+        return (vgetq_lane_u32(r, 0) & 1) | (vgetq_lane_u32(r, 1) & 2) |
+            (vgetq_lane_u32(r, 2) & 4) | (vgetq_lane_u32(r, 3) & 8);
+    }
+#else // ^^^^ SGCT_MATH_USE_NEON // !SGCT_MATH_USE_SSE && !SGCT_MATH_USE_NEON vvvv
+    struct Lanes {
+        std::array<float, Width> v;
+    };
+
+    Lanes load(const float* v) { return Lanes{ { v[0], v[1], v[2], v[3] } }; }
+    Lanes splat(float v) { return Lanes{ { v, v, v, v } }; }
+
+    Lanes add(Lanes a, Lanes b) {
+        Lanes res;
+        for (int i = 0; i < Width; i++) {
+            res.v[i] = a.v[i] + b.v[i];
+        }
+        return res;
+    }
+
+    Lanes mul(Lanes a, Lanes b) {
+        Lanes res;
+        for (int i = 0; i < Width; i++) {
+            res.v[i] = a.v[i] * b.v[i];
+        }
+        return res;
+    }
+
+    unsigned int lessThan(Lanes a, Lanes b) {
+        unsigned int res = 0;
+        for (int i = 0; i < Width; i++) {
+            res |= (a.v[i] < b.v[i] ? 1u : 0u) << i;
+        }
+        return res;
+    }
+#endif // SGCT_MATH_USE_SSE
+
+    // The centers and the radii of the objects of one batch in separate arrays. For the
+    // boxes, the radii are the half sizes along the axes instead
+    struct Batch {
+        std::array<float, Width> x = {};
+        std::array<float, Width> y = {};
+        std::array<float, Width> z = {};
+        std::array<float, Width> rx = {};
+        std::array<float, Width> ry = {};
+        std::array<float, Width> rz = {};
+    };
+} // namespace
+
+namespace sgct {
+
+void FrustumCuller::clear() {
+    _nFrusta = 0;
+}
+
+int FrustumCuller::addFrustum(const mat4& modelViewProjection) {
+    if (_nFrusta >= MaxFrusta) {
+        return -1;
+    }
+
+    // The planes are the sums and differences of the last row of the matrix and each of
+    // the other rows, as a point is inside if its clip coordinates are between -w and w
+    const std::array<float, 16>& m = modelViewProjection.values;
+    auto row = [&m](int r) { return vec4(m[r], m[4 + r], m[8 + r], m[12 + r]); };
+    const vec4 w = row(3);
+    for (int p = 0; p < PlanesPerFrustum; p++) {
+        const vec4 r = row(p / 2);
+        const float s = p % 2 == 0 ? 1.f : -1.f;
+        const vec4 plane = vec4(
+            w.x + s * r.x,
+            w.y + s * r.y,
+            w.z + s * r.z,
+            w.w + s * r.w
+        );
+
+        // The planes are normalized so that the distances can be compared with the radii
+        const float length =
+            std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        const float scale = length > 0.f ? 1.f / length : 1.f;
+        const int i = _nFrusta * PlanesPerFrustum + p;
+        _planes.a[i] = plane.x * scale;
+        _planes.b[i] = plane.y * scale;
+        _planes.c[i] = plane.z * scale;
+        _planes.d[i] = plane.w * scale;
+    }
+    return _nFrusta++;
+}
+
+int FrustumCuller::addFrusta(const RenderData& data) {
+    const int nFrusta = [&data]() {
+        if (data.cubeFaces) {
+            return 6;
+        }
+        return data.rightEye ? 2 : 1;
+    }();
+    if (_nFrusta + nFrusta > MaxFrusta) {
+        return -1;
+    }
+
+    const int first = _nFrusta;
+    if (data.fisheye || data.omniStereo) {
+        // A plane that every point is in front of, as the frustum is not bounded by the
+        // planes of a projection matrix
+        for (int p = 0; p < PlanesPerFrustum; p++) {
+            const int i = _nFrusta * PlanesPerFrustum + p;
+            _planes.a[i] = 0.f;
+            _planes.b[i] = 0.f;
+            _planes.c[i] = 0.f;
+            _planes.d[i] = 1.f;
+        }
+        _nFrusta++;
+    }
+    else if (data.cubeFaces) {
+        for (const mat4& matrix : data.cubeFaces->modelViewProjectionMatrices) {
+            addFrustum(matrix);
+        }
+    }
+    else {
+        addFrustum(data.modelViewProjectionMatrix);
+        if (data.rightEye) {
+            addFrustum(data.rightEye->modelViewProjectionMatrix);
+        }
+    }
+    return first;
+}
+
+int FrustumCuller::numberOfFrusta() const {
+    return _nFrusta;
+}
+
+void FrustumCuller::cull(std::span<const Sphere> spheres, std::span<uint32_t> masks) const
+{
+    assert(masks.size() >= spheres.size());
+
+    for (size_t begin = 0; begin < spheres.size(); begin += Width) {
+        const size_t n = std::min<size_t>(Width, spheres.size() - begin);
+        Batch batch;
+        for (size_t i = 0; i < n; i++) {
+            const Sphere& s = spheres[begin + i];
+            batch.x[i] = s.center.x;
+            batch.y[i] = s.center.y;
+            batch.z[i] = s.center.z;
+            // The negated radius is the distance from the plane below which the sphere
+            // is entirely outside
+            batch.rx[i] = -s.radius;
+        }
+
+        const Lanes x = load(batch.x.data());
+        const Lanes y = load(batch.y.data());
+        const Lanes z = load(batch.z.data());
+        const Lanes limit = load(batch.rx.data());
+        std::array<uint32_t, Width> res = {};
+        for (int f = 0; f < _nFrusta; f++) {
+            unsigned int outside = 0;
+            for (int p = 0; p < PlanesPerFrustum; p++) {
+                const int i = f * PlanesPerFrustum + p;
+                Lanes dist = mul(x, splat(_planes.a[i]));
+                dist = add(dist, mul(y, splat(_planes.b[i])));
+                dist = add(dist, mul(z, splat(_planes.c[i])));
+                dist = add(dist, splat(_planes.d[i]));
+                outside |= lessThan(dist, limit);
+            }
+            for (int l = 0; l < Width; l++) {
+                res[l] |= ((outside >> l) & 1u) == 0 ? (1u << f) : 0u;
+            }
+        }
+        std::copy(res.begin(), res.begin() + n, masks.begin() + begin);
+    }
+}
+
+void FrustumCuller::cull(std::span<const Box> boxes, std::span<uint32_t> masks) const {
+    assert(masks.size() >= boxes.size());
+
+    for (size_t begin = 0; begin < boxes.size(); begin += Width) {
+        const size_t n = std::min<size_t>(Width, boxes.size() - begin);
+        Batch batch;
+        for (size_t i = 0; i < n; i++) {
+            const Box& b = boxes[begin + i];
+            batch.x[i] = (b.min.x + b.max.x) * 0.5f;
+            batch.y[i] = (b.min.y + b.max.y) * 0.5f;
+            batch.z[i] = (b.min.z + b.max.z) * 0.5f;
+            batch.rx[i] = (b.max.x - b.min.x) * 0.5f;
+            batch.ry[i] = (b.max.y - b.min.y) * 0.5f;
+            batch.rz[i] = (b.max.z - b.min.z) * 0.5f;
+        }
+
+        const Lanes x = load(batch.x.data());
+        const Lanes y = load(batch.y.data());
+        const Lanes z = load(batch.z.data());
+        const Lanes rx = load(batch.rx.data());
+        const Lanes ry = load(batch.ry.data());
+        const Lanes rz = load(batch.rz.data());
+        const Lanes zero = splat(0.f);
+        std::array<uint32_t, Width> res = {};
+        for (int f = 0; f < _nFrusta; f++) {
+            unsigned int outside = 0;
+            for (int p = 0; p < PlanesPerFrustum; p++) {
+                const int i = f * PlanesPerFrustum + p;
+                Lanes dist = mul(x, splat(_planes.a[i]));
+                dist = add(dist, mul(y, splat(_planes.b[i])));
+                dist = add(dist, mul(z, splat(_planes.c[i])));
+                dist = add(dist, splat(_planes.d[i]));
+
+                // The corner of the box that is farthest in the direction of the normal
+                // is in front of the plane if the box is not entirely outside
+                Lanes extent = mul(rx, splat(std::abs(_planes.a[i])));
+                extent = add(extent, mul(ry, splat(std::abs(_planes.b[i]))));
+                extent = add(extent, mul(rz, splat(std::abs(_planes.c[i]))));
+                outside |= lessThan(add(dist, extent), zero);
+            }
+            for (int l = 0; l < Width; l++) {
+                res[l] |= ((outside >> l) & 1u) == 0 ? (1u << f) : 0u;
+            }
+        }
+        std::copy(res.begin(), res.begin() + n, masks.begin() + begin);
+    }
+}
+
+} // namespace sgct
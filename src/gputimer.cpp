@@ -0,0 +1,98 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/gputimer.h>
+
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <cassert>
+
+namespace sgct {
+
+GpuTimer::GpuTimer(int nStages)
+    : _times(nStages, 0.0)
+{
+    for (std::vector<Stage>& frame : _frames) {
+        frame.resize(nStages);
+    }
+}
+
+void GpuTimer::destroy() {
+    for (std::vector<Stage>& frame : _frames) {
+        for (Stage& stage : frame) {
+            for (std::array<unsigned int, 2>& q : stage.queries) {
+                glDeleteQueries(2, q.data());
+            }
+            stage.queries.clear();
+            stage.nUsed = 0;
+        }
+    }
+}
+
+void GpuTimer::beginFrame() {
+    ZoneScoped;
+
+    _current = (_current + 1) % Latency;
+    collect(_frames[_current]);
+}
+
+void GpuTimer::begin(int stage) {
+    assert(stage >= 0 && stage < static_cast<int>(_times.size()));
+
+    Stage& s = _frames[_current][stage];
+    if (s.nUsed == static_cast<int>(s.queries.size())) {
+        std::array<unsigned int, 2>& q = s.queries.emplace_back();
+        glGenQueries(2, q.data());
+    }
+    glQueryCounter(s.queries[s.nUsed][0], GL_TIMESTAMP);
+}
+
+void GpuTimer::end(int stage) {
+    assert(stage >= 0 && stage < static_cast<int>(_times.size()));
+
+    Stage& s = _frames[_current][stage];
+    assert(s.nUsed < static_cast<int>(s.queries.size()));
+    glQueryCounter(s.queries[s.nUsed][1], GL_TIMESTAMP);
+    s.nUsed++;
+}
+
+double GpuTimer::time(int stage) const {
+    return _times[stage];
+}
+
+void GpuTimer::collect(std::vector<Stage>& frame) {
+    for (size_t i = 0; i < frame.size(); i++) {
+        Stage& stage = frame[i];
+        if (stage.nUsed == 0) {
+            continue;
+        }
+
+        // The queries finish in order, so the last one being available means that all of
+        // them are. Otherwise the results are dropped rather than waited for
+        GLint isAvailable = GL_FALSE;
+        glGetQueryObjectiv(
+            stage.queries[stage.nUsed - 1][1],
+            GL_QUERY_RESULT_AVAILABLE,
+            &isAvailable
+        );
+        if (isAvailable) {
+            GLuint64 total = 0;
+            for (int j = 0; j < stage.nUsed; j++) {
+                GLuint64 begin = 0;
+                glGetQueryObjectui64v(stage.queries[j][0], GL_QUERY_RESULT, &begin);
+                GLuint64 end = 0;
+                glGetQueryObjectui64v(stage.queries[j][1], GL_QUERY_RESULT, &end);
+                total += end - begin;
+            }
+            _times[i] = static_cast<double>(total) / 1000000000.0;
+        }
+        stage.nUsed = 0;
+    }
+}
+
+} // namespace sgct
@@ -0,0 +1,153 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/hitchdetector.h>
+
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/memorytracker.h>
+#include <sgct/networkmanager.h>
+#include <sgct/profiling.h>
+#include <sgct/tracer.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+namespace {
+    // The number of frames that have to be collected before the median is meaningful,
+    // which also skips the slow first frames after the startup
+    constexpr size_t MinimumFrames = 60;
+} // namespace
+
+namespace sgct {
+
+HitchDetector::HitchDetector(std::filesystem::path folder, double threshold,
+                             double cooldown, int nodeId)
+    : _folder(std::move(folder))
+    , _threshold(threshold)
+    , _cooldown(cooldown)
+    , _nodeId(nodeId)
+{
+    _sorted.reserve(HistoryLength);
+}
+
+void HitchDetector::addFrame(unsigned int frame, double frameTime) {
+    ZoneScoped;
+
+    const size_t nFrames = std::min(_nFrames, HistoryLength);
+    if (nFrames >= MinimumFrames) {
+        _sorted.assign(_frameTimes.begin(), _frameTimes.begin() + nFrames);
+        const auto mid = _sorted.begin() + nFrames / 2;
+        std::nth_element(_sorted.begin(), mid, _sorted.end());
+        const double median = *mid;
+
+        if (frameTime > _threshold * median) {
+            _nHitches++;
+            const double now = time();
+            if (!_hasReported || now - _lastReportTime >= _cooldown) {
+                writeReport(frame, frameTime, median);
+                // The time is taken after the report, as writing it slows the next frame
+                _lastReportTime = time();
+                _hasReported = true;
+            }
+        }
+    }
+
+    // The hitch itself is part of the history, which the median is robust against
+    _frameTimes[_nFrames % HistoryLength] = frameTime;
+    _nFrames++;
+}
+
+int HitchDetector::nHitches() const {
+    return _nHitches;
+}
+
+void HitchDetector::writeReport(unsigned int frame, double frameTime,
+                                double median) const
+{
+    ZoneScoped;
+
+    std::error_code ec;
+    std::filesystem::create_directories(_folder, ec);
+
+    // The trace of the last seconds is written first, so the report can refer to it
+    const std::filesystem::path trace = Tracer::write();
+
+    nlohmann::json frameTimes = nlohmann::json::array();
+    const size_t nFrames = std::min(_nFrames, HistoryLength);
+    for (size_t i = _nFrames - nFrames; i < _nFrames; i++) {
+        frameTimes.push_back(_frameTimes[i % HistoryLength]);
+    }
+
+    const NetworkManager& nm = NetworkManager::instance();
+    nlohmann::json connections = nlohmann::json::array();
+    for (int i = 0; i < nm.connectionsCount(); i++) {
+        const Network& connection = nm.connection(i);
+        const bool isSync = connection.type() == Network::ConnectionType::SyncConnection;
+        const Network::Traffic traffic = connection.traffic();
+        connections.push_back({
+            { "id", connection.id() },
+            { "type", isSync ? "sync" : "transfer" },
+            { "connected", connection.isConnected() },
+            { "loopTime", connection.loopTime() },
+            { "sendTime", connection.sendTime() },
+            { "latency", connection.latency() },
+            { "jitter", connection.jitter() },
+            { "bytesSent", traffic.bytesSent },
+            { "messagesSent", traffic.messagesSent },
+            { "bytesReceived", traffic.bytesReceived },
+            { "messagesReceived", traffic.messagesReceived }
+        });
+    }
+
+    nlohmann::json memory = nlohmann::json::array();
+    for (int i = 0; i < MemoryTracker::NumberOfCategories; i++) {
+        const MemoryTracker::Category category = MemoryTracker::Category(i);
+        const MemoryTracker::Usage usage = MemoryTracker::usage(category);
+        memory.push_back({
+            { "category", std::string(MemoryTracker::name(category)) },
+            { "bytes", usage.bytes },
+            { "peakBytes", usage.peakBytes },
+            { "allocations", usage.nAllocations },
+            { "deallocations", usage.nDeallocations }
+        });
+    }
+
+    const nlohmann::json j = {
+        { "node", _nodeId },
+        { "frame", frame },
+        { "masterTime", nm.masterTime() },
+        { "frameTime", frameTime },
+        { "medianFrameTime", median },
+        { "threshold", _threshold },
+        { "hitches", _nHitches },
+        { "trace", trace.string() },
+        { "frameTimes", std::move(frameTimes) },
+        { "connections", std::move(connections) },
+        { "memory", std::move(memory) }
+    };
+
+    const std::filesystem::path path =
+        _folder / std::format("hitch-node{}-frame{}.json", _nodeId, frame);
+    std::ofstream file = std::ofstream(path);
+    if (!file.good()) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        //        formatting std::filesystem::path
+        Log::Error(std::format("Could not write hitch report '{}'", path.string()));
+        return;
+    }
+    file << j.dump(2) << '\n';
+    Log::Warning(std::format(
+        "Frame {} took {:.1f} ms, {:.1f} times the median. Wrote report '{}'",
+        frame, frameTime * 1000.0, frameTime / median, path.string()
+    ));
+}
+
+} // namespace sgct
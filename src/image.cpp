@@ -11,12 +11,21 @@
 #include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
+#include <sgct/jobsystem.h>
 #include <sgct/log.h>
+#include <sgct/profiling.h>
 #include <png.h>
 #include <zlib.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #ifdef WIN32
 #include <CodeAnalysis/warnings.h>
@@ -38,8 +47,13 @@
 #pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
 #endif // __clang__
 
+// The SIMD paths of stb_image speed up the decoding of JPEG files. They are enabled
+// automatically for x86 processors, but have to be requested for ARM processors
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define STBI_NEON
+#endif
+
 namespace {
-#define STBI_NO_SIMD
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 } // namespace
@@ -60,14 +74,483 @@ namespace {
 #pragma warning(disable : 4611)
 #endif // WIN32
 
-#define Err(code, msg) Error(Error::Component::Image, code, msg)
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+namespace {
+    // The number of uncompressed bytes that are compressed by one job of the parallel PNG
+    // encoder. Every band starts with an empty deflate window, so smaller bands compress
+    // slightly worse
+    constexpr size_t BandSize = 1 << 20;
+
+    // The number of bytes at the start of every PNG file that identify the format
+    constexpr size_t PngSignatureSize = 8;
+
+    struct Band {
+        std::vector<unsigned char> compressed;
+        size_t size = 0;
+        uLong adler = 0;
+    };
+
+    int zlibStrategy(sgct::Image::CompressionStrategy strategy) {
+        using CompressionStrategy = sgct::Image::CompressionStrategy;
+        switch (strategy) {
+            case CompressionStrategy::Default:     return Z_DEFAULT_STRATEGY;
+            case CompressionStrategy::Filtered:    return Z_FILTERED;
+            case CompressionStrategy::HuffmanOnly: return Z_HUFFMAN_ONLY;
+            case CompressionStrategy::Rle:         return Z_RLE;
+            default:                   throw std::logic_error("Unhandled case label");
+        }
+    }
+
+    void storeBigEndian(unsigned char* destination, uint32_t value) {
+        destination[0] = static_cast<unsigned char>(value >> 24);
+        destination[1] = static_cast<unsigned char>(value >> 16);
+        destination[2] = static_cast<unsigned char>(value >> 8);
+        destination[3] = static_cast<unsigned char>(value);
+    }
+
+    void writeChunk(FILE* fp, const char* type, const unsigned char* data, size_t size) {
+        std::array<unsigned char, 4> length;
+        storeBigEndian(length.data(), static_cast<uint32_t>(size));
+        fwrite(length.data(), 1, length.size(), fp);
+        fwrite(type, 1, 4, fp);
+
+        uLong crc = crc32(0, reinterpret_cast<const Bytef*>(type), 4);
+        if (size > 0) {
+            fwrite(data, 1, size, fp);
+            crc = crc32(crc, data, static_cast<uInt>(size));
+        }
+        std::array<unsigned char, 4> checksum;
+        storeBigEndian(checksum.data(), static_cast<uint32_t>(crc));
+        fwrite(checksum.data(), 1, checksum.size(), fp);
+    }
+
+    // Converts the rows [begin, end), which are counted from the top of the image, into
+    // PNG scanlines and compresses them into a raw deflate stream. Only the last band
+    // finishes the stream, the others end on a byte boundary so that the bands can be
+    // concatenated
+    Band compressBand(const sgct::Image& image, const unsigned char* data, int begin,
+                      int end, bool isLast, const sgct::Image::PngSettings& settings)
+    {
+        ZoneScoped;
+
+        const int nChannels = image.channels();
+        const int bpc = image.bytesPerChannel();
+        const size_t rowSize = static_cast<size_t>(image.size().x) * nChannels * bpc;
+        const bool isBgr = nChannels >= 3;
+
+        // Every scanline starts with its filter type, which is 0 as no filter is used
+        const size_t nRows = static_cast<size_t>(end - begin);
+        std::vector<unsigned char> scanlines = std::vector<unsigned char>(
+            nRows * (rowSize + 1)
+        );
+        unsigned char* out = scanlines.data();
+        for (int y = begin; y < end; y++) {
+            // The image is stored bottom-up in BGR order with little-endian 16 bit
+            // channels, whereas PNG expects top-down RGB with big-endian channels
+            const size_t row = static_cast<size_t>(image.size().y - 1 - y);
+            const unsigned char* in = data + row * rowSize;
+            *out++ = 0;
+            for (int x = 0; x < image.size().x; x++) {
+                for (int c = 0; c < nChannels; c++) {
+                    const int src = isBgr && c < 3 ? 2 - c : c;
+                    const unsigned char* channel = in + (x * nChannels + src) * bpc;
+                    if (bpc == 1) {
+                        *out++ = channel[0];
+                    }
+                    else {
+                        *out++ = channel[1];
+                        *out++ = channel[0];
+                    }
+                }
+            }
+        }
+
+        Band band;
+        band.size = scanlines.size();
+        band.adler = adler32(
+            adler32(0, nullptr, 0),
+            scanlines.data(),
+            static_cast<uInt>(band.size)
+        );
+
+        z_stream stream = {};
+        // Negative window bits create a raw deflate stream without the zlib header and
+        // checksum, which are written once for the whole image instead
+        int res = deflateInit2(
+            &stream,
+            settings.compressionLevel,
+            Z_DEFLATED,
+            -15,
+            8,
+            zlibStrategy(settings.strategy)
+        );
+        if (res != Z_OK) {
+            throw Err(9013, "Failed to initialize PNG compression");
+        }
+
+        // The bound assumes that the stream is finished, which leaves room for the few
+        // bytes that mark the end of a band that is only flushed
+        band.compressed.resize(deflateBound(&stream, static_cast<uLong>(band.size)) + 16);
+        stream.next_in = scanlines.data();
+        stream.avail_in = static_cast<uInt>(band.size);
+        stream.next_out = band.compressed.data();
+        stream.avail_out = static_cast<uInt>(band.compressed.size());
+        res = deflate(&stream, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+        const bool success =
+            (isLast ? res == Z_STREAM_END : res == Z_OK) && stream.avail_in == 0;
+        band.compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        if (!success) {
+            throw Err(9014, "Failed to compress PNG data");
+        }
+        return band;
+    }
+
+    std::vector<Band> compressBands(const sgct::Image& image, const unsigned char* data,
+                                    const sgct::Image::PngSettings& settings)
+    {
+        ZoneScoped;
+
+        const int height = image.size().y;
+        const size_t rowSize = static_cast<size_t>(image.size().x) * image.channels() *
+            image.bytesPerChannel() + 1;
+        const int rowsPerBand = static_cast<int>(std::max<size_t>(BandSize / rowSize, 1));
+        const int nBands = (height + rowsPerBand - 1) / rowsPerBand;
+
+        std::vector<Band> bands = std::vector<Band>(nBands);
+        std::vector<sgct::JobSystem::Job> jobs;
+        jobs.reserve(nBands);
+        for (int i = 0; i < nBands; i++) {
+            jobs.push_back(settings.jobSystem->submit(
+                [&image, data, &settings, &bands, i, rowsPerBand, height, nBands]() {
+                    const int begin = i * rowsPerBand;
+                    const int end = std::min(begin + rowsPerBand, height);
+                    const bool isLast = i == nBands - 1;
+                    bands[i] = compressBand(image, data, begin, end, isLast, settings);
+                }
+            ));
+        }
+        // The jobs have to finish before the bands go out of scope, even if one of them
+        // failed, so the first exception is only rethrown afterwards
+        std::exception_ptr error;
+        for (const sgct::JobSystem::Job& job : jobs) {
+            try {
+                settings.jobSystem->wait(job);
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return bands;
+    }
+
+    // Writes a PNG file whose image data consists of the independently compressed bands,
+    // which are joined into one zlib stream
+    void writeBands(FILE* fp, const sgct::Image& image, const std::vector<Band>& bands,
+                    int compressionLevel)
+    {
+        ZoneScoped;
+
+        constexpr std::array<unsigned char, 8> Signature = {
+            137, 80, 78, 71, 13, 10, 26, 10
+        };
+        fwrite(Signature.data(), 1, Signature.size(), fp);
+
+        const unsigned char colorType = [](int channels) -> unsigned char {
+            switch (channels) {
+                case 1: return PNG_COLOR_TYPE_GRAY;
+                case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
+                case 3: return PNG_COLOR_TYPE_RGB;
+                case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(image.channels());
+
+        // Width, height, bit depth, color type, compression, filter, and interlace method
+        std::array<unsigned char, 13> header = {};
+        storeBigEndian(&header[0], static_cast<uint32_t>(image.size().x));
+        storeBigEndian(&header[4], static_cast<uint32_t>(image.size().y));
+        header[8] = static_cast<unsigned char>(image.bytesPerChannel() * 8);
+        header[9] = colorType;
+        writeChunk(fp, "IHDR", header.data(), header.size());
+
+        // The zlib header announces the compression level, which is only informational,
+        // and is followed by the bands of the deflate stream
+        const unsigned char cmf = 0x78;
+        const int level = [](int l) {
+            if (l < 0 || l == 6) { return 2; }
+            if (l < 2) { return 0; }
+            if (l < 6) { return 1; }
+            return 3;
+        }(compressionLevel);
+        unsigned char flg = static_cast<unsigned char>(level << 6);
+        flg = static_cast<unsigned char>(flg + 31 - (cmf * 256 + flg) % 31);
+        const std::array<unsigned char, 2> zlibHeader = { cmf, flg };
+        writeChunk(fp, "IDAT", zlibHeader.data(), zlibHeader.size());
+
+        uLong adler = adler32(0, nullptr, 0);
+        for (const Band& band : bands) {
+            writeChunk(fp, "IDAT", band.compressed.data(), band.compressed.size());
+            adler = adler32_combine(adler, band.adler, static_cast<z_off_t>(band.size));
+        }
+
+        std::array<unsigned char, 4> checksum;
+        storeBigEndian(checksum.data(), static_cast<uint32_t>(adler));
+        writeChunk(fp, "IDAT", checksum.data(), checksum.size());
+        writeChunk(fp, "IEND", nullptr, 0);
+    }
+
+    // The file that is decoded by libPNG when an image is loaded from memory
+    struct MemoryReader {
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+    };
+
+    void readFromMemory(png_structp png, png_bytep out, png_size_t length) {
+        MemoryReader* reader = reinterpret_cast<MemoryReader*>(png_get_io_ptr(png));
+        if (reader->offset + length > reader->size) {
+            png_error(png, "Unexpected end of PNG data");
+        }
+        std::memcpy(out, reader->data + reader->offset, length);
+        reader->offset += length;
+    }
+
+    bool isPng(const unsigned char* data, size_t length) {
+        return length >= PngSignatureSize && png_sig_cmp(data, 0, PngSignatureSize) == 0;
+    }
+
+    // Decodes a PNG file with libPNG, which is considerably faster than stb_image. Either
+    // the file \p fp, whose signature has already been read, or the \p reader is used.
+    // The result matches what stb_image would produce: palettes and transparency are
+    // expanded and 16 bit channels are reduced to 8 bit. libPNG stores the rows
+    // bottom-up and in BGR order right away, so no further pass over the pixels is needed
+    unsigned char* readWithLibPng(FILE* fp, MemoryReader* reader, sgct::ivec2& size,
+                                  int& nChannels)
+    {
+        ZoneScoped;
+
+        png_structp png = png_create_read_struct(
+            PNG_LIBPNG_VER_STRING,
+            nullptr,
+            nullptr,
+            nullptr
+        );
+        if (!png) {
+            throw Err(9021, "Failed to create PNG struct");
+        }
+        png_infop info = png_create_info_struct(png);
+        if (!info) {
+            png_destroy_read_struct(&png, nullptr, nullptr);
+            throw Err(9021, "Failed to create PNG info struct");
+        }
+
+        // These are declared before the jump buffer is set so that they are freed when
+        // the decoding fails
+        std::unique_ptr<unsigned char[]> pixels;
+        std::vector<png_bytep> rowPtrs;
+        if (setjmp(png_jmpbuf(png))) {
+            png_destroy_read_struct(&png, &info, nullptr);
+            throw Err(9022, "Failed to decode PNG file");
+        }
+
+        if (fp) {
+            png_init_io(png, fp);
+            png_set_sig_bytes(png, PngSignatureSize);
+        }
+        else {
+            png_set_read_fn(png, reader, readFromMemory);
+        }
+        png_read_info(png, info);
+
+        const png_byte colorType = png_get_color_type(png, info);
+        const png_byte bitDepth = png_get_bit_depth(png, info);
+        if (colorType == PNG_COLOR_TYPE_PALETTE) {
+            png_set_palette_to_rgb(png);
+        }
+        if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) {
+            png_set_expand_gray_1_2_4_to_8(png);
+        }
+        if (png_get_valid(png, info, PNG_INFO_tRNS)) {
+            png_set_tRNS_to_alpha(png);
+        }
+        if (bitDepth == 16) {
+            png_set_strip_16(png);
+        }
+        png_set_bgr(png);
+        png_set_interlace_handling(png);
+        png_read_update_info(png, info);
+
+        size = sgct::ivec2{
+            static_cast<int>(png_get_image_width(png, info)),
+            static_cast<int>(png_get_image_height(png, info))
+        };
+        nChannels = png_get_channels(png, info);
+
+        // The buffer is not value-initialized as libPNG overwrites all of it
+        const size_t rowSize = png_get_rowbytes(png, info);
+        pixels.reset(new unsigned char[rowSize * size.y]);
+        rowPtrs.resize(size.y);
+        for (int y = 0; y < size.y; y++) {
+            const size_t idx = static_cast<size_t>(size.y) - 1 - static_cast<size_t>(y);
+            rowPtrs[idx] = pixels.get() + y * rowSize;
+        }
+        png_read_image(png, rowPtrs.data());
+        png_read_end(png, nullptr);
+        png_destroy_read_struct(&png, &info, nullptr);
+
+        return pixels.release();
+    }
+
+    void writeWithLibPng(FILE* fp, const sgct::Image& image, const unsigned char* data,
+                         const sgct::Image::PngSettings& settings)
+    {
+        // initialize stuff
+        png_structp png = png_create_write_struct(
+            PNG_LIBPNG_VER_STRING,
+            nullptr,
+            nullptr,
+            nullptr
+        );
+        if (!png) {
+            throw Err(9009, "Failed to create PNG struct");
+        }
+
+        // Compression levels 1-9.
+        //   -1 = Default compression
+        //    0 = No compression
+        //    1 = Best speed
+        //    9 = Best compression
+        png_set_compression_level(png, settings.compressionLevel);
+        png_set_filter(png, 0, PNG_FILTER_NONE);
+        png_set_compression_mem_level(png, 8);
+        png_set_compression_strategy(png, zlibStrategy(settings.strategy));
+        png_set_compression_window_bits(png, 15);
+        png_set_compression_method(png, 8);
+        png_set_compression_buffer_size(png, 8192);
+
+        png_infop info = png_create_info_struct(png);
+        if (!info) {
+            throw Err(9010, "Failed to create PNG info struct");
+        }
+
+        if (setjmp(png_jmpbuf(png))) {
+            png_destroy_write_struct(&png, &info);
+            throw Err(9011, "One of the called PNG functions failed");
+        }
+
+        png_init_io(png, fp);
+
+        const int colorType = [](int channels) {
+            switch (channels) {
+                case 1: return PNG_COLOR_TYPE_GRAY;
+                case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
+                case 3: return PNG_COLOR_TYPE_RGB;
+                case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(image.channels());
+
+        // write header
+        png_set_IHDR(
+            png,
+            info,
+            image.size().x,
+            image.size().y,
+            image.bytesPerChannel() * 8,
+            colorType,
+            PNG_INTERLACE_NONE,
+            PNG_COMPRESSION_TYPE_BASE,
+            PNG_FILTER_TYPE_BASE
+        );
+
+        if (colorType == PNG_COLOR_TYPE_RGB || colorType == PNG_COLOR_TYPE_RGB_ALPHA) {
+            png_set_bgr(png);
+        }
+        png_write_info(png, info);
+
+        // swap big-endian to little endian
+        if (image.bytesPerChannel() == 2) {
+            png_set_swap(png);
+        }
+
+        std::vector<png_bytep> rowPtrs(image.size().y);
+        for (int y = 0; y < image.size().y; y++) {
+            const size_t idx =
+                static_cast<size_t>(image.size().y) - 1 - static_cast<size_t>(y);
+            // libPNG only reads from the rows, but its interface does not take const data
+            rowPtrs[idx] = const_cast<png_bytep>(
+                &data[y * image.size().x * image.channels() * image.bytesPerChannel()]
+            );
+        }
+        png_write_image(png, rowPtrs.data());
+        rowPtrs.clear();
+
+        png_write_end(png, nullptr);
+        png_destroy_write_struct(&png, &info);
+    }
+} // namespace
 
 namespace sgct {
 
+Image::Image(Image&& rhs) noexcept
+    : _nChannels(std::exchange(rhs._nChannels, 0))
+    , _size(std::exchange(rhs._size, ivec2{ 0, 0 }))
+    , _dataSize(std::exchange(rhs._dataSize, 0))
+    , _bytesPerChannel(std::exchange(rhs._bytesPerChannel, 1))
+    , _data(std::exchange(rhs._data, nullptr))
+    , _release(std::exchange(rhs._release, nullptr))
+    , _allocator(std::move(rhs._allocator))
+    , _memory(std::move(rhs._memory))
+{}
+
+Image& Image::operator=(Image&& rhs) noexcept {
+    if (this != &rhs) {
+        releaseData();
+        _nChannels = std::exchange(rhs._nChannels, 0);
+        _size = std::exchange(rhs._size, ivec2{ 0, 0 });
+        _dataSize = std::exchange(rhs._dataSize, 0);
+        _bytesPerChannel = std::exchange(rhs._bytesPerChannel, 1);
+        _data = std::exchange(rhs._data, nullptr);
+        _release = std::exchange(rhs._release, nullptr);
+        _allocator = std::move(rhs._allocator);
+        _memory = std::move(rhs._memory);
+    }
+    return *this;
+}
+
 Image::~Image() {
-    if (_data) {
-        stbi_image_free(_data);
+    releaseData();
+}
+
+void Image::setAllocator(Allocator allocator) {
+    _allocator = std::move(allocator);
+}
+
+void Image::setData(unsigned char* data, std::function<void(unsigned char*)> release) {
+    releaseData();
+    _data = data;
+    _dataSize = _nChannels * _size.x * _size.y * _bytesPerChannel;
+    _release = std::move(release);
+    if (_release) {
+        _memory.set(_dataSize);
+    }
+}
+
+void Image::releaseData() {
+    if (_data && _release) {
+        _release(_data);
     }
+    _data = nullptr;
+    _dataSize = 0;
+    _release = nullptr;
+    _memory.set(0);
 }
 
 void Image::load(const std::filesystem::path& filename) {
@@ -75,15 +558,45 @@ void Image::load(const std::filesystem::path& filename) {
         throw Err(9000, "Cannot load empty filepath");
     }
 
-    stbi_set_flip_vertically_on_load(1);
+    releaseData();
     std::string name = filename.string();
-    _data = stbi_load(name.c_str(), &_size.x, &_size.y, &_nChannels, 0);
+    FILE* fp = fopen(name.c_str(), "rb");
+    if (fp == nullptr) {
+        throw Err(
+            9001, std::format("Could not open file '{}' for loading image", name));
+    }
+
+    std::array<unsigned char, PngSignatureSize> signature;
+    const size_t nRead = fread(signature.data(), 1, signature.size(), fp);
+    if (isPng(signature.data(), nRead)) {
+        try {
+            _data = readWithLibPng(fp, nullptr, _size, _nChannels);
+        }
+        catch (const Error&) {
+            fclose(fp);
+            throw;
+        }
+        fclose(fp);
+        _release = [](unsigned char* d) { delete[] d; };
+        _bytesPerChannel = 1;
+        _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
+        _memory.set(_dataSize);
+        return;
+    }
+
+    // All other formats are decoded by stb_image from the same file
+    fseek(fp, 0, SEEK_SET);
+    stbi_set_flip_vertically_on_load(1);
+    _data = stbi_load_from_file(fp, &_size.x, &_size.y, &_nChannels, 0);
+    fclose(fp);
     if (_data == nullptr) {
         throw Err(
             9001, std::format("Could not open file '{}' for loading image", name));
     }
+    _release = [](unsigned char* d) { stbi_image_free(d); };
     _bytesPerChannel = 1;
     _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
+    _memory.set(_data ? _dataSize : 0);
 
     // Convert BGR to RGB
     if (_nChannels >= 3) {
@@ -94,10 +607,23 @@ void Image::load(const std::filesystem::path& filename) {
 }
 
 void Image::load(unsigned char* data, int length) {
+    releaseData();
+    if (length > 0 && isPng(data, static_cast<size_t>(length))) {
+        MemoryReader reader = { data, static_cast<size_t>(length), 0 };
+        _data = readWithLibPng(nullptr, &reader, _size, _nChannels);
+        _release = [](unsigned char* d) { delete[] d; };
+        _bytesPerChannel = 1;
+        _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
+        _memory.set(_dataSize);
+        return;
+    }
+
     stbi_set_flip_vertically_on_load(1);
     _data = stbi_load_from_memory(data, length, &_size.x, &_size.y, &_nChannels, 0);
+    _release = [](unsigned char* d) { stbi_image_free(d); };
     _bytesPerChannel = 1;
     _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
+    _memory.set(_data ? _dataSize : 0);
 
     // Convert BGR to RGB
     if (_nChannels >= 3) {
@@ -108,13 +634,19 @@ void Image::load(unsigned char* data, int length) {
 }
 
 void Image::save(const std::filesystem::path& filename) {
+    save(filename, _data, PngSettings());
+}
+
+void Image::save(const std::filesystem::path& filename, const unsigned char* data,
+                 const PngSettings& settings) const
+{
     if (filename.empty()) {
         throw Err(9002, "Filename not set for saving image");
     }
 
     // We use libPNG instead of stb as libPNG is faster and we care about how fast
     // PNGs are written to disk in production
-    if (_data == nullptr) {
+    if (data == nullptr) {
         throw Err(9006, "Missing image data to save PNG");
     }
 
@@ -124,91 +656,25 @@ void Image::save(const std::filesystem::path& filename) {
 
     const double t0 = time();
 
+    // The bands are compressed before the file is created so that it is not left open
+    // if the compression fails
+    std::vector<Band> bands;
+    if (settings.jobSystem) {
+        bands = compressBands(*this, data, settings);
+    }
+
     std::string f = filename.string();
     FILE* fp = fopen(f.c_str(), "wb");
     if (fp == nullptr) {
         throw Err(9008, std::format("Cannot create PNG file '{}'", f));
     }
 
-    // initialize stuff
-    png_structp png = png_create_write_struct(
-        PNG_LIBPNG_VER_STRING,
-        nullptr,
-        nullptr,
-        nullptr
-    );
-    if (!png) {
-        throw Err(9009, "Failed to create PNG struct");
+    if (settings.jobSystem) {
+        writeBands(fp, *this, bands, settings.compressionLevel);
     }
-
-    // Compression levels 1-9.
-    //   -1 = Default compression
-    //    0 = No compression
-    //    1 = Best speed
-    //    9 = Best compression
-    png_set_compression_level(png, -1);
-    png_set_filter(png, 0, PNG_FILTER_NONE);
-    png_set_compression_mem_level(png, 8);
-    png_set_compression_strategy(png, Z_DEFAULT_STRATEGY);
-    png_set_compression_window_bits(png, 15);
-    png_set_compression_method(png, 8);
-    png_set_compression_buffer_size(png, 8192);
-
-    png_infop info = png_create_info_struct(png);
-    if (!info) {
-        throw Err(9010, "Failed to create PNG info struct");
+    else {
+        writeWithLibPng(fp, *this, data, settings);
     }
-
-    if (setjmp(png_jmpbuf(png))) {
-        png_destroy_write_struct(&png, &info);
-        throw Err(9011, "One of the called PNG functions failed");
-    }
-
-    png_init_io(png, fp);
-
-    const int colorType = [](int channels) {
-        switch (channels) {
-            case 1: return PNG_COLOR_TYPE_GRAY;
-            case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
-            case 3: return PNG_COLOR_TYPE_RGB;
-            case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
-            default: throw std::logic_error("Unhandled case label");
-        }
-    }(_nChannels);
-
-    // write header
-    png_set_IHDR(
-        png,
-        info,
-        _size.x,
-        _size.y,
-        _bytesPerChannel * 8,
-        colorType,
-        PNG_INTERLACE_NONE,
-        PNG_COMPRESSION_TYPE_BASE,
-        PNG_FILTER_TYPE_BASE
-    );
-
-    if (colorType == PNG_COLOR_TYPE_RGB || colorType == PNG_COLOR_TYPE_RGB_ALPHA) {
-        png_set_bgr(png);
-    }
-    png_write_info(png, info);
-
-    // swap big-endian to little endian
-    if (_bytesPerChannel == 2) {
-        png_set_swap(png);
-    }
-
-    std::vector<png_bytep> rowPtrs(_size.y);
-    for (int y = 0; y < _size.y; y++) {
-        const size_t idx = static_cast<size_t>(_size.y) - 1 - static_cast<size_t>(y);
-        rowPtrs[idx] = &_data[y * _size.x * _nChannels * _bytesPerChannel];
-    }
-    png_write_image(png, rowPtrs.data());
-    rowPtrs.clear();
-
-    png_write_end(png, nullptr);
-    png_destroy_write_struct(&png, &info);
     fclose(fp);
 
     const double t = (time() - t0) * 1000.0;
@@ -267,14 +733,30 @@ void Image::allocateOrResizeData() {
 
     if (_data && _dataSize != dataSize) {
         // re-allocate if needed
-        delete[] _data;
-        _data = nullptr;
-        _dataSize = 0;
+        releaseData();
     }
 
     if (!_data) {
-        _data = new unsigned char[dataSize];
+        if (_allocator.allocate) {
+            _data = _allocator.allocate(dataSize);
+            if (!_data) {
+                throw Err(
+                    9020,
+                    std::format("Failed to allocate {} bytes for image data", dataSize)
+                );
+            }
+            _release = [deallocate = _allocator.deallocate, dataSize](unsigned char* d) {
+                if (deallocate) {
+                    deallocate(d, dataSize);
+                }
+            };
+        }
+        else {
+            _data = new unsigned char[dataSize];
+            _release = [](unsigned char* d) { delete[] d; };
+        }
         _dataSize = dataSize;
+        _memory.set(_dataSize);
 
         Log::Debug(std::format(
             "Allocated {} bytes for image data ({:.2f} ms)",
@@ -283,4 +765,103 @@ void Image::allocateOrResizeData() {
     }
 }
 
+PngStripeWriter::PngStripeWriter(const std::filesystem::path& filename, ivec2 size,
+                                 int channels, int bytesPerChannel, int compressionLevel)
+    : _rowSize(
+        static_cast<size_t>(size.x) * static_cast<size_t>(channels) *
+        static_cast<size_t>(bytesPerChannel)
+    )
+    , _remainingRows(size.y)
+{
+    if (channels != 3 && channels != 4) {
+        throw Err(9033, std::format("Cannot save {} channels in stripes", channels));
+    }
+    if (bytesPerChannel != 1 && bytesPerChannel != 2) {
+        throw Err(9007, std::format("Cannot save {} bit", bytesPerChannel * 8));
+    }
+
+    _png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (!_png) {
+        throw Err(9009, "Failed to create PNG struct");
+    }
+    _info = png_create_info_struct(_png);
+    if (!_info) {
+        png_destroy_write_struct(&_png, nullptr);
+        throw Err(9010, "Failed to create PNG info struct");
+    }
+
+    const std::string f = filename.string();
+    _file = fopen(f.c_str(), "wb");
+    if (_file == nullptr) {
+        png_destroy_write_struct(&_png, &_info);
+        throw Err(9008, std::format("Cannot create PNG file '{}'", f));
+    }
+
+    if (setjmp(png_jmpbuf(_png))) {
+        png_destroy_write_struct(&_png, &_info);
+        fclose(_file);
+        throw Err(9011, "One of the called PNG functions failed");
+    }
+
+    png_init_io(_png, _file);
+    png_set_compression_level(_png, compressionLevel);
+    png_set_filter(_png, 0, PNG_FILTER_NONE);
+    png_set_IHDR(
+        _png,
+        _info,
+        size.x,
+        size.y,
+        bytesPerChannel * 8,
+        channels == 4 ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB,
+        PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_BASE,
+        PNG_FILTER_TYPE_BASE
+    );
+    png_set_bgr(_png);
+    png_write_info(_png, _info);
+
+    // swap big-endian to little endian
+    if (bytesPerChannel == 2) {
+        png_set_swap(_png);
+    }
+}
+
+PngStripeWriter::~PngStripeWriter() {
+    if (_remainingRows > 0) {
+        Log::Warning(std::format(
+            "PNG file is incomplete as {} rows were not written", _remainingRows
+        ));
+    }
+    png_destroy_write_struct(&_png, &_info);
+    fclose(_file);
+}
+
+void PngStripeWriter::write(const unsigned char* data, int nRows) {
+    ZoneScoped;
+
+    if (nRows > _remainingRows) {
+        throw Err(
+            9034,
+            std::format("Cannot write {} rows, only {} are left", nRows, _remainingRows)
+        );
+    }
+
+    if (setjmp(png_jmpbuf(_png))) {
+        throw Err(9011, "One of the called PNG functions failed");
+    }
+    for (int y = nRows - 1; y >= 0; y--) {
+        // libPNG only reads from the rows, but its interface does not take const data
+        const unsigned char* row = data + static_cast<size_t>(y) * _rowSize;
+        png_write_row(_png, const_cast<png_bytep>(row));
+    }
+    _remainingRows -= nRows;
+    if (_remainingRows == 0) {
+        png_write_end(_png, nullptr);
+    }
+}
+
+int PngStripeWriter::remainingRows() const {
+    return _remainingRows;
+}
+
 } // namespace sgct
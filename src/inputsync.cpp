@@ -0,0 +1,395 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/inputsync.h>
+
+#include <sgct/bytestream.h>
+#include <sgct/clustermanager.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/node.h>
+#include <sgct/profiling.h>
+#include <sgct/window.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace {
+    // The window index that is sent for events of windows whose index does not fit into
+    // the header, which the clients pass their first window for
+    constexpr uint8_t UnknownWindow = 31;
+
+    // The mouse positions are sent in quarter pixels and the scroll offsets in 1/256
+    constexpr double PositionSteps = 4.0;
+    constexpr double ScrollSteps = 256.0;
+
+    using AxisValue = sgct::Quantized<-1.f, 1.f>;
+
+    uint8_t windowIndex(const sgct::Window* window) {
+        if (!window) {
+            return UnknownWindow;
+        }
+        const std::vector<std::unique_ptr<sgct::Window>>& windows =
+            sgct::ClusterManager::instance().thisNode().windows();
+        const auto it = std::find_if(
+            windows.cbegin(),
+            windows.cend(),
+            [window](const std::unique_ptr<sgct::Window>& w) { return w.get() == window; }
+        );
+        const ptrdiff_t idx = std::distance(windows.cbegin(), it);
+        return idx < UnknownWindow ? static_cast<uint8_t>(idx) : UnknownWindow;
+    }
+
+    sgct::Window* windowOfIndex(uint8_t idx) {
+        const std::vector<std::unique_ptr<sgct::Window>>& windows =
+            sgct::ClusterManager::instance().thisNode().windows();
+        if (windows.empty()) {
+            return nullptr;
+        }
+        return idx < windows.size() ? windows[idx].get() : windows.front().get();
+    }
+
+    template <typename T>
+    T clampedRound(double value) {
+        const double lo = static_cast<double>(std::numeric_limits<T>::min());
+        const double hi = static_cast<double>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::clamp(std::round(value), lo, hi));
+    }
+} // namespace
+
+namespace sgct {
+
+// The type of an event is stored in the lower 3 bits of its header byte and the index
+// of its window in the upper 5 bits
+enum class InputSync::Type : uint8_t {
+    Key = 0,
+    Character = 1,
+    MouseButton = 2,
+    // The difference to the previous position in quarter pixels as 8 bit integers
+    MouseMoveSmall = 3,
+    // The difference to the previous position in quarter pixels as 16 bit integers
+    MouseMove = 4,
+    // The position as floats, which is used if the difference does not fit
+    MousePosition = 5,
+    MouseScroll = 6,
+    Drop = 7
+};
+
+InputSync::InputSync(uint32_t id, Callbacks callbacks)
+    : SharedObjectBase(id)
+    , _callbacks(std::move(callbacks))
+{}
+
+void InputSync::writeHeader(Type type, const Window* window) {
+    const uint8_t header =
+        static_cast<uint8_t>(type) | static_cast<uint8_t>(windowIndex(window) << 3);
+    ByteWriter(_events).write(header);
+    setDirty();
+}
+
+void InputSync::addKey(Key key, Modifier modifiers, Action action, int scancode,
+                       const Window* window)
+{
+    writeHeader(Type::Key, window);
+    ByteWriter writer = ByteWriter(_events);
+    writer.write(static_cast<int16_t>(key));
+    writer.write(static_cast<int16_t>(scancode));
+    // GLFW has 6 modifier bits and 3 actions
+    writer.write(static_cast<uint8_t>(
+        (static_cast<int>(modifiers) & 0x3F) | (static_cast<int>(action) << 6)
+    ));
+}
+
+void InputSync::addCharacter(unsigned int codepoint, int modifiers,
+                             const Window* window)
+{
+    writeHeader(Type::Character, window);
+    // Unicode code points have 21 bits, which leaves the upper bits for the modifiers
+    ByteWriter(_events).write(
+        static_cast<uint32_t>((codepoint & 0x1FFFFF) | ((modifiers & 0x3F) << 21))
+    );
+}
+
+void InputSync::addMouseButton(MouseButton button, Modifier modifiers, Action action,
+                               const Window* window)
+{
+    writeHeader(Type::MouseButton, window);
+    ByteWriter(_events).write(static_cast<uint16_t>(
+        (static_cast<int>(button) & 0x7) | (static_cast<int>(action) << 3) |
+        ((static_cast<int>(modifiers) & 0x3F) << 5)
+    ));
+}
+
+void InputSync::addMousePosition(double x, double y, const Window* window) {
+    const uint8_t idx = windowIndex(window);
+    std::optional<std::array<double, 2>>& previous = _mousePositions[idx];
+
+    // The position that the clients decode is tracked instead of the actual one, so
+    // that the rounding of the differences does not accumulate
+    if (previous) {
+        const double dx = std::round((x - (*previous)[0]) * PositionSteps);
+        const double dy = std::round((y - (*previous)[1]) * PositionSteps);
+        if (std::abs(dx) <= 127.0 && std::abs(dy) <= 127.0) {
+            writeHeader(Type::MouseMoveSmall, window);
+            ByteWriter writer = ByteWriter(_events);
+            writer.write(static_cast<int8_t>(dx));
+            writer.write(static_cast<int8_t>(dy));
+            (*previous)[0] += dx / PositionSteps;
+            (*previous)[1] += dy / PositionSteps;
+            return;
+        }
+        if (std::abs(dx) <= 32767.0 && std::abs(dy) <= 32767.0) {
+            writeHeader(Type::MouseMove, window);
+            ByteWriter writer = ByteWriter(_events);
+            writer.write(static_cast<int16_t>(dx));
+            writer.write(static_cast<int16_t>(dy));
+            (*previous)[0] += dx / PositionSteps;
+            (*previous)[1] += dy / PositionSteps;
+            return;
+        }
+    }
+
+    writeHeader(Type::MousePosition, window);
+    ByteWriter writer = ByteWriter(_events);
+    writer.write(static_cast<float>(x));
+    writer.write(static_cast<float>(y));
+    previous = std::array<double, 2>{
+        static_cast<double>(static_cast<float>(x)),
+        static_cast<double>(static_cast<float>(y))
+    };
+}
+
+void InputSync::addMouseScroll(double x, double y, const Window* window) {
+    writeHeader(Type::MouseScroll, window);
+    ByteWriter writer = ByteWriter(_events);
+    writer.write(clampedRound<int16_t>(x * ScrollSteps));
+    writer.write(clampedRound<int16_t>(y * ScrollSteps));
+}
+
+void InputSync::addDrop(const std::vector<std::string_view>& paths) {
+    writeHeader(Type::Drop, nullptr);
+    ByteWriter writer = ByteWriter(_events);
+    const size_t count = std::min<size_t>(paths.size(), 255);
+    writer.write(static_cast<uint8_t>(count));
+    for (size_t i = 0; i < count; i++) {
+        writer.write(paths[i]);
+    }
+}
+
+void InputSync::update() {
+    if (!joystick::isSampling()) {
+        return;
+    }
+
+    for (int i = 0; i < MaxJoysticks; i++) {
+        const joystick::State state = joystick::state(static_cast<Joystick>(i));
+        SentJoystick sent = {
+            .isPresent = state.isPresent,
+            .axes = std::vector<uint16_t>(state.axes.size()),
+            .buttons = state.buttons
+        };
+        for (size_t j = 0; j < state.axes.size(); j++) {
+            AxisValue v;
+            v = state.axes[j];
+            sent.axes[j] = v.quantized();
+        }
+
+        // The axes are compared after they are quantized, so that noise below the
+        // resolution of the quantization is not sent
+        if (sent != _joysticks[i]) {
+            _joysticks[i] = std::move(sent);
+            _joystickMask |= static_cast<uint16_t>(1 << i);
+            setDirty();
+        }
+    }
+}
+
+void InputSync::serialize(ByteWriter& writer) const {
+    writer.write(_joystickMask);
+    for (int i = 0; i < MaxJoysticks; i++) {
+        if ((_joystickMask & (1 << i)) == 0) {
+            continue;
+        }
+
+        const SentJoystick& j = _joysticks[i];
+        const size_t nAxes = std::min<size_t>(j.axes.size(), 127);
+        writer.write(static_cast<uint8_t>(nAxes | (j.isPresent ? 0x80 : 0)));
+        for (size_t a = 0; a < nAxes; a++) {
+            writer.write(j.axes[a]);
+        }
+        const size_t nButtons = std::min<size_t>(j.buttons.size(), 255);
+        writer.write(static_cast<uint8_t>(nButtons));
+        for (size_t b = 0; b < nButtons; b += 8) {
+            uint8_t bits = 0;
+            for (size_t k = b; k < std::min(b + 8, nButtons); k++) {
+                bits |= static_cast<uint8_t>(j.buttons[k] ? 1 << (k - b) : 0);
+            }
+            writer.write(bits);
+        }
+    }
+    writer.writeBytes(_events);
+
+    // The events have been sent with this frame
+    _events.clear();
+    _joystickMask = 0;
+}
+
+void InputSync::deserialize(ByteReader& reader) {
+    // The callbacks are only called in #replay, as the shared objects are locked here
+    const std::span<const std::byte> data = reader.readBytes(reader.remaining());
+    _received.emplace_back(data.begin(), data.end());
+}
+
+void InputSync::replay() {
+    ZoneScoped;
+
+    for (const std::vector<std::byte>& block : _received) {
+        ByteReader reader = ByteReader(block);
+        try {
+            const uint16_t mask = reader.read<uint16_t>();
+            for (int i = 0; i < MaxJoysticks; i++) {
+                if ((mask & (1 << i)) == 0) {
+                    continue;
+                }
+
+                const uint8_t header = reader.read<uint8_t>();
+                joystick::State state;
+                state.isPresent = (header & 0x80) != 0;
+                state.axes.resize(header & 0x7F);
+                for (float& axis : state.axes) {
+                    AxisValue v;
+                    v.setQuantized(reader.read<uint16_t>());
+                    axis = v;
+                }
+                state.buttons.resize(reader.read<uint8_t>());
+                for (size_t b = 0; b < state.buttons.size(); b += 8) {
+                    const uint8_t bits = reader.read<uint8_t>();
+                    for (size_t k = b; k < std::min(b + 8, state.buttons.size()); k++) {
+                        state.buttons[k] = ((bits >> (k - b)) & 1) != 0;
+                    }
+                }
+                joystick::setReceivedState(static_cast<Joystick>(i), state);
+            }
+
+            decodeEvents(reader);
+        }
+        catch (const Error& e) {
+            Log::Warning(std::format("Received malformed input events: {}", e.message));
+        }
+    }
+    _received.clear();
+}
+
+void InputSync::decodeEvents(ByteReader& reader) {
+    while (reader.remaining() > 0) {
+        const uint8_t header = reader.read<uint8_t>();
+        const Type type = static_cast<Type>(header & 0x7);
+        const uint8_t idx = header >> 3;
+        Window* window = windowOfIndex(idx);
+
+        switch (type) {
+            case Type::Key:
+            {
+                const int16_t key = reader.read<int16_t>();
+                const int16_t scancode = reader.read<int16_t>();
+                const uint8_t bits = reader.read<uint8_t>();
+                if (_callbacks.keyboard) {
+                    _callbacks.keyboard(
+                        Key(key),
+                        Modifier(bits & 0x3F),
+                        Action(bits >> 6),
+                        scancode,
+                        window
+                    );
+                }
+                break;
+            }
+            case Type::Character:
+            {
+                const uint32_t bits = reader.read<uint32_t>();
+                if (_callbacks.character) {
+                    _callbacks.character(bits & 0x1FFFFF, (bits >> 21) & 0x3F, window);
+                }
+                break;
+            }
+            case Type::MouseButton:
+            {
+                const uint16_t bits = reader.read<uint16_t>();
+                if (_callbacks.mouseButton) {
+                    _callbacks.mouseButton(
+                        MouseButton(bits & 0x7),
+                        Modifier((bits >> 5) & 0x3F),
+                        Action((bits >> 3) & 0x3),
+                        window
+                    );
+                }
+                break;
+            }
+            case Type::MouseMoveSmall:
+            case Type::MouseMove:
+            case Type::MousePosition:
+            {
+                std::optional<std::array<double, 2>>& pos = _mousePositions[idx];
+                if (type == Type::MousePosition) {
+                    const float x = reader.read<float>();
+                    const float y = reader.read<float>();
+                    pos = std::array<double, 2>{ x, y };
+                }
+                else {
+                    const bool isSmall = type == Type::MouseMoveSmall;
+                    const double dx = isSmall ? reader.read<int8_t>() :
+                        reader.read<int16_t>();
+                    const double dy = isSmall ? reader.read<int8_t>() :
+                        reader.read<int16_t>();
+                    if (!pos) {
+                        throw Error(
+                            Error::Component::Engine,
+                            3016,
+                            "Mouse movement without a previous position"
+                        );
+                    }
+                    (*pos)[0] += dx / PositionSteps;
+                    (*pos)[1] += dy / PositionSteps;
+                }
+                if (_callbacks.mousePos) {
+                    _callbacks.mousePos((*pos)[0], (*pos)[1], window);
+                }
+                break;
+            }
+            case Type::MouseScroll:
+            {
+                const int16_t x = reader.read<int16_t>();
+                const int16_t y = reader.read<int16_t>();
+                if (_callbacks.mouseScroll) {
+                    _callbacks.mouseScroll(x / ScrollSteps, y / ScrollSteps, window);
+                }
+                break;
+            }
+            case Type::Drop:
+            {
+                const uint8_t count = reader.read<uint8_t>();
+                std::vector<std::string> paths;
+                paths.reserve(count);
+                for (uint8_t i = 0; i < count; i++) {
+                    paths.push_back(reader.read<std::string>());
+                }
+                if (_callbacks.drop) {
+                    _callbacks.drop(
+                        std::vector<std::string_view>(paths.begin(), paths.end())
+                    );
+                }
+                break;
+            }
+        }
+    }
+}
+
+} // namespace sgct
@@ -0,0 +1,249 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/jobsystem.h>
+
+#include <sgct/profiling.h>
+#include <algorithm>
+
+namespace {
+    // The index of the worker that runs on the current thread, or -1 if the thread is not
+    // a worker of any job system
+    thread_local int CurrentWorker = -1;
+    thread_local const void* CurrentSystem = nullptr;
+} // namespace
+
+namespace sgct {
+
+struct JobSystem::State {
+    std::function<void()> function;
+
+    // The number of dependencies that have not finished yet, plus one while the job is
+    // being submitted
+    std::atomic_int nPending = 1;
+
+    std::mutex mutex;
+    bool isFinished = false;
+    std::vector<std::shared_ptr<State>> dependents;
+    std::exception_ptr error;
+};
+
+bool JobSystem::Job::isFinished() const {
+    if (!_state) {
+        return true;
+    }
+    const std::unique_lock lock(_state->mutex);
+    return _state->isFinished;
+}
+
+JobSystem::JobSystem(int nThreads) {
+    const int n = std::max(nThreads, 1);
+    for (int i = 0; i < n; i++) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < n; i++) {
+        _threads.emplace_back(&JobSystem::loop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        const std::unique_lock lock(_sleepMutex);
+        _shouldTerminate = true;
+    }
+    _sleepCond.notify_all();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+}
+
+JobSystem::Job JobSystem::submit(std::function<void()> function,
+                                 const std::vector<Job>& dependencies,
+                                 std::optional<FrameStage> finishBefore)
+{
+    ZoneScoped;
+
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->function = std::move(function);
+    for (const Job& dependency : dependencies) {
+        if (!dependency._state) {
+            continue;
+        }
+
+        const std::unique_lock lock(dependency._state->mutex);
+        if (!dependency._state->isFinished) {
+            state->nPending++;
+            dependency._state->dependents.push_back(state);
+        }
+    }
+
+    Job job;
+    job._state = state;
+    if (finishBefore.has_value()) {
+        const std::unique_lock lock(_stageMutex);
+        _stageJobs[static_cast<int>(*finishBefore)].push_back(job);
+    }
+
+    // Removes the count that prevented the dependencies from scheduling the job before
+    // all of them were registered
+    if (--state->nPending == 0) {
+        schedule(std::move(state));
+    }
+    return job;
+}
+
+void JobSystem::wait(const Job& job) {
+    ZoneScoped;
+
+    if (!job._state) {
+        return;
+    }
+
+    const int index = CurrentSystem == this ? CurrentWorker : -1;
+    while (!job.isFinished()) {
+        if (runOne(index)) {
+            continue;
+        }
+
+        std::unique_lock lock(_sleepMutex);
+        _sleepCond.wait(lock, [&]() { return job.isFinished() || _nQueued > 0; });
+    }
+
+    if (job._state->error) {
+        std::rethrow_exception(job._state->error);
+    }
+}
+
+void JobSystem::finishStage(FrameStage stage) {
+    ZoneScoped;
+
+    std::vector<Job> jobs;
+    {
+        const std::unique_lock lock(_stageMutex);
+        std::swap(jobs, _stageJobs[static_cast<int>(stage)]);
+    }
+
+    std::exception_ptr error;
+    for (const Job& job : jobs) {
+        try {
+            wait(job);
+        }
+        catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+int JobSystem::nThreads() const {
+    return static_cast<int>(_threads.size());
+}
+
+void JobSystem::loop(int index) {
+    CurrentWorker = index;
+    CurrentSystem = this;
+
+    while (true) {
+        if (runOne(index)) {
+            continue;
+        }
+
+        std::unique_lock lock(_sleepMutex);
+        _sleepCond.wait(lock, [this]() { return _shouldTerminate || _nQueued > 0; });
+        if (_shouldTerminate && _nQueued == 0) {
+            break;
+        }
+    }
+}
+
+bool JobSystem::runOne(int index) {
+    std::shared_ptr<State> state;
+
+    // The own queue is used as a stack so that a job's children run while their data is
+    // still in the cache
+    if (index >= 0) {
+        Worker& worker = *_workers[index];
+        const std::unique_lock lock(worker.mutex);
+        if (!worker.queue.empty()) {
+            state = std::move(worker.queue.back());
+            worker.queue.pop_back();
+        }
+    }
+
+    // Steals the oldest job of the other queues, which tends to be the largest one
+    const int nWorkers = static_cast<int>(_workers.size());
+    for (int i = 1; !state && i <= nWorkers; i++) {
+        Worker& victim = *_workers[(std::max(index, 0) + i) % nWorkers];
+        const std::unique_lock lock(victim.mutex);
+        if (!victim.queue.empty()) {
+            state = std::move(victim.queue.front());
+            victim.queue.pop_front();
+        }
+    }
+
+    if (!state) {
+        return false;
+    }
+    _nQueued--;
+
+    try {
+        state->function();
+    }
+    catch (...) {
+        state->error = std::current_exception();
+    }
+    // Releases everything that was captured by the job as early as possible
+    state->function = nullptr;
+    finish(*state);
+    return true;
+}
+
+void JobSystem::schedule(std::shared_ptr<State> state) {
+    const size_t index = CurrentSystem == this ?
+        static_cast<size_t>(CurrentWorker) :
+        static_cast<unsigned int>(_nextWorker++) % _workers.size();
+    {
+        Worker& worker = *_workers[index];
+        const std::unique_lock lock(worker.mutex);
+        worker.queue.push_back(std::move(state));
+    }
+    {
+        const std::unique_lock lock(_sleepMutex);
+        _nQueued++;
+    }
+    _sleepCond.notify_one();
+}
+
+void JobSystem::finish(State& state) {
+    std::vector<std::shared_ptr<State>> dependents;
+    {
+        const std::unique_lock lock(state.mutex);
+        state.isFinished = true;
+        std::swap(dependents, state.dependents);
+    }
+
+    for (std::shared_ptr<State>& dependent : dependents) {
+        if (--dependent->nPending == 0) {
+            schedule(std::move(dependent));
+        }
+    }
+
+    // Wakes up the threads that are waiting for this job. The mutex is locked so that
+    // the notification cannot happen between a waiter's check and it falling asleep
+    {
+        const std::unique_lock lock(_sleepMutex);
+    }
+    _sleepCond.notify_all();
+}
+
+} // namespace sgct
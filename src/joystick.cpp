@@ -0,0 +1,487 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/joystick.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <Xinput.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // WIN32
+
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace {
+    using sgct::joystick::Event;
+    using sgct::joystick::State;
+
+    constexpr int MaxJoysticks = 16;
+
+    // The time in seconds for which the events are kept to interpolate the states of the
+    // past
+    constexpr double HistoryDuration = 1.0;
+
+    // The axes are only interpolated between samples that are closer than this, in
+    // seconds, as an axis that has not been sampled for longer has not moved
+    constexpr double MaxInterpolationGap = 0.05;
+
+    // The number of events that are kept until the application takes them
+    constexpr size_t MaxQueuedEvents = 4096;
+
+    // The time in seconds after which the joysticks that are not connected are looked
+    // for again
+    constexpr double ScanInterval = 1.0;
+
+    struct Device {
+        // The state before the oldest event of the history
+        State base;
+        State current;
+        std::deque<Event> history;
+    };
+
+    // Protects the devices and the queue, which are written by the sampling thread
+    std::mutex mutex;
+    std::array<Device, MaxJoysticks> devices;
+    std::deque<Event> queue;
+
+    std::atomic_bool isRunning = false;
+    std::thread thread;
+
+    void apply(State& state, const Event& e) {
+        const size_t idx = static_cast<size_t>(e.index);
+        if (e.type == Event::Type::Axis) {
+            if (idx >= state.axes.size()) {
+                state.axes.resize(idx + 1, 0.f);
+            }
+            state.axes[idx] = e.value;
+        }
+        else {
+            if (idx >= state.buttons.size()) {
+                state.buttons.resize(idx + 1, false);
+            }
+            state.buttons[idx] = e.value != 0.f;
+        }
+    }
+
+    void connect(int joystick, int nAxes, int nButtons) {
+        std::lock_guard lock(mutex);
+        Device& d = devices[joystick];
+        d.current = State{
+            .isPresent = true,
+            .axes = std::vector<float>(nAxes, 0.f),
+            .buttons = std::vector<bool>(nButtons, false)
+        };
+        d.base = d.current;
+        d.history.clear();
+        sgct::Log::Info(std::format(
+            "Joystick {} connected with {} axes and {} buttons",
+            joystick + 1, nAxes, nButtons
+        ));
+    }
+
+    void disconnect(int joystick) {
+        std::lock_guard lock(mutex);
+        devices[joystick] = Device();
+        sgct::Log::Info(std::format("Joystick {} disconnected", joystick + 1));
+    }
+
+    // Sets the value that a joystick reports when it is opened, which is not a change
+    // and therefore is neither queued nor kept in the history
+    void setInitialValue(const Event& e) {
+        std::lock_guard lock(mutex);
+        Device& d = devices[static_cast<int>(e.joystick)];
+        apply(d.current, e);
+        apply(d.base, e);
+    }
+
+    // Has to be called with the mutex locked
+    void pushLocked(const Event& e) {
+        Device& d = devices[static_cast<int>(e.joystick)];
+        apply(d.current, e);
+        d.history.push_back(e);
+        while (d.history.front().time < e.time - HistoryDuration) {
+            apply(d.base, d.history.front());
+            d.history.pop_front();
+        }
+
+        queue.push_back(e);
+        if (queue.size() > MaxQueuedEvents) {
+            queue.pop_front();
+        }
+    }
+
+    void push(const Event& e) {
+        std::lock_guard lock(mutex);
+        pushLocked(e);
+    }
+
+#ifdef WIN32
+    using XInputGetStateFunc = DWORD(WINAPI*)(DWORD, XINPUT_STATE*);
+
+    // The buttons of the XInput controllers, in the order of the button indices
+    constexpr std::array<WORD, 14> XInputButtons = {
+        XINPUT_GAMEPAD_A, XINPUT_GAMEPAD_B, XINPUT_GAMEPAD_X, XINPUT_GAMEPAD_Y,
+        XINPUT_GAMEPAD_LEFT_SHOULDER, XINPUT_GAMEPAD_RIGHT_SHOULDER,
+        XINPUT_GAMEPAD_BACK, XINPUT_GAMEPAD_START, XINPUT_GAMEPAD_LEFT_THUMB,
+        XINPUT_GAMEPAD_RIGHT_THUMB, XINPUT_GAMEPAD_DPAD_UP, XINPUT_GAMEPAD_DPAD_RIGHT,
+        XINPUT_GAMEPAD_DPAD_DOWN, XINPUT_GAMEPAD_DPAD_LEFT
+    };
+
+    // The thumb sticks followed by the triggers, which are mapped to [-1, 1] like GLFW
+    // does it
+    std::array<float, 6> xinputAxes(const XINPUT_GAMEPAD& pad) {
+        auto thumb = [](SHORT v) { return std::max(v / 32767.f, -1.f); };
+        auto trigger = [](BYTE v) { return v / 255.f * 2.f - 1.f; };
+        return {
+            thumb(pad.sThumbLX), thumb(pad.sThumbLY),
+            thumb(pad.sThumbRX), thumb(pad.sThumbRY),
+            trigger(pad.bLeftTrigger), trigger(pad.bRightTrigger)
+        };
+    }
+
+    void samplingLoop(double frequency) {
+        HMODULE library = LoadLibraryA("xinput1_4.dll");
+        if (!library) {
+            library = LoadLibraryA("xinput9_1_0.dll");
+        }
+        if (!library) {
+            sgct::Log::Warning("XInput is not available, so no joystick is sampled");
+            return;
+        }
+        auto getState = reinterpret_cast<XInputGetStateFunc>(
+            reinterpret_cast<void*>(GetProcAddress(library, "XInputGetState"))
+        );
+
+        // Querying a controller that is not connected takes long, so they are only
+        // looked for once in a while
+        std::array<std::optional<XINPUT_STATE>, XUSER_MAX_COUNT> previous;
+        double lastScan = -std::numeric_limits<double>::infinity();
+
+        using Clock = std::chrono::steady_clock;
+        const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / frequency)
+        );
+        Clock::time_point next = Clock::now();
+        while (isRunning) {
+            const double now = sgct::time();
+            const bool isScanning = now - lastScan >= ScanInterval;
+            if (isScanning) {
+                lastScan = now;
+            }
+
+            for (DWORD i = 0; i < XUSER_MAX_COUNT; i++) {
+                const int joystick = static_cast<int>(i);
+                if (!previous[i] && !isScanning) {
+                    continue;
+                }
+
+                XINPUT_STATE s;
+                if (getState(i, &s) != ERROR_SUCCESS) {
+                    if (previous[i]) {
+                        disconnect(joystick);
+                        previous[i] = std::nullopt;
+                    }
+                    continue;
+                }
+
+                const bool isNew = !previous[i].has_value();
+                if (isNew) {
+                    connect(joystick, 6, static_cast<int>(XInputButtons.size()));
+                }
+                else if (previous[i]->dwPacketNumber == s.dwPacketNumber) {
+                    // The packet number only changes if the state of the controller does
+                    continue;
+                }
+
+                // The state of a new controller is its initial value for every axis and
+                // button, while for the others only the changes are events
+                auto report = [&](const Event& e) {
+                    if (isNew) {
+                        setInitialValue(e);
+                    }
+                    else {
+                        push(e);
+                    }
+                };
+                const std::array<float, 6> axes = xinputAxes(s.Gamepad);
+                const std::array<float, 6> prevAxes =
+                    isNew ? axes : xinputAxes(previous[i]->Gamepad);
+                for (size_t a = 0; a < axes.size(); a++) {
+                    if (isNew || axes[a] != prevAxes[a]) {
+                        report(Event{
+                            .joystick = static_cast<sgct::Joystick>(joystick),
+                            .type = Event::Type::Axis,
+                            .index = static_cast<int>(a),
+                            .value = axes[a],
+                            .time = now
+                        });
+                    }
+                }
+                const WORD prevButtons = isNew ? s.Gamepad.wButtons :
+                    previous[i]->Gamepad.wButtons;
+                for (size_t b = 0; b < XInputButtons.size(); b++) {
+                    const bool isPressed = (s.Gamepad.wButtons & XInputButtons[b]) != 0;
+                    const bool wasPressed = (prevButtons & XInputButtons[b]) != 0;
+                    if (isNew || isPressed != wasPressed) {
+                        report(Event{
+                            .joystick = static_cast<sgct::Joystick>(joystick),
+                            .type = Event::Type::Button,
+                            .index = static_cast<int>(b),
+                            .value = isPressed ? 1.f : 0.f,
+                            .time = now
+                        });
+                    }
+                }
+                previous[i] = s;
+            }
+
+            // The samples are taken at fixed times instead of after fixed pauses, unless
+            // the sampling has fallen behind by more than one interval
+            next += interval;
+            const Clock::time_point current = Clock::now();
+            if (next < current) {
+                next = current;
+            }
+            std::this_thread::sleep_until(next);
+        }
+
+        FreeLibrary(library);
+    }
+#elif defined(__linux__)
+    void samplingLoop(double) {
+        // The joystick devices deliver every change as soon as it happens, so the thread
+        // waits for them instead of polling them at the frequency
+        std::array<int, MaxJoysticks> files;
+        files.fill(-1);
+        double lastScan = -std::numeric_limits<double>::infinity();
+
+        std::vector<pollfd> fds;
+        std::vector<int> joysticks;
+        while (isRunning) {
+            const double now = sgct::time();
+            if (now - lastScan >= ScanInterval) {
+                lastScan = now;
+                for (int i = 0; i < MaxJoysticks; i++) {
+                    if (files[i] != -1) {
+                        continue;
+                    }
+                    const std::string path = std::format("/dev/input/js{}", i);
+                    const int file = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+                    if (file == -1) {
+                        continue;
+                    }
+                    char nAxes = 0;
+                    char nButtons = 0;
+                    ioctl(file, JSIOCGAXES, &nAxes);
+                    ioctl(file, JSIOCGBUTTONS, &nButtons);
+                    connect(i, nAxes, nButtons);
+                    files[i] = file;
+                }
+            }
+
+            fds.clear();
+            joysticks.clear();
+            for (int i = 0; i < MaxJoysticks; i++) {
+                if (files[i] != -1) {
+                    fds.push_back({ .fd = files[i], .events = POLLIN, .revents = 0 });
+                    joysticks.push_back(i);
+                }
+            }
+            if (fds.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+
+            // Limits how long it takes to notice that the sampling is stopped
+            constexpr int Timeout = 100;
+            if (poll(fds.data(), fds.size(), Timeout) <= 0) {
+                continue;
+            }
+
+            const double time = sgct::time();
+            for (size_t f = 0; f < fds.size(); f++) {
+                const int joystick = joysticks[f];
+                js_event e;
+                ssize_t n = 0;
+                while ((n = read(fds[f].fd, &e, sizeof(e))) == sizeof(e)) {
+                    const bool isAxis = (e.type & ~JS_EVENT_INIT) == JS_EVENT_AXIS;
+                    const Event event = {
+                        .joystick = static_cast<sgct::Joystick>(joystick),
+                        .type = isAxis ? Event::Type::Axis : Event::Type::Button,
+                        .index = e.number,
+                        .value = isAxis ?
+                            std::max(e.value / 32767.f, -1.f) :
+                            static_cast<float>(e.value),
+                        .time = time
+                    };
+                    if (e.type & JS_EVENT_INIT) {
+                        setInitialValue(event);
+                    }
+                    else {
+                        push(event);
+                    }
+                }
+                if (n == -1 && errno != EAGAIN) {
+                    close(files[joystick]);
+                    files[joystick] = -1;
+                    disconnect(joystick);
+                }
+            }
+        }
+
+        for (int file : files) {
+            if (file != -1) {
+                close(file);
+            }
+        }
+    }
+#else // ^^^^ __linux__ // !WIN32 && !__linux__ vvvv
+    void samplingLoop(double) {
+        sgct::Log::Warning("Joysticks cannot be sampled on this platform");
+    }
+#endif // WIN32
+} // namespace
+
+namespace sgct::joystick {
+
+void startSampling(double frequency) {
+    if (isRunning) {
+        return;
+    }
+
+    isRunning = true;
+    thread = std::thread([frequency]() {
+        sgct::ThreadPolicy::apply(sgct::ThreadPolicy::Class::Tracking, "Joystick");
+        samplingLoop(std::max(frequency, 1.0));
+    });
+}
+
+void stopSampling() {
+    isRunning = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    std::lock_guard lock(mutex);
+    devices.fill(Device());
+    queue.clear();
+}
+
+bool isSampling() {
+    return isRunning;
+}
+
+std::vector<Event> events() {
+    std::lock_guard lock(mutex);
+    std::vector<Event> res = std::vector<Event>(queue.begin(), queue.end());
+    queue.clear();
+    return res;
+}
+
+State state(Joystick joystick) {
+    std::lock_guard lock(mutex);
+    return devices[static_cast<int>(joystick)].current;
+}
+
+State state(Joystick joystick, double time) {
+    ZoneScoped;
+
+    std::lock_guard lock(mutex);
+    const Device& d = devices[static_cast<int>(joystick)];
+    State res = d.base;
+    res.axes.resize(d.current.axes.size(), 0.f);
+    res.buttons.resize(d.current.buttons.size(), false);
+
+    // The time of the latest event of each axis before the time, or a negative value if
+    // the axis has not changed within the history
+    std::vector<double> previous = std::vector<double>(res.axes.size(), -1.0);
+    std::vector<bool> isFinished = std::vector<bool>(res.axes.size(), false);
+    for (const Event& e : d.history) {
+        const size_t idx = static_cast<size_t>(e.index);
+        if (e.time <= time) {
+            apply(res, e);
+            if (e.type == Event::Type::Axis) {
+                previous[idx] = e.time;
+            }
+            continue;
+        }
+
+        if (e.type != Event::Type::Axis || isFinished[idx]) {
+            continue;
+        }
+        // The first sample after the time is interpolated with the one before it
+        isFinished[idx] = true;
+        const double gap = e.time - previous[idx];
+        if (previous[idx] >= 0.0 && gap <= MaxInterpolationGap) {
+            const float t = static_cast<float>((time - previous[idx]) / gap);
+            res.axes[idx] += (e.value - res.axes[idx]) * t;
+        }
+    }
+    return res;
+}
+
+void setReceivedState(Joystick joystick, const State& state) {
+    std::lock_guard lock(mutex);
+    Device& d = devices[static_cast<int>(joystick)];
+    if (!state.isPresent || !d.current.isPresent) {
+        // A joystick that is connected or disconnected starts with a new history
+        d = Device();
+        d.current = state;
+        d.base = state;
+        return;
+    }
+
+    const double now = sgct::time();
+    for (size_t i = 0; i < state.axes.size(); i++) {
+        if (i >= d.current.axes.size() || d.current.axes[i] != state.axes[i]) {
+            pushLocked(Event{
+                .joystick = joystick,
+                .type = Event::Type::Axis,
+                .index = static_cast<int>(i),
+                .value = state.axes[i],
+                .time = now
+            });
+        }
+    }
+    for (size_t i = 0; i < state.buttons.size(); i++) {
+        if (i >= d.current.buttons.size() || d.current.buttons[i] != state.buttons[i]) {
+            pushLocked(Event{
+                .joystick = joystick,
+                .type = Event::Type::Button,
+                .index = static_cast<int>(i),
+                .value = state.buttons[i] ? 1.f : 0.f,
+                .time = now
+            });
+        }
+    }
+}
+
+} // namespace sgct::joystick
@@ -11,9 +11,12 @@
 #include <sgct/format.h>
 #include <sgct/networkmanager.h>
 #include <sgct/mutexes.h>
+#include <sgct/threadpolicy.h>
+#include <array>
 #include <cstdarg>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 #ifdef WIN32
@@ -55,13 +58,34 @@ Log::Log() {
     _parseBuffer.resize(128);
 }
 
+Log::~Log() {
+    setAsynchronous(false);
+}
+
 void Log::printv(Level level, std::string message) {
+    if (_isAsynchronous) {
+        push(new Record {
+            .level = level,
+            .time = ::time(nullptr),
+            .message = std::move(message)
+        });
+    }
+    else {
+        write(level, ::time(nullptr), std::move(message));
+    }
+}
+
+void Log::write(Level level, time_t time, std::string message) {
+    // The master adds its own time and level to the forwarded messages
+    if (_forwardCallback) {
+        _forwardCallback(level, message);
+    }
+
     if (_showTime) {
         constexpr int TimeBufferSize = 9;
         std::array<char, TimeBufferSize> timeBuffer;
-        const time_t now = ::time(nullptr);
         tm* timeInfoPtr = nullptr;
-        timeInfoPtr = localtime(&now);
+        timeInfoPtr = localtime(&time);
         strftime(timeBuffer.data(), TimeBufferSize, "%X", timeInfoPtr);
 
         message = std::format("{} | {}", timeBuffer.data(), message);
@@ -86,6 +110,70 @@ void Log::printv(Level level, std::string message) {
     }
 }
 
+void Log::push(Record* record) {
+    // The records form a stack that the background thread takes as a whole
+    record->next = _pending.load(std::memory_order_relaxed);
+    while (!_pending.compare_exchange_weak(
+        record->next,
+        record,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ))
+    {}
+    _pending.notify_one();
+}
+
+void Log::work() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Logging, "Writer");
+
+    bool isRunning = true;
+    while (isRunning) {
+        _pending.wait(nullptr, std::memory_order_acquire);
+        isRunning = writeRecords(_pending.exchange(nullptr, std::memory_order_acquire));
+    }
+}
+
+bool Log::writeRecords(Record* records) {
+    Record* ordered = nullptr;
+    while (records) {
+        Record* next = records->next;
+        records->next = ordered;
+        ordered = records;
+        records = next;
+    }
+
+    bool isRunning = true;
+    while (ordered) {
+        std::unique_ptr<Record> record = std::unique_ptr<Record>(ordered);
+        ordered = ordered->next;
+        if (record->isStop) {
+            isRunning = false;
+        }
+        else {
+            write(record->level, record->time, std::move(record->message));
+        }
+    }
+    return isRunning;
+}
+
+void Log::setAsynchronous(bool state) {
+    if (state == _isAsynchronous) {
+        return;
+    }
+
+    if (state) {
+        _isAsynchronous = true;
+        _thread = std::thread(&Log::work, this);
+    }
+    else {
+        _isAsynchronous = false;
+        push(new Record { .isStop = true });
+        _thread.join();
+        // Messages by threads that started logging before the mode was changed
+        writeRecords(_pending.exchange(nullptr, std::memory_order_acquire));
+    }
+}
+
 void Log::setNotifyLevel(Level nl) {
     _level = nl;
 }
@@ -106,6 +194,10 @@ void Log::setLogCallback(std::function<void(Level, std::string_view)> fn) {
     _messageCallback = std::move(fn);
 }
 
+void Log::setForwardCallback(std::function<void(Level, std::string_view)> fn) {
+    _forwardCallback = std::move(fn);
+}
+
 void Log::Debug(std::string_view message) {
     if (instance()._level <= Level::Debug) {
         instance().printv(Level::Debug, std::string(message));
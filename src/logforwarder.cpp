@@ -0,0 +1,125 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/logforwarder.h>
+
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/network.h>
+#include <stdexcept>
+
+namespace {
+    void printMessage(sgct::Log::Level level, std::string_view message) {
+        using namespace sgct;
+
+        switch (level) {
+            case Log::Level::Debug:   Log::Debug(message);   break;
+            case Log::Level::Info:    Log::Info(message);    break;
+            case Log::Level::Warning: Log::Warning(message); break;
+            case Log::Level::Error:   Log::Error(message);   break;
+            default:                  throw std::logic_error("Missing case label");
+        }
+    }
+
+    std::string_view levelName(sgct::Log::Level level) {
+        switch (level) {
+            case sgct::Log::Level::Debug:   return "debug";
+            case sgct::Log::Level::Info:    return "info";
+            case sgct::Log::Level::Warning: return "warning";
+            case sgct::Log::Level::Error:   return "error";
+            default:                        throw std::logic_error("Missing case label");
+        }
+    }
+} // namespace
+
+namespace sgct {
+
+LogForwarder::LogForwarder(Network& connection)
+    : _connection(connection)
+{}
+
+void LogForwarder::forward(Log::Level level, std::string_view message) {
+    const double now = time() + _connection.clockOffset();
+
+    std::string dropped;
+    {
+        const std::unique_lock lock(_mutex);
+        Limit& limit = _limits[static_cast<int>(level)];
+        if (now - limit.windowStart >= 1.0) {
+            if (limit.nDropped > 0) {
+                dropped = encode(
+                    Log::Level::Warning,
+                    now,
+                    std::format(
+                        "Dropped {} {} messages beyond the limit of {} per second",
+                        limit.nDropped, levelName(level),
+                        MaxMessagesPerSecond[static_cast<int>(level)]
+                    )
+                );
+            }
+            limit = { .windowStart = now };
+        }
+        if (limit.nMessages >= MaxMessagesPerSecond[static_cast<int>(level)]) {
+            limit.nDropped++;
+            return;
+        }
+        limit.nMessages++;
+    }
+
+    if (!dropped.empty()) {
+        _connection.queueMessage(dropped);
+    }
+    _connection.queueMessage(encode(level, now, message));
+}
+
+std::string LogForwarder::encode(Log::Level level, double time, std::string_view message)
+{
+    return std::format("{} {:.3f} {}", static_cast<int>(level), time, message);
+}
+
+void LogForwarder::print(int clientId, std::string_view messages) {
+    // All messages of a frame arrive together, one per line. A line that is not in the
+    // format of #encode is the continuation of a message with multiple lines
+    Log::Level level = Log::Level::Info;
+    while (!messages.empty()) {
+        const size_t end = messages.find('\n');
+        std::string_view line = messages.substr(0, end);
+
+        const size_t timeEnd = line.find(' ', 2);
+        const bool hasHeader = line.size() > 2 && line[0] >= '0' && line[0] <= '3' &&
+            line[1] == ' ' && timeEnd != std::string_view::npos;
+        double t = 0.0;
+        bool hasTime = false;
+        if (hasHeader) {
+            try {
+                t = std::stod(std::string(line.substr(2, timeEnd - 2)));
+                hasTime = true;
+            }
+            catch (const std::logic_error&) {}
+        }
+
+        if (hasTime) {
+            level = static_cast<Log::Level>(line[0] - '0');
+            line.remove_prefix(timeEnd + 1);
+            printMessage(
+                level,
+                std::format("[client {} @ {:.3f}]: {}", clientId, t, line)
+            );
+        }
+        else {
+            printMessage(level, std::format("[client {}]: {}", clientId, line));
+        }
+
+        if (end == std::string_view::npos) {
+            break;
+        }
+        messages.remove_prefix(end + 1);
+    }
+}
+
+} // namespace sgct
@@ -0,0 +1,390 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/mediadistributor.h>
+
+#include <sgct/clustermanager.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/network.h>
+#include <sgct/networkmanager.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    // Every transfer starts with the id of the medium, followed by the content of the
+    // file. If the master could not read the file, the transfer only consists of the id
+    constexpr size_t HeaderSize = sizeof(int32_t);
+
+    // The message with which a client reports the result of decoding a medium
+    struct Report {
+        int32_t id = 0;
+        int32_t success = 0;
+    };
+
+    std::vector<const sgct::Network*> dataTransferConnections() {
+        const sgct::NetworkManager& nm = sgct::NetworkManager::instance();
+        std::vector<const sgct::Network*> res;
+        for (int i = 0; i < nm.connectionsCount(); i++) {
+            const sgct::Network& connection = nm.connection(i);
+            if (connection.type() == sgct::Network::ConnectionType::DataTransfer &&
+                connection.isConnected())
+            {
+                res.push_back(&connection);
+            }
+        }
+        return res;
+    }
+} // namespace
+
+namespace sgct {
+
+MediaDistributor::MediaDistributor(uint32_t sharedObjectId, JobSystem& jobSystem)
+    : _jobSystem(jobSystem)
+    , _ready(sharedObjectId, 0)
+{}
+
+MediaDistributor::~MediaDistributor() {
+    {
+        const std::lock_guard lock(_mutex);
+        _isRunning = false;
+    }
+    _cv.notify_one();
+    if (_sender.joinable()) {
+        _sender.join();
+    }
+
+    std::vector<JobSystem::Job> jobs;
+    {
+        const std::lock_guard lock(_mutex);
+        jobs = _jobs;
+    }
+    for (const JobSystem::Job& job : jobs) {
+        try {
+            _jobSystem.wait(job);
+        }
+        catch (const std::exception& e) {
+            Log::Error(e.what());
+        }
+    }
+}
+
+int MediaDistributor::distribute(std::filesystem::path path) {
+    int id = 0;
+    {
+        const std::lock_guard lock(_mutex);
+        if (!_sender.joinable()) {
+            _sender = std::thread(&MediaDistributor::work, this);
+        }
+        id = static_cast<int>(_media.size());
+        // The master itself is pending until the connections to the clients are known
+        medium(id).nPending = 1;
+        _queue.emplace_back(id, std::move(path));
+    }
+    _cv.notify_one();
+    return id;
+}
+
+bool MediaDistributor::isReady(int id) const {
+    return id < _ready.value();
+}
+
+int MediaDistributor::nReady() const {
+    return _ready.value();
+}
+
+MediaDistributor::Status MediaDistributor::status(int id) const {
+    const std::lock_guard lock(_mutex);
+    if (id < 0 || id >= static_cast<int>(_media.size())) {
+        return Status::Transferring;
+    }
+    return _media[id].status;
+}
+
+const Image* MediaDistributor::image(int id) const {
+    const std::lock_guard lock(_mutex);
+    if (id < 0 || id >= static_cast<int>(_media.size())) {
+        return nullptr;
+    }
+    const Medium& m = _media[id];
+    return m.status == Status::Decoded ? m.image.get() : nullptr;
+}
+
+void MediaDistributor::release(int id) {
+    const std::lock_guard lock(_mutex);
+    if (id >= 0 && id < static_cast<int>(_media.size())) {
+        _media[id].image = nullptr;
+    }
+}
+
+void MediaDistributor::receive(const void* data, int length, uint64_t offset,
+                               uint64_t total)
+{
+    ZoneScoped;
+
+    if (offset == 0) {
+        _incoming = Incoming();
+        _incoming.buffer.resize(total);
+    }
+    if (offset != _incoming.received || offset + length > _incoming.buffer.size()) {
+        Log::Error(std::format(
+            "Missing {} bytes of a medium from the master", offset - _incoming.received
+        ));
+        _incoming = Incoming();
+        return;
+    }
+    std::memcpy(_incoming.buffer.data() + offset, data, length);
+    _incoming.received += length;
+
+    if (_incoming.received < total) {
+        return;
+    }
+    int32_t id = -1;
+    if (total >= HeaderSize) {
+        std::memcpy(&id, _incoming.buffer.data(), sizeof(int32_t));
+    }
+    if (id < 0) {
+        Log::Error("Received a medium without a valid header from the master");
+        _incoming = Incoming();
+        return;
+    }
+    {
+        const std::lock_guard lock(_mutex);
+        medium(id).status = Status::Decoding;
+    }
+    decode(id, std::move(_incoming.buffer), HeaderSize);
+    _incoming = Incoming();
+}
+
+void MediaDistributor::receiveReport(const void* data, int length, int clientIndex) {
+    if (length != static_cast<int>(sizeof(Report))) {
+        Log::Error(std::format(
+            "Received a media report of {} bytes from client {}", length, clientIndex
+        ));
+        return;
+    }
+    Report report;
+    std::memcpy(&report, data, sizeof(Report));
+    finish(report.id, report.success != 0, clientIndex);
+}
+
+void MediaDistributor::update() {
+    const std::lock_guard lock(_mutex);
+    int32_t ready = _ready.value();
+    while (ready < static_cast<int32_t>(_media.size()) && _media[ready].nPending <= 0) {
+        ready++;
+    }
+    if (ready != _ready.value()) {
+        _ready = ready;
+    }
+}
+
+void MediaDistributor::work() {
+    while (true) {
+        std::pair<int, std::filesystem::path> next;
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [this]() { return !_queue.empty() || !_isRunning; });
+            if (!_isRunning) {
+                return;
+            }
+            next = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        sendFile(next.first, next.second);
+    }
+}
+
+void MediaDistributor::sendFile(int id, const std::filesystem::path& path) {
+    ZoneScoped;
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    const std::string filename = path.string();
+
+    // If the transfers are relayed, the clients behind a connection report as well
+    const NetworkManager& nm = NetworkManager::instance();
+    std::vector<const Network*> connections = dataTransferConnections();
+    {
+        const std::lock_guard lock(_mutex);
+        for (const Network* connection : connections) {
+            medium(id).nPending += nm.transferNodesCount(*connection);
+        }
+    }
+
+    // A file that cannot be opened is still announced to the clients as an empty
+    // transfer so that it fails on all nodes instead of never becoming ready
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    bool isValid = file.good();
+    if (!isValid) {
+        Log::Error(std::format("Failed to open medium '{}'", filename));
+    }
+    const uint64_t size = isValid ? static_cast<uint64_t>(file.tellg()) : 0;
+    file.seekg(0);
+
+    const uint64_t total = HeaderSize + size;
+    std::vector<unsigned char> buffer(total);
+    const int32_t header = id;
+    std::memcpy(buffer.data(), &header, sizeof(int32_t));
+
+    const ClusterManager& cm = ClusterManager::instance();
+    const uint64_t chunkSize = static_cast<uint64_t>(cm.transferChunkSize());
+    // The limit is provided in kilobytes per second, 0 means unlimited
+    const double bytesPerSecond = cm.transferRateLimit() * 1000.0;
+    const auto start = std::chrono::steady_clock::now();
+
+    // Each chunk is sent to all clients as soon as it has been read, so that reading the
+    // next chunk overlaps with the clients receiving the previous one
+    uint64_t offset = 0;
+    while (offset < total) {
+        {
+            const std::lock_guard lock(_mutex);
+            if (!_isRunning) {
+                return;
+            }
+        }
+
+        const uint64_t end = std::min(offset + chunkSize, total);
+        const uint64_t readBegin = std::max(offset, static_cast<uint64_t>(HeaderSize));
+        if (isValid && end > readBegin) {
+            file.read(
+                reinterpret_cast<char*>(buffer.data() + readBegin),
+                static_cast<std::streamsize>(end - readBegin)
+            );
+            if (!file.good()) {
+                // The remaining chunks are still sent so that the transfer completes
+                Log::Error(std::format("Failed to read medium '{}'", filename));
+                isValid = false;
+            }
+        }
+
+        for (auto it = connections.begin(); it != connections.end();) {
+            const Network& connection = **it;
+            try {
+                if (!connection.isConnected()) {
+                    throw std::runtime_error(std::format(
+                        "Data transfer connection {} is not connected", connection.id()
+                    ));
+                }
+                connection.sendChunk(
+                    PackageId,
+                    offset,
+                    total,
+                    buffer.data() + offset,
+                    static_cast<int>(end - offset)
+                );
+                it++;
+            }
+            catch (const std::runtime_error& e) {
+                // A client that has lost the medium is not waited for
+                Log::Warning(std::format(
+                    "Stopped sending medium {} on connection {}: {}",
+                    id, connection.id(), e.what()
+                ));
+                it = connections.erase(it);
+                const std::lock_guard lock(_mutex);
+                medium(id).nPending -= nm.transferNodesCount(connection);
+            }
+        }
+        offset = end;
+
+        if (bytesPerSecond > 0.0) {
+            // Wait until the bytes sent so far are within the bandwidth limit
+            const std::chrono::duration<double> due(offset / bytesPerSecond);
+            std::this_thread::sleep_until(
+                start + std::chrono::duration_cast<std::chrono::nanoseconds>(due)
+            );
+        }
+    }
+    file.close();
+
+    if (isValid) {
+        {
+            const std::lock_guard lock(_mutex);
+            medium(id).status = Status::Decoding;
+        }
+        decode(id, std::move(buffer), HeaderSize);
+    }
+    else {
+        {
+            const std::lock_guard lock(_mutex);
+            medium(id).status = Status::Failed;
+        }
+        finish(id, false, -1);
+    }
+}
+
+void MediaDistributor::decode(int id, std::vector<unsigned char> buffer, size_t offset) {
+    JobSystem::Job job = _jobSystem.submit(
+        [this, id, buffer = std::move(buffer), offset]() mutable {
+            ZoneScopedN("Decode medium");
+
+            std::unique_ptr<Image> image = std::make_unique<Image>();
+            bool success = false;
+            try {
+                const int length = static_cast<int>(buffer.size() - offset);
+                image->load(buffer.data() + offset, length);
+                success = true;
+            }
+            catch (const std::runtime_error& e) {
+                Log::Error(std::format("Failed to decode medium {}: {}", id, e.what()));
+            }
+            buffer = std::vector<unsigned char>();
+
+            {
+                const std::lock_guard lock(_mutex);
+                Medium& m = medium(id);
+                m.status = success ? Status::Decoded : Status::Failed;
+                if (success) {
+                    m.image = std::move(image);
+                }
+            }
+
+            if (NetworkManager::instance().isComputerServer()) {
+                finish(id, success, -1);
+            }
+            else {
+                const Report report = { .id = id, .success = success ? 1 : 0 };
+                NetworkManager::instance().transferData(
+                    &report,
+                    static_cast<int>(sizeof(Report)),
+                    PackageId
+                );
+            }
+        }
+    );
+
+    const std::lock_guard lock(_mutex);
+    std::erase_if(_jobs, [](const JobSystem::Job& j) { return j.isFinished(); });
+    _jobs.push_back(std::move(job));
+}
+
+MediaDistributor::Medium& MediaDistributor::medium(int id) {
+    if (id >= static_cast<int>(_media.size())) {
+        _media.resize(id + 1);
+    }
+    return _media[id];
+}
+
+void MediaDistributor::finish(int id, bool success, int clientIndex) {
+    if (!success && clientIndex >= 0) {
+        Log::Warning(std::format(
+            "Client {} failed to decode medium {}", clientIndex, id
+        ));
+    }
+    const std::lock_guard lock(_mutex);
+    if (id >= 0 && id < static_cast<int>(_media.size())) {
+        _media[id].nPending--;
+    }
+}
+
+} // namespace sgct
@@ -0,0 +1,192 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/memorytracker.h>
+
+#include <sgct/format.h>
+#include <sgct/opengl.h>
+#include <array>
+#include <stdexcept>
+
+namespace {
+    struct Counters {
+        std::atomic_uint64_t bytes = 0;
+        std::atomic_uint64_t peakBytes = 0;
+        std::atomic_uint64_t nAllocations = 0;
+        std::atomic_uint64_t nDeallocations = 0;
+    };
+
+    std::array<Counters, sgct::MemoryTracker::NumberOfCategories> counters;
+
+    Counters& countersFor(sgct::MemoryTracker::Category category) {
+        return counters[static_cast<int>(category)];
+    }
+
+    double toMiB(uint64_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+} // namespace
+
+namespace sgct {
+
+void MemoryTracker::allocate(Category category, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+
+    Counters& c = countersFor(category);
+    const uint64_t total = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    c.nAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (total > peak &&
+           !c.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed))
+    {}
+}
+
+void MemoryTracker::deallocate(Category category, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+
+    Counters& c = countersFor(category);
+    c.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    c.nDeallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemoryTracker::Usage MemoryTracker::usage(Category category) {
+    const Counters& c = countersFor(category);
+    return Usage {
+        .bytes = c.bytes.load(std::memory_order_relaxed),
+        .peakBytes = c.peakBytes.load(std::memory_order_relaxed),
+        .nAllocations = c.nAllocations.load(std::memory_order_relaxed),
+        .nDeallocations = c.nDeallocations.load(std::memory_order_relaxed)
+    };
+}
+
+std::string_view MemoryTracker::name(Category category) {
+    switch (category) {
+        case Category::NetworkBuffers:   return "network";
+        case Category::SharedData:       return "shareddata";
+        case Category::Images:           return "images";
+        case Category::CorrectionMeshes: return "correctionmeshes";
+        case Category::Fonts:            return "fonts";
+        case Category::Framebuffers:     return "framebuffers";
+        case Category::CubeMaps:         return "cubemaps";
+        default:                         throw std::logic_error("Unhandled case label");
+    }
+}
+
+bool MemoryTracker::isVideoMemory(Category category) {
+    switch (category) {
+        case Category::NetworkBuffers:
+        case Category::SharedData:
+        case Category::Images:
+            return false;
+        case Category::CorrectionMeshes:
+        case Category::Fonts:
+        case Category::Framebuffers:
+        case Category::CubeMaps:
+            return true;
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+size_t MemoryTracker::bytesPerTexel(unsigned int internalFormat) {
+    switch (internalFormat) {
+        case GL_R8:
+            return 1;
+        case GL_RG8:
+        case GL_R16F:
+        case GL_COMPRESSED_RG:
+            // The compressed format is counted uncompressed, as its ratio is not known
+            return 2;
+        case GL_RGB16F:
+            // The half float three channel format is assumed to be padded
+        case GL_RGBA16:
+        case GL_RGBA16F:
+        case GL_RGBA16I:
+        case GL_RGBA16UI:
+        case GL_RG32F:
+            return 8;
+        case GL_RGB32F:
+            return 12;
+        case GL_RGBA32F:
+        case GL_RGBA32I:
+        case GL_RGBA32UI:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+std::string MemoryTracker::report() {
+    std::string res = "Memory usage:";
+    uint64_t total = 0;
+    uint64_t totalVideo = 0;
+    for (int i = 0; i < NumberOfCategories; i++) {
+        const Category category = static_cast<Category>(i);
+        const Usage u = usage(category);
+        res += std::format(
+            "\n  {:<16} {:>9.2f} MiB (peak {:.2f} MiB, {} allocations, {} deallocations)"
+            "{}",
+            name(category), toMiB(u.bytes), toMiB(u.peakBytes), u.nAllocations,
+            u.nDeallocations, isVideoMemory(category) ? " estimated video memory" : ""
+        );
+        (isVideoMemory(category) ? totalVideo : total) += u.bytes;
+    }
+    res += std::format(
+        "\n  Total: {:.2f} MiB main memory, {:.2f} MiB estimated video memory",
+        toMiB(total), toMiB(totalVideo)
+    );
+    return res;
+}
+
+MemoryAccount::MemoryAccount(MemoryTracker::Category category)
+    : _category(category)
+{}
+
+MemoryAccount::MemoryAccount(MemoryAccount&& rhs) noexcept
+    : _category(rhs._category)
+    , _bytes(rhs._bytes.exchange(0))
+{}
+
+MemoryAccount& MemoryAccount::operator=(MemoryAccount&& rhs) noexcept {
+    if (this != &rhs) {
+        set(0);
+        _category = rhs._category;
+        _bytes = rhs._bytes.exchange(0);
+    }
+    return *this;
+}
+
+MemoryAccount::~MemoryAccount() {
+    set(0);
+}
+
+void MemoryAccount::set(size_t bytes) {
+    const size_t previous = _bytes.exchange(bytes, std::memory_order_relaxed);
+    if (bytes > previous) {
+        MemoryTracker::allocate(_category, bytes - previous);
+    }
+    else if (bytes < previous) {
+        MemoryTracker::deallocate(_category, previous - bytes);
+    }
+}
+
+void MemoryAccount::add(size_t bytes) {
+    _bytes.fetch_add(bytes, std::memory_order_relaxed);
+    MemoryTracker::allocate(_category, bytes);
+}
+
+size_t MemoryAccount::bytes() const {
+    return _bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace sgct
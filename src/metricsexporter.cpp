@@ -0,0 +1,519 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/metricsexporter.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/types.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <unistd.h>
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/capturecollector.h>
+#include <sgct/clustermanager.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/memorytracker.h>
+#include <sgct/networkmanager.h>
+#include <sgct/node.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <string_view>
+
+namespace {
+    // GL_NVX_gpu_memory_info and GL_ATI_meminfo, which are not part of the loader
+    constexpr GLenum GpuMemoryInfoTotalAvailableMemoryNvx = 0x9048;
+    constexpr GLenum GpuMemoryInfoCurrentAvailableVidmemNvx = 0x9049;
+    constexpr GLenum TextureFreeMemoryAti = 0x87FC;
+
+    // The time a client has to send its request before the connection is closed
+    constexpr int RequestTimeout = 1; // seconds
+    constexpr int MaxRequestSize = 4096;
+
+    // The histograms are also updated while there is no request, so that no values are
+    // missed in case the statistics' histories wrap around in the meantime
+    constexpr long CollectInterval = 100 * 1000; // microseconds
+
+    void closeSocket(SGCT_SOCKET socket) {
+#ifdef WIN32
+        closesocket(socket);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        close(socket);
+#endif // WIN32
+    }
+
+    void sendAll(SGCT_SOCKET socket, std::string_view data) {
+        while (!data.empty()) {
+            const int size = static_cast<int>(data.size());
+            const long sent = send(socket, data.data(), size, 0);
+            if (sent == SOCKET_ERROR || sent == 0) {
+                return;
+            }
+            data.remove_prefix(static_cast<size_t>(sent));
+        }
+    }
+} // namespace
+
+namespace sgct {
+
+MetricsExporter::MetricsExporter(const Engine::Statistics& statistics, int port)
+    : _nodeId(ClusterManager::instance().thisNodeId())
+    , _socket(static_cast<SGCT_SOCKET>(INVALID_SOCKET))
+{
+    ZoneScoped;
+
+    _histograms.push_back({
+        .history = &statistics.frametimes,
+        .name = "sgct_frame_time_seconds",
+        .help = "The time between the beginnings of consecutive frames"
+    });
+    _histograms.push_back({
+        .history = &statistics.drawTimes,
+        .name = "sgct_draw_time_seconds",
+        .help = "The time the GPU spent drawing and compositing the windows"
+    });
+    _histograms.push_back({
+        .history = &statistics.syncTimes,
+        .name = "sgct_sync_wait_seconds",
+        .help = "The time spent waiting for the other nodes to synchronize"
+    });
+    _values.resize(statistics.frametimes.length());
+
+    if (glfwExtensionSupported("GL_NVX_gpu_memory_info")) {
+        _gpuMemorySource = GpuMemorySource::Nvidia;
+    }
+    else if (glfwExtensionSupported("GL_ATI_meminfo")) {
+        _gpuMemorySource = GpuMemorySource::Amd;
+    }
+
+    _socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (_socket == INVALID_SOCKET) {
+        Log::Error(std::format("Failed to create the metrics socket: {}", SGCT_ERRNO));
+        return;
+    }
+
+    const int reuse = 1;
+    setsockopt(
+        _socket,
+        SOL_SOCKET,
+        SO_REUSEADDR,
+        reinterpret_cast<const char*>(&reuse),
+        sizeof(reuse)
+    );
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    const int bindResult =
+        bind(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    if (bindResult == SOCKET_ERROR || listen(_socket, SOMAXCONN) == SOCKET_ERROR) {
+        Log::Error(std::format(
+            "Failed to serve the metrics on port {}: {}", port, SGCT_ERRNO
+        ));
+        closeSocket(_socket);
+        _socket = static_cast<SGCT_SOCKET>(INVALID_SOCKET);
+        return;
+    }
+
+    Log::Info(std::format("Serving metrics on port {}", port));
+    _isRunning = true;
+    _thread = std::thread(&MetricsExporter::work, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    _isRunning = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_socket != INVALID_SOCKET) {
+        closeSocket(_socket);
+    }
+}
+
+void MetricsExporter::updateGpuMemory() {
+    if (_gpuMemorySource == GpuMemorySource::None) {
+        return;
+    }
+
+    const double now = time();
+    if (now - _lastGpuMemoryQuery < 1.0) {
+        return;
+    }
+    _lastGpuMemoryQuery = now;
+
+    if (_gpuMemorySource == GpuMemorySource::Nvidia) {
+        GLint total = 0;
+        GLint available = 0;
+        glGetIntegerv(GpuMemoryInfoTotalAvailableMemoryNvx, &total);
+        glGetIntegerv(GpuMemoryInfoCurrentAvailableVidmemNvx, &available);
+        _gpuMemoryTotal = total;
+        _gpuMemoryAvailable = available;
+    }
+    else {
+        // The first value is the free memory of the pool, the others are about the
+        // largest free block and the auxiliary memory
+        std::array<GLint, 4> info = {};
+        glGetIntegerv(TextureFreeMemoryAti, info.data());
+        _gpuMemoryAvailable = info[0];
+    }
+}
+
+void MetricsExporter::work() {
+    while (_isRunning) {
+        fd_set sockets;
+        FD_ZERO(&sockets);
+        FD_SET(_socket, &sockets);
+        timeval timeout = { 0, CollectInterval };
+        const int nfds = static_cast<int>(_socket + 1);
+        const int res = select(nfds, &sockets, nullptr, nullptr, &timeout);
+
+        collect();
+        if (res <= 0 || !FD_ISSET(_socket, &sockets)) {
+            continue;
+        }
+
+        const SGCT_SOCKET client = accept(_socket, nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            continue;
+        }
+        answer(client);
+        closeSocket(client);
+    }
+}
+
+void MetricsExporter::collect() {
+    ZoneScoped;
+
+    for (Histogram& histogram : _histograms) {
+        // If values are added while they are copied, the new values would be mistaken
+        // for those that were counted before, so the copy is repeated
+        uint64_t count = histogram.history->count();
+        int nCopied = 0;
+        while (true) {
+            nCopied = histogram.history->copy(_values);
+            const uint64_t after = histogram.history->count();
+            if (after == count) {
+                break;
+            }
+            count = after;
+        }
+
+        if (count < histogram.count) {
+            // The history has been cleared when its length was changed
+            histogram.count = 0;
+        }
+        const uint64_t nNew = std::min<uint64_t>(count - histogram.count, nCopied);
+        for (uint64_t i = 0; i < nNew; i++) {
+            const double value = _values[i];
+            const auto it = std::lower_bound(Buckets.cbegin(), Buckets.cend(), value);
+            histogram.buckets[std::distance(Buckets.cbegin(), it)]++;
+            histogram.sum += value;
+        }
+        histogram.total += nNew;
+        histogram.count = count;
+    }
+}
+
+void MetricsExporter::answer(SGCT_SOCKET client) const {
+    ZoneScoped;
+
+#ifdef WIN32
+    const DWORD timeout = RequestTimeout * 1000;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const timeval timeout = { RequestTimeout, 0 };
+#endif // WIN32
+    setsockopt(
+        client,
+        SOL_SOCKET,
+        SO_RCVTIMEO,
+        reinterpret_cast<const char*>(&timeout),
+        sizeof(timeout)
+    );
+
+    // Only the request line matters, the headers are read so that the client does not
+    // get a reset when the connection is closed
+    std::string request;
+    std::array<char, 512> buffer;
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < MaxRequestSize)
+    {
+        const int size = static_cast<int>(buffer.size());
+        const long received = recv(client, buffer.data(), size, 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer.data(), static_cast<size_t>(received));
+    }
+
+    const std::string_view line = std::string_view(request).substr(
+        0,
+        request.find("\r\n")
+    );
+    const bool isMetrics =
+        line.starts_with("GET /metrics ") || line.starts_with("GET / ");
+    if (!isMetrics) {
+        sendAll(
+            client,
+            "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+        );
+        return;
+    }
+
+    const std::string body = metrics();
+    const std::string header = std::format(
+        "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: {}\r\nConnection: close\r\n\r\n",
+        body.size()
+    );
+    sendAll(client, header);
+    sendAll(client, body);
+}
+
+std::string MetricsExporter::metrics() const {
+    ZoneScoped;
+
+    std::string res;
+    auto out = std::back_inserter(res);
+
+    for (const Histogram& histogram : _histograms) {
+        std::format_to(
+            out,
+            "# HELP {0} {1}\n# TYPE {0} histogram\n", histogram.name, histogram.help
+        );
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < Buckets.size(); i++) {
+            cumulative += histogram.buckets[i];
+            std::format_to(
+                out,
+                "{}_bucket{{node=\"{}\",le=\"{}\"}} {}\n",
+                histogram.name, _nodeId, Buckets[i], cumulative
+            );
+        }
+        std::format_to(
+            out,
+            "{0}_bucket{{node=\"{1}\",le=\"+Inf\"}} {2}\n{0}_sum{{node=\"{1}\"}} {3}\n"
+            "{0}_count{{node=\"{1}\"}} {2}\n",
+            histogram.name, _nodeId, histogram.total, histogram.sum
+        );
+    }
+
+    const NetworkManager& nm = NetworkManager::instance();
+    struct Counter {
+        std::string_view name;
+        std::string_view help;
+        uint64_t Network::Traffic::* value;
+    };
+    constexpr std::array<Counter, 4> Counters = {
+        Counter {
+            "sgct_network_sent_bytes_total",
+            "The number of bytes sent on a connection",
+            &Network::Traffic::bytesSent
+        },
+        Counter {
+            "sgct_network_sent_messages_total",
+            "The number of writes on a connection",
+            &Network::Traffic::messagesSent
+        },
+        Counter {
+            "sgct_network_received_bytes_total",
+            "The number of bytes received on a connection",
+            &Network::Traffic::bytesReceived
+        },
+        Counter {
+            "sgct_network_received_messages_total",
+            "The number of messages received on a connection",
+            &Network::Traffic::messagesReceived
+        }
+    };
+    for (const Counter& counter : Counters) {
+        std::format_to(
+            out,
+            "# HELP {0} {1}\n# TYPE {0} counter\n", counter.name, counter.help
+        );
+        for (int i = 0; i < nm.connectionsCount(); i++) {
+            const Network& connection = nm.connection(i);
+            const bool isSync =
+                connection.type() == Network::ConnectionType::SyncConnection;
+            std::format_to(
+                out,
+                "{}{{node=\"{}\",connection=\"{}\",type=\"{}\"}} {}\n",
+                counter.name, _nodeId, connection.id(), isSync ? "sync" : "transfer",
+                connection.traffic().*counter.value
+            );
+        }
+    }
+
+    std::format_to(
+        out,
+        "# HELP sgct_network_connected Whether a connection is established\n"
+        "# TYPE sgct_network_connected gauge\n"
+    );
+    for (int i = 0; i < nm.connectionsCount(); i++) {
+        const Network& connection = nm.connection(i);
+        const bool isSync = connection.type() == Network::ConnectionType::SyncConnection;
+        std::format_to(
+            out,
+            "sgct_network_connected{{node=\"{}\",connection=\"{}\",type=\"{}\"}} {}\n",
+            _nodeId, connection.id(), isSync ? "sync" : "transfer",
+            connection.isConnected() ? 1 : 0
+        );
+    }
+
+    struct Gauge {
+        std::string_view name;
+        std::string_view help;
+        double (*value)(const Network::TransferStatistics&);
+    };
+    constexpr std::array<Gauge, 4> TransferGauges = {
+        Gauge {
+            "sgct_transfer_packages_in_flight",
+            "The data transfer packages that have not been acknowledged yet",
+            [](const Network::TransferStatistics& s) {
+                return static_cast<double>(s.packagesInFlight);
+            }
+        },
+        Gauge {
+            "sgct_transfer_bytes_in_flight",
+            "The bytes of the data transfer packages that have not been acknowledged yet",
+            [](const Network::TransferStatistics& s) {
+                return static_cast<double>(s.bytesInFlight);
+            }
+        },
+        Gauge {
+            "sgct_transfer_throughput_bytes_per_second",
+            "The rate at which data transfer packages are acknowledged",
+            [](const Network::TransferStatistics& s) { return s.throughput; }
+        },
+        Gauge {
+            "sgct_transfer_latency_seconds",
+            "The time between sending a data transfer package and its acknowledgement",
+            [](const Network::TransferStatistics& s) { return s.latency; }
+        }
+    };
+    for (const Gauge& gauge : TransferGauges) {
+        std::format_to(
+            out,
+            "# HELP {0} {1}\n# TYPE {0} gauge\n", gauge.name, gauge.help
+        );
+        for (int i = 0; i < nm.connectionsCount(); i++) {
+            const Network& connection = nm.connection(i);
+            if (connection.type() != Network::ConnectionType::DataTransfer) {
+                continue;
+            }
+            std::format_to(
+                out,
+                "{}{{node=\"{}\",connection=\"{}\"}} {}\n",
+                gauge.name, _nodeId, connection.id(),
+                gauge.value(connection.transferStatistics())
+            );
+        }
+    }
+
+    int nQueued = 0;
+    const Node& node = ClusterManager::instance().thisNode();
+    for (const std::unique_ptr<Window>& w : node.windows()) {
+        nQueued += w->nQueuedScreenshots();
+    }
+    std::format_to(
+        out,
+        "# HELP sgct_capture_queue_depth The screenshots that are waiting to be saved\n"
+        "# TYPE sgct_capture_queue_depth gauge\n"
+        "sgct_capture_queue_depth{{node=\"{}\"}} {}\n",
+        _nodeId, nQueued
+    );
+    if (const CaptureCollector* collector = Engine::instance().captureCollector()) {
+        std::format_to(
+            out,
+            "# HELP sgct_capture_pending The screenshots that are waiting to be sent\n"
+            "# TYPE sgct_capture_pending gauge\n"
+            "sgct_capture_pending{{node=\"{}\"}} {}\n",
+            _nodeId, collector->statistics().nPending
+        );
+    }
+
+    if (_gpuMemorySource == GpuMemorySource::Nvidia) {
+        std::format_to(
+            out,
+            "# HELP sgct_gpu_memory_total_bytes The dedicated video memory\n"
+            "# TYPE sgct_gpu_memory_total_bytes gauge\n"
+            "sgct_gpu_memory_total_bytes{{node=\"{}\"}} {}\n",
+            _nodeId, static_cast<uint64_t>(_gpuMemoryTotal.load()) * 1024
+        );
+    }
+    if (_gpuMemorySource != GpuMemorySource::None) {
+        std::format_to(
+            out,
+            "# HELP sgct_gpu_memory_available_bytes The video memory that is available\n"
+            "# TYPE sgct_gpu_memory_available_bytes gauge\n"
+            "sgct_gpu_memory_available_bytes{{node=\"{}\"}} {}\n",
+            _nodeId, static_cast<uint64_t>(_gpuMemoryAvailable.load()) * 1024
+        );
+    }
+
+    std::format_to(
+        out,
+        "# HELP sgct_memory_bytes The memory of the subsystems, estimated for video "
+        "memory\n"
+        "# TYPE sgct_memory_bytes gauge\n"
+    );
+    for (int i = 0; i < MemoryTracker::NumberOfCategories; i++) {
+        const MemoryTracker::Category category = static_cast<MemoryTracker::Category>(i);
+        std::format_to(
+            out,
+            "sgct_memory_bytes{{node=\"{}\",subsystem=\"{}\",memory=\"{}\"}} {}\n",
+            _nodeId, MemoryTracker::name(category),
+            MemoryTracker::isVideoMemory(category) ? "video" : "main",
+            MemoryTracker::usage(category).bytes
+        );
+    }
+    std::format_to(
+        out,
+        "# HELP sgct_memory_peak_bytes The largest memory of the subsystems so far\n"
+        "# TYPE sgct_memory_peak_bytes gauge\n"
+    );
+    for (int i = 0; i < MemoryTracker::NumberOfCategories; i++) {
+        const MemoryTracker::Category category = static_cast<MemoryTracker::Category>(i);
+        std::format_to(
+            out,
+            "sgct_memory_peak_bytes{{node=\"{}\",subsystem=\"{}\",memory=\"{}\"}} "
+            "{}\n",
+            _nodeId, MemoryTracker::name(category),
+            MemoryTracker::isVideoMemory(category) ? "video" : "main",
+            MemoryTracker::usage(category).peakBytes
+        );
+    }
+
+    std::format_to(
+        out,
+        "# HELP sgct_frames_total The number of frames that were rendered\n"
+        "# TYPE sgct_frames_total counter\n"
+        "sgct_frames_total{{node=\"{}\"}} {}\n",
+        _nodeId, _histograms.front().history->count()
+    );
+
+    return res;
+}
+
+} // namespace sgct
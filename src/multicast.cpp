@@ -0,0 +1,404 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/multicast.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <unistd.h>
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    // Each datagram starts with the message id, the sequence number, the size of the
+    // full block, the index of the fragment, and the number of fragments in the block
+    constexpr int DatagramHeaderSize = 13;
+
+    // Keeps the datagrams below the typical Ethernet MTU to avoid IP fragmentation
+    constexpr uint32_t FragmentSize = 1400;
+
+    // How long a client waits for missing fragments before it sends a NACK
+    constexpr std::chrono::milliseconds NackTimeout = std::chrono::milliseconds(5);
+
+    // The receive buffer is sized to absorb the bursts of a large shared data block
+    constexpr int ReceiveBufferSize = 4 * 1024 * 1024;
+
+    uint16_t numberOfFragments(uint32_t size) {
+        return static_cast<uint16_t>(std::max<uint32_t>(
+            (size + FragmentSize - 1) / FragmentSize,
+            1
+        ));
+    }
+
+    void closeSocket(SGCT_SOCKET socket) {
+#ifdef WIN32
+        shutdown(socket, SD_BOTH);
+        closesocket(socket);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        shutdown(socket, SHUT_RDWR);
+        close(socket);
+#endif // WIN32
+    }
+} // namespace
+
+namespace sgct {
+
+Multicast::Multicast(const std::string& group, int port, bool isServer)
+    : _socket(INVALID_SOCKET)
+    , _isServer(isServer)
+    , _port(static_cast<uint16_t>(port))
+{
+    ZoneScoped;
+
+    in_addr groupAddress = {};
+    if (inet_pton(AF_INET, group.c_str(), &groupAddress) != 1) {
+        throw Err(5031, std::format("Invalid multicast group address '{}'", group));
+    }
+    _group = groupAddress.s_addr;
+
+    _socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (_socket == INVALID_SOCKET) {
+        throw Err(5032, std::format("Failed to create multicast socket: {}", SGCT_ERRNO));
+    }
+
+    if (_isServer) {
+        // Only broadcast within the local network, but loop the datagrams back so that
+        // clients running on the same computer as the master receive them as well
+        constexpr unsigned char Ttl = 1;
+        setsockopt(
+            _socket,
+            IPPROTO_IP,
+            IP_MULTICAST_TTL,
+            reinterpret_cast<const char*>(&Ttl),
+            sizeof(Ttl)
+        );
+        constexpr unsigned char Loop = 1;
+        setsockopt(
+            _socket,
+            IPPROTO_IP,
+            IP_MULTICAST_LOOP,
+            reinterpret_cast<const char*>(&Loop),
+            sizeof(Loop)
+        );
+        Log::Info(std::format("Broadcasting shared data to {}:{}", group, port));
+        return;
+    }
+
+    constexpr int TrueFlag = 1;
+    setsockopt(
+        _socket,
+        SOL_SOCKET,
+        SO_REUSEADDR,
+        reinterpret_cast<const char*>(&TrueFlag),
+        sizeof(TrueFlag)
+    );
+    setsockopt(
+        _socket,
+        SOL_SOCKET,
+        SO_RCVBUF,
+        reinterpret_cast<const char*>(&ReceiveBufferSize),
+        sizeof(ReceiveBufferSize)
+    );
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(_port);
+    const int bindRes = bind(
+        _socket,
+        reinterpret_cast<const sockaddr*>(&address),
+        sizeof(address)
+    );
+    if (bindRes == SOCKET_ERROR) {
+        closeSocket(_socket);
+        throw Err(5033, std::format("Failed to bind multicast socket: {}", SGCT_ERRNO));
+    }
+
+    ip_mreq request = {};
+    request.imr_multiaddr.s_addr = _group;
+    request.imr_interface.s_addr = htonl(INADDR_ANY);
+    const int joinRes = setsockopt(
+        _socket,
+        IPPROTO_IP,
+        IP_ADD_MEMBERSHIP,
+        reinterpret_cast<const char*>(&request),
+        sizeof(request)
+    );
+    if (joinRes == SOCKET_ERROR) {
+        closeSocket(_socket);
+        throw Err(
+            5034,
+            std::format("Failed to join multicast group {}: {}", group, SGCT_ERRNO)
+        );
+    }
+
+    Log::Info(std::format("Receiving shared data from {}:{}", group, port));
+    _receiveThread = std::make_unique<std::thread>([this]() { receiveHandler(); });
+}
+
+Multicast::~Multicast() {
+    close();
+    if (_receiveThread) {
+        _receiveThread->join();
+    }
+}
+
+uint32_t Multicast::send(const char* data, uint32_t length) {
+    ZoneScoped;
+
+    if (length > static_cast<uint64_t>(FragmentSize) * UINT16_MAX) {
+        throw Err(5035, std::format("Shared data of {} bytes is too large", length));
+    }
+
+    std::vector<char> block = std::vector<char>(data, data + length);
+    const uint32_t sequence = _nextSequence++;
+    const uint16_t nFragments = numberOfFragments(length);
+    for (uint16_t i = 0; i < nFragments; i++) {
+        sendFragment(sequence, block, i);
+    }
+
+    const std::unique_lock lock(_historyMutex);
+    _history[sequence] = std::move(block);
+    while (_history.size() > static_cast<size_t>(HistoryLength)) {
+        _history.erase(_history.begin());
+    }
+    return sequence;
+}
+
+void Multicast::retransmit(uint32_t sequence, const std::vector<uint16_t>& fragments) {
+    ZoneScoped;
+
+    const std::unique_lock lock(_historyMutex);
+    const auto it = _history.find(sequence);
+    if (it == _history.end()) {
+        Log::Warning(std::format(
+            "Shared data block {} requested that is no longer available", sequence
+        ));
+        return;
+    }
+
+    const uint32_t size = static_cast<uint32_t>(it->second.size());
+    const uint16_t nFragments = numberOfFragments(size);
+    if (fragments.empty()) {
+        for (uint16_t i = 0; i < nFragments; i++) {
+            sendFragment(sequence, it->second, i);
+        }
+    }
+    else {
+        for (const uint16_t i : fragments) {
+            if (i < nFragments) {
+                sendFragment(sequence, it->second, i);
+            }
+        }
+    }
+}
+
+void Multicast::sendFragment(uint32_t sequence, const std::vector<char>& block,
+                             uint16_t index)
+{
+    const uint32_t size = static_cast<uint32_t>(block.size());
+    const uint16_t nFragments = numberOfFragments(size);
+    const uint32_t offset = index * FragmentSize;
+    const uint32_t length = std::min(FragmentSize, size - offset);
+
+    std::array<char, DatagramHeaderSize + FragmentSize> datagram;
+    datagram[0] = Network::MulticastDataId;
+    std::memcpy(datagram.data() + 1, &sequence, sizeof(sequence));
+    std::memcpy(datagram.data() + 5, &size, sizeof(size));
+    std::memcpy(datagram.data() + 9, &index, sizeof(index));
+    std::memcpy(datagram.data() + 11, &nFragments, sizeof(nFragments));
+    if (length > 0) {
+        std::memcpy(datagram.data() + DatagramHeaderSize, block.data() + offset, length);
+    }
+
+    sockaddr_in destination = {};
+    destination.sin_family = AF_INET;
+    destination.sin_addr.s_addr = _group;
+    destination.sin_port = htons(_port);
+    const long res = sendto(
+        _socket,
+        datagram.data(),
+        static_cast<int>(DatagramHeaderSize + length),
+        0,
+        reinterpret_cast<const sockaddr*>(&destination),
+        sizeof(destination)
+    );
+    if (res == SOCKET_ERROR) {
+        // A lost datagram is recovered through a NACK from the clients
+        Log::Warning(std::format("Sending multicast datagram failed: {}", SGCT_ERRNO));
+    }
+}
+
+bool Multicast::waitForBlock(uint32_t sequence, std::vector<char>& data,
+                             std::vector<uint16_t>& missing)
+{
+    ZoneScoped;
+
+    std::unique_lock lock(_blockMutex);
+    const bool isComplete = _blockCond.wait_for(
+        lock,
+        NackTimeout,
+        [&]() {
+            if (_shouldTerminate) {
+                return true;
+            }
+            const auto it = _blocks.find(sequence);
+            return it != _blocks.end() && it->second.nMissing == 0;
+        }
+    );
+
+    const auto it = _blocks.find(sequence);
+    if (isComplete && it != _blocks.end() && it->second.nMissing == 0) {
+        data = std::move(it->second.data);
+        _blocks.erase(_blocks.begin(), std::next(it));
+        _firstAccepted = std::max(_firstAccepted, sequence + 1);
+        return true;
+    }
+
+    missing.clear();
+    if (it != _blocks.end()) {
+        const Block& block = it->second;
+        for (size_t i = 0; i < block.received.size(); i++) {
+            if (!block.received[i]) {
+                missing.push_back(static_cast<uint16_t>(i));
+            }
+        }
+    }
+    return false;
+}
+
+void Multicast::discard(uint32_t sequence) {
+    const std::unique_lock lock(_blockMutex);
+    _blocks.erase(_blocks.begin(), _blocks.upper_bound(sequence));
+    _firstAccepted = std::max(_firstAccepted, sequence + 1);
+}
+
+void Multicast::close() {
+    if (_shouldTerminate.exchange(true)) {
+        return;
+    }
+
+    if (_socket != INVALID_SOCKET) {
+        closeSocket(_socket);
+    }
+    _blockCond.notify_all();
+}
+
+void Multicast::receiveHandler() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, "Multicast");
+
+    std::array<char, DatagramHeaderSize + FragmentSize> datagram;
+
+    while (!_shouldTerminate) {
+        const long res = recv(
+            _socket,
+            datagram.data(),
+            static_cast<int>(datagram.size()),
+            0
+        );
+        if (res < DatagramHeaderSize) {
+            if (res == SOCKET_ERROR && !_shouldTerminate) {
+                Log::Warning(std::format(
+                    "Receiving multicast datagram failed: {}", SGCT_ERRNO
+                ));
+            }
+            continue;
+        }
+        if (datagram[0] != Network::MulticastDataId) {
+            continue;
+        }
+
+        uint32_t sequence = 0;
+        std::memcpy(&sequence, datagram.data() + 1, sizeof(sequence));
+        uint32_t size = 0;
+        std::memcpy(&size, datagram.data() + 5, sizeof(size));
+        uint16_t index = 0;
+        std::memcpy(&index, datagram.data() + 9, sizeof(index));
+        uint16_t nFragments = 0;
+        std::memcpy(&nFragments, datagram.data() + 11, sizeof(nFragments));
+
+        const uint32_t offset = index * FragmentSize;
+        const uint32_t length = static_cast<uint32_t>(res - DatagramHeaderSize);
+        if (nFragments != numberOfFragments(size) || index >= nFragments ||
+            length != std::min(FragmentSize, size - offset))
+        {
+            Log::Warning("Received malformed multicast datagram");
+            continue;
+        }
+
+        const std::unique_lock lock(_blockMutex);
+        if (sequence < _firstAccepted) {
+            // a retransmission of a block that has already been consumed
+            continue;
+        }
+
+        auto it = _blocks.find(sequence);
+        if (it == _blocks.end()) {
+            Block block;
+            block.data.resize(size);
+            block.received.resize(nFragments, false);
+            block.nMissing = nFragments;
+            _blocks.emplace(sequence, std::move(block));
+
+            // Blocks that were never requested, for example because the node
+            // reconnected, must not accumulate
+            while (_blocks.size() > static_cast<size_t>(2 * HistoryLength)) {
+                _blocks.erase(_blocks.begin());
+            }
+            it = _blocks.find(sequence);
+            if (it == _blocks.end()) {
+                continue;
+            }
+        }
+
+        Block& block = it->second;
+        if (block.data.size() != size || block.received[index]) {
+            continue;
+        }
+        if (length > 0) {
+            std::memcpy(
+                block.data.data() + offset,
+                datagram.data() + DatagramHeaderSize,
+                length
+            );
+        }
+        block.received[index] = true;
+        block.nMissing--;
+        if (block.nMissing == 0) {
+            _blockCond.notify_all();
+        }
+    }
+}
+
+} // namespace sgct
@@ -0,0 +1,253 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifdef SGCT_HAS_NDI
+
+#include <sgct/ndireceiver.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <cstring>
+#include <utility>
+
+namespace {
+    // The time in milliseconds that the receiving thread waits for a frame before it
+    // checks whether it should stop
+    constexpr uint32_t CaptureTimeout = 100;
+
+    // The frames are received as RGBA or RGBX, depending on whether the source has alpha
+    constexpr int BytesPerPixel = 4;
+} // namespace
+
+namespace sgct {
+
+NdiReceiver::NdiReceiver(std::string sourceName)
+    : _sourceName(std::move(sourceName))
+    , _isPersistent(GLAD_GL_VERSION_4_4)
+{
+    NDIlib_source_t source;
+    source.p_ndi_name = _sourceName.c_str();
+
+    NDIlib_recv_create_v3_t createDesc;
+    createDesc.source_to_connect_to = source;
+    createDesc.color_format = NDIlib_recv_color_format_RGBX_RGBA;
+    createDesc.bandwidth = NDIlib_recv_bandwidth_highest;
+    createDesc.allow_video_fields = false;
+    _receiver = NDIlib_recv_create_v3(&createDesc);
+    if (!_receiver) {
+        Log::Error(std::format("Error creating NDI receiver for {}", _sourceName));
+        return;
+    }
+
+    _isRunning = true;
+    _thread = std::thread(&NdiReceiver::receive, this);
+}
+
+NdiReceiver::~NdiReceiver() {
+    _isRunning = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_receiver) {
+        NDIlib_recv_destroy(_receiver);
+    }
+
+    for (Slot& slot : _slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+}
+
+bool NdiReceiver::update() {
+    ZoneScoped;
+
+    Slot* upload = nullptr;
+    {
+        std::lock_guard lock(_mutex);
+        for (Slot& slot : _slots) {
+            if (slot.state != Slot::State::Uploading) {
+                continue;
+            }
+            const GLenum res = glClientWaitSync(slot.fence, 0, 0);
+            if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED) {
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                slot.state = Slot::State::Free;
+            }
+        }
+
+        for (Slot& slot : _slots) {
+            if (slot.state == Slot::State::Free && slot.capacity < _requiredCapacity) {
+                allocate(slot, _requiredCapacity);
+            }
+        }
+
+        // Only the latest frame is uploaded and the older ones are dropped
+        for (Slot& slot : _slots) {
+            if (slot.state != Slot::State::Filled) {
+                continue;
+            }
+            if (!upload || slot.frame > upload->frame) {
+                if (upload) {
+                    upload->state = Slot::State::Free;
+                }
+                upload = &slot;
+            }
+            else {
+                slot.state = Slot::State::Free;
+            }
+        }
+        if (upload) {
+            upload->state = Slot::State::Uploading;
+        }
+    }
+
+    if (!upload) {
+        return _current != -1;
+    }
+
+    const int next = _current == 0 ? 1 : 0;
+    if (_textures[next] == 0) {
+        glGenTextures(1, &_textures[next]);
+    }
+    glBindTexture(GL_TEXTURE_2D, _textures[next]);
+    if (_textureSizes[next] != upload->size) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RGBA8,
+            upload->size.x,
+            upload->size.y,
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        _textureSizes[next] = upload->size;
+    }
+
+    // With a persistently mapped buffer, the upload only starts a transfer on the GPU.
+    // Otherwise the driver copies the frame before the function returns
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload->mapping ? upload->pbo : 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, upload->stride / BytesPerPixel);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        upload->size.x,
+        upload->size.y,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        upload->mapping ? nullptr : upload->data.data()
+    );
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    {
+        std::lock_guard lock(_mutex);
+        upload->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    _current = next;
+    return true;
+}
+
+unsigned int NdiReceiver::texture() const {
+    return _current != -1 ? _textures[_current] : 0;
+}
+
+ivec2 NdiReceiver::size() const {
+    return _current != -1 ? _textureSizes[_current] : ivec2(0, 0);
+}
+
+void NdiReceiver::receive() {
+    while (_isRunning) {
+        NDIlib_video_frame_v2_t frame;
+        const NDIlib_frame_type_e type =
+            NDIlib_recv_capture_v2(_receiver, &frame, nullptr, nullptr, CaptureTimeout);
+        if (type != NDIlib_frame_type_video) {
+            continue;
+        }
+
+        const size_t size = static_cast<size_t>(frame.line_stride_in_bytes) * frame.yres;
+        Slot* slot = nullptr;
+        {
+            std::lock_guard lock(_mutex);
+            // A frame that has not been uploaded yet is replaced, as it would be dropped
+            // in favor of this one anyway
+            for (Slot& s : _slots) {
+                if (_isPersistent && s.capacity < size) {
+                    continue;
+                }
+                if (s.state == Slot::State::Free) {
+                    slot = &s;
+                    break;
+                }
+                if (s.state == Slot::State::Filled && (!slot || s.frame < slot->frame)) {
+                    slot = &s;
+                }
+            }
+
+            if (slot) {
+                slot->state = Slot::State::Writing;
+            }
+            else if (_isPersistent && size > _requiredCapacity) {
+                // The buffers are reallocated by the rendering thread, so this frame is
+                // dropped
+                _requiredCapacity = size;
+            }
+        }
+
+        if (slot) {
+            if (!_isPersistent) {
+                slot->data.resize(size);
+            }
+            std::byte* data = slot->mapping ? slot->mapping : slot->data.data();
+            std::memcpy(data, frame.p_data, size);
+
+            std::lock_guard lock(_mutex);
+            slot->state = Slot::State::Filled;
+            slot->size = ivec2(frame.xres, frame.yres);
+            slot->stride = frame.line_stride_in_bytes;
+            slot->frame = ++_frameCounter;
+        }
+        NDIlib_recv_free_video_v2(_receiver, &frame);
+    }
+}
+
+void NdiReceiver::allocate(Slot& slot, size_t capacity) {
+    // The receiving thread only writes into the buffers, so their content is never read
+    // back by the CPU
+    constexpr GLbitfield Flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glDeleteBuffers(1, &slot.pbo);
+    glGenBuffers(1, &slot.pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, Flags);
+    slot.mapping = reinterpret_cast<std::byte*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, Flags)
+    );
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    slot.capacity = slot.mapping ? capacity : 0;
+}
+
+} // namespace sgct
+
+#endif // SGCT_HAS_NDI
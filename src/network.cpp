@@ -18,7 +18,9 @@
 #define SGCT_ERRNO WSAGetLastError()
 #else // ^^^^ WIN32 // !WIN32 vvvv
 #include <sys/types.h>
+#include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -31,25 +33,49 @@
 #define SGCT_ERRNO errno
 #endif // WIN32
 
+#include <sgct/binarylog.h>
 #include <sgct/clustermanager.h>
 #include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/multicast.h>
 #include <sgct/mutexes.h>
 #include <sgct/networkmanager.h>
 #include <sgct/profiling.h>
 #include <sgct/shareddata.h>
+#include <sgct/sharedmemory.h>
+#include <sgct/threadpolicy.h>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <random>
+#include <zlib.h>
 
 #define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
 
 namespace {
     constexpr int MaxNumberOfAttempts = 10;
 
+    // The delays between the attempts of a client to connect to its server, which double
+    // after every failed attempt. Clients usually start before the master is listening,
+    // so the first attempts are quick, while a master that takes longer to start is not
+    // flooded with connection attempts from the entire cluster
+    constexpr std::chrono::milliseconds InitialConnectDelay(50);
+    constexpr std::chrono::milliseconds MaxConnectDelay(2000);
+
     constexpr int MaxNetworkSyncFrameNumber = 10000;
 
+    // The number of NACKs a client sends for a multicast block before giving up on it
+    constexpr int MaxNackAttempts = 100;
+
+    // The number of data transfer packages after which the receiver sends an
+    // acknowledgement even if more packages are still waiting on the socket
+    constexpr uint32_t MaxUnacknowledgedPackages = 16;
+
+    // Set on the threads that receive messages, which also read the acknowledgements of
+    // the data transfer packages and therefore must never wait for them
+    thread_local bool IsReceivingThread = false;
 
     int receiveData(SGCT_SOCKET lsocket, char* buffer, int length, int flags) {
         long iResult = 0;
@@ -82,6 +108,31 @@ namespace {
         return static_cast<int>(iResult);
     }
 
+    using SocketProfile = sgct::ClusterManager::SocketProfile;
+
+    const SocketProfile& socketProfile(sgct::Network::ConnectionType connectionType) {
+        const sgct::ClusterManager& cm = sgct::ClusterManager::instance();
+        return connectionType == sgct::Network::ConnectionType::SyncConnection ?
+            cm.syncSocketProfile() :
+            cm.transferSocketProfile();
+    }
+
+    void setBufferSize(SGCT_SOCKET socket, int option, int size) {
+        const int res = setsockopt(
+            socket,
+            SOL_SOCKET,
+            option,
+            reinterpret_cast<const char*>(&size),
+            sizeof(size)
+        );
+        if (res == SOCKET_ERROR) {
+            // The system limits the sizes of the buffers, which is not fatal
+            sgct::Log::Warning(std::format(
+                "Failed to set socket buffer size to {}: {}", size, SGCT_ERRNO
+            ));
+        }
+    }
+
     void setOptions(SGCT_SOCKET socket, sgct::Network::ConnectionType connectionType) {
         constexpr int TrueFlag = 1;
 
@@ -136,6 +187,55 @@ namespace {
                 throw Err(5009, std::format("Failed to set keep alive: {}", SGCT_ERRNO));
             }
         }
+
+        // The buffers have to be sized before the connection is established for TCP to
+        // negotiate a matching window, so the listening socket is set up as well
+        const SocketProfile& profile = socketProfile(connectionType);
+        if (profile.sendBufferSize > 0) {
+            setBufferSize(socket, SO_SNDBUF, profile.sendBufferSize);
+        }
+        if (profile.receiveBufferSize > 0) {
+            setBufferSize(socket, SO_RCVBUF, profile.receiveBufferSize);
+        }
+        if (profile.dscp >= 0) {
+            // The DSCP occupies the upper six bits of the former type of service field
+            const int tos = profile.dscp << 2;
+            const int res = setsockopt(
+                socket,
+                IPPROTO_IP,
+                IP_TOS,
+                reinterpret_cast<const char*>(&tos),
+                sizeof(tos)
+            );
+            if (res == SOCKET_ERROR) {
+                sgct::Log::Warning(std::format(
+                    "Failed to set DSCP value {}: {}", profile.dscp, SGCT_ERRNO
+                ));
+            }
+        }
+    }
+
+    void bindToInterface(SGCT_SOCKET socket, const std::string& address) {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        hints.ai_flags = AI_PASSIVE;
+
+        // The port is chosen by the system, only the interface is fixed
+        addrinfo* res = nullptr;
+        if (getaddrinfo(address.c_str(), "0", &hints, &res) != 0) {
+            throw Err(5045, std::format("Failed to parse interface address {}", address));
+        }
+        const int bindRes = bind(socket, res->ai_addr, static_cast<int>(res->ai_addrlen));
+        freeaddrinfo(res);
+        if (bindRes == SOCKET_ERROR) {
+            throw Err(
+                5045,
+                std::format("Failed to bind to interface {}: {}", address, SGCT_ERRNO)
+            );
+        }
     }
 
 
@@ -153,6 +253,96 @@ namespace {
         };
         return std::string_view(header, 8) == std::string_view(rhs.data(), 8);
     }
+
+    // Each run of a delta message consists of the number of unchanged bytes to skip, the
+    // number of changed bytes, and the changed bytes XOR-ed with the reference block
+    constexpr uint32_t DeltaRunOverhead = 2 * sizeof(uint32_t);
+
+    // Encodes the difference between `data` and `reference`, which both have to be `size`
+    // bytes long, into `out` after the space reserved for the header. Returns `false` if
+    // the encoded difference would not be smaller than the data itself
+    bool encodeDelta(const char* data, const char* reference, uint32_t size,
+                     std::vector<char>& out)
+    {
+        ZoneScoped;
+
+        out.resize(sgct::Network::HeaderSize);
+        uint32_t pos = 0;
+        while (pos < size) {
+            // skip over unchanged bytes, a word at a time while possible
+            uint32_t begin = pos;
+            while (begin + sizeof(uint64_t) <= size &&
+                   std::memcmp(data + begin, reference + begin, sizeof(uint64_t)) == 0)
+            {
+                begin += sizeof(uint64_t);
+            }
+            while (begin < size && data[begin] == reference[begin]) {
+                begin++;
+            }
+            if (begin == size) {
+                // trailing unchanged bytes do not need a run
+                break;
+            }
+
+            // include short unchanged gaps in the run as they are cheaper than a new run
+            uint32_t end = begin + 1;
+            for (uint32_t i = end; i < size && i - end < DeltaRunOverhead; i++) {
+                if (data[i] != reference[i]) {
+                    end = i + 1;
+                }
+            }
+
+            const uint32_t skip = begin - pos;
+            const uint32_t count = end - begin;
+            const size_t offset = out.size();
+            if (offset - sgct::Network::HeaderSize + DeltaRunOverhead + count >= size) {
+                return false;
+            }
+
+            out.resize(offset + DeltaRunOverhead + count);
+            std::memcpy(out.data() + offset, &skip, sizeof(skip));
+            std::memcpy(out.data() + offset + sizeof(skip), &count, sizeof(count));
+            char* run = out.data() + offset + DeltaRunOverhead;
+            for (uint32_t i = 0; i < count; i++) {
+                run[i] = data[begin + i] ^ reference[begin + i];
+            }
+            pos = end;
+        }
+        return true;
+    }
+
+    // Applies a difference created by `encodeDelta` onto `reference` in-place
+    void applyDelta(const char* delta, uint32_t deltaSize, char* reference, uint32_t size)
+    {
+        ZoneScoped;
+
+        uint32_t deltaPos = 0;
+        uint32_t pos = 0;
+        while (deltaPos < deltaSize) {
+            if (deltaSize - deltaPos < DeltaRunOverhead) {
+                throw Err(5029, "Malformed run header in delta sync message");
+            }
+            uint32_t skip = 0;
+            std::memcpy(&skip, delta + deltaPos, sizeof(skip));
+            uint32_t count = 0;
+            std::memcpy(&count, delta + deltaPos + sizeof(skip), sizeof(count));
+            deltaPos += DeltaRunOverhead;
+
+            if (count > deltaSize - deltaPos || skip > size - pos ||
+                count > size - pos - skip)
+            {
+                throw Err(5029, "Malformed run in delta sync message");
+            }
+
+            pos += skip;
+            const char* run = delta + deltaPos;
+            for (uint32_t i = 0; i < count; i++) {
+                reference[pos + i] ^= run[i];
+            }
+            pos += count;
+            deltaPos += count;
+        }
+    }
 } // namespace
 
 namespace sgct {
@@ -167,6 +357,7 @@ Network::Network(int port, const std::string& address, bool isServer, Connection
     , _connectionType(t)
     , _isServer(isServer)
     , _port(port)
+    , _address(address)
 {
     static int id = 0;
     _id = id;
@@ -184,8 +375,12 @@ Network::Network(int port, const std::string& address, bool isServer, Connection
     hints.ai_protocol = IPPROTO_TCP;
     hints.ai_flags = AI_PASSIVE;
 
-    // Resolve the local address and port to be used by the server
-    const char* a = _isServer ? nullptr : address.c_str();
+    // Resolve the local address and port to be used by the server, which listens on all
+    // interfaces unless the connection is bound to a specific one
+    const std::string& interfaceAddress = socketProfile(t).interfaceAddress;
+    const char* a = _isServer ?
+        (interfaceAddress.empty() ? nullptr : interfaceAddress.c_str()) :
+        address.c_str();
     std::string portStr = std::to_string(_port);
     addrinfo* res = nullptr;
     const int addrRes = getaddrinfo(a, portStr.c_str(), &hints, &res);
@@ -226,41 +421,9 @@ Network::Network(int port, const std::string& address, bool isServer, Connection
             throw Err(5003, "Listen call failed");
         }
     }
-    else {
-        // Client socket: Connect to server
-        while (!_shouldTerminate) {
-            Log::Info(std::format(
-                "Attempting to connect to server (id: {}, ip: {}, type: {})",
-                _id, address, typeStr(type())
-            ));
-
-            _socket = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
-            if (_socket == INVALID_SOCKET) {
-                freeaddrinfo(res);
-                throw Err(5004, "Failed to init client socket");
-            }
-
-            setOptions(_socket, type());
-
-            const int r = connect(
-                _socket,
-                res->ai_addr,
-                static_cast<int>(res->ai_addrlen)
-            );
-            if (r != SOCKET_ERROR) {
-                break;
-            }
-
-            if (SGCT_ERRNO == 10061) {
-                Log::Debug("Waiting for connection...");
-            }
-            else {
-                Log::Debug(std::format("Connect error code: {}", SGCT_ERRNO));
-            }
-            std::this_thread::sleep_for(std::chrono::seconds(1)); // wait for next attempt
-        }
-    }
 
+    // A client connects to the server from its connection thread, so that all
+    // connections of a node are established in parallel
     freeaddrinfo(res);
 }
 
@@ -272,7 +435,58 @@ void Network::initialize() {
     _mainThread = std::make_unique<std::thread>([this]() { connectionHandler(); });
 }
 
+void Network::initializeEventDriven() {
+    // A client has to be connected before the reactor can wait for its data, a server
+    // first has to wait for incoming data on its listening socket
+    if (!_isServer) {
+        if (_socket == INVALID_SOCKET && !connectToServer()) {
+            return;
+        }
+        beginConnection();
+        _isReceiving = true;
+    }
+    else {
+        Log::Info(std::format("Waiting for client {} to connect on port {}", _id, _port));
+    }
+}
+
+SGCT_SOCKET Network::pollSocket() const {
+    return _isReceiving ? _socket : _listenSocket;
+}
+
+bool Network::handleReadable() {
+    if (!_isReceiving) {
+        if (_shouldTerminate) {
+            return false;
+        }
+        if (!acceptConnection()) {
+            return !_shouldTerminate;
+        }
+        beginConnection();
+        _isReceiving = true;
+        return true;
+    }
+
+    bool isOpen = false;
+    try {
+        isOpen = receiveMessage();
+    }
+    catch (const std::runtime_error& e) {
+        Log::Error(e.what());
+    }
+    if (isOpen) {
+        return true;
+    }
+
+    // The server keeps polling its listening socket so that the client can reconnect
+    _isReceiving = false;
+    endConnection();
+    return _isServer && !_shouldTerminate;
+}
+
 void Network::connectionHandler() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, std::format("Conn {}", _id));
+
     if (_isServer) {
         while (!_shouldTerminate) {
             if (!_isConnected) {
@@ -351,15 +565,129 @@ int Network::iterateFrameCounter() {
 
 void Network::pushClientMessage() {
     // The servers' render function is locked until an ack message is received
-    const int currentFrame = iterateFrameCounter();
-    uint32_t localSyncHeaderSize = 0;
+    int currentFrame = 0;
+    if (ClusterManager::instance().syncDeadline() > 0.0) {
+        // The master might have moved on without this client, so it acknowledges the
+        // newest frame that it received, which skips all of the frames in between
+        const int recvFrame = _currentRecvFrame.load();
+        if (recvFrame != _currentSendFrame) {
+            const int nSkipped = recvFrame - _currentSendFrame - 1;
+            _droppedFrames += static_cast<uint32_t>(
+                (nSkipped + MaxNetworkSyncFrameNumber) % MaxNetworkSyncFrameNumber
+            );
+        }
+        _currentSendFrame = recvFrame;
+        _isUpdated = false;
+        {
+            const std::unique_lock lock(_connectionMutex);
+            _timeStampSend = time();
+        }
+        currentFrame = _currentSendFrame;
+    }
+    else {
+        currentFrame = iterateFrameCounter();
+    }
+
+    std::string messages;
+    bool isClockRequestPending = false;
+    std::optional<NodeStatistics> statistics;
+    {
+        const std::unique_lock lock(_pendingMutex);
+        std::swap(messages, _pendingMessages);
+        std::swap(isClockRequestPending, _isClockRequestPending);
+        std::swap(statistics, _pendingStatistics);
+    }
+    const uint32_t messagesSize = static_cast<uint32_t>(messages.size());
+    BinaryLogN(
+        "Connection {}: acknowledging frame {} with {} bytes of messages",
+        _id, currentFrame, messagesSize
+    );
 
     std::array<char, HeaderSize> data = {};
     data[0] = Network::DataId;
     std::memcpy(data.data() + 1, &currentFrame, sizeof(currentFrame));
-    std::memcpy(data.data() + 5, &localSyncHeaderSize, sizeof(localSyncHeaderSize));
+    std::memcpy(data.data() + 5, &messagesSize, sizeof(messagesSize));
     std::memset(data.data() + 9, DefaultId, 4);
-    sendData(data.data(), HeaderSize);
+
+    // The clock request is taken as late as possible to not skew the measurement
+    std::array<char, HeaderSize + sizeof(double)> clockRequest = {};
+    if (isClockRequestPending) {
+        clockRequest[0] = TimeRequestId;
+        const uint32_t size = sizeof(double);
+        std::memcpy(clockRequest.data() + 5, &size, sizeof(size));
+        const double sendTime = time();
+        std::memcpy(clockRequest.data() + HeaderSize, &sendTime, sizeof(sendTime));
+    }
+
+    std::array<char, HeaderSize + sizeof(NodeStatistics)> statisticsMessage = {};
+    if (statistics) {
+        statistics->droppedFrames = _droppedFrames;
+        statisticsMessage[0] = StatisticsId;
+        const uint32_t size = sizeof(NodeStatistics);
+        std::memcpy(statisticsMessage.data() + 5, &size, sizeof(size));
+        std::memcpy(
+            statisticsMessage.data() + HeaderSize,
+            &*statistics,
+            sizeof(NodeStatistics)
+        );
+    }
+
+    sendBuffers({
+        { data.data(), static_cast<long>(HeaderSize) },
+        { messages.data(), static_cast<long>(messagesSize) },
+        {
+            clockRequest.data(),
+            isClockRequestPending ? static_cast<long>(clockRequest.size()) : 0
+        },
+        {
+            statisticsMessage.data(),
+            statistics ? static_cast<long>(statisticsMessage.size()) : 0
+        }
+    });
+}
+
+void Network::queueMessage(std::string_view message) {
+    const std::unique_lock lock(_pendingMutex);
+    if (!_pendingMessages.empty()) {
+        _pendingMessages += '\n';
+    }
+    _pendingMessages += message;
+}
+
+void Network::queueStatistics(const NodeStatistics& statistics) {
+    const std::unique_lock lock(_pendingMutex);
+    _pendingStatistics = statistics;
+}
+
+std::optional<Network::NodeStatistics> Network::nodeStatistics() const {
+    const std::unique_lock lock(_statisticsMutex);
+    return _nodeStatistics;
+}
+
+void Network::sendReady(const StartupTimes& times) {
+    std::array<char, HeaderSize + sizeof(StartupTimes)> message = {};
+    message[0] = ReadyId;
+    const uint32_t size = sizeof(StartupTimes);
+    std::memcpy(message.data() + 5, &size, sizeof(size));
+    std::memcpy(message.data() + HeaderSize, &times, sizeof(StartupTimes));
+    sendData(message.data(), static_cast<int>(message.size()));
+}
+
+std::optional<Network::StartupTimes> Network::startupTimes() const {
+    const std::unique_lock lock(_statisticsMutex);
+    return _startupTimes;
+}
+
+void Network::releaseSyncData() {
+    if (!ClusterManager::instance().usePipelinedSync()) {
+        return;
+    }
+
+    {
+        const std::unique_lock lock(_releaseMutex);
+        _isHoldingSyncData = false;
+    }
+    _releaseCond.notify_all();
 }
 
 int Network::sendFrameCurrent() const {
@@ -378,21 +706,168 @@ double Network::loopTime() const {
     return _timeStampTotal;
 }
 
+double Network::sendTime() const {
+    return _sendTime;
+}
+
+void Network::setSendTime(double time) {
+    _sendTime = time;
+}
+
+void Network::updateClock() {
+    // The number of seconds between two clock synchronization requests
+    constexpr double ClockSyncInterval = 0.25;
+
+    const double now = time();
+    if (now - _lastClockRequest < ClockSyncInterval) {
+        return;
+    }
+    _lastClockRequest = now;
+
+    if (!_isServer && _connectionType == ConnectionType::SyncConnection) {
+        const std::unique_lock lock(_pendingMutex);
+        _isClockRequestPending = true;
+        return;
+    }
+
+    std::array<char, HeaderSize> header = {};
+    header[0] = TimeRequestId;
+    const uint32_t size = sizeof(double);
+    std::memcpy(header.data() + 5, &size, sizeof(size));
+    const double sendTime = time();
+    sendData(header.data(), &sendTime, static_cast<int>(size));
+}
+
+void Network::setCritical(bool isCritical) {
+    _isCritical = isCritical;
+}
+
+bool Network::isCritical() const {
+    return _isCritical;
+}
+
+Network::Traffic Network::traffic() const {
+    Traffic traffic;
+    traffic.bytesSent = _bytesSent.load(std::memory_order_relaxed);
+    traffic.messagesSent = _messagesSent.load(std::memory_order_relaxed);
+    traffic.bytesReceived = _bytesReceived.load(std::memory_order_relaxed);
+    traffic.messagesReceived = _messagesReceived.load(std::memory_order_relaxed);
+    return traffic;
+}
+
+Network::TransferStatistics Network::transferStatistics() const {
+    const std::unique_lock lock(_windowMutex);
+    TransferStatistics statistics = _transferStatistics;
+    statistics.packagesInFlight = static_cast<uint32_t>(_packagesInFlight.size());
+    return statistics;
+}
+
+double Network::clockOffset() const {
+    return _clockOffset;
+}
+
+double Network::latency() const {
+    return _latency;
+}
+
+double Network::jitter() const {
+    return _jitter;
+}
+
+void Network::handleTimeRequest(uint32_t dataSize) {
+    const double receiveTime = time();
+    if (dataSize < sizeof(double)) {
+        throw Err(5038, std::format("Malformed time request on connection {}", _id));
+    }
+
+    // The reply contains the request's send time, its receive time, and the reply's
+    // send time in this order
+    std::array<double, 3> times;
+    std::memcpy(&times[0], _recvBuffer.data(), sizeof(double));
+    times[1] = receiveTime;
+
+    std::array<char, HeaderSize> header = {};
+    header[0] = TimeResponseId;
+    const uint32_t size = sizeof(times);
+    std::memcpy(header.data() + 5, &size, sizeof(size));
+    times[2] = time();
+    sendData(header.data(), times.data(), static_cast<int>(size));
+}
+
+void Network::handleTimeResponse(uint32_t dataSize) {
+    const double t4 = time();
+    std::array<double, 3> times;
+    if (dataSize < sizeof(times)) {
+        throw Err(5038, std::format("Malformed time response on connection {}", _id));
+    }
+    std::memcpy(times.data(), _recvBuffer.data(), sizeof(times));
+    const auto [t1, t2, t3] = times;
+
+    ClockSample& sample = _clockSamples[_nextClockSample];
+    sample.offset = ((t2 - t1) + (t3 - t4)) / 2.0;
+    sample.delay = std::max((t4 - t1) - (t3 - t2), 0.0);
+    _nextClockSample = (_nextClockSample + 1) % _clockSamples.size();
+
+    const ClockSample& best = *std::min_element(
+        _clockSamples.cbegin(),
+        _clockSamples.cend(),
+        [](const ClockSample& a, const ClockSample& b) { return a.delay < b.delay; }
+    );
+
+    // The jitter is the root mean square difference of all offsets to the best one
+    double sum = 0.0;
+    int nSamples = 0;
+    for (const ClockSample& s : _clockSamples) {
+        if (s.delay != std::numeric_limits<double>::max()) {
+            sum += (s.offset - best.offset) * (s.offset - best.offset);
+            nSamples++;
+        }
+    }
+
+    _clockOffset = best.offset;
+    _latency = best.delay / 2.0;
+    _jitter = std::sqrt(sum / nSamples);
+}
+
 bool Network::isUpdated() const {
     bool state = false;
     if (_isServer) {
-        state = ClusterManager::instance().firmFrameLockSyncStatus() ?
-            // master sends first -> so on reply they should be equal
-            (_currentRecvFrame == _currentSendFrame) :
+        const ClusterManager& cm = ClusterManager::instance();
+        if (_isJoining) {
+            // The client is still starting up and does not render the frames yet
+            state = true;
+        }
+        else if (!cm.firmFrameLockSyncStatus()) {
             // don't check if loose sync
-            true;
+            state = true;
+        }
+        else if (cm.usePipelinedSync()) {
+            // the clients are allowed to lag one frame behind the master
+            const int previousSendFrame =
+                (_currentSendFrame + MaxNetworkSyncFrameNumber - 1) %
+                MaxNetworkSyncFrameNumber;
+            state = _currentRecvFrame == _currentSendFrame ||
+                    _currentRecvFrame == previousSendFrame;
+        }
+        else {
+            // master sends first -> so on reply they should be equal
+            state = _currentRecvFrame == _currentSendFrame;
+        }
     }
     else {
-        state = ClusterManager::instance().firmFrameLockSyncStatus() ?
-            // clients receive first and then send so the prev should be equal to the send
-            (_previousRecvFrame == _currentSendFrame) :
+        const ClusterManager& cm = ClusterManager::instance();
+        if (!cm.firmFrameLockSyncStatus()) {
             // if loose sync just check if updated
-            _isUpdated.load();
+            state = _isUpdated.load();
+        }
+        else if (cm.syncDeadline() > 0.0) {
+            // a client that fell behind continues with whichever frame is the newest
+            state = _currentRecvFrame != _currentSendFrame;
+        }
+        else {
+            // clients receive first and then send so the prev should be equal to the send
+            state = _previousRecvFrame == _currentSendFrame;
+        }
     }
 
     return (state && _isConnected);
@@ -418,9 +893,45 @@ void Network::setAcknowledgeFunction(std::function<void(int, int)> fn) {
     _acknowledgeCallback = std::move(fn);
 }
 
+void Network::setNackFunction(std::function<void(uint32_t, std::vector<uint16_t>)> fn) {
+    _nackCallback = std::move(fn);
+}
+
+void Network::setChunkDecodeFunction(
+                         std::function<void(void*, int, uint64_t, uint64_t, int, int)> fn)
+{
+    _chunkDecoderCallback = std::move(fn);
+}
+
+void Network::setChunkAcknowledgeFunction(
+                                     std::function<void(int, int, uint64_t, uint64_t)> fn)
+{
+    _chunkAcknowledgeCallback = std::move(fn);
+}
+
+void Network::setMulticast(Multicast* multicast) {
+    _multicast = multicast;
+}
+
+void Network::useSharedMemory(std::string name) {
+    _sharedMemoryName = std::move(name);
+    if (_isServer) {
+        _sharedMemory = std::make_unique<SharedMemory>(_sharedMemoryName, true);
+    }
+}
+
 void Network::setConnectedStatus(bool state) {
-    const std::unique_lock lock(_connectionMutex);
-    _isConnected = state;
+    {
+        const std::unique_lock lock(_connectionMutex);
+        _isConnected = state;
+    }
+
+    // Packages that wait for the window of a lost connection are sent right away, which
+    // fails in the same way as for a connection without a window
+    {
+        const std::unique_lock lock(_windowMutex);
+        _windowCond.notify_all();
+    }
 }
 
 bool Network::isConnected() const {
@@ -445,11 +956,25 @@ void Network::setRecvFrame(int i) {
     _currentRecvFrame = i;
     _isUpdated = true;
     _timeStampTotal = time() - _timeStampSend;
+    if (_isJoining.exchange(false)) {
+        Log::Info(
+            std::format("Connection {} rejoined the frame lock at frame {}", _id, i)
+        );
+    }
 }
 
-void Network::updateBuffer(std::vector<char>& buffer, uint32_t reqSize,
-                           uint32_t& currSize)
-{
+bool Network::isJoining() const {
+    return _isJoining;
+}
+
+void Network::holdSyncData() {
+    if (!_isServer && ClusterManager::instance().usePipelinedSync()) {
+        const std::unique_lock lock(_releaseMutex);
+        _isHoldingSyncData = true;
+    }
+}
+
+void Network::updateBuffer(ReceiveBuffer& buffer, uint32_t reqSize, uint32_t& currSize) {
     // only grow
     if (reqSize <= currSize) {
         return;
@@ -458,6 +983,17 @@ void Network::updateBuffer(std::vector<char>& buffer, uint32_t reqSize,
     const std::unique_lock lock(_connectionMutex);
     buffer.resize(reqSize);
     currSize = reqSize;
+    updateReceiveMemory();
+    if (_connectionType == ConnectionType::SyncConnection) {
+        SharedData::instance().addBufferResize();
+    }
+}
+
+void Network::updateReceiveMemory() {
+    _receiveMemory.set(
+        _recvBuffer.capacity() + _uncompressBuffer.capacity() +
+        _multicastBuffer.capacity() + _sharedMemoryBuffer.capacity()
+    );
 }
 
 int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSize,
@@ -467,10 +1003,14 @@ int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSiz
 
     if (iResult == static_cast<int>(HeaderSize)) {
         _headerId = header[0];
-        if (_headerId == DataId) {
+        if (_headerId == DataId || _headerId == DeltaDataId) {
             std::memcpy(&syncFrame, header + 1, sizeof(syncFrame));
             std::memcpy(&dataSize, header + 5, sizeof(dataSize));
             std::memcpy(&uncompressedDataSize, header + 9, sizeof(uncompressedDataSize));
+            BinaryLogN(
+                "Connection {}: received frame {} with {} bytes ({} uncompressed)",
+                _id, syncFrame, dataSize, uncompressedDataSize
+            );
 
             setRecvFrame(syncFrame);
             if (syncFrame < 0) {
@@ -490,6 +1030,35 @@ int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSiz
                 _uncompressedBufferSize
             );
         }
+        else if (_headerId == MulticastDataId || _headerId == SharedMemoryDataId) {
+            // The block itself is broadcast or in shared memory, the uncompressed size
+            // slot carries the sequence number or the size of the block instead
+            std::memcpy(&syncFrame, header + 1, sizeof(syncFrame));
+            std::memcpy(&uncompressedDataSize, header + 9, sizeof(uncompressedDataSize));
+
+            setRecvFrame(syncFrame);
+            if (syncFrame < 0) {
+                throw Err(
+                    5010,
+                    std::format(
+                        "Error in sync frame {} for connection {}", syncFrame, _id
+                    )
+                );
+            }
+        }
+        else if (_headerId == TimeRequestId || _headerId == TimeResponseId ||
+                 _headerId == StatisticsId || _headerId == ReadyId)
+        {
+            std::memcpy(&dataSize, header + 5, sizeof(dataSize));
+            updateBuffer(_recvBuffer, dataSize, _bufferSize);
+        }
+        else if (_headerId == NackId) {
+            // A NACK contains the indices of the missing fragments of the block with the
+            // sequence number in the uncompressed size slot
+            std::memcpy(&dataSize, header + 5, sizeof(dataSize));
+            std::memcpy(&uncompressedDataSize, header + 9, sizeof(uncompressedDataSize));
+            updateBuffer(_recvBuffer, dataSize, _bufferSize);
+        }
     }
 
     // Get the data/message
@@ -521,9 +1090,16 @@ int Network::readDataTransferMessage(char* header, int32_t& packageId, uint32_t&
                 _uncompressedBufferSize
             );
         }
-        else if (_headerId == Ack && _acknowledgeCallback != nullptr) {
+        else if (_headerId == ChunkId || _headerId == ChunkAckId) {
             std::memcpy(&packageId, header + 1, sizeof(packageId));
-            _acknowledgeCallback(packageId, _id);
+            std::memcpy(&dataSize, header + 5, sizeof(dataSize));
+
+            // The chunks have a fixed maximum size, so the buffer is reused for all of
+            // them rather than being cleared after each one
+            updateBuffer(_recvBuffer, dataSize, _bufferSize);
+        }
+        else if (_headerId == Ack) {
+            handleAck(header);
         }
     }
 
@@ -535,6 +1111,51 @@ int Network::readDataTransferMessage(char* header, int32_t& packageId, uint32_t&
     return iResult;
 }
 
+void Network::decompressMessage(uint32_t dataSize, uint32_t uncompressedDataSize) {
+    ZoneScoped;
+
+    // The uncompressed buffer no longer contains a valid delta reference afterwards
+    _deltaReferenceSize = 0;
+
+    uLongf size = static_cast<uLongf>(uncompressedDataSize);
+    const int res = uncompress(
+        reinterpret_cast<Bytef*>(_uncompressBuffer.data()),
+        &size,
+        reinterpret_cast<const Bytef*>(_recvBuffer.data()),
+        static_cast<uLong>(dataSize)
+    );
+    if (res != Z_OK || size != uncompressedDataSize) {
+        throw Err(
+            5030,
+            std::format("Failed to uncompress message on connection {}: {}", _id, res)
+        );
+    }
+}
+
+void Network::decodeDeltaMessage(uint32_t dataSize, uint32_t uncompressedDataSize) {
+    ZoneScoped;
+
+    // The uncompressed buffer holds the last decoded block that serves as the reference
+    if (dataSize == uncompressedDataSize) {
+        std::memcpy(_uncompressBuffer.data(), _recvBuffer.data(), dataSize);
+        _deltaReferenceSize = dataSize;
+        return;
+    }
+
+    if (_deltaReferenceSize != uncompressedDataSize) {
+        throw Err(
+            5029,
+            std::format("Received delta sync message without keyframe for {}", _id)
+        );
+    }
+    applyDelta(
+        _recvBuffer.data(),
+        dataSize,
+        _uncompressBuffer.data(),
+        uncompressedDataSize
+    );
+}
+
 int Network::readExternalMessage() {
     long iResult = recv(_socket, _recvBuffer.data(), _bufferSize, 0);
 
@@ -556,179 +1177,394 @@ int Network::readExternalMessage() {
 }
 
 void Network::communicationHandler() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, std::format("Comm {}", _id));
+
     if (_shouldTerminate) {
         return;
     }
 
     // listen for client if server
     if (_isServer) {
-        Log::Info(
-            std::format("Waiting for client {} to connect on port {}", _id, _port)
-        );
-
-        _socket = accept(_listenSocket, nullptr, nullptr);
-
+        Log::Info(std::format("Waiting for client {} to connect on port {}", _id, _port));
+        if (!acceptConnection()) {
+            return;
+        }
+    }
+    else if (!connectToServer()) {
+        return;
+    }
+
+    beginConnection();
+
+    // Receive data until the server closes the connection
+    while (receiveMessage()) {}
+
+    endConnection();
+}
+
+bool Network::connectToServer() {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    hints.ai_flags = AI_PASSIVE;
+
+    const std::string portStr = std::to_string(_port);
+    addrinfo* res = nullptr;
+    if (getaddrinfo(_address.c_str(), portStr.c_str(), &hints, &res) != 0) {
+        throw Err(5000, "Failed to parse hints for connection");
+    }
+
+    const std::string& interfaceAddress = socketProfile(type()).interfaceAddress;
+    Log::Info(std::format(
+        "Attempting to connect to server (id: {}, ip: {}, type: {})",
+        _id, _address, typeStr(type())
+    ));
+
+    // The delays are randomized by up to half of their length, so that the clients of a
+    // cluster that were started together do not keep trying at the same time
+    std::minstd_rand random = std::minstd_rand(std::random_device()());
+    std::chrono::milliseconds delay = InitialConnectDelay;
+    const double startTime = time();
+    int attempt = 1;
+    while (!_shouldTerminate) {
+        _socket = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+        if (_socket == INVALID_SOCKET) {
+            freeaddrinfo(res);
+            throw Err(5004, "Failed to init client socket");
+        }
+
+        setOptions(_socket, type());
+        if (!interfaceAddress.empty()) {
+            bindToInterface(_socket, interfaceAddress);
+        }
+
+        const int r = connect(_socket, res->ai_addr, static_cast<int>(res->ai_addrlen));
+        if (r != SOCKET_ERROR) {
+            freeaddrinfo(res);
+            Log::Info(std::format(
+                "Connected to server (id: {}, type: {}) after {} attempts in {:.3f} s",
+                _id, typeStr(type()), attempt, time() - startTime
+            ));
+            return true;
+        }
+
+        const int error = SGCT_ERRNO;
 #ifdef WIN32
-        while (!_shouldTerminate && _socket == INVALID_SOCKET && SGCT_ERRNO == WSAEINTR) {
+        const bool isRefused = error == WSAECONNREFUSED;
 #else // ^^^^ WIN32 // !WIN32 vvvv
-        while (!_shouldTerminate && _socket == INVALID_SOCKET && SGCT_ERRNO == EINTR) {
+        const bool isRefused = error == ECONNREFUSED;
 #endif // WIN32
-            Log::Info(
-                std::format("Re-accept after interrupted system on connection {}", _id)
-            );
-            _socket = accept(_listenSocket, nullptr, nullptr);
+        if (isRefused) {
+            Log::Debug(std::format("Waiting for connection {}...", _id));
+        }
+        else {
+            Log::Debug(std::format("Connect error code: {}", error));
         }
+        closeSocket(_socket);
+        _socket = INVALID_SOCKET;
 
-        if (_socket == INVALID_SOCKET) {
-            Log::Error(
-                std::format("Accept connection {} failed. Error: {}", _id, SGCT_ERRNO)
-            );
+        std::uniform_int_distribution<long long> jitter(0, delay.count() / 2);
+        std::this_thread::sleep_for(
+            delay / 2 + std::chrono::milliseconds(jitter(random))
+        );
+        delay = std::min(delay * 2, MaxConnectDelay);
+        attempt++;
+    }
 
-            if (_updateCallback) {
-                _updateCallback(*this);
-            }
-            return;
+    freeaddrinfo(res);
+    return false;
+}
+
+bool Network::acceptConnection() {
+    _socket = accept(_listenSocket, nullptr, nullptr);
+
+#ifdef WIN32
+    while (!_shouldTerminate && _socket == INVALID_SOCKET && SGCT_ERRNO == WSAEINTR) {
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    while (!_shouldTerminate && _socket == INVALID_SOCKET && SGCT_ERRNO == EINTR) {
+#endif // WIN32
+        Log::Info(
+            std::format("Re-accept after interrupted system on connection {}", _id)
+        );
+        _socket = accept(_listenSocket, nullptr, nullptr);
+    }
+
+    if (_socket == INVALID_SOCKET) {
+        Log::Error(
+            std::format("Accept connection {} failed. Error: {}", _id, SGCT_ERRNO)
+        );
+
+        if (_updateCallback) {
+            _updateCallback(*this);
         }
+        return false;
     }
 
+    return true;
+}
+
+void Network::beginConnection() {
+    // A client that connects again has been restarted and is not waited for until it
+    // acknowledges a frame. It receives the full state with its first frame as the
+    // shared objects are marked as modified and a delta sync keyframe is sent
+    _isJoining = _isServer && _hasConnected;
+    _hasConnected = true;
+    _tunedSendBufferSize = 0;
     setConnectedStatus(true);
+    _needsKeyframe = true;
+    _deltaReferenceSize = 0;
+    _clockSamples = {};
+    _nextClockSample = 0;
+    {
+        // Packages that were in flight when the connection was lost are not going to be
+        // acknowledged anymore
+        const std::unique_lock lock(_windowMutex);
+        _packagesInFlight.clear();
+        _nSentPackages = 0;
+        _transferStatistics = TransferStatistics();
+        _lastAckTime = 0.0;
+    }
+    _nReceivedPackages = 0;
+    _nUnacknowledgedPackages = 0;
+    {
+        const std::unique_lock lock(_statisticsMutex);
+        _startupTimes = std::nullopt;
+    }
     Log::Info(std::format("Connection {} established", _id));
+    BinaryLogN("Connection {}: established", _id);
 
     if (_updateCallback) {
         _updateCallback(*this);
     }
 
     // init buffers
-    std::array<char, HeaderSize> RecvHeader = {};
-    std::memset(RecvHeader.data(), DefaultId, HeaderSize);
+    std::memset(_recvHeader.data(), DefaultId, HeaderSize);
 
     {
         const std::unique_lock lk(_connectionMutex);
         _recvBuffer.resize(_bufferSize);
         _uncompressBuffer.resize(_uncompressedBufferSize);
+        updateReceiveMemory();
+    }
+}
+
+bool Network::receiveMessage() {
+    IsReceivingThread = true;
+
+    // resize buffer request
+    if (type() != ConnectionType::DataTransfer && _requestedSize > _bufferSize) {
+        Log::Info(std::format(
+            "Re-sizing buffer {} -> {}", _bufferSize, _requestedSize.load()
+        ));
+        updateBuffer(_recvBuffer, _requestedSize, _bufferSize);
+    }
+
+    if (!_isServer && type() == ConnectionType::SyncConnection) {
+        // With pipelined sync, the next frame's data might already be waiting, but it
+        // must not overwrite the data that is currently used for rendering
+        std::unique_lock lock(_releaseMutex);
+        _releaseCond.wait(
+            lock,
+            [this]() { return !_isHoldingSyncData || _shouldTerminate; }
+        );
     }
 
-    // Receive data until the server closes the connection
     int iResult = 0;
-    do {
-        // resize buffer request
-        if (type() != ConnectionType::DataTransfer && _requestedSize > _bufferSize) {
-            Log::Info(std::format(
-                "Re-sizing buffer {} -> {}", _bufferSize, _requestedSize.load()
-            ));
-            updateBuffer(_recvBuffer, _requestedSize, _bufferSize);
+    int32_t packageId = -1;
+    uint32_t dataSize = 0;
+    uint32_t uncompressedDataSize = 0;
+
+    _headerId = DefaultId;
+
+    if (type() == ConnectionType::SyncConnection) {
+        int32_t syncFrameNumber = -1;
+        iResult = readSyncMessage(
+            _recvHeader.data(),
+            syncFrameNumber,
+            dataSize,
+            uncompressedDataSize
+        );
+    }
+    else if (type() == ConnectionType::DataTransfer) {
+        iResult = readDataTransferMessage(
+            _recvHeader.data(),
+            packageId,
+            dataSize,
+            uncompressedDataSize
+        );
+    }
+    else {
+        iResult = readExternalMessage();
+    }
+
+    if (iResult > 0) {
+        _bytesReceived.fetch_add(HeaderSize + dataSize, std::memory_order_relaxed);
+        _messagesReceived.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // handle failed receive
+    if (iResult == 0) {
+        setConnectedStatus(false);
+        Log::Info(std::format("TCP connection {} closed", _id));
+        BinaryLogN("Connection {}: closed", _id);
+    }
+    else if (iResult < 0) {
+        setConnectedStatus(false);
+        throw Err(
+            5013,
+            std::format("TCP connection {} receive failed: {}", _id, SGCT_ERRNO)
+        );
+    }
+
+    if (type() == ConnectionType::SyncConnection) {
+        // handle sync disconnect
+        if (isDisconnectPackage(_recvHeader.data())) {
+            setConnectedStatus(false);
+
+            // Terminate client only. The server only resets the connection,
+            // allowing clients to connect.
+            if (!_isServer) {
+                _shouldTerminate = true;
+            }
+
+            Log::Info(std::format("Client {} terminated connection", _id));
+            return false;
         }
-        int32_t packageId = -1;
-        uint32_t dataSize = 0;
-        uint32_t uncompressedDataSize = 0;
+        // handle sync communication
+        if (_headerId == DataId && decoderCallback) {
+            if (dataSize > 0 && uncompressedDataSize > 0) {
+                decompressMessage(dataSize, uncompressedDataSize);
+                decoderCallback(_uncompressBuffer.data(), uncompressedDataSize);
+            }
+            else if (dataSize > 0) {
+                decoderCallback(_recvBuffer.data(), dataSize);
+            }
 
-        _headerId = DefaultId;
+            holdSyncData();
+            NetworkManager::cond.notify_all();
+        }
+        else if (_headerId == DeltaDataId && decoderCallback) {
+            if (uncompressedDataSize > 0) {
+                decodeDeltaMessage(dataSize, uncompressedDataSize);
+                decoderCallback(_uncompressBuffer.data(), uncompressedDataSize);
+            }
 
-        if (type() == ConnectionType::SyncConnection) {
-            int32_t syncFrameNumber = -1;
-            iResult = readSyncMessage(
-                RecvHeader.data(),
-                syncFrameNumber,
-                dataSize,
-                uncompressedDataSize
-            );
+            holdSyncData();
+            NetworkManager::cond.notify_all();
         }
-        else if (type() == ConnectionType::DataTransfer) {
-            iResult = readDataTransferMessage(
-                RecvHeader.data(),
-                packageId,
-                dataSize,
-                uncompressedDataSize
-            );
+        else if (_headerId == MulticastDataId && decoderCallback && _multicast) {
+            receiveMulticastBlock(uncompressedDataSize);
+            holdSyncData();
+            NetworkManager::cond.notify_all();
         }
-        else {
-            iResult = readExternalMessage();
+        else if (_headerId == SharedMemoryDataId && decoderCallback) {
+            receiveSharedMemoryBlock(_currentRecvFrame, uncompressedDataSize);
+            holdSyncData();
+            NetworkManager::cond.notify_all();
         }
-
-        // handle failed receive
-        if (iResult == 0) {
-            setConnectedStatus(false);
-            Log::Info(std::format("TCP connection {} closed", _id));
+        else if (_headerId == TimeRequestId) {
+            handleTimeRequest(dataSize);
         }
-        else if (iResult < 0) {
-            setConnectedStatus(false);
-            throw Err(
-                5013,
-                std::format("TCP connection {} receive failed: {}", _id, SGCT_ERRNO)
+        else if (_headerId == TimeResponseId) {
+            handleTimeResponse(dataSize);
+        }
+        else if (_headerId == StatisticsId && dataSize >= sizeof(NodeStatistics)) {
+            NodeStatistics statistics;
+            std::memcpy(&statistics, _recvBuffer.data(), sizeof(NodeStatistics));
+            const std::unique_lock lock(_statisticsMutex);
+            _nodeStatistics = statistics;
+        }
+        else if (_headerId == ReadyId && dataSize >= sizeof(StartupTimes)) {
+            StartupTimes times;
+            std::memcpy(&times, _recvBuffer.data(), sizeof(StartupTimes));
+            {
+                const std::unique_lock lock(_statisticsMutex);
+                _startupTimes = times;
+            }
+            NetworkManager::cond.notify_all();
+        }
+        else if (_headerId == NackId && _nackCallback) {
+            std::vector<uint16_t> fragments(dataSize / sizeof(uint16_t));
+            std::memcpy(
+                fragments.data(),
+                _recvBuffer.data(),
+                fragments.size() * sizeof(uint16_t)
             );
+            _nackCallback(uncompressedDataSize, std::move(fragments));
+        }
+        else if (_headerId == ConnectedId && _connectedCallback) {
+            _connectedCallback();
+            NetworkManager::cond.notify_all();
+        }
+    }
+    // handle data transfer communication
+    else if (type() == ConnectionType::DataTransfer) {
+        // Disconnect if requested
+        if (isDisconnectPackage(_recvHeader.data())) {
+            setConnectedStatus(false);
+            Log::Info(std::format("File connection {} terminated", _id));
         }
+        //  Handle communication
+        else {
+            if (_headerId == DataId) {
+                if (_packageDecoderCallback && dataSize > 0 && uncompressedDataSize > 0) {
+                    decompressMessage(dataSize, uncompressedDataSize);
+                    _packageDecoderCallback(
+                        _uncompressBuffer.data(),
+                        uncompressedDataSize,
+                        packageId,
+                        _id
+                    );
+                }
+                else if (_packageDecoderCallback && dataSize > 0) {
+                    _packageDecoderCallback(
+                        _recvBuffer.data(),
+                        dataSize,
+                        packageId,
+                        _id
+                    );
+                }
 
-        if (type() == ConnectionType::SyncConnection) {
-            // handle sync disconnect
-            if (isDisconnectPackage(RecvHeader.data())) {
-                setConnectedStatus(false);
+                // Every package is counted by the sender's window, so the empty ones are
+                // acknowledged as well
+                acknowledgePackage(packageId);
 
-                // Terminate client only. The server only resets the connection,
-                // allowing clients to connect.
-                if (!_isServer) {
-                    _shouldTerminate = true;
-                }
+                {
+                    // Clear the buffers
+                    const std::unique_lock lk(_connectionMutex);
 
-                Log::Info(std::format("Client {} terminated connection", _id));
-                break;
-            }
-            // handle sync communication
-            if (_headerId == DataId && decoderCallback) {
-                if (dataSize > 0) {
-                    decoderCallback(_recvBuffer.data(), dataSize);
-                }
+                    _recvBuffer.clear();
+                    _uncompressBuffer.clear();
 
-                NetworkManager::cond.notify_all();
+                    _bufferSize = 0;
+                    _uncompressedBufferSize = 0;
+                }
+            }
+            else if (_headerId == ChunkId) {
+                handleChunk(packageId, dataSize);
+            }
+            else if (_headerId == ChunkAckId) {
+                handleChunkAck(packageId, dataSize);
             }
             else if (_headerId == ConnectedId && _connectedCallback) {
                 _connectedCallback();
                 NetworkManager::cond.notify_all();
             }
         }
-        // handle data transfer communication
-        else if (type() == ConnectionType::DataTransfer) {
-            // Disconnect if requested
-            if (isDisconnectPackage(RecvHeader.data())) {
-                setConnectedStatus(false);
-                Log::Info(std::format("File connection {} terminated", _id));
-            }
-            //  Handle communication
-            else {
-                if (_headerId == DataId && _packageDecoderCallback && dataSize > 0) {
-                    _packageDecoderCallback(_recvBuffer.data(), dataSize, packageId, _id);
-
-                    // send acknowledge
-                    uint32_t pLength = 0;
-                    std::array<char, HeaderSize> sendBuffer = {};
-                    sendBuffer[0] = Ack;
-                    std::memcpy(sendBuffer.data() + 1, &packageId, sizeof(packageId));
-                    std::memcpy(sendBuffer.data() + 5, &pLength, sizeof(pLength));
-                    sendData(sendBuffer.data(), HeaderSize);
-
-                    {
-                        // Clear the buffers
-                        const std::unique_lock lk(_connectionMutex);
-
-                        _recvBuffer.clear();
-                        _uncompressBuffer.clear();
-
-                        _bufferSize = 0;
-                        _uncompressedBufferSize = 0;
-                    }
-                }
-                else if (_headerId == ConnectedId && _connectedCallback) {
-                    _connectedCallback();
-                    NetworkManager::cond.notify_all();
-                }
-            }
-        }
-    } while (iResult > 0 || _isConnected);
+    }
 
+    return iResult > 0 || _isConnected;
+}
+
+void Network::endConnection() {
     _recvBuffer.clear();
     _uncompressBuffer.clear();
 
     // Close socket; contains mutex
     closeSocket(_socket);
+    _socket = INVALID_SOCKET;
 
     if (_updateCallback) {
         _updateCallback(*this);
@@ -740,6 +1576,8 @@ void Network::communicationHandler() {
 void Network::sendData(const void* data, int length) const {
     ZoneScoped;
 
+    // The communication thread sends acknowledgements and NACKs on the same socket
+    const std::unique_lock lock(_sendMutex);
     long sendSize = length;
 
     while (sendSize > 0) {
@@ -755,6 +1593,460 @@ void Network::sendData(const void* data, int length) const {
         }
         sendSize -= sentLen;
     }
+    _bytesSent.fetch_add(length, std::memory_order_relaxed);
+    _messagesSent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Network::sendData(const void* header, const void* data, int length) const {
+    sendBuffers({
+        { reinterpret_cast<const char*>(header), static_cast<long>(HeaderSize) },
+        { reinterpret_cast<const char*>(data), static_cast<long>(length) }
+    });
+}
+
+void Network::sendPackage(const void* header, const void* data, int length) const {
+    ZoneScoped;
+
+    int32_t packageId = -1;
+    std::memcpy(
+        &packageId,
+        reinterpret_cast<const char*>(header) + 1,
+        sizeof(packageId)
+    );
+    const ClusterManager& cm = ClusterManager::instance();
+    const size_t window = static_cast<size_t>(cm.transferWindow());
+
+    const std::unique_lock packageLock(_packageMutex);
+    {
+        std::unique_lock lock(_windowMutex);
+        if (window > 0 && !IsReceivingThread) {
+            _windowCond.wait(
+                lock,
+                [&]() {
+                    return _packagesInFlight.size() < window || !_isConnected ||
+                        _shouldTerminate;
+                }
+            );
+        }
+        _nSentPackages++;
+        _packagesInFlight.push_back({
+            .sequence = _nSentPackages,
+            .packageId = packageId,
+            .size = static_cast<uint32_t>(HeaderSize + length),
+            .sendTime = time()
+        });
+        _transferStatistics.bytesInFlight += HeaderSize + length;
+    }
+    sendData(header, data, length);
+}
+
+void Network::sendBuffers(
+                    std::initializer_list<std::pair<const char*, long>> buffers) const
+{
+    ZoneScoped;
+
+    constexpr size_t MaxBuffers = 4;
+    if (buffers.size() > MaxBuffers) {
+        throw std::logic_error("Too many buffers for a scatter-gather send");
+    }
+
+    const std::unique_lock lock(_sendMutex);
+
+    long totalSize = 0;
+    for (const std::pair<const char*, long>& buffer : buffers) {
+        totalSize += buffer.second;
+    }
+
+    long sentSize = 0;
+    while (sentSize < totalSize) {
+        // Only the parts of the buffers that have not been sent yet
+        long skip = sentSize;
+#ifdef WIN32
+        std::array<WSABUF, MaxBuffers> parts;
+        DWORD nParts = 0;
+        for (const auto& [ptr, size] : buffers) {
+            if (skip >= size) {
+                skip -= size;
+                continue;
+            }
+            parts[nParts].buf = const_cast<char*>(ptr + skip);
+            parts[nParts].len = static_cast<ULONG>(size - skip);
+            nParts++;
+            skip = 0;
+        }
+        DWORD sent = 0;
+        const int res =
+            WSASend(_socket, parts.data(), nParts, &sent, 0, nullptr, nullptr);
+        const long sentLen = res == SOCKET_ERROR ? SOCKET_ERROR : static_cast<long>(sent);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        std::array<iovec, MaxBuffers> parts;
+        size_t nParts = 0;
+        for (const auto& [ptr, size] : buffers) {
+            if (skip >= size) {
+                skip -= size;
+                continue;
+            }
+            parts[nParts].iov_base = const_cast<char*>(ptr + skip);
+            parts[nParts].iov_len = static_cast<size_t>(size - skip);
+            nParts++;
+            skip = 0;
+        }
+        msghdr message = {};
+        message.msg_iov = parts.data();
+        message.msg_iovlen = nParts;
+        const long sentLen = sendmsg(_socket, &message, 0);
+#endif // WIN32
+        if (sentLen == SOCKET_ERROR) {
+            throw Err(5014, std::format("Send data failed: {}", SGCT_ERRNO));
+        }
+        sentSize += sentLen;
+    }
+    _bytesSent.fetch_add(totalSize, std::memory_order_relaxed);
+    _messagesSent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Network::sendDeltaData(const unsigned char* header, const unsigned char* data,
+                            int length, int keyframeInterval)
+{
+    ZoneScoped;
+
+    const char* payload = reinterpret_cast<const char*>(data);
+    const uint32_t size = static_cast<uint32_t>(length);
+
+    const bool isKeyframe = _needsKeyframe || _deltaReference.size() != size ||
+        _framesSinceKeyframe + 1 >= keyframeInterval ||
+        !encodeDelta(payload, _deltaReference.data(), size, _deltaBuffer);
+
+    _deltaReference.assign(payload, payload + size);
+    if (isKeyframe) {
+        _framesSinceKeyframe = 0;
+        _needsKeyframe = false;
+    }
+    else {
+        _framesSinceKeyframe++;
+    }
+
+    // A keyframe carries the full block and is identified by having the same data size
+    // and uncompressed size
+    const uint32_t deltaSize =
+        isKeyframe ? size : static_cast<uint32_t>(_deltaBuffer.size() - HeaderSize);
+    _deltaBuffer.resize(std::max<size_t>(_deltaBuffer.size(), HeaderSize));
+    std::memcpy(_deltaBuffer.data(), header, HeaderSize);
+    _deltaBuffer[0] = DeltaDataId;
+    std::memcpy(_deltaBuffer.data() + 5, &deltaSize, sizeof(deltaSize));
+    std::memcpy(_deltaBuffer.data() + 9, &size, sizeof(size));
+
+    _sendMemory.set(_deltaReference.capacity() + _deltaBuffer.capacity());
+
+    if (isKeyframe) {
+        sendData(_deltaBuffer.data(), payload, length);
+    }
+    else {
+        sendData(_deltaBuffer.data(), static_cast<int>(_deltaBuffer.size()));
+    }
+}
+
+void Network::sendMulticastHeader(int frame, uint32_t sequence) const {
+    std::array<char, HeaderSize> header = {};
+    header[0] = MulticastDataId;
+    std::memcpy(header.data() + 1, &frame, sizeof(frame));
+    std::memset(header.data() + 5, DefaultId, sizeof(uint32_t));
+    std::memcpy(header.data() + 9, &sequence, sizeof(sequence));
+    sendData(header.data(), HeaderSize);
+}
+
+bool Network::sendSharedMemoryData(int frame, const void* data, uint32_t length) {
+    ZoneScoped;
+
+    if (!_sharedMemory ||
+        !_sharedMemory->write(frame, reinterpret_cast<const char*>(data), length))
+    {
+        return false;
+    }
+
+    // A delta sent afterwards on the socket must not refer to an older block
+    _needsKeyframe = true;
+
+    std::array<char, HeaderSize> header = {};
+    header[0] = SharedMemoryDataId;
+    std::memcpy(header.data() + 1, &frame, sizeof(frame));
+    std::memset(header.data() + 5, DefaultId, sizeof(uint32_t));
+    std::memcpy(header.data() + 9, &length, sizeof(length));
+    sendData(header.data(), HeaderSize);
+    return true;
+}
+
+void Network::sendChunk(int packageId, uint64_t offset, uint64_t totalSize,
+                        const void* data, int length) const
+{
+    const std::array<uint64_t, 2> range = { offset, totalSize };
+    const uint32_t dataSize = static_cast<uint32_t>(sizeof(range) + length);
+
+    std::array<char, HeaderSize> header = {};
+    header[0] = ChunkId;
+    std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(header.data() + 5, &dataSize, sizeof(dataSize));
+    std::memset(header.data() + 9, DefaultId, sizeof(uint32_t));
+
+    sendBuffers({
+        { header.data(), static_cast<long>(HeaderSize) },
+        { reinterpret_cast<const char*>(range.data()), static_cast<long>(sizeof(range)) },
+        { reinterpret_cast<const char*>(data), static_cast<long>(length) }
+    });
+}
+
+uint64_t Network::acknowledgedChunkBytes(int packageId) const {
+    return _chunkAckPackageId == packageId ? _chunkAckBytes.load() : 0;
+}
+
+void Network::tuneSendBuffer(double bytesPerSecond, double roundTripTime) const {
+    // Twice the bandwidth-delay product keeps the link busy while the acknowledgements
+    // of the previous round trip are on their way back
+    constexpr int MinimumSize = 64 * 1024;
+    constexpr double MaximumSize = 64.0 * 1024.0 * 1024.0;
+    const double product = std::min(2.0 * bytesPerSecond * roundTripTime, MaximumSize);
+    const int size = std::max(MinimumSize, static_cast<int>(product));
+
+    const int current = _tunedSendBufferSize;
+    if (current > 0 && std::abs(size - current) < current / 4) {
+        return;
+    }
+    setBufferSize(_socket, SO_SNDBUF, size);
+    _tunedSendBufferSize = size;
+    Log::Debug(std::format("Tuned send buffer of connection {} to {} bytes", _id, size));
+}
+
+void Network::handleChunk(int32_t packageId, uint32_t dataSize) {
+    ZoneScoped;
+
+    std::array<uint64_t, 2> range;
+    if (dataSize < sizeof(range)) {
+        throw Err(
+            5037,
+            std::format("Malformed chunk of package {} on connection {}", packageId, _id)
+        );
+    }
+    std::memcpy(range.data(), _recvBuffer.data(), sizeof(range));
+    const int length = static_cast<int>(dataSize - sizeof(range));
+
+    if (_chunkDecoderCallback) {
+        _chunkDecoderCallback(
+            _recvBuffer.data() + sizeof(range),
+            length,
+            range[0],
+            range[1],
+            packageId,
+            _id
+        );
+    }
+
+    // The acknowledgement contains the end of the chunk so that the sender knows where
+    // to resume in case the connection is lost
+    const std::array<uint64_t, 2> ack = { range[0] + length, range[1] };
+    const uint32_t ackSize = static_cast<uint32_t>(sizeof(ack));
+    std::array<char, HeaderSize> header = {};
+    header[0] = ChunkAckId;
+    std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(header.data() + 5, &ackSize, sizeof(ackSize));
+    std::memset(header.data() + 9, DefaultId, sizeof(uint32_t));
+    sendData(header.data(), ack.data(), static_cast<int>(ackSize));
+}
+
+void Network::handleChunkAck(int32_t packageId, uint32_t dataSize) {
+    std::array<uint64_t, 2> ack;
+    if (dataSize < sizeof(ack)) {
+        throw Err(
+            5037,
+            std::format("Malformed chunk of package {} on connection {}", packageId, _id)
+        );
+    }
+    std::memcpy(ack.data(), _recvBuffer.data(), sizeof(ack));
+
+    _chunkAckBytes = ack[0];
+    _chunkAckPackageId = packageId;
+    if (_chunkAcknowledgeCallback) {
+        _chunkAcknowledgeCallback(packageId, _id, ack[0], ack[1]);
+    }
+}
+
+void Network::acknowledgePackage(int32_t packageId) {
+    _nReceivedPackages++;
+    _nUnacknowledgedPackages++;
+
+    // If the next package is already waiting, its acknowledgement covers this one, too
+#ifdef WIN32
+    u_long nPending = 0;
+    ioctlsocket(_socket, FIONREAD, &nPending);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    int nPending = 0;
+    ioctl(_socket, FIONREAD, &nPending);
+#endif // WIN32
+    const bool isPending = nPending >= static_cast<int>(HeaderSize);
+    if (isPending && _nUnacknowledgedPackages < MaxUnacknowledgedPackages) {
+        return;
+    }
+
+    // The acknowledgement contains the number of packages that have been received so
+    // far, which acknowledges all packages up to and including that one
+    const uint32_t pLength = 0;
+    std::array<char, HeaderSize> header = {};
+    header[0] = Ack;
+    std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(header.data() + 5, &pLength, sizeof(pLength));
+    std::memcpy(header.data() + 9, &_nReceivedPackages, sizeof(_nReceivedPackages));
+    sendData(header.data(), HeaderSize);
+    _nUnacknowledgedPackages = 0;
+}
+
+void Network::handleAck(const char* header) {
+    uint32_t nReceived = 0;
+    std::memcpy(&nReceived, header + 9, sizeof(nReceived));
+    const double now = time();
+
+    _acknowledgedPackages.clear();
+    {
+        const std::unique_lock lock(_windowMutex);
+        uint64_t nBytes = 0;
+        double sendTime = now;
+        // The counters wrap around, so the sequences are compared by their difference
+        while (!_packagesInFlight.empty() &&
+               static_cast<int32_t>(nReceived - _packagesInFlight.front().sequence) >= 0)
+        {
+            const PackageInFlight& package = _packagesInFlight.front();
+            _acknowledgedPackages.push_back(package.packageId);
+            nBytes += package.size;
+            sendTime = package.sendTime;
+            _packagesInFlight.pop_front();
+        }
+
+        if (!_acknowledgedPackages.empty()) {
+            TransferStatistics& s = _transferStatistics;
+            s.bytesInFlight -= nBytes;
+            s.packagesAcknowledged += _acknowledgedPackages.size();
+
+            // The latency is smoothed like the round-trip time estimate of TCP, and the
+            // throughput is averaged over about a second
+            const double latency = now - sendTime;
+            s.latency = s.latency > 0.0 ? s.latency + (latency - s.latency) / 8 : latency;
+            const double elapsed = now - _lastAckTime;
+            if (_lastAckTime > 0.0 && elapsed > 0.0) {
+                const double weight = std::min(elapsed, 1.0);
+                s.throughput += (nBytes / elapsed - s.throughput) * weight;
+            }
+            _lastAckTime = now;
+        }
+    }
+    _windowCond.notify_all();
+
+    if (_acknowledgeCallback) {
+        for (const int32_t packageId : _acknowledgedPackages) {
+            _acknowledgeCallback(packageId, _id);
+        }
+    }
+}
+
+void Network::sendAsync(std::function<void()> job) {
+    {
+        const std::unique_lock lock(_sendQueueMutex);
+        _sendQueue.push_back(std::move(job));
+        if (!_sendThread) {
+            _sendThread = std::make_unique<std::thread>([this]() { sendHandler(); });
+        }
+    }
+    _sendQueueCond.notify_one();
+}
+
+void Network::sendHandler() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, std::format("Send {}", _id));
+
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(_sendQueueMutex);
+            _sendQueueCond.wait(
+                lock,
+                [this]() { return _shouldTerminate || !_sendQueue.empty(); }
+            );
+            if (_sendQueue.empty()) {
+                // only reached when terminating and all jobs are done
+                break;
+            }
+            job = std::move(_sendQueue.front());
+            _sendQueue.pop_front();
+        }
+
+        try {
+            job();
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
+    }
+}
+
+void Network::receiveMulticastBlock(uint32_t sequence) {
+    ZoneScoped;
+
+    std::vector<uint16_t> missing;
+    for (int attempt = 0; attempt < MaxNackAttempts; attempt++) {
+        if (_multicast->waitForBlock(sequence, _multicastBuffer, missing)) {
+            updateReceiveMemory();
+            decoderCallback(
+                _multicastBuffer.data(),
+                static_cast<int>(_multicastBuffer.size())
+            );
+            return;
+        }
+        if (_shouldTerminate) {
+            return;
+        }
+
+        // Request the missing fragments, or the entire block if nothing has arrived
+        const uint32_t size = static_cast<uint32_t>(missing.size() * sizeof(uint16_t));
+        std::vector<char> nack(HeaderSize + size);
+        nack[0] = NackId;
+        std::memset(nack.data() + 1, DefaultId, sizeof(int32_t));
+        std::memcpy(nack.data() + 5, &size, sizeof(size));
+        std::memcpy(nack.data() + 9, &sequence, sizeof(sequence));
+        if (size > 0) {
+            std::memcpy(nack.data() + HeaderSize, missing.data(), size);
+        }
+        sendData(nack.data(), static_cast<int>(nack.size()));
+    }
+
+    _multicast->discard(sequence);
+    Log::Warning(std::format(
+        "Skipping shared data block {} on connection {} after {} retransmission requests",
+        sequence, _id, MaxNackAttempts
+    ));
+}
+
+void Network::receiveSharedMemoryBlock(int32_t frame, uint32_t size) {
+    ZoneScoped;
+
+    // The segment is only opened now, as the server might have been started after us
+    if (!_sharedMemory) {
+        _sharedMemory = std::make_unique<SharedMemory>(_sharedMemoryName, false);
+    }
+
+    if (!_sharedMemory->read(frame, _sharedMemoryBuffer) ||
+        _sharedMemoryBuffer.size() != size)
+    {
+        Log::Warning(std::format(
+            "Skipping shared data block of frame {} on connection {} as it has been "
+            "overwritten in shared memory", frame, _id
+        ));
+        return;
+    }
+
+    updateReceiveMemory();
+
+    // The next delta on the socket is always a keyframe, so the reference is outdated
+    _deltaReferenceSize = 0;
+    decoderCallback(
+        _sharedMemoryBuffer.data(),
+        static_cast<int>(_sharedMemoryBuffer.size())
+    );
 }
 
 void Network::closeNetwork(bool forced) {
@@ -765,11 +2057,24 @@ void Network::closeNetwork(bool forced) {
     _connectedCallback = nullptr;
     _acknowledgeCallback = nullptr;
     _packageDecoderCallback = nullptr;
+    _nackCallback = nullptr;
+    _chunkDecoderCallback = nullptr;
+    _chunkAcknowledgeCallback = nullptr;
 
     // release conditions
     NetworkManager::cond.notify_all();
     _startConnectionCond.notify_all();
 
+    {
+        const std::unique_lock lock(_sendQueueMutex);
+        _shouldTerminate = true;
+    }
+    _sendQueueCond.notify_all();
+    if (_sendThread) {
+        _sendThread->join();
+    }
+    _sendThread = nullptr;
+
     // blocking sockets -> cannot wait for thread so just kill it brutally
 
     if (_commThread && !forced) {
@@ -806,6 +2111,17 @@ void Network::initShutdown() {
     _isConnected = false;
     _shouldTerminate = true;
 
+    {
+        const std::unique_lock lock(_windowMutex);
+        _windowCond.notify_all();
+    }
+
+    {
+        const std::unique_lock lock(_releaseMutex);
+        _isHoldingSyncData = false;
+    }
+    _releaseCond.notify_all();
+
     // wake up the connection handler thread (in order to finish)
     if (_isServer) {
         _startConnectionCond.notify_all();
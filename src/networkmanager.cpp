@@ -20,13 +20,23 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
-#include <sgct/mutexes.h>
+#include <sgct/logforwarder.h>
+#include <sgct/multicast.h>
+#include <sgct/networkreactor.h>
 #include <sgct/node.h>
 #include <sgct/profiling.h>
+#ifdef SGCT_HAS_RDMA
+#include <sgct/rdmaconnection.h>
+#endif // SGCT_HAS_RDMA
 #include <sgct/shareddata.h>
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <exception>
+#include <latch>
 #include <numeric>
+#include <thread>
+#include <zlib.h>
 
 #ifdef WIN32
     #include <ws2tcpip.h>
@@ -44,28 +54,64 @@
 
 namespace {
 
-    void prepareTransferData(const void* data, std::vector<char>& buffer, int& length,
-                             int packageId)
-    {
-        int messageLength = length;
-
-        length += static_cast<int>(sgct::Network::HeaderSize);
-        buffer.resize(length);
+    // Compresses `size` bytes of `data` into `buffer` after the space reserved for the
+    // header and fills in the data size and uncompressed size of the header. Returns
+    // `false` if the compressed data would not be smaller than the uncompressed data
+    bool compressData(const void* data, int size, std::vector<char>& buffer, int level) {
+        ZoneScoped;
+
+        uLongf compressedSize = compressBound(static_cast<uLong>(size));
+        buffer.resize(sgct::Network::HeaderSize + compressedSize);
+        const int res = compress2(
+            reinterpret_cast<Bytef*>(buffer.data() + sgct::Network::HeaderSize),
+            &compressedSize,
+            reinterpret_cast<const Bytef*>(data),
+            static_cast<uLong>(size),
+            level
+        );
+        if (res != Z_OK || compressedSize >= static_cast<uLongf>(size)) {
+            buffer.clear();
+            return false;
+        }
 
+        buffer.resize(sgct::Network::HeaderSize + compressedSize);
         buffer[0] = sgct::Network::DataId;
-        std::memcpy(buffer.data() + 1, &packageId, sizeof(packageId));
+        std::memset(buffer.data() + 1, sgct::Network::DefaultId, sizeof(int));
 
-        // set uncompressed size to DefaultId since compression is not used
-        std::memset(buffer.data() + 9, sgct::Network::DefaultId, sizeof(int));
+        const uint32_t dataSize = static_cast<uint32_t>(compressedSize);
+        std::memcpy(buffer.data() + 5, &dataSize, sizeof(dataSize));
+        const uint32_t uncompressedSize = static_cast<uint32_t>(size);
+        std::memcpy(buffer.data() + 9, &uncompressedSize, sizeof(uncompressedSize));
+        return true;
+    }
 
-        // add data to buffer
-        std::memcpy(
-            buffer.data() + sgct::Network::HeaderSize,
-            data,
-            length - sgct::Network::HeaderSize
-        );
+    // Compresses the transfer data into `buffer` including its header if compression is
+    // enabled and worthwhile. Returns `false` if the data should be sent uncompressed
+    bool compressTransferData(const void* data, int length, int packageId,
+                              std::vector<char>& buffer)
+    {
+        const sgct::ClusterManager& cm = sgct::ClusterManager::instance();
+        if (cm.useCompression() && length >= cm.compressionThreshold() &&
+            compressData(data, length, buffer, cm.compressionLevel()))
+        {
+            std::memcpy(buffer.data() + 1, &packageId, sizeof(packageId));
+            return true;
+        }
+        return false;
+    }
 
-        std::memcpy(buffer.data() + 5, &messageLength, sizeof(messageLength));
+    // Creates the header for uncompressed transfer data. The payload itself is sent
+    // directly from the caller's memory after this header
+    std::array<char, sgct::Network::HeaderSize> transferHeader(int length, int packageId)
+    {
+        std::array<char, sgct::Network::HeaderSize> header = {};
+        header[0] = sgct::Network::DataId;
+        std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+        std::memcpy(header.data() + 5, &length, sizeof(length));
+
+        // set uncompressed size to DefaultId since the data is not compressed
+        std::memset(header.data() + 9, sgct::Network::DefaultId, sizeof(int));
+        return header;
     }
 
 } // namespace
@@ -83,7 +129,11 @@ NetworkManager& NetworkManager::instance() {
 void NetworkManager::create(NetworkMode nm,
                             std::function<void(void*, int, int, int)> dataTransferDecode,
                             std::function<void(bool, int)> dataTransferStatus,
-                            std::function<void(int, int)> dataTransferAcknowledge)
+                            std::function<void(int, int)> dataTransferAcknowledge,
+                            std::function<void(void*, int, uint64_t, uint64_t, int, int)>
+                                dataTransferChunk,
+                            std::function<void(int, int, uint64_t, uint64_t)>
+                                dataTransferProgress)
 {
     ZoneScoped;
 
@@ -94,7 +144,9 @@ void NetworkManager::create(NetworkMode nm,
         nm,
         std::move(dataTransferDecode),
         std::move(dataTransferStatus),
-        std::move(dataTransferAcknowledge)
+        std::move(dataTransferAcknowledge),
+        std::move(dataTransferChunk),
+        std::move(dataTransferProgress)
     );
 }
 
@@ -106,14 +158,23 @@ void NetworkManager::destroy() {
 NetworkManager::NetworkManager(NetworkMode nm,
                              std::function<void(void*, int, int, int)> dataTransferDecode,
                                         std::function<void(bool, int)> dataTransferStatus,
-                                    std::function<void(int, int)> dataTransferAcknowledge)
+                                    std::function<void(int, int)> dataTransferAcknowledge,
+                            std::function<void(void*, int, uint64_t, uint64_t, int, int)>
+                                dataTransferChunk,
+                            std::function<void(int, int, uint64_t, uint64_t)>
+                                dataTransferProgress)
     : _dataTransferDecodeFn(std::move(dataTransferDecode))
     , _dataTransferStatusFn(std::move(dataTransferStatus))
     , _dataTransferAcknowledgeFn(std::move(dataTransferAcknowledge))
+    , _dataTransferChunkFn(std::move(dataTransferChunk))
+    , _dataTransferProgressFn(std::move(dataTransferProgress))
     , _mode(nm)
 {
     ZoneScoped;
 
+    // The other threads can ask for the connections as soon as the manager exists
+    publishConnections();
+
     Log::Debug("Initiating network API");
 #ifdef WIN32
     WORD version = MAKEWORD(2, 2);
@@ -224,10 +285,24 @@ NetworkManager::~NetworkManager() {
     _isRunning = false;
     cond.notify_all();
 
+    Log::instance().setForwardCallback(nullptr);
+
     // signal to terminate
     for (const std::unique_ptr<Network>& connection : _networkConnections) {
         connection->initShutdown();
     }
+    if (_multicast) {
+        _multicast->close();
+    }
+    if (_syncReactor) {
+        _syncReactor->stop();
+    }
+    if (_dataTransferReactor) {
+        _dataTransferReactor->stop();
+    }
+#ifdef SGCT_HAS_RDMA
+    _rdmaConnections.clear();
+#endif // SGCT_HAS_RDMA
 
     // wait for all nodes callbacks to run
     {
@@ -239,8 +314,14 @@ NetworkManager::~NetworkManager() {
     }
 
     _networkConnections.clear();
-    _syncConnections.clear();
-    _dataTransferConnections.clear();
+    publishConnections();
+    _connectionLists.erase(_connectionLists.begin(), _connectionLists.end() - 1);
+    _relayedNodes.clear();
+    _nodeTransferConnections.clear();
+    _transferSyncConnections.clear();
+    _multicast = nullptr;
+    _syncReactor = nullptr;
+    _dataTransferReactor = nullptr;
 
 #ifdef WIN32
     WSACleanup();
@@ -309,35 +390,90 @@ void NetworkManager::initialize() {
             }
         }
 
+        if (!cm.multicastAddress().empty()) {
+            _multicast = std::make_unique<Multicast>(
+                cm.multicastAddress(),
+                cm.multicastPort(),
+                _isServer
+            );
+        }
+
+        // Nodes only run on the same computer in the local network modes
+        _useSharedMemory =
+            _mode != NetworkMode::Remote && cm.useSharedMemory() && !_multicast;
+
+        if (cm.rdmaBufferSize() > 0) {
+            _rdmaBuffer.resize(static_cast<size_t>(cm.rdmaBufferSize()));
+#ifndef SGCT_HAS_RDMA
+            Log::Warning("RDMA is not supported, RDMA transfers are sent through TCP");
+#endif // SGCT_HAS_RDMA
+        }
+
+        if (cm.useEventDrivenNetwork()) {
+            _syncReactor = std::make_unique<NetworkReactor>();
+            _dataTransferReactor = std::make_unique<NetworkReactor>();
+        }
+
         // if client
         if (!_isServer) {
             addConnection(cm.thisNode().syncPort(), remoteAddress);
             _networkConnections.back()->setDecodeFunction(
-                std::bind_front(&SharedData::decode, SharedData::instance())
+                std::bind_front(&SharedData::decode, &SharedData::instance())
             );
+            _networkConnections.back()->setMulticast(_multicast.get());
+            if (_useSharedMemory) {
+                _networkConnections.back()->useSharedMemory(
+                    std::format("sgct-{}", cm.thisNode().syncPort())
+                );
+            }
+            if (cm.forwardLog()) {
+                _logForwarder =
+                    std::make_unique<LogForwarder>(*_networkConnections.back());
+                Log::instance().setForwardCallback(
+                    std::bind_front(&LogForwarder::forward, _logForwarder.get())
+                );
+            }
 
             // add data transfer connection
             if (cm.thisNode().dataTransferPort() > 0 && !remoteAddress.empty()) {
+                // If the transfers are relayed, they are received from the parent node,
+                // which listens on the data transfer port of this node
+                const int parent = cm.transferParent(cm.thisNodeId());
+                const bool isRelayed =
+                    cm.relaysTransfers() && parent != cm.masterNodeIndex();
                 addConnection(
                     cm.thisNode().dataTransferPort(),
-                    remoteAddress,
+                    isRelayed && _mode == NetworkMode::Remote ?
+                        cm.node(parent).address() :
+                        remoteAddress,
                     Network::ConnectionType::DataTransfer
                 );
-                if (_dataTransferDecodeFn) {
-                    _networkConnections.back()->setPackageDecodeFunction(
-                        _dataTransferDecodeFn
-                    );
-                }
+                setDataTransferCallbacks(*_networkConnections.back());
+            }
 
-                // acknowledge callback
-                if (_dataTransferAcknowledgeFn) {
-                    _networkConnections.back()->setAcknowledgeFunction(
-                        _dataTransferAcknowledgeFn
+            // The clients to which this node forwards the transfers of the master
+            for (int i = 0; i < cm.numberOfNodes(); i++) {
+                if (cm.transferParent(i) == cm.thisNodeId()) {
+                    addConnection(
+                        cm.node(i).dataTransferPort(),
+                        remoteAddress,
+                        Network::ConnectionType::DataTransfer,
+                        true
                     );
+                    setDataTransferCallbacks(*_networkConnections.back());
                 }
             }
         }
 
+        if (_isServer && cm.relaysTransfers() &&
+            !matchesAddress(cm.node(cm.masterNodeIndex()).address()))
+        {
+            throw Error(
+                5044,
+                "Relaying data transfers requires a node with the master address"
+            );
+        }
+
         // add all connections from config file
         for (int i = 0; i < cm.numberOfNodes(); i++) {
             const Node& n = cm.node(i);
@@ -345,84 +481,239 @@ void NetworkManager::initialize() {
             // don't add itself if server
             if (_isServer && !matchesAddress(n.address())) {
                 addConnection(n.syncPort(), remoteAddress);
+                const Network* syncConnection = _networkConnections.back().get();
+                _networkConnections.back()->setCritical(n.isCritical());
+                if (_useSharedMemory) {
+                    _networkConnections.back()->useSharedMemory(
+                        std::format("sgct-{}", n.syncPort())
+                    );
+                }
 
                 _networkConnections.back()->setDecodeFunction(
-                    [](const char* data, int length) {
-                        std::vector<char> d(data, data + length);
-                        d.push_back('\0');
-                        Log::Info(std::format("[client]: {} [end]", d.data()));
+                    [i](const char* data, int length) {
+                        LogForwarder::print(i, std::string_view(data, length));
                     }
                 );
+                if (_multicast) {
+                    _networkConnections.back()->setNackFunction(
+                        [this](uint32_t sequence, std::vector<uint16_t> fragments) {
+                            _multicast->retransmit(sequence, fragments);
+                        }
+                    );
+                }
 
-                // add data transfer connection
-                if (n.dataTransferPort() != 0 && !remoteAddress.empty()) {
+                // add data transfer connection, unless the transfers to this node are
+                // relayed by another client
+                const bool isDirect = !cm.relaysTransfers() ||
+                    cm.transferParent(i) == cm.masterNodeIndex();
+                if (n.dataTransferPort() != 0 && !remoteAddress.empty() && isDirect) {
                     addConnection(
                         n.dataTransferPort(),
                         remoteAddress,
                         Network::ConnectionType::DataTransfer
                     );
-                    if (_dataTransferDecodeFn) {
-                        _networkConnections.back()->setPackageDecodeFunction(
-                            _dataTransferDecodeFn
-                        );
-                    }
-
-                    // acknowledge callback
-                    if (_dataTransferAcknowledgeFn) {
-                        _networkConnections.back()->setAcknowledgeFunction(
-                            _dataTransferAcknowledgeFn
-                        );
+                    setDataTransferCallbacks(*_networkConnections.back());
+                    _nodeTransferConnections[i] = _networkConnections.back().get();
+                    _transferSyncConnections[_networkConnections.back().get()] =
+                        syncConnection;
+                    if (cm.relaysTransfers()) {
+                        _relayedNodes[_networkConnections.back().get()] =
+                            nRelayedNodes(i);
                     }
                 }
             }
         }
     }
 
+    connectPendingConnections();
+
     Log::Debug(
         std::format("Cluster sync: {}", cm.firmFrameLockSyncStatus() ? "firm" : "loose")
     );
 }
 
+void NetworkManager::connectPendingConnections() {
+    ZoneScoped;
+
+    // Each client connection waits until its server is listening, which would add up
+    // the waiting times if the connections were established one after the other
+    std::vector<std::exception_ptr> errors(_pendingConnections.size());
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(_pendingConnections.size());
+        for (size_t i = 0; i < _pendingConnections.size(); i++) {
+            Network* connection = _pendingConnections[i].first;
+            threads.emplace_back([connection, &errors, i]() {
+                try {
+                    connection->initializeEventDriven();
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (const auto& [connection, reactor] : _pendingConnections) {
+        reactor->add(*connection);
+    }
+    _pendingConnections.clear();
+}
+
 void NetworkManager::clearCallbacks() {
     _dataTransferDecodeFn = nullptr;
     _dataTransferStatusFn = nullptr;
     _dataTransferAcknowledgeFn = nullptr;
+    _dataTransferChunkFn = nullptr;
+    _dataTransferProgressFn = nullptr;
 }
 
 std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) const {
-    if (_syncConnections.empty()) {
+    const std::vector<Network*>& syncConnections = connections().sync;
+    if (syncConnections.empty()) {
         return std::nullopt;
     }
+
+    // Keep the clock offset and latency estimates of all connections up to date
+    for (Network* connection : syncConnections) {
+        if (connection->isConnected()) {
+            connection->updateClock();
+        }
+    }
+
     if (sm == SyncMode::SendDataToClients) {
         double maxTime = -std::numeric_limits<double>::max();
         double minTime = std::numeric_limits<double>::max();
 
-        bool hasFoundConnection = false;
-        for (Network* connection : _syncConnections) {
-            if (!connection->isServer() || !connection->isConnected()) {
-                continue;
+        const ClusterManager& cm = ClusterManager::instance();
+        const bool useDeltaSync = cm.useDeltaSync();
+        const int keyframeInterval = cm.deltaSyncKeyframeInterval();
+
+        // The shared data is the same for all clients, so it is only compressed once and
+        // each connection only gets its own header with the frame number
+        const unsigned char* header = SharedData::instance().header();
+        const unsigned char* payload = SharedData::instance().dataBlock();
+        const int payloadSize = SharedData::instance().dataSize();
+        std::vector<char> compressed;
+        if (!_multicast && !_useSharedMemory && !useDeltaSync && cm.useCompression() &&
+            payloadSize >= cm.compressionThreshold())
+        {
+            compressData(
+                payload,
+                payloadSize,
+                compressed,
+                cm.compressionLevel()
+            );
+        }
+
+        // With multicast, the shared data is broadcast once and the sync connections only
+        // carry the frame number and the sequence number of the broadcast block
+        uint32_t sequence = 0;
+        if (_multicast) {
+            sequence = _multicast->send(
+                reinterpret_cast<const char*>(payload),
+                static_cast<uint32_t>(payloadSize)
+            );
+        }
+
+        std::vector<Network*> receivers;
+        for (Network* connection : syncConnections) {
+            if (connection->isServer() && connection->isConnected()) {
+                receivers.push_back(connection);
             }
+        }
 
-            hasFoundConnection = true;
+        // In parallel mode, each connection sends on its own sender thread and this
+        // function returns once all of them are done, so that a single slow socket does
+        // not delay the sending to all other clients
+        const bool useParallelSend = cm.useParallelSend() && receivers.size() > 1;
+        std::latch done = std::latch(static_cast<std::ptrdiff_t>(receivers.size()));
 
+        const bool hasFoundConnection = !receivers.empty();
+        for (Network* connection : receivers) {
             const double currentTime = connection->loopTime();
             maxTime = std::max(currentTime, maxTime);
             minTime = std::min(currentTime, minTime);
 
-            const int currentSize =
-                SharedData::instance().dataSize() - static_cast<int>(Network::HeaderSize);
-
             // iterate counter
             const int currentFrame = connection->iterateFrameCounter();
 
-            unsigned char* dataBlock = SharedData::instance().dataBlock();
-            std::memcpy(dataBlock + 1, &currentFrame, sizeof(currentFrame));
-            std::memcpy(dataBlock + 5, &currentSize, sizeof(currentSize));
+            // Every connection gets its own copy of the header with its frame number, so
+            // the header and the payload are sent separately and the payload is never
+            // copied
+            std::array<char, Network::HeaderSize> head;
+            if (!compressed.empty()) {
+                std::memcpy(head.data(), compressed.data(), Network::HeaderSize);
+            }
+            else {
+                std::memcpy(head.data(), header, Network::HeaderSize);
+                std::memcpy(head.data() + 5, &payloadSize, sizeof(payloadSize));
+            }
+            std::memcpy(head.data() + 1, &currentFrame, sizeof(currentFrame));
 
-            connection->sendData(
-                SharedData::instance().dataBlock(),
-                SharedData::instance().dataSize()
-            );
+            Multicast* multicast = _multicast.get();
+            auto send = [connection, head, currentFrame, multicast, sequence,
+                         &compressed, payload, payloadSize, useDeltaSync,
+                         keyframeInterval]()
+            {
+                const double t0 = time();
+                if (multicast) {
+                    connection->sendMulticastHeader(currentFrame, sequence);
+                }
+                else if (connection->sendSharedMemoryData(
+                             currentFrame,
+                             payload,
+                             static_cast<uint32_t>(payloadSize)
+                        ))
+                {
+                    // The client reads the block straight from shared memory
+                }
+                else if (!compressed.empty()) {
+                    connection->sendData(
+                        head.data(),
+                        compressed.data() + Network::HeaderSize,
+                        static_cast<int>(compressed.size() - Network::HeaderSize)
+                    );
+                }
+                else if (useDeltaSync) {
+                    connection->sendDeltaData(
+                        reinterpret_cast<const unsigned char*>(head.data()),
+                        payload,
+                        payloadSize,
+                        keyframeInterval
+                    );
+                }
+                else {
+                    connection->sendData(head.data(), payload, payloadSize);
+                }
+                connection->setSendTime(time() - t0);
+            };
+
+            if (useParallelSend) {
+                connection->sendAsync([send, &done]() {
+                    try {
+                        send();
+                    }
+                    catch (...) {
+                        done.count_down();
+                        throw;
+                    }
+                    done.count_down();
+                });
+            }
+            else {
+                send();
+            }
+        }
+
+        if (useParallelSend) {
+            ZoneScopedN("Wait for sends");
+            done.wait();
         }
 
         if (hasFoundConnection) {
@@ -430,7 +721,7 @@ std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) const
         }
     }
     else if (sm == SyncMode::Acknowledge) {
-        for (Network* connection : _syncConnections) {
+        for (Network* connection : syncConnections) {
             if (!connection->isServer() && connection->isConnected()) {
                 // The servers's render function is locked until a message starting with
                 // the ack-byte is received.
@@ -442,20 +733,104 @@ std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) const
 }
 
 bool NetworkManager::isSyncComplete() const {
-    const unsigned int counter = static_cast<unsigned int>(std::count_if(
-        _syncConnections.cbegin(),
-        _syncConnections.cend(),
-        std::mem_fn(&Network::isUpdated)
-    ));
-    return (counter == _nActiveSyncConnections);
+    const std::vector<Network*>& sync = connections().sync;
+    const unsigned int counter = static_cast<unsigned int>(
+        std::count_if(sync.cbegin(), sync.cend(), std::mem_fn(&Network::isUpdated))
+    );
+    return (counter == _nActiveSyncConnections.load(std::memory_order_acquire));
+}
+
+bool NetworkManager::isCriticalSyncComplete() const {
+    const std::vector<Network*>& sync = connections().sync;
+    return std::all_of(
+        sync.cbegin(),
+        sync.cend(),
+        [](const Network* c) {
+            return !c->isConnected() || !c->isCritical() || c->isUpdated();
+        }
+    );
+}
+
+double NetworkManager::masterTime() const {
+    const std::vector<Network*>& sync = connections().sync;
+    if (_isServer || sync.empty()) {
+        return time();
+    }
+    return time() + sync.front()->clockOffset();
+}
+
+void NetworkManager::queueMessageToMaster(std::string_view message) const {
+    for (Network* connection : connections().sync) {
+        if (!connection->isServer()) {
+            connection->queueMessage(
+                LogForwarder::encode(Log::Level::Info, masterTime(), message)
+            );
+        }
+    }
+}
+
+void NetworkManager::queueStatisticsToMaster(
+                                          const Network::NodeStatistics& statistics) const
+{
+    for (Network* connection : connections().sync) {
+        if (!connection->isServer()) {
+            connection->queueStatistics(statistics);
+        }
+    }
+}
+
+void NetworkManager::sendReadyToMaster(const Network::StartupTimes& times) const {
+    for (Network* connection : connections().sync) {
+        if (!connection->isServer()) {
+            connection->sendReady(times);
+        }
+    }
+}
+
+bool NetworkManager::areAllNodesReady() const {
+    if (!_isServer) {
+        return true;
+    }
+
+    const std::vector<Network*>& sync = connections().sync;
+    return std::all_of(
+        sync.cbegin(),
+        sync.cend(),
+        [](const Network* c) { return c->isConnected() && c->startupTimes().has_value(); }
+    );
+}
+
+void NetworkManager::releaseSyncData() const {
+    for (Network* connection : connections().sync) {
+        connection->releaseSyncData();
+    }
 }
 
 void NetworkManager::transferData(const void* data, int length, int packageId) const {
-    std::vector<char> buffer;
-    prepareTransferData(data, buffer, length, packageId);
-    for (Network* connection : _dataTransferConnections) {
-        if (connection->isConnected()) {
-            connection->sendData(buffer.data(), length);
+    ZoneScoped;
+
+    {
+        const std::unique_lock lock(_transferMutex);
+        if (compressTransferData(data, length, packageId, _transferBuffer)) {
+            const int size = static_cast<int>(_transferBuffer.size());
+            for (Network* connection : connections().dataTransfer) {
+                if (isTransferTarget(*connection)) {
+                    connection->sendPackage(
+                        _transferBuffer.data(),
+                        _transferBuffer.data() + Network::HeaderSize,
+                        size - static_cast<int>(Network::HeaderSize)
+                    );
+                }
+            }
+            return;
+        }
+    }
+
+    const std::array<char, Network::HeaderSize> header =
+        transferHeader(length, packageId);
+    for (Network* connection : connections().dataTransfer) {
+        if (isTransferTarget(*connection)) {
+            connection->sendPackage(header.data(), data, length);
         }
     }
 }
@@ -463,34 +838,192 @@ void NetworkManager::transferData(const void* data, int length, int packageId) c
 void NetworkManager::transferData(const void* data, int length, int packageId,
                                   const Network& connection) const
 {
+    ZoneScoped;
+
+    if (!connection.isConnected()) {
+        return;
+    }
+
+    {
+        const std::unique_lock lock(_transferMutex);
+        if (compressTransferData(data, length, packageId, _transferBuffer)) {
+            const int size = static_cast<int>(_transferBuffer.size());
+            connection.sendPackage(
+                _transferBuffer.data(),
+                _transferBuffer.data() + Network::HeaderSize,
+                size - static_cast<int>(Network::HeaderSize)
+            );
+            return;
+        }
+    }
+
+    const std::array<char, Network::HeaderSize> header =
+        transferHeader(length, packageId);
+    connection.sendPackage(header.data(), data, length);
+}
+
+void NetworkManager::transferChunkedData(const void* data, uint64_t length,
+                                         int packageId) const
+{
+    ZoneScoped;
+
+    for (const Network* connection : connections().dataTransfer) {
+        if (isTransferTarget(*connection)) {
+            sendChunks(*connection, data, length, packageId);
+        }
+    }
+}
+
+void NetworkManager::transferChunkedData(const void* data, uint64_t length, int packageId,
+                                         const Network& connection) const
+{
+    ZoneScoped;
+
     if (connection.isConnected()) {
-        std::vector<char> buffer;
-        prepareTransferData(data, buffer, length, packageId);
-        connection.sendData(buffer.data(), length);
+        sendChunks(connection, data, length, packageId);
+    }
+}
+
+void* NetworkManager::rdmaTransferBuffer() {
+    return _rdmaBuffer.empty() ? nullptr : _rdmaBuffer.data();
+}
+
+size_t NetworkManager::rdmaTransferBufferSize() const {
+    return _rdmaBuffer.size();
+}
+
+void NetworkManager::transferRdmaData(int length, int packageId) const {
+    ZoneScoped;
+
+    if (length < 0 || static_cast<size_t>(length) > _rdmaBuffer.size()) {
+        throw Error(
+            5041,
+            std::format(
+                "RDMA transfer of {} bytes exceeds the buffer of {} bytes",
+                length, _rdmaBuffer.size()
+            )
+        );
+    }
+
+    for (const Network* connection : connections().dataTransfer) {
+        if (!isTransferTarget(*connection)) {
+            continue;
+        }
+#ifdef SGCT_HAS_RDMA
+        const auto it = _rdmaConnections.find(connection);
+        if (it != _rdmaConnections.end() && it->second->send(length, packageId)) {
+            continue;
+        }
+#endif // SGCT_HAS_RDMA
+        transferData(_rdmaBuffer.data(), length, packageId, *connection);
+    }
+}
+
+void NetworkManager::sendChunks(const Network& connection, const void* data,
+                                uint64_t length, int packageId) const
+{
+    ZoneScoped;
+
+    const ClusterManager& cm = ClusterManager::instance();
+    const uint64_t chunkSize = static_cast<uint64_t>(cm.transferChunkSize());
+    // The limit is provided in kilobytes per second, 0 means unlimited
+    const double bytesPerSecond = cm.transferRateLimit() * 1000.0;
+    const char* bytes = reinterpret_cast<const char*>(data);
+    const bool isAutoTuned = cm.transferSocketProfile().autoTuneBuffers;
+
+    uint64_t offset = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto lastTuning = start;
+    uint64_t sentSinceStart = 0;
+    while (offset < length && isRunning()) {
+        bool isLost = !connection.isConnected();
+        if (!isLost) {
+            const int size = static_cast<int>(std::min(chunkSize, length - offset));
+            try {
+                connection.sendChunk(packageId, offset, length, bytes + offset, size);
+                offset += size;
+                sentSinceStart += size;
+            }
+            catch (const std::runtime_error& e) {
+                Log::Warning(e.what());
+                isLost = true;
+            }
+        }
+
+        if (isLost) {
+            Log::Warning(std::format(
+                "Lost data transfer connection {} while sending package {}",
+                connection.id(), packageId
+            ));
+            while (isRunning() && !connection.isConnected()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+
+            // Continue after the last chunk that arrived on the other side
+            offset = connection.acknowledgedChunkBytes(packageId);
+            start = std::chrono::steady_clock::now();
+            sentSinceStart = 0;
+            Log::Info(std::format(
+                "Resuming package {} on connection {} at byte {}",
+                packageId, connection.id(), offset
+            ));
+            continue;
+        }
+
+        if (bytesPerSecond > 0.0) {
+            // Wait until the bytes sent so far are within the bandwidth limit
+            const std::chrono::duration<double> due(sentSinceStart / bytesPerSecond);
+            std::this_thread::sleep_until(
+                start + std::chrono::duration_cast<std::chrono::nanoseconds>(due)
+            );
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (isAutoTuned && now - lastTuning >= std::chrono::seconds(1)) {
+            // The bandwidth is measured from the chunks that were sent so far, which
+            // includes the waiting for the rate limit
+            const std::chrono::duration<double> elapsed = now - start;
+            const double roundTrip = roundTripTime(connection);
+            if (roundTrip > 0.0 && elapsed.count() > 0.0) {
+                connection.tuneSendBuffer(sentSinceStart / elapsed.count(), roundTrip);
+            }
+            lastTuning = now;
+        }
     }
 }
 
+double NetworkManager::roundTripTime(const Network& connection) const {
+    const auto it = _transferSyncConnections.find(&connection);
+    if (it != _transferSyncConnections.end()) {
+        return 2.0 * it->second->latency();
+    }
+    // A client only measures the latency to the master, which is used as an estimate
+    // for the nodes that it relays the transfers to and from, too
+    const std::vector<Network*>& sync = connections().sync;
+    if (!_isServer && !sync.empty()) {
+        return 2.0 * sync.front()->latency();
+    }
+    return 0.0;
+}
+
 unsigned int NetworkManager::activeConnectionsCount() const {
-    const std::unique_lock lock(mutex::DataSync);
-    return _nActiveConnections;
+    return _nActiveConnections.load(std::memory_order_acquire);
 }
 
 int NetworkManager::connectionsCount() const {
-    const std::unique_lock lock(mutex::DataSync);
-    return static_cast<int>(_networkConnections.size());
+    return static_cast<int>(connections().all.size());
 }
 
 int NetworkManager::syncConnectionsCount() const {
-    const std::unique_lock lock(mutex::DataSync);
-    return static_cast<int>(_syncConnections.size());
+    return static_cast<int>(connections().sync.size());
 }
 
 const Network& NetworkManager::connection(int index) const {
-    return *_networkConnections[index];
+    return *connections().all[index];
 }
 
 const Network& NetworkManager::syncConnection(int index) const {
-    return *_syncConnections[index];
+    return *connections().sync[index];
 }
 
 void NetworkManager::updateConnectionStatus(Network& connection) {
@@ -500,14 +1033,13 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
     int nConnectedSync = 0;
     int nConnectedDataTransfer = 0;
 
-    mutex::DataSync.lock();
-    int totalNConnections = static_cast<int>(_networkConnections.size());
-    int totalNSyncConnections = static_cast<int>(_syncConnections.size());
-    int totalNTransferConnections = static_cast<int>(_dataTransferConnections.size());
-    mutex::DataSync.unlock();
+    const Connections& list = connections();
+    const int totalNConnections = static_cast<int>(list.all.size());
+    const int totalNSyncConnections = static_cast<int>(list.sync.size());
+    const int totalNTransferConnections = static_cast<int>(list.dataTransfer.size());
 
     // count connections
-    for (const std::unique_ptr<Network>& conn : _networkConnections) {
+    for (const Network* conn : list.all) {
         if (conn->isConnected()) {
             nConnections++;
             if (conn->type() == Network::ConnectionType::SyncConnection) {
@@ -530,29 +1062,35 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
         nConnectedDataTransfer, totalNTransferConnections
     ));
 
-    mutex::DataSync.lock();
-    _nActiveConnections = nConnections;
-    _nActiveSyncConnections = nConnectedSync;
-    _nActiveDataTransferConnections = nConnectedDataTransfer;
+    _nActiveConnections.store(nConnections, std::memory_order_release);
+    _nActiveSyncConnections.store(nConnectedSync, std::memory_order_release);
+    _nActiveDataTransferConnections.store(
+        nConnectedDataTransfer,
+        std::memory_order_release
+    );
 
     // if client disconnects then it cannot run anymore
-    if (_nActiveSyncConnections == 0 && !_isServer) {
+    if (nConnectedSync == 0 && !_isServer) {
         _isRunning = false;
     }
-    mutex::DataSync.unlock();
 
     if (_isServer) {
-        mutex::DataSync.lock();
-        // local copy (thread safe)
+        // A client that (re)connects has to receive the full state, not only the data
+        // that changes in the next frame
+        if (connection.isConnected() &&
+            connection.type() == Network::ConnectionType::SyncConnection)
+        {
+            SharedData::instance().requestFullState();
+        }
+
         const bool allNodesConnected =
             (nConnectedSync == totalNSyncConnections) &&
             (nConnectedDataTransfer == totalNTransferConnections);
         _allNodesConnected = allNodesConnected;
-        mutex::DataSync.unlock();
 
         // send cluster connected message to clients
         if (allNodesConnected) {
-            for (Network* syncConnection : _syncConnections) {
+            for (Network* syncConnection : list.sync) {
                 if (!syncConnection->isConnected()) {
                     continue;
                 }
@@ -561,7 +1099,7 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
                 data[0] = Network::ConnectedId;
                 syncConnection->sendData(&data, Network::HeaderSize);
             }
-            for (Network* dataConnection : _dataTransferConnections) {
+            for (Network* dataConnection : list.dataTransfer) {
                 if (dataConnection->isConnected()) {
                     std::array<char, Network::HeaderSize> data = {};
                     std::fill(data.begin(), data.end(), Network::DefaultId);
@@ -574,6 +1112,17 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
         // wake up the connection handler thread on server
         connection.startConnectionConditionVar().notify_all();
     }
+    else if (connection.isServer()) {
+        // A client that relays the data transfers listens for the clients below it
+        if (connection.isConnected()) {
+            std::array<char, Network::HeaderSize> data = {};
+            std::fill(data.begin(), data.end(), Network::DefaultId);
+            data[0] = Network::ConnectedId;
+            connection.sendData(&data, Network::HeaderSize);
+        }
+        connection.startConnectionConditionVar().notify_all();
+        setAllNodesConnected();
+    }
 
     if (connection.type() == Network::ConnectionType::DataTransfer) {
         if (_dataTransferStatusFn) {
@@ -586,18 +1135,137 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
 }
 
 void NetworkManager::setAllNodesConnected() {
-    const std::unique_lock lock(mutex::DataSync);
-
     if (!_isServer) {
         const unsigned int nConn =
-            static_cast<unsigned int>(_dataTransferConnections.size());
+            static_cast<unsigned int>(connections().dataTransfer.size());
         _allNodesConnected = (_nActiveSyncConnections == 1) &&
                              (_nActiveDataTransferConnections == nConn);
     }
 }
 
+void NetworkManager::setDataTransferCallbacks(Network& connection) const {
+    if (!_isServer && ClusterManager::instance().relaysTransfers()) {
+        setRelayCallbacks(connection);
+        return;
+    }
+
+    if (_dataTransferDecodeFn) {
+        connection.setPackageDecodeFunction(_dataTransferDecodeFn);
+    }
+
+    // acknowledge callback
+    if (_dataTransferAcknowledgeFn) {
+        connection.setAcknowledgeFunction(_dataTransferAcknowledgeFn);
+    }
+
+    // chunked transfer callbacks
+    if (_dataTransferChunkFn) {
+        connection.setChunkDecodeFunction(_dataTransferChunkFn);
+    }
+    if (_dataTransferProgressFn) {
+        connection.setChunkAcknowledgeFunction(_dataTransferProgressFn);
+    }
+}
+
+void NetworkManager::setRelayCallbacks(Network& connection) const {
+    if (connection.isServer()) {
+        // The packages that a client sends to the master are forwarded towards the
+        // master without being handled on this node
+        connection.setPackageDecodeFunction(
+            [this](void* data, int length, int packageId, int) {
+                for (const Network* c : connections().dataTransfer) {
+                    if (!c->isServer()) {
+                        transferData(data, length, packageId, *c);
+                    }
+                }
+            }
+        );
+        connection.setChunkDecodeFunction(
+            [id = connection.id()](void*, int, uint64_t, uint64_t, int packageId, int) {
+                Log::Warning(std::format(
+                    "Dropping chunk of package {} from connection {} as chunked "
+                    "transfers to the master are not relayed", packageId, id
+                ));
+            }
+        );
+        return;
+    }
+
+    // The transfers from the master are forwarded to the clients below this node before
+    // they are handled, so that the chunks travel through the clients like a pipeline
+    connection.setPackageDecodeFunction(
+        [this](void* data, int length, int packageId, int client) {
+            for (const Network* c : connections().dataTransfer) {
+                if (c->isServer()) {
+                    transferData(data, length, packageId, *c);
+                }
+            }
+            if (_dataTransferDecodeFn) {
+                _dataTransferDecodeFn(data, length, packageId, client);
+            }
+        }
+    );
+    connection.setChunkDecodeFunction(
+        [this](void* data, int length, uint64_t offset, uint64_t total, int packageId,
+               int client)
+        {
+            for (const Network* c : connections().dataTransfer) {
+                if (!c->isServer() || !c->isConnected()) {
+                    continue;
+                }
+                try {
+                    c->sendChunk(packageId, offset, total, data, length);
+                }
+                catch (const std::runtime_error& e) {
+                    Log::Warning(std::format(
+                        "Failed to forward chunk of package {} to connection {}: {}",
+                        packageId, c->id(), e.what()
+                    ));
+                }
+            }
+            if (_dataTransferChunkFn) {
+                _dataTransferChunkFn(data, length, offset, total, packageId, client);
+            }
+        }
+    );
+    if (_dataTransferAcknowledgeFn) {
+        connection.setAcknowledgeFunction(_dataTransferAcknowledgeFn);
+    }
+    if (_dataTransferProgressFn) {
+        connection.setChunkAcknowledgeFunction(_dataTransferProgressFn);
+    }
+}
+
+int NetworkManager::nRelayedNodes(int nodeIndex) const {
+    const ClusterManager& cm = ClusterManager::instance();
+    int n = 1;
+    for (int i = 0; i < cm.numberOfNodes(); i++) {
+        if (cm.transferParent(i) == nodeIndex) {
+            n += nRelayedNodes(i);
+        }
+    }
+    return n;
+}
+
+int NetworkManager::transferNodesCount(const Network& connection) const {
+    const auto it = _relayedNodes.find(&connection);
+    return it != _relayedNodes.end() ? it->second : 1;
+}
+
+const Network* NetworkManager::transferConnection(int nodeIndex) const {
+    const auto it = _nodeTransferConnections.find(nodeIndex);
+    return it != _nodeTransferConnections.end() ? it->second : nullptr;
+}
+
+bool NetworkManager::isTransferTarget(const Network& connection) const {
+    // The transfers of the master go to its clients, and those of a client to the node
+    // from which it receives the transfers, but not to the clients it relays them to
+    return connection.isConnected() && connection.isServer() == _isServer;
+}
+
 void NetworkManager::addConnection(int port, std::string address,
-                                   Network::ConnectionType connectionType)
+                                   Network::ConnectionType connectionType,
+                                   std::optional<bool> isServer)
 {
     ZoneScoped;
 
@@ -611,8 +1279,8 @@ void NetworkManager::addConnection(int port, std::string address,
 
     auto net = std::make_unique<Network>(
         port,
-        std::move(address),
-        _isServer,
+        address,
+        isServer.value_or(_isServer),
         connectionType
     );
     Log::Debug(std::format(
@@ -621,24 +1289,72 @@ void NetworkManager::addConnection(int port, std::string address,
     net->setUpdateFunction([this](Network& c) { updateConnectionStatus(c); });
     net->setConnectedFunction([this]() { setAllNodesConnected(); });
 
-    // must be initialized after binding
-    net->initialize();
+    NetworkReactor* reactor = connectionType == Network::ConnectionType::DataTransfer ?
+        _dataTransferReactor.get() : _syncReactor.get();
+    if (reactor && !net->isServer()) {
+        _pendingConnections.emplace_back(net.get(), reactor);
+    }
+    else if (reactor) {
+        net->initializeEventDriven();
+        reactor->add(*net);
+    }
+    else {
+        // must be initialized after binding
+        net->initialize();
+    }
     _networkConnections.push_back(std::move(net));
 
-    // Update the previously existing shortcuts (maybe remove them altogether?)
-    _syncConnections.clear();
-    _dataTransferConnections.clear();
+#ifdef SGCT_HAS_RDMA
+    // In the local network modes, all nodes are on the same computer anyway
+    // The relayed transfers are forwarded through the TCP connections
+    if (connectionType == Network::ConnectionType::DataTransfer &&
+        _mode == NetworkMode::Remote && !_rdmaBuffer.empty() &&
+        !ClusterManager::instance().relaysTransfers())
+    {
+        const Network* connection = _networkConnections.back().get();
+        const int id = connection->id();
+        _rdmaConnections[connection] = std::make_unique<RdmaConnection>(
+            port,
+            std::move(address),
+            _isServer,
+            _rdmaBuffer.data(),
+            _rdmaBuffer.size(),
+            [this, id](char* data, int length, int packageId) {
+                if (_dataTransferDecodeFn) {
+                    _dataTransferDecodeFn(data, length, packageId, id);
+                }
+            },
+            [this, id](int packageId) {
+                if (_dataTransferAcknowledgeFn) {
+                    _dataTransferAcknowledgeFn(packageId, id);
+                }
+            }
+        );
+    }
+#endif // SGCT_HAS_RDMA
+
+    publishConnections();
+}
+
+const NetworkManager::Connections& NetworkManager::connections() const {
+    return *_connections.load(std::memory_order_acquire);
+}
 
+void NetworkManager::publishConnections() {
+    auto list = std::make_unique<Connections>();
     for (const std::unique_ptr<Network>& connection : _networkConnections) {
+        list->all.push_back(connection.get());
         switch (connection->type()) {
             case Network::ConnectionType::SyncConnection:
-                _syncConnections.push_back(connection.get());
+                list->sync.push_back(connection.get());
                 break;
             case Network::ConnectionType::DataTransfer:
-                _dataTransferConnections.push_back(connection.get());
+                list->dataTransfer.push_back(connection.get());
                 break;
         }
     }
+    _connections.store(list.get(), std::memory_order_release);
+    _connectionLists.push_back(std::move(list));
 }
 
 bool NetworkManager::matchesAddress(std::string_view address) const {
@@ -653,12 +1369,10 @@ bool NetworkManager::isComputerServer() const {
 }
 
 bool NetworkManager::isRunning() const {
-    const std::unique_lock lock(mutex::DataSync);
     return _isRunning;
 }
 
 bool NetworkManager::areAllNodesConnected() const {
-    const std::unique_lock lock(mutex::DataSync);
     return _allNodesConnected;
 }
 
@@ -0,0 +1,191 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/networkreactor.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif // __linux__
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    // The wait for incoming data is interrupted regularly to pick up new connections and
+    // to notice when the reactor should terminate
+    constexpr int PollTimeout = 100; // ms
+
+    constexpr int MaxEvents = 64;
+} // namespace
+
+namespace sgct {
+
+NetworkReactor::NetworkReactor() {
+#ifdef __linux__
+    _epoll = epoll_create1(0);
+    if (_epoll == -1) {
+        throw Err(5036, std::format("Failed to create epoll instance: {}", SGCT_ERRNO));
+    }
+#endif // __linux__
+
+    _thread = std::make_unique<std::thread>([this]() { run(); });
+}
+
+NetworkReactor::~NetworkReactor() {
+    stop();
+
+#ifdef __linux__
+    close(_epoll);
+#endif // __linux__
+}
+
+void NetworkReactor::add(Network& connection) {
+    const std::unique_lock lock(_mutex);
+    _connections.push_back(&connection);
+}
+
+void NetworkReactor::stop() {
+    _shouldTerminate = true;
+    if (_thread) {
+        _thread->join();
+    }
+    _thread = nullptr;
+}
+
+void NetworkReactor::run() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, "Reactor");
+
+    while (!_shouldTerminate) {
+        std::vector<Network*> connections;
+        {
+            const std::unique_lock lock(_mutex);
+            connections = _connections;
+        }
+
+#ifdef __linux__
+        for (Network* connection : connections) {
+            updateRegistration(connection);
+        }
+
+        std::array<epoll_event, MaxEvents> events;
+        const int nEvents = epoll_wait(_epoll, events.data(), MaxEvents, PollTimeout);
+        for (int i = 0; i < nEvents && !_shouldTerminate; i++) {
+            dispatch(reinterpret_cast<Network*>(events[i].data.ptr));
+        }
+#else // ^^^^ __linux__ // !__linux__ vvvv
+        std::vector<pollfd> sockets;
+        std::vector<Network*> owners;
+        for (Network* connection : connections) {
+            const SGCT_SOCKET socket = connection->pollSocket();
+            if (socket == static_cast<SGCT_SOCKET>(INVALID_SOCKET)) {
+                continue;
+            }
+            pollfd fd = {};
+            fd.fd = socket;
+            fd.events = POLLIN;
+            sockets.push_back(fd);
+            owners.push_back(connection);
+        }
+
+        if (sockets.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeout));
+            continue;
+        }
+
+#ifdef WIN32
+        const int nEvents =
+            WSAPoll(sockets.data(), static_cast<ULONG>(sockets.size()), PollTimeout);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        const int nEvents = poll(sockets.data(), sockets.size(), PollTimeout);
+#endif // WIN32
+        for (size_t i = 0; i < sockets.size() && nEvents > 0 && !_shouldTerminate; i++) {
+            if (sockets[i].revents != 0) {
+                dispatch(owners[i]);
+            }
+        }
+#endif // __linux__
+
+        if (nEvents < 0 && SGCT_ERRNO != EINTR) {
+            Log::Warning(std::format("Waiting for network events failed: {}", SGCT_ERRNO));
+        }
+    }
+}
+
+void NetworkReactor::dispatch(Network* connection) {
+    ZoneScoped;
+
+    const bool isActive = connection->handleReadable();
+
+#ifdef __linux__
+    // The connection might have switched between its listening and its data socket
+    updateRegistration(connection);
+#endif // __linux__
+
+    if (!isActive) {
+        const std::unique_lock lock(_mutex);
+        std::erase(_connections, connection);
+#ifdef __linux__
+        const auto it = _registered.find(connection);
+        if (it != _registered.end()) {
+            epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second, nullptr);
+            _registered.erase(it);
+        }
+#endif // __linux__
+    }
+}
+
+void NetworkReactor::updateRegistration([[maybe_unused]] Network* connection) {
+#ifdef __linux__
+    const SGCT_SOCKET socket = connection->pollSocket();
+    const auto it = _registered.find(connection);
+    if (it != _registered.end() && it->second == socket) {
+        return;
+    }
+
+    if (it != _registered.end()) {
+        // Fails harmlessly if the socket has been closed, which already removes it
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second, nullptr);
+        _registered.erase(it);
+    }
+    if (socket == INVALID_SOCKET) {
+        return;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = connection;
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, socket, &event) == 0) {
+        _registered[connection] = socket;
+    }
+#endif // __linux__
+}
+
+} // namespace sgct
@@ -23,6 +23,8 @@ Node::Node(const config::Node& node, bool initializeWindows)
     , _syncPort(node.port)
     , _dataTransferPort(node.dataTransferPort.value_or(0))
     , _useSwapGroups(node.swapLock.value_or(false))
+    , _isCritical(node.isCritical.value_or(true))
+    , _pollInterval(node.pollInterval.value_or(1))
 {
     ZoneScoped;
 
@@ -91,4 +93,12 @@ int Node::dataTransferPort() const {
     return _dataTransferPort;
 }
 
+bool Node::isCritical() const {
+    return _isCritical;
+}
+
+int Node::pollInterval() const {
+    return _pollInterval;
+}
+
 } // namespace sgct
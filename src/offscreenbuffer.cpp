@@ -8,6 +8,7 @@
 
 #include <sgct/offscreenbuffer.h>
 
+#include <sgct/engine.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
@@ -19,9 +20,50 @@
 // need an offscreen buffer if we don't have any mesh or mask to apply
 
 namespace {
-    void setDrawBuffers() {
-        if (sgct::Engine::instance().settings().usePositionTexture) {
-            if (sgct::Engine::instance().settings().useNormalTexture) {
+    // The configurations that a buffer keeps framebuffers for, which is far more than
+    // the eyes and cube map faces it is used for, so that a buffer whose textures are
+    // attached in an unexpected number of combinations does not grow without bounds
+    constexpr size_t MaxConfigurations = 32;
+
+    void attachTarget(GLenum attachment, const sgct::OffScreenBuffer::Target& target) {
+        using Type = sgct::OffScreenBuffer::Target::Type;
+        switch (target.type) {
+            case Type::Texture:
+                glFramebufferTexture2D(
+                    GL_FRAMEBUFFER,
+                    attachment,
+                    GL_TEXTURE_2D,
+                    target.texture,
+                    0
+                );
+                break;
+            case Type::CubeMapFace:
+                glFramebufferTexture2D(
+                    GL_FRAMEBUFFER,
+                    attachment,
+                    GL_TEXTURE_CUBE_MAP_POSITIVE_X + target.index,
+                    target.texture,
+                    0
+                );
+                break;
+            case Type::Layered:
+                glFramebufferTexture(GL_FRAMEBUFFER, attachment, target.texture, 0);
+                break;
+            case Type::Layer:
+                glFramebufferTextureLayer(
+                    GL_FRAMEBUFFER,
+                    attachment,
+                    target.texture,
+                    0,
+                    target.index
+                );
+                break;
+        }
+    }
+
+    void setDrawBuffers(const sgct::OffScreenBuffer::Attachments& attachments) {
+        if (attachments.positions) {
+            if (attachments.normals) {
                 GLenum d[] = {
                     GL_COLOR_ATTACHMENT0,
                     GL_COLOR_ATTACHMENT1,
@@ -35,7 +77,7 @@ namespace {
             }
         }
         else {
-            if (sgct::Engine::instance().settings().useNormalTexture) {
+            if (attachments.normals) {
                 GLenum b[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
                 glDrawBuffers(2, b);
             }
@@ -50,10 +92,23 @@ namespace {
 namespace sgct {
 
 OffScreenBuffer::OffScreenBuffer(unsigned int internalFormat)
+    : OffScreenBuffer(
+        internalFormat,
+        Attachments {
+            Engine::instance().settings().useDepthTexture,
+            Engine::instance().settings().useNormalTexture,
+            Engine::instance().settings().usePositionTexture
+        }
+    )
+{}
+
+OffScreenBuffer::OffScreenBuffer(unsigned int internalFormat, Attachments attachments)
     : _internalColorFormat(internalFormat)
+    , _attachments(attachments)
 {}
 
 OffScreenBuffer::~OffScreenBuffer() {
+    deleteConfigurations();
     glDeleteFramebuffers(1, &_frameBuffer);
     glDeleteRenderbuffers(1, &_depthBuffer);
     glDeleteFramebuffers(1, &_multiSampledFrameBuffer);
@@ -80,7 +135,9 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
     if (_isMultiSampled) {
         GLint maxSamples = 0;
         glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
-        samples = std::max(samples, maxSamples);
+        // The requested number of samples is an upper bound, as every additional sample
+        // adds to the memory and bandwidth of all attachments and their resolves
+        samples = std::min(samples, maxSamples);
         if (maxSamples < 2) {
             samples = 0;
         }
@@ -94,12 +151,12 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
         glGenRenderbuffers(1, &_colorBuffer);
 
         // generate render buffer for intermediate normal storage
-        if (Engine::instance().settings().useNormalTexture) {
+        if (_attachments.normals) {
             glGenRenderbuffers(1, &_normalBuffer);
         }
 
         // generate render buffer for intermediate position storage
-        if (Engine::instance().settings().usePositionTexture) {
+        if (_attachments.positions) {
             glGenRenderbuffers(1, &_positionBuffer);
         }
 
@@ -116,7 +173,7 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
             height
         );
 
-        if (Engine::instance().settings().useNormalTexture) {
+        if (_attachments.normals) {
             glBindRenderbuffer(GL_RENDERBUFFER, _normalBuffer);
             glRenderbufferStorageMultisample(
                 GL_RENDERBUFFER,
@@ -127,7 +184,7 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
             );
         }
 
-        if (Engine::instance().settings().usePositionTexture) {
+        if (_attachments.positions) {
             glBindRenderbuffer(GL_RENDERBUFFER, _positionBuffer);
             glRenderbufferStorageMultisample(
                 GL_RENDERBUFFER,
@@ -165,7 +222,7 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
             GL_RENDERBUFFER,
             _colorBuffer
         );
-        if (Engine::instance().settings().useNormalTexture) {
+        if (_attachments.normals) {
             glFramebufferRenderbuffer(
                 GL_FRAMEBUFFER,
                 GL_COLOR_ATTACHMENT1,
@@ -173,7 +230,7 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
                 _normalBuffer
             );
         }
-        if (Engine::instance().settings().usePositionTexture) {
+        if (_attachments.positions) {
             glFramebufferRenderbuffer(
                 GL_FRAMEBUFFER,
                 GL_COLOR_ATTACHMENT2,
@@ -205,6 +262,21 @@ void OffScreenBuffer::createFBO(int width, int height, int samples) {
     }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // The color textures are attached by the owner of this buffer and are counted there
+    const size_t texels = static_cast<size_t>(width) * height *
+        (_isMultiSampled ? std::max(samples, 1) : 1);
+    size_t bytes = texels * MemoryTracker::bytesPerTexel(GL_DEPTH_COMPONENT32);
+    if (_isMultiSampled) {
+        bytes += texels * MemoryTracker::bytesPerTexel(_internalColorFormat);
+        if (_attachments.normals) {
+            bytes += texels * MemoryTracker::bytesPerTexel(GL_RGB32F);
+        }
+        if (_attachments.positions) {
+            bytes += texels * MemoryTracker::bytesPerTexel(GL_RGB32F);
+        }
+    }
+    _memory.set(bytes);
 }
 
 void OffScreenBuffer::resizeFBO(int width, int height, int samples) {
@@ -217,6 +289,7 @@ void OffScreenBuffer::resizeFBO(int width, int height, int samples) {
     glDeleteRenderbuffers(1, &_colorBuffer);
     glDeleteRenderbuffers(1, &_normalBuffer);
     glDeleteRenderbuffers(1, &_positionBuffer);
+    deleteConfigurations();
     createFBO(width, height, samples);
 }
 
@@ -231,7 +304,7 @@ void OffScreenBuffer::bind() const {
         glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffer);
     }
 
-    setDrawBuffers();
+    setDrawBuffers(_attachments);
 }
 
 void OffScreenBuffer::bind(bool isMultisampled, int n, const unsigned int* bufs) const {
@@ -251,7 +324,72 @@ void OffScreenBuffer::bind(bool isMultisampled, int n, const unsigned int* bufs)
 void OffScreenBuffer::bindBlit() const {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, _multiSampledFrameBuffer);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _frameBuffer);
-    setDrawBuffers();
+    setDrawBuffers(_attachments);
+}
+
+void OffScreenBuffer::bind(const Configuration& configuration) const {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, configurationFrameBuffer(configuration));
+    setDrawBuffers(Attachments{
+        .depth = configuration.depth.has_value(),
+        .normals = configuration.normals.has_value(),
+        .positions = configuration.positions.has_value()
+    });
+}
+
+void OffScreenBuffer::bindBlit(const Configuration& configuration) const {
+    const unsigned int frameBuffer = configurationFrameBuffer(configuration);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _multiSampledFrameBuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer);
+    setDrawBuffers(_attachments);
+}
+
+unsigned int OffScreenBuffer::configurationFrameBuffer(
+                                                const Configuration& configuration) const
+{
+    for (const auto& [config, frameBuffer] : _configurations) {
+        if (config == configuration) {
+            return frameBuffer;
+        }
+    }
+
+    if (_configurations.size() >= MaxConfigurations) {
+        Log::Debug("Deleting the framebuffers of the configurations, as too many exist");
+        deleteConfigurations();
+    }
+
+    unsigned int frameBuffer = 0;
+    glGenFramebuffers(1, &frameBuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+    attachTarget(GL_COLOR_ATTACHMENT0, configuration.color);
+    if (configuration.depth) {
+        attachTarget(GL_DEPTH_ATTACHMENT, *configuration.depth);
+    }
+    else if (!_isMultiSampled) {
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER,
+            GL_DEPTH_ATTACHMENT,
+            GL_RENDERBUFFER,
+            _depthBuffer
+        );
+    }
+    if (configuration.normals) {
+        attachTarget(GL_COLOR_ATTACHMENT1, *configuration.normals);
+    }
+    if (configuration.positions) {
+        attachTarget(GL_COLOR_ATTACHMENT2, *configuration.positions);
+    }
+    _configurations.emplace_back(configuration, frameBuffer);
+    return frameBuffer;
+}
+
+void OffScreenBuffer::deleteConfigurations() const {
+    for (const auto& [config, frameBuffer] : _configurations) {
+        glDeleteFramebuffers(1, &frameBuffer);
+    }
+    _configurations.clear();
 }
 
 void OffScreenBuffer::unbind() {
@@ -259,6 +397,14 @@ void OffScreenBuffer::unbind() {
 }
 
 void OffScreenBuffer::blit() const {
+    blit(_attachments);
+}
+
+void OffScreenBuffer::blit(Attachments attachments) const {
+    attachments.depth &= _attachments.depth;
+    attachments.normals &= _attachments.normals;
+    attachments.positions &= _attachments.positions;
+
     const ivec2 src0 = ivec2{ 0, 0 };
     const ivec2 src1 = ivec2{ _size.x, _size.y };
     ivec2 dst0 = ivec2{ 0, 0 };
@@ -267,7 +413,7 @@ void OffScreenBuffer::blit() const {
     // use no interpolation since src and dst size is equal
     glReadBuffer(GL_COLOR_ATTACHMENT0);
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    if (Engine::instance().settings().useDepthTexture) {
+    if (attachments.depth) {
         glBlitFramebuffer(
             src0.x, src0.y, src1.x, src1.y,
             dst0.x, dst0.y, dst1.x, dst1.y,
@@ -282,7 +428,7 @@ void OffScreenBuffer::blit() const {
         );
     }
 
-    if (Engine::instance().settings().useNormalTexture) {
+    if (attachments.normals) {
         glReadBuffer(GL_COLOR_ATTACHMENT1);
         glDrawBuffer(GL_COLOR_ATTACHMENT1);
 
@@ -293,7 +439,7 @@ void OffScreenBuffer::blit() const {
         );
     }
 
-    if (Engine::instance().settings().usePositionTexture) {
+    if (attachments.positions) {
         glReadBuffer(GL_COLOR_ATTACHMENT2);
         glDrawBuffer(GL_COLOR_ATTACHMENT2);
 
@@ -341,4 +487,14 @@ void OffScreenBuffer::attachCubeMapDepthTexture(unsigned int texId,
     );
 }
 
+void OffScreenBuffer::attachLayeredTexture(unsigned int texId, GLenum attachment) const {
+    glFramebufferTexture(GL_FRAMEBUFFER, attachment, texId, 0);
+}
+
+void OffScreenBuffer::attachTextureLayer(unsigned int texId, int layer,
+                                         GLenum attachment) const
+{
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, texId, 0, layer);
+}
+
 } // namespace sgct
@@ -12,71 +12,28 @@
 
 #include <sgct/clustermanager.h>
 #include <sgct/log.h>
-#include <sgct/offscreenbuffer.h>
 #include <sgct/window.h>
 #include <sgct/opengl.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
 
 namespace {
-    struct FBODesc {
-        unsigned int fboID = 0;
-        unsigned int texID = 0;
-    };
-
     bool isOpenVRInitalized = false;
     vr::IVRSystem* HMD = nullptr;
 
-    FBODesc leftEyeFBODesc;
-    FBODesc rightEyeFBODesc;
-
     // Matries updated every rendering cycle
     glm::mat4 poseHMDMat = glm::mat4(1.f);
 
+    // The display timing of the HMD, which is used to predict when a frame is shown
+    float frameDuration = 0.f;
+    float vsyncToPhotons = 0.f;
+
     // Matrices updated on statup
     glm::mat4 eyeLeftProjectionMat = glm::mat4(1.f);
     glm::mat4 eyeLeftToHeadMat = glm::mat4(1.f);
     glm::mat4 eyeRightProjectionMat = glm::mat4(1.f);
     glm::mat4 eyeRightToHeadMat = glm::mat4(1.f);
 
-    bool createHMDFrameBuffer(int width, int height, FBODesc& fboDesc) {
-        glGenFramebuffers(1, &fboDesc.fboID);
-        glBindFramebuffer(GL_FRAMEBUFFER, fboDesc.fboID);
-
-        glGenTextures(1, &fboDesc.texID);
-        glBindTexture(GL_TEXTURE_2D, fboDesc.texID);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RGBA8,
-            width,
-            height,
-            0,
-            GL_RGBA,
-            GL_UNSIGNED_BYTE,
-            nullptr
-        );
-        glFramebufferTexture2D(
-            GL_FRAMEBUFFER,
-            GL_COLOR_ATTACHMENT0,
-            GL_TEXTURE_2D,
-            fboDesc.texID,
-            0
-        );
-
-        // check FBO status
-        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-        if (status != GL_FRAMEBUFFER_COMPLETE) {
-            return false;
-        }
-
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        return true;
-    }
-
     glm::mat4 convertSteamVRMatrixToMatrix4(const vr::HmdMatrix34_t& matPose) {
         glm::mat4 matrixObj(
             matPose.m[0][0], matPose.m[1][0], matPose.m[2][0], 0.f,
@@ -121,9 +78,15 @@ void initialize(float nearClip, float farClip) {
 
         Log::Info("OpenVR render dimensions per eye: %d x %d", width, height);
 
-        // Create FBO and Texture used for sending data top HMD
-        createHMDFrameBuffer(renderWidth, renderHeight, leftEyeFBODesc);
-        createHMDFrameBuffer(renderWidth, renderHeight, rightEyeFBODesc);
+        const float frequency = HMD->GetFloatTrackedDeviceProperty(
+            vr::k_unTrackedDeviceIndex_Hmd,
+            vr::Prop_DisplayFrequency_Float
+        );
+        frameDuration = frequency > 0.f ? 1.f / frequency : 0.f;
+        vsyncToPhotons = HMD->GetFloatTrackedDeviceProperty(
+            vr::k_unTrackedDeviceIndex_Hmd,
+            vr::Prop_SecondsFromVsyncToPhotons_Float
+        );
 
         std::string HMDDevice = getTrackedDeviceString(
             HMD,
@@ -157,18 +120,10 @@ void initialize(float nearClip, float farClip) {
 }
 
 void shutdown() {
-    if (isOpenVRInitalized) {
-        vr::VR_Shutdown();
-
-        glDeleteTextures(1, &leftEyeFBODesc.texID);
-        glDeleteFramebuffers(1, &leftEyeFBODesc.fboID);
-
-        glDeleteTextures(1, &rightEyeFBODesc.texID);
-        glDeleteFramebuffers(1, &rightEyeFBODesc.fboID);
-    }
-    else if (HMD) {
+    if (isOpenVRInitalized || HMD) {
         vr::VR_Shutdown();
     }
+    isOpenVRInitalized = false;
     HMD = nullptr;
 }
 
@@ -176,68 +131,32 @@ bool isHMDActive() {
     return (vr::VR_IsHmdPresent() && isOpenVRInitalized);
 }
 
-// Assuming side-by-side stereo, i.e. one FBO, one texture for both eyes
+// Assuming side-by-side stereo, i.e. one FBO, one texture for both eyes. The halves of
+// the texture are submitted directly, so the compositor samples the window's resolved
+// color texture instead of a copy of each eye
 void copyWindowToHMD(Window* win) {
     if (!isHMDActive()) {
         return;
     }
 
-    const glm::ivec2 dim = win->finalFBODimensions();
-    const int windowWidth = dim.x;
-    const int windowHeight = dim.y;
-    const int renderWidth = dim.x / 2;
-    const int renderHeight = dim.y;
-
-    // HMD Left Eye
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, win->fbo()->getBufferID());
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, leftEyeFBODesc.fboID);
-
-    glBlitFramebuffer(
-        0,
-        0,
-        renderWidth,
-        renderHeight,
-        0,
-        0,
-        renderWidth,
-        renderHeight,
-        GL_COLOR_BUFFER_BIT,
-        GL_LINEAR
-    );
-
-    vr::Texture_t leftEyeTexture = {
-        reinterpret_cast<void*>(static_cast<std::uintptr_t>(leftEyeFBODesc.texID)),
+    // abock (2019-10-20);  urgh, yes is know, but I couldn't find a cleaner way
+    vr::Texture_t texture = {
+        reinterpret_cast<void*>(
+            static_cast<std::uintptr_t>(win->frameBufferTextureEye(Eye::MonoOrLeft))
+        ),
         vr::TextureType_OpenGL,
         vr::ColorSpace_Gamma
     };
-    vr::VRCompositor()->Submit(vr::Eye_Left, &leftEyeTexture);
-
-    // HMD Right Eye
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, rightEyeFBODesc.fboID);
-
-    glBlitFramebuffer(
-        renderWidth,
-        0,
-        windowWidth,
-        windowHeight,
-        0,
-        0,
-        renderWidth,
-        renderHeight,
-        GL_COLOR_BUFFER_BIT,
-        GL_LINEAR
-    );
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    // The bounds are in texture coordinates, so they don't change with the resolution
+    constexpr vr::VRTextureBounds_t LeftHalf = { 0.f, 0.f, 0.5f, 1.f };
+    constexpr vr::VRTextureBounds_t RightHalf = { 0.5f, 0.f, 1.f, 1.f };
+    const bool isInverted = win->stereoMode() == Window::StereoMode::SideBySideInverted;
+    const vr::VRTextureBounds_t& left = isInverted ? RightHalf : LeftHalf;
+    const vr::VRTextureBounds_t& right = isInverted ? LeftHalf : RightHalf;
 
-    vr::Texture_t rightEyeTexture = {
-        // abock (2019-10-20);  urgh, yes is know, but I couldn't find a cleaner way
-        reinterpret_cast<void*>(static_cast<uintptr_t>(rightEyeFBODesc.texID)),
-        vr::TextureType_OpenGL,
-        vr::ColorSpace_Gamma
-    };
-    vr::VRCompositor()->Submit(vr::Eye_Right, &rightEyeTexture);
+    vr::VRCompositor()->Submit(vr::Eye_Left, &texture, &left);
+    vr::VRCompositor()->Submit(vr::Eye_Right, &texture, &right);
 }
 
 glm::mat4 currentViewProjectionMatrix(Frustum::Mode nEye) {
@@ -283,22 +202,45 @@ std::string trackedDeviceString(vr::IVRSystem* pHmd, vr::TrackedDeviceIndex_t un
     return pchBuffer.data();
 }
 
+void waitForPoses() {
+    if (!isHMDActive()) {
+        return;
+    }
+
+    // The poses that are returned here are predicted for the time at which the wait
+    // ended, which is too early for a frame that still runs its PreSync and sync stages.
+    // The wait is only used to pace the frames to the compositor
+    vr::VRCompositor()->WaitGetPoses(nullptr, 0, nullptr, 0);
+}
+
 void updatePoses() {
     if (!HMD) {
         return;
     }
 
+    // The frame will be shown at the next vsync after it was submitted, so the poses are
+    // predicted for the time at which that vsync's photons leave the display. A frame
+    // that is already late for the next vsync is shown one frame later
+    float secondsSinceLastVsync = 0.f;
+    uint64_t frameCounter = 0;
+    HMD->GetTimeSinceLastVsync(&secondsSinceLastVsync, &frameCounter);
+    float untilVsync = frameDuration - secondsSinceLastVsync;
+    if (untilVsync < 0.f) {
+        untilVsync += frameDuration;
+    }
+    const float predictedSecondsFromNow = std::max(untilVsync, 0.f) + vsyncToPhotons;
+
     // abock, 2019-09-11; This deviceClassChar value is not actually used anywhere, but I
     // didn't feel like I wanted to remove it, but I think it ought to be
     //char deviceClassChar[vr::k_unMaxTrackedDeviceCount];
     glm::mat4 devicePoseMat[vr::k_unMaxTrackedDeviceCount];
 
     vr::TrackedDevicePose_t trackedDevicePose[vr::k_unMaxTrackedDeviceCount];
-    vr::VRCompositor()->WaitGetPoses(
+    HMD->GetDeviceToAbsoluteTrackingPose(
+        vr::VRCompositor()->GetTrackingSpace(),
+        predictedSecondsFromNow,
         trackedDevicePose,
-        vr::k_unMaxTrackedDeviceCount,
-        nullptr,
-        0
+        vr::k_unMaxTrackedDeviceCount
     );
 
     for (int nDevice = 0; nDevice < vr::k_unMaxTrackedDeviceCount; ++nDevice) {
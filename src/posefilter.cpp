@@ -0,0 +1,262 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/posefilter.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    // Samples that are closer together than this arrived in the same burst and are too
+    // close to estimate the motion of the sensor from
+    constexpr double MinInterval = 1e-4;
+
+    // After a longer gap, the motion before it says nothing about the next sample
+    constexpr double MaxInterval = 0.5;
+
+    // The cutoff frequency in Hz of the accelerations, which are the differences of
+    // consecutive velocities and would otherwise be dominated by the noise
+    constexpr double AccelerationCutoff = 5.0;
+
+    // The variance of the velocity in (m/s)^2 or (rad/s)^2 before the second sample
+    constexpr double InitialVelocityVariance = 1.0;
+
+    glm::dvec3 toGlm(const sgct::vec3& v) {
+        return glm::dvec3(v.x, v.y, v.z);
+    }
+
+    glm::dquat toGlm(const sgct::quat& q) {
+        return glm::dquat(q.w, q.x, q.y, q.z);
+    }
+
+    sgct::vec3 fromGlm(const glm::dvec3& v) {
+        return sgct::vec3{
+            static_cast<float>(v.x),
+            static_cast<float>(v.y),
+            static_cast<float>(v.z)
+        };
+    }
+
+    sgct::quat fromGlm(const glm::dquat& q) {
+        return sgct::quat(
+            static_cast<float>(q.x),
+            static_cast<float>(q.y),
+            static_cast<float>(q.z),
+            static_cast<float>(q.w)
+        );
+    }
+
+    // The axis of the shortest rotation that is described by q, scaled by its angle
+    glm::dvec3 rotationVector(glm::dquat q) {
+        if (q.w < 0.0) {
+            q = -q;
+        }
+        const glm::dvec3 v = glm::dvec3(q.x, q.y, q.z);
+        const double s = glm::length(v);
+        if (s < 1e-12) {
+            return 2.0 * v;
+        }
+        return v * (2.0 * std::atan2(s, q.w) / s);
+    }
+
+    glm::dquat fromRotationVector(const glm::dvec3& v) {
+        const double angle = glm::length(v);
+        if (angle < 1e-12) {
+            return glm::normalize(glm::dquat(1.0, 0.5 * v.x, 0.5 * v.y, 0.5 * v.z));
+        }
+        return glm::angleAxis(angle, v / angle);
+    }
+
+    // The rotation from a to b, applied on the side of the tracker
+    glm::dvec3 rotationBetween(const glm::dquat& a, const glm::dquat& b) {
+        return rotationVector(b * glm::inverse(a));
+    }
+
+    // The weight of a new sample in an exponential low-pass filter with the cutoff
+    // frequency in Hz, for samples that are dt seconds apart
+    double smoothingFactor(double dt, double cutoff) {
+        const double tau = 1.0 / (2.0 * std::numbers::pi * cutoff);
+        return 1.0 / (1.0 + tau / dt);
+    }
+} // namespace
+
+namespace sgct {
+
+PoseFilter::PoseFilter(std::optional<config::Tracker::Device::Filter> filter) {
+    if (!filter) {
+        return;
+    }
+
+    _type = filter->type;
+    _minCutoff = filter->minCutoff.value_or(_minCutoff);
+    _beta = filter->beta.value_or(_beta);
+    _derivativeCutoff = filter->derivativeCutoff.value_or(_derivativeCutoff);
+    _processNoise = filter->processNoise.value_or(_processNoise);
+    _measurementNoise = filter->measurementNoise.value_or(_measurementNoise);
+}
+
+PoseFilter::State PoseFilter::update(double time, vec3 position, quat rotation) {
+    const double dt = time - _time;
+    if (!_hasSample || dt > MaxInterval) {
+        reset(time, position, rotation);
+        return _state;
+    }
+    if (dt < MinInterval) {
+        // Only the unfiltered pose follows the latest sample of a burst, as the filters
+        // would treat the gap as a sudden jump of the sensor
+        if (!_type) {
+            _state.position = position;
+            _state.rotation = rotation;
+        }
+        return _state;
+    }
+
+    const glm::dvec3 velocity = toGlm(_state.velocity);
+    const glm::dvec3 angularVelocity = toGlm(_state.angularVelocity);
+
+    if (!_type) {
+        _state.velocity = fromGlm((toGlm(position) - toGlm(_state.position)) / dt);
+        _state.angularVelocity = fromGlm(
+            rotationBetween(toGlm(_state.rotation), toGlm(rotation)) / dt
+        );
+        _state.position = position;
+        _state.rotation = rotation;
+    }
+    else if (*_type == config::Tracker::Device::Filter::Type::OneEuro) {
+        updateOneEuro(dt, position, rotation);
+    }
+    else {
+        updateKalman(dt, position, rotation);
+    }
+
+    const double a = smoothingFactor(dt, AccelerationCutoff);
+    _state.acceleration = fromGlm(glm::mix(
+        toGlm(_state.acceleration),
+        (toGlm(_state.velocity) - velocity) / dt,
+        a
+    ));
+    _state.angularAcceleration = fromGlm(glm::mix(
+        toGlm(_state.angularAcceleration),
+        (toGlm(_state.angularVelocity) - angularVelocity) / dt,
+        a
+    ));
+
+    _time = time;
+    _samplePosition = position;
+    _sampleRotation = rotation;
+    return _state;
+}
+
+PoseFilter::State PoseFilter::extrapolate(const State& state, double dt,
+                                          bool useAcceleration)
+{
+    glm::dvec3 translation = toGlm(state.velocity) * dt;
+    glm::dvec3 rotation = toGlm(state.angularVelocity) * dt;
+    if (useAcceleration) {
+        translation += 0.5 * toGlm(state.acceleration) * dt * dt;
+        rotation += 0.5 * toGlm(state.angularAcceleration) * dt * dt;
+    }
+
+    State res = state;
+    res.position = fromGlm(toGlm(state.position) + translation);
+    res.rotation = fromGlm(
+        glm::normalize(fromRotationVector(rotation) * toGlm(state.rotation))
+    );
+    return res;
+}
+
+void PoseFilter::reset(double time, vec3 position, quat rotation) {
+    _hasSample = true;
+    _time = time;
+    _state = State{ .position = position, .rotation = rotation };
+    _samplePosition = position;
+    _sampleRotation = rotation;
+
+    const Covariance covariance = {
+        .position = _measurementNoise,
+        .positionVelocity = 0.0,
+        .velocity = InitialVelocityVariance
+    };
+    _positionCovariance = covariance;
+    _rotationCovariance = covariance;
+}
+
+void PoseFilter::updateOneEuro(double dt, vec3 position, quat rotation) {
+    // The speed is estimated from the previous sample and smoothed on its own, so that
+    // the noise of the samples does not open the cutoff frequency of the pose
+    const double d = smoothingFactor(dt, _derivativeCutoff);
+    const glm::dvec3 velocity = glm::mix(
+        toGlm(_state.velocity),
+        (toGlm(position) - toGlm(_samplePosition)) / dt,
+        d
+    );
+    const glm::dvec3 angularVelocity = glm::mix(
+        toGlm(_state.angularVelocity),
+        rotationBetween(toGlm(_sampleRotation), toGlm(rotation)) / dt,
+        d
+    );
+
+    const double p = smoothingFactor(dt, _minCutoff + _beta * glm::length(velocity));
+    const double r =
+        smoothingFactor(dt, _minCutoff + _beta * glm::length(angularVelocity));
+
+    _state.position = fromGlm(glm::mix(toGlm(_state.position), toGlm(position), p));
+    _state.rotation = fromGlm(glm::slerp(toGlm(_state.rotation), toGlm(rotation), r));
+    _state.velocity = fromGlm(velocity);
+    _state.angularVelocity = fromGlm(angularVelocity);
+}
+
+void PoseFilter::updateKalman(double dt, vec3 position, quat rotation) {
+    // All axes have the same noise and are measured together, so they share one
+    // covariance. The rotation is corrected around its prediction, where the error is
+    // small enough to be treated as a vector
+    const auto [kPosition, kVelocity] = kalmanGain(_positionCovariance, dt);
+    const glm::dvec3 velocity = toGlm(_state.velocity);
+    const glm::dvec3 predicted = toGlm(_state.position) + velocity * dt;
+    const glm::dvec3 residual = toGlm(position) - predicted;
+    _state.position = fromGlm(predicted + kPosition * residual);
+    _state.velocity = fromGlm(velocity + kVelocity * residual);
+
+    const auto [kRotation, kAngularVelocity] = kalmanGain(_rotationCovariance, dt);
+    const glm::dvec3 angularVelocity = toGlm(_state.angularVelocity);
+    const glm::dquat predictedRotation = glm::normalize(
+        fromRotationVector(angularVelocity * dt) * toGlm(_state.rotation)
+    );
+    const glm::dvec3 rotationResidual =
+        rotationBetween(predictedRotation, toGlm(rotation));
+    _state.rotation = fromGlm(glm::normalize(
+        fromRotationVector(kRotation * rotationResidual) * predictedRotation
+    ));
+    _state.angularVelocity =
+        fromGlm(angularVelocity + kAngularVelocity * rotationResidual);
+}
+
+std::pair<double, double> PoseFilter::kalmanGain(Covariance& covariance, double dt) const
+{
+    // Predict with the constant velocity model, whose process noise is a random
+    // acceleration with the spectral density _processNoise
+    const double q = _processNoise;
+    const double p00 = covariance.position + 2.0 * dt * covariance.positionVelocity +
+                       dt * dt * covariance.velocity + q * dt * dt * dt / 3.0;
+    const double p01 = covariance.positionVelocity + dt * covariance.velocity +
+                       q * dt * dt / 2.0;
+    const double p11 = covariance.velocity + q * dt;
+
+    // Update with the measured value
+    const double s = p00 + _measurementNoise;
+    const double k0 = p00 / s;
+    const double k1 = p01 / s;
+    covariance.position = (1.0 - k0) * p00;
+    covariance.positionVelocity = (1.0 - k0) * p01;
+    covariance.velocity = p11 - k1 * p01;
+    return { k0, k1 };
+}
+
+} // namespace sgct
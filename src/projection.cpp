@@ -27,6 +27,21 @@ namespace sgct {
 void Projection::calculateProjection(vec3 base, const ProjectionPlane& proj,
                                      float nearClip, float farClip, vec3 offset)
 {
+    const Parameters parameters = {
+        base,
+        offset,
+        proj.coordinateLowerLeft(),
+        proj.coordinateUpperLeft(),
+        proj.coordinateUpperRight(),
+        nearClip,
+        farClip
+    };
+    if (_parameters == parameters) {
+        return;
+    }
+    _parameters = parameters;
+    _sceneTransform = std::nullopt;
+
     const glm::vec3 b = glm::make_vec3(&base.x);
     const glm::vec3 o = glm::make_vec3(&offset.x);
 
@@ -91,6 +106,14 @@ const mat4& Projection::viewProjectionMatrix() const {
     return _viewProjectionMatrix;
 }
 
+const mat4& Projection::viewProjectionMatrix(const mat4& sceneTransform) const {
+    if (_sceneTransform != sceneTransform) {
+        _sceneViewProjectionMatrix = _viewProjectionMatrix * sceneTransform;
+        _sceneTransform = sceneTransform;
+    }
+    return _sceneViewProjectionMatrix;
+}
+
 const mat4& Projection::viewMatrix() const {
     return _viewMatrix;
 }
@@ -8,12 +8,15 @@
 
 #include <sgct/projection/cubemap.h>
 
+#include <sgct/engine.h>
 #include <sgct/internalshaders.h>
 #include <sgct/log.h>
+#include <sgct/memorytracker.h>
 #include <sgct/offscreenbuffer.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
 
 #ifdef SGCT_HAS_SPOUT
 #ifndef WIN32_LEAN_AND_MEAN
@@ -23,9 +26,41 @@
 #define NOMINMAX
 #endif // NOMINMAX
 #include <SpoutLibrary.h>
+#include <sgct/spoutsharedtexture.h>
 #endif // SGCT_HAS_SPOUT
 
 namespace {
+#ifdef SGCT_HAS_NDI
+    // The time in nanoseconds that is waited at most for a cube face download
+    constexpr GLuint64 FenceTimeout = 1'000'000'000;
+
+    // Converts two neighboring pixels of the face into the U, Y0, V, and Y1 bytes of the
+    // UYVY format, using the limited range BT.709 coefficients that NDI expects for HD
+    // video. The chroma is the average of both pixels
+    constexpr std::string_view UyvyFragmentShader = R"(
+  #version 330 core
+
+  out vec4 out_uyvy;
+
+  uniform sampler2D face;
+
+  float luma(vec3 c) {
+    return (16.0 + 219.0 * dot(c, vec3(0.2126, 0.7152, 0.0722))) / 255.0;
+  }
+
+  void main() {
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    vec3 c0 = clamp(texelFetch(face, ivec2(2 * p.x, p.y), 0).rgb, 0.0, 1.0);
+    vec3 c1 = clamp(texelFetch(face, ivec2(2 * p.x + 1, p.y), 0).rgb, 0.0, 1.0);
+    vec3 c = 0.5 * (c0 + c1);
+
+    float u = (128.0 + 224.0 * dot(c, vec3(-0.1146, -0.3854, 0.5))) / 255.0;
+    float v = (128.0 + 224.0 * dot(c, vec3(0.5, -0.4542, -0.0458))) / 255.0;
+    out_uyvy = vec4(u, luma(c0), v, luma(c1));
+  }
+)";
+#endif // SGCT_HAS_NDI
+
     constexpr std::string_view FragmentShader = R"(
   #version 330 core
 
@@ -76,22 +111,44 @@ CubemapProjection::CubemapProjection(const config::CubemapProjection& config,
                                      const Window& parent, User& user)
     : NonLinearProjection(parent)
     , _cubeFaces{
-        Cubeface { config.channels ? config.channels->right : true },
-        Cubeface { config.channels ? config.channels->left : true },
-        Cubeface { config.channels ? config.channels->bottom : true },
-        Cubeface { config.channels ? config.channels->top : true },
-        Cubeface { config.channels ? config.channels->zLeft : true },
-        Cubeface { config.channels ? config.channels->zRight : true },
+        Cubeface {
+            config.channels ? config.channels->right : true,
+            config.outputIntervals ? config.outputIntervals->right.value_or(1) : 1
+        },
+        Cubeface {
+            config.channels ? config.channels->left : true,
+            config.outputIntervals ? config.outputIntervals->left.value_or(1) : 1
+        },
+        Cubeface {
+            config.channels ? config.channels->bottom : true,
+            config.outputIntervals ? config.outputIntervals->bottom.value_or(1) : 1
+        },
+        Cubeface {
+            config.channels ? config.channels->top : true,
+            config.outputIntervals ? config.outputIntervals->top.value_or(1) : 1
+        },
+        Cubeface {
+            config.channels ? config.channels->zLeft : true,
+            config.outputIntervals ? config.outputIntervals->zLeft.value_or(1) : 1
+        },
+        Cubeface {
+            config.channels ? config.channels->zRight : true,
+            config.outputIntervals ? config.outputIntervals->zRight.value_or(1) : 1
+        },
     }
 #ifdef SGCT_HAS_SPOUT
     , _spoutEnabled(config.spout ? config.spout->enabled : false)
     , _spoutName(config.spout ? config.spout->name.value_or("") : "")
+    , _spoutUseSharedTexture(
+        config.spout ? config.spout->sharedTexture.value_or(false) : false
+    )
 #endif // SGCT_HAS_SPOUT
 #ifdef SGCT_HAS_NDI
     , _ndiEnabled(config.ndi ? config.ndi->enabled : false)
     , _ndiName(config.ndi ? config.ndi->name.value_or("OpenSpace") : "OpenSpace")
     , _ndiGroups(config.ndi ? config.ndi->groups.value_or("") : "")
 #endif // SGCT_HAS_NDI
+    , _skipUnsentFaces(config.skipUnsentFaces.value_or(false))
     , _rigOrientation(config.orientation.value_or(vec3{ 0.f, 0.f, 0.f }))
 {
     setUser(user);
@@ -103,10 +160,11 @@ CubemapProjection::CubemapProjection(const config::CubemapProjection& config,
 }
 
 CubemapProjection::~CubemapProjection() {
-    for (const Cubeface& info : _cubeFaces) {
+    for (Cubeface& info : _cubeFaces) {
         glDeleteTextures(1, &info.texture);
 
 #ifdef SGCT_HAS_SPOUT
+        info.spout.sharedTexture = nullptr;
         if (info.spout.handle) {
             reinterpret_cast<SPOUTHANDLE>(info.spout.handle)->ReleaseSender();
             reinterpret_cast<SPOUTHANDLE>(info.spout.handle)->Release();
@@ -121,9 +179,25 @@ CubemapProjection::~CubemapProjection() {
             NDIlib_send_send_video_async_v2(info.ndi.handle, nullptr);
             NDIlib_send_destroy(info.ndi.handle);
         }
+
+        for (const auto& readback : info.ndi.readbacks) {
+            glDeleteSync(readback.fence);
+            if (readback.mapping) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &readback.pbo);
+        }
+        glDeleteTextures(1, &info.ndi.uyvyTexture);
 #endif // SGCT_HAS_NDI
     }
 
+#ifdef SGCT_HAS_NDI
+    glDeleteFramebuffers(1, &_ndiFbo);
+    _ndiShader.deleteProgram();
+#endif // SGCT_HAS_NDI
+
     glDeleteFramebuffers(1, &_blitFbo);
 
     glDeleteBuffers(1, &_vbo);
@@ -131,7 +205,7 @@ CubemapProjection::~CubemapProjection() {
     _shader.deleteProgram();
 }
 
-void CubemapProjection::update(const vec2&) const {}
+void CubemapProjection::update(const vec2&) {}
 
 void CubemapProjection::render(const BaseViewport& viewport,
                                FrustumMode frustumMode) const
@@ -167,13 +241,50 @@ void CubemapProjection::render(const BaseViewport& viewport,
 
     ShaderProgram::unbind();
 
+#ifdef SGCT_HAS_NDI
+    if (_ndiEnabled && _ndiUseUyvy) {
+        ZoneScopedN("Convert NDI faces");
+
+        GLint prevFbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFbo);
+        std::array<GLint, 4> prevViewport;
+        glGetIntegerv(GL_VIEWPORT, prevViewport.data());
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _ndiFbo);
+        glViewport(0, 0, _cubemapResolution.x / 2, _cubemapResolution.y);
+        _ndiShader.bind();
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(_vao);
+        for (const Cubeface& face : _cubeFaces) {
+            if (!face.isSent || !face.ndi.isConnected) {
+                continue;
+            }
+
+            glFramebufferTexture2D(
+                GL_DRAW_FRAMEBUFFER,
+                GL_COLOR_ATTACHMENT0,
+                GL_TEXTURE_2D,
+                face.ndi.uyvyTexture,
+                0
+            );
+            glBindTexture(GL_TEXTURE_2D, face.texture);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+        glBindVertexArray(0);
+        ShaderProgram::unbind();
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFbo);
+        glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    }
+#endif // SGCT_HAS_NDI
+
     for (int i = 0; i < 6; i++) {
-        if (!_cubeFaces[i].enabled) {
+        if (!_cubeFaces[i].isSent) {
             continue;
         }
 
 #ifdef SGCT_HAS_SPOUT
-        if (_spoutEnabled) {
+        if (_spoutEnabled && !_cubeFaces[i].spout.sharedTexture) {
             glBindTexture(GL_TEXTURE_2D, _cubeFaces[i].texture);
             SPOUTHANDLE h = reinterpret_cast<SPOUTHANDLE>(_cubeFaces[i].spout.handle);
             const bool s = h->SendTexture(
@@ -191,40 +302,62 @@ void CubemapProjection::render(const BaseViewport& viewport,
 #endif // SGCT_HAS_SPOUT
 
 #ifdef SGCT_HAS_NDI
-        if (_ndiEnabled) {
-            // Download the texture data from the GPU
-            glBindTexture(GL_TEXTURE_2D, _cubeFaces[i].texture);
-            glGetTexImage(
-                GL_TEXTURE_2D,
-                0,
-                GL_RGBA,
-                GL_UNSIGNED_BYTE,
-                _cubeFaces[i].ndi.currentVideoBuffer->data()
-            );
+        if (_ndiEnabled && _cubeFaces[i].ndi.isConnected) {
+            auto& ndi = _cubeFaces[i].ndi;
+            const size_t size = ndi.videoBufferPing.size();
+
+            // The oldest download is sent first. This releases the buffer that NDI has
+            // held on to since the previous send, which is the one written to below
+            auto& oldest = ndi.readbacks[(ndi.nextReadback + 1) % ndi.readbacks.size()];
+            if (oldest.fence) {
+                // The download was started two frames ago, so this rarely has to wait
+                glClientWaitSync(oldest.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+                glDeleteSync(oldest.fence);
+                oldest.fence = nullptr;
+
+                std::byte* data = oldest.mapping;
+                if (!data) {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, oldest.pbo);
+                    const void* mapped =
+                        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+                    if (mapped) {
+                        std::memcpy(ndi.currentVideoBuffer->data(), mapped, size);
+                    }
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    data = ndi.currentVideoBuffer->data();
+
+                    // Switch the current buffer
+                    ndi.currentVideoBuffer =
+                        ndi.currentVideoBuffer == &ndi.videoBufferPing ?
+                        &ndi.videoBufferPong :
+                        &ndi.videoBufferPing;
+                }
 
-            // We are using a negative line stride to correct for the y-axis flip going
-            // from OpenGL to DirectX. So our start point has to be the beginning of the
-            // *last* line of the image as NDI then steps backwards through the image to
-            // send it to the receiver.
-            // So we start at data() (=0), move to the end (+size) and then backtrack one
-            // line (- -line_stride = +line_stride)
-            _cubeFaces[i].ndi.videoFrame.p_data = reinterpret_cast<uint8_t*>(
-                _cubeFaces[i].ndi.currentVideoBuffer->data() +
-                _cubeFaces[i].ndi.currentVideoBuffer->size() +
-                _cubeFaces[i].ndi.videoFrame.line_stride_in_bytes
-            );
+                // We are using a negative line stride to correct for the y-axis flip
+                // going from OpenGL to DirectX. So our start point has to be the
+                // beginning of the *last* line of the image as NDI then steps backwards
+                // through the image to send it to the receiver.
+                // So we start at data (=0), move to the end (+size) and then backtrack
+                // one line (- -line_stride = +line_stride)
+                ndi.videoFrame.p_data = reinterpret_cast<uint8_t*>(
+                    data + size + ndi.videoFrame.line_stride_in_bytes
+                );
 
-            NDIlib_send_send_video_async_v2(
-                _cubeFaces[i].ndi.handle,
-                &_cubeFaces[i].ndi.videoFrame
-            );
+                NDIlib_send_send_video_async_v2(ndi.handle, &ndi.videoFrame);
+            }
 
-            // Switch the current buffer
-            _cubeFaces[i].ndi.currentVideoBuffer =
-                _cubeFaces[i].ndi.currentVideoBuffer ==
-                    &_cubeFaces[i].ndi.videoBufferPing ?
-                &_cubeFaces[i].ndi.videoBufferPong :
-                &_cubeFaces[i].ndi.videoBufferPing;
+            // Start downloading the texture data from the GPU without waiting for it
+            auto& current = ndi.readbacks[ndi.nextReadback];
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, current.pbo);
+            glBindTexture(
+                GL_TEXTURE_2D,
+                _ndiUseUyvy ? ndi.uyvyTexture : _cubeFaces[i].texture
+            );
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            current.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            ndi.nextReadback = (ndi.nextReadback + 1) % ndi.readbacks.size();
         }
 #endif // SGCT_HAS_NDI
     }
@@ -234,6 +367,10 @@ void CubemapProjection::setSpoutRigOrientation(vec3 orientation) {
     _rigOrientation = std::move(orientation);
 }
 
+bool CubemapProjection::supportsLayeredRendering() const {
+    return true;
+}
+
 void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int format,
                                          unsigned int type)
 {
@@ -241,6 +378,16 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
 
     Log::Debug("CubemapProjection initTextures");
 
+#ifdef SGCT_HAS_NDI
+    _ndiUseUyvy = _ndiEnabled && _cubemapResolution.x % 2 == 0;
+    if (_ndiEnabled && !_ndiUseUyvy) {
+        Log::Warning(std::format(
+            "Cubemap resolution {} is odd, so the NDI stream is sent as RGBX",
+            _cubemapResolution.x
+        ));
+    }
+#endif // SGCT_HAS_NDI
+
     for (int i = 0; i < 6; i++) {
         Log::Debug(std::format("CubemapProjection initTextures {}", i));
         if (!_cubeFaces[i].enabled) {
@@ -268,6 +415,10 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
             type,
             nullptr
         );
+        _textureMemory.add(
+            static_cast<size_t>(_cubemapResolution.x) * _cubemapResolution.y *
+            MemoryTracker::bytesPerTexel(internalFormat)
+        );
 
 #ifdef SGCT_HAS_SPOUT
         if (_spoutEnabled) {
@@ -292,6 +443,10 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
                         "Error creating SPOUT handle for {}", CubeMapFaceName[i]
                     ));
                 }
+                else if (_spoutUseSharedTexture) {
+                    _cubeFaces[i].spout.sharedTexture =
+                        SpoutSharedTexture::open(h, fullName);
+                }
             }
         }
 #endif // SGCT_HAS_SPOUT
@@ -317,10 +472,13 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
 
             _cubeFaces[i].ndi.videoFrame.xres = _cubemapResolution.x;
             _cubeFaces[i].ndi.videoFrame.yres = _cubemapResolution.y;
-            _cubeFaces[i].ndi.videoFrame.FourCC = NDIlib_FourCC_type_RGBX;
+            _cubeFaces[i].ndi.videoFrame.FourCC =
+                _ndiUseUyvy ? NDIlib_FourCC_type_UYVY : NDIlib_FourCC_type_RGBX;
             // We have a negative stride to account for the fact that OpenGL textures have
             // their y-axis flipped compared to DirectX textures
-            _cubeFaces[i].ndi.videoFrame.line_stride_in_bytes = -_cubemapResolution.x * 4;
+            const int bytesPerPixel = _ndiUseUyvy ? 2 : 4;
+            _cubeFaces[i].ndi.videoFrame.line_stride_in_bytes =
+                -_cubemapResolution.x * bytesPerPixel;
             _cubeFaces[i].ndi.videoFrame.frame_rate_N = 60000; // 60 fps
             _cubeFaces[i].ndi.videoFrame.frame_rate_D = 1000;  // 60 fps
             _cubeFaces[i].ndi.videoFrame.picture_aspect_ratio = 1.f;
@@ -329,13 +487,51 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
             _cubeFaces[i].ndi.videoFrame.timecode = 0;
 
             _cubeFaces[i].ndi.videoBufferPing.resize(
-                _cubemapResolution.x * _cubemapResolution.y * 4
+                _cubemapResolution.x * _cubemapResolution.y * bytesPerPixel
             );
             _cubeFaces[i].ndi.videoBufferPong.resize(
-                _cubemapResolution.x * _cubemapResolution.y * 4
+                _cubemapResolution.x * _cubemapResolution.y * bytesPerPixel
             );
 
+            if (_ndiUseUyvy) {
+                glGenTextures(1, &_cubeFaces[i].ndi.uyvyTexture);
+                glBindTexture(GL_TEXTURE_2D, _cubeFaces[i].ndi.uyvyTexture);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                glTexImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    GL_RGBA8,
+                    _cubemapResolution.x / 2,
+                    _cubemapResolution.y,
+                    0,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    nullptr
+                );
+            }
+
             _cubeFaces[i].ndi.currentVideoBuffer = &_cubeFaces[i].ndi.videoBufferPing;
+
+            // Persistently mapped buffers let NDI read the downloaded data in place,
+            // otherwise the data is copied into the ping-pong buffers
+            const size_t size = _cubeFaces[i].ndi.videoBufferPing.size();
+            for (auto& readback : _cubeFaces[i].ndi.readbacks) {
+                glGenBuffers(1, &readback.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                if (GLAD_GL_VERSION_4_4) {
+                    constexpr GLbitfield Flags =
+                        GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                    glBufferStorage(GL_PIXEL_PACK_BUFFER, size, nullptr, Flags);
+                    readback.mapping = reinterpret_cast<std::byte*>(
+                        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, Flags)
+                    );
+                }
+                else {
+                    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+                }
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         }
 #endif // SGCT_HAS_NDI
     }
@@ -537,6 +733,18 @@ void CubemapProjection::initShaders() {
     glUniform1i(glGetUniformLocation(_shader.id(), "zRight"), 5);
 
     ShaderProgram::unbind();
+
+#ifdef SGCT_HAS_NDI
+    if (_ndiEnabled) {
+        _ndiShader = ShaderProgram("CubemapNdiShader");
+        _ndiShader.addVertexShader(shaders::BaseVert);
+        _ndiShader.addFragmentShader(UyvyFragmentShader);
+        _ndiShader.createAndLinkProgram();
+        _ndiShader.bind();
+        glUniform1i(glGetUniformLocation(_ndiShader.id(), "face"), 0);
+        ShaderProgram::unbind();
+    }
+#endif // SGCT_HAS_NDI
 }
 
 void CubemapProjection::initFBO(unsigned int internalFormat, int nSamples) {
@@ -545,18 +753,61 @@ void CubemapProjection::initFBO(unsigned int internalFormat, int nSamples) {
     _spoutFBO = std::make_unique<OffScreenBuffer>(internalFormat);
     _spoutFBO->createFBO(_cubemapResolution.x, _cubemapResolution.y, 1);
     glGenFramebuffers(1, &_blitFbo);
+
+#ifdef SGCT_HAS_NDI
+    if (_ndiEnabled) {
+        glGenFramebuffers(1, &_ndiFbo);
+    }
+#endif // SGCT_HAS_NDI
 }
 
-void CubemapProjection::renderCubemap(FrustumMode frustumMode) const {
+void CubemapProjection::updateSentFaces() const {
     ZoneScoped;
 
-    auto render = [this](const BaseViewport& vp, int index, FrustumMode mode) {
-        if (!_cubeFaces[index].enabled) {
-            return;
+    bool hasOutput = false;
+#ifdef SGCT_HAS_SPOUT
+    hasOutput |= _spoutEnabled;
+#endif // SGCT_HAS_SPOUT
+#ifdef SGCT_HAS_NDI
+    hasOutput |= _ndiEnabled;
+#endif // SGCT_HAS_NDI
+
+    const unsigned int frame = Engine::instance().clusterFrameNumber();
+    for (const Cubeface& face : _cubeFaces) {
+        const bool isDue =
+            frame % static_cast<unsigned int>(face.outputInterval) == 0;
+
+        // Spout does not report its receivers, so its faces are always sent
+        bool hasReceiver = false;
+#ifdef SGCT_HAS_SPOUT
+        hasReceiver |= _spoutEnabled;
+#endif // SGCT_HAS_SPOUT
+#ifdef SGCT_HAS_NDI
+        if (_ndiEnabled && face.ndi.handle) {
+            const bool isConnected =
+                NDIlib_send_get_no_connections(face.ndi.handle, 0) > 0;
+            if (!isConnected && face.ndi.isConnected) {
+                // The pending downloads would be stale once a receiver connects again
+                for (auto& readback : face.ndi.readbacks) {
+                    glDeleteSync(readback.fence);
+                    readback.fence = nullptr;
+                }
+            }
+            face.ndi.isConnected = isConnected;
+            hasReceiver |= isConnected;
         }
+#endif // SGCT_HAS_NDI
+
+        face.isSent = face.enabled && (!hasOutput || (isDue && hasReceiver));
+    }
+}
+
+void CubemapProjection::renderCubemap(FrustumMode frustumMode) const {
+    ZoneScoped;
 
-        renderCubeFace(vp, index, mode);
+    updateSentFaces();
 
+    auto copyFace = [this](int index) {
         glBindTexture(GL_TEXTURE_2D, 0);
 
         glBindFramebuffer(GL_FRAMEBUFFER, _blitFbo);
@@ -587,9 +838,67 @@ void CubemapProjection::renderCubemap(FrustumMode frustumMode) const {
             GL_COLOR_BUFFER_BIT,
             GL_NEAREST
         );
+
+#ifdef SGCT_HAS_SPOUT
+        SpoutSharedTexture* shared = _cubeFaces[index].spout.sharedTexture.get();
+        if (shared && _cubeFaces[index].isSent && shared->lock()) {
+            glFramebufferTexture2D(
+                GL_DRAW_FRAMEBUFFER,
+                GL_COLOR_ATTACHMENT1,
+                GL_TEXTURE_2D,
+                shared->texture(),
+                0
+            );
+            // DirectX stores the rows from the top, so the face is flipped
+            glBlitFramebuffer(
+                0,
+                0,
+                _cubemapResolution.x,
+                _cubemapResolution.y,
+                0,
+                _cubemapResolution.y,
+                _cubemapResolution.x,
+                0,
+                GL_COLOR_BUFFER_BIT,
+                GL_NEAREST
+            );
+            shared->unlock();
+        }
+#endif // SGCT_HAS_SPOUT
+
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     };
 
+    if (_isLayered) {
+        uint8_t faceMask = 0;
+        for (int i = 0; i < 6; i++) {
+            if (_cubeFaces[i].enabled && (!_skipUnsentFaces || _cubeFaces[i].isSent)) {
+                faceMask |= 1 << i;
+            }
+        }
+        faceMask &= enabledFaces();
+
+        renderCubeFacesLayered(frustumMode, faceMask);
+        for (int i = 0; i < 6; i++) {
+            if (faceMask & (1 << i)) {
+                copyFace(i);
+            }
+        }
+        return;
+    }
+
+    auto render = [this, &copyFace](const BaseViewport& vp, int index, FrustumMode mode) {
+        if (!_cubeFaces[index].enabled ||
+            (_skipUnsentFaces && !_cubeFaces[index].isSent))
+        {
+            return;
+        }
+
+        if (renderCubeFace(vp, index, mode)) {
+            copyFace(index);
+        }
+    };
+
     render(_subViewports.right, 0, frustumMode);
     render(_subViewports.left, 1, frustumMode);
     render(_subViewports.bottom, 2, frustumMode);
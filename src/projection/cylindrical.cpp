@@ -19,6 +19,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
 
 namespace {
     constexpr std::string_view FragmentShader = R"(
@@ -28,21 +32,33 @@ namespace {
   out vec4 out_diffuse;
 
   uniform samplerCube cubemap;
+
+  vec3 direction(vec2 uv);
+
+  void main() {
+    out_diffuse = texture(cubemap, direction(tr_uv));
+  }
+)";
+
+    constexpr std::string_view DirectionFunction = R"(
+  #version 330 core
+
   uniform float rotation;
   uniform float heightOffset;
 
   const float PI = 3.141592654;
 
-  void main() {
-    vec2 pixelNormalized = tr_uv;
-    float angle = 2.0 * PI * pixelNormalized.x;
+  vec3 direction(vec2 uv) {
+    float angle = 2.0 * PI * uv.x;
     vec2 direction = vec2(cos(-angle + rotation), sin(-angle + rotation));
-
-    vec3 sample = (vec3(direction, pixelNormalized.y + heightOffset));
-    out_diffuse = texture(cubemap, sample);
+    return vec3(direction, uv.y + heightOffset);
   }
 )";
 
+    // Dense enough that neighboring directions are about 1.4 degrees apart around the
+    // cylinder
+    constexpr int DirectionSamples = 256;
+
     struct Vertex {
         float x;
         float y;
@@ -60,6 +76,10 @@ CylindricalProjection::CylindricalProjection(const config::CylindricalProjection
     , _rotation(config.rotation.value_or(0.f))
     , _heightOffset(config.heightOffset.value_or(0.f))
     , _radius(config.radius.value_or(5.f))
+    , _useAdaptiveResolution(config.adaptiveResolution.value_or(false))
+    , _useAutomaticQuality(config.automaticQuality.value_or(false))
+    , _maxQuality(config.quality.value_or(std::numeric_limits<int>::max()))
+    , _useLookupTexture(config.lookupTexture.value_or(false))
 {
     setUser(user);
     setUseDepthTransformation(true);
@@ -75,6 +95,23 @@ CylindricalProjection::~CylindricalProjection() {
     _shader.program.deleteProgram();
 }
 
+void CylindricalProjection::initialize(unsigned int internalFormat, unsigned int format,
+                                       unsigned int type, int nSamples)
+{
+    if (_useAutomaticQuality) {
+        // The viewport is not known yet, so the entire window is used until the first
+        // update, which can only overestimate the resolution
+        const ivec2 res = _subViewports.front.window().framebufferResolution();
+        fitCubemapResolution(
+            sampledDirections(),
+            ivec2(DirectionSamples, DirectionSamples),
+            vec2(static_cast<float>(res.x), static_cast<float>(res.y)),
+            _maxQuality
+        );
+    }
+    NonLinearProjection::initialize(internalFormat, format, type, nSamples);
+}
+
 void CylindricalProjection::render(const BaseViewport& viewport,
                                    FrustumMode frustumMode) const
 {
@@ -86,24 +123,31 @@ void CylindricalProjection::render(const BaseViewport& viewport,
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glDisable(GL_SCISSOR_TEST);
 
-    _shader.program.bind();
+    if (_useLookupTexture) {
+        bindDirectionLookup([this](const ShaderProgram& program) {
+            const unsigned int id = program.id();
+            glUniform1f(glGetUniformLocation(id, "rotation"), glm::radians(_rotation));
+            glUniform1f(glGetUniformLocation(id, "heightOffset"), _heightOffset);
+        });
+    }
+    else {
+        _shader.program.bind();
+        glUniform1i(_shader.cubemap, 0);
+        glUniform1f(_shader.rotation, glm::radians(_rotation));
+        glUniform1f(_shader.heightOffset, _heightOffset);
+    }
 
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
     // if for some reason the active texture has been reset
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapColor);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, sampledTextures().cubeMapColor);
 
     glDisable(GL_CULL_FACE);
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_ALWAYS);
 
-    glUniform1i(_shader.cubemap, 0);
-    glUniform1f(_shader.rotation, glm::radians(_rotation));
-    glUniform1f(_shader.heightOffset, _heightOffset);
-
-
     glBindVertexArray(_vao);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
@@ -118,6 +162,11 @@ void CylindricalProjection::render(const BaseViewport& viewport,
 void CylindricalProjection::renderCubemap(FrustumMode frustumMode) const {
     ZoneScoped;
 
+    if (_isLayered) {
+        renderCubeFacesLayered(frustumMode, enabledFaces());
+        return;
+    }
+
     renderCubeFace(_subViewports.right, 0, frustumMode);
     renderCubeFace(_subViewports.left, 1, frustumMode);
     renderCubeFace(_subViewports.bottom, 2, frustumMode);
@@ -126,7 +175,26 @@ void CylindricalProjection::renderCubemap(FrustumMode frustumMode) const {
     renderCubeFace(_subViewports.back, 5, frustumMode);
 }
 
-void CylindricalProjection::update(const vec2&) const {}
+bool CylindricalProjection::supportsLayeredRendering() const {
+    return true;
+}
+
+bool CylindricalProjection::supportsSharedCubeMap() const {
+    return true;
+}
+
+void CylindricalProjection::update(const vec2& size) {
+    // The size already contains the resolution scale of the window, so the cube map
+    // follows the adaptive resolution as well
+    if (_useAutomaticQuality) {
+        fitCubemapResolution(
+            sampledDirections(),
+            ivec2(DirectionSamples, DirectionSamples),
+            size,
+            _maxQuality
+        );
+    }
+}
 
 void CylindricalProjection::initVBO() {
     glGenVertexArrays(1, &_vao);
@@ -279,12 +347,42 @@ void CylindricalProjection::initViewports() {
     }
 
    _subViewports.back.setEnabled(false);
+
+    if (_useAdaptiveResolution) {
+        // The viewport is not known here, so the entire window is used, which can only
+        // overestimate the resolution
+        const ivec2 res = _subViewports.front.window().framebufferResolution();
+        scaleCubeFacesToImage(
+            sampledDirections(),
+            ivec2(DirectionSamples, DirectionSamples),
+            vec2(static_cast<float>(res.x), static_cast<float>(res.y))
+        );
+    }
+}
+
+std::vector<vec3> CylindricalProjection::sampledDirections() const {
+    std::vector<vec3> directions;
+    directions.reserve(DirectionSamples * DirectionSamples);
+    for (int i = 0; i < DirectionSamples; i++) {
+        const float v = static_cast<float>(i) / (DirectionSamples - 1);
+        for (int j = 0; j < DirectionSamples; j++) {
+            const float u = static_cast<float>(j) / (DirectionSamples - 1);
+            const float angle = 2.f * std::numbers::pi_v<float> * u;
+            directions.push_back(vec3{
+                std::cos(-angle + glm::radians(_rotation)),
+                std::sin(-angle + glm::radians(_rotation)),
+                v + _heightOffset
+            });
+        }
+    }
+    return directions;
 }
 
 void CylindricalProjection::initShaders() {
     _shader.program = ShaderProgram("CylindricalProjectionShader");
     _shader.program.addVertexShader(shaders_fisheye::BaseVert);
     _shader.program.addFragmentShader(FragmentShader);
+    _shader.program.addFragmentShader(DirectionFunction);
     _shader.program.createAndLinkProgram();
     _shader.program.bind();
 
@@ -294,14 +392,20 @@ void CylindricalProjection::initShaders() {
     _shader.heightOffset = glGetUniformLocation(_shader.program.id(), "heightOffset");
 
     ShaderProgram::unbind();
+
+    if (_useLookupTexture) {
+        initDirectionLookup(DirectionFunction);
+    }
 }
 
 void CylindricalProjection::setRotation(float rotation) {
     _rotation = rotation;
+    _directionLookup.isDirty = true;
 }
 
 void CylindricalProjection::setHeightOffset(float heightOffset) {
     _heightOffset = heightOffset;
+    _directionLookup.isDirty = true;
 }
 
 void CylindricalProjection::setRadius(float radius) {
@@ -20,8 +20,15 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <limits>
+#include <numbers>
 
 namespace {
+    // Dense enough that neighboring directions are about 1.4 degrees apart around the
+    // equator
+    constexpr int DirectionSamples = 256;
+
     constexpr std::string_view FragmentShader = R"(
   #version 330 core
 
@@ -30,15 +37,25 @@ namespace {
 
   uniform samplerCube cubemap;
 
-  const float PI = 3.141592654;
+  vec3 direction(vec2 uv);
 
   void main() {
-    float phi = PI * (1.0 - tr_uv.t);
-    float theta = 2.0 * PI * (tr_uv.s - 0.5);
+    out_diffuse = texture(cubemap, direction(tr_uv));
+  }
+)";
+
+    constexpr std::string_view DirectionFunction = R"(
+  #version 330 core
+
+  const float PI = 3.141592654;
+
+  vec3 direction(vec2 uv) {
+    float phi = PI * (1.0 - uv.t);
+    float theta = 2.0 * PI * (uv.s - 0.5);
     float x = sin(phi) * sin(theta);
     float y = sin(phi) * cos(theta);
     float z = cos(phi);
-    out_diffuse = texture(cubemap, vec3(x, y, z));
+    return vec3(x, y, z);
   }
 )";
 } // namespace
@@ -50,6 +67,9 @@ EquirectangularProjection::EquirectangularProjection(
                                                                      const Window& parent,
                                                                                User& user)
     : NonLinearProjection(parent)
+    , _useAutomaticQuality(config.automaticQuality.value_or(false))
+    , _maxQuality(config.quality.value_or(std::numeric_limits<int>::max()))
+    , _useLookupTexture(config.lookupTexture.value_or(false))
 {
     setUser(user);
     setUseDepthTransformation(true);
@@ -64,6 +84,24 @@ EquirectangularProjection::~EquirectangularProjection() {
     _shader.deleteProgram();
 }
 
+void EquirectangularProjection::initialize(unsigned int internalFormat,
+                                           unsigned int format, unsigned int type,
+                                           int nSamples)
+{
+    if (_useAutomaticQuality) {
+        // The viewport is not known yet, so the entire window is used until the first
+        // update, which can only overestimate the resolution
+        const ivec2 res = _subViewports.front.window().framebufferResolution();
+        fitCubemapResolution(
+            sampledDirections(),
+            ivec2(DirectionSamples, DirectionSamples),
+            vec2(static_cast<float>(res.x), static_cast<float>(res.y)),
+            _maxQuality
+        );
+    }
+    NonLinearProjection::initialize(internalFormat, format, type, nSamples);
+}
+
 void EquirectangularProjection::render(const BaseViewport& viewport,
                                        FrustumMode frustumMode) const
 {
@@ -75,13 +113,18 @@ void EquirectangularProjection::render(const BaseViewport& viewport,
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glDisable(GL_SCISSOR_TEST);
 
-    _shader.bind();
+    if (_useLookupTexture) {
+        bindDirectionLookup({});
+    }
+    else {
+        _shader.bind();
+    }
 
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
     // if for some reson the active texture has been reset
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapColor);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, sampledTextures().cubeMapColor);
 
     glDisable(GL_CULL_FACE);
     glDisable(GL_BLEND);
@@ -102,6 +145,11 @@ void EquirectangularProjection::render(const BaseViewport& viewport,
 void EquirectangularProjection::renderCubemap(FrustumMode frustumMode) const {
     ZoneScoped;
 
+    if (_isLayered) {
+        renderCubeFacesLayered(frustumMode, enabledFaces());
+        return;
+    }
+
     renderCubeFace(_subViewports.right, 0, frustumMode);
     renderCubeFace(_subViewports.left, 1, frustumMode);
     renderCubeFace(_subViewports.bottom, 2, frustumMode);
@@ -110,7 +158,26 @@ void EquirectangularProjection::renderCubemap(FrustumMode frustumMode) const {
     renderCubeFace(_subViewports.back, 5, frustumMode);
 }
 
-void EquirectangularProjection::update(const vec2&) const {}
+bool EquirectangularProjection::supportsLayeredRendering() const {
+    return true;
+}
+
+bool EquirectangularProjection::supportsSharedCubeMap() const {
+    return true;
+}
+
+void EquirectangularProjection::update(const vec2& size) {
+    // The size already contains the resolution scale of the window, so the cube map
+    // follows the adaptive resolution as well
+    if (_useAutomaticQuality) {
+        fitCubemapResolution(
+            sampledDirections(),
+            ivec2(DirectionSamples, DirectionSamples),
+            size,
+            _maxQuality
+        );
+    }
+}
 
 void EquirectangularProjection::initVBO() {
     struct Vertex {
@@ -291,16 +358,42 @@ void EquirectangularProjection::initViewports() {
     }
 }
 
+std::vector<vec3> EquirectangularProjection::sampledDirections() const {
+    constexpr float Pi = std::numbers::pi_v<float>;
+
+    std::vector<vec3> directions;
+    directions.reserve(DirectionSamples * DirectionSamples);
+    for (int i = 0; i < DirectionSamples; i++) {
+        const float t = static_cast<float>(i) / (DirectionSamples - 1);
+        const float phi = Pi * (1.f - t);
+        for (int j = 0; j < DirectionSamples; j++) {
+            const float s = static_cast<float>(j) / (DirectionSamples - 1);
+            const float theta = 2.f * Pi * (s - 0.5f);
+            directions.push_back(vec3{
+                std::sin(phi) * std::sin(theta),
+                std::sin(phi) * std::cos(theta),
+                std::cos(phi)
+            });
+        }
+    }
+    return directions;
+}
+
 void EquirectangularProjection::initShaders() {
     _shader = ShaderProgram("CylindricalProjectinoShader");
     _shader.addVertexShader(shaders_fisheye::BaseVert);
     _shader.addFragmentShader(FragmentShader);
+    _shader.addFragmentShader(DirectionFunction);
     _shader.createAndLinkProgram();
     _shader.bind();
 
     glUniform1i(glGetUniformLocation(_shader.id(), "cubemap"), 0);
 
     ShaderProgram::unbind();
+
+    if (_useLookupTexture) {
+        initDirectionLookup(DirectionFunction);
+    }
 }
 
 } // namespace sgct
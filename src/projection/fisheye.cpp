@@ -10,16 +10,23 @@
 
 #include <sgct/clustermanager.h>
 #include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/image.h>
 #include <sgct/internalshaders.h>
 #include <sgct/log.h>
 #include <sgct/offscreenbuffer.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/projection.h>
+#include <sgct/projection/projectionplane.h>
 #include <sgct/user.h>
 #include <sgct/window.h>
 
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace {
     struct Vertex {
@@ -29,6 +36,13 @@ namespace {
         float s;
         float t;
     };
+
+    // The layout of a tile in the std140 uniform block of the omni-directional stereo
+    struct OmniStereoTile {
+        sgct::mat4 viewProjection;
+        sgct::vec4 rect;
+    };
+    static_assert(sizeof(OmniStereoTile) == 80);
 } // namespace
 
 namespace sgct {
@@ -44,9 +58,53 @@ FisheyeProjection::FisheyeProjection(const config::FisheyeProjection& config,
     , _cropBottom(config.crop ? config.crop->bottom : 0.f)
     , _cropTop(config.crop ? config.crop->top : 0.f)
     , _keepAspectRatio(config.keepAspectRatio.value_or(true))
+    , _useAdaptiveResolution(config.adaptiveResolution.value_or(false))
+    , _isDirect(config.directRendering.value_or(false) || config.omniStereo.has_value())
 {
     setUser(user);
 
+    if (config.omniStereo) {
+        // The maps are only sampled on the CPU, once for every tile
+        auto loadMap = [](const std::filesystem::path& path) {
+            Image image;
+            image.load(path);
+            const int stride = image.channels() * image.bytesPerChannel();
+            OmniStereoMap map;
+            map.size = image.size();
+            map.values.reserve(static_cast<size_t>(map.size.x) * map.size.y);
+            for (int i = 0; i < map.size.x * map.size.y; i++) {
+                const float v = static_cast<float>(image.data()[i * stride]) / 255.f;
+                map.values.push_back(std::pow(v, 2.2f));
+            }
+            return map;
+        };
+
+        _omniStereo.isEnabled = true;
+        _omniStereo.tileSize = config.omniStereo->tileSize.value_or(_omniStereo.tileSize);
+        if (config.omniStereo->turnMap) {
+            _omniStereo.turnMap = loadMap(*config.omniStereo->turnMap);
+        }
+        if (config.omniStereo->separationMap) {
+            _omniStereo.separationMap = loadMap(*config.omniStereo->separationMap);
+        }
+    }
+
+    if (config.distribution) {
+        Distribution distribution;
+        distribution.outputNode = config.distribution->output;
+        for (const config::FisheyeProjection::Distribution::Helper& helper :
+             config.distribution->helpers)
+        {
+            // The faces are listed in the same order as the faces of the cube map
+            uint8_t faces = 0;
+            for (config::FisheyeProjection::Distribution::Face face : helper.faces) {
+                faces |= 1 << static_cast<int>(face);
+            }
+            distribution.helpers.emplace_back(helper.node, faces);
+        }
+        setDistribution(std::move(distribution));
+    }
+
     if (config.quality) {
         setCubemapResolution(*config.quality);
     }
@@ -71,13 +129,15 @@ FisheyeProjection::FisheyeProjection(const config::FisheyeProjection& config,
 }
 
 FisheyeProjection::~FisheyeProjection() {
+    for (OmniStereoTiles& tiles : _omniStereo.tiles) {
+        glDeleteBuffers(1, &tiles.buffer);
+    }
     glDeleteBuffers(1, &_vbo);
     glDeleteVertexArrays(1, &_vao);
     _shader.deleteProgram();
-    _depthCorrectionShader.deleteProgram();
 }
 
-void FisheyeProjection::update(const vec2& size) const {
+void FisheyeProjection::update(const vec2& size) {
     // do the cropping in the fragment shader and not by changing the vbo
 
     const float cropAspect =
@@ -97,6 +157,7 @@ void FisheyeProjection::update(const vec2& size) const {
             y = aspect;
         }
     }
+    _quadSize = vec2{ x, y };
 
     glBindVertexArray(_vao);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -122,29 +183,44 @@ void FisheyeProjection::render(const BaseViewport& viewport,
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glDisable(GL_SCISSOR_TEST);
 
+    if (isHelper()) {
+        // The faces that this node has rendered are shown by the output node
+        return;
+    }
+    if (_omniStereo.isEnabled) {
+        renderOmniStereo(viewport, frustumMode);
+        return;
+    }
+    if (_isDirect) {
+        renderDirect(viewport, frustumMode);
+        return;
+    }
+
     _shader.bind();
 
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
+    const Textures& textures = sampledTextures();
+
     // if for some reson the active texture has been reset
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapColor);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, textures.cubeMapColor);
 
-    if (Engine::instance().settings().useDepthTexture) {
+    if (_attachments.depth) {
         glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapDepth);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, textures.cubeMapDepth);
         glUniform1i(_shaderLoc.depthCubemap, 1);
     }
 
-    if (Engine::instance().settings().useNormalTexture) {
+    if (_attachments.normals) {
         glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapNormals);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, textures.cubeMapNormals);
         glUniform1i(_shaderLoc.normalCubemap, 2);
     }
 
-    if (Engine::instance().settings().usePositionTexture) {
+    if (_attachments.positions) {
         glActiveTexture(GL_TEXTURE3);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _textures.cubeMapPositions);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, textures.cubeMapPositions);
         glUniform1i(_shaderLoc.positionCubemap, 3);
     }
 
@@ -171,83 +247,291 @@ void FisheyeProjection::render(const BaseViewport& viewport,
     glDepthFunc(GL_LESS);
 }
 
-void FisheyeProjection::renderCubemap(FrustumMode frustumMode) const {
+void FisheyeProjection::renderDirect(const BaseViewport& viewport,
+                                     FrustumMode frustumMode) const
+{
     ZoneScoped;
 
-    switch (frustumMode) {
-        case FrustumMode::Mono:
-            break;
-        case FrustumMode::StereoLeft:
-            setOffset(
-                vec3{ -Engine::defaultUser().eyeSeparation() / _diameter, 0.f, 0.f }
-            );
-            break;
-        case FrustumMode::StereoRight:
-            setOffset(
-                vec3{ Engine::defaultUser().eyeSeparation() / _diameter, 0.f, 0.f }
-            );
-            break;
-    }
+    const User& user = viewport.user();
+    const vec3& eye =
+        frustumMode == FrustumMode::StereoLeft ? user.posLeftEye() :
+        frustumMode == FrustumMode::StereoRight ? user.posRightEye() :
+        user.posMono();
+    const glm::mat4 translation =
+        glm::translate(glm::mat4(1.f), -glm::vec3(eye.x, eye.y, eye.z));
+    mat4 view;
+    std::memcpy(&view, glm::value_ptr(translation), sizeof(mat4));
+    view = _directRotation * view;
+
+    const mat4& scene = ClusterManager::instance().sceneTransform();
+    RenderData renderData = {
+        viewport.window(),
+        viewport,
+        frustumMode,
+        scene,
+        view,
+        mat4(1.f),
+        view * scene,
+        viewport.window().framebufferResolution()
+    };
 
-    auto render = [this](const BaseViewport& vp, int idx, FrustumMode mode) {
-        if (!vp.isEnabled()) {
-            return;
-        }
+    // Maps the unit disk onto the quad that the fisheye covers in the viewport, which
+    // shows the cropped part of the disk
+    const float w = 1.f - _cropLeft - _cropRight;
+    const float h = 1.f - _cropBottom - _cropTop;
+    RenderData::Fisheye fisheye;
+    fisheye.halfFov = glm::radians(_fov / 2.f);
+    fisheye.scale = vec2{ _quadSize.x / w, _quadSize.y / h };
+    fisheye.offset = vec2{
+        _quadSize.x * (_cropRight - _cropLeft) / w,
+        _quadSize.y * (_cropTop - _cropBottom) / h
+    };
+    fisheye.nearClip = Engine::instance().nearClipPlane();
+    fisheye.farClip = Engine::instance().farClipPlane();
+    renderData.fisheye = fisheye;
 
-        renderCubeFace(vp, idx, mode);
+    glLineWidth(1.f);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glDepthFunc(GL_LESS);
+    Engine::instance().drawFunction()(renderData);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
 
-        // re-calculate depth values from a cube to spherical model
-        if (Engine::instance().settings().useDepthTexture) {
-            GLenum buffers[] = { GL_COLOR_ATTACHMENT0 };
-            _cubeMapFbo->bind(false, 1, buffers); // bind no multi-sampled
+void FisheyeProjection::renderOmniStereo(const BaseViewport& viewport,
+                                         FrustumMode frustumMode) const
+{
+    ZoneScoped;
 
-            _cubeMapFbo->attachCubeMapTexture(
-                _textures.cubeMapColor,
-                idx,
-                GL_COLOR_ATTACHMENT0
-            );
-            _cubeMapFbo->attachCubeMapDepthTexture(_textures.cubeMapDepth, idx);
+    updateOmniStereoTiles(viewport, frustumMode);
+    const OmniStereoTiles& tiles = _omniStereo.tiles[static_cast<int>(frustumMode)];
+
+    const mat4& scene = ClusterManager::instance().sceneTransform();
+    RenderData renderData = {
+        viewport.window(),
+        viewport,
+        frustumMode,
+        scene,
+        mat4(1.f),
+        mat4(1.f),
+        scene,
+        viewport.window().framebufferResolution()
+    };
 
-            glViewport(0, 0, _cubemapResolution.x, _cubemapResolution.y);
-            glScissor(0, 0, _cubemapResolution.x, _cubemapResolution.y);
-            glEnable(GL_SCISSOR_TEST);
+    glLineWidth(1.f);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glDepthFunc(GL_LESS);
 
-            glClearColor(0.f, 0.f, 0.f, 0.f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // The clip distances confine every instance to the rectangle of its tile
+    for (int i = 0; i < 4; i++) {
+        glEnable(GL_CLIP_DISTANCE0 + i);
+    }
 
-            glDisable(GL_CULL_FACE);
-            glDisable(GL_BLEND);
+    // The uniform block always spans the full tile array, also for the last batch
+    constexpr int MaxTiles = RenderData::OmniStereo::MaxTiles;
+    for (int first = 0; first < tiles.nTiles; first += MaxTiles) {
+        glBindBufferRange(
+            GL_UNIFORM_BUFFER,
+            RenderData::OmniStereo::UniformBinding,
+            tiles.buffer,
+            (first / MaxTiles) * _omniStereo.batchStride,
+            MaxTiles * sizeof(OmniStereoTile)
+        );
+        renderData.omniStereo = RenderData::OmniStereo{
+            .nTiles = std::min(tiles.nTiles - first, MaxTiles)
+        };
+        Engine::instance().drawFunction()(renderData);
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, RenderData::OmniStereo::UniformBinding, 0);
 
-            glEnable(GL_DEPTH_TEST);
-            glDepthFunc(GL_ALWAYS);
+    for (int i = 0; i < 4; i++) {
+        glDisable(GL_CLIP_DISTANCE0 + i);
+    }
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, _textures.colorSwap);
+void FisheyeProjection::updateOmniStereoTiles(const BaseViewport& viewport,
+                                              FrustumMode frustumMode) const
+{
+    const User& user = viewport.user();
+    const ivec2 res = viewport.window().framebufferResolution();
+    const ivec2 size = ivec2{
+        static_cast<int>(static_cast<float>(res.x) * viewport.size().x + 0.5f),
+        static_cast<int>(static_cast<float>(res.y) * viewport.size().y + 0.5f)
+    };
+    const float nearClip = Engine::instance().nearClipPlane();
+    const float farClip = Engine::instance().farClipPlane();
+    const OmniStereoKey key = {
+        .size = size,
+        .quadSize = _quadSize,
+        .eye = user.posMono(),
+        .eyeSeparation = frustumMode == FrustumMode::Mono ? 0.f : user.eyeSeparation(),
+        .nearClip = nearClip,
+        .farClip = farClip
+    };
+    OmniStereoTiles& tiles = _omniStereo.tiles[static_cast<int>(frustumMode)];
+    if (tiles.key == key || size.x <= 0 || size.y <= 0) {
+        return;
+    }
+    tiles.key = key;
 
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, _textures.depthSwap);
+    ZoneScoped;
 
-            _depthCorrectionShader.bind();
-            glUniform1i(_shaderLoc.swapColor, 0);
-            glUniform1i(_shaderLoc.swapDepth, 1);
-            glUniform1f(_shaderLoc.swapNear, Engine::instance().nearClipPlane());
-            glUniform1f(_shaderLoc.swapFar, Engine::instance().farClipPlane());
+    // The same mapping of the unit disk onto the viewport as for the direct rendering
+    const float w = 1.f - _cropLeft - _cropRight;
+    const float h = 1.f - _cropBottom - _cropTop;
+    const glm::vec2 scale = glm::vec2(_quadSize.x / w, _quadSize.y / h);
+    const glm::vec2 offset = glm::vec2(
+        _quadSize.x * (_cropRight - _cropLeft) / w,
+        _quadSize.y * (_cropTop - _cropBottom) / h
+    );
+    const float halfFov = glm::radians(_fov / 2.f);
+    const glm::mat3 toUser = glm::transpose(
+        glm::mat3(glm::make_mat4(_directRotation.values.data()))
+    );
 
-            vp.window().renderScreenQuad();
-            ShaderProgram::unbind();
+    // The direction relative to the user of the fisheye at a position in the viewport
+    auto direction = [&](float x, float y) {
+        const glm::vec2 u = (glm::vec2(x, y) - offset) / scale;
+        const float r = glm::length(u);
+        const float phi = r * halfFov;
+        const glm::vec2 d = r > 0.f ? u / r * std::sin(phi) : glm::vec2(0.f);
+        return toUser * glm::vec3(d, -std::cos(phi));
+    };
 
-            glDisable(GL_DEPTH_TEST);
-            glDepthFunc(GL_LESS);
-            glDisable(GL_SCISSOR_TEST);
+    auto sample = [](const OmniStereoMap& map, float s, float t) {
+        if (map.values.empty()) {
+            return 1.f;
         }
+        const float x = std::clamp(s, 0.f, 1.f) * static_cast<float>(map.size.x - 1);
+        const float y = std::clamp(t, 0.f, 1.f) * static_cast<float>(map.size.y - 1);
+        const int x0 = static_cast<int>(x);
+        const int y0 = static_cast<int>(y);
+        const int x1 = std::min(x0 + 1, map.size.x - 1);
+        const int y1 = std::min(y0 + 1, map.size.y - 1);
+        auto at = [&map](int i, int j) { return map.values[j * map.size.x + i]; };
+        const float fx = x - static_cast<float>(x0);
+        const float fy = y - static_cast<float>(y0);
+        return glm::mix(
+            glm::mix(at(x0, y0), at(x1, y0), fx),
+            glm::mix(at(x0, y1), at(x1, y1), fx),
+            fy
+        );
     };
 
-    render(_subViewports.right, 0, frustumMode);
-    render(_subViewports.left, 1, frustumMode);
-    render(_subViewports.bottom, 2, frustumMode);
-    render(_subViewports.top, 3, frustumMode);
-    render(_subViewports.front, 4, frustumMode);
-    render(_subViewports.back, 5, frustumMode);
+    const float radius = _diameter / 2.f;
+    const float side = frustumMode == FrustumMode::StereoLeft ? -0.5f : 0.5f;
+    const int ts = _omniStereo.tileSize;
+    const int nx = (size.x + ts - 1) / ts;
+    const int ny = (size.y + ts - 1) / ts;
+    std::vector<OmniStereoTile> result;
+    result.reserve(static_cast<size_t>(nx) * ny);
+    for (int y = 0; y < ny; y++) {
+        const float y0 = 2.f * static_cast<float>(y * ts) / size.y - 1.f;
+        const float y1 = 2.f * static_cast<float>(std::min((y + 1) * ts, size.y)) /
+            size.y - 1.f;
+        for (int x = 0; x < nx; x++) {
+            const float x0 = 2.f * static_cast<float>(x * ts) / size.x - 1.f;
+            const float x1 = 2.f * static_cast<float>(std::min((x + 1) * ts, size.x)) /
+                size.x - 1.f;
+
+            // Tiles that lie entirely outside of the fisheye disk are not rendered
+            const glm::vec2 uMin = (glm::vec2(x0, y0) - offset) / scale;
+            const glm::vec2 uMax = (glm::vec2(x1, y1) - offset) / scale;
+            const glm::vec2 closest = glm::clamp(glm::vec2(0.f), uMin, uMax);
+            if (glm::dot(closest, closest) > 1.f) {
+                continue;
+            }
+
+            auto corner = [&](float s, float t) {
+                const glm::vec3 p = radius * direction(s, t);
+                return vec3{ p.x, p.y, p.z };
+            };
+            ProjectionPlane plane;
+            plane.setCoordinates(corner(x0, y0), corner(x0, y1), corner(x1, y1));
+
+            // The eyes are turned around the vertical axis until they face the tile
+            const glm::vec2 c = glm::vec2((x0 + x1) / 2.f, (y0 + y1) / 2.f);
+            const glm::vec3 dir = direction(c.x, c.y);
+            const glm::vec2 uv = (c + 1.f) / 2.f;
+            const float azimuth =
+                std::atan2(dir.x, -dir.z) * sample(_omniStereo.turnMap, uv.x, uv.y);
+            const float separation =
+                key.eyeSeparation * sample(_omniStereo.separationMap, uv.x, uv.y);
+            const vec3 eye = vec3{
+                key.eye.x + side * separation * std::cos(azimuth),
+                key.eye.y,
+                key.eye.z + side * separation * std::sin(azimuth)
+            };
+
+            Projection proj;
+            proj.calculateProjection(eye, plane, nearClip, farClip);
+            result.push_back({
+                proj.viewProjectionMatrix(),
+                vec4{ c.x, c.y, (x1 - x0) / 2.f, (y1 - y0) / 2.f }
+            });
+        }
+    }
+
+    constexpr int MaxTiles = RenderData::OmniStereo::MaxTiles;
+    tiles.nTiles = static_cast<int>(result.size());
+    const int nBatches = (tiles.nTiles + MaxTiles - 1) / MaxTiles;
+    glBindBuffer(GL_UNIFORM_BUFFER, tiles.buffer);
+    glBufferData(
+        GL_UNIFORM_BUFFER,
+        static_cast<GLsizeiptr>(nBatches) * _omniStereo.batchStride,
+        nullptr,
+        GL_STATIC_DRAW
+    );
+    for (int b = 0; b < nBatches; b++) {
+        const int n = std::min(tiles.nTiles - b * MaxTiles, MaxTiles);
+        glBufferSubData(
+            GL_UNIFORM_BUFFER,
+            static_cast<GLintptr>(b) * _omniStereo.batchStride,
+            n * sizeof(OmniStereoTile),
+            result.data() + b * MaxTiles
+        );
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    Log::Debug(std::format(
+        "Omni stereo: {} of {} tiles in {} batches", tiles.nTiles, nx * ny, nBatches
+    ));
+}
+
+void FisheyeProjection::renderCubemap(FrustumMode frustumMode) const {
+    ZoneScoped;
+
+    if (_isDirect) {
+        return;
+    }
+
+    switch (frustumMode) {
+        case FrustumMode::Mono:
+            break;
+        case FrustumMode::StereoLeft:
+            setOffset(
+                vec3{ -Engine::defaultUser().eyeSeparation() / _diameter, 0.f, 0.f }
+            );
+            break;
+        case FrustumMode::StereoRight:
+            setOffset(
+                vec3{ Engine::defaultUser().eyeSeparation() / _diameter, 0.f, 0.f }
+            );
+            break;
+    }
+
+    if (_isLayered) {
+        renderCubeFacesLayered(frustumMode, renderedFaces());
+    }
+    else {
+        renderCubeFace(_subViewports.right, 0, frustumMode);
+        renderCubeFace(_subViewports.left, 1, frustumMode);
+        renderCubeFace(_subViewports.bottom, 2, frustumMode);
+        renderCubeFace(_subViewports.top, 3, frustumMode);
+        renderCubeFace(_subViewports.front, 4, frustumMode);
+        renderCubeFace(_subViewports.back, 5, frustumMode);
+    }
+    exchangeDistributedFaces(frustumMode);
 }
 
 void FisheyeProjection::setDomeDiameter(float diameter) {
@@ -293,7 +577,46 @@ void FisheyeProjection::setKeepAspectRatio(bool state) {
     _keepAspectRatio = state;
 }
 
+bool FisheyeProjection::supportsLayeredRendering() const {
+    return !_isDirect;
+}
+
+bool FisheyeProjection::readsAttachmentCubeMaps() const {
+    return !_isDirect;
+}
+
+bool FisheyeProjection::supportsSharedCubeMap() const {
+    return !_isDirect;
+}
+
+void FisheyeProjection::initTextures(unsigned int internalFormat, unsigned int format,
+                                     unsigned int type)
+{
+    // The direct rendering does not use a cube map
+    if (!_isDirect) {
+        NonLinearProjection::initTextures(internalFormat, format, type);
+    }
+}
+
+void FisheyeProjection::initFBO(unsigned int internalFormat, int nSamples) {
+    if (!_isDirect) {
+        NonLinearProjection::initFBO(internalFormat, nSamples);
+    }
+}
+
 void FisheyeProjection::initVBO() {
+    if (_omniStereo.isEnabled) {
+        // Every batch has to start at a multiple of the uniform buffer alignment
+        GLint alignment = 1;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        const int size = RenderData::OmniStereo::MaxTiles * sizeof(OmniStereoTile);
+        _omniStereo.batchStride = (size + alignment - 1) / alignment * alignment;
+        for (OmniStereoTiles& tiles : _omniStereo.tiles) {
+            glGenBuffers(1, &tiles.buffer);
+            tiles.key = std::nullopt;
+        }
+    }
+
     glGenVertexArrays(1, &_vao);
     glBindVertexArray(_vao);
 
@@ -583,126 +906,158 @@ void FisheyeProjection::initViewports() {
         // -Z face
         _subViewports.back.setEnabled(false);
     }
-}
 
-void FisheyeProjection::initShaders() {
-    if (_isStereo || _preferedMonoFrustumMode != FrustumMode::Mono) {
-        // if any frustum mode other than Mono (or stereo)
-        _isOffAxis = true;
-    }
+    if (_isDirect) {
+        // The planes of the faces determine the orientation of the fisheye, which is
+        // derived from the directions that the center and two directions that are
+        // slightly to the right and above of it are rendered in
+        auto rendered = [this](float x, float y, float z) {
+            const vec3 d = renderedDirection(cubeMapDirection(x, y, z));
+            return glm::vec3(d.x, d.y, d.z);
+        };
+        const glm::vec3 forward = rendered(0.f, 0.f, 1.f);
+        const glm::vec3 r = rendered(0.1f, 0.f, 1.f);
+        const glm::vec3 right = glm::normalize(r - glm::dot(r, forward) * forward);
+        const glm::vec3 u = rendered(0.f, -0.1f, 1.f);
+        const glm::vec3 up = glm::normalize(
+            u - glm::dot(u, forward) * forward - glm::dot(u, right) * right
+        );
 
-    const bool isCubic = (_interpolationMode == InterpolationMode::Cubic);
-    const std::string_view fragmentShader = [](bool isOffAxis, bool useDepth,
-                                               bool useNormal, bool usePosition)
-    {
-        // It would be nice to do a multidimensional switch statement -.-
+        // The rows are the axes of the fisheye, which looks along its negative z-axis
+        const glm::mat4 rotation = glm::transpose(
+            glm::mat4(glm::mat3(right, up, -forward))
+        );
+        std::memcpy(&_directRotation, glm::value_ptr(rotation), sizeof(mat4));
 
-        constexpr auto tuple = [](bool useOffAxis_, bool useDepth_,
-                                  bool useNormal_, bool usePosition_) -> uint16_t
-        {
-            // Injective mapping from <bool, bool, bool, bool.> to uint8_t
-                uint8_t value = 0;
-                value |= useOffAxis_ ? 0b0000 : 0b0001;
-                value |= useDepth_ ? 0b0000 : 0b0010;
-                value |= useNormal_ ? 0b0000 : 0b0100;
-                value |= usePosition_ ? 0b0000 : 0b1000;
-                return value;
-        };
+        _subViewports.right.setEnabled(false);
+        _subViewports.left.setEnabled(false);
+        _subViewports.bottom.setEnabled(false);
+        _subViewports.top.setEnabled(false);
+        _subViewports.front.setEnabled(false);
+        _subViewports.back.setEnabled(false);
+        return;
+    }
+
+    // The faces above cover the entire field of view, but the circular fisheye and the
+    // crop factors leave parts of them unused. The offset of the stereo eyes can change
+    // at runtime, so the faces are only cropped to the sampled directions in mono
+    if (!_isStereo && _preferedMonoFrustumMode == FrustumMode::Mono) {
+        const std::vector<vec3> directions = sampledDirections();
+        cropCubeFaces(directions);
 
-        switch (tuple(isOffAxis, useDepth, useNormal, usePosition)) {
-            case tuple(true, true, false, false):
-                return shaders_fisheye::FisheyeFragOffAxisDepth;
-            case tuple(true, true, true, false):
-                return shaders_fisheye::FisheyeFragOffAxisDepthNormal;
-            case tuple(true, true, false, true):
-                return shaders_fisheye::FisheyeFragOffAxisDepthPosition;
-            case tuple(true, true, true, true):
-                return shaders_fisheye::FisheyeFragOffAxisDepthNormalPosition;
-
-            case tuple(true, false, false, false):
-                return shaders_fisheye::FisheyeFragOffAxis;
-            case tuple(true, false, true, false):
-                return shaders_fisheye::FisheyeFragOffAxisNormal;
-            case tuple(true, false, false, true):
-                return shaders_fisheye::FisheyeFragOffAxisPosition;
-            case tuple(true, false, true, true):
-                return shaders_fisheye::FisheyeFragOffAxisNormalPosition;
-
-            case tuple(false, true, false, false):
-                return shaders_fisheye::FisheyeFragDepth;
-            case tuple(false, true, true, false):
-                return shaders_fisheye::FisheyeFragDepthNormal;
-            case tuple(false, true, false, true):
-                return shaders_fisheye::FisheyeFragDepthPosition;
-            case tuple(false, true, true, true):
-                return shaders_fisheye::FisheyeFragDepthNormalPosition;
-
-            case tuple(false, false, false, false):
-                return shaders_fisheye::FisheyeFrag;
-            case tuple(false, false, true, false):
-                return shaders_fisheye::FisheyeFragNormal;
-            case tuple(false, false, false, true):
-                return shaders_fisheye::FisheyeFragPosition;
-            case tuple(false, false, true, true):
-                return shaders_fisheye::FisheyeFragNormalPosition;
-
-            default:
-                throw std::logic_error("Unhandled case label");
+        // The fisheye samples every direction with the same angular density
+        if (_useAdaptiveResolution) {
+            scaleCubeFacesToDensity(directions);
         }
-    }(
-        _isOffAxis,
-        Engine::instance().settings().useDepthTexture,
-        Engine::instance().settings().useNormalTexture,
-        Engine::instance().settings().usePositionTexture
-    );
+    }
+}
 
-    const std::string_view samplerShader =
-        _isOffAxis ? shaders_fisheye::SampleOffsetFun : shaders_fisheye::SampleFun;
+std::vector<vec3> FisheyeProjection::sampledDirections() const {
+    // Dense enough that neighboring directions are less than 0.8 degrees apart
+    constexpr int Resolution = 512;
+
+    // The cubic interpolation samples the fisheye image up to two texels beyond the
+    // cropped part
+    const float border = 2.f / static_cast<float>(_cubemapResolution.x);
+    const float sMin = std::max(_cropLeft - border, 0.f);
+    const float sMax = std::min(1.f - _cropRight + border, 1.f);
+    const float tMin = std::max(_cropBottom - border, 0.f);
+    const float tMax = std::min(1.f - _cropTop + border, 1.f);
+    const float halfFov = glm::radians(_fov / 2.f);
+
+    std::vector<vec3> directions;
+    directions.reserve(Resolution * Resolution);
+    for (int i = 0; i < Resolution; i++) {
+        const float texelT = tMin + (tMax - tMin) * i / (Resolution - 1);
+        for (int j = 0; j < Resolution; j++) {
+            const float texelS = sMin + (sMax - sMin) * j / (Resolution - 1);
+
+            const float s = 2.f * (texelS - 0.5f);
+            const float t = 2.f * (texelT - 0.5f);
+            const float r2 = s * s + t * t;
+            if (r2 > 1.f) {
+                continue;
+            }
 
-    _shader = ShaderProgram("FisheyeShader");
-    _shader.addVertexShader(shaders_fisheye::BaseVert);
-    _shader.addFragmentShader(fragmentShader);
-    _shader.addFragmentShader(samplerShader);
-    _shader.addFragmentShader(
-        isCubic ?
-            shaders_fisheye::InterpolateCubicFun :
-            shaders_fisheye::InterpolateLinearFun
-    );
+            const float phi = std::sqrt(r2) * halfFov;
+            const float theta = std::atan2(s, t);
+            const float x = std::sin(phi) * std::sin(theta) - _totalOffset.x;
+            const float y = -std::sin(phi) * std::cos(theta) - _totalOffset.y;
+            const float z = std::cos(phi) - _totalOffset.z;
+            directions.push_back(cubeMapDirection(x, y, z));
+        }
+    }
+    return directions;
+}
+
+vec3 FisheyeProjection::cubeMapDirection(float x, float y, float z) const {
+    constexpr float Angle = 0.7071067812f;
     if (_method == FisheyeMethod::FourFaceCube) {
-        _shader.addFragmentShader(shaders_fisheye::RotationFourFaceCubeFun);
+        return vec3{ Angle * x + Angle * z, y, -Angle * x + Angle * z };
     }
     else {
-        // five or six face
-        _shader.addFragmentShader(shaders_fisheye::RotationFiveSixFaceCubeFun);
+        return vec3{ Angle * x - Angle * y, Angle * x + Angle * y, z };
     }
+}
 
+void FisheyeProjection::initShaders() {
+    if (_isStereo || _preferedMonoFrustumMode != FrustumMode::Mono) {
+        // if any frustum mode other than Mono (or stereo)
+        _isOffAxis = true;
+    }
 
-    _shader.createAndLinkProgram();
-    _shader.bind();
-
-
-    glUniform4fv(glGetUniformLocation(_shader.id(), "bgColor"), 1, &_clearColor.x);
+    // Each combination of features is compiled into its own permutation of the shader,
+    // which also has the constant values baked in, instead of branching at runtime
+    const bool isCubic = (_interpolationMode == InterpolationMode::Cubic);
+    _shader = ShaderProgram("FisheyeShader");
+    _shader.addVertexShader(shaders_fisheye::BaseVert);
+    _shader.addFragmentShader(shaders_fisheye::FisheyeFrag);
+    if (_attachments.depth) {
+        _shader.addDefine("USE_DEPTH");
+    }
+    if (_attachments.normals) {
+        _shader.addDefine("USE_NORMALS");
+    }
+    if (_attachments.positions) {
+        _shader.addDefine("USE_POSITIONS");
+    }
+    if (_isOffAxis) {
+        _shader.addDefine("OFF_AXIS");
+    }
     if (isCubic) {
-        glUniform1f(
-            glGetUniformLocation(_shader.id(), "size"),
-            static_cast<float>(_cubemapResolution.x)
+        _shader.addDefine("CUBIC");
+        _shader.addDefine(
+            "CUBEMAP_SIZE",
+            std::format("{:#}", static_cast<float>(_cubemapResolution.x))
         );
     }
+    if (_method == FisheyeMethod::FourFaceCube) {
+        _shader.addDefine("FOUR_FACE_CUBE");
+    }
+    _shader.addDefine(
+        "BG_COLOR",
+        std::format(
+            "vec4({:#}, {:#}, {:#}, {:#})",
+            _clearColor.x, _clearColor.y, _clearColor.z, _clearColor.w
+        )
+    );
+    _shader.createAndLinkProgram();
+    _shader.bind();
 
     _shaderLoc.cubemap = glGetUniformLocation(_shader.id(), "cubemap");
     glUniform1i(_shaderLoc.cubemap, 0);
 
-    if (Engine::instance().settings().useDepthTexture) {
+    if (_attachments.depth) {
         _shaderLoc.depthCubemap = glGetUniformLocation(_shader.id(), "depthmap");
         glUniform1i(_shaderLoc.depthCubemap, 1);
     }
 
-    if (Engine::instance().settings().useNormalTexture) {
+    if (_attachments.normals) {
         _shaderLoc.normalCubemap = glGetUniformLocation(_shader.id(), "normalmap");
         glUniform1i(_shaderLoc.normalCubemap, 2);
     }
 
-    if (Engine::instance().settings().usePositionTexture) {
+    if (_attachments.positions) {
         _shaderLoc.positionCubemap = glGetUniformLocation(_shader.id(), "positionmap");
         glUniform1i(_shaderLoc.positionCubemap, 3);
     }
@@ -716,25 +1071,6 @@ void FisheyeProjection::initShaders() {
     }
 
     ShaderProgram::unbind();
-
-    if (Engine::instance().settings().useDepthTexture) {
-        _depthCorrectionShader = ShaderProgram("FisheyeDepthCorrectionShader");
-        _depthCorrectionShader.addVertexShader(shaders_fisheye::BaseVert);
-        _depthCorrectionShader.addFragmentShader(
-            shaders_fisheye::FisheyeDepthCorrectionFrag
-        );
-        _depthCorrectionShader.createAndLinkProgram();
-        _depthCorrectionShader.bind();
-
-        _shaderLoc.swapColor = glGetUniformLocation(_depthCorrectionShader.id(), "cTex");
-        glUniform1i(_shaderLoc.swapColor, 0);
-        _shaderLoc.swapDepth = glGetUniformLocation(_depthCorrectionShader.id(), "dTex");
-        glUniform1i(_shaderLoc.swapDepth, 1);
-        _shaderLoc.swapNear = glGetUniformLocation(_depthCorrectionShader.id(), "near");
-        _shaderLoc.swapFar = glGetUniformLocation(_depthCorrectionShader.id(), "far");
-
-        ShaderProgram::unbind();
-    }
 }
 
 } // namespace sgct
@@ -10,15 +10,160 @@
 
 #include <sgct/callbackdata.h>
 #include <sgct/clustermanager.h>
+#include <sgct/cubefacedistributor.h>
 #include <sgct/engine.h>
 #include <sgct/format.h>
+#include <sgct/internalshaders.h>
 #include <sgct/log.h>
+#include <sgct/memorytracker.h>
 #include <sgct/offscreenbuffer.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/user.h>
+#include <glm/glm.hpp>
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
 #include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Returns the index of the cube face in the order +X, -X, +Y, -Y, +Z, -Z that the
+    // direction \p d points to and the position on that face in [-1, 1], in the same way
+    // as the cube map lookup. Returns -1 as the face for a zero direction
+    std::pair<int, glm::vec2> cubeFaceCoordinate(const sgct::vec3& d) {
+        const glm::vec3 a = glm::abs(glm::vec3(d.x, d.y, d.z));
+        if (a.x >= a.y && a.x >= a.z && a.x > 0.f) {
+            return {
+                d.x >= 0.f ? 0 : 1,
+                glm::vec2(d.x >= 0.f ? -d.z : d.z, -d.y) / a.x
+            };
+        }
+        else if (a.y >= a.z && a.y > 0.f) {
+            return {
+                d.y >= 0.f ? 2 : 3,
+                glm::vec2(d.x, d.y >= 0.f ? d.z : -d.z) / a.y
+            };
+        }
+        else if (a.z > 0.f) {
+            return {
+                d.z >= 0.f ? 4 : 5,
+                glm::vec2(d.z >= 0.f ? d.x : -d.x, -d.y) / a.z
+            };
+        }
+        else {
+            return { -1, glm::vec2(0.f) };
+        }
+    }
+
+    // Returns the resolution that each cube face needs so that one of its texels is no
+    // larger than one pixel where it is the most magnified in the image, or 0 for the
+    // faces without a pair of neighboring samples. The arguments are the ones of
+    // NonLinearProjection::scaleCubeFacesToImage
+    std::array<float, 6> faceResolutionsForImage(std::span<const sgct::vec3> directions,
+                                                 sgct::ivec2 gridSize,
+                                                 sgct::vec2 imageSize)
+    {
+        assert(directions.size() == static_cast<size_t>(gridSize.x * gridSize.y));
+
+        // The number of pixels of the image between two neighboring samples
+        const glm::vec2 step = glm::vec2(
+            imageSize.x / static_cast<float>(gridSize.x - 1),
+            imageSize.y / static_cast<float>(gridSize.y - 1)
+        );
+
+        std::array<float, 6> resolution;
+        resolution.fill(0.f);
+        auto visit = [&resolution](const sgct::vec3& a, const sgct::vec3& b, float px) {
+            const auto [faceA, pA] = cubeFaceCoordinate(a);
+            const auto [faceB, pB] = cubeFaceCoordinate(b);
+            if (faceA == -1 || faceA != faceB) {
+                return;
+            }
+            // The face coordinates span two units across the face
+            const float distance = glm::distance(pA, pB) / 2.f;
+            if (distance > 0.f) {
+                resolution[faceA] = std::max(resolution[faceA], px / distance);
+            }
+        };
+        for (int y = 0; y < gridSize.y; y++) {
+            for (int x = 0; x < gridSize.x; x++) {
+                const size_t i = static_cast<size_t>(y * gridSize.x + x);
+                if (x + 1 < gridSize.x) {
+                    visit(directions[i], directions[i + 1], step.x);
+                }
+                if (y + 1 < gridSize.y) {
+                    visit(directions[i], directions[i + gridSize.x], step.y);
+                }
+            }
+        }
+        return resolution;
+    }
+
+    // Covers the viewport with a single triangle without a vertex buffer, with texture
+    // coordinates that are the same as those of the quads of the projections
+    constexpr std::string_view DirectionLookupBakeVert = R"(
+  #version 330 core
+
+  out vec2 tr_uv;
+
+  void main() {
+    vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(2.0 * p - 1.0, 0.0, 1.0);
+    tr_uv = p;
+  }
+)";
+
+    // Stores the directions octahedron-encoded, which keeps the full precision of the
+    // floating point channels with two instead of three of them
+    constexpr std::string_view DirectionLookupBakeFrag = R"(
+  #version 330 core
+
+  in vec2 tr_uv;
+  out vec2 out_direction;
+
+  vec3 direction(vec2 uv);
+
+  vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+  }
+
+  void main() {
+    vec3 d = direction(tr_uv);
+    d /= abs(d.x) + abs(d.y) + abs(d.z);
+    out_direction = d.z >= 0.0 ? d.xy : (1.0 - abs(d.yx)) * signNotZero(d.xy);
+  }
+)";
+
+    constexpr std::string_view DirectionLookupFrag = R"(
+  #version 330 core
+
+  in vec2 tr_uv;
+  out vec4 out_diffuse;
+
+  uniform samplerCube cubemap;
+  uniform sampler2D lookup;
+
+  vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+  }
+
+  void main() {
+    vec2 e = texture(lookup, tr_uv).xy;
+    vec3 d = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (d.z < 0.0) {
+      d.xy = (1.0 - abs(d.yx)) * signNotZero(d.xy);
+    }
+    out_diffuse = texture(cubemap, d);
+  }
+)";
+
+    // The projections on this node that can share their cube maps with each other
+    std::vector<const sgct::NonLinearProjection*> SharingProjections;
+} // namespace
 
 namespace sgct {
 
@@ -38,24 +183,186 @@ NonLinearProjection::~NonLinearProjection() {
     glDeleteTextures(1, &_textures.cubeMapDepth);
     glDeleteTextures(1, &_textures.cubeMapNormals);
     glDeleteTextures(1, &_textures.cubeMapPositions);
-    glDeleteTextures(1, &_textures.colorSwap);
-    glDeleteTextures(1, &_textures.depthSwap);
     glDeleteTextures(1, &_textures.cubeFaceRight);
     glDeleteTextures(1, &_textures.cubeFaceLeft);
     glDeleteTextures(1, &_textures.cubeFaceBottom);
     glDeleteTextures(1, &_textures.cubeFaceTop);
     glDeleteTextures(1, &_textures.cubeFaceFront);
     glDeleteTextures(1, &_textures.cubeFaceBack);
+    glDeleteTextures(1, &_rightEyeTextures.cubeMapColor);
+    glDeleteTextures(1, &_rightEyeTextures.cubeMapDepth);
+    glDeleteTextures(1, &_rightEyeTextures.cubeMapNormals);
+    glDeleteTextures(1, &_rightEyeTextures.cubeMapPositions);
+    glDeleteFramebuffers(1, &_scaledFbo);
+    glDeleteFramebuffers(1, &_distributedFbo);
+    glDeleteTextures(1, &_directionLookup.texture);
+    glDeleteFramebuffers(1, &_directionLookup.fbo);
+    glDeleteVertexArrays(1, &_directionLookup.vao);
+    _directionLookup.bakeShader.deleteProgram();
+    _directionLookup.shader.deleteProgram();
+    TracyFreeN(this, "Non-linear projection textures");
+    std::erase(SharingProjections, this);
 }
 
 void NonLinearProjection::initialize(unsigned int internalFormat, unsigned int format,
                                      unsigned int type, int nSamples)
 {
+    // The cube maps are recreated, so none of the faces can be reused
+    _faceMatrices = {};
+    _textureMemory.set(0);
+    _internalFormat = internalFormat;
+    _format = format;
+    _type = type;
+    _nSamples = nSamples;
+
+    if (readsAttachmentCubeMaps()) {
+        const Engine::Settings& s = Engine::instance().settings();
+        _attachments.depth = s.useDepthTexture;
+        _attachments.normals = s.useNormalTexture;
+        _attachments.positions = s.usePositionTexture;
+    }
+
     initViewports();
     initTextures(internalFormat, format, type);
     initFBO(internalFormat, nSamples);
     initVBO();
     initShaders();
+
+    if (Engine::instance().settings().useLayeredCubeMaps) {
+        // All attachments of a layered framebuffer have to be layered, which rules out
+        // the multisampled buffers and the swap textures of the depth transformation
+        _isLayered = supportsLayeredRendering() && !_cubeMapFbo->isMultiSampled() &&
+            !_attachments.depth;
+        if (_isLayered) {
+            generateCubeMap(
+                _textures.cubeMapDepth,
+                GL_DEPTH_COMPONENT32,
+                GL_DEPTH_COMPONENT,
+                GL_FLOAT
+            );
+        }
+        else {
+            Log::Warning(
+                "Layered cube maps are not supported by this projection or cannot be "
+                "used with MSAA or depth textures"
+            );
+        }
+    }
+
+    initScaledFaces();
+
+    _isInterleaved = supportsSharedCubeMap() && _isStereo &&
+        Engine::instance().settings().interleaveCubeMapEyes;
+    _interleavedFrame = std::nullopt;
+    if (_isInterleaved) {
+        initRightEyeTextures();
+        Log::Debug("Cube faces are rendered with interleaved eyes");
+    }
+
+    TracyAllocN(this, _textureMemory.bytes(), "Non-linear projection textures");
+    Log::Debug(std::format(
+        "Non-linear projection textures use {:.1f} MiB",
+        static_cast<double>(_textureMemory.bytes()) / (1024.0 * 1024.0)
+    ));
+
+    if (_distribution) {
+        const int thisNode = ClusterManager::instance().thisNodeId();
+        uint8_t helperFaces = 0;
+        std::optional<uint8_t> ownFaces;
+        for (const auto& [node, faces] : _distribution->helpers) {
+            helperFaces |= faces;
+            if (node == thisNode) {
+                ownFaces = faces;
+            }
+        }
+
+        if (thisNode == _distribution->outputNode) {
+            _localFaces = ~helperFaces & 0b111111;
+            _isHelper = false;
+        }
+        else if (ownFaces) {
+            _localFaces = *ownFaces;
+            _isHelper = true;
+        }
+        else {
+            Log::Warning(
+                "This node is neither the output nor a helper of the distributed cube "
+                "faces, so it renders all faces itself"
+            );
+            _distribution = std::nullopt;
+        }
+    }
+    if (_distribution) {
+        if (_distributedFbo == 0) {
+            glGenFramebuffers(1, &_distributedFbo);
+        }
+        if (_attachments.depth || _attachments.normals || _attachments.positions) {
+            Log::Warning(
+                "Only the color of distributed cube faces is sent, so the depth, normal, "
+                "and position textures of the faces of other nodes stay empty"
+            );
+        }
+        Log::Debug(std::format(
+            "Rendering the cube faces {:#08b} of the distributed cube map", _localFaces
+        ));
+    }
+
+    _isSharingCubeMap = supportsSharedCubeMap() && !_distribution &&
+        Engine::instance().settings().shareCubeMaps;
+    if (_isSharingCubeMap) {
+        SharingProjections.push_back(this);
+    }
+}
+
+void NonLinearProjection::initScaledFaces() {
+    const bool hasScaledFaces = std::any_of(
+        _faceScales.begin(),
+        _faceScales.end(),
+        [](float scale) { return scale < 1.f; }
+    );
+    if (!hasScaledFaces) {
+        return;
+    }
+
+    // The scaled faces are rendered into a smaller part of a separate texture that is
+    // then magnified into the cube map, which is only done for the color
+    const bool isSupported = !_isLayered && !_cubeMapFbo->isMultiSampled() &&
+        !_attachments.depth && !_attachments.normals && !_attachments.positions;
+    if (isSupported) {
+        _transientTargets.scaledColor =
+            acquireTransientTarget(_internalFormat, _format, _type);
+        _textures.scaledColor = _transientTargets.scaledColor.texture();
+        if (_scaledFbo == 0) {
+            glGenFramebuffers(1, &_scaledFbo);
+        }
+    }
+    else {
+        Log::Warning(
+            "Adaptive cube face resolutions cannot be used with layered cube maps, "
+            "MSAA, or depth, normal, or position textures"
+        );
+        _faceScales.fill(1.f);
+    }
+}
+
+void NonLinearProjection::initRightEyeTextures() {
+    // The right eye is rendered while the cube maps of the left eye are still written,
+    // so it needs textures of its own with the same attachments
+    generateCubeMap(_rightEyeTextures.cubeMapColor, _internalFormat, _format, _type);
+    if (_attachments.depth || _isLayered) {
+        generateCubeMap(
+            _rightEyeTextures.cubeMapDepth,
+            GL_DEPTH_COMPONENT32,
+            GL_DEPTH_COMPONENT,
+            GL_FLOAT
+        );
+    }
+    if (_attachments.normals) {
+        generateCubeMap(_rightEyeTextures.cubeMapNormals, GL_RGB32F, GL_RGB, GL_FLOAT);
+    }
+    if (_attachments.positions) {
+        generateCubeMap(_rightEyeTextures.cubeMapPositions, GL_RGB32F, GL_RGB, GL_FLOAT);
+    }
 }
 
 void NonLinearProjection::updateFrustums(FrustumMode mode, float nearClip, float farClip)
@@ -95,6 +402,10 @@ void NonLinearProjection::setUseDepthTransformation(bool state) {
     _useDepthTransformation = state;
 }
 
+void NonLinearProjection::setDistribution(Distribution distribution) {
+    _distribution = std::move(distribution);
+}
+
 void NonLinearProjection::setStereo(bool state) {
     _isStereo = state;
 }
@@ -112,6 +423,557 @@ ivec2 NonLinearProjection::cubemapResolution() const {
     return _cubemapResolution;
 }
 
+bool NonLinearProjection::isLayered() const {
+    return _isLayered;
+}
+
+bool NonLinearProjection::supportsLayeredRendering() const {
+    return false;
+}
+
+bool NonLinearProjection::readsAttachmentCubeMaps() const {
+    return false;
+}
+
+bool NonLinearProjection::supportsSharedCubeMap() const {
+    return false;
+}
+
+void NonLinearProjection::prepareCubemap(FrustumMode frustumMode) const {
+    ZoneScoped;
+
+    const unsigned int frame = Engine::instance().currentFrameNumber();
+    _cubeMapSource = nullptr;
+    _sampledMode = frustumMode;
+    if (_isSharingCubeMap) {
+        for (const NonLinearProjection* p : SharingProjections) {
+            // Only a cube map that the other projection has rendered itself in this
+            // frame and not overwritten since, for example with the other eye, is used
+            const bool isCurrent = p->_renderedCubeMap &&
+                p->_renderedCubeMap->frame == frame &&
+                p->_renderedCubeMap->mode == frustumMode;
+            if (p != this && isCurrent && hasSameCubeMap(*p, frustumMode)) {
+                _cubeMapSource = p;
+                _renderedCubeMap = std::nullopt;
+                if (frustumMode == FrustumMode::StereoLeft) {
+                    _interleavedFrame = std::nullopt;
+                }
+                return;
+            }
+        }
+    }
+
+    if (frustumMode == FrustumMode::StereoLeft) {
+        // The right eye can only be skipped if it was rendered together with the left
+        // eye of this frame
+        _interleavedFrame =
+            _isInterleaved ? std::optional<unsigned int>(frame) : std::nullopt;
+    }
+    renderCubemap(frustumMode);
+    _renderedCubeMap = RenderedCubeMap{ frame, frustumMode };
+}
+
+bool NonLinearProjection::hasSameCubeMap(const NonLinearProjection& other,
+                                         FrustumMode mode) const
+{
+    if (_distribution || other._distribution ||
+        other._cubemapResolution != _cubemapResolution ||
+        other._internalFormat != _internalFormat || other._attachments != _attachments ||
+        other._useDepthTransformation != _useDepthTransformation ||
+        other._faceScales != _faceScales || other._isInterleaved != _isInterleaved)
+    {
+        return false;
+    }
+
+    const std::array<const BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+    const std::array<const BaseViewport*, 6> otherFaces = {
+        &other._subViewports.right, &other._subViewports.left,
+        &other._subViewports.bottom, &other._subViewports.top,
+        &other._subViewports.front, &other._subViewports.back
+    };
+    for (int i = 0; i < 6; i++) {
+        const BaseViewport& a = *faces[i];
+        const BaseViewport& b = *otherFaces[i];
+        if (a.isEnabled() != b.isEnabled()) {
+            return false;
+        }
+        // The view projection matrices contain the user, the eye, and the orientation
+        // of the face, and the viewports contain the part of the face that is rendered
+        if (a.isEnabled() &&
+            (a.position() != b.position() || a.size() != b.size() ||
+             a.projection(mode).viewProjectionMatrix() !=
+             b.projection(mode).viewProjectionMatrix()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const NonLinearProjection::Textures& NonLinearProjection::sampledTextures() const {
+    const NonLinearProjection& p = _cubeMapSource ? *_cubeMapSource : *this;
+    return p.renderedTextures(_sampledMode);
+}
+
+const NonLinearProjection::Textures&
+NonLinearProjection::renderedTextures(FrustumMode mode) const
+{
+    return _isInterleaved && mode == FrustumMode::StereoRight ?
+        _rightEyeTextures :
+        _textures;
+}
+
+bool NonLinearProjection::isRightEyeInterleaved() const {
+    return _interleavedFrame == Engine::instance().currentFrameNumber();
+}
+
+uint8_t NonLinearProjection::enabledFaces() const {
+    const std::array<const BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+
+    uint8_t mask = 0;
+    for (size_t i = 0; i < faces.size(); i++) {
+        if (faces[i]->isEnabled()) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+uint8_t NonLinearProjection::renderedFaces() const {
+    return enabledFaces() & _localFaces;
+}
+
+bool NonLinearProjection::isHelper() const {
+    return _isHelper;
+}
+
+void NonLinearProjection::exchangeDistributedFaces(FrustumMode mode) const {
+    ZoneScoped;
+
+    if (!_distribution) {
+        return;
+    }
+
+    const std::array<const BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+    Engine& engine = Engine::instance();
+    CubeFaceDistributor& distributor = engine.cubeFaceDistributor();
+    const unsigned int frame = engine.clusterFrameNumber();
+    const unsigned int texture = renderedTextures(mode).cubeMapColor;
+
+    if (_isHelper) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _distributedFbo);
+        for (int i = 0; i < 6; i++) {
+            if ((renderedFaces() & (1 << i)) == 0) {
+                continue;
+            }
+
+            // Only the part of the face that the projection samples is sent
+            const ivec4 rect = viewportCoordinates(*faces[i], 1.f);
+            glFramebufferTexture2D(
+                GL_READ_FRAMEBUFFER,
+                GL_COLOR_ATTACHMENT0,
+                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+                texture,
+                0
+            );
+            _distributedFace.frame = frame;
+            _distributedFace.rect = rect;
+            _distributedFace.pixels.resize(static_cast<size_t>(rect.z) * rect.w * 4);
+            glReadPixels(
+                rect.x,
+                rect.y,
+                rect.z,
+                rect.w,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                _distributedFace.pixels.data()
+            );
+            distributor.send(_distribution->outputNode, i, mode, _distributedFace);
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    }
+    else {
+        const uint8_t remoteFaces = enabledFaces() & ~_localFaces;
+        glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+        for (int i = 0; i < 6; i++) {
+            if ((remoteFaces & (1 << i)) == 0 ||
+                !distributor.take(i, mode, frame, _distributedFace))
+            {
+                continue;
+            }
+
+            const ivec4& r = _distributedFace.rect;
+            if (r.x < 0 || r.y < 0 || r.x + r.z > _cubemapResolution.x ||
+                r.y + r.w > _cubemapResolution.y)
+            {
+                Log::Warning(std::format(
+                    "Cube face {} of the helper node does not fit into the cube map", i
+                ));
+                continue;
+            }
+            glTexSubImage2D(
+                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+                0,
+                r.x,
+                r.y,
+                r.z,
+                r.w,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                _distributedFace.pixels.data()
+            );
+        }
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+}
+
+void NonLinearProjection::cropCubeFace(BaseViewport& vp, vec2 min, vec2 max) {
+    if (!vp.isEnabled()) {
+        return;
+    }
+    if (min.x > max.x || min.y > max.y) {
+        vp.setEnabled(false);
+        return;
+    }
+
+    // The linear and cubic interpolation read up to two texels beyond the sampled
+    // position and the rectangle is rounded outwards to whole texels
+    const glm::vec2 res = glm::vec2(_cubemapResolution.x, _cubemapResolution.y);
+    const glm::vec2 pos = glm::vec2(vp.position().x, vp.position().y);
+    const glm::vec2 size = glm::vec2(vp.size().x, vp.size().y);
+    const glm::vec2 lo = glm::max(
+        glm::floor((glm::vec2(min.x, min.y) * res) - 2.f) / res,
+        pos
+    );
+    const glm::vec2 hi = glm::min(
+        glm::ceil((glm::vec2(max.x, max.y) * res) + 2.f) / res,
+        pos + size
+    );
+    if (lo == pos && hi == pos + size) {
+        return;
+    }
+
+    // The plane spans the part of the face that is currently rendered, so the corners
+    // of the new rectangle are interpolated relative to that part
+    const glm::vec3 ll = glm::vec3(
+        vp.projectionPlane().coordinateLowerLeft().x,
+        vp.projectionPlane().coordinateLowerLeft().y,
+        vp.projectionPlane().coordinateLowerLeft().z
+    );
+    const glm::vec3 ul = glm::vec3(
+        vp.projectionPlane().coordinateUpperLeft().x,
+        vp.projectionPlane().coordinateUpperLeft().y,
+        vp.projectionPlane().coordinateUpperLeft().z
+    );
+    const glm::vec3 ur = glm::vec3(
+        vp.projectionPlane().coordinateUpperRight().x,
+        vp.projectionPlane().coordinateUpperRight().y,
+        vp.projectionPlane().coordinateUpperRight().z
+    );
+    auto point = [&](glm::vec2 p) {
+        const glm::vec2 t = (p - pos) / size;
+        return ll + t.x * (ur - ul) + t.y * (ul - ll);
+    };
+    const glm::vec3 newLl = point(lo);
+    const glm::vec3 newUl = point(glm::vec2(lo.x, hi.y));
+    const glm::vec3 newUr = point(hi);
+
+    vp.setPosition(vec2{ lo.x, lo.y });
+    vp.setSize(vec2{ hi.x - lo.x, hi.y - lo.y });
+    vp.projectionPlane().setCoordinates(
+        vec3{ newLl.x, newLl.y, newLl.z },
+        vec3{ newUl.x, newUl.y, newUl.z },
+        vec3{ newUr.x, newUr.y, newUr.z }
+    );
+}
+
+void NonLinearProjection::cropCubeFaces(std::span<const vec3> directions) {
+    ZoneScoped;
+
+    constexpr float Inf = std::numeric_limits<float>::infinity();
+    std::array<glm::vec2, 6> min;
+    min.fill(glm::vec2(Inf));
+    std::array<glm::vec2, 6> max;
+    max.fill(glm::vec2(-Inf));
+
+    for (const vec3& d : directions) {
+        const auto [face, p] = cubeFaceCoordinate(d);
+        if (face == -1) {
+            continue;
+        }
+
+        const glm::vec2 uv = (p + 1.f) / 2.f;
+        min[face] = glm::min(min[face], uv);
+        max[face] = glm::max(max[face], uv);
+    }
+
+    std::array<BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+    for (size_t i = 0; i < faces.size(); i++) {
+        // Covers the gaps between neighboring directions
+        constexpr float Margin = 1.f / 32.f;
+        const glm::vec2 lo = min[i] - Margin;
+        const glm::vec2 hi = max[i] + Margin;
+        cropCubeFace(*faces[i], vec2{ lo.x, lo.y }, vec2{ hi.x, hi.y });
+    }
+    Log::Debug(std::format("Cube faces after cropping: {:#04x}", enabledFaces()));
+}
+
+void NonLinearProjection::scaleCubeFacesToDensity(std::span<const vec3> directions) {
+    ZoneScoped;
+
+    // The texels of a face subtend an angle that shrinks with 1 / sqrt(1 + r^2), where
+    // r is the distance from the face center on the face. So the density at the point
+    // closest to the center determines the resolution that the face needs
+    std::array<float, 6> minRadius2;
+    minRadius2.fill(std::numeric_limits<float>::infinity());
+    for (const vec3& d : directions) {
+        const auto [face, p] = cubeFaceCoordinate(d);
+        if (face != -1) {
+            minRadius2[face] = std::min(minRadius2[face], glm::dot(p, p));
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(_faceScales.size()); i++) {
+        const float scale = 1.f / std::sqrt(1.f + std::min(minRadius2[i], 2.f));
+        scaleCubeFace(i, scale * _cubemapResolution.x);
+    }
+}
+
+void NonLinearProjection::scaleCubeFacesToImage(std::span<const vec3> directions,
+                                                ivec2 gridSize, vec2 imageSize)
+{
+    ZoneScoped;
+
+    const std::array<float, 6> resolution =
+        faceResolutionsForImage(directions, gridSize, imageSize);
+    for (int i = 0; i < static_cast<int>(resolution.size()); i++) {
+        // Faces without any pair of samples are left to the cropping
+        if (resolution[i] > 0.f) {
+            scaleCubeFace(i, resolution[i]);
+        }
+    }
+}
+
+void NonLinearProjection::scaleCubeFace(int idx, float resolution) {
+    const float scale = resolution / static_cast<float>(_cubemapResolution.x);
+    // Magnifying the face blurs it slightly, which is not worth the small saving
+    _faceScales[idx] = scale < 0.9f ? scale : 1.f;
+    if (_faceScales[idx] < 1.f) {
+        Log::Debug(std::format("Cube face {} scaled by {}", idx, _faceScales[idx]));
+    }
+}
+
+void NonLinearProjection::fitCubemapResolution(std::span<const vec3> directions,
+                                               ivec2 gridSize, vec2 imageSize,
+                                               int maxResolution)
+{
+    ZoneScoped;
+
+    const std::array<float, 6> faces =
+        faceResolutionsForImage(directions, gridSize, imageSize);
+    const float needed = *std::max_element(faces.begin(), faces.end());
+    if (needed <= 0.f) {
+        return;
+    }
+
+    GLint maxCubeMapRes = 0;
+    glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &maxCubeMapRes);
+
+    // Every change of the resolution recreates the cube maps, so the small changes of
+    // the image size that the resolution scale causes are absorbed by the rounding
+    constexpr int Granularity = 64;
+    const int resolution = std::clamp(
+        static_cast<int>(std::ceil(needed / Granularity)) * Granularity,
+        Granularity,
+        std::max(std::min(maxResolution, maxCubeMapRes), Granularity)
+    );
+    if (resolution == _cubemapResolution.x && resolution == _cubemapResolution.y) {
+        return;
+    }
+
+    Log::Debug(std::format(
+        "Cube map resolution changed from {} to {} for an image of {}x{} pixels",
+        _cubemapResolution.x, resolution, imageSize.x, imageSize.y
+    ));
+    setCubemapResolution(resolution);
+    if (_cubeMapFbo) {
+        recreateCubeMaps();
+    }
+}
+
+void NonLinearProjection::recreateCubeMaps() {
+    ZoneScoped;
+
+    // The new cube maps are empty, so none of the faces can be reused
+    _faceMatrices = {};
+    _renderedCubeMap = std::nullopt;
+    TracyFreeN(this, "Non-linear projection textures");
+    _textureMemory.set(0);
+
+    // The scales of the faces are relative to the resolution of the cube map
+    _faceScales.fill(1.f);
+    _transientTargets.scaledColor = RenderTargetPool::Target();
+    _textures.scaledColor = 0;
+    initViewports();
+
+    initTextures(_internalFormat, _format, _type);
+    initFBO(_internalFormat, _nSamples);
+    if (_isLayered) {
+        generateCubeMap(
+            _textures.cubeMapDepth,
+            GL_DEPTH_COMPONENT32,
+            GL_DEPTH_COMPONENT,
+            GL_FLOAT
+        );
+    }
+    initScaledFaces();
+    if (_isInterleaved) {
+        initRightEyeTextures();
+    }
+    TracyAllocN(this, _textureMemory.bytes(), "Non-linear projection textures");
+}
+
+vec3 NonLinearProjection::renderedDirection(const vec3& cubeMapDirection) const {
+    const std::array<const BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+
+    const auto [face, p] = cubeFaceCoordinate(cubeMapDirection);
+    if (face == -1) {
+        return vec3{ 0.f, 0.f, 0.f };
+    }
+
+    // The projection plane spans the part of the face that its viewport covers
+    const BaseViewport& vp = *faces[face];
+    const glm::vec2 uv = (p + 1.f) / 2.f;
+    const glm::vec2 t =
+        (uv - glm::vec2(vp.position().x, vp.position().y)) /
+        glm::vec2(vp.size().x, vp.size().y);
+    const ProjectionPlane& plane = vp.projectionPlane();
+    const glm::vec3 ll = glm::vec3(
+        plane.coordinateLowerLeft().x,
+        plane.coordinateLowerLeft().y,
+        plane.coordinateLowerLeft().z
+    );
+    const glm::vec3 ul = glm::vec3(
+        plane.coordinateUpperLeft().x,
+        plane.coordinateUpperLeft().y,
+        plane.coordinateUpperLeft().z
+    );
+    const glm::vec3 ur = glm::vec3(
+        plane.coordinateUpperRight().x,
+        plane.coordinateUpperRight().y,
+        plane.coordinateUpperRight().z
+    );
+    const glm::vec3 dir = glm::normalize(ll + t.x * (ur - ul) + t.y * (ul - ll));
+    return vec3{ dir.x, dir.y, dir.z };
+}
+
+void NonLinearProjection::initDirectionLookup(std::string_view directionFunction) {
+    _directionLookup.bakeShader = ShaderProgram("DirectionLookupBakeShader");
+    _directionLookup.bakeShader.addVertexShader(DirectionLookupBakeVert);
+    _directionLookup.bakeShader.addFragmentShader(DirectionLookupBakeFrag);
+    _directionLookup.bakeShader.addFragmentShader(directionFunction);
+    _directionLookup.bakeShader.createAndLinkProgram();
+
+    _directionLookup.shader = ShaderProgram("DirectionLookupShader");
+    _directionLookup.shader.addVertexShader(shaders_fisheye::BaseVert);
+    _directionLookup.shader.addFragmentShader(DirectionLookupFrag);
+    _directionLookup.shader.createAndLinkProgram();
+    _directionLookup.shader.bind();
+    const unsigned int id = _directionLookup.shader.id();
+    glUniform1i(glGetUniformLocation(id, "cubemap"), 0);
+    glUniform1i(glGetUniformLocation(id, "lookup"), 1);
+    ShaderProgram::unbind();
+
+    glGenFramebuffers(1, &_directionLookup.fbo);
+    glGenVertexArrays(1, &_directionLookup.vao);
+}
+
+void NonLinearProjection::bindDirectionLookup(
+                       const std::function<void(const ShaderProgram&)>& setUniforms) const
+{
+    std::array<GLint, 4> viewport;
+    glGetIntegerv(GL_VIEWPORT, viewport.data());
+    const ivec2 size = ivec2(viewport[2], viewport[3]);
+
+    if (_directionLookup.isDirty || size != _directionLookup.size) {
+        ZoneScopedN("Bake direction lookup");
+
+        if (size != _directionLookup.size) {
+            glDeleteTextures(1, &_directionLookup.texture);
+            glGenTextures(1, &_directionLookup.texture);
+            glBindTexture(GL_TEXTURE_2D, _directionLookup.texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                GL_RG32F,
+                size.x,
+                size.y,
+                0,
+                GL_RG,
+                GL_FLOAT,
+                nullptr
+            );
+            // Every pixel reads exactly the texel that was baked for it
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            _directionLookup.size = size;
+            Log::Debug(std::format(
+                "Baking direction lookup texture of {}x{} pixels", size.x, size.y
+            ));
+        }
+
+        GLint prevFbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _directionLookup.fbo);
+        glFramebufferTexture2D(
+            GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            _directionLookup.texture,
+            0
+        );
+        glViewport(0, 0, size.x, size.y);
+        glDisable(GL_SCISSOR_TEST);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+
+        _directionLookup.bakeShader.bind();
+        if (setUniforms) {
+            setUniforms(_directionLookup.bakeShader);
+        }
+        glBindVertexArray(_directionLookup.vao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        _directionLookup.isDirty = false;
+    }
+
+    _directionLookup.shader.bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, _directionLookup.texture);
+}
+
 void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int format,
                                        unsigned int type)
 {
@@ -121,7 +983,7 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
         _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapColor
     ));
 
-    if (Engine::instance().settings().useDepthTexture) {
+    if (_attachments.depth) {
         generateCubeMap(
             _textures.cubeMapDepth,
             GL_DEPTH_COMPONENT32,
@@ -132,29 +994,9 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
             "{}x{} depth cube map texture (id: {}) generated",
             _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapDepth
         ));
-
-        if (_useDepthTransformation) {
-            // generate swap textures
-            generateMap(
-                _textures.depthSwap,
-                GL_DEPTH_COMPONENT32,
-                GL_DEPTH_COMPONENT,
-                GL_FLOAT
-            );
-            Log::Debug(std::format(
-                "{}x{} depth swap map texture (id: {}) generated",
-                _cubemapResolution.x, _cubemapResolution.y, _textures.depthSwap
-            ));
-
-            generateMap(_textures.colorSwap, internalFormat, format, type);
-            Log::Debug(std::format(
-                "{}x{} color swap map texture (id: {}) generated",
-                _cubemapResolution.x, _cubemapResolution.y, _textures.colorSwap
-            ));
-        }
     }
 
-    if (Engine::instance().settings().useNormalTexture) {
+    if (_attachments.normals) {
         generateCubeMap(_textures.cubeMapNormals, GL_RGB32F, GL_RGB, GL_FLOAT);
         Log::Debug(std::format(
             "{}x{} normal cube map texture (id: {}) generated",
@@ -162,7 +1004,7 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
         ));
     }
 
-    if (Engine::instance().settings().usePositionTexture) {
+    if (_attachments.positions) {
         generateCubeMap(_textures.cubeMapPositions, GL_RGB32F, GL_RGB, GL_FLOAT);
         Log::Debug(std::format(
             "{}x{} position cube map texture ({}) generated",
@@ -172,22 +1014,52 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
 }
 
 void NonLinearProjection::initFBO(unsigned int internalFormat, int nSamples) {
-    _cubeMapFbo = std::make_unique<OffScreenBuffer>(internalFormat);
+    _cubeMapFbo = std::make_unique<OffScreenBuffer>(internalFormat, _attachments);
     _cubeMapFbo->createFBO(_cubemapResolution.x, _cubemapResolution.y, nSamples);
 }
 
-void NonLinearProjection::setupViewport(const BaseViewport& vp) const {
-    ivec4 vpCoords = ivec4 {
-        static_cast<int>(std::floor(vp.position().x * _cubemapResolution.x + 0.5f)),
-        static_cast<int>(std::floor(vp.position().y * _cubemapResolution.y + 0.5f)),
-        static_cast<int>(std::floor(vp.size().x * _cubemapResolution.x + 0.5f)),
-        static_cast<int>(std::floor(vp.size().y * _cubemapResolution.y + 0.5f))
-    };
-
+void NonLinearProjection::setupViewport(const BaseViewport& vp, float scale) const {
+    const ivec4 vpCoords = viewportCoordinates(vp, scale);
     glViewport(vpCoords.x, vpCoords.y, vpCoords.z, vpCoords.w);
     glScissor(vpCoords.x, vpCoords.y, vpCoords.z, vpCoords.w);
 }
 
+ivec4 NonLinearProjection::viewportCoordinates(const BaseViewport& vp, float scale) const
+{
+    const float w = _cubemapResolution.x * scale;
+    const float h = _cubemapResolution.y * scale;
+    return ivec4 {
+        static_cast<int>(std::floor(vp.position().x * w + 0.5f)),
+        static_cast<int>(std::floor(vp.position().y * h + 0.5f)),
+        static_cast<int>(std::floor(vp.size().x * w + 0.5f)),
+        static_cast<int>(std::floor(vp.size().y * h + 0.5f))
+    };
+}
+
+RenderTargetPool::Target
+NonLinearProjection::acquireTransientTarget(unsigned int internalFormat,
+                                            unsigned int format, unsigned int type) const
+{
+    GLint maxMapRes = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxMapRes);
+    if (_cubemapResolution.x > maxMapRes || _cubemapResolution.y > maxMapRes) {
+        Log::Error(std::format(
+            "Requested size is too big ({}x{} > {})",
+            _cubemapResolution.x, _cubemapResolution.y, maxMapRes
+        ));
+    }
+
+    return RenderTargetPool::acquire(
+        {
+            .internalFormat = internalFormat,
+            .format = format,
+            .type = type,
+            .size = _cubemapResolution
+        },
+        MemoryTracker::Category::CubeMaps
+    );
+}
+
 void NonLinearProjection::generateMap(unsigned int& texture, unsigned int internalFormat,
                                       unsigned int format, unsigned int type)
 {
@@ -231,6 +1103,11 @@ void NonLinearProjection::generateMap(unsigned int& texture, unsigned int intern
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    _textureMemory.add(
+        static_cast<size_t>(_cubemapResolution.x) * _cubemapResolution.y *
+        MemoryTracker::bytesPerTexel(internalFormat)
+    );
 }
 
 void NonLinearProjection::generateCubeMap(unsigned int& texture,
@@ -335,75 +1212,127 @@ void NonLinearProjection::generateCubeMap(unsigned int& texture,
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    _textureMemory.add(
+        static_cast<size_t>(_cubemapResolution.x) * _cubemapResolution.y * 6 *
+        MemoryTracker::bytesPerTexel(internalFormat)
+    );
 }
 
-void NonLinearProjection::attachTextures(int face) const {
-    if (Engine::instance().settings().useDepthTexture) {
-        _cubeMapFbo->attachDepthTexture(_textures.depthSwap);
-        _cubeMapFbo->attachColorTexture(_textures.colorSwap, GL_COLOR_ATTACHMENT0);
-    }
-    else {
-        _cubeMapFbo->attachCubeMapTexture(
-            _textures.cubeMapColor,
-            face,
-            GL_COLOR_ATTACHMENT0
-        );
-    }
+OffScreenBuffer::Configuration NonLinearProjection::faceConfiguration(int face,
+                                                               FrustumMode mode) const
+{
+    using Target = OffScreenBuffer::Target;
+    auto faceOf = [face](unsigned int texture) {
+        return Target{
+            .type = Target::Type::CubeMapFace,
+            .texture = texture,
+            .index = face
+        };
+    };
 
-    if (Engine::instance().settings().useNormalTexture) {
-        _cubeMapFbo->attachCubeMapTexture(
-            _textures.cubeMapNormals,
-            face,
-            GL_COLOR_ATTACHMENT1
-        );
+    const Textures& textures = renderedTextures(mode);
+    OffScreenBuffer::Configuration configuration = {
+        .color = faceOf(textures.cubeMapColor)
+    };
+    if (_attachments.depth) {
+        configuration.depth = faceOf(textures.cubeMapDepth);
     }
-
-    if (Engine::instance().settings().usePositionTexture) {
-        _cubeMapFbo->attachCubeMapTexture(
-            _textures.cubeMapPositions,
-            face,
-            GL_COLOR_ATTACHMENT2
-        );
+    if (_attachments.normals) {
+        configuration.normals = faceOf(textures.cubeMapNormals);
+    }
+    if (_attachments.positions) {
+        configuration.positions = faceOf(textures.cubeMapPositions);
     }
+    return configuration;
 }
 
-void NonLinearProjection::blitCubeFace(int face) const {
+void NonLinearProjection::blitCubeFace(int face, FrustumMode mode) const {
     // copy AA-buffer to "regular"/non-AA buffer
-    _cubeMapFbo->bindBlit();
-    attachTextures(face);
+    _cubeMapFbo->bindBlit(faceConfiguration(face, mode));
     _cubeMapFbo->blit();
 }
 
-void NonLinearProjection::renderCubeFace(const BaseViewport& vp, int idx,
+bool NonLinearProjection::renderCubeFace(const BaseViewport& vp, int idx,
                                          FrustumMode mode) const
 {
-    if (!vp.isEnabled()) {
-        return;
+    if (!vp.isEnabled() || (_localFaces & (1 << idx)) == 0) {
+        return false;
+    }
+    if (mode == FrustumMode::StereoRight && isRightEyeInterleaved()) {
+        return false;
     }
 
-    _cubeMapFbo->bind();
-    if (!_cubeMapFbo->isMultiSampled()) {
-        attachTextures(idx);
+    const mat4 modelViewProjection = vp.projection(mode).viewProjectionMatrix() *
+        ClusterManager::instance().sceneTransform();
+    if (!isCubeFaceDue(idx, modelViewProjection)) {
+        return false;
     }
 
-    const RenderData renderData = {
-        vp.window(),
+    if (mode == FrustumMode::StereoLeft && isRightEyeInterleaved()) {
+        // Both calls of the face follow each other, so the application can reuse the
+        // objects that it has culled for the left eye for the right eye
+        const float eyeSeparation = vp.user().eyeSeparation();
+        drawCubeFace(
+            vp,
+            idx,
+            FrustumMode::StereoLeft,
+            RenderData::EyePair{ .isFirst = true, .eyeSeparation = eyeSeparation }
+        );
+        drawCubeFace(
+            vp,
+            idx,
+            FrustumMode::StereoRight,
+            RenderData::EyePair{ .isFirst = false, .eyeSeparation = eyeSeparation }
+        );
+    }
+    else {
+        drawCubeFace(vp, idx, mode, std::nullopt);
+    }
+    return true;
+}
+
+void NonLinearProjection::drawCubeFace(const BaseViewport& vp, int idx, FrustumMode mode,
+                                       std::optional<RenderData::EyePair> eyePair) const
+{
+    const mat4 modelViewProjection = vp.projection(mode).viewProjectionMatrix() *
+        ClusterManager::instance().sceneTransform();
+    const bool isScaled = _textures.scaledColor != 0 && _faceScales[idx] < 1.f;
+
+    if (isScaled) {
+        _cubeMapFbo->bind(OffScreenBuffer::Configuration{
+            .color = OffScreenBuffer::Target{ .texture = _textures.scaledColor }
+        });
+    }
+    else if (!_cubeMapFbo->isMultiSampled()) {
+        _cubeMapFbo->bind(faceConfiguration(idx, mode));
+    }
+    else {
+        _cubeMapFbo->bind();
+    }
+
+    // The face is only rendered again if its matrix without the jitter of the temporal
+    // anti-aliasing changes
+    const Window& window = vp.window();
+    RenderData renderData = {
+        window,
         vp,
         mode,
         ClusterManager::instance().sceneTransform(),
         vp.projection(mode).viewMatrix(),
-        vp.projection(mode).projectionMatrix(),
-        vp.projection(mode).viewProjectionMatrix() *
-            ClusterManager::instance().sceneTransform(),
+        window.jitteredMatrix(vp.projection(mode).projectionMatrix(), _cubemapResolution),
+        window.jitteredMatrix(modelViewProjection, _cubemapResolution),
         _cubemapResolution
     };
+    renderData.radialDepth = radialDepth();
+    renderData.eyePair = eyePair;
     glLineWidth(1.f);
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
     glDepthFunc(GL_LESS);
 
     glEnable(GL_SCISSOR_TEST);
-    setupViewport(vp);
+    setupViewport(vp, isScaled ? _faceScales[idx] : 1.f);
 
     glClearColor(0.f, 0.f, 0.f, 0.f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -414,8 +1343,187 @@ void NonLinearProjection::renderCubeFace(const BaseViewport& vp, int idx,
 
     // blit MSAA fbo to texture
     if (_cubeMapFbo->isMultiSampled()) {
-        blitCubeFace(idx);
+        blitCubeFace(idx, mode);
+    }
+
+    if (isScaled) {
+        magnifyScaledFace(
+            vp,
+            idx,
+            GL_TEXTURE_CUBE_MAP_POSITIVE_X + idx,
+            renderedTextures(mode).cubeMapColor
+        );
+    }
+}
+
+std::optional<RenderData::RadialDepth> NonLinearProjection::radialDepth() const {
+    if (!_useDepthTransformation || !_attachments.depth) {
+        return std::nullopt;
+    }
+    const Engine& engine = Engine::instance();
+    return RenderData::RadialDepth{
+        .nearClip = engine.nearClipPlane(),
+        .farClip = engine.farClipPlane()
+    };
+}
+
+bool NonLinearProjection::isCubeFaceDue(int idx, const mat4& modelViewProjection) const {
+    const int interval = Engine::instance().settings().cubeMapRefreshInterval;
+    // Both eyes are rendered into the same cube map, so nothing can be reused
+    if (interval <= 1 || _isStereo) {
+        return true;
+    }
+
+    if (_faceMatrices[idx] == modelViewProjection) {
+        // The enabled faces that come before this one decide its turn, which spreads
+        // the faces evenly over the frames of the interval
+        const int turn = std::popcount(static_cast<unsigned int>(
+            enabledFaces() & ((1 << idx) - 1)
+        ));
+        const unsigned int frame = Engine::instance().clusterFrameNumber();
+        if ((frame + turn) % interval != 0) {
+            return false;
+        }
+    }
+
+    _faceMatrices[idx] = modelViewProjection;
+    return true;
+}
+
+void NonLinearProjection::magnifyScaledFace(const BaseViewport& vp, int idx,
+                                            unsigned int target,
+                                            unsigned int texture) const
+{
+    // The scaled texture is still attached to the cube map framebuffer, which is the
+    // framebuffer that is read from
+    const ivec4 src = viewportCoordinates(vp, _faceScales[idx]);
+    const ivec4 dst = viewportCoordinates(vp, 1.f);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _scaledFbo);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, texture, 0);
+    glBlitFramebuffer(
+        src.x, src.y, src.x + src.z, src.y + src.w,
+        dst.x, dst.y, dst.x + dst.z, dst.y + dst.w,
+        GL_COLOR_BUFFER_BIT,
+        GL_LINEAR
+    );
+    _cubeMapFbo->bind();
+}
+
+void NonLinearProjection::renderCubeFacesLayered(FrustumMode mode, uint8_t faceMask) const
+{
+    ZoneScoped;
+
+    if (faceMask == 0) {
+        return;
+    }
+    if (mode == FrustumMode::StereoRight && isRightEyeInterleaved()) {
+        return;
+    }
+
+    if (mode == FrustumMode::StereoLeft && isRightEyeInterleaved()) {
+        const float eyeSeparation = _subViewports.right.user().eyeSeparation();
+        drawCubeFacesLayered(
+            FrustumMode::StereoLeft,
+            faceMask,
+            RenderData::EyePair{ .isFirst = true, .eyeSeparation = eyeSeparation }
+        );
+        drawCubeFacesLayered(
+            FrustumMode::StereoRight,
+            faceMask,
+            RenderData::EyePair{ .isFirst = false, .eyeSeparation = eyeSeparation }
+        );
+    }
+    else {
+        drawCubeFacesLayered(mode, faceMask, std::nullopt);
+    }
+}
+
+void NonLinearProjection::drawCubeFacesLayered(FrustumMode mode, uint8_t faceMask,
+                                     std::optional<RenderData::EyePair> eyePair) const
+{
+    using Target = OffScreenBuffer::Target;
+    auto layered = [](unsigned int texture) {
+        return Target{ .type = Target::Type::Layered, .texture = texture };
+    };
+
+    const Textures& textures = renderedTextures(mode);
+    OffScreenBuffer::Configuration configuration = {
+        .color = layered(textures.cubeMapColor),
+        .depth = layered(textures.cubeMapDepth)
+    };
+    if (_attachments.normals) {
+        configuration.normals = layered(textures.cubeMapNormals);
+    }
+    if (_attachments.positions) {
+        configuration.positions = layered(textures.cubeMapPositions);
+    }
+    _cubeMapFbo->bind(configuration);
+
+    const std::array<const BaseViewport*, 6> faces = {
+        &_subViewports.right, &_subViewports.left, &_subViewports.bottom,
+        &_subViewports.top, &_subViewports.front, &_subViewports.back
+    };
+
+    const mat4& scene = ClusterManager::instance().sceneTransform();
+    const Window& window = faces[0]->window();
+    RenderData::CubeFaces cubeFaces;
+    cubeFaces.faceMask = faceMask;
+    int first = -1;
+    for (int i = 0; i < 6; i++) {
+        const Projection& proj = faces[i]->projection(mode);
+        cubeFaces.viewMatrices[i] = proj.viewMatrix();
+        cubeFaces.projectionMatrices[i] =
+            window.jitteredMatrix(proj.projectionMatrix(), _cubemapResolution);
+        cubeFaces.modelViewProjectionMatrices[i] =
+            window.jitteredMatrix(proj.viewProjectionMatrix(scene), _cubemapResolution);
+        if (first == -1 && (faceMask & (1 << i))) {
+            first = i;
+        }
+    }
+
+    const BaseViewport& vp = *faces[first];
+    RenderData renderData = {
+        vp.window(),
+        vp,
+        mode,
+        scene,
+        cubeFaces.viewMatrices[first],
+        cubeFaces.projectionMatrices[first],
+        cubeFaces.modelViewProjectionMatrices[first],
+        _cubemapResolution
+    };
+    renderData.cubeFaces = std::move(cubeFaces);
+    renderData.radialDepth = radialDepth();
+    renderData.eyePair = eyePair;
+
+    glLineWidth(1.f);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    glDepthFunc(GL_LESS);
+
+    // Cropped faces only cover a part of their layer, so every face has its own viewport
+    // that the application selects together with the layer. Clearing a layered
+    // framebuffer clears all of its layers
+    const vec2 res = vec2{
+        static_cast<float>(_cubemapResolution.x),
+        static_cast<float>(_cubemapResolution.y)
+    };
+    for (int i = 0; i < 6; i++) {
+        const BaseViewport& face = *faces[i];
+        glViewportIndexedf(
+            i,
+            std::floor(face.position().x * res.x + 0.5f),
+            std::floor(face.position().y * res.y + 0.5f),
+            std::floor(face.size().x * res.x + 0.5f),
+            std::floor(face.size().y * res.y + 0.5f)
+        );
     }
+
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    Engine::instance().drawFunction()(renderData);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 }
 
 } // namespace sgct
@@ -30,12 +30,15 @@ namespace {
   layout (location = 2) in vec4 in_vertColor;
   out vec2 tr_uv;
   out vec4 tr_color;
+  flat out int tr_segment;
 
   uniform mat4 mvp;
 
   void main() {
     gl_Position = mvp * vec4(in_position, 0.0, 1.0);
-    tr_uv = in_texCoords;
+    // The texture coordinates of the merged mesh are moved by twice the segment
+    tr_segment = int(floor(in_texCoords.y / 2.0));
+    tr_uv = vec2(in_texCoords.x, in_texCoords.y - 2.0 * float(tr_segment));
     tr_color = in_vertColor;
   }
 )";
@@ -45,11 +48,31 @@ namespace {
 
   in vec2 tr_uv;
   in vec4 tr_color;
+  flat in int tr_segment;
   out vec4 out_color;
 
-  uniform sampler2D tex;
+  uniform sampler2D texBottom;
+  uniform sampler2D texLeft;
+  uniform sampler2D texRight;
+  uniform sampler2D texTop;
 
-  void main() { out_color = tr_color * texture(tex, tr_uv); }
+  void main() {
+    // Arrays of samplers can only be indexed by constants in this version
+    vec4 color;
+    if (tr_segment == 0) {
+      color = texture(texBottom, tr_uv);
+    }
+    else if (tr_segment == 1) {
+      color = texture(texLeft, tr_uv);
+    }
+    else if (tr_segment == 2) {
+      color = texture(texRight, tr_uv);
+    }
+    else {
+      color = texture(texTop, tr_uv);
+    }
+    out_color = tr_color * color;
+  }
 )";
 } // namespace
 
@@ -61,6 +84,7 @@ SphericalMirrorProjection::SphericalMirrorProjection(
                                                                                User& user)
     : NonLinearProjection(parent)
     , _tilt(config.tilt.value_or(0.f))
+    , _useAdaptiveResolution(config.adaptiveResolution.value_or(false))
     , _meshPathBottom(config.mesh.bottom)
     , _meshPathLeft(config.mesh.left)
     , _meshPathRight(config.mesh.right)
@@ -76,10 +100,9 @@ SphericalMirrorProjection::SphericalMirrorProjection(
 
 SphericalMirrorProjection::~SphericalMirrorProjection() {
     _shader.deleteProgram();
-    _depthCorrectionShader.deleteProgram();
 }
 
-void SphericalMirrorProjection::update(const vec2&) const {}
+void SphericalMirrorProjection::update(const vec2&) {}
 
 void SphericalMirrorProjection::render(const BaseViewport& viewport,
                                        FrustumMode frustumMode) const
@@ -97,27 +120,36 @@ void SphericalMirrorProjection::render(const BaseViewport& viewport,
 
     _shader.bind();
 
-    glActiveTexture(GL_TEXTURE0);
-
     glDisable(GL_CULL_FACE);
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_ALWAYS);
 
-    glUniform1i(_texLoc, 0);
     glUniformMatrix4fv(_matrixLoc, 1, GL_FALSE, glm::value_ptr(mvp));
 
-    glBindTexture(GL_TEXTURE_2D, _textures.cubeFaceFront);
-    _meshBottom.renderWarpMesh();
-
-    glBindTexture(GL_TEXTURE_2D, _textures.cubeFaceLeft);
-    _meshLeft.renderWarpMesh();
-
-    glBindTexture(GL_TEXTURE_2D, _textures.cubeFaceRight);
-    _meshRight.renderWarpMesh();
-
-    glBindTexture(GL_TEXTURE_2D, _textures.cubeFaceTop);
-    _meshTop.renderWarpMesh();
+    // The bottom mesh samples the front face, as the bottom face is disabled
+    const std::array<unsigned int, 4> textures = {
+        _textures.cubeFaceFront,
+        _textures.cubeFaceLeft,
+        _textures.cubeFaceRight,
+        _textures.cubeFaceTop
+    };
+    if (_isMerged) {
+        for (size_t i = 0; i < textures.size(); i++) {
+            glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+        }
+        _meshes[0].renderWarpMesh();
+        glActiveTexture(GL_TEXTURE0);
+    }
+    else {
+        // Each mesh is its own first segment, which samples the first texture unit
+        glActiveTexture(GL_TEXTURE0);
+        for (size_t i = 0; i < textures.size(); i++) {
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+            _meshes[i].renderWarpMesh();
+        }
+    }
 
     ShaderProgram::unbind();
 
@@ -128,20 +160,34 @@ void SphericalMirrorProjection::render(const BaseViewport& viewport,
 void SphericalMirrorProjection::renderCubemap(FrustumMode frustumMode) const {
     ZoneScoped;
 
-    auto renderInternal = [this, frustumMode](const BaseViewport& bv, unsigned int t) {
+    auto renderInternal = [this, frustumMode](const BaseViewport& bv, int idx,
+                                              unsigned int t)
+    {
         if (!bv.isEnabled()) {
             return;
         }
-        _cubeMapFbo->bind();
-        if (!_cubeMapFbo->isMultiSampled()) {
-            _cubeMapFbo->attachColorTexture(t, GL_COLOR_ATTACHMENT0);
+        const bool isScaled = _textures.scaledColor != 0 && _faceScales[idx] < 1.f;
+
+        using Target = OffScreenBuffer::Target;
+        if (isScaled) {
+            _cubeMapFbo->bind(OffScreenBuffer::Configuration{
+                .color = Target{ .texture = _textures.scaledColor }
+            });
+        }
+        else if (!_cubeMapFbo->isMultiSampled()) {
+            _cubeMapFbo->bind(OffScreenBuffer::Configuration{
+                .color = Target{ .texture = t }
+            });
+        }
+        else {
+            _cubeMapFbo->bind();
         }
 
         // Draw Cube Face
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         glDepthFunc(GL_LESS);
 
-        setupViewport(bv);
+        setupViewport(bv, isScaled ? _faceScales[idx] : 1.f);
 
         glClearColor(0.f, 0.f, 0.f, 0.f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -163,18 +209,23 @@ void SphericalMirrorProjection::renderCubemap(FrustumMode frustumMode) const {
 
         if (_cubeMapFbo->isMultiSampled()) {
             // blit MSAA fbo to texture
-            _cubeMapFbo->bindBlit();
-            _cubeMapFbo->attachColorTexture(t, GL_COLOR_ATTACHMENT0);
+            _cubeMapFbo->bindBlit(OffScreenBuffer::Configuration{
+                .color = OffScreenBuffer::Target{ .texture = t }
+            });
             _cubeMapFbo->blit();
         }
+
+        if (isScaled) {
+            magnifyScaledFace(bv, idx, GL_TEXTURE_2D, t);
+        }
     };
 
-    renderInternal(_subViewports.right, _textures.cubeFaceRight);
-    renderInternal(_subViewports.left, _textures.cubeFaceLeft);
-    renderInternal(_subViewports.bottom, _textures.cubeFaceBottom);
-    renderInternal(_subViewports.top, _textures.cubeFaceTop);
-    renderInternal(_subViewports.front, _textures.cubeFaceFront);
-    renderInternal(_subViewports.back, _textures.cubeFaceBack);
+    renderInternal(_subViewports.right, 0, _textures.cubeFaceRight);
+    renderInternal(_subViewports.left, 1, _textures.cubeFaceLeft);
+    renderInternal(_subViewports.bottom, 2, _textures.cubeFaceBottom);
+    renderInternal(_subViewports.top, 3, _textures.cubeFaceTop);
+    renderInternal(_subViewports.front, 4, _textures.cubeFaceFront);
+    renderInternal(_subViewports.back, 5, _textures.cubeFaceBack);
 }
 
 void SphericalMirrorProjection::setTilt(float angle) {
@@ -206,10 +257,49 @@ void SphericalMirrorProjection::initTextures(unsigned int internalFormat,
 }
 
 void SphericalMirrorProjection::initVBO() {
-    _meshBottom.loadMesh(_meshPathBottom, _subViewports.bottom);
-    _meshLeft.loadMesh(_meshPathLeft, _subViewports.left);
-    _meshRight.loadMesh(_meshPathRight, _subViewports.right);
-    _meshTop.loadMesh(_meshPathTop, _subViewports.top);
+    const std::array<std::filesystem::path, 4> paths = {
+        _meshPathBottom, _meshPathLeft, _meshPathRight, _meshPathTop
+    };
+    const std::array<BaseViewport*, 4> parents = {
+        &_subViewports.bottom, &_subViewports.left, &_subViewports.right,
+        &_subViewports.top
+    };
+
+    // The segments are merged into one mesh that is rendered with a single draw call,
+    // unless one of them is in a format whose parser changes its viewport
+    _isMerged = std::all_of(paths.begin(), paths.end(), CorrectionMesh::isMergeable);
+    if (_isMerged) {
+        const std::array<const BaseViewport*, 4> p = {
+            parents[0], parents[1], parents[2], parents[3]
+        };
+        _meshes[0].loadMergedMesh(paths, p);
+    }
+    else {
+        for (size_t i = 0; i < paths.size(); i++) {
+            _meshes[i].loadMesh(paths[i], *parents[i]);
+        }
+    }
+
+    // Each mesh samples one face, as in the render function, so the faces are only
+    // rendered where their mesh samples them and at the resolution that the mesh needs
+    auto crop = [this](int segment, BaseViewport& face, int idx) {
+        const CorrectionMesh& mesh = _meshes[_isMerged ? 0 : segment];
+        const std::optional<std::pair<vec2, vec2>> bounds =
+            _isMerged ? mesh.warpTextureBounds(segment) : mesh.warpTextureBounds();
+        if (bounds) {
+            cropCubeFace(face, bounds->first, bounds->second);
+        }
+        const std::optional<float> resolution = _isMerged ?
+            mesh.warpTextureResolution(segment) :
+            mesh.warpTextureResolution();
+        if (_useAdaptiveResolution && resolution) {
+            scaleCubeFace(idx, *resolution);
+        }
+    };
+    crop(0, _subViewports.front, 4);
+    crop(1, _subViewports.left, 1);
+    crop(2, _subViewports.right, 0);
+    crop(3, _subViewports.top, 3);
 }
 
 void SphericalMirrorProjection::initViewports() {
@@ -311,8 +401,10 @@ void SphericalMirrorProjection::initShaders() {
     _shader.createAndLinkProgram();
     _shader.bind();
 
-    _texLoc = glGetUniformLocation(_shader.id(), "tex");
-    glUniform1i(_texLoc, 0);
+    glUniform1i(glGetUniformLocation(_shader.id(), "texBottom"), 0);
+    glUniform1i(glGetUniformLocation(_shader.id(), "texLeft"), 1);
+    glUniform1i(glGetUniformLocation(_shader.id(), "texRight"), 2);
+    glUniform1i(glGetUniformLocation(_shader.id(), "texTop"), 3);
 
     _matrixLoc = glGetUniformLocation(_shader.id(), "mvp");
 
@@ -0,0 +1,285 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/rawcapturefile.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#define SGCT_ERRNO GetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <new>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+namespace {
+    // The file grows by at least this many bytes whenever the preallocated space is used
+    // up, so that the file system does not have to allocate space for every frame
+    constexpr uint64_t GrowthSize = 1024 * 1024 * 1024;
+
+    // The file header is stored in the byte order of the computer that wrote the file
+    struct FileHeader {
+        std::array<char, 8> magic = { 'S', 'G', 'C', 'T', 'R', 'A', 'W', '\0' };
+        uint32_t version = 1;
+        uint32_t headerSize = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t nChannels = 0;
+        int32_t bytesPerChannel = 0;
+        uint64_t frameSize = 0;
+        uint64_t slotSize = 0;
+        uint64_t nFrames = 0;
+    };
+    static_assert(sizeof(FileHeader) <= sgct::RawCaptureFile::HeaderSize);
+
+    size_t alignUp(size_t value) {
+        constexpr size_t A = sgct::RawCaptureFile::Alignment;
+        return (value + A - 1) / A * A;
+    }
+
+    sgct::RawCaptureFile::Buffer allocateBuffer(size_t size) {
+        std::byte* buffer = static_cast<std::byte*>(
+            ::operator new[](size, std::align_val_t(sgct::RawCaptureFile::Alignment))
+        );
+        return sgct::RawCaptureFile::Buffer(buffer);
+    }
+} // namespace
+
+namespace sgct {
+
+void RawCaptureFile::AlignedDelete::operator()(std::byte* buffer) const {
+    ::operator delete[](buffer, std::align_val_t(Alignment));
+}
+
+RawCaptureFile::RawCaptureFile(std::filesystem::path path, ivec2 size, int nChannels,
+                               int bytesPerChannel)
+    : _path(std::move(path))
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    , _filename(_path.string())
+    , _size(std::move(size))
+    , _nChannels(nChannels)
+    , _bytesPerChannel(bytesPerChannel)
+    , _frameSize(
+        static_cast<size_t>(_size.x) * _size.y * _nChannels * _bytesPerChannel
+    )
+    , _slotSize(alignUp(SlotHeaderSize + _frameSize))
+{
+    ZoneScoped;
+
+#ifdef WIN32
+    // Unbuffered writes bypass the file system cache, which would otherwise fill up with
+    // frames that are never read again
+    _handle = CreateFileW(
+        _path.c_str(),
+        GENERIC_WRITE,
+        0,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH,
+        nullptr
+    );
+    if (_handle == INVALID_HANDLE_VALUE) {
+        _handle = nullptr;
+        throw Err(
+            9015,
+            std::format(
+                "Failed to create raw capture file '{}': {}", _filename, SGCT_ERRNO
+            )
+        );
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    constexpr int Flags = O_WRONLY | O_CREAT | O_TRUNC;
+    constexpr mode_t Mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+#ifdef O_DIRECT
+    // Direct writes bypass the file system cache, which would otherwise fill up with
+    // frames that are never read again. Not all file systems support them, though
+    _fd = open(_filename.c_str(), Flags | O_DIRECT, Mode);
+    if (_fd == -1 && errno == EINVAL) {
+        Log::Debug(std::format("Direct writes are not supported for '{}'", _filename));
+        _fd = open(_filename.c_str(), Flags, Mode);
+    }
+#else // ^^^^ O_DIRECT // !O_DIRECT vvvv
+    _fd = open(_filename.c_str(), Flags, Mode);
+#endif // O_DIRECT
+    if (_fd == -1) {
+        throw Err(
+            9015,
+            std::format(
+                "Failed to create raw capture file '{}': {}", _filename, SGCT_ERRNO
+            )
+        );
+    }
+#ifdef F_NOCACHE
+    fcntl(_fd, F_NOCACHE, 1);
+#endif // F_NOCACHE
+#endif // WIN32
+
+    Log::Info(std::format(
+        "Capturing {}x{} frames with {} bytes per pixel into '{}'",
+        _size.x, _size.y, _nChannels * _bytesPerChannel, _filename
+    ));
+
+    reserve(HeaderSize + _slotSize);
+}
+
+RawCaptureFile::~RawCaptureFile() {
+    ZoneScoped;
+
+    const uint64_t nFrames = _nFrames;
+    try {
+        FileHeader header;
+        header.headerSize = static_cast<uint32_t>(HeaderSize);
+        header.width = _size.x;
+        header.height = _size.y;
+        header.nChannels = _nChannels;
+        header.bytesPerChannel = _bytesPerChannel;
+        header.frameSize = _frameSize;
+        header.slotSize = _slotSize;
+        header.nFrames = nFrames;
+
+        Buffer buffer = allocateBuffer(HeaderSize);
+        std::memset(buffer.get(), 0, HeaderSize);
+        std::memcpy(buffer.get(), &header, sizeof(FileHeader));
+        writeAt(0, buffer.get(), HeaderSize);
+    }
+    catch (const Error& e) {
+        Log::Error(std::format("Failed to write raw capture header: {}", e.message));
+    }
+
+    // The space that was preallocated for the following frames is released again
+    const uint64_t fileSize = HeaderSize + nFrames * _slotSize;
+#ifdef WIN32
+    FILE_END_OF_FILE_INFO info = {};
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(fileSize);
+    SetFileInformationByHandle(_handle, FileEndOfFileInfo, &info, sizeof(info));
+    CloseHandle(_handle);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (ftruncate(_fd, static_cast<off_t>(fileSize)) == -1) {
+        Log::Warning(std::format("Failed to truncate raw capture file: {}", SGCT_ERRNO));
+    }
+    close(_fd);
+#endif // WIN32
+
+    Log::Info(std::format("Captured {} frames into '{}'", nFrames, _filename));
+}
+
+RawCaptureFile::Buffer RawCaptureFile::createBuffer() const {
+    Buffer buffer = allocateBuffer(_slotSize);
+    // The padding at the end of the slot is written as well, so it should not contain
+    // whatever was in memory before
+    std::memset(buffer.get(), 0, _slotSize);
+    return buffer;
+}
+
+void RawCaptureFile::write(uint64_t number, const unsigned char* data, std::byte* buffer)
+{
+    ZoneScoped;
+
+    std::memcpy(buffer, &number, sizeof(uint64_t));
+    std::memcpy(buffer + SlotHeaderSize, data, _frameSize);
+
+    const uint64_t slot = _nFrames++;
+    const uint64_t offset = HeaderSize + slot * _slotSize;
+    reserve(offset + _slotSize);
+    writeAt(offset, buffer, _slotSize);
+}
+
+size_t RawCaptureFile::slotSize() const {
+    return _slotSize;
+}
+
+void RawCaptureFile::writeAt(uint64_t offset, const std::byte* data, size_t size) {
+    while (size > 0) {
+#ifdef WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        // The chunk size is a multiple of the alignment that unbuffered writes require
+        const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1 << 30));
+        DWORD written = 0;
+        const BOOL success = WriteFile(_handle, data, chunk, &written, &overlapped);
+        if (!success || written == 0) {
+            throw Err(
+                9016,
+                std::format("Failed to write to '{}': {}", _filename, SGCT_ERRNO)
+            );
+        }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        const ssize_t written = pwrite(_fd, data, size, static_cast<off_t>(offset));
+        if (written == -1 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            throw Err(
+                9016,
+                std::format("Failed to write to '{}': {}", _filename, SGCT_ERRNO)
+            );
+        }
+#endif // WIN32
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+void RawCaptureFile::reserve(uint64_t size) {
+    if (size <= _reservedSize) {
+        return;
+    }
+
+    std::lock_guard lock(_reserveMutex);
+    const uint64_t reserved = _reservedSize;
+    if (size <= reserved) {
+        // Another thread has grown the file in the meantime
+        return;
+    }
+
+    ZoneScoped;
+    const uint64_t newSize =
+        std::max(size, reserved + std::max<uint64_t>(GrowthSize, 8 * _slotSize));
+#ifdef WIN32
+    FILE_ALLOCATION_INFO info = {};
+    info.AllocationSize.QuadPart = static_cast<LONGLONG>(newSize);
+    const bool success =
+        SetFileInformationByHandle(_handle, FileAllocationInfo, &info, sizeof(info));
+#elif defined(__linux__) // ^^^^ WIN32 // __linux__ vvvv
+    const bool success = posix_fallocate(
+        _fd,
+        static_cast<off_t>(reserved),
+        static_cast<off_t>(newSize - reserved)
+    ) == 0;
+#else // ^^^^ __linux__ // !WIN32 && !__linux__ vvvv
+    // Without a portable way to preallocate, the file grows with every written frame
+    const bool success = true;
+#endif // WIN32
+    if (!success) {
+        Log::Warning(std::format(
+            "Failed to preallocate {} bytes for '{}'", newSize, _filename
+        ));
+    }
+    _reservedSize = newSize;
+}
+
+} // namespace sgct
@@ -0,0 +1,404 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/rdmaconnection.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <poll.h>
+#include <rdma/rdma_cma.h>
+#include <rdma/rdma_verbs.h>
+#include <chrono>
+#include <cstring>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    // The wait for an incoming connection is interrupted regularly to notice when the
+    // connection should terminate
+    constexpr int PollTimeout = 100; // ms
+
+    // The number of intervals a client waits before trying to connect again
+    constexpr int RetryIntervals = 10;
+
+    // Every slot might receive a block and every block we sent might be answered by a
+    // credit, so this is the maximum number of receives that can be outstanding
+    constexpr int NumberOfReceives = 2 * sgct::RdmaConnection::NumberOfSlots;
+
+    // Sent in the private data of the connection request and its reply to tell the other
+    // side where to write the data
+    struct RemoteRegion {
+        uint64_t address;
+        uint32_t key;
+        uint32_t size;
+    };
+
+    ibv_qp_init_attr queueAttributes() {
+        ibv_qp_init_attr attr = {};
+        attr.cap.max_send_wr = NumberOfReceives;
+        attr.cap.max_recv_wr = NumberOfReceives;
+        attr.cap.max_send_sge = 1;
+        attr.cap.max_recv_sge = 1;
+        attr.qp_type = IBV_QPT_RC;
+        attr.sq_sig_all = 1;
+        return attr;
+    }
+
+    void postAndWait(rdma_cm_id* id, ibv_send_wr& wr) {
+        ibv_send_wr* bad = nullptr;
+        if (ibv_post_send(id->qp, &wr, &bad) != 0) {
+            throw Err(5040, std::format("Failed to post RDMA send: {}", errno));
+        }
+
+        ibv_wc wc = {};
+        if (rdma_get_send_comp(id, &wc) <= 0 || wc.status != IBV_WC_SUCCESS) {
+            throw Err(
+                5040,
+                std::format("RDMA send failed: {}", ibv_wc_status_str(wc.status))
+            );
+        }
+    }
+} // namespace
+
+namespace sgct {
+
+RdmaConnection::RdmaConnection(int port, std::string address, bool isServer,
+                               char* sendBuffer, size_t bufferSize,
+                               std::function<void(char*, int, int)> decode,
+                               std::function<void(int)> acknowledge)
+    : _port(port)
+    , _address(std::move(address))
+    , _isServer(isServer)
+    , _sendBuffer(sendBuffer)
+    , _bufferSize(bufferSize)
+    , _receiveBuffer(NumberOfSlots * bufferSize)
+    , _decode(std::move(decode))
+    , _acknowledge(std::move(acknowledge))
+{
+    _thread = std::make_unique<std::thread>([this]() { run(); });
+}
+
+RdmaConnection::~RdmaConnection() {
+    _shouldTerminate = true;
+    {
+        // Flushes the outstanding receives, which wakes up the connection's thread
+        const std::unique_lock lock(_sendMutex);
+        if (_id && _isConnected) {
+            rdma_disconnect(_id);
+        }
+    }
+    _creditCond.notify_all();
+
+    if (_thread) {
+        _thread->join();
+    }
+    cleanup();
+}
+
+bool RdmaConnection::isConnected() const {
+    return _isConnected;
+}
+
+bool RdmaConnection::send(int length, int packageId) {
+    ZoneScoped;
+
+    if (!_isConnected) {
+        return false;
+    }
+
+    {
+        std::unique_lock lock(_creditMutex);
+        _creditCond.wait(lock, [this]() { return _credits > 0 || !_isConnected; });
+        if (!_isConnected) {
+            return false;
+        }
+        _credits--;
+    }
+
+    const std::unique_lock lock(_sendMutex);
+    if (!_isConnected) {
+        return false;
+    }
+    if (static_cast<uint32_t>(length) > _remoteSize) {
+        throw Err(
+            5040,
+            std::format(
+                "RDMA block of {} bytes exceeds the remote buffer of {} bytes",
+                length, _remoteSize
+            )
+        );
+    }
+
+    ibv_sge sge = {};
+    sge.addr = reinterpret_cast<uint64_t>(_sendBuffer);
+    sge.length = static_cast<uint32_t>(length);
+    sge.lkey = _sendRegion->lkey;
+
+    ibv_send_wr wr = {};
+    wr.opcode = IBV_WR_RDMA_WRITE_WITH_IMM;
+    wr.imm_data = htonl(static_cast<uint32_t>(packageId));
+    wr.sg_list = &sge;
+    wr.num_sge = 1;
+    wr.wr.rdma.remote_addr =
+        _remoteAddress + static_cast<uint64_t>(_nextSendSlot) * _remoteSize;
+    wr.wr.rdma.rkey = _remoteKey;
+    postAndWait(_id, wr);
+
+    _nextSendSlot = (_nextSendSlot + 1) % NumberOfSlots;
+    return true;
+}
+
+void RdmaConnection::run() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Network, "RDMA");
+
+    while (!_shouldTerminate) {
+        try {
+            const bool isEstablished = _isServer ? accept() : connect();
+            if (isEstablished) {
+                Log::Info(std::format("RDMA connection on port {} established", _port));
+                receive();
+                Log::Info(std::format("RDMA connection on port {} closed", _port));
+            }
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
+        cleanup();
+
+        // Give the other side some time before trying again
+        for (int i = 0; i < RetryIntervals && !_isServer && !_shouldTerminate; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeout));
+        }
+    }
+}
+
+bool RdmaConnection::accept() {
+    ZoneScoped;
+
+    const std::string port = std::to_string(_port);
+    rdma_addrinfo hints = {};
+    hints.ai_flags = RAI_PASSIVE;
+    hints.ai_port_space = RDMA_PS_TCP;
+    rdma_addrinfo* res = nullptr;
+    if (rdma_getaddrinfo(nullptr, port.c_str(), &hints, &res) != 0) {
+        throw Err(5040, std::format("Failed to get RDMA address info: {}", errno));
+    }
+
+    ibv_qp_init_attr attr = queueAttributes();
+    const int result = rdma_create_ep(&_listenId, res, nullptr, &attr);
+    rdma_freeaddrinfo(res);
+    if (result != 0 || rdma_listen(_listenId, 1) != 0) {
+        throw Err(
+            5040,
+            std::format("Failed to listen for RDMA connections on port {}", _port)
+        );
+    }
+
+    // Waiting for the request on the connection manager's channel directly would block
+    // without a way of shutting down
+    pollfd fd = {};
+    fd.fd = _listenId->channel->fd;
+    fd.events = POLLIN;
+    while (!_shouldTerminate && poll(&fd, 1, PollTimeout) <= 0) {}
+    if (_shouldTerminate) {
+        return false;
+    }
+
+    if (rdma_get_request(_listenId, &_id) != 0) {
+        throw Err(5040, std::format("Failed to get RDMA connection request: {}", errno));
+    }
+    const rdma_conn_param& request = _id->event->param.conn;
+    if (request.private_data_len < sizeof(RemoteRegion)) {
+        throw Err(5040, "Received RDMA connection request without remote region");
+    }
+    RemoteRegion remote;
+    std::memcpy(&remote, request.private_data, sizeof(RemoteRegion));
+    _remoteAddress = remote.address;
+    _remoteKey = remote.key;
+    _remoteSize = remote.size;
+
+    registerRegions();
+    for (int i = 0; i < NumberOfReceives; i++) {
+        postReceive();
+    }
+
+    const RemoteRegion local = {
+        .address = reinterpret_cast<uint64_t>(_receiveBuffer.data()),
+        .key = _receiveRegion->rkey,
+        .size = static_cast<uint32_t>(_bufferSize)
+    };
+    rdma_conn_param param = {};
+    param.private_data = &local;
+    param.private_data_len = sizeof(RemoteRegion);
+    if (rdma_accept(_id, &param) != 0) {
+        throw Err(5040, std::format("Failed to accept RDMA connection: {}", errno));
+    }
+
+    // Only a single node connects to each port
+    rdma_destroy_ep(_listenId);
+    _listenId = nullptr;
+    return true;
+}
+
+bool RdmaConnection::connect() {
+    ZoneScoped;
+
+    const std::string port = std::to_string(_port);
+    rdma_addrinfo hints = {};
+    hints.ai_port_space = RDMA_PS_TCP;
+    rdma_addrinfo* res = nullptr;
+    if (rdma_getaddrinfo(_address.c_str(), port.c_str(), &hints, &res) != 0) {
+        throw Err(
+            5040,
+            std::format("Failed to get RDMA address info for {}: {}", _address, errno)
+        );
+    }
+
+    ibv_qp_init_attr attr = queueAttributes();
+    const int result = rdma_create_ep(&_id, res, nullptr, &attr);
+    rdma_freeaddrinfo(res);
+    if (result != 0) {
+        throw Err(
+            5040,
+            std::format("Failed to create RDMA endpoint for {}: {}", _address, errno)
+        );
+    }
+
+    registerRegions();
+    for (int i = 0; i < NumberOfReceives; i++) {
+        postReceive();
+    }
+
+    const RemoteRegion local = {
+        .address = reinterpret_cast<uint64_t>(_receiveBuffer.data()),
+        .key = _receiveRegion->rkey,
+        .size = static_cast<uint32_t>(_bufferSize)
+    };
+    rdma_conn_param param = {};
+    param.private_data = &local;
+    param.private_data_len = sizeof(RemoteRegion);
+    param.retry_count = 7;
+    if (rdma_connect(_id, &param) != 0) {
+        // The server is most likely not listening yet
+        return false;
+    }
+
+    const rdma_conn_param& reply = _id->event->param.conn;
+    if (reply.private_data_len < sizeof(RemoteRegion)) {
+        throw Err(5040, "Received RDMA connection reply without remote region");
+    }
+    RemoteRegion remote;
+    std::memcpy(&remote, reply.private_data, sizeof(RemoteRegion));
+    _remoteAddress = remote.address;
+    _remoteKey = remote.key;
+    _remoteSize = remote.size;
+    return true;
+}
+
+void RdmaConnection::registerRegions() {
+    _sendRegion = rdma_reg_msgs(_id, _sendBuffer, _bufferSize);
+    _receiveRegion = rdma_reg_write(_id, _receiveBuffer.data(), _receiveBuffer.size());
+    if (!_sendRegion || !_receiveRegion) {
+        throw Err(5040, std::format("Failed to register RDMA memory: {}", errno));
+    }
+}
+
+void RdmaConnection::receive() {
+    _isConnected = true;
+
+    while (!_shouldTerminate) {
+        ibv_wc wc = {};
+        if (rdma_get_recv_comp(_id, &wc) <= 0 || wc.status != IBV_WC_SUCCESS) {
+            // Either the other side disconnected or we are shutting down
+            break;
+        }
+        const int packageId = static_cast<int>(ntohl(wc.imm_data));
+        postReceive();
+
+        if (wc.opcode == IBV_WC_RECV_RDMA_WITH_IMM) {
+            ZoneScopedN("Decode RDMA block");
+            const size_t offset = static_cast<size_t>(_nextReceiveSlot) * _bufferSize;
+            char* data = _receiveBuffer.data() + offset;
+            _nextReceiveSlot = (_nextReceiveSlot + 1) % NumberOfSlots;
+            if (_decode) {
+                _decode(data, static_cast<int>(wc.byte_len), packageId);
+            }
+            // The slot can be overwritten as soon as the data has been used
+            sendCredit(packageId);
+        }
+        else {
+            {
+                const std::unique_lock lock(_creditMutex);
+                _credits++;
+            }
+            _creditCond.notify_all();
+            if (_acknowledge) {
+                _acknowledge(packageId);
+            }
+        }
+    }
+
+    _isConnected = false;
+    _creditCond.notify_all();
+}
+
+void RdmaConnection::postReceive() {
+    // The data is written into the receive region directly, so the receive itself only
+    // carries the immediate data and does not need any buffer
+    ibv_recv_wr wr = {};
+    ibv_recv_wr* bad = nullptr;
+    if (ibv_post_recv(_id->qp, &wr, &bad) != 0) {
+        throw Err(5040, std::format("Failed to post RDMA receive: {}", errno));
+    }
+}
+
+void RdmaConnection::sendCredit(int packageId) {
+    const std::unique_lock lock(_sendMutex);
+
+    ibv_send_wr wr = {};
+    wr.opcode = IBV_WR_SEND_WITH_IMM;
+    wr.imm_data = htonl(static_cast<uint32_t>(packageId));
+    postAndWait(_id, wr);
+}
+
+void RdmaConnection::cleanup() {
+    const std::unique_lock lock(_sendMutex);
+
+    _isConnected = false;
+    if (_sendRegion) {
+        rdma_dereg_mr(_sendRegion);
+        _sendRegion = nullptr;
+    }
+    if (_receiveRegion) {
+        rdma_dereg_mr(_receiveRegion);
+        _receiveRegion = nullptr;
+    }
+    if (_id) {
+        rdma_disconnect(_id);
+        rdma_destroy_ep(_id);
+        _id = nullptr;
+    }
+    if (_listenId) {
+        rdma_destroy_ep(_listenId);
+        _listenId = nullptr;
+    }
+
+    _nextSendSlot = 0;
+    _nextReceiveSlot = 0;
+    {
+        const std::unique_lock creditLock(_creditMutex);
+        _credits = NumberOfSlots;
+    }
+}
+
+} // namespace sgct
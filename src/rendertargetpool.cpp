@@ -0,0 +1,146 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/rendertargetpool.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <cassert>
+#include <map>
+
+namespace {
+    struct Entry {
+        unsigned int texture = 0;
+        int nUsers = 0;
+        sgct::MemoryAccount memory;
+    };
+
+    std::map<sgct::RenderTargetPool::Description, Entry>& entries() {
+        static std::map<sgct::RenderTargetPool::Description, Entry> Entries;
+        return Entries;
+    }
+
+    size_t bytes(const sgct::RenderTargetPool::Description& desc) {
+        return static_cast<size_t>(desc.size.x) * desc.size.y *
+            sgct::MemoryTracker::bytesPerTexel(desc.internalFormat);
+    }
+
+    double toMiB(uint64_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+} // namespace
+
+namespace sgct {
+
+RenderTargetPool::Target::Target(Target&& rhs) noexcept
+    : _description(std::move(rhs._description))
+    , _texture(rhs._texture)
+{
+    rhs._description = std::nullopt;
+    rhs._texture = 0;
+}
+
+RenderTargetPool::Target& RenderTargetPool::Target::operator=(Target&& rhs) noexcept {
+    if (this != &rhs) {
+        release();
+        _description = std::move(rhs._description);
+        _texture = rhs._texture;
+        rhs._description = std::nullopt;
+        rhs._texture = 0;
+    }
+    return *this;
+}
+
+RenderTargetPool::Target::~Target() {
+    release();
+}
+
+unsigned int RenderTargetPool::Target::texture() const {
+    return _texture;
+}
+
+void RenderTargetPool::Target::release() {
+    if (!_description) {
+        return;
+    }
+
+    auto it = entries().find(*_description);
+    assert(it != entries().end());
+    it->second.nUsers--;
+    if (it->second.nUsers == 0) {
+        glDeleteTextures(1, &it->second.texture);
+        entries().erase(it);
+    }
+    _description = std::nullopt;
+    _texture = 0;
+}
+
+RenderTargetPool::Target RenderTargetPool::acquire(const Description& description,
+                                                   MemoryTracker::Category category)
+{
+    auto it = entries().find(description);
+    if (it == entries().end()) {
+        Entry entry = { .memory = MemoryAccount(category) };
+        glGenTextures(1, &entry.texture);
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            description.internalFormat,
+            description.size.x,
+            description.size.y,
+            0,
+            description.format,
+            description.type,
+            nullptr
+        );
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        entry.memory.set(bytes(description));
+
+        Log::Debug(std::format(
+            "{}x{} pooled render target (id: {}) generated",
+            description.size.x, description.size.y, entry.texture
+        ));
+        it = entries().emplace(description, std::move(entry)).first;
+    }
+
+    it->second.nUsers++;
+    Target res;
+    res._description = description;
+    res._texture = it->second.texture;
+    return res;
+}
+
+std::string RenderTargetPool::report() {
+    std::string res = "Render target pool:";
+    uint64_t total = 0;
+    uint64_t saved = 0;
+    for (const auto& [description, entry] : entries()) {
+        const size_t b = bytes(description);
+        res += std::format(
+            "\n  {}x{} format {:#x}: {} users, {:.2f} MiB",
+            description.size.x, description.size.y, description.internalFormat,
+            entry.nUsers, toMiB(b)
+        );
+        total += b;
+        saved += (entry.nUsers - 1) * b;
+    }
+    res += std::format(
+        "\n  Total: {:.2f} MiB estimated video memory, {:.2f} MiB saved by sharing",
+        toMiB(total), toMiB(saved)
+    );
+    return res;
+}
+
+} // namespace sgct
@@ -8,90 +8,373 @@
 
 #include <sgct/screencapture.h>
 
+#include <sgct/bufferpolicy.h>
+#include <sgct/capturecollector.h>
 #include <sgct/clustermanager.h>
 #include <sgct/engine.h>
+#include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/image.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/threadpolicy.h>
 #include <sgct/window.h>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
 #include <cstring>
 #include <string>
 
+namespace {
+    // The number of frames after which the download of a screenshot is waited for at the
+    // latest. Until then, the download only finishes early if it has already completed
+    constexpr size_t DownloadLatency = 2;
+
+    // The time in nanoseconds that is waited at most for a download
+    constexpr GLuint64 FenceTimeout = 1'000'000'000;
+
+    bool isIntegerFormat(GLenum internalFormat) {
+        return internalFormat == GL_RGBA16I || internalFormat == GL_RGBA32I ||
+               internalFormat == GL_RGBA16UI || internalFormat == GL_RGBA32UI;
+    }
+
+    // Returns the type in which the colors are downloaded. Integer color buffers can
+    // neither be blitted into a normalized renderbuffer nor be filtered, so they are
+    // always downloaded as they are
+    GLenum downloadType(GLenum internalFormat, GLenum colorDataType,
+                        sgct::config::Capture::Format format, bool eightBit)
+    {
+        if (isIntegerFormat(internalFormat)) {
+            return colorDataType;
+        }
+        if (format == sgct::config::Capture::Format::Exr) {
+            return GL_HALF_FLOAT;
+        }
+        return eightBit ? GL_UNSIGNED_BYTE : colorDataType;
+    }
+
+    int downloadBytesPerColor(GLenum downloadType, int bytesPerColor) {
+        switch (downloadType) {
+            case GL_UNSIGNED_BYTE: return 1;
+            case GL_HALF_FLOAT:    return 2;
+            default:               return bytesPerColor;
+        }
+    }
+
+    // The defaults of the streams, which are sent at a lower rate than videos are
+    // recorded with, and the number of frames of a stream that are queued at most. The
+    // frames beyond that are skipped, so the latency of the stream cannot grow
+    constexpr int StreamBitrate = 4000;
+    constexpr int StreamFrameRate = 30;
+    constexpr int StreamQueueDepth = 2;
+
+    // The time in seconds that is waited before connecting to the receiver of a stream
+    // again, after the connection failed or broke
+    constexpr double StreamRetryInterval = 5.0;
+
+    // The bytes per pixel of the depth, normals, and positions in the geometry PBO
+    constexpr size_t DepthSize = sizeof(float);
+    constexpr size_t NormalSize = 3 * sizeof(uint16_t);
+    constexpr size_t PositionSize = 3 * sizeof(float);
+
+    // Returns the format of the renderbuffer into which the frames are blitted before
+    // they are downloaded, or 0 if they are downloaded directly
+    GLenum packFormat(GLenum internalFormat, bool convert, bool scale) {
+        if (convert) {
+            return GL_RGBA8;
+        }
+        return scale ? internalFormat : 0;
+    }
+
+    GLenum readBuffer(sgct::ScreenCapture::CaptureSource capSrc) {
+        using CaptureSource = sgct::ScreenCapture::CaptureSource;
+        switch (capSrc) {
+            case CaptureSource::BackBuffer:      return GL_BACK;
+            case CaptureSource::LeftBackBuffer:  return GL_BACK_LEFT;
+            case CaptureSource::RightBackBuffer: return GL_BACK_RIGHT;
+            default:                 throw std::logic_error("Unhandled case label");
+        }
+    }
+
+    sgct::Image::PngSettings pngSettings(const sgct::Engine::Settings::SS& capture) {
+        using Strategy = sgct::config::Capture::CompressionStrategy;
+        using CompressionStrategy = sgct::Image::CompressionStrategy;
+
+        sgct::Image::PngSettings settings;
+        settings.compressionLevel = capture.compressionLevel;
+        settings.strategy = [](Strategy strategy) {
+            switch (strategy) {
+                case Strategy::Default:     return CompressionStrategy::Default;
+                case Strategy::Filtered:    return CompressionStrategy::Filtered;
+                case Strategy::HuffmanOnly: return CompressionStrategy::HuffmanOnly;
+                case Strategy::Rle:         return CompressionStrategy::Rle;
+                default:            throw std::logic_error("Unhandled case label");
+            }
+        }(capture.compressionStrategy);
+        return settings;
+    }
+
+    sgct::ExrWriter::Settings exrSettings(const sgct::Engine::Settings::SS& capture) {
+        sgct::ExrWriter::Settings settings;
+        settings.compressionLevel = capture.compressionLevel;
+        return settings;
+    }
+} // namespace
+
 namespace sgct {
 
+ScreenCapture::FrameQueue::FrameQueue(size_t capacity)
+    : _mask(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1)
+{
+    _slots = std::make_unique<Slot[]>(_mask + 1);
+    for (size_t i = 0; i <= _mask; i++) {
+        _slots[i].sequence = i;
+    }
+}
+
+bool ScreenCapture::FrameQueue::push(size_t frame) {
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = _slots[pos & _mask];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+            // The slot was read in the previous round, so we can claim it
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.frame = frame;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (seq < pos) {
+            // The slot still holds the frame from the previous round
+            return false;
+        }
+        else {
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ScreenCapture::FrameQueue::pop(size_t& frame) {
+    size_t pos = _head.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = _slots[pos & _mask];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq == pos + 1) {
+            // The slot was written in this round, so we can claim it
+            if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                frame = slot.frame;
+                slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (seq < pos + 1) {
+            // Nothing has been written to this slot yet
+            return false;
+        }
+        else {
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
 ScreenCapture::ScreenCapture(const Window& window, ScreenCapture::EyeIndex ei,
-                             int bytesPerColor, unsigned int colorDataType, bool addAlpha)
+                             unsigned int internalFormat, int bytesPerColor,
+                             unsigned int colorDataType, bool addAlpha,
+                             const config::Window::Stream* stream)
     : _nThreads(Engine::instance().settings().capture.nCaptureThreads)
-    , _downloadType(colorDataType)
-    , _bytesPerColor(bytesPerColor)
+    // A stream always uses the 8 bit colors that the video encoders accept
+    , _downloadType(downloadType(
+        internalFormat,
+        colorDataType,
+        stream ? config::Capture::Format::Video :
+            Engine::instance().settings().capture.format,
+        stream || Engine::instance().settings().capture.eightBit
+    ))
+    , _bytesPerColor(downloadBytesPerColor(_downloadType, bytesPerColor))
+    , _scale(
+        isIntegerFormat(internalFormat) ?
+        1.f :
+        (stream ?
+            stream->scale.value_or(1.f) :
+            Engine::instance().settings().capture.scale)
+    )
+    // The conversion into half floats happens during the download, so only the 8 bit
+    // colors need the blit
+    , _packFormat(
+        packFormat(
+            internalFormat,
+            _downloadType == GL_UNSIGNED_BYTE && _bytesPerColor != bytesPerColor,
+            _scale < 1.f
+        )
+    )
     , _addAlpha(addAlpha)
+    , _dropWhenFull(stream || Engine::instance().settings().capture.dropWhenFull)
+    , _pngSettings(pngSettings(Engine::instance().settings().capture))
+    , _exrSettings(exrSettings(Engine::instance().settings().capture))
+    , _format(
+        stream ?
+        config::Capture::Format::Video :
+        Engine::instance().settings().capture.format
+    )
+    , _codec(
+        stream ?
+        stream->codec.value_or(config::Capture::Codec::H264) :
+        Engine::instance().settings().capture.codec
+    )
+    , _bitrate(
+        stream ?
+        stream->bitrate.value_or(StreamBitrate) :
+        Engine::instance().settings().capture.bitrate
+    )
+    , _frameRate(
+        stream ?
+        stream->frameRate.value_or(StreamFrameRate) :
+        Engine::instance().settings().capture.frameRate
+    )
+    , _streamUrl(stream ? stream->url : "")
     , _eyeIndex(ei)
     , _window(window)
+    , _frames(
+        stream ?
+        StreamQueueDepth :
+        Engine::instance().settings().capture.queueDepth.value_or(
+            static_cast<int>(_nThreads)
+        )
+    )
+    , _freeFrames(_frames.size())
+    , _queuedFrames(_frames.size())
 {
-    _captureInfos.resize(_nThreads);
-    for (unsigned int i = 0; i < _nThreads; i++) {
-        _captureInfos[i].frameBufferImage = nullptr;
-        _captureInfos[i].captureThread = nullptr;
-        _captureInfos[i].mutex = &_mutex;
-        _captureInfos[i].isRunning = false;
-    }
-    Log::Debug(std::format("Number of screencapture threads is set to {}", _nThreads));
+    for (size_t i = 0; i < _frames.size(); i++) {
+        _freeFrames.push(i);
+    }
+    _nFreeFrames.release(static_cast<std::ptrdiff_t>(_frames.size()));
+
+    Log::Debug(std::format(
+        "Number of screencapture threads is set to {} with a queue depth of {}",
+        _nThreads, _frames.size()
+    ));
+
+    const Engine::Settings::SS& capture = Engine::instance().settings().capture;
+    if (isIntegerFormat(internalFormat) && (capture.eightBit || capture.scale < 1.f)) {
+        Log::Warning(
+            "Screenshots of windows with integer color buffers are neither converted "
+            "to 8 bits nor scaled"
+        );
+    }
+    if (isIntegerFormat(internalFormat) && stream) {
+        Log::Error(std::format(
+            "Window {} cannot be streamed as it has an integer color buffer", window.id()
+        ));
+    }
+    if (isIntegerFormat(internalFormat) && _format == config::Capture::Format::Exr) {
+        Log::Error(
+            "EXR files can only store the colors of floating point or normalized color "
+            "buffers. Saving PNG files instead"
+        );
+        _format = config::Capture::Format::Png;
+    }
 }
 
 ScreenCapture::~ScreenCapture() {
-    for (ScreenCaptureThreadInfo& info : _captureInfos) {
-        // kill threads that are still running
-        if (info.captureThread) {
-            info.captureThread->join();
-            info.captureThread = nullptr;
-        }
+    while (!_downloads.empty()) {
+        finishDownload();
+    }
 
-        const std::unique_lock lock(_mutex);
-        info.frameBufferImage = nullptr;
-        info.isRunning = false;
+    // A worker that is woken up without a queued frame stops, which only happens after
+    // all frames that were queued before have been saved
+    _nQueuedFrames.release(static_cast<std::ptrdiff_t>(_workers.size()));
+    for (std::thread& worker : _workers) {
+        worker.join();
     }
 
-    glDeleteBuffers(1, &_pbo);
+    for (Frame& frame : _frames) {
+        glDeleteBuffers(1, &frame.pbo);
+        glDeleteBuffers(1, &frame.geometryPbo);
+    }
+    glDeleteFramebuffers(1, &_sourceFbo);
+    glDeleteFramebuffers(1, &_packFbo);
+    glDeleteRenderbuffers(1, &_packBuffer);
 }
 
 void ScreenCapture::resize(ivec2 resolution) {
-    glDeleteBuffers(1, &_pbo);
+    // Wait until all frames are returned by the workers, which then hold images and
+    // PBOs of the previous size that are recreated when they are used next. The pending
+    // downloads have to finish before the size changes
+    flush();
 
-    _resolution = std::move(resolution);
+    _sourceResolution = std::move(resolution);
+    auto scaled = [this](int v) {
+        return v == 0 ? 0 : std::max(static_cast<int>(std::lround(v * _scale)), 1);
+    };
+    _resolution = ivec2{ scaled(_sourceResolution.x), scaled(_sourceResolution.y) };
 
     const int nChannels = _addAlpha ? 4 : 3;
     _dataSize = _resolution.x * _resolution.y * nChannels * _bytesPerColor;
 
-    const std::unique_lock lock(_mutex);
-    for (ScreenCaptureThreadInfo& info : _captureInfos) {
-        if (info.frameBufferImage) {
-            // kill threads that are still running
-            if (info.captureThread) {
-                info.captureThread->join();
-                info.captureThread = nullptr;
-            }
-            info.frameBufferImage = nullptr;
+    if (_packFormat != 0 && _dataSize > 0) {
+        if (_packFbo == 0) {
+            glGenFramebuffers(1, &_sourceFbo);
+            glGenFramebuffers(1, &_packFbo);
+            glGenRenderbuffers(1, &_packBuffer);
         }
-        info.isRunning = false;
+        glBindRenderbuffer(GL_RENDERBUFFER, _packBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, _packFormat, _resolution.x, _resolution.y);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        GLint prevFbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _packFbo);
+        glFramebufferRenderbuffer(
+            GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_RENDERBUFFER,
+            _packBuffer
+        );
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFbo);
     }
 
-    glGenBuffers(1, &_pbo);
-    Log::Debug(std::format(
-        "Generating {}x{}x{} PBO: {}", _resolution.x, _resolution.y, nChannels, _pbo
-    ));
+    for (Frame& frame : _frames) {
+        // Deleting a buffer also unmaps it
+        glDeleteBuffers(1, &frame.pbo);
+        frame.pbo = 0;
+        glDeleteBuffers(1, &frame.geometryPbo);
+        frame.geometryPbo = 0;
+        frame.geometry.clear();
+        frame.mapping = nullptr;
+        frame.image = nullptr;
+        frame.staging = nullptr;
+    }
 
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
-    glBufferData(GL_PIXEL_PACK_BUFFER, _dataSize, nullptr, GL_STATIC_READ);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // A raw capture file or video only holds frames of one size, so the following frames
+    // are written into a new file
+    if (_rawFile || _videoFile) {
+        _rawFile = nullptr;
+        _videoFile = nullptr;
+        _nContainerFiles++;
+    }
 }
 
-void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capSrc) {
+void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capSrc,
+                                      GeometryTextures geometry)
+{
     ZoneScoped;
 
     uint64_t number = Engine::instance().screenShotNumber();
-    if (Engine::instance().settings().capture.limits) {
+    if (!_streamUrl.empty()) {
+        // The frame is sent if it is not more than a tenth of a frame early, so that the
+        // jitter of the render loop does not skip frames that are on time
+        const double interval = 1.0 / _frameRate;
+        const double now = time();
+        if (now < _nextStreamFrame - 0.1 * interval) {
+            return;
+        }
+        _nextStreamFrame = std::max(_nextStreamFrame + interval, now);
+        number = _nStreamFrames++;
+    }
+    else if (Engine::instance().settings().capture.limits) {
         uint64_t begin = Engine::instance().settings().capture.limits->first;
         uint64_t end = Engine::instance().settings().capture.limits->second;
 
@@ -103,27 +386,82 @@ void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capS
         }
     }
 
-    std::string file = createFilename(number);
-
     const ivec2 res =
         capSrc == CaptureSource::Texture ?
         _window.framebufferResolution() :
         _window.windowResolution();
-    if (_resolution.x != res.x && _resolution.y != res.y) {
+    if (_sourceResolution.x != res.x && _sourceResolution.y != res.y) {
         resize(res);
     }
 
-    const int threadIndex = availableCaptureThread();
-    if (threadIndex == -1) {
-        Log::Error("Error finding available capture thread");
+    if (!openContainerFile()) {
+        return;
+    }
+
+    if (_workers.empty()) {
+        startWorkers();
+    }
+
+    std::string file;
+    if (_format == config::Capture::Format::Png) {
+        file = createFilename(number, "png");
+    }
+    else if (_format == config::Capture::Format::Exr) {
+        file = createFilename(number, "exr");
+    }
+
+    if (!_nFreeFrames.try_acquire()) {
+        if (_dropWhenFull) {
+            _nDroppedFrames++;
+            // A stream skips frames whenever the encoder cannot keep up, which is not
+            // worth a warning
+            if (!_streamUrl.empty()) {
+                return;
+            }
+            Log::Warning(std::format(
+                "Skipping screenshot {} as {} screenshots are waiting to be saved",
+                number, _queueDepth.load()
+            ));
+            return;
+        }
+
+        ZoneScopedN("Wait for free frame");
+        // The frames that are still being downloaded only become free after they have
+        // been saved, so the oldest of them has to be handed to the capture threads
+        if (!_downloads.empty()) {
+            finishDownload();
+        }
+        _nFreeFrames.acquire();
+    }
+    size_t index = 0;
+    [[maybe_unused]] const bool hasFrame = _freeFrames.pop(index);
+    assert(hasFrame);
+
+    Frame* frame = prepareFrame(index, number, std::move(file));
+    if (!frame) {
+        _freeFrames.push(index);
+        _nFreeFrames.release();
         return;
     }
 
-    Image* imPtr = prepareImage(threadIndex, std::move(file));
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
 
-    if (capSrc == CaptureSource::Texture) {
+    GLint prevReadFbo = 0;
+    GLint prevDrawFbo = 0;
+    if (_packFormat != 0) {
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFbo);
+        packFrame(textureId, capSrc);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, frame->pbo);
+    if (_packFormat != 0) {
+        // The converted frame is read from the renderbuffer that packFrame has bound
+        const GLsizei w = static_cast<GLsizei>(_resolution.x);
+        const GLsizei h = static_cast<GLsizei>(_resolution.y);
+        glReadPixels(0, 0, w, h, _addAlpha ? GL_BGRA : GL_BGR, _downloadType, nullptr);
+    }
+    else if (capSrc == CaptureSource::Texture) {
         glBindTexture(GL_TEXTURE_2D, textureId);
         glGetTexImage(
             GL_TEXTURE_2D,
@@ -135,58 +473,139 @@ void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capS
     }
     else {
         // set the target framebuffer to read
-        switch (capSrc) {
-            case CaptureSource::BackBuffer:
-                glReadBuffer(GL_BACK);
-                break;
-            case CaptureSource::LeftBackBuffer:
-                glReadBuffer(GL_BACK_LEFT);
-                break;
-            case CaptureSource::RightBackBuffer:
-                glReadBuffer(GL_BACK_RIGHT);
-                break;
-            default:
-                throw std::logic_error("Unhandled case label");
-        }
-        const ivec2& s = imPtr->size();
-        const GLsizei w = static_cast<GLsizei>(s.x);
-        const GLsizei h = static_cast<GLsizei>(s.y);
+        glReadBuffer(readBuffer(capSrc));
+        const GLsizei w = static_cast<GLsizei>(_resolution.x);
+        const GLsizei h = static_cast<GLsizei>(_resolution.y);
         glReadPixels(0, 0, w, h, _addAlpha ? GL_BGRA : GL_BGR, _downloadType, nullptr);
     }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // The geometry buffer has the resolution of the window, so it can only be stored
+    // with screenshots that are not scaled down
+    const bool hasGeometry = _format == config::Capture::Format::Exr &&
+        capSrc == CaptureSource::Texture && _resolution == _sourceResolution &&
+        (geometry.depth != 0 || geometry.normals != 0 || geometry.positions != 0);
+    downloadGeometry(*frame, hasGeometry ? geometry : GeometryTextures{ 0, 0, 0 });
+
+    if (_packFormat != 0) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFbo);
+    }
 
-    unsigned char* memoryPtr = reinterpret_cast<unsigned char*>(
-        glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)
+    // The download is only waited for a few frames later, by which time it has usually
+    // completed without stalling the render thread
+    frame->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _queueDepth++;
+    _downloads.push_back(index);
+    while (_downloads.size() > DownloadLatency) {
+        finishDownload();
+    }
+}
+
+void ScreenCapture::saveTiledScreenCapture(unsigned int textureId, ivec2 tiles,
+                                           const std::function<void(ivec2)>& renderTile)
+{
+    ZoneScoped;
+
+    const uint64_t number = Engine::instance().screenShotNumber();
+    const ivec2 res = _window.framebufferResolution();
+    const ivec2 size = ivec2{ res.x * tiles.x, res.y * tiles.y };
+    const int nChannels = _addAlpha ? 4 : 3;
+    // The tiles are downloaded at the next bit depth that a PNG file can store
+    const int bytesPerColor = _bytesPerColor == 1 ? 1 : 2;
+    const GLenum type = bytesPerColor == 1 ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT;
+    const std::string file = std::format(
+        "{}tiled_{:06}.png", filePrefix().string(), number
     );
-    if (memoryPtr) {
-        std::memcpy(imPtr->data(), memoryPtr, _dataSize);
-
-        // save the image
-        _captureInfos[threadIndex].isRunning = true;
-        _captureInfos[threadIndex].captureThread = std::make_unique<std::thread>(
-            [](void* arg) {
-                ScreenCaptureThreadInfo* ptr =
-                    reinterpret_cast<ScreenCaptureThreadInfo*>(arg);
-
-                try {
-                    ptr->frameBufferImage->save(ptr->filename);
-                }
-                catch (const std::runtime_error& e) {
-                    Log::Error(e.what());
-                }
-                ptr->isRunning = false;
-            },
-            &_captureInfos[threadIndex]
+
+    std::unique_ptr<PngStripeWriter> writer;
+    try {
+        writer = std::make_unique<PngStripeWriter>(
+            file,
+            size,
+            nChannels,
+            bytesPerColor,
+            _pngSettings.compressionLevel
         );
-        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
     }
-    else {
-        Log::Error("Can't map data (0) from GPU in frame capture");
+    catch (const Error& e) {
+        Log::Error(e.message);
+        return;
     }
 
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // Only one row of tiles is held in memory, which is written into the file before the
+    // tiles below it are rendered
+    const size_t pixelSize = static_cast<size_t>(nChannels) * bytesPerColor;
+    const size_t tileRowSize = static_cast<size_t>(res.x) * pixelSize;
+    const size_t stripeRowSize = static_cast<size_t>(size.x) * pixelSize;
+    std::vector<unsigned char> tile(tileRowSize * res.y);
+    std::vector<unsigned char> stripe(stripeRowSize * res.y);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    for (int y = tiles.y - 1; y >= 0; y--) {
+        for (int x = 0; x < tiles.x; x++) {
+            renderTile(ivec2{ x, y });
+
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            glGetTexImage(
+                GL_TEXTURE_2D,
+                0,
+                _addAlpha ? GL_BGRA : GL_BGR,
+                type,
+                tile.data()
+            );
+            for (int row = 0; row < res.y; row++) {
+                std::memcpy(
+                    stripe.data() + row * stripeRowSize + x * tileRowSize,
+                    tile.data() + row * tileRowSize,
+                    tileRowSize
+                );
+            }
+        }
+
+        try {
+            writer->write(stripe.data(), res.y);
+        }
+        catch (const Error& e) {
+            Log::Error(e.message);
+            return;
+        }
+    }
+    Log::Info(std::format(
+        "Saved tiled screenshot '{}' with {}x{} pixels", file, size.x, size.y
+    ));
+}
+
+void ScreenCapture::update() {
+    while (!_downloads.empty()) {
+        const GLenum res = glClientWaitSync(_frames[_downloads.front()].fence, 0, 0);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        finishDownload();
+    }
+}
+
+void ScreenCapture::flush() {
+    ZoneScoped;
+
+    while (!_downloads.empty()) {
+        finishDownload();
+    }
+    for (size_t i = 0; i < _frames.size(); i++) {
+        _nFreeFrames.acquire();
+    }
+    _nFreeFrames.release(static_cast<std::ptrdiff_t>(_frames.size()));
 }
 
-std::string ScreenCapture::createFilename(uint64_t frameNumber) {
+int ScreenCapture::queueDepth() const {
+    return _queueDepth;
+}
+
+uint64_t ScreenCapture::nDroppedFrames() const {
+    return _nDroppedFrames;
+}
+
+std::filesystem::path ScreenCapture::filePrefix() const {
     const std::string eyeSuffix = [](EyeIndex eyeIndex) {
         switch (eyeIndex) {
             case EyeIndex::Mono:        return "";
@@ -196,10 +615,6 @@ std::string ScreenCapture::createFilename(uint64_t frameNumber) {
         }
     }(_eyeIndex);
 
-    std::array<char, 6> Buffer = {};
-    std::fill(Buffer.begin(), Buffer.end(), '\0');
-    std::format_to_n(Buffer.data(), Buffer.size(), "{:06}", frameNumber);
-
     std::filesystem::path file;
     if (!Engine::instance().settings().capture.capturePath.empty()) {
         file = Engine::instance().settings().capture.capturePath / "";
@@ -222,50 +637,473 @@ std::string ScreenCapture::createFilename(uint64_t frameNumber) {
     if (!eyeSuffix.empty()) {
         file += eyeSuffix + '_';
     }
+    return file;
+}
+
+std::string ScreenCapture::createFilename(uint64_t frameNumber,
+                                          std::string_view extension)
+{
+    std::array<char, 6> Buffer = {};
+    std::fill(Buffer.begin(), Buffer.end(), '\0');
+    std::format_to_n(Buffer.data(), Buffer.size(), "{:06}", frameNumber);
+
     std::string bufferString = std::string(Buffer.begin(), Buffer.end());
     // @TODO: Remove `.string()` as soon as Clang on MacOS supports
     // formatting std::filesystem::path
-    return std::format("{}{}.png", file.string(), bufferString);
+    return std::format("{}{}.{}", filePrefix().string(), bufferString, extension);
 }
 
-int ScreenCapture::availableCaptureThread() {
-    while (true) {
-        for (unsigned int i = 0; i < _captureInfos.size(); i++) {
-            // check if thread is dead
-            if (_captureInfos[i].captureThread == nullptr) {
-                return i;
+std::string ScreenCapture::createContainerFilename(std::string_view extension) {
+    // Every resolution change starts a new file, and all but the first one are numbered
+    const std::string suffix =
+        _nContainerFiles == 0 ? "capture" : std::format("capture_{}", _nContainerFiles);
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    return std::format("{}{}.{}", filePrefix().string(), suffix, extension);
+}
+
+bool ScreenCapture::openContainerFile() {
+    if (!_streamUrl.empty()) {
+        // Connecting to the receiver can take a while, so the stream is opened by the
+        // capture thread
+        return _bytesPerColor == 1;
+    }
+
+    const int nChannels = _addAlpha ? 4 : 3;
+    if (_format == config::Capture::Format::Raw && !_rawFile) {
+        try {
+            _rawFile = std::make_unique<RawCaptureFile>(
+                createContainerFilename("raw"),
+                _resolution,
+                nChannels,
+                _bytesPerColor
+            );
+        }
+        catch (const Error& e) {
+            Log::Error(e.message);
+            return false;
+        }
+    }
+    else if (_format == config::Capture::Format::Video && !_videoFile) {
+        // A missing encoder should not lose the screenshots, so they are saved as PNG
+        // files instead
+        if (_bytesPerColor != 1) {
+            Log::Error(
+                "Videos can only be captured with 8 bit colors, which requires the "
+                "'eightbit' capture setting for this window. Saving PNG files instead"
+            );
+            _format = config::Capture::Format::Png;
+            return true;
+        }
+        try {
+            _videoFile = std::make_unique<VideoEncoder>(
+                createContainerFilename("mp4"),
+                _resolution,
+                nChannels,
+                _codec == config::Capture::Codec::H264 ?
+                    VideoEncoder::Codec::H264 :
+                    VideoEncoder::Codec::HEVC,
+                _bitrate,
+                _frameRate
+            );
+        }
+        catch (const Error& e) {
+            Log::Error(std::format("{}. Saving PNG files instead", e.message));
+            _format = config::Capture::Format::Png;
+        }
+    }
+    return true;
+}
+
+ScreenCapture::Frame* ScreenCapture::prepareFrame(size_t index, uint64_t number,
+                                                 std::string file)
+{
+    Log::Debug(std::format("Queuing screenshot {} [{}]", number, index));
+
+    Frame& frame = _frames[index];
+    if (frame.image == nullptr) {
+        const int nChannels = _addAlpha ? 4 : 3;
+        frame.image = std::make_unique<Image>();
+        frame.image->setBytesPerChannel(_bytesPerColor);
+        frame.image->setChannels(nChannels);
+        frame.image->setSize(_resolution);
+        if (_dataSize == 0) {
+            frame.image = nullptr;
+            return nullptr;
+        }
+
+        glGenBuffers(1, &frame.pbo);
+        Log::Debug(std::format(
+            "Generating {}x{}x{} PBO: {}",
+            _resolution.x, _resolution.y, nChannels, frame.pbo
+        ));
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.pbo);
+        if (GLAD_GL_VERSION_4_4) {
+            constexpr GLbitfield Flags =
+                GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_PIXEL_PACK_BUFFER, _dataSize, nullptr, Flags);
+            frame.mapping = reinterpret_cast<unsigned char*>(
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, _dataSize, Flags)
+            );
+        }
+        if (frame.mapping) {
+            // The image only borrows the mapping, which is unmapped when the PBO is
+            // deleted, so the pixels are never copied out of the buffer
+            frame.image->setData(frame.mapping);
+        }
+        else {
+            if (GLAD_GL_VERSION_4_4) {
+                // The storage of a buffer is immutable, so it has to be recreated
+                glDeleteBuffers(1, &frame.pbo);
+                glGenBuffers(1, &frame.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.pbo);
             }
+            glBufferData(GL_PIXEL_PACK_BUFFER, _dataSize, nullptr, GL_STREAM_READ);
+            // The pixels are copied out of the PBO into the image and read by the
+            // workers that encode them, every frame while the capture is running
+            frame.image->setAllocator(Image::Allocator{
+                .allocate = [](size_t size) -> unsigned char* {
+                    try {
+                        return static_cast<unsigned char*>(
+                            BufferPolicy::allocate(BufferPolicy::Subsystem::Capture, size)
+                        );
+                    }
+                    catch (const std::bad_alloc&) {
+                        return nullptr;
+                    }
+                },
+                .deallocate = [](unsigned char* data, size_t size) {
+                    BufferPolicy::deallocate(data, size);
+                }
+            });
+            frame.image->allocateOrResizeData();
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    frame.number = number;
+    frame.filename = std::move(file);
+
+    return &frame;
+}
+
+void ScreenCapture::packFrame(unsigned int textureId, CaptureSource capSrc) {
+    ZoneScoped;
+
+    if (capSrc == CaptureSource::Texture) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _sourceFbo);
+        glFramebufferTexture2D(
+            GL_READ_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            textureId,
+            0
+        );
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+    }
+    else {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glReadBuffer(readBuffer(capSrc));
+    }
+
+    // The blit converts the colors into the format of the renderbuffer and averages the
+    // pixels if the frame is scaled down, so only the final pixels are downloaded
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _packFbo);
+    glBlitFramebuffer(
+        0,
+        0,
+        _sourceResolution.x,
+        _sourceResolution.y,
+        0,
+        0,
+        _resolution.x,
+        _resolution.y,
+        GL_COLOR_BUFFER_BIT,
+        GL_LINEAR
+    );
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _packFbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+}
+
+void ScreenCapture::downloadGeometry(Frame& frame, GeometryTextures geometry) {
+    frame.geometryTextures = geometry;
+    frame.geometrySize = 0;
+    if (geometry.depth == 0 && geometry.normals == 0 && geometry.positions == 0) {
+        return;
+    }
+
+    const size_t nPixels = static_cast<size_t>(_resolution.x) * _resolution.y;
+    if (frame.geometryPbo == 0) {
+        // The buffer is large enough for all textures so that it does not have to be
+        // recreated if the window starts to render another one of them
+        glGenBuffers(1, &frame.geometryPbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.geometryPbo);
+        glBufferData(
+            GL_PIXEL_PACK_BUFFER,
+            nPixels * (DepthSize + NormalSize + PositionSize),
+            nullptr,
+            GL_STREAM_READ
+        );
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.geometryPbo);
+    auto download = [&frame, nPixels](unsigned int texture, GLenum format, GLenum type,
+                                      size_t pixelSize)
+    {
+        if (texture == 0) {
+            return;
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glGetTexImage(
+            GL_TEXTURE_2D,
+            0,
+            format,
+            type,
+            reinterpret_cast<void*>(frame.geometrySize)
+        );
+        frame.geometrySize += nPixels * pixelSize;
+    };
+    download(geometry.depth, GL_DEPTH_COMPONENT, GL_FLOAT, DepthSize);
+    download(geometry.normals, GL_RGB, GL_HALF_FLOAT, NormalSize);
+    download(geometry.positions, GL_RGB, GL_FLOAT, PositionSize);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ScreenCapture::finishDownload() {
+    ZoneScoped;
+
+    const size_t index = _downloads.front();
+    _downloads.pop_front();
+
+    Frame& frame = _frames[index];
+    // The download was usually started two frames ago, so this rarely has to wait
+    glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+    glDeleteSync(frame.fence);
+    frame.fence = nullptr;
+
+    if (!frame.mapping) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.pbo);
+        const void* memoryPtr =
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, _dataSize, GL_MAP_READ_BIT);
+        if (!memoryPtr) {
+            Log::Error("Can't map data (0) from GPU in frame capture");
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            _queueDepth--;
+            _freeFrames.push(index);
+            _nFreeFrames.release();
+            return;
+        }
+        std::memcpy(frame.image->data(), memoryPtr, _dataSize);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
 
-            if (!_captureInfos[i].isRunning) {
-                _captureInfos[i].captureThread->join();
-                _captureInfos[i].captureThread = nullptr;
+    if (frame.geometrySize > 0) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.geometryPbo);
+        const void* memoryPtr = glMapBufferRange(
+            GL_PIXEL_PACK_BUFFER,
+            0,
+            frame.geometrySize,
+            GL_MAP_READ_BIT
+        );
+        if (memoryPtr) {
+            frame.geometry.resize(frame.geometrySize);
+            std::memcpy(frame.geometry.data(), memoryPtr, frame.geometrySize);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        else {
+            // The colors are still worth saving without the geometry
+            Log::Error("Can't map the geometry buffer from GPU in frame capture");
+            frame.geometryTextures = GeometryTextures{ 0, 0, 0 };
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    _queuedFrames.push(index);
+    _nQueuedFrames.release();
+}
+
+void ScreenCapture::startWorkers() {
+    // The job system is created after the windows, so it is only looked up once the
+    // first screenshot is taken
+    if (Engine::instance().settings().capture.parallelEncoding) {
+        _pngSettings.jobSystem = &Engine::instance().jobSystem();
+        _exrSettings.jobSystem = &Engine::instance().jobSystem();
+    }
 
-                return i;
+    // The master keeps its own screenshots, so only the clients send theirs
+    if (!Engine::instance().isMaster() && _streamUrl.empty()) {
+        _collector = Engine::instance().captureCollector();
+    }
+    if (_collector && _format != config::Capture::Format::Png) {
+        Log::Warning("Only PNG screenshots can be collected on the master");
+        _collector = nullptr;
+    }
+
+    // The encoder has to receive the frames of a video in order, which only a single
+    // capture thread guarantees
+    const unsigned int nThreads =
+        _format == config::Capture::Format::Video ? 1 : _nThreads;
+    _workers.reserve(nThreads);
+    for (unsigned int i = 0; i < nThreads; i++) {
+        _workers.emplace_back(&ScreenCapture::work, this);
+    }
+}
+
+void ScreenCapture::work() {
+    ThreadPolicy::apply(ThreadPolicy::Class::Capture, "Encode");
+
+    while (true) {
+        _nQueuedFrames.acquire();
+        size_t index = 0;
+        if (!_queuedFrames.pop(index)) {
+            // Only the destructor wakes up a worker without queuing a frame
+            return;
+        }
+
+        Frame& frame = _frames[index];
+        try {
+            // The image wraps the persistently mapped buffer if there is one
+            const unsigned char* data = frame.image->data();
+            if (!_streamUrl.empty()) {
+                stream(data);
+            }
+            else if (_rawFile) {
+                if (!frame.staging) {
+                    frame.staging = _rawFile->createBuffer();
+                }
+                _rawFile->write(frame.number, data, frame.staging.get());
+            }
+            else if (_videoFile) {
+                _videoFile->encode(data);
+            }
+            else if (_format == config::Capture::Format::Exr) {
+                saveExr(frame, data);
+            }
+            else {
+                frame.image->save(frame.filename, data, _pngSettings);
+                if (_collector) {
+                    _collector->send(frame.filename);
+                }
             }
         }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        _queueDepth--;
+        _freeFrames.push(index);
+        _nFreeFrames.release();
     }
 }
 
-Image* ScreenCapture::prepareImage(int index, std::string file) {
-    Log::Debug(std::format("Starting thread for screenshot/capture [{}]", index));
+void ScreenCapture::saveExr(const Frame& frame, const unsigned char* data) const {
+    ZoneScoped;
 
-    if (_captureInfos[index].frameBufferImage == nullptr) {
-        const int nChannels = _addAlpha ? 4 : 3;
-        _captureInfos[index].frameBufferImage = std::make_unique<Image>();
-        _captureInfos[index].frameBufferImage->setBytesPerChannel(_bytesPerColor);
-        _captureInfos[index].frameBufferImage->setChannels(nChannels);
-        _captureInfos[index].frameBufferImage->setSize(_resolution);
-        if (_bytesPerColor * nChannels * _resolution.x * _resolution.y == 0) {
-            _captureInfos[index].frameBufferImage = nullptr;
-            return nullptr;
+    using PixelType = ExrWriter::PixelType;
+
+    // The colors were downloaded as half floats in BGR(A) order
+    std::vector<ExrWriter::Part> parts;
+    ExrWriter::Part color = {
+        .name = "rgba",
+        .channels = {
+            { "B", PixelType::Half, 0 },
+            { "G", PixelType::Half, 2 },
+            { "R", PixelType::Half, 4 }
+        },
+        .data = reinterpret_cast<const std::byte*>(data),
+        .pixelSize = _addAlpha ? 8u : 6u
+    };
+    if (_addAlpha) {
+        color.channels.push_back({ "A", PixelType::Half, 6 });
+    }
+    parts.push_back(std::move(color));
+
+    // The textures of the geometry buffer lie one after the other in the order in which
+    // they were downloaded
+    const size_t nPixels = static_cast<size_t>(_resolution.x) * _resolution.y;
+    const std::byte* geometry = frame.geometry.data();
+    if (frame.geometryTextures.depth != 0) {
+        parts.push_back({
+            .name = "depth",
+            .channels = { { "Z", PixelType::Float, 0 } },
+            .data = geometry,
+            .pixelSize = DepthSize
+        });
+        geometry += nPixels * DepthSize;
+    }
+    if (frame.geometryTextures.normals != 0) {
+        parts.push_back({
+            .name = "normals",
+            .channels = {
+                { "N.X", PixelType::Half, 0 },
+                { "N.Y", PixelType::Half, 2 },
+                { "N.Z", PixelType::Half, 4 }
+            },
+            .data = geometry,
+            .pixelSize = NormalSize
+        });
+        geometry += nPixels * NormalSize;
+    }
+    if (frame.geometryTextures.positions != 0) {
+        parts.push_back({
+            .name = "positions",
+            .channels = {
+                { "P.X", PixelType::Float, 0 },
+                { "P.Y", PixelType::Float, 4 },
+                { "P.Z", PixelType::Float, 8 }
+            },
+            .data = geometry,
+            .pixelSize = PositionSize
+        });
+    }
+
+    ExrWriter::write(frame.filename, _resolution, parts, _exrSettings);
+}
+
+void ScreenCapture::stream(const unsigned char* data) {
+    ZoneScoped;
+
+    // The frames are skipped while the receiver cannot be reached, which is only tried
+    // again after a while as connecting can block the capture thread
+    if (!_videoFile) {
+        if (time() < _nextStreamConnection) {
+            return;
+        }
+        try {
+            _videoFile = std::make_unique<VideoEncoder>(
+                _streamUrl,
+                _resolution,
+                _addAlpha ? 4 : 3,
+                _codec == config::Capture::Codec::H264 ?
+                    VideoEncoder::Codec::H264 :
+                    VideoEncoder::Codec::HEVC,
+                _bitrate,
+                _frameRate,
+                VideoEncoder::Mode::Stream
+            );
+        }
+        catch (const Error& e) {
+            Log::Warning(std::format(
+                "{}. Retrying in {} seconds", e.message, StreamRetryInterval
+            ));
+            _nextStreamConnection = time() + StreamRetryInterval;
+            return;
         }
-        _captureInfos[index].frameBufferImage->allocateOrResizeData();
     }
-    _captureInfos[index].filename = std::move(file);
 
-    return _captureInfos[index].frameBufferImage.get();
+    try {
+        _videoFile->encode(data);
+    }
+    catch (const Error& e) {
+        Log::Warning(std::format(
+            "Stream '{}' was interrupted: {}. Reconnecting in {} seconds",
+            _streamUrl, e.message, StreamRetryInterval
+        ));
+        _videoFile = nullptr;
+        _nextStreamConnection = time() + StreamRetryInterval;
+    }
 }
 
 } // namespace sgct
@@ -8,14 +8,46 @@
 
 #include <sgct/shaderprogram.h>
 
+#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <system_error>
 
 #define Err(code, msg) Error(Error::Component::Shader, code, msg)
 
 namespace {
+    constexpr std::array<char, 4> Magic = { 'S', 'G', 'S', 'P' };
+
+    // The 64-bit FNV-1a hash
+    constexpr uint64_t FnvOffset = 14695981039346656037ull;
+    constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    void hash(uint64_t& h, const void* data, size_t size) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            h = (h ^ bytes[i]) * FnvPrime;
+        }
+    }
+
+    void hashString(uint64_t& h, std::string_view str) {
+        // The length is included so that the boundaries between strings are unambiguous
+        const uint64_t length = str.size();
+        hash(h, &length, sizeof(length));
+        hash(h, str.data(), str.size());
+    }
+
+    void hashGLString(uint64_t& h, GLenum name) {
+        const GLubyte* str = glGetString(name);
+        hashString(h, str ? reinterpret_cast<const char*>(str) : "");
+    }
+
     bool checkLinkStatus(GLint programId, const std::string& name) {
         GLint linkStatus = 0;
         glGetProgramiv(programId, GL_LINK_STATUS, &linkStatus);
@@ -34,12 +66,33 @@ namespace {
         return linkStatus != 0;
     }
 
+    void insertDefines(std::string& source, std::string_view defines) {
+        // Nothing but comments may precede the #version directive, so the macros are
+        // defined on the line after it
+        const size_t version = source.find("#version");
+        if (version == std::string::npos) {
+            source.insert(0, defines);
+            return;
+        }
+        const size_t end = source.find('\n', version);
+        if (end == std::string::npos) {
+            source += '\n';
+            source += defines;
+        }
+        else {
+            source.insert(end + 1, defines);
+        }
+    }
+
     std::string shaderTypeName(GLenum shaderType) {
         switch (shaderType) {
-            case GL_VERTEX_SHADER:   return "Vertex shader";
-            case GL_FRAGMENT_SHADER: return "Fragment shader";
-            case GL_GEOMETRY_SHADER: return "Geometry shader";
-            default:                 throw std::logic_error("Unhandled case label");
+            case GL_VERTEX_SHADER:          return "Vertex shader";
+            case GL_FRAGMENT_SHADER:        return "Fragment shader";
+            case GL_GEOMETRY_SHADER:        return "Geometry shader";
+            case GL_TESS_CONTROL_SHADER:    return "Tessellation control shader";
+            case GL_TESS_EVALUATION_SHADER: return "Tessellation evaluation shader";
+            default:
+                throw std::logic_error("Unhandled case label");
         };
     }
 
@@ -73,7 +126,11 @@ ShaderProgram::ShaderProgram(std::string name) : _name(std::move(name)) {}
 ShaderProgram::ShaderProgram(ShaderProgram&& rhs) noexcept
     : _name(std::move(rhs._name))
     , _programId(rhs._programId)
+    , _sources(std::move(rhs._sources))
     , _shaders(std::move(rhs._shaders))
+    , _feedbackVaryings(std::move(rhs._feedbackVaryings))
+    , _defines(std::move(rhs._defines))
+    , _uniformLocations(std::move(rhs._uniformLocations))
 {
     rhs._programId = 0;
 }
@@ -87,7 +144,11 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& rhs) noexcept {
         _name = std::move(rhs._name);
         _programId = rhs._programId;
         rhs._programId = 0;
+        _sources = std::move(rhs._sources);
         _shaders = std::move(rhs._shaders);
+        _feedbackVaryings = std::move(rhs._feedbackVaryings);
+        _defines = std::move(rhs._defines);
+        _uniformLocations = std::move(rhs._uniformLocations);
     }
     return *this;
 }
@@ -105,34 +166,34 @@ void ShaderProgram::deleteProgram() {
         glDeleteProgram(_programId);
     }
     _programId = 0;
+    _uniformLocations.clear();
 }
 
 void ShaderProgram::addVertexShader(std::string_view src) {
-    // Prepare source code for shader
-    constexpr char Null = '\0';
-
-    const unsigned int id = glCreateShader(GL_VERTEX_SHADER);
-    
-    const char* shaderSrc[] = { src.data(), &Null };
-    glShaderSource(id, 1, shaderSrc, nullptr);
-    glCompileShader(id);
-    checkCompilationStatus(GL_VERTEX_SHADER, id);
-
-    _shaders.push_back(id);
+    _sources.emplace_back(GL_VERTEX_SHADER, std::string(src));
 }
 
 void ShaderProgram::addFragmentShader(std::string_view src) {
-    // Prepare source code for shader
-    constexpr char Null = '\0';
+    _sources.emplace_back(GL_FRAGMENT_SHADER, std::string(src));
+}
+
+void ShaderProgram::addGeometryShader(std::string_view src) {
+    _sources.emplace_back(GL_GEOMETRY_SHADER, std::string(src));
+}
 
-    const unsigned int id = glCreateShader(GL_FRAGMENT_SHADER);
+void ShaderProgram::addTessellationShaders(std::string_view controlSrc,
+                                           std::string_view evaluationSrc)
+{
+    _sources.emplace_back(GL_TESS_CONTROL_SHADER, std::string(controlSrc));
+    _sources.emplace_back(GL_TESS_EVALUATION_SHADER, std::string(evaluationSrc));
+}
 
-    const char* shaderSrc[] = { src.data(), &Null };
-    glShaderSource(id, 1, shaderSrc, nullptr);
-    glCompileShader(id);
-    checkCompilationStatus(GL_FRAGMENT_SHADER, id);
+void ShaderProgram::setTransformFeedbackVaryings(std::vector<std::string> varyings) {
+    _feedbackVaryings = std::move(varyings);
+}
 
-    _shaders.push_back(id);
+void ShaderProgram::addDefine(std::string_view name, std::string_view value) {
+    _defines += std::format("#define {} {}\n", name, value);
 }
 
 std::string_view ShaderProgram::name() const {
@@ -143,26 +204,180 @@ unsigned int ShaderProgram::id() const {
     return _programId;
 }
 
+int ShaderProgram::uniformLocation(std::string_view name) const {
+    for (const auto& [uniform, location] : _uniformLocations) {
+        if (uniform == name) {
+            return location;
+        }
+    }
+
+    const std::string& uniform = _uniformLocations.emplace_back(name, -1).first;
+    const int location = glGetUniformLocation(_programId, uniform.c_str());
+    _uniformLocations.back().second = location;
+    return location;
+}
+
 void ShaderProgram::createAndLinkProgram() {
-    if (_shaders.empty()) {
+    ZoneScoped;
+
+    if (_sources.empty()) {
         throw Err(
             7010,
             std::format("No shaders have been added to the program '{}'", _name)
         );
     }
 
+    // The macros are part of the sources, so every permutation has its own cache key
+    if (!_defines.empty()) {
+        for (auto& [type, source] : _sources) {
+            insertDefines(source, _defines);
+        }
+    }
+
     // Create the program
     createProgram();
 
+    // Program binaries are only available since OpenGL 4.1
+    std::filesystem::path cachePath =
+        GLAD_GL_VERSION_4_1 ?
+        Engine::instance().settings().shaderCachePath :
+        std::filesystem::path();
+    if (!cachePath.empty()) {
+        // The binaries are only valid for the driver and GPU that created them
+        uint64_t key = FnvOffset;
+        for (const auto& [type, source] : _sources) {
+            hash(key, &type, sizeof(type));
+            hashString(key, source);
+        }
+        for (const std::string& varying : _feedbackVaryings) {
+            hashString(key, varying);
+        }
+        hashGLString(key, GL_VENDOR);
+        hashGLString(key, GL_RENDERER);
+        hashGLString(key, GL_VERSION);
+        cachePath /= std::format("{:016x}.sgctshader", key);
+
+        if (loadBinary(cachePath)) {
+            _sources.clear();
+            return;
+        }
+    }
+
+    // All shaders are compiled before their status is queried, which would wait for the
+    // compilation, so that drivers with parallel shader compilation compile them
+    // concurrently
+    for (const auto& [type, source] : _sources) {
+        const unsigned int id = glCreateShader(type);
+        const char* shaderSrc = source.c_str();
+        glShaderSource(id, 1, &shaderSrc, nullptr);
+        glCompileShader(id);
+        _shaders.push_back(id);
+    }
+    for (size_t i = 0; i < _sources.size(); i++) {
+        checkCompilationStatus(_sources[i].first, _shaders[i]);
+    }
+    _sources.clear();
+
     // Link shaders
     for (const unsigned int shader : _shaders) {
         glAttachShader(_programId, shader);
     }
+    if (!_feedbackVaryings.empty()) {
+        std::vector<const char*> names;
+        names.reserve(_feedbackVaryings.size());
+        for (const std::string& varying : _feedbackVaryings) {
+            names.push_back(varying.c_str());
+        }
+        glTransformFeedbackVaryings(
+            _programId,
+            static_cast<GLsizei>(names.size()),
+            names.data(),
+            GL_INTERLEAVED_ATTRIBS
+        );
+    }
+    if (!cachePath.empty()) {
+        glProgramParameteri(_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(_programId);
     const bool isLinked = checkLinkStatus(_programId, _name);
     if (!isLinked) {
         throw Err(7011, std::format("Error linking the program '{}'", _name));
     }
+
+    if (!cachePath.empty()) {
+        storeBinary(cachePath);
+    }
+}
+
+bool ShaderProgram::loadBinary(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        return false;
+    }
+    const size_t size = static_cast<size_t>(file.tellg());
+    if (size <= Magic.size() + sizeof(uint32_t)) {
+        return false;
+    }
+    file.seekg(0);
+
+    std::array<char, 4> magic;
+    uint32_t format = 0;
+    file.read(magic.data(), magic.size());
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    std::vector<char> binary(size - Magic.size() - sizeof(format));
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file.good() || magic != Magic) {
+        return false;
+    }
+
+    glProgramBinary(
+        _programId,
+        static_cast<GLenum>(format),
+        binary.data(),
+        static_cast<GLsizei>(binary.size())
+    );
+    GLint linkStatus = 0;
+    glGetProgramiv(_programId, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == 0) {
+        // The driver can reject binaries of an older version of itself even if the
+        // version string has not changed, in which case the program is compiled again
+        Log::Debug(std::format("Cached binary of shader '{}' was rejected", _name));
+        return false;
+    }
+
+    Log::Debug(std::format("Loaded shader '{}' from the shader cache", _name));
+    return true;
+}
+
+void ShaderProgram::storeBinary(const std::filesystem::path& path) const {
+    ZoneScoped;
+
+    GLint length = 0;
+    glGetProgramiv(_programId, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        // Drivers without any binary formats do not support the cache
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(_programId, length, nullptr, &format, binary.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const uint32_t f = static_cast<uint32_t>(format);
+    file.write(Magic.data(), Magic.size());
+    file.write(reinterpret_cast<const char*>(&f), sizeof(f));
+    file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file.good()) {
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Warning(std::format(
+            "Failed to write shader cache file '{}'", path.string()
+        ));
+    }
 }
 
 void ShaderProgram::createProgram() {
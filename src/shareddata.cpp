@@ -8,12 +8,43 @@
 
 #include <sgct/shareddata.h>
 
+#include <sgct/engine.h>
+#include <sgct/error.h>
+#include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/profiling.h>
 #include <zlib.h>
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <string>
 
+namespace {
+    // The size of an entry of the segment table, which holds the id and the size
+    constexpr size_t SegmentEntrySize = 2 * sizeof(uint32_t);
+
+    // The jobs refer to buffers that have to outlive them, so all jobs are waited for
+    // before the first exception that any of them threw is rethrown
+    void waitForAll(sgct::JobSystem& jobSystem,
+                    const std::vector<sgct::JobSystem::Job>& jobs)
+    {
+        std::exception_ptr error;
+        for (const sgct::JobSystem::Job& job : jobs) {
+            try {
+                jobSystem.wait(job);
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+} // namespace
+
 namespace sgct {
 
 SharedData* SharedData::_instance = nullptr;
@@ -50,53 +81,335 @@ void SharedData::setDecodeFunction(
     _decodeFn = std::move(function);
 }
 
+void SharedData::setEncodeWriterFunction(std::function<void(ByteWriter&)> function) {
+    _encodeWriterFn = std::move(function);
+}
+
+void SharedData::setDecodeReaderFunction(std::function<void(ByteReader&)> function) {
+    _decodeReaderFn = std::move(function);
+}
+
+void SharedData::setSegmentFunctions(uint32_t id,
+                                     std::function<void(ByteWriter&)> encode,
+                                     std::function<void(ByteReader&)> decode)
+{
+    Segment& segment = _segments[id];
+    segment.encode = std::move(encode);
+    segment.decode = std::move(decode);
+}
+
+void SharedData::removeSegmentFunctions(uint32_t id) {
+    _segments.erase(id);
+}
+
+void SharedData::setEncodeSkipped(bool state) {
+    _isEncodeSkipped = state;
+}
+
 void SharedData::decode(const char* receivedData, int receivedLength) {
     ZoneScoped;
 
+    ReceiveBuffer buffer;
     {
-        const std::unique_lock lk(mutex::DataSync);
+        const std::unique_lock lock(_receiveMutex);
+        if (!_freeBuffers.empty()) {
+            buffer = std::move(_freeBuffers.back());
+            _freeBuffers.pop_back();
+        }
+        else {
+            buffer.reserve(_expectedSize);
+            _receiveMemory.add(buffer.capacity());
+        }
+    }
 
-        // reset
-        _dataBlock.clear();
+    // The copy is made without holding the lock so that a large block does not stall
+    // the render thread
+    const size_t capacity = buffer.capacity();
+    buffer.assign(
+        reinterpret_cast<const std::byte*>(receivedData),
+        reinterpret_cast<const std::byte*>(receivedData) + receivedLength
+    );
+    addBlock(buffer.size(), buffer.capacity() > capacity);
+    if (buffer.capacity() > capacity) {
+        _receiveMemory.add(buffer.capacity() - capacity);
+    }
+
+    const std::unique_lock lock(_receiveMutex);
+    _pendingData.push_back(std::move(buffer));
+}
+
+void SharedData::applyReceivedData() {
+    ZoneScoped;
 
-        if (receivedLength > static_cast<int>(_dataBlock.capacity())) {
-            _dataBlock.reserve(receivedLength);
+    {
+        const std::unique_lock lock(_receiveMutex);
+        std::swap(_pendingData, _decodingData);
+    }
+
+    _decodeTime = 0.0;
+    for (const ReceiveBuffer& data : _decodingData) {
+        decodeBlock(data);
+    }
+
+    const std::unique_lock lock(_receiveMutex);
+    for (ReceiveBuffer& data : _decodingData) {
+        _freeBuffers.push_back(std::move(data));
+    }
+    _decodingData.clear();
+}
+
+std::vector<JobSystem::Job> SharedData::startSegmentEncoding() {
+    std::vector<JobSystem::Job> jobs;
+    JobSystem& jobSystem = Engine::instance().jobSystem();
+    for (auto& [id, segment] : _segments) {
+        if (!segment.encode) {
+            continue;
         }
-        _dataBlock.insert(
-            _dataBlock.end(),
-            reinterpret_cast<const std::byte*>(receivedData),
-            reinterpret_cast<const std::byte*>(receivedData) + receivedLength
+        jobs.push_back(jobSystem.submit([&segment]() {
+            ZoneScopedN("Encode segment");
+            segment.buffer.clear();
+            ByteWriter writer = ByteWriter(segment.buffer);
+            segment.encode(writer);
+        }));
+    }
+    return jobs;
+}
+
+void SharedData::appendSegments(const std::vector<JobSystem::Job>& jobs,
+                                std::vector<std::byte>& buffer)
+{
+    ZoneScoped;
+
+    waitForAll(Engine::instance().jobSystem(), jobs);
+
+    // The segments are visited in the same order in which their jobs were submitted
+    std::vector<std::byte> table;
+    ByteWriter tableWriter = ByteWriter(table);
+    uint32_t nSegments = 0;
+    for (const auto& [id, segment] : _segments) {
+        if (!segment.encode) {
+            continue;
+        }
+        buffer.insert(buffer.end(), segment.buffer.begin(), segment.buffer.end());
+        tableWriter.write(id);
+        tableWriter.write(static_cast<uint32_t>(segment.buffer.size()));
+        nSegments++;
+    }
+    tableWriter.write(nSegments);
+    buffer.insert(buffer.end(), table.begin(), table.end());
+}
+
+std::vector<JobSystem::Job> SharedData::startSegmentDecoding(
+                                                     std::span<const std::byte> data,
+                                                     std::span<const std::byte> table)
+{
+    std::vector<JobSystem::Job> jobs;
+    JobSystem& jobSystem = Engine::instance().jobSystem();
+    size_t offset = 0;
+    for (size_t i = 0; i < table.size() / SegmentEntrySize; i++) {
+        uint32_t id = 0;
+        uint32_t size = 0;
+        std::memcpy(&id, table.data() + i * SegmentEntrySize, sizeof(uint32_t));
+        std::memcpy(
+            &size,
+            table.data() + i * SegmentEntrySize + sizeof(uint32_t),
+            sizeof(uint32_t)
         );
+        const std::span<const std::byte> segmentData = data.subspan(offset, size);
+        offset += size;
+
+        const auto it = _segments.find(id);
+        if (it == _segments.end() || !it->second.decode) {
+            continue;
+        }
+        const std::function<void(ByteReader&)>& decode = it->second.decode;
+        jobs.push_back(jobSystem.submit([&decode, segmentData, id]() {
+            ZoneScopedN("Decode segment");
+            try {
+                ByteReader reader = ByteReader(segmentData);
+                decode(reader);
+            }
+            catch (const Error& e) {
+                Log::Warning(std::format(
+                    "Could not decode the shared data segment {}: {}", id, e.message
+                ));
+            }
+        }));
     }
+    return jobs;
+}
 
-    if (_decodeFn) {
-        std::vector<std::byte> data;
-        data.assign(
-            reinterpret_cast<const std::byte*>(receivedData),
-            reinterpret_cast<const std::byte*>(receivedData) + receivedLength
+void SharedData::decodeBlock(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    // The user's data is followed by the shared objects and the size of their section
+    uint32_t objectsSize = 0;
+    if (data.size() >= sizeof(uint32_t)) {
+        std::memcpy(
+            &objectsSize,
+            data.data() + data.size() - sizeof(uint32_t),
+            sizeof(uint32_t)
+        );
+    }
+    if (data.size() < sizeof(uint32_t) || objectsSize > data.size() - sizeof(uint32_t)) {
+        Log::Warning(
+            std::format("Received malformed shared data of {} bytes", data.size())
+        );
+        return;
+    }
+    const size_t objectsEnd = data.size() - sizeof(uint32_t);
+    const size_t objectsBegin = objectsEnd - objectsSize;
+
+    // The segments and their table precede the shared objects
+    uint32_t nSegments = 0;
+    if (objectsBegin >= sizeof(uint32_t)) {
+        std::memcpy(
+            &nSegments,
+            data.data() + objectsBegin - sizeof(uint32_t),
+            sizeof(uint32_t)
         );
-        _decodeFn(data);
+    }
+    const size_t tableSize = static_cast<size_t>(nSegments) * SegmentEntrySize;
+    if (objectsBegin < sizeof(uint32_t) || tableSize > objectsBegin - sizeof(uint32_t)) {
+        Log::Warning(
+            std::format("Received malformed shared data of {} bytes", data.size())
+        );
+        return;
+    }
+    const size_t tableBegin = objectsBegin - sizeof(uint32_t) - tableSize;
+    const std::span<const std::byte> table = data.subspan(tableBegin, tableSize);
+    size_t segmentsSize = 0;
+    for (uint32_t i = 0; i < nSegments; i++) {
+        uint32_t size = 0;
+        std::memcpy(
+            &size,
+            table.data() + i * SegmentEntrySize + sizeof(uint32_t),
+            sizeof(uint32_t)
+        );
+        segmentsSize += size;
+    }
+    if (segmentsSize > tableBegin) {
+        Log::Warning(
+            std::format("Received malformed shared data of {} bytes", data.size())
+        );
+        return;
+    }
+    const size_t userLength = tableBegin - segmentsSize;
+
+    if (objectsSize > 0) {
+        decodeObjects(data.subspan(objectsBegin, objectsSize));
+    }
+
+    // The segments are decoded by the jobs while the user's data is decoded here
+    const double t0 = time();
+    const std::vector<JobSystem::Job> jobs =
+        startSegmentDecoding(data.subspan(userLength, segmentsSize), table);
+    _decodeTime += time() - t0;
+    decodeUserData(data.first(userLength));
+    const double t1 = time();
+    waitForAll(Engine::instance().jobSystem(), jobs);
+    _decodeTime += time() - t1;
+}
+
+void SharedData::decodeUserData(std::span<const std::byte> data) {
+    const size_t userLength = data.size();
+    if (userLength == 0) {
+        // The master did not encode any data in this frame
+        return;
+    }
+    if (_decodeReaderFn) {
+        ByteReader reader = ByteReader(data.first(userLength));
+        const double t0 = time();
+        _decodeReaderFn(reader);
+        _decodeTime += time() - t0;
+    }
+    if (_decodeFn) {
+        // Reusing the same buffer avoids an allocation in every frame
+        _decodeBuffer.assign(data.begin(), data.begin() + userLength);
+        updateBlockMemory();
+        const double t0 = time();
+        _decodeFn(_decodeBuffer);
+        _decodeTime += time() - t0;
     }
 }
 
 void SharedData::encode() {
     ZoneScoped;
 
-    {
+    _isFullState = _isFullStateRequested.exchange(false);
+    _encodeTime = 0.0;
+    if (_isEncodeSkipped && !_isFullState) {
         const std::unique_lock lk(mutex::DataSync);
         _dataBlock.clear();
+        // An empty segment table
+        ByteWriter(_dataBlock).write(uint32_t(0));
+        encodeObjects(_dataBlock);
+        addBlock(_dataBlock.size(), false);
+        updateBlockMemory();
+        return;
+    }
 
-        _dataBlock.insert(
-            _dataBlock.begin(),
-            _headerSpace.cbegin(),
-            _headerSpace.cbegin() + Network::HeaderSize
-        );
+    if (_encodeWriterFn) {
+        // The data is written straight into the previous frame's buffer
+        const std::unique_lock lk(mutex::DataSync);
+        const size_t capacity = _dataBlock.capacity();
+        _dataBlock.clear();
+        ByteWriter writer = ByteWriter(_dataBlock);
+        const double t0 = time();
+        const std::vector<JobSystem::Job> jobs = startSegmentEncoding();
+        _encodeWriterFn(writer);
+        appendSegments(jobs, _dataBlock);
+        _encodeTime = time() - t0;
+        encodeObjects(_dataBlock);
+        addBlock(_dataBlock.size(), _dataBlock.capacity() > capacity);
+        updateBlockMemory();
+        return;
+    }
+
+    const double t0 = time();
+    const std::vector<JobSystem::Job> jobs = startSegmentEncoding();
+    std::vector<std::byte> data;
+    try {
+        data = _encodeFn ? _encodeFn() : std::vector<std::byte>();
     }
+    catch (...) {
+        // The jobs write into the buffers of the segments, so they have to finish first
+        waitForAll(Engine::instance().jobSystem(), jobs);
+        throw;
+    }
+    appendSegments(jobs, data);
+    _encodeTime = time() - t0;
+    encodeObjects(data);
+    // The buffer is provided by the encode function, so it is not counted as a resize
+    addBlock(data.size(), false);
+
+    const std::unique_lock lk(mutex::DataSync);
+    _dataBlock = std::move(data);
+    updateBlockMemory();
+}
 
-    if (_encodeFn) {
-        std::vector<std::byte> data = _encodeFn();
-        _dataBlock.insert(_dataBlock.end(), data.begin(), data.end());
+void SharedData::replay(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    // The recording only contains the state that was sent in the recorded session, so
+    // a request for the full state cannot be served and is dropped
+    _isFullStateRequested = false;
+    _isFullState = false;
+    _encodeTime = 0.0;
+    {
+        const std::unique_lock lk(mutex::DataSync);
+        const size_t capacity = _dataBlock.capacity();
+        _dataBlock.assign(data.begin(), data.end());
+        addBlock(_dataBlock.size(), _dataBlock.capacity() > capacity);
+        updateBlockMemory();
     }
+
+    _decodeTime = 0.0;
+    decodeBlock(data);
+}
+
+unsigned char* SharedData::header() {
+    return reinterpret_cast<unsigned char*>(_headerSpace.data());
 }
 
 unsigned char* SharedData::dataBlock() {
@@ -111,6 +424,183 @@ int SharedData::bufferSize() {
     return static_cast<int>(_dataBlock.capacity());
 }
 
+void SharedData::reserve(size_t size) {
+    {
+        const std::unique_lock lk(mutex::DataSync);
+        _dataBlock.reserve(size);
+        _decodeBuffer.reserve(size);
+        updateBlockMemory();
+    }
+
+    // Two buffers are enough to receive the next block while the previous one is decoded
+    const std::unique_lock lock(_receiveMutex);
+    _expectedSize = size;
+    if (_freeBuffers.size() < 2) {
+        _freeBuffers.resize(2);
+    }
+    for (ReceiveBuffer& buffer : _freeBuffers) {
+        const size_t capacity = buffer.capacity();
+        buffer.reserve(size);
+        _receiveMemory.add(buffer.capacity() - capacity);
+    }
+}
+
+SharedData::Statistics SharedData::statistics() const {
+    const std::unique_lock lock(_statisticsMutex);
+    return _statistics;
+}
+
+double SharedData::encodeTime() const {
+    return _encodeTime;
+}
+
+double SharedData::decodeTime() const {
+    return _decodeTime;
+}
+
+void SharedData::updateBlockMemory() {
+    _blockMemory.set(_dataBlock.capacity() + _decodeBuffer.capacity());
+
+    // Only the blocks that can hold a huge page benefit from the advice
+    auto advise = [](std::vector<std::byte>& block, const std::byte*& advised) {
+        if (block.capacity() >= BufferPolicy::HugePageSize && block.data() != advised) {
+            BufferPolicy::advise(
+                BufferPolicy::Subsystem::SharedData,
+                block.data(),
+                block.capacity()
+            );
+            advised = block.data();
+        }
+    };
+    advise(_dataBlock, _advisedDataBlock);
+    advise(_decodeBuffer, _advisedDecodeBuffer);
+}
+
+void SharedData::addBufferResize() {
+    const std::unique_lock lock(_statisticsMutex);
+    _statistics.nResizes++;
+}
+
+void SharedData::addBlock(size_t size, bool isResized) {
+    const std::unique_lock lock(_statisticsMutex);
+    _statistics.peakSize = std::max(_statistics.peakSize, size);
+    _statistics.nBlocks++;
+    _statistics.averageSize +=
+        (static_cast<double>(size) - _statistics.averageSize) / _statistics.nBlocks;
+    if (isResized) {
+        _statistics.nResizes++;
+    }
+}
+
+void SharedData::markObjectsDirty() {
+    const std::unique_lock lock(_objectsMutex);
+    for (const std::pair<const uint32_t, SharedObjectBase*>& p : _objects) {
+        p.second->setDirty();
+    }
+}
+
+void SharedData::requestFullState() {
+    _isFullStateRequested = true;
+    markObjectsDirty();
+}
+
+bool SharedData::isFullState() const {
+    return _isFullState;
+}
+
+void SharedData::registerObject(SharedObjectBase* object) {
+    const std::unique_lock lock(_objectsMutex);
+    const bool isInserted = _objects.emplace(object->id(), object).second;
+    if (!isInserted) {
+        throw Error(
+            Error::Component::Engine,
+            3011,
+            std::format("A shared object with id {} already exists", object->id())
+        );
+    }
+}
+
+void SharedData::unregisterObject(SharedObjectBase* object) {
+    // The shared objects might outlive the shared data if they are global variables
+    if (!_instance) {
+        return;
+    }
+
+    const std::unique_lock lock(_instance->_objectsMutex);
+    const auto it = _instance->_objects.find(object->id());
+    if (it != _instance->_objects.end() && it->second == object) {
+        _instance->_objects.erase(it);
+    }
+}
+
+void SharedData::encodeObjects(std::vector<std::byte>& buffer) {
+    ZoneScoped;
+
+    const std::unique_lock lock(_objectsMutex);
+    ByteWriter writer = ByteWriter(buffer);
+    for (const std::pair<const uint32_t, SharedObjectBase*>& p : _objects) {
+        if (!p.second->_isDirty.exchange(false)) {
+            continue;
+        }
+
+        writer.write(p.first);
+        const size_t sizePos = buffer.size();
+        writer.write(uint32_t(0));
+        p.second->serialize(writer);
+
+        const uint32_t size =
+            static_cast<uint32_t>(buffer.size() - sizePos - sizeof(uint32_t));
+        std::memcpy(buffer.data() + sizePos, &size, sizeof(size));
+    }
+    writer.write(static_cast<uint32_t>(writer.size()));
+}
+
+void SharedData::decodeObjects(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    const std::unique_lock lock(_objectsMutex);
+    ByteReader reader = ByteReader(data);
+    try {
+        while (reader.remaining() > 0) {
+            const uint32_t id = reader.read<uint32_t>();
+            const uint32_t size = reader.read<uint32_t>();
+            const std::span<const std::byte> value = reader.readBytes(size);
+
+            // Objects that are not known on this node are skipped
+            const auto it = _objects.find(id);
+            if (it != _objects.end()) {
+                ByteReader valueReader = ByteReader(value);
+                it->second->deserialize(valueReader);
+            }
+        }
+    }
+    catch (const Error& e) {
+        Log::Warning(std::format("Received malformed shared objects: {}", e.message));
+    }
+}
+
+SharedObjectBase::SharedObjectBase(uint32_t id)
+    : _id(id)
+{
+    SharedData::instance().registerObject(this);
+}
+
+SharedObjectBase::~SharedObjectBase() {
+    SharedData::unregisterObject(this);
+}
+
+uint32_t SharedObjectBase::id() const {
+    return _id;
+}
+
+bool SharedObjectBase::isDirty() const {
+    return _isDirty;
+}
+
+void SharedObjectBase::setDirty() {
+    _isDirty = true;
+}
+
 template <>
 void serializeObject(std::vector<std::byte>& buffer, std::string_view value) {
     uint32_t length = static_cast<uint32_t>(value.size());
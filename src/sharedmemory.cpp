@@ -0,0 +1,205 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/sharedmemory.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#define SGCT_ERRNO GetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    constexpr int MaxReadAttempts = 100;
+
+    // The header of each slot is followed by the data and occupies its own cache line
+    constexpr size_t SlotHeaderSize = 64;
+    constexpr size_t SlotSize = SlotHeaderSize + sgct::SharedMemory::SlotCapacity;
+} // namespace
+
+namespace sgct {
+
+// A slot that is being written to has an odd version number. A reader that sees the same
+// even version number before and after copying the data has a consistent copy
+struct alignas(SlotHeaderSize) SharedMemory::Slot {
+    std::atomic<uint32_t> version;
+    std::atomic<int32_t> frame;
+    std::atomic<uint32_t> size;
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+SharedMemory::SharedMemory(std::string name, bool isServer)
+    : _name(std::move(name))
+    , _isServer(isServer)
+    , _size(NumberOfSlots * SlotSize)
+{
+    ZoneScoped;
+
+#ifdef WIN32
+    const std::string fullName = "Local\\" + _name;
+    if (_isServer) {
+        _handle = CreateFileMappingA(
+            INVALID_HANDLE_VALUE,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(_size) >> 32),
+            static_cast<DWORD>(_size & 0xFFFFFFFF),
+            fullName.c_str()
+        );
+    }
+    else {
+        _handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, fullName.c_str());
+    }
+    if (!_handle) {
+        throw Err(
+            5039,
+            std::format("Failed to open shared memory '{}': {}", _name, SGCT_ERRNO)
+        );
+    }
+    _memory = reinterpret_cast<char*>(
+        MapViewOfFile(_handle, FILE_MAP_ALL_ACCESS, 0, 0, _size)
+    );
+    if (!_memory) {
+        CloseHandle(_handle);
+        throw Err(
+            5039,
+            std::format("Failed to map shared memory '{}': {}", _name, SGCT_ERRNO)
+        );
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const std::string fullName = "/" + _name;
+    _fd = _isServer ?
+        shm_open(fullName.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR) :
+        shm_open(fullName.c_str(), O_RDWR, 0);
+    if (_fd == -1) {
+        throw Err(
+            5039,
+            std::format("Failed to open shared memory '{}': {}", _name, SGCT_ERRNO)
+        );
+    }
+    if (_isServer && ftruncate(_fd, static_cast<off_t>(_size)) == -1) {
+        close(_fd);
+        shm_unlink(fullName.c_str());
+        throw Err(
+            5039,
+            std::format("Failed to resize shared memory '{}': {}", _name, SGCT_ERRNO)
+        );
+    }
+    void* memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (memory == MAP_FAILED) {
+        close(_fd);
+        if (_isServer) {
+            shm_unlink(fullName.c_str());
+        }
+        throw Err(
+            5039,
+            std::format("Failed to map shared memory '{}': {}", _name, SGCT_ERRNO)
+        );
+    }
+    _memory = reinterpret_cast<char*>(memory);
+#endif // WIN32
+
+    if (_isServer) {
+        // The segment might be left over from a previous run, so no slot is valid yet
+        for (int i = 0; i < NumberOfSlots; i++) {
+            Slot* s = new (_memory + i * SlotSize) Slot;
+            s->version = 0;
+            s->frame = -1;
+            s->size = 0;
+        }
+    }
+}
+
+SharedMemory::~SharedMemory() {
+#ifdef WIN32
+    UnmapViewOfFile(_memory);
+    CloseHandle(_handle);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    munmap(_memory, _size);
+    close(_fd);
+    if (_isServer) {
+        shm_unlink(("/" + _name).c_str());
+    }
+#endif // WIN32
+}
+
+bool SharedMemory::write(int32_t frame, const char* data, uint32_t length) {
+    ZoneScoped;
+
+    if (length > SlotCapacity) {
+        return false;
+    }
+
+    Slot& s = slot(frame);
+    const uint32_t version = s.version.load(std::memory_order_relaxed);
+    s.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s.frame.store(frame, std::memory_order_relaxed);
+    s.size.store(length, std::memory_order_relaxed);
+    std::memcpy(reinterpret_cast<char*>(&s) + SlotHeaderSize, data, length);
+
+    s.version.store(version + 2, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemory::read(int32_t frame, std::vector<char>& data) const {
+    ZoneScoped;
+
+    const Slot& s = slot(frame);
+    for (int i = 0; i < MaxReadAttempts; i++) {
+        const uint32_t version = s.version.load(std::memory_order_acquire);
+        if (version % 2 == 1) {
+            // The master is currently writing to this slot
+            std::this_thread::yield();
+            continue;
+        }
+        if (s.frame.load(std::memory_order_relaxed) != frame) {
+            return false;
+        }
+
+        const uint32_t size =
+            std::min(s.size.load(std::memory_order_relaxed), SlotCapacity);
+        data.resize(size);
+        const char* begin = reinterpret_cast<const char*>(&s) + SlotHeaderSize;
+        std::memcpy(data.data(), begin, size);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.version.load(std::memory_order_relaxed) == version) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SharedMemory::Slot& SharedMemory::slot(int32_t frame) const {
+    const size_t index = static_cast<size_t>(frame) % NumberOfSlots;
+    return *reinterpret_cast<Slot*>(_memory + index * SlotSize);
+}
+
+} // namespace sgct
@@ -0,0 +1,263 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/sortlastcompositor.h>
+
+#include <sgct/clustermanager.h>
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/networkmanager.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    // Every transfer starts with this header, followed by the color and the depth of the
+    // rows of the part
+    struct Header {
+        int32_t node = 0;
+        uint32_t frame = 0;
+        uint32_t key = 0;
+        int32_t firstRow = 0;
+        int32_t nRows = 0;
+        int32_t width = 0;
+        int32_t bytesPerPixel = 0;
+    };
+
+    // The stages of the compositing, which identify the parts that are exchanged. The
+    // rounds of the binary swap follow the fold stage, and the gather stage is offset by
+    // the rank of the node that sends its rows to the output node
+    constexpr int FoldStage = 0;
+    constexpr int GatherStage = 32;
+
+    // The longest time that a node waits for a part before it continues without it. A
+    // node that is this late has most likely lost its connection, so waiting longer would
+    // only stall the whole cluster
+    constexpr std::chrono::milliseconds Timeout = std::chrono::milliseconds(500);
+
+    uint32_t stageKey(int window, int eye, int stage) {
+        return (static_cast<uint32_t>(window & 0xFF) << 24) |
+            (static_cast<uint32_t>(eye & 0xFF) << 16) | static_cast<uint32_t>(stage);
+    }
+} // namespace
+
+namespace sgct {
+
+bool SortLastCompositor::composite(const Group& group, int window, int eye, Image& image)
+{
+    ZoneScoped;
+
+    // The compositing starts with the output node, which never sends its rows away, so
+    // that it ends up with the composited image. The order in which the images are
+    // composited does not change the result as all of them are tested against the depth
+    std::vector<int> order = { group.output };
+    for (int node : group.nodes) {
+        if (node != group.output) {
+            order.push_back(node);
+        }
+    }
+    const int thisNode = ClusterManager::instance().thisNodeId();
+    const auto it = std::find(order.begin(), order.end(), thisNode);
+    if (it == order.end()) {
+        return false;
+    }
+    const int rank = static_cast<int>(std::distance(order.begin(), it));
+    const int nNodes = static_cast<int>(order.size());
+    int nSwapping = 1;
+    while (nSwapping * 2 <= nNodes) {
+        nSwapping *= 2;
+    }
+
+    const unsigned int frame = Engine::instance().clusterFrameNumber();
+    const size_t width = static_cast<size_t>(image.size.x);
+    const size_t bpp = static_cast<size_t>(image.bytesPerPixel);
+    auto merge = [&](const Part& part, bool isDepthTested) {
+        const size_t nPixels = static_cast<size_t>(part.nRows) * width;
+        if (part.firstRow < 0 || part.firstRow + part.nRows > image.size.y ||
+            part.color.size() != nPixels * bpp || part.depth.size() != nPixels)
+        {
+            Log::Warning("Received a part of a composited image that does not fit");
+            return;
+        }
+
+        const size_t offset = static_cast<size_t>(part.firstRow) * width;
+        for (size_t i = 0; i < nPixels; i++) {
+            if (isDepthTested && part.depth[i] >= image.depth[offset + i]) {
+                continue;
+            }
+            image.depth[offset + i] = part.depth[i];
+            std::memcpy(
+                image.color.data() + (offset + i) * bpp,
+                part.color.data() + i * bpp,
+                bpp
+            );
+        }
+    };
+
+    // The nodes beyond the largest power of two fold their image into another node
+    const uint32_t foldKey = stageKey(window, eye, FoldStage);
+    if (rank >= nSwapping) {
+        send(order[rank - nSwapping], foldKey, 0, image.size.y, image);
+        return false;
+    }
+    if (rank + nSwapping < nNodes && take(foldKey, frame, _part)) {
+        merge(_part, true);
+    }
+
+    // Partners only differ in the bit of the round, so they are responsible for the same
+    // rows, of which the partner with the lower rank keeps the lower half
+    int begin = 0;
+    int end = image.size.y;
+    int stage = FoldStage + 1;
+    for (int bit = 1; bit < nSwapping; bit <<= 1, stage++) {
+        const int partner = order[rank ^ bit];
+        const int mid = begin + (end - begin) / 2;
+        const uint32_t key = stageKey(window, eye, stage);
+        if ((rank & bit) == 0) {
+            send(partner, key, mid, end - mid, image);
+            end = mid;
+        }
+        else {
+            send(partner, key, begin, mid - begin, image);
+            begin = mid;
+        }
+        if (take(key, frame, _part)) {
+            merge(_part, true);
+        }
+    }
+
+    if (rank != 0) {
+        const uint32_t key = stageKey(window, eye, GatherStage + rank);
+        send(order[0], key, begin, end - begin, image);
+        return false;
+    }
+    for (int r = 1; r < nSwapping; r++) {
+        if (take(stageKey(window, eye, GatherStage + r), frame, _part)) {
+            merge(_part, false);
+        }
+    }
+    return true;
+}
+
+void SortLastCompositor::send(int node, uint32_t key, int firstRow, int nRows,
+                              const Image& image) const
+{
+    ZoneScoped;
+
+    const Header header = {
+        .node = node,
+        .frame = Engine::instance().clusterFrameNumber(),
+        .key = key,
+        .firstRow = firstRow,
+        .nRows = nRows,
+        .width = image.size.x,
+        .bytesPerPixel = image.bytesPerPixel
+    };
+    const size_t offset = static_cast<size_t>(firstRow) * image.size.x;
+    const size_t nPixels = static_cast<size_t>(nRows) * image.size.x;
+    const size_t colorSize = nPixels * image.bytesPerPixel;
+    const size_t depthSize = nPixels * sizeof(float);
+    std::vector<std::byte> buffer(sizeof(Header) + colorSize + depthSize);
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+    std::memcpy(
+        buffer.data() + sizeof(Header),
+        image.color.data() + offset * image.bytesPerPixel,
+        colorSize
+    );
+    std::memcpy(
+        buffer.data() + sizeof(Header) + colorSize,
+        image.depth.data() + offset,
+        depthSize
+    );
+
+    NetworkManager& nm = NetworkManager::instance();
+    const int size = static_cast<int>(buffer.size());
+    if (!nm.isComputerServer()) {
+        // A client only has the data transfer connection to the master
+        nm.transferData(buffer.data(), size, PackageId);
+    }
+    else if (const Network* connection = nm.transferConnection(node)) {
+        nm.transferData(buffer.data(), size, PackageId, *connection);
+    }
+}
+
+void SortLastCompositor::receive(const void* data, int length) {
+    ZoneScoped;
+
+    if (length < static_cast<int>(sizeof(Header))) {
+        Log::Warning("Received a part of a composited image without a header");
+        return;
+    }
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    const size_t nPixels = static_cast<size_t>(header.nRows) * header.width;
+    const size_t colorSize = nPixels * header.bytesPerPixel;
+    const size_t depthSize = nPixels * sizeof(float);
+    if (header.nRows < 0 || header.width < 0 || header.bytesPerPixel <= 0 ||
+        static_cast<size_t>(length) != sizeof(Header) + colorSize + depthSize)
+    {
+        Log::Warning("Received an invalid part of a composited image");
+        return;
+    }
+
+    NetworkManager& nm = NetworkManager::instance();
+    if (header.node != ClusterManager::instance().thisNodeId()) {
+        // Only the master receives the parts of other nodes, which it relays to them
+        if (const Network* connection = nm.transferConnection(header.node)) {
+            nm.transferData(data, length, PackageId, *connection);
+        }
+        return;
+    }
+
+    {
+        const std::lock_guard lock(_mutex);
+        Part& part = _slots[header.key].part;
+        const std::byte* payload =
+            reinterpret_cast<const std::byte*>(data) + sizeof(Header);
+        part.frame = header.frame;
+        part.firstRow = header.firstRow;
+        part.nRows = header.nRows;
+        part.color.assign(payload, payload + colorSize);
+        part.depth.resize(nPixels);
+        std::memcpy(part.depth.data(), payload + colorSize, depthSize);
+        _slots[header.key].isValid = true;
+    }
+    _cv.notify_all();
+}
+
+bool SortLastCompositor::take(uint32_t key, unsigned int frame, Part& part) {
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    Slot& slot = _slots[key];
+    // A part of a later frame can arrive before this node has started compositing if the
+    // cluster runs without frame lock, which is used as well
+    const bool hasArrived = _cv.wait_for(
+        lock,
+        Timeout,
+        [&]() { return slot.isValid && slot.part.frame >= frame; }
+    );
+    if (!hasArrived) {
+        if (!_hasWarned) {
+            Log::Warning(std::format(
+                "A part of a composited image of frame {} did not arrive in time and is "
+                "left out", frame
+            ));
+            _hasWarned = true;
+        }
+        return false;
+    }
+
+    std::swap(part, slot.part);
+    slot.isValid = false;
+    return true;
+}
+
+} // namespace sgct
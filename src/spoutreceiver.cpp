@@ -0,0 +1,101 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifdef SGCT_HAS_SPOUT
+
+#include <sgct/spoutreceiver.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/spoutsharedtexture.h>
+#include <utility>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <SpoutLibrary.h>
+
+namespace sgct {
+
+SpoutReceiver::SpoutReceiver(std::string senderName)
+    : _senderName(std::move(senderName))
+    , _handle(GetSpout())
+{
+    if (!_handle) {
+        Log::Error(std::format("Error creating SPOUT handle for {}", _senderName));
+    }
+}
+
+SpoutReceiver::~SpoutReceiver() {
+    _texture = nullptr;
+    if (_handle) {
+        _handle->Release();
+    }
+}
+
+bool SpoutReceiver::update() {
+    if (_texture) {
+        _texture->unlock();
+    }
+    _isLocked = false;
+    if (!_handle) {
+        return false;
+    }
+
+    // The sender information is read from shared memory, so it is cheap to check every
+    // frame whether the sender is still the same
+    unsigned int width = 0;
+    unsigned int height = 0;
+    HANDLE shareHandle = nullptr;
+    DWORD format = 0;
+    const bool hasSender =
+        _handle->GetSenderInfo(_senderName.c_str(), width, height, shareHandle, format);
+    if (!hasSender || !shareHandle) {
+        if (_shareHandle) {
+            Log::Info(std::format("Spout sender '{}' disconnected", _senderName));
+        }
+        _texture = nullptr;
+        _shareHandle = nullptr;
+        return false;
+    }
+
+    if (shareHandle != _shareHandle) {
+        // If the texture can't be opened, it is not tried again until the sender changes
+        _shareHandle = shareHandle;
+        _size = ivec2(static_cast<int>(width), static_cast<int>(height));
+        _texture = nullptr;
+        _texture = SpoutSharedTexture::open(
+            _handle,
+            _senderName,
+            SpoutSharedTexture::Access::Read
+        );
+        if (_texture) {
+            Log::Info(std::format(
+                "Receiving {}x{} texture from '{}'", width, height, _senderName
+            ));
+        }
+    }
+
+    _isLocked = _texture && _texture->lock();
+    return _isLocked;
+}
+
+unsigned int SpoutReceiver::texture() const {
+    return _isLocked ? _texture->texture() : 0;
+}
+
+ivec2 SpoutReceiver::size() const {
+    return _size;
+}
+
+} // namespace sgct
+
+#endif // SGCT_HAS_SPOUT
@@ -0,0 +1,200 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifdef SGCT_HAS_SPOUT
+
+#include <sgct/spoutsharedtexture.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+#include <d3d11.h>
+#include <SpoutLibrary.h>
+
+namespace {
+    // The functions of the WGL_NV_DX_interop extension, which is not part of the loader
+    using DXOpenDevice = HANDLE(WINAPI*)(void* dxDevice);
+    using DXCloseDevice = BOOL(WINAPI*)(HANDLE device);
+    using DXRegisterObject =
+        HANDLE(WINAPI*)(HANDLE device, void* dxObject, GLuint name, GLenum type,
+            GLenum access);
+    using DXUnregisterObject = BOOL(WINAPI*)(HANDLE device, HANDLE object);
+    using DXLockObjects = BOOL(WINAPI*)(HANDLE device, GLint count, HANDLE* objects);
+
+    constexpr GLenum AccessReadOnly = 0x0000;
+    constexpr GLenum AccessWriteDiscard = 0x0002;
+} // namespace
+
+namespace sgct {
+
+// The DirectX device that opens the shared textures and its interop handle, which are
+// shared by all textures as long as any of them exists
+struct SpoutSharedTexture::Interop {
+    ~Interop() {
+        if (device) {
+            closeDevice(device);
+        }
+        if (dxDevice) {
+            dxDevice->Release();
+        }
+    }
+
+    ID3D11Device* dxDevice = nullptr;
+    HANDLE device = nullptr;
+
+    DXCloseDevice closeDevice = nullptr;
+    DXRegisterObject registerObject = nullptr;
+    DXUnregisterObject unregisterObject = nullptr;
+    DXLockObjects lockObjects = nullptr;
+    DXLockObjects unlockObjects = nullptr;
+};
+
+std::unique_ptr<SpoutSharedTexture>
+SpoutSharedTexture::open(SPOUTHANDLE handle, const std::string& senderName,
+                         Access access)
+{
+    static std::weak_ptr<Interop> sharedInterop;
+
+    std::shared_ptr<Interop> interop = sharedInterop.lock();
+    if (!interop) {
+        auto openDevice = reinterpret_cast<DXOpenDevice>(
+            wglGetProcAddress("wglDXOpenDeviceNV")
+        );
+        interop = std::make_shared<Interop>();
+        interop->closeDevice = reinterpret_cast<DXCloseDevice>(
+            wglGetProcAddress("wglDXCloseDeviceNV")
+        );
+        interop->registerObject = reinterpret_cast<DXRegisterObject>(
+            wglGetProcAddress("wglDXRegisterObjectNV")
+        );
+        interop->unregisterObject = reinterpret_cast<DXUnregisterObject>(
+            wglGetProcAddress("wglDXUnregisterObjectNV")
+        );
+        interop->lockObjects = reinterpret_cast<DXLockObjects>(
+            wglGetProcAddress("wglDXLockObjectsNV")
+        );
+        interop->unlockObjects = reinterpret_cast<DXLockObjects>(
+            wglGetProcAddress("wglDXUnlockObjectsNV")
+        );
+        if (!openDevice || !interop->closeDevice || !interop->registerObject ||
+            !interop->unregisterObject || !interop->lockObjects ||
+            !interop->unlockObjects)
+        {
+            Log::Warning("WGL_NV_DX_interop is not available for the Spout texture");
+            return nullptr;
+        }
+
+        const HRESULT createRes = D3D11CreateDevice(
+            nullptr,
+            D3D_DRIVER_TYPE_HARDWARE,
+            nullptr,
+            0,
+            nullptr,
+            0,
+            D3D11_SDK_VERSION,
+            &interop->dxDevice,
+            nullptr,
+            nullptr
+        );
+        if (FAILED(createRes)) {
+            Log::Warning("Could not create the DirectX device for the Spout texture");
+            return nullptr;
+        }
+
+        interop->device = openDevice(interop->dxDevice);
+        if (!interop->device) {
+            Log::Warning("Could not open the DirectX device for OpenGL interop");
+            return nullptr;
+        }
+        sharedInterop = interop;
+    }
+
+    unsigned int width = 0;
+    unsigned int height = 0;
+    HANDLE shareHandle = nullptr;
+    DWORD format = 0;
+    const bool hasInfo =
+        handle->GetSenderInfo(senderName.c_str(), width, height, shareHandle, format);
+    if (!hasInfo || !shareHandle) {
+        Log::Warning(std::format("Could not find the Spout texture of '{}'", senderName));
+        return nullptr;
+    }
+
+    std::unique_ptr<SpoutSharedTexture> res =
+        std::unique_ptr<SpoutSharedTexture>(new SpoutSharedTexture);
+    res->_interop = std::move(interop);
+
+    ID3D11Texture2D* dxTexture = nullptr;
+    const HRESULT openRes = res->_interop->dxDevice->OpenSharedResource(
+        shareHandle,
+        __uuidof(ID3D11Texture2D),
+        reinterpret_cast<void**>(&dxTexture)
+    );
+    if (FAILED(openRes)) {
+        Log::Warning(std::format("Could not open the Spout texture of '{}'", senderName));
+        return nullptr;
+    }
+    res->_dxTexture = dxTexture;
+
+    glGenTextures(1, &res->_texture);
+    res->_object = res->_interop->registerObject(
+        res->_interop->device,
+        dxTexture,
+        res->_texture,
+        GL_TEXTURE_2D,
+        access == Access::Read ? AccessReadOnly : AccessWriteDiscard
+    );
+    if (!res->_object) {
+        Log::Warning(std::format(
+            "Could not link the Spout texture of '{}' to OpenGL", senderName
+        ));
+        return nullptr;
+    }
+    return res;
+}
+
+SpoutSharedTexture::~SpoutSharedTexture() {
+    unlock();
+    if (_object) {
+        _interop->unregisterObject(_interop->device, _object);
+    }
+    glDeleteTextures(1, &_texture);
+    if (_dxTexture) {
+        reinterpret_cast<ID3D11Texture2D*>(_dxTexture)->Release();
+    }
+}
+
+unsigned int SpoutSharedTexture::texture() const {
+    return _texture;
+}
+
+bool SpoutSharedTexture::lock() {
+    if (!_isLocked) {
+        _isLocked = _interop->lockObjects(_interop->device, 1, &_object) == TRUE;
+    }
+    return _isLocked;
+}
+
+void SpoutSharedTexture::unlock() {
+    if (_isLocked) {
+        _interop->unlockObjects(_interop->device, 1, &_object);
+        _isLocked = false;
+    }
+}
+
+} // namespace sgct
+
+#endif // SGCT_HAS_SPOUT
@@ -0,0 +1,91 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/statisticshistory.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace sgct {
+
+StatisticsHistory::StatisticsHistory(int length) {
+    setLength(length);
+}
+
+void StatisticsHistory::setLength(int length) {
+    _length = std::max(length, 1);
+    _values = std::make_unique<std::atomic<double>[]>(_length);
+    for (int i = 0; i < _length; i++) {
+        _values[i].store(0.0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sequence.store(0, std::memory_order_relaxed);
+}
+
+void StatisticsHistory::add(double value) {
+    const uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+    const uint64_t count = _count.load(std::memory_order_relaxed);
+
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _values[count % _length].store(value, std::memory_order_relaxed);
+    _count.store(count + 1, std::memory_order_relaxed);
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+int StatisticsHistory::length() const {
+    return _length;
+}
+
+int StatisticsHistory::size() const {
+    const uint64_t count = _count.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<uint64_t>(count, _length));
+}
+
+uint64_t StatisticsHistory::count() const {
+    return _count.load(std::memory_order_acquire);
+}
+
+double StatisticsHistory::operator[](int age) const {
+    const uint64_t count = _count.load(std::memory_order_relaxed);
+    if (age < 0 || static_cast<uint64_t>(age) >= std::min<uint64_t>(count, _length)) {
+        return 0.0;
+    }
+    return _values[(count - 1 - age) % _length].load(std::memory_order_relaxed);
+}
+
+double StatisticsHistory::newest() const {
+    return (*this)[0];
+}
+
+int StatisticsHistory::copy(std::span<double> values) const {
+    while (true) {
+        const uint64_t sequence = _sequence.load(std::memory_order_acquire);
+        if (sequence % 2 == 1) {
+            // The writer only stores a single value, so it is done almost immediately
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t count = _count.load(std::memory_order_relaxed);
+        const int n = static_cast<int>(
+            std::min<uint64_t>(std::min<uint64_t>(count, _length), values.size())
+        );
+        for (int i = 0; i < n; i++) {
+            const uint64_t index = (count - 1 - i) % _length;
+            values[i] = _values[index].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) == sequence) {
+            return n;
+        }
+    }
+}
+
+} // namespace sgct
@@ -45,9 +45,76 @@ out vec4 out_color;
 void main() { out_color = col; }
 )";
 
+    // Each statistic is a line strip with one vertex per value of its history, where the
+    // value of the vertex is looked up in the ring buffer starting from the newest value
+    constexpr std::string_view LineVertShader = R"(
+#version 330 core
+uniform mat4 mvp;
+uniform samplerBuffer values;
+uniform int offset;
+uniform int len;
+uniform int newest;
+uniform int size;
+void main() {
+  float value = 0.0;
+  if (gl_VertexID < size) {
+    value = texelFetch(values, offset + (newest - gl_VertexID + len) % len).r;
+  }
+  gl_Position = mvp * vec4(float(gl_VertexID), value, 0.0, 1.0);
+}
+)";
+
+    // Each bin of a histogram consists of two triangles, whose height is the count of
+    // the bin relative to the largest count of the histogram
+    constexpr std::string_view HistogramVertShader = R"(
+#version 330 core
+uniform mat4 mvp;
+uniform samplerBuffer values;
+uniform int offset;
+uniform int bins;
+uniform float maxBin;
+const vec2 corners[6] = vec2[6](
+  vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0),
+  vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0)
+);
+void main() {
+  int bin = gl_VertexID / 6;
+  vec2 corner = corners[gl_VertexID % 6];
+  float height = texelFetch(values, offset + bin).r / maxBin;
+  float x = (float(bin) + corner.x) / float(bins);
+  gl_Position = mvp * vec4(x, corner.y * height, 0.0, 1.0);
+}
+)";
+
+    constexpr sgct::vec4 ColorNode = sgct::vec4{ 0.8f, 0.8f, 0.8f, 1.f };
+    constexpr sgct::vec4 ColorNodeOutlier = sgct::vec4{ 1.f, 0.2f, 0.2f, 1.f };
+
+    // A client is flagged if its draw or GPU time is this much longer than the median of
+    // all clients. As the frame times of the nodes are locked to each other, they are
+    // not used to find the slowest client
+    constexpr float OutlierFactor = 1.25f;
+    constexpr float OutlierMargin = 1.f / 1000.f; // 1ms
+
     // Histogram parameters
     constexpr double HistogramScaleFrame = 35.0 / 1000.0; // 35ms
     constexpr double HistogramScaleSync = 1.0 / 1000.0; // 1ms
+
+    float median(std::vector<float>& values) {
+        if (values.empty()) {
+            return 0.f;
+        }
+        const auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+
+    // Returns the bin of the histogram with \p nBins bins into which the \p value falls
+    int histogramBin(double value, double scale, int nBins) {
+        // convert from d into [0, 1];  0 for d=0  and 1 for d=MaxHistogramValue
+        const double dp = value / scale;
+        const int dpScaled = static_cast<int>(dp * nBins);
+        return std::clamp(dpScaled, 0, nBins - 1);
+    }
 } // namespace
 
 namespace sgct {
@@ -57,6 +124,9 @@ StatisticsRenderer::StatisticsRenderer(const Engine::Statistics& statistics)
 {
     ZoneScoped;
 
+    const int length = _statistics.frametimes.length();
+    const float historyLength = static_cast<float>(length);
+
     // Static background quad
     struct Vertex {
         Vertex(float x_, float y_) : x(x_), y(y_) {}
@@ -65,27 +135,27 @@ StatisticsRenderer::StatisticsRenderer(const Engine::Statistics& statistics)
     };
     std::vector<Vertex> vs;
     vs.emplace_back(0.f, 0.f);
-    vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), 0.f);
+    vs.emplace_back(historyLength, 0.f);
     vs.emplace_back(0.f, 1.f / 30.f);
-    vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), 1.f / 30.f);
+    vs.emplace_back(historyLength, 1.f / 30.f);
 
     // Static 1 ms lines
     _lines.staticDraw.nLines = 0;
     for (float f = 0.001f; f < (1.f / 30.f); f += 0.001f) {
         vs.emplace_back(0.f, f);
-        vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), f);
+        vs.emplace_back(historyLength, f);
         _lines.staticDraw.nLines++;
     }
 
     // Static 0, 30 & 60 FPS lines
     vs.emplace_back(0.f, 0.f);
-    vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), 0.f);
+    vs.emplace_back(historyLength, 0.f);
 
     vs.emplace_back(0.f, 1.f / 30.f);
-    vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), 1.f / 30.f);
+    vs.emplace_back(historyLength, 1.f / 30.f);
 
     vs.emplace_back(0.f, 1.f / 60.f);
-    vs.emplace_back(static_cast<float>(Engine::Statistics::HistoryLength), 1.f / 60.f);
+    vs.emplace_back(historyLength, 1.f / 60.f);
 
     // Setup shaders
     _shader = ShaderProgram("General Statistics Shader");
@@ -95,6 +165,31 @@ StatisticsRenderer::StatisticsRenderer(const Engine::Statistics& statistics)
     _shader.bind();
     _mvpLoc = glGetUniformLocation(_shader.id(), "mvp");
     _colorLoc = glGetUniformLocation(_shader.id(), "col");
+
+    _lineShader = ShaderProgram("Statistics Line Shader");
+    _lineShader.addVertexShader(LineVertShader);
+    _lineShader.addFragmentShader(StatsFragShader);
+    _lineShader.createAndLinkProgram();
+    _lineShader.bind();
+    _lineLocs.mvp = glGetUniformLocation(_lineShader.id(), "mvp");
+    _lineLocs.color = glGetUniformLocation(_lineShader.id(), "col");
+    _lineLocs.offset = glGetUniformLocation(_lineShader.id(), "offset");
+    _lineLocs.newest = glGetUniformLocation(_lineShader.id(), "newest");
+    _lineLocs.size = glGetUniformLocation(_lineShader.id(), "size");
+    glUniform1i(glGetUniformLocation(_lineShader.id(), "values"), 0);
+    glUniform1i(glGetUniformLocation(_lineShader.id(), "len"), length);
+
+    _histogramShader = ShaderProgram("Statistics Histogram Shader");
+    _histogramShader.addVertexShader(HistogramVertShader);
+    _histogramShader.addFragmentShader(StatsFragShader);
+    _histogramShader.createAndLinkProgram();
+    _histogramShader.bind();
+    _histogramLocs.mvp = glGetUniformLocation(_histogramShader.id(), "mvp");
+    _histogramLocs.color = glGetUniformLocation(_histogramShader.id(), "col");
+    _histogramLocs.offset = glGetUniformLocation(_histogramShader.id(), "offset");
+    _histogramLocs.maxBin = glGetUniformLocation(_histogramShader.id(), "maxBin");
+    glUniform1i(glGetUniformLocation(_histogramShader.id(), "values"), 0);
+    glUniform1i(glGetUniformLocation(_histogramShader.id(), "bins"), Histogram::Bins);
     ShaderProgram::unbind();
 
     // OpenGL objects for lines
@@ -106,13 +201,6 @@ StatisticsRenderer::StatisticsRenderer(const Engine::Statistics& statistics)
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-    glGenVertexArrays(1, &_lines.dynamicDraw.vao);
-    glGenBuffers(1, &_lines.dynamicDraw.vbo);
-    glBindVertexArray(_lines.dynamicDraw.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _lines.dynamicDraw.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Engine::Statistics), nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
     glBindVertexArray(0);
 
     // OpenGL objects for histogram
@@ -120,151 +208,170 @@ StatisticsRenderer::StatisticsRenderer(const Engine::Statistics& statistics)
     glGenBuffers(1, &_histogram.staticDraw.vbo);
     glBindVertexArray(_histogram.staticDraw.vao);
     glBindBuffer(GL_ARRAY_BUFFER, _histogram.staticDraw.vbo);
-    constexpr std::array<float, 8> HistogramAxisVertices = {
-        0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f
+    constexpr std::array<float, 16> HistogramVertices = {
+        0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f,
+        0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 1.f
     };
     glBufferData(
         GL_ARRAY_BUFFER,
-        sizeof(HistogramAxisVertices),
-        HistogramAxisVertices.data(),
+        sizeof(HistogramVertices),
+        HistogramVertices.data(),
         GL_STATIC_DRAW
     );
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-    glGenVertexArrays(1, &_histogram.dynamicDraw.vao);
-    glGenBuffers(1, &_histogram.dynamicDraw.vbo);
-    glBindVertexArray(_histogram.dynamicDraw.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _histogram.dynamicDraw.vbo);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        sizeof(Histogram::Vertices),
-        nullptr,
-        GL_DYNAMIC_DRAW
-    );
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glGenVertexArrays(1, &_emptyVao);
     glBindVertexArray(0);
+
+    // Buffer texture with the values and histogram bins of all statistics
+    _statisticsState[0] = { &_statistics.frametimes, HistogramScaleFrame };
+    _statisticsState[1] = { &_statistics.drawTimes, HistogramScaleFrame };
+    _statisticsState[2] = { &_statistics.syncTimes, HistogramScaleSync };
+    _statisticsState[3] = { &_statistics.loopTimeMin, HistogramScaleSync };
+    _statisticsState[4] = { &_statistics.loopTimeMax, HistogramScaleSync };
+    _values.resize(NStatistics * static_cast<size_t>(length), 0.f);
+
+    const size_t bufferSize = (_values.size() + _binValues.size()) * sizeof(float);
+    glGenBuffers(1, &_valueBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, _valueBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, bufferSize, nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(
+        GL_TEXTURE_BUFFER,
+        0,
+        _values.size() * sizeof(float),
+        _values.data()
+    );
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &_valueTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, _valueTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, _valueBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
 }
 
 StatisticsRenderer::~StatisticsRenderer() {
     ZoneScoped;
 
     _shader.deleteProgram();
+    _lineShader.deleteProgram();
+    _histogramShader.deleteProgram();
 
     glDeleteVertexArrays(1, &_lines.staticDraw.vao);
     glDeleteBuffers(1, &_lines.staticDraw.vbo);
-    glDeleteVertexArrays(1, &_lines.dynamicDraw.vao);
-    glDeleteBuffers(1, &_lines.dynamicDraw.vbo);
 
     glDeleteVertexArrays(1, &_histogram.staticDraw.vao);
     glDeleteBuffers(1, &_histogram.staticDraw.vbo);
-    glDeleteVertexArrays(1, &_histogram.dynamicDraw.vao);
-    glDeleteBuffers(1, &_histogram.dynamicDraw.vbo);
+
+    glDeleteVertexArrays(1, &_emptyVao);
+    glDeleteTextures(1, &_valueTexture);
+    glDeleteBuffers(1, &_valueBuffer);
 }
 
 void StatisticsRenderer::update() {
     ZoneScoped;
 
-    // Lines rendering
-    // The statistics are stored as 1D double arrays, but we need 2D float arrays
-    for (size_t i = 0; i < Engine::Statistics::HistoryLength; i++) {
-        _lines.buffer.frametimes[i].x = static_cast<float>(i);
-        _lines.buffer.frametimes[i].y = static_cast<float>(_statistics.frametimes[i]);
-    }
-    for (size_t i = 0; i < Engine::Statistics::HistoryLength; i++) {
-        _lines.buffer.drawTimes[i].x = static_cast<float>(i);
-        _lines.buffer.drawTimes[i].y = static_cast<float>(_statistics.drawTimes[i]);
-    }
-    for (size_t i = 0; i < Engine::Statistics::HistoryLength; i++) {
-        _lines.buffer.syncTimes[i].x = static_cast<float>(i);
-        _lines.buffer.syncTimes[i].y = static_cast<float>(_statistics.syncTimes[i]);
-    }
-    for (size_t i = 0; i < Engine::Statistics::HistoryLength; i++) {
-        _lines.buffer.loopTimeMin[i].x = static_cast<float>(i);
-        _lines.buffer.loopTimeMin[i].y = static_cast<float>(_statistics.loopTimeMin[i]);
-    }
-    for (size_t i = 0; i < Engine::Statistics::HistoryLength; i++) {
-        _lines.buffer.loopTimeMax[i].x = static_cast<float>(i);
-        _lines.buffer.loopTimeMax[i].y = static_cast<float>(_statistics.loopTimeMax[i]);
-    }
-
-    glBindBuffer(GL_ARRAY_BUFFER, _lines.dynamicDraw.vbo);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        sizeof(Lines::Vertices),
-        &_lines.buffer.frametimes,
-        GL_DYNAMIC_DRAW
-    );
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-
-    // Histogram update
-    auto updateHist = [](std::array<int, Histogram::Bins>& hValues,
-                         const std::array<double, Histogram::Bins>& sValues, double scale)
-    {
-        std::fill(hValues.begin(), hValues.end(), 0);
-
-        for (const double d : sValues) {
-            // convert from d into [0, 1];  0 for d=0  and 1 for d=MaxHistogramValue
-            const double dp = d / scale;
-            const int dpScaled = static_cast<int>(dp * Histogram::Bins);
-            const int bin = std::clamp(dpScaled, 0, Histogram::Bins - 1);
-            hValues[bin] += 1;
+    const uint64_t length = static_cast<uint64_t>(_statistics.frametimes.length());
+    glBindBuffer(GL_TEXTURE_BUFFER, _valueBuffer);
+    for (size_t i = 0; i < _statisticsState.size(); i++) {
+        Statistic& stat = _statisticsState[i];
+        const uint64_t count = stat.history->count();
+        if (count == stat.count) {
+            continue;
         }
 
-        return *std::max_element(hValues.cbegin(), hValues.cend());
-    };
-    auto& h = _histogram;
-    h.maxBinValue.frametimes =
-        updateHist(h.values.frametimes, _statistics.frametimes, HistogramScaleFrame);
-    h.maxBinValue.drawTimes =
-        updateHist(h.values.drawTimes, _statistics.drawTimes, HistogramScaleFrame);
-    h.maxBinValue.syncTimes =
-        updateHist(h.values.syncTimes, _statistics.syncTimes, HistogramScaleSync);
-    h.maxBinValue.loopTimeMin =
-        updateHist(h.values.loopTimeMin, _statistics.loopTimeMin, HistogramScaleSync);
-    h.maxBinValue.loopTimeMax =
-        updateHist(h.values.loopTimeMax, _statistics.loopTimeMax, HistogramScaleSync);
-
-
-    auto convertValues = [&](std::array<Vertex, 6 * Histogram::Bins>& buffer,
-                            const std::array<int, Histogram::Bins>& values, int maxBinVal)
-    {
-        for (size_t i = 0; i < static_cast<size_t>(Histogram::Bins); i++) {
-            const int val = values[i];
-
-            const float x0 = static_cast<float>(i) / Histogram::Bins;
-            const float x1 = static_cast<float>(i + 1) / Histogram::Bins;
-            const float y0 = 0.f;
-            const float y1 = static_cast<float>(val) / maxBinVal;
-
-            const size_t idx = i * 6;
-            buffer[idx + 0] = { x0, y0 };
-            buffer[idx + 1] = { x1, y1 };
-            buffer[idx + 2] = { x0, y1 };
-
-            buffer[idx + 3] = { x0, y0 };
-            buffer[idx + 4] = { x1, y0 };
-            buffer[idx + 5] = { x1, y1 };
+        // If more values were added than fit into the history, for example before the
+        // statistics were shown, the values that are still kept are all transferred
+        const bool isReset = count - stat.count >= length;
+        if (isReset) {
+            stat.bins.fill(0);
+            stat.count = count - std::min(count, length);
         }
-    };
 
-    convertValues(h.buffer.frametimes, h.values.frametimes, h.maxBinValue.frametimes);
-    convertValues(h.buffer.drawTimes, h.values.drawTimes, h.maxBinValue.drawTimes);
-    convertValues(h.buffer.syncTimes, h.values.syncTimes, h.maxBinValue.syncTimes);
-    convertValues(h.buffer.loopTimeMin, h.values.loopTimeMin, h.maxBinValue.loopTimeMin);
-    convertValues(h.buffer.loopTimeMax, h.values.loopTimeMax, h.maxBinValue.loopTimeMax);
+        float* values = _values.data() + i * length;
+        const uint64_t first = stat.count;
+        for (uint64_t c = first; c < count; c++) {
+            float& slot = values[c % length];
+            if (!isReset && c >= length) {
+                // The value that is replaced leaves the histogram
+                stat.bins[histogramBin(slot, stat.histogramScale, Histogram::Bins)]--;
+            }
+            // The renderer is updated on the thread that adds the values, so they can be
+            // read one at a time
+            slot = static_cast<float>((*stat.history)[static_cast<int>(count - 1 - c)]);
+            stat.bins[histogramBin(slot, stat.histogramScale, Histogram::Bins)]++;
+        }
+        stat.count = count;
+        stat.maxBin = std::max(*std::max_element(stat.bins.begin(), stat.bins.end()), 1);
+
+        // The new values are at most two ranges, as they might wrap around the end of
+        // the ring buffer
+        const uint64_t begin = first % length;
+        const uint64_t n = count - first;
+        const uint64_t nFirst = std::min(n, length - begin);
+        glBufferSubData(
+            GL_TEXTURE_BUFFER,
+            (i * length + begin) * sizeof(float),
+            nFirst * sizeof(float),
+            values + begin
+        );
+        if (nFirst < n) {
+            glBufferSubData(
+                GL_TEXTURE_BUFFER,
+                i * length * sizeof(float),
+                (n - nFirst) * sizeof(float),
+                values
+            );
+        }
 
+        std::transform(
+            stat.bins.begin(),
+            stat.bins.end(),
+            _binValues.begin() + i * Histogram::Bins,
+            [](int bin) { return static_cast<float>(bin); }
+        );
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, _histogram.dynamicDraw.vbo);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        sizeof(Histogram::Vertices),
-        _histogram.buffer.frametimes.data(),
-        GL_DYNAMIC_DRAW
+    // The bins of all histograms are small enough to always be uploaded together
+    glBufferSubData(
+        GL_TEXTURE_BUFFER,
+        _values.size() * sizeof(float),
+        _binValues.size() * sizeof(float),
+        _binValues.data()
     );
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    _nodes.resize(_statistics.nodes.size());
+    std::vector<float> drawTimes;
+    std::vector<float> gpuTimes;
+    for (const std::optional<Network::NodeStatistics>& node : _statistics.nodes) {
+        if (node) {
+            drawTimes.push_back(node->drawTime);
+            gpuTimes.push_back(node->gpuTime);
+        }
+    }
+    const float drawMedian = median(drawTimes);
+    const float gpuMedian = median(gpuTimes);
+    for (size_t i = 0; i < _nodes.size(); i++) {
+        Node& node = _nodes[i];
+        const std::optional<Network::NodeStatistics>& stats = _statistics.nodes[i];
+        if (!stats) {
+            node = Node();
+            continue;
+        }
+
+        node.isSlow = stats->drawTime > drawMedian * OutlierFactor + OutlierMargin ||
+                      stats->gpuTime > gpuMedian * OutlierFactor + OutlierMargin;
+        const bool hasDropped =
+            node.statistics && stats->droppedFrames != node.statistics->droppedFrames;
+        if (hasDropped) {
+            node.updatesSinceDrop = 0;
+        }
+        else if (node.updatesSinceDrop < std::numeric_limits<uint64_t>::max()) {
+            node.updatesSinceDrop++;
+        }
+        node.statistics = stats;
+    }
 }
 
 void StatisticsRenderer::render(const Window& window, const Viewport& viewport) const {
@@ -311,7 +418,7 @@ void StatisticsRenderer::render(const Window& window, const Viewport& viewport)
         _shader.bind();
 
         const glm::vec2 size = glm::vec2(
-            res.x / static_cast<float>(Engine::Statistics::HistoryLength),
+            res.x / static_cast<float>(_statistics.frametimes.length()),
             res.y * 15.f
         );
 
@@ -335,28 +442,32 @@ void StatisticsRenderer::render(const Window& window, const Viewport& viewport)
         glUniform4fv(_colorLoc, 1, &ColorStaticFrequency.x);
         glDrawArrays(GL_LINES, 4 + _lines.staticDraw.nLines * 2, 6);
 
-        glBindVertexArray(_lines.dynamicDraw.vao);
-
-        // frametime
-        constexpr int StatsLength = Engine::Statistics::HistoryLength;
-        glUniform4fv(_colorLoc, 1, &ColorFrameTime.x);
-        glDrawArrays(GL_LINE_STRIP, 0 * StatsLength, StatsLength);
-
-        // drawtime
-        glUniform4fv(_colorLoc, 1, &ColorDrawTime.x);
-        glDrawArrays(GL_LINE_STRIP, 1 * StatsLength, StatsLength);
-
-        // synctime
-        glUniform4fv(_colorLoc, 1, &ColorSyncTime.x);
-        glDrawArrays(GL_LINE_STRIP, 2 * StatsLength, StatsLength);
-
-        // looptimemin
-        glUniform4fv(_colorLoc, 1, &ColorLoopTimeMin.x);
-        glDrawArrays(GL_LINE_STRIP, 3 * StatsLength, StatsLength);
-
-        // looptimemax
-        glUniform4fv(_colorLoc, 1, &ColorLoopTimeMax.x);
-        glDrawArrays(GL_LINE_STRIP, 4 * StatsLength, StatsLength);
+        glBindVertexArray(_emptyVao);
+        _lineShader.bind();
+        glUniformMatrix4fv(_lineLocs.mvp, 1, GL_FALSE, glm::value_ptr(m));
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_BUFFER, _valueTexture);
+
+        auto renderLine = [&](int i, const vec4& color) {
+            const Statistic& stat = _statisticsState[i];
+            const int length = _statistics.frametimes.length();
+            glUniform4fv(_lineLocs.color, 1, &color.x);
+            glUniform1i(_lineLocs.offset, i * length);
+            glUniform1i(
+                _lineLocs.newest,
+                static_cast<int>((stat.count + length - 1) % length)
+            );
+            glUniform1i(
+                _lineLocs.size,
+                static_cast<int>(std::min<uint64_t>(stat.count, length))
+            );
+            glDrawArrays(GL_LINE_STRIP, 0, length);
+        };
+        renderLine(0, ColorFrameTime);
+        renderLine(1, ColorDrawTime);
+        renderLine(2, ColorSyncTime);
+        renderLine(3, ColorLoopTimeMin);
+        renderLine(4, ColorLoopTimeMax);
 
         glBindVertexArray(0);
         ShaderProgram::unbind();
@@ -461,23 +572,36 @@ void StatisticsRenderer::render(const Window& window, const Viewport& viewport)
 
             glm::mat4 m = glm::translate(orthoMat, glm::vec3(pos.x, pos.y, 0.f));
             m = glm::scale(m, glm::vec3(size.x, size.y, 1.f));
+            _shader.bind();
             glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(m));
             glUniform4fv(_colorLoc, 1, glm::value_ptr(glm::vec4(1.f)));
 
             glBindVertexArray(_histogram.staticDraw.vao);
             glDrawArrays(GL_LINES, 0, 4);
 
-            glBindVertexArray(_histogram.dynamicDraw.vao);
-            glUniform4fv(_colorLoc, 1, &color.x);
-            glDrawArrays(GL_TRIANGLES, i * 6 * Histogram::Bins, 6 * Histogram::Bins);
+            const int binOffset =
+                NStatistics * _statistics.frametimes.length() + i * Histogram::Bins;
+            _histogramShader.bind();
+            glUniformMatrix4fv(_histogramLocs.mvp, 1, GL_FALSE, glm::value_ptr(m));
+            glUniform4fv(_histogramLocs.color, 1, &color.x);
+            glUniform1i(_histogramLocs.offset, binOffset);
+            glUniform1f(
+                _histogramLocs.maxBin,
+                static_cast<float>(_statisticsState[i].maxBin)
+            );
+            glBindVertexArray(_emptyVao);
+            glDrawArrays(GL_TRIANGLES, 0, 6 * Histogram::Bins);
         };
 
-        _shader.bind();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_BUFFER, _valueTexture);
         renderHistogram(0, ColorFrameTime);
         renderHistogram(1, ColorDrawTime);
         renderHistogram(2, ColorSyncTime);
         renderHistogram(3, ColorLoopTimeMin);
         renderHistogram(4, ColorLoopTimeMax);
+        glBindVertexArray(0);
+        ShaderProgram::unbind();
 
 #ifdef SGCT_HAS_TEXT
         constexpr text::Alignment mode = text::Alignment::TopLeft;
@@ -510,6 +634,158 @@ void StatisticsRenderer::render(const Window& window, const Viewport& viewport)
         );
 #endif // SGCT_HAS_TEXT
     }
+
+    if (!_nodes.empty()) {
+        //
+        // Render Nodes
+        //
+
+        ZoneScopedN("Nodes");
+
+        // One row per client to the right of the histograms, with a bar for the longer of
+        // its draw and GPU times that is full at 30 FPS
+        const glm::vec2 pos = glm::vec2(
+            1080.f * _scale + _offset.x * res.x,
+            10.f * _scale + _offset.y * res.y
+        );
+        const float rowHeight = 10.f * _scale;
+        const float barWidth = 150.f * _scale;
+        const int length = _statistics.frametimes.length();
+        auto rowPosition = [&](size_t i) {
+            const float row = static_cast<float>(_nodes.size() - 1 - i);
+            return glm::vec2(pos.x, pos.y + row * rowHeight);
+        };
+        auto isOutlier = [length](const Node& node) {
+            return node.isSlow || node.updatesSinceDrop < static_cast<uint64_t>(length);
+        };
+
+        _shader.bind();
+        glBindVertexArray(_histogram.staticDraw.vao);
+        for (size_t i = 0; i < _nodes.size(); i++) {
+            const Node& node = _nodes[i];
+            if (!node.statistics) {
+                continue;
+            }
+
+            const Network::NodeStatistics& stats = *node.statistics;
+            const float time = std::max(stats.drawTime, stats.gpuTime);
+            const float width = std::min(time * 30.f, 1.f) * barWidth;
+            const glm::vec2 p = rowPosition(i);
+            glm::mat4 m = glm::translate(orthoMat, glm::vec3(p.x, p.y, 0.f));
+            m = glm::scale(m, glm::vec3(std::max(width, 1.f), 0.8f * rowHeight, 1.f));
+            glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(m));
+            const vec4& color = isOutlier(node) ? ColorNodeOutlier : ColorDrawTime;
+            glUniform4fv(_colorLoc, 1, &color.x);
+            glDrawArrays(GL_TRIANGLE_STRIP, 4, 4);
+        }
+        glBindVertexArray(0);
+        ShaderProgram::unbind();
+
+#ifdef SGCT_HAS_TEXT
+        constexpr text::Alignment mode = text::Alignment::TopLeft;
+
+        const int fontSize = static_cast<int>(8 * _scale);
+        text::Font& f = *text::FontManager::instance().font("SGCTFont", fontSize);
+        for (size_t i = 0; i < _nodes.size(); i++) {
+            const Node& node = _nodes[i];
+            // The text is placed in window coordinates, which the scaling of the
+            // orthographic matrix above does not apply to
+            const glm::vec2 p = rowPosition(i) + glm::vec2(barWidth + 10.f * _scale, 0.f);
+            const glm::vec2 pen = p * _scale + scaleOffset * (1.f - _scale);
+            if (!node.statistics) {
+                text::print(
+                    window,
+                    viewport,
+                    f,
+                    mode,
+                    pen.x, pen.y,
+                    ColorNode,
+                    std::format("IG {}: No statistics", i)
+                );
+                continue;
+            }
+
+            const Network::NodeStatistics& stats = *node.statistics;
+            const std::string missedSwaps = stats.swapGroupFrame > 0 ?
+                std::format("  Missed swaps {}", stats.missedSwaps) :
+                "";
+            text::print(
+                window,
+                viewport,
+                f,
+                mode,
+                pen.x, pen.y,
+                isOutlier(node) ? ColorNodeOutlier : ColorNode,
+                std::format(
+                    "IG {}: Frame {:.2f} ms  Draw {:.2f} ms  Sync {:.2f} ms  "
+                    "GPU {:.2f} ms  Dropped {}{}",
+                    i, stats.frameTime * 1000.f, stats.drawTime * 1000.f,
+                    stats.syncWait * 1000.f, stats.gpuTime * 1000.f, stats.droppedFrames,
+                    missedSwaps
+                )
+            );
+        }
+#endif // SGCT_HAS_TEXT
+    }
+
+#ifdef SGCT_HAS_TEXT
+    {
+        //
+        // Render Callbacks
+        //
+
+        ZoneScopedN("Callbacks");
+
+        // The CPU times of the application's callbacks in the same column as the nodes
+        // and above them, with one row for each window's viewports
+        const glm::vec2 pos = glm::vec2(
+            1080.f * _scale + _offset.x * res.x,
+            10.f * _scale + _offset.y * res.y
+        );
+        const float rowHeight = 10.f * _scale;
+        const int fontSize = static_cast<int>(8 * _scale);
+        text::Font& f = *text::FontManager::instance().font("SGCTFont", fontSize);
+        float row = static_cast<float>(_nodes.size()) + 1.f;
+        auto print = [&](const std::string& line) {
+            const glm::vec2 p = glm::vec2(pos.x, pos.y + row * rowHeight);
+            const glm::vec2 pen = p * _scale + scaleOffset * (1.f - _scale);
+            text::print(
+                window,
+                viewport,
+                f,
+                text::Alignment::TopLeft,
+                pen.x, pen.y,
+                ColorNode,
+                line
+            );
+            row += 1.f;
+        };
+
+        const std::vector<std::vector<double>>& vps = _statistics.viewportDrawTimes;
+        for (size_t i = vps.size(); i > 0; i--) {
+            std::string line = std::format("Window {}:", i - 1);
+            for (size_t j = 0; j < vps[i - 1].size(); j++) {
+                line += std::format("  Viewport {} {:.2f} ms", j, vps[i - 1][j] * 1000.0);
+            }
+            print(line);
+        }
+        print(std::format(
+            "Draw {:.2f} ms  Draw 2D {:.2f} ms  Post draw {:.2f} ms",
+            _statistics.drawCallbackTimes[0] * 1000.0,
+            _statistics.draw2DTimes[0] * 1000.0,
+            _statistics.postDrawTimes[0] * 1000.0
+        ));
+        print(std::format(
+            "Pre sync {:.2f} ms  Encode {:.2f} ms  Decode {:.2f} ms  "
+            "Post sync pre draw {:.2f} ms",
+            _statistics.preSyncTimes[0] * 1000.0,
+            _statistics.encodeTimes[0] * 1000.0,
+            _statistics.decodeTimes[0] * 1000.0,
+            _statistics.postSyncPreDrawTimes[0] * 1000.0
+        ));
+        print("Application callbacks (CPU):");
+    }
+#endif // SGCT_HAS_TEXT
 }
 
 float StatisticsRenderer::scale() const {
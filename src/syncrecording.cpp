@@ -0,0 +1,306 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/syncrecording.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <sgct/correction/mappedfile.h>
+#include <algorithm>
+#include <cstring>
+
+#define Err(code, msg) Error(Error::Component::Engine, code, msg)
+
+namespace {
+    constexpr uint32_t Magic = 0x52534753; // "SGSR"
+    constexpr uint32_t Version = 1;
+
+    // The header is followed by the frames, each of which is a FrameHeader followed by
+    // the data of the frame, which is padded to a multiple of 8 bytes
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        // The number of complete frames and the bytes that they use after the header,
+        // which are only updated once a frame has been written
+        uint64_t nFrames;
+        uint64_t size;
+    };
+    static_assert(sizeof(FileHeader) == 24);
+
+    struct FrameHeader {
+        uint64_t frameNumber;
+        double time;
+        uint64_t size;
+    };
+    static_assert(sizeof(FrameHeader) == 24);
+
+    constexpr size_t InitialCapacity = 64 * 1024 * 1024;
+
+    size_t padded(size_t size) {
+        return (size + 7) & ~size_t(7);
+    }
+} // namespace
+
+namespace sgct {
+
+std::unique_ptr<SyncRecorder> SyncRecorder::create(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    std::unique_ptr<SyncRecorder> res = std::unique_ptr<SyncRecorder>(new SyncRecorder);
+    res->_path = path;
+
+#ifdef WIN32
+    res->_file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (res->_file == INVALID_HANDLE_VALUE) {
+        res->_file = nullptr;
+    }
+    const bool isOpen = res->_file != nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    res->_file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    const bool isOpen = res->_file != -1;
+#endif // WIN32
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports formatting
+    //        std::filesystem::path
+    if (!isOpen || !res->map(InitialCapacity)) {
+        Log::Error(
+            std::format("Could not create the sync recording '{}'", path.string())
+        );
+        return nullptr;
+    }
+
+    const FileHeader header = {
+        .magic = Magic,
+        .version = Version,
+        .nFrames = 0,
+        .size = 0
+    };
+    std::memcpy(res->_memory, &header, sizeof(FileHeader));
+    res->_size = sizeof(FileHeader);
+
+    Log::Info(std::format("Recording the shared data into '{}'", path.string()));
+    return res;
+}
+
+SyncRecorder::~SyncRecorder() {
+    unmap();
+
+    // The file is cut to the recorded frames, so that the capacity is not left on disk
+#ifdef WIN32
+    if (_file) {
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(_size);
+        SetFilePointerEx(_file, size, nullptr, FILE_BEGIN);
+        SetEndOfFile(_file);
+        CloseHandle(_file);
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (_file != -1) {
+        if (ftruncate(_file, static_cast<off_t>(_size)) == -1) {
+            Log::Warning("Could not truncate the sync recording");
+        }
+        close(_file);
+    }
+#endif // WIN32
+
+    Log::Info(std::format("Recorded {} frames into '{}'", _nFrames, _path.string()));
+}
+
+bool SyncRecorder::map(size_t capacity) {
+#ifdef WIN32
+    _mapping = CreateFileMappingW(
+        _file,
+        nullptr,
+        PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(capacity) >> 32),
+        static_cast<DWORD>(capacity & 0xFFFFFFFF),
+        nullptr
+    );
+    if (!_mapping) {
+        return false;
+    }
+    _memory = reinterpret_cast<std::byte*>(
+        MapViewOfFile(_mapping, FILE_MAP_WRITE, 0, 0, capacity)
+    );
+    if (!_memory) {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+        return false;
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (ftruncate(_file, static_cast<off_t>(capacity)) == -1) {
+        return false;
+    }
+    void* m = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0);
+    if (m == MAP_FAILED) {
+        return false;
+    }
+    _memory = reinterpret_cast<std::byte*>(m);
+#endif // WIN32
+    _capacity = capacity;
+    return true;
+}
+
+void SyncRecorder::unmap() {
+#ifdef WIN32
+    if (_memory) {
+        UnmapViewOfFile(_memory);
+    }
+    if (_mapping) {
+        CloseHandle(_mapping);
+    }
+    _mapping = nullptr;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (_memory) {
+        munmap(_memory, _capacity);
+    }
+#endif // WIN32
+    _memory = nullptr;
+}
+
+void SyncRecorder::addFrame(uint64_t frameNumber, double time,
+                            std::span<const std::byte> data)
+{
+    ZoneScoped;
+
+    if (_isFailed) {
+        return;
+    }
+
+    const size_t frameSize = sizeof(FrameHeader) + padded(data.size());
+    if (_size + frameSize > _capacity) {
+        // The mapping is replaced by a larger one, which keeps the recorded frames in
+        // the file
+        size_t capacity = _capacity;
+        while (_size + frameSize > capacity) {
+            capacity *= 2;
+        }
+        unmap();
+        if (!map(capacity)) {
+            Log::Error(std::format(
+                "Could not grow the sync recording '{}' to {} bytes, dropping all "
+                "following frames", _path.string(), capacity
+            ));
+            _isFailed = true;
+            return;
+        }
+    }
+
+    const FrameHeader frame = {
+        .frameNumber = frameNumber,
+        .time = time,
+        .size = data.size()
+    };
+    std::memcpy(_memory + _size, &frame, sizeof(FrameHeader));
+    std::memcpy(_memory + _size + sizeof(FrameHeader), data.data(), data.size());
+    _size += frameSize;
+
+    // The header only counts the frame once it is complete
+    FileHeader* header = reinterpret_cast<FileHeader*>(_memory);
+    _nFrames++;
+    header->nFrames = _nFrames;
+    header->size = _size - sizeof(FileHeader);
+}
+
+uint64_t SyncRecorder::nFrames() const {
+    return _nFrames;
+}
+
+SyncReplay::SyncReplay(const std::filesystem::path& path)
+    : _file(correction::MappedFile::map(path))
+{
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports formatting
+    //        std::filesystem::path
+    if (!_file) {
+        throw Err(
+            3017,
+            std::format("Could not open the sync recording '{}'", path.string())
+        );
+    }
+
+    const std::span<const std::byte> data = _file->data();
+    FileHeader header;
+    if (data.size() >= sizeof(FileHeader)) {
+        std::memcpy(&header, data.data(), sizeof(FileHeader));
+    }
+    if (data.size() < sizeof(FileHeader) || header.magic != Magic ||
+        header.version != Version || header.size > data.size() - sizeof(FileHeader))
+    {
+        throw Err(
+            3017,
+            std::format("'{}' is not a sync recording of this version", path.string())
+        );
+    }
+    _nFrames = header.nFrames;
+    _offset = sizeof(FileHeader);
+
+    Log::Info(std::format(
+        "Replaying {} frames of shared data from '{}'", _nFrames, path.string()
+    ));
+}
+
+SyncReplay::~SyncReplay() = default;
+
+std::optional<SyncReplay::Frame> SyncReplay::nextFrame() {
+    if (_nextFrame == _nFrames) {
+        return std::nullopt;
+    }
+
+    const std::span<const std::byte> data = _file->data();
+    FrameHeader header;
+    if (data.size() - _offset >= sizeof(FrameHeader)) {
+        std::memcpy(&header, data.data() + _offset, sizeof(FrameHeader));
+    }
+    if (data.size() - _offset < sizeof(FrameHeader) ||
+        header.size > data.size() - _offset - sizeof(FrameHeader))
+    {
+        throw Err(
+            3018,
+            std::format("Frame {} of the sync recording is malformed", _nextFrame)
+        );
+    }
+
+    Frame res = {
+        .frameNumber = header.frameNumber,
+        .time = header.time,
+        .data = data.subspan(_offset + sizeof(FrameHeader), header.size)
+    };
+    _offset = std::min(
+        _offset + sizeof(FrameHeader) + padded(header.size),
+        data.size()
+    );
+    _nextFrame++;
+    return res;
+}
+
+uint64_t SyncReplay::nFrames() const {
+    return _nFrames;
+}
+
+} // namespace sgct
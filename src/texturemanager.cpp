@@ -8,63 +8,51 @@
 
 #include <sgct/texturemanager.h>
 
+#include <sgct/compressedimage.h>
+#include <sgct/engine.h>
 #include <sgct/format.h>
 #include <sgct/image.h>
+#include <sgct/jobsystem.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
+#include <sgct/profiling.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
 
 namespace {
-    unsigned int uploadImage(const sgct::Image& img, bool interpolate, int mipmap,
-                             float anisotropicFilterSize)
-    {
-        unsigned int tex = 0;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-
-        const auto [type, internalFormat] = [](int c) -> std::pair<GLenum, GLenum> {
-            switch (c) {
-                case 1: return { GL_RED, GL_R8 };
-                case 2: return { GL_RG, GL_RG8 };
-                case 3: return { GL_BGR, GL_RGB8 };
-                case 4: return { GL_BGRA, GL_RGBA8 };
-                default: throw std::logic_error("Unhandled case label");
-            }
-        }(img.channels());
+    // The number of bytes that are uploaded at most in one step of an asynchronous
+    // upload, unless a single row of the image is larger
+    constexpr size_t BandSize = 4 << 20;
 
-        sgct::Log::Debug(std::format(
-            "Creating texture. Size: {}x{}, {}-channels, Type: {:#04x}, Format: {:#04x}",
-            img.size().x, img.size().y, img.channels(), type, internalFormat
-        ));
-
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    std::pair<GLenum, GLenum> textureFormat(int channels) {
+        switch (channels) {
+            case 1: return { GL_RED, GL_R8 };
+            case 2: return { GL_RG, GL_RG8 };
+            case 3: return { GL_BGR, GL_RGB8 };
+            case 4: return { GL_BGRA, GL_RGBA8 };
+            default: throw std::logic_error("Unhandled case label");
+        }
+    }
 
-        constexpr GLenum Format = GL_UNSIGNED_BYTE;
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            internalFormat,
-            img.size().x,
-            img.size().y,
-            0,
-            type,
-            Format,
-            img.data()
-        );
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipmap - 1);
+    void setTextureParameters(GLenum target, bool interpolate, int mipmap,
+                              float anisotropicFilterSize)
+    {
+        glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, mipmap - 1);
 
         if (mipmap > 1) {
-            glGenerateMipmap(GL_TEXTURE_2D);
-
             glTexParameteri(
-                GL_TEXTURE_2D,
+                target,
                 GL_TEXTURE_MIN_FILTER,
                 interpolate ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR
             );
             glTexParameteri(
-                GL_TEXTURE_2D,
+                target,
                 GL_TEXTURE_MAG_FILTER,
                 interpolate ? GL_LINEAR : GL_NEAREST
             );
@@ -72,13 +60,13 @@ namespace {
             // GL_TEXTURE_MAX_ANISOTROPY is no longer an extension, but a core feature in OpenGL 4.0
             #ifdef GL_TEXTURE_MAX_ANISOTROPY
                 glTexParameterf(
-                    GL_TEXTURE_2D,
+                    target,
                     GL_TEXTURE_MAX_ANISOTROPY,
                     anisotropicFilterSize
                 );
             #else
                 glTexParameterf(
-                    GL_TEXTURE_2D,
+                    target,
                     GL_TEXTURE_MAX_ANISOTROPY_EXT,
                     anisotropicFilterSize
                 );
@@ -86,19 +74,85 @@ namespace {
         }
         else {
             glTexParameteri(
-                GL_TEXTURE_2D,
+                target,
                 GL_TEXTURE_MIN_FILTER,
                 interpolate ? GL_LINEAR : GL_NEAREST
             );
             glTexParameteri(
-                GL_TEXTURE_2D,
+                target,
                 GL_TEXTURE_MAG_FILTER,
                 interpolate ? GL_LINEAR : GL_NEAREST
             );
         }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    // The number of mipmap levels down to a size of 1x1 pixels for a texture of \p size
+    int maxMipmapLevels(sgct::ivec2 size) {
+        return std::bit_width(static_cast<unsigned int>(std::max(size.x, size.y)));
+    }
+
+    // Creates the texture for the image and uploads the \p data, if it is provided. The
+    // mipmaps are not generated, which is left to the caller
+    unsigned int createTexture(const sgct::Image& img, const unsigned char* data,
+                               bool interpolate, int mipmap, float anisotropicFilterSize)
+    {
+        unsigned int tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+
+        const auto [type, internalFormat] = textureFormat(img.channels());
+        const int nLevels = std::clamp(mipmap, 1, maxMipmapLevels(img.size()));
+
+        sgct::Log::Debug(std::format(
+            "Creating texture. Size: {}x{}, {}-channels, Type: {:#04x}, Format: {:#04x}",
+            img.size().x, img.size().y, img.channels(), type, internalFormat
+        ));
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        constexpr GLenum Format = GL_UNSIGNED_BYTE;
+        if (GLAD_GL_VERSION_4_2) {
+            // Immutable storage allocates the whole mipmap chain at once, so the driver
+            // neither has to reallocate it nor check its completeness when it is used
+            glTexStorage2D(
+                GL_TEXTURE_2D,
+                nLevels,
+                internalFormat,
+                img.size().x,
+                img.size().y
+            );
+            if (data) {
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    img.size().x,
+                    img.size().y,
+                    type,
+                    Format,
+                    data
+                );
+            }
+        }
+        else {
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                internalFormat,
+                img.size().x,
+                img.size().y,
+                0,
+                type,
+                Format,
+                data
+            );
+        }
+        setTextureParameters(GL_TEXTURE_2D, interpolate, nLevels, anisotropicFilterSize);
 
         return tex;
     }
@@ -106,6 +160,30 @@ namespace {
 
 namespace sgct {
 
+struct TextureManager::AsyncState {
+    std::filesystem::path filename;
+    bool interpolate = true;
+    float anisotropicFilterSize = 1.f;
+    int mipmapLevels = 8;
+
+    // Written by the decoding job before the status changes to Uploading, and only used
+    // by the main thread afterwards
+    Image image;
+    std::atomic<AsyncTexture::Status> status = AsyncTexture::Status::Decoding;
+
+    // Only used by the main thread
+    unsigned int texture = 0;
+    int nUploadedRows = 0;
+};
+
+TextureManager::AsyncTexture::Status TextureManager::AsyncTexture::status() const {
+    return _state ? _state->status.load() : Status::Failed;
+}
+
+unsigned int TextureManager::AsyncTexture::id() const {
+    return status() == Status::Ready ? _state->texture : 0;
+}
+
 TextureManager* TextureManager::_instance = nullptr;
 
 TextureManager& TextureManager::instance() {
@@ -122,12 +200,29 @@ void TextureManager::destroy() {
 
 TextureManager::~TextureManager() {
     glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+    glDeleteBuffers(static_cast<GLsizei>(_pbos.size()), _pbos.data());
 }
 
 unsigned int TextureManager::loadTexture(const std::filesystem::path& filename,
                                          bool interpolate, float anisotropicFilterSize,
                                          int mipmapLevels)
 {
+    if (CompressedImage::isCompressedImage(filename)) {
+        const CompressedImage img = CompressedImage(filename);
+        unsigned int t = loadTexture(
+            img,
+            interpolate,
+            anisotropicFilterSize,
+            mipmapLevels
+        );
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Debug(std::format(
+            "Compressed texture created from '{}' [id={}]", filename.string(), t
+        ));
+        return t;
+    }
+
     // load image
     Image img;
     img.load(filename);
@@ -152,12 +247,357 @@ unsigned int TextureManager::loadTexture(const std::filesystem::path& filename,
 unsigned int TextureManager::loadTexture(const Image& img, bool interpolate,
                                          float anisotropicFilterSize, int mipmapLevels)
 {
-    const GLuint t = uploadImage(img, interpolate, mipmapLevels, anisotropicFilterSize);
+    const GLuint t = createTexture(
+        img,
+        img.data(),
+        interpolate,
+        mipmapLevels,
+        anisotropicFilterSize
+    );
+    if (mipmapLevels > 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     _textures.push_back(t);
 
     return t;
 }
 
+unsigned int TextureManager::loadTexture(const CompressedImage& img, bool interpolate,
+                                         float anisotropicFilterSize, int mipmapLevels)
+{
+    ZoneScoped;
+
+    const std::vector<CompressedImage::Level>& levels = img.levels();
+    const int nLevels = std::clamp(mipmapLevels, 1, static_cast<int>(levels.size()));
+
+    Log::Debug(std::format(
+        "Creating compressed texture. Size: {}x{}, Levels: {}, Format: {:#04x}",
+        img.size().x, img.size().y, nLevels, img.internalFormat()
+    ));
+
+    unsigned int tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    if (GLAD_GL_VERSION_4_2) {
+        glTexStorage2D(
+            GL_TEXTURE_2D,
+            nLevels,
+            img.internalFormat(),
+            img.size().x,
+            img.size().y
+        );
+    }
+    for (int i = 0; i < nLevels; i++) {
+        if (GLAD_GL_VERSION_4_2) {
+            glCompressedTexSubImage2D(
+                GL_TEXTURE_2D,
+                i,
+                0,
+                0,
+                levels[i].size.x,
+                levels[i].size.y,
+                img.internalFormat(),
+                static_cast<GLsizei>(levels[i].data.size()),
+                levels[i].data.data()
+            );
+        }
+        else {
+            glCompressedTexImage2D(
+                GL_TEXTURE_2D,
+                i,
+                img.internalFormat(),
+                levels[i].size.x,
+                levels[i].size.y,
+                0,
+                static_cast<GLsizei>(levels[i].data.size()),
+                levels[i].data.data()
+            );
+        }
+    }
+    setTextureParameters(GL_TEXTURE_2D, interpolate, nLevels, anisotropicFilterSize);
+    _textures.push_back(tex);
+
+    return tex;
+}
+
+std::vector<TextureManager::ArrayLayer> TextureManager::loadTextureArray(
+                                         std::span<const std::filesystem::path> filenames,
+                                                                        bool interpolate,
+                                                             float anisotropicFilterSize,
+                                                                        int mipmapLevels)
+{
+    ZoneScoped;
+
+    std::vector<Image> images = std::vector<Image>(filenames.size());
+    for (size_t i = 0; i < filenames.size(); i++) {
+        try {
+            images[i].load(filenames[i]);
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
+    }
+
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+    // Only images with the same number of channels share the format of an array texture,
+    // and each array texture holds as many of them as the driver allows
+    std::vector<std::vector<size_t>> arrays;
+    std::array<int, 4> currentArray = { -1, -1, -1, -1 };
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!images[i].data()) {
+            continue;
+        }
+        int& current = currentArray[images[i].channels() - 1];
+        if (current < 0 || arrays[current].size() >= static_cast<size_t>(maxLayers)) {
+            current = static_cast<int>(arrays.size());
+            arrays.emplace_back();
+        }
+        arrays[current].push_back(i);
+    }
+
+    std::vector<ArrayLayer> layers = std::vector<ArrayLayer>(filenames.size());
+    for (const std::vector<size_t>& group : arrays) {
+        const int channels = images[group.front()].channels();
+        ivec2 size = ivec2{ 0, 0 };
+        for (const size_t i : group) {
+            size.x = std::max(size.x, images[i].size().x);
+            size.y = std::max(size.y, images[i].size().y);
+        }
+
+        const auto [type, internalFormat] = textureFormat(channels);
+        Log::Debug(std::format(
+            "Creating array texture. Size: {}x{}x{}, {}-channels",
+            size.x, size.y, group.size(), channels
+        ));
+
+        const int nLevels = std::clamp(mipmapLevels, 1, maxMipmapLevels(size));
+
+        unsigned int tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, tex);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (GLAD_GL_VERSION_4_2) {
+            glTexStorage3D(
+                GL_TEXTURE_2D_ARRAY,
+                nLevels,
+                internalFormat,
+                size.x,
+                size.y,
+                static_cast<GLsizei>(group.size())
+            );
+        }
+        else {
+            glTexImage3D(
+                GL_TEXTURE_2D_ARRAY,
+                0,
+                internalFormat,
+                size.x,
+                size.y,
+                static_cast<GLsizei>(group.size()),
+                0,
+                type,
+                GL_UNSIGNED_BYTE,
+                nullptr
+            );
+        }
+        if (GLAD_GL_VERSION_4_4) {
+            // Smaller images leave parts of their layer empty, which would otherwise be
+            // undefined and bleed into the mipmaps
+            glClearTexImage(tex, 0, type, GL_UNSIGNED_BYTE, nullptr);
+        }
+
+        for (size_t layer = 0; layer < group.size(); layer++) {
+            const Image& img = images[group[layer]];
+            glTexSubImage3D(
+                GL_TEXTURE_2D_ARRAY,
+                0,
+                0,
+                0,
+                static_cast<GLint>(layer),
+                img.size().x,
+                img.size().y,
+                1,
+                type,
+                GL_UNSIGNED_BYTE,
+                img.data()
+            );
+
+            ArrayLayer& l = layers[group[layer]];
+            l.texture = tex;
+            l.layer = static_cast<int>(layer);
+            l.uvScale = vec2(
+                static_cast<float>(img.size().x) / static_cast<float>(size.x),
+                static_cast<float>(img.size().y) / static_cast<float>(size.y)
+            );
+        }
+
+        setTextureParameters(
+            GL_TEXTURE_2D_ARRAY,
+            interpolate,
+            nLevels,
+            anisotropicFilterSize
+        );
+        if (nLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        _textures.push_back(tex);
+    }
+    return layers;
+}
+
+TextureManager::AsyncTexture TextureManager::loadTextureAsync(
+                                                           std::filesystem::path filename,
+                                                                         bool interpolate,
+                                                              float anisotropicFilterSize,
+                                                                         int mipmapLevels)
+{
+    std::shared_ptr<AsyncState> state = std::make_shared<AsyncState>();
+    state->filename = std::move(filename);
+    state->interpolate = interpolate;
+    state->anisotropicFilterSize = anisotropicFilterSize;
+    state->mipmapLevels = mipmapLevels;
+
+    Engine::instance().jobSystem().submit([state]() {
+        ZoneScopedN("Decode texture");
+        try {
+            state->image.load(state->filename);
+            state->status = AsyncTexture::Status::Uploading;
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+            state->status = AsyncTexture::Status::Failed;
+        }
+    });
+    _pending.push_back(state);
+
+    AsyncTexture texture;
+    texture._state = std::move(state);
+    return texture;
+}
+
+void TextureManager::setUploadBudget(double milliseconds) {
+    _uploadBudget = milliseconds / 1000.0;
+}
+
+void TextureManager::update() {
+    if (_pending.empty()) [[likely]] {
+        return;
+    }
+
+    ZoneScoped;
+
+    const double start = time();
+    auto it = _pending.begin();
+    while (it != _pending.end()) {
+        AsyncState& state = **it;
+        const AsyncTexture::Status status = state.status;
+        if (status == AsyncTexture::Status::Decoding) {
+            // Textures that were requested later might already be decoded
+            it++;
+            continue;
+        }
+
+        if (status == AsyncTexture::Status::Uploading) {
+            uploadStep(state);
+        }
+        if (state.status != AsyncTexture::Status::Uploading) {
+            it = _pending.erase(it);
+        }
+
+        if (time() - start >= _uploadBudget) {
+            break;
+        }
+    }
+}
+
+void TextureManager::uploadStep(AsyncState& state) {
+    ZoneScoped;
+
+    const Image& img = state.image;
+    if (state.texture == 0) {
+        state.texture = createTexture(
+            img,
+            nullptr,
+            state.interpolate,
+            state.mipmapLevels,
+            state.anisotropicFilterSize
+        );
+        _textures.push_back(state.texture);
+    }
+    glBindTexture(GL_TEXTURE_2D, state.texture);
+
+    if (state.nUploadedRows < img.size().y) {
+        if (_pbos[0] == 0) {
+            glGenBuffers(static_cast<GLsizei>(_pbos.size()), _pbos.data());
+        }
+
+        const size_t rowSize = static_cast<size_t>(img.size().x) * img.channels();
+        const int nRows = std::min(
+            std::max(static_cast<int>(BandSize / rowSize), 1),
+            img.size().y - state.nUploadedRows
+        );
+        const size_t bandSize = rowSize * nRows;
+        const unsigned char* band = img.data() + rowSize * state.nUploadedRows;
+
+        // Reallocating the storage of the buffer lets the driver hand out new memory if
+        // the previous contents are still being transferred to the texture
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbos[_nextPbo]);
+        _nextPbo = (_nextPbo + 1) % _pbos.size();
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bandSize, nullptr, GL_STREAM_DRAW);
+        void* ptr = glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER,
+            0,
+            bandSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        );
+        const void* source = nullptr;
+        if (ptr) {
+            std::memcpy(ptr, band, bandSize);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        else {
+            // Without a mapping, the band is uploaded directly from the image
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            source = band;
+        }
+
+        const GLenum type = textureFormat(img.channels()).first;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0,
+            state.nUploadedRows,
+            img.size().x,
+            nRows,
+            type,
+            GL_UNSIGNED_BYTE,
+            source
+        );
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        state.nUploadedRows += nRows;
+    }
+    else {
+        // The mipmaps are generated in a step of their own, as they are computed from
+        // the complete first level
+        if (state.mipmapLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Debug(std::format(
+            "Texture created from '{}' [id={}]", state.filename.string(), state.texture
+        ));
+        state.image = Image();
+        state.status = AsyncTexture::Status::Ready;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void TextureManager::removeTexture(unsigned int textureId) {
     _textures.erase(
         std::remove(_textures.begin(), _textures.end(), textureId),
@@ -0,0 +1,220 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/threadpolicy.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <pthread.h>
+#include <sched.h>
+#ifdef __APPLE__
+#include <pthread/qos.h>
+#else // ^^^^ __APPLE__ // !__APPLE__ vvvv
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __APPLE__
+#endif // WIN32
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/tracer.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+    using Priority = sgct::config::Settings::Thread::Priority;
+
+    constexpr int NumberOfClasses = 5;
+
+    // The names of the classes in the log messages and the default prefixes of the names
+    // of their threads
+    constexpr std::array<std::string_view, NumberOfClasses> ClassNames = {
+        "Render", "Net", "Track", "Capture", "Log"
+    };
+
+    // The render and network threads are the ones the other nodes wait for every frame
+    constexpr std::array<Priority, NumberOfClasses> DefaultPriorities = {
+        Priority::High, Priority::High, Priority::Normal, Priority::Normal,
+        Priority::Normal
+    };
+
+    std::mutex policiesMutex;
+    std::array<sgct::config::Settings::Thread, NumberOfClasses> policies;
+
+    // Every thread of a class would fail the same way, so each class only logs once
+    std::array<std::atomic_flag, NumberOfClasses> hasReported;
+
+    void report(int c, bool isExplicit, std::string_view message) {
+        if (hasReported[c].test_and_set()) {
+            return;
+        }
+        const std::string msg = std::format(
+            "Could not {} of the {} threads", message, ClassNames[c]
+        );
+        // The default priorities need permissions that most processes do not have, so
+        // only a failure of the configured settings is worth a warning
+        if (isExplicit) {
+            sgct::Log::Warning(msg);
+        }
+        else {
+            sgct::Log::Debug(msg);
+        }
+    }
+
+    void setName(const std::string& name) {
+#ifdef WIN32
+        const std::wstring n = std::wstring(name.begin(), name.end());
+        SetThreadDescription(GetCurrentThread(), n.c_str());
+#elif defined(__APPLE__)
+        pthread_setname_np(name.c_str());
+#else // ^^^^ __APPLE__ // !WIN32 && !__APPLE__ vvvv
+        // Linux limits the names to 16 bytes including the terminator
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif // WIN32
+    }
+
+    bool setPriority(Priority priority) {
+#ifdef WIN32
+        int p = THREAD_PRIORITY_NORMAL;
+        switch (priority) {
+            case Priority::Idle:     p = THREAD_PRIORITY_IDLE;          break;
+            case Priority::Low:      p = THREAD_PRIORITY_BELOW_NORMAL;  break;
+            case Priority::Normal:   p = THREAD_PRIORITY_NORMAL;        break;
+            case Priority::High:     p = THREAD_PRIORITY_HIGHEST;       break;
+            case Priority::Realtime: p = THREAD_PRIORITY_TIME_CRITICAL; break;
+        }
+        return SetThreadPriority(GetCurrentThread(), p) != 0;
+#elif defined(__APPLE__)
+        qos_class_t qos = QOS_CLASS_DEFAULT;
+        switch (priority) {
+            case Priority::Idle:     qos = QOS_CLASS_BACKGROUND;       break;
+            case Priority::Low:      qos = QOS_CLASS_UTILITY;          break;
+            case Priority::Normal:   qos = QOS_CLASS_DEFAULT;          break;
+            case Priority::High:     qos = QOS_CLASS_USER_INITIATED;   break;
+            case Priority::Realtime: qos = QOS_CLASS_USER_INTERACTIVE; break;
+        }
+        return pthread_set_qos_class_self_np(qos, 0) == 0;
+#else // ^^^^ __APPLE__ // !WIN32 && !__APPLE__ vvvv
+        // The scheduling policy has to be reset first, as a nice value has no effect on
+        // threads with a real-time or idle policy
+        sched_param param = {};
+        const int policy = [priority]() {
+            switch (priority) {
+                case Priority::Idle:     return SCHED_IDLE;
+                case Priority::Realtime: return SCHED_FIFO;
+                default:                 return SCHED_OTHER;
+            }
+        }();
+        if (policy == SCHED_FIFO) {
+            // The lowest real-time priority already preempts all regular threads without
+            // competing with the threads of the system
+            param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        }
+        if (pthread_setschedparam(pthread_self(), policy, &param) != 0) {
+            return false;
+        }
+        if (policy != SCHED_OTHER) {
+            return true;
+        }
+
+        // On Linux, the nice value of a thread is set through its thread id
+        const int nice = [priority]() {
+            switch (priority) {
+                case Priority::Low:  return 10;
+                case Priority::High: return -10;
+                default:             return 0;
+            }
+        }();
+        const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+        return setpriority(PRIO_PROCESS, tid, nice) == 0;
+#endif // WIN32
+    }
+
+    bool setAffinity(const std::vector<int>& cores) {
+#ifdef WIN32
+        DWORD_PTR mask = 0;
+        for (int core : cores) {
+            if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                return false;
+            }
+            mask |= DWORD_PTR(1) << core;
+        }
+        return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__APPLE__)
+        // macOS does not allow to bind threads to cores
+        (void)cores;
+        return false;
+#else // ^^^^ __APPLE__ // !WIN32 && !__APPLE__ vvvv
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int core : cores) {
+            if (core >= CPU_SETSIZE) {
+                return false;
+            }
+            CPU_SET(core, &set);
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif // WIN32
+    }
+} // namespace
+
+namespace sgct {
+
+void ThreadPolicy::configure(const config::Settings::Threads& threads) {
+    const std::lock_guard lock(policiesMutex);
+    policies = {
+        threads.render.value_or(config::Settings::Thread()),
+        threads.network.value_or(config::Settings::Thread()),
+        threads.tracking.value_or(config::Settings::Thread()),
+        threads.capture.value_or(config::Settings::Thread()),
+        threads.logging.value_or(config::Settings::Thread())
+    };
+    for (std::atomic_flag& flag : hasReported) {
+        flag.clear();
+    }
+}
+
+void ThreadPolicy::apply(Class threadClass, std::string_view name) {
+    const int c = static_cast<int>(threadClass);
+    config::Settings::Thread policy;
+    {
+        const std::lock_guard lock(policiesMutex);
+        policy = policies[c];
+    }
+
+    if (!name.empty()) {
+        const std::string n = std::format(
+            "{} {}", policy.name.value_or(std::string(ClassNames[c])), name
+        );
+        setName(n);
+        if (Tracer::isEnabled()) {
+            Tracer::setThreadName(n);
+        }
+    }
+
+    // The normal priority is set as well, as threads inherit the priority of the thread
+    // that created them on some systems
+    const Priority priority = policy.priority.value_or(DefaultPriorities[c]);
+    if (!setPriority(priority)) {
+        report(c, policy.priority.has_value(), "set the priority");
+    }
+
+    if (policy.affinity && !policy.affinity->empty() && !setAffinity(*policy.affinity)) {
+        report(c, true, "set the affinity");
+    }
+}
+
+} // namespace sgct
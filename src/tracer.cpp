@@ -0,0 +1,227 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/tracer.h>
+
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace {
+    // One scope in the ring buffer of a thread. The fields are atomic so that the scopes
+    // can be read while they are being overwritten, in which case the sequence number
+    // differs before and after reading them
+    struct Event {
+        // 0 while the event is being written, otherwise the number of the event plus 1
+        std::atomic_uint64_t sequence = 0;
+        std::atomic<const char*> name = nullptr;
+        std::atomic<double> begin = 0.0;
+        std::atomic<double> end = 0.0;
+    };
+
+    struct ThreadBuffer {
+        int id = 0;
+        std::string name;
+        std::unique_ptr<Event[]> events =
+            std::make_unique<Event[]>(sgct::Tracer::EventsPerThread);
+        // The total number of events that were recorded by this thread
+        std::atomic_uint64_t count = 0;
+    };
+
+    std::atomic_bool isTracing = false;
+    std::atomic<double> clockOffset = 0.0;
+    int nodeId = 0;
+    std::filesystem::path traceFolder;
+    // The path of the file that is written when the application crashes, which is
+    // prepared beforehand to do as little as possible in the signal handler
+    std::string crashPath;
+    std::atomic_int nWritten = 0;
+
+    // The buffers of threads that have ended are kept, so that their scopes still show
+    // up in the trace
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+
+    ThreadBuffer& thisThreadBuffer() {
+        if (!threadBuffer) {
+            const std::lock_guard lock(buffersMutex);
+            std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+            buffer->id = static_cast<int>(buffers.size());
+            threadBuffer = buffer.get();
+            buffers.push_back(std::move(buffer));
+        }
+        return *threadBuffer;
+    }
+
+    // Writes the Chrome trace of all buffers into the \p file. The caller has to hold
+    // the buffers mutex. This only uses the C library, so that it can also be used
+    // from the signal handler
+    void writeTrace(std::FILE* file) {
+        const double offset = clockOffset.load(std::memory_order_relaxed);
+
+        std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        std::fprintf(
+            file,
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+            "\"args\":{\"name\":\"Node %d\"}}",
+            nodeId, nodeId
+        );
+        for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+            if (buffer->name.empty()) {
+                std::fprintf(
+                    file,
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                    "\"args\":{\"name\":\"Thread %d\"}}",
+                    nodeId, buffer->id, buffer->id
+                );
+            }
+            else {
+                std::fprintf(
+                    file,
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                    "\"args\":{\"name\":\"%s\"}}",
+                    nodeId, buffer->id, buffer->name.c_str()
+                );
+            }
+
+            const uint64_t count = buffer->count.load(std::memory_order_acquire);
+            const uint64_t first =
+                count - std::min<uint64_t>(count, sgct::Tracer::EventsPerThread);
+            for (uint64_t i = first; i < count; i++) {
+                const Event& event = buffer->events[i % sgct::Tracer::EventsPerThread];
+                const uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+                const char* name = event.name.load(std::memory_order_relaxed);
+                const double begin = event.begin.load(std::memory_order_relaxed);
+                const double end = event.end.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence != i + 1 ||
+                    event.sequence.load(std::memory_order_relaxed) != sequence)
+                {
+                    // The event has been overwritten by a newer one in the meantime
+                    continue;
+                }
+
+                std::fprintf(
+                    file,
+                    ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f}",
+                    name, nodeId, buffer->id, (begin + offset) * 1e6, (end - begin) * 1e6
+                );
+            }
+        }
+        std::fprintf(file, "\n]}\n");
+    }
+
+    void crashHandler(int signal) {
+        // A crash while a thread registers its buffer would otherwise deadlock here
+        if (buffersMutex.try_lock()) {
+            std::FILE* file = std::fopen(crashPath.c_str(), "w");
+            if (file) {
+                writeTrace(file);
+                std::fclose(file);
+            }
+            buffersMutex.unlock();
+        }
+
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+} // namespace
+
+namespace sgct {
+
+void Tracer::enable(std::filesystem::path folder, int node) {
+    std::error_code ec;
+    std::filesystem::create_directories(folder, ec);
+
+    nodeId = node;
+    traceFolder = std::move(folder);
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    crashPath = (traceFolder / std::format("trace-node{}-crash.json", nodeId)).string();
+
+    std::signal(SIGSEGV, crashHandler);
+    std::signal(SIGABRT, crashHandler);
+    std::signal(SIGFPE, crashHandler);
+    std::signal(SIGILL, crashHandler);
+
+    isTracing = true;
+}
+
+bool Tracer::isEnabled() {
+    return isTracing.load(std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(std::string name) {
+    ThreadBuffer& buffer = thisThreadBuffer();
+    const std::lock_guard lock(buffersMutex);
+    buffer.name = std::move(name);
+}
+
+void Tracer::setClockOffset(double offset) {
+    clockOffset.store(offset, std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* name, double begin, double end) {
+    ThreadBuffer& buffer = thisThreadBuffer();
+    const uint64_t count = buffer.count.load(std::memory_order_relaxed);
+    Event& event = buffer.events[count % EventsPerThread];
+
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(begin, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    event.sequence.store(count + 1, std::memory_order_release);
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+std::filesystem::path Tracer::write() {
+    if (!isEnabled()) {
+        return std::filesystem::path();
+    }
+
+    const std::filesystem::path path =
+        traceFolder / std::format("trace-node{}-{}.json", nodeId, nWritten++);
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    std::FILE* file = std::fopen(path.string().c_str(), "w");
+    if (!file) {
+        Log::Error(std::format("Failed to write trace file '{}'", path.string()));
+        return std::filesystem::path();
+    }
+
+    {
+        const std::lock_guard lock(buffersMutex);
+        writeTrace(file);
+    }
+    std::fclose(file);
+    return path;
+}
+
+TraceScope::TraceScope(const char* name)
+    : _name(Tracer::isEnabled() ? name : nullptr)
+    , _begin(_name ? time() : 0.0)
+{}
+
+TraceScope::~TraceScope() {
+    if (_name) {
+        Tracer::record(_name, _begin, time());
+    }
+}
+
+} // namespace sgct
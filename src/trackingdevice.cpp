@@ -21,6 +21,26 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <cstring>
+
+namespace {
+    // Samples that stop arriving must not make the predicted pose drift away
+    constexpr double MaxPrediction = 0.1;
+
+    sgct::mat4 composeTransform(const sgct::mat4& parent, sgct::vec3 position,
+                                sgct::quat rotation, const sgct::mat4& device)
+    {
+        const glm::mat4 m =
+            glm::make_mat4(parent.values.data()) *
+            glm::translate(glm::mat4(1.f), glm::make_vec3(&position.x)) *
+            glm::mat4_cast(glm::make_quat(&rotation.x)) *
+            glm::make_mat4(device.values.data());
+
+        sgct::mat4 res;
+        std::memcpy(&res, glm::value_ptr(m), sizeof(sgct::mat4));
+        return res;
+    }
+} // namespace
 
 namespace sgct {
 
@@ -32,7 +52,6 @@ TrackingDevice::TrackingDevice([[maybe_unused]] int parentIndex, std::string nam
 {}
 
 void TrackingDevice::setEnabled(bool state) {
-    const std::unique_lock lock(mutex::Tracking);
     _isEnabled = state;
 }
 
@@ -66,31 +85,25 @@ void TrackingDevice::setSensorTransform(vec3 vec, quat rot) {
         return;
     }
 
-    const glm::mat4 parentTrans = glm::make_mat4(parent->transform().values.data());
-
-    // create matrixes
-    const glm::mat4 sensorTransMat = glm::translate(
-        glm::mat4(1.f),
-        glm::make_vec3(&vec.x)
+    const double now = time();
+    const PoseFilter::State state = _filter.update(now, vec, rot);
+
+    // The sampling thread is the only one that writes the poses
+    Poses poses = _poses.load();
+    poses.parentTransform = parent->transform();
+    poses.deviceTransform = _deviceTransform.load();
+    poses.state = state;
+    poses.previous = poses.current;
+    poses.current.worldTransform = composeTransform(
+        poses.parentTransform,
+        state.position,
+        state.rotation,
+        poses.deviceTransform
     );
-    const glm::mat4 sensorRotMat = glm::mat4_cast(glm::make_quat(&rot.x));
-
-    {
-        const std::unique_lock lock(mutex::Tracking);
-
-        // swap
-        _sensorRotationPrevious = std::move(_sensorRotation);
-        _sensorRotation = std::move(rot);
-
-        _sensorPosPrevious = std::move(_sensorPos);
-        _sensorPos = std::move(vec);
-
-        _worldTransformPrevious = std::move(_worldTransform);
-        const glm::mat4 m = parentTrans * sensorTransMat * sensorRotMat *
-                            glm::make_mat4(_deviceTransform.values.data());
-        std::memcpy(&_worldTransform, glm::value_ptr(m), 16 * sizeof(float));
-    }
-    setTrackerTimeStamp();
+    poses.current.sensorRotation = rot;
+    poses.current.sensorPosition = vec;
+    poses.current.timeStamp = now;
+    _poses.store(poses);
 }
 
 void TrackingDevice::setButtonValue(bool val, int index) {
@@ -144,7 +157,45 @@ void TrackingDevice::setOffset(vec3 offset) {
 
 void TrackingDevice::setTransform(mat4 mat) {
     const std::unique_lock lock(mutex::Tracking);
-    _deviceTransform = std::move(mat);
+    _deviceTransform.store(mat);
+}
+
+void TrackingDevice::setFilter(std::optional<config::Tracker::Device::Filter> filter) {
+    _filter = PoseFilter(std::move(filter));
+}
+
+void TrackingDevice::setPrediction(
+                            std::optional<config::Tracker::Device::Prediction> prediction)
+{
+    _prediction = std::move(prediction);
+}
+
+void TrackingDevice::setReceivedPose(vec3 position, quat rotation, vec3 predictedPosition,
+                                     quat predictedRotation)
+{
+    const mat4 transform = composeTransform(mat4(1.f), position, rotation, mat4(1.f));
+
+    // The clients are the only ones that write the received poses
+    Poses poses = _poses.load();
+    if (poses.current.worldTransform == transform &&
+        poses.state.position == predictedPosition &&
+        poses.state.rotation == predictedRotation)
+    {
+        return;
+    }
+
+    poses.previous = poses.current;
+    poses.current.worldTransform = transform;
+    poses.current.timeStamp = time();
+    // The pose was predicted by the master, so it is kept as a pose without any motion
+    // that predictedWorldTransform then returns as it is
+    poses.state = PoseFilter::State{
+        .position = predictedPosition,
+        .rotation = predictedRotation
+    };
+    poses.parentTransform = mat4(1.f);
+    poses.deviceTransform = mat4(1.f);
+    _poses.store(poses);
 }
 
 const std::string& TrackingDevice::name() const {
@@ -164,11 +215,13 @@ void TrackingDevice::calculateTransform() {
         glm::mat4(1.f),
         glm::make_vec3(&_offset.x)) * glm::mat4_cast(glm::make_quat(&_orientation.x)
     );
-    std::memcpy(&_deviceTransform, glm::value_ptr(transMat), 16 * sizeof(float));
+    mat4 deviceTransform;
+    std::memcpy(&deviceTransform, glm::value_ptr(transMat), sizeof(mat4));
+    _deviceTransform.store(deviceTransform);
 }
 
 int TrackingDevice::sensorId() const {
-    const std::unique_lock lock(mutex::Tracking);
+    // Only set while the configuration is applied, before the sampling starts
     return _sensorId;
 }
 
@@ -193,80 +246,95 @@ double TrackingDevice::analogPrevious(int index) const {
 }
 
 vec3 TrackingDevice::position() const {
-    const std::unique_lock lock(mutex::Tracking);
-    const glm::mat4 m = glm::make_mat4(_worldTransform.values.data());
+    const mat4 transform = _poses.load().current.worldTransform;
+    const glm::mat4 m = glm::make_mat4(transform.values.data());
     const glm::vec3 p = glm::vec3(m[3]);
     return sgct::vec3(p.x, p.y, p.z);
 }
 
 vec3 TrackingDevice::previousPosition() const {
-    const std::unique_lock lock(mutex::Tracking);
-    const glm::mat4 m = glm::make_mat4(_worldTransformPrevious.values.data());
+    const mat4 transform = _poses.load().previous.worldTransform;
+    const glm::mat4 m = glm::make_mat4(transform.values.data());
     const glm::vec3 p = glm::vec3(m[3]);
     return sgct::vec3(p.x, p.y, p.z);
 }
 
 vec3 TrackingDevice::eulerAngles() const {
-    const std::unique_lock lock(mutex::Tracking);
+    const mat4 transform = _poses.load().current.worldTransform;
     const glm::vec3 v =
-        glm::eulerAngles(glm::quat_cast(glm::make_mat4(_worldTransform.values.data())));
+        glm::eulerAngles(glm::quat_cast(glm::make_mat4(transform.values.data())));
     return sgct::vec3(v.x, v.y, v.z);
 }
 
 vec3 TrackingDevice::eulerAnglesPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
+    const mat4 transform = _poses.load().previous.worldTransform;
     const glm::vec3 v =
-        glm::eulerAngles(
-            glm::quat_cast(glm::make_mat4(_worldTransformPrevious.values.data()))
-        );
+        glm::eulerAngles(glm::quat_cast(glm::make_mat4(transform.values.data())));
     return sgct::vec3(v.x, v.y, v.z);
 }
 
 quat TrackingDevice::rotation() const {
-    const std::unique_lock lock(mutex::Tracking);
-    const glm::quat q = glm::quat_cast(glm::make_mat4(_worldTransform.values.data()));
+    const mat4 transform = _poses.load().current.worldTransform;
+    const glm::quat q = glm::quat_cast(glm::make_mat4(transform.values.data()));
     return quat(q.x, q.y, q.z, q.w);
 }
 
 quat TrackingDevice::rotationPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
-    const glm::quat q =
-        glm::quat_cast(glm::make_mat4(_worldTransformPrevious.values.data()));
+    const mat4 transform = _poses.load().previous.worldTransform;
+    const glm::quat q = glm::quat_cast(glm::make_mat4(transform.values.data()));
     return quat(q.x, q.y, q.z, q.w);
 }
 
 mat4 TrackingDevice::worldTransform() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _worldTransform;
+    return _poses.load().current.worldTransform;
 }
 
 mat4 TrackingDevice::worldTransformPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _worldTransformPrevious;
+    return _poses.load().previous.worldTransform;
+}
+
+mat4 TrackingDevice::predictedWorldTransform() const {
+    const Poses poses = _poses.load();
+    if (!_prediction) {
+        return poses.current.worldTransform;
+    }
+
+    const double dt = std::clamp(
+        time() + _prediction->latency - poses.current.timeStamp,
+        0.0,
+        MaxPrediction
+    );
+    using Model = config::Tracker::Device::Prediction::Model;
+    const PoseFilter::State state = PoseFilter::extrapolate(
+        poses.state,
+        dt,
+        _prediction->model == Model::Acceleration
+    );
+    return composeTransform(
+        poses.parentTransform,
+        state.position,
+        state.rotation,
+        poses.deviceTransform
+    );
 }
 
 quat TrackingDevice::sensorRotation() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _sensorRotation;
+    return _poses.load().current.sensorRotation;
 }
 
 quat TrackingDevice::sensorRotationPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _sensorRotationPrevious;
+    return _poses.load().previous.sensorRotation;
 }
 
 vec3 TrackingDevice::sensorPosition() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _sensorPos;
+    return _poses.load().current.sensorPosition;
 }
 
 vec3 TrackingDevice::sensorPositionPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _sensorPosPrevious;
+    return _poses.load().previous.sensorPosition;
 }
 
 bool TrackingDevice::isEnabled() const {
-    const std::unique_lock lock(mutex::Tracking);
     return _isEnabled;
 }
 
@@ -274,6 +342,10 @@ bool TrackingDevice::hasSensor() const {
     return _sensorId != -1;
 }
 
+bool TrackingDevice::hasPrediction() const {
+    return _prediction.has_value();
+}
+
 bool TrackingDevice::hasButtons() const {
     return _nButtons > 0;
 }
@@ -282,12 +354,6 @@ bool TrackingDevice::hasAnalogs() const {
     return _nAxes > 0;
 }
 
-void TrackingDevice::setTrackerTimeStamp() {
-    const std::unique_lock lock(mutex::Tracking);
-    _trackerTimePrevious = _trackerTime;
-    _trackerTime = time();
-}
-
 void TrackingDevice::setAnalogTimeStamp() {
     const std::unique_lock lock(mutex::Tracking);
     _analogTimePrevious = _analogTime;
@@ -301,13 +367,11 @@ void TrackingDevice::setButtonTimeStamp(int index) {
 }
 
 double TrackingDevice::trackerTimeStamp() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _trackerTime;
+    return _poses.load().current.timeStamp;
 }
 
 double TrackingDevice::trackerTimeStampPrevious() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _trackerTimePrevious;
+    return _poses.load().previous.timeStamp;
 }
 
 double TrackingDevice::analogTimeStamp() const {
@@ -331,8 +395,8 @@ double TrackingDevice::buttonTimeStampPrevious(int index) const {
 }
 
 double TrackingDevice::trackerDeltaTime() const {
-    const std::unique_lock lock(mutex::Tracking);
-    return _trackerTime - _trackerTimePrevious;
+    const Poses poses = _poses.load();
+    return poses.current.timeStamp - poses.previous.timeStamp;
 }
 
 double TrackingDevice::analogDeltaTime() const {
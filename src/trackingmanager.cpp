@@ -8,13 +8,15 @@
 
 #include <sgct/trackingmanager.h>
 
+#include <sgct/bytestream.h>
 #include <sgct/config.h>
 #include <sgct/clustermanager.h>
 #include <sgct/engine.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
-#include <sgct/mutexes.h>
 #include <sgct/profiling.h>
+#include <sgct/shareddata.h>
+#include <sgct/threadpolicy.h>
 #include <sgct/trackingdevice.h>
 #include <sgct/user.h>
 #ifdef __GNUC__
@@ -30,9 +32,13 @@
 #pragma GCC diagnostic pop
 #endif // __GNUC__
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/euler_angles.hpp>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
 
 namespace {
     struct VRPNPointer {
@@ -50,7 +56,8 @@ namespace {
         sgct::Tracker* tracker = reinterpret_cast<sgct::Tracker*>(userdata);
         sgct::TrackingDevice* device = tracker->deviceBySensorId(t.sensor);
 
-        if (device == nullptr) {
+        // The connections dispatch the samples of all devices, including disabled ones
+        if (device == nullptr || !device->isEnabled()) {
             return;
         }
 
@@ -70,30 +77,63 @@ namespace {
 
     void VRPN_CALLBACK updateButton(void* userdata, const vrpn_BUTTONCB b) {
         sgct::TrackingDevice* device = reinterpret_cast<sgct::TrackingDevice*>(userdata);
-        device->setButtonValue(b.state != 0, b.button);
+        if (device->isEnabled()) {
+            device->setButtonValue(b.state != 0, b.button);
+        }
     }
 
     void VRPN_CALLBACK updateAnalog(void* userdata, const vrpn_ANALOGCB a) {
         sgct::TrackingDevice* tdPtr = reinterpret_cast<sgct::TrackingDevice*>(userdata);
-        tdPtr->setAnalogValue(a.channel, static_cast<int>(a.num_channel));
+        if (tdPtr->isEnabled()) {
+            tdPtr->setAnalogValue(a.channel, static_cast<int>(a.num_channel));
+        }
     }
 
-    void samplingLoop(void* arg) {
-        sgct::TrackingManager* tm = reinterpret_cast<sgct::TrackingManager*>(arg);
+    // The longest time that the sampling thread waits for a sample from a single VRPN
+    // server in microseconds, which limits how long it takes to notice that the sampling
+    // is stopped
+    constexpr long SingleServerTimeout = 10000;
 
-        while (true) {
-            const double t = sgct::Engine::getTime();
-            for (size_t i = 0; i < tm->trackers().size(); ++i) {
-                sgct::Tracker* tracker = tm->trackers()[i].get();
-                if (tracker == nullptr) {
-                    continue;
-                }
-                for (size_t j = 0; j < tracker->devices().size(); ++j) {
-                    if (!tracker->devices()[j]->isEnabled()) {
-                        continue;
-                    }
+    // With several servers, the thread has to wait on them in turn, so it only waits
+    // briefly on each of them for a sample to arrive
+    constexpr long MultipleServerTimeout = 250;
+
+    void samplingLoop(sgct::TrackingManager* tm) {
+        sgct::ThreadPolicy::apply(sgct::ThreadPolicy::Class::Tracking, "VRPN");
+
+        // The remote devices on the same server share one connection, whose sockets are
+        // waited on until a sample arrives instead of polling them in fixed intervals
+        std::vector<vrpn_Connection*> connections;
+        auto addConnection = [&connections](vrpn_BaseClass* remote) {
+            vrpn_Connection* c = remote ? remote->connectionPtr() : nullptr;
+            if (c && std::find(connections.begin(), connections.end(), c) ==
+                     connections.end())
+            {
+                connections.push_back(c);
+            }
+        };
+        for (const std::vector<VRPNPointer>& tracker : gTrackers) {
+            for (const VRPNPointer& ptr : tracker) {
+                addConnection(ptr.sensorDevice.get());
+                addConnection(ptr.analogDevice.get());
+                addConnection(ptr.buttonDevice.get());
+            }
+        }
+        const long timeout =
+            connections.size() == 1 ? SingleServerTimeout : MultipleServerTimeout;
+
+        while (tm->isRunning()) {
+            // Dispatches the samples to the callbacks the moment they arrive
+            for (vrpn_Connection* connection : connections) {
+                timeval wait = { .tv_sec = 0, .tv_usec = timeout };
+                connection->mainloop(&wait);
+            }
 
-                    const VRPNPointer& ptr = gTrackers[i][j];
+            // The remote devices only send their heartbeats and reconnect here, as the
+            // samples have already been received by the connections
+            const double t = sgct::time();
+            for (const std::vector<VRPNPointer>& tracker : gTrackers) {
+                for (const VRPNPointer& ptr : tracker) {
                     if (ptr.sensorDevice) {
                         ptr.sensorDevice->mainloop();
                     }
@@ -105,22 +145,180 @@ namespace {
                     }
                 }
             }
+            tm->setSamplingTime(sgct::time() - t);
+
+            if (connections.empty()) {
+                // Without a connection there is nothing to wait on
+                vrpn_SleepMsecs(1);
+            }
+        }
+    }
 
-            const bool isRunning = tm->isRunning();
-            tm->setSamplingTime(sgct::Engine::getTime() - t);
+    // Follows the ids of the shared objects of the Engine
+    constexpr uint32_t SharedStateId = sgct::SharedObjectBase::FirstReservedId + 3;
 
-            // Sleep for 1ms so we don't eat the CPU
-            vrpn_SleepMsecs(1);
+    // A rigid transformation in the compact form in which it is sent to the clients
+    struct CompactPose {
+        // Positions of up to 16 m from the origin are sent with a resolution of 0.5 mm
+        sgct::Quantized<-16.f, 16.f> x;
+        sgct::Quantized<-16.f, 16.f> y;
+        sgct::Quantized<-16.f, 16.f> z;
+        // The three smallest components of the rotation quaternion with 15 bits each, as
+        // the largest one follows from them. The index of the largest component is stored
+        // in the highest bits of the first two values
+        std::array<uint16_t, 3> rotation = {};
 
-            if (!isRunning) {
-                break;
+        SGCT_SERIALIZE_MEMBERS(x, y, z, rotation)
+    };
+
+    // All but the largest component of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)]
+    constexpr float ComponentRange = 1.f / std::numbers::sqrt2_v<float>;
+    constexpr float ComponentSteps = 32767.f;
+
+    CompactPose encodePose(const sgct::mat4& transform) {
+        const glm::mat4 m = glm::make_mat4(transform.values.data());
+        const glm::quat q = glm::normalize(glm::quat_cast(m));
+        const std::array<float, 4> c = { q.x, q.y, q.z, q.w };
+
+        size_t largest = 0;
+        for (size_t i = 1; i < c.size(); i++) {
+            if (std::abs(c[i]) > std::abs(c[largest])) {
+                largest = i;
             }
         }
+        // q and -q are the same rotation, so the largest component is made positive
+        const float sign = c[largest] < 0.f ? -1.f : 1.f;
+
+        CompactPose pose;
+        pose.x = m[3].x;
+        pose.y = m[3].y;
+        pose.z = m[3].z;
+        size_t j = 0;
+        for (size_t i = 0; i < c.size(); i++) {
+            if (i == largest) {
+                continue;
+            }
+            const float v = std::clamp(sign * c[i] / ComponentRange, -1.f, 1.f);
+            pose.rotation[j] =
+                static_cast<uint16_t>(std::lround((v * 0.5f + 0.5f) * ComponentSteps));
+            j++;
+        }
+        pose.rotation[0] |= static_cast<uint16_t>((largest & 1) << 15);
+        pose.rotation[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+        return pose;
+    }
+
+    std::pair<sgct::vec3, sgct::quat> decodePose(const CompactPose& pose) {
+        const size_t largest = (pose.rotation[0] >> 15) | ((pose.rotation[1] >> 15) << 1);
+
+        std::array<float, 4> c = {};
+        float sum = 0.f;
+        size_t j = 0;
+        for (size_t i = 0; i < c.size(); i++) {
+            if (i == largest) {
+                continue;
+            }
+            const float v = (pose.rotation[j] & 0x7FFF) / ComponentSteps * 2.f - 1.f;
+            c[i] = v * ComponentRange;
+            sum += c[i] * c[i];
+            j++;
+        }
+        c[largest] = std::sqrt(std::max(1.f - sum, 0.f));
+
+        return {
+            sgct::vec3{ pose.x, pose.y, pose.z },
+            sgct::quat(c[0], c[1], c[2], c[3])
+        };
     }
 } // namespace
 
 namespace sgct {
 
+/**
+ * The state of all devices in the order of the trackers and their devices. Which values
+ * are sent for a device follows from its configuration, which is the same on all nodes,
+ * so that only the values themselves are sent. For each device, these are:
+ *   - Whether it is enabled, as one byte
+ *   - Its pose if it has a sensor, followed by the predicted pose if that is enabled
+ *   - Its buttons, 8 to a byte
+ *   - Its axes as `float`s
+ */
+class TrackingManager::SharedState final : public SharedObjectBase {
+public:
+    explicit SharedState(TrackingManager& manager)
+        : SharedObjectBase(SharedStateId)
+        , _manager(manager)
+    {}
+
+    /// Replaces the state with the \p data, which are sent if they have changed
+    void setData(std::vector<std::byte>& data) {
+        if (data != _data) {
+            std::swap(data, _data);
+            setDirty();
+        }
+    }
+
+private:
+    void serialize(ByteWriter& writer) const override {
+        writer.writeBytes(_data);
+    }
+
+    void deserialize(ByteReader& reader) override;
+
+    TrackingManager& _manager;
+    std::vector<std::byte> _data;
+    std::vector<double> _axes;
+};
+
+void TrackingManager::SharedState::deserialize(ByteReader& reader) {
+    ZoneScoped
+
+    for (const std::unique_ptr<Tracker>& tracker : _manager._trackers) {
+        for (const std::unique_ptr<TrackingDevice>& device : tracker->devices()) {
+            device->setEnabled(reader.read<uint8_t>() != 0);
+
+            if (device->hasSensor()) {
+                const auto [pos, rot] = decodePose(reader.read<CompactPose>());
+                if (device->hasPrediction()) {
+                    const CompactPose predicted = reader.read<CompactPose>();
+                    const auto [predPos, predRot] = decodePose(predicted);
+                    device->setReceivedPose(pos, rot, predPos, predRot);
+                }
+                else {
+                    device->setReceivedPose(pos, rot, pos, rot);
+                }
+            }
+
+            const int nButtons = device->numberOfButtons();
+            for (int i = 0; i < nButtons; i += 8) {
+                const uint8_t bits = reader.read<uint8_t>();
+                for (int j = i; j < std::min(i + 8, nButtons); j++) {
+                    const bool value = ((bits >> (j - i)) & 1) != 0;
+                    if (value != device->button(j)) {
+                        device->setButtonValue(value, j);
+                    }
+                }
+            }
+
+            if (device->hasAnalogs()) {
+                _axes.resize(device->numberOfAxes());
+                bool hasChanged = false;
+                for (int i = 0; i < device->numberOfAxes(); i++) {
+                    _axes[i] = reader.read<float>();
+                    hasChanged |= _axes[i] != device->analog(i);
+                }
+                if (hasChanged) {
+                    device->setAnalogValue(_axes.data(), device->numberOfAxes());
+                }
+            }
+        }
+    }
+
+    if (_manager._head && _manager._head->isEnabled() && _manager._headUser) {
+        _manager._headUser->setTransform(_manager._head->predictedWorldTransform());
+    }
+}
+
 TrackingManager* TrackingManager::_instance = nullptr;
 
 TrackingManager& TrackingManager::instance() {
@@ -138,10 +336,7 @@ void TrackingManager::destroy() {
 TrackingManager::~TrackingManager() {
     Log::Info("Disconnecting VRPN");
 
-    {
-        std::unique_lock lock(mutex::Tracking);
-        _isRunning = false;
-    }
+    _isRunning = false;
 
     // destroy thread
     if (_samplingThread) {
@@ -149,21 +344,22 @@ TrackingManager::~TrackingManager() {
         _samplingThread = nullptr;
     }
 
+    _sharedState = nullptr;
     _trackers.clear();
     gTrackers.clear();
     Log::Debug("Done");
 }
 
-void TrackingManager::applyDevice(const config::Device& device) {
+void TrackingManager::applyDevice(const config::Tracker::Device& device) {
     addDeviceToCurrentTracker(device.name);
 
-    for (const config::Device::Sensors& s : device.sensors) {
+    for (const config::Tracker::Device::Sensor& s : device.sensors) {
         addSensorToCurrentDevice(s.vrpnAddress, s.identifier);
     }
-    for (const config::Device::Buttons& b : device.buttons) {
+    for (const config::Tracker::Device::Button& b : device.buttons) {
         addButtonsToCurrentDevice(b.vrpnAddress, b.count);
     }
-    for (const config::Device::Axes& a : device.axes) {
+    for (const config::Tracker::Device::Axis& a : device.axes) {
         addAnalogsToCurrentDevice(a.vrpnAddress, a.count);
     }
     if (device.offset) {
@@ -172,6 +368,8 @@ void TrackingManager::applyDevice(const config::Device& device) {
     if (device.transformation) {
         _trackers.back()->devices().back()->setTransform(*device.transformation);
     }
+    _trackers.back()->devices().back()->setFilter(device.filter);
+    _trackers.back()->devices().back()->setPrediction(device.prediction);
 }
 
 void TrackingManager::applyTracker(const config::Tracker& tracker) {
@@ -179,7 +377,7 @@ void TrackingManager::applyTracker(const config::Tracker& tracker) {
 
     addTracker(tracker.name);
 
-    for (const config::Device& device : tracker.devices) {
+    for (const config::Tracker::Device& device : tracker.devices) {
         applyDevice(device);
     }
     if (tracker.offset) {
@@ -194,7 +392,6 @@ void TrackingManager::applyTracker(const config::Tracker& tracker) {
 }
 
 bool TrackingManager::isRunning() const {
-    std::unique_lock lock(mutex::Tracking);
     return _isRunning;
 }
 
@@ -202,6 +399,23 @@ void TrackingManager::startSampling() {
     if (_trackers.empty()) {
         return;
     }
+
+    _sharedState = std::make_unique<SharedState>(*this);
+    if (linkHeadDevice()) {
+        _samplingThread = std::make_unique<std::thread>(samplingLoop, this);
+    }
+}
+
+void TrackingManager::startReceiving() {
+    if (_trackers.empty()) {
+        return;
+    }
+
+    _sharedState = std::make_unique<SharedState>(*this);
+    linkHeadDevice();
+}
+
+bool TrackingManager::linkHeadDevice() {
     // find user with headtracking
     _headUser = ClusterManager::instance().trackedUser();
 
@@ -223,22 +437,51 @@ void TrackingManager::startSampling() {
         Log::Error(std::format(
             "Failed to set head tracker to {}@{}", deviceName, trackerName
         ));
-        return;
+        return false;
     }
-
-    _samplingThread = std::make_unique<std::thread>(samplingLoop, this);
+    return true;
 }
 
 void TrackingManager::updateTrackingDevices() {
     ZoneScoped
 
+    // The state is encoded into the same buffer in every frame and only replaces the one
+    // that is sent to the clients if it has changed
+    _encodeBuffer.clear();
+    ByteWriter writer = ByteWriter(_encodeBuffer);
     for (const std::unique_ptr<Tracker>& tracker : _trackers) {
         for (const std::unique_ptr<TrackingDevice>& device : tracker->devices()) {
+            const mat4 predicted = device->predictedWorldTransform();
             if (device->isEnabled() && device.get() == _head && _headUser) {
-                _headUser->setTransform(device->worldTransform());
+                _headUser->setTransform(predicted);
+            }
+
+            writer.write(static_cast<uint8_t>(device->isEnabled()));
+            if (device->hasSensor()) {
+                writer.write(encodePose(device->worldTransform()));
+                if (device->hasPrediction()) {
+                    writer.write(encodePose(predicted));
+                }
+            }
+
+            const int nButtons = device->numberOfButtons();
+            for (int i = 0; i < nButtons; i += 8) {
+                uint8_t bits = 0;
+                for (int j = i; j < std::min(i + 8, nButtons); j++) {
+                    bits |= static_cast<uint8_t>(device->button(j) ? 1 << (j - i) : 0);
+                }
+                writer.write(bits);
+            }
+
+            for (int i = 0; i < device->numberOfAxes(); i++) {
+                writer.write(static_cast<float>(device->analog(i)));
             }
         }
     }
+
+    if (_sharedState) {
+        _sharedState->setData(_encodeBuffer);
+    }
 }
 
 void TrackingManager::addTracker(std::string name) {
@@ -351,12 +594,10 @@ void TrackingManager::setEnabled(bool state) {
 }
 
 void TrackingManager::setSamplingTime(double t) {
-    std::unique_lock lock(mutex::Tracking);
     _samplingTime = t;
 }
 
 double TrackingManager::samplingTime() const {
-    std::unique_lock lock(mutex::Tracking);
     return _samplingTime;
 }
 
@@ -0,0 +1,853 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/videodecoder.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavdevice/avdevice.h>
+#include <libavformat/avformat.h>
+#include <libavutil/hwcontext.h>
+#include <libswscale/swscale.h>
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+namespace {
+    // The hardware decoders that are tried in order before falling back to the software
+    // decoder of the codec: NVDEC, Direct3D 11, VA-API, and VideoToolbox
+    constexpr std::array<AVHWDeviceType, 4> HardwareDevices = {
+        AV_HWDEVICE_TYPE_CUDA,
+        AV_HWDEVICE_TYPE_D3D11VA,
+        AV_HWDEVICE_TYPE_VAAPI,
+        AV_HWDEVICE_TYPE_VIDEOTOOLBOX
+    };
+
+    // A gap between two frames that is longer than this is treated as a discontinuity
+    // in the timestamps instead of being waited for
+    constexpr std::chrono::seconds MaxFrameGap = std::chrono::seconds(1);
+
+    // Covers the whole target with a single triangle
+    constexpr std::string_view VertexShader = R"(
+  #version 330 core
+
+  void main() {
+    vec2 p = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);
+    gl_Position = vec4(p, 0.0, 1.0);
+  }
+)";
+
+    // Converts the luma and chroma planes into RGB. The chroma is either interleaved in
+    // one texture (NV12) or split into two (I420). The frame is flipped vertically, as
+    // its first row is the top of the image
+    constexpr std::string_view FragmentShader = R"(
+  #version 330 core
+
+  out vec4 out_color;
+
+  uniform sampler2D luma;
+  uniform sampler2D chromaU;
+  uniform sampler2D chromaV;
+  uniform vec2 size;
+  uniform bool isPlanar;
+  uniform mat3 conversion;
+  uniform vec3 offset;
+
+  void main() {
+    vec2 uv = vec2(gl_FragCoord.x, size.y - gl_FragCoord.y) / size;
+    float y = texture(luma, uv).r;
+    vec2 c = isPlanar ?
+      vec2(texture(chromaU, uv).r, texture(chromaV, uv).r) :
+      texture(chromaU, uv).rg;
+    out_color = vec4(clamp(conversion * (vec3(y, c) - offset), 0.0, 1.0), 1.0);
+  }
+)";
+
+    std::string errorString(int error) {
+        std::array<char, AV_ERROR_MAX_STRING_SIZE> buffer = {};
+        av_strerror(error, buffer.data(), buffer.size());
+        return std::string(buffer.data());
+    }
+
+    // Returns the number of planes in which the frames with the format are uploaded, or
+    // 0 if they first have to be converted
+    int numberOfPlanes(int format) {
+        switch (format) {
+            case AV_PIX_FMT_NV12:
+                return 2;
+            case AV_PIX_FMT_YUV420P:
+            case AV_PIX_FMT_YUVJ420P:
+                return 3;
+            default:
+                return 0;
+        }
+    }
+
+    // Returns the luma coefficients of red and blue for the color space of the frame
+    std::pair<float, float> lumaCoefficients(const AVFrame& frame) {
+        switch (frame.colorspace) {
+            case AVCOL_SPC_BT709:
+                return { 0.2126f, 0.0722f };
+            case AVCOL_SPC_BT470BG:
+            case AVCOL_SPC_SMPTE170M:
+                return { 0.299f, 0.114f };
+            case AVCOL_SPC_BT2020_NCL:
+            case AVCOL_SPC_BT2020_CL:
+                return { 0.2627f, 0.0593f };
+            default:
+                // Videos without a color space use the one of their resolution
+                return frame.height >= 720 ?
+                    std::pair(0.2126f, 0.0722f) :
+                    std::pair(0.299f, 0.114f);
+        }
+    }
+} // namespace
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+namespace sgct {
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+
+VideoDecoder::VideoDecoder(std::string url)
+    : VideoDecoder(std::move(url), Options())
+{}
+
+VideoDecoder::VideoDecoder(std::string url, Options options)
+    : _url(std::move(url))
+    , _loop(options.loop)
+    , _decodeAhead(std::max(options.decodeAhead, 0))
+    , _isPersistent(GLAD_GL_VERSION_4_4)
+    // Besides the frames ahead, one slot is being written and one is being uploaded
+    , _slots(_decodeAhead > 0 ? _decodeAhead + 2 : 3)
+{
+    // The interrupt callback of the input stops every read while this is not set
+    _isRunning = true;
+    try {
+        open(options);
+
+        _shader = ShaderProgram("VideoDecoderShader");
+        _shader.addVertexShader(VertexShader);
+        _shader.addFragmentShader(FragmentShader);
+        _shader.createAndLinkProgram();
+    }
+    catch (const std::runtime_error&) {
+        release();
+        throw;
+    }
+    _shader.bind();
+    glUniform1i(glGetUniformLocation(_shader.id(), "luma"), 0);
+    glUniform1i(glGetUniformLocation(_shader.id(), "chromaU"), 1);
+    glUniform1i(glGetUniformLocation(_shader.id(), "chromaV"), 2);
+    _sizeLoc = glGetUniformLocation(_shader.id(), "size");
+    _isPlanarLoc = glGetUniformLocation(_shader.id(), "isPlanar");
+    _conversionLoc = glGetUniformLocation(_shader.id(), "conversion");
+    _offsetLoc = glGetUniformLocation(_shader.id(), "offset");
+    ShaderProgram::unbind();
+
+    glGenFramebuffers(1, &_fbo);
+    // The vertices are generated in the vertex shader, but a vertex array still has to
+    // be bound to draw them
+    glGenVertexArrays(1, &_vao);
+
+    _thread = std::thread(&VideoDecoder::decode, this);
+}
+
+VideoDecoder::~VideoDecoder() {
+    {
+        std::lock_guard lock(_mutex);
+        _isRunning = false;
+    }
+    _slotFreed.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    release();
+
+    for (Slot& slot : _slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    glDeleteTextures(static_cast<GLsizei>(_planes.size()), _planes.data());
+    glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+    glDeleteFramebuffers(1, &_fbo);
+    glDeleteVertexArrays(1, &_vao);
+    _shader.deleteProgram();
+}
+
+bool VideoDecoder::update() {
+    return update(std::numeric_limits<double>::infinity());
+}
+
+bool VideoDecoder::update(double time) {
+    ZoneScoped;
+
+    Slot* upload = nullptr;
+    {
+        std::lock_guard lock(_mutex);
+        for (Slot& slot : _slots) {
+            if (slot.state != Slot::State::Uploading) {
+                continue;
+            }
+            const GLenum res = glClientWaitSync(slot.fence, 0, 0);
+            if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED) {
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                slot.state = Slot::State::Free;
+            }
+        }
+
+        for (Slot& slot : _slots) {
+            if (slot.state == Slot::State::Free && slot.capacity < _requiredCapacity) {
+                allocate(slot, _requiredCapacity);
+            }
+        }
+
+        // Only the latest frame that is due is uploaded and the older ones are dropped
+        for (Slot& slot : _slots) {
+            if (slot.state != Slot::State::Filled || slot.time > time) {
+                continue;
+            }
+            if (!upload || slot.frame > upload->frame) {
+                if (upload) {
+                    upload->state = Slot::State::Free;
+                }
+                upload = &slot;
+            }
+            else {
+                slot.state = Slot::State::Free;
+            }
+        }
+        if (upload) {
+            upload->state = Slot::State::Uploading;
+        }
+    }
+    _slotFreed.notify_one();
+
+    if (!upload) {
+        return _current != -1;
+    }
+
+    const ivec2 chromaSize = ivec2((upload->size.x + 1) / 2, (upload->size.y + 1) / 2);
+    if (_planeSize != upload->size || _nPlanes != upload->nPlanes) {
+        glDeleteTextures(static_cast<GLsizei>(_planes.size()), _planes.data());
+        _planes = { 0, 0, 0 };
+        glGenTextures(upload->nPlanes, _planes.data());
+        for (int i = 0; i < upload->nPlanes; i++) {
+            const bool isChroma = i > 0;
+            const bool isInterleaved = upload->nPlanes == 2 && isChroma;
+            const ivec2 s = isChroma ? chromaSize : upload->size;
+            glBindTexture(GL_TEXTURE_2D, _planes[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                isInterleaved ? GL_RG8 : GL_R8,
+                s.x,
+                s.y,
+                0,
+                isInterleaved ? GL_RG : GL_RED,
+                GL_UNSIGNED_BYTE,
+                nullptr
+            );
+        }
+        _planeSize = upload->size;
+        _nPlanes = upload->nPlanes;
+    }
+
+    // With a persistently mapped buffer, the upload only starts a transfer on the GPU.
+    // Otherwise the driver copies the planes before the function returns
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload->mapping ? upload->pbo : 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int i = 0; i < upload->nPlanes; i++) {
+        const bool isChroma = i > 0;
+        const bool isInterleaved = upload->nPlanes == 2 && isChroma;
+        const ivec2 s = isChroma ? chromaSize : upload->size;
+        // The offset into the bound pixel buffer is passed in place of the pointer
+        const void* pixels = upload->mapping ?
+            reinterpret_cast<const void*>(upload->offsets[i]) :
+            upload->data.data() + upload->offsets[i];
+        glBindTexture(GL_TEXTURE_2D, _planes[i]);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, upload->strides[i] / (isInterleaved ? 2 : 1));
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0,
+            0,
+            s.x,
+            s.y,
+            isInterleaved ? GL_RG : GL_RED,
+            GL_UNSIGNED_BYTE,
+            pixels
+        );
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    {
+        std::lock_guard lock(_mutex);
+        upload->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    const int next = _current == 0 ? 1 : 0;
+    convert(*upload, next);
+    _current = next;
+    return true;
+}
+
+unsigned int VideoDecoder::texture() const {
+    return _current != -1 ? _textures[_current] : 0;
+}
+
+ivec2 VideoDecoder::size() const {
+    return _current != -1 ? _textureSizes[_current] : ivec2(0, 0);
+}
+
+const std::string& VideoDecoder::hardwareDevice() const {
+    return _hardwareDevice;
+}
+
+bool VideoDecoder::hasEnded() const {
+    return _hasEnded;
+}
+
+void VideoDecoder::open(const Options& options) {
+    const AVInputFormat* input = nullptr;
+    if (!options.format.empty()) {
+        // The capture devices are only available once they have been registered
+        static std::once_flag isRegistered;
+        std::call_once(isRegistered, []() { avdevice_register_all(); });
+
+        input = av_find_input_format(options.format.c_str());
+        if (!input) {
+            throw Err(
+                9027,
+                std::format("Unknown video input format '{}'", options.format)
+            );
+        }
+    }
+
+    AVDictionary* parameters = nullptr;
+    for (const std::pair<std::string, std::string>& p : options.parameters) {
+        av_dict_set(&parameters, p.first.c_str(), p.second.c_str(), 0);
+    }
+
+    _format = avformat_alloc_context();
+    _format->interrupt_callback.callback = [](void* decoder) {
+        return static_cast<VideoDecoder*>(decoder)->_isRunning ? 0 : 1;
+    };
+    _format->interrupt_callback.opaque = this;
+    int res = avformat_open_input(&_format, _url.c_str(), input, &parameters);
+    av_dict_free(&parameters);
+    if (res < 0) {
+        throw Err(
+            9028,
+            std::format("Could not open video '{}': {}", _url, errorString(res))
+        );
+    }
+
+    res = avformat_find_stream_info(_format, nullptr);
+    if (res < 0) {
+        throw Err(
+            9029,
+            std::format("Could not read the streams of '{}': {}", _url, errorString(res))
+        );
+    }
+
+    _streamIndex = av_find_best_stream(_format, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    const AVCodec* decoder = _streamIndex >= 0 ?
+        avcodec_find_decoder(_format->streams[_streamIndex]->codecpar->codec_id) :
+        nullptr;
+    if (!decoder) {
+        throw Err(9030, std::format("No video decoder available for '{}'", _url));
+    }
+
+    // Capture devices and streams deliver their frames in real time, so they are not
+    // paced a second time
+    _isPaced = !(_format->iformat->flags & AVFMT_NOFILE);
+
+    _codec = avcodec_alloc_context3(decoder);
+    avcodec_parameters_to_context(_codec, _format->streams[_streamIndex]->codecpar);
+    _codec->thread_count = 0;
+    if (!_isPaced) {
+        _codec->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    }
+    if (options.allowHardware) {
+        openHardwareDevice(*decoder);
+    }
+
+    res = avcodec_open2(_codec, decoder, nullptr);
+    if (res < 0) {
+        throw Err(
+            9031,
+            std::format("Could not open decoder for '{}': {}", _url, errorString(res))
+        );
+    }
+
+    Log::Info(std::format(
+        "Decoding '{}' ({}x{}) with {} on {}",
+        _url, _codec->width, _codec->height, decoder->name,
+        _hardwareDevice.empty() ? "the CPU" : _hardwareDevice
+    ));
+}
+
+void VideoDecoder::openHardwareDevice(const AVCodec& decoder) {
+    for (AVHWDeviceType type : HardwareDevices) {
+        int format = -1;
+        for (int i = 0;; i++) {
+            const AVCodecHWConfig* config = avcodec_get_hw_config(&decoder, i);
+            if (!config) {
+                break;
+            }
+            if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) &&
+                config->device_type == type)
+            {
+                format = config->pix_fmt;
+                break;
+            }
+        }
+        if (format == -1) {
+            continue;
+        }
+
+        // The device fails to be created if the GPU or its driver do not support it
+        if (av_hwdevice_ctx_create(&_hwDevice, type, nullptr, nullptr, 0) < 0) {
+            continue;
+        }
+        _hwFormat = format;
+        _hardwareDevice = av_hwdevice_get_type_name(type);
+        _codec->hw_device_ctx = av_buffer_ref(_hwDevice);
+        _codec->opaque = this;
+        _codec->get_format = [](AVCodecContext* context, const AVPixelFormat* formats) {
+            const VideoDecoder* self = static_cast<const VideoDecoder*>(context->opaque);
+            for (const AVPixelFormat* f = formats; *f != AV_PIX_FMT_NONE; f++) {
+                if (*f == self->_hwFormat) {
+                    return *f;
+                }
+            }
+            // The device does not support the profile of this video, so it is decoded
+            // in software instead
+            Log::Warning("Hardware decoder does not support the video");
+            return avcodec_default_get_format(context, formats);
+        };
+        return;
+    }
+}
+
+void VideoDecoder::release() {
+    sws_freeContext(_conversion);
+    _conversion = nullptr;
+    av_frame_free(&_converted);
+    avcodec_free_context(&_codec);
+    av_buffer_unref(&_hwDevice);
+    avformat_close_input(&_format);
+}
+
+void VideoDecoder::decode() {
+    AVPacket* packet = av_packet_alloc();
+    AVFrame* frame = av_frame_alloc();
+    AVFrame* transferred = av_frame_alloc();
+
+    const AVStream* stream = _format->streams[_streamIndex];
+    const AVRational timeBase = stream->time_base;
+    const double frameDuration =
+        stream->avg_frame_rate.num > 0 ? 1.0 / av_q2d(stream->avg_frame_rate) : 0.0;
+    std::chrono::steady_clock::time_point start;
+    int64_t startTimestamp = AV_NOPTS_VALUE;
+
+    // The time of a frame in the video, which continues to grow when the video is looped
+    int64_t firstTimestamp = stream->start_time;
+    double loopOffset = 0.0;
+    double videoTime = -frameDuration;
+
+    auto receiveFrames = [&]() {
+        while (_isRunning && avcodec_receive_frame(_codec, frame) == 0) {
+            ZoneScopedN("Decode video frame");
+
+            const AVFrame* source = frame;
+            if (frame->format == _hwFormat) {
+                // The frame is downloaded from the decoder in its native format, which
+                // is converted into RGB on the GPU
+                const int res = av_hwframe_transfer_data(transferred, frame, 0);
+                if (res < 0) {
+                    Log::Warning(std::format(
+                        "Failed to transfer video frame: {}", errorString(res)
+                    ));
+                    av_frame_unref(frame);
+                    continue;
+                }
+                av_frame_copy_props(transferred, frame);
+                source = transferred;
+            }
+
+            const int64_t timestamp = frame->best_effort_timestamp;
+            if (timestamp != AV_NOPTS_VALUE) {
+                if (firstTimestamp == AV_NOPTS_VALUE) {
+                    firstTimestamp = timestamp;
+                }
+                videoTime = loopOffset + (timestamp - firstTimestamp) * av_q2d(timeBase);
+            }
+            else {
+                videoTime += frameDuration;
+            }
+
+            // Frames that are decoded ahead are shown at the time that is passed to
+            // update instead
+            if (_isPaced && _decodeAhead == 0 && timestamp != AV_NOPTS_VALUE) {
+                const auto now = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> offset(
+                    (timestamp - startTimestamp) * av_q2d(timeBase)
+                );
+                const auto due =
+                    start + std::chrono::duration_cast<std::chrono::nanoseconds>(offset);
+                if (startTimestamp == AV_NOPTS_VALUE || timestamp < startTimestamp ||
+                    due - now > MaxFrameGap)
+                {
+                    startTimestamp = timestamp;
+                    start = now;
+                }
+                else {
+                    std::this_thread::sleep_until(due);
+                }
+            }
+
+            store(*source, videoTime);
+            av_frame_unref(transferred);
+            av_frame_unref(frame);
+        }
+    };
+
+    while (_isRunning) {
+        int res = av_read_frame(_format, packet);
+        if (res < 0) {
+            if (res != AVERROR_EOF && res != AVERROR_EXIT) {
+                Log::Error(std::format(
+                    "Failed to read video '{}': {}", _url, errorString(res)
+                ));
+            }
+            // Drain the frames that are still buffered by the decoder
+            avcodec_send_packet(_codec, nullptr);
+            receiveFrames();
+            if (res != AVERROR_EOF || !_loop || !_isRunning) {
+                _hasEnded = res == AVERROR_EOF;
+                break;
+            }
+            av_seek_frame(_format, _streamIndex, 0, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(_codec);
+            startTimestamp = AV_NOPTS_VALUE;
+            loopOffset = videoTime + frameDuration;
+            continue;
+        }
+
+        if (packet->stream_index == _streamIndex) {
+            res = avcodec_send_packet(_codec, packet);
+            if (res < 0) {
+                Log::Warning(std::format(
+                    "Failed to decode video packet: {}", errorString(res)
+                ));
+            }
+            receiveFrames();
+        }
+        av_packet_unref(packet);
+    }
+
+    av_frame_free(&transferred);
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+}
+
+void VideoDecoder::store(const AVFrame& frame, double time) {
+    const AVFrame* f = &frame;
+    int nPlanes = numberOfPlanes(frame.format);
+    if (nPlanes == 0) {
+        // Other formats, such as the 10 bit formats of the hardware decoders, are
+        // converted into NV12 first
+        const AVPixelFormat format = static_cast<AVPixelFormat>(frame.format);
+        _conversion = sws_getCachedContext(
+            _conversion,
+            frame.width,
+            frame.height,
+            format,
+            frame.width,
+            frame.height,
+            AV_PIX_FMT_NV12,
+            SWS_BILINEAR,
+            nullptr,
+            nullptr,
+            nullptr
+        );
+        if (!_conversion) {
+            Log::Error("Could not create video frame conversion");
+            return;
+        }
+        if (!_converted) {
+            _converted = av_frame_alloc();
+        }
+        if (_converted->width != frame.width || _converted->height != frame.height) {
+            av_frame_unref(_converted);
+            _converted->format = AV_PIX_FMT_NV12;
+            _converted->width = frame.width;
+            _converted->height = frame.height;
+            if (av_frame_get_buffer(_converted, 0) < 0) {
+                Log::Error("Could not allocate video frame conversion");
+                av_frame_unref(_converted);
+                return;
+            }
+        }
+        sws_scale(
+            _conversion,
+            frame.data,
+            frame.linesize,
+            0,
+            frame.height,
+            _converted->data,
+            _converted->linesize
+        );
+        av_frame_copy_props(_converted, &frame);
+        f = _converted;
+        nPlanes = 2;
+    }
+
+    const int chromaRows = (f->height + 1) / 2;
+    std::array<size_t, 3> offsets = { 0, 0, 0 };
+    size_t size = 0;
+    for (int i = 0; i < nPlanes; i++) {
+        offsets[i] = size;
+        size += static_cast<size_t>(f->linesize[i]) * (i == 0 ? f->height : chromaRows);
+    }
+
+    auto findSlot = [this, size]() {
+        Slot* res = nullptr;
+        for (Slot& s : _slots) {
+            if (_isPersistent && s.capacity < size) {
+                continue;
+            }
+            if (s.state == Slot::State::Free) {
+                return &s;
+            }
+            // A frame that has not been uploaded yet is replaced, as it would be dropped
+            // in favor of this one anyway. Frames that are decoded ahead are kept
+            if (_decodeAhead == 0 && s.state == Slot::State::Filled &&
+                (!res || s.frame < res->frame))
+            {
+                res = &s;
+            }
+        }
+        return res;
+    };
+
+    Slot* slot = nullptr;
+    {
+        std::unique_lock lock(_mutex);
+        slot = findSlot();
+        if (!slot && _isPersistent && size > _requiredCapacity) {
+            // The buffers are reallocated by the rendering thread, so this frame is
+            // dropped unless the decoder waits for them
+            _requiredCapacity = size;
+        }
+        if (!slot && _decodeAhead > 0) {
+            _slotFreed.wait(lock, [&]() {
+                slot = findSlot();
+                return slot || !_isRunning;
+            });
+        }
+        if (!slot) {
+            return;
+        }
+        slot->state = Slot::State::Writing;
+    }
+
+    if (!_isPersistent) {
+        slot->data.resize(size);
+    }
+    std::byte* data = slot->mapping ? slot->mapping : slot->data.data();
+    for (int i = 0; i < nPlanes; i++) {
+        const size_t rows = i == 0 ? f->height : chromaRows;
+        std::memcpy(data + offsets[i], f->data[i], f->linesize[i] * rows);
+    }
+    const auto [kr, kb] = lumaCoefficients(*f);
+
+    std::lock_guard lock(_mutex);
+    slot->state = Slot::State::Filled;
+    slot->size = ivec2(f->width, f->height);
+    slot->nPlanes = nPlanes;
+    slot->offsets = offsets;
+    slot->strides = { f->linesize[0], f->linesize[1], f->linesize[2] };
+    slot->kr = kr;
+    slot->kb = kb;
+    slot->isFullRange =
+        f->color_range == AVCOL_RANGE_JPEG || frame.format == AV_PIX_FMT_YUVJ420P;
+    slot->time = time;
+    slot->frame = ++_frameCounter;
+}
+
+void VideoDecoder::allocate(Slot& slot, size_t capacity) {
+    // The decoding thread only writes into the buffers, so their content is never read
+    // back by the CPU
+    constexpr GLbitfield Flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glDeleteBuffers(1, &slot.pbo);
+    glGenBuffers(1, &slot.pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, Flags);
+    slot.mapping = reinterpret_cast<std::byte*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, Flags)
+    );
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    slot.capacity = slot.mapping ? capacity : 0;
+}
+
+void VideoDecoder::convert(const Slot& slot, int target) {
+    ZoneScoped;
+
+    if (_textures[target] == 0) {
+        glGenTextures(1, &_textures[target]);
+    }
+    glBindTexture(GL_TEXTURE_2D, _textures[target]);
+    if (_textureSizes[target] != slot.size) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RGBA8,
+            slot.size.x,
+            slot.size.y,
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        _textureSizes[target] = slot.size;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // The columns of the matrix are the contributions of Y, U, and V to RGB
+    const float kg = 1.f - slot.kr - slot.kb;
+    const float ys = slot.isFullRange ? 1.f : 255.f / 219.f;
+    const float cs = slot.isFullRange ? 1.f : 255.f / 224.f;
+    const std::array<float, 9> conversion = {
+        ys, ys, ys,
+        0.f, -2.f * slot.kb * (1.f - slot.kb) / kg * cs, 2.f * (1.f - slot.kb) * cs,
+        2.f * (1.f - slot.kr) * cs, -2.f * slot.kr * (1.f - slot.kr) / kg * cs, 0.f
+    };
+    const float yOffset = slot.isFullRange ? 0.f : 16.f / 255.f;
+
+    GLint prevFbo = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFbo);
+    std::array<GLint, 4> prevViewport;
+    glGetIntegerv(GL_VIEWPORT, prevViewport.data());
+    const GLboolean hasScissor = glIsEnabled(GL_SCISSOR_TEST);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _fbo);
+    glFramebufferTexture2D(
+        GL_DRAW_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        _textures[target],
+        0
+    );
+    glViewport(0, 0, slot.size.x, slot.size.y);
+    glDisable(GL_SCISSOR_TEST);
+
+    _shader.bind();
+    const vec2 size = vec2(static_cast<float>(slot.size.x), static_cast<float>(slot.size.y));
+    glUniform2f(_sizeLoc, size.x, size.y);
+    glUniform1i(_isPlanarLoc, slot.nPlanes == 3 ? 1 : 0);
+    glUniformMatrix3fv(_conversionLoc, 1, GL_FALSE, conversion.data());
+    glUniform3f(_offsetLoc, yOffset, 128.f / 255.f, 128.f / 255.f);
+    for (int i = 0; i < slot.nPlanes; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, _planes[i]);
+    }
+    glBindVertexArray(_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    for (int i = slot.nPlanes - 1; i >= 0; i--) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    ShaderProgram::unbind();
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFbo);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    if (hasScissor) {
+        glEnable(GL_SCISSOR_TEST);
+    }
+}
+
+#else // ^^^^ SGCT_HAS_VIDEO_CAPTURE // !SGCT_HAS_VIDEO_CAPTURE vvvv
+
+VideoDecoder::VideoDecoder(std::string url)
+    : VideoDecoder(std::move(url), Options())
+{}
+
+VideoDecoder::VideoDecoder(std::string url, Options options)
+    : _url(std::move(url))
+    , _loop(options.loop)
+    , _decodeAhead(options.decodeAhead)
+    , _isPersistent(false)
+{
+    throw Err(9032, "SGCT was compiled without support for video capture");
+}
+
+VideoDecoder::~VideoDecoder() {}
+
+bool VideoDecoder::update() {
+    return false;
+}
+
+bool VideoDecoder::update(double) {
+    return false;
+}
+
+unsigned int VideoDecoder::texture() const {
+    return 0;
+}
+
+ivec2 VideoDecoder::size() const {
+    return ivec2(0, 0);
+}
+
+const std::string& VideoDecoder::hardwareDevice() const {
+    return _hardwareDevice;
+}
+
+bool VideoDecoder::hasEnded() const {
+    return false;
+}
+
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+} // namespace sgct
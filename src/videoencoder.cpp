@@ -0,0 +1,342 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/videoencoder.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Image, code, msg)
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+namespace {
+    // The encoders that are tried in order. The hardware encoders come first, and the
+    // last entry is replaced by the default encoder of the codec, which usually is a
+    // software encoder
+    constexpr std::array<const char*, 5> H264Encoders = {
+        "h264_nvenc", "h264_amf", "h264_qsv", "h264_mf", "h264_videotoolbox"
+    };
+    constexpr std::array<const char*, 5> HEVCEncoders = {
+        "hevc_nvenc", "hevc_amf", "hevc_qsv", "hevc_mf", "hevc_videotoolbox"
+    };
+
+    // Returns the options that make the encoder return every frame as soon as it has been
+    // encoded. The encoders ignore the options that they do not know
+    AVDictionary* lowLatencyOptions(std::string_view encoder) {
+        AVDictionary* options = nullptr;
+        if (encoder.ends_with("_nvenc")) {
+            av_dict_set(&options, "tune", "ull", 0);
+            av_dict_set(&options, "zerolatency", "1", 0);
+            av_dict_set(&options, "delay", "0", 0);
+        }
+        else if (encoder.ends_with("_amf")) {
+            av_dict_set(&options, "usage", "ultralowlatency", 0);
+        }
+        else if (encoder.ends_with("_qsv")) {
+            av_dict_set(&options, "low_delay_brc", "1", 0);
+        }
+        else if (encoder.ends_with("_mf")) {
+            av_dict_set(&options, "scenario", "live_streaming", 0);
+        }
+        else if (encoder.ends_with("_videotoolbox")) {
+            av_dict_set(&options, "realtime", "1", 0);
+        }
+        else {
+            av_dict_set(&options, "preset", "veryfast", 0);
+            av_dict_set(&options, "tune", "zerolatency", 0);
+        }
+        return options;
+    }
+
+    std::string errorString(int error) {
+        std::array<char, AV_ERROR_MAX_STRING_SIZE> buffer = {};
+        av_strerror(error, buffer.data(), buffer.size());
+        return std::string(buffer.data());
+    }
+
+    // Returns the pixel format in which the frames are passed to the encoder. The
+    // downloaded pixels are used directly if the encoder accepts them
+    AVPixelFormat pixelFormat(const AVCodec& codec, AVPixelFormat source) {
+        if (!codec.pix_fmts) {
+            return AV_PIX_FMT_YUV420P;
+        }
+        for (const AVPixelFormat* f = codec.pix_fmts; *f != AV_PIX_FMT_NONE; f++) {
+            if (*f == source) {
+                return source;
+            }
+        }
+        // Formats that only exist on the GPU cannot be filled from memory
+        for (const AVPixelFormat* f = codec.pix_fmts; *f != AV_PIX_FMT_NONE; f++) {
+            const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(*f);
+            if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+                return *f;
+            }
+        }
+        return AV_PIX_FMT_NONE;
+    }
+} // namespace
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+namespace sgct {
+
+#ifdef SGCT_HAS_VIDEO_CAPTURE
+
+VideoEncoder::VideoEncoder(const std::filesystem::path& path, ivec2 size, int nChannels,
+                           Codec codec, int bitrate, int frameRate, Mode mode)
+    : _size(std::move(size))
+    , _nChannels(nChannels)
+{
+    ZoneScoped;
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    const std::string file = path.string();
+
+    // A URL has no extension from which the container could be guessed, and a transport
+    // stream can be joined by the receiver at any time
+    const char* container = nullptr;
+    if (mode == Mode::Stream) {
+        container = file.starts_with("rtp://") ? "rtp_mpegts" : "mpegts";
+    }
+    int res = avformat_alloc_output_context2(&_format, nullptr, container, file.c_str());
+    if (res < 0) {
+        throw Err(
+            9017,
+            std::format("Failed to create video file '{}': {}", file, errorString(res))
+        );
+    }
+
+    const AVPixelFormat source = _nChannels == 4 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_BGR24;
+    const std::array<const char*, 5>& names =
+        codec == Codec::H264 ? H264Encoders : HEVCEncoders;
+    const AVCodecID codecId = codec == Codec::H264 ? AV_CODEC_ID_H264 : AV_CODEC_ID_HEVC;
+
+    const AVCodec* encoder = nullptr;
+    for (size_t i = 0; i <= names.size() && !_codec; i++) {
+        encoder = i < names.size() ?
+            avcodec_find_encoder_by_name(names[i]) :
+            avcodec_find_encoder(codecId);
+        if (!encoder) {
+            continue;
+        }
+        const AVPixelFormat format = pixelFormat(*encoder, source);
+        if (format == AV_PIX_FMT_NONE) {
+            continue;
+        }
+
+        _codec = avcodec_alloc_context3(encoder);
+        _codec->width = _size.x;
+        _codec->height = _size.y;
+        _codec->pix_fmt = format;
+        _codec->bit_rate = static_cast<int64_t>(bitrate) * 1000;
+        _codec->time_base = AVRational{ 1, frameRate };
+        _codec->framerate = AVRational{ frameRate, 1 };
+        _codec->gop_size = frameRate;
+        if (_format->oformat->flags & AVFMT_GLOBALHEADER) {
+            _codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+        }
+        AVDictionary* options = nullptr;
+        if (mode == Mode::Stream) {
+            // B-frames hold back the frames they refer to, and a rate control buffer of
+            // one frame keeps every frame close to the size the network can send in the
+            // time of a frame
+            _codec->max_b_frames = 0;
+            _codec->flags |= AV_CODEC_FLAG_LOW_DELAY;
+            _codec->rc_max_rate = _codec->bit_rate;
+            _codec->rc_buffer_size = static_cast<int>(_codec->bit_rate / frameRate);
+            options = lowLatencyOptions(encoder->name);
+        }
+
+        // Opening a hardware encoder fails if the computer does not have the hardware
+        res = avcodec_open2(_codec, encoder, &options);
+        av_dict_free(&options);
+        if (res < 0) {
+            Log::Debug(std::format(
+                "Video encoder '{}' is not available: {}", encoder->name, errorString(res)
+            ));
+            avcodec_free_context(&_codec);
+        }
+    }
+    if (!_codec) {
+        avformat_free_context(_format);
+        throw Err(9017, std::format("No video encoder available for '{}'", file));
+    }
+
+    if (_codec->pix_fmt != source) {
+        _conversion = sws_getContext(
+            _size.x, _size.y, source,
+            _size.x, _size.y, _codec->pix_fmt,
+            SWS_BILINEAR, nullptr, nullptr, nullptr
+        );
+    }
+    Log::Info(std::format(
+        "Encoding {}x{} video '{}' with '{}' from {} pixels",
+        _size.x, _size.y, file, encoder->name,
+        _conversion ? "converted" : "BGR(A)"
+    ));
+
+    _stream = avformat_new_stream(_format, nullptr);
+    avcodec_parameters_from_context(_stream->codecpar, _codec);
+    _stream->time_base = _codec->time_base;
+    if (mode == Mode::Stream) {
+        // The packets are sent as soon as they are written instead of being buffered
+        _format->flags |= AVFMT_FLAG_FLUSH_PACKETS;
+        _format->max_delay = 0;
+    }
+
+    res = avio_open(&_format->pb, file.c_str(), AVIO_FLAG_WRITE);
+    if (res >= 0) {
+        res = avformat_write_header(_format, nullptr);
+    }
+    if (res < 0) {
+        sws_freeContext(_conversion);
+        avcodec_free_context(&_codec);
+        avio_closep(&_format->pb);
+        avformat_free_context(_format);
+        throw Err(
+            9017,
+            std::format("Failed to create video file '{}': {}", file, errorString(res))
+        );
+    }
+
+    _frame = av_frame_alloc();
+    _frame->format = _codec->pix_fmt;
+    _frame->width = _size.x;
+    _frame->height = _size.y;
+    av_frame_get_buffer(_frame, 0);
+    _packet = av_packet_alloc();
+}
+
+VideoEncoder::~VideoEncoder() {
+    ZoneScoped;
+
+    // Sending no frame tells the encoder to return all frames that it is still holding
+    avcodec_send_frame(_codec, nullptr);
+    try {
+        writePackets();
+    }
+    catch (const Error& e) {
+        Log::Error(e.message);
+    }
+    av_write_trailer(_format);
+
+    Log::Info(std::format("Encoded {} frames into '{}'", _nFrames, _format->url));
+
+    av_packet_free(&_packet);
+    av_frame_free(&_frame);
+    sws_freeContext(_conversion);
+    avcodec_free_context(&_codec);
+    avio_closep(&_format->pb);
+    avformat_free_context(_format);
+}
+
+void VideoEncoder::encode(const unsigned char* data) {
+    ZoneScoped;
+
+    // The encoder might still hold a reference to the previous frame
+    av_frame_make_writable(_frame);
+
+    // The rows of the downloaded pixels are stored from the bottom to the top, so they
+    // are read with a negative stride to flip the image
+    const int rowSize = _size.x * _nChannels;
+    const unsigned char* lastRow = data + static_cast<ptrdiff_t>(_size.y - 1) * rowSize;
+    if (_conversion) {
+        const std::array<const uint8_t*, 1> src = { lastRow };
+        const std::array<int, 1> stride = { -rowSize };
+        sws_scale(
+            _conversion,
+            src.data(),
+            stride.data(),
+            0,
+            _size.y,
+            _frame->data,
+            _frame->linesize
+        );
+    }
+    else {
+        for (int y = 0; y < _size.y; y++) {
+            std::memcpy(
+                _frame->data[0] + static_cast<ptrdiff_t>(y) * _frame->linesize[0],
+                lastRow - static_cast<ptrdiff_t>(y) * rowSize,
+                rowSize
+            );
+        }
+    }
+
+    _frame->pts = _nFrames;
+    _nFrames++;
+    const int res = avcodec_send_frame(_codec, _frame);
+    if (res < 0) {
+        throw Err(
+            9018,
+            std::format("Failed to encode video frame: {}", errorString(res))
+        );
+    }
+    writePackets();
+}
+
+void VideoEncoder::writePackets() {
+    while (true) {
+        int res = avcodec_receive_packet(_codec, _packet);
+        if (res == AVERROR(EAGAIN) || res == AVERROR_EOF) {
+            return;
+        }
+        if (res < 0) {
+            throw Err(
+                9018,
+                std::format("Failed to encode video frame: {}", errorString(res))
+            );
+        }
+
+        av_packet_rescale_ts(_packet, _codec->time_base, _stream->time_base);
+        _packet->stream_index = _stream->index;
+        res = av_interleaved_write_frame(_format, _packet);
+        if (res < 0) {
+            throw Err(
+                9018,
+                std::format("Failed to write video frame: {}", errorString(res))
+            );
+        }
+    }
+}
+
+#else // ^^^^ SGCT_HAS_VIDEO_CAPTURE // !SGCT_HAS_VIDEO_CAPTURE vvvv
+
+VideoEncoder::VideoEncoder(const std::filesystem::path&, ivec2 size, int nChannels,
+                           Codec, int, int, Mode)
+    : _size(std::move(size))
+    , _nChannels(nChannels)
+{
+    throw Err(9019, "SGCT was compiled without support for video capture");
+}
+
+VideoEncoder::~VideoEncoder() {}
+
+void VideoEncoder::encode(const unsigned char*) {}
+
+void VideoEncoder::writePackets() {}
+
+#endif // SGCT_HAS_VIDEO_CAPTURE
+
+} // namespace sgct
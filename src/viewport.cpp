@@ -10,6 +10,9 @@
 
 #include <sgct/clustermanager.h>
 #include <sgct/config.h>
+#include <sgct/engine.h>
+#include <sgct/format.h>
+#include <sgct/image.h>
 #include <sgct/log.h>
 #include <sgct/profiling.h>
 #include <sgct/screencapture.h>
@@ -23,6 +26,7 @@
 #include <algorithm>
 #include <array>
 #include <optional>
+#include <system_error>
 #include <variant>
 
 namespace {
@@ -39,6 +43,44 @@ namespace {
             default:                       throw std::logic_error("Unhandled case label");
         }
     }
+
+    std::unique_ptr<sgct::Image> decodeImage(const std::filesystem::path& path) {
+        if (path.empty()) {
+            return nullptr;
+        }
+        auto img = std::make_unique<sgct::Image>();
+        img->load(path);
+        return img;
+    }
+
+    std::optional<std::filesystem::file_time_type> lastWriteTime(
+                                                        const std::filesystem::path& path)
+    {
+        // The file might briefly be missing while it is replaced by a newer version
+        std::error_code ec;
+        const std::filesystem::file_time_type time =
+            std::filesystem::last_write_time(path, ec);
+        return ec ? std::nullopt : std::optional(time);
+    }
+
+    // Uploads the image that was decoded in advance or loads it from the file otherwise
+    unsigned int loadTexture(const std::filesystem::path& path,
+                             std::unique_ptr<sgct::Image>& image)
+    {
+        using namespace sgct;
+
+        TextureManager& mgr = TextureManager::instance();
+        if (!image) {
+            return mgr.loadTexture(path, true, 1);
+        }
+
+        const unsigned int t = mgr.loadTexture(*image, true, 1);
+        // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+        // formatting std::filesystem::path
+        Log::Debug(std::format("Texture created from '{}' [id={}]", path.string(), t));
+        image = nullptr;
+        return t;
+    }
 } // namespace
 
 namespace sgct {
@@ -64,10 +106,33 @@ Viewport::Viewport(const config::Viewport& viewport, const Window& parent)
         // If the user name is not empty, the User better exists
         _user = user;
     }
+    for (const std::string& name : viewport.users) {
+        User* user = ClusterManager::instance().user(name);
+        if (!user) {
+            Log::Warning(std::format("Could not find user with name '{}'", name));
+            continue;
+        }
+        _users.push_back(user);
+    }
+    if (!_users.empty()) {
+        _user = _users.front();
+    }
     assert(_user);
 
     _position = viewport.position.value_or(_position);
     _size = viewport.size.value_or(_size);
+    if (viewport.correctionMeshTolerance) {
+        _mesh.setSimplificationTolerance(*viewport.correctionMeshTolerance);
+    }
+    if (viewport.correctionMeshWarpMap) {
+        _mesh.setUseWarpMap(*viewport.correctionMeshWarpMap);
+    }
+    if (viewport.correctionMeshProcedural) {
+        _mesh.setUseProceduralMesh(*viewport.correctionMeshProcedural);
+    }
+    if (viewport.correctionMeshEditable) {
+        _mesh.setUseEditableMesh(*viewport.correctionMeshEditable);
+    }
 
     std::visit(overloaded {
         [](const config::NoProjection&) {},
@@ -86,6 +151,9 @@ Viewport::Viewport(const config::Viewport& viewport, const Window& parent)
         },
         [this](const config::TextureMappedProjection& p) {
             _useTextureMappedProjection = true;
+            if (p.baked.value_or(false)) {
+                _mesh.setUseWarpMap(true);
+            }
             setViewPlaneCoordsUsingFOVs(
                 p.fov.up,
                 p.fov.down,
@@ -142,28 +210,150 @@ void Viewport::initialize(vec2 size, bool hasStereo, unsigned int internalFormat
     }
 }
 
+void Viewport::prepareData() {
+    ZoneScoped;
+
+    _overlayImage = decodeImage(_overlayFilename);
+    _blendMaskImage = decodeImage(_blendMaskFilename);
+    _blackLevelMaskImage = decodeImage(_blackLevelMaskFilename);
+}
+
+JobSystem::Job Viewport::prepareMesh() {
+    ZoneScoped;
+
+    _meshWriteTime = lastWriteTime(_meshFilename);
+    if (!CorrectionMesh::isPreparable(_meshFilename)) {
+        return JobSystem::Job();
+    }
+
+    _meshPreparation = Engine::instance().jobSystem().submit([this]() {
+        _mesh.prepareMesh(_meshFilename, *this, _useTextureMappedProjection);
+    });
+    return *_meshPreparation;
+}
+
 void Viewport::loadData() {
     ZoneScoped;
 
-    TextureManager& mgr = TextureManager::instance();
     if (!_overlayFilename.empty()) {
-        _overlayTextureIndex = mgr.loadTexture(_overlayFilename, true, 1);
+        _overlayTextureIndex = loadTexture(_overlayFilename, _overlayImage);
     }
 
     if (!_blendMaskFilename.empty()) {
-        _blendMaskTextureIndex = mgr.loadTexture(_blendMaskFilename, true, 1);
+        _blendMaskTextureIndex = loadTexture(_blendMaskFilename, _blendMaskImage);
     }
 
     if (!_blackLevelMaskFilename.empty()) {
-        _blackLevelMaskTextureIndex = mgr.loadTexture(_blackLevelMaskFilename, true, 1);
+        _blackLevelMaskTextureIndex =
+            loadTexture(_blackLevelMaskFilename, _blackLevelMaskImage);
     }
 
-    _mesh.loadMesh(
-        _meshFilename,
-        *this,
-        hasBlendMaskTexture() || hasBlackLevelMaskTexture(),
-        _useTextureMappedProjection
-    );
+    if (_meshPreparation && !_meshPreparation->isFinished()) {
+        // The mesh is still being parsed, so the viewport is not warped until updateMesh
+        // loads it
+        _mesh.loadMesh(
+            std::filesystem::path(),
+            *this,
+            hasBlendMaskTexture() || hasBlackLevelMaskTexture(),
+            _useTextureMappedProjection
+        );
+    }
+    else {
+        loadMesh();
+    }
+    _lastMeshCheck = std::chrono::steady_clock::now();
+}
+
+void Viewport::updateMesh() {
+    ZoneScoped;
+
+    if (_meshPreparation && _meshPreparation->isFinished()) {
+        loadMesh();
+    }
+    _mesh.updateProceduralMesh(*this);
+
+    if (_meshFilename.empty() || _meshPreparation.has_value() ||
+        !Engine::instance().settings().watchCorrectionMeshes)
+    {
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - _lastMeshCheck < std::chrono::seconds(1)) {
+        return;
+    }
+    _lastMeshCheck = now;
+
+    const std::optional<std::filesystem::file_time_type> time =
+        lastWriteTime(_meshFilename);
+    if (!time || time == _meshWriteTime) {
+        return;
+    }
+
+    // @TODO: Remove `.string()` as soon as Clang on MacOS supports
+    // formatting std::filesystem::path
+    Log::Info(std::format("Reloading correction mesh '{}'", _meshFilename.string()));
+    // The previous mesh is kept until the changed file has been parsed in the background
+    prepareMesh();
+    if (!_meshPreparation) {
+        loadMesh();
+    }
+}
+
+void Viewport::loadMesh() {
+    ZoneScoped;
+
+    try {
+        if (_meshPreparation) {
+            // Rethrows the exception that the parsing of the mesh has thrown
+            const JobSystem::Job job = *_meshPreparation;
+            _meshPreparation = std::nullopt;
+            Engine::instance().jobSystem().wait(job);
+        }
+        _mesh.loadMesh(
+            _meshFilename,
+            *this,
+            hasBlendMaskTexture() || hasBlackLevelMaskTexture(),
+            _useTextureMappedProjection
+        );
+        _isMeshLoaded = true;
+    }
+    catch (const std::exception& e) {
+        if (!_isMeshLoaded) {
+            throw;
+        }
+        Log::Error(std::format(
+            "Could not reload correction mesh '{}': {}", _meshFilename.string(), e.what()
+        ));
+    }
+}
+
+void Viewport::setCorrectionMeshPoints(
+                                      std::span<const correction::WarpGrid::Point> points)
+{
+    if (!_mesh.hasProceduralMesh()) {
+        Log::Warning("Viewport has no procedural correction mesh");
+        return;
+    }
+    _mesh.setProceduralMeshPoints(points, *this);
+}
+
+std::span<const correction::WarpGrid::Point> Viewport::correctionMeshPoints() const {
+    return _mesh.proceduralMeshPoints();
+}
+
+void Viewport::setCorrectionMeshVertices(size_t first,
+                                 std::span<const correction::Buffer::Vertex> vertices)
+{
+    if (!_mesh.hasEditableMesh()) {
+        Log::Warning("Viewport has no editable correction mesh");
+        return;
+    }
+    _mesh.setWarpMeshVertices(first, vertices);
+}
+
+std::span<const correction::Buffer::Vertex> Viewport::correctionMeshVertices() const {
+    return _mesh.warpMeshVertices();
 }
 
 void Viewport::calculateFrustum(FrustumMode mode, float nearClip, float farClip) {
@@ -171,6 +361,11 @@ void Viewport::calculateFrustum(FrustumMode mode, float nearClip, float farClip)
         _nonLinearProjection->updateFrustums(mode, nearClip, farClip);
     }
     else {
+        if (!_users.empty()) {
+            // All nodes render the same frame, so they agree on the user of the frame
+            const unsigned int frame = Engine::instance().clusterFrameNumber();
+            _user = _users[frame % _users.size()];
+        }
         BaseViewport::calculateFrustum(mode, nearClip, farClip);
     }
 }
@@ -199,6 +394,10 @@ void Viewport::renderMaskMesh() const {
     }
 }
 
+void Viewport::bindWarpMap() const {
+    _mesh.bindWarpMap(_position, _size);
+}
+
 bool Viewport::hasOverlayTexture() const {
     return _overlayTextureIndex != 0;
 }
@@ -211,12 +410,25 @@ bool Viewport::hasBlackLevelMaskTexture() const {
     return _blackLevelMaskTextureIndex != 0;
 }
 
+bool Viewport::hasWarpMap() const {
+    return _mesh.hasWarpMap();
+}
+
+bool Viewport::hasCorrectionMesh() const {
+    return !_meshFilename.empty();
+}
+
 bool Viewport::hasSubViewports() const {
     return _nonLinearProjection != nullptr;
 }
 
 bool Viewport::isTracked() const {
-    return _isTracked;
+    // The frustums of viewports with several users change with the user of each frame
+    return _isTracked || !_users.empty();
+}
+
+const std::vector<User*>& Viewport::users() const {
+    return _users;
 }
 
 unsigned int Viewport::overlayTextureIndex() const {
@@ -235,4 +447,8 @@ NonLinearProjection* Viewport::nonLinearProjection() const {
     return _nonLinearProjection.get();
 }
 
+uint64_t Viewport::meshRevision() const {
+    return _mesh.revision();
+}
+
 } // namespace sgct
@@ -0,0 +1,291 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/vulkanimage.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <GLFW/glfw3.h>
+#include <stdexcept>
+
+namespace {
+    // The constants and functions of the GL_EXT_memory_object and GL_EXT_semaphore
+    // extensions and their platform variants, which are not part of the loader
+    constexpr GLenum DedicatedMemoryObject = 0x9581;
+    constexpr GLenum LayoutGeneral = 0x958D;
+    constexpr GLenum LayoutColorAttachment = 0x958E;
+    constexpr GLenum LayoutDepthStencilAttachment = 0x958F;
+    constexpr GLenum LayoutShaderReadOnly = 0x9591;
+
+    using CreateMemoryObjects = void(APIENTRY*)(GLsizei n, GLuint* memoryObjects);
+    using DeleteMemoryObjects = void(APIENTRY*)(GLsizei n, const GLuint* memoryObjects);
+    using MemoryObjectParameteriv =
+        void(APIENTRY*)(GLuint memoryObject, GLenum pname, const GLint* params);
+    using TexStorageMem2D =
+        void(APIENTRY*)(GLenum target, GLsizei levels, GLenum internalFormat,
+            GLsizei width, GLsizei height, GLuint memory, GLuint64 offset);
+    using GenSemaphores = void(APIENTRY*)(GLsizei n, GLuint* semaphores);
+    using DeleteSemaphores = void(APIENTRY*)(GLsizei n, const GLuint* semaphores);
+    using WaitSemaphore =
+        void(APIENTRY*)(GLuint semaphore, GLuint numBufferBarriers, const GLuint* buffers,
+            GLuint numTextureBarriers, const GLuint* textures, const GLenum* layouts);
+#ifdef WIN32
+    using ImportMemory =
+        void(APIENTRY*)(GLuint memory, GLuint64 size, GLenum handleType, void* handle);
+    using ImportSemaphore =
+        void(APIENTRY*)(GLuint semaphore, GLenum handleType, void* handle);
+    // GL_HANDLE_TYPE_OPAQUE_WIN32_EXT
+    constexpr GLenum HandleType = 0x9587;
+    constexpr const char* MemoryExtension = "GL_EXT_memory_object_win32";
+    constexpr const char* SemaphoreExtension = "GL_EXT_semaphore_win32";
+    constexpr const char* ImportMemoryName = "glImportMemoryWin32HandleEXT";
+    constexpr const char* ImportSemaphoreName = "glImportSemaphoreWin32HandleEXT";
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    using ImportMemory =
+        void(APIENTRY*)(GLuint memory, GLuint64 size, GLenum handleType, GLint fd);
+    using ImportSemaphore =
+        void(APIENTRY*)(GLuint semaphore, GLenum handleType, GLint fd);
+    // GL_HANDLE_TYPE_OPAQUE_FD_EXT
+    constexpr GLenum HandleType = 0x9586;
+    constexpr const char* MemoryExtension = "GL_EXT_memory_object_fd";
+    constexpr const char* SemaphoreExtension = "GL_EXT_semaphore_fd";
+    constexpr const char* ImportMemoryName = "glImportMemoryFdEXT";
+    constexpr const char* ImportSemaphoreName = "glImportSemaphoreFdEXT";
+#endif // WIN32
+
+    struct Functions {
+        CreateMemoryObjects createMemoryObjects = nullptr;
+        DeleteMemoryObjects deleteMemoryObjects = nullptr;
+        MemoryObjectParameteriv memoryObjectParameteriv = nullptr;
+        ImportMemory importMemory = nullptr;
+        TexStorageMem2D texStorageMem2D = nullptr;
+        GenSemaphores genSemaphores = nullptr;
+        DeleteSemaphores deleteSemaphores = nullptr;
+        ImportSemaphore importSemaphore = nullptr;
+        WaitSemaphore waitSemaphore = nullptr;
+        WaitSemaphore signalSemaphore = nullptr;
+    };
+
+    // The functions are loaded once, as all contexts that use the images share them
+    const Functions* functions() {
+        static const Functions Fns = []() {
+            Functions fns;
+            const bool hasExtensions =
+                glfwExtensionSupported("GL_EXT_memory_object") &&
+                glfwExtensionSupported(MemoryExtension) &&
+                glfwExtensionSupported("GL_EXT_semaphore") &&
+                glfwExtensionSupported(SemaphoreExtension);
+            if (!hasExtensions) {
+                return fns;
+            }
+
+            fns.createMemoryObjects = reinterpret_cast<CreateMemoryObjects>(
+                glfwGetProcAddress("glCreateMemoryObjectsEXT")
+            );
+            fns.deleteMemoryObjects = reinterpret_cast<DeleteMemoryObjects>(
+                glfwGetProcAddress("glDeleteMemoryObjectsEXT")
+            );
+            fns.memoryObjectParameteriv = reinterpret_cast<MemoryObjectParameteriv>(
+                glfwGetProcAddress("glMemoryObjectParameterivEXT")
+            );
+            fns.importMemory =
+                reinterpret_cast<ImportMemory>(glfwGetProcAddress(ImportMemoryName));
+            fns.texStorageMem2D = reinterpret_cast<TexStorageMem2D>(
+                glfwGetProcAddress("glTexStorageMem2DEXT")
+            );
+            fns.genSemaphores = reinterpret_cast<GenSemaphores>(
+                glfwGetProcAddress("glGenSemaphoresEXT")
+            );
+            fns.deleteSemaphores = reinterpret_cast<DeleteSemaphores>(
+                glfwGetProcAddress("glDeleteSemaphoresEXT")
+            );
+            fns.importSemaphore = reinterpret_cast<ImportSemaphore>(
+                glfwGetProcAddress(ImportSemaphoreName)
+            );
+            fns.waitSemaphore = reinterpret_cast<WaitSemaphore>(
+                glfwGetProcAddress("glWaitSemaphoreEXT")
+            );
+            fns.signalSemaphore = reinterpret_cast<WaitSemaphore>(
+                glfwGetProcAddress("glSignalSemaphoreEXT")
+            );
+            return fns;
+        }();
+
+        const bool isComplete = Fns.createMemoryObjects && Fns.deleteMemoryObjects &&
+            Fns.memoryObjectParameteriv && Fns.importMemory && Fns.texStorageMem2D &&
+            Fns.genSemaphores && Fns.deleteSemaphores && Fns.importSemaphore &&
+            Fns.waitSemaphore && Fns.signalSemaphore;
+        return isComplete ? &Fns : nullptr;
+    }
+
+    GLenum toGL(sgct::VulkanImage::Layout layout) {
+        using Layout = sgct::VulkanImage::Layout;
+        switch (layout) {
+            case Layout::General:                return LayoutGeneral;
+            case Layout::ColorAttachment:        return LayoutColorAttachment;
+            case Layout::DepthStencilAttachment: return LayoutDepthStencilAttachment;
+            case Layout::ShaderReadOnly:         return LayoutShaderReadOnly;
+            default: throw std::logic_error("Missing case label");
+        }
+    }
+
+    // Imports the semaphore with the handle, or returns 0 if there is none
+    GLuint importSemaphore(const Functions& fns, sgct::VulkanImage::Handle handle) {
+        if (handle == sgct::VulkanImage::NoHandle) {
+            return 0;
+        }
+        GLuint semaphore = 0;
+        fns.genSemaphores(1, &semaphore);
+        fns.importSemaphore(semaphore, HandleType, handle);
+        return semaphore;
+    }
+} // namespace
+
+namespace sgct {
+
+std::unique_ptr<VulkanImage> VulkanImage::import(const Info& info) {
+    ZoneScoped;
+
+    const Functions* fns = functions();
+    if (!fns) {
+        Log::Warning(std::format(
+            "GL_EXT_memory_object and GL_EXT_semaphore with {} and {} are not available "
+            "for the Vulkan image", MemoryExtension, SemaphoreExtension
+        ));
+        return nullptr;
+    }
+    if (info.memory == NoHandle || info.size.x <= 0 || info.size.y <= 0 ||
+        info.internalFormat == 0)
+    {
+        Log::Warning("Incomplete description of the Vulkan image to import");
+        return nullptr;
+    }
+
+    // Errors of earlier calls would be mistaken for the ones of the import
+    while (glGetError() != GL_NO_ERROR) {}
+
+    std::unique_ptr<VulkanImage> res = std::unique_ptr<VulkanImage>(new VulkanImage);
+    res->_size = info.size;
+    res->_readyLayout = toGL(info.readyLayout);
+    res->_releasedLayout = toGL(info.releasedLayout);
+
+    fns->createMemoryObjects(1, &res->_memory);
+    if (info.isDedicated) {
+        const GLint dedicated = GL_TRUE;
+        fns->memoryObjectParameteriv(res->_memory, DedicatedMemoryObject, &dedicated);
+    }
+    fns->importMemory(res->_memory, info.memorySize, HandleType, info.memory);
+
+    glGenTextures(1, &res->_texture);
+    glBindTexture(GL_TEXTURE_2D, res->_texture);
+    fns->texStorageMem2D(
+        GL_TEXTURE_2D,
+        1,
+        info.internalFormat,
+        info.size.x,
+        info.size.y,
+        res->_memory,
+        info.memoryOffset
+    );
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    res->_readySemaphore = importSemaphore(*fns, info.readySemaphore);
+    res->_releasedSemaphore = importSemaphore(*fns, info.releasedSemaphore);
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR) {
+        Log::Warning(std::format(
+            "Could not import the Vulkan image of {}x{} pixels (error {:#x})",
+            info.size.x, info.size.y, error
+        ));
+        return nullptr;
+    }
+
+    Log::Debug(std::format(
+        "Imported the Vulkan image of {}x{} pixels into texture {}",
+        info.size.x, info.size.y, res->_texture
+    ));
+    return res;
+}
+
+VulkanImage::~VulkanImage() {
+    const Functions* fns = functions();
+    glDeleteTextures(1, &_texture);
+    if (!fns) {
+        return;
+    }
+    if (_readySemaphore != 0) {
+        fns->deleteSemaphores(1, &_readySemaphore);
+    }
+    if (_releasedSemaphore != 0) {
+        fns->deleteSemaphores(1, &_releasedSemaphore);
+    }
+    if (_memory != 0) {
+        fns->deleteMemoryObjects(1, &_memory);
+    }
+}
+
+unsigned int VulkanImage::texture() const {
+    return _texture;
+}
+
+ivec2 VulkanImage::size() const {
+    return _size;
+}
+
+void VulkanImage::acquire() {
+    ZoneScoped;
+
+    if (_isAcquired) {
+        return;
+    }
+    if (_readySemaphore != 0) {
+        functions()->waitSemaphore(
+            _readySemaphore,
+            0,
+            nullptr,
+            1,
+            &_texture,
+            &_readyLayout
+        );
+    }
+    _isAcquired = true;
+}
+
+void VulkanImage::release() {
+    ZoneScoped;
+
+    if (!_isAcquired) {
+        return;
+    }
+    if (_releasedSemaphore != 0) {
+        functions()->signalSemaphore(
+            _releasedSemaphore,
+            0,
+            nullptr,
+            1,
+            &_texture,
+            &_releasedLayout
+        );
+        // The semaphore is only signaled once the commands reach the GPU, and the
+        // Vulkan renderer might be waiting for it before the next swap would flush them
+        glFlush();
+    }
+    _isAcquired = false;
+}
+
+bool VulkanImage::isAcquired() const {
+    return _isAcquired;
+}
+
+} // namespace sgct
@@ -12,6 +12,7 @@
 #include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
+#include <sgct/frameexport.h>
 #include <sgct/internalshaders.h>
 #include <sgct/log.h>
 #include <sgct/networkmanager.h>
@@ -20,12 +21,18 @@
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
 #include <sgct/screencapture.h>
+#ifdef SGCT_HAS_SPOUT
+#include <sgct/spoutsharedtexture.h>
+#endif // SGCT_HAS_SPOUT
 #include <sgct/statisticsrenderer.h>
 #include <sgct/texturemanager.h>
+#include <sgct/tracer.h>
+#include <sgct/vulkanimage.h>
 #include <sgct/projection/nonlinearprojection.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <algorithm>
+#include <cmath>
 
 #ifdef SGCT_HAS_SCALABLE
 #include "EasyBlendSDK.h"
@@ -101,6 +108,7 @@ namespace {
         using CBD = sgct::config::Window::ColorBitDepth;
         switch (cbd) {
             case CBD::Depth8:       return GL_RGBA8;
+            case CBD::Depth10:      return GL_RGB10_A2;
             case CBD::Depth16:      return GL_RGBA16;
             case CBD::Depth16Float: return GL_RGBA16F;
             case CBD::Depth32Float: return GL_RGBA32F;
@@ -116,6 +124,7 @@ namespace {
         using CBD = sgct::config::Window::ColorBitDepth;
         switch (cbd) {
             case CBD::Depth8:       return GL_UNSIGNED_BYTE;
+            case CBD::Depth10:      return GL_UNSIGNED_INT_2_10_10_10_REV;
             case CBD::Depth16:      return GL_UNSIGNED_SHORT;
             case CBD::Depth16Float: return GL_HALF_FLOAT;
             case CBD::Depth32Float: return GL_FLOAT;
@@ -131,6 +140,8 @@ namespace {
         using CBD = sgct::config::Window::ColorBitDepth;
         switch (cbd) {
             case CBD::Depth8:       return 1;
+            // The channels are packed, so they can't be downloaded into an image
+            case CBD::Depth10:      throw std::logic_error("Cannot capture 10 bits");
             case CBD::Depth16:      return 2;
             case CBD::Depth16Float: return 2;
             case CBD::Depth32Float: return 4;
@@ -142,6 +153,23 @@ namespace {
         }
     }
 
+    // Returns the bit depth of a stage of the pipeline, which defaults to the one of the
+    // final frame
+    sgct::config::Window::ColorBitDepth stageBitDepth(
+        const sgct::config::Window& window,
+        std::optional<sgct::config::Window::ColorBitDepth> stage)
+    {
+        using CBD = sgct::config::Window::ColorBitDepth;
+        return stage.value_or(window.bufferBitDepth.value_or(CBD::Depth8));
+    }
+
+    sgct::config::Window::ColorBitDepth captureBitDepth(const sgct::config::Window& w) {
+        using CBD = sgct::config::Window::ColorBitDepth;
+        const CBD depth = stageBitDepth(w, w.captureBitDepth);
+        // Packed 10 bit colors are captured with 16 bits instead
+        return depth == CBD::Depth10 ? CBD::Depth16 : depth;
+    }
+
     enum class BufferMode { BackBufferBlack, RenderToTexture };
     void setAndClearBuffer(const sgct::Window& window, BufferMode buffer,
                            sgct::FrustumMode frustum)
@@ -174,11 +202,90 @@ namespace {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         }
     }
+    // The stages of rendering a window in the shared context that are measured
+    constexpr int DrawStage = 0;
+    constexpr int NonLinearStage = 1;
+    constexpr int BlitStage = 2;
+    constexpr int FxaaStage = 3;
+
+    // Measures the GPU time of a stage from its creation until its destruction, unless
+    // the timer is a nullptr
+    struct GpuTimerScope {
+        GpuTimerScope(sgct::GpuTimer* timer_, int stage_)
+            : timer(timer_)
+            , stage(stage_)
+        {
+            if (timer) {
+                timer->begin(stage);
+            }
+        }
+
+        ~GpuTimerScope() {
+            if (timer) {
+                timer->end(stage);
+            }
+        }
+
+        sgct::GpuTimer* timer;
+        const int stage;
+    };
+
+    // Assigns the texture units that are bound before a warp map is applied
+    void setWarpMapUniforms(const sgct::ShaderProgram& program) {
+        glUniform1i(program.uniformLocation("tex"), 0);
+        glUniform1i(program.uniformLocation("warpTexCoords"), 1);
+        glUniform1i(program.uniformLocation("warpColors"), 2);
+        glUniform1i(program.uniformLocation("blendMask"), 3);
+        glUniform1i(program.uniformLocation("blackLevelMask"), 4);
+    }
+
+#ifdef WIN32
+    // The functions of the WGL_NV_gpu_affinity extension, which is not part of the loader
+    struct GpuDevice {
+        DWORD cb;
+        CHAR DeviceName[32];
+        CHAR DeviceString[128];
+        DWORD Flags;
+        RECT rcVirtualScreen;
+    };
+    using EnumGpus = BOOL(WINAPI*)(UINT gpuIndex, void** gpu);
+    using EnumGpuDevices = BOOL(WINAPI*)(void* gpu, UINT deviceIndex, GpuDevice* device);
+
+    // Returns the areas of the desktop (left, top, right, bottom) that the displays of
+    // the GPU cover, which is empty if the GPU does not exist, or std::nullopt if the
+    // extension is not available. This requires a current context
+    std::optional<std::vector<sgct::ivec4>> gpuDisplayAreas(int gpu) {
+        auto enumGpus = reinterpret_cast<EnumGpus>(wglGetProcAddress("wglEnumGpusNV"));
+        auto enumDevices = reinterpret_cast<EnumGpuDevices>(
+            wglGetProcAddress("wglEnumGpuDevicesNV")
+        );
+        if (!enumGpus || !enumDevices) {
+            return std::nullopt;
+        }
+
+        std::vector<sgct::ivec4> areas;
+        void* handle = nullptr;
+        if (!enumGpus(static_cast<UINT>(gpu), &handle)) {
+            return areas;
+        }
+        GpuDevice device = {};
+        device.cb = sizeof(GpuDevice);
+        for (UINT i = 0; enumDevices(handle, i, &device); i++) {
+            // The displays that are not part of the desktop have no meaningful area
+            if (device.Flags & DISPLAY_DEVICE_ATTACHED_TO_DESKTOP) {
+                const RECT& r = device.rcVirtualScreen;
+                areas.emplace_back(r.left, r.top, r.right, r.bottom);
+            }
+        }
+        return areas;
+    }
+#endif // WIN32
 } // namespace
 
 namespace sgct {
 
-GLFWwindow* _activeContext = nullptr;
+// The context that is current on each thread, windows may be rendered on other threads
+thread_local GLFWwindow* _activeContext = nullptr;
 
 bool Window::_useSwapGroups = false;
 bool Window::_isBarrierActive = false;
@@ -195,6 +302,16 @@ void Window::makeSharedContextCurrent() {
     glfwMakeContextCurrent(_sharedHandle);
 }
 
+void Window::releaseContext() {
+    ZoneScoped;
+
+    if (!_activeContext) {
+        return;
+    }
+    _activeContext = nullptr;
+    glfwMakeContextCurrent(nullptr);
+}
+
 void Window::initNvidiaSwapGroups() {
     ZoneScoped;
 
@@ -392,32 +509,56 @@ Window::Window(const config::Window& window)
     , _shouldRenderWhileHidden(window.alwaysRender.value_or(false))
     , _nAASamples(window.msaa.value_or(1))
     , _useFXAA(window.useFxaa.value_or(false))
+    , _useSmaa(window.useSmaa.value_or(false))
+    , _useTaa(window.useTaa.value_or(false))
+    , _swapInterval(window.swapInterval)
+    , _adaptiveSync(window.adaptiveSync)
     , _isDecorated(window.isDecorated.value_or(true))
     , _isResizable(window.isResizable.value_or(true))
     , _blitWindowId(window.blitWindowId.value_or(-1))
     , _monitorIndex(window.monitor.value_or(0))
+    , _gpu(window.gpu)
     , _mirrorX(window.mirrorX.value_or(false))
     , _mirrorY(window.mirrorY.value_or(false))
     , _noError(window.noError.value_or(false))
     , _isVisible(!window.isHidden.value_or(false))
     , _stereoMode(convert(window.stereo.value_or(config::Window::StereoMode::NoStereo)))
+    , _useSinglePassStereo(window.singlePassStereo.value_or(false))
     , _windowPos(window.pos)
     , _windowRes(window.size)
     , _framebufferRes(window.size)
+    , _unscaledFramebufferRes(window.size)
     , _aspectRatio(static_cast<float>(window.size.x) / static_cast<float>(window.size.y))
 #ifdef SGCT_HAS_SPOUT
     , _spoutEnabled(window.spout.has_value() && window.spout->enabled)
     , _spoutName(window.spout ? window.spout->name.value_or("") : "")
+    , _useSpoutSharedTexture(
+        window.spout && window.spout->sharedTexture.value_or(false)
+    )
 #endif // SGCT_HAS_SPOUT
     , _internalColorFormat(colorBitDepthToColorFormat(
-        window.bufferBitDepth.value_or(config::Window::ColorBitDepth::Depth8)
+        stageBitDepth(window, std::nullopt)
+    ))
+    , _colorDataType(colorBitDepthToDataType(stageBitDepth(window, std::nullopt)))
+    , _bytesPerColor(colorBitDepthToBytesPerColor(stageBitDepth(window, std::nullopt)))
+    , _cubemapColorFormat(colorBitDepthToColorFormat(
+        stageBitDepth(window, window.cubemapBitDepth)
     ))
-    , _colorDataType(colorBitDepthToDataType(
-        window.bufferBitDepth.value_or(config::Window::ColorBitDepth::Depth8)
+    , _cubemapDataType(colorBitDepthToDataType(
+        stageBitDepth(window, window.cubemapBitDepth)
     ))
-    , _bytesPerColor(colorBitDepthToBytesPerColor(
-        window.bufferBitDepth.value_or(config::Window::ColorBitDepth::Depth8)
+    , _intermediateColorFormat(colorBitDepthToColorFormat(
+        stageBitDepth(window, window.intermediateBitDepth)
     ))
+    , _intermediateDataType(colorBitDepthToDataType(
+        stageBitDepth(window, window.intermediateBitDepth)
+    ))
+    , _captureColorFormat(colorBitDepthToColorFormat(captureBitDepth(window)))
+    , _captureDataType(colorBitDepthToDataType(captureBitDepth(window)))
+    , _captureBytesPerColor(colorBitDepthToBytesPerColor(captureBitDepth(window)))
+    , _stream(window.stream)
+    , _draw2DRate(window.draw2DRate)
+    , _renderEvery(static_cast<unsigned int>(window.renderEvery.value_or(1)))
 {
     ZoneScoped;
 
@@ -428,6 +569,20 @@ Window::Window(const config::Window& window)
         setFixResolution(true);
     }
 
+    if (window.compositing) {
+        SortLastCompositor::Group group;
+        const std::vector<uint8_t>& nodes = window.compositing->nodes;
+        group.nodes.assign(nodes.begin(), nodes.end());
+        group.output = window.compositing->output;
+        _compositing = std::move(group);
+    }
+
+    if (window.frameExport && window.frameExport->enabled) {
+        _frameExportName = window.frameExport->name.value_or(
+            window.name.value_or(std::to_string(window.id))
+        );
+    }
+
 #ifdef SGCT_HAS_NDI
     if (window.ndi && window.ndi->enabled) {
         _ndiName = window.ndi->name.value_or(_ndiName);
@@ -480,6 +635,14 @@ Window::Window(const config::Window& window)
 void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
     ZoneScoped;
 
+    const bool isHeadless = Engine::instance().settings().headless;
+    if (isHeadless) {
+        // A headless window is only the render target of its framebuffer textures
+        _isVisible = false;
+        _shouldRenderWhileHidden = true;
+        _isFullScreen = false;
+    }
+
     {
         ZoneScopedN("Set GLFW settings");
         glfwWindowHint(GLFW_DEPTH_BITS, 32);
@@ -566,21 +729,12 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
     _scale.x = static_cast<float>(bufferSize.x) / static_cast<float>(_windowRes->x);
     _scale.y = static_cast<float>(bufferSize.y) / static_cast<float>(_windowRes->y);
     if (!_useFixResolution) {
-        _framebufferRes.x = bufferSize.x;
-        _framebufferRes.y = bufferSize.y;
+        _unscaledFramebufferRes.x = bufferSize.x;
+        _unscaledFramebufferRes.y = bufferSize.y;
+        applyResolutionScale();
     }
 
-    // Swap interval:
-    //  -1 = adaptive sync
-    //   0 = vertical sync off
-    //   1 = wait for vertical sync
-    //   2 = fix when using swapgroups in xp and running half the framerate
-
-    // If we would set multiple windows to use vsync, we would get a framerate of (monitor
-    // refreshrate)/(number of windows), which is something that might really slow down a
-    // multi-monitor application. Setting last window to the requested interval, which
-    // does mean all other windows will respect the last window in the pipeline.
-    glfwSwapInterval(isLastWindow ? Engine::instance().settings().swapInterval : 0);
+    setSwapInterval(_swapInterval, _adaptiveSync, isLastWindow);
 
     // if client, disable mouse pointer
     if (_hideMouseCursor || !Engine::instance().isMaster()) {
@@ -589,13 +743,16 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
 
     _hasFocus = glfwGetWindowAttrib(_windowHandle, GLFW_FOCUSED) == GLFW_TRUE;
 
-    const bool captureBackBuffer = Engine::instance().settings().captureBackBuffer;
-    int bytesPerColor = captureBackBuffer ? 1 : _bytesPerColor;
-    unsigned int colorDataType = captureBackBuffer ? GL_UNSIGNED_BYTE : _colorDataType;
+    const bool captureBackBuffer =
+        Engine::instance().settings().captureBackBuffer && !isHeadless;
+    int bytesPerColor = captureBackBuffer ? 1 : _captureBytesPerColor;
+    unsigned int colorDataType = captureBackBuffer ? GL_UNSIGNED_BYTE : _captureDataType;
+    unsigned int colorFormat = captureBackBuffer ? GL_RGBA8 : _captureColorFormat;
     if (!useRightEyeTexture()) {
         _screenCaptureLeftOrMono = std::make_unique<ScreenCapture>(
             *this,
             ScreenCapture::EyeIndex::Mono,
+            colorFormat,
             bytesPerColor,
             colorDataType,
             _hasAlpha
@@ -605,6 +762,7 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
         _screenCaptureLeftOrMono = std::make_unique<ScreenCapture>(
             *this,
             ScreenCapture::EyeIndex::StereoLeft,
+            colorFormat,
             bytesPerColor,
             colorDataType,
             _hasAlpha
@@ -612,11 +770,23 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
         _screenCaptureRight = std::make_unique<ScreenCapture>(
             *this,
             ScreenCapture::EyeIndex::Mono,
+            colorFormat,
             bytesPerColor,
             colorDataType,
             _hasAlpha
         );
     }
+    if (_stream) {
+        _streamCapture = std::make_unique<ScreenCapture>(
+            *this,
+            ScreenCapture::EyeIndex::Mono,
+            _internalColorFormat,
+            _bytesPerColor,
+            _colorDataType,
+            false,
+            &*_stream
+        );
+    }
     _finalFBO = std::make_unique<OffScreenBuffer>(_internalColorFormat);
 
     if (!_isFullScreen) {
@@ -660,6 +830,10 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
         );
     }
 
+    if (_gpu) {
+        placeOnGpu(*_gpu);
+    }
+
     const std::string title = std::format(
         "SGCT node: {} ({}: {})",
         ClusterManager::instance().thisNode().address(),
@@ -669,9 +843,10 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
 
     glfwSetWindowTitle(_windowHandle, _name.empty() ? title.c_str() : _name.c_str());
 
-    {
+    if (!isHeadless) {
         // swap the buffers and update the window
         ZoneScopedN("glfwSwapBuffers");
+        TraceScopedN("glfwSwapBuffers");
         glfwSwapBuffers(_windowHandle);
     }
 }
@@ -690,6 +865,9 @@ void Window::closeWindow() {
 #endif // SGCT_HAS_SCALABLE
 
 #ifdef SGCT_HAS_SPOUT
+    // The shared texture belongs to the sender, so it has to be closed first
+    _spoutTexture = nullptr;
+    glDeleteFramebuffers(1, &_spoutFbo);
     if (_spoutHandle) {
         _spoutHandle->ReleaseSender();
         _spoutHandle->Release();
@@ -711,6 +889,10 @@ void Window::closeWindow() {
     Log::Info(std::format("Deleting screen capture data for window {}", _id));
     _screenCaptureLeftOrMono = nullptr;
     _screenCaptureRight = nullptr;
+    _streamCapture = nullptr;
+    _frameExport = nullptr;
+
+    _sharedGpuTimer.destroy();
 
     // delete FBO stuff
     if (_finalFBO) {
@@ -718,6 +900,8 @@ void Window::closeWindow() {
         _finalFBO = nullptr;
         destroyFBOs();
     }
+    glDeleteFramebuffers(1, &_overlayLayer.fbo);
+    _overlayLayer.fbo = 0;
 
     Log::Info(std::format("Deleting VBOs for window {}", _id));
     glDeleteBuffers(1, &_vbo);
@@ -728,14 +912,25 @@ void Window::closeWindow() {
     _vao = 0;
 
     _fboQuad.deleteProgram();
+    _warpMapQuad.deleteProgram();
     _overlay.deleteProgram();
     _stereo.deleteProgram();
+    _preMask.coverageShader.deleteProgram();
+    _preMask.shader.deleteProgram();
+    glDeleteTextures(1, &_preMask.texture);
+    _preMask.texture = 0;
     if (_fxaa) {
         _fxaa->shader.deleteProgram();
+        _fxaa->fusedQuad.deleteProgram();
+        _fxaa->fusedWarpMapQuad.deleteProgram();
     }
+    _antiAliasing = nullptr;
 
     // Current handle must be set at the end to properly destroy the window
     makeOpenGLContextCurrent();
+    _windowGpuTimer.destroy();
+    glDeleteFramebuffers(1, &_preMask.fbo);
+    _preMask.fbo = 0;
 
     _viewports.clear();
 
@@ -756,10 +951,49 @@ void Window::closeWindow() {
 void Window::initialize() {
     ZoneScoped;
 
+    if (_blitWindowId != -1) {
+        // All windows of the node have been created before any of them is initialized
+        const std::vector<std::unique_ptr<Window>>& wins = Engine::instance().windows();
+        auto it = std::find_if(
+            wins.cbegin(),
+            wins.cend(),
+            [id = _blitWindowId](const std::unique_ptr<Window>& w) {
+                return w->id() == id;
+            }
+        );
+        assert(it != wins.cend());
+        _blitWindow = it->get();
+    }
+
+    if (_useSinglePassStereo) {
+        // The layered rendering needs all attachments to be texture arrays and the eye
+        // textures are views of their layers, so the features that use other textures
+        // fall back to rendering each eye separately
+        const Engine::Settings& settings = Engine::instance().settings();
+        _isSinglePassStereoSupported = GLAD_GL_VERSION_4_3 && _nAASamples <= 1 &&
+            !_useFXAA && !_useSmaa && !_useTaa && _blitWindowId == -1 &&
+            !settings.useNormalTexture && !settings.usePositionTexture;
+        if (!_isSinglePassStereoSupported) {
+            Log::Warning(std::format(
+                "Window {}: Single pass stereo requires OpenGL 4.3 and cannot be used "
+                "together with MSAA, FXAA, SMAA, TAA, blitting, or normal and position "
+                "textures",
+                _id
+            ));
+        }
+    }
+
+    if (_useSmaa || _useTaa) {
+        _antiAliasing = std::make_unique<AntiAliasing>(_useSmaa, _useTaa);
+    }
+
     createTextures();
     createVBOs();
 
     _finalFBO->createFBO(_framebufferRes.x, _framebufferRes.y, _nAASamples);
+    if (_draw2DRate) {
+        glGenFramebuffers(1, &_overlayLayer.fbo);
+    }
 
     Log::Debug(std::format(
         "Window {}: FBO initiated successfully. Number of samples: {}",
@@ -779,6 +1013,10 @@ void Window::initialize() {
         _screenCaptureRight->resize(res);
     }
 
+    if (_streamCapture) {
+        _streamCapture->resize(framebufferResolution());
+    }
+
     loadShaders();
 
 #ifdef SGCT_HAS_SPOUT
@@ -797,9 +1035,24 @@ void Window::initialize() {
         if (!success) {
             Log::Error(std::format("Error creating SPOUT handle for {}", _spoutName));
         }
+        else if (_useSpoutSharedTexture && _stereoMode != StereoMode::Active) {
+            _spoutTexture = SpoutSharedTexture::open(_spoutHandle, _spoutName);
+            if (_spoutTexture) {
+                glGenFramebuffers(1, &_spoutFbo);
+            }
+            else {
+                Log::Info(std::format(
+                    "Sending '{}' through Spout instead of its shared texture", _spoutName
+                ));
+            }
+        }
     }
 #endif // SGCT_HAS_SPOUT
 
+    if (_frameExportName) {
+        _frameExport = FrameExport::create(*_frameExportName, _framebufferRes);
+    }
+
     for (const std::unique_ptr<Viewport>& vp : _viewports) {
         const vec2 viewportSize = vec2{
             _framebufferRes.x * vp->size().x,
@@ -808,9 +1061,9 @@ void Window::initialize() {
         vp->initialize(
             viewportSize,
             _stereoMode != StereoMode::NoStereo,
-            _internalColorFormat,
+            _cubemapColorFormat,
             GL_BGRA,
-            _colorDataType,
+            _cubemapDataType,
             _nAASamples
         );
     }
@@ -843,6 +1096,93 @@ void Window::initializeContextSpecific() {
 #endif // SGCT_HAS_SCALABLE
 }
 
+void Window::placeOnGpu(int gpu) {
+    ZoneScoped;
+
+#ifdef WIN32
+    const std::optional<std::vector<ivec4>> areas = gpuDisplayAreas(gpu);
+    if (!areas) {
+        Log::Warning(std::format(
+            "Window {}: Cannot select GPU {} as WGL_NV_gpu_affinity is not available",
+            _id, gpu
+        ));
+        return;
+    }
+    if (areas->empty()) {
+        Log::Warning(std::format(
+            "Window {}: GPU {} does not exist or has no display", _id, gpu
+        ));
+        return;
+    }
+
+    // The driver renders the window on the GPU whose displays show most of it
+    ivec2 pos;
+    glfwGetWindowPos(_windowHandle, &pos.x, &pos.y);
+    ivec2 size;
+    glfwGetWindowSize(_windowHandle, &size.x, &size.y);
+    int64_t covered = 0;
+    for (const ivec4& area : *areas) {
+        const int w = std::min(pos.x + size.x, area.z) - std::max(pos.x, area.x);
+        const int h = std::min(pos.y + size.y, area.w) - std::max(pos.y, area.y);
+        covered += static_cast<int64_t>(std::max(w, 0)) * std::max(h, 0);
+    }
+    const int64_t total = static_cast<int64_t>(size.x) * size.y;
+    if (2 * covered > total) {
+        if (covered < total) {
+            Log::Warning(std::format(
+                "Window {}: Window extends beyond the displays of GPU {}, which copies "
+                "the parts on other displays between the GPUs", _id, gpu
+            ));
+        }
+        Log::Info(std::format("Window {}: Rendering on GPU {}", _id, gpu));
+        return;
+    }
+
+    const ivec4& display = areas->front();
+    if (_isFullScreen) {
+        int count = 0;
+        GLFWmonitor** monitors = glfwGetMonitors(&count);
+        for (int i = 0; i < count; i++) {
+            int x = 0;
+            int y = 0;
+            glfwGetMonitorPos(monitors[i], &x, &y);
+            if (x == display.x && y == display.y) {
+                glfwSetWindowMonitor(
+                    _windowHandle,
+                    monitors[i],
+                    0,
+                    0,
+                    size.x,
+                    size.y,
+                    GLFW_DONT_CARE
+                );
+                Log::Info(std::format(
+                    "Window {}: Using monitor {} of GPU {}", _id, i, gpu
+                ));
+                return;
+            }
+        }
+        Log::Warning(std::format(
+            "Window {}: No monitor found for the displays of GPU {}", _id, gpu
+        ));
+    }
+    else {
+        // Center the window on the first display of the GPU
+        const int x = display.x + std::max((display.z - display.x - size.x) / 2, 0);
+        const int y = display.y + std::max((display.w - display.y - size.y) / 2, 0);
+        glfwSetWindowPos(_windowHandle, x, y);
+        Log::Info(std::format(
+            "Window {}: Moved to ({}, {}) to render on GPU {}", _id, x, y, gpu
+        ));
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    Log::Warning(std::format(
+        "Window {}: Selecting GPU {} is only supported on Windows. Use a separate node "
+        "for each GPU instead", _id, gpu
+    ));
+#endif // WIN32
+}
+
 void Window::updateResolutions() {
     ZoneScoped;
 
@@ -891,8 +1231,19 @@ void Window::updateResolutions() {
 #endif // SGCT_HAS_NDI
     }
 
+    // While a window is resized interactively, its framebuffer keeps the previous
+    // resolution until the size has not changed for the resize delay, so that the
+    // textures are only recreated once and the frame is stretched to the window until
+    // then
+    const std::optional<double>& delay = Engine::instance().settings().resizeDelay;
+    if (_pendingFramebufferRes && delay && time() - _framebufferResTime < *delay) {
+        return;
+    }
+
     if (_pendingFramebufferRes) {
-        _framebufferRes = *_pendingFramebufferRes;
+        _unscaledFramebufferRes = *_pendingFramebufferRes;
+        _windowResChanged = true;
+        applyResolutionScale();
 
         Log::Debug(std::format(
             "Framebuffer resolution changed to {}x{} for window {}",
@@ -906,12 +1257,34 @@ void Window::updateResolutions() {
 void Window::update() {
     ZoneScoped;
 
+    if (_pendingResolutionScale && _isVisible) {
+        _resolutionScale = *_pendingResolutionScale;
+        _pendingResolutionScale = std::nullopt;
+        applyResolutionScale();
+
+        Log::Debug(std::format(
+            "Framebuffer resolution scaled by {} to {}x{} for window {}",
+            _resolutionScale, _framebufferRes.x, _framebufferRes.y, _id
+        ));
+
+        // The buffers are recreated in the same way as when the window is resized
+        _windowResChanged = true;
+        _isResolutionScaleChanged = true;
+    }
+
     if (!_isVisible || !isWindowResized()) {
         return;
     }
     makeOpenGLContextCurrent();
 
-    resizeFBOs();
+    // The textures only have to be recreated if the framebuffer resolution has changed,
+    // which it has not if only the window was resized, for example while the resize of
+    // the framebuffer is delayed or if the window has a fixed resolution
+    const bool isFramebufferResized = _framebufferRes != _textureResolution;
+    if (isFramebufferResized) {
+        resizeFBOs();
+    }
+    _isResolutionScaleChanged = false;
 
     const ivec2 res =
         Engine::instance().settings().captureBackBuffer ?
@@ -923,10 +1296,19 @@ void Window::update() {
     if (_screenCaptureRight) {
         _screenCaptureRight->resize(res);
     }
+    if (_streamCapture) {
+        _streamCapture->resize(framebufferResolution());
+    }
+    if (_frameExport && _frameExport->size() != framebufferResolution()) {
+        // The consumers are disconnected, as the images are replaced. The old export has
+        // to be closed first, as the new one uses the same name
+        _frameExport = nullptr;
+        _frameExport = FrameExport::create(*_frameExportName, framebufferResolution());
+    }
 
     // resize non linear projection buffers
     for (const std::unique_ptr<Viewport>& vp : _viewports) {
-        if (vp->hasSubViewports()) {
+        if (isFramebufferResized && vp->hasSubViewports()) {
             const vec2 viewport = vec2{
                 _framebufferRes.x * vp->size().x,
                 _framebufferRes.y * vp->size().y
@@ -938,10 +1320,23 @@ void Window::update() {
 
 void Window::draw() {
     ZoneScopedN("Render window");
+    TraceScopedN("Render window");
 
     if (!(isVisible() || isRenderingWhileHidden())) [[unlikely]] {
         return;
     }
+    if (isSamplingBlitWindow()) {
+        // The blitted window's texture is warped onto this window directly
+        return;
+    }
+
+    _viewportDrawTimes.assign(_viewports.size(), 0.0);
+    _isMeasuringGpuTimes = Engine::instance().statisticsRenderer() != nullptr ||
+        Engine::instance().settings().benchmark.has_value();
+    if (_isMeasuringGpuTimes) [[unlikely]] {
+        _sharedGpuTimer.beginFrame();
+    }
+    const GpuTimerScope timer(sharedGpuTimer(), DrawStage);
 
     // Render Left/Mono non-linear projection viewports to cubemap
     for (const std::unique_ptr<Viewport>& vp : viewports()) {
@@ -952,13 +1347,15 @@ void Window::draw() {
         }
 
         NonLinearProjection* nonLinearProj = vp->nonLinearProjection();
+        const double callbackTime = Engine::instance().drawCallbackTime();
         if (_stereoMode == Window::StereoMode::NoStereo) {
             // for mono viewports frustum mode can be selected by user or config
-            nonLinearProj->renderCubemap(vp->eye());
+            nonLinearProj->prepareCubemap(vp->eye());
         }
         else {
-            nonLinearProj->renderCubemap(FrustumMode::StereoLeft);
+            nonLinearProj->prepareCubemap(FrustumMode::StereoLeft);
         }
+        addViewportDrawTime(*vp, callbackTime);
     }
 
     // Render left/mono regular viewports to FBO
@@ -969,6 +1366,10 @@ void Window::draw() {
         // if we are not rendering in stereo, we are done
         return;
     }
+    else if (isSinglePassStereo()) {
+        renderSinglePassStereo();
+        renderViewports(FrustumMode::StereoLeft, Eye::MonoOrLeft, true);
+    }
     else {
         renderViewports(FrustumMode::StereoLeft, Eye::MonoOrLeft);
     }
@@ -980,7 +1381,9 @@ void Window::draw() {
             continue;
         }
         NonLinearProjection* p = vp->nonLinearProjection();
-        p->renderCubemap(FrustumMode::StereoRight);
+        const double callbackTime = Engine::instance().drawCallbackTime();
+        p->prepareCubemap(FrustumMode::StereoRight);
+        addViewportDrawTime(*vp, callbackTime);
     }
 
     // Render right regular viewports to FBO
@@ -989,8 +1392,37 @@ void Window::draw() {
         renderViewports(FrustumMode::StereoRight, Eye::MonoOrLeft);
     }
     else {
-        renderViewports(FrustumMode::StereoRight, Eye::Right);
+        renderViewports(FrustumMode::StereoRight, Eye::Right, isSinglePassStereo());
+    }
+}
+
+void Window::renderTiledScreenshot(ivec2 tiles) {
+    ZoneScoped;
+
+    if (!_screenCaptureLeftOrMono) {
+        return;
+    }
+    const bool hasNonLinear = std::any_of(
+        _viewports.cbegin(),
+        _viewports.cend(),
+        [](const std::unique_ptr<Viewport>& vp) { return vp->hasSubViewports(); }
+    );
+    if (hasNonLinear) {
+        Log::Warning(std::format(
+            "Window {}: Tiled screenshots cannot be taken of non-linear projections", _id
+        ));
+        return;
     }
+
+    _screenCaptureLeftOrMono->saveTiledScreenCapture(
+        _frameBufferTextures.leftEye,
+        tiles,
+        [this, tiles](ivec2 tile) {
+            _screenshotTile = ScreenshotTile{ .index = tile, .count = tiles };
+            draw();
+        }
+    );
+    _screenshotTile = std::nullopt;
 }
 
 void Window::renderFBOTexture() {
@@ -1004,6 +1436,22 @@ void Window::renderFBOTexture() {
 
     makeOpenGLContextCurrent();
 
+    // Meshes that have been parsed in the background or changed on disk are loaded here
+    // as they have to be created in this window's context
+    for (const std::unique_ptr<Viewport>& vp : _viewports) {
+        vp->updateMesh();
+    }
+    // The scene of this frame has already been rendered, so a changed pre-mask is used
+    // from the next frame on
+    updatePreMask();
+
+    GpuTimer* gpuTimer = nullptr;
+    if (_isMeasuringGpuTimes) [[unlikely]] {
+        _windowGpuTimer.beginFrame();
+        gpuTimer = &_windowGpuTimer;
+    }
+    const GpuTimerScope timer(gpuTimer, 0);
+
     glDisable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -1022,36 +1470,76 @@ void Window::renderFBOTexture() {
 
     bool maskShaderSet = false;
     const std::vector<std::unique_ptr<Viewport>>& vps = _viewports;
-    if (_stereoMode > Window::StereoMode::Active &&
-        _stereoMode < Window::StereoMode::SideBySide)
-    {
+    const bool isInterleavedStereo = _stereoMode > Window::StereoMode::Active &&
+        _stereoMode < Window::StereoMode::SideBySide;
+    if (isInterleavedStereo) {
         _stereo.bind();
 
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, _frameBufferTextures.leftEye);
+        glBindTexture(GL_TEXTURE_2D, compositeTexture(Eye::MonoOrLeft));
 
         glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, _frameBufferTextures.rightEye);
+        glBindTexture(GL_TEXTURE_2D, compositeTexture(Eye::Right));
 
         std::for_each(vps.begin(), vps.end(), std::mem_fn(&Viewport::renderWarpMesh));
     }
     else {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, _frameBufferTextures.leftEye);
+        const bool isFused = isFxaaFused();
+        const ShaderProgram& quad = isFused ? _fxaa->fusedQuad : _fboQuad;
+        const ShaderProgram& warpMapQuad =
+            isFused ? _fxaa->fusedWarpMapQuad : _warpMapQuad;
+        const ivec2 fbRes = framebufferResolution();
+        auto setFrameUniforms = [this, isFused, fbRes](const ShaderProgram& program) {
+            glUniform1i(program.uniformLocation("flipX"), _mirrorX ? 1 : 0);
+            glUniform1i(program.uniformLocation("flipY"), _mirrorY ? 1 : 0);
+            if (isFused) {
+                const float w = static_cast<float>(fbRes.x);
+                const float h = static_cast<float>(fbRes.y);
+                glUniform1f(program.uniformLocation("rt_w"), w);
+                glUniform1f(program.uniformLocation("rt_h"), h);
+            }
+        };
 
-        _fboQuad.bind();
-        maskShaderSet = true;
+        // Viewports with a warp map apply the warping and their masks in a single pass
+        // over their quad with a separate shader
+        auto renderWarp = [&vps, &quad, &warpMapQuad, &setFrameUniforms]() {
+            for (const std::unique_ptr<Viewport>& vp : vps) {
+                if (!vp->hasWarpMap() || !vp->isEnabled()) {
+                    vp->renderWarpMesh();
+                    continue;
+                }
 
-        glUniform1i(
-            glGetUniformLocation(_fboQuad.id(), "flipX"),
-            _mirrorX ? 1 : 0
-        );
-        glUniform1i(
-            glGetUniformLocation(_fboQuad.id(), "flipY"),
-            _mirrorY ? 1 : 0
-        );
+                vp->bindWarpMap();
+                warpMapQuad.bind();
+                setFrameUniforms(warpMapQuad);
+                glUniform1i(
+                    warpMapQuad.uniformLocation("hasBlendMask"),
+                    vp->hasBlendMaskTexture() ? 1 : 0
+                );
+                glUniform1i(
+                    warpMapQuad.uniformLocation("hasBlackLevelMask"),
+                    vp->hasBlackLevelMaskTexture() ? 1 : 0
+                );
+                glActiveTexture(GL_TEXTURE3);
+                glBindTexture(GL_TEXTURE_2D, vp->blendMaskTextureIndex());
+                glActiveTexture(GL_TEXTURE4);
+                glBindTexture(GL_TEXTURE_2D, vp->blackLevelMaskTextureIndex());
+                glActiveTexture(GL_TEXTURE0);
 
-        std::for_each(vps.begin(), vps.end(), std::mem_fn(&Viewport::renderWarpMesh));
+                vp->renderQuadMesh();
+                quad.bind();
+            }
+        };
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, compositeTexture(Eye::MonoOrLeft));
+
+        quad.bind();
+        // The masks must not be antialiased, so they need the regular shader
+        maskShaderSet = !isFused;
+        setFrameUniforms(quad);
+
+        renderWarp();
 
         // render right eye in active stereo mode
         if (_stereoMode == Window::StereoMode::Active) {
@@ -1064,8 +1552,8 @@ void Window::renderFBOTexture() {
                 FrustumMode::StereoRight
             );
 
-            glBindTexture(GL_TEXTURE_2D, _frameBufferTextures.rightEye);
-            std::for_each(vps.begin(), vps.end(), std::mem_fn(&Viewport::renderWarpMesh));
+            glBindTexture(GL_TEXTURE_2D, compositeTexture(Eye::Right));
+            renderWarp();
         }
     }
 
@@ -1074,8 +1562,8 @@ void Window::renderFBOTexture() {
         if (!maskShaderSet) {
             _fboQuad.bind();
 
-            glUniform1i(glGetUniformLocation(_fboQuad.id(), "flipX"), _mirrorX ? 1 : 0);
-            glUniform1i(glGetUniformLocation(_fboQuad.id(), "flipY"), _mirrorY ? 1 : 0);
+            glUniform1i(_fboQuad.uniformLocation("flipX"), _mirrorX ? 1 : 0);
+            glUniform1i(_fboQuad.uniformLocation("flipY"), _mirrorY ? 1 : 0);
         }
 
         glDrawBuffer(GL_BACK);
@@ -1089,6 +1577,10 @@ void Window::renderFBOTexture() {
         for (const std::unique_ptr<Viewport>& vp : _viewports) {
             ZoneScopedN("Render Viewport");
 
+            if (!isInterleavedStereo && vp->hasWarpMap()) {
+                // The masks have already been applied together with the warp map
+                continue;
+            }
             if (vp->hasBlendMaskTexture() && vp->isEnabled()) {
                 glBindTexture(GL_TEXTURE_2D, vp->blendMaskTextureIndex());
                 vp->renderMaskMesh();
@@ -1106,7 +1598,35 @@ void Window::renderFBOTexture() {
     glDisable(GL_BLEND);
 
 #ifdef SGCT_HAS_SPOUT
-    if (_spoutHandle) {
+    if (_spoutTexture && _spoutTexture->lock()) {
+        // The window is blitted straight into the texture that the receivers read, which
+        // replaces Spout's copy of the texture that would otherwise have to be sent
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _spoutFbo);
+        glFramebufferTexture2D(
+            GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            _spoutTexture->texture(),
+            0
+        );
+        // DirectX stores the rows from the top, so the image is flipped
+        glBlitFramebuffer(
+            0,
+            0,
+            _framebufferRes.x,
+            _framebufferRes.y,
+            0,
+            _framebufferRes.y,
+            _framebufferRes.x,
+            0,
+            GL_COLOR_BUFFER_BIT,
+            GL_NEAREST
+        );
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        _spoutTexture->unlock();
+    }
+    else if (_spoutHandle) {
         // Share the window via Spout
         glBindTexture(GL_TEXTURE_2D, _frameBufferTextures.leftEye);
         glCopyTexImage2D(
@@ -1175,9 +1695,14 @@ void Window::renderFBOTexture() {
             &_videoBufferPing;
     }
 #endif // SGCT_HAS_NDI
+
+    if (_frameExport) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        _frameExport->exportFrame(Engine::instance().clusterFrameNumber());
+    }
 }
 
-void Window::swapBuffers(bool takeScreenshot) {
+void Window::swapBuffers(bool takeScreenshot, bool shouldPresent) {
     if (!(_isVisible || _shouldRenderWhileHidden)) {
         return;
     }
@@ -1186,7 +1711,12 @@ void Window::swapBuffers(bool takeScreenshot) {
 
     if (takeScreenshot) {
         ZoneScopedN("Take Screenshot");
-        if (Engine::instance().settings().captureBackBuffer) {
+        // This window's own framebuffer texture is not rendered while it samples the
+        // blitted window, but the back buffer shows the same
+        const Engine::Settings& settings = Engine::instance().settings();
+        const bool captureBackBuffer =
+            (settings.captureBackBuffer && !settings.headless) || isSamplingBlitWindow();
+        if (captureBackBuffer) {
             if (_screenCaptureLeftOrMono) {
                 _screenCaptureLeftOrMono->saveScreenCapture(
                     0,
@@ -1204,16 +1734,57 @@ void Window::swapBuffers(bool takeScreenshot) {
         }
         else {
             if (_screenCaptureLeftOrMono) {
-                _screenCaptureLeftOrMono->saveScreenCapture(_frameBufferTextures.leftEye);
+                // The geometry buffer is only rendered for one of the eyes in stereo,
+                // so it is only saved with the screenshots of mono windows
+                const ScreenCapture::GeometryTextures geometry =
+                    useRightEyeTexture() ?
+                    ScreenCapture::GeometryTextures{ 0, 0, 0 } :
+                    ScreenCapture::GeometryTextures{
+                        frameBufferDepthTexture(Eye::MonoOrLeft),
+                        _frameBufferTextures.normals,
+                        _frameBufferTextures.positions
+                    };
+                _screenCaptureLeftOrMono->saveScreenCapture(
+                    frameBufferTextureEye(Eye::MonoOrLeft),
+                    ScreenCapture::CaptureSource::Texture,
+                    geometry
+                );
             }
             if (_screenCaptureRight && _stereoMode > StereoMode::NoStereo &&
                 _stereoMode < Window::StereoMode::SideBySide)
             {
-                _screenCaptureRight->saveScreenCapture(_frameBufferTextures.rightEye);
+                _screenCaptureRight->saveScreenCapture(frameBufferTextureEye(Eye::Right));
             }
         }
     }
 
+    // The stream skips the frames that exceed its frame rate by itself
+    if (_streamCapture) {
+        _streamCapture->saveScreenCapture(frameBufferTextureEye(Eye::MonoOrLeft));
+    }
+
+    // The Vulkan renderer can render into its images again once they have been warped
+    // and captured
+    for (const VulkanImages& images : _vulkanImages) {
+        if (images.color) {
+            images.color->release();
+        }
+        if (images.depth) {
+            images.depth->release();
+        }
+    }
+
+    // The screenshots of the previous frames are saved as soon as they were downloaded
+    if (_screenCaptureLeftOrMono) {
+        _screenCaptureLeftOrMono->update();
+    }
+    if (_screenCaptureRight) {
+        _screenCaptureRight->update();
+    }
+    if (_streamCapture) {
+        _streamCapture->update();
+    }
+
     // swap
     _windowResChanged = false;
 
@@ -1225,10 +1796,24 @@ void Window::swapBuffers(bool takeScreenshot) {
     }
 #endif // SGCT_HAS_SCALABLE
 
-    {
-        ZoneScopedN("glfwSwapBuffers");
-        glfwSwapBuffers(_windowHandle);
+    if (shouldPresent) {
+        present();
+    }
+    else {
+        // The swap on the other thread does not flush the commands of this context
+        glFlush();
+    }
+}
+
+void Window::present() {
+    if (Engine::instance().settings().headless) {
+        // Nothing is presented, so there is no reason to wait for the compositor
+        return;
     }
+
+    ZoneScopedN("glfwSwapBuffers");
+    TraceScopedN("glfwSwapBuffers");
+    glfwSwapBuffers(_windowHandle);
 }
 
 void Window::makeOpenGLContextCurrent() {
@@ -1242,6 +1827,24 @@ void Window::makeOpenGLContextCurrent() {
     glfwMakeContextCurrent(_windowHandle);
 }
 
+Window::GpuTimes Window::gpuTimes() const {
+    return {
+        .draw = _sharedGpuTimer.time(DrawStage),
+        .nonLinearProjection = _sharedGpuTimer.time(NonLinearStage),
+        .blit = _sharedGpuTimer.time(BlitStage),
+        .fxaa = _sharedGpuTimer.time(FxaaStage),
+        .composite = _windowGpuTimer.time(0)
+    };
+}
+
+const std::vector<double>& Window::viewportDrawTimes() const {
+    return _viewportDrawTimes;
+}
+
+GpuTimer* Window::sharedGpuTimer() const {
+    return _isMeasuringGpuTimes ? &_sharedGpuTimer : nullptr;
+}
+
 bool Window::needsCompatibilityProfile() const {
     return !_scalableMesh.path.empty();
 }
@@ -1250,6 +1853,26 @@ bool Window::shouldTakeScreenshot() const {
     return _takeScreenshot;
 }
 
+int Window::nQueuedScreenshots() const {
+    int res = 0;
+    if (_screenCaptureLeftOrMono) {
+        res += _screenCaptureLeftOrMono->queueDepth();
+    }
+    if (_screenCaptureRight) {
+        res += _screenCaptureRight->queueDepth();
+    }
+    return res;
+}
+
+void Window::flushScreenshots() {
+    if (_screenCaptureLeftOrMono) {
+        _screenCaptureLeftOrMono->flush();
+    }
+    if (_screenCaptureRight) {
+        _screenCaptureRight->flush();
+    }
+}
+
 vec2 Window::scale() const {
     return _scale;
 }
@@ -1301,6 +1924,7 @@ void Window::renderScreenQuad() const {
 void Window::setFramebufferResolution(ivec2 resolution) {
     if (!_useFixResolution) {
         _pendingFramebufferRes = std::move(resolution);
+        _framebufferResTime = time();
     }
 }
 
@@ -1308,15 +1932,46 @@ ivec2 Window::framebufferResolution() const {
     return _framebufferRes;
 }
 
-bool Window::isWindowResized() const {
-    return _windowResChanged;
-}
-
-bool Window::isFocused() const {
-    return _hasFocus;
-}
-
-int Window::id() const {
+void Window::setResolutionScale(float scale) {
+#ifdef SGCT_HAS_SPOUT
+    if (_spoutEnabled) {
+        return;
+    }
+#endif // SGCT_HAS_SPOUT
+#ifdef SGCT_HAS_NDI
+    if (_ndiHandle) {
+        return;
+    }
+#endif // SGCT_HAS_NDI
+
+    if (scale != _pendingResolutionScale.value_or(_resolutionScale)) {
+        _pendingResolutionScale = scale;
+    }
+}
+
+float Window::resolutionScale() const {
+    return _resolutionScale;
+}
+
+bool Window::isWindowResized() const {
+    return _windowResChanged;
+}
+
+bool Window::shouldRender(unsigned int frame, bool isUnchanged) {
+    _isOutdated = _isOutdated || !isUnchanged;
+    // Offset by the id, so that windows with the same divisor take turns
+    if (!_isOutdated || (frame + static_cast<unsigned int>(_id)) % _renderEvery != 0) {
+        return false;
+    }
+    _isOutdated = false;
+    return true;
+}
+
+bool Window::isFocused() const {
+    return _hasFocus;
+}
+
+int Window::id() const {
     return _id;
 }
 
@@ -1336,7 +1991,14 @@ bool Window::hasTag(std::string_view tag) const {
     return std::find(_tags.cbegin(), _tags.cend(), tag) != _tags.cend();
 }
 
+bool Window::hasFrameExport() const {
+    return _frameExportName.has_value();
+}
+
 void Window::setVisible(bool state) {
+    if (Engine::instance().settings().headless) {
+        return;
+    }
     if (state != _isVisible && _windowHandle) {
         if (state) {
             glfwShowWindow(_windowHandle);
@@ -1407,6 +2069,11 @@ float Window::horizFieldOfViewDegrees() const {
 
 void Window::setCallDraw2DFunction(bool state) {
     _hasCallDraw2DFunction = state;
+    invalidateOverlay();
+}
+
+void Window::invalidateOverlay() {
+    _overlayLayer.isDirty = { true, true };
 }
 
 void Window::setCallDraw3DFunction(bool state) {
@@ -1418,6 +2085,134 @@ void Window::setStereoMode(StereoMode sm) {
     loadShaders();
 }
 
+void Window::setVulkanImages(Eye eye, VulkanImage* color, VulkanImage* depth) {
+    if (color && (isSinglePassStereo() || (_finalFBO && _finalFBO->isMultiSampled()))) {
+        Log::Warning(std::format(
+            "Window {}: Vulkan images cannot be used with multisampling or while both "
+            "eyes are rendered in one pass", _id
+        ));
+        return;
+    }
+    if (color && color->size() != _framebufferRes) {
+        Log::Warning(std::format(
+            "Window {}: The Vulkan images of {}x{} pixels are only used while the "
+            "framebuffer has the same size instead of {}x{}",
+            _id, color->size().x, color->size().y, _framebufferRes.x, _framebufferRes.y
+        ));
+    }
+
+    VulkanImages& images = _vulkanImages[eye == Eye::Right ? 1 : 0];
+    images = VulkanImages{ .color = color, .depth = color ? depth : nullptr };
+}
+
+void Window::setUseFXAA(bool state) {
+    if (state == _useFXAA) {
+        return;
+    }
+    if (state && _isSinglePassStereoSupported) {
+        Log::Warning(std::format(
+            "Window {}: FXAA cannot be enabled while both eyes are rendered in one pass",
+            _id
+        ));
+        return;
+    }
+    if (state && _antiAliasing) {
+        Log::Warning(std::format(
+            "Window {}: FXAA cannot be enabled together with SMAA or TAA", _id
+        ));
+        return;
+    }
+
+    _useFXAA = state;
+    if (_useFXAA) {
+        acquireIntermediateTarget();
+        loadFxaaShaders();
+        ShaderProgram::unbind();
+    }
+    else {
+        _intermediateTarget = RenderTargetPool::Target();
+        _frameBufferTextures.intermediate = 0;
+        if (_fxaa) {
+            _fxaa->shader.deleteProgram();
+            _fxaa->fusedQuad.deleteProgram();
+            _fxaa->fusedWarpMapQuad.deleteProgram();
+            _fxaa = std::nullopt;
+        }
+    }
+}
+
+mat4 Window::jitteredMatrix(const mat4& matrix, ivec2 size) const {
+    if (_screenshotTile) {
+        // The tile is scaled up to the whole viewport, which maps x from the range
+        // [-1 + 2i/n, -1 + 2(i+1)/n] of tile i of n to [-1, 1], and likewise for y
+        const vec2 count = vec2(
+            static_cast<float>(_screenshotTile->count.x),
+            static_cast<float>(_screenshotTile->count.y)
+        );
+        const vec2 offset = vec2(
+            count.x - 2.f * _screenshotTile->index.x - 1.f,
+            count.y - 2.f * _screenshotTile->index.y - 1.f
+        );
+        mat4 res = matrix;
+        for (int c = 0; c < 4; c++) {
+            res.values[c * 4 + 0] =
+                count.x * matrix.values[c * 4 + 0] + offset.x * matrix.values[c * 4 + 3];
+            res.values[c * 4 + 1] =
+                count.y * matrix.values[c * 4 + 1] + offset.y * matrix.values[c * 4 + 3];
+        }
+        // The temporal anti-aliasing cannot reuse the previous frames for a tile
+        return res;
+    }
+    if (!_antiAliasing || !_antiAliasing->useTaa() || size.x <= 0 || size.y <= 0) {
+        return matrix;
+    }
+
+    // The cluster frame number is synchronized, so all nodes use the same jitter. The
+    // offset in normalized device coordinates is applied as a translation after the
+    // matrix, which adds a multiple of the w row to the x and y rows
+    const vec2 jitter = AntiAliasing::jitter(Engine::instance().clusterFrameNumber());
+    const float tx = 2.f * jitter.x / static_cast<float>(size.x);
+    const float ty = 2.f * jitter.y / static_cast<float>(size.y);
+    mat4 res = matrix;
+    for (int c = 0; c < 4; c++) {
+        res.values[c * 4 + 0] += tx * matrix.values[c * 4 + 3];
+        res.values[c * 4 + 1] += ty * matrix.values[c * 4 + 3];
+    }
+    return res;
+}
+
+void Window::setSwapInterval(std::optional<int8_t> swapInterval,
+                             std::optional<bool> adaptiveSync, bool isLastWindow)
+{
+    _swapInterval = swapInterval;
+    _adaptiveSync = adaptiveSync;
+
+    // If we would set multiple windows to use vsync, we would get a framerate of (monitor
+    // refreshrate)/(number of windows), which is something that might really slow down a
+    // multi-monitor application. Setting last window to the requested interval, which
+    // does mean all other windows will respect the last window in the pipeline.
+    const int global = Engine::instance().settings().swapInterval;
+    int interval = _swapInterval.value_or(isLastWindow ? std::abs(global) : 0);
+    if (Engine::instance().settings().headless) {
+        // The buffers of a headless window are never swapped
+        interval = 0;
+    }
+    if (_adaptiveSync.value_or(global < 0) && interval > 0) {
+        const bool isSupported = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+            glfwExtensionSupported("GLX_EXT_swap_control_tear");
+        if (isSupported) {
+            // A negative interval enables the late swap tearing
+            interval = -interval;
+        }
+        else {
+            Log::Warning(std::format(
+                "Window {}: Adaptive sync is not supported, using vertical sync", _id
+            ));
+        }
+    }
+    glfwSwapInterval(interval);
+}
+
 Window::StereoMode Window::stereoMode() const {
     return _stereoMode;
 }
@@ -1438,18 +2233,24 @@ void Window::createTextures() {
         ));
         return;
     }
+    _textureResolution = _framebufferRes;
 
     // Create left and right color & depth textures; don't allocate the right eye image if
     // stereo is not used create a postFX texture for effects
-    generateTexture(_frameBufferTextures.leftEye, TextureType::Color);
-    if (useRightEyeTexture()) {
-        generateTexture(_frameBufferTextures.rightEye, TextureType::Color);
+    if (_isSinglePassStereoSupported && useRightEyeTexture()) {
+        generateStereoTextures();
     }
-    if (Engine::instance().settings().useDepthTexture) {
-        generateTexture(_frameBufferTextures.depth, TextureType::Depth);
+    else {
+        generateTexture(_frameBufferTextures.leftEye, TextureType::Color);
+        if (useRightEyeTexture()) {
+            generateTexture(_frameBufferTextures.rightEye, TextureType::Color);
+        }
+        if (Engine::instance().settings().useDepthTexture) {
+            generateTexture(_frameBufferTextures.depth, TextureType::Depth);
+        }
     }
     if (_useFXAA) {
-        generateTexture(_frameBufferTextures.intermediate, TextureType::Color);
+        acquireIntermediateTarget();
     }
     if (Engine::instance().settings().useNormalTexture) {
         generateTexture(_frameBufferTextures.normals, TextureType::Normal);
@@ -1457,6 +2258,41 @@ void Window::createTextures() {
     if (Engine::instance().settings().usePositionTexture) {
         generateTexture(_frameBufferTextures.positions, TextureType::Position);
     }
+    // The right eye has its own overlays in all stereo modes, including the ones that
+    // render both eyes into the same texture
+    const size_t nOverlays =
+        !_draw2DRate ? 0 : (_stereoMode != StereoMode::NoStereo ? 2 : 1);
+    for (size_t i = 0; i < nOverlays; i++) {
+        generateTexture(_overlayLayer.textures[i], TextureType::Overlay);
+    }
+    _overlayLayer.isDirty = { true, true };
+
+    const size_t texels = static_cast<size_t>(_framebufferRes.x) * _framebufferRes.y;
+    const bool hasArrays = _frameBufferTextures.stereoColor != 0;
+    const size_t nColor = 1 + (useRightEyeTexture() ? 1 : 0);
+    size_t bytes = nColor * texels * MemoryTracker::bytesPerTexel(_internalColorFormat);
+    if (hasArrays || Engine::instance().settings().useDepthTexture) {
+        // The depth array always has a layer for each eye
+        bytes += (hasArrays ? 2 : 1) * texels *
+            MemoryTracker::bytesPerTexel(GL_DEPTH_COMPONENT32);
+    }
+    if (Engine::instance().settings().useNormalTexture) {
+        bytes += texels * MemoryTracker::bytesPerTexel(GL_RGB32F);
+    }
+    if (Engine::instance().settings().usePositionTexture) {
+        bytes += texels * MemoryTracker::bytesPerTexel(GL_RGB32F);
+    }
+    bytes += nOverlays * texels * MemoryTracker::bytesPerTexel(GL_RGBA8);
+    _textureMemory.set(bytes);
+
+    if (_antiAliasing) {
+        _antiAliasing->resize(
+            _framebufferRes,
+            _internalColorFormat,
+            GL_BGRA,
+            _colorDataType
+        );
+    }
 
     Log::Debug(std::format("Targets initialized successfully for window {}", _id));
 }
@@ -1481,6 +2317,8 @@ void Window::generateTexture(unsigned int& id, Window::TextureType type) {
             case TextureType::Normal:
             case TextureType::Position:
                 return { GL_RGB32F, GL_RGB, GL_FLOAT };
+            case TextureType::Overlay:
+                return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
             default:
                 throw std::logic_error("Unhandled case label");
         }
@@ -1506,10 +2344,52 @@ void Window::generateTexture(unsigned int& id, Window::TextureType type) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 }
 
+void Window::generateStereoTextures() {
+    ZoneScoped;
+    TracyGpuZone("Generate Stereo Textures");
+
+    const ivec2 res = _framebufferRes;
+    auto createArray = [res](unsigned int& id, GLenum format) {
+        glDeleteTextures(1, &id);
+        glGenTextures(1, &id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, format, res.x, res.y, 2);
+    };
+    auto createView = [](unsigned int& id, unsigned int array, GLenum format,
+                         unsigned int layer)
+    {
+        glDeleteTextures(1, &id);
+        glGenTextures(1, &id);
+        glTextureView(id, GL_TEXTURE_2D, array, format, 0, 1, layer, 1);
+        glBindTexture(GL_TEXTURE_2D, id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    };
+
+    createArray(_frameBufferTextures.stereoColor, _internalColorFormat);
+    createArray(_frameBufferTextures.stereoDepth, GL_DEPTH_COMPONENT32);
+    createView(_frameBufferTextures.leftEye, _frameBufferTextures.stereoColor,
+        _internalColorFormat, 0);
+    createView(_frameBufferTextures.rightEye, _frameBufferTextures.stereoColor,
+        _internalColorFormat, 1);
+    if (Engine::instance().settings().useDepthTexture) {
+        // The right eye is rendered last when the eyes are rendered separately, too
+        createView(_frameBufferTextures.depth, _frameBufferTextures.stereoDepth,
+            GL_DEPTH_COMPONENT32, 1);
+    }
+    Log::Debug(std::format(
+        "{}x{} stereo texture arrays generated for window {}", res.x, res.y, _id
+    ));
+}
+
 void Window::resizeFBOs() {
-    if (_useFixResolution) {
+    // A fixed resolution only changes through the resolution scale
+    if (_useFixResolution && !_isResolutionScaleChanged) {
         return;
     }
+    _isResolutionScaleChanged = false;
 
     makeSharedContextCurrent();
     destroyFBOs();
@@ -1524,6 +2404,27 @@ void Window::resizeFBOs() {
     }
 }
 
+void Window::applyResolutionScale() {
+    const ivec2 res = _unscaledFramebufferRes;
+    _framebufferRes = ivec2{
+        std::max(static_cast<int>(std::round(res.x * _resolutionScale)), 1),
+        std::max(static_cast<int>(std::round(res.y * _resolutionScale)), 1)
+    };
+}
+
+void Window::acquireIntermediateTarget() {
+    _intermediateTarget = RenderTargetPool::acquire(
+        {
+            .internalFormat = _intermediateColorFormat,
+            .format = GL_BGRA,
+            .type = _intermediateDataType,
+            .size = _framebufferRes
+        },
+        MemoryTracker::Category::Framebuffers
+    );
+    _frameBufferTextures.intermediate = _intermediateTarget.texture();
+}
+
 void Window::destroyFBOs() {
     glDeleteTextures(1, &_frameBufferTextures.leftEye);
     _frameBufferTextures.leftEye = 0;
@@ -1531,41 +2432,100 @@ void Window::destroyFBOs() {
     _frameBufferTextures.rightEye = 0;
     glDeleteTextures(1, &_frameBufferTextures.depth);
     _frameBufferTextures.depth = 0;
-    glDeleteTextures(1, &_frameBufferTextures.intermediate);
+    _intermediateTarget = RenderTargetPool::Target();
     _frameBufferTextures.intermediate = 0;
+    glDeleteTextures(1, &_frameBufferTextures.normals);
+    _frameBufferTextures.normals = 0;
     glDeleteTextures(1, &_frameBufferTextures.positions);
     _frameBufferTextures.positions = 0;
+    glDeleteTextures(1, &_frameBufferTextures.stereoColor);
+    _frameBufferTextures.stereoColor = 0;
+    glDeleteTextures(1, &_frameBufferTextures.stereoDepth);
+    _frameBufferTextures.stereoDepth = 0;
+    glDeleteTextures(2, _overlayLayer.textures.data());
+    _overlayLayer.textures = { 0, 0 };
+    _textureMemory.set(0);
+}
+
+bool Window::isSinglePassStereo() const {
+    // The texture arrays only exist if the stereo mode was set when they were created
+    const bool hasArrays = _frameBufferTextures.stereoColor != 0;
+    return _isSinglePassStereoSupported && useRightEyeTexture() && hasArrays;
+}
+
+std::optional<SortLastCompositor::Partition> Window::compositingPartition() const {
+    if (!_compositing) {
+        return std::nullopt;
+    }
+    const std::vector<int>& nodes = _compositing->nodes;
+    const auto it =
+        std::find(nodes.begin(), nodes.end(), ClusterManager::instance().thisNodeId());
+    if (it == nodes.end()) {
+        return std::nullopt;
+    }
+    return SortLastCompositor::Partition {
+        .index = static_cast<int>(std::distance(nodes.begin(), it)),
+        .count = static_cast<int>(nodes.size())
+    };
 }
 
 bool Window::useRightEyeTexture() const {
     return _stereoMode != StereoMode::NoStereo && _stereoMode < StereoMode::SideBySide;
 }
 
-void Window::renderViewports(FrustumMode frustum, Eye eye) const {
+void Window::renderViewports(FrustumMode frustum, Eye eye, bool isSceneRendered) const {
     ZoneScoped;
 
-    _finalFBO->bind();
     if (_finalFBO->isMultiSampled()) {
+        _finalFBO->bind();
         return;
     }
 
-    // update attachments
-    _finalFBO->attachColorTexture(frameBufferTextureEye(eye), GL_COLOR_ATTACHMENT0);
-
-    if (Engine::instance().settings().useDepthTexture) {
-        _finalFBO->attachDepthTexture(_frameBufferTextures.depth);
+    using Target = OffScreenBuffer::Target;
+    const Engine::Settings& settings = Engine::instance().settings();
+    const VulkanImages* vulkan = vulkanImages(eye);
+    OffScreenBuffer::Configuration configuration = {
+        .color = Target{ .texture = frameBufferTextureEye(eye) }
+    };
+    if (isSceneRendered) {
+        // All attachments have to be either layered or not, so the depth of this eye's
+        // layer replaces the layered depth attachment
+        configuration.depth = Target{
+            .type = Target::Type::Layer,
+            .texture = _frameBufferTextures.stereoDepth,
+            .index = eye == Eye::Right ? 1 : 0
+        };
     }
-
-    if (Engine::instance().settings().useNormalTexture) {
-        _finalFBO->attachColorTexture(_frameBufferTextures.normals, GL_COLOR_ATTACHMENT1);
+    else if (settings.useDepthTexture) {
+        configuration.depth = Target{ .texture = frameBufferDepthTexture(eye) };
     }
-
-    if (Engine::instance().settings().usePositionTexture) {
-        _finalFBO->attachColorTexture(
-            _frameBufferTextures.positions,
-            GL_COLOR_ATTACHMENT2
-        );
+    if (settings.useNormalTexture) {
+        configuration.normals = Target{ .texture = _frameBufferTextures.normals };
+    }
+    if (settings.usePositionTexture) {
+        configuration.positions = Target{ .texture = _frameBufferTextures.positions };
     }
+    _finalFBO->bind(configuration);
+
+    auto callDrawFunction = [this](const Viewport& vp, FrustumMode f) {
+        ZoneScopedN("[SGCT] Draw");
+        TraceScopedN("[SGCT] Draw");
+        const mat4& scene = ClusterManager::instance().sceneTransform();
+        const Projection& proj = vp.projection(f);
+        const ivec4 rect = vp.pixelCoordinates(f);
+        const ivec2 size = ivec2(rect.z, rect.w);
+        const RenderData renderData = {
+            *this,
+            vp,
+            f,
+            scene,
+            proj.viewMatrix(),
+            jitteredMatrix(proj.projectionMatrix(), size),
+            jitteredMatrix(proj.viewProjectionMatrix(scene), size),
+            framebufferResolution()
+        };
+        Engine::instance().drawFunction()(renderData);
+    };
 
     const Window::StereoMode sm = stereoMode();
     // render all viewports for selected eye
@@ -1573,6 +2533,7 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
         if (!vp->isEnabled()) {
             continue;
         }
+        const double callbackTime = Engine::instance().drawCallbackTime();
 
         // if passive stereo or mono
         if (sm == Window::StereoMode::NoStereo) {
@@ -1590,24 +2551,24 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
             );
         }
         if (vp->hasSubViewports()) {
-            if (_hasCallDraw3DFunction) {
+            // The Vulkan images can only be written once they have been acquired below
+            if (_hasCallDraw3DFunction && !vulkan) {
+                const GpuTimerScope timer(sharedGpuTimer(), NonLinearStage);
                 vp->nonLinearProjection()->render(*vp, frustum);
             }
         }
-        else {
+        else if (vulkan) {
+            // The application renders the viewport with Vulkan, which is not cleared
+            // here as OpenGL must not write into the images before they are acquired
+            if (_hasCallDraw3DFunction && Engine::instance().drawFunction()) {
+                callDrawFunction(*vp, frustum);
+            }
+        }
+        else if (!isSceneRendered) {
             // check if we want to blit the previous window before we do anything else
-            if (_blitWindowId >= 0) {
-                const std::vector<std::unique_ptr<Window>>& wins =
-                    Engine::instance().windows();
-                auto it = std::find_if(
-                    wins.cbegin(),
-                    wins.cend(),
-                    [id = _blitWindowId](const std::unique_ptr<Window>& w) {
-                        return w->id() == id;
-                    }
-                );
-                assert(it != wins.cend());
-                blitWindowViewport(**it, *vp, frustum);
+            if (_blitWindow) {
+                const GpuTimerScope timer(sharedGpuTimer(), BlitStage);
+                blitWindowViewport(*_blitWindow, *vp, frustum);
             }
 
             if (_hasCallDraw3DFunction) {
@@ -1618,43 +2579,41 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
                 glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
                 glDisable(GL_SCISSOR_TEST);
 
+                if (_preMask.isValid) {
+                    applyPreMask();
+                }
+
                 if (Engine::instance().drawFunction()) {
-                    ZoneScopedN("[SGCT] Draw");
-                    const RenderData renderData = {
-                        *this,
-                        *vp,
-                        frustum,
-                        ClusterManager::instance().sceneTransform(),
-                        vp->projection(frustum).viewMatrix(),
-                        vp->projection(frustum).projectionMatrix(),
-                        vp->projection(frustum).viewProjectionMatrix() *
-                            ClusterManager::instance().sceneTransform(),
-                        framebufferResolution()
-                    };
-                    Engine::instance().drawFunction()(renderData);
+                    callDrawFunction(*vp, frustum);
                 }
             }
         }
+        addViewportDrawTime(*vp, callbackTime);
     }
 
+    if (vulkan) {
+        // The draw callbacks have submitted the Vulkan rendering of all viewports
+        vulkan->color->acquire();
+        if (vulkan->depth) {
+            vulkan->depth->acquire();
+        }
+        for (const std::unique_ptr<Viewport>& vp : viewports()) {
+            if (!vp->isEnabled() || !vp->hasSubViewports() || !_hasCallDraw3DFunction) {
+                continue;
+            }
+            const FrustumMode f =
+                sm == Window::StereoMode::NoStereo ? vp->eye() : frustum;
+            const GpuTimerScope timer(sharedGpuTimer(), NonLinearStage);
+            vp->nonLinearProjection()->render(*vp, f);
+        }
+    }
     // If we did not render anything, make sure we clear the screen at least
-    if (!_hasCallDraw3DFunction && _blitWindowId == -1) {
+    else if (!_hasCallDraw3DFunction && _blitWindowId == -1) {
         glClearColor(0.f, 0.f, 0.f, 0.f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
-    else if (_blitWindowId != -1) {
-        const std::vector<std::unique_ptr<Window>>& wins = Engine::instance().windows();
-        auto it = std::find_if(
-            wins.cbegin(),
-            wins.cend(),
-            [id = _blitWindowId](const std::unique_ptr<Window>& w) {
-                return w->id() == id;
-            }
-        );
-        assert(it != wins.cend());
-        const Window& srcWin = **it;
-
-        if (!srcWin.isVisible() && !srcWin.isRenderingWhileHidden()) {
+    else if (_blitWindow) {
+        if (!_blitWindow->isVisible() && !_blitWindow->isRenderingWhileHidden()) {
             glClearColor(0.f, 0.f, 0.f, 0.f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         }
@@ -1669,49 +2628,70 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
     const bool isSplitScreen = (sm >= Window::StereoMode::SideBySide);
     if (!isSplitScreen || frustum != FrustumMode::StereoLeft) {
         ZoneScopedN("PostFX/Blit");
+        TraceScopedN("PostFX/Blit");
 
         // copy AA-buffer to "regular" / non-AA buffer
 
         if (_finalFBO->isMultiSampled()) {
-            // bind separate read and draw buffers to prepare blit operation
-            _finalFBO->bindBlit();
-
-            // update attachments
-            _finalFBO->attachColorTexture(
-                frameBufferTextureEye(eye),
-                GL_COLOR_ATTACHMENT0
-            );
+            const GpuTimerScope timer(sharedGpuTimer(), BlitStage);
+
+            // Both eyes share the depth, normal, and position textures, which hold the
+            // right eye once the frame is done. Resolving them for the left eye would
+            // only be overwritten
+            const Engine::Settings& settings = Engine::instance().settings();
+            const bool resolveAttachments = frustum != FrustumMode::StereoLeft;
+            const OffScreenBuffer::Attachments attachments = {
+                .depth = (resolveAttachments || _compositing.has_value()) &&
+                    settings.useDepthTexture,
+                .normals = resolveAttachments && settings.useNormalTexture,
+                .positions = resolveAttachments && settings.usePositionTexture
+            };
 
-            if (Engine::instance().settings().useDepthTexture) {
-                _finalFBO->attachDepthTexture(_frameBufferTextures.depth);
+            using Target = OffScreenBuffer::Target;
+            OffScreenBuffer::Configuration configuration = {
+                .color = Target{ .texture = frameBufferTextureEye(eye) }
+            };
+            if (attachments.depth) {
+                configuration.depth = Target{ .texture = frameBufferDepthTexture(eye) };
             }
-
-            if (Engine::instance().settings().useNormalTexture) {
-                _finalFBO->attachColorTexture(
-                    _frameBufferTextures.normals,
-                    GL_COLOR_ATTACHMENT1
-                );
+            if (attachments.normals) {
+                configuration.normals = Target{ .texture = _frameBufferTextures.normals };
             }
-
-            if (Engine::instance().settings().usePositionTexture) {
-                _finalFBO->attachColorTexture(
-                    _frameBufferTextures.positions,
-                    GL_COLOR_ATTACHMENT2
-                );
+            if (attachments.positions) {
+                configuration.positions =
+                    Target{ .texture = _frameBufferTextures.positions };
             }
-            _finalFBO->blit();
+
+            // bind separate read and draw buffers to prepare blit operation
+            _finalFBO->bindBlit(configuration);
+            _finalFBO->blit(attachments);
         }
 
+        if (_compositing) {
+            const GpuTimerScope timer(sharedGpuTimer(), BlitStage);
+            composite(eye);
+        }
+
+        if (_antiAliasing) {
+            const GpuTimerScope timer(sharedGpuTimer(), FxaaStage);
+            glDisable(GL_BLEND);
+            applyAntiAliasing(frustum, eye);
+            // The overlays are rendered into the resolved texture without multisampling
+            _finalFBO->bind(OffScreenBuffer::Configuration{
+                .color = OffScreenBuffer::Target{ .texture = frameBufferTextureEye(eye) }
+            });
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glEnable(GL_BLEND);
+        }
 
-        if (_useFXAA) {
+        if (_useFXAA && !isFxaaFused()) {
             assert(_fxaa);
+            const GpuTimerScope timer(sharedGpuTimer(), FxaaStage);
 
-            glDrawBuffer(GL_COLOR_ATTACHMENT0);
             // bind target FBO
-            _finalFBO->attachColorTexture(
-                frameBufferTextureEye(eye),
-                GL_COLOR_ATTACHMENT0
-            );
+            _finalFBO->bind(OffScreenBuffer::Configuration{
+                .color = OffScreenBuffer::Target{ .texture = frameBufferTextureEye(eye) }
+            });
 
             const ivec2 framebufferSize = framebufferResolution();
             glViewport(0, 0, framebufferSize.x, framebufferSize.y);
@@ -1730,14 +2710,361 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
             ShaderProgram::unbind();
         }
 
-        render2D(frustum);
+        // The overlays are placed in the window, so they are left out of the tiles of a
+        // tiled screenshot, in which they would be repeated
+        if (!_screenshotTile) {
+            if (_draw2DRate) {
+                renderOverlayLayer(frustum, eye, isSplitScreen);
+            }
+            else {
+                render2D(frustum);
+                if (isSplitScreen) {
+                    // render left eye info and graph to render 2D items after post fx
+                    render2D(FrustumMode::StereoLeft);
+                }
+            }
+        }
+    }
+
+    glDisable(GL_BLEND);
+}
+
+void Window::applyAntiAliasing(FrustumMode frustum, Eye eye) const {
+    ZoneScoped;
+
+    // In the side-by-side and top-bottom modes, both eyes are rendered into the same
+    // texture, which is only anti-aliased after the right eye
+    const bool isSplitScreen = _stereoMode >= StereoMode::SideBySide;
+    const mat4& scene = ClusterManager::instance().sceneTransform();
+    std::vector<AntiAliasing::Region> regions;
+    auto addRegion = [&regions, &scene](const Viewport& vp, FrustumMode f) {
+        AntiAliasing::Region region = { .rect = vp.pixelCoordinates(f) };
+        // The cube faces of a non-linear projection have no single view-projection
+        if (!vp.hasSubViewports()) {
+            region.viewProjection = vp.projection(f).viewProjectionMatrix(scene);
+        }
+        regions.push_back(std::move(region));
+    };
+    for (const std::unique_ptr<Viewport>& vp : _viewports) {
+        if (!vp->isEnabled()) {
+            continue;
+        }
         if (isSplitScreen) {
-            // render left eye info and graph to render 2D items after post fx
-            render2D(FrustumMode::StereoLeft);
+            addRegion(*vp, FrustumMode::StereoLeft);
+            addRegion(*vp, FrustumMode::StereoRight);
+        }
+        else {
+            addRegion(*vp, _stereoMode == StereoMode::NoStereo ? vp->eye() : frustum);
+        }
+    }
+
+    // The depth of the left eye is not resolved from the multisampled buffer
+    const bool hasDepth = Engine::instance().settings().useDepthTexture &&
+        (!_finalFBO->isMultiSampled() || frustum != FrustumMode::StereoLeft);
+    _antiAliasing->apply(
+        frameBufferTextureEye(eye),
+        hasDepth ? frameBufferDepthTexture(eye) : 0,
+        eye == Eye::Right ? 1 : 0,
+        regions
+    );
+}
+
+void Window::composite(Eye eye) const {
+    ZoneScoped;
+
+    // The color is transferred in the smallest type that keeps the precision of the
+    // framebuffer, which converts the normalized deeper formats to half floats
+    const GLenum type = [](GLenum dataType) {
+        switch (dataType) {
+            case GL_UNSIGNED_BYTE: return GL_UNSIGNED_BYTE;
+            case GL_FLOAT:         return GL_FLOAT;
+            default:               return GL_HALF_FLOAT;
         }
+    }(_colorDataType);
+    const int bytesPerColor = type == GL_UNSIGNED_BYTE ? 1 : (type == GL_FLOAT ? 4 : 2);
+
+    const ivec2 res = _framebufferRes;
+    const size_t nPixels = static_cast<size_t>(res.x) * res.y;
+    _compositingImage.size = res;
+    _compositingImage.bytesPerPixel = 4 * bytesPerColor;
+    _compositingImage.color.resize(nPixels * _compositingImage.bytesPerPixel);
+    _compositingImage.depth.resize(nPixels);
+
+    const unsigned int colorTexture = frameBufferTextureEye(eye);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, type, _compositingImage.color.data());
+    glBindTexture(GL_TEXTURE_2D, frameBufferDepthTexture(eye));
+    glGetTexImage(
+        GL_TEXTURE_2D,
+        0,
+        GL_DEPTH_COMPONENT,
+        GL_FLOAT,
+        _compositingImage.depth.data()
+    );
+
+    const bool isOutput = Engine::instance().sortLastCompositor().composite(
+        *_compositing,
+        _id,
+        static_cast<int>(eye),
+        _compositingImage
+    );
+    if (isOutput) {
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0,
+            0,
+            res.x,
+            res.y,
+            GL_DEPTH_COMPONENT,
+            GL_FLOAT,
+            _compositingImage.depth.data()
+        );
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0,
+            0,
+            res.x,
+            res.y,
+            GL_RGBA,
+            type,
+            _compositingImage.color.data()
+        );
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Window::renderSinglePassStereo() const {
+    ZoneScoped;
+
+    if (!_hasCallDraw3DFunction) {
+        return;
+    }
+
+    using Target = OffScreenBuffer::Target;
+    _finalFBO->bind(OffScreenBuffer::Configuration{
+        .color = Target{
+            .type = Target::Type::Layered,
+            .texture = _frameBufferTextures.stereoColor
+        },
+        .depth = Target{
+            .type = Target::Type::Layered,
+            .texture = _frameBufferTextures.stereoDepth
+        }
+    });
+
+    for (const std::unique_ptr<Viewport>& vp : viewports()) {
+        if (!vp->isEnabled() || vp->hasSubViewports()) {
+            continue;
+        }
+        const double callbackTime = Engine::instance().drawCallbackTime();
+
+        if (vp->isTracked()) {
+            const float nearClip = Engine::instance().nearClipPlane();
+            const float farClip = Engine::instance().farClipPlane();
+            vp->calculateFrustum(FrustumMode::StereoLeft, nearClip, farClip);
+            vp->calculateFrustum(FrustumMode::StereoRight, nearClip, farClip);
+        }
+
+        // Both eyes use the same area of the framebuffer in the stereo modes that have a
+        // separate texture per eye. Clearing a layered framebuffer clears all layers
+        vp->setupViewport(FrustumMode::StereoLeft);
+        glEnable(GL_SCISSOR_TEST);
+        glClearColor(0.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+
+        if (Engine::instance().drawFunction()) {
+            ZoneScopedN("[SGCT] Draw");
+            TraceScopedN("[SGCT] Draw");
+            const mat4& scene = ClusterManager::instance().sceneTransform();
+            const Projection& left = vp->projection(FrustumMode::StereoLeft);
+            const Projection& right = vp->projection(FrustumMode::StereoRight);
+            RenderData renderData = {
+                *this,
+                *vp,
+                FrustumMode::StereoLeft,
+                scene,
+                left.viewMatrix(),
+                left.projectionMatrix(),
+                left.viewProjectionMatrix(scene),
+                framebufferResolution()
+            };
+            renderData.rightEye = RenderData::EyeMatrices {
+                right.viewMatrix(),
+                right.projectionMatrix(),
+                right.viewProjectionMatrix(scene)
+            };
+            Engine::instance().drawFunction()(renderData);
+        }
+        addViewportDrawTime(*vp, callbackTime);
+    }
+}
+
+void Window::addViewportDrawTime(const Viewport& viewport, double callbackTime) const {
+    const auto it = std::find_if(
+        _viewports.cbegin(),
+        _viewports.cend(),
+        [&viewport](const std::unique_ptr<Viewport>& vp) { return vp.get() == &viewport; }
+    );
+    const size_t i = static_cast<size_t>(std::distance(_viewports.cbegin(), it));
+    if (i < _viewportDrawTimes.size()) {
+        _viewportDrawTimes[i] += Engine::instance().drawCallbackTime() - callbackTime;
     }
+}
+
+void Window::updatePreMask() {
+    ZoneScoped;
 
+    // The pre-mask is only derived for the composites that sample the framebuffer in the
+    // same place for both eyes through the warp meshes
+    const bool isSupported =
+        (_stereoMode == StereoMode::NoStereo || _stereoMode == StereoMode::Active) &&
+        !_scalableMesh.sdk &&
+        std::none_of(
+            _viewports.cbegin(),
+            _viewports.cend(),
+            [](const std::unique_ptr<Viewport>& vp) { return vp->hasWarpMap(); }
+        ) &&
+        std::any_of(
+            _viewports.cbegin(),
+            _viewports.cend(),
+            [](const std::unique_ptr<Viewport>& vp) {
+                return vp->hasBlendMaskTexture() || vp->hasCorrectionMesh();
+            }
+        );
+    if (!isSupported) {
+        _preMask.isValid = false;
+        _preMask.meshRevisions.clear();
+        return;
+    }
+
+    std::vector<uint64_t> revisions;
+    revisions.reserve(_viewports.size());
+    for (const std::unique_ptr<Viewport>& vp : _viewports) {
+        revisions.push_back(vp->meshRevision());
+    }
+    if (_preMask.isValid && revisions == _preMask.meshRevisions &&
+        _preMask.size == _framebufferRes)
+    {
+        return;
+    }
+    TracyGpuZone("Update pre-mask");
+
+    if (_preMask.shader.id() == 0) {
+        ZoneScopedN("Pre-mask Shaders");
+        const double t0 = time();
+        _preMask.coverageShader = ShaderProgram("PreMaskCoverageShader");
+        _preMask.coverageShader.addVertexShader(shaders::PreMaskCoverageVert);
+        _preMask.coverageShader.addFragmentShader(shaders::PreMaskCoverageFrag);
+        _preMask.coverageShader.createAndLinkProgram();
+        _preMask.coverageShader.bind();
+        glUniform1i(_preMask.coverageShader.uniformLocation("blendMask"), 0);
+
+        _preMask.shader = ShaderProgram("PreMaskShader");
+        _preMask.shader.addVertexShader(shaders::PreMaskVert);
+        _preMask.shader.addFragmentShader(shaders::PreMaskFrag);
+        _preMask.shader.createAndLinkProgram();
+        _preMask.shader.bind();
+        glUniform1i(_preMask.shader.uniformLocation("coverage"), 0);
+        ShaderProgram::unbind();
+        Log::Debug(std::format(
+            "Window {}: Created the pre-mask shaders ({:.2f} ms)",
+            _id, (time() - t0) * 1000.0
+        ));
+    }
+
+    if (_preMask.size != _framebufferRes) {
+        glDeleteTextures(1, &_preMask.texture);
+        glGenTextures(1, &_preMask.texture);
+        glBindTexture(GL_TEXTURE_2D, _preMask.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_R8,
+            _framebufferRes.x,
+            _framebufferRes.y,
+            0,
+            GL_RED,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        _preMask.memory.set(
+            static_cast<size_t>(_framebufferRes.x) * _framebufferRes.y *
+            MemoryTracker::bytesPerTexel(GL_R8)
+        );
+        _preMask.size = _framebufferRes;
+    }
+
+    if (_preMask.fbo == 0) {
+        glGenFramebuffers(1, &_preMask.fbo);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, _preMask.fbo);
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        _preMask.texture,
+        0
+    );
+    glViewport(0, 0, _framebufferRes.x, _framebufferRes.y);
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT);
     glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+
+    // The pixels that are sampled by any of the warp meshes are visible
+    const ShaderProgram& shader = _preMask.coverageShader;
+    shader.bind();
+    glUniform1i(shader.uniformLocation("flipX"), _mirrorX ? 1 : 0);
+    glUniform1i(shader.uniformLocation("flipY"), _mirrorY ? 1 : 0);
+    glActiveTexture(GL_TEXTURE0);
+    for (const std::unique_ptr<Viewport>& vp : _viewports) {
+        glUniform2f(
+            shader.uniformLocation("viewportPosition"),
+            vp->position().x,
+            vp->position().y
+        );
+        glUniform2f(shader.uniformLocation("viewportSize"), vp->size().x, vp->size().y);
+        glUniform1i(
+            shader.uniformLocation("hasBlendMask"),
+            vp->hasBlendMaskTexture() ? 1 : 0
+        );
+        glBindTexture(GL_TEXTURE_2D, vp->blendMaskTextureIndex());
+        vp->renderWarpMesh();
+    }
+    ShaderProgram::unbind();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    _preMask.meshRevisions = std::move(revisions);
+    _preMask.isValid = true;
+}
+
+void Window::applyPreMask() const {
+    ZoneScoped;
+    TracyGpuZone("Apply pre-mask");
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_ALWAYS);
+
+    _preMask.shader.bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _preMask.texture);
+    renderScreenQuad();
+    ShaderProgram::unbind();
+
+    glDisable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 }
 
 void Window::render2D(FrustumMode frustum) const {
@@ -1754,7 +3081,7 @@ void Window::render2D(FrustumMode frustum) const {
         if (vp->hasOverlayTexture()) {
             glActiveTexture(GL_TEXTURE0);
             glBindTexture(GL_TEXTURE_2D, vp->overlayTextureIndex());
-            _overlay.bind();
+            overlayShader().bind();
             renderScreenQuad();
         }
 
@@ -1765,15 +3092,17 @@ void Window::render2D(FrustumMode frustum) const {
         // Check if we should call the use defined draw2D function
         if (Engine::instance().draw2DFunction() && _hasCallDraw2DFunction) {
             ZoneScopedN("[SGCT] Draw 2D");
+            TraceScopedN("[SGCT] Draw 2D");
+            const mat4& scene = ClusterManager::instance().sceneTransform();
+            const Projection& proj = vp->projection(frustum);
             const RenderData renderData = {
                 *this,
                 *vp,
                 frustum,
-                ClusterManager::instance().sceneTransform(),
-                vp->projection(frustum).viewMatrix(),
-                vp->projection(frustum).projectionMatrix(),
-                vp->projection(frustum).viewProjectionMatrix() *
-                    ClusterManager::instance().sceneTransform(),
+                scene,
+                proj.viewMatrix(),
+                proj.projectionMatrix(),
+                proj.viewProjectionMatrix(scene),
                 framebufferResolution()
             };
             Engine::instance().draw2DFunction()(renderData);
@@ -1781,6 +3110,73 @@ void Window::render2D(FrustumMode frustum) const {
     }
 }
 
+void Window::renderOverlayLayer(FrustumMode frustum, Eye eye, bool isSplitScreen) const {
+    ZoneScoped;
+
+    const size_t index = eye == Eye::Right ? 1 : 0;
+    const unsigned int texture = _overlayLayer.textures[index];
+    if (texture == 0) {
+        // The stereo mode was changed after the overlay layers were created
+        render2D(frustum);
+        if (isSplitScreen) {
+            render2D(FrustumMode::StereoLeft);
+        }
+        return;
+    }
+
+    const ivec2 res = framebufferResolution();
+    const double now = time();
+    const bool isExpired = *_draw2DRate > 0.f &&
+        now - _overlayLayer.renderTime[index] >= 1.0 / *_draw2DRate;
+    if (_overlayLayer.isDirty[index] || isExpired) {
+        TracyGpuZone("Render overlay layer");
+
+        GLint drawFbo = 0;
+        GLint readFbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, _overlayLayer.fbo);
+        glFramebufferTexture2D(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            texture,
+            0
+        );
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glViewport(0, 0, res.x, res.y);
+        glClearColor(0.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // The alpha is accumulated separately so that the layer ends up with colors that
+        // are premultiplied by the coverage of all overlays that were drawn into it
+        glBlendFuncSeparate(
+            GL_SRC_ALPHA,
+            GL_ONE_MINUS_SRC_ALPHA,
+            GL_ONE,
+            GL_ONE_MINUS_SRC_ALPHA
+        );
+        render2D(frustum);
+        if (isSplitScreen) {
+            render2D(FrustumMode::StereoLeft);
+        }
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFbo));
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFbo));
+        _overlayLayer.isDirty[index] = false;
+        _overlayLayer.renderTime[index] = now;
+    }
+
+    glViewport(0, 0, res.x, res.y);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    overlayShader().bind();
+    renderScreenQuad();
+    ShaderProgram::unbind();
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
 void Window::blitWindowViewport(const Window& prevWindow, const Viewport& viewport,
                                 FrustumMode mode) const
 {
@@ -1795,15 +3191,15 @@ void Window::blitWindowViewport(const Window& prevWindow, const Viewport& viewpo
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glDisable(GL_SCISSOR_TEST);
 
-    _overlay.bind();
+    overlayShader().bind();
 
     glActiveTexture(GL_TEXTURE0);
     const unsigned int tex = [&prevWindow](FrustumMode v) {
         switch (v) {
             case FrustumMode::Mono:
-                return prevWindow._frameBufferTextures.leftEye;
+                return prevWindow.frameBufferTextureEye(Eye::MonoOrLeft);
             case FrustumMode::StereoLeft:
-                return prevWindow._frameBufferTextures.rightEye;
+                return prevWindow.frameBufferTextureEye(Eye::Right);
             case FrustumMode::StereoRight:
                 return prevWindow._frameBufferTextures.intermediate;
             default:
@@ -1870,42 +3266,25 @@ void Window::loadShaders() {
         _fboQuad = ShaderProgram("FBOQuadShader");
         _fboQuad.addVertexShader(shaders::BaseVert);
         _fboQuad.addFragmentShader(shaders::BaseFrag);
+        _fboQuad.addFragmentShader(shaders::FrameSampleFun);
         _fboQuad.createAndLinkProgram();
         _fboQuad.bind();
         glUniform1i(glGetUniformLocation(_fboQuad.id(), "tex"), 0);
     }
 
     {
-        ZoneScopedN("Overlay Shader");
-        _overlay = ShaderProgram("OverlayShader");
-        _overlay.addVertexShader(shaders::BaseVert);
-        _overlay.addFragmentShader(shaders::OverlayFrag);
-        _overlay.createAndLinkProgram();
-        _overlay.bind();
-        glUniform1i(glGetUniformLocation(_overlay.id(), "tex"), 0);
+        ZoneScopedN("Warp Map Shader");
+        _warpMapQuad = ShaderProgram("WarpMapShader");
+        _warpMapQuad.addVertexShader(shaders::BaseVert);
+        _warpMapQuad.addFragmentShader(shaders::WarpMapFrag);
+        _warpMapQuad.addFragmentShader(shaders::FrameSampleFun);
+        _warpMapQuad.createAndLinkProgram();
+        _warpMapQuad.bind();
+        setWarpMapUniforms(_warpMapQuad);
     }
 
     if (_useFXAA) {
-        ZoneScopedN("FXAA shader");
-
-        _fxaa = FXAAShader();
-        _fxaa->shader = ShaderProgram("FXAAShader");
-        _fxaa->shader.addVertexShader(shaders::FXAAVert);
-        _fxaa->shader.addFragmentShader(shaders::FXAAFrag);
-        _fxaa->shader.createAndLinkProgram();
-        _fxaa->shader.bind();
-
-        const int id = _fxaa->shader.id();
-        _fxaa->sizeX = glGetUniformLocation(id, "rt_w");
-        const ivec2 framebufferSize = framebufferResolution();
-        glUniform1f(_fxaa->sizeX, static_cast<float>(framebufferSize.x));
-
-        _fxaa->sizeY = glGetUniformLocation(id, "rt_h");
-        glUniform1f(_fxaa->sizeY, static_cast<float>(framebufferSize.y));
-
-        glUniform1f(glGetUniformLocation(id, "FXAA_SUBPIX_TRIM"), 1.f / 4.f);
-        glUniform1f(glGetUniformLocation(id, "FXAA_SUBPIX_OFFSET"), 1.f / 2.f);
-        glUniform1i(glGetUniformLocation(id, "tex"), 0);
+        loadFxaaShaders();
     }
 
 
@@ -1943,7 +3322,159 @@ void Window::loadShaders() {
     ShaderProgram::unbind();
 }
 
+const ShaderProgram& Window::overlayShader() const {
+    if (_overlay.id() == 0) [[unlikely]] {
+        ZoneScopedN("Overlay Shader");
+        const double t0 = time();
+        _overlay = ShaderProgram("OverlayShader");
+        _overlay.addVertexShader(shaders::BaseVert);
+        _overlay.addFragmentShader(shaders::OverlayFrag);
+        _overlay.createAndLinkProgram();
+        _overlay.bind();
+        glUniform1i(glGetUniformLocation(_overlay.id(), "tex"), 0);
+        Log::Debug(std::format(
+            "Window {}: Created the overlay shader ({:.2f} ms)",
+            _id, (time() - t0) * 1000.0
+        ));
+    }
+    return _overlay;
+}
+
+void Window::loadFxaaShaders() {
+    ZoneScoped;
+
+    const double t0 = time();
+    _fxaa = FXAAShader();
+    _fxaa->shader = ShaderProgram("FXAAShader");
+    _fxaa->shader.addVertexShader(shaders::FXAAVert);
+    _fxaa->shader.addFragmentShader(shaders::FXAAFrag);
+    _fxaa->shader.createAndLinkProgram();
+    _fxaa->shader.bind();
+
+    const int id = _fxaa->shader.id();
+    _fxaa->sizeX = glGetUniformLocation(id, "rt_w");
+    const ivec2 framebufferSize = framebufferResolution();
+    glUniform1f(_fxaa->sizeX, static_cast<float>(framebufferSize.x));
+
+    _fxaa->sizeY = glGetUniformLocation(id, "rt_h");
+    glUniform1f(_fxaa->sizeY, static_cast<float>(framebufferSize.y));
+
+    glUniform1f(glGetUniformLocation(id, "FXAA_SUBPIX_TRIM"), 1.f / 4.f);
+    glUniform1f(glGetUniformLocation(id, "FXAA_SUBPIX_OFFSET"), 1.f / 2.f);
+    glUniform1i(glGetUniformLocation(id, "tex"), 0);
+
+    auto setFxaaUniforms = [](const ShaderProgram& program) {
+        const unsigned int pid = program.id();
+        glUniform1f(glGetUniformLocation(pid, "FXAA_SUBPIX_TRIM"), 1.f / 4.f);
+        glUniform1f(glGetUniformLocation(pid, "FXAA_SUBPIX_OFFSET"), 1.f / 2.f);
+        glUniform1i(glGetUniformLocation(pid, "tex"), 0);
+    };
+
+    _fxaa->fusedQuad = ShaderProgram("FusedFXAAQuadShader");
+    _fxaa->fusedQuad.addVertexShader(shaders::BaseVert);
+    _fxaa->fusedQuad.addFragmentShader(shaders::BaseFrag);
+    _fxaa->fusedQuad.addFragmentShader(shaders::FXAASampleFun);
+    _fxaa->fusedQuad.createAndLinkProgram();
+    _fxaa->fusedQuad.bind();
+    setFxaaUniforms(_fxaa->fusedQuad);
+
+    _fxaa->fusedWarpMapQuad = ShaderProgram("FusedFXAAWarpMapShader");
+    _fxaa->fusedWarpMapQuad.addVertexShader(shaders::BaseVert);
+    _fxaa->fusedWarpMapQuad.addFragmentShader(shaders::WarpMapFrag);
+    _fxaa->fusedWarpMapQuad.addFragmentShader(shaders::FXAASampleFun);
+    _fxaa->fusedWarpMapQuad.createAndLinkProgram();
+    _fxaa->fusedWarpMapQuad.bind();
+    setFxaaUniforms(_fxaa->fusedWarpMapQuad);
+    setWarpMapUniforms(_fxaa->fusedWarpMapQuad);
+    Log::Debug(std::format(
+        "Window {}: Created the FXAA shaders ({:.2f} ms)", _id, (time() - t0) * 1000.0
+    ));
+}
+
+bool Window::isFxaaFused() const {
+    if (!_fxaa) {
+        return false;
+    }
+
+    // Only these stereo modes warp each eye's framebuffer with the shaders that read it
+    // through sampleFrame
+    if (_stereoMode != StereoMode::NoStereo && _stereoMode != StereoMode::Active) {
+        return false;
+    }
+
+    // The 2D elements are drawn after the FXAA pass and must not be antialiased
+    Engine& engine = Engine::instance();
+    if (engine.statisticsRenderer() ||
+        (engine.draw2DFunction() && _hasCallDraw2DFunction))
+    {
+        return false;
+    }
+    const bool hasOverlay = std::any_of(
+        _viewports.cbegin(),
+        _viewports.cend(),
+        std::mem_fn(&Viewport::hasOverlayTexture)
+    );
+    if (hasOverlay) {
+        return false;
+    }
+
+    // Other windows that blit this window's framebuffer expect it to be antialiased
+    const std::vector<std::unique_ptr<Window>>& wins = engine.windows();
+    return std::none_of(
+        wins.cbegin(),
+        wins.cend(),
+        [id = _id](const std::unique_ptr<Window>& w) { return w->_blitWindowId == id; }
+    );
+}
+
+bool Window::isSamplingBlitWindow() const {
+    if (!_blitWindow || _stereoMode != StereoMode::NoStereo || _useFXAA ||
+        _hasCallDraw3DFunction)
+    {
+        return false;
+    }
+
+    // The 2D elements would be drawn on top of the blitted window
+    Engine& engine = Engine::instance();
+    if (engine.statisticsRenderer() ||
+        (engine.draw2DFunction() && _hasCallDraw2DFunction))
+    {
+        return false;
+    }
+
+    // The blit fills each viewport with the whole window, which is only the same as
+    // sampling its texture if the viewport covers the whole framebuffer
+    if (_viewports.size() != 1) {
+        return false;
+    }
+    const Viewport& vp = *_viewports.front();
+    return vp.isEnabled() && !vp.hasSubViewports() && !vp.hasOverlayTexture() &&
+        vp.position() == vec2{ 0.f, 0.f } && vp.size() == vec2{ 1.f, 1.f };
+}
+
+unsigned int Window::compositeTexture(Eye eye) const {
+    if (!isSamplingBlitWindow()) {
+        return frameBufferTextureEye(eye);
+    }
+
+    // Nothing is bound for a window that is not rendered, which samples as black just
+    // like the cleared framebuffer that the blit would leave
+    const bool isRendered =
+        _blitWindow->isVisible() || _blitWindow->isRenderingWhileHidden();
+    return isRendered ? _blitWindow->frameBufferTextureEye(Eye::MonoOrLeft) : 0;
+}
+
+const Window::VulkanImages* Window::vulkanImages(Eye eye) const {
+    const VulkanImages& images = _vulkanImages[eye == Eye::Right ? 1 : 0];
+    const bool isUsable = images.color && images.color->size() == _framebufferRes &&
+        (!images.depth || images.depth->size() == _framebufferRes);
+    return isUsable ? &images : nullptr;
+}
+
 unsigned int Window::frameBufferTextureEye(Eye eye) const {
+    if (const VulkanImages* images = vulkanImages(eye); images) {
+        return images->color->texture();
+    }
     switch (eye) {
         case Eye::MonoOrLeft: return _frameBufferTextures.leftEye;
         case Eye::Right:      return _frameBufferTextures.rightEye;
@@ -1951,4 +3482,11 @@ unsigned int Window::frameBufferTextureEye(Eye eye) const {
     }
 }
 
+unsigned int Window::frameBufferDepthTexture(Eye eye) const {
+    const VulkanImages* images = vulkanImages(eye);
+    return images && images->depth ?
+        images->depth->texture() :
+        _frameBufferTextures.depth;
+}
+
 } // namespace sgct
@@ -0,0 +1,76 @@
+# - try to find the FFmpeg libraries that are needed to encode and decode videos
+#
+# Cache Variables: (probably not for direct use in your scripts)
+#  FFMPEG_ROOT_DIR
+#  FFMPEG_<component>_INCLUDE_DIR
+#  FFMPEG_<component>_LIBRARY
+#
+# Non-cache variables you might use in your CMakeLists.txt:
+#  FFMPEG_FOUND
+#  FFMPEG_INCLUDE_DIRS
+#  FFMPEG_LIBRARIES
+#
+# Imported targets:
+#  FFmpeg::avcodec, FFmpeg::avdevice, FFmpeg::avformat, FFmpeg::avutil,
+#  FFmpeg::swscale
+#
+# Requires these CMake modules:
+#  FindPackageHandleStandardArgs (known included with CMake >=2.6.2)
+
+if(DEFINED ENV{FFMPEG_ROOT_DIR})
+set(FFMPEG_ROOT_DIR
+  "$ENV{FFMPEG_ROOT_DIR}"
+  CACHE
+  PATH
+  "Directory to search for FFmpeg")
+else()
+set(FFMPEG_ROOT_DIR
+  "${FFMPEG_ROOT_DIR}"
+  CACHE
+  PATH
+  "Directory to search for FFmpeg")
+endif()
+
+set(_ffmpeg_components avcodec avdevice avformat avutil swscale)
+set(_ffmpeg_required)
+set(FFMPEG_INCLUDE_DIRS)
+set(FFMPEG_LIBRARIES)
+
+foreach(_component ${_ffmpeg_components})
+  string(TOUPPER ${_component} _name)
+
+  find_path(FFMPEG_${_name}_INCLUDE_DIR
+    NAMES lib${_component}/${_component}.h
+    PATHS ${FFMPEG_ROOT_DIR}
+    PATH_SUFFIXES include)
+
+  find_library(FFMPEG_${_name}_LIBRARY
+    NAMES ${_component}
+    PATHS ${FFMPEG_ROOT_DIR}
+    PATH_SUFFIXES lib lib64)
+
+  list(APPEND _ffmpeg_required FFMPEG_${_name}_INCLUDE_DIR FFMPEG_${_name}_LIBRARY)
+  mark_as_advanced(FFMPEG_${_name}_INCLUDE_DIR FFMPEG_${_name}_LIBRARY)
+endforeach()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFmpeg
+  DEFAULT_MSG
+  ${_ffmpeg_required})
+
+if(FFMPEG_FOUND)
+  foreach(_component ${_ffmpeg_components})
+    string(TOUPPER ${_component} _name)
+    list(APPEND FFMPEG_INCLUDE_DIRS ${FFMPEG_${_name}_INCLUDE_DIR})
+    list(APPEND FFMPEG_LIBRARIES ${FFMPEG_${_name}_LIBRARY})
+
+    if(NOT TARGET FFmpeg::${_component})
+      add_library(FFmpeg::${_component} UNKNOWN IMPORTED)
+      set_target_properties(FFmpeg::${_component} PROPERTIES
+        IMPORTED_LOCATION "${FFMPEG_${_name}_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFMPEG_${_name}_INCLUDE_DIR}")
+    endif()
+  endforeach()
+  list(REMOVE_DUPLICATES FFMPEG_INCLUDE_DIRS)
+  mark_as_advanced(FFMPEG_ROOT_DIR)
+endif()
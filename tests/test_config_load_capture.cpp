@@ -159,7 +159,735 @@ TEST_CASE("Load: Capture/ScreenShotRange", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Capture/QueueDepth", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "queuedepth": 2
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .queueDepth = 2
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "queuedepth": 16
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .queueDepth = 16
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/DropWhenFull", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "dropwhenfull": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .dropWhenFull = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "dropwhenfull": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .dropWhenFull = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/Format", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": "png"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .format = Capture::Format::Png
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": "raw"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .format = Capture::Format::Raw
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": "video"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .format = Capture::Format::Video
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": "exr"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .format = Capture::Format::Exr
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/CompressionLevel", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionlevel": 0
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .compressionLevel = 0
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionlevel": 9
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .compressionLevel = 9
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/CompressionStrategy", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionstrategy": "huffmanonly"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .compressionStrategy = Capture::CompressionStrategy::HuffmanOnly
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionstrategy": "rle"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .compressionStrategy = Capture::CompressionStrategy::Rle
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/ParallelEncoding", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "parallelencoding": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .parallelEncoding = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "parallelencoding": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .parallelEncoding = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+
+
+
+
+TEST_CASE("Load: Capture/Codec", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "codec": "h264"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .codec = Capture::Codec::H264
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "codec": "hevc"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .codec = Capture::Codec::HEVC
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/Bitrate", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "bitrate": 1
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .bitrate = 1
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "bitrate": 50000
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .bitrate = 50000
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/FrameRate", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "framerate": 24
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .frameRate = 24
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "framerate": 120
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .frameRate = 120
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/EightBit", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "eightbit": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .eightBit = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "eightbit": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .eightBit = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/Scale", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "scale": 0.5
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .scale = 0.5f
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "scale": 1.0
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .scale = 1.f
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Capture/Collect", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "collect": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .collect = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "collect": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .capture = Capture {
+                .collect = false
+            }
+        };
 
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
 
 
 
@@ -267,3 +995,283 @@ TEST_CASE("Validate: Capture/Range/Illegal Value", "[validate]") {
         )
     );
 }
+
+TEST_CASE("Validate: Capture/QueueDepth/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "queuedepth": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/QueueDepth/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "queuedepth": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/DropWhenFull/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "dropwhenfull": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Format/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": 5
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Format/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "format": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/CompressionLevel/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionlevel": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/CompressionLevel/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionlevel": 10
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/CompressionStrategy/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionstrategy": 5
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/CompressionStrategy/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "compressionstrategy": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/ParallelEncoding/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "parallelencoding": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Codec/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "codec": 5
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Codec/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "codec": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Bitrate/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "bitrate": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Bitrate/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "bitrate": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/FrameRate/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "framerate": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/FrameRate/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "framerate": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/EightBit/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "eightbit": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Scale/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "scale": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Scale/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "scale": 0.0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Capture/Collect/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "capture": {
+    "collect": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
@@ -182,6 +182,20 @@ TEST_CASE("Load: Cluster/FirmSync", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Cluster/Binary", "[parse]") {
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .debugLog = true,
+        .firmSync = false
+    };
+
+    const std::vector<uint8_t> binary = serializeBinaryConfig(Object);
+    const config::Cluster output = readBinaryConfig(binary);
+    CHECK(output == Object);
+    CHECK(binary.size() < serializeConfig(Object).size());
+}
+
 
 
 
@@ -1548,6 +1548,70 @@ TEST_CASE("Load: CubemapProjection/Spout/Name", "[parse]") {
     }
 }
 
+TEST_CASE("Load: CubemapProjection/Spout/SharedTexture", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CubemapProjection",
+                "spout": {
+                  "enabled": true,
+                  "sharedtexture": true
+                }
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = CubemapProjection {
+                                    .spout = CubemapProjection::Spout {
+                                        .enabled = true,
+                                        .sharedTexture = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: CubemapProjection/NDI/Enabled", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -2026,6 +2090,131 @@ string
     }
 }
 
+TEST_CASE("Load: CubemapProjection/OutputIntervals", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CubemapProjection",
+                "outputintervals": {
+                  "right": 2,
+                  "top": 4,
+                  "zright": 1
+                }
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = CubemapProjection {
+                                    .outputIntervals =
+                                        CubemapProjection::OutputIntervals {
+                                            .right = 2,
+                                            .top = 4,
+                                            .zRight = 1
+                                        }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: CubemapProjection/SkipUnsentFaces", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CubemapProjection",
+                "skipunsentfaces": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = CubemapProjection {
+                                    .skipUnsentFaces = true
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: CubemapProjection/Orientation", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -3042,6 +3231,118 @@ TEST_CASE("Validate: CubemapProjection/Channels/zRight/Wrong Type", "[validate]"
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: CubemapProjection/OutputIntervals/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CubemapProjection",
+              "outputintervals": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: CubemapProjection/OutputIntervals/Right/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CubemapProjection",
+              "outputintervals": {
+                "right": "abc"
+              }
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: CubemapProjection/OutputIntervals/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CubemapProjection",
+              "outputintervals": {
+                "right": 0
+              }
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: CubemapProjection/SkipUnsentFaces/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CubemapProjection",
+              "skipunsentfaces": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: CubemapProjection/Orientation/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -1291,6 +1291,124 @@ TEST_CASE("Load: CylindricalProjection/Quality", "[parse]") {
     }
 }
 
+TEST_CASE("Load: CylindricalProjection/AutomaticQuality", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "automaticquality": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .automaticQuality = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "automaticquality": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .automaticQuality = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Load: CylindricalProjection/Rotation", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -1645,6 +1763,242 @@ TEST_CASE("Load: CylindricalProjection/Radius", "[parse]") {
     }
 }
 
+TEST_CASE("Load: CylindricalProjection/AdaptiveResolution", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "adaptiveresolution": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .adaptiveResolution = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "adaptiveresolution": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .adaptiveResolution = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: CylindricalProjection/LookupTexture", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "lookuptexture": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .lookupTexture = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "CylindricalProjection",
+                "lookuptexture": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = CylindricalProjection {
+                                        .lookupTexture = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Load: CylindricalProjection/Full", "[parse]") {
     constexpr std::string_view String = R"(
 {
@@ -1796,6 +2150,33 @@ TEST_CASE("Validate: CylindricalProjection/Quality/Illegal Value", "[validate]")
     }
 }
 
+TEST_CASE("Validate: CylindricalProjection/AutomaticQuality/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CylindricalProjection",
+              "automaticquality": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: CylindricalProjection/Rotation/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -1876,3 +2257,57 @@ TEST_CASE("Validate: CylindricalProjection/Radius/Wrong Type", "[validate]") {
 
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
+
+TEST_CASE("Validate: CylindricalProjection/AdaptiveResolution/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CylindricalProjection",
+              "adaptiveresolution": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: CylindricalProjection/LookupTexture/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "CylindricalProjection",
+              "lookuptexture": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
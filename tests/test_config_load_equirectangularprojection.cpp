@@ -1295,6 +1295,242 @@ TEST_CASE("Load: EquirectangularProjection/Quality", "[parse]") {
 
 
 
+TEST_CASE("Load: EquirectangularProjection/AutomaticQuality", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "EquirectangularProjection",
+                "automaticquality": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = EquirectangularProjection {
+                                        .automaticQuality = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "EquirectangularProjection",
+                "automaticquality": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = EquirectangularProjection {
+                                        .automaticQuality = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: EquirectangularProjection/LookupTexture", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "EquirectangularProjection",
+                "lookuptexture": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = EquirectangularProjection {
+                                        .lookupTexture = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "EquirectangularProjection",
+                "lookuptexture": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = EquirectangularProjection {
+                                        .lookupTexture = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Validate: EquirectangularProjection/Quality/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -1377,3 +1613,57 @@ TEST_CASE("Validate: EquirectangularProjection/Quality/Illegal Value", "[validat
         CHECK_THROWS_AS(validate(Config), ParsingError);
     }
 }
+
+TEST_CASE("Validate: EquirectangularProjection/AutomaticQuality/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "EquirectangularProjection",
+              "automaticquality": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: EquirectangularProjection/LookupTexture/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "EquirectangularProjection",
+              "lookuptexture": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
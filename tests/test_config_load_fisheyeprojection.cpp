@@ -2375,6 +2375,379 @@ TEST_CASE("Load: FisheyeProjection/Background/RGBA", "[parse]") {
     }
 }
 
+TEST_CASE("Load: FisheyeProjection/AdaptiveResolution", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "adaptiveresolution": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = FisheyeProjection {
+                                        .adaptiveResolution = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "adaptiveresolution": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = FisheyeProjection {
+                                        .adaptiveResolution = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: FisheyeProjection/DirectRendering", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "directrendering": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = FisheyeProjection {
+                                        .directRendering = false
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "directrendering": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = FisheyeProjection {
+                                        .directRendering = true
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: FisheyeProjection/OmniStereo", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "omnistereo": {
+                  "tilesize": 4
+                }
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = FisheyeProjection {
+                                    .omniStereo = FisheyeProjection::OmniStereo {
+                                        .tileSize = 4
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: FisheyeProjection/Distribution", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "FisheyeProjection",
+                "distribution": {
+                  "output": 0,
+                  "helpers": [
+                    {
+                      "node": 1,
+                      "faces": [ "left", "top" ]
+                    }
+                  ]
+                }
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    using Face = FisheyeProjection::Distribution::Face;
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = FisheyeProjection {
+                                    .distribution = FisheyeProjection::Distribution {
+                                        .output = 0,
+                                        .helpers = {
+                                            FisheyeProjection::Distribution::Helper {
+                                                .node = 1,
+                                                .faces = { Face::Left, Face::Top }
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: FisheyeProjection/Full", "[parse]") {
     constexpr std::string_view String = R"(
 {
@@ -3069,6 +3442,175 @@ TEST_CASE("Validate: FisheyeProjection/KeepAspectRatio/Wrong Type", "[validate]"
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: FisheyeProjection/AdaptiveResolution/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "adaptiveresolution": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: FisheyeProjection/DirectRendering/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "directrendering": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: FisheyeProjection/OmniStereo/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "omnistereo": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: FisheyeProjection/OmniStereo/TileSize/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "omnistereo": {
+                "tilesize": "abc"
+              }
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: FisheyeProjection/Distribution/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "distribution": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: FisheyeProjection/Distribution/Faces/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "FisheyeProjection",
+              "distribution": {
+                "output": 0,
+                "helpers": [
+                  { "node": 1, "faces": [ "abc" ] }
+                ]
+              }
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: FisheyeProjection/Offset/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -0,0 +1,174 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/config.h>
+#include <sgct/format.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace sgct::config;
+
+// The configurations of large installations are loaded on every restart of a show, so
+// these tests load a synthetic cluster of 64 nodes with 8 windows of 4 viewports each
+// that all have a correction mesh. The budgets are for the unoptimized test build and
+// are about ten times the time that the steps take on a regular development machine,
+// so that they only fail when a step becomes much slower and not because of a noisy
+// machine
+
+namespace {
+    constexpr int NumberOfNodes = 64;
+    constexpr int WindowsPerNode = 8;
+    constexpr int ViewportsPerWindow = 4;
+
+    // The time budgets in seconds of the steps of loading the cluster
+    constexpr double ParseBudget = 2.0;
+    constexpr double ValidationBudget = 15.0;
+    constexpr double ConversionBudget = 3.0;
+    constexpr double LoadBudget = 5.0;
+
+    Cluster largeCluster() {
+        // The paths are absolute, as the loaded paths are made absolute from the folder
+        // of the configuration
+        const std::filesystem::path folder = std::filesystem::temp_directory_path();
+
+        Cluster cluster;
+        cluster.success = true;
+        cluster.masterAddress = "10.0.0.1";
+        cluster.users.push_back(User{ .name = "default", .eyeSeparation = 0.065f });
+
+        for (int n = 0; n < NumberOfNodes; n++) {
+            Node node;
+            node.address = std::format("10.0.{}.{}", n / 250, n % 250 + 1);
+            node.port = 20401;
+            node.dataTransferPort = 20501;
+            for (int w = 0; w < WindowsPerNode; w++) {
+                Window window;
+                window.id = static_cast<int8_t>(w);
+                window.name = std::format("Node {} Projector {}", n, w);
+                window.isFullScreen = true;
+                window.monitor = static_cast<uint8_t>(w);
+                window.pos = sgct::ivec2{ w * 1920, 0 };
+                window.size = sgct::ivec2{ 1920, 1200 };
+                for (int v = 0; v < ViewportsPerWindow; v++) {
+                    const float f = static_cast<float>(v) / ViewportsPerWindow;
+                    Viewport viewport;
+                    viewport.position = sgct::vec2{ f, 0.f };
+                    viewport.size = sgct::vec2{ 1.f / ViewportsPerWindow, 1.f };
+                    viewport.correctionMeshTexture = folder /
+                        std::format("meshes/node{}_window{}_viewport{}.sgc", n, w, v);
+                    viewport.blendMaskTexture = folder /
+                        std::format("masks/node{}_window{}_viewport{}.png", n, w, v);
+                    viewport.projection = PlanarProjection{
+                        .fov = PlanarProjection::FOV{
+                            .down = -20.5f,
+                            .left = -30.25f + f,
+                            .right = 30.25f + f,
+                            .up = 20.5f
+                        },
+                        .orientation = sgct::quat{ 0.f, 0.1f * f, 0.f, 1.f }
+                    };
+                    window.viewports.push_back(std::move(viewport));
+                }
+                node.windows.push_back(std::move(window));
+            }
+            cluster.nodes.push_back(std::move(node));
+        }
+        return cluster;
+    }
+
+    double measure(const std::function<void()>& fn) {
+        const auto begin = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - begin).count();
+    }
+
+    std::filesystem::path writeFile(const std::string& name, const void* data,
+                                    size_t size)
+    {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / name;
+        std::ofstream file = std::ofstream(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data), size);
+        return path;
+    }
+} // namespace
+
+TEST_CASE("Performance: Large Cluster/JSON", "[performance]") {
+    const Cluster cluster = largeCluster();
+    const std::string json = sgct::serializeConfig(cluster);
+    const std::string schema = std::string(BASE_PATH) + "/sgct.schema.json";
+
+    // The validator is compiled from the schema once and kept, which is not part of the
+    // validation of each configuration
+    const std::string schemaError =
+        sgct::validateConfigAgainstSchema(std::string_view("{}"), schema);
+    REQUIRE_FALSE(schemaError.empty());
+
+    const double parse = measure([&json]() {
+        [[maybe_unused]] const nlohmann::json j = nlohmann::json::parse(json);
+    });
+
+    std::string error;
+    const double validation = measure([&json, &schema, &error]() {
+        error = sgct::validateConfigAgainstSchema(std::string_view(json), schema);
+    });
+    REQUIRE(error.empty());
+
+    Cluster res;
+    const double conversion = measure([&json, &res]() {
+        res = sgct::readJsonConfig(json);
+    });
+    CHECK(res == cluster);
+
+    // Both the validation and the conversion parse the configuration first
+    INFO(std::format(
+        "{} bytes: parse {:.3f} s, validation {:.3f} s, conversion {:.3f} s",
+        json.size(), parse, validation - parse, conversion - parse
+    ));
+    CHECK(parse < ParseBudget);
+    CHECK(validation - parse < ValidationBudget);
+    CHECK(conversion - parse < ConversionBudget);
+
+    const std::filesystem::path path =
+        writeFile("sgct-large.json", json.data(), json.size());
+    const double load = measure([&path, &res]() { res = sgct::readConfig(path); });
+    std::filesystem::remove(path);
+    INFO(std::format("Loading the file took {:.3f} s", load));
+    CHECK(res == cluster);
+    CHECK(load < LoadBudget);
+}
+
+TEST_CASE("Performance: Large Cluster/Binary", "[performance]") {
+    const Cluster cluster = largeCluster();
+    const std::vector<uint8_t> binary = sgct::serializeBinaryConfig(cluster);
+
+    Cluster res;
+    const double conversion = measure([&binary, &res]() {
+        res = sgct::readBinaryConfig(binary);
+    });
+    INFO(std::format("{} bytes: conversion {:.3f} s", binary.size(), conversion));
+    CHECK(res == cluster);
+    CHECK(conversion < ParseBudget + ConversionBudget);
+
+    const std::filesystem::path path =
+        writeFile("sgct-large.cbor", binary.data(), binary.size());
+    const double load = measure([&path, &res]() { res = sgct::readConfig(path); });
+    std::filesystem::remove(path);
+    INFO(std::format("Loading the file took {:.3f} s", load));
+    CHECK(res == cluster);
+    CHECK(load < LoadBudget);
+}
@@ -207,14 +207,14 @@ TEST_CASE("Load: Settings/UsePositionTexture", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
+TEST_CASE("Load: Settings/UseLayeredCubeMaps", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "precision": 16.0
+    "layeredcubemaps": false
   }
 }
 )";
@@ -223,7 +223,7 @@ TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .bufferFloatPrecision = Settings::BufferFloatPrecision::Float16Bit
+                .useLayeredCubeMaps = false
             }
         };
 
@@ -241,7 +241,7 @@ TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "precision": 32.0
+    "layeredcubemaps": true
   }
 }
 )";
@@ -250,7 +250,7 @@ TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .bufferFloatPrecision = Settings::BufferFloatPrecision::Float32Bit
+                .useLayeredCubeMaps = true
             }
         };
 
@@ -263,43 +263,41 @@ TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Settings/Display/Minimal", "[parse]") {
-    constexpr std::string_view String = R"(
+TEST_CASE("Load: Settings/CubeMapRefreshInterval", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {}
+    "cubemaprefreshinterval": 1
   }
 }
 )";
 
-    const Cluster Object = {
-        .success = true,
-        .masterAddress = "localhost",
-        .settings = Settings {
-            .display = Settings::Display()
-        }
-    };
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .cubeMapRefreshInterval = 1
+            }
+        };
 
-    Cluster res = sgct::readJsonConfig(String);
-    CHECK(res == Object);
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
 
-    const std::string str = serializeConfig(Object);
-    const config::Cluster output = readJsonConfig(str);
-    CHECK(output == Object);
-}
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
 
-TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "swapinterval": 1
-    }
+    "cubemaprefreshinterval": 4
   }
 }
 )";
@@ -308,9 +306,7 @@ TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .display = Settings::Display {
-                    .swapInterval = 1
-                }
+                .cubeMapRefreshInterval = 4
             }
         };
 
@@ -321,16 +317,16 @@ TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Settings/ShareCubeMaps", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "swapinterval": 2
-    }
+    "sharecubemaps": false
   }
 }
 )";
@@ -339,9 +335,7 @@ TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .display = Settings::Display {
-                    .swapInterval = 2
-                }
+                .shareCubeMaps = false
             }
         };
 
@@ -352,18 +346,14 @@ TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "refreshrate": 1
-    }
+    "sharecubemaps": true
   }
 }
 )";
@@ -372,9 +362,7 @@ TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .display = Settings::Display {
-                    .refreshRate = 1
-                }
+                .shareCubeMaps = true
             }
         };
 
@@ -385,16 +373,16 @@ TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Settings/InterleaveCubeMapEyes", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "refreshrate": 2
-    }
+    "interleavecubemapeyes": false
   }
 }
 )";
@@ -403,9 +391,7 @@ TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
             .success = true,
             .masterAddress = "localhost",
             .settings = Settings {
-                .display = Settings::Display {
-                    .refreshRate = 2
-                }
+                .interleaveCubeMapEyes = false
             }
         };
 
@@ -416,211 +402,3750 @@ TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Settings/Full", "[parse]") {
-    constexpr std::string_view String = R"(
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "depthbuffertexture": true,
-    "normaltexture": true,
-    "positiontexture": true,
-    "precision": 16.0,
-    "display": {
-      "swapinterval": 2,
-      "refreshrate": 3
-    }
+    "interleavecubemapeyes": true
   }
 }
 )";
 
-    const Cluster Object = {
-        .success = true,
-        .masterAddress = "localhost",
-        .settings = Settings {
-            .useDepthTexture = true,
-            .useNormalTexture = true,
-            .usePositionTexture = true,
-            .bufferFloatPrecision = Settings::BufferFloatPrecision::Float16Bit,
-            .display = Settings::Display {
-                .swapInterval = 2,
-                .refreshRate = 3
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .interleaveCubeMapEyes = true
             }
-        }
-    };
+        };
 
-    Cluster res = sgct::readJsonConfig(String);
-    CHECK(res == Object);
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
 
-    const std::string str = serializeConfig(Object);
-    const config::Cluster output = readJsonConfig(str);
-    CHECK(output == Object);
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
 }
 
-
-
-
-
-TEST_CASE("Validate: Settings/UseDepthTexture/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+TEST_CASE("Load: Settings/CorrectionMeshCache", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "depthbuffertexture": "abc"
+    "correctionmeshcache": false
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
-}
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .useCorrectionMeshCache = false
+            }
+        };
 
-TEST_CASE("Validate: Settings/UseNormalTexture/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "normaltexture": "abc"
+    "correctionmeshcache": true
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .useCorrectionMeshCache = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
 }
 
-TEST_CASE("Validate: Settings/UsePositionTexture/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+TEST_CASE("Load: Settings/AsyncCorrectionMeshes", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "positiontexture": "abc"
+    "asynccorrectionmeshes": false
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
-}
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .loadCorrectionMeshesAsync = false
+            }
+        };
 
-TEST_CASE("Validate: Settings/BufferFloatPrecision/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "precision": "abc"
+    "asynccorrectionmeshes": true
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .loadCorrectionMeshesAsync = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
 }
 
-TEST_CASE("Validate: Settings/BufferFloatPrecision/Illegal Value", "[validate]") {
+TEST_CASE("Load: Settings/WatchCorrectionMeshes", "[parse]") {
     {
-        constexpr std::string_view Config = R"(
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "precision": -20
+    "watchcorrectionmeshes": false
   }
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .watchCorrectionMeshes = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
     }
 
     {
-        constexpr std::string_view Config = R"(
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "precision": 256
+    "watchcorrectionmeshes": true
   }
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .watchCorrectionMeshes = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
     }
 }
 
-TEST_CASE("Validate: Settings/Display/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+TEST_CASE("Load: Settings/WatchConfig", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": "abc"
+    "watchconfig": false
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
-}
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .watchConfig = false
+            }
+        };
 
-TEST_CASE("Validate: Settings/Display/SwapInterval/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "swapinterval": "abc"
-    }
+    "watchconfig": true
   }
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .watchConfig = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/SyncInput", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncinput": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .syncInput = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncinput": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .syncInput = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/ShaderCache", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "shadercache": "abc"
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .shaderCachePath = "abc"
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/StatisticsHistory", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "statisticshistory": 1200
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .statisticsHistoryLength = 1200
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Trace", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "trace": "abc"
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .tracePath = "abc"
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/BinaryLog", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "binarylog": "abc"
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .binaryLogPath = "abc"
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/SyncRecord", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncrecord": "abc"
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .syncRecordPath = "abc"
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/SyncReplay", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncreplay": "abc"
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .syncReplayPath = "abc"
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "precision": 16.0
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .bufferFloatPrecision = Settings::BufferFloatPrecision::Float16Bit
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "precision": 32.0
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .bufferFloatPrecision = Settings::BufferFloatPrecision::Float32Bit
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/Lockstep/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .lockstep = Settings::Lockstep()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Lockstep", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "timestep": 0.02,
+      "maxsteps": 8,
+      "hashinterval": 60,
+      "seed": 1234
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .lockstep = Settings::Lockstep {
+                .timestep = 0.02f,
+                .maxSteps = 8,
+                .hashInterval = 60,
+                .seed = 1234
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/HitchDetector/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .hitchDetector = Settings::HitchDetector()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/HitchDetector", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "threshold": 2.5,
+      "cooldown": 30,
+      "path": "abc"
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .hitchDetector = Settings::HitchDetector {
+                .threshold = 2.5f,
+                .cooldown = 30.f,
+                .path = "abc"
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Threads/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "capture": {}
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .threads = Settings::Threads {
+                .capture = Settings::Thread()
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Threads", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "render": {
+        "priority": "high",
+        "affinity": [ 0, 1 ]
+      },
+      "network": {
+        "name": "Sync",
+        "priority": "realtime",
+        "affinity": [ 2 ]
+      },
+      "tracking": {
+        "priority": "normal"
+      },
+      "capture": {
+        "priority": "low",
+        "affinity": [ 8, 9, 10, 11 ]
+      },
+      "logging": {
+        "name": "Log",
+        "priority": "idle"
+      }
+    }
+  }
+}
+)";
+
+    using Priority = Settings::Thread::Priority;
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .threads = Settings::Threads {
+                .render = Settings::Thread {
+                    .priority = Priority::High,
+                    .affinity = std::vector<int>{ 0, 1 }
+                },
+                .network = Settings::Thread {
+                    .name = "Sync",
+                    .priority = Priority::Realtime,
+                    .affinity = std::vector<int>{ 2 }
+                },
+                .tracking = Settings::Thread {
+                    .priority = Priority::Normal
+                },
+                .capture = Settings::Thread {
+                    .priority = Priority::Low,
+                    .affinity = std::vector<int>{ 8, 9, 10, 11 }
+                },
+                .logging = Settings::Thread {
+                    .name = "Log",
+                    .priority = Priority::Idle
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Buffers/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "ndi": {}
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .buffers = Settings::Buffers {
+                .ndi = Settings::Buffer()
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Buffers", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "network": {
+        "hugepages": true,
+        "numanode": 1
+      },
+      "shareddata": {
+        "numanode": 0
+      },
+      "capture": {
+        "hugepages": false
+      },
+      "ndi": {
+        "hugepages": true,
+        "numanode": 0
+      }
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .buffers = Settings::Buffers {
+                .network = Settings::Buffer {
+                    .hugePages = true,
+                    .numaNode = 1
+                },
+                .sharedData = Settings::Buffer {
+                    .numaNode = 0
+                },
+                .capture = Settings::Buffer {
+                    .hugePages = false
+                },
+                .ndi = Settings::Buffer {
+                    .hugePages = true,
+                    .numaNode = 0
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/SwapInterval", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": 1
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .display = Settings::Display {
+                    .swapInterval = 1
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": 2
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .display = Settings::Display {
+                    .swapInterval = 2
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "refreshrate": 1
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .display = Settings::Display {
+                    .refreshRate = 1
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "refreshrate": 2
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .display = Settings::Display {
+                    .refreshRate = 2
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/Network/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/DeltaSync", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasync": false
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .network = Settings::Network {
+                    .deltaSync = false
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasync": true
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .network = Settings::Network {
+                    .deltaSync = true
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/Network/DeltaSyncKeyframeInterval", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasynckeyframeinterval": 30
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .deltaSyncKeyframeInterval = 30
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/Compression", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compression": false
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .network = Settings::Network {
+                    .compression = false
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compression": true
+    }
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .network = Settings::Network {
+                    .compression = true
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/Network/CompressionThreshold", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionthreshold": 4096
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .compressionThreshold = 4096
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/CompressionLevel", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionlevel": 6
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .compressionLevel = 6
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/MulticastAddress", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastaddress": "239.255.42.1"
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .multicastAddress = "239.255.42.1"
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/MulticastPort", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastport": 20600
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .multicastPort = 20600
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/ParallelSend", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "parallelsend": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .parallelSend = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/EventDriven", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "eventdriven": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .eventDriven = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/BusyWait", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "busywait": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .busyWait = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/PipelinedSync", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "pipelinedsync": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .pipelinedSync = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/TransferChunkSize", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferchunksize": 65536
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .transferChunkSize = 65536
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/TransferRateLimit", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferratelimit": 50000
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .transferRateLimit = 50000
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/TransferWindow", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferwindow": 32
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .transferWindow = 32
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/SyncDeadline", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncdeadline": 8.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .syncDeadline = 8.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/SharedMemory", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "sharedmemory": false
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .sharedMemory = false
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/RdmaBufferSize", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "rdmabuffersize": 16777216
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .rdmaBufferSize = 16777216
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/ForwardLog", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "forwardlog": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .forwardLog = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/MetricsPort", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "metricsport": 9100
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .metricsPort = 9100
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/ControlPort", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "controlport": 8000
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .controlPort = 8000
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/ControlUdpPort", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "controludpport": 9000
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .controlUdpPort = 9000
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/TransferTopology", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transfertopology": "tree"
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .transferTopology = Settings::Network::TransferTopology::Tree
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/SyncSocket", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncsocket": {
+        "sendbuffer": 65536,
+        "receivebuffer": 131072,
+        "dscp": 46,
+        "interface": "10.0.0.1"
+      }
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .syncSocket = Settings::Network::SocketProfile {
+                    .sendBufferSize = 65536,
+                    .receiveBufferSize = 131072,
+                    .dscp = 46,
+                    .interfaceAddress = "10.0.0.1"
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Network/TransferSocket", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transfersocket": {
+        "interface": "10.0.1.1",
+        "autotune": true
+      }
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .network = Settings::Network {
+                .transferSocket = Settings::Network::SocketProfile {
+                    .interfaceAddress = "10.0.1.1",
+                    .autoTuneBuffers = true
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/UseWindowThreads", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "windowthreads": true
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .useWindowThreads = true
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/UsePresentThread", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "presentthread": true
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .usePresentThread = true
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/FramePacingMargin", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "framepacingmargin": 2.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .framePacingMargin = 2.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/LateLatching", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "latelatching": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .lateLatching = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/TargetFrameRate", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "targetframerate": 59.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .targetFrameRate = 59.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/MinResolutionScale", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "minresolutionscale": 0.25
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .minResolutionScale = 0.25f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/MaxResolutionScale", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "maxresolutionscale": 1.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .maxResolutionScale = 1.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/AdaptiveSync", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": 1,
+      "adaptivesync": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .swapInterval = 1,
+                .adaptiveSync = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/MaxFramesInFlight", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "maxframesinflight": 2
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .maxFramesInFlight = 2
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/ResizeDelay", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "resizedelay": 150.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .resizeDelay = 150.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Display/Headless", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "headless": true
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .display = Settings::Display {
+                .headless = true
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Full", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "depthbuffertexture": true,
+    "normaltexture": true,
+    "positiontexture": true,
+    "precision": 16.0,
+    "display": {
+      "swapinterval": 2,
+      "refreshrate": 3
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .useDepthTexture = true,
+            .useNormalTexture = true,
+            .usePositionTexture = true,
+            .bufferFloatPrecision = Settings::BufferFloatPrecision::Float16Bit,
+            .display = Settings::Display {
+                .swapInterval = 2,
+                .refreshRate = 3
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+
+
+
+
+TEST_CASE("Validate: Settings/UseDepthTexture/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "depthbuffertexture": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/UseNormalTexture/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "normaltexture": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/UsePositionTexture/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "positiontexture": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/BufferFloatPrecision/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "precision": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/BufferFloatPrecision/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "precision": -20
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "precision": 256
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+}
+
+TEST_CASE("Validate: Settings/Display/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/SwapInterval/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/SwapInterval/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": -1
+    }
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "swapinterval": 1000
+    }
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+}
+
+TEST_CASE("Validate: Settings/Display/RefreshRate/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "refreshrate": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/RefreshRate/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "refreshrate": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/DeltaSync/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasync": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/KeyframeInterval/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasynckeyframeinterval": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/KeyframeInterval/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "deltasynckeyframeinterval": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/Compression/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compression": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/CompressionThreshold/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionthreshold": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/CompressionThreshold/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionthreshold": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/CompressionLevel/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionlevel": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/CompressionLevel/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "compressionlevel": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MulticastAddress/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastaddress": 123
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MulticastAddress/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastaddress": ""
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MulticastPort/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastport": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MulticastPort/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "multicastport": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/ParallelSend/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "parallelsend": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/EventDriven/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "eventdriven": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/BusyWait/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "busywait": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/PipelinedSync/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "pipelinedsync": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferChunkSize/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferchunksize": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferChunkSize/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferchunksize": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferRateLimit/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferratelimit": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferRateLimit/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferratelimit": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferWindow/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferwindow": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferWindow/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transferwindow": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncDeadline/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncdeadline": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncDeadline/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncdeadline": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SharedMemory/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "sharedmemory": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/RdmaBufferSize/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "rdmabuffersize": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/RdmaBufferSize/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "rdmabuffersize": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/ForwardLog/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "forwardlog": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/UseWindowThreads/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "windowthreads": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/UsePresentThread/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "presentthread": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/FramePacingMargin/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "framepacingmargin": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/FramePacingMargin/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "framepacingmargin": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/LateLatching/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "latelatching": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/Headless/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "headless": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/TargetFrameRate/Zero", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "targetframerate": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/MinResolutionScale/Zero", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "minresolutionscale": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/MaxResolutionScale/Negative", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "maxresolutionscale": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/AdaptiveSync/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "adaptivesync": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/MaxFramesInFlight/Zero", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "maxframesinflight": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/ResizeDelay/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "resizedelay": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Display/ResizeDelay/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "display": {
+      "resizedelay": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/CubeMapRefreshInterval/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "cubemaprefreshinterval": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/CubeMapRefreshInterval/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "cubemaprefreshinterval": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/ShareCubeMaps/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "sharecubemaps": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/InterleaveCubeMapEyes/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "interleavecubemapeyes": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/CorrectionMeshCache/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "correctionmeshcache": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/AsyncCorrectionMeshes/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "asynccorrectionmeshes": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/WatchCorrectionMeshes/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "watchcorrectionmeshes": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/WatchConfig/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "watchconfig": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/SyncInput/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncinput": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/Timestep/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "timestep": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/Timestep/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "timestep": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/MaxSteps/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "maxsteps": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/MaxSteps/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "maxsteps": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/HashInterval/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "hashinterval": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Lockstep/HashInterval/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "lockstep": {
+      "hashinterval": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/HitchDetector/Threshold/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "threshold": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/HitchDetector/Threshold/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "threshold": 1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/HitchDetector/Cooldown/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "cooldown": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/HitchDetector/Cooldown/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "cooldown": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/HitchDetector/Path/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "hitchdetector": {
+      "path": 1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Render/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "render": 1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Name/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "network": {
+        "name": 1
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Name/Empty", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "network": {
+        "name": ""
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Priority/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "network": {
+        "priority": 1
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Priority/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "network": {
+        "priority": "abc"
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Affinity/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "capture": {
+        "affinity": 1
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Affinity/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "capture": {
+        "affinity": [ 0, -1 ]
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Threads/Unknown Class", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "threads": {
+      "audio": {}
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Buffers/Network/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "network": 1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Buffers/HugePages/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "capture": {
+        "hugepages": "abc"
+      }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Buffers/NumaNode/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "network": {
+        "numanode": "abc"
+      }
+    }
+  }
 }
+)";
 
-TEST_CASE("Validate: Settings/Display/SwapInterval/Illegal Value", "[validate]") {
-    {
-        constexpr std::string_view Config = R"(
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Buffers/NumaNode/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "swapinterval": -1
+    "buffers": {
+      "network": {
+        "numanode": -1
+      }
     }
   }
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Buffers/Unknown Subsystem", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "buffers": {
+      "audio": {}
     }
+  }
+}
+)";
 
-    {
-        constexpr std::string_view Config = R"(
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/ShaderCache/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "swapinterval": 1000
+    "shadercache": 123
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/StatisticsHistory/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "statisticshistory": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/StatisticsHistory/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "statisticshistory": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Trace/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "trace": 123
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/BinaryLog/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "binarylog": 123
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/SyncRecord/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncrecord": 123
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/SyncReplay/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "syncreplay": 123
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MetricsPort/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "metricsport": "abc"
     }
   }
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/MetricsPort/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "metricsport": 0
     }
+  }
 }
+)";
 
-TEST_CASE("Validate: Settings/Display/RefreshRate/Wrong Type", "[validate]") {
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/ControlPort/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "refreshrate": "abc"
+    "network": {
+      "controlport": "abc"
     }
   }
 }
@@ -629,14 +4154,158 @@ TEST_CASE("Validate: Settings/Display/RefreshRate/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Settings/Display/RefreshRate/Illegal Value", "[validate]") {
+TEST_CASE("Validate: Settings/Network/ControlPort/Illegal Value", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
   "settings": {
-    "display": {
-      "refreshrate": -1
+    "network": {
+      "controlport": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/ControlUdpPort/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "controludpport": "abc"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/ControlUdpPort/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "controludpport": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferTopology/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transfertopology": 2
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferTopology/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transfertopology": "ring"
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncSocket/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncsocket": 123
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncSocket/SendBuffer/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncsocket": { "sendbuffer": 0 }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncSocket/DSCP/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncsocket": { "dscp": 64 }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/SyncSocket/Interface/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "syncsocket": { "interface": 123 }
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Network/TransferSocket/AutoTune/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "network": {
+      "transfersocket": { "autotune": "abc" }
     }
   }
 }
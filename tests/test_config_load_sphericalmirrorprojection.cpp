@@ -2052,6 +2052,148 @@ TEST_CASE("Load: SphericalMirrorProjection/Background/RGBA", "[parse]") {
     }
 }
 
+TEST_CASE("Load: SphericalMirrorProjection/AdaptiveResolution", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "SphericalMirrorProjection",
+                "geometry": {
+                  "bottom": "abc",
+                  "left": "def",
+                  "right": "ghi",
+                  "top": "jkl"
+                },
+                "adaptiveresolution": false
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = SphericalMirrorProjection {
+                                        .adaptiveResolution = false,
+                                        .mesh = SphericalMirrorProjection::Mesh {
+                                            .bottom = "abc",
+                                            .left = "def",
+                                            .right = "ghi",
+                                            .top = "jkl"
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "SphericalMirrorProjection",
+                "geometry": {
+                  "bottom": "123",
+                  "left": "456",
+                  "right": "789",
+                  "top": "101112"
+                },
+                "adaptiveresolution": true
+              }
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .projection = SphericalMirrorProjection {
+                                        .adaptiveResolution = true,
+                                        .mesh = SphericalMirrorProjection::Mesh {
+                                            .bottom = "123",
+                                            .left = "456",
+                                            .right = "789",
+                                            .top = "101112"
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Load: SphericalMirrorProjection/Full", "[parse]") {
     constexpr std::string_view String = R"(
 {
@@ -2264,6 +2406,43 @@ TEST_CASE("Validate: SphericalMirrorProjection/Tilt/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE(
+    "Validate: SphericalMirrorProjection/AdaptiveResolution/Wrong Type",
+    "[validate]"
+)
+{
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "projection": {
+              "type": "SphericalMirrorProjection",
+              "mesh": {
+                "bottom": "abc",
+                "left": "abc",
+                "right": "abc",
+                "top": "abc"
+              },
+              "adaptiveresolution": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: SphericalMirrorProjection/Background/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -550,6 +550,81 @@ TEST_CASE("Load: TextureMappedProjection/Offset", "[parse]") {
     }
 }
 
+TEST_CASE("Load: TextureMappedProjection/Baked", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "projection": {
+                "type": "TextureMappedProjection",
+                "fov": {
+                  "down": 1.0,
+                  "left": 2.0,
+                  "right": 3.0,
+                  "up": 4.0
+                },
+                "baked": true
+              },
+              "mesh": "abc"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    // Can't use initializer list for this since TextureMappedProjection is actually a
+    // PlanarProjection
+    TextureMappedProjection proj;
+    proj.fov = TextureMappedProjection::FOV {
+        .down = -1.f,
+        .left = -2.f,
+        .right = 3.f,
+        .up = 4.f
+    };
+    proj.baked = true;
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .projection = proj,
+                                .correctionMeshTexture = std::filesystem::absolute("abc")
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: TextureMappedProjection/Full", "[parse]") {
     constexpr std::string_view String = R"(
 {
@@ -1697,3 +1772,31 @@ TEST_CASE("Validate: TextureMappedProjection/Offset/Z/Wrong Type", "[validate]")
 
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
+
+TEST_CASE("Validate: TextureMappedProjection/Baked/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "mesh": "abc",
+            "projection": {
+              "type": "TextureMappedProjection",
+              "baked": "abc"
+            }
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
@@ -942,6 +942,206 @@ TEST_CASE("Load: Tracker/Devices/Transformation", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Tracker/Devices/Filter", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": [
+    {
+      "name": "abc",
+      "devices": [
+        {
+          "name": "def",
+          "filter": {
+            "type": "oneeuro",
+            "mincutoff": 1.5,
+            "beta": 0.25,
+            "derivativecutoff": 2.0
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .trackers = {
+                Tracker {
+                    .name = "abc",
+                    .devices = {
+                        Tracker::Device {
+                            .name = "def",
+                            .filter = Tracker::Device::Filter {
+                                .type = Tracker::Device::Filter::Type::OneEuro,
+                                .minCutoff = 1.5,
+                                .beta = 0.25,
+                                .derivativeCutoff = 2.0
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": [
+    {
+      "name": "abc",
+      "devices": [
+        {
+          "name": "def",
+          "filter": {
+            "type": "kalman",
+            "processnoise": 20.0,
+            "measurementnoise": 0.5
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .trackers = {
+                Tracker {
+                    .name = "abc",
+                    .devices = {
+                        Tracker::Device {
+                            .name = "def",
+                            .filter = Tracker::Device::Filter {
+                                .type = Tracker::Device::Filter::Type::Kalman,
+                                .processNoise = 20.0,
+                                .measurementNoise = 0.5
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Tracker/Devices/Prediction", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": [
+    {
+      "name": "abc",
+      "devices": [
+        {
+          "name": "def",
+          "prediction": { "latency": 0.25 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .trackers = {
+                Tracker {
+                    .name = "abc",
+                    .devices = {
+                        Tracker::Device {
+                            .name = "def",
+                            .prediction = Tracker::Device::Prediction {
+                                .latency = 0.25
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": [
+    {
+      "name": "abc",
+      "devices": [
+        {
+          "name": "def",
+          "prediction": { "model": "acceleration", "latency": 0.5 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .trackers = {
+                Tracker {
+                    .name = "abc",
+                    .devices = {
+                        Tracker::Device {
+                            .name = "def",
+                            .prediction = Tracker::Device::Prediction {
+                                .model =
+                                    Tracker::Device::Prediction::Model::Acceleration,
+                                .latency = 0.5
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Load: Tracker/Offset", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -2093,3 +2293,40 @@ TEST_CASE("Validate: Tracker/Transformation/Illegal Value", "[validate]") {
         CHECK_THROWS_AS(validate(Config), ParsingError);
     }
 }
+
+
+TEST_CASE("Validate: Tracker/Device/Filter/Type/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": {
+    "devices": [
+      {
+        "filter": { "type": "abc" }
+      }
+    ]
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Tracker/Device/Prediction/Latency/Missing", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "trackers": {
+    "devices": [
+      {
+        "prediction": { "model": "velocity" }
+      }
+    ]
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
@@ -306,6 +306,59 @@ TEST_CASE("Load: Viewport/User", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Viewport/Users", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "users": [ "abc", "def" ]
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .viewports = {
+                            Viewport {
+                                .users = { "abc", "def" }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -321,7 +374,387 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "overlay": "abc"
+              "overlay": "abc"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .overlayTexture = std::filesystem::absolute("abc")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "overlay": "def"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .overlayTexture = std::filesystem::absolute("def")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "blendmask": "abc"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .blendMaskTexture = std::filesystem::absolute("abc")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "blendmask": "def"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .blendMaskTexture = std::filesystem::absolute("def")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "blacklevelmask": "abc"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .blackLevelMaskTexture =
+                                        std::filesystem::absolute("abc")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "blacklevelmask": "def"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .blackLevelMaskTexture =
+                                        std::filesystem::absolute("def")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "mesh": "abc"
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .correctionMeshTexture =
+                                        std::filesystem::absolute("abc")
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "mesh": "def"
             }
           ]
         }
@@ -343,7 +776,8 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .overlayTexture = std::filesystem::absolute("abc")
+                                    .correctionMeshTexture =
+                                        std::filesystem::absolute("def")
                                 }
                             }
                         }
@@ -359,7 +793,9 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Viewport/CorrectionMeshTolerance", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -374,7 +810,7 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "overlay": "def"
+              "meshtolerance": 0.5
             }
           ]
         }
@@ -396,7 +832,60 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .overlayTexture = std::filesystem::absolute("def")
+                                    .correctionMeshTolerance = 0.5f
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "viewports": [
+            {
+              "meshtolerance": 2.0
+            }
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .viewports = {
+                                Viewport {
+                                    .correctionMeshTolerance = 2.f
                                 }
                             }
                         }
@@ -414,7 +903,7 @@ TEST_CASE("Load: Viewport/OverlayTexture", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
+TEST_CASE("Load: Viewport/CorrectionMeshWarpMap", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -429,7 +918,7 @@ TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "blendmask": "abc"
+              "meshwarpmap": false
             }
           ]
         }
@@ -451,7 +940,7 @@ TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .blendMaskTexture = std::filesystem::absolute("abc")
+                                    .correctionMeshWarpMap = false
                                 }
                             }
                         }
@@ -482,7 +971,7 @@ TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "blendmask": "def"
+              "meshwarpmap": true
             }
           ]
         }
@@ -504,7 +993,7 @@ TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .blendMaskTexture = std::filesystem::absolute("def")
+                                    .correctionMeshWarpMap = true
                                 }
                             }
                         }
@@ -522,7 +1011,7 @@ TEST_CASE("Load: Viewport/BlendMaskTexture", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
+TEST_CASE("Load: Viewport/CorrectionMeshProcedural", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -537,7 +1026,7 @@ TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "blacklevelmask": "abc"
+              "meshprocedural": false
             }
           ]
         }
@@ -559,8 +1048,7 @@ TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .blackLevelMaskTexture =
-                                        std::filesystem::absolute("abc")
+                                    .correctionMeshProcedural = false
                                 }
                             }
                         }
@@ -591,7 +1079,7 @@ TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "blacklevelmask": "def"
+              "meshprocedural": true
             }
           ]
         }
@@ -613,8 +1101,7 @@ TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .blackLevelMaskTexture =
-                                        std::filesystem::absolute("def")
+                                    .correctionMeshProcedural = true
                                 }
                             }
                         }
@@ -632,7 +1119,7 @@ TEST_CASE("Load: Viewport/BlackLevelMaskTexture", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
+TEST_CASE("Load: Viewport/CorrectionMeshEditable", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -647,7 +1134,7 @@ TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "mesh": "abc"
+              "mesheditable": false
             }
           ]
         }
@@ -669,8 +1156,7 @@ TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .correctionMeshTexture =
-                                        std::filesystem::absolute("abc")
+                                    .correctionMeshEditable = false
                                 }
                             }
                         }
@@ -701,7 +1187,7 @@ TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
           "size": { "x": 640, "y": 480 },
           "viewports": [
             {
-              "mesh": "def"
+              "mesheditable": true
             }
           ]
         }
@@ -723,8 +1209,7 @@ TEST_CASE("Load: Viewport/CorrectionMeshTexture", "[parse]") {
                             .size = ivec2{ 640, 480 },
                             .viewports = {
                                 Viewport {
-                                    .correctionMeshTexture =
-                                        std::filesystem::absolute("def")
+                                    .correctionMeshEditable = true
                                 }
                             }
                         }
@@ -1320,6 +1805,54 @@ TEST_CASE("Validate: Viewport/User/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: Viewport/Users/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "users": [ 123 ]
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Viewport/Users/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "users": [ "" ]
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: Viewport/OverlayTexture/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -1416,6 +1949,152 @@ TEST_CASE("Validate: Viewport/CorrectionMeshTexture/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: Viewport/CorrectionMeshTolerance/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "meshtolerance": "abc"
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Viewport/CorrectionMeshTolerance/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "meshtolerance": 0
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "meshtolerance": -1.5
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+}
+
+TEST_CASE("Validate: Viewport/CorrectionMeshWarpMap/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "meshwarpmap": "abc"
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Viewport/CorrectionMeshProcedural/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "meshprocedural": "abc"
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Viewport/CorrectionMeshEditable/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "viewport": {
+            "mesheditable": "abc"
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: Viewport/IsTracked/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -779,6 +779,57 @@ TEST_CASE("Load: Window/BufferBitDepth", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Window/StageBitDepths", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "bufferbitdepth": "10",
+          "cubemapbitdepth": "16f",
+          "intermediatebitdepth": "8",
+          "capturebitdepth": "16"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .bufferBitDepth = Window::ColorBitDepth::Depth10,
+                        .cubemapBitDepth = Window::ColorBitDepth::Depth16Float,
+                        .intermediateBitDepth = Window::ColorBitDepth::Depth8,
+                        .captureBitDepth = Window::ColorBitDepth::Depth16
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: Window/IsFullScreen", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -1607,6 +1658,100 @@ TEST_CASE("Load: Window/UseFXAA", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Window/UseSMAAAndTAA", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "smaa": true,
+          "taa": true
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .useSmaa = true,
+                        .useTaa = true
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Window/SwapInterval", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "swapinterval": 2,
+          "adaptivesync": true
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .swapInterval = 2,
+                        .adaptiveSync = true
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: Window/IsDecorated", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -1883,6 +2028,96 @@ TEST_CASE("Load: Window/Draw2D", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Window/Draw2DRate", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "draw2drate": 10.5
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .draw2DRate = 10.5f
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Window/RenderEvery", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "renderevery": 4
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .renderEvery = 4
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: Window/Draw3D", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -2435,7 +2670,7 @@ TEST_CASE("Load: Window/Monitor", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Window/Stereo", "[parse]") {
+TEST_CASE("Load: Window/Gpu", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -2448,7 +2683,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "none"
+          "gpu": 0
         }
       ]
     }
@@ -2466,7 +2701,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::NoStereo
+                            .gpu = 0
                         }
                     }
                 }
@@ -2493,7 +2728,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "no_stereo"
+          "gpu": 1
         }
       ]
     }
@@ -2511,7 +2746,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::NoStereo
+                            .gpu = 1
                         }
                     }
                 }
@@ -2525,9 +2760,10 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
-    {
-        constexpr std::string_view String = R"(
+TEST_CASE("Load: Window/Compositing", "[parse]") {
+    constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -2538,7 +2774,10 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "active"
+          "compositing": {
+            "nodes": [ 0, 1, 2 ],
+            "output": 1
+          }
         }
       ]
     }
@@ -2546,33 +2785,37 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
 }
 )";
 
-        const Cluster Object = {
-            .success = true,
-            .masterAddress = "localhost",
-            .nodes = {
-                Node {
-                    .address = "abc",
-                    .port = 1,
-                    .windows = {
-                        Window {
-                            .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::Active
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .compositing = Window::Compositing {
+                            .nodes = { 0, 1, 2 },
+                            .output = 1
                         }
                     }
                 }
             }
-        };
-
-        Cluster res = sgct::readJsonConfig(String);
-        CHECK(res == Object);
+        }
+    };
 
-        const std::string str = serializeConfig(Object);
-        const config::Cluster output = readJsonConfig(str);
-        CHECK(output == Object);
-    }
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
 
-    {
-        constexpr std::string_view String = R"(
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Window/Stereo", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -2583,7 +2826,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "quadbuffer"
+          "stereo": "none"
         }
       ]
     }
@@ -2601,7 +2844,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::Active
+                            .stereo = Window::StereoMode::NoStereo
                         }
                     }
                 }
@@ -2628,7 +2871,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "checkerboard"
+          "stereo": "no_stereo"
         }
       ]
     }
@@ -2646,7 +2889,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::Checkerboard
+                            .stereo = Window::StereoMode::NoStereo
                         }
                     }
                 }
@@ -2673,7 +2916,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "checkerboard_inverted"
+          "stereo": "active"
         }
       ]
     }
@@ -2691,7 +2934,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::CheckerboardInverted
+                            .stereo = Window::StereoMode::Active
                         }
                     }
                 }
@@ -2718,7 +2961,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "anaglyph_red_cyan"
+          "stereo": "quadbuffer"
         }
       ]
     }
@@ -2736,7 +2979,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::AnaglyphRedCyan
+                            .stereo = Window::StereoMode::Active
                         }
                     }
                 }
@@ -2763,7 +3006,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "anaglyph_amber_blue"
+          "stereo": "checkerboard"
         }
       ]
     }
@@ -2781,7 +3024,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::AnaglyphAmberBlue
+                            .stereo = Window::StereoMode::Checkerboard
                         }
                     }
                 }
@@ -2808,7 +3051,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "anaglyph_wimmer"
+          "stereo": "checkerboard_inverted"
         }
       ]
     }
@@ -2826,7 +3069,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::AnaglyphRedCyanWimmer
+                            .stereo = Window::StereoMode::CheckerboardInverted
                         }
                     }
                 }
@@ -2853,7 +3096,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "vertical_interlaced"
+          "stereo": "anaglyph_red_cyan"
         }
       ]
     }
@@ -2871,7 +3114,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::VerticalInterlaced
+                            .stereo = Window::StereoMode::AnaglyphRedCyan
                         }
                     }
                 }
@@ -2898,7 +3141,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "vertical_interlaced_inverted"
+          "stereo": "anaglyph_amber_blue"
         }
       ]
     }
@@ -2916,7 +3159,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::VerticalInterlacedInverted
+                            .stereo = Window::StereoMode::AnaglyphAmberBlue
                         }
                     }
                 }
@@ -2943,7 +3186,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "test"
+          "stereo": "anaglyph_wimmer"
         }
       ]
     }
@@ -2961,7 +3204,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::Dummy
+                            .stereo = Window::StereoMode::AnaglyphRedCyanWimmer
                         }
                     }
                 }
@@ -2988,7 +3231,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "dummy"
+          "stereo": "vertical_interlaced"
         }
       ]
     }
@@ -3006,7 +3249,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::Dummy
+                            .stereo = Window::StereoMode::VerticalInterlaced
                         }
                     }
                 }
@@ -3033,7 +3276,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "side_by_side"
+          "stereo": "vertical_interlaced_inverted"
         }
       ]
     }
@@ -3051,7 +3294,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::SideBySide
+                            .stereo = Window::StereoMode::VerticalInterlacedInverted
                         }
                     }
                 }
@@ -3078,7 +3321,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "side_by_side_inverted"
+          "stereo": "test"
         }
       ]
     }
@@ -3096,7 +3339,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::SideBySideInverted
+                            .stereo = Window::StereoMode::Dummy
                         }
                     }
                 }
@@ -3123,7 +3366,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "top_bottom"
+          "stereo": "dummy"
         }
       ]
     }
@@ -3141,7 +3384,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::TopBottom
+                            .stereo = Window::StereoMode::Dummy
                         }
                     }
                 }
@@ -3168,7 +3411,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "stereo": "top_bottom_inverted"
+          "stereo": "side_by_side"
         }
       ]
     }
@@ -3186,7 +3429,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .stereo = Window::StereoMode::TopBottomInverted
+                            .stereo = Window::StereoMode::SideBySide
                         }
                     }
                 }
@@ -3200,9 +3443,7 @@ TEST_CASE("Load: Window/Stereo", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3215,9 +3456,7 @@ TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "spout": {
-            "enabled": false
-          }
+          "stereo": "side_by_side_inverted"
         }
       ]
     }
@@ -3235,9 +3474,7 @@ TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .spout = Window::Spout {
-                                .enabled = false
-                            }
+                            .stereo = Window::StereoMode::SideBySideInverted
                         }
                     }
                 }
@@ -3264,9 +3501,7 @@ TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "spout": {
-            "enabled": true
-          }
+          "stereo": "top_bottom"
         }
       ]
     }
@@ -3284,9 +3519,7 @@ TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .spout = Window::Spout {
-                                .enabled = true
-                            }
+                            .stereo = Window::StereoMode::TopBottom
                         }
                     }
                 }
@@ -3300,9 +3533,7 @@ TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Window/Spout/Name", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3315,10 +3546,7 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "spout": {
-            "enabled": true,
-            "name": "abc"
-          }
+          "stereo": "top_bottom_inverted"
         }
       ]
     }
@@ -3336,10 +3564,7 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .spout = Window::Spout {
-                                .enabled = true,
-                                .name = "abc"
-                            }
+                            .stereo = Window::StereoMode::TopBottomInverted
                         }
                     }
                 }
@@ -3353,7 +3578,9 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Window/SinglePassStereo", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3366,10 +3593,7 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "spout": {
-            "enabled": true,
-            "name": "123"
-          }
+          "singlepassstereo": false
         }
       ]
     }
@@ -3387,10 +3611,7 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .spout = Window::Spout {
-                                .enabled = true,
-                                .name = "123"
-                            }
+                            .singlePassStereo = false
                         }
                     }
                 }
@@ -3404,9 +3625,7 @@ TEST_CASE("Load: Window/Spout/Name", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3419,9 +3638,7 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
-            "enabled": false
-          }
+          "singlepassstereo": true
         }
       ]
     }
@@ -3439,9 +3656,7 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
-                                .enabled = false
-                            }
+                            .singlePassStereo = true
                         }
                     }
                 }
@@ -3455,7 +3670,9 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Window/Spout/Enabled", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3468,8 +3685,8 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
-            "enabled": true
+          "spout": {
+            "enabled": false
           }
         }
       ]
@@ -3488,8 +3705,8 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
-                                .enabled = true
+                            .spout = Window::Spout {
+                                .enabled = false
                             }
                         }
                     }
@@ -3504,9 +3721,7 @@ TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Window/NDI/Name", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3519,9 +3734,8 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
-            "enabled": true,
-            "name": "abc"
+          "spout": {
+            "enabled": true
           }
         }
       ]
@@ -3540,9 +3754,8 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
-                                .enabled = true,
-                                .name = "abc"
+                            .spout = Window::Spout {
+                                .enabled = true
                             }
                         }
                     }
@@ -3557,7 +3770,9 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
+TEST_CASE("Load: Window/Spout/Name", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3570,9 +3785,9 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
+          "spout": {
             "enabled": true,
-            "name": "123"
+            "name": "abc"
           }
         }
       ]
@@ -3591,9 +3806,9 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
+                            .spout = Window::Spout {
                                 .enabled = true,
-                                .name = "123"
+                                .name = "abc"
                             }
                         }
                     }
@@ -3608,9 +3823,7 @@ TEST_CASE("Load: Window/NDI/Name", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
-}
 
-TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3623,9 +3836,9 @@ TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
+          "spout": {
             "enabled": true,
-            "groups": "abc,def"
+            "name": "123"
           }
         }
       ]
@@ -3644,9 +3857,9 @@ TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
+                            .spout = Window::Spout {
                                 .enabled = true,
-                                .groups = "abc,def"
+                                .name = "123"
                             }
                         }
                     }
@@ -3661,9 +3874,10 @@ TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+}
 
-    {
-        constexpr std::string_view String = R"(
+TEST_CASE("Load: Window/Spout/SharedTexture", "[parse]") {
+    constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -3674,9 +3888,9 @@ TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "ndi": {
+          "spout": {
             "enabled": true,
-            "groups": "123,456"
+            "sharedtexture": true
           }
         }
       ]
@@ -3685,36 +3899,35 @@ TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
 }
 )";
 
-        const Cluster Object = {
-            .success = true,
-            .masterAddress = "localhost",
-            .nodes = {
-                Node {
-                    .address = "abc",
-                    .port = 1,
-                    .windows = {
-                        Window {
-                            .size = ivec2{ 640, 480 },
-                            .ndi = Window::NDI {
-                                .enabled = true,
-                                .groups = "123,456"
-                            }
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .spout = Window::Spout {
+                            .enabled = true,
+                            .sharedTexture = true
                         }
                     }
                 }
             }
-        };
+        }
+    };
 
-        Cluster res = sgct::readJsonConfig(String);
-        CHECK(res == Object);
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
 
-        const std::string str = serializeConfig(Object);
-        const config::Cluster output = readJsonConfig(str);
-        CHECK(output == Object);
-    }
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
 }
 
-TEST_CASE("Load: Window/Pos", "[parse]") {
+TEST_CASE("Load: Window/NDI/Enabled", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3726,8 +3939,10 @@ TEST_CASE("Load: Window/Pos", "[parse]") {
       "port": 1,
       "windows": [
         {
-          "pos": { "x": 1, "y": 2 },
-          "size": { "x": 640, "y": 480 }
+          "size": { "x": 640, "y": 480 },
+          "ndi": {
+            "enabled": false
+          }
         }
       ]
     }
@@ -3744,8 +3959,10 @@ TEST_CASE("Load: Window/Pos", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .pos = ivec2{ 1, 2 },
-                            .size = ivec2{ 640, 480 }
+                            .size = ivec2{ 640, 480 },
+                            .ndi = Window::NDI {
+                                .enabled = false
+                            }
                         }
                     }
                 }
@@ -3771,8 +3988,10 @@ TEST_CASE("Load: Window/Pos", "[parse]") {
       "port": 1,
       "windows": [
         {
-          "pos": { "x": 3, "y": 4 },
-          "size": { "x": 640, "y": 480 }
+          "size": { "x": 640, "y": 480 },
+          "ndi": {
+            "enabled": true
+          }
         }
       ]
     }
@@ -3789,8 +4008,10 @@ TEST_CASE("Load: Window/Pos", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .pos = ivec2{ 3, 4 },
-                            .size = ivec2{ 640, 480 }
+                            .size = ivec2{ 640, 480 },
+                            .ndi = Window::NDI {
+                                .enabled = true
+                            }
                         }
                     }
                 }
@@ -3806,7 +4027,7 @@ TEST_CASE("Load: Window/Pos", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Window/Size", "[parse]") {
+TEST_CASE("Load: Window/NDI/Name", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3818,7 +4039,11 @@ TEST_CASE("Load: Window/Size", "[parse]") {
       "port": 1,
       "windows": [
         {
-          "size": { "x": 1, "y": 2 }
+          "size": { "x": 640, "y": 480 },
+          "ndi": {
+            "enabled": true,
+            "name": "abc"
+          }
         }
       ]
     }
@@ -3835,7 +4060,11 @@ TEST_CASE("Load: Window/Size", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .size = ivec2{ 1, 2 }
+                            .size = ivec2{ 640, 480 },
+                            .ndi = Window::NDI {
+                                .enabled = true,
+                                .name = "abc"
+                            }
                         }
                     }
                 }
@@ -3861,7 +4090,11 @@ TEST_CASE("Load: Window/Size", "[parse]") {
       "port": 1,
       "windows": [
         {
-          "size": { "x": 3, "y": 4 }
+          "size": { "x": 640, "y": 480 },
+          "ndi": {
+            "enabled": true,
+            "name": "123"
+          }
         }
       ]
     }
@@ -3878,7 +4111,11 @@ TEST_CASE("Load: Window/Size", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .size = ivec2{ 3, 4 }
+                            .size = ivec2{ 640, 480 },
+                            .ndi = Window::NDI {
+                                .enabled = true,
+                                .name = "123"
+                            }
                         }
                     }
                 }
@@ -3894,7 +4131,7 @@ TEST_CASE("Load: Window/Size", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Window/Resolution", "[parse]") {
+TEST_CASE("Load: Window/NDI/Groups", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3907,8 +4144,11 @@ TEST_CASE("Load: Window/Resolution", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "res": { "x": 1, "y": 2 }
-        }
+          "ndi": {
+            "enabled": true,
+            "groups": "abc,def"
+          }
+        }
       ]
     }
   ]
@@ -3925,7 +4165,10 @@ TEST_CASE("Load: Window/Resolution", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .resolution = ivec2{ 1, 2 }
+                            .ndi = Window::NDI {
+                                .enabled = true,
+                                .groups = "abc,def"
+                            }
                         }
                     }
                 }
@@ -3952,7 +4195,10 @@ TEST_CASE("Load: Window/Resolution", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "res": { "x": 3, "y": 4 }
+          "ndi": {
+            "enabled": true,
+            "groups": "123,456"
+          }
         }
       ]
     }
@@ -3970,7 +4216,10 @@ TEST_CASE("Load: Window/Resolution", "[parse]") {
                     .windows = {
                         Window {
                             .size = ivec2{ 640, 480 },
-                            .resolution = ivec2{ 3, 4 }
+                            .ndi = Window::NDI {
+                                .enabled = true,
+                                .groups = "123,456"
+                            }
                         }
                     }
                 }
@@ -3986,7 +4235,58 @@ TEST_CASE("Load: Window/Resolution", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
+TEST_CASE("Load: Window/FrameExport", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "frameexport": {
+            "enabled": true,
+            "name": "recorder"
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .size = ivec2{ 640, 480 },
+                        .frameExport = Window::FrameExport {
+                            .enabled = true,
+                            .name = "recorder"
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Window/Stream", "[parse]") {
     {
         constexpr std::string_view String = R"(
 {
@@ -3999,7 +4299,9 @@ TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "scalablemesh": "abc"
+          "stream": {
+            "url": "srt://noc:9000"
+          }
         }
       ]
     }
@@ -4016,8 +4318,9 @@ TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .scalable = Window::Scalable {
-                                .mesh = std::filesystem::current_path() / "abc"
+                            .size = ivec2{ 640, 480 },
+                            .stream = Window::Stream {
+                                .url = "srt://noc:9000"
                             }
                         }
                     }
@@ -4045,7 +4348,13 @@ TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
       "windows": [
         {
           "size": { "x": 640, "y": 480 },
-          "scalablemesh": "def"
+          "stream": {
+            "url": "udp://10.0.0.1:5000",
+            "codec": "hevc",
+            "bitrate": 2500,
+            "framerate": 15,
+            "scale": 0.25
+          }
         }
       ]
     }
@@ -4062,8 +4371,13 @@ TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
                     .port = 1,
                     .windows = {
                         Window {
-                            .scalable = Window::Scalable {
-                                .mesh = std::filesystem::current_path() / "def"
+                            .size = ivec2{ 640, 480 },
+                            .stream = Window::Stream {
+                                .url = "udp://10.0.0.1:5000",
+                                .codec = Capture::Codec::HEVC,
+                                .bitrate = 2500,
+                                .frameRate = 15,
+                                .scale = 0.25f
                             }
                         }
                     }
@@ -4080,11 +4394,9 @@ TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
     }
 }
 
-TEST_CASE("Load: Window/Full", "[parse]") {
-    // We don't check the scalable mesh here since that inhibits loading all of the other
-    // variables
-
-    constexpr std::string_view String = R"(
+TEST_CASE("Load: Window/Pos", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4094,41 +4406,8 @@ TEST_CASE("Load: Window/Full", "[parse]") {
       "port": 1,
       "windows": [
         {
-          "id": 0,
-          "name": "def",
-          "tags": [ "ghi", "jkl" ],
-          "bufferbitdepth": "8",
-          "fullscreen": true,
-          "autoiconify": true,
-          "hidemousecursor": true,
-          "floating": true,
-          "alwaysrender": true,
-          "hidden": true,
-          "takescreenshot": true,
-          "msaa": 1,
-          "fxaa": true,
-          "border": true,
-          "resizable": true,
-          "draw2d": true,
-          "draw3d": true,
-          "noerror": true,
-          "blitwindowid": 1,
-          "mirrorx": true,
-          "mirrory": true,
-          "monitor": 1,
-          "stereo": "active",
-          "spout": {
-            "enabled": true,
-            "name": "mno"
-          },
-          "ndi": {
-            "enabled": true,
-            "name": "pqr",
-            "groups": "stu,vwx"
-          },
           "pos": { "x": 1, "y": 2 },
-          "size": { "x": 640, "y": 480 },
-          "res": { "x": 1, "y": 2 }
+          "size": { "x": 640, "y": 480 }
         }
       ]
     }
@@ -4136,69 +4415,779 @@ TEST_CASE("Load: Window/Full", "[parse]") {
 }
 )";
 
-    const Cluster Object = {
-        .success = true,
-        .masterAddress = "localhost",
-        .nodes = {
-            Node {
-                .address = "abc",
-                .port = 1,
-                .windows = {
-                    Window {
-                        .pos = ivec2{ 1, 2 },
-                        .size = ivec2{ 640, 480 },
-                        .resolution = ivec2{ 1, 2 },
-                        .id = 0,
-                        .name = "def",
-                        .tags = { "ghi", "jkl" },
-                        .bufferBitDepth = Window::ColorBitDepth::Depth8,
-                        .isFullScreen = true,
-                        .shouldAutoiconify = true,
-                        .hideMouseCursor = true,
-                        .isFloating = true,
-                        .alwaysRender = true,
-                        .isHidden = true,
-                        .takeScreenshot = true,
-                        .msaa = 1,
-                        .useFxaa = true,
-                        .isDecorated = true,
-                        .isResizable = true,
-                        .draw2D = true,
-                        .draw3D = true,
-                        .noError = true,
-                        .blitWindowId = 1,
-                        .mirrorX = true,
-                        .mirrorY = true,
-                        .monitor = 1,
-                        .stereo = Window::StereoMode::Active,
-                        .spout = Window::Spout {
-                            .enabled = true,
-                            .name = "mno"
-                        },
-                        .ndi = Window::NDI {
-                            .enabled = true,
-                            .name = "pqr",
-                            .groups = "stu,vwx"
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .pos = ivec2{ 1, 2 },
+                            .size = ivec2{ 640, 480 }
                         }
                     }
                 }
             }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "pos": { "x": 3, "y": 4 },
+          "size": { "x": 640, "y": 480 }
         }
-    };
+      ]
+    }
+  ]
+}
+)";
 
-    Cluster res = sgct::readJsonConfig(String);
-    CHECK(res == Object);
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .pos = ivec2{ 3, 4 },
+                            .size = ivec2{ 640, 480 }
+                        }
+                    }
+                }
+            }
+        };
 
-    const std::string str = serializeConfig(Object);
-    const config::Cluster output = readJsonConfig(str);
-    CHECK(output == Object);
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Window/Size", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 1, "y": 2 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 1, 2 }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 3, "y": 4 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 3, 4 }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Window/Resolution", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "res": { "x": 1, "y": 2 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .resolution = ivec2{ 1, 2 }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "res": { "x": 3, "y": 4 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .size = ivec2{ 640, 480 },
+                            .resolution = ivec2{ 3, 4 }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Window/ScalableMesh", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "scalablemesh": "abc"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .scalable = Window::Scalable {
+                                .mesh = std::filesystem::current_path() / "abc"
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "scalablemesh": "def"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .nodes = {
+                Node {
+                    .address = "abc",
+                    .port = 1,
+                    .windows = {
+                        Window {
+                            .scalable = Window::Scalable {
+                                .mesh = std::filesystem::current_path() / "def"
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Window/Full", "[parse]") {
+    // We don't check the scalable mesh here since that inhibits loading all of the other
+    // variables
+
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "abc",
+      "port": 1,
+      "windows": [
+        {
+          "id": 0,
+          "name": "def",
+          "tags": [ "ghi", "jkl" ],
+          "bufferbitdepth": "8",
+          "fullscreen": true,
+          "autoiconify": true,
+          "hidemousecursor": true,
+          "floating": true,
+          "alwaysrender": true,
+          "hidden": true,
+          "takescreenshot": true,
+          "msaa": 1,
+          "fxaa": true,
+          "border": true,
+          "resizable": true,
+          "draw2d": true,
+          "draw3d": true,
+          "noerror": true,
+          "blitwindowid": 1,
+          "mirrorx": true,
+          "mirrory": true,
+          "monitor": 1,
+          "stereo": "active",
+          "spout": {
+            "enabled": true,
+            "name": "mno"
+          },
+          "ndi": {
+            "enabled": true,
+            "name": "pqr",
+            "groups": "stu,vwx"
+          },
+          "pos": { "x": 1, "y": 2 },
+          "size": { "x": 640, "y": 480 },
+          "res": { "x": 1, "y": 2 }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .nodes = {
+            Node {
+                .address = "abc",
+                .port = 1,
+                .windows = {
+                    Window {
+                        .pos = ivec2{ 1, 2 },
+                        .size = ivec2{ 640, 480 },
+                        .resolution = ivec2{ 1, 2 },
+                        .id = 0,
+                        .name = "def",
+                        .tags = { "ghi", "jkl" },
+                        .bufferBitDepth = Window::ColorBitDepth::Depth8,
+                        .isFullScreen = true,
+                        .shouldAutoiconify = true,
+                        .hideMouseCursor = true,
+                        .isFloating = true,
+                        .alwaysRender = true,
+                        .isHidden = true,
+                        .takeScreenshot = true,
+                        .msaa = 1,
+                        .useFxaa = true,
+                        .isDecorated = true,
+                        .isResizable = true,
+                        .draw2D = true,
+                        .draw3D = true,
+                        .noError = true,
+                        .blitWindowId = 1,
+                        .mirrorX = true,
+                        .mirrorY = true,
+                        .monitor = 1,
+                        .stereo = Window::StereoMode::Active,
+                        .spout = Window::Spout {
+                            .enabled = true,
+                            .name = "mno"
+                        },
+                        .ndi = Window::NDI {
+                            .enabled = true,
+                            .name = "pqr",
+                            .groups = "stu,vwx"
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+
+
+
+
+TEST_CASE("Validate: Window/Empty", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {}
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/CaptureBitDepth/Packed", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "size": { "x": 640, "y": 480 },
+          "capturebitdepth": "10"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/ID/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "id": "abc"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/Name/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "name": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "tags": [ 123 ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "tags": [ 123, "abc" ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "tags": [ "abc", 123 ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+}
+
+TEST_CASE("Validate: Window/Tags/Duplicate", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "tags": [ "abc", "def", "abc" ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/BufferBitDepth/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "bufferbitdepth": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/BufferBitDepth/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "bufferbitdepth": "1"
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/IsFullScreen/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "fullscreen": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/ShouldAutoIconify/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "autoiconify": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/HideMouseCursor/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "hidemousecursor": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/IsFloating/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "floating": 123
+        }
+      ]
+    }
+  ]
 }
+)";
 
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
 
-
-
-
-TEST_CASE("Validate: Window/Empty", "[validate]") {
+TEST_CASE("Validate: Window/AlwaysRender/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4208,7 +5197,9 @@ TEST_CASE("Validate: Window/Empty", "[validate]") {
       "address": "localhost",
       "port": 123,
       "windows": [
-        {}
+        {
+          "alwaysrender": 123
+        }
       ]
     }
   ]
@@ -4218,7 +5209,7 @@ TEST_CASE("Validate: Window/Empty", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/ID/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/IsHidden/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4229,7 +5220,7 @@ TEST_CASE("Validate: Window/ID/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "id": "abc"
+          "hidden": 123
         }
       ]
     }
@@ -4240,7 +5231,7 @@ TEST_CASE("Validate: Window/ID/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/Name/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/TakeScreenshot/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4251,7 +5242,7 @@ TEST_CASE("Validate: Window/Name/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "name": 123
+          "takescreenshot": 123
         }
       ]
     }
@@ -4262,9 +5253,8 @@ TEST_CASE("Validate: Window/Name/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
-    {
-        constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/MSAA/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4274,7 +5264,7 @@ TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "tags": [ 123 ]
+          "msaa": "abc"
         }
       ]
     }
@@ -4282,9 +5272,10 @@ TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
-    }
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
 
+TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
     {
         constexpr std::string_view Config = R"(
 {
@@ -4296,7 +5287,7 @@ TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "tags": [ 123, "abc" ]
+          "msaa": -10
         }
       ]
     }
@@ -4318,7 +5309,7 @@ TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "tags": [ "abc", 123 ]
+          "msaa": 500
         }
       ]
     }
@@ -4330,7 +5321,7 @@ TEST_CASE("Validate: Window/Tags/Wrong Type", "[validate]") {
     }
 }
 
-TEST_CASE("Validate: Window/Tags/Duplicate", "[validate]") {
+TEST_CASE("Validate: Window/UseFxaa/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4341,7 +5332,7 @@ TEST_CASE("Validate: Window/Tags/Duplicate", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "tags": [ "abc", "def", "abc" ]
+          "fxaa": "abc"
         }
       ]
     }
@@ -4352,7 +5343,7 @@ TEST_CASE("Validate: Window/Tags/Duplicate", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/BufferBitDepth/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/UseSmaa/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4363,7 +5354,7 @@ TEST_CASE("Validate: Window/BufferBitDepth/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "bufferbitdepth": 123
+          "smaa": "abc"
         }
       ]
     }
@@ -4374,7 +5365,7 @@ TEST_CASE("Validate: Window/BufferBitDepth/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/BufferBitDepth/Illegal Value", "[validate]") {
+TEST_CASE("Validate: Window/SwapInterval/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4385,7 +5376,7 @@ TEST_CASE("Validate: Window/BufferBitDepth/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "bufferbitdepth": "1"
+          "swapinterval": "abc"
         }
       ]
     }
@@ -4396,7 +5387,7 @@ TEST_CASE("Validate: Window/BufferBitDepth/Illegal Value", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/IsFullScreen/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/SwapInterval/Illegal Value", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4407,7 +5398,7 @@ TEST_CASE("Validate: Window/IsFullScreen/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "fullscreen": 123
+          "swapinterval": -1
         }
       ]
     }
@@ -4418,7 +5409,7 @@ TEST_CASE("Validate: Window/IsFullScreen/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/ShouldAutoIconify/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/AdaptiveSync/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4429,7 +5420,7 @@ TEST_CASE("Validate: Window/ShouldAutoIconify/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "autoiconify": 123
+          "adaptivesync": "abc"
         }
       ]
     }
@@ -4440,7 +5431,7 @@ TEST_CASE("Validate: Window/ShouldAutoIconify/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/HideMouseCursor/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/IsDecorated/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4451,7 +5442,7 @@ TEST_CASE("Validate: Window/HideMouseCursor/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "hidemousecursor": 123
+          "border": "abc"
         }
       ]
     }
@@ -4462,7 +5453,7 @@ TEST_CASE("Validate: Window/HideMouseCursor/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/IsFloating/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/IsResizable/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4473,7 +5464,7 @@ TEST_CASE("Validate: Window/IsFloating/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "floating": 123
+          "resizable": "abc"
         }
       ]
     }
@@ -4484,7 +5475,7 @@ TEST_CASE("Validate: Window/IsFloating/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/AlwaysRender/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/Draw2D/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4495,7 +5486,7 @@ TEST_CASE("Validate: Window/AlwaysRender/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "alwaysrender": 123
+          "draw2d": "abc"
         }
       ]
     }
@@ -4506,7 +5497,7 @@ TEST_CASE("Validate: Window/AlwaysRender/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/IsHidden/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/Draw2DRate/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4517,7 +5508,7 @@ TEST_CASE("Validate: Window/IsHidden/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "hidden": 123
+          "draw2drate": "abc"
         }
       ]
     }
@@ -4528,7 +5519,7 @@ TEST_CASE("Validate: Window/IsHidden/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/TakeScreenshot/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/Draw2DRate/Illegal Value", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4539,7 +5530,7 @@ TEST_CASE("Validate: Window/TakeScreenshot/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "takescreenshot": 123
+          "draw2drate": -1
         }
       ]
     }
@@ -4550,7 +5541,7 @@ TEST_CASE("Validate: Window/TakeScreenshot/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/MSAA/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/RenderEvery/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4561,7 +5552,7 @@ TEST_CASE("Validate: Window/MSAA/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "msaa": "abc"
+          "renderevery": "abc"
         }
       ]
     }
@@ -4572,9 +5563,8 @@ TEST_CASE("Validate: Window/MSAA/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
-    {
-        constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/RenderEvery/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4584,7 +5574,7 @@ TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "msaa": -10
+          "renderevery": 0
         }
       ]
     }
@@ -4592,11 +5582,11 @@ TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
-    }
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
 
-    {
-        constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/Draw3D/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4606,7 +5596,7 @@ TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "msaa": 500
+          "draw3d": "abc"
         }
       ]
     }
@@ -4614,11 +5604,10 @@ TEST_CASE("Validate: Window/MSAA/Illegal Value", "[validate]") {
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
-    }
+    CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/UseFxaa/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/IsMirrored/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4629,7 +5618,7 @@ TEST_CASE("Validate: Window/UseFxaa/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "fxaa": "abc"
+          "mirror": "abc"
         }
       ]
     }
@@ -4640,7 +5629,7 @@ TEST_CASE("Validate: Window/UseFxaa/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/IsDecorated/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/NoError/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4651,7 +5640,7 @@ TEST_CASE("Validate: Window/IsDecorated/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "border": "abc"
+          "noerror": "abc"
         }
       ]
     }
@@ -4662,7 +5651,7 @@ TEST_CASE("Validate: Window/IsDecorated/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/IsResizable/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/BlitWindowId/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4673,7 +5662,7 @@ TEST_CASE("Validate: Window/IsResizable/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "resizable": "abc"
+          "blitwindowid": "abc"
         }
       ]
     }
@@ -4684,8 +5673,9 @@ TEST_CASE("Validate: Window/IsResizable/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/Draw2D/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/BlitWindowId/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4695,7 +5685,7 @@ TEST_CASE("Validate: Window/Draw2D/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "draw2d": "abc"
+          "blitwindowid": -5000
         }
       ]
     }
@@ -4703,11 +5693,11 @@ TEST_CASE("Validate: Window/Draw2D/Wrong Type", "[validate]") {
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
-}
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
 
-TEST_CASE("Validate: Window/Draw3D/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+    {
+        constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4717,7 +5707,7 @@ TEST_CASE("Validate: Window/Draw3D/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "draw3d": "abc"
+          "blitwindowid": 5000
         }
       ]
     }
@@ -4725,10 +5715,11 @@ TEST_CASE("Validate: Window/Draw3D/Wrong Type", "[validate]") {
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
 }
 
-TEST_CASE("Validate: Window/IsMirrored/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/MirrorX/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4739,7 +5730,7 @@ TEST_CASE("Validate: Window/IsMirrored/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "mirror": "abc"
+          "mirrorx": "abc"
         }
       ]
     }
@@ -4750,7 +5741,7 @@ TEST_CASE("Validate: Window/IsMirrored/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/NoError/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/MirrorY/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4761,7 +5752,7 @@ TEST_CASE("Validate: Window/NoError/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "noerror": "abc"
+          "mirrory": "abc"
         }
       ]
     }
@@ -4772,7 +5763,7 @@ TEST_CASE("Validate: Window/NoError/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/BlitWindowId/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/Monitor/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4783,7 +5774,7 @@ TEST_CASE("Validate: Window/BlitWindowId/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "blitwindowid": "abc"
+          "monitor": "abc"
         }
       ]
     }
@@ -4794,7 +5785,7 @@ TEST_CASE("Validate: Window/BlitWindowId/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/BlitWindowId/Illegal Value", "[validate]") {
+TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
     {
         constexpr std::string_view Config = R"(
 {
@@ -4806,7 +5797,7 @@ TEST_CASE("Validate: Window/BlitWindowId/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "blitwindowid": -5000
+          "monitor": -1
         }
       ]
     }
@@ -4828,7 +5819,7 @@ TEST_CASE("Validate: Window/BlitWindowId/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "blitwindowid": 5000
+          "monitor": 500
         }
       ]
     }
@@ -4840,7 +5831,7 @@ TEST_CASE("Validate: Window/BlitWindowId/Illegal Value", "[validate]") {
     }
 }
 
-TEST_CASE("Validate: Window/MirrorX/Wrong Type", "[validate]") {
+TEST_CASE("Validate: Window/Gpu/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
   "version": 1,
@@ -4851,7 +5842,7 @@ TEST_CASE("Validate: Window/MirrorX/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "mirrorx": "abc"
+          "gpu": "abc"
         }
       ]
     }
@@ -4862,8 +5853,9 @@ TEST_CASE("Validate: Window/MirrorX/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
-TEST_CASE("Validate: Window/MirrorY/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/Gpu/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4873,7 +5865,7 @@ TEST_CASE("Validate: Window/MirrorY/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "mirrory": "abc"
+          "gpu": -1
         }
       ]
     }
@@ -4881,11 +5873,11 @@ TEST_CASE("Validate: Window/MirrorY/Wrong Type", "[validate]") {
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
-}
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
 
-TEST_CASE("Validate: Window/Monitor/Wrong Type", "[validate]") {
-    constexpr std::string_view Config = R"(
+    {
+        constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4895,7 +5887,7 @@ TEST_CASE("Validate: Window/Monitor/Wrong Type", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "monitor": "abc"
+          "gpu": 500
         }
       ]
     }
@@ -4903,12 +5895,12 @@ TEST_CASE("Validate: Window/Monitor/Wrong Type", "[validate]") {
 }
 )";
 
-    CHECK_THROWS_AS(validate(Config), ParsingError);
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
 }
 
-TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
-    {
-        constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/Compositing/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4918,7 +5910,7 @@ TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "monitor": -1
+          "compositing": "abc"
         }
       ]
     }
@@ -4926,11 +5918,11 @@ TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
-    }
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
 
-    {
-        constexpr std::string_view Config = R"(
+TEST_CASE("Validate: Window/Compositing/Output/Missing", "[validate]") {
+    constexpr std::string_view Config = R"(
 {
   "version": 1,
   "masteraddress": "localhost",
@@ -4940,7 +5932,9 @@ TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
       "port": 123,
       "windows": [
         {
-          "monitor": 500
+          "compositing": {
+            "nodes": [ 0, 1 ]
+          }
         }
       ]
     }
@@ -4948,8 +5942,7 @@ TEST_CASE("Validate: Window/Monitor/Illegal Value", "[validate]") {
 }
 )";
 
-        CHECK_THROWS_AS(validate(Config), ParsingError);
-    }
+    CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
 TEST_CASE("Validate: Window/Stereo/Wrong Type", "[validate]") {
@@ -5238,6 +6231,102 @@ TEST_CASE("Validate: Window/NDI/Groups/Illegal Value", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: Window/FrameExport/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "frameexport": 123
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/FrameExport/Name/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "frameexport": {
+            "enabled": true,
+            "name": ""
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/Stream/URL/Missing", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "stream": {
+            "bitrate": 2500
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Window/Stream/Scale/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "nodes": [
+    {
+      "address": "localhost",
+      "port": 123,
+      "windows": [
+        {
+          "stream": {
+            "url": "srt://noc:9000",
+            "scale": 2
+          }
+        }
+      ]
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: Window/Pos/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {